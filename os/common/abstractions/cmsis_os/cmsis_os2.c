@@ -0,0 +1,1811 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    cmsis_os2.c
+ * @brief   CMSIS RTOS2 module code.
+ *
+ * @addtogroup CMSIS_OS2
+ * @{
+ */
+
+#include <string.h>
+
+#include "cmsis_os2.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a pool of pre-allocated control blocks.
+ */
+typedef struct {
+  memory_pool_t             pool;
+  uint8_t                   *base;
+  uint8_t                   *end;
+} cb_pool_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static osKernelState_t kernel_state = osKernelInactive;
+
+static cb_pool_t timers_pool;
+static cb_pool_t event_flags_pool;
+static cb_pool_t mutexes_pool;
+static cb_pool_t semaphores_pool;
+static cb_pool_t memory_pools_pool;
+static cb_pool_t message_queues_pool;
+
+#if CMSIS_CFG_NUM_TIMERS > 0
+static cmsis_timer_t timers[CMSIS_CFG_NUM_TIMERS];
+#endif
+#if CMSIS_CFG_NUM_EVENT_FLAGS > 0
+static cmsis_event_flags_t event_flags[CMSIS_CFG_NUM_EVENT_FLAGS];
+#endif
+#if CMSIS_CFG_NUM_MUTEXES > 0
+static mutex_t mutexes[CMSIS_CFG_NUM_MUTEXES];
+#endif
+#if CMSIS_CFG_NUM_SEMAPHORES > 0
+static cmsis_semaphore_t semaphores[CMSIS_CFG_NUM_SEMAPHORES];
+#endif
+#if CMSIS_CFG_NUM_MEMORY_POOLS > 0
+static cmsis_memory_pool_t memory_pools[CMSIS_CFG_NUM_MEMORY_POOLS];
+#endif
+#if CMSIS_CFG_NUM_MESSAGE_QUEUES > 0
+static cmsis_message_queue_t message_queues[CMSIS_CFG_NUM_MESSAGE_QUEUES];
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts a CMSIS timeout in a system interval.
+ * @note    CMSIS timeouts are expressed in system ticks.
+ */
+static inline sysinterval_t tmo(uint32_t timeout) {
+
+  if (timeout == osWaitForever) {
+    return TIME_INFINITE;
+  }
+  if (timeout == 0U) {
+    return TIME_IMMEDIATE;
+  }
+  return (sysinterval_t)timeout;
+}
+
+/**
+ * @brief   Maps a CMSIS priority on a kernel priority.
+ */
+static inline tprio_t prio_to_kernel(osPriority_t priority) {
+
+  return (tprio_t)((int32_t)NORMALPRIO +
+                   ((int32_t)priority - (int32_t)osPriorityNormal));
+}
+
+/**
+ * @brief   Initializes a control blocks pool.
+ */
+static void cb_pool_init(cb_pool_t *cbp, void *p, size_t size, size_t n) {
+
+  chPoolObjectInit(&cbp->pool, size, NULL);
+  cbp->base = (uint8_t *)p;
+  cbp->end  = (uint8_t *)p + (size * n);
+  if (n > 0U) {
+    chPoolLoadArray(&cbp->pool, p, n);
+  }
+}
+
+/**
+ * @brief   Gets a control block.
+ * @details The control block provided in the attributes is used if present
+ *          else one is taken from the pool.
+ */
+static void *cb_alloc(cb_pool_t *cbp, void *cb_mem, uint32_t cb_size) {
+
+  if (cb_mem != NULL) {
+    if ((size_t)cb_size < cbp->pool.object_size) {
+      return NULL;
+    }
+    return cb_mem;
+  }
+
+  return chPoolAlloc(&cbp->pool);
+}
+
+/**
+ * @brief   Releases a control block.
+ * @details Control blocks provided by the application are ignored.
+ */
+static void cb_free(cb_pool_t *cbp, void *p) {
+
+  if (((uint8_t *)p >= cbp->base) && ((uint8_t *)p < cbp->end)) {
+    chPoolFree(&cbp->pool, p);
+  }
+}
+
+/**
+ * @brief   Periodic timers callback.
+ * @details One-shot timers invoke the application callback directly.
+ */
+static void timer_periodic_cb(void *p) {
+  cmsis_timer_t *tp = (cmsis_timer_t *)p;
+
+  chSysLockFromISR();
+  chVTDoSetI(&tp->vt, tp->period, timer_periodic_cb, p);
+  chSysUnlockFromISR();
+
+  tp->func(tp->argument);
+}
+
+/**
+ * @brief   Checks if an event flags condition is satisfied.
+ */
+static inline bool flags_match(uint32_t current, uint32_t flags,
+                               uint32_t options) {
+
+  if ((options & osFlagsWaitAll) != 0U) {
+    return (current & flags) == flags;
+  }
+  return (current & flags) != 0U;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Kernel initialization.
+ * @note    The calling thread runs at @p HIGHPRIO until the kernel is
+ *          started so that created threads are not scheduled.
+ *
+ * @return                          The function execution status.
+ */
+osStatus_t osKernelInitialize(void) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (kernel_state != osKernelInactive) {
+    return osError;
+  }
+
+  chSysInit();
+  chThdSetPriority(HIGHPRIO);
+
+#if CMSIS_CFG_NUM_TIMERS > 0
+  cb_pool_init(&timers_pool, timers, sizeof (cmsis_timer_t),
+               CMSIS_CFG_NUM_TIMERS);
+#else
+  cb_pool_init(&timers_pool, NULL, sizeof (cmsis_timer_t), 0U);
+#endif
+#if CMSIS_CFG_NUM_EVENT_FLAGS > 0
+  cb_pool_init(&event_flags_pool, event_flags, sizeof (cmsis_event_flags_t),
+               CMSIS_CFG_NUM_EVENT_FLAGS);
+#else
+  cb_pool_init(&event_flags_pool, NULL, sizeof (cmsis_event_flags_t), 0U);
+#endif
+#if CMSIS_CFG_NUM_MUTEXES > 0
+  cb_pool_init(&mutexes_pool, mutexes, sizeof (mutex_t),
+               CMSIS_CFG_NUM_MUTEXES);
+#else
+  cb_pool_init(&mutexes_pool, NULL, sizeof (mutex_t), 0U);
+#endif
+#if CMSIS_CFG_NUM_SEMAPHORES > 0
+  cb_pool_init(&semaphores_pool, semaphores, sizeof (cmsis_semaphore_t),
+               CMSIS_CFG_NUM_SEMAPHORES);
+#else
+  cb_pool_init(&semaphores_pool, NULL, sizeof (cmsis_semaphore_t), 0U);
+#endif
+#if CMSIS_CFG_NUM_MEMORY_POOLS > 0
+  cb_pool_init(&memory_pools_pool, memory_pools,
+               sizeof (cmsis_memory_pool_t), CMSIS_CFG_NUM_MEMORY_POOLS);
+#else
+  cb_pool_init(&memory_pools_pool, NULL, sizeof (cmsis_memory_pool_t), 0U);
+#endif
+#if CMSIS_CFG_NUM_MESSAGE_QUEUES > 0
+  cb_pool_init(&message_queues_pool, message_queues,
+               sizeof (cmsis_message_queue_t), CMSIS_CFG_NUM_MESSAGE_QUEUES);
+#else
+  cb_pool_init(&message_queues_pool, NULL,
+               sizeof (cmsis_message_queue_t), 0U);
+#endif
+
+  kernel_state = osKernelReady;
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the kernel information.
+ *
+ * @param[out] version              pointer to the version structure or
+ *                                  @p NULL
+ * @param[out] id_buf               buffer for the kernel identification
+ *                                  string or @p NULL
+ * @param[in] id_size               size of the buffer
+ * @return                          The function execution status.
+ */
+osStatus_t osKernelGetInfo(osVersion_t *version, char *id_buf,
+                           uint32_t id_size) {
+
+  if (version != NULL) {
+    version->api    = osCMSIS_API_VERSION;
+    version->kernel = ((uint32_t)CH_KERNEL_MAJOR * 10000000U) +
+                      ((uint32_t)CH_KERNEL_MINOR * 10000U) +
+                      (uint32_t)CH_KERNEL_PATCH;
+  }
+
+  if ((id_buf != NULL) && (id_size > 0U)) {
+    strncpy(id_buf, osCMSIS_KERNEL_ID, (size_t)id_size - 1U);
+    id_buf[id_size - 1U] = '\0';
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the kernel state.
+ *
+ * @return                          The kernel state.
+ */
+osKernelState_t osKernelGetState(void) {
+
+  return kernel_state;
+}
+
+/**
+ * @brief   Kernel start.
+ * @details The calling thread lowers its priority and sleeps forever, the
+ *          function does not return on success.
+ *
+ * @return                          The function execution status.
+ */
+osStatus_t osKernelStart(void) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (kernel_state != osKernelReady) {
+    return osError;
+  }
+
+  kernel_state = osKernelRunning;
+
+  chThdSetPriority(LOWPRIO);
+  while (true) {
+    chThdSleep(TIME_INFINITE);
+  }
+
+  return osError;
+}
+
+/**
+ * @brief   Creates a thread.
+ * @details If @p stack_mem is specified the thread is created statically
+ *          in that working area, else the working area is allocated from
+ *          the heap.
+ *
+ * @param[in] func                  the thread function
+ * @param[in] argument              argument for the thread function
+ * @param[in] attr                  thread attributes or @p NULL
+ * @return                          The thread identifier.
+ * @retval NULL                     if the function failed.
+ */
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument,
+                         const osThreadAttr_t *attr) {
+  const char *name = NULL;
+  tprio_t prio = NORMALPRIO;
+  uint32_t attr_bits = osThreadDetached;
+  thread_t *tp;
+
+  if ((func == NULL) || port_is_isr_context()) {
+    return NULL;
+  }
+
+  if (attr != NULL) {
+    name      = attr->name;
+    attr_bits = attr->attr_bits;
+    if (attr->priority != osPriorityNone) {
+      if ((attr->priority < osPriorityIdle) ||
+          (attr->priority > osPriorityISR)) {
+        return NULL;
+      }
+      prio = prio_to_kernel(attr->priority);
+    }
+  }
+
+  if ((attr != NULL) && (attr->stack_mem != NULL)) {
+    thread_descriptor_t td = {
+      .name  = name,
+      .wbase = (stkalign_t *)attr->stack_mem,
+      .wend  = (stkalign_t *)((uint8_t *)attr->stack_mem +
+                              attr->stack_size),
+      .prio  = prio,
+      .funcp = func,
+      .arg   = argument
+    };
+
+    if ((attr->stack_size < THD_WORKING_AREA_SIZE(0)) ||
+        !MEM_IS_ALIGNED(attr->stack_mem, PORT_WORKING_AREA_ALIGN) ||
+        !MEM_IS_ALIGNED(attr->stack_size, PORT_STACK_ALIGN)) {
+      return NULL;
+    }
+
+    tp = chThdCreate(&td);
+  }
+  else {
+#if (CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_HEAP == TRUE)
+    size_t size = CMSIS_CFG_DEFAULT_STACK;
+
+    if ((attr != NULL) && (attr->stack_size != 0U)) {
+      size = (size_t)attr->stack_size;
+    }
+    tp = chThdCreateFromHeap(NULL, THD_WORKING_AREA_SIZE(size),
+                             name, prio, func, argument);
+    if (tp == NULL) {
+      return NULL;
+    }
+#else
+    return NULL;
+#endif
+  }
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  /* Detached threads do not keep a reference, memory is released on
+     exit.*/
+  if ((attr_bits & osThreadJoinable) == 0U) {
+    chThdRelease(tp);
+  }
+#else
+  (void)attr_bits;
+#endif
+
+  return tp;
+}
+
+/**
+ * @brief   Returns the name of a thread.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The thread name.
+ * @retval NULL                     if the name is not available.
+ */
+const char *osThreadGetName(osThreadId_t thread_id) {
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  if (thread_id == NULL) {
+    return NULL;
+  }
+
+  return thread_id->name;
+#else
+  (void)thread_id;
+
+  return NULL;
+#endif
+}
+
+/**
+ * @brief   Returns the state of a thread.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The thread state.
+ */
+osThreadState_t osThreadGetState(osThreadId_t thread_id) {
+
+  if (thread_id == NULL) {
+    return osThreadError;
+  }
+
+  switch (thread_id->state) {
+  case CH_STATE_CURRENT:
+    return osThreadRunning;
+  case CH_STATE_READY:
+    return osThreadReady;
+  case CH_STATE_WTSTART:
+    return osThreadInactive;
+  case CH_STATE_FINAL:
+    return osThreadTerminated;
+  default:
+    return osThreadBlocked;
+  }
+}
+
+/**
+ * @brief   Changes a thread priority.
+ * @note    This can interfere with the priority inheritance mechanism.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @param[in] priority              new priority level
+ * @return                          The function execution status.
+ */
+osStatus_t osThreadSetPriority(osThreadId_t thread_id,
+                               osPriority_t priority) {
+  thread_t *tp = (thread_t *)thread_id;
+  tprio_t newprio;
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if ((tp == NULL) ||
+      (priority < osPriorityIdle) || (priority > osPriorityISR)) {
+    return osErrorParameter;
+  }
+
+  newprio = prio_to_kernel(priority);
+
+  chSysLock();
+
+  if (tp->state == CH_STATE_FINAL) {
+    chSysUnlock();
+    return osErrorResource;
+  }
+
+  /* Changing priority.*/
+  if ((tp->hdr.pqueue.prio == tp->realprio) ||
+      (newprio > tp->hdr.pqueue.prio)) {
+    tp->hdr.pqueue.prio = newprio;
+  }
+  tp->realprio = newprio;
+
+  /* The following states need priority queues reordering.*/
+  switch (tp->state) {
+  case CH_STATE_WTMTX:
+#if CH_CFG_USE_CONDVARS
+  case CH_STATE_WTCOND:
+#endif
+#if CH_CFG_USE_SEMAPHORES_PRIORITY
+  case CH_STATE_WTSEM:
+#endif
+#if CH_CFG_USE_MESSAGES && CH_CFG_USE_MESSAGES_PRIORITY
+  case CH_STATE_SNDMSGQ:
+#endif
+    /* Re-enqueues tp with its new priority on the queue.*/
+    ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue),
+                       (ch_queue_t *)tp->u.wtobjp);
+    break;
+  case CH_STATE_READY:
+#if CH_DBG_ENABLE_ASSERTS
+    /* Prevents an assertion in chSchReadyI().*/
+    tp->state = CH_STATE_CURRENT;
+#endif
+    /* Re-enqueues tp with its new priority on the ready list.*/
+    chSchReadyI((thread_t *)ch_queue_dequeue(&tp->hdr.queue));
+    break;
+  default:
+    break;
+  }
+
+  /* Rescheduling.*/
+  chSchRescheduleS();
+
+  chSysUnlock();
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the priority of a thread.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The thread priority.
+ */
+osPriority_t osThreadGetPriority(osThreadId_t thread_id) {
+
+  if ((thread_id == NULL) || port_is_isr_context()) {
+    return osPriorityError;
+  }
+
+  return (osPriority_t)((int32_t)osPriorityNormal +
+                        ((int32_t)thread_id->realprio - (int32_t)NORMALPRIO));
+}
+
+/**
+ * @brief   Detaches a joinable thread.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osThreadDetach(osThreadId_t thread_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (thread_id == NULL) {
+    return osErrorParameter;
+  }
+
+#if CH_CFG_USE_REGISTRY == TRUE
+  chThdRelease(thread_id);
+
+  return osOK;
+#else
+  return osErrorResource;
+#endif
+}
+
+/**
+ * @brief   Waits for the termination of a joinable thread.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osThreadJoin(osThreadId_t thread_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if ((thread_id == NULL) || (thread_id == chThdGetSelfX())) {
+    return osErrorParameter;
+  }
+
+#if CH_CFG_USE_WAITEXIT == TRUE
+  (void)chThdWait(thread_id);
+
+  return osOK;
+#else
+  return osErrorResource;
+#endif
+}
+
+/**
+ * @brief   Terminates the current thread.
+ */
+void osThreadExit(void) {
+
+  chThdExit(MSG_OK);
+
+  /* Not reached.*/
+  while (true) {
+  }
+}
+
+/**
+ * @brief   Thread termination.
+ * @note    Other threads are not really terminated but asked to terminate,
+ *          which is not compliant. The termination request can be checked
+ *          using @p chThdShouldTerminateX().
+ *
+ * @param[in] thread_id             a thread identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osThreadTerminate(osThreadId_t thread_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (thread_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (thread_id == chThdGetSelfX()) {
+    osThreadExit();
+  }
+
+  chThdTerminate(thread_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Sets flags of a thread.
+ * @note    Thread flags are the thread events.
+ *
+ * @param[in] thread_id             a thread identifier
+ * @param[in] flags                 flags to be set
+ * @return                          The thread flags after setting.
+ */
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+  uint32_t current;
+  syssts_t sts;
+
+  if ((thread_id == NULL) || ((flags & osFlagsError) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  chEvtSignalI(thread_id, (eventmask_t)flags);
+  current = (uint32_t)thread_id->epending;
+  if (!port_is_isr_context()) {
+    chSchRescheduleS();
+  }
+  chSysRestoreStatusX(sts);
+
+  return current;
+}
+
+/**
+ * @brief   Clears flags of the current thread.
+ *
+ * @param[in] flags                 flags to be cleared
+ * @return                          The thread flags before clearing.
+ */
+uint32_t osThreadFlagsClear(uint32_t flags) {
+  thread_t *tp = chThdGetSelfX();
+  uint32_t current;
+
+  if (port_is_isr_context()) {
+    return osFlagsErrorISR;
+  }
+
+  if ((flags & osFlagsError) != 0U) {
+    return osFlagsErrorParameter;
+  }
+
+  chSysLock();
+  current = (uint32_t)tp->epending;
+  tp->epending &= ~(eventmask_t)flags;
+  chSysUnlock();
+
+  return current;
+}
+
+/**
+ * @brief   Returns the flags of the current thread.
+ *
+ * @return                          The thread flags.
+ */
+uint32_t osThreadFlagsGet(void) {
+
+  if (port_is_isr_context()) {
+    return 0U;
+  }
+
+  return (uint32_t)chThdGetSelfX()->epending;
+}
+
+/**
+ * @brief   Waits for flags of the current thread.
+ *
+ * @param[in] flags                 flags to wait for
+ * @param[in] options               wait options
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The thread flags before clearing.
+ */
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options,
+                           uint32_t timeout) {
+  eventmask_t events;
+
+  if (port_is_isr_context()) {
+    return osFlagsErrorISR;
+  }
+
+  if ((flags == 0U) || ((flags & osFlagsError) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+
+  if ((options & osFlagsWaitAll) != 0U) {
+    events = chEvtWaitAllTimeout((eventmask_t)flags, tmo(timeout));
+  }
+  else {
+    events = chEvtWaitAnyTimeout((eventmask_t)flags, tmo(timeout));
+  }
+
+  if (events == (eventmask_t)0) {
+    return timeout == 0U ? osFlagsErrorResource : osFlagsErrorTimeout;
+  }
+
+  if ((options & osFlagsNoClear) != 0U) {
+    chEvtAddEvents(events);
+  }
+
+  return (uint32_t)events;
+}
+
+/**
+ * @brief   Creates a one-shot or periodic timer.
+ *
+ * @param[in] func                  the timer callback function
+ * @param[in] type                  @p osTimerOnce or @p osTimerPeriodic
+ * @param[in] argument              argument for the timer callback function
+ * @param[in] attr                  timer attributes or @p NULL
+ * @return                          The timer identifier.
+ * @retval NULL                     if the function failed.
+ */
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type,
+                       void *argument, const osTimerAttr_t *attr) {
+  cmsis_timer_t *tp;
+
+  if ((func == NULL) || port_is_isr_context()) {
+    return NULL;
+  }
+
+  tp = cb_alloc(&timers_pool,
+                attr != NULL ? attr->cb_mem : NULL,
+                attr != NULL ? attr->cb_size : 0U);
+  if (tp == NULL) {
+    return NULL;
+  }
+
+  chVTObjectInit(&tp->vt);
+  tp->func     = func;
+  tp->argument = argument;
+  tp->type     = type;
+  tp->period   = (sysinterval_t)0;
+
+  return tp;
+}
+
+/**
+ * @brief   Starts or restarts a timer.
+ *
+ * @param[in] timer_id              a timer identifier
+ * @param[in] ticks                 time delay value of the timer
+ * @return                          The function execution status.
+ */
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if ((timer_id == NULL) || (ticks == 0U) || (ticks == osWaitForever)) {
+    return osErrorParameter;
+  }
+
+  timer_id->period = (sysinterval_t)ticks;
+  if (timer_id->type == osTimerPeriodic) {
+    chVTSet(&timer_id->vt, (sysinterval_t)ticks, timer_periodic_cb,
+            timer_id);
+  }
+  else {
+    chVTSet(&timer_id->vt, (sysinterval_t)ticks, timer_id->func,
+            timer_id->argument);
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief   Stops a timer.
+ *
+ * @param[in] timer_id              a timer identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osTimerStop(osTimerId_t timer_id) {
+  osStatus_t status = osOK;
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (timer_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chSysLock();
+  if (chVTIsArmedI(&timer_id->vt)) {
+    chVTDoResetI(&timer_id->vt);
+  }
+  else {
+    status = osErrorResource;
+  }
+  chSysUnlock();
+
+  return status;
+}
+
+/**
+ * @brief   Checks if a timer is running.
+ *
+ * @param[in] timer_id              a timer identifier
+ * @return                          Zero if the timer is not running.
+ */
+uint32_t osTimerIsRunning(osTimerId_t timer_id) {
+
+  if ((timer_id == NULL) || port_is_isr_context()) {
+    return 0U;
+  }
+
+  return chVTIsArmed(&timer_id->vt) ? 1U : 0U;
+}
+
+/**
+ * @brief   Deletes a timer.
+ *
+ * @param[in] timer_id              a timer identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osTimerDelete(osTimerId_t timer_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (timer_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chVTReset(&timer_id->vt);
+  cb_free(&timers_pool, timer_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Creates an event flags object.
+ *
+ * @param[in] attr                  event flags attributes or @p NULL
+ * @return                          The event flags identifier.
+ * @retval NULL                     if the function failed.
+ */
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr) {
+  cmsis_event_flags_t *efp;
+
+  if (port_is_isr_context()) {
+    return NULL;
+  }
+
+  efp = cb_alloc(&event_flags_pool,
+                 attr != NULL ? attr->cb_mem : NULL,
+                 attr != NULL ? attr->cb_size : 0U);
+  if (efp == NULL) {
+    return NULL;
+  }
+
+  chThdQueueObjectInit(&efp->queue);
+  efp->flags = 0U;
+
+  return efp;
+}
+
+/**
+ * @brief   Sets event flags.
+ * @details All the waiting threads are woken up and check their condition.
+ *
+ * @param[in] ef_id                 an event flags identifier
+ * @param[in] flags                 flags to be set
+ * @return                          The event flags after setting.
+ */
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags) {
+  uint32_t current;
+  syssts_t sts;
+
+  if ((ef_id == NULL) || ((flags & osFlagsError) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  ef_id->flags |= flags;
+  current = ef_id->flags;
+  chThdDequeueAllI(&ef_id->queue, MSG_OK);
+  if (!port_is_isr_context()) {
+    chSchRescheduleS();
+  }
+  chSysRestoreStatusX(sts);
+
+  return current;
+}
+
+/**
+ * @brief   Clears event flags.
+ *
+ * @param[in] ef_id                 an event flags identifier
+ * @param[in] flags                 flags to be cleared
+ * @return                          The event flags before clearing.
+ */
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags) {
+  uint32_t current;
+  syssts_t sts;
+
+  if ((ef_id == NULL) || ((flags & osFlagsError) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  current = ef_id->flags;
+  ef_id->flags &= ~flags;
+  chSysRestoreStatusX(sts);
+
+  return current;
+}
+
+/**
+ * @brief   Returns the event flags.
+ *
+ * @param[in] ef_id                 an event flags identifier
+ * @return                          The event flags.
+ */
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id) {
+
+  if (ef_id == NULL) {
+    return 0U;
+  }
+
+  return ef_id->flags;
+}
+
+/**
+ * @brief   Waits for event flags.
+ *
+ * @param[in] ef_id                 an event flags identifier
+ * @param[in] flags                 flags to wait for
+ * @param[in] options               wait options
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The event flags before clearing.
+ */
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags,
+                          uint32_t options, uint32_t timeout) {
+  sysinterval_t interval = tmo(timeout);
+  systime_t start;
+  uint32_t current;
+
+  if ((ef_id == NULL) || (flags == 0U) || ((flags & osFlagsError) != 0U)) {
+    return osFlagsErrorParameter;
+  }
+
+  if (port_is_isr_context()) {
+    syssts_t sts;
+
+    if (timeout != 0U) {
+      return osFlagsErrorParameter;
+    }
+
+    sts = chSysGetStatusAndLockX();
+    current = ef_id->flags;
+    if (!flags_match(current, flags, options)) {
+      chSysRestoreStatusX(sts);
+      return osFlagsErrorResource;
+    }
+    if ((options & osFlagsNoClear) == 0U) {
+      ef_id->flags &= ~flags;
+    }
+    chSysRestoreStatusX(sts);
+
+    return current;
+  }
+
+  chSysLock();
+  start = chVTGetSystemTimeX();
+  while (!flags_match(ef_id->flags, flags, options)) {
+    sysinterval_t remaining = interval;
+
+    if (interval == TIME_IMMEDIATE) {
+      chSysUnlock();
+      return osFlagsErrorResource;
+    }
+
+    /* Waiting for the remaining time, woken threads check again their
+       condition.*/
+    if (interval != TIME_INFINITE) {
+      sysinterval_t elapsed = chTimeDiffX(start, chVTGetSystemTimeX());
+
+      if (elapsed >= interval) {
+        chSysUnlock();
+        return osFlagsErrorTimeout;
+      }
+      remaining = interval - elapsed;
+    }
+
+    if (chThdEnqueueTimeoutS(&ef_id->queue, remaining) == MSG_TIMEOUT) {
+      chSysUnlock();
+      return osFlagsErrorTimeout;
+    }
+  }
+
+  current = ef_id->flags;
+  if ((options & osFlagsNoClear) == 0U) {
+    ef_id->flags &= ~flags;
+  }
+  chSysUnlock();
+
+  return current;
+}
+
+/**
+ * @brief   Deletes an event flags object.
+ * @note    Waiting threads are released with an error.
+ *
+ * @param[in] ef_id                 an event flags identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (ef_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chSysLock();
+  chThdDequeueAllI(&ef_id->queue, MSG_TIMEOUT);
+  chSchRescheduleS();
+  chSysUnlock();
+
+  cb_free(&event_flags_pool, ef_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Creates a mutex.
+ * @note    Mutexes always use priority inheritance, recursive mutexes
+ *          require @p CH_CFG_USE_MUTEXES_RECURSIVE.
+ *
+ * @param[in] attr                  mutex attributes or @p NULL
+ * @return                          The mutex identifier.
+ * @retval NULL                     if the function failed.
+ */
+osMutexId_t osMutexNew(const osMutexAttr_t *attr) {
+  mutex_t *mp;
+
+  if (port_is_isr_context()) {
+    return NULL;
+  }
+
+#if CH_CFG_USE_MUTEXES_RECURSIVE == FALSE
+  if ((attr != NULL) && ((attr->attr_bits & osMutexRecursive) != 0U)) {
+    return NULL;
+  }
+#endif
+
+  mp = cb_alloc(&mutexes_pool,
+                attr != NULL ? attr->cb_mem : NULL,
+                attr != NULL ? attr->cb_size : 0U);
+  if (mp == NULL) {
+    return NULL;
+  }
+
+  chMtxObjectInit(mp);
+
+  return mp;
+}
+
+/**
+ * @brief   Acquires a mutex.
+ * @note    Kernel mutexes do not support timeouts, finite timeouts are
+ *          handled as @p osWaitForever after a failed immediate attempt.
+ *
+ * @param[in] mutex_id              a mutex identifier
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The function execution status.
+ */
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (mutex_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (timeout == 0U) {
+    return chMtxTryLock(mutex_id) ? osOK : osErrorResource;
+  }
+
+  chMtxLock(mutex_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Releases a mutex.
+ *
+ * @param[in] mutex_id              a mutex identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (mutex_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (mutex_id->owner != chThdGetSelfX()) {
+    return osErrorResource;
+  }
+
+  chMtxUnlock(mutex_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the owner of a mutex.
+ *
+ * @param[in] mutex_id              a mutex identifier
+ * @return                          The owner thread.
+ * @retval NULL                     if the mutex is not locked.
+ */
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id) {
+
+  if ((mutex_id == NULL) || port_is_isr_context()) {
+    return NULL;
+  }
+
+  return mutex_id->owner;
+}
+
+/**
+ * @brief   Deletes a mutex.
+ * @note    The mutex must not be locked.
+ *
+ * @param[in] mutex_id              a mutex identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osMutexDelete(osMutexId_t mutex_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (mutex_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (mutex_id->owner != NULL) {
+    return osErrorResource;
+  }
+
+  cb_free(&mutexes_pool, mutex_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Creates a semaphore.
+ *
+ * @param[in] max_count             maximum number of tokens
+ * @param[in] initial_count         initial number of tokens
+ * @param[in] attr                  semaphore attributes or @p NULL
+ * @return                          The semaphore identifier.
+ * @retval NULL                     if the function failed.
+ */
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count,
+                               const osSemaphoreAttr_t *attr) {
+  cmsis_semaphore_t *sp;
+
+  if (port_is_isr_context() ||
+      (max_count == 0U) || (max_count > 0x7FFFFFFFU) ||
+      (initial_count > max_count)) {
+    return NULL;
+  }
+
+  sp = cb_alloc(&semaphores_pool,
+                attr != NULL ? attr->cb_mem : NULL,
+                attr != NULL ? attr->cb_size : 0U);
+  if (sp == NULL) {
+    return NULL;
+  }
+
+  chSemObjectInit(&sp->sem, (cnt_t)initial_count);
+  sp->max = (cnt_t)max_count;
+
+  return sp;
+}
+
+/**
+ * @brief   Acquires a semaphore token.
+ *
+ * @param[in] semaphore_id          a semaphore identifier
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The function execution status.
+ */
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id,
+                              uint32_t timeout) {
+  msg_t msg;
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  if (port_is_isr_context()) {
+    syssts_t sts;
+
+    if (timeout != 0U) {
+      return osErrorParameter;
+    }
+
+    sts = chSysGetStatusAndLockX();
+    if (chSemGetCounterI(&semaphore_id->sem) > (cnt_t)0) {
+      chSemFastWaitI(&semaphore_id->sem);
+      msg = MSG_OK;
+    }
+    else {
+      msg = MSG_TIMEOUT;
+    }
+    chSysRestoreStatusX(sts);
+  }
+  else {
+    msg = chSemWaitTimeout(&semaphore_id->sem, tmo(timeout));
+  }
+
+  if (msg == MSG_OK) {
+    return osOK;
+  }
+  if ((msg == MSG_TIMEOUT) && (timeout != 0U)) {
+    return osErrorTimeout;
+  }
+  return osErrorResource;
+}
+
+/**
+ * @brief   Releases a semaphore token.
+ *
+ * @param[in] semaphore_id          a semaphore identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+  osStatus_t status = osOK;
+  syssts_t sts;
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  if (chSemGetCounterI(&semaphore_id->sem) >= semaphore_id->max) {
+    status = osErrorResource;
+  }
+  else {
+    chSemSignalI(&semaphore_id->sem);
+    if (!port_is_isr_context()) {
+      chSchRescheduleS();
+    }
+  }
+  chSysRestoreStatusX(sts);
+
+  return status;
+}
+
+/**
+ * @brief   Returns the number of available tokens.
+ *
+ * @param[in] semaphore_id          a semaphore identifier
+ * @return                          The number of available tokens.
+ */
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id) {
+  cnt_t cnt;
+
+  if (semaphore_id == NULL) {
+    return 0U;
+  }
+
+  cnt = semaphore_id->sem.cnt;
+
+  return cnt > (cnt_t)0 ? (uint32_t)cnt : 0U;
+}
+
+/**
+ * @brief   Deletes a semaphore.
+ * @note    Waiting threads are released with an error.
+ *
+ * @param[in] semaphore_id          a semaphore identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (semaphore_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chSemReset(&semaphore_id->sem, (cnt_t)0);
+  cb_free(&semaphores_pool, semaphore_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Creates a memory pool.
+ * @details The blocks are taken from @p mp_mem if specified else they are
+ *          allocated from the heap.
+ *
+ * @param[in] block_count           number of blocks
+ * @param[in] block_size            size of a block
+ * @param[in] attr                  memory pool attributes or @p NULL
+ * @return                          The memory pool identifier.
+ * @retval NULL                     if the function failed.
+ */
+osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size,
+                                 const osMemoryPoolAttr_t *attr) {
+  size_t objsize = MEM_ALIGN_NEXT((size_t)block_size, PORT_NATURAL_ALIGN);
+  size_t size = objsize * (size_t)block_count;
+  cmsis_memory_pool_t *mpp;
+  void *mem, *heap_mem = NULL;
+
+  if (port_is_isr_context() || (block_count == 0U) || (block_size == 0U)) {
+    return NULL;
+  }
+
+  if ((attr != NULL) && (attr->mp_mem != NULL)) {
+    if (((size_t)attr->mp_size < size) ||
+        !MEM_IS_ALIGNED(attr->mp_mem, PORT_NATURAL_ALIGN)) {
+      return NULL;
+    }
+    mem = attr->mp_mem;
+  }
+  else {
+#if CH_CFG_USE_HEAP == TRUE
+    heap_mem = chHeapAllocAligned(NULL, size, PORT_NATURAL_ALIGN);
+    if (heap_mem == NULL) {
+      return NULL;
+    }
+    mem = heap_mem;
+#else
+    return NULL;
+#endif
+  }
+
+  mpp = cb_alloc(&memory_pools_pool,
+                 attr != NULL ? attr->cb_mem : NULL,
+                 attr != NULL ? attr->cb_size : 0U);
+  if (mpp == NULL) {
+#if CH_CFG_USE_HEAP == TRUE
+    if (heap_mem != NULL) {
+      chHeapFree(heap_mem);
+    }
+#endif
+    return NULL;
+  }
+
+  chGuardedPoolObjectInitAligned(&mpp->pool, objsize, PORT_NATURAL_ALIGN);
+  chGuardedPoolLoadArray(&mpp->pool, mem, (size_t)block_count);
+  mpp->capacity = block_count;
+  mpp->heap_mem = heap_mem;
+
+  return mpp;
+}
+
+/**
+ * @brief   Allocates a memory block.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The pointer to the allocated block.
+ * @retval NULL                     if the function failed.
+ */
+void *osMemoryPoolAlloc(osMemoryPoolId_t mp_id, uint32_t timeout) {
+  void *block;
+
+  if (mp_id == NULL) {
+    return NULL;
+  }
+
+  if (port_is_isr_context()) {
+    syssts_t sts;
+
+    if (timeout != 0U) {
+      return NULL;
+    }
+
+    sts = chSysGetStatusAndLockX();
+    block = chGuardedPoolAllocI(&mp_id->pool);
+    chSysRestoreStatusX(sts);
+  }
+  else {
+    block = chGuardedPoolAllocTimeout(&mp_id->pool, tmo(timeout));
+  }
+
+  return block;
+}
+
+/**
+ * @brief   Returns a memory block to a memory pool.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @param[in] block                 pointer to the block
+ * @return                          The function execution status.
+ */
+osStatus_t osMemoryPoolFree(osMemoryPoolId_t mp_id, void *block) {
+  syssts_t sts;
+
+  if ((mp_id == NULL) || (block == NULL)) {
+    return osErrorParameter;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  if ((uint32_t)chGuardedPoolGetCounterI(&mp_id->pool) >= mp_id->capacity) {
+    chSysRestoreStatusX(sts);
+    return osErrorResource;
+  }
+  chGuardedPoolFreeI(&mp_id->pool, block);
+  if (!port_is_isr_context()) {
+    chSchRescheduleS();
+  }
+  chSysRestoreStatusX(sts);
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the number of blocks of a memory pool.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @return                          The number of blocks.
+ */
+uint32_t osMemoryPoolGetCapacity(osMemoryPoolId_t mp_id) {
+
+  if (mp_id == NULL) {
+    return 0U;
+  }
+
+  return mp_id->capacity;
+}
+
+/**
+ * @brief   Returns the blocks size of a memory pool.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @return                          The blocks size.
+ */
+uint32_t osMemoryPoolGetBlockSize(osMemoryPoolId_t mp_id) {
+
+  if (mp_id == NULL) {
+    return 0U;
+  }
+
+  return (uint32_t)mp_id->pool.pool.object_size;
+}
+
+/**
+ * @brief   Returns the number of allocated blocks.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @return                          The number of allocated blocks.
+ */
+uint32_t osMemoryPoolGetCount(osMemoryPoolId_t mp_id) {
+
+  if (mp_id == NULL) {
+    return 0U;
+  }
+
+  return mp_id->capacity - osMemoryPoolGetSpace(mp_id);
+}
+
+/**
+ * @brief   Returns the number of free blocks.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @return                          The number of free blocks.
+ */
+uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id) {
+  cnt_t cnt;
+
+  if (mp_id == NULL) {
+    return 0U;
+  }
+
+  cnt = mp_id->pool.sem.cnt;
+
+  return cnt > (cnt_t)0 ? (uint32_t)cnt : 0U;
+}
+
+/**
+ * @brief   Deletes a memory pool.
+ * @note    Waiting threads are released with an error.
+ *
+ * @param[in] mp_id                 a memory pool identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (mp_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chSemReset(&mp_id->pool.sem, (cnt_t)0);
+#if CH_CFG_USE_HEAP == TRUE
+  if (mp_id->heap_mem != NULL) {
+    chHeapFree(mp_id->heap_mem);
+  }
+#endif
+  cb_free(&memory_pools_pool, mp_id);
+
+  return osOK;
+}
+
+/**
+ * @brief   Creates a message queue.
+ * @details Messages are objects of an objects FIFO, the storage is taken
+ *          from @p mq_mem if specified else it is allocated from the heap.
+ * @note    Messages priorities are not supported, messages are always
+ *          queued in FIFO order.
+ *
+ * @param[in] msg_count             number of messages
+ * @param[in] msg_size              size of a message
+ * @param[in] attr                  message queue attributes or @p NULL
+ * @return                          The message queue identifier.
+ * @retval NULL                     if the function failed.
+ */
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
+                                     const osMessageQueueAttr_t *attr) {
+  size_t objsize = MEM_ALIGN_NEXT((size_t)msg_size, PORT_NATURAL_ALIGN);
+  size_t size = CMSIS_MESSAGE_QUEUE_MEM_SIZE((size_t)msg_count,
+                                             (size_t)msg_size);
+  cmsis_message_queue_t *mqp;
+  void *mem, *heap_mem = NULL;
+
+  if (port_is_isr_context() || (msg_count == 0U) || (msg_size == 0U)) {
+    return NULL;
+  }
+
+  if ((attr != NULL) && (attr->mq_mem != NULL)) {
+    if (((size_t)attr->mq_size < size) ||
+        !MEM_IS_ALIGNED(attr->mq_mem, PORT_NATURAL_ALIGN)) {
+      return NULL;
+    }
+    mem = attr->mq_mem;
+  }
+  else {
+#if CH_CFG_USE_HEAP == TRUE
+    heap_mem = chHeapAllocAligned(NULL, size, PORT_NATURAL_ALIGN);
+    if (heap_mem == NULL) {
+      return NULL;
+    }
+    mem = heap_mem;
+#else
+    return NULL;
+#endif
+  }
+
+  mqp = cb_alloc(&message_queues_pool,
+                 attr != NULL ? attr->cb_mem : NULL,
+                 attr != NULL ? attr->cb_size : 0U);
+  if (mqp == NULL) {
+#if CH_CFG_USE_HEAP == TRUE
+    if (heap_mem != NULL) {
+      chHeapFree(heap_mem);
+    }
+#endif
+    return NULL;
+  }
+
+  chFifoObjectInitAligned(&mqp->fifo, objsize, (size_t)msg_count,
+                          PORT_NATURAL_ALIGN, mem,
+                          (msg_t *)((uint8_t *)mem +
+                                    (objsize * (size_t)msg_count)));
+  mqp->capacity = msg_count;
+  mqp->msg_size = msg_size;
+  mqp->heap_mem = heap_mem;
+
+  return mqp;
+}
+
+/**
+ * @brief   Puts a message in a message queue.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @param[in] msg_ptr               pointer to the message
+ * @param[in] msg_prio              message priority, ignored
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The function execution status.
+ */
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr,
+                             uint8_t msg_prio, uint32_t timeout) {
+  void *objp;
+
+  (void)msg_prio;
+
+  if ((mq_id == NULL) || (msg_ptr == NULL)) {
+    return osErrorParameter;
+  }
+
+  if (port_is_isr_context()) {
+    if (timeout != 0U) {
+      return osErrorParameter;
+    }
+
+    chSysLockFromISR();
+    objp = chFifoTakeObjectI(&mq_id->fifo);
+    if (objp != NULL) {
+      memcpy(objp, msg_ptr, (size_t)mq_id->msg_size);
+      chFifoSendObjectI(&mq_id->fifo, objp);
+    }
+    chSysUnlockFromISR();
+  }
+  else {
+    objp = chFifoTakeObjectTimeout(&mq_id->fifo, tmo(timeout));
+    if (objp != NULL) {
+      memcpy(objp, msg_ptr, (size_t)mq_id->msg_size);
+      chFifoSendObject(&mq_id->fifo, objp);
+    }
+  }
+
+  if (objp == NULL) {
+    return timeout == 0U ? osErrorResource : osErrorTimeout;
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief   Gets a message from a message queue.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @param[out] msg_ptr              pointer to the message buffer
+ * @param[out] msg_prio             message priority or @p NULL, always zero
+ * @param[in] timeout               timeout in system ticks
+ * @return                          The function execution status.
+ */
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr,
+                             uint8_t *msg_prio, uint32_t timeout) {
+  void *objp;
+  msg_t msg;
+
+  if ((mq_id == NULL) || (msg_ptr == NULL)) {
+    return osErrorParameter;
+  }
+
+  if (port_is_isr_context()) {
+    if (timeout != 0U) {
+      return osErrorParameter;
+    }
+
+    chSysLockFromISR();
+    msg = chFifoReceiveObjectI(&mq_id->fifo, &objp);
+    if (msg == MSG_OK) {
+      memcpy(msg_ptr, objp, (size_t)mq_id->msg_size);
+      chFifoReturnObjectI(&mq_id->fifo, objp);
+    }
+    chSysUnlockFromISR();
+  }
+  else {
+    msg = chFifoReceiveObjectTimeout(&mq_id->fifo, &objp, tmo(timeout));
+    if (msg == MSG_OK) {
+      memcpy(msg_ptr, objp, (size_t)mq_id->msg_size);
+      chFifoReturnObject(&mq_id->fifo, objp);
+    }
+  }
+
+  if (msg != MSG_OK) {
+    return timeout == 0U ? osErrorResource : osErrorTimeout;
+  }
+
+  if (msg_prio != NULL) {
+    *msg_prio = 0U;
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief   Returns the number of message slots of a message queue.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @return                          The number of message slots.
+ */
+uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id) {
+
+  if (mq_id == NULL) {
+    return 0U;
+  }
+
+  return mq_id->capacity;
+}
+
+/**
+ * @brief   Returns the messages size of a message queue.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @return                          The messages size.
+ */
+uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id) {
+
+  if (mq_id == NULL) {
+    return 0U;
+  }
+
+  return mq_id->msg_size;
+}
+
+/**
+ * @brief   Returns the number of queued messages.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @return                          The number of queued messages.
+ */
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id) {
+  uint32_t n;
+  syssts_t sts;
+
+  if (mq_id == NULL) {
+    return 0U;
+  }
+
+  sts = chSysGetStatusAndLockX();
+  n = (uint32_t)chMBGetUsedCountI(&mq_id->fifo.mbx);
+  chSysRestoreStatusX(sts);
+
+  return n;
+}
+
+/**
+ * @brief   Returns the number of free message slots.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @return                          The number of free message slots.
+ */
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id) {
+  cnt_t cnt;
+
+  if (mq_id == NULL) {
+    return 0U;
+  }
+
+  cnt = mq_id->fifo.free.sem.cnt;
+
+  return cnt > (cnt_t)0 ? (uint32_t)cnt : 0U;
+}
+
+/**
+ * @brief   Deletes a message queue.
+ * @note    Waiting threads are released with an error.
+ *
+ * @param[in] mq_id                 a message queue identifier
+ * @return                          The function execution status.
+ */
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (mq_id == NULL) {
+    return osErrorParameter;
+  }
+
+  chSysLock();
+  chMBResetI(&mq_id->fifo.mbx);
+  chSemResetI(&mq_id->fifo.free.sem, (cnt_t)0);
+  chSchRescheduleS();
+  chSysUnlock();
+
+#if CH_CFG_USE_HEAP == TRUE
+  if (mq_id->heap_mem != NULL) {
+    chHeapFree(mq_id->heap_mem);
+  }
+#endif
+  cb_free(&message_queues_pool, mq_id);
+
+  return osOK;
+}
+
+/** @} */
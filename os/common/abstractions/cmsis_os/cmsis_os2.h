@@ -0,0 +1,630 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    cmsis_os2.h
+ * @brief   CMSIS RTOS2 module macros and structures.
+ * @details Objects identifiers point directly to the underlying kernel
+ *          objects, control blocks are provided by the application through
+ *          the @p cb_mem attribute or taken from static pools, the heap is
+ *          never used by the API except for creating objects without
+ *          application-provided storage.
+ * @note    This header cannot be included together with @p cmsis_os.h.
+ *
+ * @addtogroup CMSIS_OS2
+ * @{
+ */
+
+#ifndef CMSIS_OS2_H
+#define CMSIS_OS2_H
+
+#include "ch.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   API version.
+ */
+#define osCMSIS_API_VERSION         20010003U
+
+/**
+ * @brief   Kernel identification string.
+ */
+#define osCMSIS_KERNEL_ID           "ChibiOS/RT"
+
+/**
+ * @brief   Wait forever specification for timeouts.
+ */
+#define osWaitForever               0xFFFFFFFFU
+
+/**
+ * @name    Flags options
+ * @{
+ */
+#define osFlagsWaitAny              0x00000000U
+#define osFlagsWaitAll              0x00000001U
+#define osFlagsNoClear              0x00000002U
+/** @} */
+
+/**
+ * @name    Flags error codes
+ * @{
+ */
+#define osFlagsError                0x80000000U
+#define osFlagsErrorUnknown         0xFFFFFFFFU
+#define osFlagsErrorTimeout         0xFFFFFFFEU
+#define osFlagsErrorResource        0xFFFFFFFDU
+#define osFlagsErrorParameter       0xFFFFFFFCU
+#define osFlagsErrorISR             0xFFFFFFFAU
+/** @} */
+
+/**
+ * @name    Objects attributes
+ * @{
+ */
+#define osThreadDetached            0x00000000U
+#define osThreadJoinable            0x00000001U
+#define osMutexRecursive            0x00000001U
+#define osMutexPrioInherit          0x00000002U
+#define osMutexRobust               0x00000008U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Default stack size for threads allocated from the heap.
+ */
+#if !defined(CMSIS_CFG_DEFAULT_STACK)
+#define CMSIS_CFG_DEFAULT_STACK     256
+#endif
+
+/**
+ * @brief   Number of pre-allocated static timers.
+ */
+#if !defined(CMSIS_CFG_NUM_TIMERS)
+#define CMSIS_CFG_NUM_TIMERS        4
+#endif
+
+/**
+ * @brief   Number of pre-allocated static event flags.
+ */
+#if !defined(CMSIS_CFG_NUM_EVENT_FLAGS)
+#define CMSIS_CFG_NUM_EVENT_FLAGS   4
+#endif
+
+/**
+ * @brief   Number of pre-allocated static mutexes.
+ */
+#if !defined(CMSIS_CFG_NUM_MUTEXES)
+#define CMSIS_CFG_NUM_MUTEXES       4
+#endif
+
+/**
+ * @brief   Number of pre-allocated static semaphores.
+ */
+#if !defined(CMSIS_CFG_NUM_SEMAPHORES)
+#define CMSIS_CFG_NUM_SEMAPHORES    4
+#endif
+
+/**
+ * @brief   Number of pre-allocated static memory pools.
+ */
+#if !defined(CMSIS_CFG_NUM_MEMORY_POOLS)
+#define CMSIS_CFG_NUM_MEMORY_POOLS  2
+#endif
+
+/**
+ * @brief   Number of pre-allocated static message queues.
+ */
+#if !defined(CMSIS_CFG_NUM_MESSAGE_QUEUES)
+#define CMSIS_CFG_NUM_MESSAGE_QUEUES 2
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if defined(CMSIS_OS_H)
+#error "cmsis_os2.h cannot be used together with cmsis_os.h"
+#endif
+
+#if !CH_CFG_USE_MEMPOOLS
+#error "CMSIS RTOS2 requires CH_CFG_USE_MEMPOOLS"
+#endif
+
+#if !CH_CFG_USE_EVENTS
+#error "CMSIS RTOS2 requires CH_CFG_USE_EVENTS"
+#endif
+
+#if !CH_CFG_USE_EVENTS_TIMEOUT
+#error "CMSIS RTOS2 requires CH_CFG_USE_EVENTS_TIMEOUT"
+#endif
+
+#if !CH_CFG_USE_SEMAPHORES
+#error "CMSIS RTOS2 requires CH_CFG_USE_SEMAPHORES"
+#endif
+
+#if !CH_CFG_USE_MUTEXES
+#error "CMSIS RTOS2 requires CH_CFG_USE_MUTEXES"
+#endif
+
+#if !CH_CFG_USE_OBJ_FIFOS
+#error "CMSIS RTOS2 requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+#if (CMSIS_CFG_NUM_TIMERS < 0) || (CMSIS_CFG_NUM_EVENT_FLAGS < 0) ||         \
+    (CMSIS_CFG_NUM_MUTEXES < 0) || (CMSIS_CFG_NUM_SEMAPHORES < 0) ||        \
+    (CMSIS_CFG_NUM_MEMORY_POOLS < 0) || (CMSIS_CFG_NUM_MESSAGE_QUEUES < 0)
+#error "invalid number of pre-allocated objects"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of kernel information.
+ */
+typedef struct {
+  uint32_t                  api;
+  uint32_t                  kernel;
+} osVersion_t;
+
+/**
+ * @brief   Type of kernel states.
+ */
+typedef enum {
+  osKernelInactive          = 0,
+  osKernelReady             = 1,
+  osKernelRunning           = 2,
+  osKernelLocked            = 3,
+  osKernelSuspended         = 4,
+  osKernelError             = -1,
+  osKernelReserved          = 0x7FFFFFFF
+} osKernelState_t;
+
+/**
+ * @brief   Type of thread states.
+ */
+typedef enum {
+  osThreadInactive          = 0,
+  osThreadReady             = 1,
+  osThreadRunning           = 2,
+  osThreadBlocked           = 3,
+  osThreadTerminated        = 4,
+  osThreadError             = -1,
+  osThreadReserved          = 0x7FFFFFFF
+} osThreadState_t;
+
+/**
+ * @brief   Type of priority levels.
+ * @note    Priorities are mapped around @p NORMALPRIO, @p osPriorityNormal
+ *          is @p NORMALPRIO.
+ */
+typedef enum {
+  osPriorityNone            = 0,
+  osPriorityIdle            = 1,
+  osPriorityLow             = 8,
+  osPriorityLow1            = 8 + 1,
+  osPriorityLow2            = 8 + 2,
+  osPriorityLow3            = 8 + 3,
+  osPriorityLow4            = 8 + 4,
+  osPriorityLow5            = 8 + 5,
+  osPriorityLow6            = 8 + 6,
+  osPriorityLow7            = 8 + 7,
+  osPriorityBelowNormal     = 16,
+  osPriorityBelowNormal1    = 16 + 1,
+  osPriorityBelowNormal2    = 16 + 2,
+  osPriorityBelowNormal3    = 16 + 3,
+  osPriorityBelowNormal4    = 16 + 4,
+  osPriorityBelowNormal5    = 16 + 5,
+  osPriorityBelowNormal6    = 16 + 6,
+  osPriorityBelowNormal7    = 16 + 7,
+  osPriorityNormal          = 24,
+  osPriorityNormal1         = 24 + 1,
+  osPriorityNormal2         = 24 + 2,
+  osPriorityNormal3         = 24 + 3,
+  osPriorityNormal4         = 24 + 4,
+  osPriorityNormal5         = 24 + 5,
+  osPriorityNormal6         = 24 + 6,
+  osPriorityNormal7         = 24 + 7,
+  osPriorityAboveNormal     = 32,
+  osPriorityAboveNormal1    = 32 + 1,
+  osPriorityAboveNormal2    = 32 + 2,
+  osPriorityAboveNormal3    = 32 + 3,
+  osPriorityAboveNormal4    = 32 + 4,
+  osPriorityAboveNormal5    = 32 + 5,
+  osPriorityAboveNormal6    = 32 + 6,
+  osPriorityAboveNormal7    = 32 + 7,
+  osPriorityHigh            = 40,
+  osPriorityHigh1           = 40 + 1,
+  osPriorityHigh2           = 40 + 2,
+  osPriorityHigh3           = 40 + 3,
+  osPriorityHigh4           = 40 + 4,
+  osPriorityHigh5           = 40 + 5,
+  osPriorityHigh6           = 40 + 6,
+  osPriorityHigh7           = 40 + 7,
+  osPriorityRealtime        = 48,
+  osPriorityRealtime1       = 48 + 1,
+  osPriorityRealtime2       = 48 + 2,
+  osPriorityRealtime3       = 48 + 3,
+  osPriorityRealtime4       = 48 + 4,
+  osPriorityRealtime5       = 48 + 5,
+  osPriorityRealtime6       = 48 + 6,
+  osPriorityRealtime7       = 48 + 7,
+  osPriorityISR             = 56,
+  osPriorityError           = -1,
+  osPriorityReserved        = 0x7FFFFFFF
+} osPriority_t;
+
+/**
+ * @brief   Type of status codes.
+ */
+typedef enum {
+  osOK                      = 0,
+  osError                   = -1,
+  osErrorTimeout            = -2,
+  osErrorResource           = -3,
+  osErrorParameter          = -4,
+  osErrorNoMemory           = -5,
+  osErrorISR                = -6,
+  osStatusReserved          = 0x7FFFFFFF
+} osStatus_t;
+
+/**
+ * @brief   Type of a timer mode.
+ */
+typedef enum {
+  osTimerOnce               = 0,
+  osTimerPeriodic           = 1
+} osTimerType_t;
+
+/**
+ * @brief   Type of thread functions.
+ * @note    Same signature of @p tfunc_t, no adapter is required.
+ */
+typedef void (*osThreadFunc_t)(void *argument);
+
+/**
+ * @brief   Type of timer callbacks.
+ * @note    Same signature of @p vtfunc_t, callbacks are invoked from the
+ *          virtual timers ISR context.
+ */
+typedef void (*osTimerFunc_t)(void *argument);
+
+/**
+ * @brief   Type of a timer control block.
+ */
+typedef struct {
+  virtual_timer_t           vt;
+  osTimerFunc_t             func;
+  void                      *argument;
+  osTimerType_t             type;
+  sysinterval_t             period;
+} cmsis_timer_t;
+
+/**
+ * @brief   Type of an event flags control block.
+ */
+typedef struct {
+  threads_queue_t           queue;
+  uint32_t                  flags;
+} cmsis_event_flags_t;
+
+/**
+ * @brief   Type of a semaphore control block.
+ */
+typedef struct {
+  semaphore_t               sem;
+  cnt_t                     max;
+} cmsis_semaphore_t;
+
+/**
+ * @brief   Type of a memory pool control block.
+ */
+typedef struct {
+  guarded_memory_pool_t     pool;
+  uint32_t                  capacity;
+  void                      *heap_mem;
+} cmsis_memory_pool_t;
+
+/**
+ * @brief   Type of a message queue control block.
+ */
+typedef struct {
+  objects_fifo_t            fifo;
+  uint32_t                  capacity;
+  uint32_t                  msg_size;
+  void                      *heap_mem;
+} cmsis_message_queue_t;
+
+/**
+ * @name    Objects identifiers
+ * @{
+ */
+typedef thread_t *osThreadId_t;
+typedef cmsis_timer_t *osTimerId_t;
+typedef cmsis_event_flags_t *osEventFlagsId_t;
+typedef mutex_t *osMutexId_t;
+typedef cmsis_semaphore_t *osSemaphoreId_t;
+typedef cmsis_memory_pool_t *osMemoryPoolId_t;
+typedef cmsis_message_queue_t *osMessageQueueId_t;
+/** @} */
+
+/**
+ * @brief   Type of a thread attributes structure.
+ * @note    The thread structure is part of the working area, @p cb_mem is
+ *          not used.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+  void                      *stack_mem;
+  uint32_t                  stack_size;
+  osPriority_t              priority;
+  uint32_t                  tz_module;
+  uint32_t                  reserved;
+} osThreadAttr_t;
+
+/**
+ * @brief   Type of a timer attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+} osTimerAttr_t;
+
+/**
+ * @brief   Type of an event flags attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+} osEventFlagsAttr_t;
+
+/**
+ * @brief   Type of a mutex attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+} osMutexAttr_t;
+
+/**
+ * @brief   Type of a semaphore attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+} osSemaphoreAttr_t;
+
+/**
+ * @brief   Type of a memory pool attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+  void                      *mp_mem;
+  uint32_t                  mp_size;
+} osMemoryPoolAttr_t;
+
+/**
+ * @brief   Type of a message queue attributes structure.
+ */
+typedef struct {
+  const char                *name;
+  uint32_t                  attr_bits;
+  void                      *cb_mem;
+  uint32_t                  cb_size;
+  void                      *mq_mem;
+  uint32_t                  mq_size;
+} osMessageQueueAttr_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the @p mp_mem area of a memory pool.
+ *
+ * @param[in] block_count       number of blocks
+ * @param[in] block_size        size of a block
+ */
+#define CMSIS_MEMORY_POOL_MEM_SIZE(block_count, block_size)                 \
+  ((block_count) * MEM_ALIGN_NEXT(block_size, PORT_NATURAL_ALIGN))
+
+/**
+ * @brief   Size of the @p mq_mem area of a message queue.
+ * @details The area contains the messages followed by the mailbox buffer.
+ *
+ * @param[in] msg_count         number of messages
+ * @param[in] msg_size          size of a message
+ */
+#define CMSIS_MESSAGE_QUEUE_MEM_SIZE(msg_count, msg_size)                   \
+  ((msg_count) * (MEM_ALIGN_NEXT(msg_size, PORT_NATURAL_ALIGN) +            \
+                  sizeof (msg_t)))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  osStatus_t osKernelInitialize(void);
+  osStatus_t osKernelGetInfo(osVersion_t *version, char *id_buf,
+                             uint32_t id_size);
+  osKernelState_t osKernelGetState(void);
+  osStatus_t osKernelStart(void);
+  osThreadId_t osThreadNew(osThreadFunc_t func, void *argument,
+                           const osThreadAttr_t *attr);
+  const char *osThreadGetName(osThreadId_t thread_id);
+  osThreadState_t osThreadGetState(osThreadId_t thread_id);
+  osStatus_t osThreadSetPriority(osThreadId_t thread_id,
+                                 osPriority_t priority);
+  osPriority_t osThreadGetPriority(osThreadId_t thread_id);
+  osStatus_t osThreadDetach(osThreadId_t thread_id);
+  osStatus_t osThreadJoin(osThreadId_t thread_id);
+  void osThreadExit(void);
+  osStatus_t osThreadTerminate(osThreadId_t thread_id);
+  uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+  uint32_t osThreadFlagsClear(uint32_t flags);
+  uint32_t osThreadFlagsGet(void);
+  uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options,
+                             uint32_t timeout);
+  osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type,
+                         void *argument, const osTimerAttr_t *attr);
+  osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks);
+  osStatus_t osTimerStop(osTimerId_t timer_id);
+  uint32_t osTimerIsRunning(osTimerId_t timer_id);
+  osStatus_t osTimerDelete(osTimerId_t timer_id);
+  osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr);
+  uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags);
+  uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags);
+  uint32_t osEventFlagsGet(osEventFlagsId_t ef_id);
+  uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags,
+                            uint32_t options, uint32_t timeout);
+  osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id);
+  osMutexId_t osMutexNew(const osMutexAttr_t *attr);
+  osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+  osStatus_t osMutexRelease(osMutexId_t mutex_id);
+  osThreadId_t osMutexGetOwner(osMutexId_t mutex_id);
+  osStatus_t osMutexDelete(osMutexId_t mutex_id);
+  osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count,
+                                 const osSemaphoreAttr_t *attr);
+  osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id,
+                                uint32_t timeout);
+  osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id);
+  uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id);
+  osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id);
+  osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size,
+                                   const osMemoryPoolAttr_t *attr);
+  void *osMemoryPoolAlloc(osMemoryPoolId_t mp_id, uint32_t timeout);
+  osStatus_t osMemoryPoolFree(osMemoryPoolId_t mp_id, void *block);
+  uint32_t osMemoryPoolGetCapacity(osMemoryPoolId_t mp_id);
+  uint32_t osMemoryPoolGetBlockSize(osMemoryPoolId_t mp_id);
+  uint32_t osMemoryPoolGetCount(osMemoryPoolId_t mp_id);
+  uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id);
+  osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id);
+  osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
+                                       const osMessageQueueAttr_t *attr);
+  osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr,
+                               uint8_t msg_prio, uint32_t timeout);
+  osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr,
+                               uint8_t *msg_prio, uint32_t timeout);
+  uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id);
+  uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id);
+  uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id);
+  uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id);
+  osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the system ticks count.
+ */
+static inline uint32_t osKernelGetTickCount(void) {
+
+  return (uint32_t)chVTGetSystemTimeX();
+}
+
+/**
+ * @brief   Returns the system ticks frequency.
+ */
+static inline uint32_t osKernelGetTickFreq(void) {
+
+  return (uint32_t)CH_CFG_ST_FREQUENCY;
+}
+
+/**
+ * @brief   Returns the current thread.
+ */
+static inline osThreadId_t osThreadGetId(void) {
+
+  return chThdGetSelfX();
+}
+
+/**
+ * @brief   Thread time slice yield.
+ */
+static inline osStatus_t osThreadYield(void) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  chThdYield();
+
+  return osOK;
+}
+
+/**
+ * @brief   Thread delay in system ticks.
+ */
+static inline osStatus_t osDelay(uint32_t ticks) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  if (ticks != 0U) {
+    chThdSleep((sysinterval_t)ticks);
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief   Thread delay until an absolute system time.
+ */
+static inline osStatus_t osDelayUntil(uint32_t ticks) {
+
+  if (port_is_isr_context()) {
+    return osErrorISR;
+  }
+
+  chThdSleepUntil((systime_t)ticks);
+
+  return osOK;
+}
+
+#endif /* CMSIS_OS2_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# List of the ChibiOS/RT CMSIS RTOS2 wrapper.
+CMSISRTOS2SRC = ${CHIBIOS}/os/common/abstractions/cmsis_os/cmsis_os2.c
+
+CMSISRTOS2INC = ${CHIBIOS}/os/common/abstractions/cmsis_os
+
+# Shared variables
+ALLCSRC += $(CMSISRTOS2SRC)
+ALLINC  += $(CMSISRTOS2INC)
@@ -55,6 +55,11 @@ extern "C" {
   void OS_set_printf(int (*printf)(const char *fmt, ...));
   boolean OS_TaskDeleteCheck(void);
   int32 OS_TaskWait(uint32 task_id);
+  int32 OS_QueueAllocBuffer(uint32 queue_id, void **buffer, int32 timeout);
+  int32 OS_QueuePutBuffer(uint32 queue_id, void *buffer, uint32 size);
+  int32 OS_QueueGetBuffer(uint32 queue_id, void **buffer, uint32 *size,
+                          int32 timeout);
+  int32 OS_QueueFreeBuffer(uint32 queue_id, void *buffer);
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@
  */
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "ch.h"
@@ -66,6 +67,10 @@
 #error "NASA OSAL requires CH_CFG_USE_HEAP"
 #endif
 
+#if CH_CFG_USE_OBJ_FIFOS == FALSE
+#error "NASA OSAL requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
 /*===========================================================================*/
 /* Module local definitions.                                                 */
 /*===========================================================================*/
@@ -79,6 +84,19 @@
 #define MIN_QUEUE_DEPTH     1
 #define MAX_QUEUE_DEPTH     16384
 
+/**
+ * @brief   Number of buckets of the names hash tables.
+ * @note    It must be a power of two.
+ */
+#if !defined(OS_NAMES_HASH_BUCKETS)
+#define OS_NAMES_HASH_BUCKETS 16
+#endif
+
+#if (OS_NAMES_HASH_BUCKETS < 1) ||                                          \
+    ((OS_NAMES_HASH_BUCKETS & (OS_NAMES_HASH_BUCKETS - 1)) != 0)
+#error "OS_NAMES_HASH_BUCKETS must be a power of two"
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -95,29 +113,34 @@ typedef void (*funcptr_t)(void);
 /**
  * @brief   Type of OSAL timer.
  */
-typedef struct {
+typedef struct osal_timer osal_timer_t;
+struct osal_timer {
   uint32                is_free;
   char                  name[OS_MAX_API_NAME];
+  osal_timer_t          *hash_next;
   OS_TimerCallback_t    callback_ptr;
   uint32                start_time;
   uint32                interval_time;
   virtual_timer_t       vt;
-} osal_timer_t;
+};
 
 /**
  * @brief   Type of an OSAL queue.
+ * @details Messages are objects of the FIFO, each one made of a size field
+ *          followed by the message body.
  */
-typedef struct {
+typedef struct osal_queue osal_queue_t;
+struct osal_queue {
   uint32                is_free;
   char                  name[OS_MAX_API_NAME];
-  semaphore_t           free_msgs;
-  memory_pool_t         messages;
-  mailbox_t             mb;
-  msg_t                 *mb_buffer;
-  void                  *q_buffer;
+  osal_queue_t          *hash_next;
+  objects_fifo_t        fifo;
+  uint8_t               *mb_buffer;
+  msg_t                 *q_buffer;
+  size_t                msgsize;
   uint32                depth;
   uint32                size;
-} osal_queue_t;
+};
 
 /**
  * @brief   Type of an osal message with minimum size.
@@ -142,6 +165,8 @@ typedef struct {
   memory_pool_t         mutexes_pool;
   osal_timer_t          timers[OS_MAX_TIMERS];
   osal_queue_t          queues[OS_MAX_QUEUES];
+  osal_timer_t          *timers_hash[OS_NAMES_HASH_BUCKETS];
+  osal_queue_t          *queues_hash[OS_NAMES_HASH_BUCKETS];
   binary_semaphore_t    binary_semaphores[OS_MAX_BIN_SEMAPHORES];
   semaphore_t           count_semaphores[OS_MAX_COUNT_SEMAPHORES];
   mutex_t               mutexes[OS_MAX_MUTEXES];
@@ -190,29 +215,45 @@ static void timer_handler(void *p) {
   }
 }
 
+/**
+ * @brief   Returns the hash bucket of a name.
+ * @details FNV-1a hash of the significant part of the name.
+ */
+static unsigned name_bucket(const char *name) {
+  uint32_t hash = 2166136261U;
+  unsigned i = OS_MAX_API_NAME - 1;
+
+  while ((*name != '\0') && (i > 0U)) {
+    hash = (hash ^ (uint32_t)(uint8_t)*name++) * 16777619U;
+    i--;
+  }
+
+  return (unsigned)(hash & (uint32_t)(OS_NAMES_HASH_BUCKETS - 1));
+}
+
 /**
  * @brief   Finds a queue by name.
  */
 uint32 queue_find(const char *queue_name) {
   osal_queue_t *oqp;
+  syssts_t sts;
 
-  /* Searching the queue in the table.*/
-  for (oqp = &osal.queues[0]; oqp < &osal.queues[OS_MAX_QUEUES]; oqp++) {
-    /* Entering a reentrant critical zone.*/
-    syssts_t sts = chSysGetStatusAndLockX();
+  /* Entering a reentrant critical zone.*/
+  sts = chSysGetStatusAndLockX();
 
-    if (!oqp->is_free &&
-        (strncmp(oqp->name, queue_name, OS_MAX_API_NAME - 1) == 0)) {
-      /* Leaving the critical zone.*/
-      chSysRestoreStatusX(sts);
-      return (uint32)oqp;
+  /* Searching the queue in its hash bucket.*/
+  oqp = osal.queues_hash[name_bucket(queue_name)];
+  while (oqp != NULL) {
+    if (strncmp(oqp->name, queue_name, OS_MAX_API_NAME - 1) == 0) {
+      break;
     }
-
-    /* Leaving the critical zone.*/
-    chSysRestoreStatusX(sts);
+    oqp = oqp->hash_next;
   }
 
-  return 0;
+  /* Leaving the critical zone.*/
+  chSysRestoreStatusX(sts);
+
+  return (uint32)oqp;
 }
 
 /**
@@ -220,24 +261,114 @@ uint32 queue_find(const char *queue_name) {
  */
 uint32 timer_find(const char *timer_name) {
   osal_timer_t *otp;
+  syssts_t sts;
 
-  /* Searching the queue in the table.*/
-  for (otp = &osal.timers[0]; otp < &osal.timers[OS_MAX_TIMERS]; otp++) {
-    /* Entering a reentrant critical zone.*/
-    syssts_t sts = chSysGetStatusAndLockX();
+  /* Entering a reentrant critical zone.*/
+  sts = chSysGetStatusAndLockX();
 
-    if (!otp->is_free &&
-        (strncmp(otp->name, timer_name, OS_MAX_API_NAME - 1) == 0)) {
-      /* Leaving the critical zone.*/
-      chSysRestoreStatusX(sts);
-      return (uint32)otp;
+  /* Searching the timer in its hash bucket.*/
+  otp = osal.timers_hash[name_bucket(timer_name)];
+  while (otp != NULL) {
+    if (strncmp(otp->name, timer_name, OS_MAX_API_NAME - 1) == 0) {
+      break;
     }
+    otp = otp->hash_next;
+  }
 
-    /* Leaving the critical zone.*/
-    chSysRestoreStatusX(sts);
+  /* Leaving the critical zone.*/
+  chSysRestoreStatusX(sts);
+
+  return (uint32)otp;
+}
+
+/**
+ * @brief   Removes a queue from the names hash table.
+ * @note    Must be called from within a critical zone.
+ */
+static void queue_unlink(osal_queue_t *oqp) {
+  osal_queue_t **pp = &osal.queues_hash[name_bucket(oqp->name)];
+
+  while (*pp != oqp) {
+    pp = &(*pp)->hash_next;
+  }
+  *pp = oqp->hash_next;
+}
+
+/**
+ * @brief   Removes a timer from the names hash table.
+ * @note    Must be called from within a critical zone.
+ */
+static void timer_unlink(osal_timer_t *otp) {
+  osal_timer_t **pp = &osal.timers_hash[name_bucket(otp->name)];
+
+  while (*pp != otp) {
+    pp = &(*pp)->hash_next;
+  }
+  *pp = otp->hash_next;
+}
+
+/**
+ * @brief   Waits for a message from a queue.
+ *
+ * @param[in] oqp               pointer to the queue
+ * @param[out] omsgp            pointer to the received message
+ * @param[in] timeout           timeout in ticks, the special values @p OS_PEND
+ *                              and @p OS_CHECK can be specified
+ * @return                      An error code.
+ */
+static int32 queue_receive(osal_queue_t *oqp, osal_message_t **omsgp,
+                           int32 timeout) {
+  msg_t msgsts;
+
+  /* Special time handling.*/
+  if (timeout == OS_PEND) {
+    msgsts = chFifoReceiveObjectTimeout(&oqp->fifo, (void **)omsgp,
+                                        TIME_INFINITE);
+    if (msgsts < MSG_OK) {
+      return OS_ERROR;
+    }
+  }
+  else if (timeout == OS_CHECK) {
+    msgsts = chFifoReceiveObjectTimeout(&oqp->fifo, (void **)omsgp,
+                                        TIME_IMMEDIATE);
+    if (msgsts < MSG_OK) {
+      return OS_QUEUE_EMPTY;
+    }
+  }
+  else {
+    msgsts = chFifoReceiveObjectTimeout(&oqp->fifo, (void **)omsgp,
+                                        (sysinterval_t)timeout);
+    if (msgsts < MSG_OK) {
+      return OS_QUEUE_TIMEOUT;
+    }
+  }
+
+  return OS_SUCCESS;
+}
+
+/**
+ * @brief   Returns the message containing a message body.
+ *
+ * @param[in] oqp               pointer to the queue
+ * @param[in] buffer            pointer to a message body
+ * @return                      Pointer to the message or @p NULL if the
+ *                              pointer is not a message body of the queue.
+ */
+static osal_message_t *queue_message(osal_queue_t *oqp, void *buffer) {
+  uint8_t *p = (uint8_t *)buffer - offsetof(osal_message_t, buf);
+  size_t offset;
+
+  if ((buffer == NULL) || (p < oqp->mb_buffer)) {
+    return NULL;
   }
 
-  return 0;
+  offset = (size_t)(p - oqp->mb_buffer);
+  if ((offset >= oqp->msgsize * (size_t)oqp->depth) ||
+      ((offset % oqp->msgsize) != 0U)) {
+    return NULL;
+  }
+
+  return (osal_message_t *)p;
 }
 
 /*===========================================================================*/
@@ -257,6 +388,7 @@ uint32 timer_find(const char *timer_name) {
  * @api
  */
 int32 OS_API_Init(void) {
+  unsigned i;
 
   chSysInit();
 
@@ -286,6 +418,12 @@ int32 OS_API_Init(void) {
                   &osal.queues[0],
                   OS_MAX_QUEUES);
 
+  /* Names hash tables initialization.*/
+  for (i = 0U; i < (unsigned)OS_NAMES_HASH_BUCKETS; i++) {
+    osal.timers_hash[i] = NULL;
+    osal.queues_hash[i] = NULL;
+  }
+
   /* Binary Semaphores pool initialization.*/
   chPoolObjectInit(&osal.binary_semaphores_pool,
                    sizeof (binary_semaphore_t),
@@ -448,6 +586,7 @@ int32 OS_Milli2Ticks(uint32 milli_seconds) {
 int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name,
                      uint32 *clock_accuracy, OS_TimerCallback_t callback_ptr) {
   osal_timer_t *otp;
+  unsigned b;
 
   /* NULL pointer checks.*/
   if ((timer_id == NULL) || (timer_name == NULL) ||
@@ -485,7 +624,14 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name,
   otp->start_time    = 0;
   otp->interval_time = 0;
   otp->callback_ptr  = callback_ptr;
-  otp->is_free       = 0;   /* Note, last.*/
+
+  /* Making the timer visible by name.*/
+  chSysLock();
+  b = name_bucket(otp->name);
+  otp->hash_next = osal.timers_hash[b];
+  osal.timers_hash[b] = otp;
+  otp->is_free   = 0;   /* Note, last.*/
+  chSysUnlock();
 
   *timer_id = (uint32)otp;
   *clock_accuracy = (uint32)(1000000 / CH_CFG_ST_FREQUENCY);
@@ -515,6 +661,7 @@ int32 OS_TimerDelete(uint32 timer_id) {
 
   /* Marking as no more free, will be overwritten by the pool pointer.*/
   otp->is_free = 1;
+  timer_unlink(otp);
 
   /* Resetting the timer.*/
   chVTResetI(&otp->vt);
@@ -665,6 +812,7 @@ int32 OS_QueueCreate(uint32 *queue_id, const char *queue_name,
                      uint32 queue_depth, uint32 data_size, uint32 flags) {
   osal_queue_t *oqp;
   size_t msgsize;
+  unsigned b;
 
   (void)flags;
 
@@ -721,13 +869,19 @@ int32 OS_QueueCreate(uint32 *queue_id, const char *queue_name,
 
   /* Initializing object static parts.*/
   strncpy(oqp->name, queue_name, OS_MAX_API_NAME - 1);
-  chMBObjectInit(&oqp->mb, oqp->q_buffer, (size_t)queue_depth);
-  chSemObjectInit(&oqp->free_msgs, (cnt_t)queue_depth);
-  chPoolObjectInit(&oqp->messages, msgsize, NULL);
-  chPoolLoadArray(&oqp->messages, oqp->mb_buffer, (size_t)queue_depth);
+  chFifoObjectInitAligned(&oqp->fifo, msgsize, (size_t)queue_depth,
+                          PORT_NATURAL_ALIGN, oqp->mb_buffer, oqp->q_buffer);
+  oqp->msgsize = msgsize;
   oqp->depth   = queue_depth;
   oqp->size    = data_size;
-  oqp->is_free = 0;   /* Note, last.*/
+
+  /* Making the queue visible by name.*/
+  chSysLock();
+  b = name_bucket(oqp->name);
+  oqp->hash_next = osal.queues_hash[b];
+  osal.queues_hash[b] = oqp;
+  oqp->is_free   = 0;   /* Note, last.*/
+  chSysUnlock();
   *queue_id = (uint32)oqp;
 
   return OS_SUCCESS;
@@ -757,14 +911,15 @@ int32 OS_QueueDelete(uint32 queue_id) {
 
   /* Marking as no more free, will be overwritten by the pool pointer.*/
   oqp->is_free = 1;
+  queue_unlink(oqp);
 
   /* Pointers to areas to be freed.*/
   q_buffer  = oqp->q_buffer;
   mb_buffer = oqp->mb_buffer;
 
   /* Resetting the queue.*/
-  chMBResetI(&oqp->mb);
-  chSemResetI(&oqp->free_msgs, 0);
+  chMBResetI(&oqp->fifo.mbx);
+  chSemResetI(&oqp->fifo.free.sem, 0);
 
   /* Flagging it as unused and returning it to the pool.*/
   chPoolFreeI(&osal.queues_pool, (void *)oqp);
@@ -797,8 +952,8 @@ int32 OS_QueueDelete(uint32 queue_id) {
 int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
                   uint32 *size_copied, int32 timeout) {
   osal_queue_t *oqp = (osal_queue_t *)queue_id;
-  msg_t msg, msgsts;
-  void *body;
+  osal_message_t *omsg;
+  int32 err;
 
   /* NULL pointer checks.*/
   if ((data == NULL) || (size_copied == NULL)) {
@@ -817,39 +972,19 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
     return OS_QUEUE_INVALID_SIZE;
   }
 
-  /* Special time handling.*/
-  if (timeout == OS_PEND) {
-    msgsts = chMBFetchTimeout(&oqp->mb, &msg, TIME_INFINITE);
-    if (msgsts < MSG_OK) {
-      *size_copied = 0;
-      return OS_ERROR;
-    }
+  /* Waiting for a message.*/
+  err = queue_receive(oqp, &omsg, timeout);
+  if (err != OS_SUCCESS) {
+    *size_copied = 0;
+    return err;
   }
-  else if (timeout == OS_CHECK) {
-    msgsts = chMBFetchTimeout(&oqp->mb, &msg, TIME_IMMEDIATE);
-    if (msgsts < MSG_OK) {
-      *size_copied = 0;
-      return OS_QUEUE_EMPTY;
-    }
-  }
-  else {
-    msgsts = chMBFetchTimeout(&oqp->mb, &msg, (sysinterval_t)timeout);
-    if (msgsts < MSG_OK) {
-      *size_copied = 0;
-      return OS_QUEUE_TIMEOUT;
-    }
-  }
-
-  /* Message body and size.*/
-  *size_copied = ((osal_message_t *)msg)->size;
-  body  = (void *)((osal_message_t *)msg)->buf;
 
   /* Copying the message body.*/
-  memcpy(data, body, *size_copied);
+  *size_copied = (uint32)omsg->size;
+  memcpy(data, omsg->buf, omsg->size);
 
   /* Freeing the message buffer.*/
-  chPoolFree(&oqp->messages, (void *)msg);
-  chSemSignal(&oqp->free_msgs);
+  chFifoReturnObject(&oqp->fifo, (void *)omsg);
 
   return OS_SUCCESS;
 }
@@ -867,7 +1002,6 @@ int32 OS_QueueGet(uint32 queue_id, void *data, uint32 size,
  */
 int32 OS_QueuePut(uint32 queue_id, void *data, uint32 size, uint32 flags) {
   osal_queue_t *oqp = (osal_queue_t *)queue_id;
-  msg_t msgsts;
   osal_message_t *omsg;
 
   (void)flags;
@@ -889,22 +1023,18 @@ int32 OS_QueuePut(uint32 queue_id, void *data, uint32 size, uint32 flags) {
     return OS_QUEUE_INVALID_SIZE;
   }
 
-  /* Getting a message buffer from the pool.*/
-  msgsts = chSemWait(&oqp->free_msgs);
-  if (msgsts < MSG_OK) {
+  /* Getting a message buffer from the FIFO.*/
+  omsg = chFifoTakeObjectTimeout(&oqp->fifo, TIME_INFINITE);
+  if (omsg == NULL) {
     return OS_ERROR;
   }
-  omsg = chPoolAlloc(&oqp->messages);
 
   /* Filling message size and data.*/
   omsg->size = (size_t)size;
   memcpy(omsg->buf, data, size);
 
-  /* Posting the message.*/
-  msgsts = chMBPostTimeout(&oqp->mb, (msg_t)omsg, TIME_INFINITE);
-  if (msgsts < MSG_OK) {
-    return OS_ERROR;
-  }
+  /* Posting the message, there is always space for a taken buffer.*/
+  chFifoSendObject(&oqp->fifo, (void *)omsg);
 
   return OS_SUCCESS;
 }
@@ -986,6 +1116,187 @@ int32 OS_QueueGetInfo (uint32 queue_id, OS_queue_prop_t *queue_prop) {
   return OS_ERR_NOT_IMPLEMENTED;
 }
 
+/**
+ * @brief   Gets a free message buffer from the queue.
+ * @details The message body is written in place then posted using
+ *          @p OS_QueuePutBuffer(), this avoids the copy performed by
+ *          @p OS_QueuePut().
+ * @note    This function is a ChibiOS extension.
+ *
+ * @param[in] queue_id          queue id variable
+ * @param[out] buffer           pointer to the message body, of the maximum
+ *                              message size of the queue
+ * @param[in] timeout           timeout in ticks, the special values @p OS_PEND
+ *                              and @p OS_CHECK can be specified
+ * @return                      An error code.
+ *
+ * @api
+ */
+int32 OS_QueueAllocBuffer(uint32 queue_id, void **buffer, int32 timeout) {
+  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_message_t *omsg;
+  sysinterval_t interval;
+
+  /* NULL pointer checks.*/
+  if (buffer == NULL) {
+    return OS_INVALID_POINTER;
+  }
+
+  /* Range check.*/
+  if ((oqp < &osal.queues[0]) ||
+      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
+      (oqp->is_free)) {
+    return OS_ERR_INVALID_ID;
+  }
+
+  /* Special time handling.*/
+  if (timeout == OS_PEND) {
+    interval = TIME_INFINITE;
+  }
+  else if (timeout == OS_CHECK) {
+    interval = TIME_IMMEDIATE;
+  }
+  else {
+    interval = (sysinterval_t)timeout;
+  }
+
+  omsg = chFifoTakeObjectTimeout(&oqp->fifo, interval);
+  if (omsg == NULL) {
+    *buffer = NULL;
+    if (timeout == OS_PEND) {
+      return OS_ERROR;
+    }
+    return OS_QUEUE_FULL;
+  }
+
+  *buffer = (void *)omsg->buf;
+
+  return OS_SUCCESS;
+}
+
+/**
+ * @brief   Posts a message buffer in the queue.
+ * @details The buffer must have been obtained using
+ *          @p OS_QueueAllocBuffer(), its ownership passes to the receiver.
+ * @note    This function is a ChibiOS extension.
+ *
+ * @param[in] queue_id          queue id variable
+ * @param[in] buffer            pointer to the message body
+ * @param[in] size              size of the message
+ * @return                      An error code.
+ *
+ * @api
+ */
+int32 OS_QueuePutBuffer(uint32 queue_id, void *buffer, uint32 size) {
+  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_message_t *omsg;
+
+  /* Range check.*/
+  if ((oqp < &osal.queues[0]) ||
+      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
+      (oqp->is_free)) {
+    return OS_ERR_INVALID_ID;
+  }
+
+  /* Buffer check.*/
+  omsg = queue_message(oqp, buffer);
+  if (omsg == NULL) {
+    return OS_INVALID_POINTER;
+  }
+
+  /* Check on maximum size.*/
+  if (size > oqp->size) {
+    return OS_QUEUE_INVALID_SIZE;
+  }
+
+  /* Posting the message.*/
+  omsg->size = (size_t)size;
+  chFifoSendObject(&oqp->fifo, (void *)omsg);
+
+  return OS_SUCCESS;
+}
+
+/**
+ * @brief   Retrieves a message buffer from the queue.
+ * @details The message is not copied, the buffer must be returned to the
+ *          queue using @p OS_QueueFreeBuffer() after use.
+ * @note    This function is a ChibiOS extension.
+ *
+ * @param[in] queue_id          queue id variable
+ * @param[out] buffer           pointer to the message body
+ * @param[out] size             size of the received message
+ * @param[in] timeout           timeout in ticks, the special values @p OS_PEND
+ *                              and @p OS_CHECK can be specified
+ * @return                      An error code.
+ *
+ * @api
+ */
+int32 OS_QueueGetBuffer(uint32 queue_id, void **buffer, uint32 *size,
+                        int32 timeout) {
+  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_message_t *omsg;
+  int32 err;
+
+  /* NULL pointer checks.*/
+  if ((buffer == NULL) || (size == NULL)) {
+    return OS_INVALID_POINTER;
+  }
+
+  /* Range check.*/
+  if ((oqp < &osal.queues[0]) ||
+      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
+      (oqp->is_free)) {
+    return OS_ERR_INVALID_ID;
+  }
+
+  /* Waiting for a message.*/
+  err = queue_receive(oqp, &omsg, timeout);
+  if (err != OS_SUCCESS) {
+    *buffer = NULL;
+    *size   = 0;
+    return err;
+  }
+
+  *buffer = (void *)omsg->buf;
+  *size   = (uint32)omsg->size;
+
+  return OS_SUCCESS;
+}
+
+/**
+ * @brief   Returns a message buffer to the queue.
+ * @details Buffers obtained using @p OS_QueueAllocBuffer() or
+ *          @p OS_QueueGetBuffer() are made available again.
+ * @note    This function is a ChibiOS extension.
+ *
+ * @param[in] queue_id          queue id variable
+ * @param[in] buffer            pointer to the message body
+ * @return                      An error code.
+ *
+ * @api
+ */
+int32 OS_QueueFreeBuffer(uint32 queue_id, void *buffer) {
+  osal_queue_t *oqp = (osal_queue_t *)queue_id;
+  osal_message_t *omsg;
+
+  /* Range check.*/
+  if ((oqp < &osal.queues[0]) ||
+      (oqp >= &osal.queues[OS_MAX_QUEUES]) ||
+      (oqp->is_free)) {
+    return OS_ERR_INVALID_ID;
+  }
+
+  /* Buffer check.*/
+  omsg = queue_message(oqp, buffer);
+  if (omsg == NULL) {
+    return OS_INVALID_POINTER;
+  }
+
+  chFifoReturnObject(&oqp->fifo, (void *)omsg);
+
+  return OS_SUCCESS;
+}
+
 /*-- Binary Semaphore API ---------------------------------------------------*/
 
 /**
@@ -1831,12 +2142,12 @@ int32 OS_TaskCreate(uint32 *task_id,
   }
 
   thread_descriptor_t td = {
-    task_name,
-    (stkalign_t *)stack_pointer,
-    (stkalign_t *)((uint8_t *)stack_pointer + stack_size),
-    rt_prio,
-    (tfunc_t)(void *)function_pointer,
-    NULL
+    .name  = task_name,
+    .wbase = (stkalign_t *)stack_pointer,
+    .wend  = (stkalign_t *)((uint8_t *)stack_pointer + stack_size),
+    .prio  = rt_prio,
+    .funcp = (tfunc_t)(void *)function_pointer,
+    .arg   = NULL
   };
 
   /* Creating the task and detaching it, other APIs will have to gain a
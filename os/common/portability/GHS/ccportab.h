@@ -106,6 +106,15 @@
  *          compiler.
  */
 #define CC_NO_RETURN    __attribute__((noreturn))
+
+/**
+ * @brief   Places a function in the fast code section.
+ * @details The linker script can relocate the section into a RAM with no
+ *          wait states, the code is copied there by the startup code.
+ * @note    Can be implemented as an empty macro if not supported by the
+ *          compiler.
+ */
+#define CC_FAST_CODE    __attribute__((section(".fastcode")))
 /** @} */
 
 /*===========================================================================*/
@@ -120,6 +120,7 @@ void port_unprivileged_jump(uint32_t pc, uint32_t psp) {
  * @note    The SVC vector is only used in advanced kernel mode.
  */
 /*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+CC_FAST_CODE
 void SVC_Handler(void) {
 /*lint -restore*/
   uint32_t psp = __get_PSP();
@@ -213,6 +214,7 @@ void SVC_Handler(void) {
  * @note    The PendSV vector is only used in compact kernel mode.
  */
 /*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+CC_FAST_CODE
 void PendSV_Handler(void) {
 /*lint -restore*/
   uint32_t psp = __get_PSP();
@@ -240,6 +242,23 @@ void PendSV_Handler(void) {
 }
 #endif /* CORTEX_SIMPLIFIED_PRIORITY == TRUE */
 
+#if (CORTEX_SIMPLIFIED_PRIORITY == FALSE) &&                                \
+    (CORTEX_USE_FAST_IRQ_EXIT == TRUE)
+/**
+ * @brief   PendSV vector.
+ * @details The PendSV vector is used in fast ISR exit mode for serving
+ *          preemptions required by nested ISRs.
+ */
+/*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+CC_FAST_CODE
+void PendSV_Handler(void) {
+/*lint -restore*/
+
+  PORT_IRQ_PROLOGUE();
+  PORT_IRQ_EPILOGUE();
+}
+#endif /* CORTEX_USE_FAST_IRQ_EXIT == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -311,6 +330,7 @@ void __port_set_region(void) {
 /**
  * @brief   Exception exit redirection to _port_switch_from_isr().
  */
+CC_FAST_CODE
 void __port_irq_epilogue(void) {
 
   port_lock_from_isr();
@@ -318,6 +338,19 @@ void __port_irq_epilogue(void) {
     struct port_extctx *ectxp;
     uint32_t s_psp;
 
+#if CORTEX_USE_FAST_IRQ_EXIT == TRUE
+    /* Fast path, returning directly to the interrupted thread if there is
+       no need to preempt it. A preemption required by an ISR nesting
+       before the exception return is served by PendSV.*/
+    if (!chSchIsPreemptionRequired()) {
+      port_unlock_from_isr();
+      return;
+    }
+
+    /* The context switch is performed here, a deferred one is redundant.*/
+    SCB->ICSR = SCB_ICSR_PENDSVCLR_Msk;
+#endif
+
 #if CORTEX_USE_FPU == TRUE
     /* Enforcing a lazy FPU state save by accessing the FPCSR register.*/
     (void) __get_FPSCR();
@@ -391,6 +424,13 @@ void __port_irq_epilogue(void) {
        order to keep the rest of the context switch atomic.*/
     return;
   }
+#if CORTEX_USE_FAST_IRQ_EXIT == TRUE
+  else if (chSchIsPreemptionRequired()) {
+    /* Nested ISR, the preemption is deferred to PendSV which has the
+       lowest kernel priority and is served after all the active ISRs.*/
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+  }
+#endif
   port_unlock_from_isr();
 }
 
@@ -83,6 +83,8 @@
  * @note    The use of this option has an overhead of 8 bytes for each
  *          region for each thread.
  * @note    Allowed values are 0..4, zero means none.
+ * @note    On context switch only the regions differing from those of the
+ *          previous thread are written into the MPU.
  */
 #if !defined(PORT_SWITCHED_REGIONS_NUMBER) || defined(__DOXYGEN__)
 #define PORT_SWITCHED_REGIONS_NUMBER    0
@@ -163,6 +165,19 @@
 #define CORTEX_SIMPLIFIED_PRIORITY      FALSE
 #endif
 
+/**
+ * @brief   Fast ISR exit.
+ * @details If enabled, ISRs not requiring a preemption return directly to
+ *          the interrupted thread without the artificial exception frame
+ *          and the SVC exception. Preemptions required by nested ISRs are
+ *          deferred to the PendSV exception which is tail-chained after
+ *          the last active ISR.
+ * @note    This option is only supported in advanced kernel mode.
+ */
+#if !defined(CORTEX_USE_FAST_IRQ_EXIT)
+#define CORTEX_USE_FAST_IRQ_EXIT        FALSE
+#endif
+
 /**
  * @brief   SVCALL handler priority.
  * @note    The default SVCALL handler priority is defaulted to
@@ -194,6 +209,10 @@
 #error "invalid PORT_SWITCHED_REGIONS_NUMBER value"
 #endif
 
+#if (CORTEX_USE_FAST_IRQ_EXIT == TRUE) && (CORTEX_SIMPLIFIED_PRIORITY == TRUE)
+#error "CORTEX_USE_FAST_IRQ_EXIT requires advanced kernel mode"
+#endif
+
 #if !defined(_FROM_ASM_)
 /**
  * @brief   MPU guard page size.
@@ -446,36 +465,37 @@ struct port_context {
 #define __PORT_SETUP_CONTEXT_SYSCALL(tp, wtop)
 #endif
 
-/* By default threads have all regions disabled.*/
+/* By default threads have all regions disabled, the RBAR values have the
+   VALID bit and the region number set.*/
 #if (PORT_SWITCHED_REGIONS_NUMBER == 0) || defined(__DOXYGEN__)
 #define __PORT_SETUP_CONTEXT_MPU(tp)
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 1) || defined(__DOXYGEN__)
 #define __PORT_SETUP_CONTEXT_MPU(tp)                                        \
-  (tp)->ctx.sp->regions[0].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                   \
   (tp)->ctx.sp->regions[0].rasr  = 0U
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 2) || defined(__DOXYGEN__)
 #define __PORT_SETUP_CONTEXT_MPU(tp)                                        \
-  (tp)->ctx.sp->regions[0].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                   \
   (tp)->ctx.sp->regions[0].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[1].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                   \
   (tp)->ctx.sp->regions[1].rasr  = 0U
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 3) || defined(__DOXYGEN__)
 #define __PORT_SETUP_CONTEXT_MPU(tp)                                        \
-  (tp)->ctx.sp->regions[0].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                   \
   (tp)->ctx.sp->regions[0].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[1].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                   \
   (tp)->ctx.sp->regions[1].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[2].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[2].rbar  = 0x12U;                                   \
   (tp)->ctx.sp->regions[2].rasr  = 0U
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 4) || defined(__DOXYGEN__)
 #define __PORT_SETUP_CONTEXT_MPU(tp)                                        \
-  (tp)->ctx.sp->regions[0].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                   \
   (tp)->ctx.sp->regions[0].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[1].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                   \
   (tp)->ctx.sp->regions[1].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[2].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[2].rbar  = 0x12U;                                   \
   (tp)->ctx.sp->regions[2].rasr  = 0U;                                      \
-  (tp)->ctx.sp->regions[3].rbar  = 0U;                                      \
+  (tp)->ctx.sp->regions[3].rbar  = 0x13U;                                   \
   (tp)->ctx.sp->regions[3].rasr  = 0U
 #else
 #endif
@@ -65,6 +65,13 @@ typedef uint32_t            ucnt_t;         /**< Generic unsigned counter.  */
  */
 #define NOINLINE           __attribute__((noinline))
 
+/**
+ * @brief   Places a function in the fast code section.
+ * @details The linker script can relocate the section into a RAM with no
+ *          wait states, ITCM-RAM where available.
+ */
+#define CC_FAST_CODE       __attribute__((section(".fastcode")))
+
 /**
  * @brief   Optimized thread function declaration macro.
  */
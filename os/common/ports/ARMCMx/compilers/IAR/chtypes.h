@@ -83,6 +83,13 @@ typedef uint32_t            ucnt_t;         /**< Generic unsigned counter.  */
  */
 #define NOINLINE            _Pragma("inline=never")
 
+/**
+ * @brief   Places a function in the fast code section.
+ * @note    Not supported with this compiler, functions are left in their
+ *          default section.
+ */
+#define CC_FAST_CODE
+
 /**
  * @brief   Optimized thread function declaration macro.
  */
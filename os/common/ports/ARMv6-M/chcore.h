@@ -63,7 +63,18 @@
  * @name    Port Capabilities and Constants
  * @{
  */
-#define PORT_SUPPORTS_RT                FALSE
+#define PORT_SUPPORTS_RT                PORT_USE_RT_COUNTER
+
+/**
+ * @brief   This port supports thread local storage.
+ */
+#define PORT_SUPPORTS_TLS               TRUE
+
+/**
+ * @brief   Size of the TLS thread control block.
+ * @note    The ARM EABI reserves two words before the TLS data.
+ */
+#define PORT_TLS_TCB_SIZE               8U
 
 /**
  * @brief   Natural alignment constant.
@@ -166,6 +177,38 @@
 #define PORT_USE_ALT_TIMER              FALSE
 #endif
 
+/**
+ * @brief   Enables the realtime counter emulation.
+ * @details The architecture has no cycle counter, if this option is
+ *          enabled then the realtime counter is read from the counter
+ *          register of a free running timer.
+ * @note    The timer must be configured and started by the application
+ *          before the kernel initialization, the realtime counter
+ *          frequency is the timer clock frequency.
+ */
+#if !defined(PORT_USE_RT_COUNTER)
+#define PORT_USE_RT_COUNTER             FALSE
+#endif
+
+/**
+ * @brief   Address of the free running counter register.
+ * @details It is the 32 bits counter or the low part of a counter made
+ *          of two chained 16 bits timers, for example @p &TIM2->CNT.
+ */
+#if defined(__DOXYGEN__)
+#define PORT_RT_COUNTER_ADDRESS         (&TIM2->CNT)
+#endif
+
+/**
+ * @brief   Address of the high part counter register.
+ * @details If defined then the realtime counter is made of two 16 bits
+ *          timers, the timer counting the overflows of the first one is
+ *          read from this address.
+ */
+#if defined(__DOXYGEN__)
+#define PORT_RT_COUNTER_HIGH_ADDRESS    (&TIM22->CNT)
+#endif
+
 /**
  * @brief   Enables the use of the WFI instruction in the idle thread loop.
  */
@@ -194,6 +237,12 @@
   #error "ChibiOS Cortex-M0 port not licensed"
 #endif
 
+#if (PORT_USE_RT_COUNTER == TRUE) && !defined(__DOXYGEN__)
+  #if !defined(PORT_RT_COUNTER_ADDRESS)
+    #error "PORT_USE_RT_COUNTER requires PORT_RT_COUNTER_ADDRESS"
+  #endif
+#endif
+
 /* Handling a GCC problem impacting ARMv6-M.*/
 #if defined(__GNUC__) && !defined(PORT_IGNORE_GCC_VERSION_CHECK)
   #if ( __GNUC__ > 5 ) && ( __GNUC__ < 10 )
@@ -435,6 +484,14 @@ struct port_context {
   } while (0)
 #endif
 
+/**
+ * @brief   Returns the stack pointer of the current thread.
+ * @details Threads run on the process stack so this macro can also be used
+ *          from interrupt handlers in order to sample the stack pointer of
+ *          the interrupted thread.
+ */
+#define port_get_thread_stack_pointer() __get_PSP()
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -577,6 +634,31 @@ static inline void port_wait_for_interrupt(void) {
 #endif
 }
 
+#if (PORT_USE_RT_COUNTER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the current value of the realtime counter.
+ * @note    With chained timers the high part is read twice, the read is
+ *          repeated if it changed meanwhile.
+ *
+ * @return              The realtime counter value.
+ */
+static inline rtcnt_t port_rt_get_counter_value(void) {
+
+#if !defined(PORT_RT_COUNTER_HIGH_ADDRESS)
+  return (rtcnt_t)*(PORT_RT_COUNTER_ADDRESS);
+#else
+  uint32_t h, l;
+
+  do {
+    h = (uint32_t)*(PORT_RT_COUNTER_HIGH_ADDRESS);
+    l = (uint32_t)*(PORT_RT_COUNTER_ADDRESS);
+  } while (h != (uint32_t)*(PORT_RT_COUNTER_HIGH_ADDRESS));
+
+  return (rtcnt_t)((h << 16) | (l & 0xFFFFU));
+#endif
+}
+#endif
+
 #endif /* !defined(_FROM_ASM_) */
 
 #endif /* CHCORE_H */
@@ -33,6 +33,15 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CORTEX_USE_FPU_TRACKING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Size of the exception frame specified by an EXC_RETURN value.
+ * @note    The frame includes the FPU context if bit 4 is zero.
+ */
+#define EXTCTX_SIZE(lr)                                                     \
+  ((((lr) & 0x10U) != 0U) ? PORT_EXTCTX_INT_SIZE : sizeof (struct port_extctx))
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -179,7 +188,11 @@ void SVC_Handler(void) {
 
     /* Unstacking procedure, discarding the current exception context and
        positioning the stack to point to the real one.*/
+#if CORTEX_USE_FPU_TRACKING == TRUE
+    psp += EXTCTX_SIZE((uint32_t)__builtin_return_address(0));
+#else
     psp += sizeof (struct port_extctx);
+#endif
 
 #if CORTEX_USE_FPU == TRUE
     /* Enforcing unstacking of the FP part of the context.*/
@@ -224,7 +237,11 @@ void PendSV_Handler(void) {
 
   /* Discarding the current exception context and positioning the stack to
      point to the real one.*/
+#if CORTEX_USE_FPU_TRACKING == TRUE
+  psp += EXTCTX_SIZE((uint32_t)__builtin_return_address(0));
+#else
   psp += sizeof (struct port_extctx);
+#endif
 
 #if PORT_USE_SYSCALL == TRUE
   {
@@ -240,6 +257,22 @@ void PendSV_Handler(void) {
 }
 #endif /* CORTEX_SIMPLIFIED_PRIORITY == TRUE */
 
+#if (CORTEX_SIMPLIFIED_PRIORITY == FALSE) &&                                \
+    (CORTEX_USE_FAST_IRQ_EXIT == TRUE)
+/**
+ * @brief   PendSV vector.
+ * @details The PendSV vector is used in fast ISR exit mode for serving
+ *          preemptions required by nested ISRs.
+ */
+/*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+void PendSV_Handler(void) {
+/*lint -restore*/
+
+  PORT_IRQ_PROLOGUE();
+  PORT_IRQ_EPILOGUE();
+}
+#endif /* CORTEX_USE_FAST_IRQ_EXIT == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -310,14 +343,34 @@ void __port_set_region(void) {
 
 /**
  * @brief   Exception exit redirection to @p __port_switch_from_isr().
+ *
+ * @param[in] lr        EXC_RETURN value of the exception, only with
+ *                      @p CORTEX_USE_FPU_TRACKING enabled
  */
+#if (CORTEX_USE_FPU_TRACKING == FALSE) || defined(__DOXYGEN__)
 void __port_irq_epilogue(void) {
+#else
+void __port_irq_epilogue(uint32_t lr) {
+#endif
 
   port_lock_from_isr();
   if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) != 0U) {
     struct port_extctx *ectxp;
     uint32_t s_psp;
 
+#if CORTEX_USE_FAST_IRQ_EXIT == TRUE
+    /* Fast path, returning directly to the interrupted thread if there is
+       no need to preempt it. A preemption required by an ISR nesting
+       before the exception return is served by PendSV.*/
+    if (!chSchIsPreemptionRequired()) {
+      port_unlock_from_isr();
+      return;
+    }
+
+    /* The context switch is performed here, a deferred one is redundant.*/
+    SCB->ICSR = SCB_ICSR_PENDSVCLR_Msk;
+#endif
+
 #if CORTEX_USE_FPU == TRUE
     /* Enforcing a lazy FPU state save by accessing the FPCSR register.*/
     (void) __get_FPSCR();
@@ -361,17 +414,31 @@ void __port_irq_epilogue(void) {
 
     /* Adding an artificial exception return context, there is no need to
        populate it fully.*/
+#if CORTEX_USE_FPU_TRACKING == TRUE
+    /* The artificial context has the same format of the exception
+       context, R0 carries the FPCA bit to the exit code.*/
+    s_psp -= EXTCTX_SIZE(lr);
+    ectxp = (struct port_extctx *)s_psp;
+    if ((lr & 0x10U) == 0U) {
+      ectxp->r0    = CONTROL_FPCA_Msk;
+      ectxp->fpscr = FPU->FPDSCR;
+    }
+    else {
+      ectxp->r0    = 0U;
+    }
+#else
     s_psp -= sizeof (struct port_extctx);
 
     /* The port_extctx structure is pointed by the S-PSP register.*/
     ectxp = (struct port_extctx *)s_psp;
-
-    /* Setting up a fake XPSR register value.*/
-    ectxp->xpsr = 0x01000000U;
 #if CORTEX_USE_FPU == TRUE
     ectxp->fpscr = FPU->FPDSCR;
+#endif
 #endif
 
+    /* Setting up a fake XPSR register value.*/
+    ectxp->xpsr = 0x01000000U;
+
     /* Writing back the modified S-PSP value.*/
     __set_PSP(s_psp);
 
@@ -391,6 +458,13 @@ void __port_irq_epilogue(void) {
        order to keep the rest of the context switch atomic.*/
     return;
   }
+#if CORTEX_USE_FAST_IRQ_EXIT == TRUE
+  else if (chSchIsPreemptionRequired()) {
+    /* Nested ISR, the preemption is deferred to PendSV which has the
+       lowest kernel priority and is served after all the active ISRs.*/
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+  }
+#endif
   port_unlock_from_isr();
 }
 
@@ -118,6 +118,8 @@
  * @note    The use of this option has an overhead of 8 bytes for each
  *          region for each thread.
  * @note    Allowed values are 0..4, zero means none.
+ * @note    On context switch only the regions differing from those of the
+ *          previous thread are written into the MPU.
  */
 #if !defined(PORT_SWITCHED_REGIONS_NUMBER) || defined(__DOXYGEN__)
 #define PORT_SWITCHED_REGIONS_NUMBER    0
@@ -199,6 +201,21 @@
 #error "the selected core does not have an FPU"
 #endif
 
+/**
+ * @brief   Per-thread FPU context tracking.
+ * @details If enabled, the FPU context is saved and restored on context
+ *          switch only for threads that used the FPU. A thread becomes an
+ *          FPU user on its first FPU instruction, integer-only threads
+ *          have smaller exception and context switch frames.
+ * @note    Threads using the FPU must add @p PORT_FPU_STACK_OVERHEAD to
+ *          their stack size.
+ * @note    This option is only supported by the GCC port and is not
+ *          compatible with @p PORT_USE_SYSCALL.
+ */
+#if !defined(CORTEX_USE_FPU_TRACKING)
+#define CORTEX_USE_FPU_TRACKING         FALSE
+#endif
+
 /**
  * @brief   Simplified priority handling flag.
  * @details Activating this option makes the Kernel work in compact mode.
@@ -209,6 +226,19 @@
 #define CORTEX_SIMPLIFIED_PRIORITY      FALSE
 #endif
 
+/**
+ * @brief   Fast ISR exit.
+ * @details If enabled, ISRs not requiring a preemption return directly to
+ *          the interrupted thread without the artificial exception frame
+ *          and the SVC exception. Preemptions required by nested ISRs are
+ *          deferred to the PendSV exception which is tail-chained after
+ *          the last active ISR.
+ * @note    This option is only supported in advanced kernel mode.
+ */
+#if !defined(CORTEX_USE_FAST_IRQ_EXIT)
+#define CORTEX_USE_FAST_IRQ_EXIT        FALSE
+#endif
+
 /**
  * @brief   SVCALL handler priority.
  * @note    The default SVCALL handler priority is defaulted to
@@ -240,6 +270,22 @@
   #error "invalid PORT_SWITCHED_REGIONS_NUMBER value"
 #endif
 
+#if (CORTEX_USE_FAST_IRQ_EXIT == TRUE) && (CORTEX_SIMPLIFIED_PRIORITY == TRUE)
+  #error "CORTEX_USE_FAST_IRQ_EXIT requires advanced kernel mode"
+#endif
+
+#if CORTEX_USE_FPU_TRACKING == TRUE
+  #if CORTEX_USE_FPU == FALSE
+    #error "CORTEX_USE_FPU_TRACKING requires CORTEX_USE_FPU"
+  #endif
+  #if !defined(__GNUC__)
+    #error "CORTEX_USE_FPU_TRACKING is only supported by the GCC port"
+  #endif
+  #if PORT_USE_SYSCALL == TRUE
+    #error "CORTEX_USE_FPU_TRACKING not compatible with PORT_USE_SYSCALL"
+  #endif
+#endif
+
 /**
  * @name    Port Capabilities and Constants
  * @{
@@ -249,6 +295,17 @@
  */
 #define PORT_SUPPORTS_RT                TRUE
 
+/**
+ * @brief   This port supports thread local storage.
+ */
+#define PORT_SUPPORTS_TLS               TRUE
+
+/**
+ * @brief   Size of the TLS thread control block.
+ * @note    The ARM EABI reserves two words before the TLS data.
+ */
+#define PORT_TLS_TCB_SIZE               8U
+
 /**
  * @brief   Natural alignment constant.
  * @note    It is the minimum alignment for pointer-size variables.
@@ -482,7 +539,11 @@ struct port_intctx {
     uint32_t    rasr;
   } regions[PORT_SWITCHED_REGIONS_NUMBER];
 #endif
-#if CORTEX_USE_FPU
+#if CORTEX_USE_FPU_TRACKING == TRUE
+  /* The registers s16...s31 are stacked above this field when it is not
+     zero.*/
+  uint32_t      fpca;
+#elif CORTEX_USE_FPU
   uint32_t      s16;
   uint32_t      s17;
   uint32_t      s18;
@@ -554,40 +615,49 @@ struct port_context {
   #define __PORT_SETUP_CONTEXT_SYSCALL(tp, wtop)
 #endif
 
-/* By default threads have all regions disabled.*/
+/* By default threads are not FPU users.*/
+#if (CORTEX_USE_FPU_TRACKING == TRUE) || defined(__DOXYGEN__)
+  #define __PORT_SETUP_CONTEXT_FPU(tp)                                      \
+    (tp)->ctx.sp->fpca = 0U;
+#else
+  #define __PORT_SETUP_CONTEXT_FPU(tp)
+#endif
+
+/* By default threads have all regions disabled, the RBAR values have the
+   VALID bit and the region number set.*/
 #if (PORT_SWITCHED_REGIONS_NUMBER == 0) || defined(__DOXYGEN__)
   #define __PORT_SETUP_CONTEXT_MPU(tp)
 
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 1) || defined(__DOXYGEN__)
   #define __PORT_SETUP_CONTEXT_MPU(tp)                                      \
-    (tp)->ctx.sp->regions[0].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                 \
     (tp)->ctx.sp->regions[0].rasr  = 0U
 
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 2) || defined(__DOXYGEN__)
   #define __PORT_SETUP_CONTEXT_MPU(tp)                                      \
-    (tp)->ctx.sp->regions[0].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                 \
     (tp)->ctx.sp->regions[0].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[1].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                 \
     (tp)->ctx.sp->regions[1].rasr  = 0U
 
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 3) || defined(__DOXYGEN__)
   #define __PORT_SETUP_CONTEXT_MPU(tp)                                      \
-    (tp)->ctx.sp->regions[0].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                 \
     (tp)->ctx.sp->regions[0].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[1].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                 \
     (tp)->ctx.sp->regions[1].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[2].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[2].rbar  = 0x12U;                                 \
     (tp)->ctx.sp->regions[2].rasr  = 0U
 
 #elif (PORT_SWITCHED_REGIONS_NUMBER == 4) || defined(__DOXYGEN__)
   #define __PORT_SETUP_CONTEXT_MPU(tp)                                      \
-    (tp)->ctx.sp->regions[0].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[0].rbar  = 0x10U;                                 \
     (tp)->ctx.sp->regions[0].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[1].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[1].rbar  = 0x11U;                                 \
     (tp)->ctx.sp->regions[1].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[2].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[2].rbar  = 0x12U;                                 \
     (tp)->ctx.sp->regions[2].rasr  = 0U;                                    \
-    (tp)->ctx.sp->regions[3].rbar  = 0U;                                    \
+    (tp)->ctx.sp->regions[3].rbar  = 0x13U;                                 \
     (tp)->ctx.sp->regions[3].rasr  = 0U
 
 #else
@@ -605,19 +675,50 @@ struct port_context {
   (tp)->ctx.sp->r4 = (uint32_t)(pf);                                        \
   (tp)->ctx.sp->r5 = (uint32_t)(arg);                                       \
   (tp)->ctx.sp->lr = (uint32_t)__port_thread_start;                         \
+  __PORT_SETUP_CONTEXT_FPU(tp);                                             \
   __PORT_SETUP_CONTEXT_MPU(tp);                                             \
   __PORT_SETUP_CONTEXT_SYSCALL(tp, wtop);                                   \
 } while (0)
 
+#if (CORTEX_USE_FPU_TRACKING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Size of an exception frame without FPU context.
+ */
+#define PORT_EXTCTX_INT_SIZE            (8U * sizeof (uint32_t))
+
+/**
+ * @brief   Additional stack size required by threads using the FPU.
+ * @details It is the FPU part of the exception frame plus the registers
+ *          s16...s31 saved on context switch.
+ */
+#define PORT_FPU_STACK_OVERHEAD                                             \
+  ((sizeof (struct port_extctx) - PORT_EXTCTX_INT_SIZE) +                   \
+   (16U * sizeof (uint32_t)))
+
 /**
  * @brief   Computes the thread working area global size.
  * @note    There is no need to perform alignments in this macro.
+ * @note    The size is computed for integer-only threads.
  */
+#define PORT_WA_SIZE(n) ((size_t)PORT_GUARD_PAGE_SIZE +                     \
+                         sizeof (struct port_intctx) +                      \
+                         PORT_EXTCTX_INT_SIZE +                             \
+                         (size_t)(n) +                                      \
+                         (size_t)PORT_INT_REQUIRED_STACK)
+
+#else
+/**
+ * @brief   Additional stack size required by threads using the FPU.
+ * @note    The FPU context is accounted for all threads.
+ */
+#define PORT_FPU_STACK_OVERHEAD         0U
+
 #define PORT_WA_SIZE(n) ((size_t)PORT_GUARD_PAGE_SIZE +                     \
                          sizeof (struct port_intctx) +                      \
                          sizeof (struct port_extctx) +                      \
                          (size_t)(n) +                                      \
                          (size_t)PORT_INT_REQUIRED_STACK)
+#endif
 
 /**
  * @brief   Static working area allocation.
@@ -648,7 +749,14 @@ struct port_context {
  * @details This macro must be inserted at the end of all IRQ handlers
  *          enabled to invoke system APIs.
  */
-#define PORT_IRQ_EPILOGUE() __port_irq_epilogue()
+#if (CORTEX_USE_FPU_TRACKING == FALSE) || defined(__DOXYGEN__)
+  #define PORT_IRQ_EPILOGUE() __port_irq_epilogue()
+
+#else
+  /* The EXC_RETURN value specifies the exception frame format.*/
+  #define PORT_IRQ_EPILOGUE()                                               \
+    __port_irq_epilogue((uint32_t)__builtin_return_address(0))
+#endif
 
 /**
  * @brief   IRQ handler function declaration.
@@ -708,6 +816,24 @@ struct port_context {
   #endif
 #endif
 
+/**
+ * @brief   Counts the leading zeros in a 32 bits word.
+ * @details This macro is used by the kernel for fast priority bitmap
+ *          lookups, it is implemented using the @p CLZ instruction.
+ * @note    The result is undefined for a zero value.
+ *
+ * @param[in] n         the value to be scanned
+ */
+#define port_clz32(n) __CLZ((uint32_t)(n))
+
+/**
+ * @brief   Returns the stack pointer of the current thread.
+ * @details Threads run on the process stack so this macro can also be used
+ *          from interrupt handlers in order to sample the stack pointer of
+ *          the interrupted thread.
+ */
+#define port_get_thread_stack_pointer() __get_PSP()
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -718,7 +844,11 @@ struct port_context {
 extern "C" {
 #endif
   void port_init(os_instance_t *oip);
+#if CORTEX_USE_FPU_TRACKING == FALSE
   void __port_irq_epilogue(void);
+#else
+  void __port_irq_epilogue(uint32_t lr);
+#endif
   void __port_switch(thread_t *ntp, thread_t *otp);
   void __port_thread_start(void);
   void __port_switch_from_isr(void);
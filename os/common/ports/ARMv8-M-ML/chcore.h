@@ -532,6 +532,24 @@ struct port_context {
   } while (0)
 #endif
 
+/**
+ * @brief   Counts the leading zeros in a 32 bits word.
+ * @details This macro is used by the kernel for fast priority bitmap
+ *          lookups, it is implemented using the @p CLZ instruction.
+ * @note    The result is undefined for a zero value.
+ *
+ * @param[in] n         the value to be scanned
+ */
+#define port_clz32(n) __CLZ((uint32_t)(n))
+
+/**
+ * @brief   Returns the stack pointer of the current thread.
+ * @details Threads run on the process stack so this macro can also be used
+ *          from interrupt handlers in order to sample the stack pointer of
+ *          the interrupted thread.
+ */
+#define port_get_thread_stack_pointer() __get_PSP()
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -60,6 +60,8 @@ bool __avr_in_isr;
  *          is responsible for the context switch between 2 threads.
  * @note    The implementation of this code affects <b>directly</b> the context
  *          switch performance so optimize here as much as you can.
+ * @note    Only the call-saved registers are saved, the call-clobbered
+ *          registers are already saved by the caller when required.
  *
  * @param[in] ntp       the thread to be switched in
  * @param[in] otp       the thread to be switched out
@@ -156,4 +158,73 @@ void _port_thread_start(void) {
   asm volatile ("call    chThdExit");  /* Used for avr5 Architecture. */
 }
 
+#if (PORT_AVR_LAZY_IRQ_SAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   IRQ reschedule entry.
+ * @details Invoked by @p PORT_IRQ_EPILOGUE() when a reschedule could be
+ *          required, the call-clobbered registers are saved here because
+ *          the IRQ handler only saved the registers it used.
+ * @note    All registers are preserved.
+ */
+#if !defined(__DOXYGEN__)
+__attribute__((naked))
+#endif
+void _port_irq_reschedule(void) {
+
+  asm volatile ("push    r0");
+  asm volatile ("in      r0, 0x3f");
+  asm volatile ("push    r0");
+  asm volatile ("push    r1");
+  asm volatile ("clr     r1");
+  asm volatile ("push    r18");
+  asm volatile ("push    r19");
+  asm volatile ("push    r20");
+  asm volatile ("push    r21");
+  asm volatile ("push    r22");
+  asm volatile ("push    r23");
+  asm volatile ("push    r24");
+  asm volatile ("push    r25");
+  asm volatile ("push    r26");
+  asm volatile ("push    r27");
+  asm volatile ("push    r30");
+  asm volatile ("push    r31");
+
+  asm volatile ("%~call    _port_irq_preempt" : : : "memory");
+
+  asm volatile ("pop     r31");
+  asm volatile ("pop     r30");
+  asm volatile ("pop     r27");
+  asm volatile ("pop     r26");
+  asm volatile ("pop     r25");
+  asm volatile ("pop     r24");
+  asm volatile ("pop     r23");
+  asm volatile ("pop     r22");
+  asm volatile ("pop     r21");
+  asm volatile ("pop     r20");
+  asm volatile ("pop     r19");
+  asm volatile ("pop     r18");
+  asm volatile ("pop     r1");
+  asm volatile ("pop     r0");
+  asm volatile ("out     0x3f, r0");
+  asm volatile ("pop     r0");
+  asm volatile ("ret");
+}
+
+/**
+ * @brief   IRQ preemption code.
+ * @note    Not an user function, it is invoked by
+ *          @p _port_irq_reschedule().
+ */
+#if !defined(__DOXYGEN__)
+__attribute__((used))
+#endif
+void _port_irq_preempt(void) {
+
+  _dbg_check_lock();
+  if (chSchIsPreemptionRequired())
+    chSchDoReschedule();
+  _dbg_check_unlock();
+}
+#endif /* PORT_AVR_LAZY_IRQ_SAVE == TRUE */
+
 /** @} */
@@ -140,6 +140,19 @@ extern bool __avr_in_isr;
 #define PORT_AVR_WFI_SLEEP_IDLE      FALSE
 #endif
 
+/**
+ * @brief   Enables the lazy registers save in IRQ handlers.
+ * @details If enabled the IRQ handlers only save the registers used by
+ *          their own code, the remaining call-clobbered registers are
+ *          saved by @p _port_irq_reschedule() only when a reschedule is
+ *          required.
+ * @note    Handlers calling functions still save the whole call-clobbered
+ *          set, the compiler does so.
+ */
+#if !defined(PORT_AVR_LAZY_IRQ_SAVE) || defined(__DOXYGEN__)
+#define PORT_AVR_LAZY_IRQ_SAVE          FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -298,6 +311,47 @@ struct port_context {
  */
 #define PORT_IRQ_IS_VALID_KERNEL_PRIORITY(n) false
 
+#if (PORT_AVR_LAZY_IRQ_SAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Inline reschedule check.
+ * @details This check does not call functions so the registers not used
+ *          by the handler are not saved, it can give false positives, the
+ *          final decision is taken by @p chSchIsPreemptionRequired().
+ */
+#if defined(_CHIBIOS_NIL_)
+#define __port_irq_resched_hint() chSchIsRescRequiredI()
+#elif CH_CFG_TIME_QUANTUM > 0
+#define __port_irq_resched_hint()                                           \
+  (firstprio(&currcore->rlist.pqueue) >= chThdGetSelfX()->hdr.pqueue.prio)
+#else
+#define __port_irq_resched_hint()                                           \
+  (firstprio(&currcore->rlist.pqueue) > chThdGetSelfX()->hdr.pqueue.prio)
+#endif
+
+/**
+ * @brief   IRQ prologue code.
+ * @details This macro must be inserted at the start of all IRQ handlers
+ *          enabled to invoke system APIs.
+ */
+#define PORT_IRQ_PROLOGUE() {                                               \
+  __avr_in_isr = true;                                                      \
+}
+
+/**
+ * @brief   IRQ epilogue code.
+ * @details This macro must be inserted at the end of all IRQ handlers
+ *          enabled to invoke system APIs.
+ * @note    The call is hidden to the compiler, @p _port_irq_reschedule()
+ *          preserves all registers.
+ */
+#define PORT_IRQ_EPILOGUE() {                                               \
+  __avr_in_isr = false;                                                     \
+  if (__port_irq_resched_hint()) {                                          \
+    asm volatile ("%~call    _port_irq_reschedule" : : : "memory");         \
+  }                                                                         \
+}
+
+#else /* PORT_AVR_LAZY_IRQ_SAVE == FALSE */
 /**
  * @brief   IRQ prologue code.
  * @details This macro must be inserted at the start of all IRQ handlers
@@ -323,6 +377,7 @@ struct port_context {
     chSchDoReschedule();                                                    \
   _dbg_check_unlock();                                                      \
 }
+#endif /* PORT_AVR_LAZY_IRQ_SAVE == FALSE */
 
 /**
  * @brief   IRQ handler function declaration.
@@ -375,6 +430,10 @@ extern "C" {
 #endif
   void _port_switch(thread_t *ntp, thread_t *otp);
   void _port_thread_start(void);
+#if PORT_AVR_LAZY_IRQ_SAVE == TRUE
+  void _port_irq_reschedule(void);
+  void _port_irq_preempt(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -169,6 +169,29 @@
 #define PPC_ENABLE_WFI_IDLE             FALSE
 #endif
 
+/**
+ * @brief   Enables the INTC hardware vector mode.
+ * @details Each interrupt source enters through its own prologue instead
+ *          of the common IVOR4 handler reading the INTC acknowledge
+ *          register, this reduces the interrupt latency.
+ * @note    The SPRG1 register is used by the prologues.
+ */
+#if !defined(PPC_USE_HW_VECTORS) || defined(__DOXYGEN__)
+#define PPC_USE_HW_VECTORS              FALSE
+#endif
+
+/**
+ * @brief   Enables the SPE context switching.
+ * @details The upper halves of the GPRs, the accumulator and the SPEFSCR
+ *          register are saved only for threads having enabled the SPE
+ *          unit using @p port_spe_enable(), the other threads keep the
+ *          32 bits context switch.
+ * @note    The kernel and the ISRs must not use SPE instructions.
+ */
+#if !defined(PPC_USE_SPE) || defined(__DOXYGEN__)
+#define PPC_USE_SPE                     FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -181,6 +204,43 @@
 #error "the selected MCU does not support BookE instructions set"
 #endif
 
+/**
+ * @brief   SPE unit support.
+ */
+#if !defined(PPC_SUPPORTS_SPE) || defined(__DOXYGEN__)
+#if (PPC_VARIANT == PPC_VARIANT_e200z3) ||                                  \
+    (PPC_VARIANT == PPC_VARIANT_e200z4) || defined(__DOXYGEN__)
+#define PPC_SUPPORTS_SPE                TRUE
+#else
+#define PPC_SUPPORTS_SPE                FALSE
+#endif
+#endif
+
+#if PPC_USE_HW_VECTORS && !PPC_SUPPORTS_IVORS
+#error "PPC_USE_HW_VECTORS requires IVOR registers"
+#endif
+
+#if PPC_USE_SPE && !PPC_SUPPORTS_SPE
+#error "the selected MCU does not support the SPE unit"
+#endif
+
+#if (PPC_USE_HW_VECTORS || PPC_USE_SPE) &&                                  \
+    !(defined(__GNUC__) && !defined(__ghs__))
+#error "PPC_USE_HW_VECTORS and PPC_USE_SPE are only supported with GCC"
+#endif
+
+/**
+ * @brief   MSR SPE enable bit.
+ */
+#define PPC_MSR_SPE                     0x02000000U
+
+/**
+ * @brief   INTC hardware vector mode enable bit for core 0.
+ */
+#if !defined(INTC_BCR_HVEN) || defined(__DOXYGEN__)
+#define INTC_BCR_HVEN                   0x00000001U
+#endif
+
 /**
  * @brief   Name of the architecture variant.
  */
@@ -313,6 +373,26 @@ struct port_extctx {
  * @note    LR is stored in the caller context so it is not present in this
  *          structure.
  */
+#if PPC_USE_SPE || defined(__DOXYGEN__)
+/**
+ * @brief   System saved context.
+ * @details This structure represents the inner stack frame during a context
+ *          switching of threads that may use the SPE unit.
+ * @note    The whole 64 bits GPRs are saved for threads with the SPE unit
+ *          enabled, for the other threads only R14...R31 are stored as 32
+ *          bits words starting from @p gpr[14].
+ * @note    LR is stored in the caller context so it is not present in this
+ *          structure.
+ */
+struct port_intctx {
+  uint64_t      gpr[32];            /* R1, R2, R13 slots not used.          */
+  regppc_t      cr;
+  regppc_t      spe;                /* Non-zero if SPE context saved.       */
+  regppc_t      spefscr;
+  regppc_t      scratch;
+  uint64_t      acc;
+};
+#else /* !PPC_USE_SPE */
 struct port_intctx {
   regppc_t      cr;                 /* Part of it is not volatile...        */
   regppc_t      r14;
@@ -335,6 +415,7 @@ struct port_intctx {
   regppc_t      r31;
   regppc_t      padding;
 };
+#endif /* !PPC_USE_SPE */
 
 /**
  * @brief   Platform dependent part of the @p thread_t structure.
@@ -356,6 +437,17 @@ struct port_context {
  * @details This code usually setup the context switching frame represented
  *          by an @p port_intctx structure.
  */
+#if PPC_USE_SPE || defined(__DOXYGEN__)
+#define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
+  uint8_t *sp = (uint8_t *)(wtop) - sizeof(struct port_eabi_frame);         \
+  ((struct port_eabi_frame *)sp)->slink = 0;                                \
+  ((struct port_eabi_frame *)sp)->shole = (uint32_t)_port_thread_start;     \
+  (tp)->ctx.sp = (struct port_intctx *)(sp - sizeof(struct port_intctx));   \
+  (tp)->ctx.sp->spe = 0;                                                    \
+  ((regppc_t *)&(tp)->ctx.sp->gpr[14])[17] = (regppc_t)(arg);               \
+  ((regppc_t *)&(tp)->ctx.sp->gpr[14])[16] = (regppc_t)(pf);                \
+}
+#else
 #define PORT_SETUP_CONTEXT(tp, wbase, wtop, pf, arg) {                      \
   uint8_t *sp = (uint8_t *)(wtop) - sizeof(struct port_eabi_frame);         \
   ((struct port_eabi_frame *)sp)->slink = 0;                                \
@@ -364,6 +456,7 @@ struct port_context {
   (tp)->ctx.sp->r31 = (regppc_t)(arg);                                      \
   (tp)->ctx.sp->r30 = (regppc_t)(pf);                                       \
 }
+#endif
 
 /**
  * @brief   Computes the thread working area global size.
@@ -510,6 +603,9 @@ extern "C" {
 
 extern void _IVOR4(void);
 extern void _IVOR10(void);
+#if PPC_USE_HW_VECTORS
+extern void _hw_vectors(void);
+#endif
 
 /**
  * @brief   Kernel port layer initialization.
@@ -527,8 +623,13 @@ static inline void port_init(void) {
 #if PPC_SUPPORTS_IVORS
   {
     /* The CPU supports IVOR registers, the kernel requires IVOR4 and IVOR10
-       and the initialization is performed here.*/
+       and the initialization is performed here. In hardware vector mode
+       IVOR4 points to the branch table of the interrupt sources.*/
+#if PPC_USE_HW_VECTORS
+    port_write_spr(404, (uint32_t)_hw_vectors);
+#else
     port_write_spr(404, (uint32_t)_IVOR4);
+#endif
 
 #if PPC_SUPPORTS_DECREMENTER
     port_write_spr(410, (uint32_t)_IVOR10);
@@ -536,6 +637,14 @@ static inline void port_init(void) {
   }
 #endif
 
+#if PPC_USE_HW_VECTORS
+  /* INTC initialization, hardware vector mode, 4 bytes vectors, starting
+     at priority 0.*/
+  INTC_BCR = INTC_BCR_HVEN;
+  for (i = 0; i < PPC_CORE_NUMBER; i++) {
+    INTC_CPR(i)   = 0;
+  }
+#else
   /* INTC initialization, software vector mode, 4 bytes vectors, starting
      at priority 0.*/
   INTC_BCR = 0;
@@ -543,6 +652,7 @@ static inline void port_init(void) {
     INTC_CPR(i)   = 0;
     INTC_IACKR(i) = (uint32_t)_vectors;
   }
+#endif
 }
 
 /**
@@ -689,6 +799,36 @@ static inline void port_wait_for_interrupt(void) {
 #endif
 }
 
+#if PPC_USE_SPE || defined(__DOXYGEN__)
+/**
+ * @brief   Enables the SPE unit for the current thread.
+ * @details The SPE context of the thread is saved and restored on context
+ *          switches from now on.
+ */
+static inline void port_spe_enable(void) {
+  uint32_t msr;
+
+  asm volatile ("mfmsr   %[p0]" : [p0] "=r" (msr) :);
+  msr |= PPC_MSR_SPE;
+#if PPC_USE_VLE
+  asm volatile ("mtmsr   %[p0]\n\tse_isync" : : [p0] "r" (msr) : "memory");
+#else
+  asm volatile ("mtmsr   %[p0]\n\tisync" : : [p0] "r" (msr) : "memory");
+#endif
+}
+
+/**
+ * @brief   Disables the SPE unit for the current thread.
+ */
+static inline void port_spe_disable(void) {
+  uint32_t msr;
+
+  asm volatile ("mfmsr   %[p0]" : [p0] "=r" (msr) :);
+  msr &= ~PPC_MSR_SPE;
+  asm volatile ("mtmsr   %[p0]" : : [p0] "r" (msr) : "memory");
+}
+#endif /* PPC_USE_SPE */
+
 /**
  * @brief   Returns the current value of the realtime counter.
  *
@@ -61,6 +61,8 @@ typedef struct {
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+extern uint32_t __fastcode_init_text__, __fastcode_init__, __fastcode_end__;
+
 #if (CRT1_AREAS_NUMBER > 0) || defined(__DOXYGEN__)
 extern uint32_t __ram0_init_text__, __ram0_init__, __ram0_clear__, __ram0_noinit__;
 #endif
@@ -187,28 +189,84 @@ void __default_exit(void) {
   }
 }
 
+/**
+ * @brief   Initializes a RAM area.
+ * @details The initialization data is copied then the clear area is zeroed,
+ *          the default implementation uses CPU loops moving four words
+ *          per iteration.
+ * @note    This function is a weak symbol, it can be redefined in order
+ *          to perform the initialization using a DMA engine. The function
+ *          is invoked before the DATA and BSS segments initialization
+ *          so it must not rely on initialized variables.
+ *
+ * @param[in] tp        initialization data
+ * @param[in] p         area base, start of the initialized part
+ * @param[in] cp        start of the clear part
+ * @param[in] np        start of the not initialized part
+ */
+#if !defined(__DOXYGEN__)
+__attribute__((weak))
+#endif
+/*lint -save -e9075 [8.4] All symbols are invoked from asm context.*/
+void __init_ram_area(uint32_t *tp, uint32_t *p, uint32_t *cp, uint32_t *np) {
+/*lint -restore*/
+
+  /* Copying initialization data.*/
+  while ((cp - p) >= 4) {
+    p[0] = tp[0];
+    p[1] = tp[1];
+    p[2] = tp[2];
+    p[3] = tp[3];
+    p  += 4;
+    tp += 4;
+  }
+  while (p < cp) {
+    *p = *tp;
+    p++;
+    tp++;
+  }
+
+  /* Zeroing clear area.*/
+  while ((np - p) >= 4) {
+    p[0] = 0U;
+    p[1] = 0U;
+    p[2] = 0U;
+    p[3] = 0U;
+    p += 4;
+  }
+  while (p < np) {
+    *p = 0U;
+    p++;
+  }
+}
+
 /**
  * @brief   Performs the initialization of the various RAM areas.
+ * @details The fast code area is copied first, it is empty if the linker
+ *          script does not relocate the fast code section.
  */
 void __init_ram_areas(void) {
 #if CRT1_AREAS_NUMBER > 0
   const ram_init_area_t *rap = ram_areas;
+#endif
 
-  do {
-    uint32_t *tp = rap->init_text_area;
-    uint32_t *p = rap->init_area;
-
-    /* Copying initialization data.*/
-    while (p < rap->clear_area) {
-      *p = *tp;
-      p++;
-      tp++;
-    }
+  if (&__fastcode_init__ < &__fastcode_end__) {
+    __init_ram_area(&__fastcode_init_text__, &__fastcode_init__,
+                    &__fastcode_end__, &__fastcode_end__);
+#if CORTEX_MODEL == 7
+    /* Code written through the data cache must reach the memory before
+       being fetched.*/
+    SCB_CleanDCache();
+    SCB_InvalidateICache();
+#endif
+  }
 
-    /* Zeroing clear area.*/
-    while (p < rap->no_init_area) {
-      *p = 0;
-      p++;
+#if CRT1_AREAS_NUMBER > 0
+  do {
+    /* Empty areas are skipped.*/
+    if (rap->init_area < rap->no_init_area) {
+      __init_ram_area(rap->init_text_area, rap->init_area,
+                      rap->clear_area, rap->no_init_area);
     }
     rap++;
   }
@@ -800,6 +800,195 @@ static msg_t gyro_set_full_scale(LSM6DSLDriver *devp, lsm6dsl_gyro_fs_t fs) {
   return msg;
 }
 
+#if (LSM6DSL_USE_FIFO) || defined(__DOXYGEN__)
+/**
+ * @brief   Reads the FIFO status.
+ * @pre     The bus must be owned by the caller.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[out] wordsp   pointer to the number of unread words.
+ * @param[out] patternp pointer to the position of the next word in the
+ *                      samples set.
+ *
+ * @return              The operation status.
+ */
+static msg_t fifo_read_status(LSM6DSLDriver *devp, size_t *wordsp,
+                              size_t *patternp) {
+  uint8_t buff[4];
+  msg_t msg;
+
+  msg = lsm6dslI2CReadRegister(devp->config->i2cp, devp->config->slaveaddress,
+                               LSM6DSL_AD_FIFO_STATUS1, buff, 4);
+  if (msg == MSG_OK) {
+    *wordsp = (size_t)buff[0] |
+              ((size_t)(buff[1] & LSMDSL_FIFO_STATUS2_DIFF_FIFO_MASK) << 8);
+    *patternp = (size_t)buff[2] |
+                ((size_t)(buff[3] & LSMDSL_FIFO_STATUS4_PATTERN_MASK) << 8);
+  }
+  return msg;
+}
+
+/**
+ * @brief   Return the number of values in a FIFO samples set.
+ *
+ * @param[in] ip        pointer to @p BaseSensorFIFO interface.
+ *
+ * @return              the number of values.
+ */
+static size_t fifo_get_set_size(void *ip) {
+  (void)ip;
+
+  return LSM6DSL_FIFO_SET_SIZE;
+}
+
+/**
+ * @brief   Returns the number of complete samples sets in the FIFO.
+ *
+ * @param[in] ip        pointer to @p BaseSensorFIFO interface.
+ * @param[out] np       pointer to the number of samples sets.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t fifo_get_level(void *ip, size_t *np) {
+  LSM6DSLDriver* devp;
+  size_t words, pattern, skip;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorFIFO*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "fifo_get_level(), invalid state");
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "fifo_get_level(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  msg = fifo_read_status(devp, &words, &pattern);
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+
+  *np = 0U;
+  if (msg == MSG_OK) {
+    skip = (pattern != 0U) ? (LSM6DSL_FIFO_SET_SIZE - pattern) : 0U;
+    if (words > skip) {
+      *np = (words - skip) / LSM6DSL_FIFO_SET_SIZE;
+    }
+  }
+  return msg;
+}
+
+/**
+ * @brief   Reads raw samples sets from the FIFO.
+ * @details The samples sets are read using burst transactions of up to
+ *          @p LSM6DSL_FIFO_READ_SETS sets, words belonging to an
+ *          incomplete samples set, this can happen after an overrun, are
+ *          discarded.
+ *
+ * @param[in] ip        pointer to @p BaseSensorFIFO interface.
+ * @param[out] data     a buffer able to contain @p n samples sets.
+ * @param[in] n         maximum number of samples sets to be read.
+ * @param[out] np       pointer to the number of samples sets read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ */
+static msg_t fifo_read_raw_sets(void *ip, int32_t data[], size_t n,
+                                size_t *np) {
+  LSM6DSLDriver* devp;
+  uint8_t buff[LSM6DSL_FIFO_READ_SETS * LSM6DSL_FIFO_SET_SIZE * 2];
+  size_t words, pattern, sets, done, i;
+  int16_t tmp;
+  msg_t msg;
+
+  osalDbgCheck((ip != NULL) && (data != NULL) && (np != NULL));
+
+  /* Getting parent instance pointer.*/
+  devp = objGetInstance(LSM6DSLDriver*, (BaseSensorFIFO*)ip);
+
+  osalDbgAssert((devp->state == LSM6DSL_READY),
+                "fifo_read_raw_sets(), invalid state");
+
+  done = 0U;
+#if LSM6DSL_USE_I2C
+  osalDbgAssert((devp->config->i2cp->state == I2C_READY),
+                "fifo_read_raw_sets(), channel not ready");
+
+#if LSM6DSL_SHARED_I2C
+  i2cAcquireBus(devp->config->i2cp);
+  i2cStart(devp->config->i2cp,
+           devp->config->i2ccfg);
+#endif /* LSM6DSL_SHARED_I2C */
+
+  msg = fifo_read_status(devp, &words, &pattern);
+
+  /* Discarding the words of an incomplete samples set.*/
+  if ((msg == MSG_OK) && (pattern != 0U) && (words > 0U)) {
+    size_t skip = LSM6DSL_FIFO_SET_SIZE - pattern;
+
+    if (skip > words) {
+      skip = words;
+    }
+    msg = lsm6dslI2CReadRegister(devp->config->i2cp,
+                                 devp->config->slaveaddress,
+                                 LSM6DSL_AD_FIFO_DATA_OUT_L, buff, skip * 2U);
+    words -= skip;
+  }
+
+  /* Reading complete samples sets, the FIFO output address rolls back
+     automatically on multiple reads.*/
+  if (msg == MSG_OK) {
+    sets = words / LSM6DSL_FIFO_SET_SIZE;
+    if (sets > n) {
+      sets = n;
+    }
+    while ((msg == MSG_OK) && (done < sets)) {
+      size_t chunk = sets - done;
+
+      if (chunk > (size_t)LSM6DSL_FIFO_READ_SETS) {
+        chunk = (size_t)LSM6DSL_FIFO_READ_SETS;
+      }
+      msg = lsm6dslI2CReadRegister(devp->config->i2cp,
+                                   devp->config->slaveaddress,
+                                   LSM6DSL_AD_FIFO_DATA_OUT_L, buff,
+                                   chunk * LSM6DSL_FIFO_SET_SIZE * 2U);
+      if (msg == MSG_OK) {
+        for (i = 0U; i < chunk * LSM6DSL_FIFO_SET_SIZE; i++) {
+          tmp = buff[2 * i] + (buff[2 * i + 1] << 8);
+          data[(done * LSM6DSL_FIFO_SET_SIZE) + i] = (int32_t)tmp;
+        }
+        done += chunk;
+      }
+    }
+  }
+
+#if LSM6DSL_SHARED_I2C
+  i2cReleaseBus(devp->config->i2cp);
+#endif /* LSM6DSL_SHARED_I2C */
+#endif /* LSM6DSL_USE_I2C */
+
+  *np = done;
+  return msg;
+}
+#endif /* LSM6DSL_USE_FIFO */
+
 static const struct LSM6DSLVMT vmt_device = {
   (size_t)0,
   acc_set_full_scale, gyro_set_full_scale
@@ -818,6 +1007,14 @@ static const struct BaseGyroscopeVMT vmt_gyroscope = {
   gyro_set_sensivity, gyro_reset_sensivity
 };
 
+#if (LSM6DSL_USE_FIFO) || defined(__DOXYGEN__)
+static const struct BaseSensorFIFOVMT vmt_fifo = {
+  sizeof(struct LSM6DSLVMT*) + sizeof(BaseAccelerometer) +
+  sizeof(BaseGyroscope),
+  fifo_get_set_size, fifo_get_level, fifo_read_raw_sets
+};
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -833,6 +1030,9 @@ void lsm6dslObjectInit(LSM6DSLDriver *devp) {
   devp->vmt = &vmt_device;
   devp->acc_if.vmt = &vmt_accelerometer;
   devp->gyro_if.vmt = &vmt_gyroscope;
+#if LSM6DSL_USE_FIFO
+  devp->fifo_if.vmt = &vmt_fifo;
+#endif
 
   devp->config = NULL;
 
@@ -962,6 +1162,24 @@ void lsm6dslStart(LSM6DSLDriver *devp, const LSM6DSLConfig *config) {
   lsm6dslI2CWriteRegister(devp->config->i2cp, devp->config->slaveaddress,
                           cr, 10);
 
+#if LSM6DSL_USE_FIFO
+  /* FIFO configuration, bypass mode is entered first in order to empty
+     the FIFO then continuous mode is set with no decimation for both
+     subsystems and the accelerometer data rate as FIFO data rate.*/
+  cr[0] = LSM6DSL_AD_FIFO_CTRL5;
+  cr[1] = LSMDSL_FIFO_CTRL5_FIFO_MODE_BYPASS;
+  lsm6dslI2CWriteRegister(devp->config->i2cp, devp->config->slaveaddress,
+                          cr, 1);
+  cr[0] = LSM6DSL_AD_FIFO_CTRL3;
+  cr[1] = LSMDSL_FIFO_CTRL3_DEC_FIFO_XL0 | LSMDSL_FIFO_CTRL3_DEC_FIFO_GYRO0;
+  cr[2] = 0;
+  cr[3] = (((uint8_t)devp->config->accoutdatarate >> 1) &
+           LSMDSL_FIFO_CTRL5_ODR_FIFO_MASK) |
+          LSMDSL_FIFO_CTRL5_FIFO_MODE_CONT;
+  lsm6dslI2CWriteRegister(devp->config->i2cp, devp->config->slaveaddress,
+                          cr, 3);
+#endif /* LSM6DSL_USE_FIFO */
+
 #if LSM6DSL_SHARED_I2C
   i2cReleaseBus(devp->config->i2cp);
 #endif /* LSM6DSL_SHARED_I2C */
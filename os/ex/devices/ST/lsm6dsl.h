@@ -220,6 +220,46 @@
 #define LSM6DSL_AD_Z_OFS_USR                0x75
 /** @} */
 
+/**
+ * @name    LSM6DSL_AD_FIFO_CTRL3 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL0      (1 << 0)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL1      (1 << 1)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_XL2      (1 << 2)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_GYRO0    (1 << 3)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_GYRO1    (1 << 4)
+#define LSMDSL_FIFO_CTRL3_DEC_FIFO_GYRO2    (1 << 5)
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_CTRL5 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_MASK    0x07
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_BYPASS  0x00
+#define LSMDSL_FIFO_CTRL5_FIFO_MODE_CONT    0x06
+#define LSMDSL_FIFO_CTRL5_ODR_FIFO_MASK     0x78
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_STATUS2 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_STATUS2_DIFF_FIFO_MASK  0x07
+#define LSMDSL_FIFO_STATUS2_FIFO_EMPTY      (1 << 4)
+#define LSMDSL_FIFO_STATUS2_FIFO_FULL_SMART (1 << 5)
+#define LSMDSL_FIFO_STATUS2_OVER_RUN        (1 << 6)
+#define LSMDSL_FIFO_STATUS2_WATERM          (1 << 7)
+/** @} */
+
+/**
+ * @name    LSM6DSL_AD_FIFO_STATUS4 register bits definitions
+ * @{
+ */
+#define LSMDSL_FIFO_STATUS4_PATTERN_MASK    0x03
+/** @} */
+
 /**
  * @name    LSM6DSL_AD_CTRL1_XL register bits definitions
  * @{
@@ -407,6 +447,29 @@
 #define LSM6DSL_USE_ADVANCED                FALSE
 #endif
 
+/**
+ * @brief   LSM6DSL hardware FIFO switch.
+ * @details If set to @p TRUE the hardware FIFO is enabled in continuous
+ *          mode and the @p BaseSensorFIFO interface is included, each
+ *          samples set contains the gyroscope axes followed by the
+ *          accelerometer axes.
+ * @note    The FIFO output data rate is the accelerometer one, the
+ *          gyroscope should be configured with the same output data rate.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(LSM6DSL_USE_FIFO) || defined(__DOXYGEN__)
+#define LSM6DSL_USE_FIFO                    FALSE
+#endif
+
+/**
+ * @brief   Number of samples sets read by a single FIFO transaction.
+ * @details This is the size of the reading buffer allocated on the stack
+ *          of the calling thread, in samples sets.
+ */
+#if !defined(LSM6DSL_FIFO_READ_SETS) || defined(__DOXYGEN__)
+#define LSM6DSL_FIFO_READ_SETS              8
+#endif
+
 /**
  * @brief   Number of acquisitions for gyroscope bias removal.
  * @details This is the number of acquisitions performed to compute the
@@ -449,6 +512,16 @@
 #error "LSM6DSL_SHARED_I2C requires I2C_USE_MUTUAL_EXCLUSION"
 #endif
 
+#if LSM6DSL_FIFO_READ_SETS < 1
+#error "invalid LSM6DSL_FIFO_READ_SETS value"
+#endif
+
+/**
+ * @brief   Number of values in a FIFO samples set.
+ */
+#define LSM6DSL_FIFO_SET_SIZE                                               \
+  (LSM6DSL_GYRO_NUMBER_OF_AXES + LSM6DSL_ACC_NUMBER_OF_AXES)
+
 /*
  * CHTODO: Add support for LSM6DSL over SPI.
  */
@@ -734,6 +807,10 @@ struct LSM6DSLDriver {
   BaseAccelerometer           acc_if;
   /** @brief Base gyroscope interface.*/
   BaseGyroscope               gyro_if;
+#if (LSM6DSL_USE_FIFO) || defined(__DOXYGEN__)
+  /** @brief Hardware FIFO interface.*/
+  BaseSensorFIFO              fifo_if;
+#endif
   _lsm6dsl_data
 };
 /** @} */
@@ -1036,6 +1113,46 @@ struct LSM6DSLDriver {
 #define lsm6dslGyroscopeSetFullScale(devp, fs)                              \
         (devp)->vmt->acc_set_full_scale(devp, fs)
 
+#if (LSM6DSL_USE_FIFO) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of complete samples sets in the FIFO.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[out] np       pointer to the number of samples sets.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslFIFOGetLevel(devp, np)                                       \
+        sensorFIFOGetLevel(&((devp)->fifo_if), np)
+
+/**
+ * @brief   Reads raw samples sets from the FIFO.
+ * @note    Each samples set contains the gyroscope axes followed by the
+ *          accelerometer axes.
+ *
+ * @param[in] devp      pointer to @p LSM6DSLDriver.
+ * @param[out] data     a buffer able to contain @p n samples sets.
+ * @param[in] n         maximum number of samples sets to be read.
+ * @param[out] np       pointer to the number of samples sets read.
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved using @p i2cGetErrors().
+ * @retval MSG_TIMEOUT  if a timeout occurred before operation end.
+ *
+ * @api
+ */
+#define lsm6dslFIFOReadRawSets(devp, data, n, np)                           \
+        sensorFIFOReadRawSets(&((devp)->fifo_if), data, n, np)
+#endif /* LSM6DSL_USE_FIFO */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -0,0 +1,517 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stm32_dma2d.c
+ * @brief   STM32 DMA2D graphic accelerator code.
+ *
+ * @addtogroup STM32_DMA2D
+ * @ingroup EX_ST
+ * @{
+ */
+
+#include "hal.h"
+#include "stm32_dma2d.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define DMA2D_CR_MODE_M2M           (0U << DMA2D_CR_MODE_Pos)
+#define DMA2D_CR_MODE_M2M_PFC       (1U << DMA2D_CR_MODE_Pos)
+#define DMA2D_CR_MODE_M2M_BLEND     (2U << DMA2D_CR_MODE_Pos)
+#define DMA2D_CR_MODE_R2M           (3U << DMA2D_CR_MODE_Pos)
+
+#define DMA2D_CR_IRQS               (DMA2D_CR_TEIE | DMA2D_CR_TCIE |        \
+                                     DMA2D_CR_CEIE)
+
+#define DMA2D_IFCR_ALL              (DMA2D_IFCR_CTEIF | DMA2D_IFCR_CTCIF |  \
+                                     DMA2D_IFCR_CTWIF | DMA2D_IFCR_CAECIF | \
+                                     DMA2D_IFCR_CCTCIF | DMA2D_IFCR_CCEIF)
+
+/* Alpha multiplied by the ALPHA field.*/
+#define DMA2D_FGPFCCR_AM_MULTIPLY   (2U << DMA2D_FGPFCCR_AM_Pos)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   DMA2D driver identifier.
+ */
+DMA2DDriver DMA2DD1;
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts an ARGB8888 color in the specified format.
+ *
+ * @param[in] format    pixel format
+ * @param[in] color     ARGB8888 color
+ * @return              The color in the OCOLR register format.
+ */
+static uint32_t dma2d_convert_color(uint8_t format, display_color_t color) {
+  uint32_t a = (color >> 24) & 0xFFU;
+  uint32_t r = (color >> 16) & 0xFFU;
+  uint32_t g = (color >> 8) & 0xFFU;
+  uint32_t b = color & 0xFFU;
+
+  switch (format) {
+  case DISPLAY_PIXFMT_RGB888:
+    return color & 0x00FFFFFFU;
+  case DISPLAY_PIXFMT_RGB565:
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+  case DISPLAY_PIXFMT_ARGB1555:
+    return ((a >> 7) << 15) | ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+  case DISPLAY_PIXFMT_ARGB4444:
+    return ((a >> 4) << 12) | ((r >> 4) << 8) | ((g >> 4) << 4) | (b >> 4);
+  default:
+    return color;
+  }
+}
+
+/**
+ * @brief   Returns the address of a pixel in a bitmap.
+ *
+ * @param[in] bmp       pointer to the bitmap
+ * @param[in] x         horizontal position
+ * @param[in] y         vertical position
+ * @return              The pixel address.
+ */
+static uint32_t dma2d_pixel_address(const display_bitmap_t *bmp,
+                                    uint16_t x, uint16_t y) {
+
+  return (uint32_t)bmp->buffer +
+         (((uint32_t)y * bmp->pitch) + x) * displayPixelSize(bmp->format);
+}
+
+/**
+ * @brief   Waits for the completion of the operation in progress.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ *
+ * @sclass
+ */
+static void dma2d_wait_s(DMA2DDriver *devp) {
+
+  if (devp->state == DMA2D_ACTIVE) {
+    (void) osalThreadSuspendS(&devp->thread);
+  }
+}
+
+/**
+ * @brief   Programs the output area and starts an operation.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] rp        destination rectangle
+ * @param[in] mode      operation mode
+ */
+static void dma2d_start_operation(DMA2DDriver *devp,
+                                  const display_rect_t *rp, uint32_t mode) {
+
+  DMA2D->OPFCCR = devp->target.format;
+  DMA2D->OMAR   = dma2d_pixel_address(&devp->target, rp->x, rp->y);
+  DMA2D->OOR    = (uint32_t)devp->target.pitch - rp->width;
+  DMA2D->NLR    = ((uint32_t)rp->width << 16) | rp->height;
+
+  devp->state = DMA2D_ACTIVE;
+  DMA2D->CR = mode | DMA2D_CR_IRQS | DMA2D_CR_START;
+}
+
+/**
+ * @brief   Checks that a rectangle lies inside the drawing target.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] rp        rectangle
+ * @return              The check result.
+ */
+static bool dma2d_is_inside(DMA2DDriver *devp, const display_rect_t *rp) {
+
+  return (rp->width > 0U) && (rp->height > 0U) &&
+         ((uint32_t)rp->x + rp->width <= devp->target.width) &&
+         ((uint32_t)rp->y + rp->height <= devp->target.height);
+}
+
+static msg_t display_get_info(void *ip, display_bitmap_t *bmp) {
+  DMA2DDriver *devp;
+
+  osalDbgCheck((ip != NULL) && (bmp != NULL));
+
+  devp = objGetInstance(DMA2DDriver*, (BaseDisplay*)ip);
+
+  *bmp = devp->target;
+
+  return MSG_OK;
+}
+
+static msg_t display_fill(void *ip, const display_rect_t *rp,
+                          display_color_t color) {
+
+  osalDbgCheck(ip != NULL);
+
+  return dma2dFill(objGetInstance(DMA2DDriver*, (BaseDisplay*)ip),
+                   rp, color);
+}
+
+static msg_t display_blit(void *ip, const display_rect_t *rp,
+                          const display_bitmap_t *bmp,
+                          uint16_t x, uint16_t y) {
+
+  osalDbgCheck(ip != NULL);
+
+  return dma2dBlit(objGetInstance(DMA2DDriver*, (BaseDisplay*)ip),
+                   rp, bmp, x, y);
+}
+
+static msg_t display_blend(void *ip, const display_rect_t *rp,
+                           const display_bitmap_t *bmp,
+                           uint16_t x, uint16_t y, uint8_t alpha) {
+
+  osalDbgCheck(ip != NULL);
+
+  return dma2dBlend(objGetInstance(DMA2DDriver*, (BaseDisplay*)ip),
+                    rp, bmp, x, y, alpha);
+}
+
+static msg_t display_sync(void *ip) {
+
+  osalDbgCheck(ip != NULL);
+
+  return dma2dSync(objGetInstance(DMA2DDriver*, (BaseDisplay*)ip));
+}
+
+static const struct DMA2DVMT vmt_device = {
+  (size_t)0
+};
+
+static const struct BaseDisplayVMT vmt_display = {
+  sizeof(struct DMA2DVMT*),
+  display_get_info, display_fill, display_blit, display_blend,
+  display_sync, display_sync
+};
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   DMA2D interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_DMA2D_HANDLER) {
+  DMA2DDriver *devp = &DMA2DD1;
+  uint32_t isr;
+
+  OSAL_IRQ_PROLOGUE();
+
+  isr = DMA2D->ISR;
+  DMA2D->IFCR = isr;
+
+  osalSysLockFromISR();
+  if ((isr & (DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)) != 0U) {
+    devp->errors++;
+    devp->status = MSG_RESET;
+  }
+  devp->state = DMA2D_READY;
+  osalThreadResumeI(&devp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+
+  if ((devp->config != NULL) && (devp->config->end_cb != NULL)) {
+    devp->config->end_cb(devp);
+  }
+
+  OSAL_IRQ_EPILOGUE();
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p DMA2DDriver object
+ *
+ * @init
+ */
+void dma2dObjectInit(DMA2DDriver *devp) {
+
+  devp->vmt = &vmt_device;
+  devp->display_if.vmt = &vmt_display;
+
+  devp->config = NULL;
+  devp->target.buffer = NULL;
+  devp->target.width = 0U;
+  devp->target.height = 0U;
+  devp->target.pitch = 0U;
+  devp->target.format = DISPLAY_PIXFMT_ARGB8888;
+  devp->thread = NULL;
+  devp->status = MSG_OK;
+  devp->errors = 0U;
+
+  devp->state = DMA2D_STOP;
+}
+
+/**
+ * @brief   Configures and activates the DMA2D.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] config    pointer to the @p DMA2DConfig object
+ *
+ * @api
+ */
+void dma2dStart(DMA2DDriver *devp, const DMA2DConfig *config) {
+
+  osalDbgCheck((devp == &DMA2DD1) && (config != NULL));
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_STOP) || (devp->state == DMA2D_READY),
+                "dma2dStart(), invalid state");
+
+  devp->config = config;
+  if (config->target != NULL) {
+    devp->target = *config->target;
+  }
+
+  if (devp->state == DMA2D_STOP) {
+    rccEnableDMA2D(true);
+    rccResetDMA2D();
+    nvicEnableVector(STM32_DMA2D_NUMBER, STM32_DMA2D_IRQ_PRIORITY);
+  }
+  DMA2D->IFCR = DMA2D_IFCR_ALL;
+
+  devp->status = MSG_OK;
+  devp->state = DMA2D_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Deactivates the DMA2D.
+ * @note    The operation in progress, if any, is completed first.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ *
+ * @api
+ */
+void dma2dStop(DMA2DDriver *devp) {
+
+  osalDbgCheck(devp == &DMA2DD1);
+
+  osalSysLock();
+  osalDbgAssert(devp->state != DMA2D_UNINIT, "dma2dStop(), invalid state");
+
+  dma2d_wait_s(devp);
+
+  if (devp->state == DMA2D_READY) {
+    nvicDisableVector(STM32_DMA2D_NUMBER);
+    rccDisableDMA2D();
+  }
+  devp->state = DMA2D_STOP;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Changes the drawing target.
+ * @note    The operation in progress, if any, is completed first.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] bmp       new drawing target
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ *
+ * @api
+ */
+msg_t dma2dSetTarget(DMA2DDriver *devp, const display_bitmap_t *bmp) {
+
+  osalDbgCheck((devp != NULL) && (bmp != NULL) &&
+               (bmp->format <= DISPLAY_PIXFMT_ARGB4444) &&
+               (bmp->pitch >= bmp->width));
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_READY) ||
+                (devp->state == DMA2D_ACTIVE),
+                "dma2dSetTarget(), invalid state");
+
+  dma2d_wait_s(devp);
+  devp->target = *bmp;
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Fills a rectangle of the drawing target with a color.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] rp        destination rectangle
+ * @param[in] color     ARGB8888 color
+ * @return              The operation status.
+ * @retval MSG_OK       if the operation has been started.
+ *
+ * @api
+ */
+msg_t dma2dFill(DMA2DDriver *devp, const display_rect_t *rp,
+                display_color_t color) {
+
+  osalDbgCheck((devp != NULL) && (rp != NULL));
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_READY) ||
+                (devp->state == DMA2D_ACTIVE),
+                "dma2dFill(), invalid state");
+  osalDbgAssert(dma2d_is_inside(devp, rp), "out of target");
+
+  dma2d_wait_s(devp);
+
+  DMA2D->OCOLR = dma2d_convert_color(devp->target.format, color);
+  dma2d_start_operation(devp, rp, DMA2D_CR_MODE_R2M);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Copies a bitmap area in the drawing target.
+ * @details The pixel format is converted if different.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] rp        destination rectangle
+ * @param[in] bmp       source bitmap
+ * @param[in] x         source area horizontal position
+ * @param[in] y         source area vertical position
+ * @return              The operation status.
+ * @retval MSG_OK       if the operation has been started.
+ *
+ * @api
+ */
+msg_t dma2dBlit(DMA2DDriver *devp, const display_rect_t *rp,
+                const display_bitmap_t *bmp, uint16_t x, uint16_t y) {
+  uint32_t mode;
+
+  osalDbgCheck((devp != NULL) && (rp != NULL) && (bmp != NULL) &&
+               (bmp->format <= DISPLAY_PIXFMT_ARGB4444));
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_READY) ||
+                (devp->state == DMA2D_ACTIVE),
+                "dma2dBlit(), invalid state");
+  osalDbgAssert(dma2d_is_inside(devp, rp) &&
+                ((uint32_t)x + rp->width <= bmp->width) &&
+                ((uint32_t)y + rp->height <= bmp->height), "out of bitmap");
+
+  dma2d_wait_s(devp);
+
+  DMA2D->FGMAR   = dma2d_pixel_address(bmp, x, y);
+  DMA2D->FGOR    = (uint32_t)bmp->pitch - rp->width;
+  DMA2D->FGPFCCR = bmp->format;
+  if (bmp->format == devp->target.format) {
+    mode = DMA2D_CR_MODE_M2M;
+  }
+  else {
+    mode = DMA2D_CR_MODE_M2M_PFC;
+  }
+  dma2d_start_operation(devp, rp, mode);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Blends a bitmap area over the drawing target.
+ * @details The source pixel alpha is multiplied by @p alpha.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @param[in] rp        destination rectangle
+ * @param[in] bmp       source bitmap
+ * @param[in] x         source area horizontal position
+ * @param[in] y         source area vertical position
+ * @param[in] alpha     global alpha
+ * @return              The operation status.
+ * @retval MSG_OK       if the operation has been started.
+ *
+ * @api
+ */
+msg_t dma2dBlend(DMA2DDriver *devp, const display_rect_t *rp,
+                 const display_bitmap_t *bmp, uint16_t x, uint16_t y,
+                 uint8_t alpha) {
+
+  osalDbgCheck((devp != NULL) && (rp != NULL) && (bmp != NULL) &&
+               (bmp->format <= DISPLAY_PIXFMT_ARGB4444));
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_READY) ||
+                (devp->state == DMA2D_ACTIVE),
+                "dma2dBlend(), invalid state");
+  osalDbgAssert(dma2d_is_inside(devp, rp) &&
+                ((uint32_t)x + rp->width <= bmp->width) &&
+                ((uint32_t)y + rp->height <= bmp->height), "out of bitmap");
+
+  dma2d_wait_s(devp);
+
+  /* Foreground is the source bitmap.*/
+  DMA2D->FGMAR   = dma2d_pixel_address(bmp, x, y);
+  DMA2D->FGOR    = (uint32_t)bmp->pitch - rp->width;
+  DMA2D->FGPFCCR = ((uint32_t)alpha << DMA2D_FGPFCCR_ALPHA_Pos) |
+                   DMA2D_FGPFCCR_AM_MULTIPLY | bmp->format;
+
+  /* Background is the target itself.*/
+  DMA2D->BGMAR   = dma2d_pixel_address(&devp->target, rp->x, rp->y);
+  DMA2D->BGOR    = (uint32_t)devp->target.pitch - rp->width;
+  DMA2D->BGPFCCR = devp->target.format;
+
+  dma2d_start_operation(devp, rp, DMA2D_CR_MODE_M2M_BLEND);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Waits for the completion of the drawing operations.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @return              The operations status.
+ * @retval MSG_OK       if the operations succeeded.
+ * @retval MSG_RESET    if one or more errors occurred since the previous
+ *                      synchronization.
+ *
+ * @api
+ */
+msg_t dma2dSync(DMA2DDriver *devp) {
+  msg_t msg;
+
+  osalDbgCheck(devp != NULL);
+
+  osalSysLock();
+  osalDbgAssert((devp->state == DMA2D_READY) ||
+                (devp->state == DMA2D_ACTIVE),
+                "dma2dSync(), invalid state");
+
+  dma2d_wait_s(devp);
+  msg = devp->status;
+  devp->status = MSG_OK;
+  osalSysUnlock();
+
+  return msg;
+}
+
+/** @} */
@@ -0,0 +1,200 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stm32_dma2d.h
+ * @brief   STM32 DMA2D graphic accelerator header.
+ *
+ * @addtogroup STM32_DMA2D
+ * @ingroup EX_ST
+ * @{
+ */
+
+#ifndef STM32_DMA2D_H
+#define STM32_DMA2D_H
+
+#include "ex_displays.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   DMA2D interrupt priority level setting.
+ */
+#if !defined(STM32_DMA2D_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_DMA2D_IRQ_PRIORITY            11
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(STM32_HAS_DMA2D) || (STM32_HAS_DMA2D == FALSE) ||              \
+    !defined(rccEnableDMA2D)
+#error "DMA2D not present in the selected device"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_DMA2D_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to DMA2D"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  DMA2D_UNINIT = 0,                 /**< Not initialized.                   */
+  DMA2D_STOP = 1,                   /**< Stopped.                           */
+  DMA2D_READY = 2,                  /**< Ready.                             */
+  DMA2D_ACTIVE = 3                  /**< Operation in progress.             */
+} dma2d_state_t;
+
+/**
+ * @brief   Type of a structure representing a DMA2D driver.
+ */
+typedef struct DMA2DDriver DMA2DDriver;
+
+/**
+ * @brief   Type of a DMA2D completion callback.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ */
+typedef void (*dma2dcallback_t)(DMA2DDriver *devp);
+
+/**
+ * @brief   DMA2D configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Initial drawing target.
+   */
+  const display_bitmap_t    *target;
+  /**
+   * @brief   Operation completed callback or @p NULL.
+   * @note    It is invoked from ISR context.
+   */
+  dma2dcallback_t           end_cb;
+} DMA2DConfig;
+
+/**
+ * @brief   @p DMA2DDriver specific methods.
+ * @note    No methods so far, just a common ancestor interface.
+ */
+#define _dma2d_methods_alone
+
+/**
+ * @brief   @p DMA2DDriver specific methods with inherited ones.
+ */
+#define _dma2d_methods                                                      \
+  _base_object_methods                                                      \
+  _dma2d_methods_alone
+
+/**
+ * @extends BaseObjectVMT
+ *
+ * @brief   @p DMA2DDriver virtual methods table.
+ */
+struct DMA2DVMT {
+  _dma2d_methods
+};
+
+/**
+ * @brief   @p DMA2DDriver specific data.
+ */
+#define _dma2d_data                                                         \
+  /* Driver state.*/                                                        \
+  dma2d_state_t             state;                                          \
+  /* Current configuration data.*/                                          \
+  const DMA2DConfig         *config;                                        \
+  /* Current drawing target.*/                                              \
+  display_bitmap_t          target;                                         \
+  /* Waiting thread.*/                                                      \
+  thread_reference_t        thread;                                         \
+  /* Operations result since the last synchronization.*/                    \
+  msg_t                     status;                                         \
+  /* Number of transfer and configuration errors.*/                         \
+  uint32_t                  errors;
+
+/**
+ * @brief   DMA2D graphic accelerator class.
+ * @details The accelerator draws in a bitmap in memory, the bitmap is
+ *          also exposed as a @p BaseDisplay. Operations are started
+ *          asynchronously, an operation waits for the completion of the
+ *          previous one.
+ * @note    The DMA2D bypasses the data cache, bitmaps must be placed in
+ *          a non-cacheable memory area or the cache must be cleaned and
+ *          invalidated by the application.
+ */
+struct DMA2DDriver {
+  /** @brief Virtual Methods Table.*/
+  const struct DMA2DVMT     *vmt;
+  /** @brief Base display interface.*/
+  BaseDisplay               display_if;
+  _dma2d_data
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the @p BaseDisplay interface of the driver.
+ *
+ * @param[in] devp      pointer to the @p DMA2DDriver object
+ * @return              The @p BaseDisplay interface.
+ *
+ * @xclass
+ */
+#define dma2dGetDisplayX(devp) (&(devp)->display_if)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern DMA2DDriver DMA2DD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dma2dObjectInit(DMA2DDriver *devp);
+  void dma2dStart(DMA2DDriver *devp, const DMA2DConfig *config);
+  void dma2dStop(DMA2DDriver *devp);
+  msg_t dma2dSetTarget(DMA2DDriver *devp, const display_bitmap_t *bmp);
+  msg_t dma2dFill(DMA2DDriver *devp, const display_rect_t *rp,
+                  display_color_t color);
+  msg_t dma2dBlit(DMA2DDriver *devp, const display_rect_t *rp,
+                  const display_bitmap_t *bmp, uint16_t x, uint16_t y);
+  msg_t dma2dBlend(DMA2DDriver *devp, const display_rect_t *rp,
+                   const display_bitmap_t *bmp, uint16_t x, uint16_t y,
+                   uint8_t alpha);
+  msg_t dma2dSync(DMA2DDriver *devp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_DMA2D_H */
+
+/** @} */
@@ -0,0 +1,10 @@
+# List of all the STM32 DMA2D device files.
+STM32DMA2DSRC := $(CHIBIOS)/os/ex/devices/ST/stm32_dma2d.c
+
+# Required include directories
+STM32DMA2DINC := $(CHIBIOS)/os/ex/include \
+                 $(CHIBIOS)/os/ex/devices/ST
+
+# Shared variables
+ALLCSRC += $(STM32DMA2DSRC)
+ALLINC  += $(STM32DMA2DINC)
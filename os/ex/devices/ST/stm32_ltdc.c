@@ -0,0 +1,375 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stm32_ltdc.c
+ * @brief   STM32 LTDC display controller code.
+ *
+ * @addtogroup STM32_LTDC
+ * @ingroup EX_ST
+ * @{
+ */
+
+#include "hal.h"
+#include "stm32_ltdc.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/* Blending factors, pixel alpha multiplied by constant alpha.*/
+#define LTDC_BFCR_PAXCA             ((6U << 8) | 7U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   LTDC driver identifier.
+ */
+LTDCDriver LTDCD1;
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the bitmap of the buffer being drawn.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ * @param[out] bmp      pointer to the bitmap
+ */
+static void ltdc_get_back(LTDCDriver *devp, display_bitmap_t *bmp) {
+
+  bmp->buffer = devp->config->buffers[devp->back];
+  bmp->width  = devp->config->width;
+  bmp->height = devp->config->height;
+  bmp->pitch  = devp->config->width;
+  bmp->format = devp->config->format;
+}
+
+/**
+ * @brief   Waits for a pending buffers swap.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ *
+ * @sclass
+ */
+static void ltdc_wait_swap_s(LTDCDriver *devp) {
+
+  if (devp->swap_pending) {
+    (void) osalThreadSuspendS(&devp->thread);
+  }
+}
+
+/**
+ * @brief   Prepares the DMA2D for drawing on the back buffer.
+ * @note    Drawing cannot start before the previous swap is performed
+ *          because the back buffer would still be visible.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ * @return              The operation status.
+ */
+static msg_t ltdc_prepare(LTDCDriver *devp) {
+  display_bitmap_t bmp;
+
+  osalDbgAssert(devp->state == LTDC_READY, "invalid state");
+
+  osalSysLock();
+  ltdc_wait_swap_s(devp);
+  osalSysUnlock();
+
+  ltdc_get_back(devp, &bmp);
+
+  return dma2dSetTarget(devp->config->dma2dp, &bmp);
+}
+
+static msg_t display_get_info(void *ip, display_bitmap_t *bmp) {
+  LTDCDriver *devp;
+
+  osalDbgCheck((ip != NULL) && (bmp != NULL));
+
+  devp = objGetInstance(LTDCDriver*, (BaseDisplay*)ip);
+  osalDbgAssert(devp->state == LTDC_READY, "invalid state");
+
+  ltdc_get_back(devp, bmp);
+
+  return MSG_OK;
+}
+
+static msg_t display_fill(void *ip, const display_rect_t *rp,
+                          display_color_t color) {
+  LTDCDriver *devp;
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  devp = objGetInstance(LTDCDriver*, (BaseDisplay*)ip);
+
+  msg = ltdc_prepare(devp);
+  if (msg == MSG_OK) {
+    msg = dma2dFill(devp->config->dma2dp, rp, color);
+  }
+
+  return msg;
+}
+
+static msg_t display_blit(void *ip, const display_rect_t *rp,
+                          const display_bitmap_t *bmp,
+                          uint16_t x, uint16_t y) {
+  LTDCDriver *devp;
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  devp = objGetInstance(LTDCDriver*, (BaseDisplay*)ip);
+
+  msg = ltdc_prepare(devp);
+  if (msg == MSG_OK) {
+    msg = dma2dBlit(devp->config->dma2dp, rp, bmp, x, y);
+  }
+
+  return msg;
+}
+
+static msg_t display_blend(void *ip, const display_rect_t *rp,
+                           const display_bitmap_t *bmp,
+                           uint16_t x, uint16_t y, uint8_t alpha) {
+  LTDCDriver *devp;
+  msg_t msg;
+
+  osalDbgCheck(ip != NULL);
+
+  devp = objGetInstance(LTDCDriver*, (BaseDisplay*)ip);
+
+  msg = ltdc_prepare(devp);
+  if (msg == MSG_OK) {
+    msg = dma2dBlend(devp->config->dma2dp, rp, bmp, x, y, alpha);
+  }
+
+  return msg;
+}
+
+static msg_t display_sync(void *ip) {
+  LTDCDriver *devp;
+
+  osalDbgCheck(ip != NULL);
+
+  devp = objGetInstance(LTDCDriver*, (BaseDisplay*)ip);
+  osalDbgAssert(devp->state == LTDC_READY, "invalid state");
+
+  return dma2dSync(devp->config->dma2dp);
+}
+
+static msg_t display_flush(void *ip) {
+
+  osalDbgCheck(ip != NULL);
+
+  return ltdcSwapBuffers(objGetInstance(LTDCDriver*, (BaseDisplay*)ip));
+}
+
+static const struct LTDCVMT vmt_device = {
+  (size_t)0
+};
+
+static const struct BaseDisplayVMT vmt_display = {
+  sizeof(struct LTDCVMT*),
+  display_get_info, display_fill, display_blit, display_blend,
+  display_sync, display_flush
+};
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   LTDC event interrupt handler.
+ * @details The registers reload happened, the new front buffer is now
+ *          being scanned.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_LTDC_EV_HANDLER) {
+  LTDCDriver *devp = &LTDCD1;
+
+  OSAL_IRQ_PROLOGUE();
+
+  LTDC->ICR = LTDC_ICR_CRRIF;
+
+  osalSysLockFromISR();
+  devp->swap_pending = false;
+  osalThreadResumeI(&devp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+
+  OSAL_IRQ_EPILOGUE();
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p LTDCDriver object
+ *
+ * @init
+ */
+void ltdcObjectInit(LTDCDriver *devp) {
+
+  devp->vmt = &vmt_device;
+  devp->display_if.vmt = &vmt_display;
+
+  devp->config = NULL;
+  devp->back = 0U;
+  devp->swap_pending = false;
+  devp->thread = NULL;
+
+  devp->state = LTDC_STOP;
+}
+
+/**
+ * @brief   Configures and activates the LTDC.
+ * @details A single layer covering the whole active area is enabled, the
+ *          first buffer is shown.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ * @param[in] config    pointer to the @p LTDCConfig object
+ *
+ * @api
+ */
+void ltdcStart(LTDCDriver *devp, const LTDCConfig *config) {
+  uint32_t ahbp, avbp, bpl;
+
+  osalDbgCheck((devp == &LTDCD1) && (config != NULL) &&
+               (config->dma2dp != NULL) && (config->buffers[0] != NULL) &&
+               (config->hsync > 0U) && (config->vsync > 0U) &&
+               (config->format <= DISPLAY_PIXFMT_ARGB4444));
+
+  osalDbgAssert(devp->state == LTDC_STOP, "ltdcStart(), invalid state");
+
+  devp->config = config;
+  devp->swap_pending = false;
+  devp->back = config->buffers[1] != NULL ? 1U : 0U;
+
+  rccEnableLTDC(true);
+  rccResetLTDC();
+
+  /* Timings, the registers contain accumulated values minus one.*/
+  ahbp = (uint32_t)config->hsync + config->hbp - 1U;
+  avbp = (uint32_t)config->vsync + config->vbp - 1U;
+  LTDC->SSCR = (((uint32_t)config->hsync - 1U) << 16) |
+               ((uint32_t)config->vsync - 1U);
+  LTDC->BPCR = (ahbp << 16) | avbp;
+  LTDC->AWCR = ((ahbp + config->width) << 16) | (avbp + config->height);
+  LTDC->TWCR = ((ahbp + config->width + config->hfp) << 16) |
+               (avbp + config->height + config->vfp);
+  LTDC->BCCR = config->bgcolor & 0x00FFFFFFU;
+  LTDC->GCR  = config->polarity;
+
+  /* Layer 1 covering the whole active area.*/
+  bpl = (uint32_t)config->width * displayPixelSize(config->format);
+  LTDC_Layer1->WHPCR  = ((ahbp + config->width) << 16) | (ahbp + 1U);
+  LTDC_Layer1->WVPCR  = ((avbp + config->height) << 16) | (avbp + 1U);
+  LTDC_Layer1->PFCR   = config->format;
+  LTDC_Layer1->CACR   = 255U;
+  LTDC_Layer1->DCCR   = 0U;
+  LTDC_Layer1->BFCR   = LTDC_BFCR_PAXCA;
+  LTDC_Layer1->CFBAR  = (uint32_t)config->buffers[0];
+  LTDC_Layer1->CFBLR  = (bpl << 16) | (bpl + 3U);
+  LTDC_Layer1->CFBLNR = config->height;
+  LTDC_Layer1->CR     = LTDC_LxCR_LEN;
+  LTDC->SRCR = LTDC_SRCR_IMR;
+
+  /* Reload interrupt used for buffers swap.*/
+  LTDC->ICR = LTDC_ICR_CRRIF;
+  LTDC->IER = LTDC_IER_RRIE;
+  nvicEnableVector(STM32_LTDC_EV_NUMBER, STM32_LTDC_IRQ_PRIORITY);
+
+  LTDC->GCR |= LTDC_GCR_LTDCEN;
+
+  devp->state = LTDC_READY;
+}
+
+/**
+ * @brief   Deactivates the LTDC.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ *
+ * @api
+ */
+void ltdcStop(LTDCDriver *devp) {
+
+  osalDbgCheck(devp == &LTDCD1);
+
+  osalDbgAssert((devp->state == LTDC_STOP) || (devp->state == LTDC_READY),
+                "ltdcStop(), invalid state");
+
+  if (devp->state == LTDC_READY) {
+    osalSysLock();
+    ltdc_wait_swap_s(devp);
+    osalSysUnlock();
+
+    LTDC->GCR &= ~LTDC_GCR_LTDCEN;
+    LTDC->IER = 0U;
+    nvicDisableVector(STM32_LTDC_EV_NUMBER);
+    rccDisableLTDC();
+  }
+
+  devp->state = LTDC_STOP;
+}
+
+/**
+ * @brief   Shows the drawn frame.
+ * @details The drawing operations are completed then, if double
+ *          buffered, the buffers are swapped at the next vertical
+ *          blanking. The function does not wait for the swap, the next
+ *          drawing operation does.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ * @return              The drawing operations status.
+ * @retval MSG_OK       if the operations succeeded.
+ * @retval MSG_RESET    if one or more errors occurred while drawing.
+ *
+ * @api
+ */
+msg_t ltdcSwapBuffers(LTDCDriver *devp) {
+  msg_t msg;
+
+  osalDbgCheck(devp != NULL);
+
+  osalDbgAssert(devp->state == LTDC_READY, "ltdcSwapBuffers(), invalid state");
+
+  msg = dma2dSync(devp->config->dma2dp);
+
+  if (devp->config->buffers[1] != NULL) {
+    osalSysLock();
+    ltdc_wait_swap_s(devp);
+    LTDC_Layer1->CFBAR = (uint32_t)devp->config->buffers[devp->back];
+    LTDC->SRCR = LTDC_SRCR_VBR;
+    devp->swap_pending = true;
+    devp->back ^= 1U;
+    osalSysUnlock();
+  }
+
+  return msg;
+}
+
+/** @} */
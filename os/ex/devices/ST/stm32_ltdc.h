@@ -0,0 +1,217 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    stm32_ltdc.h
+ * @brief   STM32 LTDC display controller header.
+ *
+ * @addtogroup STM32_LTDC
+ * @ingroup EX_ST
+ * @{
+ */
+
+#ifndef STM32_LTDC_H
+#define STM32_LTDC_H
+
+#include "stm32_dma2d.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Synchronization signals polarity
+ * @{
+ */
+#define LTDC_POLARITY_HSYNC_HIGH            LTDC_GCR_HSPOL
+#define LTDC_POLARITY_VSYNC_HIGH            LTDC_GCR_VSPOL
+#define LTDC_POLARITY_DE_HIGH               LTDC_GCR_DEPOL
+#define LTDC_POLARITY_PCLK_INVERTED         LTDC_GCR_PCPOL
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   LTDC interrupt priority level setting.
+ */
+#if !defined(STM32_LTDC_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_LTDC_IRQ_PRIORITY             11
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(STM32_HAS_LTDC) || (STM32_HAS_LTDC == FALSE) ||                \
+    !defined(rccEnableLTDC)
+#error "LTDC not present in the selected device"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_LTDC_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to LTDC"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  LTDC_UNINIT = 0,                  /**< Not initialized.                   */
+  LTDC_STOP = 1,                    /**< Stopped.                           */
+  LTDC_READY = 2                    /**< Ready.                             */
+} ltdc_state_t;
+
+/**
+ * @brief   LTDC configuration structure.
+ * @note    The pixel clock and the GPIOs are configured by the
+ *          application.
+ */
+typedef struct {
+  /**
+   * @brief   DMA2D driver used for drawing.
+   * @note    The DMA2D driver must be already started.
+   */
+  DMA2DDriver               *dma2dp;
+  /**
+   * @name    Active area size in pixels
+   * @{
+   */
+  uint16_t                  width;
+  uint16_t                  height;
+  /** @} */
+  /**
+   * @name    Timings in pixel clocks and lines
+   * @{
+   */
+  uint16_t                  hsync;
+  uint16_t                  vsync;
+  uint16_t                  hbp;
+  uint16_t                  vbp;
+  uint16_t                  hfp;
+  uint16_t                  vfp;
+  /** @} */
+  /**
+   * @brief   Synchronization signals polarity.
+   */
+  uint32_t                  polarity;
+  /**
+   * @brief   Background color as RGB888.
+   */
+  display_color_t           bgcolor;
+  /**
+   * @brief   Frame buffers pixel format.
+   */
+  uint8_t                   format;
+  /**
+   * @brief   Frame buffers.
+   * @details If the second buffer is @p NULL the display is single
+   *          buffered and drawing happens on the visible frame.
+   */
+  void                      *buffers[2];
+} LTDCConfig;
+
+/**
+ * @brief   @p LTDCDriver specific methods.
+ * @note    No methods so far, just a common ancestor interface.
+ */
+#define _ltdc_methods_alone
+
+/**
+ * @brief   @p LTDCDriver specific methods with inherited ones.
+ */
+#define _ltdc_methods                                                       \
+  _base_object_methods                                                      \
+  _ltdc_methods_alone
+
+/**
+ * @extends BaseObjectVMT
+ *
+ * @brief   @p LTDCDriver virtual methods table.
+ */
+struct LTDCVMT {
+  _ltdc_methods
+};
+
+/**
+ * @brief   @p LTDCDriver specific data.
+ */
+#define _ltdc_data                                                          \
+  /* Driver state.*/                                                        \
+  ltdc_state_t              state;                                          \
+  /* Current configuration data.*/                                          \
+  const LTDCConfig          *config;                                        \
+  /* Index of the buffer being drawn.*/                                     \
+  unsigned                  back;                                           \
+  /* A buffers swap is waiting for the vertical blanking.*/                 \
+  bool                      swap_pending;                                   \
+  /* Thread waiting for the buffers swap.*/                                 \
+  thread_reference_t        thread;
+
+/**
+ * @brief   LTDC display controller class.
+ * @details The frame buffers are drawn using the DMA2D and exposed as a
+ *          @p BaseDisplay, when double buffered the buffers are swapped
+ *          during the vertical blanking.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct LTDCVMT      *vmt;
+  /** @brief Base display interface.*/
+  BaseDisplay               display_if;
+  _ltdc_data
+} LTDCDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the @p BaseDisplay interface of the driver.
+ *
+ * @param[in] devp      pointer to the @p LTDCDriver object
+ * @return              The @p BaseDisplay interface.
+ *
+ * @xclass
+ */
+#define ltdcGetDisplayX(devp) (&(devp)->display_if)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern LTDCDriver LTDCD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ltdcObjectInit(LTDCDriver *devp);
+  void ltdcStart(LTDCDriver *devp, const LTDCConfig *config);
+  void ltdcStop(LTDCDriver *devp);
+  msg_t ltdcSwapBuffers(LTDCDriver *devp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_LTDC_H */
+
+/** @} */
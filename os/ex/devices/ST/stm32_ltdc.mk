@@ -0,0 +1,10 @@
+# List of all the STM32 LTDC device files, the DMA2D is required.
+STM32LTDCSRC := $(CHIBIOS)/os/ex/devices/ST/stm32_ltdc.c
+
+# Required include directories
+STM32LTDCINC := $(CHIBIOS)/os/ex/include \
+                $(CHIBIOS)/os/ex/devices/ST
+
+# Shared variables
+ALLCSRC += $(STM32LTDCSRC)
+ALLINC  += $(STM32LTDCINC)
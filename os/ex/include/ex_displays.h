@@ -29,6 +29,18 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Pixel formats
+ * @note    The values match the STM32 DMA2D and LTDC encodings.
+ * @{
+ */
+#define DISPLAY_PIXFMT_ARGB8888             0U
+#define DISPLAY_PIXFMT_RGB888               1U
+#define DISPLAY_PIXFMT_RGB565               2U
+#define DISPLAY_PIXFMT_ARGB1555             3U
+#define DISPLAY_PIXFMT_ARGB4444             4U
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -42,15 +54,74 @@
 /*===========================================================================*/
 
 /**
- * @brief   @p BaseDisplay specific methods.
- * @note    No methods so far, just a common ancestor interface.
+ * @brief   Type of a color, always expressed as ARGB8888.
+ */
+typedef uint32_t display_color_t;
+
+/**
+ * @brief   Type of a rectangle.
+ */
+typedef struct {
+  uint16_t                  x;
+  uint16_t                  y;
+  uint16_t                  width;
+  uint16_t                  height;
+} display_rect_t;
+
+/**
+ * @brief   Type of a bitmap in memory.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the first pixel.
+   */
+  void                      *buffer;
+  /**
+   * @brief   Bitmap width in pixels.
+   */
+  uint16_t                  width;
+  /**
+   * @brief   Bitmap height in pixels.
+   */
+  uint16_t                  height;
+  /**
+   * @brief   Distance between lines in pixels.
+   */
+  uint16_t                  pitch;
+  /**
+   * @brief   Pixel format.
+   */
+  uint8_t                   format;
+} display_bitmap_t;
+
+/**
+ * @brief   BaseDisplay specific methods.
+ * @note    Drawing operations can return before completion, the source
+ *          bitmaps must not be modified until the display is synchronized.
  */
-#define _base_display_methods_alone
+#define _base_display_methods_alone                                         \
+  /* Returns the drawing area, the buffer is NULL if not accessible.*/      \
+  msg_t (*get_info)(void *instance, display_bitmap_t *bmp);                 \
+  /* Fills a rectangle with a color.*/                                      \
+  msg_t (*fill)(void *instance, const display_rect_t *rp,                   \
+                display_color_t color);                                     \
+  /* Copies a bitmap area converting its pixel format.*/                    \
+  msg_t (*blit)(void *instance, const display_rect_t *rp,                   \
+                const display_bitmap_t *bmp, uint16_t x, uint16_t y);       \
+  /* Blends a bitmap area over the display content.*/                       \
+  msg_t (*blend)(void *instance, const display_rect_t *rp,                  \
+                 const display_bitmap_t *bmp, uint16_t x, uint16_t y,       \
+                 uint8_t alpha);                                            \
+  /* Waits for the completion of the drawing operations.*/                  \
+  msg_t (*sync)(void *instance);                                            \
+  /* Shows the drawn frame.*/                                               \
+  msg_t (*flush)(void *instance);
 
 /**
- * @brief   @p BaseDisplay specific methods with inherited ones.
+ * @brief   BaseDisplay specific methods with inherited ones.
  */
 #define _base_display_methods                                               \
+  _base_object_methods                                                      \
   _base_display_methods_alone
 
 /**
@@ -65,14 +136,20 @@ struct BaseDisplayVMT {
  * @note    It is empty because @p BaseDisplay is only an interface
  *          without implementation.
  */
-#define _base_display_data
+#define _base_display_data                                                  \
+  _base_object_data
 
 /**
+ * @extends BaseObject
+ *
  * @brief   Base display class.
+ * @details This class represents a generic display with drawing
+ *          primitives, implementations can perform them using hardware
+ *          accelerators.
  */
 typedef struct {
   /** @brief Virtual Methods Table.*/
-  const struct BaseDisplayVMT *vmt_basedisplay;
+  const struct BaseDisplayVMT *vmt;
   _base_display_data
 } BaseDisplay;
 
@@ -85,16 +162,99 @@ typedef struct {
  * @{
  */
 /**
- * @brief   Sensors get axes number.
+ * @brief   Returns the drawing area.
  *
- * @param[in] ip        pointer to a @p BaseDisplay or derived class.
- * @return              The number of axes of the BaseDisplay
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @param[out] bmp      pointer to the bitmap describing the drawing area
+ * @return              The operation status.
  *
  * @api
  */
-#define displayGetType(ip) (ip)->vmt_basedisplay->get_type(ip)
+#define displayGetInfo(ip, bmp)                                             \
+        (ip)->vmt->get_info(ip, bmp)
+
+/**
+ * @brief   Fills a rectangle with a color.
+ *
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @param[in] rp        destination rectangle
+ * @param[in] color     ARGB8888 color
+ * @return              The operation status.
+ *
+ * @api
+ */
+#define displayFill(ip, rp, color)                                          \
+        (ip)->vmt->fill(ip, rp, color)
+
+/**
+ * @brief   Copies a bitmap area converting its pixel format.
+ *
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @param[in] rp        destination rectangle
+ * @param[in] bmp       source bitmap
+ * @param[in] x         source area horizontal position
+ * @param[in] y         source area vertical position
+ * @return              The operation status.
+ *
+ * @api
+ */
+#define displayBlit(ip, rp, bmp, x, y)                                      \
+        (ip)->vmt->blit(ip, rp, bmp, x, y)
+
+/**
+ * @brief   Blends a bitmap area over the display content.
+ * @details The source pixel alpha is multiplied by @p alpha.
+ *
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @param[in] rp        destination rectangle
+ * @param[in] bmp       source bitmap
+ * @param[in] x         source area horizontal position
+ * @param[in] y         source area vertical position
+ * @param[in] alpha     global alpha
+ * @return              The operation status.
+ *
+ * @api
+ */
+#define displayBlend(ip, rp, bmp, x, y, alpha)                              \
+        (ip)->vmt->blend(ip, rp, bmp, x, y, alpha)
+
+/**
+ * @brief   Waits for the completion of the drawing operations.
+ *
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define displaySync(ip)                                                     \
+        (ip)->vmt->sync(ip)
+
+/**
+ * @brief   Shows the drawn frame.
+ * @details On double buffered displays the buffers are swapped, drawing
+ *          continues on the other buffer.
+ *
+ * @param[in] ip        pointer to a @p BaseDisplay class.
+ * @return              The operation status.
+ *
+ * @api
+ */
+#define displayFlush(ip)                                                    \
+        (ip)->vmt->flush(ip)
 /** @} */
 
+/**
+ * @brief   Returns the size in bytes of a pixel.
+ *
+ * @param[in] format    pixel format
+ * @return              The pixel size.
+ */
+#define displayPixelSize(format)                                            \
+        ((format) == DISPLAY_PIXFMT_ARGB8888 ? 4U :                         \
+         (format) == DISPLAY_PIXFMT_RGB888 ? 3U : 2U)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
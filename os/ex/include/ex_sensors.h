@@ -87,6 +87,53 @@ typedef struct {
   _base_sensor_data
 } BaseSensor;
 
+/**
+ * @brief   BaseSensorFIFO specific methods.
+ */
+#define _base_sensor_fifo_methods_alone                                     \
+  /* Get number of values in a samples set.*/                               \
+  size_t (*get_set_size)(void *instance);                                   \
+  /* Get number of complete samples sets in the FIFO.*/                     \
+  msg_t (*get_level)(void *instance, size_t *np);                           \
+  /* Reads samples sets from the FIFO.*/                                    \
+  msg_t (*read_raw_sets)(void *instance, int32_t data[], size_t n,          \
+                         size_t *np);
+
+/**
+ * @brief   BaseSensorFIFO specific methods with inherited ones.
+ */
+#define _base_sensor_fifo_methods                                           \
+  _base_object_methods                                                      \
+  _base_sensor_fifo_methods_alone
+
+/**
+ * @brief   @p BaseSensorFIFO virtual methods table.
+ */
+struct BaseSensorFIFOVMT {
+  _base_sensor_fifo_methods
+};
+
+/**
+ * @brief   @p BaseSensorFIFO specific data.
+ */
+#define _base_sensor_fifo_data                                              \
+  _base_object_data
+
+/**
+ * @extends BaseObject
+ *
+ * @brief   Sensor hardware FIFO interface.
+ * @details This interface is implemented by devices having an hardware
+ *          FIFO, multiple samples sets are read with a single bus
+ *          transaction. A samples set contains one raw value for each
+ *          channel buffered by the device.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct BaseSensorFIFOVMT *vmt;
+  _base_sensor_fifo_data
+} BaseSensorFIFO;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -134,6 +181,56 @@ typedef struct {
 #define sensorReadCooked(ip, dp) (ip)->vmt->read_cooked(ip, dp)
 /** @} */
 
+/**
+ * @name    Macro Functions (BaseSensorFIFO)
+ * @{
+ */
+/**
+ * @brief   Sensor FIFO get samples set size.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorFIFO or derived class.
+ * @return              The number of values in a samples set.
+ *
+ * @api
+ */
+#define sensorFIFOGetSetSize(ip) (ip)->vmt->get_set_size(ip)
+
+/**
+ * @brief   Sensor FIFO get level.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorFIFO or derived class.
+ * @param[out] np       pointer to the number of complete samples sets
+ *                      in the FIFO
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorFIFOGetLevel(ip, np) (ip)->vmt->get_level(ip, np)
+
+/**
+ * @brief   Sensor FIFO read raw samples sets.
+ * @details Reads up to @p n samples sets, the sets are stored one after
+ *          the other in the data array.
+ *
+ * @param[in] ip        pointer to a @p BaseSensorFIFO or derived class.
+ * @param[out] dp       pointer to a data array, it must be able to contain
+ *                      @p n samples sets
+ * @param[in] n         maximum number of samples sets to be read
+ * @param[out] np       pointer to the number of samples sets read
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more errors occurred.
+ *
+ * @api
+ */
+#define sensorFIFOReadRawSets(ip, dp, n, np)                                \
+  (ip)->vmt->read_raw_sets(ip, dp, n, np)
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -25,12 +25,19 @@ endif
 ifneq ($(findstring HAL_USE_CAN TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_can.c
 endif
+ifneq ($(findstring HAL_USE_CRC TRUE,$(HALCONF)),)
+HALSRC += $(CHIBIOS)/os/hal/src/hal_crc.c
+endif
 ifneq ($(findstring HAL_USE_CRY TRUE,$(HALCONF)),)
-HALSRC += $(CHIBIOS)/os/hal/src/hal_crypto.c
+HALSRC += $(CHIBIOS)/os/hal/src/hal_crypto.c \
+          $(CHIBIOS)/os/hal/lib/fallback/CRYPTO/hal_crypto_fallback.c
 endif
 ifneq ($(findstring HAL_USE_DAC TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_dac.c
 endif
+ifneq ($(findstring HAL_USE_DCMI TRUE,$(HALCONF)),)
+HALSRC += $(CHIBIOS)/os/hal/src/hal_dcmi.c
+endif
 ifneq ($(findstring HAL_USE_EFL TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_efl.c
 endif
@@ -91,6 +98,9 @@ endif
 ifneq ($(findstring HAL_USE_WSPI TRUE,$(HALCONF)),)
 HALSRC += $(CHIBIOS)/os/hal/src/hal_wspi.c
 endif
+ifneq ($(findstring HAL_USE_CLOCK_SCALING TRUE,$(HALCONF)),)
+HALSRC += $(CHIBIOS)/os/hal/src/hal_clock.c
+endif
 else
 HALSRC = $(CHIBIOS)/os/hal/src/hal.c \
          $(CHIBIOS)/os/hal/src/hal_st.c \
@@ -100,8 +110,11 @@ HALSRC = $(CHIBIOS)/os/hal/src/hal.c \
          $(CHIBIOS)/os/hal/src/hal_mmcsd.c \
          $(CHIBIOS)/os/hal/src/hal_adc.c \
          $(CHIBIOS)/os/hal/src/hal_can.c \
+         $(CHIBIOS)/os/hal/src/hal_crc.c \
          $(CHIBIOS)/os/hal/src/hal_crypto.c \
+         $(CHIBIOS)/os/hal/lib/fallback/CRYPTO/hal_crypto_fallback.c \
          $(CHIBIOS)/os/hal/src/hal_dac.c \
+         $(CHIBIOS)/os/hal/src/hal_dcmi.c \
          $(CHIBIOS)/os/hal/src/hal_efl.c \
          $(CHIBIOS)/os/hal/src/hal_gpt.c \
          $(CHIBIOS)/os/hal/src/hal_i2c.c \
@@ -121,11 +134,13 @@ HALSRC = $(CHIBIOS)/os/hal/src/hal.c \
          $(CHIBIOS)/os/hal/src/hal_uart.c \
          $(CHIBIOS)/os/hal/src/hal_usb.c \
          $(CHIBIOS)/os/hal/src/hal_wdg.c \
-         $(CHIBIOS)/os/hal/src/hal_wspi.c
+         $(CHIBIOS)/os/hal/src/hal_wspi.c \
+         $(CHIBIOS)/os/hal/src/hal_clock.c
 endif
 
 # Required include directories
-HALINC = $(CHIBIOS)/os/hal/include
+HALINC = $(CHIBIOS)/os/hal/include \
+         $(CHIBIOS)/os/hal/lib/fallback/CRYPTO
 
 # Shared variables
 ALLCSRC += $(HALSRC)
@@ -42,6 +42,10 @@
 #define HAL_USE_CAN                         FALSE
 #endif
 
+#if !defined(HAL_USE_CRC)
+#define HAL_USE_CRC                         FALSE
+#endif
+
 #if !defined(HAL_USE_CRY)
 #define HAL_USE_CRY                         FALSE
 #endif
@@ -50,6 +54,10 @@
 #define HAL_USE_DAC                         FALSE
 #endif
 
+#if !defined(HAL_USE_DCMI)
+#define HAL_USE_DCMI                        FALSE
+#endif
+
 #if !defined(HAL_USE_EFL)
 #define HAL_USE_EFL                         FALSE
 #endif
@@ -118,6 +126,10 @@
 #define HAL_USE_WSPI                        FALSE
 #endif
 
+#if !defined(HAL_USE_CLOCK_SCALING)
+#define HAL_USE_CLOCK_SCALING               FALSE
+#endif
+
 /* Low Level HAL support.*/
 #include "hal_lld.h"
 
@@ -134,13 +146,16 @@
 /* Shared headers.*/
 #include "hal_buffers.h"
 #include "hal_queues.h"
+#include "hal_clock.h"
 
 /* Normal drivers.*/
 #include "hal_pal.h"
 #include "hal_adc.h"
 #include "hal_can.h"
+#include "hal_crc.h"
 #include "hal_crypto.h"
 #include "hal_dac.h"
+#include "hal_dcmi.h"
 #include "hal_efl.h"
 #include "hal_gpt.h"
 #include "hal_i2c.h"
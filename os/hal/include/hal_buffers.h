@@ -318,6 +318,10 @@ extern "C" {
   msg_t ibqGetTimeout(input_buffers_queue_t *ibqp, sysinterval_t timeout);
   size_t ibqReadTimeout(input_buffers_queue_t *ibqp, uint8_t *bp,
                         size_t n, sysinterval_t timeout);
+  msg_t ibqBorrowBufferTimeout(input_buffers_queue_t *ibqp,
+                               const uint8_t **bpp, size_t *np,
+                               sysinterval_t timeout);
+  void ibqReturnBuffer(input_buffers_queue_t *ibqp, size_t n);
   void obqObjectInit(output_buffers_queue_t *obqp, bool suspended, uint8_t *bp,
                      size_t size, size_t n, bqnotify_t onfy, void *link);
   void obqResetI(output_buffers_queue_t *obqp);
@@ -334,6 +338,10 @@ extern "C" {
                       sysinterval_t timeout);
   size_t obqWriteTimeout(output_buffers_queue_t *obqp, const uint8_t *bp,
                          size_t n, sysinterval_t timeout);
+  msg_t obqBorrowBufferTimeout(output_buffers_queue_t *obqp,
+                               uint8_t **bpp, size_t *np,
+                               sysinterval_t timeout);
+  void obqReturnBuffer(output_buffers_queue_t *obqp, size_t n);
   bool obqTryFlushI(output_buffers_queue_t *obqp);
   void obqFlush(output_buffers_queue_t *obqp);
 #ifdef __cplusplus
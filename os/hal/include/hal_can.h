@@ -242,6 +242,11 @@ extern "C" {
                           canmbx_t mailbox,
                           CANRxFrame *crfp,
                           sysinterval_t timeout);
+  msg_t canReceiveBatchTimeout(CANDriver *canp,
+                               canmbx_t mailbox,
+                               CANRxFrame *crfp,
+                               size_t n,
+                               sysinterval_t timeout);
 #if CAN_USE_SLEEP_MODE
   void canSleep(CANDriver *canp);
   void canWakeup(CANDriver *canp);
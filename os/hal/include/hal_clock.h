@@ -0,0 +1,143 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_clock.h
+ * @brief   Clock scaling macros and structures.
+ *
+ * @addtogroup HAL_CLOCK
+ * @{
+ */
+
+#ifndef HAL_CLOCK_H
+#define HAL_CLOCK_H
+
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(HAL_LLD_SUPPORTS_CLOCK_SCALING) ||                             \
+    (HAL_LLD_SUPPORTS_CLOCK_SCALING != TRUE)
+#error "clock scaling not supported by the HAL LLD"
+#endif
+
+#if (HAL_LLD_CLOCK_LEVELS < 1) || (HAL_LLD_CLOCK_LEVELS > 16)
+#error "invalid HAL_LLD_CLOCK_LEVELS value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Clock change events.
+ */
+typedef enum {
+  HAL_CLOCK_PRE_CHANGE = 0,         /**< Clocks about to be changed.        */
+  HAL_CLOCK_POST_CHANGE = 1         /**< Clocks changed.                    */
+} halclkevent_t;
+
+/**
+ * @brief   Type of a clock change callback.
+ * @note    Callbacks are invoked from within a critical zone, the time
+ *          spent in them adds to the clock switch latency.
+ *
+ * @param[in] param     parameter specified on registration
+ * @param[in] event     the clock change event
+ */
+typedef void (*halclkcb_t)(void *param, halclkevent_t event);
+
+/**
+ * @brief   Type of a clock change listener.
+ */
+typedef struct hal_clock_listener hal_clock_listener_t;
+
+/**
+ * @brief   Structure representing a clock change listener.
+ */
+struct hal_clock_listener {
+  /**
+   * @brief   Next listener in the list.
+   */
+  hal_clock_listener_t      *next;
+  /**
+   * @brief   Clock change callback.
+   */
+  halclkcb_t                cb;
+  /**
+   * @brief   Callback parameter.
+   */
+  void                      *param;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Highest clock level, it is the boot clock configuration.
+ */
+#define HAL_CLOCK_LEVEL_MAX                 (HAL_LLD_CLOCK_LEVELS - 1U)
+
+/**
+ * @brief   Returns the current frequency of a clock point.
+ * @details The clock points are defined by the HAL LLD, drivers use the
+ *          returned value in order to recompute their dividers after a
+ *          clock change.
+ *
+ * @param[in] clkpt     clock point identifier
+ * @return              The clock point frequency in Hz.
+ *
+ * @xclass
+ */
+#define halClockGetPointX(clkpt) hal_lld_get_clock_point(clkpt)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void halClockInit(void);
+  void halClockRegisterListenerI(hal_clock_listener_t *lp,
+                                 halclkcb_t cb, void *param);
+  void halClockUnregisterListenerI(hal_clock_listener_t *lp);
+  unsigned halClockSetLevelS(unsigned level);
+  unsigned halClockSetLevel(unsigned level);
+  unsigned halClockGetLevelX(void);
+  unsigned halClockGetFloorX(void);
+  void halClockRequestLevel(unsigned level);
+  void halClockReleaseLevel(unsigned level);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_CLOCK_SCALING == TRUE */
+
+#endif /* HAL_CLOCK_H */
+
+/** @} */
@@ -0,0 +1,194 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crc.h
+ * @brief   CRC Driver macros and structures.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#ifndef HAL_CRC_H
+#define HAL_CRC_H
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    CRC configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the @p crcAcquireBus() and @p crcReleaseBus() APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(CRC_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
+#define CRC_USE_MUTUAL_EXCLUSION            TRUE
+#endif
+
+/**
+ * @brief   Enables the software fallback.
+ * @details If enabled then configurations not supported by the low level
+ *          driver are served by a table-driven software implementation,
+ *          the tables are generated by @p crcStart() and kept in the
+ *          driver structure.
+ */
+#if !defined(CRC_USE_SW_FALLBACK) || defined(__DOXYGEN__)
+#define CRC_USE_SW_FALLBACK                 TRUE
+#endif
+
+/**
+ * @brief   Number of tables used by the software fallback.
+ * @details The software fallback processes 1, 4 or 8 bytes per step
+ *          using the slicing-by-N technique, each table takes 1kB of RAM.
+ */
+#if !defined(CRC_SW_SLICES) || defined(__DOXYGEN__)
+#define CRC_SW_SLICES                       4
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CRC_SW_SLICES != 1) && (CRC_SW_SLICES != 4) && (CRC_SW_SLICES != 8)
+#error "invalid CRC_SW_SLICES value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  CRC_UNINIT = 0,                   /**< Not initialized.                   */
+  CRC_STOP = 1,                     /**< Stopped.                           */
+  CRC_READY = 2,                    /**< Ready.                             */
+  CRC_ACTIVE = 3                    /**< Computing a CRC.                   */
+} crcstate_t;
+
+/**
+ * @brief   Type of a structure representing a CRC driver.
+ */
+typedef struct hal_crc_driver CRCDriver;
+
+/**
+ * @brief   Driver configuration structure.
+ */
+typedef struct hal_crc_config CRCConfig;
+
+/* Including the low level driver header, it exports information required
+   for completing types.*/
+#include "hal_crc_lld.h"
+
+/**
+ * @brief   Driver configuration structure.
+ * @note    The initial value and the final XOR are not part of the
+ *          configuration, they are applied by the caller.
+ */
+struct hal_crc_config {
+  /**
+   * @brief   Polynomial in normal representation, without the implicit
+   *          most significant bit.
+   */
+  uint32_t                  poly;
+  /**
+   * @brief   CRC width in bits, from 1 to 32.
+   */
+  uint8_t                   width;
+  /**
+   * @brief   Reflected input and output.
+   */
+  bool                      reflect;
+  /* End of the mandatory fields.*/
+  crc_lld_config_fields;
+};
+
+/**
+ * @brief   Structure representing a CRC driver.
+ */
+struct hal_crc_driver {
+  /**
+   * @brief   Driver state.
+   */
+  crcstate_t                state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const CRCConfig           *config;
+#if (CRC_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Mutex protecting the peripheral.
+   */
+  mutex_t                   mutex;
+#endif
+#if (CRC_USE_SW_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   The current configuration is served in software.
+   */
+  bool                      sw;
+  /**
+   * @brief   Software fallback tables.
+   */
+  uint32_t                  sw_tables[CRC_SW_SLICES][256];
+#endif
+#if defined(CRC_DRIVER_EXT_FIELDS)
+  CRC_DRIVER_EXT_FIELDS
+#endif
+  /* End of the mandatory fields.*/
+  crc_lld_driver_fields;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void crcInit(void);
+  void crcObjectInit(CRCDriver *crcp);
+  void crcStart(CRCDriver *crcp, const CRCConfig *config);
+  void crcStop(CRCDriver *crcp);
+  uint32_t crcCompute(CRCDriver *crcp, uint32_t crc,
+                      size_t n, const void *buf);
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+  void crcAcquireBus(CRCDriver *crcp);
+  void crcReleaseBus(CRCDriver *crcp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_CRC == TRUE */
+
+#endif /* HAL_CRC_H */
+
+/** @} */
@@ -54,6 +54,16 @@
 #define HAL_CRY_ENFORCE_FALLBACK            FALSE
 #endif
 
+/**
+ * @brief   Enables the asynchronous jobs API.
+ * @details Jobs are queued by the callers and executed by a service thread
+ *          provided by the application, completion is notified using a
+ *          callback.
+ */
+#if !defined(HAL_CRY_USE_JOBS) || defined(__DOXYGEN__)
+#define HAL_CRY_USE_JOBS                    FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -107,6 +117,36 @@ typedef enum {
   cry_algo_hmac                             /**< HMAC variable size.        */
 } cryalgorithm_t;
 
+/**
+ * @brief   Type of a hash algorithm identifier.
+ */
+typedef enum {
+  cry_hash_sha1 = 0,                        /**< SHA-1.                     */
+  cry_hash_sha256,                          /**< SHA-256.                   */
+  cry_hash_sha512,                          /**< SHA-512.                   */
+  cry_hash_hmac_sha256,                     /**< HMAC-SHA-256.              */
+  cry_hash_hmac_sha512                      /**< HMAC-SHA-512.              */
+} cryhashalgo_t;
+
+/**
+ * @brief   Type of a batch hash entry.
+ */
+typedef struct {
+  /**
+   * @brief   Message buffer.
+   */
+  const uint8_t             *in;
+  /**
+   * @brief   Message size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Digest output buffer, it must be large enough for the
+   *          algorithm digest.
+   */
+  uint8_t                   *out;
+} cry_hash_entry_t;
+
 #if HAL_CRY_ENFORCE_FALLBACK == FALSE
 /* Use the defined low level driver.*/
 #include "hal_crypto_lld.h"
@@ -205,6 +245,142 @@ typedef struct {
 } HMACSHA512Context;
 #endif
 
+#if (HAL_CRY_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a job operation.
+ */
+typedef enum {
+  cry_job_encrypt_aes_ecb = 0,              /**< AES-ECB encryption.        */
+  cry_job_decrypt_aes_ecb,                  /**< AES-ECB decryption.        */
+  cry_job_encrypt_aes_cbc,                  /**< AES-CBC encryption.        */
+  cry_job_decrypt_aes_cbc,                  /**< AES-CBC decryption.        */
+  cry_job_encrypt_aes_ctr,                  /**< AES-CTR encryption.        */
+  cry_job_decrypt_aes_ctr,                  /**< AES-CTR decryption.        */
+  cry_job_encrypt_aes_gcm,                  /**< AES-GCM encryption.        */
+  cry_job_decrypt_aes_gcm,                  /**< AES-GCM decryption.        */
+  cry_job_sha256                            /**< SHA-256 digest.            */
+} cryjobop_t;
+
+/**
+ * @brief   Type of a job descriptor.
+ */
+typedef struct cry_job cry_job_t;
+
+/**
+ * @brief   Type of a job completion callback.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the completed @p cry_job_t object
+ */
+typedef void (*cryjobcb_t)(CRYDriver *cryp, cry_job_t *jobp);
+
+/**
+ * @brief   Type of a scatter list entry.
+ */
+typedef struct {
+  /**
+   * @brief   Input buffer.
+   */
+  const uint8_t             *in;
+  /**
+   * @brief   Output buffer, not used by digest jobs.
+   */
+  uint8_t                   *out;
+  /**
+   * @brief   Size of both buffers.
+   */
+  size_t                    size;
+} cry_segment_t;
+
+/**
+ * @brief   Job descriptor structure.
+ * @note    The descriptor and the buffers must stay valid until the
+ *          completion callback.
+ */
+struct cry_job {
+  /**
+   * @brief   Next job in the queue.
+   */
+  cry_job_t                 *next;
+  /**
+   * @brief   Job operation.
+   */
+  cryjobop_t                op;
+  /**
+   * @brief   Key to be used for the operation.
+   */
+  crykey_t                  key_id;
+  /**
+   * @brief   Input vector or @p NULL.
+   */
+  const uint8_t             *iv;
+  /**
+   * @brief   Scatter list.
+   * @note    Only AES-ECB, AES-CBC and SHA-256 jobs accept more than one
+   *          entry, the AES-CBC chaining continues across the entries.
+   */
+  const cry_segment_t       *segp;
+  /**
+   * @brief   Number of entries in the scatter list.
+   */
+  size_t                    n;
+  /**
+   * @brief   AES-GCM additional authenticated data size.
+   */
+  size_t                    auth_size;
+  /**
+   * @brief   AES-GCM additional authenticated data.
+   */
+  const uint8_t             *auth_in;
+  /**
+   * @brief   AES-GCM tag size.
+   */
+  size_t                    tag_size;
+  /**
+   * @brief   AES-GCM tag, output on encryption and input on decryption.
+   */
+  uint8_t                   *tag;
+  /**
+   * @brief   SHA-256 context used by the job.
+   */
+  SHA256Context             *sha256ctxp;
+  /**
+   * @brief   SHA-256 digest output.
+   */
+  uint8_t                   *digest;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  cryjobcb_t                end_cb;
+  /**
+   * @brief   Job result.
+   */
+  cryerror_t                error;
+};
+
+/**
+ * @brief   Type of a jobs queue.
+ */
+typedef struct {
+  /**
+   * @brief   Driver executing the jobs.
+   */
+  CRYDriver                 *cryp;
+  /**
+   * @brief   First queued job or @p NULL.
+   */
+  cry_job_t                 *head;
+  /**
+   * @brief   Last queued job.
+   */
+  cry_job_t                 *tail;
+  /**
+   * @brief   Service thread waiting for jobs.
+   */
+  thread_reference_t        server;
+} cry_jobs_queue_t;
+#endif /* HAL_CRY_USE_JOBS == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -372,6 +548,16 @@ extern "C" {
   cryerror_t cryHMACSHA512Final(CRYDriver *cryp,
                                 HMACSHA512Context *hmacsha512ctxp,
                                 uint8_t *out);
+  cryerror_t cryHashBatch(CRYDriver *cryp,
+                          cryhashalgo_t algo,
+                          const cry_hash_entry_t *entries,
+                          size_t n);
+#if HAL_CRY_USE_JOBS == TRUE
+  void cryJobsObjectInit(cry_jobs_queue_t *jqp, CRYDriver *cryp);
+  void cryJobSubmitI(cry_jobs_queue_t *jqp, cry_job_t *jobp);
+  void cryJobSubmit(cry_jobs_queue_t *jqp, cry_job_t *jobp);
+  msg_t cryJobsServeTimeout(cry_jobs_queue_t *jqp, sysinterval_t timeout);
+#endif
 #ifdef __cplusplus
 }
 #endif
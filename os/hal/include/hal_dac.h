@@ -54,6 +54,14 @@
 #if !defined(DAC_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
 #define DAC_USE_MUTUAL_EXCLUSION    TRUE
 #endif
+
+/**
+ * @brief   Enables the @p dacStartStreaming() API.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(DAC_USE_STREAMING) || defined(__DOXYGEN__)
+#define DAC_USE_STREAMING           FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -175,6 +183,16 @@ struct hal_dac_driver {
    */
   mutex_t                   mutex;
 #endif /* DAC_USE_MUTUAL_EXCLUSION */
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Streaming buffers queue or @p NULL.
+   */
+  output_buffers_queue_t    *obqp;
+  /**
+   * @brief   Number of underruns since the streaming start.
+   */
+  uint32_t                  underruns;
+#endif /* DAC_USE_STREAMING */
 #if defined(DAC_DRIVER_EXT_FIELDS)
   DAC_DRIVER_EXT_FIELDS
 #endif
@@ -205,6 +223,37 @@ struct hal_dac_driver {
  */
 #define dacIsBufferComplete(dacp) ((bool)((dacp)->state == DAC_COMPLETE))
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of underruns since the streaming start.
+ * @details An underrun happens when a half buffer is due and the streaming
+ *          queue does not contain enough samples, the last row is held in
+ *          the missing rows.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @return              The number of underruns.
+ *
+ * @xclass
+ */
+#define dacGetUnderrunsX(dacp) ((dacp)->underruns)
+
+/**
+ * @brief   Common ISR code, streaming refill.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] half      index of the consumed half buffer
+ *
+ * @notapi
+ */
+#define _dac_isr_stream_code(dacp, half) {                                  \
+  if ((dacp)->obqp != NULL) {                                               \
+    _dac_isr_stream_refill(dacp, half);                                     \
+  }                                                                         \
+}
+#else /* !DAC_USE_STREAMING */
+#define _dac_isr_stream_code(dacp, half)
+#endif /* !DAC_USE_STREAMING */
+
 #if (DAC_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Waits for operation completion.
@@ -285,6 +334,7 @@ struct hal_dac_driver {
  * @notapi
  */
 #define _dac_isr_half_code(dacp) {                                          \
+  _dac_isr_stream_code(dacp, 0U);                                           \
   if ((dacp)->grpp->end_cb != NULL) {                                       \
     (dacp)->grpp->end_cb(dacp);                                             \
   }                                                                         \
@@ -304,6 +354,7 @@ struct hal_dac_driver {
  * @notapi
  */
 #define _dac_isr_full_code(dacp) {                                          \
+  _dac_isr_stream_code(dacp, 1U);                                           \
   if ((dacp)->grpp->end_cb) {                                               \
     (dacp)->state = DAC_COMPLETE;                                           \
     (dacp)->grpp->end_cb(dacp);                                             \
@@ -368,6 +419,15 @@ extern "C" {
   void dacAcquireBus(DACDriver *dacp);
   void dacReleaseBus(DACDriver *dacp);
 #endif
+#if DAC_USE_STREAMING == TRUE
+  void dacStartStreaming(DACDriver *dacp, const DACConversionGroup *grpp,
+                         output_buffers_queue_t *obqp,
+                         dacsample_t *samples, size_t depth);
+  void dacStartStreamingI(DACDriver *dacp, const DACConversionGroup *grpp,
+                          output_buffers_queue_t *obqp,
+                          dacsample_t *samples, size_t depth);
+  void _dac_isr_stream_refill(DACDriver *dacp, unsigned half);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,311 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_dcmi.h
+ * @brief   DCMI Driver macros and structures.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#ifndef HAL_DCMI_H
+#define HAL_DCMI_H
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(CH_CFG_USE_OBJ_FIFOS) || (CH_CFG_USE_OBJ_FIFOS == FALSE)
+#error "DCMI driver requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  DCMI_UNINIT = 0,                  /**< Not initialized.                   */
+  DCMI_STOP = 1,                    /**< Stopped.                           */
+  DCMI_READY = 2,                   /**< Ready.                             */
+  DCMI_ACTIVE = 3,                  /**< Continuous capture.                */
+  DCMI_SNAPSHOT = 4                 /**< Single frame capture.              */
+} dcmistate_t;
+
+/**
+ * @brief   Type of a structure representing a DCMI driver.
+ */
+typedef struct hal_dcmi_driver DCMIDriver;
+
+/**
+ * @brief   Driver configuration structure.
+ */
+typedef struct hal_dcmi_config DCMIConfig;
+
+/**
+ * @brief   DCMI notification callback type.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ */
+typedef void (*dcmicallback_t)(DCMIDriver *dcmip);
+
+/**
+ * @brief   Type of a capture window.
+ */
+typedef struct {
+  /**
+   * @brief   Horizontal offset in pixel clocks.
+   */
+  uint16_t                  x;
+  /**
+   * @brief   Vertical offset in lines.
+   */
+  uint16_t                  y;
+  /**
+   * @brief   Width in pixel clocks, zero disables cropping.
+   */
+  uint16_t                  width;
+  /**
+   * @brief   Height in lines.
+   */
+  uint16_t                  height;
+} dcmi_crop_t;
+
+/* Including the low level driver header, it exports information required
+   for completing types.*/
+#include "hal_dcmi_lld.h"
+
+/**
+ * @brief   Driver configuration structure.
+ */
+struct hal_dcmi_config {
+  /**
+   * @brief   Size in bytes of a captured frame.
+   * @note    It must match exactly the amount of data captured for each
+   *          frame, after cropping.
+   */
+  size_t                    frame_size;
+  /**
+   * @brief   Capture window.
+   */
+  dcmi_crop_t               crop;
+  /**
+   * @brief   Capture error callback or @p NULL.
+   * @note    In continuous mode the capture is restarted after the
+   *          callback returns, the frame in progress is lost.
+   */
+  dcmicallback_t            error_cb;
+  /* End of the mandatory fields.*/
+  dcmi_lld_config_fields;
+};
+
+/**
+ * @brief   Structure representing a DCMI driver.
+ */
+struct hal_dcmi_driver {
+  /**
+   * @brief   Driver state.
+   */
+  dcmistate_t               state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const DCMIConfig          *config;
+  /**
+   * @brief   Frames FIFO used in continuous capture.
+   */
+  objects_fifo_t            *fifo;
+  /**
+   * @brief   Thread waiting for a snapshot.
+   */
+  thread_reference_t        thread;
+  /**
+   * @brief   Number of captured frames.
+   */
+  uint32_t                  frames;
+  /**
+   * @brief   Number of frames dropped for lack of free buffers.
+   */
+  uint32_t                  dropped;
+  /**
+   * @brief   Number of capture errors.
+   */
+  uint32_t                  errors;
+#if defined(DCMI_DRIVER_EXT_FIELDS)
+  DCMI_DRIVER_EXT_FIELDS
+#endif
+  /* End of the mandatory fields.*/
+  dcmi_lld_driver_fields;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @name    Macro Functions
+ * @{
+ */
+/**
+ * @brief   Returns the number of captured frames.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @return              The number of frames.
+ *
+ * @xclass
+ */
+#define dcmiGetFramesX(dcmip) ((dcmip)->frames)
+
+/**
+ * @brief   Returns the number of dropped frames.
+ * @details Frames are dropped when the application does not return the
+ *          buffers to the FIFO fast enough.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @return              The number of dropped frames.
+ *
+ * @xclass
+ */
+#define dcmiGetDroppedX(dcmip) ((dcmip)->dropped)
+
+/**
+ * @brief   Returns the number of capture errors.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @return              The number of errors.
+ *
+ * @xclass
+ */
+#define dcmiGetErrorsX(dcmip) ((dcmip)->errors)
+/** @} */
+
+/**
+ * @name    Low level driver helper macros
+ * @{
+ */
+/**
+ * @brief   Gets a free frame buffer.
+ * @note    Not meant to be used in the application code.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @return              A free frame buffer or @p NULL if none available
+ *                      or not capturing in continuous mode.
+ *
+ * @iclass
+ */
+#define _dcmi_get_frame_i(dcmip)                                            \
+  ((dcmip)->state == DCMI_ACTIVE ? chFifoTakeObjectI((dcmip)->fifo) : NULL)
+
+/**
+ * @brief   Releases a frame buffer not delivered to the application.
+ * @note    Not meant to be used in the application code.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] frame     frame buffer
+ *
+ * @iclass
+ */
+#define _dcmi_release_frame_i(dcmip, frame) {                               \
+  if ((dcmip)->state == DCMI_ACTIVE) {                                      \
+    chFifoReturnObjectI((dcmip)->fifo, frame);                              \
+  }                                                                         \
+}
+
+/**
+ * @brief   Common ISR code, frame captured.
+ * @details In continuous mode the frame is posted in the FIFO, in
+ *          snapshot mode the waiting thread is resumed.
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] frame     captured frame buffer
+ *
+ * @notapi
+ */
+#define _dcmi_isr_frame_code(dcmip, frame) {                                \
+  osalSysLockFromISR();                                                     \
+  (dcmip)->frames++;                                                        \
+  if ((dcmip)->state == DCMI_SNAPSHOT) {                                    \
+    (dcmip)->state = DCMI_READY;                                            \
+    osalThreadResumeI(&(dcmip)->thread, MSG_OK);                            \
+  }                                                                         \
+  else {                                                                    \
+    chFifoSendObjectI((dcmip)->fifo, frame);                                \
+  }                                                                         \
+  osalSysUnlockFromISR();                                                   \
+}
+
+/**
+ * @brief   Common ISR code, capture error.
+ * @details The error callback is invoked, a pending snapshot fails.
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+#define _dcmi_isr_error_code(dcmip) {                                       \
+  (dcmip)->errors++;                                                        \
+  if ((dcmip)->config->error_cb != NULL) {                                  \
+    (dcmip)->config->error_cb(dcmip);                                       \
+  }                                                                         \
+  if ((dcmip)->state == DCMI_SNAPSHOT) {                                    \
+    osalSysLockFromISR();                                                   \
+    (dcmip)->state = DCMI_READY;                                            \
+    osalThreadResumeI(&(dcmip)->thread, MSG_RESET);                         \
+    osalSysUnlockFromISR();                                                 \
+  }                                                                         \
+}
+/** @} */
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dcmiInit(void);
+  void dcmiObjectInit(DCMIDriver *dcmip);
+  void dcmiStart(DCMIDriver *dcmip, const DCMIConfig *config);
+  void dcmiStop(DCMIDriver *dcmip);
+  msg_t dcmiStartCapture(DCMIDriver *dcmip, objects_fifo_t *ofp);
+  void dcmiStopCapture(DCMIDriver *dcmip);
+  msg_t dcmiSnapshot(DCMIDriver *dcmip, void *buf, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+#endif /* HAL_DCMI_H */
+
+/** @} */
@@ -31,6 +31,11 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Bank identifier of addresses not belonging to the flash.
+ */
+#define EFL_NO_BANK                         0xFFFFFFFFU
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -52,6 +57,11 @@ typedef struct hal_efl_driver EFlashDriver;
 
 #include "hal_efl_lld.h"
 
+/* LLDs not declaring the banks capability are handled as single bank.*/
+#if !defined(EFL_LLD_SUPPORTS_BANKS)
+#define EFL_LLD_SUPPORTS_BANKS              FALSE
+#endif
+
 /**
  * @brief   @p EFlashDriver specific methods.
  */
@@ -119,6 +129,14 @@ extern "C" {
   void eflObjectInit(EFlashDriver *eflp);
   void eflStart(EFlashDriver *eflp, const EFlashConfig *config);
   void eflStop(EFlashDriver *eflp);
+  uint32_t eflGetBanksNumber(EFlashDriver *eflp);
+  uint32_t eflGetSectorBank(EFlashDriver *eflp, flash_sector_t sector);
+  uint32_t eflGetAddressBank(EFlashDriver *eflp, const void *addr);
+  uint32_t eflGetExecutionBank(EFlashDriver *eflp);
+  bool eflIsSectorConcurrent(EFlashDriver *eflp, flash_sector_t sector);
+  bool eflGetConcurrentSectors(EFlashDriver *eflp,
+                               flash_sector_t *firstp,
+                               flash_sector_t *np);
 #ifdef __cplusplus
 }
 #endif
@@ -90,7 +90,8 @@ typedef enum {
   FLASH_READY = 2,
   FLASH_READ = 3,
   FLASH_PGM = 4,
-  FLASH_ERASE = 5
+  FLASH_ERASE = 5,
+  FLASH_SUSPENDED = 6
 } flash_state_t;
 
 /**
@@ -189,7 +190,11 @@ typedef struct {
                                       flash_sector_t sector);               \
   flash_error_t (*query_erase)(void *instance, uint32_t *wait_time);        \
   /* Verify erase single sector.*/                                          \
-  flash_error_t (*verify_erase)(void *instance, flash_sector_t sector);
+  flash_error_t (*verify_erase)(void *instance, flash_sector_t sector);     \
+  /* Suspend the erase operation in progress.*/                             \
+  flash_error_t (*suspend_erase)(void *instance);                           \
+  /* Resume the suspended erase operation.*/                                \
+  flash_error_t (*resume_erase)(void *instance);
 
 /**
  * @brief   @p BaseFlash specific methods with inherited ones.
@@ -348,6 +353,43 @@ typedef struct {
  */
 #define flashVerifyErase(ip, sector)                                        \
   (ip)->vmt->verify_erase(ip, sector)
+
+/**
+ * @brief   Suspends the erase operation in progress.
+ * @details While the erase operation is suspended read and program
+ *          operations are allowed on sectors other than the one being
+ *          erased.
+ * @note    Only devices with the @p FLASH_ATTR_SUSPEND_ERASE_CAPABLE
+ *          attribute implement this function.
+ *
+ * @param[in] ip                    pointer to a @p BaseFlash or derived class
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if the operation has been suspended or
+ *                                  there is no erase operation in progress.
+ * @retval FLASH_ERROR_UNIMPLEMENTED if the device is not able to suspend
+ *                                  erase operations.
+ * @retval FLASH_ERROR_HW_FAILURE   if access to the memory failed.
+ *
+ * @api
+ */
+#define flashSuspendErase(ip)                                               \
+  (ip)->vmt->suspend_erase(ip)
+
+/**
+ * @brief   Resumes a suspended erase operation.
+ *
+ * @param[in] ip                    pointer to a @p BaseFlash or derived class
+ * @return                          An error code.
+ * @retval FLASH_NO_ERROR           if the operation has been resumed or
+ *                                  there is no suspended erase operation.
+ * @retval FLASH_ERROR_UNIMPLEMENTED if the device is not able to suspend
+ *                                  erase operations.
+ * @retval FLASH_ERROR_HW_FAILURE   if access to the memory failed.
+ *
+ * @api
+ */
+#define flashResumeErase(ip)                                                \
+  (ip)->vmt->resume_erase(ip)
 /** @} */
 
 /*===========================================================================*/
@@ -62,6 +62,14 @@
 #define I2C_USE_MUTUAL_EXCLUSION    TRUE
 #endif
 
+/**
+ * @brief   Enables the asynchronous requests queue APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(I2C_USE_QUEUE) || defined(__DOXYGEN__)
+#define I2C_USE_QUEUE               FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -82,8 +90,101 @@ typedef enum {
   I2C_LOCKED = 5                            /**< @brief Bus locked.         */
 } i2cstate_t;
 
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a request segment.
+ */
+typedef struct i2c_segment i2c_segment_t;
+
+/**
+ * @brief   Type of a queued request.
+ */
+typedef struct i2c_request i2c_request_t;
+#endif
+
 #include "hal_i2c_lld.h"
 
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+#if !defined(I2C_LLD_SUPPORTS_QUEUE)
+#error "I2C_USE_QUEUE not supported by the I2C low level driver"
+#endif
+
+/**
+ * @brief   Structure representing a request segment.
+ * @details A segment is a write phase followed by a read phase with
+ *          the same slave, either phase can be empty but not both.
+ *          Segments of a request are chained with repeated starts, the
+ *          STOP condition is sent after the last segment only.
+ */
+struct i2c_segment {
+  /**
+   * @brief   Slave device address (7 bits) without R/W bit.
+   */
+  i2caddr_t                 addr;
+  /**
+   * @brief   Transmit buffer or @p NULL.
+   */
+  const uint8_t             *txbuf;
+  /**
+   * @brief   Number of bytes to be transmitted.
+   */
+  size_t                    txbytes;
+  /**
+   * @brief   Receive buffer or @p NULL.
+   */
+  uint8_t                   *rxbuf;
+  /**
+   * @brief   Number of bytes to be received.
+   */
+  size_t                    rxbytes;
+};
+
+/**
+ * @brief   I2C request completion callback type.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] reqp      pointer to the completed @p i2c_request_t object
+ */
+typedef void (*i2crequestcb_t)(I2CDriver *i2cp, i2c_request_t *reqp);
+
+/**
+ * @brief   Structure representing a queued request.
+ * @note    The structure is owned by the driver from submission until
+ *          completion.
+ */
+struct i2c_request {
+  /**
+   * @brief   Next request in the queue.
+   */
+  i2c_request_t             *next;
+  /**
+   * @brief   Request priority, higher values are served first.
+   */
+  uint32_t                  prio;
+  /**
+   * @brief   Pointer to the request segments.
+   */
+  const i2c_segment_t       *segp;
+  /**
+   * @brief   Number of request segments.
+   */
+  size_t                    n;
+  /**
+   * @brief   Completion callback or @p NULL.
+   * @note    The callback is invoked from ISR context.
+   */
+  i2crequestcb_t            end_cb;
+  /**
+   * @brief   Errors mask of the completed request.
+   */
+  i2cflags_t                errors;
+  /**
+   * @brief   Waiting thread.
+   */
+  thread_reference_t        thread;
+};
+#endif /* I2C_USE_QUEUE == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -154,6 +255,13 @@ extern "C" {
   void i2cAcquireBus(I2CDriver *i2cp);
   void i2cReleaseBus(I2CDriver *i2cp);
 #endif
+#if I2C_USE_QUEUE == TRUE
+  void i2cQueueRequestI(I2CDriver *i2cp, i2c_request_t *reqp);
+  void i2cQueueRequest(I2CDriver *i2cp, i2c_request_t *reqp);
+  msg_t i2cRequest(I2CDriver *i2cp, i2c_request_t *reqp);
+  bool _i2c_isr_next_segment(I2CDriver *i2cp);
+  void _i2c_isr_end_request(I2CDriver *i2cp);
+#endif
 
 #ifdef __cplusplus
 }
@@ -30,6 +30,24 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Checksum offload flags
+ * @{
+ */
+#define MAC_CHECKSUM_GEN_IP         (1U << 0)
+#define MAC_CHECKSUM_GEN_UDP        (1U << 1)
+#define MAC_CHECKSUM_GEN_TCP        (1U << 2)
+#define MAC_CHECKSUM_GEN_ICMP       (1U << 3)
+#define MAC_CHECKSUM_CHECK_IP       (1U << 8)
+#define MAC_CHECKSUM_CHECK_UDP      (1U << 9)
+#define MAC_CHECKSUM_CHECK_TCP      (1U << 10)
+#define MAC_CHECKSUM_CHECK_ICMP     (1U << 11)
+#define MAC_CHECKSUM_CHECK_ALL      (MAC_CHECKSUM_CHECK_IP |                \
+                                     MAC_CHECKSUM_CHECK_UDP |               \
+                                     MAC_CHECKSUM_CHECK_TCP |               \
+                                     MAC_CHECKSUM_CHECK_ICMP)
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -51,6 +69,13 @@
 #if !defined(MAC_USE_EVENTS) || defined(__DOXYGEN__)
 #define MAC_USE_EVENTS              TRUE
 #endif
+
+/**
+ * @brief   Enables the IEEE 1588 PTP hardware clock and time stamps API.
+ */
+#if !defined(MAC_USE_PTP) || defined(__DOXYGEN__)
+#define MAC_USE_PTP                 FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -75,8 +100,32 @@ typedef enum {
  */
 typedef struct MACDriver MACDriver;
 
+#if (MAC_USE_PTP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a PTP time value.
+ */
+typedef struct {
+  /**
+   * @brief   Seconds.
+   */
+  uint32_t                  sec;
+  /**
+   * @brief   Nanoseconds, the range is 0..999999999.
+   */
+  uint32_t                  nsec;
+} mac_ptp_time_t;
+#endif
+
 #include "hal_mac_lld.h"
 
+/**
+ * @brief   Checksum operations performed by the hardware.
+ * @note    Drivers not supporting checksum offload leave this to zero.
+ */
+#if !defined(MAC_CHECKSUM_OFFLOAD) || defined(__DOXYGEN__)
+#define MAC_CHECKSUM_OFFLOAD        0U
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -168,6 +217,40 @@ typedef struct MACDriver MACDriver;
 #define macGetNextReceiveBuffer(rdp, sizep)                                 \
   mac_lld_get_next_receive_buffer(rdp, sizep)
 #endif /* MAC_USE_ZERO_COPY */
+
+#if (MAC_USE_PTP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the hardware time stamp of a transmitted frame.
+ * @note    The time stamp is available after the frame has been sent and
+ *          until the descriptor is obtained again for another frame.
+ *
+ * @param[in] tdp       pointer to a released @p MACTransmitDescriptor
+ *                      structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ * @retval true         if the time stamp has been captured.
+ * @retval false        if the frame has not been sent yet or the time
+ *                      stamp was not captured.
+ *
+ * @api
+ */
+#define macGetTransmitTimestamp(tdp, tp)                                    \
+  mac_lld_get_transmit_timestamp(tdp, tp)
+
+/**
+ * @brief   Returns the hardware time stamp of a received frame.
+ *
+ * @param[in] rdp       pointer to a @p MACReceiveDescriptor structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ * @retval true         if the time stamp has been captured.
+ * @retval false        if the time stamp was not captured.
+ *
+ * @api
+ */
+#define macGetReceiveTimestamp(rdp, tp)                                     \
+  mac_lld_get_receive_timestamp(rdp, tp)
+#endif /* MAC_USE_PTP */
 /** @} */
 
 /*===========================================================================*/
@@ -189,8 +272,18 @@ extern "C" {
   msg_t macWaitReceiveDescriptor(MACDriver *macp,
                                  MACReceiveDescriptor *rdp,
                                  sysinterval_t timeout);
+  size_t macWaitReceiveDescriptors(MACDriver *macp,
+                                   MACReceiveDescriptor *rdp,
+                                   size_t n,
+                                   sysinterval_t timeout);
   void macReleaseReceiveDescriptor(MACReceiveDescriptor *rdp);
   bool macPollLinkStatus(MACDriver *macp);
+#if MAC_USE_PTP == TRUE
+  void macPTPGetTimeX(MACDriver *macp, mac_ptp_time_t *tp);
+  void macPTPSetTime(MACDriver *macp, const mac_ptp_time_t *tp);
+  void macPTPAdjustTime(MACDriver *macp, int64_t offset);
+  void macPTPAdjustRate(MACDriver *macp, int32_t ppb);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -55,6 +55,16 @@
 #if !defined(MMC_NICE_WAITING) || defined(__DOXYGEN__)
 #define MMC_NICE_WAITING            TRUE
 #endif
+
+/**
+ * @brief   Size of the polling transactions.
+ * @details Tokens and busy conditions are polled this number of bytes
+ *          at time, larger values reduce the number of SPI transactions
+ *          at the cost of some extra clocks after the awaited condition.
+ */
+#if !defined(MMC_POLL_SIZE) || defined(__DOXYGEN__)
+#define MMC_POLL_SIZE               8U
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -65,6 +75,10 @@
 #error "MMC_SPI driver requires HAL_USE_SPI and SPI_USE_WAIT"
 #endif
 
+#if (MMC_POLL_SIZE < 1U) || (MMC_POLL_SIZE > 64U)
+#error "invalid MMC_POLL_SIZE value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -121,6 +135,20 @@ typedef struct {
    * @brief Addresses use blocks instead of bytes.
    */
   bool                  block_addresses;
+  /**
+   * @brief Bytes received ahead of the current block.
+   * @details The CRC of a block is received together with the first
+   *          polling bytes of the next one.
+   */
+  uint8_t               lookahead[MMC_POLL_SIZE + 2U];
+  /**
+   * @brief Position of the first unprocessed byte in @p lookahead.
+   */
+  size_t                lapos;
+  /**
+   * @brief Number of valid bytes in @p lookahead.
+   */
+  size_t                lacnt;
 } MMCDriver;
 
 /*===========================================================================*/
@@ -78,17 +78,21 @@
 #define MMCSD_CMD_SEND_EXT_CSD          MMCSD_CMD_SEND_IF_COND
 #define MMCSD_CMD_SEND_CSD              9U
 #define MMCSD_CMD_SEND_CID              10U
+#define MMCSD_CMD_VOLTAGE_SWITCH        11U
 #define MMCSD_CMD_STOP_TRANSMISSION     12U
 #define MMCSD_CMD_SEND_STATUS           13U
 #define MMCSD_CMD_SET_BLOCKLEN          16U
 #define MMCSD_CMD_READ_SINGLE_BLOCK     17U
 #define MMCSD_CMD_READ_MULTIPLE_BLOCK   18U
+#define MMCSD_CMD_SEND_TUNING_BLOCK     19U
+#define MMCSD_CMD_SEND_TUNING_HS200     21U
 #define MMCSD_CMD_SET_BLOCK_COUNT       23U
 #define MMCSD_CMD_WRITE_BLOCK           24U
 #define MMCSD_CMD_WRITE_MULTIPLE_BLOCK  25U
 #define MMCSD_CMD_ERASE_RW_BLK_START    32U
 #define MMCSD_CMD_ERASE_RW_BLK_END      33U
 #define MMCSD_CMD_ERASE                 38U
+#define MMCSD_CMD_APP_SET_WR_BLK_ERASE  23U
 #define MMCSD_CMD_APP_OP_COND           41U
 #define MMCSD_CMD_LOCK_UNLOCK           42U
 #define MMCSD_CMD_APP_CMD               55U
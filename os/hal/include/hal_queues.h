@@ -304,6 +304,7 @@ extern "C" {
                     qnotify_t infy, void *link);
   void iqResetI(input_queue_t *iqp);
   msg_t iqPutI(input_queue_t *iqp, uint8_t b);
+  size_t iqWriteI(input_queue_t *iqp, const uint8_t *bp, size_t n);
   msg_t iqGetI(input_queue_t *iqp);
   msg_t iqGetTimeout(input_queue_t *iqp, sysinterval_t timeout);
   size_t iqReadI(input_queue_t *iqp, uint8_t *bp, size_t n);
@@ -316,6 +317,7 @@ extern "C" {
   msg_t oqPutI(output_queue_t *oqp, uint8_t b);
   msg_t oqPutTimeout(output_queue_t *oqp, uint8_t b, sysinterval_t timeout);
   msg_t oqGetI(output_queue_t *oqp);
+  size_t oqReadI(output_queue_t *oqp, uint8_t *bp, size_t n);
   size_t oqWriteI(output_queue_t *oqp, const uint8_t *bp, size_t n);
   size_t oqWriteTimeout(output_queue_t *oqp, const uint8_t *bp,
                         size_t n, sysinterval_t timeout);
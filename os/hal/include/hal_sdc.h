@@ -40,6 +40,16 @@
 #define SDC_MODE_CARDTYPE_SDV20             1U
 #define SDC_MODE_CARDTYPE_MMC               2U
 #define SDC_MODE_HIGH_CAPACITY              0x10U
+#define SDC_MODE_LOW_VOLTAGE                0x20U
+/** @} */
+
+/**
+ * @name    Card I/O signaling capabilities
+ * @{
+ */
+#define SDC_SIGNALING_3V3                   0U
+#define SDC_SIGNALING_1V8                   1U
+#define SDC_SIGNALING_SWITCHABLE            2U
 /** @} */
 
 /**
@@ -93,6 +103,28 @@
 #define SDC_NICE_WAITING                    TRUE
 #endif
 
+/**
+ * @brief   Pre-erase of multi-block writes.
+ * @details If enabled, multi-block writes to SD cards are preceded by an
+ *          ACMD23 command declaring the number of blocks to be written,
+ *          the card can pre-erase the area and program it faster.
+ */
+#if !defined(SDC_USE_PREERASE) || defined(__DOXYGEN__)
+#define SDC_USE_PREERASE                    FALSE
+#endif
+
+/**
+ * @brief   Include support for the fast bus modes.
+ * @details If enabled, eMMC devices are switched to the HS200 or DDR52
+ *          modes and SD cards to the UHS-I SDR50 or SDR104 modes when
+ *          supported by the card, the board and the low level driver.
+ * @note    HS200, SDR50 and SDR104 require 1.8V signaling, the board
+ *          capability is declared in the low level driver configuration.
+ */
+#if !defined(SDC_UHS_SUPPORT) || defined(__DOXYGEN__)
+#define SDC_UHS_SUPPORT                     FALSE
+#endif
+
 /**
  * @brief   OCR initialization constant for V20 cards.
  */
@@ -130,11 +162,19 @@ typedef enum {
  */
 typedef enum {
   SDC_CLK_25MHz = 0,
-  SDC_CLK_50MHz
+  SDC_CLK_50MHz,
+  SDC_CLK_50MHz_DDR,
+  SDC_CLK_100MHz,
+  SDC_CLK_200MHz
 } sdcbusclk_t;
 
 #include "hal_sdc_lld.h"
 
+#if (SDC_UHS_SUPPORT == TRUE) &&                                            \
+    (!defined(SDC_SUPPORTS_UHS) || (SDC_SUPPORTS_UHS == FALSE))
+#error "SDC_UHS_SUPPORT requires a low level driver supporting UHS modes"
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -198,6 +238,9 @@ extern "C" {
   bool sdcGetInfo(SDCDriver *sdcp, BlockDeviceInfo *bdip);
   bool sdcErase(SDCDriver *sdcp, uint32_t startblk, uint32_t endblk);
   bool _sdc_wait_for_transfer_state(SDCDriver *sdcp);
+#if SDC_USE_PREERASE == TRUE
+  bool _sdc_preerase(SDCDriver *sdcp, uint32_t n);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -297,6 +297,7 @@ extern "C" {
   void sdStart(SerialDriver *sdp, const SerialConfig *config);
   void sdStop(SerialDriver *sdp);
   void sdIncomingDataI(SerialDriver *sdp, uint8_t b);
+  void sdIncomingDataBufferI(SerialDriver *sdp, const uint8_t *bp, size_t n);
   msg_t sdRequestDataI(SerialDriver *sdp);
   bool sdPutWouldBlock(SerialDriver *sdp);
   bool sdGetWouldBlock(SerialDriver *sdp);
@@ -47,6 +47,10 @@
  *          the USB data endpoint maximum packet size.
  * @note    The default is 256 bytes for both the transmission and receive
  *          buffers.
+ * @note    Each buffer is moved in a single multi-packet USB transfer, the
+ *          size is also the transfer size. Larger buffers reduce the
+ *          number of transfers per second, on high speed links a size of
+ *          several 512 bytes packets is recommended.
  */
 #if !defined(SERIAL_USB_BUFFERS_SIZE) || defined(__DOXYGEN__)
 #define SERIAL_USB_BUFFERS_SIZE     256
@@ -166,6 +170,75 @@ struct SerialUSBDriver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @name    Zero-copy buffers access
+ * @{
+ */
+/**
+ * @brief   Borrows the current receive buffer for in place access.
+ * @details Received data is accessed directly in the input buffers queue,
+ *          the buffer is then returned using @p sduReturnReceiveBuffer().
+ * @note    It can be mixed with the stream read functions, data not
+ *          consumed is returned by subsequent reads.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[out] bpp      pointer to a variable receiving the data pointer
+ * @param[out] np       pointer to a variable receiving the data size
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been borrowed.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the driver has been stopped or disconnected.
+ *
+ * @api
+ */
+#define sduBorrowReceiveBufferTimeout(sdup, bpp, np, timeout)               \
+  ibqBorrowBufferTimeout(&(sdup)->ibqueue, bpp, np, timeout)
+
+/**
+ * @brief   Returns a borrowed receive buffer.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] n         number of bytes consumed
+ *
+ * @api
+ */
+#define sduReturnReceiveBuffer(sdup, n)                                     \
+  ibqReturnBuffer(&(sdup)->ibqueue, n)
+
+/**
+ * @brief   Borrows an empty transmit buffer for in place access.
+ * @details Data is written directly in the output buffers queue, the
+ *          buffer is then returned using @p sduReturnTransmitBuffer() and
+ *          sent as a single USB transfer.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[out] bpp      pointer to a variable receiving the buffer pointer
+ * @param[out] np       pointer to a variable receiving the buffer size
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been borrowed.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the driver has been stopped or disconnected.
+ *
+ * @api
+ */
+#define sduBorrowTransmitBufferTimeout(sdup, bpp, np, timeout)              \
+  obqBorrowBufferTimeout(&(sdup)->obqueue, bpp, np, timeout)
+
+/**
+ * @brief   Returns a borrowed transmit buffer.
+ *
+ * @param[in] sdup      pointer to a @p SerialUSBDriver object
+ * @param[in] n         number of bytes written in the buffer, if zero the
+ *                      buffer is not sent
+ *
+ * @api
+ */
+#define sduReturnTransmitBuffer(sdup, n)                                    \
+  obqReturnBuffer(&(sdup)->obqueue, n)
+/** @} */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -74,6 +74,16 @@
 #if !defined(SIO_USE_SYNCHRONIZATION) || defined(__DOXYGEN__)
 #define SIO_USE_SYNCHRONIZATION             TRUE
 #endif
+
+/**
+ * @brief   Support for the DMA streaming mode.
+ * @details In streaming mode data is received continuously into an user
+ *          ring buffer and transmitted from a chain of user buffers.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(SIO_USE_STREAMING) || defined(__DOXYGEN__)
+#define SIO_USE_STREAMING                   FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -104,6 +114,18 @@ typedef struct hal_sio_config SIOConfig;
  */
 typedef struct hal_sio_operation SIOOperation;
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of structure representing a SIO streaming configuration.
+ */
+typedef struct hal_sio_stream_config SIOStreamConfig;
+
+/**
+ * @brief   Type of a SIO streaming transmit buffer.
+ */
+typedef struct hal_sio_txbuf sio_txbuf_t;
+#endif
+
 /**
  * @brief   Generic SIO notification callback type.
  *
@@ -123,6 +145,10 @@ typedef enum {
 
 #include "hal_sio_lld.h"
 
+#if (SIO_USE_STREAMING == TRUE) && !defined(SIO_LLD_SUPPORTS_STREAMING)
+#error "SIO streaming mode not supported by the low level driver"
+#endif
+
 /**
  * @brief   Driver configuration structure.
  * @note    Implementations may extend this structure to contain more,
@@ -186,6 +212,28 @@ struct hal_sio_driver {
    */
   thread_reference_t        sync_txend;
 #endif /* SIO_USE_SYNCHRONIZATION == TRUE */
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Current streaming configuration or @p NULL.
+   */
+  const SIOStreamConfig     *stream;
+  /**
+   * @brief   Streaming RX ring read index.
+   */
+  size_t                    rxrdptr;
+  /**
+   * @brief   Head of the chain of buffers being transmitted.
+   */
+  sio_txbuf_t               *txhead;
+  /**
+   * @brief   Tail of the chain of buffers being transmitted.
+   */
+  sio_txbuf_t               *txtail;
+  /**
+   * @brief   Last transmitted buffer.
+   */
+  sio_txbuf_t               *txdone;
+#endif /* SIO_USE_STREAMING == TRUE */
 #if defined(SIO_DRIVER_EXT_FIELDS)
   SIO_DRIVER_EXT_FIELDS
 #endif
@@ -224,6 +272,51 @@ struct hal_sio_operation {
   siocb_t                   rx_evt_cb;
 };
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Structure representing a SIO streaming configuration.
+ */
+struct hal_sio_stream_config {
+  /**
+   * @brief   RX ring buffer.
+   */
+  uint8_t                   *rxbuf;
+  /**
+   * @brief   RX ring buffer size, must be even.
+   */
+  size_t                    rxsize;
+  /**
+   * @brief   RX wakeup threshold.
+   * @details The RX-waiting thread is woken when the ring contains more
+   *          than this number of bytes, zero means any data.
+   * @note    The amount of data is checked on half and full ring events,
+   *          a ring size of twice the threshold gives the finest
+   *          granularity. An idle line always wakes the thread.
+   */
+  size_t                    rxthreshold;
+};
+
+/**
+ * @brief   Structure representing a SIO streaming transmit buffer.
+ * @note    The buffer belongs to the driver from the moment it is queued
+ *          until its transmission is complete.
+ */
+struct hal_sio_txbuf {
+  /**
+   * @brief   Next buffer in the chain.
+   */
+  sio_txbuf_t               *next;
+  /**
+   * @brief   Data to be transmitted.
+   */
+  const uint8_t             *buffer;
+  /**
+   * @brief   Number of bytes to be transmitted.
+   */
+  size_t                    n;
+};
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -337,6 +430,43 @@ struct hal_sio_operation {
  */
 #define sioControlX(siop, operation, arg) sio_lld_control(siop, operation, arg)
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the streaming RX ring write index.
+ * @details The index is the position in the ring where the next received
+ *          byte will be written.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @return              The write index.
+ *
+ * @xclass
+ */
+#define sioStreamGetWritePointerX(siop) sio_lld_stream_get_wrptr(siop)
+
+/**
+ * @brief   Returns the number of bytes in the streaming RX ring.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @return              The number of received bytes not yet released.
+ *
+ * @xclass
+ */
+#define sioStreamGetRXCountX(siop)                                          \
+  __sio_stream_rx_count(siop, sio_lld_stream_get_wrptr(siop))
+
+/**
+ * @brief   Returns the last transmitted streaming buffer.
+ * @note    This function is meant to be called from the @p tx_cb callback
+ *          handler, buffers are released in the order they were queued.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @return              The last transmitted buffer.
+ *
+ * @xclass
+ */
+#define sioStreamGetTXDoneX(siop) ((siop)->txdone)
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /**
  * @name    Low level driver helper macros
  * @{
@@ -451,6 +581,20 @@ struct hal_sio_operation {
 #define __sio_wakeup_txend(siop, msg)
 #endif /* !SIO_USE_SYNCHRONIZATION */
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of bytes in the streaming RX ring.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] wrptr     current ring write index
+ *
+ * @notapi
+ */
+#define __sio_stream_rx_count(siop, wrptr)                                  \
+  (((wrptr) >= (siop)->rxrdptr) ? ((wrptr) - (siop)->rxrdptr) :             \
+   ((siop)->stream->rxsize - (siop)->rxrdptr + (wrptr)))
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -466,6 +610,14 @@ extern "C" {
   void sioStopOperation(SIODriver *siop);
   size_t sioAsyncRead(SIODriver *siop, uint8_t *buffer, size_t n);
   size_t sioAsyncWrite(SIODriver *siop, const uint8_t *buffer, size_t n);
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+  void sioStartStreaming(SIODriver *siop, const SIOOperation *operation,
+                         const SIOStreamConfig *scp);
+  size_t sioStreamPeekRX(SIODriver *siop, const uint8_t **bpp);
+  void sioStreamReleaseRX(SIODriver *siop, size_t n);
+  void sioStreamWriteI(SIODriver *siop, sio_txbuf_t *tbp);
+  void sioStreamWrite(SIODriver *siop, sio_txbuf_t *tbp);
+#endif
 #if (SIO_USE_SYNCHRONIZATION == TRUE) || defined(__DOXYGEN__)
   msg_t sioSynchronizeRX(SIODriver *siop, sysinterval_t timeout);
   msg_t sioSynchronizeTX(SIODriver *siop, sysinterval_t timeout);
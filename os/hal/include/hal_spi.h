@@ -44,6 +44,14 @@
 #define SPI_SELECT_MODE_LLD                 4   /** @brief LLD-defined mode.*/
 /** @} */
 
+/**
+ * @name    Transaction segment flags
+ * @{
+ */
+#define SPI_SEG_SELECT                      1U  /** @brief Select before.   */
+#define SPI_SEG_UNSELECT                    2U  /** @brief Unselect after.  */
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -68,6 +76,32 @@
 #define SPI_USE_CIRCULAR                    FALSE
 #endif
 
+/**
+ * @brief   Enables the slave mode APIs.
+ * @note    Requires @p PAL_USE_CALLBACKS for the NSS framing events.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_SLAVE) || defined(__DOXYGEN__)
+#define SPI_USE_SLAVE                       FALSE
+#endif
+
+/**
+ * @brief   Enables the segmented transactions APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_TRANSACTIONS) || defined(__DOXYGEN__)
+#define SPI_USE_TRANSACTIONS                FALSE
+#endif
+
+/**
+ * @brief   Enables the requests queue APIs.
+ * @note    Requires @p SPI_USE_TRANSACTIONS.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_QUEUE) || defined(__DOXYGEN__)
+#define SPI_USE_QUEUE                       FALSE
+#endif
+
 /**
  * @brief   Enables the @p spiAcquireBus() and @p spiReleaseBus() APIs.
  * @note    Disabling this option saves both code and data space.
@@ -97,6 +131,10 @@
 #error "invalid SPI_SELECT_MODE setting"
 #endif
 
+#if (SPI_USE_QUEUE == TRUE) && (SPI_USE_TRANSACTIONS == FALSE)
+#error "SPI_USE_QUEUE requires SPI_USE_TRANSACTIONS"
+#endif
+
 /* Some modes have a dependency on the PAL driver, making the required
    checks here.*/
 #if ((SPI_SELECT_MODE != SPI_SELECT_MODE_PAD)  ||                           \
@@ -138,10 +176,101 @@ typedef struct hal_spi_config SPIConfig;
  */
 typedef void (*spicallback_t)(SPIDriver *spip);
 
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a transaction segment.
+ * @details A segment describes one step of a transaction, the operation
+ *          performed depends on the buffers:
+ *          - @p txbuf and @p rxbuf both @p NULL, idle words are sent and
+ *            the received data is ignored.
+ *          - @p rxbuf @p NULL, send operation.
+ *          - @p txbuf @p NULL, receive operation.
+ *          - Both buffers specified, exchange operation.
+ *          .
+ */
+typedef struct {
+  /**
+   * @brief   Number of words in the segment, must be greater than zero.
+   */
+  size_t                    n;
+  /**
+   * @brief   Transmit buffer or @p NULL.
+   */
+  const void                *txbuf;
+  /**
+   * @brief   Receive buffer or @p NULL.
+   */
+  void                      *rxbuf;
+  /**
+   * @brief   Segment flags, a combination of @p SPI_SEG_SELECT and
+   *          @p SPI_SEG_UNSELECT.
+   */
+  uint32_t                  flags;
+} spi_segment_t;
+#endif
+
+#if (SPI_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a queued request.
+ */
+typedef struct spi_request spi_request_t;
+
+/**
+ * @brief   SPI request completion callback type.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] reqp      pointer to the completed @p spi_request_t object
+ */
+typedef void (*spirequestcb_t)(SPIDriver *spip, spi_request_t *reqp);
+
+/**
+ * @brief   Structure representing a queued request.
+ * @note    The structure is owned by the driver from submission until
+ *          completion.
+ */
+struct spi_request {
+  /**
+   * @brief   Next request in the queue.
+   */
+  spi_request_t             *next;
+  /**
+   * @brief   Request priority, higher values are served first.
+   */
+  uint32_t                  prio;
+  /**
+   * @brief   Pointer to the transaction segments.
+   */
+  const spi_segment_t       *segp;
+  /**
+   * @brief   Number of transaction segments.
+   */
+  size_t                    n;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  spirequestcb_t            end_cb;
+#if (SPI_USE_WAIT == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Waiting thread.
+   */
+  thread_reference_t        thread;
+#endif
+};
+#endif
+
 /* Including the low level driver header, it exports information required
    for completing types.*/
 #include "hal_spi_lld.h"
 
+#if (SPI_USE_SLAVE == TRUE) && (!defined(SPI_SUPPORTS_SLAVE_MODE) ||        \
+                                (SPI_SUPPORTS_SLAVE_MODE == FALSE))
+#error "SPI_USE_SLAVE not supported by the low level driver"
+#endif
+
+#if (SPI_USE_SLAVE == TRUE) && (PAL_USE_CALLBACKS != TRUE)
+#error "SPI_USE_SLAVE requires PAL_USE_CALLBACKS"
+#endif
+
 /**
  * @brief   Driver configuration structure.
  */
@@ -156,6 +285,27 @@ struct hal_spi_config {
    * @brief Operation complete callback or @p NULL.
    */
   spicallback_t             end_cb;
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Enables the slave mode, the clock is driven by the master.
+   * @note    Slave operations are started using @p spiStartSlave() and
+   *          require the circular buffer mode.
+   */
+  bool                      slave;
+  /**
+   * @brief   NSS line monitored for the framing events.
+   * @note    This is the same pad used by the SPI peripheral for the
+   *          hardware NSS, the PAL event is enabled on both edges while a
+   *          slave operation is in progress.
+   */
+  ioline_t                  nssline;
+  /**
+   * @brief   NSS edges callback or @p NULL.
+   * @note    The line state is returned by @p spiIsSlaveSelectedX(), no
+   *          event is enabled if the callback is @p NULL.
+   */
+  spicallback_t             nss_cb;
+#endif
 #if (SPI_SELECT_MODE == SPI_SELECT_MODE_LINE) || defined(__DOXYGEN__)
   /**
    * @brief The chip select line.
@@ -210,6 +360,33 @@ struct hal_spi_driver {
    */
   mutex_t                   mutex;
 #endif /* SPI_USE_MUTUAL_EXCLUSION == TRUE */
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Current transaction segment or @p NULL.
+   */
+  const spi_segment_t       *segp;
+  /**
+   * @brief   Segments left in the current transaction, including the
+   *          current one.
+   */
+  size_t                    segn;
+#endif /* SPI_USE_TRANSACTIONS == TRUE */
+#if (SPI_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Pending requests, in priority order.
+   */
+  spi_request_t             *qhead;
+  /**
+   * @brief   Request in progress or @p NULL.
+   */
+  spi_request_t             *qcurr;
+#endif /* SPI_USE_QUEUE == TRUE */
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Size of the circular buffers of the slave operation.
+   */
+  size_t                    slaven;
+#endif /* SPI_USE_SLAVE == TRUE */
 #if defined(SPI_DRIVER_EXT_FIELDS)
   SPI_DRIVER_EXT_FIELDS
 #endif
@@ -399,6 +576,35 @@ do {                                                                        \
  * @return              The received data frame from the SPI bus.
  */
 #define spiPolledExchange(spip, frame) spi_lld_polled_exchange(spip, frame)
+
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the NSS line state.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @return              The NSS state.
+ * @retval false        if the master is not selecting this slave.
+ * @retval true         if the master is selecting this slave.
+ *
+ * @xclass
+ */
+#define spiIsSlaveSelectedX(spip)                                           \
+  ((bool)(palReadLine((spip)->config->nssline) == PAL_LOW))
+
+/**
+ * @brief   Returns the position in the slave circular buffers.
+ * @details The position is the index of the next word to be received
+ *          and transmitted, it can be sampled in the NSS callback in order
+ *          to delimit the frames sent by the master.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @return              The current position in words.
+ *
+ * @xclass
+ */
+#define spiGetSlavePositionX(spip)                                          \
+  ((spip)->slaven - spi_lld_get_remaining(spip))
+#endif /* SPI_USE_SLAVE == TRUE */
 /** @} */
 
 /**
@@ -422,9 +628,14 @@ do {                                                                        \
 #define _spi_wakeup_isr(spip)
 #endif /* !SPI_USE_WAIT */
 
+#if (SPI_USE_TRANSACTIONS == FALSE) && !defined(__DOXYGEN__)
+#define _spi_isr_next_segment(spip) false
+#endif
+
 /**
  * @brief   Common ISR code when circular mode is not supported.
  * @details This code handles the portable part of the ISR code:
+ *          - Next transaction segment start, if any.
  *          - Callback invocation.
  *          - Waiting thread wakeup, if any.
  *          - Driver state transitions.
@@ -437,15 +648,17 @@ do {                                                                        \
  * @notapi
  */
 #define _spi_isr_code(spip) {                                               \
-  if ((spip)->config->end_cb) {                                             \
-    (spip)->state = SPI_COMPLETE;                                           \
-    (spip)->config->end_cb(spip);                                           \
-    if ((spip)->state == SPI_COMPLETE)                                      \
+  if (_spi_isr_next_segment(spip) == false) {                               \
+    if ((spip)->config->end_cb) {                                           \
+      (spip)->state = SPI_COMPLETE;                                         \
+      (spip)->config->end_cb(spip);                                         \
+      if ((spip)->state == SPI_COMPLETE)                                    \
+        (spip)->state = SPI_READY;                                          \
+    }                                                                       \
+    else                                                                    \
       (spip)->state = SPI_READY;                                            \
+    _spi_wakeup_isr(spip);                                                  \
   }                                                                         \
-  else                                                                      \
-    (spip)->state = SPI_READY;                                              \
-  _spi_wakeup_isr(spip);                                                    \
 }
 
 /**
@@ -511,12 +724,35 @@ extern "C" {
   void spiAbortI(SPIDriver *spip);
   void spiAbort(SPIDriver *spip);
 #endif
+#if SPI_USE_SLAVE == TRUE
+  void spiStartSlaveI(SPIDriver *spip, size_t n,
+                      const void *txbuf, void *rxbuf);
+  void spiStartSlave(SPIDriver *spip, size_t n,
+                     const void *txbuf, void *rxbuf);
+#endif
 #if SPI_USE_WAIT == TRUE
   void spiIgnore(SPIDriver *spip, size_t n);
   void spiExchange(SPIDriver *spip, size_t n, const void *txbuf, void *rxbuf);
   void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
   void spiReceive(SPIDriver *spip, size_t n, void *rxbuf);
 #endif
+#if SPI_USE_TRANSACTIONS == TRUE
+  void spiStartTransactionI(SPIDriver *spip,
+                            const spi_segment_t *segp, size_t n);
+  void spiStartTransaction(SPIDriver *spip,
+                           const spi_segment_t *segp, size_t n);
+  bool _spi_isr_next_segment(SPIDriver *spip);
+#if SPI_USE_WAIT == TRUE
+  void spiTransaction(SPIDriver *spip, const spi_segment_t *segp, size_t n);
+#endif
+#endif
+#if SPI_USE_QUEUE == TRUE
+  void spiQueueRequestI(SPIDriver *spip, spi_request_t *reqp);
+  void spiQueueRequest(SPIDriver *spip, spi_request_t *reqp);
+#if SPI_USE_WAIT == TRUE
+  void spiRequest(SPIDriver *spip, spi_request_t *reqp);
+#endif
+#endif
 #if SPI_USE_MUTUAL_EXCLUSION == TRUE
   void spiAcquireBus(SPIDriver *spip);
   void spiReleaseBus(SPIDriver *spip);
@@ -35,10 +35,46 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    TRNG configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the entropy pool.
+ * @details If enabled then the low level driver keeps a pool of random
+ *          bytes refilled in background, @p trngGenerate() is served from
+ *          the pool and the non-blocking @p trngTryGenerate() is available.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(TRNG_USE_POOL) || defined(__DOXYGEN__)
+#define TRNG_USE_POOL                       FALSE
+#endif
+
+/**
+ * @brief   Entropy pool size in bytes.
+ * @note    Must be a multiple of 4 and not smaller than 16.
+ */
+#if !defined(TRNG_POOL_SIZE) || defined(__DOXYGEN__)
+#define TRNG_POOL_SIZE                      256
+#endif
+
+/**
+ * @brief   Maximum time in milliseconds @p trngGenerate() waits for the
+ *          pool to be refilled before failing.
+ */
+#if !defined(TRNG_POOL_TIMEOUT) || defined(__DOXYGEN__)
+#define TRNG_POOL_TIMEOUT                   100
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (TRNG_POOL_SIZE < 16) || ((TRNG_POOL_SIZE % 4) != 0)
+#error "invalid TRNG_POOL_SIZE value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -68,6 +104,10 @@ typedef struct hal_trng_config TRNGConfig;
    for completing types.*/
 #include "hal_trng_lld.h"
 
+#if (TRNG_USE_POOL == TRUE) && !defined(TRNG_LLD_SUPPORTS_POOL)
+#error "TRNG entropy pool not supported by the low level driver"
+#endif
+
 /**
  * @brief   Driver configuration structure.
  */
@@ -88,6 +128,16 @@ struct hal_trng_driver {
    * @brief Current configuration data.
    */
   const TRNGConfig           *config;
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief Entropy pool, filled by the low level driver.
+   */
+  input_queue_t              pool;
+  /**
+   * @brief Entropy pool buffer.
+   */
+  uint8_t                    pool_buf[TRNG_POOL_SIZE];
+#endif
 #if defined(TRNG_DRIVER_EXT_FIELDS)
   TRNG_DRIVER_EXT_FIELDS
 #endif
@@ -99,6 +149,35 @@ struct hal_trng_driver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Free space in the entropy pool.
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only.
+ *
+ * @param[in] trngp     pointer to the @p TRNGDriver object
+ * @return              The number of bytes that can be added to the pool.
+ *
+ * @iclass
+ */
+#define _trng_pool_space_i(trngp) iqGetEmptyI(&(trngp)->pool)
+
+/**
+ * @brief   Adds a random word to the entropy pool.
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only, the pool must have space for the word.
+ *
+ * @param[in] trngp     pointer to the @p TRNGDriver object
+ * @param[in] r         random word
+ *
+ * @iclass
+ */
+#define _trng_pool_put_i(trngp, r) {                                        \
+  uint32_t _w = (r);                                                        \
+  (void) iqWriteI(&(trngp)->pool, (const uint8_t *)&_w, sizeof (uint32_t)); \
+}
+#endif /* TRNG_USE_POOL == TRUE */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -111,6 +190,9 @@ extern "C" {
   void trngStart(TRNGDriver *trngp, const TRNGConfig *config);
   void trngStop(TRNGDriver *trngp);
   bool trngGenerate(TRNGDriver *trngp, size_t size, uint8_t *out);
+#if TRNG_USE_POOL == TRUE
+  bool trngTryGenerate(TRNGDriver *trngp, size_t size, uint8_t *out);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -73,6 +73,14 @@
 #if !defined(UART_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
 #define UART_USE_MUTUAL_EXCLUSION           FALSE
 #endif
+
+/**
+ * @brief   Enables the ring receive mode APIs.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(UART_USE_RING) || defined(__DOXYGEN__)
+#define UART_USE_RING                       FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -112,6 +120,10 @@ typedef enum {
 
 #include "hal_uart_lld.h"
 
+#if (UART_USE_RING == TRUE) && !defined(UART_LLD_SUPPORTS_RING)
+#error "UART ring mode not supported by the low level driver"
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -381,6 +393,44 @@ typedef enum {
   _uart_wakeup_rx_cm_isr(uartp);                                            \
 }
 
+#if (UART_USE_RING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Common ISR code for RX ring half filled.
+ * @details This code handles the portable part of the ISR code:
+ *          - Callback invocation.
+ *          .
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @notapi
+ */
+#define _uart_rx_half_isr_code(uartp) {                                     \
+  if ((uartp)->config->rxhalf_cb != NULL) {                                 \
+    (uartp)->config->rxhalf_cb(uartp);                                      \
+  }                                                                         \
+}
+
+/**
+ * @brief   Common ISR code for RX ring end reached.
+ * @details This code handles the portable part of the ISR code:
+ *          - Callback invocation.
+ *          .
+ * @note    This macro is meant to be used in the low level drivers
+ *          implementation only, the receiver stays active.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @notapi
+ */
+#define _uart_rx_ring_end_isr_code(uartp) {                                 \
+  if ((uartp)->config->rxend_cb != NULL) {                                  \
+    (uartp)->config->rxend_cb(uartp);                                       \
+  }                                                                         \
+}
+#endif /* UART_USE_RING == TRUE */
+
 /** @} */
 
 /*===========================================================================*/
@@ -402,6 +452,12 @@ extern "C" {
   void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf);
   size_t uartStopReceive(UARTDriver *uartp);
   size_t uartStopReceiveI(UARTDriver *uartp);
+#if UART_USE_RING == TRUE
+  void uartStartRingReceive(UARTDriver *uartp, size_t n, uint8_t *rxbuf);
+  void uartStartRingReceiveI(UARTDriver *uartp, size_t n, uint8_t *rxbuf);
+  size_t uartRingGetSpanX(UARTDriver *uartp, const uint8_t **bpp);
+  void uartRingReleaseX(UARTDriver *uartp, size_t n);
+#endif
 #if UART_USE_WAIT == TRUE
   msg_t uartSendTimeout(UARTDriver *uartp, size_t *np,
                         const void *txbuf, sysinterval_t timeout);
@@ -52,6 +52,32 @@
 #define CDC_GET_RINGER_PARMS                0x31U
 #define CDC_SET_OPERATION_PARMS             0x32U
 #define CDC_GET_OPERATION_PARMS             0x33U
+#define CDC_SET_ETHERNET_MULTICAST_FILTERS  0x40U
+#define CDC_SET_ETHERNET_PM_PATTERN_FILTER  0x41U
+#define CDC_GET_ETHERNET_PM_PATTERN_FILTER  0x42U
+#define CDC_SET_ETHERNET_PACKET_FILTER      0x43U
+#define CDC_GET_ETHERNET_STATISTIC          0x44U
+#define CDC_GET_NTB_PARAMETERS              0x80U
+#define CDC_GET_NET_ADDRESS                 0x81U
+#define CDC_SET_NET_ADDRESS                 0x82U
+#define CDC_GET_NTB_FORMAT                  0x83U
+#define CDC_SET_NTB_FORMAT                  0x84U
+#define CDC_GET_NTB_INPUT_SIZE              0x85U
+#define CDC_SET_NTB_INPUT_SIZE              0x86U
+#define CDC_GET_MAX_DATAGRAM_SIZE           0x87U
+#define CDC_SET_MAX_DATAGRAM_SIZE           0x88U
+#define CDC_GET_CRC_MODE                    0x89U
+#define CDC_SET_CRC_MODE                    0x8AU
+/** @} */
+
+/**
+ * @name    CDC notifications
+ * @{
+ */
+#define CDC_NETWORK_CONNECTION              0x00U
+#define CDC_RESPONSE_AVAILABLE              0x01U
+#define CDC_SERIAL_STATE                    0x20U
+#define CDC_CONNECTION_SPEED_CHANGE         0x2AU
 /** @} */
 
 /**
@@ -67,6 +93,15 @@
  * @{
  */
 #define CDC_ABSTRACT_CONTROL_MODEL          0x02U
+#define CDC_ETHERNET_NETWORKING_CONTROL_MODEL 0x06U
+#define CDC_NETWORK_CONTROL_MODEL           0x0DU
+/** @} */
+
+/**
+ * @name    CDC protocols
+ * @{
+ */
+#define CDC_NCM_DATA_PROTOCOL               0x01U
 /** @} */
 
 /**
@@ -84,6 +119,8 @@
 #define CDC_CALL_MANAGEMENT                 0x01U
 #define CDC_ABSTRACT_CONTROL_MANAGEMENT     0x02U
 #define CDC_UNION                           0x06U
+#define CDC_ETHERNET_NETWORKING             0x0FU
+#define CDC_NCM                             0x1AU
 /** @} */
 
 /**
@@ -133,6 +133,10 @@ typedef struct {
 #error "low level does not define WSPI_DEFAULT_CFG_MASKS"
 #endif
 
+#if !defined(WSPI_SUPPORTS_MEMMAP_WRITE)
+#error "low level does not define WSPI_SUPPORTS_MEMMAP_WRITE"
+#endif
+
 /**
  * @brief   Driver configuration structure.
  */
@@ -347,6 +351,27 @@ struct hal_wspi_driver {
 #define wspiUnmapFlashI(wspip)                                              \
   wspi_lld_unmap_flash(wspip)
 #endif /* WSPI_SUPPORTS_MEMMAP == TRUE */
+
+#if (WSPI_SUPPORTS_MEMMAP_WRITE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Maps in memory space a WSPI RAM device.
+ * @details The memory is readable and writable, the read and write
+ *          accesses are performed using the specified commands.
+ * @pre     The memory device must be initialized appropriately before
+ *          mapping it in memory space.
+ * @note    The device is unmapped using @p wspiUnmapFlashI().
+ *
+ * @param[in] wspip     pointer to the @p WSPIDriver object
+ * @param[in] rcmdp     pointer to the read command descriptor
+ * @param[in] wcmdp     pointer to the write command descriptor
+ * @param[out] addrp    pointer to the memory start address of the mapped
+ *                      memory or @p NULL
+ *
+ * @iclass
+ */
+#define wspiMapMemoryI(wspip, rcmdp, wcmdp, addrp)                          \
+  wspi_lld_map_memory(wspip, rcmdp, wcmdp, addrp)
+#endif /* WSPI_SUPPORTS_MEMMAP_WRITE == TRUE */
 /** @} */
 
 /**
@@ -453,6 +478,12 @@ void wspiMapFlash(WSPIDriver *wspip,
                   uint8_t **addrp);
 void wspiUnmapFlash(WSPIDriver *wspip);
 #endif
+#if WSPI_SUPPORTS_MEMMAP_WRITE == TRUE
+  void wspiMapMemory(WSPIDriver *wspip,
+                     const wspi_command_t *rcmdp,
+                     const wspi_command_t *wcmdp,
+                     uint8_t **addrp);
+#endif
 #if WSPI_USE_MUTUAL_EXCLUSION == TRUE
   void wspiAcquireBus(WSPIDriver *wspip);
   void wspiReleaseBus(WSPIDriver *wspip);
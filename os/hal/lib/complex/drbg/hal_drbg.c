@@ -0,0 +1,348 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_drbg.c
+ * @brief   CTR-DRBG module code.
+ * @details This module implements the AES-256 CTR_DRBG of NIST SP 800-90A
+ *          without derivation function. The entropy input is taken from a
+ *          TRNG driver, the AES operations are performed by a crypto driver
+ *          so the bulk output is produced by the AES engine when present.
+ * @note    The module is not thread safe, concurrent access to an instance
+ *          must be serialized by the application.
+ *
+ * @addtogroup HAL_DRBG
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#include "hal_drbg.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Increments the 128 bits counter block.
+ *
+ * @param[in,out] v     counter block
+ */
+static void drbg_increment(uint8_t *v) {
+  unsigned i = DRBG_BLOCK_SIZE;
+
+  do {
+    i--;
+    v[i]++;
+  } while ((v[i] == 0U) && (i > 0U));
+}
+
+/**
+ * @brief   Updates the working state.
+ * @details This is the SP 800-90A CTR_DRBG_Update function.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ * @param[in] data      @p DRBG_SEED_SIZE bytes of provided data or @p NULL
+ *                      for all zeros data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static drbg_error_t drbg_update(DRBGDriver *drbgp, const uint8_t *data) {
+  CRYDriver *cryp = drbgp->config->cryp;
+  uint8_t ctr[DRBG_SEED_SIZE], temp[DRBG_SEED_SIZE];
+  drbg_error_t err = DRBG_NO_ERROR;
+  unsigned i;
+
+  /* The three counter blocks are encrypted with a single operation.*/
+  for (i = 0U; i < DRBG_SEED_SIZE; i += DRBG_BLOCK_SIZE) {
+    drbg_increment(drbgp->v);
+    memcpy(&ctr[i], drbgp->v, DRBG_BLOCK_SIZE);
+  }
+
+  if ((cryLoadAESTransientKey(cryp, DRBG_KEY_SIZE,
+                              drbgp->key) != CRY_NOERROR) ||
+      (cryEncryptAES_ECB(cryp, (crykey_t)0, DRBG_SEED_SIZE,
+                         ctr, temp) != CRY_NOERROR)) {
+    err = DRBG_ERR_CRYPTO;
+  }
+  else {
+    if (data != NULL) {
+      for (i = 0U; i < DRBG_SEED_SIZE; i++) {
+        temp[i] ^= data[i];
+      }
+    }
+    memcpy(drbgp->key, &temp[0], DRBG_KEY_SIZE);
+    memcpy(drbgp->v, &temp[DRBG_KEY_SIZE], DRBG_BLOCK_SIZE);
+  }
+
+  /* Not leaving state information on the stack.*/
+  memset(temp, 0, sizeof temp);
+
+  return err;
+}
+
+/**
+ * @brief   Reseeds the working state.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ * @param[in] size      size of the additional input
+ * @param[in] in        additional input or @p NULL
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static drbg_error_t drbg_reseed(DRBGDriver *drbgp,
+                                size_t size,
+                                const uint8_t *in) {
+  uint8_t seed[DRBG_SEED_SIZE];
+  drbg_error_t err;
+  size_t i;
+
+  if (trngGenerate(drbgp->config->trngp, sizeof seed, seed)) {
+    err = DRBG_ERR_ENTROPY;
+  }
+  else {
+    for (i = 0U; i < size; i++) {
+      seed[i] ^= in[i];
+    }
+    err = drbg_update(drbgp, seed);
+    if (err == DRBG_NO_ERROR) {
+      drbgp->reseed_counter = 1U;
+    }
+  }
+
+  memset(seed, 0, sizeof seed);
+
+  return err;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] drbgp    pointer to the @p DRBGDriver object
+ *
+ * @init
+ */
+void drbgObjectInit(DRBGDriver *drbgp) {
+
+  osalDbgCheck(drbgp != NULL);
+
+  drbgp->state          = DRBG_STOP;
+  drbgp->config         = NULL;
+  drbgp->reseed_counter = 0U;
+}
+
+/**
+ * @brief   Configures and instantiates a DRBG.
+ * @details The working state is seeded from the TRNG driver, the TRNG and
+ *          crypto drivers must have been started.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ * @param[in] config    pointer to the configuration
+ * @return              The operation status.
+ * @retval DRBG_NO_ERROR        if the operation succeeded.
+ * @retval DRBG_ERR_INV_SIZE    if the personalization string is too long.
+ * @retval DRBG_ERR_ENTROPY     if the entropy source failed.
+ * @retval DRBG_ERR_CRYPTO      if an AES operation failed.
+ *
+ * @api
+ */
+drbg_error_t drbgStart(DRBGDriver *drbgp, const DRBGConfig *config) {
+  drbg_error_t err;
+
+  osalDbgCheck((drbgp != NULL) && (config != NULL) &&
+               ((config->pers != NULL) || (config->pers_size == 0U)));
+
+  osalDbgAssert((drbgp->state == DRBG_STOP) || (drbgp->state == DRBG_READY),
+                "invalid state");
+
+  if (config->pers_size > DRBG_SEED_SIZE) {
+    return DRBG_ERR_INV_SIZE;
+  }
+
+  drbgp->config = config;
+  memset(drbgp->key, 0, sizeof drbgp->key);
+  memset(drbgp->v, 0, sizeof drbgp->v);
+
+  err = drbg_reseed(drbgp, config->pers_size, config->pers);
+  if (err != DRBG_NO_ERROR) {
+    drbgStop(drbgp);
+    return err;
+  }
+
+  drbgp->state = DRBG_READY;
+
+  return DRBG_NO_ERROR;
+}
+
+/**
+ * @brief   Uninstantiates a DRBG.
+ * @details The working state is erased.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ *
+ * @api
+ */
+void drbgStop(DRBGDriver *drbgp) {
+
+  osalDbgCheck(drbgp != NULL);
+
+  memset(drbgp->key, 0, sizeof drbgp->key);
+  memset(drbgp->v, 0, sizeof drbgp->v);
+  drbgp->reseed_counter = 0U;
+  drbgp->config         = NULL;
+  drbgp->state          = DRBG_STOP;
+}
+
+/**
+ * @brief   Reseeds a DRBG.
+ * @note    Reseeding is also performed automatically every
+ *          @p DRBG_CFG_RESEED_INTERVAL generate requests.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ * @param[in] size      size of the additional input, up to
+ *                      @p DRBG_SEED_SIZE bytes
+ * @param[in] in        additional input or @p NULL
+ * @return              The operation status.
+ * @retval DRBG_NO_ERROR        if the operation succeeded.
+ * @retval DRBG_ERR_INV_SIZE    if the additional input is too long.
+ * @retval DRBG_ERR_ENTROPY     if the entropy source failed.
+ * @retval DRBG_ERR_CRYPTO      if an AES operation failed.
+ *
+ * @api
+ */
+drbg_error_t drbgReseed(DRBGDriver *drbgp, size_t size, const uint8_t *in) {
+
+  osalDbgCheck((drbgp != NULL) && ((in != NULL) || (size == 0U)));
+
+  osalDbgAssert(drbgp->state == DRBG_READY, "invalid state");
+
+  if (size > DRBG_SEED_SIZE) {
+    return DRBG_ERR_INV_SIZE;
+  }
+
+  return drbg_reseed(drbgp, size, in);
+}
+
+/**
+ * @brief   Generates pseudo random bytes.
+ * @details The output blocks are the encryption of successive values of
+ *          the counter block, this is performed as a single AES-CTR
+ *          operation on the output buffer so that the AES engine, if
+ *          present, processes the whole request using DMA.
+ *
+ * @param[in] drbgp     pointer to the @p DRBGDriver object
+ * @param[in] size      number of bytes to be generated, up to
+ *                      @p DRBG_MAX_REQUEST_SIZE
+ * @param[out] out      output buffer
+ * @return              The operation status.
+ * @retval DRBG_NO_ERROR        if the operation succeeded.
+ * @retval DRBG_ERR_INV_SIZE    if the request is too large.
+ * @retval DRBG_ERR_ENTROPY     if an automatic reseed failed.
+ * @retval DRBG_ERR_CRYPTO      if an AES operation failed.
+ *
+ * @api
+ */
+drbg_error_t drbgGenerate(DRBGDriver *drbgp, size_t size, uint8_t *out) {
+  CRYDriver *cryp;
+  drbg_error_t err;
+
+  osalDbgCheck((drbgp != NULL) && (out != NULL));
+
+  osalDbgAssert(drbgp->state == DRBG_READY, "invalid state");
+
+  if (size > DRBG_MAX_REQUEST_SIZE) {
+    return DRBG_ERR_INV_SIZE;
+  }
+
+  if (drbgp->reseed_counter > (uint32_t)DRBG_CFG_RESEED_INTERVAL) {
+    err = drbg_reseed(drbgp, (size_t)0, NULL);
+    if (err != DRBG_NO_ERROR) {
+      return err;
+    }
+  }
+
+  cryp = drbgp->config->cryp;
+  if (cryLoadAESTransientKey(cryp, DRBG_KEY_SIZE,
+                             drbgp->key) != CRY_NOERROR) {
+    return DRBG_ERR_CRYPTO;
+  }
+
+  /* Encrypting a zeroed buffer in CTR mode starting from V+1.*/
+  memset(out, 0, size);
+  while (size > 0U) {
+    uint32_t low, nblocks;
+    size_t chunk;
+
+    drbg_increment(drbgp->v);
+    low = ((uint32_t)drbgp->v[12] << 24) | ((uint32_t)drbgp->v[13] << 16) |
+          ((uint32_t)drbgp->v[14] << 8)  | ((uint32_t)drbgp->v[15]);
+
+    /* Some AES engines only increment the low 32 bits of the counter
+       block, requests are split where those bits would wrap.*/
+    nblocks = (uint32_t)((size + DRBG_BLOCK_SIZE - 1U) / DRBG_BLOCK_SIZE);
+    if (low > 0xFFFFFFFFU - (nblocks - 1U)) {
+      nblocks = (0xFFFFFFFFU - low) + 1U;
+    }
+    chunk = (size_t)nblocks * DRBG_BLOCK_SIZE;
+    if (chunk > size) {
+      chunk = size;
+    }
+
+    if (cryEncryptAES_CTR(cryp, (crykey_t)0, chunk, out, out,
+                          drbgp->v) != CRY_NOERROR) {
+      return DRBG_ERR_CRYPTO;
+    }
+
+    /* V becomes the last counter value used.*/
+    low += nblocks - 1U;
+    drbgp->v[12] = (uint8_t)(low >> 24);
+    drbgp->v[13] = (uint8_t)(low >> 16);
+    drbgp->v[14] = (uint8_t)(low >> 8);
+    drbgp->v[15] = (uint8_t)low;
+
+    out  += chunk;
+    size -= chunk;
+  }
+
+  err = drbg_update(drbgp, NULL);
+  if (err == DRBG_NO_ERROR) {
+    drbgp->reseed_counter++;
+  }
+
+  return err;
+}
+
+/** @} */
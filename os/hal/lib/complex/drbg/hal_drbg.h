@@ -0,0 +1,186 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_drbg.h
+ * @brief   CTR-DRBG module header.
+ *
+ * @addtogroup HAL_DRBG
+ * @{
+ */
+
+#ifndef HAL_DRBG_H
+#define HAL_DRBG_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   AES-256 key size.
+ */
+#define DRBG_KEY_SIZE                       32U
+
+/**
+ * @brief   AES block size.
+ */
+#define DRBG_BLOCK_SIZE                     16U
+
+/**
+ * @brief   Seed size, key plus block.
+ */
+#define DRBG_SEED_SIZE                      (DRBG_KEY_SIZE + DRBG_BLOCK_SIZE)
+
+/**
+ * @brief   Maximum number of bytes for a single generate request.
+ * @note    This is the SP 800-90A limit of 2^19 bits.
+ */
+#define DRBG_MAX_REQUEST_SIZE               65536U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Number of generate requests between automatic reseeds.
+ */
+#if !defined(DRBG_CFG_RESEED_INTERVAL) || defined(__DOXYGEN__)
+#define DRBG_CFG_RESEED_INTERVAL            1024
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_TRNG != TRUE
+#error "DRBG requires HAL_USE_TRNG"
+#endif
+
+#if HAL_USE_CRY != TRUE
+#error "DRBG requires HAL_USE_CRY"
+#endif
+
+#if DRBG_CFG_RESEED_INTERVAL < 1
+#error "invalid DRBG_CFG_RESEED_INTERVAL value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  DRBG_UNINIT = 0,
+  DRBG_STOP = 1,
+  DRBG_READY = 2
+} drbg_state_t;
+
+/**
+ * @brief   Type of a DRBG error code.
+ */
+typedef enum {
+  DRBG_NO_ERROR = 0,
+  DRBG_ERR_INV_SIZE = -1,
+  DRBG_ERR_ENTROPY = -2,
+  DRBG_ERR_CRYPTO = -3
+} drbg_error_t;
+
+/**
+ * @brief   Type of a DRBG configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   TRNG driver used as entropy source.
+   */
+  TRNGDriver                *trngp;
+  /**
+   * @brief   Crypto driver used for AES operations.
+   * @note    The AES transient key of the driver is overwritten by the
+   *          DRBG operations.
+   */
+  CRYDriver                 *cryp;
+  /**
+   * @brief   Personalization string or @p NULL.
+   */
+  const uint8_t             *pers;
+  /**
+   * @brief   Personalization string size, up to @p DRBG_SEED_SIZE bytes.
+   */
+  size_t                    pers_size;
+} DRBGConfig;
+
+/**
+ * @brief   Type of a DRBG instance.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  drbg_state_t              state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const DRBGConfig          *config;
+  /**
+   * @brief   Working state key.
+   */
+  uint8_t                   key[DRBG_KEY_SIZE];
+  /**
+   * @brief   Working state counter block.
+   */
+  uint8_t                   v[DRBG_BLOCK_SIZE];
+  /**
+   * @brief   Generate requests since the last reseed.
+   */
+  uint32_t                  reseed_counter;
+} DRBGDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void drbgObjectInit(DRBGDriver *drbgp);
+  drbg_error_t drbgStart(DRBGDriver *drbgp, const DRBGConfig *config);
+  void drbgStop(DRBGDriver *drbgp);
+  drbg_error_t drbgReseed(DRBGDriver *drbgp, size_t size, const uint8_t *in);
+  drbg_error_t drbgGenerate(DRBGDriver *drbgp, size_t size, uint8_t *out);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_DRBG_H */
+
+/** @} */
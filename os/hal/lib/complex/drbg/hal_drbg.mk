@@ -0,0 +1,9 @@
+# List of all the DRBG subsystem files.
+DRBGSRC := $(CHIBIOS)/os/hal/lib/complex/drbg/hal_drbg.c
+
+# Required include directories
+DRBGINC := $(CHIBIOS)/os/hal/lib/complex/drbg
+
+# Shared variables
+ALLCSRC += $(DRBGSRC)
+ALLINC  += $(DRBGINC)
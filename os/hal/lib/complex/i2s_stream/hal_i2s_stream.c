@@ -0,0 +1,449 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_i2s_stream.c
+ * @brief   I2S audio streaming code.
+ * @details This module connects the circular buffers of an I2S driver to
+ *          a pair of buffers queues. On each half buffer event a period
+ *          of audio is moved between the circular buffers and the queues,
+ *          the application produces and consumes audio through the
+ *          buffers queues API from its own threads.
+ *          Drift between the I2S clock and the clock of the other end of
+ *          the stream, for example an USB audio interface, is compensated
+ *          by dropping or repeating single frames when the average queue
+ *          level moves away from a target level.
+ *
+ * @addtogroup HAL_I2S_STREAM
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#include "hal_i2s_stream.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Queue level hysteresis in 1/256 buffer units.
+ */
+#define I2SS_LEVEL_HYSTERESIS               128U
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Updates a queue level average and evaluates a correction.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[in,out] avgp  pointer to the filtered level
+ * @param[in] level     current queue level in buffers
+ * @param[in] target    target level in buffers, zero if disabled
+ * @return              The correction to be applied.
+ * @retval 0            no correction.
+ * @retval 1            the queue is too full, a frame must be dropped.
+ * @retval -1           the queue is too empty, a frame must be repeated.
+ *
+ * @notapi
+ */
+static int i2ss_drift(I2SStreamDriver *sp, uint32_t *avgp,
+                      size_t level, size_t target) {
+  uint32_t t;
+
+  /* First order filter with 1/16 coefficient.*/
+  *avgp = *avgp - (*avgp >> 4) + (((uint32_t)level << 8) >> 4);
+
+  if ((target == 0U) || (sp->holdoff > 0U)) {
+    return 0;
+  }
+
+  t = (uint32_t)target << 8;
+  if (*avgp > t + I2SS_LEVEL_HYSTERESIS) {
+    return 1;
+  }
+  if (*avgp + I2SS_LEVEL_HYSTERESIS < t) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief   Copies data out of the TX queue.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[out] dp       destination buffer or @p NULL for skipping data
+ * @param[in] n         number of bytes to be copied
+ * @return              The number of bytes copied.
+ *
+ * @notapi
+ */
+static size_t i2ss_tx_copy(I2SStreamDriver *sp, uint8_t *dp, size_t n) {
+  size_t done = 0U;
+
+  while (done < n) {
+    size_t chunk;
+
+    if (sp->txptr == NULL) {
+      sp->txptr = obqGetFullBufferI(&sp->obq, &sp->txleft);
+      if (sp->txptr == NULL) {
+        break;
+      }
+    }
+
+    chunk = n - done;
+    if (chunk > sp->txleft) {
+      chunk = sp->txleft;
+    }
+    if (dp != NULL) {
+      memcpy(dp + done, sp->txptr, chunk);
+    }
+    sp->txptr  += chunk;
+    sp->txleft -= chunk;
+    done       += chunk;
+
+    if (sp->txleft == 0U) {
+      sp->txptr = NULL;
+      obqReleaseEmptyBufferI(&sp->obq);
+    }
+  }
+
+  return done;
+}
+
+/**
+ * @brief   Fills a TX period.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[out] dp       pointer to the period in the circular buffer
+ *
+ * @notapi
+ */
+static void i2ss_tx_period(I2SStreamDriver *sp, uint8_t *dp) {
+  size_t fsize = sp->config->frame_size;
+  size_t n, done, level;
+  int slip;
+
+  level = bqSizeX(&sp->obq) - bqSpaceI(&sp->obq);
+  slip  = i2ss_drift(sp, &sp->txavg, level, sp->config->tx_target);
+
+  n = sp->period;
+  if (slip < 0) {
+    n -= fsize;
+  }
+
+  done = i2ss_tx_copy(sp, dp, n);
+  if (done < n) {
+    /* Not enough data, the rest of the period is silence.*/
+    memset(dp + done, 0, sp->period - done);
+    sp->stats.underruns++;
+    return;
+  }
+
+  if (slip > 0) {
+    /* Dropping a frame.*/
+    (void)i2ss_tx_copy(sp, NULL, fsize);
+    sp->stats.slips++;
+    sp->holdoff = I2SS_CFG_SLIP_PERIODS;
+  }
+  else if (slip < 0) {
+    /* Repeating the last frame.*/
+    memcpy(dp + n, dp + n - fsize, fsize);
+    sp->stats.slips++;
+    sp->holdoff = I2SS_CFG_SLIP_PERIODS;
+  }
+  else {
+    /* No correction.*/
+  }
+}
+
+/**
+ * @brief   Drains an RX period.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[in] p         pointer to the period in the circular buffer
+ *
+ * @notapi
+ */
+static void i2ss_rx_period(I2SStreamDriver *sp, const uint8_t *p) {
+  size_t fsize = sp->config->frame_size;
+  size_t n;
+  uint8_t *bp;
+  int slip;
+
+  slip = i2ss_drift(sp, &sp->rxavg, bqSpaceI(&sp->ibq),
+                    sp->config->rx_target);
+
+  bp = ibqGetEmptyBufferI(&sp->ibq);
+  if (bp == NULL) {
+    sp->stats.overruns++;
+    return;
+  }
+
+  n = sp->period;
+  memcpy(bp, p, n);
+  if (slip > 0) {
+    /* Dropping the last frame.*/
+    n -= fsize;
+    sp->stats.slips++;
+    sp->holdoff = I2SS_CFG_SLIP_PERIODS;
+  }
+  else if (slip < 0) {
+    /* Repeating the last frame, buffers have room for an extra frame.*/
+    memcpy(bp + n, p + n - fsize, fsize);
+    n += fsize;
+    sp->stats.slips++;
+    sp->holdoff = I2SS_CFG_SLIP_PERIODS;
+  }
+  else {
+    /* No correction.*/
+  }
+  ibqPostFullBufferI(&sp->ibq, n);
+}
+
+/**
+ * @brief   I2S half buffer callback.
+ *
+ * @param[in] i2sp      pointer to the @p I2SDriver object
+ *
+ * @notapi
+ */
+static void i2ss_cb(I2SDriver *i2sp) {
+  I2SStreamDriver *sp;
+  size_t offset;
+
+  /* The stream owns the I2S configuration.*/
+  sp = (I2SStreamDriver *)((const uint8_t *)i2sp->config -
+                           offsetof(I2SStreamDriver, i2scfg));
+
+  offset = i2sIsBufferComplete(i2sp) ? sp->period : 0U;
+
+  osalSysLockFromISR();
+  if (sp->state == I2SS_ACTIVE) {
+    if (sp->i2scfg.tx_buffer != NULL) {
+      i2ss_tx_period(sp, (uint8_t *)sp->i2scfg.tx_buffer + offset);
+    }
+    if (sp->i2scfg.rx_buffer != NULL) {
+      i2ss_rx_period(sp, (const uint8_t *)sp->i2scfg.rx_buffer + offset);
+    }
+    if (sp->holdoff > 0U) {
+      sp->holdoff--;
+    }
+    sp->stats.periods++;
+  }
+  osalSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a stream instance.
+ *
+ * @param[out] sp       pointer to the @p I2SStreamDriver object
+ *
+ * @init
+ */
+void i2ssObjectInit(I2SStreamDriver *sp) {
+
+  osalDbgCheck(sp != NULL);
+
+  sp->state  = I2SS_STOP;
+  sp->config = NULL;
+  memset(&sp->stats, 0, sizeof sp->stats);
+}
+
+/**
+ * @brief   Configures and activates a stream.
+ * @details The buffers queues are initialized and the I2S driver is
+ *          started, the data exchange is started separately using
+ *          @p i2ssStartStream().
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void i2ssStart(I2SStreamDriver *sp, const I2SStreamConfig *config) {
+  const I2SConfig *i2scfg;
+  size_t period;
+
+  osalDbgCheck((sp != NULL) && (config != NULL) &&
+               (config->i2sp != NULL) && (config->i2scfg != NULL) &&
+               (config->sample_size > 0U) && (config->frame_size > 0U));
+
+  i2scfg = config->i2scfg;
+  period = (i2scfg->size * config->sample_size) / 2U;
+
+  osalDbgCheck(((i2scfg->tx_buffer == NULL) || (config->txqbuf != NULL)) &&
+               ((i2scfg->rx_buffer == NULL) || (config->rxqbuf != NULL)) &&
+               ((period % config->frame_size) == 0U) &&
+               (period >= config->frame_size * 2U));
+
+  osalDbgAssert((sp->state == I2SS_STOP) || (sp->state == I2SS_READY),
+                "invalid state");
+
+  sp->config        = config;
+  sp->period        = period;
+  sp->i2scfg        = *i2scfg;
+  sp->i2scfg.end_cb = i2ss_cb;
+
+  if (i2scfg->tx_buffer != NULL) {
+    obqObjectInit(&sp->obq, false, config->txqbuf,
+                  period + config->frame_size, config->txqn, NULL, sp);
+  }
+  if (i2scfg->rx_buffer != NULL) {
+    ibqObjectInit(&sp->ibq, false, config->rxqbuf,
+                  period + config->frame_size, config->rxqn, NULL, sp);
+  }
+
+  i2sStart(config->i2sp, &sp->i2scfg);
+
+  sp->state = I2SS_READY;
+}
+
+/**
+ * @brief   Deactivates a stream.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ *
+ * @api
+ */
+void i2ssStop(I2SStreamDriver *sp) {
+
+  osalDbgCheck(sp != NULL);
+
+  osalDbgAssert((sp->state == I2SS_STOP) || (sp->state == I2SS_READY),
+                "invalid state");
+
+  if (sp->state == I2SS_READY) {
+    i2sStop(sp->config->i2sp);
+  }
+
+  sp->config = NULL;
+  sp->state  = I2SS_STOP;
+}
+
+/**
+ * @brief   Starts the audio exchange.
+ * @details The circular buffers are cleared and the I2S exchange is
+ *          started, the TX queue should already contain @p tx_target
+ *          buffers in order to avoid initial underruns.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ *
+ * @api
+ */
+void i2ssStartStream(I2SStreamDriver *sp) {
+
+  osalDbgCheck(sp != NULL);
+
+  osalDbgAssert(sp->state == I2SS_READY, "invalid state");
+
+  if (sp->i2scfg.tx_buffer != NULL) {
+    memset((void *)sp->i2scfg.tx_buffer, 0, sp->period * 2U);
+  }
+
+  osalSysLock();
+  sp->txptr   = NULL;
+  sp->txleft  = 0U;
+  sp->txavg   = (uint32_t)sp->config->tx_target << 8;
+  sp->rxavg   = (uint32_t)sp->config->rx_target << 8;
+  sp->holdoff = I2SS_CFG_SLIP_PERIODS;
+  memset(&sp->stats, 0, sizeof sp->stats);
+  sp->state   = I2SS_ACTIVE;
+  osalSysUnlock();
+
+  i2sStartExchange(sp->config->i2sp);
+}
+
+/**
+ * @brief   Stops the audio exchange.
+ * @details The buffers queues are reset, threads waiting on them are
+ *          resumed with @p MSG_RESET.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ *
+ * @api
+ */
+void i2ssStopStream(I2SStreamDriver *sp) {
+
+  osalDbgCheck(sp != NULL);
+
+  osalDbgAssert((sp->state == I2SS_READY) || (sp->state == I2SS_ACTIVE),
+                "invalid state");
+
+  i2sStopExchange(sp->config->i2sp);
+
+  osalSysLock();
+  sp->state = I2SS_READY;
+  if (sp->i2scfg.tx_buffer != NULL) {
+    obqResetI(&sp->obq);
+  }
+  if (sp->i2scfg.rx_buffer != NULL) {
+    ibqResetI(&sp->ibq);
+  }
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Returns the stream statistics.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @param[out] statsp   pointer to the statistics to be filled
+ *
+ * @iclass
+ */
+void i2ssGetStatsI(I2SStreamDriver *sp, i2ss_stats_t *statsp) {
+  size_t frames;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sp != NULL) && (statsp != NULL));
+
+  osalDbgAssert((sp->state == I2SS_READY) || (sp->state == I2SS_ACTIVE),
+                "invalid state");
+
+  frames = sp->period / sp->config->frame_size;
+
+  *statsp = sp->stats;
+  statsp->tx_level = sp->txavg;
+  statsp->rx_level = sp->rxavg;
+  statsp->tx_latency = 0U;
+  statsp->rx_latency = 0U;
+  if (sp->i2scfg.tx_buffer != NULL) {
+    statsp->tx_latency = (uint32_t)(((bqSizeX(&sp->obq) -
+                                      bqSpaceI(&sp->obq)) + 1U) * frames);
+  }
+  if (sp->i2scfg.rx_buffer != NULL) {
+    statsp->rx_latency = (uint32_t)((bqSpaceI(&sp->ibq) + 1U) * frames);
+  }
+}
+
+/** @} */
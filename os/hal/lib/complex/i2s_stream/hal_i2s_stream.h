@@ -0,0 +1,292 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_i2s_stream.h
+ * @brief   I2S audio streaming header.
+ *
+ * @addtogroup HAL_I2S_STREAM
+ * @{
+ */
+
+#ifndef HAL_I2S_STREAM_H
+#define HAL_I2S_STREAM_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Minimum number of periods between drift corrections.
+ */
+#if !defined(I2SS_CFG_SLIP_PERIODS) || defined(__DOXYGEN__)
+#define I2SS_CFG_SLIP_PERIODS               16
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_I2S != TRUE
+#error "I2S streaming requires HAL_USE_I2S"
+#endif
+
+#if I2SS_CFG_SLIP_PERIODS < 1
+#error "invalid I2SS_CFG_SLIP_PERIODS value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  I2SS_UNINIT = 0,
+  I2SS_STOP = 1,
+  I2SS_READY = 2,
+  I2SS_ACTIVE = 3
+} i2ss_state_t;
+
+/**
+ * @brief   Type of an I2S stream configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   I2S driver to use.
+   */
+  I2SDriver                 *i2sp;
+  /**
+   * @brief   I2S driver configuration.
+   * @details The circular buffers and the low level settings are taken
+   *          from this configuration, each half of the circular buffers
+   *          is a streaming period. The callback is not used.
+   */
+  const I2SConfig           *i2scfg;
+  /**
+   * @brief   Size in bytes of an I2S sample as counted by the driver.
+   */
+  size_t                    sample_size;
+  /**
+   * @brief   Size in bytes of an audio frame, all channels.
+   */
+  size_t                    frame_size;
+  /**
+   * @brief   TX buffers queue memory or @p NULL.
+   * @note    It must be @p I2SS_QUEUE_SIZE() bytes large.
+   */
+  uint8_t                   *txqbuf;
+  /**
+   * @brief   Number of buffers in the TX queue.
+   */
+  size_t                    txqn;
+  /**
+   * @brief   RX buffers queue memory or @p NULL.
+   * @note    It must be @p I2SS_QUEUE_SIZE() bytes large.
+   */
+  uint8_t                   *rxqbuf;
+  /**
+   * @brief   Number of buffers in the RX queue.
+   */
+  size_t                    rxqn;
+  /**
+   * @brief   Target number of buffers in the TX queue.
+   * @details When the average TX queue level drifts away from the target
+   *          a frame is dropped or repeated, this compensates the drift
+   *          between the I2S clock and the clock of the data source.
+   *          Zero disables the compensation.
+   */
+  size_t                    tx_target;
+  /**
+   * @brief   Target number of buffers in the RX queue.
+   * @details When the average RX queue level drifts away from the target
+   *          a frame is dropped or repeated, this compensates the drift
+   *          between the I2S clock and the clock of the data sink.
+   *          Zero disables the compensation.
+   */
+  size_t                    rx_target;
+} I2SStreamConfig;
+
+/**
+ * @brief   Type of the stream statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Number of periods served.
+   */
+  uint32_t                  periods;
+  /**
+   * @brief   Number of TX periods not completely filled with data.
+   */
+  uint32_t                  underruns;
+  /**
+   * @brief   Number of RX periods dropped because the queue was full.
+   */
+  uint32_t                  overruns;
+  /**
+   * @brief   Number of frames dropped or repeated for drift compensation.
+   */
+  uint32_t                  slips;
+  /**
+   * @brief   Average TX queue level in 1/256 buffer units.
+   */
+  uint32_t                  tx_level;
+  /**
+   * @brief   Average RX queue level in 1/256 buffer units.
+   */
+  uint32_t                  rx_level;
+  /**
+   * @brief   Current TX latency in frames, queued data plus one period.
+   */
+  uint32_t                  tx_latency;
+  /**
+   * @brief   Current RX latency in frames, queued data plus one period.
+   */
+  uint32_t                  rx_latency;
+} i2ss_stats_t;
+
+/**
+ * @brief   Type of an I2S stream instance.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  i2ss_state_t              state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const I2SStreamConfig     *config;
+  /**
+   * @brief   I2S configuration derived from the stream configuration.
+   */
+  I2SConfig                 i2scfg;
+  /**
+   * @brief   Period size in bytes.
+   */
+  size_t                    period;
+  /**
+   * @brief   TX buffers queue, filled by the application.
+   */
+  output_buffers_queue_t    obq;
+  /**
+   * @brief   RX buffers queue, emptied by the application.
+   */
+  input_buffers_queue_t     ibq;
+  /**
+   * @brief   Current TX buffer read pointer or @p NULL.
+   */
+  const uint8_t             *txptr;
+  /**
+   * @brief   Bytes left in the current TX buffer.
+   */
+  size_t                    txleft;
+  /**
+   * @brief   Filtered TX queue level in 1/256 buffer units.
+   */
+  uint32_t                  txavg;
+  /**
+   * @brief   Filtered RX queue level in 1/256 buffer units.
+   */
+  uint32_t                  rxavg;
+  /**
+   * @brief   Periods before the next drift correction is allowed.
+   */
+  unsigned                  holdoff;
+  /**
+   * @brief   Statistics.
+   */
+  i2ss_stats_t              stats;
+} I2SStreamDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Computes the size of a stream buffers queue memory.
+ * @details Queue buffers are one frame larger than a period in order to
+ *          accommodate repeated frames.
+ *
+ * @param[in] n         number of buffers in the queue
+ * @param[in] period    period size in bytes
+ * @param[in] frame     frame size in bytes
+ */
+#define I2SS_QUEUE_SIZE(n, period, frame)                                   \
+  BQ_BUFFER_SIZE(n, (size_t)(period) + (size_t)(frame))
+
+/**
+ * @brief   Returns the TX buffers queue.
+ * @details The application writes audio data using the buffers queue API,
+ *          the borrow/return functions allow to produce data directly
+ *          into the queue buffers.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @return              Pointer to the output buffers queue.
+ *
+ * @xclass
+ */
+#define i2ssGetTxQueueX(sp) (&(sp)->obq)
+
+/**
+ * @brief   Returns the RX buffers queue.
+ * @details The application reads audio data using the buffers queue API,
+ *          the borrow/return functions allow to consume data directly
+ *          from the queue buffers.
+ *
+ * @param[in] sp        pointer to the @p I2SStreamDriver object
+ * @return              Pointer to the input buffers queue.
+ *
+ * @xclass
+ */
+#define i2ssGetRxQueueX(sp) (&(sp)->ibq)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2ssObjectInit(I2SStreamDriver *sp);
+  void i2ssStart(I2SStreamDriver *sp, const I2SStreamConfig *config);
+  void i2ssStop(I2SStreamDriver *sp);
+  void i2ssStartStream(I2SStreamDriver *sp);
+  void i2ssStopStream(I2SStreamDriver *sp);
+  void i2ssGetStatsI(I2SStreamDriver *sp, i2ss_stats_t *statsp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_I2S_STREAM_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the I2S streaming files.
+I2SSTREAMSRC := $(CHIBIOS)/os/hal/lib/complex/i2s_stream/hal_i2s_stream.c
+
+# Required include directories
+I2SSTREAMINC := $(CHIBIOS)/os/hal/lib/complex/i2s_stream
+
+# Shared variables
+ALLCSRC += $(I2SSTREAMSRC)
+ALLINC  += $(I2SSTREAMINC)
@@ -62,6 +62,55 @@
 #define ALIGNED_SIZEOF(t)                                                   \
   (((sizeof (t) - 1U) | MFS_ALIGN_MASK) + 1U)
 
+/**
+ * @brief   Identifier of checkpoint records.
+ */
+#define CHECKPOINT_ID       0U
+
+/**
+ * @brief   Data size of checkpoint records.
+ */
+#define CHECKPOINT_SIZE                                                     \
+  (sizeof (mfs_record_descriptor_t) * (size_t)MFS_CFG_MAX_RECORDS)
+
+/**
+ * @brief   Checks if a data header belongs to a checkpoint record.
+ */
+#define IS_CHECKPOINT(dhdr)                                                 \
+  ((MFS_CFG_USE_CHECKPOINTS == TRUE) &&                                     \
+   ((dhdr).fields.id == CHECKPOINT_ID) &&                                   \
+   ((dhdr).fields.size == CHECKPOINT_SIZE))
+
+/**
+ * @brief   Header identifier flag of compressed records.
+ */
+#define COMPRESSED_FLAG     0x8000U
+
+/**
+ * @brief   Record identifier from a data header.
+ */
+#if (MFS_CFG_USE_COMPRESSION == TRUE) || defined(__DOXYGEN__)
+#define RECORD_ID(dhdr)     ((uint32_t)(dhdr).fields.id & ~COMPRESSED_FLAG)
+#else
+#define RECORD_ID(dhdr)     ((uint32_t)(dhdr).fields.id)
+#endif
+
+/**
+ * @name    Compressed records format
+ * @details The compressed data is preceded by the original size, a flags
+ *          byte precedes each group of 8 items, LSB first, a set flag is
+ *          a literal byte, a cleared flag is a big endian match token with
+ *          the distance minus one in the high bits and the length minus
+ *          @p LZ_MIN_MATCH in the low bits.
+ * @{
+ */
+#define LZ_DISTANCE_BITS    10U
+#define LZ_LENGTH_BITS      6U
+#define LZ_WINDOW_SIZE      (1U << LZ_DISTANCE_BITS)
+#define LZ_MIN_MATCH        3U
+#define LZ_MAX_MATCH        ((1U << LZ_LENGTH_BITS) - 1U + LZ_MIN_MATCH)
+/** @} */
+
 /**
  * @brief   Combines two values (0..3) in one (0..15).
  */
@@ -85,6 +134,61 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (MFS_CFG_USE_COMPRESSION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Compressed data writer.
+ */
+typedef struct {
+  /**
+   * @brief   Data offset or zero if the data is only measured.
+   */
+  flash_offset_t            offset;
+  /**
+   * @brief   Size of the data already flushed.
+   */
+  uint32_t                  size;
+  /**
+   * @brief   CRC of the data already flushed.
+   */
+  uint16_t                  crc;
+  /**
+   * @brief   Number of bytes in the staging buffer.
+   */
+  size_t                    fill;
+  /**
+   * @brief   Staging buffer, the transient buffer is used by the write
+   *          verification.
+   */
+  uint8_t                   buf[MFS_CFG_BUFFER_SIZE];
+} mfs_lz_writer_t;
+
+/**
+ * @brief   Compressed data reader.
+ */
+typedef struct {
+  /**
+   * @brief   Offset of the data not yet read.
+   */
+  flash_offset_t            offset;
+  /**
+   * @brief   Size of the data not yet read.
+   */
+  uint32_t                  remaining;
+  /**
+   * @brief   CRC of the data already read.
+   */
+  uint16_t                  crc;
+  /**
+   * @brief   Position in the transient buffer.
+   */
+  size_t                    pos;
+  /**
+   * @brief   Number of bytes in the transient buffer.
+   */
+  size_t                    fill;
+} mfs_lz_reader_t;
+#endif
+
 static const uint16_t crc16_table[256] = {
   0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
   0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
@@ -135,6 +239,40 @@ uint16_t crc16(uint16_t crc, const uint8_t *data, size_t n) {
   return crc;
 }
 
+/**
+ * @brief   Computes the CRC of a data block.
+ * @details The computation is delegated to the CRC driver if one has been
+ *          specified in the configuration.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] crc       CRC value to continue from
+ * @param[in] data      pointer to the data
+ * @param[in] n         number of bytes
+ * @return              The updated CRC value.
+ *
+ * @notapi
+ */
+static uint16_t mfs_crc16(MFSDriver *mfsp, uint16_t crc,
+                          const uint8_t *data, size_t n) {
+
+#if HAL_USE_CRC == TRUE
+  if (mfsp->config->crcp != NULL) {
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+    crcAcquireBus(mfsp->config->crcp);
+#endif
+    crc = (uint16_t)crcCompute(mfsp->config->crcp, (uint32_t)crc, n, data);
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+    crcReleaseBus(mfsp->config->crcp);
+#endif
+    return crc;
+  }
+#else
+  (void)mfsp;
+#endif
+
+  return crc16(crc, data, n);
+}
+
 static void mfs_state_reset(MFSDriver *mfsp) {
   unsigned i;
 
@@ -147,6 +285,10 @@ static void mfs_state_reset(MFSDriver *mfsp) {
     mfsp->descriptors[i].offset = 0U;
     mfsp->descriptors[i].size   = 0U;
   }
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+
+  mfsp->gc_phase = MFS_GC_IDLE;
+#endif
 }
 
 static flash_offset_t mfs_flash_get_bank_offset(MFSDriver *mfsp,
@@ -182,6 +324,23 @@ static mfs_error_t mfs_flash_read(MFSDriver *mfsp, flash_offset_t offset,
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Invalidates the retained state before a flash modification.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ *
+ * @notapi
+ */
+static void mfs_warm_invalidate(MFSDriver *mfsp) {
+
+  if (mfsp->warm_valid) {
+    mfsp->warm_valid = false;
+    wrInvalidate(mfsp->config->wrp, mfsp->config->wr_slot);
+  }
+}
+#endif /* MFS_CFG_USE_WARM_RESTART == TRUE */
+
 /**
  * @brief   Flash write.
  * @note    If the option @p MFS_CFG_WRITE_VERIFY is enabled then the flash
@@ -201,6 +360,10 @@ static mfs_error_t mfs_flash_write(MFSDriver *mfsp,
                                    const uint8_t *wp) {
   flash_error_t ferr;
 
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  mfs_warm_invalidate(mfsp);
+#endif
+
   ferr = flashProgram(mfsp->config->flashp, offset, n, wp);
   if (ferr != FLASH_NO_ERROR) {
     mfsp->state = MFS_ERROR;
@@ -267,6 +430,463 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_USE_COMPRESSION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Flushes the staging buffer of a compressed data writer.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in,out] wp    pointer to the writer
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_lz_flush(MFSDriver *mfsp, mfs_lz_writer_t *wp) {
+
+  if ((wp->offset != 0U) && (wp->fill > 0U)) {
+    wp->crc = mfs_crc16(mfsp, wp->crc, wp->buf, wp->fill);
+    RET_ON_ERROR(mfs_flash_write(mfsp, wp->offset + wp->size,
+                                 wp->fill, wp->buf));
+  }
+  wp->size += (uint32_t)wp->fill;
+  wp->fill  = 0U;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Appends bytes to a compressed data writer.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in,out] wp    pointer to the writer
+ * @param[in] p         pointer to the bytes
+ * @param[in] n         number of bytes
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_lz_put(MFSDriver *mfsp, mfs_lz_writer_t *wp,
+                              const uint8_t *p, size_t n) {
+
+  while (n > 0U) {
+    wp->buf[wp->fill++] = *p++;
+    n--;
+    if (wp->fill >= MFS_CFG_BUFFER_SIZE) {
+      RET_ON_ERROR(mfs_lz_flush(mfsp, wp));
+    }
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Compresses record data.
+ * @details Matches are searched in the record data itself so no window
+ *          memory is required. The encoding is deterministic, the data is
+ *          measured in a first pass and written in a second pass.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in,out] wp    pointer to an initialized writer
+ * @param[in] src       pointer to the record data
+ * @param[in] n         size of the record data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_lz_encode(MFSDriver *mfsp, mfs_lz_writer_t *wp,
+                                 const uint8_t *src, size_t n) {
+  uint8_t group[1U + (8U * 2U)];
+  size_t i, gfill;
+  unsigned items;
+
+  /* Original size first.*/
+  group[0] = (uint8_t)n;
+  group[1] = (uint8_t)(n >> 8);
+  group[2] = (uint8_t)(n >> 16);
+  group[3] = (uint8_t)(n >> 24);
+  RET_ON_ERROR(mfs_lz_put(mfsp, wp, group, sizeof (uint32_t)));
+
+  i        = 0U;
+  gfill    = 1U;
+  items    = 0U;
+  group[0] = 0U;
+  while (i < n) {
+    size_t j, start, max, best_len, best_dist;
+
+    /* Longest match within the window, nearest first.*/
+    start     = i > LZ_WINDOW_SIZE ? i - LZ_WINDOW_SIZE : 0U;
+    max       = n - i > LZ_MAX_MATCH ? LZ_MAX_MATCH : n - i;
+    best_len  = 0U;
+    best_dist = 0U;
+    for (j = i; j > start; ) {
+      size_t len = 0U;
+
+      j--;
+      while ((len < max) && (src[j + len] == src[i + len])) {
+        len++;
+      }
+      if (len > best_len) {
+        best_len  = len;
+        best_dist = i - j;
+        if (len >= max) {
+          break;
+        }
+      }
+    }
+
+    if (best_len >= LZ_MIN_MATCH) {
+      uint32_t token = ((uint32_t)(best_dist - 1U) << LZ_LENGTH_BITS) |
+                       (uint32_t)(best_len - LZ_MIN_MATCH);
+
+      group[gfill++] = (uint8_t)(token >> 8);
+      group[gfill++] = (uint8_t)token;
+      i += best_len;
+    }
+    else {
+      group[0] |= (uint8_t)(1U << items);
+      group[gfill++] = src[i++];
+    }
+
+    /* Groups are emitted after 8 items or at the end.*/
+    items++;
+    if ((items >= 8U) || (i >= n)) {
+      RET_ON_ERROR(mfs_lz_put(mfsp, wp, group, gfill));
+      gfill    = 1U;
+      items    = 0U;
+      group[0] = 0U;
+    }
+  }
+
+  return mfs_lz_flush(mfsp, wp);
+}
+
+/**
+ * @brief   Reads a byte of compressed data.
+ * @details The data is read in chunks into the transient buffer, the CRC
+ *          is updated on each chunk.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in,out] rp    pointer to the reader
+ * @param[out] bp       pointer to the read byte
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_lz_get(MFSDriver *mfsp, mfs_lz_reader_t *rp,
+                              uint8_t *bp) {
+
+  if (rp->pos >= rp->fill) {
+    size_t chunk;
+
+    /* Reading beyond the data means a corrupted record.*/
+    if (rp->remaining == 0U) {
+      mfsp->state = MFS_ERROR;
+      return MFS_ERR_FLASH_FAILURE;
+    }
+
+    chunk = rp->remaining > MFS_CFG_BUFFER_SIZE ? MFS_CFG_BUFFER_SIZE :
+                                                  rp->remaining;
+    RET_ON_ERROR(mfs_flash_read(mfsp, rp->offset, chunk, mfsp->buffer.data8));
+    rp->crc        = mfs_crc16(mfsp, rp->crc, mfsp->buffer.data8, chunk);
+    rp->offset    += (flash_offset_t)chunk;
+    rp->remaining -= (uint32_t)chunk;
+    rp->pos        = 0U;
+    rp->fill       = chunk;
+  }
+  *bp = mfsp->buffer.data8[rp->pos++];
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Reads a compressed record and checks its CRC.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    record header offset
+ * @param[in] ssize     stored data size
+ * @param[in] crc       CRC from the record header
+ * @param[in,out] np    on input is the maximum buffer size, on return it is
+ *                      the size of the data decoded into the buffer
+ * @param[out] buffer   pointer to a buffer for record data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_record_decode(MFSDriver *mfsp,
+                                     flash_offset_t offset,
+                                     uint32_t ssize,
+                                     uint16_t crc,
+                                     size_t *np,
+                                     uint8_t *buffer) {
+  mfs_lz_reader_t r;
+  size_t i, n;
+  uint8_t b[4];
+
+  r.offset    = offset + sizeof (mfs_data_header_t);
+  r.remaining = ssize;
+  r.crc       = 0xFFFFU;
+  r.pos       = 0U;
+  r.fill      = 0U;
+
+  /* Original size first.*/
+  for (i = 0U; i < sizeof (uint32_t); i++) {
+    RET_ON_ERROR(mfs_lz_get(mfsp, &r, &b[i]));
+  }
+  n = (size_t)b[0] | ((size_t)b[1] << 8) |
+      ((size_t)b[2] << 16) | ((size_t)b[3] << 24);
+  if (*np < n) {
+    return MFS_ERR_INV_SIZE;
+  }
+  *np = n;
+
+  i = 0U;
+  while (i < n) {
+    unsigned items;
+    uint8_t flags;
+
+    RET_ON_ERROR(mfs_lz_get(mfsp, &r, &flags));
+    for (items = 0U; (items < 8U) && (i < n); items++) {
+      if ((flags & 1U) != 0U) {
+        RET_ON_ERROR(mfs_lz_get(mfsp, &r, &buffer[i]));
+        i++;
+      }
+      else {
+        size_t dist, len;
+
+        RET_ON_ERROR(mfs_lz_get(mfsp, &r, &b[0]));
+        RET_ON_ERROR(mfs_lz_get(mfsp, &r, &b[1]));
+        dist = ((((size_t)b[0] << 8) | (size_t)b[1]) >> LZ_LENGTH_BITS) + 1U;
+        len  = ((size_t)b[1] & ((1U << LZ_LENGTH_BITS) - 1U)) + LZ_MIN_MATCH;
+        if ((dist > i) || (len > n - i)) {
+          mfsp->state = MFS_ERROR;
+          return MFS_ERR_FLASH_FAILURE;
+        }
+
+        /* Byte by byte because source and destination can overlap.*/
+        while (len > 0U) {
+          buffer[i] = buffer[i - dist];
+          i++;
+          len--;
+        }
+      }
+      flags >>= 1;
+    }
+  }
+
+  /* The whole stored data must have been consumed, then checking CRC.*/
+  if ((r.remaining != 0U) || (r.pos != r.fill) || (r.crc != crc)) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_USE_COMPRESSION == TRUE */
+
+/**
+ * @brief   Determines the stored size of a record.
+ * @details If compression is enabled then records of at least
+ *          @p MFS_CFG_COMPRESSION_THRESHOLD bytes are measured compressed,
+ *          the compressed form is used only if it saves flash space.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] n         size of record data
+ * @param[in] buffer    pointer to a buffer for record data
+ * @return              The stored data size, it differs from @p n only
+ *                      for compressed records.
+ *
+ * @notapi
+ */
+static uint32_t mfs_record_stored_size(MFSDriver *mfsp,
+                                       size_t n,
+                                       const uint8_t *buffer) {
+
+#if MFS_CFG_USE_COMPRESSION == TRUE
+  if (n >= (size_t)MFS_CFG_COMPRESSION_THRESHOLD) {
+    mfs_lz_writer_t w;
+
+    w.offset = 0U;
+    w.size   = 0U;
+    w.crc    = 0xFFFFU;
+    w.fill   = 0U;
+    (void) mfs_lz_encode(mfsp, &w, buffer, n);
+    if (ALIGNED_REC_SIZE(w.size) < ALIGNED_REC_SIZE(n)) {
+      return w.size;
+    }
+  }
+#else
+  (void)mfsp;
+  (void)buffer;
+#endif
+
+  return (uint32_t)n;
+}
+
+/**
+ * @brief   Writes a record except the header magic.
+ * @details The header fields following the magic are programmed together
+ *          with the beginning of the record data in a single operation,
+ *          the magic is left erased and must be written last.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    record header offset
+ * @param[in] id        record identifier
+ * @param[in] n         size of data to be written
+ * @param[in] ssize     stored data size as returned by
+ *                      @p mfs_record_stored_size()
+ * @param[in] buffer    pointer to a buffer for record data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_record_write(MFSDriver *mfsp,
+                                    flash_offset_t offset,
+                                    mfs_id_t id,
+                                    size_t n,
+                                    uint32_t ssize,
+                                    const uint8_t *buffer) {
+  size_t tsize = sizeof (mfs_data_header_t) - (sizeof (uint32_t) * 2U);
+  size_t chunk = MFS_CFG_BUFFER_SIZE - tsize;
+
+#if MFS_CFG_USE_COMPRESSION == TRUE
+  if ((size_t)ssize != n) {
+    mfs_lz_writer_t w;
+
+    /* The compressed data is written first because its CRC is needed
+       in the header fields.*/
+    w.offset = offset + sizeof (mfs_data_header_t);
+    w.size   = 0U;
+    w.crc    = 0xFFFFU;
+    w.fill   = 0U;
+    RET_ON_ERROR(mfs_lz_encode(mfsp, &w, buffer, n));
+    if (w.size != ssize) {
+      return MFS_ERR_INTERNAL;
+    }
+
+    mfsp->buffer.dhdr.fields.id     = (uint16_t)(id | COMPRESSED_FLAG);
+    mfsp->buffer.dhdr.fields.size   = ssize;
+    mfsp->buffer.dhdr.fields.crc    = w.crc;
+    return mfs_flash_write(mfsp,
+                           offset + (sizeof (uint32_t) * 2U),
+                           tsize,
+                           mfsp->buffer.data8 + (sizeof (uint32_t) * 2U));
+  }
+#else
+  (void)ssize;
+#endif
+
+  /* Preparing the header fields, they are moved at the buffer start and
+     followed by as much data as the buffer can contain.*/
+  mfsp->buffer.dhdr.fields.id     = (uint16_t)id;
+  mfsp->buffer.dhdr.fields.size   = (uint32_t)n;
+  mfsp->buffer.dhdr.fields.crc    = mfs_crc16(mfsp, 0xFFFFU, buffer, n);
+  memmove((void *)mfsp->buffer.data8,
+          (const void *)(mfsp->buffer.data8 + (sizeof (uint32_t) * 2U)),
+          tsize);
+  if (chunk > n) {
+    chunk = n;
+  }
+  memcpy((void *)(mfsp->buffer.data8 + tsize), (const void *)buffer, chunk);
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               offset + (sizeof (uint32_t) * 2U),
+                               tsize + chunk,
+                               mfsp->buffer.data8));
+
+  /* Writing the remaining data part, if any.*/
+  if (n > chunk) {
+    RET_ON_ERROR(mfs_flash_write(mfsp,
+                                 offset + sizeof (mfs_data_header_t) + chunk,
+                                 n - chunk,
+                                 buffer + chunk));
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Reads a record and checks its CRC.
+ * @details The record header and the beginning of the record data are
+ *          read in a single operation.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    record header offset
+ * @param[in] n         size of data to be read
+ * @param[out] buffer   pointer to a buffer for record data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_record_read(MFSDriver *mfsp,
+                                   flash_offset_t offset,
+                                   size_t n,
+                                   uint8_t *buffer) {
+  size_t chunk = MFS_CFG_BUFFER_SIZE - sizeof (mfs_data_header_t);
+  uint16_t crc;
+
+  /* Header and first data chunk read from flash.*/
+  if (chunk > n) {
+    chunk = n;
+  }
+  RET_ON_ERROR(mfs_flash_read(mfsp, offset,
+                              sizeof (mfs_data_header_t) + chunk,
+                              mfsp->buffer.data8));
+  memcpy((void *)buffer,
+         (const void *)(mfsp->buffer.data8 + sizeof (mfs_data_header_t)),
+         chunk);
+
+  /* Remaining data read from flash, if any.*/
+  if (n > chunk) {
+    RET_ON_ERROR(mfs_flash_read(mfsp,
+                                offset + sizeof (mfs_data_header_t) + chunk,
+                                n - chunk,
+                                buffer + chunk));
+  }
+
+  /* Checking CRC.*/
+  crc = mfs_crc16(mfsp, 0xFFFFU, buffer, n);
+  if (crc != mfsp->buffer.dhdr.fields.crc) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Erases and verifies a sector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] sector    sector to be erased
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_flash_erase_sector(MFSDriver *mfsp,
+                                          flash_sector_t sector) {
+  flash_error_t ferr;
+
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  mfs_warm_invalidate(mfsp);
+#endif
+
+  ferr = flashStartEraseSector(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashWaitErase(mfsp->config->flashp);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashVerifyErase(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+
+  return MFS_NO_ERROR;
+}
+
 /**
  * @brief   Erases and verifies all sectors belonging to a bank.
  *
@@ -289,24 +909,7 @@ static mfs_error_t mfs_bank_erase(MFSDriver *mfsp, mfs_bank_t bank) {
   }
 
   while (sector < end) {
-    flash_error_t ferr;
-
-    ferr = flashStartEraseSector(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashWaitErase(mfsp->config->flashp);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashVerifyErase(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-
+    RET_ON_ERROR(mfs_flash_erase_sector(mfsp, sector));
     sector++;
   }
 
@@ -379,8 +982,9 @@ static mfs_error_t mfs_bank_write_header(MFSDriver *mfsp,
   bhdr.fields.magic2    = MFS_BANK_MAGIC_2;
   bhdr.fields.counter   = cnt;
   bhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
-  bhdr.fields.crc       = crc16(0xFFFFU, bhdr.hdr8,
-                                sizeof (mfs_bank_header_t) - sizeof (uint16_t));
+  bhdr.fields.crc       = mfs_crc16(mfsp, 0xFFFFU, bhdr.hdr8,
+                                    sizeof (mfs_bank_header_t) -
+                                    sizeof (uint16_t));
 
   return mfs_flash_write(mfsp,
                          flashGetSectorOffset(mfsp->config->flashp, sector),
@@ -415,8 +1019,8 @@ static mfs_bank_state_t mfs_bank_check_header(MFSDriver *mfsp) {
   }
 
   /* Verifying header CRC.*/
-  crc = crc16(0xFFFFU, mfsp->buffer.bhdr.hdr8,
-              sizeof (mfs_bank_header_t) - sizeof (uint16_t));
+  crc = mfs_crc16(mfsp, 0xFFFFU, mfsp->buffer.bhdr.hdr8,
+                  sizeof (mfs_bank_header_t) - sizeof (uint16_t));
   if (crc != mfsp->buffer.bhdr.fields.crc) {
     return MFS_BANK_GARBAGE;
   }
@@ -424,6 +1028,113 @@ static mfs_bank_state_t mfs_bank_check_header(MFSDriver *mfsp) {
   return MFS_BANK_OK;
 }
 
+/**
+ * @brief   Checks the integrity of a data header.
+ *
+ * @param[in] dhdrp     pointer to the data header
+ * @param[in] space     space between the header and the bank end
+ * @return              The header state.
+ * @retval false        if the header is not valid.
+ * @retval true         if the header is valid.
+ *
+ * @notapi
+ */
+static bool mfs_is_valid_dhdr(const mfs_data_header_t *dhdrp,
+                              flash_offset_t space) {
+
+  return (dhdrp->fields.magic1 == MFS_HEADER_MAGIC_1) &&
+         (dhdrp->fields.magic2 == MFS_HEADER_MAGIC_2) &&
+         ((RECORD_ID(*dhdrp) >= 1U) || IS_CHECKPOINT(*dhdrp)) &&
+         (RECORD_ID(*dhdrp) <= (uint32_t)MFS_CFG_MAX_RECORDS) &&
+         (dhdrp->fields.size <= space);
+}
+
+#if (MFS_CFG_USE_CHECKPOINTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Loads the records index from the most recent checkpoint.
+ * @details Record headers are traversed without reading the data until
+ *          the end of the written area, if a valid checkpoint is found then
+ *          the records index is loaded from it.
+ * @note    Anomalies are not reported here, the scan performed afterward
+ *          detects them.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] start_offset bank start offset
+ * @param[in] end_offset bank end offset
+ * @param[in,out] offsetp on input the offset of the first record, on output
+ *                      the offset of the first record following the loaded
+ *                      checkpoint
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_load_checkpoint(MFSDriver *mfsp,
+                                            flash_offset_t start_offset,
+                                            flash_offset_t end_offset,
+                                            flash_offset_t *offsetp) {
+  flash_offset_t hdr_offset, cp_offset;
+  unsigned i;
+  uint16_t crc;
+
+  /* Searching for the last checkpoint record.*/
+  cp_offset  = 0U;
+  crc        = 0U;
+  hdr_offset = *offsetp;
+  while (hdr_offset < end_offset - ALIGNED_DHDR_SIZE) {
+
+    RET_ON_ERROR(mfs_flash_read(mfsp, hdr_offset,
+                                sizeof (mfs_data_header_t),
+                                mfsp->buffer.data8));
+
+    if (!mfs_is_valid_dhdr(&mfsp->buffer.dhdr, end_offset - hdr_offset)) {
+      break;
+    }
+
+    if (IS_CHECKPOINT(mfsp->buffer.dhdr)) {
+      cp_offset = hdr_offset;
+      crc = mfsp->buffer.dhdr.fields.crc;
+    }
+
+    /* On the next header.*/
+    hdr_offset = hdr_offset + ALIGNED_REC_SIZE(mfsp->buffer.dhdr.fields.size);
+  }
+
+  if (cp_offset == 0U) {
+    return MFS_NO_ERROR;
+  }
+
+  /* Loading the index, it is discarded if anything is wrong.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp, cp_offset + sizeof (mfs_data_header_t),
+                              CHECKPOINT_SIZE,
+                              (uint8_t *)mfsp->descriptors));
+  if (mfs_crc16(mfsp, 0xFFFFU, (const uint8_t *)mfsp->descriptors,
+                CHECKPOINT_SIZE) == crc) {
+    for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+      flash_offset_t offset = mfsp->descriptors[i].offset;
+
+      if ((offset != 0U) &&
+          ((offset < start_offset + ALIGNED_SIZEOF(mfs_bank_header_t)) ||
+           (offset > cp_offset) ||
+           (mfsp->descriptors[i].size == 0U) ||
+           (ALIGNED_REC_SIZE(mfsp->descriptors[i].size) > cp_offset - offset))) {
+        break;
+      }
+    }
+    if (i >= MFS_CFG_MAX_RECORDS) {
+      *offsetp = cp_offset + ALIGNED_REC_SIZE(CHECKPOINT_SIZE);
+      return MFS_NO_ERROR;
+    }
+  }
+
+  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+    mfsp->descriptors[i].offset = 0U;
+    mfsp->descriptors[i].size   = 0U;
+  }
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_USE_CHECKPOINTS == TRUE */
+
 /**
  * @brief   Scans blocks searching for records.
  * @note    The block integrity is strongly checked.
@@ -449,6 +1160,13 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
   hdr_offset   = start_offset + (flash_offset_t)ALIGNED_SIZEOF(mfs_bank_header_t);
   end_offset   = start_offset + mfsp->config->bank_size;
 
+#if MFS_CFG_USE_CHECKPOINTS == TRUE
+  /* Records preceding the most recent checkpoint are skipped, the index
+     is loaded from the checkpoint record instead.*/
+  RET_ON_ERROR(mfs_bank_load_checkpoint(mfsp, start_offset,
+                                        end_offset, &hdr_offset));
+#endif
+
   /* Scanning records until there is there is not enough space left for an
      header.*/
   while (hdr_offset < end_offset - ALIGNED_DHDR_SIZE) {
@@ -471,11 +1189,7 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
     }
 
     /* It is not erased so checking for integrity.*/
-    if ((u.dhdr.fields.magic1 != MFS_HEADER_MAGIC_1) ||
-        (u.dhdr.fields.magic2 != MFS_HEADER_MAGIC_2) ||
-        (u.dhdr.fields.id < 1U) ||
-        (u.dhdr.fields.id > (uint32_t)MFS_CFG_MAX_RECORDS) ||
-        (u.dhdr.fields.size > end_offset - hdr_offset)) {
+    if (!mfs_is_valid_dhdr(&u.dhdr, end_offset - hdr_offset)) {
       *wflagp = true;
       break;
     }
@@ -495,7 +1209,7 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
         RET_ON_ERROR(mfs_flash_read(mfsp, data, chunk, mfsp->buffer.data8));
 
         /* CRC on the read data chunk.*/
-        crc = crc16(crc, &mfsp->buffer.data8[0], chunk);
+        crc = mfs_crc16(mfsp, crc, &mfsp->buffer.data8[0], chunk);
 
         /* Next chunk.*/
         data  += chunk;
@@ -507,15 +1221,15 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
          continues because there could be more valid records afterward.*/
       *wflagp = true;
     }
-    else {
+    else if (!IS_CHECKPOINT(u.dhdr)) {
       /* Zero-sized records are erase markers.*/
       if (u.dhdr.fields.size == 0U) {
-        mfsp->descriptors[u.dhdr.fields.id - 1U].offset = 0U;
-        mfsp->descriptors[u.dhdr.fields.id - 1U].size   = 0U;
+        mfsp->descriptors[RECORD_ID(u.dhdr) - 1U].offset = 0U;
+        mfsp->descriptors[RECORD_ID(u.dhdr) - 1U].size   = 0U;
       }
       else {
-        mfsp->descriptors[u.dhdr.fields.id - 1U].offset = hdr_offset;
-        mfsp->descriptors[u.dhdr.fields.id - 1U].size   = u.dhdr.fields.size;
+        mfsp->descriptors[RECORD_ID(u.dhdr) - 1U].offset = hdr_offset;
+        mfsp->descriptors[RECORD_ID(u.dhdr) - 1U].size   = u.dhdr.fields.size;
       }
     }
 
@@ -575,6 +1289,249 @@ static mfs_error_t mfs_bank_get_state(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_USE_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a step of an incremental garbage collection.
+ * @details The most recent record instances are copied into the other bank
+ *          in index order, at most @p budget bytes are copied in a single
+ *          step. After the last record the banks are swapped and the old
+ *          bank is erased, one sector per step.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] budget    maximum number of bytes to be copied in this step
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if the garbage collection has been completed.
+ * @retval MFS_WARN_GC_PENDING if more steps are required.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_step(MFSDriver *mfsp, uint32_t budget) {
+  flash_sector_t start, count;
+  mfs_bank_t dbank;
+  unsigned i;
+
+  if (mfsp->current_bank == MFS_BANK_0) {
+    dbank = MFS_BANK_1;
+  }
+  else {
+    dbank = MFS_BANK_0;
+  }
+
+  if (mfsp->gc_phase == MFS_GC_IDLE) {
+    /* Starting a new garbage collection.*/
+    mfsp->gc_phase       = MFS_GC_COPY;
+    mfsp->gc_index       = 0U;
+    mfsp->gc_copied      = 0U;
+    mfsp->gc_next_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
+                           ALIGNED_SIZEOF(mfs_bank_header_t);
+  }
+
+  if (mfsp->gc_phase == MFS_GC_COPY) {
+
+    /* Copying the most recent record instances within the budget.*/
+    while ((budget > 0U) && (mfsp->gc_index < MFS_CFG_MAX_RECORDS)) {
+      mfs_record_descriptor_t *dp = &mfsp->descriptors[mfsp->gc_index];
+
+      if (dp->offset == 0U) {
+        mfsp->gc_offsets[mfsp->gc_index] = 0U;
+        mfsp->gc_index++;
+      }
+      else {
+        uint32_t n, totsize = ALIGNED_REC_SIZE(dp->size);
+
+        n = totsize - mfsp->gc_copied;
+        if (n > budget) {
+          n = budget;
+        }
+        RET_ON_ERROR(mfs_flash_copy(mfsp,
+                                    mfsp->gc_next_offset + mfsp->gc_copied,
+                                    dp->offset + mfsp->gc_copied,
+                                    n));
+        mfsp->gc_copied += n;
+        budget -= n;
+
+        if (mfsp->gc_copied >= totsize) {
+          mfsp->gc_offsets[mfsp->gc_index] = mfsp->gc_next_offset;
+          mfsp->gc_next_offset += totsize;
+          mfsp->gc_copied = 0U;
+          mfsp->gc_index++;
+        }
+      }
+    }
+
+    if (mfsp->gc_index < MFS_CFG_MAX_RECORDS) {
+      return MFS_WARN_GC_PENDING;
+    }
+
+    /* All records copied, the destination bank becomes the current one.*/
+    for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+      mfsp->descriptors[i].offset = mfsp->gc_offsets[i];
+    }
+    mfsp->current_bank = dbank;
+    mfsp->current_counter += 1U;
+    mfsp->next_offset = mfsp->gc_next_offset;
+
+    /* The header is written after the data.*/
+    RET_ON_ERROR(mfs_bank_write_header(mfsp, dbank, mfsp->current_counter));
+
+    /* The old bank is erased in the following steps.*/
+    mfsp->gc_phase  = MFS_GC_ERASE;
+    mfsp->gc_sector = 0U;
+
+    return MFS_WARN_GC_PENDING;
+  }
+
+  /* Erasing one sector of the old bank, now it is the "other" bank.*/
+  if (dbank == MFS_BANK_0) {
+    start = mfsp->config->bank0_start;
+    count = mfsp->config->bank0_sectors;
+  }
+  else {
+    start = mfsp->config->bank1_start;
+    count = mfsp->config->bank1_sectors;
+  }
+  RET_ON_ERROR(mfs_flash_erase_sector(mfsp, start + mfsp->gc_sector));
+  mfsp->gc_sector++;
+  if (mfsp->gc_sector < count) {
+    return MFS_WARN_GC_PENDING;
+  }
+
+  mfsp->gc_phase = MFS_GC_IDLE;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Completes an incremental garbage collection.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_complete(MFSDriver *mfsp) {
+
+  while (mfsp->gc_phase != MFS_GC_IDLE) {
+    mfs_error_t err;
+
+    err = mfs_gc_step(mfsp, mfsp->config->bank_size);
+    if (MFS_IS_ERROR(err)) {
+      return err;
+    }
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Completes the copy of a partially copied record.
+ * @note    Must be invoked before any storage update so that the record
+ *          being copied is never left half updated.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_sync_record(MFSDriver *mfsp) {
+  mfs_error_t err;
+
+  if ((mfsp->gc_phase != MFS_GC_COPY) || (mfsp->gc_copied == 0U)) {
+    return MFS_NO_ERROR;
+  }
+
+  err = mfs_gc_step(mfsp,
+                    ALIGNED_REC_SIZE(mfsp->descriptors[mfsp->gc_index].size) -
+                    mfsp->gc_copied);
+  if (MFS_IS_ERROR(err)) {
+    return err;
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Propagates a storage update to the destination bank.
+ * @details If records already copied by an incremental garbage collection
+ *          have been updated then the newly written area is copied into
+ *          the destination bank too. If there is not enough space there
+ *          then the garbage collection is abandoned.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    value of @p next_offset before the update
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_sync_update(MFSDriver *mfsp, flash_offset_t offset) {
+  flash_offset_t dest_offset, dest_end;
+  uint32_t required, size;
+  bool changed;
+  unsigned i;
+
+  if ((mfsp->gc_phase != MFS_GC_COPY) || (offset >= mfsp->next_offset)) {
+    return MFS_NO_ERROR;
+  }
+
+  /* Checking if already copied records have been updated.*/
+  changed  = false;
+  required = 0U;
+  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+    if (i < mfsp->gc_index) {
+      if ((mfsp->descriptors[i].offset >= offset) ||
+          ((mfsp->descriptors[i].offset == 0U) &&
+           (mfsp->gc_offsets[i] != 0U))) {
+        changed = true;
+      }
+    }
+    else if (mfsp->descriptors[i].offset != 0U) {
+      required += ALIGNED_REC_SIZE(mfsp->descriptors[i].size);
+    }
+  }
+  if (!changed) {
+    return MFS_NO_ERROR;
+  }
+
+  /* Space check in the destination bank, the remaining records must still
+     fit after the updated area.*/
+  size = mfsp->next_offset - offset;
+  dest_offset = mfsp->gc_next_offset;
+  if (mfsp->current_bank == MFS_BANK_0) {
+    dest_end = mfs_flash_get_bank_offset(mfsp, MFS_BANK_1) +
+               mfsp->config->bank_size;
+  }
+  else {
+    dest_end = mfs_flash_get_bank_offset(mfsp, MFS_BANK_0) +
+               mfsp->config->bank_size;
+  }
+  if ((flash_offset_t)(required + size) > (dest_end - dest_offset)) {
+
+    /* The garbage collection is abandoned, the destination bank is
+       erased.*/
+    mfsp->gc_phase = MFS_GC_IDLE;
+    if (mfsp->current_bank == MFS_BANK_0) {
+      return mfs_bank_erase(mfsp, MFS_BANK_1);
+    }
+    return mfs_bank_erase(mfsp, MFS_BANK_0);
+  }
+
+  /* Copying the updated area as-is, offsets inside the area are moved by
+     the same amount.*/
+  RET_ON_ERROR(mfs_flash_copy(mfsp, dest_offset, offset, size));
+  for (i = 0; i < mfsp->gc_index; i++) {
+    if (mfsp->descriptors[i].offset >= offset) {
+      mfsp->gc_offsets[i] = mfsp->descriptors[i].offset - offset + dest_offset;
+    }
+    else if (mfsp->descriptors[i].offset == 0U) {
+      mfsp->gc_offsets[i] = 0U;
+    }
+  }
+  mfsp->gc_next_offset += size;
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_USE_INCREMENTAL_GC == TRUE */
+
 /**
  * @brief   Enforces a garbage collection.
  * @details Storage data is compacted into a single bank.
@@ -589,6 +1546,12 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
   mfs_bank_t sbank, dbank;
   flash_offset_t dest_offset;
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+  /* An incremental garbage collection in progress is completed first, the
+     result could contain updates copied as-is so it is compacted again.*/
+  RET_ON_ERROR(mfs_gc_complete(mfsp));
+#endif
+
   sbank = mfsp->current_bank;
   if (sbank == MFS_BANK_0) {
     dbank = MFS_BANK_1;
@@ -766,6 +1729,125 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
   return (w1 || w2) ? MFS_WARN_REPAIR : MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checkpoints the mounted state in the warm restart slot.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ *
+ * @notapi
+ */
+static void mfs_warm_save(MFSDriver *mfsp) {
+  mfs_warm_state_t *wsp;
+
+  wsp = (mfs_warm_state_t *)wrSaveStart(mfsp->config->wrp,
+                                        mfsp->config->wr_slot);
+  wsp->bank        = mfsp->current_bank;
+  wsp->counter     = mfsp->current_counter;
+  wsp->next_offset = mfsp->next_offset;
+  wsp->used_space  = mfsp->used_space;
+  memcpy((void *)wsp->descriptors, (const void *)mfsp->descriptors,
+         sizeof (mfsp->descriptors));
+  wrSaveEnd(mfsp->config->wrp, mfsp->config->wr_slot);
+
+  mfsp->warm_valid = true;
+}
+
+/**
+ * @brief   Mounts the storage from the warm restart slot.
+ * @details The retained state is checked against the bank headers and
+ *          the free space start, any mismatch falls back to a full
+ *          mount.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation result.
+ * @retval false        if the retained state cannot be used.
+ * @retval true         if the state has been restored.
+ *
+ * @notapi
+ */
+static bool mfs_warm_restore(MFSDriver *mfsp) {
+  const mfs_warm_state_t *wsp;
+  flash_offset_t start, end;
+  mfs_bank_t other;
+  unsigned i;
+
+  if ((mfsp->config->wrp == NULL) ||
+      (mfsp->config->wrp->state != WR_READY)) {
+    return false;
+  }
+
+  wsp = (const mfs_warm_state_t *)wrGetSlot(mfsp->config->wrp,
+                                            mfsp->config->wr_slot);
+  if (wsp == NULL) {
+    return false;
+  }
+
+  /* Checking the retained state consistency.*/
+  if ((wsp->bank != MFS_BANK_0) && (wsp->bank != MFS_BANK_1)) {
+    return false;
+  }
+  other = wsp->bank == MFS_BANK_0 ? MFS_BANK_1 : MFS_BANK_0;
+  start = mfs_flash_get_bank_offset(mfsp, wsp->bank);
+  end   = start + mfsp->config->bank_size;
+  if ((wsp->next_offset < start + ALIGNED_SIZEOF(mfs_bank_header_t)) ||
+      (wsp->next_offset > end) ||
+      (wsp->used_space > wsp->next_offset - start)) {
+    return false;
+  }
+  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+    flash_offset_t offset = wsp->descriptors[i].offset;
+
+    if ((offset != 0U) &&
+        ((offset < start + ALIGNED_SIZEOF(mfs_bank_header_t)) ||
+         (offset >= wsp->next_offset) ||
+         (wsp->descriptors[i].size > wsp->next_offset - offset) ||
+         (ALIGNED_REC_SIZE(wsp->descriptors[i].size) >
+          wsp->next_offset - offset))) {
+      return false;
+    }
+  }
+
+  /* The bank in use must have the retained counter and the other bank
+     must be erased.*/
+  if ((mfs_flash_read(mfsp, start, sizeof (mfs_bank_header_t),
+                      mfsp->buffer.data8) != MFS_NO_ERROR) ||
+      (mfs_bank_check_header(mfsp) != MFS_BANK_OK) ||
+      (mfsp->buffer.bhdr.fields.counter != wsp->counter)) {
+    return false;
+  }
+  if ((mfs_flash_read(mfsp, mfs_flash_get_bank_offset(mfsp, other),
+                      sizeof (mfs_bank_header_t),
+                      mfsp->buffer.data8) != MFS_NO_ERROR) ||
+      (mfs_bank_check_header(mfsp) != MFS_BANK_ERASED)) {
+    return false;
+  }
+
+  /* Nothing must have been written after the retained free space start.*/
+  if (end - wsp->next_offset >= sizeof (mfs_data_header_t)) {
+    if (mfs_flash_read(mfsp, wsp->next_offset, sizeof (mfs_data_header_t),
+                       mfsp->buffer.data8) != MFS_NO_ERROR) {
+      return false;
+    }
+    for (i = 0; i < sizeof (mfs_data_header_t) / sizeof (uint32_t); i++) {
+      if (mfsp->buffer.dhdr.hdr32[i] != mfsp->config->erased) {
+        return false;
+      }
+    }
+  }
+
+  mfsp->current_bank    = wsp->bank;
+  mfsp->current_counter = wsp->counter;
+  mfsp->next_offset     = wsp->next_offset;
+  mfsp->used_space      = wsp->used_space;
+  memcpy((void *)mfsp->descriptors, (const void *)wsp->descriptors,
+         sizeof (mfsp->descriptors));
+  mfsp->warm_valid      = true;
+
+  return true;
+}
+#endif /* MFS_CFG_USE_WARM_RESTART == TRUE */
+
 /**
  * @brief   Configures and activates a MFS driver.
  *
@@ -788,6 +1870,14 @@ mfs_error_t mfs_mount(MFSDriver *mfsp) {
   /* Resetting previous state.*/
   mfs_state_reset(mfsp);
 
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  /* Restoring the retained state, if any, scanning is not required.*/
+  if (mfs_warm_restore(mfsp)) {
+    mfsp->state = MFS_READY;
+    return MFS_NO_ERROR;
+  }
+#endif
+
   /* Attempting to mount the managed partition.*/
   for (i = 0; i < MFS_CFG_MAX_REPAIR_ATTEMPTS; i++) {
     mfs_error_t err;
@@ -801,6 +1891,11 @@ mfs_error_t mfs_mount(MFSDriver *mfsp) {
     }
     if (!MFS_IS_ERROR(err)) {
       mfsp->state  = MFS_READY;
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+      if (mfsp->config->wrp != NULL) {
+        mfs_warm_save(mfsp);
+      }
+#endif
       return err;
     }
   }
@@ -827,6 +1922,9 @@ void mfsObjectInit(MFSDriver *mfsp) {
 
   mfsp->state = MFS_STOP;
   mfsp->config = NULL;
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  mfsp->warm_valid = false;
+#endif
 }
 
 /**
@@ -852,6 +1950,34 @@ mfs_error_t mfsStart(MFSDriver *mfsp, const MFSConfig *config) {
   osalDbgAssert((mfsp->state == MFS_STOP) || (mfsp->state == MFS_READY) ||
                 (mfsp->state == MFS_ERROR), "invalid state");
 
+#if HAL_USE_CRC == TRUE
+  osalDbgAssert((config->crcp == NULL) ||
+                ((config->crcp->state == CRC_READY) &&
+                 (config->crcp->config->poly == 0x1021U) &&
+                 (config->crcp->config->width == 16U) &&
+                 !config->crcp->config->reflect),
+                "invalid CRC driver configuration");
+#endif
+
+  /* On ECC flashes a program unit can be written only once, records must
+     not share units and the header magic must fill whole units.*/
+  osalDbgAssert(((flashGetDescriptor(config->flashp)->attributes &
+                  FLASH_ATTR_ECC_CAPABLE) == 0U) ||
+                ((MFS_CFG_MEMORY_ALIGNMENT %
+                  flashGetDescriptor(config->flashp)->page_size == 0U) &&
+                 ((sizeof (uint32_t) * 2U) %
+                  flashGetDescriptor(config->flashp)->page_size == 0U)),
+                "alignment not compatible with the flash program unit");
+
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  osalDbgAssert((config->wrp == NULL) ||
+                ((config->wrp->state == WR_READY) &&
+                 (config->wr_slot < config->wrp->config->nslots) &&
+                 (config->wrp->config->slots[config->wr_slot].size ==
+                  sizeof (mfs_warm_state_t))),
+                "invalid warm restart configuration");
+#endif
+
   /* Storing configuration.*/
   mfsp->config = config;
 
@@ -907,6 +2033,8 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
 
 /**
  * @brief   Retrieves and reads a data record.
+ * @note    Compressed records are transparently decompressed, the returned
+ *          size is the original record size.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
@@ -931,7 +2059,6 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
  */
 mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
                           size_t *np, uint8_t *buffer) {
-  uint16_t crc;
 
   osalDbgCheck((mfsp != NULL) &&
                (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
@@ -946,32 +2073,28 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
     return MFS_ERR_NOT_FOUND;
   }
 
+#if MFS_CFG_USE_COMPRESSION == TRUE
+  /* The header tells if the record is compressed, in that case the size
+     check is done on the original size.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp, mfsp->descriptors[id - 1U].offset,
+                              sizeof (mfs_data_header_t),
+                              mfsp->buffer.data8));
+  if ((mfsp->buffer.dhdr.fields.id & COMPRESSED_FLAG) != 0U) {
+    return mfs_record_decode(mfsp, mfsp->descriptors[id - 1U].offset,
+                             mfsp->descriptors[id - 1U].size,
+                             mfsp->buffer.dhdr.fields.crc,
+                             np, buffer);
+  }
+#endif
+
   /* Making sure to not overflow the buffer.*/
   if (*np < mfsp->descriptors[id - 1U].size) {
     return MFS_ERR_INV_SIZE;
   }
 
-  /* Header read from flash.*/
-  RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset,
-                              sizeof (mfs_data_header_t),
-                              mfsp->buffer.data8));
-
-  /* Data read from flash.*/
+  /* Header and data read from flash.*/
   *np = mfsp->descriptors[id - 1U].size;
-  RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset + sizeof (mfs_data_header_t),
-                              *np,
-                              buffer));
-
-  /* Checking CRC.*/
-  crc = crc16(0xFFFFU, buffer, *np);
-  if (crc != mfsp->buffer.dhdr.fields.crc) {
-    mfsp->state = MFS_ERROR;
-    return MFS_ERR_FLASH_FAILURE;
-  }
-
-  return MFS_NO_ERROR;
+  return mfs_record_read(mfsp, mfsp->descriptors[id - 1U].offset, *np, buffer);
 }
 
 /**
@@ -1005,18 +2128,25 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
 mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
                            size_t n, const uint8_t *buffer) {
   flash_offset_t free, asize, rspace;
+  uint32_t ssize;
 
   osalDbgCheck((mfsp != NULL) &&
                (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
                (n > 0U) && (buffer != NULL));
 
-  /* Aligned record size.*/
-  asize = ALIGNED_REC_SIZE(n);
+  /* Stored and aligned record sizes.*/
+  ssize = mfs_record_stored_size(mfsp, n, buffer);
+  asize = ALIGNED_REC_SIZE(ssize);
 
   /* Normal mode code path.*/
   if (mfsp->state == MFS_READY) {
     bool warning = false;
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* A partially copied record is completed before the update.*/
+    RET_ON_ERROR(mfs_gc_sync_record(mfsp));
+#endif
+
     /* If the required space is beyond the available (compacted) block
        size then an error is returned.
        NOTE: The space for one extra header is reserved in order to allow
@@ -1036,20 +2166,10 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
       RET_ON_ERROR(mfs_garbage_collect(mfsp));
     }
 
-    /* Writing the data header without the magic, it will be written last.*/
-    mfsp->buffer.dhdr.fields.id     = (uint16_t)id;
-    mfsp->buffer.dhdr.fields.size   = (uint32_t)n;
-    mfsp->buffer.dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
-    RET_ON_ERROR(mfs_flash_write(mfsp,
-                                 mfsp->next_offset + (sizeof (uint32_t) * 2U),
-                                 sizeof (mfs_data_header_t) - (sizeof (uint32_t) * 2U),
-                                 mfsp->buffer.data8 + (sizeof (uint32_t) * 2U)));
-
-    /* Writing the data part.*/
-    RET_ON_ERROR(mfs_flash_write(mfsp,
-                                 mfsp->next_offset + sizeof (mfs_data_header_t),
-                                 n,
-                                 buffer));
+    /* Writing the data header and the data part without the magic, it will
+       be written last.*/
+    RET_ON_ERROR(mfs_record_write(mfsp, mfsp->next_offset, id,
+                                  n, ssize, buffer));
 
     /* Finally writing the magic number, it seals the operation.*/
     mfsp->buffer.dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
@@ -1067,10 +2187,15 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
 
     /* Adjusting bank-related metadata.*/
     mfsp->descriptors[id - 1U].offset = mfsp->next_offset;
-    mfsp->descriptors[id - 1U].size   = (uint32_t)n;
+    mfsp->descriptors[id - 1U].size   = ssize;
     mfsp->next_offset += asize;
     mfsp->used_space  += asize;
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* Updates of already copied records are propagated.*/
+    RET_ON_ERROR(mfs_gc_sync_update(mfsp, mfsp->next_offset - asize));
+#endif
+
     return warning ? MFS_WARN_GC : MFS_NO_ERROR;
   }
 
@@ -1092,25 +2217,15 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
       return MFS_ERR_TRANSACTION_SIZE;
     }
 
-    /* Writing the data header without the magic, it will be written last.*/
-    mfsp->buffer.dhdr.fields.id     = (uint16_t)id;
-    mfsp->buffer.dhdr.fields.size   = (uint32_t)n;
-    mfsp->buffer.dhdr.fields.crc    = crc16(0xFFFFU, buffer, n);
-    RET_ON_ERROR(mfs_flash_write(mfsp,
-                                 mfsp->tr_next_offset + (sizeof (uint32_t) * 2U),
-                                 sizeof (mfs_data_header_t) - (sizeof (uint32_t) * 2U),
-                                 mfsp->buffer.data8 + (sizeof (uint32_t) * 2U)));
-
-    /* Writing the data part.*/
-    RET_ON_ERROR(mfs_flash_write(mfsp,
-                                 mfsp->tr_next_offset + sizeof (mfs_data_header_t),
-                                 n,
-                                 buffer));
+    /* Writing the data header and the data part without the magic, it will
+       be written on commit.*/
+    RET_ON_ERROR(mfs_record_write(mfsp, mfsp->tr_next_offset, id,
+                                  n, ssize, buffer));
 
     /* Adding a transaction operation record.*/
     top = &mfsp->tr_ops[mfsp->tr_nops];
     top->offset = mfsp->tr_next_offset;
-    top->size   = n;
+    top->size   = ssize;
     top->id     = id;
 
     /* Number of records and next write position updated.*/
@@ -1164,6 +2279,11 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
   if (mfsp->state == MFS_READY) {
     bool warning = false;
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* A partially copied record is completed before the update.*/
+    RET_ON_ERROR(mfs_gc_sync_record(mfsp));
+#endif
+
     /* Checking if the requested record actually exists.*/
     if (mfsp->descriptors[id - 1U].offset == 0U) {
       return MFS_ERR_NOT_FOUND;
@@ -1198,12 +2318,18 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
                                  sizeof (mfs_data_header_t),
                                  mfsp->buffer.data8));
 
-    /* Adjusting bank-related metadata.*/
+    /* Adjusting bank-related metadata, the next record starts on the
+       next aligned program unit.*/
     mfsp->used_space  -= ALIGNED_REC_SIZE(mfsp->descriptors[id - 1U].size);
-    mfsp->next_offset += sizeof (mfs_data_header_t);
+    mfsp->next_offset += asize;
     mfsp->descriptors[id - 1U].offset = 0U;
     mfsp->descriptors[id - 1U].size   = 0U;
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* Updates of already copied records are propagated.*/
+    RET_ON_ERROR(mfs_gc_sync_update(mfsp, mfsp->next_offset - asize));
+#endif
+
     return warning ? MFS_WARN_GC : MFS_NO_ERROR;
   }
 
@@ -1257,6 +2383,201 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
   return MFS_ERR_INV_STATE;
 }
 
+/**
+ * @brief   Creates or updates multiple data records.
+ * @details The records are written sequentially and sealed in reverse order
+ *          so that the whole operation is atomic, either all records are
+ *          updated or none of them. Space is checked and, if required, a
+ *          garbage collection is performed once for all records.
+ * @note    In transaction mode the records are simply added to the current
+ *          transaction.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] n         number of records to be written, it cannot be zero
+ * @param[in] records   array of record descriptors, the size fields contain
+ *                      the size of the data to be written, it cannot be zero
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if the operation has been successfully
+ *                                  completed.
+ * @retval MFS_WARN_GC              if the operation triggered a garbage
+ *                                  collection.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state.
+ * @retval MFS_ERR_OUT_OF_MEM       if there is not enough flash space for the
+ *                                  operation.
+ * @retval MFS_ERR_TRANSACTION_NUM  if the transaction operations buffer space
+ *                                  has been exceeded.
+ * @retval MFS_ERR_TRANSACTION_SIZE if the transaction allocated space
+ *                                  has been exceeded.
+ * @retval MFS_ERR_FLASH_FAILURE    if the flash memory is unusable because HW
+ *                                  failures. Makes the driver enter the
+ *                                  @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL         if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsWriteRecords(MFSDriver *mfsp, size_t n,
+                            const mfs_record_io_t *records) {
+  flash_offset_t free, rspace, offset;
+  size_t i;
+
+  osalDbgCheck((mfsp != NULL) && (n > 0U) && (records != NULL));
+
+  /* Normal mode code path.*/
+  if (mfsp->state == MFS_READY) {
+    bool warning = false;
+
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* A partially copied record is completed before the update.*/
+    RET_ON_ERROR(mfs_gc_sync_record(mfsp));
+#endif
+
+    /* Total aligned size of the records.*/
+    rspace = ALIGNED_DHDR_SIZE;
+    for (i = 0U; i < n; i++) {
+      osalDbgCheck((records[i].id >= 1U) &&
+                   (records[i].id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
+                   (records[i].size > 0U) && (records[i].buffer != NULL));
+
+      rspace += ALIGNED_REC_SIZE(mfs_record_stored_size(mfsp,
+                                                        records[i].size,
+                                                        records[i].buffer));
+    }
+
+    /* If the required space is beyond the available (compacted) block
+       size then an error is returned.
+       NOTE: The space for one extra header is reserved in order to allow
+       for an erase operation after the space has been fully allocated.*/
+    if (rspace > mfsp->config->bank_size - mfsp->used_space) {
+      return MFS_ERR_OUT_OF_MEM;
+    }
+
+    /* Checking for immediately (not compacted) available space.*/
+    free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
+            mfsp->config->bank_size) - mfsp->next_offset;
+    if (rspace > free) {
+      /* We need to perform a garbage collection, there is enough space
+         but it has to be freed.*/
+      warning = true;
+      RET_ON_ERROR(mfs_garbage_collect(mfsp));
+    }
+
+    /* Writing the records, all records except the first one are sealed
+       as they are written. The first one is sealed last and seals the
+       whole operation because the mount scan stops on its header.*/
+    offset = mfsp->next_offset;
+    for (i = 0U; i < n; i++) {
+      unsigned j = (unsigned)records[i].id - 1U;
+      uint32_t ssize = mfs_record_stored_size(mfsp, records[i].size,
+                                              records[i].buffer);
+
+      RET_ON_ERROR(mfs_record_write(mfsp, mfsp->next_offset, records[i].id,
+                                    records[i].size, ssize,
+                                    records[i].buffer));
+      if (i > 0U) {
+        mfsp->buffer.dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
+        mfsp->buffer.dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
+        RET_ON_ERROR(mfs_flash_write(mfsp,
+                                     mfsp->next_offset,
+                                     sizeof (uint32_t) * 2U,
+                                     mfsp->buffer.data8));
+      }
+
+      /* The size of the old record instance, if present, must be subtracted
+         to the total used size.*/
+      if (mfsp->descriptors[j].offset != 0U) {
+        mfsp->used_space -= ALIGNED_REC_SIZE(mfsp->descriptors[j].size);
+      }
+
+      /* Adjusting bank-related metadata.*/
+      mfsp->descriptors[j].offset = mfsp->next_offset;
+      mfsp->descriptors[j].size   = ssize;
+      mfsp->next_offset += ALIGNED_REC_SIZE(ssize);
+      mfsp->used_space  += ALIGNED_REC_SIZE(ssize);
+    }
+
+    /* Finally writing the magic number of the first record.*/
+    mfsp->buffer.dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
+    mfsp->buffer.dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
+    RET_ON_ERROR(mfs_flash_write(mfsp,
+                                 offset,
+                                 sizeof (uint32_t) * 2U,
+                                 mfsp->buffer.data8));
+
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+    /* Updates of already copied records are propagated.*/
+    RET_ON_ERROR(mfs_gc_sync_update(mfsp, offset));
+#endif
+
+    return warning ? MFS_WARN_GC : MFS_NO_ERROR;
+  }
+
+#if MFS_CFG_TRANSACTION_MAX > 0
+  /* Transaction mode code path.*/
+  if (mfsp->state == MFS_TRANSACTION) {
+
+    for (i = 0U; i < n; i++) {
+      RET_ON_ERROR(mfsWriteRecord(mfsp, records[i].id,
+                                  records[i].size, records[i].buffer));
+    }
+
+    return MFS_NO_ERROR;
+  }
+#endif /* MFS_CFG_TRANSACTION_MAX > 0 */
+
+  /* Invalid state.*/
+  return MFS_ERR_INV_STATE;
+}
+
+/**
+ * @brief   Retrieves and reads multiple data records.
+ * @note    Records not found are reported with size zero and do not stop
+ *          the operation, any other error stops the operation.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] n         number of records to be read, it cannot be zero
+ * @param[in,out] records array of record descriptors, on input the size
+ *                      fields are the buffers sizes, on return they are the
+ *                      sizes of the data copied into the buffers
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if the operation has been successfully
+ *                                  completed.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state.
+ * @retval MFS_ERR_INV_SIZE         if a passed buffer is not large enough to
+ *                                  contain the record data.
+ * @retval MFS_ERR_NOT_FOUND        if one or more records do not exist.
+ * @retval MFS_ERR_FLASH_FAILURE    if the flash memory is unusable because HW
+ *                                  failures. Makes the driver enter the
+ *                                  @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL         if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsReadRecords(MFSDriver *mfsp, size_t n,
+                           mfs_record_io_t *records) {
+  mfs_error_t err = MFS_NO_ERROR;
+  size_t i;
+
+  osalDbgCheck((mfsp != NULL) && (n > 0U) && (records != NULL));
+
+  for (i = 0U; i < n; i++) {
+    mfs_error_t e;
+
+    e = mfsReadRecord(mfsp, records[i].id, &records[i].size,
+                      records[i].buffer);
+    if (e == MFS_ERR_NOT_FOUND) {
+      records[i].size = 0U;
+      err = MFS_ERR_NOT_FOUND;
+    }
+    else if (e != MFS_NO_ERROR) {
+      return e;
+    }
+  }
+
+  return err;
+}
+
 /**
  * @brief   Enforces a garbage collection operation.
  * @details Garbage collection involves: integrity check, optionally repairs,
@@ -1327,6 +2648,14 @@ mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size) {
     return MFS_ERR_INV_STATE;
   }
 
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+  /* Transactions cannot overlap the copy phase of an incremental garbage
+     collection, it is completed first.*/
+  if (mfsp->gc_phase == MFS_GC_COPY) {
+    RET_ON_ERROR(mfs_gc_complete(mfsp));
+  }
+#endif
+
   /* Estimating the required contiguous compacted space.*/
   tspace = (flash_offset_t)MFS_ALIGN_NEXT(size);
   rspace = tspace + ALIGNED_DHDR_SIZE;
@@ -1479,4 +2808,155 @@ mfs_error_t mfsRollbackTransaction(MFSDriver *mfsp) {
 }
 #endif /* MFS_CFG_TRANSACTION_MAX > 0 */
 
+#if (MFS_CFG_USE_CHECKPOINTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Writes a checkpoint record.
+ * @details The checkpoint record contains the current records index, on
+ *          mount the records written before the checkpoint are not read.
+ * @note    Checkpoints are not preserved by garbage collection, it is up
+ *          to the application to write a new one when convenient.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if the operation has been successfully
+ *                                  completed.
+ * @retval MFS_WARN_GC              if the operation triggered a garbage
+ *                                  collection.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state.
+ * @retval MFS_ERR_OUT_OF_MEM       if there is not enough flash space for the
+ *                                  operation.
+ * @retval MFS_ERR_FLASH_FAILURE    if the flash memory is unusable because HW
+ *                                  failures. Makes the driver enter the
+ *                                  @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL         if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsWriteCheckpoint(MFSDriver *mfsp) {
+  flash_offset_t free, asize, rspace;
+  bool warning = false;
+
+  osalDbgCheck(mfsp != NULL);
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  /* Aligned record size.*/
+  asize = ALIGNED_REC_SIZE(CHECKPOINT_SIZE);
+
+  /* If the required space is beyond the available (compacted) block
+     size then an error is returned.*/
+  rspace = ALIGNED_DHDR_SIZE + asize;
+  if (rspace > mfsp->config->bank_size - mfsp->used_space) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+
+  /* Checking for immediately (not compacted) available space.*/
+  free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
+          mfsp->config->bank_size) - mfsp->next_offset;
+  if (rspace > free) {
+    /* We need to perform a garbage collection, there is enough space
+       but it has to be freed.*/
+    warning = true;
+    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+  }
+
+  /* Writing the checkpoint record, the magic is written last.*/
+  RET_ON_ERROR(mfs_record_write(mfsp, mfsp->next_offset, CHECKPOINT_ID,
+                                CHECKPOINT_SIZE, CHECKPOINT_SIZE,
+                                (const uint8_t *)mfsp->descriptors));
+  mfsp->buffer.dhdr.fields.magic1 = (uint32_t)MFS_HEADER_MAGIC_1;
+  mfsp->buffer.dhdr.fields.magic2 = (uint32_t)MFS_HEADER_MAGIC_2;
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               mfsp->next_offset,
+                               sizeof (uint32_t) * 2U,
+                               mfsp->buffer.data8));
+
+  /* The checkpoint does not count as used space, it is not preserved by
+     garbage collection.*/
+  mfsp->next_offset += asize;
+
+  return warning ? MFS_WARN_GC : MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_USE_CHECKPOINTS == TRUE */
+
+#if (MFS_CFG_USE_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a step of an incremental garbage collection.
+ * @details A garbage collection is started if none is in progress, each
+ *          step copies at most @p budget bytes or erases one sector.
+ *          Records can be read, written and erased between steps.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] budget    maximum number of bytes to be copied in this step,
+ *                      it cannot be zero
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if the garbage collection has been
+ *                                  completed.
+ * @retval MFS_WARN_GC_PENDING      if more steps are required in order to
+ *                                  complete the garbage collection.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state.
+ * @retval MFS_ERR_FLASH_FAILURE    if the flash memory is unusable because HW
+ *                                  failures. Makes the driver enter the
+ *                                  @p MFS_ERROR state.
+ *
+ * @api
+ */
+mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp, size_t budget) {
+
+  osalDbgCheck((mfsp != NULL) && (budget > 0U));
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  return mfs_gc_step(mfsp, (uint32_t)budget);
+}
+#endif /* MFS_CFG_USE_INCREMENTAL_GC == TRUE */
+
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checkpoints the records index for a warm restart.
+ * @details The state is saved in the configured warm restart slot, the
+ *          next mount uses it instead of scanning the flash. Any flash
+ *          modification invalidates the slot so this function should be
+ *          called after a burst of writes or before a planned reset.
+ * @note    The state is saved on mount, calling this function is not
+ *          required if the storage is not modified afterward.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR             if the operation has been successfully
+ *                                  completed.
+ * @retval MFS_ERR_INV_STATE        if the driver is in not in @p MFS_READY
+ *                                  state, if a warm restart driver is not
+ *                                  configured or if a garbage collection
+ *                                  is in progress.
+ *
+ * @api
+ */
+mfs_error_t mfsSaveWarmState(MFSDriver *mfsp) {
+
+  osalDbgCheck(mfsp != NULL);
+
+  if ((mfsp->state != MFS_READY) || (mfsp->config->wrp == NULL)) {
+    return MFS_ERR_INV_STATE;
+  }
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+  if (mfsp->gc_phase != MFS_GC_IDLE) {
+    return MFS_ERR_INV_STATE;
+  }
+#endif
+
+  if (!mfsp->warm_valid) {
+    mfs_warm_save(mfsp);
+  }
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_USE_WARM_RESTART == TRUE */
+
 /** @} */
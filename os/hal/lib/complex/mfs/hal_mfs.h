@@ -107,6 +107,60 @@
 #if !defined(MFS_CFG_TRANSACTION_MAX) || defined(__DOXYGEN__)
 #define MFS_CFG_TRANSACTION_MAX             16
 #endif
+
+/**
+ * @brief   Enables checkpoint records.
+ * @details A checkpoint record stores the whole records index, on mount
+ *          the records preceding the most recent checkpoint are only
+ *          traversed by header, their data is not read. Data errors in
+ *          those records are detected on read.
+ */
+#if !defined(MFS_CFG_USE_CHECKPOINTS) || defined(__DOXYGEN__)
+#define MFS_CFG_USE_CHECKPOINTS             FALSE
+#endif
+
+/**
+ * @brief   Enables incremental garbage collection.
+ * @details If enabled then a garbage collection can be performed in
+ *          bounded steps using @p mfsPerformGarbageCollectionStep(), records
+ *          can be written and erased between steps.
+ */
+#if !defined(MFS_CFG_USE_INCREMENTAL_GC) || defined(__DOXYGEN__)
+#define MFS_CFG_USE_INCREMENTAL_GC          FALSE
+#endif
+
+/**
+ * @brief   Enables the warm restart of the records index.
+ * @details If enabled then the mounted state is checkpointed in a slot of
+ *          a warm restart driver, after a reset the storage is mounted
+ *          from the slot without scanning the flash. The slot is
+ *          invalidated on the first flash modification and saved again
+ *          by @p mfsSaveWarmState().
+ */
+#if !defined(MFS_CFG_USE_WARM_RESTART) || defined(__DOXYGEN__)
+#define MFS_CFG_USE_WARM_RESTART            FALSE
+#endif
+
+/**
+ * @brief   Enables records compression.
+ * @details If enabled then records of at least
+ *          @p MFS_CFG_COMPRESSION_THRESHOLD bytes are stored compressed
+ *          when this saves flash space, fewer writes and garbage
+ *          collections are performed. Compression is transparent, records
+ *          are returned with their original size and content.
+ * @note    Matches are searched in the record data itself so no additional
+ *          RAM is required, writing large records takes more time.
+ */
+#if !defined(MFS_CFG_USE_COMPRESSION) || defined(__DOXYGEN__)
+#define MFS_CFG_USE_COMPRESSION             FALSE
+#endif
+
+/**
+ * @brief   Minimum size of records to be compressed.
+ */
+#if !defined(MFS_CFG_COMPRESSION_THRESHOLD) || defined(__DOXYGEN__)
+#define MFS_CFG_COMPRESSION_THRESHOLD       64
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -144,6 +198,18 @@
 #error "invalid MFS_CFG_TRANSACTION_MAX value"
 #endif
 
+#if (MFS_CFG_USE_COMPRESSION == TRUE) && (MFS_CFG_MAX_RECORDS > 32767)
+#error "MFS_CFG_USE_COMPRESSION requires MFS_CFG_MAX_RECORDS below 32768"
+#endif
+
+#if MFS_CFG_COMPRESSION_THRESHOLD < 8
+#error "invalid MFS_CFG_COMPRESSION_THRESHOLD value"
+#endif
+
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+#include "hal_warm_restart.h"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -176,6 +242,7 @@ typedef enum {
   MFS_NO_ERROR = 0,
   MFS_WARN_REPAIR = 1,
   MFS_WARN_GC = 2,
+  MFS_WARN_GC_PENDING = 3,
   MFS_ERR_INV_STATE = -1,
   MFS_ERR_INV_SIZE = -2,
   MFS_ERR_NOT_FOUND = -3,
@@ -196,6 +263,15 @@ typedef enum {
   MFS_BANK_GARBAGE = 2
 } mfs_bank_state_t;
 
+/**
+ * @brief   Type of an incremental garbage collection phase.
+ */
+typedef enum {
+  MFS_GC_IDLE = 0,
+  MFS_GC_COPY = 1,
+  MFS_GC_ERASE = 2
+} mfs_gc_phase_t;
+
 /**
  * @brief   Type of a record identifier.
  */
@@ -250,6 +326,7 @@ typedef union {
     uint32_t                magic2;
     /**
      * @brief   Record identifier.
+     * @note    The most significant bit marks compressed records.
      */
     uint16_t                id;
     /**
@@ -273,10 +350,30 @@ typedef struct {
   flash_offset_t            offset;
   /**
    * @brief   Record data size.
+   * @note    This is the stored size, it is smaller than the original
+   *          size for compressed records.
    */
   uint32_t                  size;
 } mfs_record_descriptor_t;
 
+/**
+ * @brief   Type of a record descriptor for multiple records operations.
+ */
+typedef struct {
+  /**
+   * @brief   Record identifier.
+   */
+  mfs_id_t                  id;
+  /**
+   * @brief   Record data size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Record data buffer.
+   */
+  uint8_t                   *buffer;
+} mfs_record_io_t;
+
 /**
  * @brief   Type of a MFS configuration structure.
  */
@@ -295,6 +392,10 @@ typedef struct {
   flash_offset_t            bank_size;
   /**
    * @brief   Base sector index for bank 0.
+   * @note    On dual-bank embedded flashes both MFS banks should be placed
+   *          on the flash bank the code is not executed from, see
+   *          @p eflGetConcurrentSectors(), so that erase and program
+   *          operations do not stall the CPU.
    */
   flash_sector_t            bank0_start;
   /**
@@ -313,6 +414,30 @@ typedef struct {
    *          @p bank_size.
    */
   flash_sector_t            bank1_sectors;
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   CRC driver used for records and headers integrity or @p NULL
+   *          for the software implementation.
+   * @note    The driver must be started before @p mfsStart() with the
+   *          CRC-16/CCITT configuration: polynomial 0x1021, 16 bits, not
+   *          reflected.
+   * @note    The driver can be shared with other users if the option
+   *          @p CRC_USE_MUTUAL_EXCLUSION is enabled.
+   */
+  CRCDriver                 *crcp;
+#endif
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Warm restart driver holding the state or @p NULL.
+   * @note    The driver must be started before @p mfsStart().
+   */
+  WRDriver                  *wrp;
+  /**
+   * @brief   Warm restart slot index.
+   * @note    The slot size must be @p sizeof(mfs_warm_state_t).
+   */
+  size_t                    wr_slot;
+#endif
 } MFSConfig;
 
 /**
@@ -333,6 +458,34 @@ typedef struct {
   mfs_id_t                  id;
 } mfs_transaction_op_t;
 
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a retained MFS state.
+ */
+typedef struct {
+  /**
+   * @brief   Bank in use.
+   */
+  mfs_bank_t                bank;
+  /**
+   * @brief   Usage counter of the bank in use.
+   */
+  uint32_t                  counter;
+  /**
+   * @brief   Next free position in the bank.
+   */
+  flash_offset_t            next_offset;
+  /**
+   * @brief   Used space in the bank.
+   */
+  flash_offset_t            used_space;
+  /**
+   * @brief   Records index.
+   */
+  mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+} mfs_warm_state_t;
+#endif
+
 /**
  * @brief   Type of an MFS instance.
  */
@@ -383,6 +536,38 @@ typedef struct {
    * @brief   Buffered operations in current transaction.
    */
   mfs_transaction_op_t      tr_ops[MFS_CFG_TRANSACTION_MAX];
+#endif
+#if (MFS_CFG_USE_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Incremental garbage collection phase.
+   */
+  mfs_gc_phase_t            gc_phase;
+  /**
+   * @brief   Index of the record being copied.
+   */
+  uint32_t                  gc_index;
+  /**
+   * @brief   Already copied size of the record being copied.
+   */
+  uint32_t                  gc_copied;
+  /**
+   * @brief   Next write offset in the destination bank.
+   */
+  flash_offset_t            gc_next_offset;
+  /**
+   * @brief   Next sector to be erased relative to the bank start.
+   */
+  flash_sector_t            gc_sector;
+  /**
+   * @brief   Offsets of the copied records in the destination bank.
+   */
+  flash_offset_t            gc_offsets[MFS_CFG_MAX_RECORDS];
+#endif
+#if (MFS_CFG_USE_WARM_RESTART == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   The retained state matches the flash content.
+   */
+  bool                      warm_valid;
 #endif
   /**
    * @brief   Transient buffer.
@@ -435,12 +620,25 @@ extern "C" {
   mfs_error_t mfsWriteRecord(MFSDriver *devp, mfs_id_t id,
                              size_t n, const uint8_t *buffer);
   mfs_error_t mfsEraseRecord(MFSDriver *devp, mfs_id_t id);
+  mfs_error_t mfsWriteRecords(MFSDriver *mfsp, size_t n,
+                              const mfs_record_io_t *records);
+  mfs_error_t mfsReadRecords(MFSDriver *mfsp, size_t n,
+                             mfs_record_io_t *records);
   mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp);
 #if MFS_CFG_TRANSACTION_MAX > 0
   mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size);
   mfs_error_t mfsCommitTransaction(MFSDriver *mfsp);
   mfs_error_t mfsRollbackTransaction(MFSDriver *mfsp);
 #endif /* MFS_CFG_TRANSACTION_MAX > 0 */
+#if MFS_CFG_USE_CHECKPOINTS == TRUE
+  mfs_error_t mfsWriteCheckpoint(MFSDriver *mfsp);
+#endif /* MFS_CFG_USE_CHECKPOINTS == TRUE */
+#if MFS_CFG_USE_INCREMENTAL_GC == TRUE
+  mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp, size_t budget);
+#endif /* MFS_CFG_USE_INCREMENTAL_GC == TRUE */
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+  mfs_error_t mfsSaveWarmState(MFSDriver *mfsp);
+#endif /* MFS_CFG_USE_WARM_RESTART == TRUE */
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,366 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_pal_monitor.c
+ * @brief   Debounced PAL inputs monitor code.
+ * @details This module monitors a set of digital inputs, edges are not
+ *          delivered individually, the inputs are sampled by a timer
+ *          until stable for a debounce window and the accumulated changes
+ *          are delivered as per-port masks to a waiting thread.
+ *
+ * @addtogroup HAL_PAL_MONITOR
+ * @{
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "hal.h"
+
+#include "hal_pal_monitor.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Samples the monitored ports.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ * @param[out] dst      sampled state
+ * @param[in] ref       reference state
+ * @return              The comparison result.
+ * @retval false        if the sampled state is equal to the reference.
+ * @retval true         if the sampled state differs from the reference.
+ *
+ * @notapi
+ */
+static bool pmon_sample(PMONDriver *pmp, ioportmask_t *dst,
+                        const ioportmask_t *ref) {
+  const PMONConfig *config = pmp->config;
+  bool differ = false;
+  unsigned i;
+
+  for (i = 0U; i < config->nports; i++) {
+    dst[i] = palReadPort(config->ports[i].port) & config->ports[i].mask;
+    if (dst[i] != ref[i]) {
+      differ = true;
+    }
+  }
+
+  return differ;
+}
+
+/**
+ * @brief   Disables the events of all the trigger lines.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ *
+ * @notapi
+ */
+static void pmon_disable_events_i(PMONDriver *pmp) {
+  unsigned i;
+
+  for (i = 0U; i < pmp->config->nlines; i++) {
+    palDisableLineEventI(pmp->config->lines[i]);
+  }
+}
+
+/**
+ * @brief   Edge callback of the trigger lines.
+ *
+ * @param[in] arg       pointer to the @p PMONDriver object
+ *
+ * @notapi
+ */
+static void pmon_line_cb(void *arg) {
+  PMONDriver *pmp = (PMONDriver *)arg;
+
+  osalSysLockFromISR();
+  pmp->edges++;
+  if (pmp->state == PMON_READY) {
+    /* No more edge interrupts until the inputs are stable.*/
+    pmon_disable_events_i(pmp);
+    memcpy(pmp->last, pmp->stable, sizeof pmp->last);
+    pmp->state = PMON_FILTERING;
+    gptStartOneShotI(pmp->config->gptp, pmp->config->window);
+  }
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Enables the events of all the trigger lines.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ *
+ * @notapi
+ */
+static void pmon_enable_events_i(PMONDriver *pmp) {
+  unsigned i;
+
+  for (i = 0U; i < pmp->config->nlines; i++) {
+    palEnableLineEventI(pmp->config->lines[i], PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallbackI(pmp->config->lines[i], pmon_line_cb, (void *)pmp);
+  }
+}
+
+/**
+ * @brief   Debounce window callback.
+ *
+ * @param[in] gptp      pointer to the @p GPTDriver object
+ *
+ * @notapi
+ */
+static void pmon_gpt_cb(GPTDriver *gptp) {
+  PMONDriver *pmp;
+  ioportmask_t cur[PMON_CFG_MAX_PORTS];
+  bool changed = false;
+  unsigned i;
+
+  /* The monitor owns the GPT configuration.*/
+  pmp = (PMONDriver *)((const uint8_t *)gptp->config -
+                       offsetof(PMONDriver, gptcfg));
+
+  osalSysLockFromISR();
+  if ((pmp->state != PMON_READY) && (pmp->state != PMON_FILTERING)) {
+    osalSysUnlockFromISR();
+    return;
+  }
+  pmp->samples++;
+
+  /* Inputs still moving, another window is required.*/
+  if (pmon_sample(pmp, cur, pmp->last)) {
+    memcpy(pmp->last, cur, sizeof pmp->last);
+    if (pmp->config->nlines > 0U) {
+      gptStartOneShotI(gptp, pmp->config->window);
+    }
+    osalSysUnlockFromISR();
+    return;
+  }
+
+  /* Inputs stable for a whole window, accepting changes.*/
+  for (i = 0U; i < pmp->config->nports; i++) {
+    ioportmask_t diff = cur[i] ^ pmp->stable[i];
+
+    if (diff != 0U) {
+      pmp->stable[i]   = cur[i];
+      pmp->changes[i] |= diff;
+      changed = true;
+    }
+  }
+
+  if (pmp->config->nlines > 0U) {
+    /* Back to edge detection, edges occurred before enabling the events
+       are caught by sampling again.*/
+    pmon_enable_events_i(pmp);
+    if (pmon_sample(pmp, pmp->last, pmp->stable)) {
+      pmon_disable_events_i(pmp);
+      gptStartOneShotI(gptp, pmp->config->window);
+    }
+    else {
+      pmp->state = PMON_READY;
+    }
+  }
+
+  if (changed) {
+    osalThreadResumeI(&pmp->thread, MSG_OK);
+  }
+  osalSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] pmp      pointer to the @p PMONDriver object
+ *
+ * @init
+ */
+void pmonObjectInit(PMONDriver *pmp) {
+
+  osalDbgCheck(pmp != NULL);
+
+  pmp->state   = PMON_STOP;
+  pmp->config  = NULL;
+  pmp->thread  = NULL;
+  pmp->edges   = 0U;
+  pmp->samples = 0U;
+}
+
+/**
+ * @brief   Configures and activates a monitor.
+ * @details The current inputs state is taken as the initial debounced
+ *          state.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void pmonStart(PMONDriver *pmp, const PMONConfig *config) {
+
+  osalDbgCheck((pmp != NULL) && (config != NULL) &&
+               (config->gptp != NULL) && (config->window > 0U) &&
+               (config->nports > 0U) &&
+               (config->nports <= (unsigned)PMON_CFG_MAX_PORTS) &&
+               ((config->lines != NULL) || (config->nlines == 0U)));
+
+  osalDbgAssert(pmp->state == PMON_STOP, "invalid state");
+
+  pmp->config = config;
+  memset(&pmp->gptcfg, 0, sizeof pmp->gptcfg);
+  pmp->gptcfg.frequency = config->frequency;
+  pmp->gptcfg.callback  = pmon_gpt_cb;
+  gptStart(config->gptp, &pmp->gptcfg);
+
+  memset(pmp->changes, 0, sizeof pmp->changes);
+  memset(pmp->stable, 0, sizeof pmp->stable);
+  (void) pmon_sample(pmp, pmp->stable, pmp->stable);
+  memcpy(pmp->last, pmp->stable, sizeof pmp->last);
+
+  osalSysLock();
+  pmp->state = PMON_READY;
+  if (config->nlines > 0U) {
+    pmon_enable_events_i(pmp);
+  }
+  else {
+    gptStartContinuousI(config->gptp, config->window);
+  }
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Deactivates a monitor.
+ * @details A thread waiting for changes is resumed with @p MSG_RESET.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ *
+ * @api
+ */
+void pmonStop(PMONDriver *pmp) {
+
+  osalDbgCheck(pmp != NULL);
+
+  osalDbgAssert((pmp->state == PMON_STOP) || (pmp->state == PMON_READY) ||
+                (pmp->state == PMON_FILTERING), "invalid state");
+
+  if (pmp->state != PMON_STOP) {
+    osalSysLock();
+    pmon_disable_events_i(pmp);
+    gptStopTimerI(pmp->config->gptp);
+    pmp->state = PMON_STOP;
+    osalThreadResumeI(&pmp->thread, MSG_RESET);
+    osalOsRescheduleS();
+    osalSysUnlock();
+
+    gptStop(pmp->config->gptp);
+    pmp->config = NULL;
+  }
+}
+
+/**
+ * @brief   Waits for input changes.
+ * @details The changes accumulated since the previous call are returned
+ *          as one mask per configured port, a set bit means that the
+ *          debounced state of the pad changed an odd number of times.
+ *          The accumulated changes are cleared.
+ * @note    Only one thread can wait on an instance.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ * @param[out] changes  array receiving one change mask per configured port
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if changes have been returned.
+ * @retval MSG_TIMEOUT  if no changes occurred within the timeout.
+ * @retval MSG_RESET    if the monitor has been stopped.
+ *
+ * @api
+ */
+msg_t pmonWaitChangesTimeout(PMONDriver *pmp, ioportmask_t *changes,
+                             sysinterval_t timeout) {
+  msg_t msg = MSG_OK;
+  bool pending = false;
+  unsigned i;
+
+  osalDbgCheck((pmp != NULL) && (changes != NULL));
+
+  osalSysLock();
+  osalDbgAssert((pmp->state == PMON_READY) || (pmp->state == PMON_FILTERING),
+                "invalid state");
+
+  for (i = 0U; i < pmp->config->nports; i++) {
+    if (pmp->changes[i] != 0U) {
+      pending = true;
+    }
+  }
+  if (!pending) {
+    msg = osalThreadSuspendTimeoutS(&pmp->thread, timeout);
+  }
+
+  if (msg == MSG_OK) {
+    for (i = 0U; i < pmp->config->nports; i++) {
+      changes[i]      = pmp->changes[i];
+      pmp->changes[i] = 0U;
+    }
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Returns the debounced inputs state.
+ *
+ * @param[in] pmp       pointer to the @p PMONDriver object
+ * @param[out] state    array receiving one state mask per configured port
+ *
+ * @iclass
+ */
+void pmonGetStateI(PMONDriver *pmp, ioportmask_t *state) {
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((pmp != NULL) && (state != NULL));
+
+  osalDbgAssert((pmp->state == PMON_READY) || (pmp->state == PMON_FILTERING),
+                "invalid state");
+
+  for (i = 0U; i < pmp->config->nports; i++) {
+    state[i] = pmp->stable[i];
+  }
+}
+
+/** @} */
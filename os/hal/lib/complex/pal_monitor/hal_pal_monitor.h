@@ -0,0 +1,213 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_pal_monitor.h
+ * @brief   Debounced PAL inputs monitor header.
+ *
+ * @addtogroup HAL_PAL_MONITOR
+ * @{
+ */
+
+#ifndef HAL_PAL_MONITOR_H
+#define HAL_PAL_MONITOR_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Maximum number of ports monitored by an instance.
+ */
+#if !defined(PMON_CFG_MAX_PORTS) || defined(__DOXYGEN__)
+#define PMON_CFG_MAX_PORTS                  4
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_PAL != TRUE
+#error "PAL monitor requires HAL_USE_PAL"
+#endif
+
+#if PAL_USE_CALLBACKS != TRUE
+#error "PAL monitor requires PAL_USE_CALLBACKS"
+#endif
+
+#if HAL_USE_GPT != TRUE
+#error "PAL monitor requires HAL_USE_GPT"
+#endif
+
+#if PMON_CFG_MAX_PORTS < 1
+#error "invalid PMON_CFG_MAX_PORTS value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  PMON_UNINIT = 0,
+  PMON_STOP = 1,
+  PMON_READY = 2,
+  PMON_FILTERING = 3
+} pmon_state_t;
+
+/**
+ * @brief   Type of a monitored port.
+ */
+typedef struct {
+  /**
+   * @brief   Port identifier.
+   */
+  ioportid_t                port;
+  /**
+   * @brief   Mask of the monitored pads.
+   */
+  ioportmask_t              mask;
+} pmon_port_t;
+
+/**
+ * @brief   Type of a PAL monitor configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   GPT driver used for the debounce window.
+   * @note    The driver is reserved to the monitor.
+   */
+  GPTDriver                 *gptp;
+  /**
+   * @brief   GPT clock frequency.
+   */
+  gptfreq_t                 frequency;
+  /**
+   * @brief   Debounce window in GPT ticks.
+   * @details Inputs must be stable for a whole window in order for their
+   *          changes to be accepted.
+   */
+  gptcnt_t                  window;
+  /**
+   * @brief   Monitored ports.
+   */
+  const pmon_port_t         *ports;
+  /**
+   * @brief   Number of monitored ports.
+   */
+  unsigned                  nports;
+  /**
+   * @brief   Lines triggering a debounce window or @p NULL.
+   * @details An edge on any of these lines disables the events of all the
+   *          lines and starts sampling the ports at the window rate until
+   *          the inputs are stable, this limits the IRQ rate of chattering
+   *          inputs to one per window.
+   * @note    If no lines are specified then the ports are continuously
+   *          sampled at the window rate.
+   * @note    On some platforms lines with the same pad number cannot have
+   *          events enabled at the same time, inputs without an event line
+   *          are still captured by the sampling triggered by other lines.
+   */
+  const ioline_t            *lines;
+  /**
+   * @brief   Number of trigger lines.
+   */
+  unsigned                  nlines;
+} PMONConfig;
+
+/**
+ * @brief   Type of a PAL monitor instance.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  pmon_state_t              state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const PMONConfig          *config;
+  /**
+   * @brief   GPT configuration derived from the monitor configuration.
+   */
+  GPTConfig                 gptcfg;
+  /**
+   * @brief   Waiting thread.
+   */
+  thread_reference_t        thread;
+  /**
+   * @brief   Debounced inputs state.
+   */
+  ioportmask_t              stable[PMON_CFG_MAX_PORTS];
+  /**
+   * @brief   Last sampled inputs state.
+   */
+  ioportmask_t              last[PMON_CFG_MAX_PORTS];
+  /**
+   * @brief   Accumulated changes not yet delivered.
+   */
+  ioportmask_t              changes[PMON_CFG_MAX_PORTS];
+  /**
+   * @brief   Number of edge interrupts served.
+   */
+  uint32_t                  edges;
+  /**
+   * @brief   Number of debounce window interrupts served.
+   */
+  uint32_t                  samples;
+} PMONDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void pmonObjectInit(PMONDriver *pmp);
+  void pmonStart(PMONDriver *pmp, const PMONConfig *config);
+  void pmonStop(PMONDriver *pmp);
+  msg_t pmonWaitChangesTimeout(PMONDriver *pmp, ioportmask_t *changes,
+                               sysinterval_t timeout);
+  void pmonGetStateI(PMONDriver *pmp, ioportmask_t *state);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_PAL_MONITOR_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the PAL monitor files.
+PMONSRC := $(CHIBIOS)/os/hal/lib/complex/pal_monitor/hal_pal_monitor.c
+
+# Required include directories
+PMONINC := $(CHIBIOS)/os/hal/lib/complex/pal_monitor
+
+# Shared variables
+ALLCSRC += $(PMONSRC)
+ALLINC  += $(PMONINC)
@@ -0,0 +1,365 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_ram_flash.c
+ * @brief   RAM flash emulator code.
+ *
+ * @addtogroup HAL_RAM_FLASH
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "hal_ram_flash.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Erased bytes value.
+ */
+#define RFL_ERASED(devp)                                                    \
+  ((((devp)->config->attributes & FLASH_ATTR_ERASED_IS_ONE) != 0U) ?        \
+   (uint8_t)0xFFU : (uint8_t)0x00U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+static const flash_descriptor_t *rfl_get_descriptor(void *instance);
+static flash_error_t rfl_read(void *instance, flash_offset_t offset,
+                              size_t n, uint8_t *rp);
+static flash_error_t rfl_program(void *instance, flash_offset_t offset,
+                                 size_t n, const uint8_t *pp);
+static flash_error_t rfl_start_erase_all(void *instance);
+static flash_error_t rfl_start_erase_sector(void *instance,
+                                            flash_sector_t sector);
+static flash_error_t rfl_query_erase(void *instance, uint32_t *msec);
+static flash_error_t rfl_verify_erase(void *instance, flash_sector_t sector);
+static flash_error_t rfl_suspend_erase(void *instance);
+static flash_error_t rfl_resume_erase(void *instance);
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct RFLDriverVMT rfl_vmt = {
+  (size_t)0,
+  rfl_get_descriptor, rfl_read, rfl_program,
+  rfl_start_erase_all, rfl_start_erase_sector,
+  rfl_query_erase, rfl_verify_erase,
+  rfl_suspend_erase, rfl_resume_erase
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static const flash_descriptor_t *rfl_get_descriptor(void *instance) {
+  RFLDriver *devp = (RFLDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert(devp->state != FLASH_UNINIT, "invalid state");
+
+  return &devp->descriptor;
+}
+
+static flash_error_t rfl_read(void *instance, flash_offset_t offset,
+                              size_t n, uint8_t *rp) {
+  RFLDriver *devp = (RFLDriver *)instance;
+
+  osalDbgCheck((instance != NULL) && (rp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)devp->descriptor.size);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  memcpy(rp, &devp->config->buffer[offset], n);
+
+  devp->stats.time += (uint64_t)devp->config->read_setup +
+                      ((uint64_t)devp->config->read_byte * (uint64_t)n);
+  devp->stats.reads++;
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_program(void *instance, flash_offset_t offset,
+                                 size_t n, const uint8_t *pp) {
+  RFLDriver *devp = (RFLDriver *)instance;
+  uint8_t *p, erased;
+  uint32_t pages;
+  size_t i;
+
+  osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= (size_t)devp->descriptor.size);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  p      = &devp->config->buffer[offset];
+  erased = RFL_ERASED(devp);
+  if ((devp->config->attributes & FLASH_ATTR_ECC_CAPABLE) != 0U) {
+
+    /* ECC devices program whole aligned pages and only once.*/
+    osalDbgCheck(((offset % devp->config->page_size) == 0U) &&
+                 ((n % devp->config->page_size) == 0U));
+
+    for (i = 0U; i < n; i++) {
+      if (p[i] != erased) {
+        return FLASH_ERROR_PROGRAM;
+      }
+    }
+    memcpy(p, pp, n);
+  }
+  else {
+    /* NOR behavior, bits can only be moved away from the erased state.*/
+    for (i = 0U; i < n; i++) {
+      if (erased == (uint8_t)0xFFU) {
+        p[i] &= pp[i];
+      }
+      else {
+        p[i] |= pp[i];
+      }
+    }
+  }
+
+  pages = (uint32_t)(((offset + n - 1U) / devp->config->page_size) -
+                     (offset / devp->config->page_size)) + 1U;
+  devp->stats.time += (uint64_t)devp->config->program_setup +
+                      ((uint64_t)devp->config->program_page * (uint64_t)pages);
+  devp->stats.programs++;
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_start_erase_all(void *instance) {
+  RFLDriver *devp = (RFLDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  memset(devp->config->buffer, RFL_ERASED(devp), devp->descriptor.size);
+
+  devp->stats.time   += (uint64_t)devp->config->erase_sector *
+                        (uint64_t)devp->config->sectors_count;
+  devp->stats.erases += devp->config->sectors_count;
+
+  /* The operation is completed by the next query.*/
+  devp->state = FLASH_ERASE;
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_start_erase_sector(void *instance,
+                                            flash_sector_t sector) {
+  RFLDriver *devp = (RFLDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < devp->config->sectors_count);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  memset(&devp->config->buffer[sector * devp->config->sectors_size],
+         RFL_ERASED(devp), devp->config->sectors_size);
+
+  devp->stats.time += (uint64_t)devp->config->erase_sector;
+  devp->stats.erases++;
+
+  /* The operation is completed by the next query.*/
+  devp->state = FLASH_ERASE;
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_query_erase(void *instance, uint32_t *msec) {
+  RFLDriver *devp = (RFLDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  /* The erase time is already accounted, no need to wait.*/
+  devp->state = FLASH_READY;
+  if (msec != NULL) {
+    *msec = 0U;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_verify_erase(void *instance, flash_sector_t sector) {
+  RFLDriver *devp = (RFLDriver *)instance;
+  const uint8_t *p;
+  uint8_t erased;
+  uint32_t i;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < devp->config->sectors_count);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE), "invalid state");
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  devp->stats.time += (uint64_t)devp->config->read_setup +
+                      ((uint64_t)devp->config->read_byte *
+                       (uint64_t)devp->config->sectors_size);
+  devp->stats.reads++;
+
+  p      = &devp->config->buffer[sector * devp->config->sectors_size];
+  erased = RFL_ERASED(devp);
+  for (i = 0U; i < devp->config->sectors_size; i++) {
+    if (p[i] != erased) {
+      return FLASH_ERROR_VERIFY;
+    }
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t rfl_suspend_erase(void *instance) {
+
+  (void)instance;
+
+  return FLASH_ERROR_UNIMPLEMENTED;
+}
+
+static flash_error_t rfl_resume_erase(void *instance) {
+
+  (void)instance;
+
+  return FLASH_ERROR_UNIMPLEMENTED;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p RFLDriver object
+ *
+ * @init
+ */
+void rflObjectInit(RFLDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+
+  devp->vmt    = &rfl_vmt;
+  devp->state  = FLASH_STOP;
+  devp->config = NULL;
+  memset(&devp->stats, 0, sizeof (rfl_statistics_t));
+}
+
+/**
+ * @brief   Configures and activates the RAM flash.
+ * @note    The buffer content is preserved, it is the flash content.
+ *
+ * @param[in] devp      pointer to the @p RFLDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void rflStart(RFLDriver *devp, const RFLConfig *config) {
+
+  osalDbgCheck((devp != NULL) && (config != NULL) &&
+               (config->buffer != NULL) && (config->page_size > 0U) &&
+               ((config->sectors_size % config->page_size) == 0U));
+  osalDbgAssert((devp->state == FLASH_STOP) || (devp->state == FLASH_READY),
+                "invalid state");
+
+  devp->config                   = config;
+  devp->descriptor.attributes    = config->attributes;
+  devp->descriptor.page_size     = config->page_size;
+  devp->descriptor.sectors_count = config->sectors_count;
+  devp->descriptor.sectors       = NULL;
+  devp->descriptor.sectors_size  = config->sectors_size;
+  devp->descriptor.address       = NULL;
+  devp->descriptor.size          = config->sectors_count *
+                                   config->sectors_size;
+  devp->state                    = FLASH_READY;
+}
+
+/**
+ * @brief   Deactivates the RAM flash.
+ *
+ * @param[in] devp      pointer to the @p RFLDriver object
+ *
+ * @api
+ */
+void rflStop(RFLDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+  osalDbgAssert((devp->state == FLASH_STOP) || (devp->state == FLASH_READY),
+                "invalid state");
+
+  devp->config = NULL;
+  devp->state  = FLASH_STOP;
+}
+
+/**
+ * @brief   Returns the operations statistics.
+ *
+ * @param[in] devp      pointer to the @p RFLDriver object
+ * @param[out] statsp   pointer to the statistics structure to be filled
+ *
+ * @api
+ */
+void rflGetStatistics(RFLDriver *devp, rfl_statistics_t *statsp) {
+
+  osalDbgCheck((devp != NULL) && (statsp != NULL));
+
+  *statsp = devp->stats;
+}
+
+/**
+ * @brief   Resets the operations statistics.
+ *
+ * @param[in] devp      pointer to the @p RFLDriver object
+ *
+ * @api
+ */
+void rflResetStatistics(RFLDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+
+  memset(&devp->stats, 0, sizeof (rfl_statistics_t));
+}
+
+/** @} */
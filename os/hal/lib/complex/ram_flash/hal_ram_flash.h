@@ -0,0 +1,192 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_ram_flash.h
+ * @brief   RAM flash emulator header.
+ * @details The emulated flash stores data in a RAM buffer and accounts
+ *          the time the operations would take on a real device according
+ *          to a simple timing model, operations complete immediately so
+ *          the results do not depend on the CPU or on the port.
+ *
+ * @addtogroup HAL_RAM_FLASH
+ * @{
+ */
+
+#ifndef HAL_RAM_FLASH_H
+#define HAL_RAM_FLASH_H
+
+#include "hal_flash.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a RAM flash configuration structure.
+ * @note    All times are in nanoseconds.
+ */
+typedef struct {
+  /**
+   * @brief   Storage buffer, its size must be at least
+   *          @p sectors_count * @p sectors_size bytes.
+   */
+  uint8_t                   *buffer;
+  /**
+   * @brief   Emulated device attributes.
+   * @note    @p FLASH_ATTR_ECC_CAPABLE enforces aligned whole pages
+   *          programming, otherwise bits can only be programmed from the
+   *          erased state like on NOR devices.
+   */
+  uint32_t                  attributes;
+  /**
+   * @brief   Program page size.
+   */
+  uint32_t                  page_size;
+  /**
+   * @brief   Number of sectors.
+   */
+  flash_sector_t            sectors_count;
+  /**
+   * @brief   Size of sectors.
+   */
+  uint32_t                  sectors_size;
+  /**
+   * @brief   Fixed time of a read operation.
+   */
+  uint32_t                  read_setup;
+  /**
+   * @brief   Read time per byte.
+   */
+  uint32_t                  read_byte;
+  /**
+   * @brief   Fixed time of a program operation.
+   */
+  uint32_t                  program_setup;
+  /**
+   * @brief   Program time per page, partially programmed pages count
+   *          as whole pages.
+   */
+  uint32_t                  program_page;
+  /**
+   * @brief   Erase time per sector.
+   */
+  uint32_t                  erase_sector;
+} RFLConfig;
+
+/**
+ * @brief   Type of the operations statistics of a RAM flash.
+ */
+typedef struct {
+  /**
+   * @brief   Modeled time spent in flash operations in nanoseconds.
+   */
+  uint64_t                  time;
+  /**
+   * @brief   Number of read operations.
+   */
+  uint32_t                  reads;
+  /**
+   * @brief   Number of program operations.
+   */
+  uint32_t                  programs;
+  /**
+   * @brief   Number of erased sectors.
+   */
+  uint32_t                  erases;
+} rfl_statistics_t;
+
+/**
+ * @brief   @p RFLDriver specific methods.
+ */
+#define _rfl_flash_methods_alone
+
+/**
+ * @brief   @p RFLDriver specific methods with inherited ones.
+ */
+#define _rfl_flash_methods                                                  \
+  _base_flash_methods                                                       \
+  _rfl_flash_methods_alone
+
+/**
+ * @extends BaseFlashVMT
+ *
+ * @brief   @p RFLDriver virtual methods table.
+ */
+struct RFLDriverVMT {
+  _rfl_flash_methods
+};
+
+/**
+ * @extends BaseFlash
+ *
+ * @brief   Type of RAM flash class.
+ */
+typedef struct {
+  /**
+   * @brief   RFLDriver Virtual Methods Table.
+   */
+  const struct RFLDriverVMT *vmt;
+  _base_flash_data
+  /**
+   * @brief   Current configuration data.
+   */
+  const RFLConfig           *config;
+  /**
+   * @brief   Device descriptor built from the configuration.
+   */
+  flash_descriptor_t        descriptor;
+  /**
+   * @brief   Operations statistics.
+   */
+  rfl_statistics_t          stats;
+} RFLDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void rflObjectInit(RFLDriver *devp);
+  void rflStart(RFLDriver *devp, const RFLConfig *config);
+  void rflStop(RFLDriver *devp);
+  void rflGetStatistics(RFLDriver *devp, rfl_statistics_t *statsp);
+  void rflResetStatistics(RFLDriver *devp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_RAM_FLASH_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the RAM flash emulator files.
+RFLSRC := $(CHIBIOS)/os/hal/lib/complex/ram_flash/hal_ram_flash.c
+
+# Required include directories
+RFLINC := $(CHIBIOS)/os/hal/lib/complex/ram_flash
+
+# Shared variables
+ALLCSRC += $(RFLSRC)
+ALLINC  += $(RFLINC)
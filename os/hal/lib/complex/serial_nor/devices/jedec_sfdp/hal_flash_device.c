@@ -0,0 +1,681 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_flash_device.c
+ * @brief   JEDEC SFDP generic serial flash driver code.
+ *
+ * @addtogroup JEDEC_SFDP
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "hal_serial_nor.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   SFDP signature, "SFDP" in little endian.
+ */
+#define SFDP_SIGNATURE                      0x50444653U
+
+/**
+ * @brief   Number of BFPT DWORDs used by the driver.
+ */
+#define SFDP_BFPT_DWORDS                    16U
+
+/**
+ * @brief   Returns a BFPT DWORD, DWORDs are numbered from one as in JESD216.
+ */
+#define BFPT(n)                             (bfpt[(n) - 1U])
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Generic SFDP device descriptor.
+ */
+flash_descriptor_t snor_descriptor = {
+  .attributes       = FLASH_ATTR_ERASED_IS_ONE | FLASH_ATTR_REWRITABLE,
+  .page_size        = 256U,         /* It is overwritten.*/
+  .sectors_count    = 0U,           /* It is overwritten.*/
+  .sectors          = NULL,
+  .sectors_size     = 0U,           /* It is overwritten.*/
+  .address          = 0U,
+  .size             = 0U            /* It is overwritten.*/
+};
+
+/**
+ * @brief   Settings discovered from SFDP.
+ */
+sfdp_nor_t sfdp_nor;
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint32_t sfdp_get_dword(const uint8_t *p) {
+
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static flash_error_t sfdp_poll_status(SNORDriver *devp) {
+  uint8_t sts;
+
+  do {
+#if SFDP_NICE_WAITING == TRUE
+    osalThreadSleepMilliseconds(1);
+#endif
+    /* Read status command.*/
+    bus_cmd_receive(devp->config->busp, SFDP_CMD_READ_STATUS_REGISTER,
+                    1, &sts);
+  } while ((sts & SFDP_STATUS_WIP) != 0U);
+
+  return FLASH_NO_ERROR;
+}
+
+static void sfdp_read_table(SNORDriver *devp, flash_offset_t offset,
+                            size_t n, uint8_t *rp) {
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  wspi_command_t cmd;
+
+  /* SFDP is always addressed with 3 bytes and 8 dummy cycles.*/
+  cmd.cmd   = SFDP_CMD_READ_SFDP;
+  cmd.cfg   = (sfdp_nor.cfg_cmd_addr_data & ~WSPI_CFG_ADDR_SIZE_MASK) |
+              WSPI_CFG_ADDR_SIZE_24;
+  cmd.addr  = offset;
+  cmd.alt   = 0U;
+  cmd.dummy = 8U;
+  wspiReceive(devp->config->busp, &cmd, n, rp);
+#else
+  uint8_t buf[5];
+
+  spiSelect(devp->config->busp);
+  buf[0] = SFDP_CMD_READ_SFDP;
+  buf[1] = (uint8_t)(offset >> 16);
+  buf[2] = (uint8_t)(offset >> 8);
+  buf[3] = (uint8_t)(offset >> 0);
+  buf[4] = 0xFFU;                   /* Dummy byte.*/
+  spiSend(devp->config->busp, 5, buf);
+  spiReceive(devp->config->busp, n, rp);
+  spiUnselect(devp->config->busp);
+#endif
+}
+
+#if (SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI) || defined(__DOXYGEN__)
+static uint32_t sfdp_cfg(unsigned cmd, unsigned addr, unsigned data,
+                         uint32_t addr_size) {
+  static const uint32_t cmd_modes[5] = {
+    WSPI_CFG_CMD_MODE_NONE,       WSPI_CFG_CMD_MODE_ONE_LINE,
+    WSPI_CFG_CMD_MODE_TWO_LINES,  WSPI_CFG_CMD_MODE_NONE,
+    WSPI_CFG_CMD_MODE_FOUR_LINES
+  };
+  static const uint32_t addr_modes[5] = {
+    WSPI_CFG_ADDR_MODE_NONE,      WSPI_CFG_ADDR_MODE_ONE_LINE,
+    WSPI_CFG_ADDR_MODE_TWO_LINES, WSPI_CFG_ADDR_MODE_NONE,
+    WSPI_CFG_ADDR_MODE_FOUR_LINES
+  };
+  static const uint32_t data_modes[5] = {
+    WSPI_CFG_DATA_MODE_NONE,      WSPI_CFG_DATA_MODE_ONE_LINE,
+    WSPI_CFG_DATA_MODE_TWO_LINES, WSPI_CFG_DATA_MODE_NONE,
+    WSPI_CFG_DATA_MODE_FOUR_LINES
+  };
+
+  return cmd_modes[cmd] | addr_modes[addr] | data_modes[data] |
+         WSPI_CFG_ALT_MODE_NONE | WSPI_CFG_CMD_SIZE_8 | addr_size;
+}
+#endif
+
+static void sfdp_set_cmd_lines(unsigned lines, uint32_t addr_size) {
+
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  sfdp_nor.cfg_cmd           = sfdp_cfg(lines, 0U, 0U, addr_size);
+  sfdp_nor.cfg_cmd_addr      = sfdp_cfg(lines, lines, 0U, addr_size);
+  sfdp_nor.cfg_cmd_data      = sfdp_cfg(lines, 0U, lines, addr_size);
+  sfdp_nor.cfg_cmd_addr_data = sfdp_cfg(lines, lines, lines, addr_size);
+#else
+  (void)lines;
+  (void)addr_size;
+#endif
+}
+
+#if ((SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI) && (SFDP_BUS_LINES == 4)) ||  \
+    defined(__DOXYGEN__)
+static void sfdp_write_status(SNORDriver *devp, uint32_t cmd,
+                              size_t n, const uint8_t *p) {
+
+  bus_cmd(devp->config->busp, SFDP_CMD_WRITE_ENABLE);
+  bus_cmd_send(devp->config->busp, cmd, n, p);
+  (void) sfdp_poll_status(devp);
+}
+
+/**
+ * @brief   Sets the quad enable bit as described by the BFPT QER field.
+ */
+static void sfdp_quad_enable(SNORDriver *devp, uint32_t qer) {
+  BUSDriver *busp = devp->config->busp;
+  uint8_t sr[2];
+
+  switch (qer) {
+  case 1U:
+    /* Bit 1 of SR2, SR2 cannot be read and writing one byte clears it.*/
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER, 1, &sr[0]);
+    sr[1] = 0x02U;
+    sfdp_write_status(devp, SFDP_CMD_WRITE_STATUS_REGISTER, 2, sr);
+    break;
+  case 2U:
+    /* Bit 6 of SR1.*/
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER, 1, &sr[0]);
+    sr[0] |= 0x40U;
+    sfdp_write_status(devp, SFDP_CMD_WRITE_STATUS_REGISTER, 1, sr);
+    break;
+  case 3U:
+    /* Bit 7 of SR2, accessed with dedicated commands.*/
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER_3F, 1, &sr[0]);
+    sr[0] |= 0x80U;
+    sfdp_write_status(devp, SFDP_CMD_WRITE_STATUS_REGISTER_3E, 1, sr);
+    break;
+  case 4U:
+  case 5U:
+    /* Bit 1 of SR2, written together with SR1.*/
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER, 1, &sr[0]);
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER_2, 1, &sr[1]);
+    sr[1] |= 0x02U;
+    sfdp_write_status(devp, SFDP_CMD_WRITE_STATUS_REGISTER, 2, sr);
+    break;
+  case 6U:
+    /* Bit 1 of SR2, written alone.*/
+    bus_cmd_receive(busp, SFDP_CMD_READ_STATUS_REGISTER_2, 1, &sr[0]);
+    sr[0] |= 0x02U;
+    sfdp_write_status(devp, SFDP_CMD_WRITE_STATUS_REGISTER_2, 1, sr);
+    break;
+  default:
+    /* No quad enable bit.*/
+    break;
+  }
+}
+#endif
+
+#if (SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI) || defined(__DOXYGEN__)
+static void sfdp_reset_memory(SNORDriver *devp) {
+
+  /* 1x SFDP_CMD_RESET_ENABLE command.*/
+  static const wspi_command_t cmd_reset_enable_1 = {
+    .cmd              = SFDP_CMD_RESET_ENABLE,
+    .cfg              = WSPI_CFG_CMD_MODE_ONE_LINE,
+    .addr             = 0,
+    .alt              = 0,
+    .dummy            = 0
+  };
+
+  /* 1x SFDP_CMD_RESET_MEMORY command.*/
+  static const wspi_command_t cmd_reset_memory_1 = {
+    .cmd              = SFDP_CMD_RESET_MEMORY,
+    .cfg              = WSPI_CFG_CMD_MODE_ONE_LINE,
+    .addr             = 0,
+    .alt              = 0,
+    .dummy            = 0
+  };
+
+#if SFDP_BUS_LINES == 4
+  /* 4x SFDP_CMD_RESET_ENABLE command.*/
+  static const wspi_command_t cmd_reset_enable_4 = {
+    .cmd              = SFDP_CMD_RESET_ENABLE,
+    .cfg              = WSPI_CFG_CMD_MODE_FOUR_LINES,
+    .addr             = 0,
+    .alt              = 0,
+    .dummy            = 0
+  };
+
+  /* 4x SFDP_CMD_RESET_MEMORY command.*/
+  static const wspi_command_t cmd_reset_memory_4 = {
+    .cmd              = SFDP_CMD_RESET_MEMORY,
+    .cfg              = WSPI_CFG_CMD_MODE_FOUR_LINES,
+    .addr             = 0,
+    .alt              = 0,
+    .dummy            = 0
+  };
+
+  /* If the device has been left in 4-4-4 mode then these commands reset
+     it, in one bit mode they are rejected because shorter than 8 bits.*/
+  wspiCommand(devp->config->busp, &cmd_reset_enable_4);
+  wspiCommand(devp->config->busp, &cmd_reset_memory_4);
+#endif
+
+  /* Now the device should be in one bit mode for sure and we perform a
+     device reset.*/
+  wspiCommand(devp->config->busp, &cmd_reset_enable_1);
+  wspiCommand(devp->config->busp, &cmd_reset_memory_1);
+}
+
+/**
+ * @brief   Selects the fastest read mode and switches the device to it.
+ * @details Modes are evaluated from the fastest, 4-4-4 then 1-4-4, 1-1-4,
+ *          1-2-2, 1-1-2 and finally 1-1-1 fast read.
+ *
+ * @return              The number of lines used by commands.
+ */
+static unsigned sfdp_select_read(SNORDriver *devp, const uint32_t *bfpt,
+                                 unsigned ndw, uint32_t addr_size) {
+  uint32_t qer = ndw >= 15U ? (BFPT(15) >> 20) & 7U : 0U;
+  wspi_command_t *rdp = &sfdp_nor.read;
+  uint32_t dw;
+
+  rdp->addr = 0U;
+  rdp->alt  = 0U;
+
+#if SFDP_BUS_LINES >= 4
+  /* 4-4-4, only if the device can be switched with a single command.*/
+  if ((ndw >= 15U) && ((BFPT(5) & (1U << 4)) != 0U) &&
+      ((BFPT(15) & (7U << 4)) != 0U)) {
+    if ((BFPT(15) & (1U << 4)) != 0U) {
+      sfdp_quad_enable(devp, qer);
+      bus_cmd(devp->config->busp, SFDP_CMD_ENTER_QPI_38);
+    }
+    else if ((BFPT(15) & (1U << 5)) != 0U) {
+      bus_cmd(devp->config->busp, SFDP_CMD_ENTER_QPI_38);
+    }
+    else {
+      bus_cmd(devp->config->busp, SFDP_CMD_ENTER_QPI_35);
+    }
+    dw = BFPT(7) >> 16;
+    rdp->cmd   = (dw >> 8) & 0xFFU;
+    rdp->dummy = (dw & 0x1FU) + ((dw >> 5) & 7U);
+    rdp->cfg   = sfdp_cfg(4U, 4U, 4U, addr_size);
+    return 4U;
+  }
+
+  /* 1-4-4.*/
+  if ((BFPT(1) & (1U << 21)) != 0U) {
+    sfdp_quad_enable(devp, qer);
+    dw = BFPT(3);
+    rdp->cmd   = (dw >> 8) & 0xFFU;
+    rdp->dummy = (dw & 0x1FU) + ((dw >> 5) & 7U);
+    rdp->cfg   = sfdp_cfg(1U, 4U, 4U, addr_size);
+    return 1U;
+  }
+
+  /* 1-1-4.*/
+  if ((BFPT(1) & (1U << 22)) != 0U) {
+    sfdp_quad_enable(devp, qer);
+    dw = BFPT(3) >> 16;
+    rdp->cmd   = (dw >> 8) & 0xFFU;
+    rdp->dummy = (dw & 0x1FU) + ((dw >> 5) & 7U);
+    rdp->cfg   = sfdp_cfg(1U, 1U, 4U, addr_size);
+    return 1U;
+  }
+#endif
+
+#if SFDP_BUS_LINES >= 2
+  /* 1-2-2.*/
+  if ((BFPT(1) & (1U << 20)) != 0U) {
+    dw = BFPT(4) >> 16;
+    rdp->cmd   = (dw >> 8) & 0xFFU;
+    rdp->dummy = (dw & 0x1FU) + ((dw >> 5) & 7U);
+    rdp->cfg   = sfdp_cfg(1U, 2U, 2U, addr_size);
+    return 1U;
+  }
+
+  /* 1-1-2.*/
+  if ((BFPT(1) & (1U << 16)) != 0U) {
+    dw = BFPT(4);
+    rdp->cmd   = (dw >> 8) & 0xFFU;
+    rdp->dummy = (dw & 0x1FU) + ((dw >> 5) & 7U);
+    rdp->cfg   = sfdp_cfg(1U, 1U, 2U, addr_size);
+    return 1U;
+  }
+#endif
+
+  (void)devp;
+  (void)qer;
+  (void)dw;
+
+  /* 1-1-1 fast read, always supported.*/
+  rdp->cmd   = SFDP_CMD_FAST_READ;
+  rdp->dummy = 8U;
+  rdp->cfg   = sfdp_cfg(1U, 1U, 1U, addr_size);
+  return 1U;
+}
+#endif /* SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI */
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+void snor_device_init(SNORDriver *devp) {
+  uint8_t buf[SFDP_BFPT_DWORDS * 4U];
+  uint32_t bfpt[SFDP_BFPT_DWORDS];
+  uint32_t addr_size, size, sector_size, ptr;
+  unsigned i, ndw, lines;
+
+  /* Discovery is performed in one bit mode with 3 bytes addresses.*/
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  addr_size = WSPI_CFG_ADDR_SIZE_24;
+#else
+  addr_size = 0U;
+#endif
+  sfdp_set_cmd_lines(1U, addr_size);
+
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  /* Attempting a reset of the device, it could be in an unexpected state
+     because a CPU reset does not reset the memory too.*/
+  sfdp_reset_memory(devp);
+#else
+  bus_cmd(devp->config->busp, SFDP_CMD_RESET_ENABLE);
+  bus_cmd(devp->config->busp, SFDP_CMD_RESET_MEMORY);
+#endif
+  osalThreadSleepMilliseconds(1);
+
+  /* Reading device ID and unique ID.*/
+  bus_cmd_receive(devp->config->busp, SFDP_CMD_READ_ID,
+                  sizeof devp->device_id, devp->device_id);
+
+  /* SFDP header followed by the first parameter header, the first
+     parameter header always describes the BFPT.*/
+  sfdp_read_table(devp, 0U, 16U, buf);
+  osalDbgAssert(sfdp_get_dword(&buf[0]) == SFDP_SIGNATURE,
+                "SFDP not supported");
+  osalDbgAssert((buf[8] == 0x00U) && (buf[15] == 0xFFU), "BFPT not found");
+  ndw = (unsigned)buf[11];
+  ptr = sfdp_get_dword(&buf[12]) & 0x00FFFFFFU;
+  osalDbgAssert(ndw >= 9U, "BFPT too short");
+  if (ndw > SFDP_BFPT_DWORDS) {
+    ndw = SFDP_BFPT_DWORDS;
+  }
+
+  /* Reading the BFPT, missing DWORDs are zero.*/
+  memset(buf, 0, sizeof buf);
+  sfdp_read_table(devp, (flash_offset_t)ptr, (size_t)ndw * 4U, buf);
+  for (i = 0U; i < SFDP_BFPT_DWORDS; i++) {
+    bfpt[i] = sfdp_get_dword(&buf[i * 4U]);
+  }
+
+  /* Device size in bytes.*/
+  if ((BFPT(2) & 0x80000000U) == 0U) {
+    size = (BFPT(2) + 1U) / 8U;
+  }
+  else {
+    size = 1U << ((BFPT(2) & 0x7FFFFFFFU) - 3U);
+  }
+
+  /* Devices larger than 16MB require 4 bytes addresses.*/
+  if ((size > 0x01000000U) || (((BFPT(1) >> 17) & 3U) == 2U)) {
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+    uint32_t methods = ndw >= 16U ? BFPT(16) >> 24 : 0U;
+
+    if ((((BFPT(1) >> 17) & 3U) == 2U) || ((methods & 0x40U) != 0U)) {
+      /* Always in 4 bytes mode.*/
+      addr_size = WSPI_CFG_ADDR_SIZE_32;
+    }
+    else if ((methods & 0x01U) != 0U) {
+      bus_cmd(devp->config->busp, SFDP_CMD_ENTER_4BYTE_ADDRESS);
+      addr_size = WSPI_CFG_ADDR_SIZE_32;
+    }
+    else if ((methods & 0x02U) != 0U) {
+      bus_cmd(devp->config->busp, SFDP_CMD_WRITE_ENABLE);
+      bus_cmd(devp->config->busp, SFDP_CMD_ENTER_4BYTE_ADDRESS);
+      addr_size = WSPI_CFG_ADDR_SIZE_32;
+    }
+    else {
+      /* Unsupported method, only the first 16MB are used.*/
+      size = 0x01000000U;
+    }
+#else
+    /* The SPI bus functions only send 3 bytes addresses.*/
+    osalDbgAssert(((BFPT(1) >> 17) & 3U) != 2U, "4 bytes addresses only");
+    size = 0x01000000U;
+#endif
+  }
+
+  /* Erase type selection.*/
+  sector_size = 0U;
+  for (i = 0U; i < 4U; i++) {
+    uint32_t et = BFPT(8U + (i / 2U)) >> ((i & 1U) * 16U);
+    uint32_t n = et & 0xFFU;
+
+    if ((n == 0U) || (n > 24U)) {
+      continue;
+    }
+#if SFDP_USE_SMALL_SECTORS == TRUE
+    if ((sector_size == 0U) || ((1U << n) < sector_size)) {
+#else
+    if ((1U << n) > sector_size) {
+#endif
+      sector_size        = 1U << n;
+      sfdp_nor.cmd_erase = (uint8_t)(et >> 8);
+    }
+  }
+  if (sector_size == 0U) {
+    /* No erase types described, the 4kB erase is assumed.*/
+    sector_size        = 0x00001000U;
+    sfdp_nor.cmd_erase = SFDP_CMD_SUBSECTOR_ERASE;
+  }
+
+  /* Page size, JESD216A and later.*/
+  if (ndw >= 11U) {
+    snor_descriptor.page_size = 1U << ((BFPT(11) >> 4) & 15U);
+  }
+
+  /* Erase suspend and resume commands.*/
+  if ((ndw >= 13U) && ((BFPT(12) & 0x80000000U) == 0U)) {
+    sfdp_nor.cmd_suspend = (uint8_t)(BFPT(13) >> 24);
+    sfdp_nor.cmd_resume  = (uint8_t)(BFPT(13) >> 16);
+    snor_descriptor.attributes |= FLASH_ATTR_SUSPEND_ERASE_CAPABLE;
+  }
+  else {
+    sfdp_nor.cmd_suspend = 0U;
+    sfdp_nor.cmd_resume  = 0U;
+  }
+
+  /* Read mode selection, commands could switch to 4 lines.*/
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  lines = sfdp_select_read(devp, bfpt, ndw, addr_size);
+#else
+  lines = 1U;
+#endif
+  sfdp_set_cmd_lines(lines, addr_size);
+
+  /* Setting up the device size.*/
+  snor_descriptor.sectors_size  = sector_size;
+  snor_descriptor.sectors_count = size / sector_size;
+  snor_descriptor.size = snor_descriptor.sectors_count * sector_size;
+}
+
+flash_error_t snor_device_read(SNORDriver *devp, flash_offset_t offset,
+                               size_t n, uint8_t *rp) {
+
+#if SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI
+  wspi_command_t cmd = sfdp_nor.read;
+
+  /* Fastest read command in WSPI mode.*/
+  cmd.addr = offset;
+  wspiReceive(devp->config->busp, &cmd, n, rp);
+#else
+  /* Normal read command in SPI mode.*/
+  bus_cmd_addr_receive(devp->config->busp, SFDP_CMD_READ,
+                       offset, n, rp);
+#endif
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_program(SNORDriver *devp, flash_offset_t offset,
+                                  size_t n, const uint8_t *pp) {
+  flash_offset_t page_mask = (flash_offset_t)snor_descriptor.page_size - 1U;
+
+  /* Data is programmed page by page.*/
+  while (n > 0U) {
+    flash_error_t err;
+
+    /* Data size that can be written in a single program page operation.*/
+    size_t chunk = (size_t)(((offset | page_mask) + 1U) - offset);
+    if (chunk > n) {
+      chunk = n;
+    }
+
+    /* Enabling write operation.*/
+    bus_cmd(devp->config->busp, SFDP_CMD_WRITE_ENABLE);
+
+    /* Page program command.*/
+    bus_cmd_addr_send(devp->config->busp, SFDP_CMD_PAGE_PROGRAM, offset,
+                      chunk, pp);
+
+    /* Wait for status and check errors.*/
+    err = sfdp_poll_status(devp);
+    if (err != FLASH_NO_ERROR) {
+
+      return err;
+    }
+
+    /* Next page.*/
+    offset += chunk;
+    pp     += chunk;
+    n      -= chunk;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_start_erase_all(SNORDriver *devp) {
+
+  /* Enabling write operation.*/
+  bus_cmd(devp->config->busp, SFDP_CMD_WRITE_ENABLE);
+
+  /* Chip erase command.*/
+  bus_cmd(devp->config->busp, SFDP_CMD_CHIP_ERASE);
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_start_erase_sector(SNORDriver *devp,
+                                             flash_sector_t sector) {
+  flash_offset_t offset = (flash_offset_t)(sector *
+                                           snor_descriptor.sectors_size);
+
+  /* Enabling write operation.*/
+  bus_cmd(devp->config->busp, SFDP_CMD_WRITE_ENABLE);
+
+  /* Sector erase command.*/
+  bus_cmd_addr(devp->config->busp, sfdp_nor.cmd_erase, offset);
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_verify_erase(SNORDriver *devp,
+                                       flash_sector_t sector) {
+  uint8_t cmpbuf[SFDP_COMPARE_BUFFER_SIZE];
+  flash_offset_t offset;
+  size_t n;
+
+  /* Read command.*/
+  offset = (flash_offset_t)(sector * snor_descriptor.sectors_size);
+  n = snor_descriptor.sectors_size;
+  while (n > 0U) {
+    uint8_t *p;
+
+    (void) snor_device_read(devp, offset, sizeof cmpbuf, cmpbuf);
+
+    /* Checking for erased state of current buffer.*/
+    for (p = cmpbuf; p < &cmpbuf[SFDP_COMPARE_BUFFER_SIZE]; p++) {
+      if (*p != 0xFFU) {
+        /* Ready state again.*/
+        devp->state = FLASH_READY;
+
+        return FLASH_ERROR_VERIFY;
+      }
+    }
+
+    offset += sizeof cmpbuf;
+    n -= sizeof cmpbuf;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_query_erase(SNORDriver *devp, uint32_t *msec) {
+  uint8_t sts;
+
+  /* Read status command.*/
+  bus_cmd_receive(devp->config->busp, SFDP_CMD_READ_STATUS_REGISTER,
+                  1, &sts);
+
+  /* If the WIP bit is one (busy) then report that the operation is still
+     in progress.*/
+  if ((sts & SFDP_STATUS_WIP) != 0U) {
+
+    /* Recommended time before polling again, this is a simplified
+       implementation.*/
+    if (msec != NULL) {
+      *msec = 1U;
+    }
+
+    return FLASH_BUSY_ERASING;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_suspend_erase(SNORDriver *devp) {
+  uint8_t sts;
+
+  if (sfdp_nor.cmd_suspend == 0U) {
+    return FLASH_ERROR_UNIMPLEMENTED;
+  }
+
+  /* Suspend command.*/
+  bus_cmd(devp->config->busp, sfdp_nor.cmd_suspend);
+
+  /* Waiting for the device to become ready, the suspend latency is in
+     the order of microseconds so no sleeping is done here.*/
+  do {
+    bus_cmd_receive(devp->config->busp, SFDP_CMD_READ_STATUS_REGISTER,
+                    1, &sts);
+  } while ((sts & SFDP_STATUS_WIP) != 0U);
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_resume_erase(SNORDriver *devp) {
+
+  if (sfdp_nor.cmd_suspend == 0U) {
+    return FLASH_ERROR_UNIMPLEMENTED;
+  }
+
+  /* Resume command.*/
+  bus_cmd(devp->config->busp, sfdp_nor.cmd_resume);
+
+  return FLASH_NO_ERROR;
+}
+
+flash_error_t snor_device_read_sfdp(SNORDriver *devp, flash_offset_t offset,
+                                    size_t n, uint8_t *rp) {
+
+  sfdp_read_table(devp, offset, n, rp);
+
+  return FLASH_NO_ERROR;
+}
+
+/** @} */
@@ -0,0 +1,227 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_flash_device.h
+ * @brief   JEDEC SFDP generic serial flash driver header.
+ * @details The device geometry, the read command and the bus width are
+ *          discovered at initialization from the SFDP Basic Flash
+ *          Parameter Table (JESD216).
+ * @note    The WSPI peripheral configuration, for example the flash size
+ *          on STM32 QUADSPI, is still provided by the application.
+ *
+ * @addtogroup JEDEC_SFDP
+ * @{
+ */
+
+#ifndef HAL_FLASH_DEVICE_H
+#define HAL_FLASH_DEVICE_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Device capabilities
+ * @{
+ */
+#define SNOR_DEVICE_SUPPORTS_XIP            FALSE
+/** @} */
+
+/**
+ * @name    Command codes
+ * @{
+ */
+#define SFDP_CMD_RESET_ENABLE               0x66
+#define SFDP_CMD_RESET_MEMORY               0x99
+#define SFDP_CMD_READ_ID                    0x9F
+#define SFDP_CMD_READ_SFDP                  0x5A
+#define SFDP_CMD_READ                       0x03
+#define SFDP_CMD_FAST_READ                  0x0B
+#define SFDP_CMD_WRITE_ENABLE               0x06
+#define SFDP_CMD_READ_STATUS_REGISTER       0x05
+#define SFDP_CMD_READ_STATUS_REGISTER_2     0x35
+#define SFDP_CMD_WRITE_STATUS_REGISTER      0x01
+#define SFDP_CMD_WRITE_STATUS_REGISTER_2    0x31
+#define SFDP_CMD_READ_STATUS_REGISTER_3F    0x3F
+#define SFDP_CMD_WRITE_STATUS_REGISTER_3E   0x3E
+#define SFDP_CMD_PAGE_PROGRAM               0x02
+#define SFDP_CMD_SUBSECTOR_ERASE            0x20
+#define SFDP_CMD_CHIP_ERASE                 0xC7
+#define SFDP_CMD_ENTER_4BYTE_ADDRESS        0xB7
+#define SFDP_CMD_ENTER_QPI_38               0x38
+#define SFDP_CMD_ENTER_QPI_35               0x35
+/** @} */
+
+/**
+ * @name    Status register bits
+ * @{
+ */
+#define SFDP_STATUS_WIP                     0x01U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of data lines connected to the device.
+ * @details The fastest read mode allowed by this number of lines and
+ *          supported by the device is selected.
+ * @note    This option is only valid in WSPI bus mode.
+ */
+#if !defined(SFDP_BUS_LINES) || defined(__DOXYGEN__)
+#define SFDP_BUS_LINES                      4
+#endif
+
+/**
+ * @brief   Uses the smallest erase size rather than the largest one.
+ */
+#if !defined(SFDP_USE_SMALL_SECTORS) || defined(__DOXYGEN__)
+#define SFDP_USE_SMALL_SECTORS              FALSE
+#endif
+
+/**
+ * @brief   Delays insertions.
+ * @details If enabled this options inserts delays into the flash waiting
+ *          routines releasing some extra CPU time for threads with lower
+ *          priority, this may slow down the driver a bit however.
+ */
+#if !defined(SFDP_NICE_WAITING) || defined(__DOXYGEN__)
+#define SFDP_NICE_WAITING                   TRUE
+#endif
+
+/**
+ * @brief   Size of the compare buffer.
+ * @details This buffer is allocated in the stack frame of the function
+ *          @p flashVerifyErase() and its size must be a power of two.
+ *          Larger buffers lead to better verify performance but increase
+ *          stack usage for that function.
+ */
+#if !defined(SFDP_COMPARE_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define SFDP_COMPARE_BUFFER_SIZE            32
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (SFDP_BUS_LINES != 1) && (SFDP_BUS_LINES != 2) && (SFDP_BUS_LINES != 4)
+#error "invalid SFDP_BUS_LINES value (1, 2, 4)"
+#endif
+
+#if (SFDP_COMPARE_BUFFER_SIZE & (SFDP_COMPARE_BUFFER_SIZE - 1)) != 0
+#error "invalid SFDP_COMPARE_BUFFER_SIZE value"
+#endif
+
+/**
+ * @name    WSPI settings
+ * @note    The settings depend on the mode selected at initialization.
+ * @{
+ */
+#define SNOR_WSPI_CFG_CMD                   (sfdp_nor.cfg_cmd)
+#define SNOR_WSPI_CFG_CMD_ADDR              (sfdp_nor.cfg_cmd_addr)
+#define SNOR_WSPI_CFG_CMD_DATA              (sfdp_nor.cfg_cmd_data)
+#define SNOR_WSPI_CFG_CMD_ADDR_DATA         (sfdp_nor.cfg_cmd_addr_data)
+/** @} */
+
+/**
+ * @brief   Read command for memory mapped mode.
+ */
+#define snor_memmap_read                    (sfdp_nor.read)
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of the settings discovered from SFDP.
+ */
+typedef struct {
+  /**
+   * @brief   WSPI settings for command only.
+   */
+  uint32_t                  cfg_cmd;
+  /**
+   * @brief   WSPI settings for command and address.
+   */
+  uint32_t                  cfg_cmd_addr;
+  /**
+   * @brief   WSPI settings for command and data.
+   */
+  uint32_t                  cfg_cmd_data;
+  /**
+   * @brief   WSPI settings for command, address and data.
+   */
+  uint32_t                  cfg_cmd_addr_data;
+#if (SNOR_BUS_DRIVER == SNOR_BUS_DRIVER_WSPI) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fastest read command supported by the device.
+   */
+  wspi_command_t            read;
+#endif
+  /**
+   * @brief   Sector erase command.
+   */
+  uint8_t                   cmd_erase;
+  /**
+   * @brief   Erase suspend command or zero if not supported.
+   */
+  uint8_t                   cmd_suspend;
+  /**
+   * @brief   Erase resume command.
+   */
+  uint8_t                   cmd_resume;
+} sfdp_nor_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern flash_descriptor_t snor_descriptor;
+extern sfdp_nor_t sfdp_nor;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void snor_device_init(SNORDriver *devp);
+  flash_error_t snor_device_read(SNORDriver *devp, flash_offset_t offset,
+                                 size_t n, uint8_t *rp);
+  flash_error_t snor_device_program(SNORDriver *devp, flash_offset_t offset,
+                                    size_t n, const uint8_t *pp);
+  flash_error_t snor_device_start_erase_all(SNORDriver *devp);
+  flash_error_t snor_device_start_erase_sector(SNORDriver *devp,
+                                               flash_sector_t sector);
+  flash_error_t snor_device_verify_erase(SNORDriver *devp,
+                                         flash_sector_t sector);
+  flash_error_t snor_device_query_erase(SNORDriver *devp, uint32_t *msec);
+  flash_error_t snor_device_suspend_erase(SNORDriver *devp);
+  flash_error_t snor_device_resume_erase(SNORDriver *devp);
+  flash_error_t snor_device_read_sfdp(SNORDriver *devp, flash_offset_t offset,
+                                      size_t n, uint8_t *rp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_FLASH_DEVICE_H */
+
+/** @} */
@@ -652,6 +652,52 @@ flash_error_t snor_device_query_erase(SNORDriver *devp, uint32_t *msec) {
   return FLASH_NO_ERROR;
 }
 
+/**
+ * @brief   Suspends the erase operation in progress.
+ *
+ * @param[in] devp      pointer to a @p SNORDriver instance
+ */
+flash_error_t snor_device_suspend_erase(SNORDriver *devp) {
+  uint8_t sts[2];
+
+  /* Suspend command.*/
+#if MX25_BUS_MODE == MX25_BUS_MODE_SPI
+  bus_cmd(devp->config->busp, MX25_CMD_SPI_PE_SUSPEND);
+#else
+  bus_cmd(devp->config->busp, MX25_CMD_OPI_PE_SUSPEND);
+#endif
+
+  /* Waiting for the WIP bit to be cleared, the suspend latency is in the
+     order of microseconds so no sleeping is done here.*/
+  do {
+#if MX25_BUS_MODE == MX25_BUS_MODE_SPI
+    bus_cmd_receive(devp->config->busp, MX25_CMD_SPI_RDSR, 1U, sts);
+#else
+    bus_cmd_addr_dummy_receive(devp->config->busp, MX25_CMD_OPI_RDSR,
+                               0U, 4U, 2U, sts);   /*Note: always 4 dummies.*/
+#endif
+  } while ((sts[0] & 1U) != 0U);
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Resumes a suspended erase operation.
+ *
+ * @param[in] devp      pointer to a @p SNORDriver instance
+ */
+flash_error_t snor_device_resume_erase(SNORDriver *devp) {
+
+  /* Resume command.*/
+#if MX25_BUS_MODE == MX25_BUS_MODE_SPI
+  bus_cmd(devp->config->busp, MX25_CMD_SPI_PE_RESUME);
+#else
+  bus_cmd(devp->config->busp, MX25_CMD_OPI_PE_RESUME);
+#endif
+
+  return FLASH_NO_ERROR;
+}
+
 flash_error_t snor_device_read_sfdp(SNORDriver *devp, flash_offset_t offset,
                                     size_t n, uint8_t *rp) {
 
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 #include "hal_serial_nor.h"
 
@@ -29,6 +31,21 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (SNOR_USE_XIP_READS == TRUE) && (WSPI_SUPPORTS_MEMMAP == FALSE)
+#error "SNOR_USE_XIP_READS requires WSPI_SUPPORTS_MEMMAP"
+#endif
+
+#if SNOR_READ_CACHE_SIZE > 0U
+#define snor_cache_invalidate(devp) (devp)->cache_valid = false
+#else
+#define snor_cache_invalidate(devp)
+#endif
+
+#if SNOR_USE_XIP_READS == FALSE
+#define snor_xip_suspend(devp)
+#define snor_xip_resume(devp)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -50,6 +67,8 @@ static flash_error_t snor_verify_erase(void *instance,
 static flash_error_t snor_query_erase(void *instance, uint32_t *msec);
 static flash_error_t snor_read_sfdp(void *instance, flash_offset_t offset,
                                     size_t n, uint8_t *rp);
+static flash_error_t snor_suspend_erase(void *instance);
+static flash_error_t snor_resume_erase(void *instance);
 
 /**
  * @brief   Virtual methods table.
@@ -59,6 +78,7 @@ static const struct SNORDriverVMT snor_vmt = {
   snor_get_descriptor, snor_read, snor_program,
   snor_start_erase_all, snor_start_erase_sector,
   snor_query_erase, snor_verify_erase,
+  snor_suspend_erase, snor_resume_erase,
   snor_read_sfdp
 };
 
@@ -66,6 +86,96 @@ static const struct SNORDriverVMT snor_vmt = {
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (SNOR_READ_CACHE_SIZE > 0U) || defined(__DOXYGEN__)
+/**
+ * @brief   Reads data through the read-ahead cache.
+ * @note    Reads not smaller than the cache bypass it.
+ *
+ * @param[in] devp      pointer to the @p SNORDriver object
+ * @param[in] offset    flash offset
+ * @param[in] n         number of bytes to be read
+ * @param[out] rp       pointer to the data buffer
+ * @return              An error code.
+ *
+ * @notapi
+ */
+static flash_error_t snor_cache_read(SNORDriver *devp, flash_offset_t offset,
+                                     size_t n, uint8_t *rp) {
+
+  if (n >= SNOR_READ_CACHE_SIZE) {
+    return snor_device_read(devp, offset, n, rp);
+  }
+
+  while (n > 0U) {
+    flash_offset_t base = offset & ~((flash_offset_t)SNOR_READ_CACHE_SIZE - 1U);
+    size_t pos = (size_t)(offset - base);
+    size_t chunk = SNOR_READ_CACHE_SIZE - pos;
+
+    /* Filling the cache with the whole aligned block on miss.*/
+    if (!devp->cache_valid || (devp->cache_offset != base)) {
+      flash_error_t err;
+
+      devp->cache_valid = false;
+      err = snor_device_read(devp, base, SNOR_READ_CACHE_SIZE, devp->cache);
+      if (err != FLASH_NO_ERROR) {
+        return err;
+      }
+      devp->cache_offset = base;
+      devp->cache_valid  = true;
+    }
+
+    if (chunk > n) {
+      chunk = n;
+    }
+    memcpy(rp, &devp->cache[pos], chunk);
+    offset += (flash_offset_t)chunk;
+    rp     += chunk;
+    n      -= chunk;
+  }
+
+  return FLASH_NO_ERROR;
+}
+#endif /* SNOR_READ_CACHE_SIZE > 0U */
+
+#if (SNOR_USE_XIP_READS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Temporarily leaves the memory mapped mode, if active.
+ * @note    The bus must be acquired.
+ *
+ * @param[in] devp      pointer to the @p SNORDriver object
+ *
+ * @notapi
+ */
+static void snor_xip_suspend(SNORDriver *devp) {
+
+  if (devp->config->busp->state == WSPI_MEMMAP) {
+    wspiUnmapFlash(devp->config->busp);
+#if SNOR_DEVICE_SUPPORTS_XIP == TRUE
+    snor_reset_xip(devp);
+#endif
+  }
+}
+
+/**
+ * @brief   Enters again the memory mapped mode, if it has been requested.
+ * @note    The bus must be acquired.
+ *
+ * @param[in] devp      pointer to the @p SNORDriver object
+ *
+ * @notapi
+ */
+static void snor_xip_resume(SNORDriver *devp) {
+
+  if ((devp->xip_addr != NULL) &&
+      (devp->config->busp->state != WSPI_MEMMAP)) {
+#if SNOR_DEVICE_SUPPORTS_XIP == TRUE
+    snor_activate_xip(devp);
+#endif
+    wspiMapFlash(devp->config->busp, &snor_memmap_read, &devp->xip_addr);
+  }
+}
+#endif /* SNOR_USE_XIP_READS == TRUE */
+
 /**
  * @brief   Returns a pointer to the device descriptor.
  *
@@ -85,12 +195,15 @@ static const flash_descriptor_t *snor_get_descriptor(void *instance) {
 static flash_error_t snor_read(void *instance, flash_offset_t offset,
                                size_t n, uint8_t *rp) {
   SNORDriver *devp = (SNORDriver *)instance;
+  flash_state_t state;
   flash_error_t err;
 
   osalDbgCheck((instance != NULL) && (rp != NULL) && (n > 0U));
   osalDbgCheck((size_t)offset + n <= (size_t)snor_descriptor.sectors_count *
                                      (size_t)snor_descriptor.sectors_size);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
   if (devp->state == FLASH_ERASE) {
@@ -100,14 +213,29 @@ static flash_error_t snor_read(void *instance, flash_offset_t offset,
   /* Bus acquired.*/
   bus_acquire(devp->config->busp, devp->config->buscfg);
 
-  /* FLASH_READY state while the operation is performed.*/
+  /* FLASH_READ state while the operation is performed.*/
+  state = devp->state;
   devp->state = FLASH_READ;
 
-  /* Actual read implementation.*/
-  err = snor_device_read(devp, offset, n, rp);
+#if SNOR_USE_XIP_READS == TRUE
+  if (devp->xip_addr != NULL) {
+    /* Reading through the memory mapped area.*/
+    memcpy(rp, devp->xip_addr + offset, n);
+    err = FLASH_NO_ERROR;
+  }
+  else
+#endif
+  {
+    /* Actual read implementation.*/
+#if SNOR_READ_CACHE_SIZE > 0U
+    err = snor_cache_read(devp, offset, n, rp);
+#else
+    err = snor_device_read(devp, offset, n, rp);
+#endif
+  }
 
-  /* Ready state again.*/
-  devp->state = FLASH_READY;
+  /* Previous state again, ready or erase suspended.*/
+  devp->state = state;
 
   /* Bus released.*/
   bus_release(devp->config->busp);
@@ -118,12 +246,15 @@ static flash_error_t snor_read(void *instance, flash_offset_t offset,
 static flash_error_t snor_program(void *instance, flash_offset_t offset,
                                   size_t n, const uint8_t *pp) {
   SNORDriver *devp = (SNORDriver *)instance;
+  flash_state_t state;
   flash_error_t err;
 
   osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
   osalDbgCheck((size_t)offset + n <= (size_t)snor_descriptor.sectors_count *
                                      (size_t)snor_descriptor.sectors_size);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
   if (devp->state == FLASH_ERASE) {
@@ -134,13 +265,19 @@ static flash_error_t snor_program(void *instance, flash_offset_t offset,
   bus_acquire(devp->config->busp, devp->config->buscfg);
 
   /* FLASH_PGM state while the operation is performed.*/
+  state = devp->state;
   devp->state = FLASH_PGM;
 
+  /* Cached data is no more valid.*/
+  snor_cache_invalidate(devp);
+
   /* Actual program implementation.*/
+  snor_xip_suspend(devp);
   err = snor_device_program(devp, offset, n, pp);
+  snor_xip_resume(devp);
 
-  /* Ready state again.*/
-  devp->state = FLASH_READY;
+  /* Previous state again, ready or erase suspended.*/
+  devp->state = state;
 
   /* Bus released.*/
   bus_release(devp->config->busp);
@@ -153,10 +290,12 @@ static flash_error_t snor_start_erase_all(void *instance) {
   flash_error_t err;
 
   osalDbgCheck(instance != NULL);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
-  if (devp->state == FLASH_ERASE) {
+  if ((devp->state == FLASH_ERASE) || (devp->state == FLASH_SUSPENDED)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -166,7 +305,12 @@ static flash_error_t snor_start_erase_all(void *instance) {
   /* FLASH_ERASE state while the operation is performed.*/
   devp->state = FLASH_ERASE;
 
-  /* Actual erase implementation.*/
+  /* Cached data is no more valid.*/
+  snor_cache_invalidate(devp);
+
+  /* Actual erase implementation, the memory mapped mode is resumed after
+     the erase completion.*/
+  snor_xip_suspend(devp);
   err = snor_device_start_erase_all(devp);
 
   /* Ready state again.*/
@@ -185,10 +329,12 @@ static flash_error_t snor_start_erase_sector(void *instance,
 
   osalDbgCheck(instance != NULL);
   osalDbgCheck(sector < snor_descriptor.sectors_count);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
-  if (devp->state == FLASH_ERASE) {
+  if ((devp->state == FLASH_ERASE) || (devp->state == FLASH_SUSPENDED)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -198,7 +344,12 @@ static flash_error_t snor_start_erase_sector(void *instance,
   /* FLASH_ERASE state while the operation is performed.*/
   devp->state = FLASH_ERASE;
 
-  /* Actual erase implementation.*/
+  /* Cached data is no more valid.*/
+  snor_cache_invalidate(devp);
+
+  /* Actual erase implementation, the memory mapped mode is resumed after
+     the erase completion.*/
+  snor_xip_suspend(devp);
   err = snor_device_start_erase_sector(devp, sector);
 
   /* Bus released.*/
@@ -214,10 +365,12 @@ static flash_error_t snor_verify_erase(void *instance,
 
   osalDbgCheck(instance != NULL);
   osalDbgCheck(sector < snor_descriptor.sectors_count);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
-  if (devp->state == FLASH_ERASE) {
+  if ((devp->state == FLASH_ERASE) || (devp->state == FLASH_SUSPENDED)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -228,7 +381,9 @@ static flash_error_t snor_verify_erase(void *instance,
   devp->state = FLASH_READ;
 
   /* Actual verify erase implementation.*/
+  snor_xip_suspend(devp);
   err = snor_device_verify_erase(devp, sector);
+  snor_xip_resume(devp);
 
   /* Ready state again.*/
   devp->state = FLASH_READY;
@@ -244,9 +399,20 @@ static flash_error_t snor_query_erase(void *instance, uint32_t *msec) {
   flash_error_t err;
 
   osalDbgCheck(instance != NULL);
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
+  /* A suspended erase operation cannot progress.*/
+  if (devp->state == FLASH_SUSPENDED) {
+    if (msec != NULL) {
+      *msec = 1U;
+    }
+
+    return FLASH_BUSY_ERASING;
+  }
+
   /* If there is an erase in progress then the device must be checked.*/
   if (devp->state == FLASH_ERASE) {
 
@@ -259,6 +425,7 @@ static flash_error_t snor_query_erase(void *instance, uint32_t *msec) {
     /* The device is ready to accept commands.*/
     if (err == FLASH_NO_ERROR) {
       devp->state = FLASH_READY;
+      snor_xip_resume(devp);
     }
 
     /* Bus released.*/
@@ -277,10 +444,12 @@ static flash_error_t snor_read_sfdp(void *instance, flash_offset_t offset,
   flash_error_t err;
 
   osalDbgCheck((instance != NULL) && (rp != NULL) && (n > 0U));
-  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
                 "invalid state");
 
-  if (devp->state == FLASH_ERASE) {
+  if ((devp->state == FLASH_ERASE) || (devp->state == FLASH_SUSPENDED)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -288,7 +457,9 @@ static flash_error_t snor_read_sfdp(void *instance, flash_offset_t offset,
   bus_acquire(devp->config->busp, devp->config->buscfg);
 
   /* Actual read SFDP implementation.*/
+  snor_xip_suspend(devp);
   err = snor_device_read_sfdp(devp, offset, n, rp);
+  snor_xip_resume(devp);
 
   /* The device is ready to accept commands.*/
   if (err == FLASH_NO_ERROR) {
@@ -301,6 +472,73 @@ static flash_error_t snor_read_sfdp(void *instance, flash_offset_t offset,
   return err;
 }
 
+static flash_error_t snor_suspend_erase(void *instance) {
+  SNORDriver *devp = (SNORDriver *)instance;
+  flash_error_t err;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
+                "invalid state");
+
+  /* Nothing to suspend.*/
+  if (devp->state != FLASH_ERASE) {
+    return FLASH_NO_ERROR;
+  }
+
+  /* Bus acquired.*/
+  bus_acquire(devp->config->busp, devp->config->buscfg);
+
+  /* Actual suspend implementation.*/
+  err = snor_device_suspend_erase(devp);
+
+  /* Reads are allowed while suspended, the memory mapped mode is
+     resumed.*/
+  if (err == FLASH_NO_ERROR) {
+    devp->state = FLASH_SUSPENDED;
+    snor_xip_resume(devp);
+  }
+
+  /* Bus released.*/
+  bus_release(devp->config->busp);
+
+  return err;
+}
+
+static flash_error_t snor_resume_erase(void *instance) {
+  SNORDriver *devp = (SNORDriver *)instance;
+  flash_error_t err;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) ||
+                (devp->state == FLASH_ERASE) ||
+                (devp->state == FLASH_SUSPENDED),
+                "invalid state");
+
+  /* Nothing to resume.*/
+  if (devp->state != FLASH_SUSPENDED) {
+    return FLASH_NO_ERROR;
+  }
+
+  /* Bus acquired.*/
+  bus_acquire(devp->config->busp, devp->config->buscfg);
+
+  /* Actual resume implementation.*/
+  snor_xip_suspend(devp);
+  err = snor_device_resume_erase(devp);
+
+  /* Erase in progress again.*/
+  if (err == FLASH_NO_ERROR) {
+    devp->state = FLASH_ERASE;
+  }
+
+  /* Bus released.*/
+  bus_release(devp->config->busp);
+
+  return err;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -647,6 +885,12 @@ void snorObjectInit(SNORDriver *devp) {
   devp->vmt         = &snor_vmt;
   devp->state       = FLASH_STOP;
   devp->config      = NULL;
+#if SNOR_READ_CACHE_SIZE > 0U
+  devp->cache_valid = false;
+#endif
+#if SNOR_USE_XIP_READS == TRUE
+  devp->xip_addr    = NULL;
+#endif
 }
 
 /**
@@ -671,6 +915,7 @@ void snorStart(SNORDriver *devp, const SNORConfig *config) {
 
     /* Device identification and initialization.*/
     snor_device_init(devp);
+    snor_cache_invalidate(devp);
 
     /* Driver in ready state.*/
     devp->state = FLASH_READY;
@@ -697,6 +942,12 @@ void snorStop(SNORDriver *devp) {
     /* Bus acquisition.*/
     bus_acquire(devp->config->busp, devp->config->buscfg);
 
+#if SNOR_USE_XIP_READS == TRUE
+    /* Leaving the memory mapped mode, if active.*/
+    snor_xip_suspend(devp);
+    devp->xip_addr = NULL;
+#endif
+
     /* Stopping bus device.*/
     bus_stop(devp->config->busp);
 
@@ -718,6 +969,8 @@ void snorStop(SNORDriver *devp) {
  * @details The memory mapping mode is only available when the WSPI mode
  *          is selected and the underlying WSPI controller supports the
  *          feature.
+ * @note    If @p SNOR_USE_XIP_READS is enabled then the flash interface
+ *          remains usable, reads are served from the mapped area.
  *
  * @param[in] devp      pointer to the @p SNORDriver object
  * @param[out] addrp    pointer to the memory start address of the mapped
@@ -726,6 +979,7 @@ void snorStop(SNORDriver *devp) {
  * @api
  */
 void snorMemoryMap(SNORDriver *devp, uint8_t **addrp) {
+  uint8_t *addr;
 
   /* Bus acquisition.*/
   bus_acquire(devp->config->busp, devp->config->buscfg);
@@ -736,7 +990,13 @@ void snorMemoryMap(SNORDriver *devp, uint8_t **addrp) {
 #endif
 
   /* Starting WSPI memory mapped mode.*/
-  wspiMapFlash(devp->config->busp, &snor_memmap_read, addrp);
+  wspiMapFlash(devp->config->busp, &snor_memmap_read, &addr);
+#if SNOR_USE_XIP_READS == TRUE
+  devp->xip_addr = addr;
+#endif
+  if (addrp != NULL) {
+    *addrp = addr;
+  }
 
   /* Bus release.*/
   bus_release(devp->config->busp);
@@ -754,11 +1014,18 @@ void snorMemoryUnmap(SNORDriver *devp) {
   /* Bus acquisition.*/
   bus_acquire(devp->config->busp, devp->config->buscfg);
 
+#if SNOR_USE_XIP_READS == TRUE
+  /* Reads are served by the bus again, the memory mapped mode could be
+     already suspended by an erase operation.*/
+  devp->xip_addr = NULL;
+  snor_xip_suspend(devp);
+#else
   /* Stopping WSPI memory mapped mode.*/
   wspiUnmapFlash(devp->config->busp);
 
 #if SNOR_DEVICE_SUPPORTS_XIP == TRUE
   snor_reset_xip(devp);
+#endif
 #endif
 
   /* Bus release.*/
@@ -65,6 +65,30 @@
 #if !defined(SNOR_SHARED_BUS) || defined(__DOXYGEN__)
 #define SNOR_SHARED_BUS                     TRUE
 #endif
+
+/**
+ * @brief   Size of the read-ahead cache.
+ * @details Reads smaller than this size are served from an internal
+ *          buffer, the buffer is filled with a whole aligned block of
+ *          this size so that small sequential reads hit the buffer.
+ * @note    Must be zero, disabling the cache, or a power of two.
+ */
+#if !defined(SNOR_READ_CACHE_SIZE) || defined(__DOXYGEN__)
+#define SNOR_READ_CACHE_SIZE                0U
+#endif
+
+/**
+ * @brief   Reads through memory mapping switch.
+ * @details If set to @p TRUE then, after @p snorMemoryMap(), reads are
+ *          served from the memory mapped area while program and erase
+ *          operations temporarily leave the memory mapped mode.
+ * @note    The memory mapped area must not be accessed directly while an
+ *          erase operation is in progress.
+ * @note    Requires the WSPI bus driver with memory mapping support.
+ */
+#if !defined(SNOR_USE_XIP_READS) || defined(__DOXYGEN__)
+#define SNOR_USE_XIP_READS                  FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -81,6 +105,15 @@
 #error "invalid SNOR_BUS_DRIVER setting"
 #endif
 
+#if (SNOR_READ_CACHE_SIZE & (SNOR_READ_CACHE_SIZE - 1U)) != 0U
+#error "SNOR_READ_CACHE_SIZE must be zero or a power of two"
+#endif
+
+#if (SNOR_USE_XIP_READS == TRUE) &&                                         \
+    (SNOR_BUS_DRIVER != SNOR_BUS_DRIVER_WSPI)
+#error "SNOR_USE_XIP_READS requires SNOR_BUS_DRIVER_WSPI"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -138,6 +171,26 @@ typedef struct {
    * @brief   Device ID and unique ID.
    */
   uint8_t                       device_id[20];
+#if (SNOR_READ_CACHE_SIZE > 0U) || defined(__DOXYGEN__)
+  /**
+   * @brief   Offset of the cached block.
+   */
+  flash_offset_t                cache_offset;
+  /**
+   * @brief   Cached block validity.
+   */
+  bool                          cache_valid;
+  /**
+   * @brief   Read-ahead cache buffer.
+   */
+  uint8_t                       cache[SNOR_READ_CACHE_SIZE];
+#endif
+#if (SNOR_USE_XIP_READS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Memory mapped area address or @p NULL if not mapped.
+   */
+  uint8_t                       *xip_addr;
+#endif
 } SNORDriver;
 
 /*===========================================================================*/
@@ -0,0 +1,517 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_isoc.c
+ * @brief   USB isochronous streaming code.
+ * @details This module streams data over an isochronous endpoint using two
+ *          buffers, while the endpoint transfers one buffer the application
+ *          fills or consumes the other one. Transactions are re-armed from
+ *          the endpoint callbacks so that no thread is involved in the data
+ *          path.
+ * @note    The endpoint callbacks @p isocDataTransmitted(),
+ *          @p isocDataReceived() and @p isocFeedbackTransmitted() must be
+ *          specified in the @p USBEndpointConfig structures of the
+ *          involved endpoints.
+ *
+ * @addtogroup HAL_USB_ISOC
+ * @{
+ */
+
+#include "hal.h"
+
+#include "hal_usb_isoc.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the address of a stream buffer.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @param[in] i         buffer index
+ * @return              The buffer address.
+ *
+ * @notapi
+ */
+static uint8_t *isoc_buffer(USBIsocDriver *isocp, unsigned i) {
+
+  return isocp->config->buffers + (i * isocp->config->size);
+}
+
+/**
+ * @brief   Starts the next IN transaction.
+ * @details The next ready buffer is transmitted, if there is none then a
+ *          zero length packet is sent in order to keep the stream paced.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @notapi
+ */
+static void isoc_transmit(USBIsocDriver *isocp) {
+  USBDriver *usbp = isocp->config->usbp;
+  usbep_t ep = isocp->config->ep;
+  unsigned i = isocp->hw;
+
+  if ((usbGetDriverStateI(usbp) != USB_ACTIVE) ||
+      usbGetTransmitStatusI(usbp, ep)) {
+    return;
+  }
+
+  if (isocp->bstate[i] == ISOC_BUF_READY) {
+    isocp->bstate[i] = ISOC_BUF_BUSY;
+    usbStartTransmitI(usbp, ep, isoc_buffer(isocp, i), isocp->bsize[i]);
+  }
+  else {
+    isocp->underruns++;
+    usbStartTransmitI(usbp, ep, NULL, 0);
+  }
+}
+
+/**
+ * @brief   Starts the next OUT transaction.
+ * @details If the next buffer still holds unread data then the oldest data
+ *          is dropped.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @notapi
+ */
+static void isoc_receive(USBIsocDriver *isocp) {
+  USBDriver *usbp = isocp->config->usbp;
+  usbep_t ep = isocp->config->ep;
+  unsigned i = isocp->hw;
+
+  if ((usbGetDriverStateI(usbp) != USB_ACTIVE) ||
+      usbGetReceiveStatusI(usbp, ep)) {
+    return;
+  }
+
+  if (isocp->bstate[i] == ISOC_BUF_READY) {
+    /* Dropping the oldest received buffer.*/
+    isocp->overruns++;
+    isocp->app ^= 1U;
+  }
+  else if (isocp->bstate[i] == ISOC_BUF_TAKEN) {
+    /* The application is reading this buffer, dropping the last received
+       one instead.*/
+    isocp->overruns++;
+    i ^= 1U;
+    isocp->hw = i;
+  }
+  else {
+    /* Buffer free.*/
+  }
+
+  isocp->bstate[i] = ISOC_BUF_BUSY;
+  usbStartReceiveI(usbp, ep, isoc_buffer(isocp, i), isocp->config->size);
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a stream object.
+ *
+ * @param[out] isocp    pointer to the @p USBIsocDriver object
+ *
+ * @init
+ */
+void isocObjectInit(USBIsocDriver *isocp) {
+
+  osalDbgCheck(isocp != NULL);
+
+  isocp->state     = ISOC_STOP;
+  isocp->config    = NULL;
+  isocp->underruns = 0U;
+  isocp->overruns  = 0U;
+  isocp->arg       = NULL;
+}
+
+/**
+ * @brief   Configures a stream.
+ * @details The stream is associated to its endpoints, streaming is started
+ *          separately using @p isocStartStreamI() once the interface
+ *          alternate setting is selected by the host.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void isocStart(USBIsocDriver *isocp, const USBIsocConfig *config) {
+  USBDriver *usbp;
+
+  osalDbgCheck((isocp != NULL) && (config != NULL) &&
+               (config->usbp != NULL) && (config->buffers != NULL) &&
+               (config->ep > 0U) && (config->ep <= USB_MAX_ENDPOINTS) &&
+               (config->fb_ep <= USB_MAX_ENDPOINTS) &&
+               ((config->fb_ep == 0U) ||
+                (config->fb_size == USB_ISOC_FB_FS) ||
+                (config->fb_size == USB_ISOC_FB_HS)));
+
+  usbp = config->usbp;
+
+  osalSysLock();
+  osalDbgAssert((isocp->state == ISOC_STOP) || (isocp->state == ISOC_READY),
+                "invalid state");
+  isocp->config = config;
+  if (config->dir == USB_ISOC_IN) {
+    usbp->in_params[config->ep - 1U] = isocp;
+  }
+  else {
+    usbp->out_params[config->ep - 1U] = isocp;
+  }
+  if (config->fb_ep > 0U) {
+    usbp->in_params[config->fb_ep - 1U] = isocp;
+  }
+  isocp->state = ISOC_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops a stream.
+ * @details The stream is detached from its endpoints, transactions in
+ *          progress are completed but not re-armed.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @api
+ */
+void isocStop(USBIsocDriver *isocp) {
+  USBDriver *usbp;
+
+  osalDbgCheck(isocp != NULL);
+
+  osalSysLock();
+  osalDbgAssert((isocp->state == ISOC_STOP) || (isocp->state == ISOC_READY) ||
+                (isocp->state == ISOC_ACTIVE), "invalid state");
+  if (isocp->state != ISOC_STOP) {
+    usbp = isocp->config->usbp;
+    if (isocp->config->dir == USB_ISOC_IN) {
+      usbp->in_params[isocp->config->ep - 1U] = NULL;
+    }
+    else {
+      usbp->out_params[isocp->config->ep - 1U] = NULL;
+    }
+    if (isocp->config->fb_ep > 0U) {
+      usbp->in_params[isocp->config->fb_ep - 1U] = NULL;
+    }
+  }
+  isocp->config = NULL;
+  isocp->state  = ISOC_STOP;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts streaming.
+ * @details Buffers are emptied and the first transactions are armed, IN
+ *          streams start sending zero length packets until the first
+ *          buffer is committed.
+ * @note    This function is meant to be called from the interface
+ *          alternate setting handler.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @iclass
+ */
+void isocStartStreamI(USBIsocDriver *isocp) {
+  USBDriver *usbp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  osalDbgAssert(isocp->state == ISOC_READY, "invalid state");
+
+  usbp = isocp->config->usbp;
+  isocp->bstate[0] = ISOC_BUF_FREE;
+  isocp->bstate[1] = ISOC_BUF_FREE;
+  isocp->bsize[0]  = 0U;
+  isocp->bsize[1]  = 0U;
+  isocp->app       = 0U;
+  isocp->hw        = 0U;
+  isocp->state     = ISOC_ACTIVE;
+
+  if (isocp->config->dir == USB_ISOC_IN) {
+    isoc_transmit(isocp);
+  }
+  else {
+    isoc_receive(isocp);
+  }
+
+  if ((isocp->config->fb_ep > 0U) &&
+      (usbGetDriverStateI(usbp) == USB_ACTIVE) &&
+      !usbGetTransmitStatusI(usbp, isocp->config->fb_ep)) {
+    usbStartTransmitI(usbp, isocp->config->fb_ep,
+                      isocp->fb_buf, isocp->config->fb_size);
+  }
+}
+
+/**
+ * @brief   Stops streaming.
+ * @details Transactions in progress are completed but not re-armed.
+ * @note    This function is meant to be called from the interface
+ *          alternate setting handler and on USB reset or suspend events.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @iclass
+ */
+void isocStopStreamI(USBIsocDriver *isocp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  osalDbgAssert((isocp->state == ISOC_READY) || (isocp->state == ISOC_ACTIVE),
+                "invalid state");
+
+  isocp->state = ISOC_READY;
+}
+
+/**
+ * @brief   Gets a buffer from the stream.
+ * @details For IN streams a free buffer is returned for filling, it must
+ *          be handed back using @p isocCommitBufferI(). For OUT streams
+ *          the oldest received buffer is returned, it must be handed back
+ *          using @p isocReleaseBufferI().
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @param[out] np       pointer to a variable receiving the buffer capacity
+ *                      for IN streams or the received data size for OUT
+ *                      streams, can be @p NULL
+ * @return              The buffer pointer.
+ * @retval NULL         if no buffer is available.
+ *
+ * @iclass
+ */
+uint8_t *isocGetBufferI(USBIsocDriver *isocp, size_t *np) {
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  if (isocp->state != ISOC_ACTIVE) {
+    return NULL;
+  }
+
+  i = isocp->app;
+  if (isocp->config->dir == USB_ISOC_IN) {
+    if (isocp->bstate[i] != ISOC_BUF_FREE) {
+      return NULL;
+    }
+    isocp->bsize[i] = isocp->config->size;
+  }
+  else {
+    if (isocp->bstate[i] != ISOC_BUF_READY) {
+      return NULL;
+    }
+  }
+
+  isocp->bstate[i] = ISOC_BUF_TAKEN;
+  if (np != NULL) {
+    *np = isocp->bsize[i];
+  }
+
+  return isoc_buffer(isocp, i);
+}
+
+/**
+ * @brief   Commits a filled buffer to an IN stream.
+ * @details The buffer is transmitted in the next available interval.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @param[in] n         size of the data in the buffer
+ *
+ * @iclass
+ */
+void isocCommitBufferI(USBIsocDriver *isocp, size_t n) {
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  i = isocp->app;
+  osalDbgAssert((isocp->config->dir == USB_ISOC_IN) &&
+                (isocp->bstate[i] == ISOC_BUF_TAKEN), "no buffer taken");
+  osalDbgCheck(n <= isocp->config->size);
+
+  isocp->bsize[i]  = n;
+  isocp->bstate[i] = ISOC_BUF_READY;
+  isocp->app       = i ^ 1U;
+
+  if (isocp->state == ISOC_ACTIVE) {
+    isoc_transmit(isocp);
+  }
+}
+
+/**
+ * @brief   Releases a consumed buffer to an OUT stream.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ *
+ * @iclass
+ */
+void isocReleaseBufferI(USBIsocDriver *isocp) {
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  i = isocp->app;
+  osalDbgAssert((isocp->config->dir == USB_ISOC_OUT) &&
+                (isocp->bstate[i] == ISOC_BUF_TAKEN), "no buffer taken");
+
+  isocp->bstate[i] = ISOC_BUF_FREE;
+  isocp->app       = i ^ 1U;
+}
+
+/**
+ * @brief   Sets the explicit feedback value.
+ * @details The value is the number of samples per frame, or microframe
+ *          at high speed, in 16.16 fixed point format. It is converted
+ *          to 10.14 format for full speed feedback endpoints.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @param[in] value     feedback value in 16.16 format
+ *
+ * @iclass
+ */
+void isocSetFeedbackI(USBIsocDriver *isocp, uint32_t value) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(isocp != NULL);
+
+  if (isocp->config->fb_size == USB_ISOC_FB_FS) {
+    value >>= 2;
+  }
+  isocp->fb_buf[0] = (uint8_t)value;
+  isocp->fb_buf[1] = (uint8_t)(value >> 8);
+  isocp->fb_buf[2] = (uint8_t)(value >> 16);
+  isocp->fb_buf[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief   Default data transmitted callback.
+ * @details The transmitted buffer is freed, the next one is armed and the
+ *          application is notified.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        IN endpoint number
+ */
+void isocDataTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBIsocDriver *isocp = usbp->in_params[ep - 1U];
+
+  if (isocp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+
+  if (isocp->bstate[isocp->hw] == ISOC_BUF_BUSY) {
+    isocp->bstate[isocp->hw] = ISOC_BUF_FREE;
+    isocp->hw ^= 1U;
+  }
+
+  if (isocp->state != ISOC_ACTIVE) {
+    osalSysUnlockFromISR();
+    return;
+  }
+
+  isoc_transmit(isocp);
+
+  osalSysUnlockFromISR();
+
+  if (isocp->config->cb != NULL) {
+    isocp->config->cb(isocp);
+  }
+}
+
+/**
+ * @brief   Default data received callback.
+ * @details The received buffer is made available, the next one is armed
+ *          and the application is notified.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        OUT endpoint number
+ */
+void isocDataReceived(USBDriver *usbp, usbep_t ep) {
+  USBIsocDriver *isocp = usbp->out_params[ep - 1U];
+
+  if (isocp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+
+  if (isocp->state != ISOC_ACTIVE) {
+    osalSysUnlockFromISR();
+    return;
+  }
+
+  if (isocp->bstate[isocp->hw] == ISOC_BUF_BUSY) {
+    isocp->bsize[isocp->hw]  = usbGetReceiveTransactionSizeX(usbp, ep);
+    isocp->bstate[isocp->hw] = ISOC_BUF_READY;
+    isocp->hw ^= 1U;
+  }
+
+  isoc_receive(isocp);
+
+  osalSysUnlockFromISR();
+
+  if (isocp->config->cb != NULL) {
+    isocp->config->cb(isocp);
+  }
+}
+
+/**
+ * @brief   Default feedback transmitted callback.
+ * @details The current feedback value is armed for the next interval.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        feedback IN endpoint number
+ */
+void isocFeedbackTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBIsocDriver *isocp = usbp->in_params[ep - 1U];
+
+  if (isocp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+
+  if ((isocp->state == ISOC_ACTIVE) &&
+      (usbGetDriverStateI(usbp) == USB_ACTIVE)) {
+    usbStartTransmitI(usbp, ep, isocp->fb_buf, isocp->config->fb_size);
+  }
+
+  osalSysUnlockFromISR();
+}
+
+/** @} */
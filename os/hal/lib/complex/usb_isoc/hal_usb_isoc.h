@@ -0,0 +1,248 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_isoc.h
+ * @brief   USB isochronous streaming header.
+ *
+ * @addtogroup HAL_USB_ISOC
+ * @{
+ */
+
+#ifndef HAL_USB_ISOC_H
+#define HAL_USB_ISOC_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Feedback value sizes
+ * @{
+ */
+/**
+ * @brief   Full speed feedback, 10.14 format.
+ */
+#define USB_ISOC_FB_FS                      3U
+
+/**
+ * @brief   High speed feedback, 16.16 format.
+ */
+#define USB_ISOC_FB_HS                      4U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_USB != TRUE
+#error "USB isochronous streaming requires HAL_USE_USB"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  ISOC_UNINIT = 0,
+  ISOC_STOP = 1,
+  ISOC_READY = 2,
+  ISOC_ACTIVE = 3
+} isoc_state_t;
+
+/**
+ * @brief   Type of a stream direction.
+ */
+typedef enum {
+  USB_ISOC_IN = 0,
+  USB_ISOC_OUT = 1
+} isoc_dir_t;
+
+/**
+ * @brief   Type of a stream buffer state.
+ */
+typedef enum {
+  ISOC_BUF_FREE = 0,
+  ISOC_BUF_TAKEN = 1,
+  ISOC_BUF_READY = 2,
+  ISOC_BUF_BUSY = 3
+} isoc_buf_state_t;
+
+/**
+ * @brief   Type of a structure representing an isochronous stream.
+ */
+typedef struct USBIsocDriver USBIsocDriver;
+
+/**
+ * @brief   Type of a stream notification callback.
+ * @note    The callback is invoked from the endpoint callbacks, in ISR
+ *          context and outside the critical zone.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ */
+typedef void (*isoccb_t)(USBIsocDriver *isocp);
+
+/**
+ * @brief   Type of a stream configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   USB driver to use.
+   */
+  USBDriver                 *usbp;
+  /**
+   * @brief   Isochronous data endpoint.
+   */
+  usbep_t                   ep;
+  /**
+   * @brief   Stream direction.
+   */
+  isoc_dir_t                dir;
+  /**
+   * @brief   Stream buffers, two consecutive buffers of @p size bytes.
+   * @note    When the USB driver uses DMA the buffers must be located in
+   *          a DMA-reachable, non-cached memory area.
+   */
+  uint8_t                   *buffers;
+  /**
+   * @brief   Size of each buffer, at least the endpoint packet size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Callback invoked on each completed transaction or @p NULL.
+   * @details For IN streams it is the request to fill a buffer, for OUT
+   *          streams it is the notification of a received buffer.
+   */
+  isoccb_t                  cb;
+  /**
+   * @brief   Explicit feedback IN endpoint, zero if not used.
+   */
+  usbep_t                   fb_ep;
+  /**
+   * @brief   Feedback value size, @p USB_ISOC_FB_FS or @p USB_ISOC_FB_HS.
+   */
+  size_t                    fb_size;
+} USBIsocConfig;
+
+/**
+ * @brief   Structure representing an isochronous stream.
+ */
+struct USBIsocDriver {
+  /**
+   * @brief   Driver state.
+   */
+  isoc_state_t              state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const USBIsocConfig       *config;
+  /**
+   * @brief   Buffers state.
+   */
+  isoc_buf_state_t          bstate[2];
+  /**
+   * @brief   Buffers data size.
+   */
+  size_t                    bsize[2];
+  /**
+   * @brief   Next buffer to be used by the application.
+   */
+  unsigned                  app;
+  /**
+   * @brief   Next buffer to be used by the endpoint.
+   */
+  unsigned                  hw;
+  /**
+   * @brief   Feedback value buffer.
+   */
+  uint8_t                   fb_buf[4];
+  /**
+   * @brief   Number of intervals without data for an IN stream.
+   */
+  uint32_t                  underruns;
+  /**
+   * @brief   Number of buffers dropped by an OUT stream.
+   */
+  uint32_t                  overruns;
+  /**
+   * @brief   Application defined field.
+   */
+  void                      *arg;
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of IN stream underruns.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @return              The number of intervals without data.
+ *
+ * @xclass
+ */
+#define isocGetUnderrunsX(isocp) ((isocp)->underruns)
+
+/**
+ * @brief   Returns the number of OUT stream overruns.
+ *
+ * @param[in] isocp     pointer to the @p USBIsocDriver object
+ * @return              The number of dropped buffers.
+ *
+ * @xclass
+ */
+#define isocGetOverrunsX(isocp) ((isocp)->overruns)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void isocObjectInit(USBIsocDriver *isocp);
+  void isocStart(USBIsocDriver *isocp, const USBIsocConfig *config);
+  void isocStop(USBIsocDriver *isocp);
+  void isocStartStreamI(USBIsocDriver *isocp);
+  void isocStopStreamI(USBIsocDriver *isocp);
+  uint8_t *isocGetBufferI(USBIsocDriver *isocp, size_t *np);
+  void isocCommitBufferI(USBIsocDriver *isocp, size_t n);
+  void isocReleaseBufferI(USBIsocDriver *isocp);
+  void isocSetFeedbackI(USBIsocDriver *isocp, uint32_t value);
+  void isocDataTransmitted(USBDriver *usbp, usbep_t ep);
+  void isocDataReceived(USBDriver *usbp, usbep_t ep);
+  void isocFeedbackTransmitted(USBDriver *usbp, usbep_t ep);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_USB_ISOC_H */
+
+/** @} */
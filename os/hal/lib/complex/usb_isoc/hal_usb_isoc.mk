@@ -0,0 +1,9 @@
+# List of all the USB isochronous streaming files.
+USBISOCSRC := $(CHIBIOS)/os/hal/lib/complex/usb_isoc/hal_usb_isoc.c
+
+# Required include directories
+USBISOCINC := $(CHIBIOS)/os/hal/lib/complex/usb_isoc
+
+# Shared variables
+ALLCSRC += $(USBISOCSRC)
+ALLINC  += $(USBISOCINC)
@@ -0,0 +1,1011 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_msd.c
+ * @brief   USB Mass Storage Bulk-Only Transport function code.
+ * @details This module exports a @p BaseBlockDevice to the host as a
+ *          SCSI direct access device with a single LUN.
+ *          - Commands are executed by @p msdServe(), the application must
+ *            dedicate a thread to it.
+ *          - Data is moved through two buffers, the block device is read
+ *            or written using one buffer while the other one is exchanged
+ *            with the host, this way the bus and the media transfers
+ *            overlap.
+ *          .
+ * @note    The descriptors are provided by the application, the endpoint
+ *          callbacks @p msdDataTransmitted() and @p msdDataReceived() must
+ *          be specified in the @p USBEndpointConfig structures of the bulk
+ *          endpoints, @p msdRequestsHook() must be invoked from the USB
+ *          requests hook.
+ *
+ * @addtogroup HAL_USB_MSD
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#include "hal_usb_msd.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @name    Bulk transfers in progress
+ * @{
+ */
+#define MSD_PENDING_IN                      1U
+#define MSD_PENDING_OUT                     2U
+/** @} */
+
+/**
+ * @name    CBW fields offsets
+ * @{
+ */
+#define MSD_CBW_TAG                         4U
+#define MSD_CBW_LENGTH                      8U
+#define MSD_CBW_FLAGS                       12U
+#define MSD_CBW_LUN                         13U
+#define MSD_CBW_CB_LENGTH                   14U
+#define MSD_CBW_CB                          15U
+/** @} */
+
+/**
+ * @name    SCSI commands
+ * @{
+ */
+#define SCSI_TEST_UNIT_READY                0x00U
+#define SCSI_REQUEST_SENSE                  0x03U
+#define SCSI_INQUIRY                        0x12U
+#define SCSI_MODE_SENSE_6                   0x1AU
+#define SCSI_START_STOP_UNIT                0x1BU
+#define SCSI_PREVENT_ALLOW_REMOVAL          0x1EU
+#define SCSI_READ_FORMAT_CAPACITIES         0x23U
+#define SCSI_READ_CAPACITY_10               0x25U
+#define SCSI_READ_10                        0x28U
+#define SCSI_WRITE_10                       0x2AU
+#define SCSI_VERIFY_10                      0x2FU
+#define SCSI_SYNCHRONIZE_CACHE_10           0x35U
+#define SCSI_MODE_SENSE_10                  0x5AU
+/** @} */
+
+/**
+ * @name    SCSI sense keys
+ * @{
+ */
+#define SCSI_SENSE_NO_SENSE                 0x00U
+#define SCSI_SENSE_NOT_READY                0x02U
+#define SCSI_SENSE_MEDIUM_ERROR             0x03U
+#define SCSI_SENSE_ILLEGAL_REQUEST          0x05U
+#define SCSI_SENSE_DATA_PROTECT             0x07U
+/** @} */
+
+/**
+ * @name    SCSI additional sense codes
+ * @{
+ */
+#define SCSI_ASC_NONE                       0x00U
+#define SCSI_ASC_WRITE_FAULT                0x03U
+#define SCSI_ASC_UNRECOVERED_READ_ERROR     0x11U
+#define SCSI_ASC_INVALID_COMMAND            0x20U
+#define SCSI_ASC_LBA_OUT_OF_RANGE           0x21U
+#define SCSI_ASC_INVALID_FIELD_IN_CDB       0x24U
+#define SCSI_ASC_WRITE_PROTECTED            0x27U
+#define SCSI_ASC_MEDIUM_NOT_PRESENT         0x3AU
+/** @} */
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Answer to the GET_MAX_LUN request, a single LUN.
+ */
+static uint8_t msd_max_lun = 0U;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint32_t msd_get32(const uint8_t *p) {
+
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void msd_put32(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t msd_get16be(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 8) | (uint32_t)p[1];
+}
+
+static uint32_t msd_get32be(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void msd_put32be(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+/**
+ * @brief   Copies a string in a space padded SCSI field.
+ */
+static void msd_put_string(uint8_t *p, const char *s, size_t n) {
+
+  memset(p, ' ', n);
+  if (s != NULL) {
+    size_t len = strlen(s);
+    memcpy(p, s, len < n ? len : n);
+  }
+}
+
+/**
+ * @brief   Sets the sense data and fails the current command.
+ */
+static void msd_sense(USBMsdDriver *msdp, uint8_t key, uint8_t asc) {
+
+  msdp->sense_key = key;
+  msdp->asc       = asc;
+  msdp->ascq      = 0U;
+  msdp->status    = MSD_CSW_STATUS_FAILED;
+}
+
+/**
+ * @brief   Waits for the completion of bulk transfers.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[in] mask      transfers to be waited for
+ * @return              The operation status.
+ * @retval MSG_OK       if the transfers are complete.
+ * @retval MSG_RESET    if the command must be abandoned.
+ */
+static msg_t msd_wait(USBMsdDriver *msdp, uint8_t mask) {
+  msg_t msg = MSG_OK;
+
+  osalSysLock();
+  while ((msg == MSG_OK) && ((msdp->pending & mask) != 0U)) {
+    msg = osalThreadEnqueueTimeoutS(&msdp->waiting, TIME_INFINITE);
+  }
+  if (!msdp->connected || msdp->reset) {
+    msg = MSG_RESET;
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Starts sending data to the host.
+ * @details The previous IN transfer, if any, is waited for first.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[in] buf       buffer to be sent, it must stay untouched until the
+ *                      next IN transfer is started
+ * @param[in] n         number of bytes
+ * @return              The operation status.
+ */
+static msg_t msd_transmit(USBMsdDriver *msdp, const uint8_t *buf, size_t n) {
+  msg_t msg;
+
+  msg = msd_wait(msdp, MSD_PENDING_IN);
+  if (msg == MSG_OK) {
+    osalSysLock();
+    if (msdp->connected && !msdp->reset) {
+      msdp->pending |= MSD_PENDING_IN;
+      usbStartTransmitI(msdp->config->usbp, msdp->config->bulk_in, buf, n);
+    }
+    else {
+      msg = MSG_RESET;
+    }
+    osalSysUnlock();
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Starts receiving data from the host.
+ * @pre     No OUT transfer must be in progress.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[out] buf      receive buffer
+ * @param[in] n         number of bytes
+ * @return              The operation status.
+ */
+static msg_t msd_start_receive(USBMsdDriver *msdp, uint8_t *buf, size_t n) {
+  msg_t msg = MSG_OK;
+
+  osalSysLock();
+  if (msdp->connected && !msdp->reset) {
+    msdp->pending |= MSD_PENDING_OUT;
+    msdp->rxbuf    = buf;
+    usbStartReceiveI(msdp->config->usbp, msdp->config->bulk_out, buf, n);
+  }
+  else {
+    msg = MSG_RESET;
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Stalls the bulk IN endpoint.
+ * @details The function returns after the host cleared the halt condition.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_stall_in(USBMsdDriver *msdp) {
+  USBDriver *usbp = msdp->config->usbp;
+  msg_t msg;
+
+  msg = msd_wait(msdp, MSD_PENDING_IN);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  osalSysLock();
+  (void) usbStallTransmitI(usbp, msdp->config->bulk_in);
+  osalSysUnlock();
+
+  while (usb_lld_get_status_in(usbp, msdp->config->bulk_in) ==
+         EP_STATUS_STALLED) {
+    if (!msdp->connected || msdp->reset) {
+      return MSG_RESET;
+    }
+    osalThreadSleepMilliseconds(1);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Stalls the bulk OUT endpoint.
+ * @details The function returns after the host cleared the halt condition.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_stall_out(USBMsdDriver *msdp) {
+  USBDriver *usbp = msdp->config->usbp;
+  msg_t msg;
+
+  msg = msd_wait(msdp, MSD_PENDING_OUT);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  osalSysLock();
+  (void) usbStallReceiveI(usbp, msdp->config->bulk_out);
+  osalSysUnlock();
+
+  while (usb_lld_get_status_out(usbp, msdp->config->bulk_out) ==
+         EP_STATUS_STALLED) {
+    if (!msdp->connected || msdp->reset) {
+      return MSG_RESET;
+    }
+    osalThreadSleepMilliseconds(1);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Terminates a data phase expected by the host and not executed.
+ * @details The endpoint of the data phase is stalled and the whole length
+ *          is reported as residue.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_skip_data(USBMsdDriver *msdp) {
+
+  msdp->residue = msdp->length;
+  if (msdp->length == 0U) {
+    return MSG_OK;
+  }
+  if ((msdp->cbw[MSD_CBW_FLAGS] & 0x80U) != 0U) {
+    return msd_stall_in(msdp);
+  }
+  return msd_stall_out(msdp);
+}
+
+/**
+ * @brief   Terminates a command whose data phase disagrees with the host.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_phase_error(USBMsdDriver *msdp) {
+
+  msdp->status = MSD_CSW_STATUS_PHASE_ERROR;
+  return msd_skip_data(msdp);
+}
+
+/**
+ * @brief   Sends a command response to the host.
+ * @details The response is truncated to the length expected by the host,
+ *          if shorter then the IN endpoint is stalled after it.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[in] buf       response buffer
+ * @param[in] n         response size
+ * @return              The operation status.
+ */
+static msg_t msd_data_in(USBMsdDriver *msdp, const uint8_t *buf, size_t n) {
+  msg_t msg = MSG_OK;
+
+  if ((msdp->status != MSD_CSW_STATUS_PASSED) || (n == 0U)) {
+    return msd_skip_data(msdp);
+  }
+  if ((msdp->length == 0U) ||
+      ((msdp->cbw[MSD_CBW_FLAGS] & 0x80U) == 0U)) {
+    return msd_phase_error(msdp);
+  }
+
+  if (n > msdp->length) {
+    n = msdp->length;
+  }
+  msdp->residue = msdp->length - (uint32_t)n;
+  msg = msd_transmit(msdp, buf, n);
+  if ((msg == MSG_OK) && (msdp->residue > 0U)) {
+    msg = msd_stall_in(msdp);
+  }
+
+  return msg;
+}
+
+/**
+ * @brief   Checks the media and updates the block device information.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The media status.
+ * @retval true         if the media is ready.
+ * @retval false        if the media is not present, the sense data is set.
+ */
+static bool msd_media_ready(USBMsdDriver *msdp) {
+  BaseBlockDevice *bbdp = msdp->config->bbdp;
+
+  if (!blkIsInserted(bbdp) || (blkGetDriverState(bbdp) != BLK_READY) ||
+      (blkGetInfo(bbdp, &msdp->info) != HAL_SUCCESS)) {
+    msd_sense(msdp, SCSI_SENSE_NOT_READY, SCSI_ASC_MEDIUM_NOT_PRESENT);
+    return false;
+  }
+
+  osalDbgAssert((msdp->info.blk_size > 0U) &&
+                ((USB_MSD_BUFFERS_SIZE % msdp->info.blk_size) == 0U),
+                "unsupported block size");
+
+  return true;
+}
+
+/**
+ * @brief   Checks the range of a read or write command.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[in] lba       first block
+ * @param[in] n         number of blocks
+ * @return              The range status.
+ * @retval true         if the range is valid.
+ * @retval false        if the range is not valid, the sense data is set.
+ */
+static bool msd_check_range(USBMsdDriver *msdp, uint32_t lba, uint32_t n) {
+
+  if (!msd_media_ready(msdp)) {
+    return false;
+  }
+  if ((lba >= msdp->info.blk_num) || (n > (msdp->info.blk_num - lba))) {
+    msd_sense(msdp, SCSI_SENSE_ILLEGAL_REQUEST, SCSI_ASC_LBA_OUT_OF_RANGE);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   READ(10) command.
+ * @details A chunk is read from the block device while the previous one
+ *          is being transmitted.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_read(USBMsdDriver *msdp) {
+  const uint8_t *cb = &msdp->cbw[MSD_CBW_CB];
+  uint32_t lba = msd_get32be(&cb[2]);
+  uint32_t n = msd_get16be(&cb[7]);
+  uint32_t chunk;
+  unsigned i;
+
+  if (!msd_check_range(msdp, lba, n)) {
+    return msd_skip_data(msdp);
+  }
+  if (((msdp->cbw[MSD_CBW_FLAGS] & 0x80U) == 0U) ||
+      (msdp->length < (n * msdp->info.blk_size))) {
+    return msd_phase_error(msdp);
+  }
+
+  chunk = USB_MSD_BUFFERS_SIZE / msdp->info.blk_size;
+  msdp->residue = msdp->length;
+  i = 0U;
+  while (n > 0U) {
+    uint32_t k = n < chunk ? n : chunk;
+    msg_t msg;
+
+    if (blkRead(msdp->config->bbdp, lba, msdp->buf[i], k) != HAL_SUCCESS) {
+      msdp->io_errors++;
+      msd_sense(msdp, SCSI_SENSE_MEDIUM_ERROR,
+                SCSI_ASC_UNRECOVERED_READ_ERROR);
+      break;
+    }
+
+    /* The buffer just read is sent after the previous one.*/
+    msg = msd_transmit(msdp, msdp->buf[i], k * msdp->info.blk_size);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+
+    msdp->residue -= k * msdp->info.blk_size;
+    lba += k;
+    n   -= k;
+    i ^= 1U;
+  }
+
+  if (msdp->residue > 0U) {
+    return msd_stall_in(msdp);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   WRITE(10) command.
+ * @details A chunk is written to the block device while the next one is
+ *          being received.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_write(USBMsdDriver *msdp) {
+  const uint8_t *cb = &msdp->cbw[MSD_CBW_CB];
+  uint32_t lba = msd_get32be(&cb[2]);
+  uint32_t n = msd_get16be(&cb[7]);
+  uint32_t chunk, k;
+  unsigned i;
+  msg_t msg;
+
+  if (!msd_check_range(msdp, lba, n)) {
+    return msd_skip_data(msdp);
+  }
+  if (blkIsWriteProtected(msdp->config->bbdp)) {
+    msd_sense(msdp, SCSI_SENSE_DATA_PROTECT, SCSI_ASC_WRITE_PROTECTED);
+    return msd_skip_data(msdp);
+  }
+  if (((msdp->cbw[MSD_CBW_FLAGS] & 0x80U) != 0U) ||
+      (msdp->length < (n * msdp->info.blk_size))) {
+    return msd_phase_error(msdp);
+  }
+
+  chunk = USB_MSD_BUFFERS_SIZE / msdp->info.blk_size;
+  msdp->residue = msdp->length;
+  i = 0U;
+  k = n < chunk ? n : chunk;
+  if (k > 0U) {
+    msg = msd_start_receive(msdp, msdp->buf[0], k * msdp->info.blk_size);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+  }
+  while (n > 0U) {
+    uint32_t next;
+
+    msg = msd_wait(msdp, MSD_PENDING_OUT);
+    if (msg != MSG_OK) {
+      return msg;
+    }
+
+    /* Receiving the next chunk while writing the current one.*/
+    next = (n - k) < chunk ? (n - k) : chunk;
+    if (next > 0U) {
+      msg = msd_start_receive(msdp, msdp->buf[i ^ 1U],
+                              next * msdp->info.blk_size);
+      if (msg != MSG_OK) {
+        return msg;
+      }
+    }
+
+    /* After an error the data is still received but discarded.*/
+    if ((msdp->status == MSD_CSW_STATUS_PASSED) &&
+        (blkWrite(msdp->config->bbdp, lba, msdp->buf[i], k) != HAL_SUCCESS)) {
+      msdp->io_errors++;
+      msd_sense(msdp, SCSI_SENSE_MEDIUM_ERROR, SCSI_ASC_WRITE_FAULT);
+    }
+
+    msdp->residue -= k * msdp->info.blk_size;
+    lba += k;
+    n   -= k;
+    k    = next;
+    i ^= 1U;
+  }
+
+  if (msdp->residue > 0U) {
+    return msd_stall_out(msdp);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Executes the SCSI command in the received CBW.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ */
+static msg_t msd_execute(USBMsdDriver *msdp) {
+  const uint8_t *cb = &msdp->cbw[MSD_CBW_CB];
+  uint8_t *p = msdp->buf[0];
+  uint32_t alloc;
+
+  msdp->status = MSD_CSW_STATUS_PASSED;
+  if (cb[0] != SCSI_REQUEST_SENSE) {
+    msdp->sense_key = SCSI_SENSE_NO_SENSE;
+    msdp->asc       = SCSI_ASC_NONE;
+    msdp->ascq      = 0U;
+  }
+
+  switch (cb[0]) {
+  case SCSI_READ_10:
+    return msd_read(msdp);
+  case SCSI_WRITE_10:
+    return msd_write(msdp);
+  case SCSI_TEST_UNIT_READY:
+    (void) msd_media_ready(msdp);
+    return msd_skip_data(msdp);
+  case SCSI_REQUEST_SENSE:
+    memset(p, 0, 18);
+    p[0]  = 0x70U;                      /* Current error, fixed format.    */
+    p[2]  = msdp->sense_key;
+    p[7]  = 10U;                        /* Additional sense length.        */
+    p[12] = msdp->asc;
+    p[13] = msdp->ascq;
+    msdp->sense_key = SCSI_SENSE_NO_SENSE;
+    msdp->asc       = SCSI_ASC_NONE;
+    msdp->ascq      = 0U;
+    alloc = cb[4];
+    return msd_data_in(msdp, p, alloc < 18U ? alloc : 18U);
+  case SCSI_INQUIRY:
+    if ((cb[1] & 1U) != 0U) {
+      /* Vital product data pages are not supported.*/
+      msd_sense(msdp, SCSI_SENSE_ILLEGAL_REQUEST,
+                SCSI_ASC_INVALID_FIELD_IN_CDB);
+      return msd_skip_data(msdp);
+    }
+    memset(p, 0, 8);
+    p[1] = 0x80U;                       /* Removable.                      */
+    p[2] = 0x04U;                       /* SPC-2.                          */
+    p[3] = 0x02U;                       /* Response data format.           */
+    p[4] = 31U;                         /* Additional length.              */
+    msd_put_string(&p[8], msdp->config->vendor, 8U);
+    msd_put_string(&p[16], msdp->config->product, 16U);
+    msd_put_string(&p[32], msdp->config->revision, 4U);
+    alloc = msd_get16be(&cb[3]);
+    return msd_data_in(msdp, p, alloc < 36U ? alloc : 36U);
+  case SCSI_MODE_SENSE_6:
+    memset(p, 0, 4);
+    p[0] = 3U;                          /* Mode data length.               */
+    if (blkIsWriteProtected(msdp->config->bbdp)) {
+      p[2] = 0x80U;
+    }
+    alloc = cb[4];
+    return msd_data_in(msdp, p, alloc < 4U ? alloc : 4U);
+  case SCSI_MODE_SENSE_10:
+    memset(p, 0, 8);
+    p[1] = 6U;                          /* Mode data length.               */
+    if (blkIsWriteProtected(msdp->config->bbdp)) {
+      p[3] = 0x80U;
+    }
+    alloc = msd_get16be(&cb[7]);
+    return msd_data_in(msdp, p, alloc < 8U ? alloc : 8U);
+  case SCSI_READ_CAPACITY_10:
+    if (!msd_media_ready(msdp)) {
+      return msd_skip_data(msdp);
+    }
+    msd_put32be(&p[0], msdp->info.blk_num - 1U);
+    msd_put32be(&p[4], msdp->info.blk_size);
+    return msd_data_in(msdp, p, 8U);
+  case SCSI_READ_FORMAT_CAPACITIES:
+    if (!msd_media_ready(msdp)) {
+      return msd_skip_data(msdp);
+    }
+    memset(p, 0, 4);
+    p[3] = 8U;                          /* Capacity list length.           */
+    msd_put32be(&p[4], msdp->info.blk_num);
+    msd_put32be(&p[8], msdp->info.blk_size);
+    p[8] = 0x02U;                       /* Formatted media.                */
+    alloc = msd_get16be(&cb[7]);
+    return msd_data_in(msdp, p, alloc < 12U ? alloc : 12U);
+  case SCSI_SYNCHRONIZE_CACHE_10:
+    if (blkSync(msdp->config->bbdp) != HAL_SUCCESS) {
+      msd_sense(msdp, SCSI_SENSE_MEDIUM_ERROR, SCSI_ASC_WRITE_FAULT);
+    }
+    return msd_skip_data(msdp);
+  case SCSI_START_STOP_UNIT:
+  case SCSI_PREVENT_ALLOW_REMOVAL:
+  case SCSI_VERIFY_10:
+    return msd_skip_data(msdp);
+  default:
+    msd_sense(msdp, SCSI_SENSE_ILLEGAL_REQUEST, SCSI_ASC_INVALID_COMMAND);
+    return msd_skip_data(msdp);
+  }
+}
+
+/**
+ * @brief   Receives a CBW.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The operation status.
+ * @retval MSG_OK       if a valid CBW has been received.
+ * @retval MSG_TIMEOUT  if an invalid CBW has been received.
+ * @retval MSG_RESET    if the device has been reset or disconnected.
+ */
+static msg_t msd_receive_cbw(USBMsdDriver *msdp) {
+  USBDriver *usbp = msdp->config->usbp;
+  size_t n;
+  msg_t msg;
+
+  osalSysLock();
+  if ((msdp->pending & MSD_PENDING_OUT) == 0U) {
+    msdp->pending |= MSD_PENDING_OUT;
+    msdp->rxbuf    = msdp->cbw;
+    usbStartReceiveI(usbp, msdp->config->bulk_out, msdp->cbw,
+                     sizeof msdp->cbw);
+  }
+  else {
+    /* An OUT transfer abandoned by a reset is still in progress, the CBW
+       sent by the host after the reset recovery terminates it.*/
+  }
+  osalSysUnlock();
+
+  msg = msd_wait(msdp, MSD_PENDING_OUT);
+  if (msg != MSG_OK) {
+    return msg;
+  }
+
+  n = usbGetReceiveTransactionSizeX(usbp, msdp->config->bulk_out);
+  if (n != MSD_CBW_SIZE) {
+    return MSG_TIMEOUT;
+  }
+  if (msdp->rxbuf != msdp->cbw) {
+    memcpy(msdp->cbw, msdp->rxbuf, MSD_CBW_SIZE);
+  }
+  if ((msd_get32(&msdp->cbw[0]) != MSD_CBW_SIGNATURE) ||
+      (msdp->cbw[MSD_CBW_LUN] != 0U) ||
+      (msdp->cbw[MSD_CBW_CB_LENGTH] < 1U) ||
+      (msdp->cbw[MSD_CBW_CB_LENGTH] > 16U)) {
+    return MSG_TIMEOUT;
+  }
+
+  msdp->tag     = msd_get32(&msdp->cbw[MSD_CBW_TAG]);
+  msdp->length  = msd_get32(&msdp->cbw[MSD_CBW_LENGTH]);
+  msdp->residue = 0U;
+
+  return MSG_OK;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a MSD function object.
+ *
+ * @param[out] msdp     pointer to the @p USBMsdDriver object
+ *
+ * @init
+ */
+void msdObjectInit(USBMsdDriver *msdp) {
+
+  osalDbgCheck(msdp != NULL);
+
+  msdp->state     = MSD_STOP;
+  msdp->config    = NULL;
+  msdp->connected = false;
+  msdp->reset     = false;
+  msdp->pending   = 0U;
+  msdp->rxbuf     = NULL;
+  msdp->sense_key = SCSI_SENSE_NO_SENSE;
+  msdp->asc       = SCSI_ASC_NONE;
+  msdp->ascq      = 0U;
+  msdp->io_errors = 0U;
+  msdp->arg       = NULL;
+  osalThreadQueueObjectInit(&msdp->waiting);
+}
+
+/**
+ * @brief   Configures a MSD function.
+ * @details The function is associated to its endpoints, commands are
+ *          accepted after the device has been configured by the host.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void msdStart(USBMsdDriver *msdp, const USBMsdConfig *config) {
+  USBDriver *usbp;
+
+  osalDbgCheck((msdp != NULL) && (config != NULL) &&
+               (config->usbp != NULL) && (config->bbdp != NULL) &&
+               (config->bulk_in > 0U) &&
+               (config->bulk_in <= USB_MAX_ENDPOINTS) &&
+               (config->bulk_out > 0U) &&
+               (config->bulk_out <= USB_MAX_ENDPOINTS));
+
+  usbp = config->usbp;
+
+  osalSysLock();
+  osalDbgAssert((msdp->state == MSD_STOP) || (msdp->state == MSD_READY),
+                "invalid state");
+  usbp->in_params[config->bulk_in - 1U]   = msdp;
+  usbp->out_params[config->bulk_out - 1U] = msdp;
+  msdp->config = config;
+  msdp->state  = MSD_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops a MSD function.
+ * @details The thread executing @p msdServe() returns.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ *
+ * @api
+ */
+void msdStop(USBMsdDriver *msdp) {
+  USBDriver *usbp;
+
+  osalDbgCheck(msdp != NULL);
+
+  osalSysLock();
+  osalDbgAssert((msdp->state == MSD_STOP) || (msdp->state == MSD_READY),
+                "invalid state");
+
+  if (msdp->state == MSD_READY) {
+    usbp = msdp->config->usbp;
+    usbp->in_params[msdp->config->bulk_in - 1U]   = NULL;
+    usbp->out_params[msdp->config->bulk_out - 1U] = NULL;
+  }
+  msdp->state     = MSD_STOP;
+  msdp->connected = false;
+  osalThreadDequeueAllI(&msdp->waiting, MSG_RESET);
+  osalOsRescheduleS();
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   USB device configured handler.
+ * @details The function starts accepting commands, a command abandoned
+ *          by a previous configuration is terminated.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ *
+ * @iclass
+ */
+void msdConfigureHookI(USBMsdDriver *msdp) {
+
+  osalDbgCheckClassI();
+
+  msdp->connected = true;
+  msdp->reset     = true;
+  msdp->pending   = 0U;
+  osalThreadDequeueAllI(&msdp->waiting, MSG_RESET);
+}
+
+/**
+ * @brief   USB device suspend handler.
+ * @details The command in progress is abandoned.
+ * @note    It is meant to be called also on USB reset and unconfigured
+ *          events.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ *
+ * @iclass
+ */
+void msdSuspendHookI(USBMsdDriver *msdp) {
+
+  osalDbgCheckClassI();
+
+  msdp->connected = false;
+  msdp->pending   = 0U;
+  osalThreadDequeueAllI(&msdp->waiting, MSG_RESET);
+}
+
+/**
+ * @brief   USB device wakeup handler.
+ * @details Commands are accepted again if the device is still configured.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ *
+ * @iclass
+ */
+void msdWakeupHookI(USBMsdDriver *msdp) {
+
+  osalDbgCheckClassI();
+
+  if (usbGetDriverStateI(msdp->config->usbp) == USB_ACTIVE) {
+    msdp->connected = true;
+    msdp->reset     = true;
+    osalThreadDequeueAllI(&msdp->waiting, MSG_RESET);
+  }
+}
+
+/**
+ * @brief   MSD requests handler.
+ * @details Applications must invoke this function from the USB requests
+ *          hook. The following requests are handled:
+ *          - Bulk-Only Mass Storage Reset.
+ *          - Get Max LUN, a single LUN is reported.
+ *          .
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The hook status.
+ * @retval true         Message handled internally.
+ * @retval false        Message not handled.
+ */
+bool msdRequestsHook(USBMsdDriver *msdp) {
+  USBDriver *usbp = msdp->config->usbp;
+
+  if (((usbp->setup[0] & USB_RTYPE_TYPE_MASK) != USB_RTYPE_TYPE_CLASS) ||
+      ((usbp->setup[0] & USB_RTYPE_RECIPIENT_MASK) !=
+       USB_RTYPE_RECIPIENT_INTERFACE) ||
+      (usbp->setup[4] != msdp->config->ifnum)) {
+    return false;
+  }
+
+  switch (usbp->setup[1]) {
+  case MSD_REQ_RESET:
+    osalSysLockFromISR();
+    msdp->reset = true;
+    osalThreadDequeueAllI(&msdp->waiting, MSG_RESET);
+    osalSysUnlockFromISR();
+    usbSetupTransfer(usbp, NULL, 0, NULL);
+    return true;
+  case MSD_REQ_GET_MAX_LUN:
+    usbSetupTransfer(usbp, &msd_max_lun, 1, NULL);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief   Executes the commands sent by the host.
+ * @details This function is meant to be the body of a dedicated thread,
+ *          the block device is accessed from this thread only.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ *
+ * @api
+ */
+void msdServe(USBMsdDriver *msdp) {
+
+  osalDbgCheck(msdp != NULL);
+
+  while (true) {
+    msg_t msg;
+
+    /* Waiting for the host, a reset condition is cleared here.*/
+    osalSysLock();
+    while (!msdp->connected) {
+      if (msdp->state != MSD_READY) {
+        osalSysUnlock();
+        return;
+      }
+      (void) osalThreadEnqueueTimeoutS(&msdp->waiting, TIME_INFINITE);
+    }
+    msdp->reset = false;
+    osalSysUnlock();
+
+    msg = msd_receive_cbw(msdp);
+    if (msg == MSG_TIMEOUT) {
+      /* Invalid CBW, both endpoints are stalled until the host performs
+         a reset recovery.*/
+      osalSysLock();
+      (void) usbStallTransmitI(msdp->config->usbp, msdp->config->bulk_in);
+      (void) usbStallReceiveI(msdp->config->usbp, msdp->config->bulk_out);
+      while (msdp->connected && !msdp->reset) {
+        (void) osalThreadEnqueueTimeoutS(&msdp->waiting, TIME_INFINITE);
+      }
+      osalSysUnlock();
+      continue;
+    }
+
+    if (msg == MSG_OK) {
+      msg = msd_execute(msdp);
+    }
+
+    if (msg == MSG_OK) {
+      /* Command status, the tag is copied from the CBW.*/
+      msd_put32(&msdp->csw[0], MSD_CSW_SIGNATURE);
+      msd_put32(&msdp->csw[4], msdp->tag);
+      msd_put32(&msdp->csw[8], msdp->residue);
+      msdp->csw[12] = msdp->status;
+      (void) msd_transmit(msdp, msdp->csw, MSD_CSW_SIZE);
+    }
+  }
+}
+
+/**
+ * @brief   Default data transmitted callback.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        IN endpoint number
+ */
+void msdDataTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBMsdDriver *msdp = usbp->in_params[ep - 1U];
+
+  if (msdp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+  msdp->pending &= (uint8_t)~MSD_PENDING_IN;
+  osalThreadDequeueAllI(&msdp->waiting, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Default data received callback.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        OUT endpoint number
+ */
+void msdDataReceived(USBDriver *usbp, usbep_t ep) {
+  USBMsdDriver *msdp = usbp->out_params[ep - 1U];
+
+  if (msdp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+  msdp->pending &= (uint8_t)~MSD_PENDING_OUT;
+  osalThreadDequeueAllI(&msdp->waiting, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/** @} */
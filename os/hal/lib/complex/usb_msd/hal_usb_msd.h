@@ -0,0 +1,271 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_msd.h
+ * @brief   USB Mass Storage Bulk-Only Transport function header.
+ *
+ * @addtogroup HAL_USB_MSD
+ * @{
+ */
+
+#ifndef HAL_USB_MSD_H
+#define HAL_USB_MSD_H
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Mass Storage class requests
+ * @{
+ */
+#define MSD_REQ_RESET                       0xFFU
+#define MSD_REQ_GET_MAX_LUN                 0xFEU
+/** @} */
+
+/**
+ * @name    Bulk-Only Transport wrappers
+ * @{
+ */
+#define MSD_CBW_SIGNATURE                   0x43425355U
+#define MSD_CSW_SIGNATURE                   0x53425355U
+#define MSD_CBW_SIZE                        31U
+#define MSD_CSW_SIZE                        13U
+/** @} */
+
+/**
+ * @name    Command status values
+ * @{
+ */
+#define MSD_CSW_STATUS_PASSED               0x00U
+#define MSD_CSW_STATUS_FAILED               0x01U
+#define MSD_CSW_STATUS_PHASE_ERROR          0x02U
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Transfer buffers size.
+ * @details Two buffers of this size are used, while one is exchanged with
+ *          the host the other one is read from or written to the block
+ *          device.
+ * @note    It must be a multiple of the block size and of the bulk
+ *          endpoints packet size, larger buffers allow multi-block
+ *          operations on the block device.
+ */
+#if !defined(USB_MSD_BUFFERS_SIZE) || defined(__DOXYGEN__)
+#define USB_MSD_BUFFERS_SIZE                4096
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_USB != TRUE
+#error "USB MSD requires HAL_USE_USB"
+#endif
+
+#if (USB_MSD_BUFFERS_SIZE < 512) || ((USB_MSD_BUFFERS_SIZE % 512) != 0)
+#error "USB_MSD_BUFFERS_SIZE must be a multiple of 512"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  MSD_UNINIT = 0,
+  MSD_STOP = 1,
+  MSD_READY = 2
+} msd_state_t;
+
+/**
+ * @brief   Type of a MSD function configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   USB driver to use.
+   */
+  USBDriver                 *usbp;
+  /**
+   * @brief   Bulk IN endpoint.
+   */
+  usbep_t                   bulk_in;
+  /**
+   * @brief   Bulk OUT endpoint.
+   */
+  usbep_t                   bulk_out;
+  /**
+   * @brief   Mass storage interface number.
+   */
+  uint8_t                   ifnum;
+  /**
+   * @brief   Block device exported to the host.
+   * @note    The block device must be already connected.
+   */
+  BaseBlockDevice           *bbdp;
+  /**
+   * @brief   SCSI vendor identification, up to 8 characters.
+   */
+  const char                *vendor;
+  /**
+   * @brief   SCSI product identification, up to 16 characters.
+   */
+  const char                *product;
+  /**
+   * @brief   SCSI product revision, up to 4 characters.
+   */
+  const char                *revision;
+} USBMsdConfig;
+
+/**
+ * @brief   Structure representing a MSD function.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  msd_state_t               state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const USBMsdConfig        *config;
+  /**
+   * @brief   The device is configured, the host can send commands.
+   */
+  bool                      connected;
+  /**
+   * @brief   The command in progress must be abandoned.
+   * @details It is set by a Bulk-Only Mass Storage Reset and when the
+   *          device is configured again.
+   */
+  bool                      reset;
+  /**
+   * @brief   Bulk transfers in progress mask.
+   */
+  uint8_t                   pending;
+  /**
+   * @brief   Threads waiting for a transfer or a state change.
+   */
+  threads_queue_t           waiting;
+  /**
+   * @brief   Information about the block device.
+   */
+  BlockDeviceInfo           info;
+  /**
+   * @brief   Buffer of the OUT transfer in progress.
+   */
+  uint8_t                   *rxbuf;
+  /**
+   * @name    Current command state
+   * @{
+   */
+  uint32_t                  tag;
+  uint32_t                  length;
+  uint32_t                  residue;
+  uint8_t                   status;
+  /** @} */
+  /**
+   * @name    Sense data of the last command
+   * @{
+   */
+  uint8_t                   sense_key;
+  uint8_t                   asc;
+  uint8_t                   ascq;
+  /** @} */
+  /**
+   * @brief   Received command block wrapper.
+   */
+  uint8_t                   cbw[32];
+  /**
+   * @brief   Command status wrapper to be sent.
+   */
+  uint8_t                   csw[16];
+  /**
+   * @brief   Transfer buffers.
+   */
+  uint8_t                   buf[2][USB_MSD_BUFFERS_SIZE];
+  /**
+   * @brief   Number of read and write errors reported to the host.
+   */
+  uint32_t                  io_errors;
+  /**
+   * @brief   Application defined field.
+   */
+  void                      *arg;
+} USBMsdDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the connection status.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The connection status.
+ *
+ * @xclass
+ */
+#define msdIsConnectedX(msdp) ((msdp)->connected)
+
+/**
+ * @brief   Returns the number of I/O errors.
+ *
+ * @param[in] msdp      pointer to the @p USBMsdDriver object
+ * @return              The number of block device errors reported to the
+ *                      host.
+ *
+ * @xclass
+ */
+#define msdGetIOErrorsX(msdp) ((msdp)->io_errors)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void msdObjectInit(USBMsdDriver *msdp);
+  void msdStart(USBMsdDriver *msdp, const USBMsdConfig *config);
+  void msdStop(USBMsdDriver *msdp);
+  void msdConfigureHookI(USBMsdDriver *msdp);
+  void msdSuspendHookI(USBMsdDriver *msdp);
+  void msdWakeupHookI(USBMsdDriver *msdp);
+  bool msdRequestsHook(USBMsdDriver *msdp);
+  void msdServe(USBMsdDriver *msdp);
+  void msdDataTransmitted(USBDriver *usbp, usbep_t ep);
+  void msdDataReceived(USBDriver *usbp, usbep_t ep);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_USB_MSD_H */
+
+/** @} */
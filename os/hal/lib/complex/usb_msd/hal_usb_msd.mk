@@ -0,0 +1,9 @@
+# List of all the USB Mass Storage files.
+USBMSDSRC := $(CHIBIOS)/os/hal/lib/complex/usb_msd/hal_usb_msd.c
+
+# Required include directories
+USBMSDINC := $(CHIBIOS)/os/hal/lib/complex/usb_msd
+
+# Shared variables
+ALLCSRC += $(USBMSDSRC)
+ALLINC  += $(USBMSDINC)
@@ -0,0 +1,1057 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_ncm.c
+ * @brief   USB CDC-NCM network function code.
+ * @details This module implements the data path of a CDC-NCM function,
+ *          Ethernet frames are exchanged with the host aggregated in NTB16
+ *          transfer blocks, NTBs are kept in the buffers of an input and
+ *          an output buffers queue.
+ *          - Received datagrams are returned pointing inside the NTB
+ *            buffer, the NTB is released once all its datagrams have been
+ *            released.
+ *          - Datagrams to be transmitted are written directly in the NTB
+ *            being assembled, the NTB is sent immediately if the bulk IN
+ *            endpoint is idle else it accumulates datagrams until the
+ *            previous transfer is complete.
+ *          .
+ * @note    The descriptors are provided by the application, the data
+ *          interface must have an alternate setting zero without endpoints
+ *          and an alternate setting one with the bulk endpoints.
+ * @note    The endpoint callbacks @p ncmDataTransmitted(),
+ *          @p ncmDataReceived() and @p ncmInterruptTransmitted() must be
+ *          specified in the @p USBEndpointConfig structures of the
+ *          involved endpoints, @p ncmRequestsHook() must be invoked from
+ *          the USB requests hook.
+ *
+ * @addtogroup HAL_USB_NCM
+ * @{
+ */
+
+#include "hal.h"
+
+#include "hal_usb_ncm.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @name    Pending notifications
+ * @{
+ */
+#define NCM_NTF_SPEED                       1U
+#define NCM_NTF_CONNECTION                  2U
+/** @} */
+
+/**
+ * @brief   Datagrams and NDP alignment inside a NTB.
+ */
+#define NCM_ALIGN                           4U
+
+/**
+ * @brief   Offset of received datagrams from the alignment boundary.
+ * @details It makes the IP header following the Ethernet header aligned.
+ */
+#define NCM_OUT_REMAINDER                   2U
+
+/**
+ * @brief   Rounds up to the NTB alignment.
+ */
+#define NCM_ROUND(n) (((n) + (NCM_ALIGN - 1U)) & ~(size_t)(NCM_ALIGN - 1U))
+
+/**
+ * @brief   Size of a NDP16 with @p n datagram entries.
+ */
+#define NCM_NDP_SIZE(n)                                                     \
+  (USB_NCM_NDP16_HEADER_SIZE + (((n) + 1U) * USB_NCM_NDP16_ENTRY_SIZE))
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint16_t ncm_get16(const uint8_t *p) {
+
+  return (uint16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t ncm_get32(const uint8_t *p) {
+
+  return (uint32_t)p[0]         | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void ncm_put16(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void ncm_put32(uint8_t *p, uint32_t v) {
+
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief   Starts a receive transaction if a buffer is available.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @notapi
+ */
+static void ncm_start_receive(USBNcmDriver *ncmp) {
+  USBDriver *usbp = ncmp->config->usbp;
+  uint8_t *buf;
+
+  if ((usbGetDriverStateI(usbp) != USB_ACTIVE) || !ncmp->connected ||
+      usbGetReceiveStatusI(usbp, ncmp->config->bulk_out)) {
+    return;
+  }
+
+  buf = ibqGetEmptyBufferI(&ncmp->ibqueue);
+  if (buf != NULL) {
+    usbStartReceiveI(usbp, ncmp->config->bulk_out, buf, USB_NCM_BUFFERS_SIZE);
+  }
+}
+
+/**
+ * @brief   Sends the next pending notification.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @notapi
+ */
+static void ncm_notify(USBNcmDriver *ncmp) {
+  USBDriver *usbp = ncmp->config->usbp;
+  uint8_t *p = ncmp->ntf_buf;
+  size_t n;
+
+  if ((ncmp->config->int_in == 0U) || (ncmp->ntf_pending == 0U) ||
+      (usbGetDriverStateI(usbp) != USB_ACTIVE) ||
+      usbGetTransmitStatusI(usbp, ncmp->config->int_in)) {
+    return;
+  }
+
+  p[0] = USB_RTYPE_DIR_DEV2HOST | USB_RTYPE_TYPE_CLASS |
+         USB_RTYPE_RECIPIENT_INTERFACE;
+  ncm_put16(&p[4], ncmp->config->ctrl_if);
+  if ((ncmp->ntf_pending & NCM_NTF_SPEED) != 0U) {
+    /* The speed is notified before connecting.*/
+    ncmp->ntf_pending &= ~NCM_NTF_SPEED;
+    p[1] = CDC_CONNECTION_SPEED_CHANGE;
+    ncm_put16(&p[2], 0U);
+    ncm_put16(&p[6], 8U);
+    ncm_put32(&p[8], ncmp->config->speed);
+    ncm_put32(&p[12], ncmp->config->speed);
+    n = 16U;
+  }
+  else {
+    ncmp->ntf_pending &= ~NCM_NTF_CONNECTION;
+    p[1] = CDC_NETWORK_CONNECTION;
+    ncm_put16(&p[2], ncmp->connected ? 1U : 0U);
+    ncm_put16(&p[6], 0U);
+    n = 8U;
+  }
+  usbStartTransmitI(usbp, ncmp->config->int_in, p, n);
+}
+
+/**
+ * @brief   Selects the data interface alternate setting.
+ * @details Selecting the alternate setting one empties the queues and
+ *          starts the data path, selecting zero suspends it.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[in] alt       alternate setting
+ *
+ * @notapi
+ */
+static void ncm_set_alt(USBNcmDriver *ncmp, uint8_t alt) {
+
+  ncmp->alt = alt;
+  if (alt == 1U) {
+    /* The NTB being parsed is kept while its datagrams are referenced.*/
+    if (ncmp->rx_refs == 0U) {
+      ibqResetI(&ncmp->ibqueue);
+      ncmp->rx_ntb = NULL;
+    }
+    obqResetI(&ncmp->obqueue);
+    ncmp->tx_seq    = 0U;
+    bqResumeX(&ncmp->ibqueue);
+    bqResumeX(&ncmp->obqueue);
+    ncmp->connected = true;
+    ncmp->ntf_pending = NCM_NTF_SPEED | NCM_NTF_CONNECTION;
+    ncm_start_receive(ncmp);
+  }
+  else {
+    bqSuspendI(&ncmp->ibqueue);
+    bqSuspendI(&ncmp->obqueue);
+    ncmp->connected = false;
+    ncmp->ntf_pending = NCM_NTF_CONNECTION;
+  }
+  ncm_notify(ncmp);
+}
+
+/**
+ * @brief   Returns the start of the NTB being assembled.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The NTB address.
+ *
+ * @notapi
+ */
+static uint8_t *ncm_tx_base(USBNcmDriver *ncmp) {
+
+  return ncmp->obqueue.bwrptr + sizeof (size_t);
+}
+
+/**
+ * @brief   Returns the NTB size limit set by the host.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The NTB size limit.
+ *
+ * @notapi
+ */
+static size_t ncm_tx_limit(USBNcmDriver *ncmp) {
+  uint32_t size = ncm_get32(ncmp->ntb_in_buf);
+
+  if ((size < USB_NCM_MIN_NTB_SIZE) || (size > USB_NCM_BUFFERS_SIZE)) {
+    return USB_NCM_BUFFERS_SIZE;
+  }
+  return (size_t)size;
+}
+
+/**
+ * @brief   Checks if a datagram fits in the NTB being assembled.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[in] n         datagram size
+ * @return              The check result.
+ *
+ * @notapi
+ */
+static bool ncm_tx_fits(USBNcmDriver *ncmp, size_t n) {
+  size_t offset = NCM_ROUND((size_t)(ncmp->obqueue.ptr - ncm_tx_base(ncmp)));
+
+  return (ncmp->tx_count < (unsigned)USB_NCM_TX_MAX_DATAGRAMS) &&
+         ((NCM_ROUND(offset + n) +
+           NCM_NDP_SIZE(ncmp->tx_count + 1U)) <= ncmp->tx_max);
+}
+
+/**
+ * @brief   Completes the NTB being assembled.
+ * @details The NDP is appended after the last datagram and the NTH is
+ *          written at the beginning of the buffer, the buffer pointer is
+ *          moved at the end of the NTB.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The NTB size.
+ *
+ * @notapi
+ */
+static size_t ncm_tx_finalize(USBNcmDriver *ncmp) {
+  uint8_t *base = ncm_tx_base(ncmp);
+  size_t ndp = NCM_ROUND((size_t)(ncmp->obqueue.ptr - base));
+  size_t ndpsize = NCM_NDP_SIZE(ncmp->tx_count);
+  uint8_t *p = base + ndp;
+  unsigned i;
+
+  ncm_put32(&p[0], USB_NCM_NDP16_SIGNATURE);
+  ncm_put16(&p[4], ndpsize);
+  ncm_put16(&p[6], 0U);
+  p += USB_NCM_NDP16_HEADER_SIZE;
+  for (i = 0U; i < ncmp->tx_count; i++) {
+    ncm_put16(&p[0], ncmp->tx_index[i]);
+    ncm_put16(&p[2], ncmp->tx_length[i]);
+    p += USB_NCM_NDP16_ENTRY_SIZE;
+  }
+  ncm_put32(&p[0], 0U);
+
+  ncm_put32(&base[0], USB_NCM_NTH16_SIGNATURE);
+  ncm_put16(&base[4], USB_NCM_NTH16_SIZE);
+  ncm_put16(&base[6], ncmp->tx_seq++);
+  ncm_put16(&base[8], ndp + ndpsize);
+  ncm_put16(&base[10], ndp);
+
+  ncmp->obqueue.ptr = base + ndp + ndpsize;
+
+  return ndp + ndpsize;
+}
+
+/**
+ * @brief   Checks if the NTB being assembled can be sent right now.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The check result.
+ *
+ * @notapi
+ */
+static bool ncm_tx_ready(USBNcmDriver *ncmp) {
+
+  return (ncmp->obqueue.ptr != NULL) && (ncmp->tx_count > 0U) &&
+         !ncmp->tx_busy;
+}
+
+/**
+ * @brief   Starts transmitting the next queued NTB if the endpoint is idle.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @notapi
+ */
+static void ncm_tx_start(USBNcmDriver *ncmp) {
+  USBDriver *usbp = ncmp->config->usbp;
+  uint8_t *buf;
+  size_t n;
+
+  if ((usbGetDriverStateI(usbp) != USB_ACTIVE) || !ncmp->connected ||
+      usbGetTransmitStatusI(usbp, ncmp->config->bulk_in)) {
+    return;
+  }
+
+  buf = obqGetFullBufferI(&ncmp->obqueue, &n);
+  if (buf != NULL) {
+    usbStartTransmitI(usbp, ncmp->config->bulk_in, buf, n);
+  }
+}
+
+/**
+ * @brief   Validates the NDP at the current parser position.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The validation result.
+ *
+ * @notapi
+ */
+static bool ncm_rx_ndp(USBNcmDriver *ncmp) {
+  size_t ndp = ncmp->rx_ndp;
+  const uint8_t *p = ncmp->rx_ntb + ndp;
+  size_t len;
+
+  if ((ndp < USB_NCM_NTH16_SIZE) || ((ndp & (NCM_ALIGN - 1U)) != 0U) ||
+      ((ndp + NCM_NDP_SIZE(1U)) > ncmp->rx_size) ||
+      (ncm_get32(p) != USB_NCM_NDP16_SIGNATURE)) {
+    return false;
+  }
+
+  len = ncm_get16(&p[4]);
+  if ((len < NCM_NDP_SIZE(1U)) || ((ndp + len) > ncmp->rx_size)) {
+    return false;
+  }
+
+  ncmp->rx_entry = ndp + USB_NCM_NDP16_HEADER_SIZE;
+  ncmp->rx_end   = ndp + len;
+
+  return true;
+}
+
+/**
+ * @brief   Starts parsing the current input buffer.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The validation result.
+ *
+ * @notapi
+ */
+static bool ncm_rx_start(USBNcmDriver *ncmp) {
+  const uint8_t *p = ncmp->ibqueue.ptr;
+  size_t size = (size_t)(ncmp->ibqueue.top - ncmp->ibqueue.ptr);
+  size_t len;
+
+  ncmp->rx_ntb = p;
+  if ((size < USB_NCM_NTH16_SIZE) ||
+      (ncm_get32(p) != USB_NCM_NTH16_SIGNATURE) ||
+      (ncm_get16(&p[4]) != USB_NCM_NTH16_SIZE)) {
+    return false;
+  }
+
+  len = ncm_get16(&p[8]);
+  if ((len < USB_NCM_NTH16_SIZE) || (len > size)) {
+    return false;
+  }
+
+  ncmp->rx_size = len;
+  ncmp->rx_ndp  = ncm_get16(&p[10]);
+
+  return ncm_rx_ndp(ncmp);
+}
+
+/**
+ * @brief   Returns the next datagram of the NTB being parsed.
+ * @details NDPs chained through their next index are followed, malformed
+ *          entries are skipped.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[out] dpp      pointer to a variable receiving the datagram address
+ * @param[out] np       pointer to a variable receiving the datagram size
+ * @return              The parser status.
+ * @retval false        if there are no more datagrams.
+ *
+ * @notapi
+ */
+static bool ncm_rx_next(USBNcmDriver *ncmp, const uint8_t **dpp,
+                        size_t *np) {
+  size_t next;
+
+  while (ncmp->rx_ndp != 0U) {
+    if ((ncmp->rx_entry + USB_NCM_NDP16_ENTRY_SIZE) <= ncmp->rx_end) {
+      const uint8_t *p = ncmp->rx_ntb + ncmp->rx_entry;
+      size_t index = ncm_get16(&p[0]);
+      size_t len = ncm_get16(&p[2]);
+
+      ncmp->rx_entry += USB_NCM_NDP16_ENTRY_SIZE;
+      if ((index != 0U) && (len != 0U)) {
+        if ((len < 14U) || (index < USB_NCM_NTH16_SIZE) ||
+            ((index + len) > ncmp->rx_size)) {
+          ncmp->rx_errors++;
+          continue;
+        }
+        *dpp = ncmp->rx_ntb + index;
+        *np  = len;
+        return true;
+      }
+    }
+
+    /* End of this NDP, moving to the next one, if any. NDPs are required
+       to be chained forward so that the parsing always terminates.*/
+    next = ncm_get16(ncmp->rx_ntb + ncmp->rx_ndp + 6U);
+    if (next == 0U) {
+      ncmp->rx_ndp = 0U;
+    }
+    else {
+      ncmp->rx_ndp = (next > ncmp->rx_ndp) ? next : 0U;
+      if (!ncm_rx_ndp(ncmp)) {
+        ncmp->rx_errors++;
+        ncmp->rx_ndp = 0U;
+      }
+    }
+  }
+
+  return false;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a NCM function object.
+ *
+ * @param[out] ncmp     pointer to the @p USBNcmDriver object
+ *
+ * @init
+ */
+void ncmObjectInit(USBNcmDriver *ncmp) {
+
+  osalDbgCheck(ncmp != NULL);
+
+  ncmp->state       = NCM_STOP;
+  ncmp->config      = NULL;
+  ncmp->connected   = false;
+  ncmp->alt         = 0U;
+  ncmp->ntf_pending = 0U;
+  ncmp->rx_ntb      = NULL;
+  ncmp->rx_refs     = 0U;
+  ncmp->tx_busy     = false;
+  ncmp->rx_errors   = 0U;
+  ncmp->arg         = NULL;
+  ncm_put32(ncmp->ntb_in_buf, USB_NCM_BUFFERS_SIZE);
+  osalThreadQueueObjectInit(&ncmp->rx_waiting);
+  ibqObjectInit(&ncmp->ibqueue, true, ncmp->ib,
+                USB_NCM_BUFFERS_SIZE, USB_NCM_BUFFERS_NUMBER,
+                NULL, ncmp);
+  obqObjectInit(&ncmp->obqueue, true, ncmp->ob,
+                USB_NCM_BUFFERS_SIZE, USB_NCM_BUFFERS_NUMBER,
+                NULL, ncmp);
+}
+
+/**
+ * @brief   Configures a NCM function.
+ * @details The function is associated to its endpoints, the data path is
+ *          started when the host selects the data interface.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void ncmStart(USBNcmDriver *ncmp, const USBNcmConfig *config) {
+  USBDriver *usbp;
+
+  osalDbgCheck((ncmp != NULL) && (config != NULL) &&
+               (config->usbp != NULL) &&
+               (config->bulk_in > 0U) &&
+               (config->bulk_in <= USB_MAX_ENDPOINTS) &&
+               (config->bulk_out > 0U) &&
+               (config->bulk_out <= USB_MAX_ENDPOINTS) &&
+               (config->int_in <= USB_MAX_ENDPOINTS));
+
+  usbp = config->usbp;
+
+  osalSysLock();
+  osalDbgAssert((ncmp->state == NCM_STOP) || (ncmp->state == NCM_READY),
+                "invalid state");
+  usbp->in_params[config->bulk_in - 1U]   = ncmp;
+  usbp->out_params[config->bulk_out - 1U] = ncmp;
+  if (config->int_in > 0U) {
+    usbp->in_params[config->int_in - 1U]  = ncmp;
+  }
+  ncmp->config = config;
+  ncmp->state  = NCM_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops a NCM function.
+ * @details Any thread waiting on the driver will be awakened with the
+ *          message @p MSG_RESET.
+ * @pre     All the received datagrams must have been released.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @api
+ */
+void ncmStop(USBNcmDriver *ncmp) {
+  USBDriver *usbp;
+
+  osalDbgCheck(ncmp != NULL);
+
+  osalSysLock();
+  osalDbgAssert((ncmp->state == NCM_STOP) || (ncmp->state == NCM_READY),
+                "invalid state");
+  osalDbgAssert(ncmp->rx_refs == 0U, "datagrams not released");
+
+  if (ncmp->state == NCM_READY) {
+    usbp = ncmp->config->usbp;
+    usbp->in_params[ncmp->config->bulk_in - 1U]   = NULL;
+    usbp->out_params[ncmp->config->bulk_out - 1U] = NULL;
+    if (ncmp->config->int_in > 0U) {
+      usbp->in_params[ncmp->config->int_in - 1U]  = NULL;
+    }
+  }
+  ncmp->config    = NULL;
+  ncmp->state     = NCM_STOP;
+  ncmp->connected = false;
+  ncmp->rx_ntb    = NULL;
+
+  ibqResetI(&ncmp->ibqueue);
+  obqResetI(&ncmp->obqueue);
+  bqSuspendI(&ncmp->ibqueue);
+  bqSuspendI(&ncmp->obqueue);
+  osalThreadDequeueAllI(&ncmp->rx_waiting, MSG_RESET);
+  osalOsRescheduleS();
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   USB device configured handler.
+ * @details The data interface is put in alternate setting zero and the
+ *          NTB input size is restored to its default.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @iclass
+ */
+void ncmConfigureHookI(USBNcmDriver *ncmp) {
+
+  osalDbgCheckClassI();
+
+  ncm_put32(ncmp->ntb_in_buf, USB_NCM_BUFFERS_SIZE);
+  ncmp->alt         = 0U;
+  ncmp->connected   = false;
+  ncmp->ntf_pending = 0U;
+  bqSuspendI(&ncmp->ibqueue);
+  bqSuspendI(&ncmp->obqueue);
+}
+
+/**
+ * @brief   USB device suspend handler.
+ * @details The queues are suspended, this way the application cannot get
+ *          stuck in the middle of an I/O operations.
+ * @note    It is meant to be called also on USB reset and unconfigured
+ *          events.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @iclass
+ */
+void ncmSuspendHookI(USBNcmDriver *ncmp) {
+
+  osalDbgCheckClassI();
+
+  ncmp->connected = false;
+  bqSuspendI(&ncmp->ibqueue);
+  bqSuspendI(&ncmp->obqueue);
+}
+
+/**
+ * @brief   USB device wakeup handler.
+ * @details The data path is resumed if the data interface is selected.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @iclass
+ */
+void ncmWakeupHookI(USBNcmDriver *ncmp) {
+
+  osalDbgCheckClassI();
+
+  if (ncmp->alt == 1U) {
+    bqResumeX(&ncmp->ibqueue);
+    bqResumeX(&ncmp->obqueue);
+    ncmp->connected = true;
+    ncm_start_receive(ncmp);
+  }
+}
+
+/**
+ * @brief   NCM requests handler.
+ * @details Applications must invoke this function from the USB requests
+ *          hook. The following requests are handled:
+ *          - SET_INTERFACE and GET_INTERFACE on the data interface.
+ *          - CDC_GET_NTB_PARAMETERS.
+ *          - CDC_GET_NTB_FORMAT and CDC_SET_NTB_FORMAT, only NTB16.
+ *          - CDC_GET_NTB_INPUT_SIZE and CDC_SET_NTB_INPUT_SIZE.
+ *          - CDC_SET_ETHERNET_PACKET_FILTER, no filtering is performed.
+ *          .
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The hook status.
+ * @retval true         Message handled internally.
+ * @retval false        Message not handled.
+ */
+bool ncmRequestsHook(USBNcmDriver *ncmp) {
+  USBDriver *usbp = ncmp->config->usbp;
+  uint8_t *p = ncmp->ctl_buf;
+
+  if ((usbp->setup[0] & USB_RTYPE_RECIPIENT_MASK) !=
+      USB_RTYPE_RECIPIENT_INTERFACE) {
+    return false;
+  }
+
+  if ((usbp->setup[0] & USB_RTYPE_TYPE_MASK) == USB_RTYPE_TYPE_STD) {
+    if ((usbp->setup[4] == ncmp->config->ctrl_if) &&
+        (usbp->setup[1] == USB_REQ_SET_INTERFACE) &&
+        (usbp->setup[2] == 0U)) {
+      /* The communication interface has a single alternate setting.*/
+      usbSetupTransfer(usbp, NULL, 0, NULL);
+      return true;
+    }
+    if (usbp->setup[4] != ncmp->config->data_if) {
+      return false;
+    }
+    switch (usbp->setup[1]) {
+    case USB_REQ_SET_INTERFACE:
+      if (usbp->setup[2] > 1U) {
+        return false;
+      }
+      osalSysLockFromISR();
+      ncm_set_alt(ncmp, usbp->setup[2]);
+      osalSysUnlockFromISR();
+      usbSetupTransfer(usbp, NULL, 0, NULL);
+      return true;
+    case USB_REQ_GET_INTERFACE:
+      usbSetupTransfer(usbp, &ncmp->alt, 1, NULL);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  if (((usbp->setup[0] & USB_RTYPE_TYPE_MASK) != USB_RTYPE_TYPE_CLASS) ||
+      (usbp->setup[4] != ncmp->config->ctrl_if)) {
+    return false;
+  }
+
+  switch (usbp->setup[1]) {
+  case CDC_GET_NTB_PARAMETERS:
+    ncm_put16(&p[0], USB_NCM_NTB_PARAMETERS_SIZE);
+    ncm_put16(&p[2], 1U);                   /* NTB16 only.                 */
+    ncm_put32(&p[4], USB_NCM_BUFFERS_SIZE);
+    ncm_put16(&p[8], NCM_ALIGN);
+    ncm_put16(&p[10], 0U);
+    ncm_put16(&p[12], NCM_ALIGN);
+    ncm_put16(&p[14], 0U);
+    ncm_put32(&p[16], USB_NCM_BUFFERS_SIZE);
+    ncm_put16(&p[20], NCM_ALIGN);
+    ncm_put16(&p[22], NCM_OUT_REMAINDER);
+    ncm_put16(&p[24], NCM_ALIGN);
+    ncm_put16(&p[26], 0U);                  /* No datagrams limit.         */
+    usbSetupTransfer(usbp, p, USB_NCM_NTB_PARAMETERS_SIZE, NULL);
+    return true;
+  case CDC_GET_NTB_FORMAT:
+    ncm_put16(&p[0], 0U);
+    usbSetupTransfer(usbp, p, 2, NULL);
+    return true;
+  case CDC_SET_NTB_FORMAT:
+    if ((usbp->setup[2] | usbp->setup[3]) != 0U) {
+      return false;
+    }
+    usbSetupTransfer(usbp, NULL, 0, NULL);
+    return true;
+  case CDC_GET_NTB_INPUT_SIZE:
+    usbSetupTransfer(usbp, ncmp->ntb_in_buf, 4, NULL);
+    return true;
+  case CDC_SET_NTB_INPUT_SIZE:
+    /* The size is applied starting from the next NTB, the optional
+       datagrams limit is ignored.*/
+    if ((usbp->setup[6] != 4U) && (usbp->setup[6] != 8U)) {
+      return false;
+    }
+    usbSetupTransfer(usbp, ncmp->ntb_in_buf, usbp->setup[6], NULL);
+    return true;
+  case CDC_SET_ETHERNET_PACKET_FILTER:
+    usbSetupTransfer(usbp, NULL, 0, NULL);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief   Gets the next received datagram.
+ * @details The datagram is not copied, the returned pointer refers to
+ *          the NTB buffer. Each datagram must be released using
+ *          @p ncmReleaseReceiveDatagram(), datagrams can be released in
+ *          any order and from any thread.
+ * @note    The NTB buffer is returned to the queue after all its datagrams
+ *          have been released, until then the following NTBs are not
+ *          parsed, releasing datagrams late reduces the receive rate.
+ * @note    There must be a single reader.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[out] dpp      pointer to a variable receiving the datagram address
+ * @param[out] np       pointer to a variable receiving the datagram size
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a datagram has been returned.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the function is not connected or has been
+ *                      stopped.
+ *
+ * @api
+ */
+msg_t ncmGetReceiveDatagramTimeout(USBNcmDriver *ncmp, const uint8_t **dpp,
+                                   size_t *np, sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((ncmp != NULL) && (dpp != NULL) && (np != NULL));
+
+  osalSysLock();
+  while (true) {
+    if (ncmp->rx_ntb == NULL) {
+      msg = ibqGetFullBufferTimeoutS(&ncmp->ibqueue, timeout);
+      if (msg != MSG_OK) {
+        break;
+      }
+      if (!ncm_rx_start(ncmp)) {
+        ncmp->rx_errors++;
+        ncmp->rx_ndp = 0U;
+      }
+    }
+
+    if (ncm_rx_next(ncmp, dpp, np)) {
+      ncmp->rx_refs++;
+      msg = MSG_OK;
+      break;
+    }
+
+    /* NTB fully parsed, it is returned to the queue after all its
+       datagrams have been released.*/
+    while (ncmp->rx_refs > 0U) {
+      msg = osalThreadEnqueueTimeoutS(&ncmp->rx_waiting, timeout);
+      if (msg != MSG_OK) {
+        osalSysUnlock();
+        return msg;
+      }
+    }
+    if (ncmp->rx_ntb != NULL) {
+      ncmp->rx_ntb = NULL;
+      ibqReleaseEmptyBufferS(&ncmp->ibqueue);
+      ncm_start_receive(ncmp);
+    }
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Releases a received datagram.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @iclass
+ */
+void ncmReleaseReceiveDatagramI(USBNcmDriver *ncmp) {
+
+  osalDbgCheckClassI();
+  osalDbgAssert(ncmp->rx_refs > 0U, "no datagram");
+
+  if (--ncmp->rx_refs == 0U) {
+    osalThreadDequeueAllI(&ncmp->rx_waiting, MSG_OK);
+  }
+}
+
+/**
+ * @brief   Releases a received datagram.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ *
+ * @api
+ */
+void ncmReleaseReceiveDatagram(USBNcmDriver *ncmp) {
+
+  osalSysLock();
+  ncmReleaseReceiveDatagramI(ncmp);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Gets a buffer for a datagram to be transmitted.
+ * @details The buffer is located in the NTB being assembled, if the
+ *          datagram does not fit then the NTB is queued for transmission
+ *          and a new one is started. The buffer must be committed using
+ *          @p ncmCommitTransmitBuffer().
+ * @note    There must be a single writer.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[in] n         datagram size
+ * @param[out] bpp      pointer to a variable receiving the buffer address
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been returned.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the function is not connected or has been
+ *                      stopped.
+ *
+ * @api
+ */
+msg_t ncmGetTransmitBufferTimeout(USBNcmDriver *ncmp, size_t n,
+                                  uint8_t **bpp, sysinterval_t timeout) {
+  output_buffers_queue_t *obqp = &ncmp->obqueue;
+  msg_t msg;
+
+  osalDbgCheck((ncmp != NULL) && (bpp != NULL) &&
+               (n > 0U) && (n <= USB_NCM_MAX_DATAGRAM_SIZE));
+
+  osalSysLock();
+  osalDbgAssert(!ncmp->tx_busy, "buffer already taken");
+
+  if (bqIsSuspendedX(obqp)) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+
+  if ((obqp->ptr != NULL) && !ncm_tx_fits(ncmp, n)) {
+    obqPostFullBufferS(obqp, ncm_tx_finalize(ncmp));
+    ncm_tx_start(ncmp);
+  }
+
+  if (obqp->ptr == NULL) {
+    msg = obqGetEmptyBufferTimeoutS(obqp, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+    ncmp->tx_count = 0U;
+    ncmp->tx_max   = ncm_tx_limit(ncmp);
+    obqp->ptr     += USB_NCM_NTH16_SIZE;
+  }
+
+  ncmp->tx_offset = NCM_ROUND((size_t)(obqp->ptr - ncm_tx_base(ncmp)));
+  ncmp->tx_busy   = true;
+  *bpp = ncm_tx_base(ncmp) + ncmp->tx_offset;
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Commits a datagram to the NTB being assembled.
+ * @details If the bulk IN endpoint is idle then the NTB is sent
+ *          immediately, else it is sent when the current transfer is
+ *          complete together with any other datagram committed meanwhile.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @param[in] n         datagram size, not larger than the size specified
+ *                      to @p ncmGetTransmitBufferTimeout()
+ *
+ * @api
+ */
+void ncmCommitTransmitBuffer(USBNcmDriver *ncmp, size_t n) {
+  output_buffers_queue_t *obqp = &ncmp->obqueue;
+  USBDriver *usbp = ncmp->config->usbp;
+
+  osalDbgCheck((ncmp != NULL) && (n > 0U));
+
+  osalSysLock();
+  osalDbgAssert(ncmp->tx_busy, "no buffer taken");
+
+  ncmp->tx_busy = false;
+
+  /* The NTB could have been discarded by a reset meanwhile.*/
+  if (obqp->ptr == NULL) {
+    osalSysUnlock();
+    return;
+  }
+
+  ncmp->tx_index[ncmp->tx_count]  = (uint16_t)ncmp->tx_offset;
+  ncmp->tx_length[ncmp->tx_count] = (uint16_t)n;
+  ncmp->tx_count++;
+  obqp->ptr = ncm_tx_base(ncmp) + ncmp->tx_offset + n;
+
+  /* Sending right away if nothing else is queued or in flight.*/
+  if (ncmp->connected && (usbGetDriverStateI(usbp) == USB_ACTIVE) &&
+      !usbGetTransmitStatusI(usbp, ncmp->config->bulk_in) &&
+      obqIsEmptyI(obqp)) {
+    obqPostFullBufferS(obqp, ncm_tx_finalize(ncmp));
+    ncm_tx_start(ncmp);
+  }
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Default data transmitted callback.
+ * @details The transmitted NTB is freed and the next one, if any, is sent.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        IN endpoint number
+ */
+void ncmDataTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBNcmDriver *ncmp = usbp->in_params[ep - 1U];
+  output_buffers_queue_t *obqp;
+  uint8_t *buf;
+  size_t n;
+
+  if (ncmp == NULL) {
+    return;
+  }
+
+  obqp = &ncmp->obqueue;
+
+  osalSysLockFromISR();
+
+  /* Freeing the NTB just transmitted, if it was not a zero size packet.*/
+  if (usbp->epc[ep]->in_state->txsize > 0U) {
+    obqReleaseEmptyBufferI(obqp);
+  }
+
+  if (!ncmp->connected) {
+    osalSysUnlockFromISR();
+    return;
+  }
+
+  buf = obqGetFullBufferI(obqp, &n);
+  if (buf != NULL) {
+    usbStartTransmitI(usbp, ep, buf, n);
+  }
+  else if ((usbp->epc[ep]->in_state->txsize > 0U) &&
+           ((usbp->epc[ep]->in_state->txsize &
+            ((size_t)usbp->epc[ep]->in_maxsize - 1U)) == 0U)) {
+    /* The NTB ended with a full packet, a zero sized packet terminates
+       the transfer.*/
+    usbStartTransmitI(usbp, ep, usbp->setup, 0);
+  }
+  else if (ncm_tx_ready(ncmp)) {
+    /* Sending the datagrams aggregated while the endpoint was busy.*/
+    (void) ncm_tx_finalize(ncmp);
+    if (obqTryFlushI(obqp)) {
+      buf = obqGetFullBufferI(obqp, &n);
+      osalDbgAssert(buf != NULL, "queue is empty");
+      usbStartTransmitI(usbp, ep, buf, n);
+    }
+  }
+  else {
+    /* Nothing to transmit.*/
+  }
+
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Default data received callback.
+ * @details The received NTB is posted in the input queue and the next
+ *          transaction is started.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        OUT endpoint number
+ */
+void ncmDataReceived(USBDriver *usbp, usbep_t ep) {
+  USBNcmDriver *ncmp = usbp->out_params[ep - 1U];
+  size_t size;
+
+  if (ncmp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+
+  /* Zero sized transactions are terminators of NTBs of a size multiple
+     of the packet size.*/
+  size = usbGetReceiveTransactionSizeX(usbp, ep);
+  if ((size > 0U) && ncmp->connected) {
+    ibqPostFullBufferI(&ncmp->ibqueue, size);
+  }
+
+  ncm_start_receive(ncmp);
+
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Default interrupt transmitted callback.
+ * @details The next pending notification, if any, is sent.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        interrupt IN endpoint number
+ */
+void ncmInterruptTransmitted(USBDriver *usbp, usbep_t ep) {
+  USBNcmDriver *ncmp = usbp->in_params[ep - 1U];
+
+  if (ncmp == NULL) {
+    return;
+  }
+
+  osalSysLockFromISR();
+  ncm_notify(ncmp);
+  osalSysUnlockFromISR();
+}
+
+/** @} */
@@ -0,0 +1,307 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_usb_ncm.h
+ * @brief   USB CDC-NCM network function header.
+ *
+ * @addtogroup HAL_USB_NCM
+ * @{
+ */
+
+#ifndef HAL_USB_NCM_H
+#define HAL_USB_NCM_H
+
+#include "hal.h"
+#include "hal_usb_cdc.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    NTB16 structures
+ * @{
+ */
+#define USB_NCM_NTH16_SIGNATURE             0x484D434EU
+#define USB_NCM_NDP16_SIGNATURE             0x304D434EU
+#define USB_NCM_NTH16_SIZE                  12U
+#define USB_NCM_NDP16_HEADER_SIZE           8U
+#define USB_NCM_NDP16_ENTRY_SIZE            4U
+/** @} */
+
+/**
+ * @brief   Size of the NTB parameters structure.
+ */
+#define USB_NCM_NTB_PARAMETERS_SIZE         28U
+
+/**
+ * @brief   Smallest NTB size a host is allowed to select.
+ */
+#define USB_NCM_MIN_NTB_SIZE                2048U
+
+/**
+ * @brief   Largest Ethernet frame, without FCS.
+ */
+#define USB_NCM_MAX_DATAGRAM_SIZE           1514U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   NTB buffers size.
+ * @details It is both the largest NTB accepted from the host and the
+ *          largest NTB sent to it, the host can lower the latter using
+ *          the @p SET_NTB_INPUT_SIZE request.
+ * @note    At high speed 16384 bytes allow about ten full size frames per
+ *          NTB, it must be a multiple of the bulk endpoints packet size.
+ */
+#if !defined(USB_NCM_BUFFERS_SIZE) || defined(__DOXYGEN__)
+#define USB_NCM_BUFFERS_SIZE                2048
+#endif
+
+/**
+ * @brief   Number of NTB buffers in each direction.
+ */
+#if !defined(USB_NCM_BUFFERS_NUMBER) || defined(__DOXYGEN__)
+#define USB_NCM_BUFFERS_NUMBER              2
+#endif
+
+/**
+ * @brief   Maximum number of datagrams aggregated in a transmitted NTB.
+ */
+#if !defined(USB_NCM_TX_MAX_DATAGRAMS) || defined(__DOXYGEN__)
+#define USB_NCM_TX_MAX_DATAGRAMS            16
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_USB != TRUE
+#error "USB CDC-NCM requires HAL_USE_USB"
+#endif
+
+#if (USB_NCM_BUFFERS_SIZE < USB_NCM_MIN_NTB_SIZE) ||                        \
+    (USB_NCM_BUFFERS_SIZE > 65535)
+#error "USB_NCM_BUFFERS_SIZE out of NTB16 range"
+#endif
+
+#if USB_NCM_BUFFERS_NUMBER < 2
+#error "USB_NCM_BUFFERS_NUMBER must be at least 2"
+#endif
+
+#if USB_NCM_TX_MAX_DATAGRAMS < 1
+#error "invalid USB_NCM_TX_MAX_DATAGRAMS value"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of driver state machine states.
+ */
+typedef enum {
+  NCM_UNINIT = 0,
+  NCM_STOP = 1,
+  NCM_READY = 2
+} ncm_state_t;
+
+/**
+ * @brief   Type of a NCM function configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   USB driver to use.
+   */
+  USBDriver                 *usbp;
+  /**
+   * @brief   Bulk IN endpoint used for outgoing NTBs.
+   */
+  usbep_t                   bulk_in;
+  /**
+   * @brief   Bulk OUT endpoint used for incoming NTBs.
+   */
+  usbep_t                   bulk_out;
+  /**
+   * @brief   Interrupt IN endpoint used for notifications.
+   */
+  usbep_t                   int_in;
+  /**
+   * @brief   Communication class interface number.
+   */
+  uint8_t                   ctrl_if;
+  /**
+   * @brief   Data class interface number.
+   */
+  uint8_t                   data_if;
+  /**
+   * @brief   Link speed notified to the host in bits per second.
+   */
+  uint32_t                  speed;
+} USBNcmConfig;
+
+/**
+ * @brief   Structure representing a NCM function.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  ncm_state_t               state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const USBNcmConfig        *config;
+  /**
+   * @brief   Data interface active, the host can exchange NTBs.
+   */
+  bool                      connected;
+  /**
+   * @brief   Data interface alternate setting.
+   */
+  uint8_t                   alt;
+  /**
+   * @brief   Pending notifications mask.
+   */
+  uint8_t                   ntf_pending;
+  /**
+   * @brief   Notification buffer.
+   */
+  uint8_t                   ntf_buf[16];
+  /**
+   * @brief   Control transfers buffer.
+   */
+  uint8_t                   ctl_buf[USB_NCM_NTB_PARAMETERS_SIZE];
+  /**
+   * @brief   NTB input size set by the host.
+   */
+  uint8_t                   ntb_in_buf[8];
+  /**
+   * @brief   Incoming NTBs queue.
+   */
+  input_buffers_queue_t     ibqueue;
+  /**
+   * @brief   Outgoing NTBs queue.
+   */
+  output_buffers_queue_t    obqueue;
+  /**
+   * @brief   Incoming NTBs buffers.
+   */
+  uint8_t                   ib[BQ_BUFFER_SIZE(USB_NCM_BUFFERS_NUMBER,
+                                              USB_NCM_BUFFERS_SIZE)];
+  /**
+   * @brief   Outgoing NTBs buffers.
+   */
+  uint8_t                   ob[BQ_BUFFER_SIZE(USB_NCM_BUFFERS_NUMBER,
+                                              USB_NCM_BUFFERS_SIZE)];
+  /**
+   * @name    Incoming NTB parser state
+   * @{
+   */
+  const uint8_t             *rx_ntb;
+  size_t                    rx_size;
+  size_t                    rx_ndp;
+  size_t                    rx_entry;
+  size_t                    rx_end;
+  unsigned                  rx_refs;
+  threads_queue_t           rx_waiting;
+  /** @} */
+  /**
+   * @name    Outgoing NTB state
+   * @{
+   */
+  size_t                    tx_max;
+  size_t                    tx_offset;
+  bool                      tx_busy;
+  uint16_t                  tx_seq;
+  unsigned                  tx_count;
+  uint16_t                  tx_index[USB_NCM_TX_MAX_DATAGRAMS];
+  uint16_t                  tx_length[USB_NCM_TX_MAX_DATAGRAMS];
+  /** @} */
+  /**
+   * @brief   Number of malformed NTBs or datagrams dropped.
+   */
+  uint32_t                  rx_errors;
+  /**
+   * @brief   Application defined field.
+   */
+  void                      *arg;
+} USBNcmDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the connection status.
+ * @details The function is connected when the host has selected the data
+ *          interface alternate setting with the bulk endpoints.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The connection status.
+ *
+ * @xclass
+ */
+#define ncmIsConnectedX(ncmp) ((ncmp)->connected)
+
+/**
+ * @brief   Returns the number of receive errors.
+ *
+ * @param[in] ncmp      pointer to the @p USBNcmDriver object
+ * @return              The number of malformed NTBs or datagrams dropped.
+ *
+ * @xclass
+ */
+#define ncmGetReceiveErrorsX(ncmp) ((ncmp)->rx_errors)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ncmObjectInit(USBNcmDriver *ncmp);
+  void ncmStart(USBNcmDriver *ncmp, const USBNcmConfig *config);
+  void ncmStop(USBNcmDriver *ncmp);
+  void ncmConfigureHookI(USBNcmDriver *ncmp);
+  void ncmSuspendHookI(USBNcmDriver *ncmp);
+  void ncmWakeupHookI(USBNcmDriver *ncmp);
+  bool ncmRequestsHook(USBNcmDriver *ncmp);
+  msg_t ncmGetReceiveDatagramTimeout(USBNcmDriver *ncmp, const uint8_t **dpp,
+                                     size_t *np, sysinterval_t timeout);
+  void ncmReleaseReceiveDatagramI(USBNcmDriver *ncmp);
+  void ncmReleaseReceiveDatagram(USBNcmDriver *ncmp);
+  msg_t ncmGetTransmitBufferTimeout(USBNcmDriver *ncmp, size_t n,
+                                    uint8_t **bpp, sysinterval_t timeout);
+  void ncmCommitTransmitBuffer(USBNcmDriver *ncmp, size_t n);
+  void ncmDataTransmitted(USBDriver *usbp, usbep_t ep);
+  void ncmDataReceived(USBDriver *usbp, usbep_t ep);
+  void ncmInterruptTransmitted(USBDriver *usbp, usbep_t ep);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_USB_NCM_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the USB CDC-NCM files.
+USBNCMSRC := $(CHIBIOS)/os/hal/lib/complex/usb_ncm/hal_usb_ncm.c
+
+# Required include directories
+USBNCMINC := $(CHIBIOS)/os/hal/lib/complex/usb_ncm
+
+# Shared variables
+ALLCSRC += $(USBNCMSRC)
+ALLINC  += $(USBNCMINC)
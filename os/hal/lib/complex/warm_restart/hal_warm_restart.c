@@ -0,0 +1,402 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_warm_restart.c
+ * @brief   Warm restart state retention code.
+ *
+ * @addtogroup HAL_WARM_RESTART
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "hal_warm_restart.h"
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a slot data rounded to a multiple of 4.
+ */
+#define WR_ALIGNED_SIZE(n) (((n) + 3U) & ~(size_t)3U)
+
+/**
+ * @brief   Writes back the cached copy of a retained memory block.
+ * @note    Dirty cache lines would be lost on reset.
+ */
+#if defined(cacheBufferFlush) || defined(__DOXYGEN__)
+#define WR_FLUSH(p, n) cacheBufferFlush(p, n)
+#else
+#define WR_FLUSH(p, n)
+#endif
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   CRC32 nibble table.
+ */
+static const uint32_t wr_crc32_table[16] = {
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+  0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+  0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static uint32_t wr_crc32(uint32_t crc, const void *data, size_t n) {
+  const uint8_t *p = (const uint8_t *)data;
+
+  crc = ~crc;
+  while (n > 0U) {
+    crc ^= (uint32_t)*p++;
+    crc = (crc >> 4) ^ wr_crc32_table[crc & 15U];
+    crc = (crc >> 4) ^ wr_crc32_table[crc & 15U];
+    n--;
+  }
+
+  return ~crc;
+}
+
+static uint32_t wr_layout_crc(const WRConfig *config) {
+  uint32_t crc = 0U;
+  size_t i;
+
+  for (i = 0U; i < config->nslots; i++) {
+    uint32_t desc[2];
+
+    desc[0] = config->slots[i].id;
+    desc[1] = (uint32_t)config->slots[i].size;
+    crc = wr_crc32(crc, desc, sizeof (desc));
+  }
+
+  return crc;
+}
+
+static wr_slot_header_t *wr_get_slot(WRDriver *wrp, size_t slot) {
+  uint8_t *p = (uint8_t *)wrp->config->base + sizeof (wr_area_header_t);
+  size_t i;
+
+  for (i = 0U; i < slot; i++) {
+    p += sizeof (wr_slot_header_t) +
+         WR_ALIGNED_SIZE(wrp->config->slots[i].size);
+  }
+
+  return (wr_slot_header_t *)p;
+}
+
+static void wr_write_header(WRDriver *wrp, uint32_t layout) {
+  volatile wr_area_header_t *hp;
+  wr_area_header_t hdr;
+
+  hp = (volatile wr_area_header_t *)wrp->config->base;
+
+  hdr.magic  = WR_AREA_MAGIC;
+  hdr.layout = layout;
+  hdr.boots  = wrp->boots;
+  hdr.crc    = wr_crc32(0U, &hdr, sizeof (wr_area_header_t) -
+                                  sizeof (uint32_t));
+
+  hp->magic  = 0U;
+  hp->layout = hdr.layout;
+  hp->boots  = hdr.boots;
+  hp->crc    = hdr.crc;
+  hp->magic  = hdr.magic;
+  WR_FLUSH(wrp->config->base, sizeof (wr_area_header_t));
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] wrp      pointer to the @p WRDriver object
+ *
+ * @init
+ */
+void wrObjectInit(WRDriver *wrp) {
+
+  osalDbgCheck(wrp != NULL);
+
+  wrp->state  = WR_STOP;
+  wrp->config = NULL;
+  wrp->warm   = false;
+  wrp->boots  = 0U;
+}
+
+/**
+ * @brief   Configures and activates the driver.
+ * @details The retained area is checked, if it is valid and the slots
+ *          table did not change then the start is warm and the slots can
+ *          be restored, else the area is initialized and all slots are
+ *          invalid.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void wrStart(WRDriver *wrp, const WRConfig *config) {
+  const wr_area_header_t *hp;
+  uint32_t layout;
+  size_t i, total;
+
+  osalDbgCheck((wrp != NULL) && (config != NULL) &&
+               (config->base != NULL) &&
+               (((uint32_t)config->base & 3U) == 0U));
+  osalDbgAssert((wrp->state == WR_STOP) || (wrp->state == WR_READY),
+                "invalid state");
+
+  total = sizeof (wr_area_header_t);
+  for (i = 0U; i < config->nslots; i++) {
+    total += sizeof (wr_slot_header_t) +
+             WR_ALIGNED_SIZE(config->slots[i].size);
+  }
+  osalDbgAssert(total <= config->size, "retained area too small");
+
+  wrp->config = config;
+
+  /* Checking the area header.*/
+  hp = (const wr_area_header_t *)config->base;
+  layout = wr_layout_crc(config);
+  if ((hp->magic == WR_AREA_MAGIC) && (hp->layout == layout) &&
+      (hp->crc == wr_crc32(0U, hp, sizeof (wr_area_header_t) -
+                                   sizeof (uint32_t)))) {
+    wrp->warm  = true;
+    wrp->boots = hp->boots + 1U;
+  }
+  else {
+    wrp->warm  = false;
+    wrp->boots = 0U;
+    for (i = 0U; i < config->nslots; i++) {
+      wr_get_slot(wrp, i)->magic = 0U;
+    }
+    WR_FLUSH(config->base, total);
+  }
+  wr_write_header(wrp, layout);
+
+  wrp->state = WR_READY;
+}
+
+/**
+ * @brief   Deactivates the driver.
+ * @note    The retained state is not modified.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ *
+ * @api
+ */
+void wrStop(WRDriver *wrp) {
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert((wrp->state == WR_STOP) || (wrp->state == WR_READY),
+                "invalid state");
+
+  wrp->config = NULL;
+  wrp->state  = WR_STOP;
+}
+
+/**
+ * @brief   Starts an in-place checkpoint of a slot.
+ * @details The slot is invalidated and its data area returned, the caller
+ *          writes the state directly in the retained memory then calls
+ *          @p wrSaveEnd(). A reset in the middle of the operation leaves
+ *          the slot invalid.
+ * @note    Slots are not protected against concurrent access, each slot
+ *          is meant to be owned by a single subsystem.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ * @return              Pointer to the slot data area.
+ *
+ * @api
+ */
+void *wrSaveStart(WRDriver *wrp, size_t slot) {
+  volatile wr_slot_header_t *shp;
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert(wrp->state == WR_READY, "invalid state");
+  osalDbgCheck(slot < wrp->config->nslots);
+
+  shp = wr_get_slot(wrp, slot);
+  shp->magic = 0U;
+
+  return (void *)(shp + 1);
+}
+
+/**
+ * @brief   Completes an in-place checkpoint of a slot.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ *
+ * @api
+ */
+void wrSaveEnd(WRDriver *wrp, size_t slot) {
+  volatile wr_slot_header_t *shp;
+  size_t size;
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert(wrp->state == WR_READY, "invalid state");
+  osalDbgCheck(slot < wrp->config->nslots);
+
+  shp  = wr_get_slot(wrp, slot);
+  size = wrp->config->slots[slot].size;
+
+  shp->id    = wrp->config->slots[slot].id;
+  shp->size  = (uint32_t)size;
+  shp->crc   = wr_crc32(0U, (const void *)(shp + 1), size);
+  shp->magic = WR_SLOT_MAGIC;
+  WR_FLUSH((void *)shp, sizeof (wr_slot_header_t) + size);
+}
+
+/**
+ * @brief   Checkpoints a slot.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ * @param[in] data      data to be saved, the slot size is used
+ *
+ * @api
+ */
+void wrSave(WRDriver *wrp, size_t slot, const void *data) {
+
+  osalDbgCheck(data != NULL);
+
+  memcpy(wrSaveStart(wrp, slot), data, wrp->config->slots[slot].size);
+  wrSaveEnd(wrp, slot);
+}
+
+/**
+ * @brief   Returns the retained data of a valid slot.
+ * @details The data can be used in place, without copying it.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ * @return              Pointer to the slot data area.
+ * @retval NULL         if the slot is not valid.
+ *
+ * @api
+ */
+const void *wrGetSlot(WRDriver *wrp, size_t slot) {
+  const wr_slot_header_t *shp;
+  size_t size;
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert(wrp->state == WR_READY, "invalid state");
+  osalDbgCheck(slot < wrp->config->nslots);
+
+  shp  = wr_get_slot(wrp, slot);
+  size = wrp->config->slots[slot].size;
+
+  if ((shp->magic != WR_SLOT_MAGIC) ||
+      (shp->id != wrp->config->slots[slot].id) ||
+      (shp->size != (uint32_t)size) ||
+      (shp->crc != wr_crc32(0U, shp + 1, size))) {
+    return NULL;
+  }
+
+  return (const void *)(shp + 1);
+}
+
+/**
+ * @brief   Restores a slot.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ * @param[out] data     buffer for the restored data, the slot size is used
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  if the slot has been restored.
+ * @retval HAL_FAILED   if the slot is not valid, the buffer is not
+ *                      modified.
+ *
+ * @api
+ */
+bool wrRestore(WRDriver *wrp, size_t slot, void *data) {
+  const void *p;
+
+  osalDbgCheck(data != NULL);
+
+  p = wrGetSlot(wrp, slot);
+  if (p == NULL) {
+    return HAL_FAILED;
+  }
+
+  memcpy(data, p, wrp->config->slots[slot].size);
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Invalidates a slot.
+ * @details Subsystems invalidate their slot before modifying the state
+ *          it describes, a reset before the next checkpoint then forces
+ *          a full initialization.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @param[in] slot      slot index in the slots table
+ *
+ * @api
+ */
+void wrInvalidate(WRDriver *wrp, size_t slot) {
+  volatile wr_slot_header_t *shp;
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert(wrp->state == WR_READY, "invalid state");
+  osalDbgCheck(slot < wrp->config->nslots);
+
+  shp = wr_get_slot(wrp, slot);
+  shp->magic = 0U;
+  WR_FLUSH((void *)shp, sizeof (uint32_t));
+}
+
+/**
+ * @brief   Invalidates the whole retained area.
+ * @details The next start is a cold one, this is meant to be used when
+ *          the reset cause requires a full initialization.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ *
+ * @api
+ */
+void wrInvalidateAll(WRDriver *wrp) {
+  size_t i;
+
+  osalDbgCheck(wrp != NULL);
+  osalDbgAssert(wrp->state == WR_READY, "invalid state");
+
+  for (i = 0U; i < wrp->config->nslots; i++) {
+    wrInvalidate(wrp, i);
+  }
+  ((volatile wr_area_header_t *)wrp->config->base)->magic = 0U;
+  WR_FLUSH(wrp->config->base, sizeof (uint32_t));
+  wrp->warm = false;
+}
+
+/** @} */
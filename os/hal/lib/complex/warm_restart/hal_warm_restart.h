@@ -0,0 +1,227 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_warm_restart.h
+ * @brief   Warm restart state retention header.
+ * @details Subsystems checkpoint their state in slots of a retained memory
+ *          area, backup SRAM or RAM not initialized by the startup code,
+ *          after a watchdog or software reset the state is restored from
+ *          the slots instead of being rebuilt. Each slot is protected by a
+ *          CRC, a reset during a checkpoint invalidates the slot.
+ *
+ * @addtogroup HAL_WARM_RESTART
+ * @{
+ */
+
+#ifndef HAL_WARM_RESTART_H
+#define HAL_WARM_RESTART_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Retained area header magic number.
+ */
+#define WR_AREA_MAGIC                       0x5752A5C3U
+
+/**
+ * @brief   Valid slot magic number.
+ */
+#define WR_SLOT_MAGIC                       0x57534C54U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Driver state machine possible states.
+ */
+typedef enum {
+  WR_UNINIT = 0,                    /**< Not initialized.                   */
+  WR_STOP = 1,                      /**< Stopped.                           */
+  WR_READY = 2                      /**< Ready.                             */
+} wrstate_t;
+
+/**
+ * @brief   Type of a slot descriptor.
+ */
+typedef struct {
+  /**
+   * @brief   Slot identifier.
+   * @note    It is stored with the data, a slot saved by a firmware using
+   *          a different identifier is not restored.
+   */
+  uint32_t                  id;
+  /**
+   * @brief   Size of the slot data.
+   */
+  size_t                    size;
+} wr_slot_t;
+
+/**
+ * @brief   Type of a warm restart configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Retained area base, it must be aligned to 4.
+   * @note    The area must not be initialized by the startup code.
+   */
+  void                      *base;
+  /**
+   * @brief   Retained area size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Slots table.
+   * @note    The slots are allocated in the area in table order, any
+   *          change to the table invalidates all the retained state.
+   */
+  const wr_slot_t           *slots;
+  /**
+   * @brief   Number of slots in the table.
+   */
+  size_t                    nslots;
+} WRConfig;
+
+/**
+ * @brief   Type of a retained area header.
+ */
+typedef struct {
+  /**
+   * @brief   Magic number.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief   CRC of the slots table.
+   */
+  uint32_t                  layout;
+  /**
+   * @brief   Number of warm restarts since the last cold start.
+   */
+  uint32_t                  boots;
+  /**
+   * @brief   CRC of the previous fields.
+   */
+  uint32_t                  crc;
+} wr_area_header_t;
+
+/**
+ * @brief   Type of a slot header.
+ */
+typedef struct {
+  /**
+   * @brief   Valid slot magic number, written last.
+   */
+  uint32_t                  magic;
+  /**
+   * @brief   Slot identifier.
+   */
+  uint32_t                  id;
+  /**
+   * @brief   Size of the slot data.
+   */
+  uint32_t                  size;
+  /**
+   * @brief   CRC of the slot data.
+   */
+  uint32_t                  crc;
+} wr_slot_header_t;
+
+/**
+ * @brief   Type of a warm restart driver.
+ */
+typedef struct {
+  /**
+   * @brief   Driver state.
+   */
+  wrstate_t                 state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const WRConfig            *config;
+  /**
+   * @brief   The retained area was valid on start.
+   */
+  bool                      warm;
+  /**
+   * @brief   Number of warm restarts since the last cold start.
+   */
+  uint32_t                  boots;
+} WRDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @name    Macro Functions
+ * @{
+ */
+/**
+ * @brief   Returns @p true if the retained state survived the reset.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @return              The warm start status.
+ *
+ * @xclass
+ */
+#define wrIsWarmX(wrp) ((wrp)->warm)
+
+/**
+ * @brief   Returns the number of warm restarts since the last cold start.
+ *
+ * @param[in] wrp       pointer to the @p WRDriver object
+ * @return              The number of warm restarts.
+ *
+ * @xclass
+ */
+#define wrGetBootsX(wrp) ((wrp)->boots)
+/** @} */
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void wrObjectInit(WRDriver *wrp);
+  void wrStart(WRDriver *wrp, const WRConfig *config);
+  void wrStop(WRDriver *wrp);
+  void *wrSaveStart(WRDriver *wrp, size_t slot);
+  void wrSaveEnd(WRDriver *wrp, size_t slot);
+  void wrSave(WRDriver *wrp, size_t slot, const void *data);
+  const void *wrGetSlot(WRDriver *wrp, size_t slot);
+  bool wrRestore(WRDriver *wrp, size_t slot, void *data);
+  void wrInvalidate(WRDriver *wrp, size_t slot);
+  void wrInvalidateAll(WRDriver *wrp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_WARM_RESTART_H */
+
+/** @} */
@@ -0,0 +1,9 @@
+# List of all the warm restart state retention files.
+WRSRC := $(CHIBIOS)/os/hal/lib/complex/warm_restart/hal_warm_restart.c
+
+# Required include directories
+WRINC := $(CHIBIOS)/os/hal/lib/complex/warm_restart
+
+# Shared variables
+ALLCSRC += $(WRSRC)
+ALLINC  += $(WRINC)
@@ -0,0 +1,2327 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fallback/CRYPTO/hal_crypto_fallback.c
+ * @brief   Cryptographic software fallback code.
+ * @details AES uses a single 1kB round table per direction, the other
+ *          three tables are obtained by rotation, and an equivalent
+ *          inverse cipher key schedule. GHASH uses a 4 bits multiplication
+ *          table computed on each GCM operation. The SHA round functions
+ *          are unrolled over a 16 words message schedule window.
+ * @note    Table lookups are not constant time on cores with a data cache
+ *          or behind a flash cache, the fallback is meant for MCUs without
+ *          a crypto accelerator and should not be used where timing side
+ *          channels are a concern.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if (HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) ||                                   \
+    (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE)
+#define CRY_FALLBACK_NEEDS_SHA256           TRUE
+#else
+#define CRY_FALLBACK_NEEDS_SHA256           FALSE
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) ||                                   \
+    (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE)
+#define CRY_FALLBACK_NEEDS_SHA512           TRUE
+#else
+#define CRY_FALLBACK_NEEDS_SHA512           FALSE
+#endif
+
+#define ROR32(x, n)         (((x) >> (n)) | ((x) << (32U - (n))))
+#define ROR64(x, n)         (((x) >> (n)) | ((x) << (64U - (n))))
+
+#if (CRY_LLD_SUPPORTS_AES == FALSE) ||                                      \
+    (CRY_LLD_SUPPORTS_AES_ECB == FALSE) ||                                  \
+    (CRY_LLD_SUPPORTS_AES_CBC == FALSE)
+#define CRY_FALLBACK_NEEDS_AES_DECRYPT      TRUE
+#else
+#define CRY_FALLBACK_NEEDS_AES_DECRYPT      FALSE
+#endif
+
+#define CH(x, y, z)         ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)        (((x) & (y)) | ((z) & ((x) | (y))))
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Transient keys storage.
+ * @note    The fallback transient keys are shared by all the driver
+ *          instances.
+ */
+static struct {
+#if (CRY_FALLBACK_NEEDS_AES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   AES encryption round keys.
+   */
+  uint32_t                  aes_ek[4U * (CRY_FALLBACK_AES_MAX_ROUNDS + 1U)];
+  /**
+   * @brief   AES decryption round keys.
+   */
+  uint32_t                  aes_dk[4U * (CRY_FALLBACK_AES_MAX_ROUNDS + 1U)];
+  /**
+   * @brief   Number of AES rounds, zero if no key has been loaded.
+   */
+  uint32_t                  aes_rounds;
+#endif
+#if (CRY_FALLBACK_NEEDS_HMAC == TRUE) || defined(__DOXYGEN__)
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) || defined(__DOXYGEN__)
+  /**
+   * @brief   HMAC-SHA256 key padded to the block size.
+   */
+  uint8_t                   hmac256_key[64];
+#endif
+#if (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+  /**
+   * @brief   HMAC-SHA512 key padded to the block size.
+   */
+  uint8_t                   hmac512_key[128];
+#endif
+  /**
+   * @brief   HMAC key loaded.
+   */
+  bool                      hmac_loaded;
+#endif
+} cry_fallback_keys;
+
+#if (CRY_FALLBACK_NEEDS_AES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   AES forward S-box.
+ */
+static const uint8_t aes_sbox[256] = {
+  0x63U, 0x7CU, 0x77U, 0x7BU, 0xF2U, 0x6BU, 0x6FU, 0xC5U,
+  0x30U, 0x01U, 0x67U, 0x2BU, 0xFEU, 0xD7U, 0xABU, 0x76U,
+  0xCAU, 0x82U, 0xC9U, 0x7DU, 0xFAU, 0x59U, 0x47U, 0xF0U,
+  0xADU, 0xD4U, 0xA2U, 0xAFU, 0x9CU, 0xA4U, 0x72U, 0xC0U,
+  0xB7U, 0xFDU, 0x93U, 0x26U, 0x36U, 0x3FU, 0xF7U, 0xCCU,
+  0x34U, 0xA5U, 0xE5U, 0xF1U, 0x71U, 0xD8U, 0x31U, 0x15U,
+  0x04U, 0xC7U, 0x23U, 0xC3U, 0x18U, 0x96U, 0x05U, 0x9AU,
+  0x07U, 0x12U, 0x80U, 0xE2U, 0xEBU, 0x27U, 0xB2U, 0x75U,
+  0x09U, 0x83U, 0x2CU, 0x1AU, 0x1BU, 0x6EU, 0x5AU, 0xA0U,
+  0x52U, 0x3BU, 0xD6U, 0xB3U, 0x29U, 0xE3U, 0x2FU, 0x84U,
+  0x53U, 0xD1U, 0x00U, 0xEDU, 0x20U, 0xFCU, 0xB1U, 0x5BU,
+  0x6AU, 0xCBU, 0xBEU, 0x39U, 0x4AU, 0x4CU, 0x58U, 0xCFU,
+  0xD0U, 0xEFU, 0xAAU, 0xFBU, 0x43U, 0x4DU, 0x33U, 0x85U,
+  0x45U, 0xF9U, 0x02U, 0x7FU, 0x50U, 0x3CU, 0x9FU, 0xA8U,
+  0x51U, 0xA3U, 0x40U, 0x8FU, 0x92U, 0x9DU, 0x38U, 0xF5U,
+  0xBCU, 0xB6U, 0xDAU, 0x21U, 0x10U, 0xFFU, 0xF3U, 0xD2U,
+  0xCDU, 0x0CU, 0x13U, 0xECU, 0x5FU, 0x97U, 0x44U, 0x17U,
+  0xC4U, 0xA7U, 0x7EU, 0x3DU, 0x64U, 0x5DU, 0x19U, 0x73U,
+  0x60U, 0x81U, 0x4FU, 0xDCU, 0x22U, 0x2AU, 0x90U, 0x88U,
+  0x46U, 0xEEU, 0xB8U, 0x14U, 0xDEU, 0x5EU, 0x0BU, 0xDBU,
+  0xE0U, 0x32U, 0x3AU, 0x0AU, 0x49U, 0x06U, 0x24U, 0x5CU,
+  0xC2U, 0xD3U, 0xACU, 0x62U, 0x91U, 0x95U, 0xE4U, 0x79U,
+  0xE7U, 0xC8U, 0x37U, 0x6DU, 0x8DU, 0xD5U, 0x4EU, 0xA9U,
+  0x6CU, 0x56U, 0xF4U, 0xEAU, 0x65U, 0x7AU, 0xAEU, 0x08U,
+  0xBAU, 0x78U, 0x25U, 0x2EU, 0x1CU, 0xA6U, 0xB4U, 0xC6U,
+  0xE8U, 0xDDU, 0x74U, 0x1FU, 0x4BU, 0xBDU, 0x8BU, 0x8AU,
+  0x70U, 0x3EU, 0xB5U, 0x66U, 0x48U, 0x03U, 0xF6U, 0x0EU,
+  0x61U, 0x35U, 0x57U, 0xB9U, 0x86U, 0xC1U, 0x1DU, 0x9EU,
+  0xE1U, 0xF8U, 0x98U, 0x11U, 0x69U, 0xD9U, 0x8EU, 0x94U,
+  0x9BU, 0x1EU, 0x87U, 0xE9U, 0xCEU, 0x55U, 0x28U, 0xDFU,
+  0x8CU, 0xA1U, 0x89U, 0x0DU, 0xBFU, 0xE6U, 0x42U, 0x68U,
+  0x41U, 0x99U, 0x2DU, 0x0FU, 0xB0U, 0x54U, 0xBBU, 0x16U
+};
+
+#if (CRY_FALLBACK_NEEDS_AES_DECRYPT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   AES inverse S-box.
+ */
+static const uint8_t aes_isbox[256] = {
+  0x52U, 0x09U, 0x6AU, 0xD5U, 0x30U, 0x36U, 0xA5U, 0x38U,
+  0xBFU, 0x40U, 0xA3U, 0x9EU, 0x81U, 0xF3U, 0xD7U, 0xFBU,
+  0x7CU, 0xE3U, 0x39U, 0x82U, 0x9BU, 0x2FU, 0xFFU, 0x87U,
+  0x34U, 0x8EU, 0x43U, 0x44U, 0xC4U, 0xDEU, 0xE9U, 0xCBU,
+  0x54U, 0x7BU, 0x94U, 0x32U, 0xA6U, 0xC2U, 0x23U, 0x3DU,
+  0xEEU, 0x4CU, 0x95U, 0x0BU, 0x42U, 0xFAU, 0xC3U, 0x4EU,
+  0x08U, 0x2EU, 0xA1U, 0x66U, 0x28U, 0xD9U, 0x24U, 0xB2U,
+  0x76U, 0x5BU, 0xA2U, 0x49U, 0x6DU, 0x8BU, 0xD1U, 0x25U,
+  0x72U, 0xF8U, 0xF6U, 0x64U, 0x86U, 0x68U, 0x98U, 0x16U,
+  0xD4U, 0xA4U, 0x5CU, 0xCCU, 0x5DU, 0x65U, 0xB6U, 0x92U,
+  0x6CU, 0x70U, 0x48U, 0x50U, 0xFDU, 0xEDU, 0xB9U, 0xDAU,
+  0x5EU, 0x15U, 0x46U, 0x57U, 0xA7U, 0x8DU, 0x9DU, 0x84U,
+  0x90U, 0xD8U, 0xABU, 0x00U, 0x8CU, 0xBCU, 0xD3U, 0x0AU,
+  0xF7U, 0xE4U, 0x58U, 0x05U, 0xB8U, 0xB3U, 0x45U, 0x06U,
+  0xD0U, 0x2CU, 0x1EU, 0x8FU, 0xCAU, 0x3FU, 0x0FU, 0x02U,
+  0xC1U, 0xAFU, 0xBDU, 0x03U, 0x01U, 0x13U, 0x8AU, 0x6BU,
+  0x3AU, 0x91U, 0x11U, 0x41U, 0x4FU, 0x67U, 0xDCU, 0xEAU,
+  0x97U, 0xF2U, 0xCFU, 0xCEU, 0xF0U, 0xB4U, 0xE6U, 0x73U,
+  0x96U, 0xACU, 0x74U, 0x22U, 0xE7U, 0xADU, 0x35U, 0x85U,
+  0xE2U, 0xF9U, 0x37U, 0xE8U, 0x1CU, 0x75U, 0xDFU, 0x6EU,
+  0x47U, 0xF1U, 0x1AU, 0x71U, 0x1DU, 0x29U, 0xC5U, 0x89U,
+  0x6FU, 0xB7U, 0x62U, 0x0EU, 0xAAU, 0x18U, 0xBEU, 0x1BU,
+  0xFCU, 0x56U, 0x3EU, 0x4BU, 0xC6U, 0xD2U, 0x79U, 0x20U,
+  0x9AU, 0xDBU, 0xC0U, 0xFEU, 0x78U, 0xCDU, 0x5AU, 0xF4U,
+  0x1FU, 0xDDU, 0xA8U, 0x33U, 0x88U, 0x07U, 0xC7U, 0x31U,
+  0xB1U, 0x12U, 0x10U, 0x59U, 0x27U, 0x80U, 0xECU, 0x5FU,
+  0x60U, 0x51U, 0x7FU, 0xA9U, 0x19U, 0xB5U, 0x4AU, 0x0DU,
+  0x2DU, 0xE5U, 0x7AU, 0x9FU, 0x93U, 0xC9U, 0x9CU, 0xEFU,
+  0xA0U, 0xE0U, 0x3BU, 0x4DU, 0xAEU, 0x2AU, 0xF5U, 0xB0U,
+  0xC8U, 0xEBU, 0xBBU, 0x3CU, 0x83U, 0x53U, 0x99U, 0x61U,
+  0x17U, 0x2BU, 0x04U, 0x7EU, 0xBAU, 0x77U, 0xD6U, 0x26U,
+  0xE1U, 0x69U, 0x14U, 0x63U, 0x55U, 0x21U, 0x0CU, 0x7DU
+};
+#endif
+
+/**
+ * @brief   AES forward round table, the other three tables are obtained
+ *          by rotation.
+ */
+static const uint32_t aes_te0[256] = {
+  0xC66363A5U, 0xF87C7C84U, 0xEE777799U, 0xF67B7B8DU,
+  0xFFF2F20DU, 0xD66B6BBDU, 0xDE6F6FB1U, 0x91C5C554U,
+  0x60303050U, 0x02010103U, 0xCE6767A9U, 0x562B2B7DU,
+  0xE7FEFE19U, 0xB5D7D762U, 0x4DABABE6U, 0xEC76769AU,
+  0x8FCACA45U, 0x1F82829DU, 0x89C9C940U, 0xFA7D7D87U,
+  0xEFFAFA15U, 0xB25959EBU, 0x8E4747C9U, 0xFBF0F00BU,
+  0x41ADADECU, 0xB3D4D467U, 0x5FA2A2FDU, 0x45AFAFEAU,
+  0x239C9CBFU, 0x53A4A4F7U, 0xE4727296U, 0x9BC0C05BU,
+  0x75B7B7C2U, 0xE1FDFD1CU, 0x3D9393AEU, 0x4C26266AU,
+  0x6C36365AU, 0x7E3F3F41U, 0xF5F7F702U, 0x83CCCC4FU,
+  0x6834345CU, 0x51A5A5F4U, 0xD1E5E534U, 0xF9F1F108U,
+  0xE2717193U, 0xABD8D873U, 0x62313153U, 0x2A15153FU,
+  0x0804040CU, 0x95C7C752U, 0x46232365U, 0x9DC3C35EU,
+  0x30181828U, 0x379696A1U, 0x0A05050FU, 0x2F9A9AB5U,
+  0x0E070709U, 0x24121236U, 0x1B80809BU, 0xDFE2E23DU,
+  0xCDEBEB26U, 0x4E272769U, 0x7FB2B2CDU, 0xEA75759FU,
+  0x1209091BU, 0x1D83839EU, 0x582C2C74U, 0x341A1A2EU,
+  0x361B1B2DU, 0xDC6E6EB2U, 0xB45A5AEEU, 0x5BA0A0FBU,
+  0xA45252F6U, 0x763B3B4DU, 0xB7D6D661U, 0x7DB3B3CEU,
+  0x5229297BU, 0xDDE3E33EU, 0x5E2F2F71U, 0x13848497U,
+  0xA65353F5U, 0xB9D1D168U, 0x00000000U, 0xC1EDED2CU,
+  0x40202060U, 0xE3FCFC1FU, 0x79B1B1C8U, 0xB65B5BEDU,
+  0xD46A6ABEU, 0x8DCBCB46U, 0x67BEBED9U, 0x7239394BU,
+  0x944A4ADEU, 0x984C4CD4U, 0xB05858E8U, 0x85CFCF4AU,
+  0xBBD0D06BU, 0xC5EFEF2AU, 0x4FAAAAE5U, 0xEDFBFB16U,
+  0x864343C5U, 0x9A4D4DD7U, 0x66333355U, 0x11858594U,
+  0x8A4545CFU, 0xE9F9F910U, 0x04020206U, 0xFE7F7F81U,
+  0xA05050F0U, 0x783C3C44U, 0x259F9FBAU, 0x4BA8A8E3U,
+  0xA25151F3U, 0x5DA3A3FEU, 0x804040C0U, 0x058F8F8AU,
+  0x3F9292ADU, 0x219D9DBCU, 0x70383848U, 0xF1F5F504U,
+  0x63BCBCDFU, 0x77B6B6C1U, 0xAFDADA75U, 0x42212163U,
+  0x20101030U, 0xE5FFFF1AU, 0xFDF3F30EU, 0xBFD2D26DU,
+  0x81CDCD4CU, 0x180C0C14U, 0x26131335U, 0xC3ECEC2FU,
+  0xBE5F5FE1U, 0x359797A2U, 0x884444CCU, 0x2E171739U,
+  0x93C4C457U, 0x55A7A7F2U, 0xFC7E7E82U, 0x7A3D3D47U,
+  0xC86464ACU, 0xBA5D5DE7U, 0x3219192BU, 0xE6737395U,
+  0xC06060A0U, 0x19818198U, 0x9E4F4FD1U, 0xA3DCDC7FU,
+  0x44222266U, 0x542A2A7EU, 0x3B9090ABU, 0x0B888883U,
+  0x8C4646CAU, 0xC7EEEE29U, 0x6BB8B8D3U, 0x2814143CU,
+  0xA7DEDE79U, 0xBC5E5EE2U, 0x160B0B1DU, 0xADDBDB76U,
+  0xDBE0E03BU, 0x64323256U, 0x743A3A4EU, 0x140A0A1EU,
+  0x924949DBU, 0x0C06060AU, 0x4824246CU, 0xB85C5CE4U,
+  0x9FC2C25DU, 0xBDD3D36EU, 0x43ACACEFU, 0xC46262A6U,
+  0x399191A8U, 0x319595A4U, 0xD3E4E437U, 0xF279798BU,
+  0xD5E7E732U, 0x8BC8C843U, 0x6E373759U, 0xDA6D6DB7U,
+  0x018D8D8CU, 0xB1D5D564U, 0x9C4E4ED2U, 0x49A9A9E0U,
+  0xD86C6CB4U, 0xAC5656FAU, 0xF3F4F407U, 0xCFEAEA25U,
+  0xCA6565AFU, 0xF47A7A8EU, 0x47AEAEE9U, 0x10080818U,
+  0x6FBABAD5U, 0xF0787888U, 0x4A25256FU, 0x5C2E2E72U,
+  0x381C1C24U, 0x57A6A6F1U, 0x73B4B4C7U, 0x97C6C651U,
+  0xCBE8E823U, 0xA1DDDD7CU, 0xE874749CU, 0x3E1F1F21U,
+  0x964B4BDDU, 0x61BDBDDCU, 0x0D8B8B86U, 0x0F8A8A85U,
+  0xE0707090U, 0x7C3E3E42U, 0x71B5B5C4U, 0xCC6666AAU,
+  0x904848D8U, 0x06030305U, 0xF7F6F601U, 0x1C0E0E12U,
+  0xC26161A3U, 0x6A35355FU, 0xAE5757F9U, 0x69B9B9D0U,
+  0x17868691U, 0x99C1C158U, 0x3A1D1D27U, 0x279E9EB9U,
+  0xD9E1E138U, 0xEBF8F813U, 0x2B9898B3U, 0x22111133U,
+  0xD26969BBU, 0xA9D9D970U, 0x078E8E89U, 0x339494A7U,
+  0x2D9B9BB6U, 0x3C1E1E22U, 0x15878792U, 0xC9E9E920U,
+  0x87CECE49U, 0xAA5555FFU, 0x50282878U, 0xA5DFDF7AU,
+  0x038C8C8FU, 0x59A1A1F8U, 0x09898980U, 0x1A0D0D17U,
+  0x65BFBFDAU, 0xD7E6E631U, 0x844242C6U, 0xD06868B8U,
+  0x824141C3U, 0x299999B0U, 0x5A2D2D77U, 0x1E0F0F11U,
+  0x7BB0B0CBU, 0xA85454FCU, 0x6DBBBBD6U, 0x2C16163AU
+};
+
+/**
+ * @brief   AES inverse round table, the other three tables are obtained
+ *          by rotation.
+ */
+static const uint32_t aes_td0[256] = {
+  0x51F4A750U, 0x7E416553U, 0x1A17A4C3U, 0x3A275E96U,
+  0x3BAB6BCBU, 0x1F9D45F1U, 0xACFA58ABU, 0x4BE30393U,
+  0x2030FA55U, 0xAD766DF6U, 0x88CC7691U, 0xF5024C25U,
+  0x4FE5D7FCU, 0xC52ACBD7U, 0x26354480U, 0xB562A38FU,
+  0xDEB15A49U, 0x25BA1B67U, 0x45EA0E98U, 0x5DFEC0E1U,
+  0xC32F7502U, 0x814CF012U, 0x8D4697A3U, 0x6BD3F9C6U,
+  0x038F5FE7U, 0x15929C95U, 0xBF6D7AEBU, 0x955259DAU,
+  0xD4BE832DU, 0x587421D3U, 0x49E06929U, 0x8EC9C844U,
+  0x75C2896AU, 0xF48E7978U, 0x99583E6BU, 0x27B971DDU,
+  0xBEE14FB6U, 0xF088AD17U, 0xC920AC66U, 0x7DCE3AB4U,
+  0x63DF4A18U, 0xE51A3182U, 0x97513360U, 0x62537F45U,
+  0xB16477E0U, 0xBB6BAE84U, 0xFE81A01CU, 0xF9082B94U,
+  0x70486858U, 0x8F45FD19U, 0x94DE6C87U, 0x527BF8B7U,
+  0xAB73D323U, 0x724B02E2U, 0xE31F8F57U, 0x6655AB2AU,
+  0xB2EB2807U, 0x2FB5C203U, 0x86C57B9AU, 0xD33708A5U,
+  0x302887F2U, 0x23BFA5B2U, 0x02036ABAU, 0xED16825CU,
+  0x8ACF1C2BU, 0xA779B492U, 0xF307F2F0U, 0x4E69E2A1U,
+  0x65DAF4CDU, 0x0605BED5U, 0xD134621FU, 0xC4A6FE8AU,
+  0x342E539DU, 0xA2F355A0U, 0x058AE132U, 0xA4F6EB75U,
+  0x0B83EC39U, 0x4060EFAAU, 0x5E719F06U, 0xBD6E1051U,
+  0x3E218AF9U, 0x96DD063DU, 0xDD3E05AEU, 0x4DE6BD46U,
+  0x91548DB5U, 0x71C45D05U, 0x0406D46FU, 0x605015FFU,
+  0x1998FB24U, 0xD6BDE997U, 0x894043CCU, 0x67D99E77U,
+  0xB0E842BDU, 0x07898B88U, 0xE7195B38U, 0x79C8EEDBU,
+  0xA17C0A47U, 0x7C420FE9U, 0xF8841EC9U, 0x00000000U,
+  0x09808683U, 0x322BED48U, 0x1E1170ACU, 0x6C5A724EU,
+  0xFD0EFFFBU, 0x0F853856U, 0x3DAED51EU, 0x362D3927U,
+  0x0A0FD964U, 0x685CA621U, 0x9B5B54D1U, 0x24362E3AU,
+  0x0C0A67B1U, 0x9357E70FU, 0xB4EE96D2U, 0x1B9B919EU,
+  0x80C0C54FU, 0x61DC20A2U, 0x5A774B69U, 0x1C121A16U,
+  0xE293BA0AU, 0xC0A02AE5U, 0x3C22E043U, 0x121B171DU,
+  0x0E090D0BU, 0xF28BC7ADU, 0x2DB6A8B9U, 0x141EA9C8U,
+  0x57F11985U, 0xAF75074CU, 0xEE99DDBBU, 0xA37F60FDU,
+  0xF701269FU, 0x5C72F5BCU, 0x44663BC5U, 0x5BFB7E34U,
+  0x8B432976U, 0xCB23C6DCU, 0xB6EDFC68U, 0xB8E4F163U,
+  0xD731DCCAU, 0x42638510U, 0x13972240U, 0x84C61120U,
+  0x854A247DU, 0xD2BB3DF8U, 0xAEF93211U, 0xC729A16DU,
+  0x1D9E2F4BU, 0xDCB230F3U, 0x0D8652ECU, 0x77C1E3D0U,
+  0x2BB3166CU, 0xA970B999U, 0x119448FAU, 0x47E96422U,
+  0xA8FC8CC4U, 0xA0F03F1AU, 0x567D2CD8U, 0x223390EFU,
+  0x87494EC7U, 0xD938D1C1U, 0x8CCAA2FEU, 0x98D40B36U,
+  0xA6F581CFU, 0xA57ADE28U, 0xDAB78E26U, 0x3FADBFA4U,
+  0x2C3A9DE4U, 0x5078920DU, 0x6A5FCC9BU, 0x547E4662U,
+  0xF68D13C2U, 0x90D8B8E8U, 0x2E39F75EU, 0x82C3AFF5U,
+  0x9F5D80BEU, 0x69D0937CU, 0x6FD52DA9U, 0xCF2512B3U,
+  0xC8AC993BU, 0x10187DA7U, 0xE89C636EU, 0xDB3BBB7BU,
+  0xCD267809U, 0x6E5918F4U, 0xEC9AB701U, 0x834F9AA8U,
+  0xE6956E65U, 0xAAFFE67EU, 0x21BCCF08U, 0xEF15E8E6U,
+  0xBAE79BD9U, 0x4A6F36CEU, 0xEA9F09D4U, 0x29B07CD6U,
+  0x31A4B2AFU, 0x2A3F2331U, 0xC6A59430U, 0x35A266C0U,
+  0x744EBC37U, 0xFC82CAA6U, 0xE090D0B0U, 0x33A7D815U,
+  0xF104984AU, 0x41ECDAF7U, 0x7FCD500EU, 0x1791F62FU,
+  0x764DD68DU, 0x43EFB04DU, 0xCCAA4D54U, 0xE49604DFU,
+  0x9ED1B5E3U, 0x4C6A881BU, 0xC12C1FB8U, 0x4665517FU,
+  0x9D5EEA04U, 0x018C355DU, 0xFA877473U, 0xFB0B412EU,
+  0xB3671D5AU, 0x92DBD252U, 0xE9105633U, 0x6DD64713U,
+  0x9AD7618CU, 0x37A10C7AU, 0x59F8148EU, 0xEB133C89U,
+  0xCEA927EEU, 0xB761C935U, 0xE11CE5EDU, 0x7A47B13CU,
+  0x9CD2DF59U, 0x55F2733FU, 0x1814CE79U, 0x73C737BFU,
+  0x53F7CDEAU, 0x5FFDAA5BU, 0xDF3D6F14U, 0x7844DB86U,
+  0xCAAFF381U, 0xB968C43EU, 0x3824342CU, 0xC2A3405FU,
+  0x161DC372U, 0xBCE2250CU, 0x283C498BU, 0xFF0D9541U,
+  0x39A80171U, 0x080CB3DEU, 0xD8B4E49CU, 0x6456C190U,
+  0x7BCB8461U, 0xD532B670U, 0x486C5C74U, 0xD0B85742U
+};
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   GHASH reduction table for 4 bits shifts.
+ */
+static const uint16_t ghash_last4[16] = {
+  0x0000U, 0x1C20U, 0x3840U, 0x2460U, 0x7080U, 0x6CA0U, 0x48C0U, 0x54E0U,
+  0xE100U, 0xFD20U, 0xD940U, 0xC560U, 0x9180U, 0x8DA0U, 0xA9C0U, 0xB5E0U
+};
+
+/**
+ * @brief   Type of a GHASH multiplication table.
+ */
+typedef struct {
+  uint64_t                  hh[16];
+  uint64_t                  hl[16];
+} ghash_table_t;
+#endif
+#endif /* CRY_FALLBACK_NEEDS_AES == TRUE */
+
+#if (CRY_FALLBACK_NEEDS_SHA256 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   SHA256 round constants.
+ */
+static const uint32_t sha256_k[64] = {
+  0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U,
+  0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+  0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U,
+  0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+  0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU,
+  0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+  0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U,
+  0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+  0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U,
+  0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+  0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U,
+  0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+  0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U,
+  0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+  0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U,
+  0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U
+};
+
+/**
+ * @brief   SHA256 initial hash value.
+ */
+static const uint32_t sha256_h0[8] = {
+  0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+  0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+};
+#endif
+
+#if (CRY_FALLBACK_NEEDS_SHA512 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   SHA512 round constants.
+ */
+static const uint64_t sha512_k[80] = {
+  0x428A2F98D728AE22U, 0x7137449123EF65CDU,
+  0xB5C0FBCFEC4D3B2FU, 0xE9B5DBA58189DBBCU,
+  0x3956C25BF348B538U, 0x59F111F1B605D019U,
+  0x923F82A4AF194F9BU, 0xAB1C5ED5DA6D8118U,
+  0xD807AA98A3030242U, 0x12835B0145706FBEU,
+  0x243185BE4EE4B28CU, 0x550C7DC3D5FFB4E2U,
+  0x72BE5D74F27B896FU, 0x80DEB1FE3B1696B1U,
+  0x9BDC06A725C71235U, 0xC19BF174CF692694U,
+  0xE49B69C19EF14AD2U, 0xEFBE4786384F25E3U,
+  0x0FC19DC68B8CD5B5U, 0x240CA1CC77AC9C65U,
+  0x2DE92C6F592B0275U, 0x4A7484AA6EA6E483U,
+  0x5CB0A9DCBD41FBD4U, 0x76F988DA831153B5U,
+  0x983E5152EE66DFABU, 0xA831C66D2DB43210U,
+  0xB00327C898FB213FU, 0xBF597FC7BEEF0EE4U,
+  0xC6E00BF33DA88FC2U, 0xD5A79147930AA725U,
+  0x06CA6351E003826FU, 0x142929670A0E6E70U,
+  0x27B70A8546D22FFCU, 0x2E1B21385C26C926U,
+  0x4D2C6DFC5AC42AEDU, 0x53380D139D95B3DFU,
+  0x650A73548BAF63DEU, 0x766A0ABB3C77B2A8U,
+  0x81C2C92E47EDAEE6U, 0x92722C851482353BU,
+  0xA2BFE8A14CF10364U, 0xA81A664BBC423001U,
+  0xC24B8B70D0F89791U, 0xC76C51A30654BE30U,
+  0xD192E819D6EF5218U, 0xD69906245565A910U,
+  0xF40E35855771202AU, 0x106AA07032BBD1B8U,
+  0x19A4C116B8D2D0C8U, 0x1E376C085141AB53U,
+  0x2748774CDF8EEB99U, 0x34B0BCB5E19B48A8U,
+  0x391C0CB3C5C95A63U, 0x4ED8AA4AE3418ACBU,
+  0x5B9CCA4F7763E373U, 0x682E6FF3D6B2B8A3U,
+  0x748F82EE5DEFB2FCU, 0x78A5636F43172F60U,
+  0x84C87814A1F0AB72U, 0x8CC702081A6439ECU,
+  0x90BEFFFA23631E28U, 0xA4506CEBDE82BDE9U,
+  0xBEF9A3F7B2C67915U, 0xC67178F2E372532BU,
+  0xCA273ECEEA26619CU, 0xD186B8C721C0C207U,
+  0xEADA7DD6CDE0EB1EU, 0xF57D4F7FEE6ED178U,
+  0x06F067AA72176FBAU, 0x0A637DC5A2C898A6U,
+  0x113F9804BEF90DAEU, 0x1B710B35131C471BU,
+  0x28DB77F523047D84U, 0x32CAAB7B40C72493U,
+  0x3C9EBE0A15C9BEBCU, 0x431D67C49C100D4CU,
+  0x4CC5D4BECB3E42B6U, 0x597F299CFC657E2AU,
+  0x5FCB6FAB3AD6FAECU, 0x6C44198C4A475817U
+};
+
+/**
+ * @brief   SHA512 initial hash value.
+ */
+static const uint64_t sha512_h0[8] = {
+  0x6A09E667F3BCC908U, 0xBB67AE8584CAA73BU,
+  0x3C6EF372FE94F82BU, 0xA54FF53A5F1D36F1U,
+  0x510E527FADE682D1U, 0x9B05688C2B3E6C1FU,
+  0x1F83D9ABFB41BD6BU, 0x5BE0CD19137E2179U
+};
+#endif
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+static inline uint32_t load_be32(const uint8_t *p) {
+
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+}
+
+static inline void store_be32(uint8_t *p, uint32_t x) {
+
+  p[0] = (uint8_t)(x >> 24);
+  p[1] = (uint8_t)(x >> 16);
+  p[2] = (uint8_t)(x >> 8);
+  p[3] = (uint8_t)x;
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+
+  return ((uint64_t)load_be32(p) << 32) | (uint64_t)load_be32(p + 4);
+}
+
+static inline void store_be64(uint8_t *p, uint64_t x) {
+
+  store_be32(p, (uint32_t)(x >> 32));
+  store_be32(p + 4, (uint32_t)x);
+}
+
+static void xor_block(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                      size_t n) {
+
+  while (n > 0U) {
+    *out++ = *a++ ^ *b++;
+    n--;
+  }
+}
+
+#if (CRY_FALLBACK_NEEDS_AES == TRUE) || defined(__DOXYGEN__)
+static uint32_t aes_subword(uint32_t w) {
+
+  return ((uint32_t)aes_sbox[w >> 24] << 24) |
+         ((uint32_t)aes_sbox[(w >> 16) & 0xFFU] << 16) |
+         ((uint32_t)aes_sbox[(w >> 8) & 0xFFU] << 8) |
+         (uint32_t)aes_sbox[w & 0xFFU];
+}
+
+static uint32_t aes_invmixcolumn(uint32_t w) {
+
+  return aes_td0[aes_sbox[w >> 24]] ^
+         ROR32(aes_td0[aes_sbox[(w >> 16) & 0xFFU]], 8U) ^
+         ROR32(aes_td0[aes_sbox[(w >> 8) & 0xFFU]], 16U) ^
+         ROR32(aes_td0[aes_sbox[w & 0xFFU]], 24U);
+}
+
+static cryerror_t aes_check_key(crykey_t key_id) {
+
+  if ((key_id != (crykey_t)0) || (cry_fallback_keys.aes_rounds == 0U)) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  return CRY_NOERROR;
+}
+
+#define AES_TE(t0, t1, t2, t3, rk)                                          \
+  (aes_te0[(t0) >> 24] ^                                                    \
+   ROR32(aes_te0[((t1) >> 16) & 0xFFU], 8U) ^                               \
+   ROR32(aes_te0[((t2) >> 8) & 0xFFU], 16U) ^                               \
+   ROR32(aes_te0[(t3) & 0xFFU], 24U) ^ (rk))
+
+#define AES_TD(t0, t1, t2, t3, rk)                                          \
+  (aes_td0[(t0) >> 24] ^                                                    \
+   ROR32(aes_td0[((t1) >> 16) & 0xFFU], 8U) ^                               \
+   ROR32(aes_td0[((t2) >> 8) & 0xFFU], 16U) ^                               \
+   ROR32(aes_td0[(t3) & 0xFFU], 24U) ^ (rk))
+
+#define AES_LAST(sb, t0, t1, t2, t3, rk)                                    \
+  (((uint32_t)(sb)[(t0) >> 24] << 24) ^                                     \
+   ((uint32_t)(sb)[((t1) >> 16) & 0xFFU] << 16) ^                           \
+   ((uint32_t)(sb)[((t2) >> 8) & 0xFFU] << 8) ^                             \
+   (uint32_t)(sb)[(t3) & 0xFFU] ^ (rk))
+
+static void aes_encrypt_block(const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = cry_fallback_keys.aes_ek;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3, r;
+
+  s0 = load_be32(in)      ^ rk[0];
+  s1 = load_be32(in + 4)  ^ rk[1];
+  s2 = load_be32(in + 8)  ^ rk[2];
+  s3 = load_be32(in + 12) ^ rk[3];
+
+  /* Two rounds for each iteration, the last full round and the final
+     round are done after the loop.*/
+  r = cry_fallback_keys.aes_rounds >> 1;
+  while (true) {
+    t0 = AES_TE(s0, s1, s2, s3, rk[4]);
+    t1 = AES_TE(s1, s2, s3, s0, rk[5]);
+    t2 = AES_TE(s2, s3, s0, s1, rk[6]);
+    t3 = AES_TE(s3, s0, s1, s2, rk[7]);
+    rk += 8;
+    if (--r == 0U) {
+      break;
+    }
+    s0 = AES_TE(t0, t1, t2, t3, rk[0]);
+    s1 = AES_TE(t1, t2, t3, t0, rk[1]);
+    s2 = AES_TE(t2, t3, t0, t1, rk[2]);
+    s3 = AES_TE(t3, t0, t1, t2, rk[3]);
+  }
+
+  store_be32(out,      AES_LAST(aes_sbox, t0, t1, t2, t3, rk[0]));
+  store_be32(out + 4,  AES_LAST(aes_sbox, t1, t2, t3, t0, rk[1]));
+  store_be32(out + 8,  AES_LAST(aes_sbox, t2, t3, t0, t1, rk[2]));
+  store_be32(out + 12, AES_LAST(aes_sbox, t3, t0, t1, t2, rk[3]));
+}
+
+#if (CRY_FALLBACK_NEEDS_AES_DECRYPT == TRUE) || defined(__DOXYGEN__)
+static void aes_decrypt_block(const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = cry_fallback_keys.aes_dk;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3, r;
+
+  s0 = load_be32(in)      ^ rk[0];
+  s1 = load_be32(in + 4)  ^ rk[1];
+  s2 = load_be32(in + 8)  ^ rk[2];
+  s3 = load_be32(in + 12) ^ rk[3];
+
+  r = cry_fallback_keys.aes_rounds >> 1;
+  while (true) {
+    t0 = AES_TD(s0, s3, s2, s1, rk[4]);
+    t1 = AES_TD(s1, s0, s3, s2, rk[5]);
+    t2 = AES_TD(s2, s1, s0, s3, rk[6]);
+    t3 = AES_TD(s3, s2, s1, s0, rk[7]);
+    rk += 8;
+    if (--r == 0U) {
+      break;
+    }
+    s0 = AES_TD(t0, t3, t2, t1, rk[0]);
+    s1 = AES_TD(t1, t0, t3, t2, rk[1]);
+    s2 = AES_TD(t2, t1, t0, t3, rk[2]);
+    s3 = AES_TD(t3, t2, t1, t0, rk[3]);
+  }
+
+  store_be32(out,      AES_LAST(aes_isbox, t0, t3, t2, t1, rk[0]));
+  store_be32(out + 4,  AES_LAST(aes_isbox, t1, t0, t3, t2, rk[1]));
+  store_be32(out + 8,  AES_LAST(aes_isbox, t2, t1, t0, t3, rk[2]));
+  store_be32(out + 12, AES_LAST(aes_isbox, t3, t2, t1, t0, rk[3]));
+}
+
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_CTR == FALSE) ||                                  \
+    (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+static void ctr_increment(uint8_t *ctr, size_t n) {
+
+  /* Big endian increment of the last n bytes of the counter block.*/
+  ctr += 16U;
+  while (n > 0U) {
+    ctr--;
+    n--;
+    *ctr = *ctr + 1U;
+    if (*ctr != 0U) {
+      break;
+    }
+  }
+}
+
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+static void ghash_init(ghash_table_t *tp, const uint8_t *h) {
+  uint64_t vh, vl;
+  unsigned i, j;
+
+  vh = load_be64(h);
+  vl = load_be64(h + 8);
+
+  tp->hh[0] = 0U;
+  tp->hl[0] = 0U;
+  tp->hh[8] = vh;
+  tp->hl[8] = vl;
+  for (i = 4U; i > 0U; i >>= 1) {
+    uint32_t t = ((uint32_t)vl & 1U) * 0xE1000000U;
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ ((uint64_t)t << 32);
+    tp->hh[i] = vh;
+    tp->hl[i] = vl;
+  }
+  for (i = 2U; i <= 8U; i *= 2U) {
+    for (j = 1U; j < i; j++) {
+      tp->hh[i + j] = tp->hh[i] ^ tp->hh[j];
+      tp->hl[i + j] = tp->hl[i] ^ tp->hl[j];
+    }
+  }
+}
+
+static void ghash_mult(const ghash_table_t *tp, uint8_t *y) {
+  uint64_t zh, zl;
+  unsigned i, lo, hi, rem;
+
+  lo = (unsigned)y[15] & 0x0FU;
+  zh = tp->hh[lo];
+  zl = tp->hl[lo];
+  for (i = 16U; i > 0U; i--) {
+    lo = (unsigned)y[i - 1U] & 0x0FU;
+    hi = (unsigned)y[i - 1U] >> 4;
+    if (i != 16U) {
+      rem = (unsigned)zl & 0x0FU;
+      zl = (zh << 60) | (zl >> 4);
+      zh = (zh >> 4) ^ ((uint64_t)ghash_last4[rem] << 48);
+      zh ^= tp->hh[lo];
+      zl ^= tp->hl[lo];
+    }
+    rem = (unsigned)zl & 0x0FU;
+    zl = (zh << 60) | (zl >> 4);
+    zh = (zh >> 4) ^ ((uint64_t)ghash_last4[rem] << 48);
+    zh ^= tp->hh[hi];
+    zl ^= tp->hl[hi];
+  }
+
+  store_be64(y, zh);
+  store_be64(y + 8, zl);
+}
+
+static void ghash_update(const ghash_table_t *tp, uint8_t *y,
+                         size_t size, const uint8_t *in) {
+
+  while (size > 0U) {
+    size_t n = size < 16U ? size : 16U;
+
+    xor_block(y, y, in, n);
+    ghash_mult(tp, y);
+    in   += n;
+    size -= n;
+  }
+}
+
+static cryerror_t aes_gcm(crykey_t key_id,
+                          bool decrypt,
+                          size_t auth_size,
+                          const uint8_t *auth_in,
+                          size_t text_size,
+                          const uint8_t *text_in,
+                          uint8_t *text_out,
+                          const uint8_t *iv,
+                          uint8_t *tag) {
+  ghash_table_t table;
+  uint8_t h[16], ctr[16], ks[16];
+  uint64_t text_bits = (uint64_t)text_size << 3;
+  cryerror_t err;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  /* Hash subkey and multiplication table.*/
+  memset(h, 0, sizeof h);
+  aes_encrypt_block(h, h);
+  ghash_init(&table, h);
+
+  /* Additional authenticated data, the hash accumulator is reused from
+     here.*/
+  memset(h, 0, sizeof h);
+  ghash_update(&table, h, auth_size, auth_in);
+
+  /* Text, the counter block starts from inc32(J0).*/
+  memcpy(ctr, iv, 16U);
+  while (text_size > 0U) {
+    size_t n = text_size < 16U ? text_size : 16U;
+
+    ctr_increment(ctr, 4U);
+    aes_encrypt_block(ctr, ks);
+    if (decrypt) {
+      ghash_update(&table, h, n, text_in);
+      xor_block(text_out, text_in, ks, n);
+    }
+    else {
+      xor_block(text_out, text_in, ks, n);
+      ghash_update(&table, h, n, text_out);
+    }
+    text_in   += n;
+    text_out  += n;
+    text_size -= n;
+  }
+
+  /* Lengths block.*/
+  store_be64(ks, (uint64_t)auth_size << 3);
+  store_be64(ks + 8, (uint64_t)text_bits);
+  ghash_update(&table, h, 16U, ks);
+
+  /* Full tag, it is truncated by the caller.*/
+  aes_encrypt_block(iv, ks);
+  xor_block(tag, h, ks, 16U);
+
+  return CRY_NOERROR;
+}
+#endif /* CRY_LLD_SUPPORTS_AES_GCM == FALSE */
+#endif /* CRY_FALLBACK_NEEDS_AES == TRUE */
+
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+static void sha1_block(uint32_t *hp, const uint8_t *p) {
+  uint32_t w[16];
+  uint32_t a, b, c, d, e, t;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = load_be32(p + (i * 4U));
+  }
+
+  a = hp[0];
+  b = hp[1];
+  c = hp[2];
+  d = hp[3];
+  e = hp[4];
+  for (i = 0U; i < 80U; i++) {
+    if (i >= 16U) {
+      t = w[(i + 13U) & 15U] ^ w[(i + 8U) & 15U] ^
+          w[(i + 2U) & 15U] ^ w[i & 15U];
+      w[i & 15U] = ROR32(t, 31U);
+    }
+    if (i < 20U) {
+      t = CH(b, c, d) + 0x5A827999U;
+    }
+    else if (i < 40U) {
+      t = (b ^ c ^ d) + 0x6ED9EBA1U;
+    }
+    else if (i < 60U) {
+      t = MAJ(b, c, d) + 0x8F1BBCDCU;
+    }
+    else {
+      t = (b ^ c ^ d) + 0xCA62C1D6U;
+    }
+    t += ROR32(a, 27U) + e + w[i & 15U];
+    e = d;
+    d = c;
+    c = ROR32(b, 2U);
+    b = a;
+    a = t;
+  }
+  hp[0] += a;
+  hp[1] += b;
+  hp[2] += c;
+  hp[3] += d;
+  hp[4] += e;
+}
+#endif
+
+#if (CRY_FALLBACK_NEEDS_SHA256 == TRUE) || defined(__DOXYGEN__)
+#define SHA256_S0(x)        (ROR32(x, 2U) ^ ROR32(x, 13U) ^ ROR32(x, 22U))
+#define SHA256_S1(x)        (ROR32(x, 6U) ^ ROR32(x, 11U) ^ ROR32(x, 25U))
+#define SHA256_G0(x)        (ROR32(x, 7U) ^ ROR32(x, 18U) ^ ((x) >> 3))
+#define SHA256_G1(x)        (ROR32(x, 17U) ^ ROR32(x, 19U) ^ ((x) >> 10))
+
+/* Message word from the block.*/
+#define SHA256_WL(i)        w[i]
+
+/* Message word from the schedule, the window is updated in place.*/
+#define SHA256_WX(i)                                                        \
+  (w[i] += SHA256_G1(w[((i) + 14U) & 15U]) + w[((i) + 9U) & 15U] +          \
+           SHA256_G0(w[((i) + 1U) & 15U]))
+
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, k, wi) do {                    \
+  uint32_t t1 = (h) + SHA256_S1(e) + CH(e, f, g) + (k) + (wi);              \
+  (d) += t1;                                                                \
+  (h)  = t1 + SHA256_S0(a) + MAJ(a, b, c);                                  \
+} while (false)
+
+/* Eight rounds, the working variables are rotated by renaming.*/
+#define SHA256_ROUNDS8(i, W) do {                                           \
+  SHA256_ROUND(a, b, c, d, e, f, g, h, kp[(i) + 0U], W((i) + 0U));          \
+  SHA256_ROUND(h, a, b, c, d, e, f, g, kp[(i) + 1U], W((i) + 1U));          \
+  SHA256_ROUND(g, h, a, b, c, d, e, f, kp[(i) + 2U], W((i) + 2U));          \
+  SHA256_ROUND(f, g, h, a, b, c, d, e, kp[(i) + 3U], W((i) + 3U));          \
+  SHA256_ROUND(e, f, g, h, a, b, c, d, kp[(i) + 4U], W((i) + 4U));          \
+  SHA256_ROUND(d, e, f, g, h, a, b, c, kp[(i) + 5U], W((i) + 5U));          \
+  SHA256_ROUND(c, d, e, f, g, h, a, b, kp[(i) + 6U], W((i) + 6U));          \
+  SHA256_ROUND(b, c, d, e, f, g, h, a, kp[(i) + 7U], W((i) + 7U));          \
+} while (false)
+
+static void sha256_block(uint32_t *hp, const uint8_t *p) {
+  const uint32_t *kp = sha256_k;
+  uint32_t w[16];
+  uint32_t a, b, c, d, e, f, g, h;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = load_be32(p + (i * 4U));
+  }
+
+  a = hp[0];
+  b = hp[1];
+  c = hp[2];
+  d = hp[3];
+  e = hp[4];
+  f = hp[5];
+  g = hp[6];
+  h = hp[7];
+  SHA256_ROUNDS8(0U, SHA256_WL);
+  SHA256_ROUNDS8(8U, SHA256_WL);
+  for (i = 1U; i < 4U; i++) {
+    kp += 16;
+    SHA256_ROUNDS8(0U, SHA256_WX);
+    SHA256_ROUNDS8(8U, SHA256_WX);
+  }
+  hp[0] += a;
+  hp[1] += b;
+  hp[2] += c;
+  hp[3] += d;
+  hp[4] += e;
+  hp[5] += f;
+  hp[6] += g;
+  hp[7] += h;
+}
+
+static void sha256_init(crysha256state_t *sp) {
+
+  memcpy(sp->h, sha256_h0, sizeof sp->h);
+  sp->length = 0U;
+}
+
+static void sha256_update(crysha256state_t *sp, size_t size,
+                          const uint8_t *in) {
+  size_t used = (size_t)(sp->length & 63U);
+
+  sp->length += (uint64_t)size;
+
+  /* Completing a partial block first.*/
+  if (used > 0U) {
+    size_t n = 64U - used;
+
+    if (size < n) {
+      memcpy(&sp->buf[used], in, size);
+      return;
+    }
+    memcpy(&sp->buf[used], in, n);
+    sha256_block(sp->h, sp->buf);
+    in   += n;
+    size -= n;
+  }
+
+  /* Full blocks are hashed directly from the input buffer.*/
+  while (size >= 64U) {
+    sha256_block(sp->h, in);
+    in   += 64;
+    size -= 64U;
+  }
+
+  memcpy(sp->buf, in, size);
+}
+
+static void sha256_final(crysha256state_t *sp, uint8_t *out) {
+  size_t used = (size_t)(sp->length & 63U);
+  unsigned i;
+
+  sp->buf[used++] = 0x80U;
+  if (used > 56U) {
+    memset(&sp->buf[used], 0, 64U - used);
+    sha256_block(sp->h, sp->buf);
+    used = 0U;
+  }
+  memset(&sp->buf[used], 0, 56U - used);
+  store_be64(&sp->buf[56], sp->length << 3);
+  sha256_block(sp->h, sp->buf);
+
+  for (i = 0U; i < 8U; i++) {
+    store_be32(out + (i * 4U), sp->h[i]);
+  }
+}
+#endif /* CRY_FALLBACK_NEEDS_SHA256 == TRUE */
+
+#if (CRY_FALLBACK_NEEDS_SHA512 == TRUE) || defined(__DOXYGEN__)
+#define SHA512_S0(x)        (ROR64(x, 28U) ^ ROR64(x, 34U) ^ ROR64(x, 39U))
+#define SHA512_S1(x)        (ROR64(x, 14U) ^ ROR64(x, 18U) ^ ROR64(x, 41U))
+#define SHA512_G0(x)        (ROR64(x, 1U) ^ ROR64(x, 8U) ^ ((x) >> 7))
+#define SHA512_G1(x)        (ROR64(x, 19U) ^ ROR64(x, 61U) ^ ((x) >> 6))
+
+#define SHA512_WL(i)        w[i]
+
+#define SHA512_WX(i)                                                        \
+  (w[i] += SHA512_G1(w[((i) + 14U) & 15U]) + w[((i) + 9U) & 15U] +          \
+           SHA512_G0(w[((i) + 1U) & 15U]))
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, k, wi) do {                    \
+  uint64_t t1 = (h) + SHA512_S1(e) + CH(e, f, g) + (k) + (wi);              \
+  (d) += t1;                                                                \
+  (h)  = t1 + SHA512_S0(a) + MAJ(a, b, c);                                  \
+} while (false)
+
+#define SHA512_ROUNDS8(i, W) do {                                           \
+  SHA512_ROUND(a, b, c, d, e, f, g, h, kp[(i) + 0U], W((i) + 0U));          \
+  SHA512_ROUND(h, a, b, c, d, e, f, g, kp[(i) + 1U], W((i) + 1U));          \
+  SHA512_ROUND(g, h, a, b, c, d, e, f, kp[(i) + 2U], W((i) + 2U));          \
+  SHA512_ROUND(f, g, h, a, b, c, d, e, kp[(i) + 3U], W((i) + 3U));          \
+  SHA512_ROUND(e, f, g, h, a, b, c, d, kp[(i) + 4U], W((i) + 4U));          \
+  SHA512_ROUND(d, e, f, g, h, a, b, c, kp[(i) + 5U], W((i) + 5U));          \
+  SHA512_ROUND(c, d, e, f, g, h, a, b, kp[(i) + 6U], W((i) + 6U));          \
+  SHA512_ROUND(b, c, d, e, f, g, h, a, kp[(i) + 7U], W((i) + 7U));          \
+} while (false)
+
+static void sha512_block(uint64_t *hp, const uint8_t *p) {
+  const uint64_t *kp = sha512_k;
+  uint64_t w[16];
+  uint64_t a, b, c, d, e, f, g, h;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = load_be64(p + (i * 8U));
+  }
+
+  a = hp[0];
+  b = hp[1];
+  c = hp[2];
+  d = hp[3];
+  e = hp[4];
+  f = hp[5];
+  g = hp[6];
+  h = hp[7];
+  SHA512_ROUNDS8(0U, SHA512_WL);
+  SHA512_ROUNDS8(8U, SHA512_WL);
+  for (i = 1U; i < 5U; i++) {
+    kp += 16;
+    SHA512_ROUNDS8(0U, SHA512_WX);
+    SHA512_ROUNDS8(8U, SHA512_WX);
+  }
+  hp[0] += a;
+  hp[1] += b;
+  hp[2] += c;
+  hp[3] += d;
+  hp[4] += e;
+  hp[5] += f;
+  hp[6] += g;
+  hp[7] += h;
+}
+
+static void sha512_init(crysha512state_t *sp) {
+
+  memcpy(sp->h, sha512_h0, sizeof sp->h);
+  sp->length = 0U;
+}
+
+static void sha512_update(crysha512state_t *sp, size_t size,
+                          const uint8_t *in) {
+  size_t used = (size_t)(sp->length & 127U);
+
+  sp->length += (uint64_t)size;
+
+  if (used > 0U) {
+    size_t n = 128U - used;
+
+    if (size < n) {
+      memcpy(&sp->buf[used], in, size);
+      return;
+    }
+    memcpy(&sp->buf[used], in, n);
+    sha512_block(sp->h, sp->buf);
+    in   += n;
+    size -= n;
+  }
+
+  while (size >= 128U) {
+    sha512_block(sp->h, in);
+    in   += 128;
+    size -= 128U;
+  }
+
+  memcpy(sp->buf, in, size);
+}
+
+static void sha512_final(crysha512state_t *sp, uint8_t *out) {
+  size_t used = (size_t)(sp->length & 127U);
+  unsigned i;
+
+  sp->buf[used++] = 0x80U;
+  if (used > 112U) {
+    memset(&sp->buf[used], 0, 128U - used);
+    sha512_block(sp->h, sp->buf);
+    used = 0U;
+  }
+
+  /* The length is limited to 2^61 bytes, the upper half of the 128 bits
+     length field is always zero.*/
+  memset(&sp->buf[used], 0, 120U - used);
+  store_be64(&sp->buf[120], sp->length << 3);
+  sha512_block(sp->h, sp->buf);
+
+  for (i = 0U; i < 8U; i++) {
+    store_be64(out + (i * 8U), sp->h[i]);
+  }
+}
+#endif /* CRY_FALLBACK_NEEDS_SHA512 == TRUE */
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+#if (CRY_FALLBACK_NEEDS_AES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   AES key loading.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_SIZE if the specified key size is invalid for
+ *                              the specified algorithm.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_aes_loadkey(CRYDriver *cryp,
+                                    size_t size,
+                                    const uint8_t *keyp) {
+  uint32_t *ek = cry_fallback_keys.aes_ek;
+  uint32_t *dk = cry_fallback_keys.aes_dk;
+  uint32_t nk, rounds, i, j, t, rcon;
+
+  (void)cryp;
+
+  if ((size != 16U) && (size != 24U) && (size != 32U)) {
+    return CRY_ERR_INV_KEY_SIZE;
+  }
+
+  /* Encryption key schedule.*/
+  nk     = (uint32_t)size / 4U;
+  rounds = nk + 6U;
+  for (i = 0U; i < nk; i++) {
+    ek[i] = load_be32(keyp + (i * 4U));
+  }
+  rcon = 1U;
+  for (i = nk; i < (4U * (rounds + 1U)); i++) {
+    t = ek[i - 1U];
+    if ((i % nk) == 0U) {
+      t = aes_subword(ROR32(t, 24U)) ^ (rcon << 24);
+      rcon = (rcon << 1) ^ ((rcon >> 7) * 0x11BU);
+    }
+    else if ((nk > 6U) && ((i % nk) == 4U)) {
+      t = aes_subword(t);
+    }
+    ek[i] = ek[i - nk] ^ t;
+  }
+
+  /* Decryption key schedule for the equivalent inverse cipher, round keys
+     in reverse order and inner round keys through InvMixColumns.*/
+  for (j = 0U; j < 4U; j++) {
+    dk[j] = ek[(4U * rounds) + j];
+    dk[(4U * rounds) + j] = ek[j];
+  }
+  for (i = 1U; i < rounds; i++) {
+    for (j = 0U; j < 4U; j++) {
+      dk[(4U * i) + j] = aes_invmixcolumn(ek[(4U * (rounds - i)) + j]);
+    }
+  }
+
+  cry_fallback_keys.aes_rounds = rounds;
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption of a single block using AES.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err == CRY_NOERROR) {
+    aes_encrypt_block(in, out);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption of a single block using AES.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err == CRY_NOERROR) {
+    aes_decrypt_block(in, out);
+  }
+
+  return err;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_ECB == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-ECB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  while (size > 0U) {
+    aes_encrypt_block(in, out);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-ECB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  while (size > 0U) {
+    aes_decrypt_block(in, out);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_CBC == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CBC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  while (size > 0U) {
+    xor_block(out, in, iv, 16U);
+    aes_encrypt_block(out, out);
+    iv    = out;
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-CBC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers, this number must be a
+ *                              multiple of 16
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t chain[16], block[16];
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  /* The ciphertext block is saved before decryption, the operation can
+     be done in place.*/
+  memcpy(chain, iv, 16U);
+  while (size > 0U) {
+    memcpy(block, in, 16U);
+    aes_decrypt_block(block, out);
+    xor_block(out, out, chain, 16U);
+    memcpy(chain, block, 16U);
+    in   += 16;
+    out  += 16;
+    size -= 16U;
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_CFB == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CFB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t ks[16];
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  aes_encrypt_block(iv, ks);
+  while (size > 0U) {
+    size_t n = size < 16U ? size : 16U;
+
+    xor_block(out, in, ks, n);
+    if (n == 16U) {
+      aes_encrypt_block(out, ks);
+    }
+    in   += n;
+    out  += n;
+    size -= n;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-CFB.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t ks[16], block[16];
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  aes_encrypt_block(iv, ks);
+  while (size > 0U) {
+    size_t n = size < 16U ? size : 16U;
+
+    memcpy(block, in, n);
+    xor_block(out, block, ks, n);
+    if (n == 16U) {
+      aes_encrypt_block(block, ks);
+    }
+    in   += n;
+    out  += n;
+    size -= n;
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_CTR == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-CTR.
+ * @note    The whole 128 bits counter block is incremented.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                128 bits input vector + counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  uint8_t ctr[16], ks[16];
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_check_key(key_id);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  memcpy(ctr, iv, 16U);
+  while (size > 0U) {
+    size_t n = size < 16U ? size : 16U;
+
+    aes_encrypt_block(ctr, ks);
+    xor_block(out, in, ks, n);
+    ctr_increment(ctr, 16U);
+    in   += n;
+    out  += n;
+    size -= n;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Decryption operation using AES-CTR.
+ * @note    The whole 128 bits counter block is incremented.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                128 bits input vector + counter
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  /* CTR decryption is the same operation.*/
+  return cry_fallback_encrypt_AES_CTR(cryp, key_id, size, in, out, iv);
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Encryption operation using AES-GCM.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] auth_size         size of the data buffer to be authenticated
+ * @param[in] auth_in           buffer containing the data to be authenticated
+ * @param[in] text_size         size of the text buffer
+ * @param[in] text_in           buffer containing the input plaintext
+ * @param[out] text_out         buffer for the output ciphertext
+ * @param[in] iv                128 bits initial counter block
+ * @param[in] tag_size          size of the authentication tag, this number
+ *                              must be between 1 and 16
+ * @param[out] tag_out          buffer for the generated authentication tag
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t auth_size,
+                                        const uint8_t *auth_in,
+                                        size_t text_size,
+                                        const uint8_t *text_in,
+                                        uint8_t *text_out,
+                                        const uint8_t *iv,
+                                        size_t tag_size,
+                                        uint8_t *tag_out) {
+  uint8_t tag[16];
+  cryerror_t err;
+
+  (void)cryp;
+
+  err = aes_gcm(key_id, false, auth_size, auth_in,
+                text_size, text_in, text_out, iv, tag);
+  if (err == CRY_NOERROR) {
+    memcpy(tag_out, tag, tag_size);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-GCM.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation, zero is
+ *                              the transient key, other values are keys stored
+ *                              in an unspecified way
+ * @param[in] auth_size         size of the data buffer to be authenticated
+ * @param[in] auth_in           buffer containing the data to be authenticated
+ * @param[in] text_size         size of the text buffer
+ * @param[in] text_in           buffer containing the input ciphertext
+ * @param[out] text_out         buffer for the output plaintext
+ * @param[in] iv                128 bits initial counter block
+ * @param[in] tag_size          size of the authentication tag, this number
+ *                              must be between 1 and 16
+ * @param[in] tag_in            buffer containing the authentication tag
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ * @retval CRY_ERR_AUTH_FAILED  authentication failed
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t auth_size,
+                                        const uint8_t *auth_in,
+                                        size_t text_size,
+                                        const uint8_t *text_in,
+                                        uint8_t *text_out,
+                                        const uint8_t *iv,
+                                        size_t tag_size,
+                                        const uint8_t *tag_in) {
+  uint8_t tag[16], diff;
+  cryerror_t err;
+  size_t i;
+
+  (void)cryp;
+
+  err = aes_gcm(key_id, true, auth_size, auth_in,
+                text_size, text_in, text_out, iv, tag);
+  if (err != CRY_NOERROR) {
+    return err;
+  }
+
+  /* Constant time tag comparison.*/
+  diff = 0U;
+  for (i = 0U; i < tag_size; i++) {
+    diff |= tag[i] ^ tag_in[i];
+  }
+  if (diff != 0U) {
+    return CRY_ERR_AUTH_FAILED;
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+/**
+ * @brief   DES key loading.
+ * @note    There is no DES fallback, DES is only available when provided
+ *          by the LLD.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the algorithm is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_des_loadkey(CRYDriver *cryp,
+                                    size_t size,
+                                    const uint8_t *keyp) {
+
+  (void)cryp;
+  (void)size;
+  (void)keyp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Encryption of a single block using (T)DES.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption of a single block using (T)DES.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Encryption operation using (T)DES-ECB.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-ECB.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Encryption operation using (T)DES-CBC.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input plaintext
+ * @param[out] out              buffer for the output ciphertext
+ * @param[in] iv                64 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-CBC.
+ * @note    There is no DES fallback.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] key_id            the key to be used for the operation
+ * @param[in] size              size of both buffers
+ * @param[in] in                buffer containing the input ciphertext
+ * @param[out] out              buffer for the output plaintext
+ * @param[in] iv                64 bits input vector
+ * @return                      The operation status.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  (void)cryp;
+  (void)key_id;
+  (void)size;
+  (void)in;
+  (void)out;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha1ctxp         pointer to a SHA1 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp) {
+
+  (void)cryp;
+
+  sha1ctxp->h[0]   = 0x67452301U;
+  sha1ctxp->h[1]   = 0xEFCDAB89U;
+  sha1ctxp->h[2]   = 0x98BADCFEU;
+  sha1ctxp->h[3]   = 0x10325476U;
+  sha1ctxp->h[4]   = 0xC3D2E1F0U;
+  sha1ctxp->length = 0U;
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp          pointer to a SHA1 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                    size_t size, const uint8_t *in) {
+  size_t used = (size_t)(sha1ctxp->length & 63U);
+
+  (void)cryp;
+
+  sha1ctxp->length += (uint64_t)size;
+  if (used > 0U) {
+    size_t n = 64U - used;
+
+    if (size < n) {
+      memcpy(&sha1ctxp->buf[used], in, size);
+      return CRY_NOERROR;
+    }
+    memcpy(&sha1ctxp->buf[used], in, n);
+    sha1_block(sha1ctxp->h, sha1ctxp->buf);
+    in   += n;
+    size -= n;
+  }
+  while (size >= 64U) {
+    sha1_block(sha1ctxp->h, in);
+    in   += 64;
+    size -= 64U;
+  }
+  memcpy(sha1ctxp->buf, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp          pointer to a SHA1 context
+ * @param[out] out              160 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                   uint8_t *out) {
+  size_t used = (size_t)(sha1ctxp->length & 63U);
+  unsigned i;
+
+  (void)cryp;
+
+  sha1ctxp->buf[used++] = 0x80U;
+  if (used > 56U) {
+    memset(&sha1ctxp->buf[used], 0, 64U - used);
+    sha1_block(sha1ctxp->h, sha1ctxp->buf);
+    used = 0U;
+  }
+  memset(&sha1ctxp->buf[used], 0, 56U - used);
+  store_be64(&sha1ctxp->buf[56], sha1ctxp->length << 3);
+  sha1_block(sha1ctxp->h, sha1ctxp->buf);
+
+  for (i = 0U; i < 5U; i++) {
+    store_be32(out + (i * 4U), sha1ctxp->h[i]);
+  }
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha256ctxp       pointer to a SHA256 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_init(CRYDriver *cryp,
+                                    SHA256Context *sha256ctxp) {
+
+  (void)cryp;
+
+  sha256_init(sha256ctxp);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp        pointer to a SHA256 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_update(CRYDriver *cryp,
+                                      SHA256Context *sha256ctxp,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha256_update(sha256ctxp, size, in);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp        pointer to a SHA256 context
+ * @param[out] out              256 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_final(CRYDriver *cryp,
+                                     SHA256Context *sha256ctxp,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha256_final(sha256ctxp, out);
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] sha512ctxp       pointer to a SHA512 context to be initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_init(CRYDriver *cryp,
+                                    SHA512Context *sha512ctxp) {
+
+  (void)cryp;
+
+  sha512_init(sha512ctxp);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp        pointer to a SHA512 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_update(CRYDriver *cryp,
+                                      SHA512Context *sha512ctxp,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha512_update(sha512ctxp, size, in);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp        pointer to a SHA512 context
+ * @param[out] out              512 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_final(CRYDriver *cryp,
+                                     SHA512Context *sha512ctxp,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha512_final(sha512ctxp, out);
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_FALLBACK_NEEDS_HMAC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   HMAC key loading.
+ * @details Keys longer than the hash block size are hashed first, the
+ *          keys are stored padded to the block size of each algorithm.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] size              key size in bytes
+ * @param[in] keyp              pointer to the key data
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_hmac_loadkey(CRYDriver *cryp,
+                                     size_t size,
+                                     const uint8_t *keyp) {
+
+  (void)cryp;
+
+#if CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE
+  memset(cry_fallback_keys.hmac256_key, 0,
+         sizeof cry_fallback_keys.hmac256_key);
+  if (size > sizeof cry_fallback_keys.hmac256_key) {
+    crysha256state_t sha;
+
+    sha256_init(&sha);
+    sha256_update(&sha, size, keyp);
+    sha256_final(&sha, cry_fallback_keys.hmac256_key);
+  }
+  else {
+    memcpy(cry_fallback_keys.hmac256_key, keyp, size);
+  }
+#endif
+#if CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE
+  memset(cry_fallback_keys.hmac512_key, 0,
+         sizeof cry_fallback_keys.hmac512_key);
+  if (size > sizeof cry_fallback_keys.hmac512_key) {
+    crysha512state_t sha;
+
+    sha512_init(&sha);
+    sha512_update(&sha, size, keyp);
+    sha512_final(&sha, cry_fallback_keys.hmac512_key);
+  }
+  else {
+    memcpy(cry_fallback_keys.hmac512_key, keyp, size);
+  }
+#endif
+  cry_fallback_keys.hmac_loaded = true;
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using HMAC_SHA256.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] hmacsha256ctxp   pointer to a HMAC_SHA256 context to be
+ *                              initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if no HMAC key has been loaded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_init(CRYDriver *cryp,
+                                        HMACSHA256Context *hmacsha256ctxp) {
+  uint8_t pad[64];
+  unsigned i;
+
+  (void)cryp;
+
+  if (!cry_fallback_keys.hmac_loaded) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  for (i = 0U; i < 64U; i++) {
+    pad[i] = cry_fallback_keys.hmac256_key[i] ^ 0x36U;
+  }
+  sha256_init(&hmacsha256ctxp->inner);
+  sha256_update(&hmacsha256ctxp->inner, 64U, pad);
+
+  for (i = 0U; i < 64U; i++) {
+    pad[i] = cry_fallback_keys.hmac256_key[i] ^ 0x5CU;
+  }
+  sha256_init(&hmacsha256ctxp->outer);
+  sha256_update(&hmacsha256ctxp->outer, 64U, pad);
+
+  memset(pad, 0, sizeof pad);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha256ctxp    pointer to a HMAC_SHA256 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_update(CRYDriver *cryp,
+                                          HMACSHA256Context *hmacsha256ctxp,
+                                          size_t size,
+                                          const uint8_t *in) {
+
+  (void)cryp;
+
+  sha256_update(&hmacsha256ctxp->inner, size, in);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha256ctxp    pointer to a HMAC_SHA256 context
+ * @param[out] out              256 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA256_final(CRYDriver *cryp,
+                                         HMACSHA256Context *hmacsha256ctxp,
+                                         uint8_t *out) {
+  uint8_t digest[32];
+
+  (void)cryp;
+
+  sha256_final(&hmacsha256ctxp->inner, digest);
+  sha256_update(&hmacsha256ctxp->outer, sizeof digest, digest);
+  sha256_final(&hmacsha256ctxp->outer, out);
+
+  return CRY_NOERROR;
+}
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Hash initialization using HMAC_SHA512.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[out] hmacsha512ctxp   pointer to a HMAC_SHA512 context to be
+ *                              initialized
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_ID   if no HMAC key has been loaded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_init(CRYDriver *cryp,
+                                        HMACSHA512Context *hmacsha512ctxp) {
+  uint8_t pad[128];
+  unsigned i;
+
+  (void)cryp;
+
+  if (!cry_fallback_keys.hmac_loaded) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  for (i = 0U; i < 128U; i++) {
+    pad[i] = cry_fallback_keys.hmac512_key[i] ^ 0x36U;
+  }
+  sha512_init(&hmacsha512ctxp->inner);
+  sha512_update(&hmacsha512ctxp->inner, 128U, pad);
+
+  for (i = 0U; i < 128U; i++) {
+    pad[i] = cry_fallback_keys.hmac512_key[i] ^ 0x5CU;
+  }
+  sha512_init(&hmacsha512ctxp->outer);
+  sha512_update(&hmacsha512ctxp->outer, 128U, pad);
+
+  memset(pad, 0, sizeof pad);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha512ctxp    pointer to a HMAC_SHA512 context
+ * @param[in] size              size of input buffer
+ * @param[in] in                buffer containing the input text
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_update(CRYDriver *cryp,
+                                          HMACSHA512Context *hmacsha512ctxp,
+                                          size_t size,
+                                          const uint8_t *in) {
+
+  (void)cryp;
+
+  sha512_update(&hmacsha512ctxp->inner, size, in);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using HMAC.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hmacsha512ctxp    pointer to a HMAC_SHA512 context
+ * @param[out] out              512 bits output buffer
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_HMACSHA512_final(CRYDriver *cryp,
+                                         HMACSHA512Context *hmacsha512ctxp,
+                                         uint8_t *out) {
+  uint8_t digest[64];
+
+  (void)cryp;
+
+  sha512_final(&hmacsha512ctxp->inner, digest);
+  sha512_update(&hmacsha512ctxp->outer, sizeof digest, digest);
+  sha512_final(&hmacsha512ctxp->outer, out);
+
+  return CRY_NOERROR;
+}
+#endif
+
+#endif /* (HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE) */
+
+/** @} */
@@ -71,6 +71,7 @@ I2CDriver I2CD4;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if !SW_I2C_USE_GPT
 static msg_t i2c_write_stop(I2CDriver *i2cp);
 
 static inline void i2c_delay(I2CDriver *i2cp) {
@@ -271,10 +272,301 @@ static msg_t i2c_write_header(I2CDriver *i2cp, i2caddr_t addr, bool rw) {
   return MSG_OK;
 }
 
+#else /* SW_I2C_USE_GPT */
+
+static void i2c_gpt_end(I2CDriver *i2cp, msg_t msg) {
+
+  osalSysLockFromISR();
+  gptStopTimerI(i2cp->config->gptp);
+  osalThreadResumeI(&i2cp->thread, msg);
+  osalSysUnlockFromISR();
+}
+
+static void i2c_gpt_arbitration_lost(I2CDriver *i2cp) {
+
+  /* The bus is no more owned, it is not driven further.*/
+  i2cp->errors |= I2C_ARBITRATION_LOST;
+  i2c_gpt_end(i2cp, MSG_RESET);
+}
+
+static void i2c_gpt_next(I2CDriver *i2cp) {
+
+  i2cp->bit  = 0U;
+  i2cp->step = 0U;
+
+  switch (i2cp->phase) {
+  case SW_I2C_HEADER:
+    if (i2cp->hdri < i2cp->hdrn) {
+      i2cp->byte = i2cp->hdr[i2cp->hdri++];
+      return;
+    }
+    if (i2cp->rd) {
+      i2cp->phase = SW_I2C_RX;
+      i2cp->byte  = 0U;
+      return;
+    }
+    i2cp->phase = SW_I2C_TX;
+    /* Falls through.*/
+  case SW_I2C_TX:
+    if (i2cp->txbytes > 0U) {
+      i2cp->byte = *i2cp->txbuf++;
+      i2cp->txbytes--;
+      return;
+    }
+    i2cp->phase = i2cp->rxbytes > 0U ? SW_I2C_RESTART : SW_I2C_STOP;
+    return;
+  case SW_I2C_RX:
+    if (i2cp->rxbytes > 0U) {
+      i2cp->byte = 0U;
+      return;
+    }
+    i2cp->phase = SW_I2C_STOP;
+    return;
+  default:
+    return;
+  }
+}
+
+static void i2c_gpt_header(I2CDriver *i2cp, bool rd) {
+  uint8_t mode = rd ? 1U : 0U;
+
+  /* Check for 10 bits addressing.*/
+  if (i2cp->config->addr10) {
+    i2cp->hdr[0] = (uint8_t)(0xF0U | ((i2cp->addr >> 8U) << 1U) | mode);
+    i2cp->hdr[1] = (uint8_t)(i2cp->addr & 255U);
+    i2cp->hdrn   = 2U;
+  }
+  else {
+    i2cp->hdr[0] = (uint8_t)((i2cp->addr << 1U) | mode);
+    i2cp->hdrn   = 1U;
+  }
+  i2cp->hdri  = 0U;
+  i2cp->rd    = rd;
+  i2cp->phase = SW_I2C_HEADER;
+  i2c_gpt_next(i2cp);
+}
+
+static void i2c_gpt_bit(I2CDriver *i2cp) {
+  const I2CConfig *cfg = i2cp->config;
+  bool out;
+  unsigned level;
+  unsigned sda;
+
+  /* Data bits are driven when transmitting, the acknowledge bit when
+     receiving, else the line is released.*/
+  out = (i2cp->phase == SW_I2C_RX) == (i2cp->bit >= 8U);
+  level = PAL_HIGH;
+  if (out) {
+    if (i2cp->bit < 8U) {
+      level = ((unsigned)i2cp->byte >> (7U - i2cp->bit)) & 1U;
+    }
+    else if (i2cp->rxbytes > 1U) {
+      /* ACK, the last byte is NACKed.*/
+      level = PAL_LOW;
+    }
+  }
+
+  switch (i2cp->step) {
+  case 0U:
+    palWriteLine(cfg->sda, level);
+    i2cp->step = 1U;
+    return;
+  case 1U:
+    palSetLine(cfg->scl);
+    i2cp->step = 2U;
+    return;
+  default:
+    /* Clock stretching.*/
+    if (palReadLine(cfg->scl) == PAL_LOW) {
+      return;
+    }
+    sda = (unsigned)palReadLine(cfg->sda);
+    palClearLine(cfg->scl);
+    i2cp->step = 0U;
+    break;
+  }
+
+  /* Arbitration check.*/
+  if (out && (level == PAL_HIGH) && (sda == PAL_LOW)) {
+    i2c_gpt_arbitration_lost(i2cp);
+    return;
+  }
+
+  if (i2cp->bit < 8U) {
+    if (!out) {
+      i2cp->byte = (uint8_t)((i2cp->byte << 1U) | sda);
+    }
+    i2cp->bit++;
+    return;
+  }
+
+  /* Acknowledge bit done.*/
+  if (i2cp->phase == SW_I2C_RX) {
+    *i2cp->rxbuf++ = i2cp->byte;
+    i2cp->rxbytes--;
+  }
+  else if (sda == PAL_HIGH) {
+    /* NACK, the transfer is terminated with a stop condition.*/
+    i2cp->errors |= I2C_ACK_FAILURE;
+    i2cp->result = MSG_RESET;
+    i2cp->phase  = SW_I2C_STOP;
+    return;
+  }
+
+  i2c_gpt_next(i2cp);
+}
+
+static void i2c_gpt_step(I2CDriver *i2cp) {
+  const I2CConfig *cfg = i2cp->config;
+
+  switch (i2cp->phase) {
+  case SW_I2C_START:
+    if (i2cp->step == 0U) {
+      /* Arbitration check.*/
+      if (palReadLine(cfg->sda) == PAL_LOW) {
+        i2c_gpt_arbitration_lost(i2cp);
+        return;
+      }
+      palClearLine(cfg->sda);
+      i2cp->step = 1U;
+    }
+    else {
+      palClearLine(cfg->scl);
+      i2c_gpt_header(i2cp, i2cp->txbytes == 0U);
+    }
+    break;
+  case SW_I2C_RESTART:
+    switch (i2cp->step) {
+    case 0U:
+      palSetLine(cfg->sda);
+      i2cp->step = 1U;
+      break;
+    case 1U:
+      palSetLine(cfg->scl);
+      i2cp->step = 2U;
+      break;
+    case 2U:
+      /* Clock stretching.*/
+      if (palReadLine(cfg->scl) == PAL_HIGH) {
+        i2cp->step = 3U;
+      }
+      break;
+    case 3U:
+      /* Arbitration check.*/
+      if (palReadLine(cfg->sda) == PAL_LOW) {
+        i2c_gpt_arbitration_lost(i2cp);
+        return;
+      }
+      palClearLine(cfg->sda);
+      i2cp->step = 4U;
+      break;
+    default:
+      palClearLine(cfg->scl);
+      i2c_gpt_header(i2cp, true);
+      break;
+    }
+    break;
+  case SW_I2C_STOP:
+    switch (i2cp->step) {
+    case 0U:
+      palClearLine(cfg->sda);
+      i2cp->step = 1U;
+      break;
+    case 1U:
+      palSetLine(cfg->scl);
+      i2cp->step = 2U;
+      break;
+    case 2U:
+      /* Clock stretching.*/
+      if (palReadLine(cfg->scl) == PAL_HIGH) {
+        i2cp->step = 3U;
+      }
+      break;
+    case 3U:
+      palSetLine(cfg->sda);
+      i2cp->step = 4U;
+      break;
+    default:
+      /* Arbitration check.*/
+      if (palReadLine(cfg->sda) == PAL_LOW) {
+        i2cp->errors |= I2C_ARBITRATION_LOST;
+        i2cp->result = MSG_RESET;
+      }
+      i2c_gpt_end(i2cp, i2cp->result);
+      break;
+    }
+    break;
+  default:
+    i2c_gpt_bit(i2cp);
+    break;
+  }
+}
+
+static msg_t i2c_gpt_transfer(I2CDriver *i2cp, i2caddr_t addr,
+                              const uint8_t *txbuf, size_t txbytes,
+                              uint8_t *rxbuf, size_t rxbytes,
+                              sysinterval_t timeout) {
+  msg_t msg;
+
+  i2cp->addr    = addr;
+  i2cp->txbuf   = txbuf;
+  i2cp->txbytes = txbytes;
+  i2cp->rxbuf   = rxbuf;
+  i2cp->rxbytes = rxbytes;
+  i2cp->result  = MSG_OK;
+  i2cp->phase   = SW_I2C_START;
+  i2cp->step    = 0U;
+
+  /* The whole transfer is performed by the GPT callback.*/
+  gptStartContinuousI(i2cp->config->gptp, i2cp->config->interval);
+  msg = osalThreadSuspendTimeoutS(&i2cp->thread, timeout);
+  if (msg == MSG_TIMEOUT) {
+    gptStopTimerI(i2cp->config->gptp);
+  }
+
+  return msg;
+}
+#endif /* SW_I2C_USE_GPT */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if SW_I2C_USE_GPT || defined(__DOXYGEN__)
+/**
+ * @brief   GPT callback for the I2C drivers in GPT mode.
+ * @details Each invocation advances by one step the transfer of the I2C
+ *          driver using the GPT unit.
+ *
+ * @param[in] gptp      pointer to the @p GPTDriver object
+ *
+ * @isr
+ */
+void i2c_lld_serve_gpt_interrupt(GPTDriver *gptp) {
+
+#if SW_I2C_USE_I2C1
+  if ((I2CD1.thread != NULL) && (I2CD1.config->gptp == gptp)) {
+    i2c_gpt_step(&I2CD1);
+  }
+#endif
+#if SW_I2C_USE_I2C2
+  if ((I2CD2.thread != NULL) && (I2CD2.config->gptp == gptp)) {
+    i2c_gpt_step(&I2CD2);
+  }
+#endif
+#if SW_I2C_USE_I2C3
+  if ((I2CD3.thread != NULL) && (I2CD3.config->gptp == gptp)) {
+    i2c_gpt_step(&I2CD3);
+  }
+#endif
+#if SW_I2C_USE_I2C4
+  if ((I2CD4.thread != NULL) && (I2CD4.config->gptp == gptp)) {
+    i2c_gpt_step(&I2CD4);
+  }
+#endif
+}
+#endif /* SW_I2C_USE_GPT */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -309,8 +601,14 @@ void i2c_lld_init(void) {
  */
 void i2c_lld_start(I2CDriver *i2cp) {
 
+#if SW_I2C_USE_GPT
+  osalDbgAssert(i2cp->config->gptp->state == GPT_READY, "GPT not ready");
+
+  i2cp->thread = NULL;
+#else
   /* Does nothing.*/
   (void)i2cp;
+#endif
 }
 
 /**
@@ -351,6 +649,9 @@ msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
                                      uint8_t *rxbuf, size_t rxbytes,
                                      sysinterval_t timeout) {
 
+#if SW_I2C_USE_GPT
+  return i2c_gpt_transfer(i2cp, addr, NULL, 0U, rxbuf, rxbytes, timeout);
+#else
   /* Setting timeout fields.*/
   i2cp->start = osalOsGetSystemTimeX();
   i2cp->end = i2cp->start;
@@ -371,6 +672,7 @@ msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
   } while (--rxbytes);
 
   return i2c_write_stop(i2cp);
+#endif
 }
 
 /**
@@ -403,6 +705,10 @@ msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
                                       uint8_t *rxbuf, size_t rxbytes,
                                       sysinterval_t timeout) {
 
+#if SW_I2C_USE_GPT
+  return i2c_gpt_transfer(i2cp, addr, txbuf, txbytes, rxbuf, rxbytes,
+                          timeout);
+#else
   /* Setting timeout fields.*/
   i2cp->start = osalOsGetSystemTimeX();
   i2cp->end = i2cp->start;
@@ -429,7 +735,7 @@ msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
     CHECK_ERROR(i2c_write_header(i2cp, addr, true));
 
     do {
-      /* Last byte sends a NACK.*/
+      /* ACK, the last byte is NACKed.*/
       msg_t msg = i2c_read_byte(i2cp, rxbytes > 1U ? 0U : 1U);
       CHECK_ERROR(msg);
       *rxbuf++ = (uint8_t)msg;
@@ -437,6 +743,7 @@ msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
   }
 
   return i2c_write_stop(i2cp);
+#endif
 }
 
 #endif /* HAL_USE_I2C */
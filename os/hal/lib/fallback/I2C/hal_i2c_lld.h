@@ -49,6 +49,21 @@
 #define SW_I2C_USE_OSAL_DELAY               TRUE
 #endif
 
+/**
+ * @brief   Use a GPT unit for pacing the bus.
+ * @details If set to @p TRUE then the bus lines are driven by a state
+ *          machine advanced by a GPT callback, one line transition each
+ *          timer period, the calling thread is suspended for the whole
+ *          transfer instead of polling and delaying.
+ * @note    The GPT unit must be started by the application before the
+ *          I2C driver, the GPT configuration callback must be
+ *          @p i2c_lld_serve_gpt_interrupt().
+ * @note    The default is @p FALSE.
+ */
+#if !defined(SW_I2C_USE_GPT) || defined(__DOXYGEN__)
+#define SW_I2C_USE_GPT                      FALSE
+#endif
+
 /**
  * @brief   I2C1 driver enable switch.
  * @details If set to @p TRUE the support for I2C1 is included.
@@ -90,6 +105,10 @@
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if SW_I2C_USE_GPT && !HAL_USE_GPT
+#error "SW I2C GPT mode requires HAL_USE_GPT"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -109,6 +128,20 @@ typedef uint8_t i2cflags_t;
  */
 typedef void (*i2c_delay_t)(void);
 
+#if SW_I2C_USE_GPT || defined(__DOXYGEN__)
+/**
+ * @brief   GPT mode transfer phases.
+ */
+typedef enum {
+  SW_I2C_START = 0,                 /**< Start condition.                   */
+  SW_I2C_HEADER = 1,                /**< Address and mode bytes.            */
+  SW_I2C_TX = 2,                    /**< Transmitting data bytes.           */
+  SW_I2C_RESTART = 3,               /**< Restart condition.                 */
+  SW_I2C_RX = 4,                    /**< Receiving data bytes.              */
+  SW_I2C_STOP = 5                   /**< Stop condition.                    */
+} sw_i2c_phase_t;
+#endif
+
 /**
  * @brief   Type of I2C driver configuration structure.
  */
@@ -125,6 +158,18 @@ typedef struct {
    * @brief   I2C data line.
    */
   ioline_t                  sda;
+#if SW_I2C_USE_GPT || defined(__DOXYGEN__)
+  /**
+   * @brief   GPT unit pacing the bus.
+   * @note    The unit can be shared by multiple I2C drivers.
+   */
+  GPTDriver                 *gptp;
+  /**
+   * @brief   Interval between bus line transitions in GPT ticks.
+   * @note    A bit takes three intervals.
+   */
+  gptcnt_t                  interval;
+#endif
 #if SW_I2C_USE_OSAL_DELAY || defined(__DOXYGEN__)
   /**
    * @brief   Delay of an half bit time in system ticks.
@@ -174,6 +219,68 @@ struct I2CDriver {
    * @brief   Time of operation timeout.
    */
   systime_t                 end;
+#if SW_I2C_USE_GPT || defined(__DOXYGEN__)
+  /**
+   * @brief   Waiting thread.
+   */
+  thread_reference_t        thread;
+  /**
+   * @brief   Transfer result.
+   */
+  msg_t                     result;
+  /**
+   * @brief   Current transfer phase.
+   */
+  sw_i2c_phase_t            phase;
+  /**
+   * @brief   Step within the current phase or bit.
+   */
+  uint8_t                   step;
+  /**
+   * @brief   Current bit, eight is the acknowledge bit.
+   */
+  uint8_t                   bit;
+  /**
+   * @brief   Byte being transmitted or received.
+   */
+  uint8_t                   byte;
+  /**
+   * @brief   Read mode header.
+   */
+  bool                      rd;
+  /**
+   * @brief   Header bytes.
+   */
+  uint8_t                   hdr[2];
+  /**
+   * @brief   Number of header bytes.
+   */
+  uint8_t                   hdrn;
+  /**
+   * @brief   Next header byte.
+   */
+  uint8_t                   hdri;
+  /**
+   * @brief   Slave address.
+   */
+  i2caddr_t                 addr;
+  /**
+   * @brief   Pointer to the next byte to be transmitted.
+   */
+  const uint8_t             *txbuf;
+  /**
+   * @brief   Bytes still to be transmitted.
+   */
+  size_t                    txbytes;
+  /**
+   * @brief   Pointer to the next byte to be received.
+   */
+  uint8_t                   *rxbuf;
+  /**
+   * @brief   Bytes still to be received.
+   */
+  size_t                    rxbytes;
+#endif
 };
 
 /*===========================================================================*/
@@ -221,6 +328,9 @@ extern "C" {
   msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
                                        uint8_t *rxbuf, size_t rxbytes,
                                        sysinterval_t timeout);
+#if SW_I2C_USE_GPT
+  void i2c_lld_serve_gpt_interrupt(GPTDriver *gptp);
+#endif
 #ifdef __cplusplus
 }
 #endif
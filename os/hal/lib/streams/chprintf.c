@@ -28,13 +28,84 @@
  * @{
  */
 
+#include <limits.h>
+
 #include "hal.h"
 #include "chprintf.h"
 #include "memstreams.h"
 
-#define MAX_FILLER 11
+#define MAX_FILLER ((sizeof (long) * 8U + 2U) / 3U)
 #define FLOAT_PRECISION 9
 
+/**
+ * @brief   Type of the formatted output buffer.
+ */
+typedef struct {
+  BaseSequentialStream  *chp;
+  size_t                n;
+#if CHPRINTF_BUFFER_SIZE > 0
+  uint8_t               buf[CHPRINTF_BUFFER_SIZE];
+#endif
+} chp_output_t;
+
+/**
+ * @brief   Powers of ten used by the decimal conversion.
+ */
+static const unsigned long dec_pow[] = {
+#if ULONG_MAX > 0xFFFFFFFFUL
+  10000000000000000000UL, 1000000000000000000UL, 100000000000000000UL,
+  10000000000000000UL, 1000000000000000UL, 100000000000000UL,
+  10000000000000UL, 1000000000000UL, 100000000000UL, 10000000000UL,
+#endif
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL,
+  1000UL, 100UL, 10UL
+};
+
+static void out_flush(chp_output_t *op) {
+
+#if CHPRINTF_BUFFER_SIZE > 0
+  if (op->n > 0U) {
+    (void) streamWrite(op->chp, op->buf, op->n);
+    op->n = 0U;
+  }
+#else
+  (void)op;
+#endif
+}
+
+static void out_put(chp_output_t *op, char c) {
+
+#if CHPRINTF_BUFFER_SIZE > 0
+  op->buf[op->n++] = (uint8_t)c;
+  if (op->n >= (size_t)CHPRINTF_BUFFER_SIZE) {
+    out_flush(op);
+  }
+#else
+  (void) streamPut(op->chp, (uint8_t)c);
+#endif
+}
+
+static void out_write(chp_output_t *op, const char *s, size_t n) {
+
+#if CHPRINTF_BUFFER_SIZE > 0
+  /* Large blocks bypass the buffer.*/
+  if (n >= (size_t)CHPRINTF_BUFFER_SIZE) {
+    out_flush(op);
+    (void) streamWrite(op->chp, (const uint8_t *)s, n);
+    return;
+  }
+  while (n > 0U) {
+    out_put(op, *s++);
+    n--;
+  }
+#else
+  if (n > 0U) {
+    (void) streamWrite(op->chp, (const uint8_t *)s, n);
+  }
+#endif
+}
+
+#if CHPRINTF_USE_FLOAT
 static char *long_to_string_with_divisor(char *p,
                                          long num,
                                          unsigned radix,
@@ -68,10 +139,50 @@ static char *long_to_string_with_divisor(char *p,
 
   return p;
 }
+#endif
+
+/*
+ * Integer conversion without divisions, decimal digits are obtained by
+ * subtracting powers of ten, octal and hexadecimal digits by shifting.
+ * This matters on cores without a hardware divider.
+ */
+static char *ch_ultoa(char *p, unsigned long num, unsigned radix) {
+  unsigned shift, d, i;
+  unsigned long t;
+  bool started;
+  char *q;
 
-static char *ch_ltoa(char *p, long num, unsigned radix) {
+  if (radix == 10U) {
+    started = false;
+    for (i = 0U; i < sizeof dec_pow / sizeof dec_pow[0]; i++) {
+      d = 0U;
+      while (num >= dec_pow[i]) {
+        num -= dec_pow[i];
+        d++;
+      }
+      if (started || (d > 0U)) {
+        *p++ = (char)('0' + d);
+        started = true;
+      }
+    }
+    *p++ = (char)('0' + num);
+    return p;
+  }
 
-  return long_to_string_with_divisor(p, num, radix, 0);
+  shift = (radix == 16U) ? 4U : 3U;
+  i = 1U;
+  for (t = num >> shift; t != 0U; t >>= shift) {
+    i++;
+  }
+  p += i;
+  q = p;
+  do {
+    d = (unsigned)(num & (radix - 1U));
+    *--q = (char)((d < 10U) ? ('0' + d) : ('A' + d - 10U));
+    num >>= shift;
+  } while (--i > 0U);
+
+  return p;
 }
 
 #if CHPRINTF_USE_FLOAT
@@ -96,34 +207,9 @@ static char *ftoa(char *p, double num, unsigned long precision) {
 }
 #endif
 
-/**
- * @brief   System formatted output function.
- * @details This function implements a minimal @p vprintf()-like functionality
- *          with output on a @p BaseSequentialStream.
- *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
- *          The following parameter types (p) are supported:
- *          - <b>x</b> hexadecimal integer.
- *          - <b>X</b> hexadecimal long.
- *          - <b>o</b> octal integer.
- *          - <b>O</b> octal long.
- *          - <b>d</b> decimal signed integer.
- *          - <b>D</b> decimal signed long.
- *          - <b>u</b> decimal unsigned integer.
- *          - <b>U</b> decimal unsigned long.
- *          - <b>c</b> character.
- *          - <b>s</b> string.
- *          .
- *
- * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
- * @param[in] fmt       formatting string
- * @param[in] ap        list of parameters
- * @return              The number of bytes that would have been
- *                      written to @p chp if no stream error occurs
- *
- * @api
- */
-int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+static int chp_format(chp_output_t *op, const char *fmt, va_list ap) {
   char *p, *s, c, filler;
+  const char *t;
   int i, precision, width;
   int n = 0;
   bool is_long, left_align, do_sign;
@@ -142,11 +228,16 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
     }
     
     if (c != '%') {
-      streamPut(chp, (uint8_t)c);
-      n++;
+      /* Literal text is output as a single block.*/
+      t = fmt - 1;
+      while ((*fmt != 0) && (*fmt != '%')) {
+        fmt++;
+      }
+      out_write(op, t, (size_t)(fmt - t));
+      n += (int)(fmt - t);
       continue;
     }
-    
+
     p = tmpbuf;
     s = tmpbuf;
 
@@ -264,7 +355,7 @@ int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
         if (do_sign) {
           *p++ = '+';
         }
-      p = ch_ltoa(p, l, 10);
+      p = ch_ultoa(p, (unsigned long)l, 10);
       break;
 #if CHPRINTF_USE_FLOAT
     case 'f':
@@ -301,7 +392,7 @@ unsigned_common:
       else {
         l = va_arg(ap, unsigned int);
       }
-      p = ch_ltoa(p, l, c);
+      p = ch_ultoa(p, (unsigned long)l, (unsigned)c);
       break;
     default:
       *p++ = c;
@@ -316,28 +407,68 @@ unsigned_common:
     }
     if (width < 0) {
       if (*s == '-' && filler == '0') {
-        streamPut(chp, (uint8_t)*s++);
+        out_put(op, *s++);
         n++;
         i--;
       }
       do {
-        streamPut(chp, (uint8_t)filler);
+        out_put(op, filler);
         n++;
       } while (++width != 0);
     }
-    while (--i >= 0) {
-      streamPut(chp, (uint8_t)*s++);
-      n++;
-    }
+    out_write(op, s, (size_t)i);
+    n += i;
 
     while (width) {
-      streamPut(chp, (uint8_t)filler);
+      out_put(op, filler);
       n++;
       width--;
     }
   }
 }
 
+/**
+ * @brief   System formatted output function.
+ * @details This function implements a minimal @p vprintf()-like functionality
+ *          with output on a @p BaseSequentialStream.
+ *          The general parameters format is: %[-][width|*][.precision|*][l|L]p.
+ *          The following parameter types (p) are supported:
+ *          - <b>x</b> hexadecimal integer.
+ *          - <b>X</b> hexadecimal long.
+ *          - <b>o</b> octal integer.
+ *          - <b>O</b> octal long.
+ *          - <b>d</b> decimal signed integer.
+ *          - <b>D</b> decimal signed long.
+ *          - <b>u</b> decimal unsigned integer.
+ *          - <b>U</b> decimal unsigned long.
+ *          - <b>c</b> character.
+ *          - <b>s</b> string.
+ *          .
+ * @note    The output is collected in a local buffer of
+ *          @p CHPRINTF_BUFFER_SIZE bytes and written to the stream using
+ *          @p streamWrite(), the stream is written when the buffer is full
+ *          and before returning.
+ *
+ * @param[in] chp       pointer to a @p BaseSequentialStream implementing object
+ * @param[in] fmt       formatting string
+ * @param[in] ap        list of parameters
+ * @return              The number of bytes that would have been
+ *                      written to @p chp if no stream error occurs
+ *
+ * @api
+ */
+int chvprintf(BaseSequentialStream *chp, const char *fmt, va_list ap) {
+  chp_output_t out;
+  int n;
+
+  out.chp = chp;
+  out.n   = 0U;
+  n = chp_format(&out, fmt, ap);
+  out_flush(&out);
+
+  return n;
+}
+
 /**
  * @brief   System formatted output function.
  * @details This function implements a minimal @p printf() like functionality
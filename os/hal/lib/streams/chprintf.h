@@ -34,6 +34,17 @@
 #define CHPRINTF_USE_FLOAT          FALSE
 #endif
 
+/**
+ * @brief   Output buffer size.
+ * @details Formatted output is collected in a buffer of this size, on the
+ *          stack, and written to the stream in blocks.
+ * @note    Zero disables the buffer, literal text and strings are still
+ *          written in blocks.
+ */
+#if !defined(CHPRINTF_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CHPRINTF_BUFFER_SIZE        32
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
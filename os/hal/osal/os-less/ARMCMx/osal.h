@@ -361,6 +361,17 @@ typedef struct {
  * @param[in] id        a vector name as defined in @p vectors.s
  */
 #define OSAL_IRQ_HANDLER(id) void id(void)
+
+/**
+ * @brief   Fast code function qualifier.
+ * @details Functions marked with this qualifier are placed in the fast code
+ *          section, the linker script can relocate it into RAM.
+ */
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define OSAL_FAST_CODE __attribute__((section(".fastcode")))
+#else
+#define OSAL_FAST_CODE
+#endif
 /** @} */
 
 /**
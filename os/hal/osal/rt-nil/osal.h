@@ -321,6 +321,17 @@ typedef struct {
  * @param[in] id        a vector name as defined in @p vectors.s
  */
 #define OSAL_IRQ_HANDLER(id) CH_IRQ_HANDLER(id)
+
+/**
+ * @brief   Fast code function qualifier.
+ * @details Functions marked with this qualifier are placed in the fast code
+ *          section, the linker script can relocate it into RAM.
+ */
+#if defined(CC_FAST_CODE) || defined(__DOXYGEN__)
+#define OSAL_FAST_CODE CC_FAST_CODE
+#else
+#define OSAL_FAST_CODE
+#endif
 /** @} */
 
 /**
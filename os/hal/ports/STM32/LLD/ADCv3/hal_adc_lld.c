@@ -47,11 +47,13 @@
 /* Compact type dual mode.*/
 #define ADC_DMA_SIZE    (STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_PSIZE_HWORD)
 #define ADC_DMA_MDMA    ADC_CCR_MDMA_HWORD
+#define ADC_DMA_SSIZE   (STM32_DMA_CR_MSIZE_BYTE | STM32_DMA_CR_PSIZE_BYTE)
 
 #else /* !STM32_ADC_COMPACT_SAMPLES */
 /* Large type dual mode.*/
 #define ADC_DMA_SIZE    (STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_PSIZE_WORD)
 #define ADC_DMA_MDMA    ADC_CCR_MDMA_WORD
+#define ADC_DMA_SSIZE   (STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_PSIZE_HWORD)
 #endif /* !STM32_ADC_COMPACT_SAMPLES */
 
 #else /* !STM32_ADC_DUAL_MODE */
@@ -848,22 +850,43 @@ void adc_lld_stop(ADCDriver *adcp) {
  * @notapi
  */
 void adc_lld_start_conversion(ADCDriver *adcp) {
-  uint32_t dmamode, cfgr;
+  uint32_t dmamode, cfgr, n;
   const ADCConversionGroup *grpp = adcp->grpp;
 #if STM32_ADC_DUAL_MODE
   uint32_t ccr = grpp->ccr & ~(ADC_CCR_CKMODE_MASK | ADC_CCR_MDMA_MASK);
-#endif
+  bool dual = (ccr & ADC_CCR_DUAL_MASK) != ADC_CCR_DUAL_INDEPENDENT;
 
-  osalDbgAssert(!STM32_ADC_DUAL_MODE || ((grpp->num_channels & 1) == 0),
+  osalDbgAssert(!dual || ((grpp->num_channels & 1) == 0),
                 "odd number of channels in dual mode");
+#endif
 
   /* Calculating control registers values.*/
   dmamode = adcp->dmamode;
   cfgr    = grpp->cfgr | ADC_CFGR_DMAEN;
+  n       = (uint32_t)grpp->num_channels;
+#if STM32_ADC_DUAL_MODE
+  if (dual) {
+    /* Master and slave results packed by the common data register, one
+       DMA transfer for each pair.*/
+    dmaStreamSetPeripheral(adcp->dmastp, &adcp->adcc->CDR);
+    ccr |= ADC_DMA_MDMA;
+    n   /= 2U;
+  }
+  else {
+    /* Master only group, samples read from the master data register.*/
+    dmaStreamSetPeripheral(adcp->dmastp, &adcp->adcm->DR);
+    dmamode = (dmamode & ~STM32_DMA_CR_SIZE_MASK) | ADC_DMA_SSIZE;
+  }
+#endif
   if (grpp->circular) {
     dmamode |= STM32_DMA_CR_CIRC;
 #if STM32_ADC_DUAL_MODE
-    ccr  |= ADC_CCR_DMACFG_CIRCULAR;
+    if (dual) {
+      ccr  |= ADC_CCR_DMACFG_CIRCULAR;
+    }
+    else {
+      cfgr |= ADC_CFGR_DMACFG_CIRCULAR;
+    }
 #else
     cfgr |= ADC_CFGR_DMACFG_CIRCULAR;
 #endif
@@ -876,13 +899,7 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
 
   /* DMA setup.*/
   dmaStreamSetMemory0(adcp->dmastp, adcp->samples);
-#if STM32_ADC_DUAL_MODE
-  dmaStreamSetTransactionSize(adcp->dmastp, ((uint32_t)grpp->num_channels/2) *
-                                            (uint32_t)adcp->depth);
-#else
-  dmaStreamSetTransactionSize(adcp->dmastp, (uint32_t)grpp->num_channels *
-                                            (uint32_t)adcp->depth);
-#endif
+  dmaStreamSetTransactionSize(adcp->dmastp, n * (uint32_t)adcp->depth);
   dmaStreamSetMode(adcp->dmastp, dmamode);
   dmaStreamEnable(adcp->dmastp);
 
@@ -905,21 +922,22 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
   /* Configuring the CCR register with the user-specified settings
      in the conversion group configuration structure, static settings are
      preserved.*/
-  adcp->adcc->CCR   = (adcp->adcc->CCR &
-                       (ADC_CCR_CKMODE_MASK | ADC_CCR_MDMA_MASK)) | ccr;
+  adcp->adcc->CCR   = (adcp->adcc->CCR & ADC_CCR_CKMODE_MASK) | ccr;
 
   adcp->adcm->SMPR1 = grpp->smpr[0];
   adcp->adcm->SMPR2 = grpp->smpr[1];
-  adcp->adcm->SQR1  = grpp->sqr[0] | ADC_SQR1_NUM_CH(grpp->num_channels / 2);
+  adcp->adcm->SQR1  = grpp->sqr[0] | ADC_SQR1_NUM_CH(n);
   adcp->adcm->SQR2  = grpp->sqr[1];
   adcp->adcm->SQR3  = grpp->sqr[2];
   adcp->adcm->SQR4  = grpp->sqr[3];
-  adcp->adcs->SMPR1 = grpp->ssmpr[0];
-  adcp->adcs->SMPR2 = grpp->ssmpr[1];
-  adcp->adcs->SQR1  = grpp->ssqr[0] | ADC_SQR1_NUM_CH(grpp->num_channels / 2);
-  adcp->adcs->SQR2  = grpp->ssqr[1];
-  adcp->adcs->SQR3  = grpp->ssqr[2];
-  adcp->adcs->SQR4  = grpp->ssqr[3];
+  if (dual) {
+    adcp->adcs->SMPR1 = grpp->ssmpr[0];
+    adcp->adcs->SMPR2 = grpp->ssmpr[1];
+    adcp->adcs->SQR1  = grpp->ssqr[0] | ADC_SQR1_NUM_CH(n);
+    adcp->adcs->SQR2  = grpp->ssqr[1];
+    adcp->adcs->SQR3  = grpp->ssqr[2];
+    adcp->adcs->SQR4  = grpp->ssqr[3];
+  }
 
 #else /* !STM32_ADC_DUAL_MODE */
   adcp->adcm->SMPR1 = grpp->smpr[0];
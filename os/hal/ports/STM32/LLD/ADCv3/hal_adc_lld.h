@@ -139,6 +139,14 @@
  */
 #define ADC_CCR_DUAL_MASK               (31 << 0)
 #define ADC_CCR_DUAL_FIELD(n)           ((n) << 0)
+#define ADC_CCR_DUAL_INDEPENDENT        (0 << 0)    /**< @brief Independent, master only.                                    */
+#define ADC_CCR_DUAL_REG_SIMULT         (6 << 0)    /**< @brief Regular simultaneous.                                        */
+#define ADC_CCR_DUAL_REG_INTERL         (7 << 0)    /**< @brief Regular interleaved.                                         */
+#define ADC_CCR_DUAL_INJ_SIMULT         (5 << 0)    /**< @brief Injected simultaneous.                                       */
+#define ADC_CCR_DUAL_INJ_ALTERNATE      (9 << 0)    /**< @brief Injected alternate trigger.                                  */
+#define ADC_CCR_DUAL_REG_SIM_INJ_SIM    (1 << 0)    /**< @brief Combined regular simultaneous + injected simultaneous.       */
+#define ADC_CCR_DUAL_REG_SIM_INJ_ALT    (2 << 0)    /**< @brief Combined regular simultaneous + injected alternate trigger.  */
+#define ADC_CCR_DUAL_REG_INT_INJ_SIM    (3 << 0)    /**< @brief Combined regular interleaved  + injected simultaneous.       */
 
 #define ADC_CCR_DELAY_MASK              (15 << 8)
 #define ADC_CCR_DELAY_FIELD(n)          ((n) << 8)
@@ -198,6 +206,11 @@
  */
 /**
  * @brief   Enables the ADC master/slave mode.
+ * @details The multi-ADC mode is selected by the DUAL field of the group
+ *          @p ccr, the master and slave results are packed by the common
+ *          data register into a single DMA stream, each row of samples
+ *          contains master/slave pairs. Groups specifying
+ *          @p ADC_CCR_DUAL_INDEPENDENT only use the master ADC.
  * @note    In dual mode only ADCD1 and ADCD3 are available.
  */
 #if !defined(STM32_ADC_DUAL_MODE) || defined(__DOXYGEN__)
@@ -873,8 +886,9 @@ typedef enum {
   uint32_t                  awd2cr;                                         \
   /* ADC AWD3CR register initialization data.*/                             \
   uint32_t                  awd3cr;                                         \
-  /* ADC CCR register initialization data.                                  \
-     NOTE: Put this field to zero if not using oversampling.*/              \
+  /* ADC CCR register initialization data, the DUAL field selects the       \
+     multi-ADC mode, ADC_CCR_DUAL_INDEPENDENT for master only groups.       \
+     NOTE: This field is only present in dual mode.*/                       \
   uint32_t                  ccr;                                            \
   /* ADC SMPRx registers initialization data.*/                             \
   uint32_t                  smpr[2];                                        \
@@ -34,12 +34,14 @@
 #if STM32_ADC_COMPACT_SAMPLES == TRUE
 /* Compact type dual mode, 2x8-bit.*/
 #define ADC12_DMA_SIZE  (STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_PSIZE_HWORD)
+#define ADC12_DMA_SSIZE (STM32_DMA_CR_MSIZE_BYTE | STM32_DMA_CR_PSIZE_BYTE)
 #define ADC3_BDMA_SIZE  (STM32_BDMA_CR_MSIZE_BYTE | STM32_BDMA_CR_PSIZE_BYTE)
 #define ADC_DMA_DAMDF   ADC_CCR_DAMDF_BYTE
 
 #else /* STM32_ADC_COMPACT_SAMPLES == FALSE */
 /* Large type dual mode, 2x16bit.*/
 #define ADC12_DMA_SIZE  (STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_PSIZE_WORD)
+#define ADC12_DMA_SSIZE (STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_PSIZE_HWORD)
 #define ADC3_BDMA_SIZE  (STM32_BDMA_CR_MSIZE_HWORD | STM32_BDMA_CR_PSIZE_HWORD)
 #define ADC_DMA_DAMDF   ADC_CCR_DAMDF_HWORD
 #endif /* !STM32_ADC_COMPACT_SAMPLES */
@@ -556,17 +558,32 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
 
 #if STM32_ADC_USE_ADC12 == TRUE
 #if STM32_ADC_DUAL_MODE
-  uint32_t ccr;
+  uint32_t ccr = 0U;
+  bool dual = false;
 #endif
   if (&ADCD1 == adcp) {
-#if STM32_ADC_DUAL_MODE
-    ccr = grpp->ccr & ~(ADC_CCR_CKMODE_MASK | ADC_CCR_DAMDF_MASK);
-    osalDbgAssert(!STM32_ADC_DUAL_MODE || ((grpp->num_channels & 1) == 0),
-                  "odd number of channels in dual mode");
-#endif
+    uint32_t n = (uint32_t)grpp->num_channels;
 
     /* Calculating control registers values.*/
     dmamode = adcp->dmamode;
+#if STM32_ADC_DUAL_MODE
+    ccr  = grpp->ccr & ~(ADC_CCR_CKMODE_MASK | ADC_CCR_DAMDF_MASK);
+    dual = (ccr & ADC_CCR_DUAL_MASK) != ADC_CCR_DUAL_INDEPENDENT;
+    osalDbgAssert(!dual || ((grpp->num_channels & 1) == 0),
+                  "odd number of channels in dual mode");
+    if (dual) {
+      /* Master and slave results packed by the common data register, one
+         DMA transfer for each pair.*/
+      dmaStreamSetPeripheral(adcp->data.dma, &adcp->adcc->CDR);
+      ccr |= ADC_DMA_DAMDF;
+      n   /= 2U;
+    }
+    else {
+      /* Master only group, samples read from the master data register.*/
+      dmaStreamSetPeripheral(adcp->data.dma, &adcp->adcm->DR);
+      dmamode = (dmamode & ~STM32_DMA_CR_SIZE_MASK) | ADC12_DMA_SSIZE;
+    }
+#endif
     if (grpp->circular) {
       dmamode |= STM32_DMA_CR_CIRC;
       cfgr = grpp->cfgr | ADC_CFGR_DMNGT_CIRCULAR;
@@ -582,13 +599,7 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
 
     /* DMA setup.*/
     dmaStreamSetMemory0(adcp->data.dma, adcp->samples);
-#if STM32_ADC_DUAL_MODE
-    dmaStreamSetTransactionSize(adcp->data.dma, ((uint32_t)grpp->num_channels / 2U) *
-                                                (uint32_t)adcp->depth);
-#else
-    dmaStreamSetTransactionSize(adcp->data.dma, (uint32_t)grpp->num_channels *
-                                                (uint32_t)adcp->depth);
-#endif
+    dmaStreamSetTransactionSize(adcp->data.dma, n * (uint32_t)adcp->depth);
     dmaStreamSetMode(adcp->data.dma, dmamode);
     dmaStreamEnable(adcp->data.dma);
   }
@@ -630,8 +641,7 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
     /* Configuring the CCR register with the user-specified settings
       in the conversion group configuration structure, static settings are
       preserved.*/
-    adcp->adcc->CCR   = (adcp->adcc->CCR &
-                        (ADC_CCR_CKMODE_MASK | ADC_CCR_DAMDF_MASK)) | ccr;
+    adcp->adcc->CCR   = (adcp->adcc->CCR & ADC_CCR_CKMODE_MASK) | ccr;
 
     adcp->adcm->CFGR2 = grpp->cfgr2;
     adcp->adcm->PCSEL = grpp->pcsel;
@@ -643,28 +653,31 @@ void adc_lld_start_conversion(ADCDriver *adcp) {
     adcp->adcm->HTR1  = grpp->htr3;
     adcp->adcm->SMPR1 = grpp->smpr[0];
     adcp->adcm->SMPR2 = grpp->smpr[1];
-    adcp->adcm->SQR1  = grpp->sqr[0] | ADC_SQR1_NUM_CH(grpp->num_channels / 2);
+    adcp->adcm->SQR1  = grpp->sqr[0] |
+                        ADC_SQR1_NUM_CH(dual ? grpp->num_channels / 2 :
+                                               grpp->num_channels);
     adcp->adcm->SQR2  = grpp->sqr[1];
     adcp->adcm->SQR3  = grpp->sqr[2];
     adcp->adcm->SQR4  = grpp->sqr[3];
-    adcp->adcs->CFGR2 = grpp->cfgr2;
-    adcp->adcs->PCSEL = grpp->pcsel;
-    adcp->adcs->LTR1  = grpp->ltr1;
-    adcp->adcs->HTR1  = grpp->htr1;
-    adcp->adcs->LTR1  = grpp->ltr2;
-    adcp->adcs->HTR1  = grpp->htr2;
-    adcp->adcs->LTR1  = grpp->ltr3;
-    adcp->adcs->HTR1  = grpp->htr3;
-    adcp->adcs->SMPR1 = grpp->ssmpr[0];
-    adcp->adcs->SMPR2 = grpp->ssmpr[1];
-    adcp->adcs->SQR1  = grpp->ssqr[0] | ADC_SQR1_NUM_CH(grpp->num_channels / 2);
-    adcp->adcs->SQR2  = grpp->ssqr[1];
-    adcp->adcs->SQR3  = grpp->ssqr[2];
-    adcp->adcs->SQR4  = grpp->ssqr[3];
-
-    /* ADC configuration.*/
     adcp->adcm->CFGR  = cfgr;
-    adcp->adcs->CFGR  = cfgr;
+    if (dual) {
+      adcp->adcs->CFGR2 = grpp->cfgr2;
+      adcp->adcs->PCSEL = grpp->pcsel;
+      adcp->adcs->LTR1  = grpp->ltr1;
+      adcp->adcs->HTR1  = grpp->htr1;
+      adcp->adcs->LTR1  = grpp->ltr2;
+      adcp->adcs->HTR1  = grpp->htr2;
+      adcp->adcs->LTR1  = grpp->ltr3;
+      adcp->adcs->HTR1  = grpp->htr3;
+      adcp->adcs->SMPR1 = grpp->ssmpr[0];
+      adcp->adcs->SMPR2 = grpp->ssmpr[1];
+      adcp->adcs->SQR1  = grpp->ssqr[0] |
+                          ADC_SQR1_NUM_CH(grpp->num_channels / 2);
+      adcp->adcs->SQR2  = grpp->ssqr[1];
+      adcp->adcs->SQR3  = grpp->ssqr[2];
+      adcp->adcs->SQR4  = grpp->ssqr[3];
+      adcp->adcs->CFGR  = cfgr;
+    }
   }
 
 #endif /* STM32_ADC_DUAL_MODE == TRUE && STM32_ADC_USE_ADC12 == TRUE */
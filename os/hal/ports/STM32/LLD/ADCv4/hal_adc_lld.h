@@ -139,6 +139,26 @@
 #define ADC_CFGR_DISCNUM_VAL(n)         ((n) << 17U)
 /** @} */
 
+/**
+ * @name    CFGR2 register configuration helpers
+ * @{
+ */
+#define ADC_CFGR2_ROVSE                 (1U << 0U)
+#define ADC_CFGR2_JOVSE                 (1U << 1U)
+
+#define ADC_CFGR2_OVSS_MASK             (15U << 5U)
+#define ADC_CFGR2_OVSS_SHIFT(n)         ((n) << 5U)
+
+#define ADC_CFGR2_TROVS                 (1U << 9U)
+#define ADC_CFGR2_ROVSM                 (1U << 10U)
+
+#define ADC_CFGR2_OVSR_MASK             (1023U << 16U)
+#define ADC_CFGR2_OVSR_RATIO(n)         (((n) - 1U) << 16U)
+
+#define ADC_CFGR2_LSHIFT_MASK           (15U << 28U)
+#define ADC_CFGR2_LSHIFT(n)             ((n) << 28U)
+/** @} */
+
 /**
  * @name    CCR register configuration helpers
  * @{
@@ -176,6 +196,11 @@
  */
 /**
  * @brief   Enables the ADC1 and ADC2 master/slave mode.
+ * @details The multi-ADC mode is selected by the DUAL field of the group
+ *          @p ccr, the master and slave results are packed by the common
+ *          data register into a single DMA stream, each row of samples
+ *          contains master/slave pairs. Groups specifying
+ *          @p ADC_CCR_DUAL_INDEPENDENT only use the master ADC.
  */
 #if !defined(STM32_ADC_DUAL_MODE) || defined(__DOXYGEN__)
 #define STM32_ADC_DUAL_MODE                 FALSE
@@ -584,7 +609,8 @@ typedef union {
   /* ADC CFGR2 register initialization data.                                \
      NOTE: Put this field to zero if not using oversampling.*/              \
   uint32_t                  cfgr2;                                          \
-  /* ADC CCR register initialization data*/                                 \
+  /* ADC CCR register initialization data, the DUAL field selects the       \
+     multi-ADC mode, ADC_CCR_DUAL_INDEPENDENT for master only groups.*/     \
   uint32_t                  ccr;                                            \
   /* ADC PCSEL register initialization data.*/                              \
   uint32_t                  pcsel;                                          \
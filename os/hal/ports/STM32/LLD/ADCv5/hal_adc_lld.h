@@ -74,6 +74,8 @@
 #define STM32_ADC_CKMODE_PCLK_DIV4      (2U << 30U)
 #define STM32_ADC_CKMODE_PCLK           (3U << 30U)
 
+#define ADC_CFGR2_OVSE                  (1U << 0U)
+
 #define ADC_CFGR2_OVSR_MASK             (7U << 2U)
 #define ADC_CFGR2_OVSR_2X               (0U << 2U)
 #define ADC_CFGR2_OVSR_4X               (1U << 2U)
@@ -86,6 +88,8 @@
 
 #define ADC_CFGR2_OVSS_MASK             (15 << 5U)
 #define ADC_CFGR2_OVSS_SHIFT(n)         ((n) << 5U)
+
+#define ADC_CFGR2_TOVS                  (1U << 9U)
 /** @} */
 
 /**
@@ -114,6 +114,7 @@ static struct {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH0_HANDLER) {
   uint32_t flags;
 
@@ -132,6 +133,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH0_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH1_HANDLER) {
   uint32_t flags;
 
@@ -150,6 +152,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH1_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH2_HANDLER) {
   uint32_t flags;
 
@@ -168,6 +171,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH2_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH3_HANDLER) {
   uint32_t flags;
 
@@ -186,6 +190,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH3_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH4_HANDLER) {
   uint32_t flags;
 
@@ -204,6 +209,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH4_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH5_HANDLER) {
   uint32_t flags;
 
@@ -222,6 +228,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH5_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH6_HANDLER) {
   uint32_t flags;
 
@@ -240,6 +247,7 @@ OSAL_IRQ_HANDLER(STM32_BDMA1_CH6_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_BDMA1_CH7_HANDLER) {
   uint32_t flags;
 
@@ -434,6 +442,18 @@ void bdmaStreamFree(const stm32_bdma_stream_t *stp) {
   osalSysUnlock();
 }
 
+/**
+ * @brief   Returns the mask of the allocated streams.
+ *
+ * @return              The allocated streams mask, bit N is stream N.
+ *
+ * @xclass
+ */
+uint32_t bdmaGetAllocatedMaskX(void) {
+
+  return bdma.allocated_mask;
+}
+
 /**
  * @brief   Associates a peripheral request to a BDMA stream.
  * @note    This function can be invoked in both ISR or thread context.
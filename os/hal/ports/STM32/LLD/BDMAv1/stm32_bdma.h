@@ -431,6 +431,7 @@ extern "C" {
                                              void *param);
   void bdmaStreamFreeI(const stm32_bdma_stream_t *stp);
   void bdmaStreamFree(const stm32_bdma_stream_t *stp);
+  uint32_t bdmaGetAllocatedMaskX(void);
   void bdmaSetRequestSource(const stm32_bdma_stream_t *stp, uint32_t per);
 #ifdef __cplusplus
 }
@@ -0,0 +1,311 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    CRCv1/hal_crc_lld.c
+ * @brief   STM32 CRC subsystem low level driver source.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   CRCD1 driver identifier.
+ */
+#if (STM32_CRC_USE_CRC1 == TRUE) || defined(__DOXYGEN__)
+CRCDriver CRCD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+#if (STM32_CRC_PROGRAMMABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reflects the lower bits of a value.
+ *
+ * @param[in] v         value to be reflected
+ * @param[in] width     number of bits to be reflected
+ * @return              The reflected value.
+ */
+static uint32_t crc_lld_reflect(uint32_t v, uint32_t width) {
+
+  return __RBIT(v) >> (32U - width);
+}
+#endif
+
+#if (STM32_CRC_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared end-of-feed service routine.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void crc_lld_serve_dma_interrupt(CRCDriver *crcp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+#if defined(STM32_CRC_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0U) {
+    STM32_CRC_DMA_ERROR_HOOK(crcp);
+  }
+#else
+  (void)flags;
+#endif
+
+  dmaStreamDisable(crcp->dma);
+
+  osalSysLockFromISR();
+  osalThreadResumeI(&crcp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+#endif
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level CRC driver initialization.
+ *
+ * @notapi
+ */
+void crc_lld_init(void) {
+
+#if STM32_CRC_USE_CRC1 == TRUE
+  /* Driver initialization.*/
+  crcObjectInit(&CRCD1);
+  CRCD1.crc    = CRC;
+#if STM32_CRC_USE_DMA == TRUE
+  CRCD1.dma    = NULL;
+  CRCD1.thread = NULL;
+#endif
+#endif
+}
+
+/**
+ * @brief   Checks if a configuration is supported by the CRC unit.
+ * @details The programmable CRC unit handles odd polynomials of 7, 8, 16
+ *          or 32 bits, the fixed unit found on older devices cannot be
+ *          reloaded with a previous value and is not used.
+ *
+ * @param[in] config    pointer to the @p CRCConfig object
+ * @return              The check result.
+ * @retval false        if the configuration requires the software fallback.
+ * @retval true         if the configuration is supported.
+ *
+ * @notapi
+ */
+bool crc_lld_is_supported(const CRCConfig *config) {
+
+#if STM32_CRC_PROGRAMMABLE == TRUE
+  return (bool)(((config->poly & 1U) != 0U) &&
+                ((config->width == 7U) || (config->width == 8U) ||
+                 (config->width == 16U) || (config->width == 32U)));
+#else
+  (void)config;
+
+  return false;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the CRC peripheral.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @notapi
+ */
+void crc_lld_start(CRCDriver *crcp) {
+#if STM32_CRC_PROGRAMMABLE == TRUE
+  uint32_t cr;
+
+  if (crcp->state == CRC_STOP) {
+    /* Enables the peripheral.*/
+#if STM32_CRC_USE_CRC1 == TRUE
+    if (&CRCD1 == crcp) {
+      rccEnableCRC(true);
+#if STM32_CRC_USE_DMA == TRUE
+      crcp->dma = dmaStreamAllocI(STM32_CRC_CRC1_DMA_STREAM,
+                                  STM32_CRC_CRC1_IRQ_PRIORITY,
+                                  (stm32_dmaisr_t)crc_lld_serve_dma_interrupt,
+                                  (void *)crcp);
+      osalDbgAssert(crcp->dma != NULL, "unable to allocate stream");
+      crcp->dmamode = STM32_DMA_CR_PL(STM32_CRC_CRC1_DMA_PRIORITY) |
+                      STM32_DMA_CR_PSIZE_BYTE | STM32_DMA_CR_MSIZE_BYTE |
+                      STM32_DMA_CR_PINC | STM32_DMA_CR_DIR_M2M |
+                      STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                      STM32_DMA_CR_DMEIE;
+#if STM32_DMA_ADVANCED == TRUE
+      /* Memory to memory transfers require the FIFO.*/
+      dmaStreamSetFIFO(crcp->dma, STM32_DMA_FCR_DMDIS |
+                                  STM32_DMA_FCR_FTH_FULL);
+#endif
+#endif
+    }
+#endif
+  }
+
+  /* Polynomial size and input reflection by byte, the output is reflected
+     in software because the unit reflects the whole 32 bits register.*/
+  switch (crcp->config->width) {
+  case 7U:
+    cr = CRC_CR_POLYSIZE_0 | CRC_CR_POLYSIZE_1;
+    break;
+  case 8U:
+    cr = CRC_CR_POLYSIZE_1;
+    break;
+  case 16U:
+    cr = CRC_CR_POLYSIZE_0;
+    break;
+  default:
+    cr = 0U;
+    break;
+  }
+  if (crcp->config->reflect) {
+    cr |= CRC_CR_REV_IN_0;
+  }
+  crcp->crc->POL = crcp->config->poly;
+  crcp->crc->CR  = cr;
+#else
+  (void)crcp;
+
+  osalDbgAssert(false, "not programmable");
+#endif
+}
+
+/**
+ * @brief   Deactivates the CRC peripheral.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @notapi
+ */
+void crc_lld_stop(CRCDriver *crcp) {
+
+  if (crcp->state == CRC_READY) {
+#if STM32_CRC_USE_CRC1 == TRUE
+    if (&CRCD1 == crcp) {
+#if STM32_CRC_USE_DMA == TRUE
+      dmaStreamFreeI(crcp->dma);
+      crcp->dma = NULL;
+#endif
+      rccDisableCRC();
+    }
+#endif
+  }
+}
+
+/**
+ * @brief   Computes the CRC of a data block.
+ * @details The unit is reloaded with the previous CRC value then the data
+ *          is fed as big-endian words and trailing bytes. Blocks larger
+ *          than @p STM32_CRC_DMA_THRESHOLD are fed using DMA while the
+ *          calling thread sleeps.
+ * @note    When using DMA the buffer must be reachable by the DMA and, on
+ *          devices with data cache, its lines are flushed before the
+ *          transfer.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] crc       CRC value to continue from
+ * @param[in] n         number of bytes
+ * @param[in] buf       pointer to the data
+ * @return              The updated CRC value.
+ *
+ * @notapi
+ */
+uint32_t crc_lld_compute(CRCDriver *crcp, uint32_t crc,
+                         size_t n, const uint8_t *buf) {
+#if STM32_CRC_PROGRAMMABLE == TRUE
+  CRC_TypeDef *crcr = crcp->crc;
+  uint32_t width = (uint32_t)crcp->config->width;
+
+  /* The INIT register is not reflected.*/
+  if (crcp->config->reflect) {
+    crc = crc_lld_reflect(crc, width);
+  }
+  crcr->INIT = crc;
+  crcr->CR  |= CRC_CR_RESET;
+
+#if STM32_CRC_USE_DMA == TRUE
+  while (n >= (size_t)STM32_CRC_DMA_THRESHOLD) {
+    size_t chunk = n > 0xFFFFU ? 0xFFFFU : n;
+
+    cacheBufferFlush(buf, chunk);
+
+    osalSysLock();
+    dmaStreamSetPeripheral(crcp->dma, buf);
+    dmaStreamSetMemory0(crcp->dma, &crcr->DR);
+    dmaStreamSetTransactionSize(crcp->dma, chunk);
+    dmaStreamSetMode(crcp->dma, crcp->dmamode);
+    dmaStreamEnable(crcp->dma);
+    (void) osalThreadSuspendS(&crcp->thread);
+    osalSysUnlock();
+
+    buf += chunk;
+    n   -= chunk;
+  }
+#endif
+
+  while (n >= 4U) {
+    crcr->DR = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+               ((uint32_t)buf[2] << 8)  | (uint32_t)buf[3];
+    buf += 4U;
+    n   -= 4U;
+  }
+  while (n > 0U) {
+    *(volatile uint8_t *)&crcr->DR = *buf;
+    buf++;
+    n--;
+  }
+
+  crc = crcr->DR & (0xFFFFFFFFU >> (32U - width));
+  if (crcp->config->reflect) {
+    crc = crc_lld_reflect(crc, width);
+  }
+
+  return crc;
+#else
+  (void)crcp;
+  (void)n;
+  (void)buf;
+
+  return crc;
+#endif
+}
+
+#endif /* HAL_USE_CRC == TRUE */
+
+/** @} */
@@ -0,0 +1,195 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    CRCv1/hal_crc_lld.h
+ * @brief   STM32 CRC subsystem low level driver header.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#ifndef HAL_CRC_LLD_H
+#define HAL_CRC_LLD_H
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    STM32 configuration options
+ * @{
+ */
+/**
+ * @brief   CRCD1 driver enable switch.
+ * @details If set to @p TRUE the support for CRCD1 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(STM32_CRC_USE_CRC1) || defined(__DOXYGEN__)
+#define STM32_CRC_USE_CRC1                  FALSE
+#endif
+
+/**
+ * @brief   Enables the DMA feeding of large blocks.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(STM32_CRC_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_CRC_USE_DMA                   FALSE
+#endif
+
+/**
+ * @brief   Minimum block size in bytes fed using DMA.
+ * @details Smaller blocks are fed by the CPU, the DMA setup and the
+ *          context switch are not convenient for few bytes.
+ */
+#if !defined(STM32_CRC_DMA_THRESHOLD) || defined(__DOXYGEN__)
+#define STM32_CRC_DMA_THRESHOLD             256
+#endif
+
+/**
+ * @brief   CRCD1 DMA interrupt priority level setting.
+ */
+#if !defined(STM32_CRC_CRC1_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_CRC_CRC1_IRQ_PRIORITY         12
+#endif
+
+/**
+ * @brief   CRCD1 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_CRC_CRC1_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_CRC_CRC1_DMA_PRIORITY         0
+#endif
+
+/**
+ * @brief   CRC DMA error hook.
+ */
+#if !defined(STM32_CRC_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_CRC_DMA_ERROR_HOOK(crcp)      osalSysHalt("DMA failure")
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(STM32_HAS_CRC)
+#define STM32_HAS_CRC                       FALSE
+#endif
+
+#if !defined(STM32_CRC_PROGRAMMABLE)
+#define STM32_CRC_PROGRAMMABLE              FALSE
+#endif
+
+#if STM32_CRC_USE_CRC1 && !STM32_HAS_CRC
+#error "CRC not present in the selected device"
+#endif
+
+#if !STM32_CRC_USE_CRC1
+#error "CRC driver activated but no CRC peripheral assigned"
+#endif
+
+#if STM32_CRC_USE_DMA == TRUE
+#if !STM32_CRC_PROGRAMMABLE
+#error "CRC DMA feeding requires a programmable CRC unit"
+#endif
+
+#if !defined(STM32_CRC_CRC1_DMA_STREAM)
+#error "STM32_CRC_CRC1_DMA_STREAM not defined"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_CRC_CRC1_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to CRC1"
+#endif
+
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_CRC_CRC1_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to CRC1"
+#endif
+
+#if STM32_CRC_DMA_THRESHOLD < 4
+#error "invalid STM32_CRC_DMA_THRESHOLD value"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* STM32_CRC_USE_DMA == TRUE */
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the CRC configuration structure.
+ */
+#define crc_lld_config_fields                                               \
+  /* Dummy configuration, it is not needed.*/                               \
+  uint32_t                  dummy
+
+#if (STM32_CRC_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Low level fields of the CRC driver structure.
+ */
+#define crc_lld_driver_fields                                               \
+  /* Pointer to the CRC registers block.*/                                  \
+  CRC_TypeDef               *crc;                                           \
+  /* Feeding DMA stream.*/                                                  \
+  const stm32_dma_stream_t  *dma;                                           \
+  /* DMA mode bit mask.*/                                                   \
+  uint32_t                  dmamode;                                        \
+  /* Thread waiting for the DMA completion.*/                               \
+  thread_reference_t        thread
+#else
+#define crc_lld_driver_fields                                               \
+  /* Pointer to the CRC registers block.*/                                  \
+  CRC_TypeDef               *crc
+#endif
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (STM32_CRC_USE_CRC1 == TRUE) && !defined(__DOXYGEN__)
+extern CRCDriver CRCD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void crc_lld_init(void);
+  bool crc_lld_is_supported(const CRCConfig *config);
+  void crc_lld_start(CRCDriver *crcp);
+  void crc_lld_stop(CRCDriver *crcp);
+  uint32_t crc_lld_compute(CRCDriver *crcp, uint32_t crc,
+                           size_t n, const uint8_t *buf);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_CRC == TRUE */
+
+#endif /* HAL_CRC_LLD_H */
+
+/** @} */
@@ -334,6 +334,109 @@ static void cry_lld_hash_push(CRYDriver *cryp, uint32_t n, const uint32_t *p) {
 
 }
 
+/**
+ * @brief   Waits for the hash engine to complete the current operation.
+ */
+static void cry_lld_hash_wait_idle(void) {
+
+  while ((HASH->SR & HASH_SR_BUSY) != 0U) {
+  }
+}
+
+#if (STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Saves the hash engine state.
+ *
+ * @param[out] hsp              pointer to the state to be saved
+ */
+static void cry_lld_hash_save(stm32_hash_state_t *hsp) {
+  unsigned i;
+
+  cry_lld_hash_wait_idle();
+
+  hsp->imr = HASH->IMR;
+  hsp->str = HASH->STR;
+  hsp->cr  = HASH->CR & (HASH_CR_DMAE | HASH_CR_DATATYPE | HASH_CR_MODE |
+                         HASH_CR_ALGO | HASH_CR_LKEY);
+  for (i = 0U; i < STM32_HASH_CSR_NUM; i++) {
+    hsp->csr[i] = HASH->CSR[i];
+  }
+}
+
+/**
+ * @brief   Restores the hash engine state.
+ *
+ * @param[in] hsp               pointer to the state to be restored
+ */
+static void cry_lld_hash_restore(const stm32_hash_state_t *hsp) {
+  unsigned i;
+
+  HASH->IMR = hsp->imr;
+  HASH->STR = hsp->str;
+  HASH->CR  = hsp->cr;
+  HASH->CR  = hsp->cr | HASH_CR_INIT;
+  for (i = 0U; i < STM32_HASH_CSR_NUM; i++) {
+    HASH->CSR[i] = hsp->csr[i];
+  }
+}
+
+/**
+ * @brief   Makes a context the owner of the hash engine.
+ * @details The state of the previous owner, if any, is saved into its
+ *          context.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hsp               pointer to the state of the new owner
+ */
+static void cry_lld_hash_claim(CRYDriver *cryp, stm32_hash_state_t *hsp) {
+
+  if ((cryp->hash_owner != NULL) && (cryp->hash_owner != hsp)) {
+    cry_lld_hash_save(cryp->hash_owner);
+  }
+  cryp->hash_owner = hsp;
+}
+
+/**
+ * @brief   Makes sure the state of a context is loaded in the hash engine.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] hsp               pointer to the state of the context
+ */
+static void cry_lld_hash_acquire(CRYDriver *cryp, stm32_hash_state_t *hsp) {
+
+  if (cryp->hash_owner != hsp) {
+    cry_lld_hash_claim(cryp, hsp);
+    cry_lld_hash_restore(hsp);
+  }
+}
+
+#define HASH_CLAIM(cryp, ctxp)      cry_lld_hash_claim(cryp, &(ctxp)->hw)
+#define HASH_ACQUIRE(cryp, ctxp)    cry_lld_hash_acquire(cryp, &(ctxp)->hw)
+#define HASH_RELEASE(cryp)          (cryp)->hash_owner = NULL
+#else
+#define HASH_CLAIM(cryp, ctxp)
+#define HASH_ACQUIRE(cryp, ctxp)
+#define HASH_RELEASE(cryp)
+#endif
+
+#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Pushes the HMAC key into the hash engine and starts processing.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ */
+static void cry_lld_hmac_push_key(CRYDriver *cryp) {
+  uint32_t nbits = 8U * (uint32_t)(cryp->hash_ksize % sizeof (uint32_t));
+
+  cry_lld_hash_push(cryp,
+                    (uint32_t)((cryp->hash_ksize + sizeof (uint32_t) - 1U) /
+                               sizeof (uint32_t)),
+                    cryp->hash_k);
+  HASH->STR = nbits;
+  HASH->STR = nbits | HASH_STR_DCAL;
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -471,6 +574,10 @@ void cry_lld_start(CRYDriver *cryp) {
 
 #if STM32_CRY_USE_HASH1
   /* HASH setup and enable.*/
+  cryp->hash_ksize = 0U;
+#if STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE
+  cryp->hash_owner = NULL;
+#endif
 #endif
 }
 
@@ -1540,6 +1647,7 @@ cryerror_t cry_lld_SHA256_init(CRYDriver *cryp, SHA256Context *sha256ctxp) {
   sha256ctxp->last_size = 0U;
 
   /* Initializing operation.*/
+  HASH_CLAIM(cryp, sha256ctxp);
   HASH->CR = /*HASH_CR_MDMAT |*/ HASH_CR_ALGO_1 | HASH_CR_ALGO_0 |
              HASH_CR_DATATYPE_1 | HASH_CR_INIT;
 
@@ -1580,6 +1688,7 @@ cryerror_t cry_lld_SHA256_update(CRYDriver *cryp, SHA256Context *sha256ctxp,
   }
 
   /* Pushing data.*/
+  HASH_ACQUIRE(cryp, sha256ctxp);
   cry_lld_hash_push(cryp, (uint32_t)(size / sizeof (uint32_t)), wp);
 
   return CRY_NOERROR;
@@ -1606,6 +1715,7 @@ cryerror_t cry_lld_SHA256_final(CRYDriver *cryp, SHA256Context *sha256ctxp,
 
   (void)cryp;
 
+  HASH_ACQUIRE(cryp, sha256ctxp);
   if (sha256ctxp->last_size > 0U) {
     HASH->DIN = sha256ctxp->last_data;
   }
@@ -1627,6 +1737,7 @@ cryerror_t cry_lld_SHA256_final(CRYDriver *cryp, SHA256Context *sha256ctxp,
   digest[6] = HASH_DIGEST->HR[6];
   digest[7] = HASH_DIGEST->HR[7];
   memcpy((void *)out, (const void *)digest, sizeof digest);
+  HASH_RELEASE(cryp);
 
   return CRY_NOERROR;
 }
@@ -1728,9 +1839,31 @@ cryerror_t cry_lld_hmac_loadkey(CRYDriver *cryp,
                                 size_t size,
                                 const uint8_t *keyp) {
 
-  (void)cryp;
-  (void)size;
-  (void)keyp;
+  memset((void *)cryp->hash_k, 0, sizeof cryp->hash_k);
+
+  /* Keys longer than the block size are replaced by their digest, as
+     specified by RFC 2104, so the engine never needs the long key mode.*/
+  if (size > STM32_HASH_HMAC_KEY_SIZE) {
+    SHA256Context ctx;
+    cryerror_t err;
+
+    err = cry_lld_SHA256_init(cryp, &ctx);
+    if (err == CRY_NOERROR) {
+      err = cry_lld_SHA256_update(cryp, &ctx, size, keyp);
+    }
+    if (err == CRY_NOERROR) {
+      err = cry_lld_SHA256_final(cryp, &ctx, (uint8_t *)cryp->hash_k);
+    }
+    if (err != CRY_NOERROR) {
+      cryp->hash_ksize = 0U;
+      return err;
+    }
+    cryp->hash_ksize = 32U;
+  }
+  else {
+    memcpy((void *)cryp->hash_k, (const void *)keyp, size);
+    cryp->hash_ksize = size;
+  }
 
   return CRY_NOERROR;
 }
@@ -1753,10 +1886,18 @@ cryerror_t cry_lld_hmac_loadkey(CRYDriver *cryp,
 cryerror_t cry_lld_HMACSHA256_init(CRYDriver *cryp,
                                    HMACSHA256Context *hmacsha256ctxp) {
 
-  (void)cryp;
-  (void)hmacsha256ctxp;
+  /* Initializing context structure.*/
+  hmacsha256ctxp->last_data = 0U;
+  hmacsha256ctxp->last_size = 0U;
 
-  return CRY_ERR_INV_ALGO;
+  /* Initializing operation in HMAC mode, the key is hashed first.*/
+  HASH_CLAIM(cryp, hmacsha256ctxp);
+  HASH->CR = HASH_CR_ALGO_1 | HASH_CR_ALGO_0 | HASH_CR_DATATYPE_1 |
+             HASH_CR_MODE | HASH_CR_INIT;
+  cry_lld_hmac_push_key(cryp);
+  cry_lld_hash_wait_idle();
+
+  return CRY_NOERROR;
 }
 
 /**
@@ -1779,13 +1920,24 @@ cryerror_t cry_lld_HMACSHA256_update(CRYDriver *cryp,
                                      HMACSHA256Context *hmacsha256ctxp,
                                      size_t size,
                                      const uint8_t *in) {
+  const uint32_t *wp = (const uint32_t *)(const void *)in;
 
-  (void)cryp;
-  (void)hmacsha256ctxp;
-  (void)size;
-  (void)in;
+  /* Same constraints of the SHA256 update, see above.*/
+  if (hmacsha256ctxp->last_size != 0U) {
+    return CRY_ERR_OP_FAILURE;
+  }
 
-  return CRY_ERR_INV_ALGO;
+  /* Any unaligned data is deferred to the "final" function.*/
+  hmacsha256ctxp->last_size = 8U * (size % sizeof (uint32_t));
+  if (hmacsha256ctxp->last_size > 0U) {
+    hmacsha256ctxp->last_data = wp[size / sizeof (uint32_t)];
+  }
+
+  /* Pushing data.*/
+  HASH_ACQUIRE(cryp, hmacsha256ctxp);
+  cry_lld_hash_push(cryp, (uint32_t)(size / sizeof (uint32_t)), wp);
+
+  return CRY_NOERROR;
 }
 
 /**
@@ -1806,12 +1958,37 @@ cryerror_t cry_lld_HMACSHA256_update(CRYDriver *cryp,
 cryerror_t cry_lld_HMACSHA256_final(CRYDriver *cryp,
                                     HMACSHA256Context *hmacsha256ctxp,
                                     uint8_t *out) {
+  uint32_t digest[8];
 
-  (void)cryp;
-  (void)hmacsha256ctxp;
-  (void)out;
+  HASH_ACQUIRE(cryp, hmacsha256ctxp);
+  if (hmacsha256ctxp->last_size > 0U) {
+    HASH->DIN = hmacsha256ctxp->last_data;
+  }
 
-  return CRY_ERR_INV_ALGO;
+  /* Closing the message phase.*/
+  HASH->STR = hmacsha256ctxp->last_size;
+  HASH->STR = hmacsha256ctxp->last_size | HASH_STR_DCAL;
+  cry_lld_hash_wait_idle();
+
+  /* Outer hash phase, the key is pushed again then wait for result.*/
+  HASH->SR  = 0U;
+  cry_lld_hmac_push_key(cryp);
+  while ((HASH->SR & HASH_SR_DCIS) == 0U) {
+  }
+
+  /* Reading digest.*/
+  digest[0] = HASH_DIGEST->HR[0];
+  digest[1] = HASH_DIGEST->HR[1];
+  digest[2] = HASH_DIGEST->HR[2];
+  digest[3] = HASH_DIGEST->HR[3];
+  digest[4] = HASH_DIGEST->HR[4];
+  digest[5] = HASH_DIGEST->HR[5];
+  digest[6] = HASH_DIGEST->HR[6];
+  digest[7] = HASH_DIGEST->HR[7];
+  memcpy((void *)out, (const void *)digest, sizeof digest);
+  HASH_RELEASE(cryp);
+
+  return CRY_NOERROR;
 }
 #endif
 
@@ -31,6 +31,17 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of HASH context swap registers.
+ */
+#define STM32_HASH_CSR_NUM                  54U
+
+/**
+ * @brief   Maximum HMAC key size stored in the driver.
+ * @note    Longer keys are hashed when loaded.
+ */
+#define STM32_HASH_HMAC_KEY_SIZE            64U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -94,6 +105,18 @@
 #define STM32_CRY_HASH_SIZE_THRESHOLD       1024
 #endif
 
+/**
+ * @brief   Enables the HASH context swap.
+ * @details If set to @p TRUE then each hash context stores the state of
+ *          the HASH engine, the state is saved and restored when operations
+ *          on different contexts are interleaved. If set to @p FALSE then
+ *          a context must be finalized before another one is initialized.
+ * @note    Enabling this option adds about 230 bytes to each context.
+ */
+#if !defined(STM32_CRY_HASH_USE_CONTEXT_SWAP) || defined(__DOXYGEN__)
+#define STM32_CRY_HASH_USE_CONTEXT_SWAP     FALSE
+#endif
+
 /**
  * @brief   Minimum text size (in bytes) for DMA use.
  * @note    If set to zero then DMA is never used.
@@ -282,6 +305,18 @@ typedef enum {
   cryp_key_aes_decrypt = 4
 } cryp_ktype_t;
 
+#if (STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a saved HASH engine state.
+ */
+typedef struct {
+  uint32_t                  imr;
+  uint32_t                  str;
+  uint32_t                  cr;
+  uint32_t                  csr[STM32_HASH_CSR_NUM];
+} stm32_hash_state_t;
+#endif
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -335,6 +370,20 @@ struct CRYDriver {
 #endif /* STM32_CRY_CRYP_SIZE_THRESHOLD != 0 */
 #endif /* STM32_CRY_USE_CRYP1 == TRUE */
 #if (STM32_CRY_USE_HASH1 == TRUE) || defined (__DOXYGEN__)
+  /**
+   * @brief   HMAC transient key data.
+   */
+  uint32_t                  hash_k[STM32_HASH_HMAC_KEY_SIZE / 4U];
+  /**
+   * @brief   HMAC transient key size in bytes.
+   */
+  size_t                    hash_ksize;
+#if (STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE) || defined (__DOXYGEN__)
+  /**
+   * @brief   State of the context currently loaded in the HASH engine.
+   */
+  stm32_hash_state_t        *hash_owner;
+#endif
 #if (STM32_CRY_HASH_SIZE_THRESHOLD != 0) || defined (__DOXYGEN__)
   /**
    * @brief   Thread reference for hash operations.
@@ -370,6 +419,12 @@ typedef struct {
    * @brief   Size, in bits, of the last data.
    */
   uint32_t      last_size;
+#if (STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Saved HASH engine state.
+   */
+  stm32_hash_state_t hw;
+#endif
 } SHA256Context;
 #endif
 
@@ -387,7 +442,20 @@ typedef struct {
  * @brief   Type of a HMAC_SHA256 context.
  */
 typedef struct {
-  uint32_t dummy;
+  /**
+   * @brief   Last data to be hashed on finalization.
+   */
+  uint32_t      last_data;
+  /**
+   * @brief   Size, in bits, of the last data.
+   */
+  uint32_t      last_size;
+#if (STM32_CRY_HASH_USE_CONTEXT_SWAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Saved HASH engine state.
+   */
+  stm32_hash_state_t hw;
+#endif
 } HMACSHA256Context;
 #endif
 
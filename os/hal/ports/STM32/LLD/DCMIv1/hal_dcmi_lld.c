@@ -0,0 +1,373 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    DCMIv1/hal_dcmi_lld.c
+ * @brief   STM32 DCMI subsystem low level driver source.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define DCMI_CR_DRIVER_MASK         (DCMI_CR_CAPTURE | DCMI_CR_CM |         \
+                                     DCMI_CR_CROP | DCMI_CR_ENABLE)
+
+#define DCMI_ICR_ALL                (DCMI_ICR_FRAME_ISC | DCMI_ICR_OVR_ISC |  \
+                                     DCMI_ICR_ERR_ISC | DCMI_ICR_VSYNC_ISC |  \
+                                     DCMI_ICR_LINE_ISC)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   DCMID1 driver identifier.
+ */
+#if (STM32_DCMI_USE_DCMI1 == TRUE) || defined(__DOXYGEN__)
+DCMIDriver DCMID1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Starts capturing in the current frame buffer.
+ * @details The frame is split in chunks, the DMA double buffer mode
+ *          writes a chunk while the next one is programmed. Chunks of
+ *          the following frame go in another buffer, so frames are
+ *          captured back to back.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ */
+static void dcmi_lld_capture_begin(DCMIDriver *dcmip) {
+  const DCMIConfig *config = dcmip->config;
+  uint32_t cr;
+
+  /* Dirty lines must not be evicted over the captured data.*/
+  cacheBufferInvalidate(dcmip->frame, config->frame_size);
+
+  dcmip->done       = 0U;
+  dcmip->drop       = false;
+  dcmip->prog_frame = dcmip->frame;
+  dcmip->prog_chunk = 1U;
+
+  dmaStreamSetPeripheral(dcmip->dma, &dcmip->dcmi->DR);
+  dmaStreamSetMemory0(dcmip->dma, dcmip->frame);
+  dmaStreamSetMemory1(dcmip->dma, dcmip->frame + dcmip->chunk_size);
+  dmaStreamSetTransactionSize(dcmip->dma, dcmip->chunk_size / 4U);
+  dmaStreamSetMode(dcmip->dma, dcmip->dmamode);
+  dmaStreamEnable(dcmip->dma);
+
+  cr = config->cr & ~DCMI_CR_DRIVER_MASK;
+  if (dcmip->state == DCMI_SNAPSHOT) {
+    cr |= DCMI_CR_CM;
+  }
+  if (config->crop.width > 0U) {
+    dcmip->dcmi->CWSTRTR = ((uint32_t)config->crop.y << 16) |
+                           (uint32_t)config->crop.x;
+    dcmip->dcmi->CWSIZER = (((uint32_t)config->crop.height - 1U) << 16) |
+                           ((uint32_t)config->crop.width - 1U);
+    cr |= DCMI_CR_CROP;
+  }
+  dcmip->dcmi->ESCR = config->escr;
+  dcmip->dcmi->ESUR = config->esur;
+  dcmip->dcmi->ICR  = DCMI_ICR_ALL;
+  dcmip->dcmi->IER  = DCMI_IER_OVR_IE | DCMI_IER_ERR_IE;
+  dcmip->dcmi->CR   = cr | DCMI_CR_ENABLE;
+
+  /* The capture starts on the next frame start.*/
+  dcmip->dcmi->CR   = cr | DCMI_CR_ENABLE | DCMI_CR_CAPTURE;
+}
+
+/**
+ * @brief   Stops the capture.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ */
+static void dcmi_lld_capture_end(DCMIDriver *dcmip) {
+
+  dcmip->dcmi->IER = 0U;
+  dcmip->dcmi->CR  = 0U;
+  dcmip->dcmi->ICR = DCMI_ICR_ALL;
+  dmaStreamDisable(dcmip->dma);
+}
+
+/**
+ * @brief   Shared end-of-chunk service routine.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void dcmi_lld_serve_dma_interrupt(DCMIDriver *dcmip, uint32_t flags) {
+  const DCMIConfig *config = dcmip->config;
+  uint8_t *frame = NULL;
+  uint8_t *p;
+
+  /* DMA errors handling.*/
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0U) {
+    STM32_DCMI_DMA_ERROR_HOOK(dcmip);
+  }
+
+  if ((flags & STM32_DMA_ISR_TCIF) == 0U) {
+    return;
+  }
+
+  osalSysLockFromISR();
+
+  /* Frame end, the next frame is the one of the chunk being written.*/
+  if (++dcmip->done >= dcmip->chunks) {
+    if (dcmip->drop) {
+      dcmip->dropped++;
+    }
+    else {
+      frame = dcmip->frame;
+    }
+    dcmip->frame = dcmip->prog_frame;
+    dcmip->done  = 0U;
+    dcmip->drop  = false;
+  }
+
+  if ((frame != NULL) && (dcmip->state == DCMI_SNAPSHOT)) {
+    /* Single frame captured.*/
+    dcmi_lld_capture_end(dcmip);
+  }
+  else {
+    /* Programming the chunk after the one being written in the idle
+       memory register.*/
+    if (++dcmip->prog_chunk >= dcmip->chunks) {
+      p = _dcmi_get_frame_i(dcmip);
+      if (p == NULL) {
+        /* No free buffers, the frame being captured is dropped and its
+           buffer reused for the next one.*/
+        p = dcmip->frame;
+        dcmip->drop = dcmip->state == DCMI_ACTIVE;
+      }
+      else {
+        cacheBufferInvalidate(p, config->frame_size);
+      }
+      dcmip->prog_frame = p;
+      dcmip->prog_chunk = 0U;
+    }
+    p = dcmip->prog_frame + (dcmip->prog_chunk * dcmip->chunk_size);
+    if (dmaStreamGetCurrentTarget(dcmip->dma) == 0U) {
+      dmaStreamSetMemory1(dcmip->dma, p);
+    }
+    else {
+      dmaStreamSetMemory0(dcmip->dma, p);
+    }
+  }
+
+  osalSysUnlockFromISR();
+
+  if (frame != NULL) {
+    /* Lines speculatively loaded during the transfer are discarded.*/
+    cacheBufferInvalidate(frame, config->frame_size);
+    _dcmi_isr_frame_code(dcmip, frame);
+  }
+}
+
+/**
+ * @brief   Shared capture error service routine.
+ * @details The capture is stopped, in continuous mode it is restarted on
+ *          the current buffer.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ */
+static void dcmi_lld_serve_error(DCMIDriver *dcmip) {
+
+  osalSysLockFromISR();
+  dcmi_lld_capture_end(dcmip);
+  if (dcmip->prog_frame != dcmip->frame) {
+    _dcmi_release_frame_i(dcmip, dcmip->prog_frame);
+  }
+  osalSysUnlockFromISR();
+
+  _dcmi_isr_error_code(dcmip);
+
+  osalSysLockFromISR();
+  if (dcmip->state == DCMI_ACTIVE) {
+    dcmi_lld_capture_begin(dcmip);
+  }
+  osalSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+#if (STM32_DCMI_USE_DCMI1 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   DCMI interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_DCMI_HANDLER) {
+  uint32_t misr;
+
+  OSAL_IRQ_PROLOGUE();
+
+  misr = DCMID1.dcmi->MISR;
+  DCMID1.dcmi->ICR = misr;
+
+  if ((misr & (DCMI_MIS_OVR_MIS | DCMI_MIS_ERR_MIS)) != 0U) {
+    dcmi_lld_serve_error(&DCMID1);
+  }
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level DCMI driver initialization.
+ *
+ * @notapi
+ */
+void dcmi_lld_init(void) {
+
+#if STM32_DCMI_USE_DCMI1 == TRUE
+  dcmiObjectInit(&DCMID1);
+  DCMID1.dcmi = DCMI;
+  DCMID1.dma  = NULL;
+#endif
+}
+
+/**
+ * @brief   Configures and activates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_start(DCMIDriver *dcmip) {
+  uint32_t words, n;
+
+  if (dcmip->state == DCMI_STOP) {
+    /* Enables the peripheral.*/
+#if STM32_DCMI_USE_DCMI1 == TRUE
+    if (&DCMID1 == dcmip) {
+      dcmip->dma = dmaStreamAllocI(STM32_DCMI_DCMI1_DMA_STREAM,
+                                   STM32_DCMI_DCMI1_IRQ_PRIORITY,
+                                   (stm32_dmaisr_t)dcmi_lld_serve_dma_interrupt,
+                                   (void *)dcmip);
+      osalDbgAssert(dcmip->dma != NULL, "unable to allocate stream");
+      rccEnableDCMI(true);
+      dmaSetRequestSource(dcmip->dma, STM32_DMAMUX1_DCMI);
+      nvicEnableVector(STM32_DCMI_NUMBER, STM32_DCMI_DCMI1_IRQ_PRIORITY);
+      dcmip->dmamode = STM32_DMA_CR_PL(STM32_DCMI_DCMI1_DMA_PRIORITY);
+    }
+#endif
+    dcmip->dmamode |= STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_PSIZE_WORD |
+                      STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC |
+                      STM32_DMA_CR_CIRC | STM32_DMA_CR_DBM |
+                      STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE |
+                      STM32_DMA_CR_DMEIE;
+    dmaStreamSetFIFO(dcmip->dma, STM32_DMA_FCR_DMDIS |
+                                 STM32_DMA_FCR_FTH_FULL);
+  }
+
+  /* Splitting the frame in at least two equal chunks, each one within
+     the DMA transfer size limit.*/
+  osalDbgAssert((dcmip->config->frame_size & 3U) == 0U,
+                "frame size not multiple of 4");
+  words = (uint32_t)(dcmip->config->frame_size / 4U);
+  n = 2U;
+  while (((words % n) != 0U) || ((words / n) > STM32_DCMI_MAX_CHUNK)) {
+    n++;
+    osalDbgAssert(n <= words, "unsupported frame size");
+  }
+  dcmip->chunks     = n;
+  dcmip->chunk_size = (size_t)(words / n) * 4U;
+
+  dcmip->dcmi->CR = 0U;
+}
+
+/**
+ * @brief   Deactivates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_stop(DCMIDriver *dcmip) {
+
+  if (dcmip->state == DCMI_READY) {
+    dcmip->dcmi->CR = 0U;
+    dmaStreamFreeI(dcmip->dma);
+    dcmip->dma = NULL;
+
+#if STM32_DCMI_USE_DCMI1 == TRUE
+    if (&DCMID1 == dcmip) {
+      nvicDisableVector(STM32_DCMI_NUMBER);
+      rccDisableDCMI();
+    }
+#endif
+  }
+}
+
+/**
+ * @brief   Starts a capture.
+ * @details The mode depends on the driver state, @p DCMI_ACTIVE for
+ *          continuous capture or @p DCMI_SNAPSHOT for a single frame.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] frame     first frame buffer
+ *
+ * @notapi
+ */
+void dcmi_lld_start_capture(DCMIDriver *dcmip, void *frame) {
+
+  dcmip->frame = (uint8_t *)frame;
+  dcmi_lld_capture_begin(dcmip);
+}
+
+/**
+ * @brief   Stops a capture.
+ * @details The buffers owned by the driver are released.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_stop_capture(DCMIDriver *dcmip) {
+
+  dcmi_lld_capture_end(dcmip);
+
+  _dcmi_release_frame_i(dcmip, dcmip->frame);
+  if (dcmip->prog_frame != dcmip->frame) {
+    _dcmi_release_frame_i(dcmip, dcmip->prog_frame);
+  }
+}
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+/** @} */
@@ -0,0 +1,192 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    DCMIv1/hal_dcmi_lld.h
+ * @brief   STM32 DCMI subsystem low level driver header.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#ifndef HAL_DCMI_LLD_H
+#define HAL_DCMI_LLD_H
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of words of a DMA transfer.
+ */
+#define STM32_DCMI_MAX_CHUNK                65535U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    STM32 configuration options
+ * @{
+ */
+/**
+ * @brief   DCMID1 driver enable switch.
+ * @details If set to @p TRUE the support for DCMID1 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(STM32_DCMI_USE_DCMI1) || defined(__DOXYGEN__)
+#define STM32_DCMI_USE_DCMI1                FALSE
+#endif
+
+/**
+ * @brief   DCMID1 interrupt priority level setting.
+ * @note    The same priority is used for the DMA stream.
+ */
+#if !defined(STM32_DCMI_DCMI1_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_DCMI_DCMI1_IRQ_PRIORITY       8
+#endif
+
+/**
+ * @brief   DCMID1 DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_DCMI_DCMI1_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_DCMI_DCMI1_DMA_PRIORITY       3
+#endif
+
+/**
+ * @brief   DCMID1 DMA stream.
+ */
+#if !defined(STM32_DCMI_DCMI1_DMA_STREAM) || defined(__DOXYGEN__)
+#define STM32_DCMI_DCMI1_DMA_STREAM         STM32_DMA_STREAM_ID_ANY
+#endif
+
+/**
+ * @brief   DCMI DMA error hook.
+ */
+#if !defined(STM32_DCMI_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_DCMI_DMA_ERROR_HOOK(dcmip)    osalSysHalt("DMA failure")
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(STM32_HAS_DCMI)
+#define STM32_HAS_DCMI                      FALSE
+#endif
+
+#if STM32_DCMI_USE_DCMI1 && !STM32_HAS_DCMI
+#error "DCMI not present in the selected device"
+#endif
+
+#if !STM32_DCMI_USE_DCMI1
+#error "DCMI driver activated but no DCMI peripheral assigned"
+#endif
+
+#if (STM32_DMA_SUPPORTS_DMAMUX == FALSE) || !defined(STM32_DMA_CR_DBM)
+#error "DCMI driver requires a DMA with DMAMUX and double buffer mode"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_DCMI_DCMI1_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to DCMI1"
+#endif
+
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_DCMI_DCMI1_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to DCMI1"
+#endif
+
+#if !STM32_DMA_IS_VALID_STREAM(STM32_DCMI_DCMI1_DMA_STREAM)
+#error "Invalid DMA stream assigned to DCMI1"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the DCMI configuration structure.
+ */
+#define dcmi_lld_config_fields                                              \
+  /* DCMI CR register initialization data, polarities, data width and    */ \
+  /* capture rates. The CAPTURE, CM, CROP and ENABLE bits are handled by */ \
+  /* the driver.*/                                                          \
+  uint32_t                  cr;                                             \
+  /* DCMI ESCR register initialization data, embedded sync codes.*/         \
+  uint32_t                  escr;                                           \
+  /* DCMI ESUR register initialization data, embedded sync masks.*/         \
+  uint32_t                  esur
+
+/**
+ * @brief   Low level fields of the DCMI driver structure.
+ */
+#define dcmi_lld_driver_fields                                              \
+  /* Pointer to the DCMI registers block.*/                                 \
+  DCMI_TypeDef              *dcmi;                                          \
+  /* Receive DMA stream.*/                                                  \
+  const stm32_dma_stream_t  *dma;                                           \
+  /* DMA mode bit mask.*/                                                   \
+  uint32_t                  dmamode;                                        \
+  /* Size in bytes of a DMA transfer, a frame is split in chunks.*/         \
+  size_t                    chunk_size;                                     \
+  /* Number of chunks in a frame.*/                                         \
+  uint32_t                  chunks;                                         \
+  /* Frame being captured.*/                                                \
+  uint8_t                   *frame;                                         \
+  /* Chunks of the frame already captured.*/                                \
+  uint32_t                  done;                                           \
+  /* The frame being captured will be dropped.*/                            \
+  bool                      drop;                                           \
+  /* Frame of the last chunk programmed in the DMA.*/                       \
+  uint8_t                   *prog_frame;                                    \
+  /* Index of the last chunk programmed in the DMA.*/                       \
+  uint32_t                  prog_chunk
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (STM32_DCMI_USE_DCMI1 == TRUE) && !defined(__DOXYGEN__)
+extern DCMIDriver DCMID1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dcmi_lld_init(void);
+  void dcmi_lld_start(DCMIDriver *dcmip);
+  void dcmi_lld_stop(DCMIDriver *dcmip);
+  void dcmi_lld_start_capture(DCMIDriver *dcmip, void *frame);
+  void dcmi_lld_stop_capture(DCMIDriver *dcmip);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+#endif /* HAL_DCMI_LLD_H */
+
+/** @} */
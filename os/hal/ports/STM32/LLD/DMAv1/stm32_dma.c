@@ -295,6 +295,7 @@ static struct {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH1_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -311,6 +312,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH1_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH2_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -327,6 +329,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH2_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH3_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -343,6 +346,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH3_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH4_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -359,6 +363,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH4_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH5_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -375,6 +380,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH5_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH6_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -391,6 +397,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH6_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH7_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -407,6 +414,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH7_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH8_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -423,6 +431,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH8_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH1_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -439,6 +448,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH1_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH2_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -455,6 +465,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH2_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH3_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -471,6 +482,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH3_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH4_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -487,6 +499,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH4_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH5_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -503,6 +516,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH5_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH6_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -519,6 +533,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH6_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH7_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -535,6 +550,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH7_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH8_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -29,6 +29,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 /* The following macro is only defined if some driver requiring DMA services
@@ -150,6 +152,185 @@ static struct {
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (STM32_DMA_USE_MEMCPY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the next chunk of a memory copy service operation.
+ * @note    The stream can transfer up to 65535 data units at once, larger
+ *          operations are split in chunks restarted from the ISR.
+ *
+ * @param[in] xfp       pointer to the @p stm32_dma_xfer_t object
+ *
+ * @notapi
+ */
+static void dma_xfer_next(stm32_dma_xfer_t *xfp) {
+  const stm32_dma_stream_t *dmastp = xfp->dmastp;
+  size_t n = xfp->remaining;
+
+  if (n > xfp->chunk) {
+    n = xfp->chunk;
+  }
+
+  if ((xfp->cr & STM32_DMA_CR_PINC) != 0U) {
+    dmaStreamSetPeripheral(dmastp, xfp->next_src);
+    xfp->next_src += n;
+  }
+  else {
+    dmaStreamSetPeripheral(dmastp, &xfp->pattern);
+  }
+  dmaStreamSetMemory0(dmastp, xfp->next_dst);
+  xfp->next_dst  += n;
+  xfp->remaining -= n;
+
+  /* The transaction size is expressed in source data units.*/
+  if ((xfp->cr & STM32_DMA_CR_PSIZE_WORD) != 0U) {
+    n /= 4U;
+  }
+  dmaStreamSetTransactionSize(dmastp, n);
+  dmaStreamSetMode(dmastp, xfp->cr);
+  dmaStreamEnable(dmastp);
+}
+
+/**
+ * @brief   Memory copy service stream ISR.
+ *
+ * @param[in] p         pointer to the @p stm32_dma_xfer_t object
+ * @param[in] flags     pre-shifted content of the ISR register
+ *
+ * @notapi
+ */
+static void dma_xfer_serve_interrupt(void *p, uint32_t flags) {
+  stm32_dma_xfer_t *xfp = (stm32_dma_xfer_t *)p;
+  bool error = (flags & STM32_DMA_ISR_TEIF) != 0U;
+
+  if (!error) {
+    if ((flags & STM32_DMA_ISR_TCIF) == 0U) {
+      return;
+    }
+    if (xfp->remaining > 0U) {
+      dma_xfer_next(xfp);
+      return;
+    }
+  }
+
+  dmaStreamDisable(xfp->dmastp);
+
+  /* Discarding cache lines possibly loaded during the transfer.*/
+  cacheBufferInvalidate(xfp->dst, xfp->size);
+
+  osalSysLockFromISR();
+  dmaStreamFreeI(xfp->dmastp);
+  xfp->dmastp = NULL;
+  osalSysUnlockFromISR();
+
+  if (xfp->cb != NULL) {
+    xfp->cb(xfp, error);
+  }
+}
+
+/**
+ * @brief   Starts a memory copy service operation.
+ *
+ * @param[in] xfp       pointer to the @p stm32_dma_xfer_t object
+ * @param[in] dst       destination buffer
+ * @param[in] src       source buffer or @p NULL for a set operation
+ * @param[in] n         number of bytes
+ * @param[in] cb        completion callback or @p NULL
+ * @param[in] param     application parameter
+ * @return              The operation status.
+ * @retval false        if the transfer has been started.
+ * @retval true         if the operation must be performed by the CPU.
+ *
+ * @notapi
+ */
+static bool dma_xfer_start(stm32_dma_xfer_t *xfp, void *dst, const void *src,
+                           size_t n, stm32_dmaxfercb_t cb, void *param) {
+  const stm32_dma_stream_t *dmastp = NULL;
+  uint32_t align, cr;
+
+  if (n < (size_t)STM32_DMA_MEMCPY_THRESHOLD) {
+    return true;
+  }
+
+  osalSysLock();
+#if STM32_DMA_SUPPORTS_DMAMUX == TRUE
+  dmastp = dmaStreamAllocI(STM32_DMA_STREAM_ID_ANY,
+                           STM32_DMA_MEMCPY_IRQ_PRIORITY,
+                           dma_xfer_serve_interrupt, (void *)xfp);
+#else
+  {
+    uint32_t id;
+
+    /* Only DMA2 is able to perform memory to memory transfers.*/
+    for (id = STM32_DMA_STREAM_ID(2U, 0U);
+         id <= STM32_DMA_STREAM_ID(2U, 7U);
+         id++) {
+      if ((dma.allocated_mask & (1U << id)) == 0U) {
+        dmastp = dmaStreamAllocI(id, STM32_DMA_MEMCPY_IRQ_PRIORITY,
+                                 dma_xfer_serve_interrupt, (void *)xfp);
+        break;
+      }
+    }
+  }
+#endif
+  osalSysUnlock();
+
+  if (dmastp == NULL) {
+    return true;
+  }
+
+  xfp->dmastp    = dmastp;
+  xfp->cb        = cb;
+  xfp->param     = param;
+  xfp->dst       = dst;
+  xfp->size      = n;
+  xfp->next_src  = (const uint8_t *)src;
+  xfp->next_dst  = (uint8_t *)dst;
+  xfp->remaining = n;
+
+  /* Widest data size allowed by the alignment, bursts require the FIFO
+     threshold to be a multiple of the burst size.*/
+  cr = STM32_DMA_CR_PL(STM32_DMA_MEMCPY_DMA_PRIORITY) |
+       STM32_DMA_CR_DIR_M2M | STM32_DMA_CR_MINC |
+       STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE;
+  align = (uint32_t)dst | (uint32_t)n;
+  if (src != NULL) {
+    cr    |= STM32_DMA_CR_PINC;
+    align |= (uint32_t)src;
+  }
+  if ((align & 15U) == 0U) {
+    cr |= STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+          STM32_DMA_CR_MBURST_INCR4;
+    if (src != NULL) {
+      cr |= STM32_DMA_CR_PBURST_INCR4;
+    }
+    xfp->chunk = (size_t)65532U * 4U;
+  }
+  else if ((align & 3U) == 0U) {
+    cr |= STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD;
+    xfp->chunk = (size_t)65535U * 4U;
+  }
+  else {
+    xfp->chunk = (size_t)65535U;
+  }
+  xfp->cr = cr;
+
+  /* Source data must be in memory, dirty destination lines must not be
+     evicted over the transferred data.*/
+  if (src != NULL) {
+    cacheBufferFlush(src, n);
+  }
+  cacheBufferFlush(dst, n);
+
+#if STM32_DMA_SUPPORTS_DMAMUX == TRUE
+  dmaSetRequestSource(dmastp, 0U);
+#endif
+  dmaStreamSetFIFO(dmastp, STM32_DMA_FCR_DMDIS | STM32_DMA_FCR_FTH_FULL);
+  dma_xfer_next(xfp);
+
+  return false;
+}
+#endif /* STM32_DMA_USE_MEMCPY == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -159,6 +340,7 @@ static struct {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH0_HANDLER) {
   uint32_t flags;
 
@@ -177,6 +359,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH0_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH1_HANDLER) {
   uint32_t flags;
 
@@ -195,6 +378,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH1_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH2_HANDLER) {
   uint32_t flags;
 
@@ -213,6 +397,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH2_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH3_HANDLER) {
   uint32_t flags;
 
@@ -231,6 +416,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH3_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH4_HANDLER) {
   uint32_t flags;
 
@@ -249,6 +435,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH4_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH5_HANDLER) {
   uint32_t flags;
 
@@ -267,6 +454,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH5_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH6_HANDLER) {
   uint32_t flags;
 
@@ -285,6 +473,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH6_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA1_CH7_HANDLER) {
   uint32_t flags;
 
@@ -303,6 +492,7 @@ OSAL_IRQ_HANDLER(STM32_DMA1_CH7_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH0_HANDLER) {
   uint32_t flags;
 
@@ -321,6 +511,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH0_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH1_HANDLER) {
   uint32_t flags;
 
@@ -339,6 +530,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH1_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH2_HANDLER) {
   uint32_t flags;
 
@@ -357,6 +549,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH2_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH3_HANDLER) {
   uint32_t flags;
 
@@ -375,6 +568,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH3_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH4_HANDLER) {
   uint32_t flags;
 
@@ -393,6 +587,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH4_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH5_HANDLER) {
   uint32_t flags;
 
@@ -411,6 +606,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH5_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH6_HANDLER) {
   uint32_t flags;
 
@@ -429,6 +625,7 @@ OSAL_IRQ_HANDLER(STM32_DMA2_CH6_HANDLER) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_DMA2_CH7_HANDLER) {
   uint32_t flags;
 
@@ -509,7 +706,7 @@ const stm32_dma_stream_t *dmaStreamAllocI(uint32_t id,
     endid   = (STM32_DMA_STREAMS / 2U) - 1U;
   }
   else if (id == STM32_DMA_STREAM_ID_ANY_DMA2) {
-    startid = (STM32_DMA_STREAMS / 2U) - 1U;
+    startid = STM32_DMA_STREAMS / 2U;
     endid   = STM32_DMA_STREAMS - 1U;
   }
 #endif
@@ -652,6 +849,100 @@ void dmaStreamFree(const stm32_dma_stream_t *dmastp) {
   osalSysUnlock();
 }
 
+/**
+ * @brief   Returns the mask of the allocated streams.
+ *
+ * @return              The allocated streams mask, bit N is stream N.
+ *
+ * @xclass
+ */
+uint32_t dmaGetAllocatedMaskX(void) {
+
+  return dma.allocated_mask;
+}
+
+#if (STM32_DMA_USE_MEMCPY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Copies a memory area using a DMA stream.
+ * @details The copy is performed by a memory to memory transfer, the
+ *          function returns immediately and the callback is invoked on
+ *          completion. Copies smaller than @p STM32_DMA_MEMCPY_THRESHOLD
+ *          bytes, or started when no stream is available, are performed
+ *          by the CPU before returning.
+ * @note    Data caches are handled by the driver. The destination buffer
+ *          should be aligned and sized to cache lines because lines shared
+ *          with other data are invalidated on completion.
+ * @note    On STM32H7 the DMA is not able to access the TCM memories.
+ * @note    The areas must not overlap.
+ *
+ * @param[out] xfp      pointer to a @p stm32_dma_xfer_t object
+ * @param[out] dst      destination buffer
+ * @param[in] src       source buffer
+ * @param[in] n         number of bytes to be copied
+ * @param[in] cb        completion callback or @p NULL
+ * @param[in] param     application parameter stored in the object
+ * @return              The operation mode.
+ * @retval false        if the transfer has been started, the callback is
+ *                      invoked on completion.
+ * @retval true         if the copy has been performed by the CPU, the
+ *                      callback is not invoked.
+ *
+ * @api
+ */
+bool dmaMemcpy(stm32_dma_xfer_t *xfp, void *dst, const void *src,
+               size_t n, stm32_dmaxfercb_t cb, void *param) {
+
+  osalDbgCheck((xfp != NULL) && (dst != NULL) && (src != NULL));
+
+  if (dma_xfer_start(xfp, dst, src, n, cb, param)) {
+    memcpy(dst, src, n);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Fills a memory area using a DMA stream.
+ * @details The fill is performed by a memory to memory transfer from a
+ *          fixed source address, the function returns immediately and the
+ *          callback is invoked on completion. Fills smaller than
+ *          @p STM32_DMA_MEMCPY_THRESHOLD bytes, or started when no stream
+ *          is available, are performed by the CPU before returning.
+ * @note    Data caches are handled by the driver. The destination buffer
+ *          should be aligned and sized to cache lines because lines shared
+ *          with other data are invalidated on completion.
+ * @note    On STM32H7 the DMA is not able to access the TCM memories.
+ *
+ * @param[out] xfp      pointer to a @p stm32_dma_xfer_t object
+ * @param[out] dst      destination buffer
+ * @param[in] c         fill value
+ * @param[in] n         number of bytes to be filled
+ * @param[in] cb        completion callback or @p NULL
+ * @param[in] param     application parameter stored in the object
+ * @return              The operation mode.
+ * @retval false        if the transfer has been started, the callback is
+ *                      invoked on completion.
+ * @retval true         if the fill has been performed by the CPU, the
+ *                      callback is not invoked.
+ *
+ * @api
+ */
+bool dmaMemset(stm32_dma_xfer_t *xfp, void *dst, uint8_t c,
+               size_t n, stm32_dmaxfercb_t cb, void *param) {
+
+  osalDbgCheck((xfp != NULL) && (dst != NULL));
+
+  xfp->pattern = (uint32_t)c * 0x01010101U;
+  if (dma_xfer_start(xfp, dst, NULL, n, cb, param)) {
+    memset(dst, (int)c, n);
+    return true;
+  }
+
+  return false;
+}
+#endif /* STM32_DMA_USE_MEMCPY == TRUE */
+
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Associates a peripheral request to a DMA stream.
@@ -251,10 +251,71 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the memory copy service.
+ * @note    Enabling the service also enables the DMA helper driver.
+ */
+#if !defined(STM32_DMA_USE_MEMCPY) || defined(__DOXYGEN__)
+#define STM32_DMA_USE_MEMCPY                FALSE
+#endif
+
+/**
+ * @brief   Memory copy service size threshold.
+ * @details Operations smaller than this number of bytes are performed by
+ *          the CPU because the DMA setup and completion overhead would
+ *          exceed the gain.
+ */
+#if !defined(STM32_DMA_MEMCPY_THRESHOLD) || defined(__DOXYGEN__)
+#define STM32_DMA_MEMCPY_THRESHOLD          256
+#endif
+
+/**
+ * @brief   Memory copy service DMA priority.
+ * @note    The default is the lowest priority so that peripheral streams
+ *          are not delayed by bulk copies.
+ */
+#if !defined(STM32_DMA_MEMCPY_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_DMA_MEMCPY_DMA_PRIORITY       0
+#endif
+
+/**
+ * @brief   Memory copy service DMA IRQ priority.
+ */
+#if !defined(STM32_DMA_MEMCPY_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_DMA_MEMCPY_IRQ_PRIORITY       12
+#endif
+/** @} */
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if STM32_DMA_USE_MEMCPY == TRUE
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+
+#if STM32_DMA_MEMCPY_THRESHOLD < 0
+#error "invalid STM32_DMA_MEMCPY_THRESHOLD value"
+#endif
+
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_DMA_MEMCPY_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to the memory copy service"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_DMA_MEMCPY_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to the memory copy service"
+#endif
+
+#if (STM32_DMA_SUPPORTS_DMAMUX == FALSE) && (STM32_HAS_DMA2 == FALSE)
+#error "the memory copy service requires DMA2"
+#endif
+#endif /* STM32_DMA_USE_MEMCPY == TRUE */
+
 #if !defined(STM32_DMA_SUPPORTS_DMAMUX)
 #error "STM32_DMA_SUPPORTS_DMAMUX not defined in registry"
 #endif
@@ -429,6 +490,73 @@ typedef struct {
   uint8_t               vector;         /**< @brief Associated IRQ vector.  */
 } stm32_dma_stream_t;
 
+#if (STM32_DMA_USE_MEMCPY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a memory copy service operation.
+ */
+typedef struct stm32_dma_xfer stm32_dma_xfer_t;
+
+/**
+ * @brief   Memory copy service completion callback type.
+ * @note    The callback is invoked from ISR context.
+ *
+ * @param[in] xfp       pointer to the @p stm32_dma_xfer_t object
+ * @param[in] error     @p true if the transfer failed
+ */
+typedef void (*stm32_dmaxfercb_t)(stm32_dma_xfer_t *xfp, bool error);
+
+/**
+ * @brief   Structure representing a memory copy service operation.
+ * @note    The object must stay valid until the operation completes.
+ */
+struct stm32_dma_xfer {
+  /**
+   * @brief   Stream used by the operation, @p NULL when not running.
+   */
+  const stm32_dma_stream_t  *dmastp;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  stm32_dmaxfercb_t         cb;
+  /**
+   * @brief   Application parameter, not used by the driver.
+   */
+  void                      *param;
+  /**
+   * @brief   Destination buffer.
+   */
+  void                      *dst;
+  /**
+   * @brief   Destination buffer size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Source pointer of the next chunk.
+   */
+  const uint8_t             *next_src;
+  /**
+   * @brief   Destination pointer of the next chunk.
+   */
+  uint8_t                   *next_dst;
+  /**
+   * @brief   Bytes not yet transferred.
+   */
+  size_t                    remaining;
+  /**
+   * @brief   Maximum bytes for a single chunk.
+   */
+  size_t                    chunk;
+  /**
+   * @brief   Stream CR register setting.
+   */
+  uint32_t                  cr;
+  /**
+   * @brief   Fill pattern for set operations.
+   */
+  uint32_t                  pattern;
+};
+#endif /* STM32_DMA_USE_MEMCPY == TRUE */
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -670,6 +798,13 @@ extern "C" {
                                            void *param);
   void dmaStreamFreeI(const stm32_dma_stream_t *dmastp);
   void dmaStreamFree(const stm32_dma_stream_t *dmastp);
+  uint32_t dmaGetAllocatedMaskX(void);
+#if STM32_DMA_USE_MEMCPY == TRUE
+  bool dmaMemcpy(stm32_dma_xfer_t *xfp, void *dst, const void *src,
+                 size_t n, stm32_dmaxfercb_t cb, void *param);
+  bool dmaMemset(stm32_dma_xfer_t *xfp, void *dst, uint8_t c,
+                 size_t n, stm32_dmaxfercb_t cb, void *param);
+#endif
 #if STM32_DMA_SUPPORTS_DMAMUX == TRUE
   void dmaSetRequestSource(const stm32_dma_stream_t *dmastp, uint32_t per);
 #endif
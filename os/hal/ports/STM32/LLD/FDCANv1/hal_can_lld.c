@@ -93,6 +93,12 @@
 #define TIMEOUT_INIT_MS                 250U
 #define TIMEOUT_CSA_MS                  250U
 
+/* Filter types, range and dual ID.*/
+#define FDCAN_SFT_RANGE                 0U
+#define FDCAN_SFT_DUAL                  1U
+#define FDCAN_EFT_RANGE_NO_MASK         3U
+#define FDCAN_EFT_DUAL                  1U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -127,6 +133,89 @@ static uint32_t canclk;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Writes a filter element.
+ * @note    Elements beyond the array size are only counted.
+ *
+ * @param[out] fp       pointer to the filter elements as words
+ * @param[in,out] cntp  pointer to the elements counter
+ * @param[in] n         number of elements in the array
+ * @param[in] ext       @p true for extended filter elements
+ * @param[in] ft        filter type
+ * @param[in] ec        filter element configuration
+ * @param[in] id1       first identifier
+ * @param[in] id2       second identifier
+ */
+static void fdcan_set_element(uint32_t *fp, uint32_t *cntp, uint32_t n,
+                              bool ext, uint32_t ft, uint32_t ec,
+                              uint32_t id1, uint32_t id2) {
+
+  if (*cntp < n) {
+    if (ext) {
+      fp[*cntp * 2U]      = (ec << 29U) | id1;
+      fp[*cntp * 2U + 1U] = (ft << 30U) | id2;
+    }
+    else {
+      fp[*cntp] = (ft << 30U) | (ec << 27U) | (id1 << 16U) | id2;
+    }
+  }
+  (*cntp)++;
+}
+
+/**
+ * @brief   Compiles a list of identifiers in filter elements.
+ * @details The list is sorted, runs of consecutive identifiers become range
+ *          elements and the remaining identifiers are paired in dual ID
+ *          elements.
+ *
+ * @param[out] fp       pointer to the filter elements as words
+ * @param[in] n         number of elements in the array
+ * @param[in,out] ids   identifiers list, it is sorted and overwritten
+ * @param[in] nids      number of identifiers
+ * @param[in] ext       @p true for extended filter elements
+ * @param[in] ec        filter element configuration
+ * @return              The number of elements required.
+ */
+static uint32_t fdcan_compile(uint32_t *fp, uint32_t n,
+                              uint32_t *ids, uint32_t nids,
+                              bool ext, uint32_t ec) {
+  uint32_t i, j, ns, cnt;
+
+  /* Insertion sort, the lists are expected to be short.*/
+  for (i = 1U; i < nids; i++) {
+    uint32_t id = ids[i];
+    for (j = i; (j > 0U) && (ids[j - 1U] > id); j--) {
+      ids[j] = ids[j - 1U];
+    }
+    ids[j] = id;
+  }
+
+  /* Ranges, the single identifiers are moved at the list start.*/
+  cnt = 0U;
+  ns  = 0U;
+  for (i = 0U; i < nids; i = j + 1U) {
+    for (j = i; ((j + 1U) < nids) && (ids[j + 1U] <= (ids[j] + 1U)); j++) {
+    }
+    if (ids[j] != ids[i]) {
+      fdcan_set_element(fp, &cnt, n, ext,
+                        ext ? FDCAN_EFT_RANGE_NO_MASK : FDCAN_SFT_RANGE,
+                        ec, ids[i], ids[j]);
+    }
+    else {
+      ids[ns++] = ids[i];
+    }
+  }
+
+  /* Pairs of single identifiers.*/
+  for (i = 0U; i < ns; i += 2U) {
+    fdcan_set_element(fp, &cnt, n, ext,
+                      ext ? FDCAN_EFT_DUAL : FDCAN_SFT_DUAL, ec,
+                      ids[i], ((i + 1U) < ns) ? ids[i + 1U] : ids[i]);
+  }
+
+  return cnt;
+}
+
 static bool fdcan_clock_stop(CANDriver *canp) {
   systime_t start, end;
 
@@ -203,6 +292,10 @@ void can_lld_init(void) {
   canObjectInit(&CAND1);
   CAND1.fdcan = FDCAN1;
   CAND1.ram_base = (uint32_t *)(SRAMCAN_BASE + 0U * SRAMCAN_SIZE);
+  CAND1.std_filters = NULL;
+  CAND1.std_filters_num = 0U;
+  CAND1.ext_filters = NULL;
+  CAND1.ext_filters_num = 0U;
 #endif
 
 #if STM32_CAN_USE_FDCAN2
@@ -210,6 +303,10 @@ void can_lld_init(void) {
   canObjectInit(&CAND2);
   CAND2.fdcan = FDCAN2;
   CAND2.ram_base = (uint32_t *)(SRAMCAN_BASE + 1U * SRAMCAN_SIZE);
+  CAND2.std_filters = NULL;
+  CAND2.std_filters_num = 0U;
+  CAND2.ext_filters = NULL;
+  CAND2.ext_filters_num = 0U;
 #endif
 
 #if STM32_CAN_USE_FDCAN3
@@ -217,6 +314,10 @@ void can_lld_init(void) {
   canObjectInit(&CAND3);
   CAND3.fdcan = FDCAN3;
   CAND3.ram_base = (uint32_t *)(SRAMCAN_BASE + 2U * SRAMCAN_SIZE);
+  CAND3.std_filters = NULL;
+  CAND3.std_filters_num = 0U;
+  CAND3.ext_filters = NULL;
+  CAND3.ext_filters_num = 0U;
 #endif
 }
 
@@ -286,6 +387,25 @@ bool can_lld_start(CANDriver *canp) {
   canp->fdcan->TEST   = canp->config->TEST;
   canp->fdcan->RXGFC  = canp->config->RXGFC;
 
+  /* Loading the filter elements, if any, and the lists sizes.*/
+  if (canp->std_filters_num > 0U) {
+    uint32_t *fp = canp->ram_base + (SRAMCAN_FLSSA / sizeof (uint32_t));
+    for (uint32_t i = 0U; i < canp->std_filters_num; i++) {
+      fp[i] = canp->std_filters[i].data32;
+    }
+    canp->fdcan->RXGFC = (canp->fdcan->RXGFC & ~FDCAN_RXGFC_LSS) |
+                         (canp->std_filters_num << FDCAN_RXGFC_LSS_Pos);
+  }
+  if (canp->ext_filters_num > 0U) {
+    uint32_t *fp = canp->ram_base + (SRAMCAN_FLESA / sizeof (uint32_t));
+    for (uint32_t i = 0U; i < canp->ext_filters_num; i++) {
+      fp[i * 2U]      = canp->ext_filters[i].data32[0];
+      fp[i * 2U + 1U] = canp->ext_filters[i].data32[1];
+    }
+    canp->fdcan->RXGFC = (canp->fdcan->RXGFC & ~FDCAN_RXGFC_LSE) |
+                         (canp->ext_filters_num << FDCAN_RXGFC_LSE_Pos);
+  }
+
   /* Enabling interrupts, only using interrupt zero.*/
   canp->fdcan->IR     = (uint32_t)-1;
   canp->fdcan->IE     = FDCAN_IE_RF1NE | FDCAN_IE_RF1LE |
@@ -580,6 +700,94 @@ void can_lld_serve_interrupt(CANDriver *canp) {
   }
 }
 
+/**
+ * @brief   Sets the filter elements.
+ * @details The elements are loaded in the message RAM when the driver is
+ *          started, frames not matching any element are handled as
+ *          specified by the @p RXGFC field of the configuration.
+ * @note    This is an STM32-specific API.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] sfp       pointer to the standard filter elements, can be
+ *                      @p NULL if (sfn == 0)
+ * @param[in] sfn       number of standard filter elements
+ * @param[in] efp       pointer to the extended filter elements, can be
+ *                      @p NULL if (efn == 0)
+ * @param[in] efn       number of extended filter elements
+ *
+ * @api
+ */
+void canSTM32SetFilters(CANDriver *canp,
+                        const CANRxStandardFilter *sfp, uint32_t sfn,
+                        const CANRxExtendedFilter *efp, uint32_t efn) {
+
+  osalDbgCheck((canp != NULL) &&
+               (sfn <= STM32_FDCAN_FLS_NBR) && ((sfn == 0U) || (sfp != NULL)) &&
+               (efn <= STM32_FDCAN_FLE_NBR) && ((efn == 0U) || (efp != NULL)));
+  osalDbgAssert(canp->state == CAN_STOP, "invalid state");
+
+  canp->std_filters     = sfp;
+  canp->std_filters_num = sfn;
+  canp->ext_filters     = efp;
+  canp->ext_filters_num = efn;
+}
+
+/**
+ * @brief   Compiles a list of standard identifiers in filter elements.
+ * @details The list is sorted, runs of consecutive identifiers become range
+ *          elements and the remaining identifiers are paired in dual ID
+ *          elements.
+ * @note    This is an STM32-specific API.
+ *
+ * @param[out] sfp      pointer to the standard filter elements array
+ * @param[in] n         number of elements in the array
+ * @param[in,out] ids   identifiers list, it is sorted and overwritten
+ * @param[in] nids      number of identifiers
+ * @param[in] mailbox   receive mailbox of the matching frames, 1 or 2
+ * @return              The number of elements required, if greater than
+ *                      @p n then the array has not been completely filled.
+ *
+ * @api
+ */
+uint32_t canSTM32CompileStandardFilters(CANRxStandardFilter *sfp,
+                                        uint32_t n, uint32_t *ids,
+                                        uint32_t nids, canmbx_t mailbox) {
+
+  osalDbgCheck((sfp != NULL) && (ids != NULL) &&
+               ((mailbox == 1U) || (mailbox == 2U)));
+
+  return fdcan_compile((uint32_t *)(void *)sfp, n, ids, nids,
+                       false, (uint32_t)mailbox);
+}
+
+/**
+ * @brief   Compiles a list of extended identifiers in filter elements.
+ * @details The list is sorted, runs of consecutive identifiers become range
+ *          elements and the remaining identifiers are paired in dual ID
+ *          elements.
+ * @note    This is an STM32-specific API.
+ *
+ * @param[out] efp      pointer to the extended filter elements array
+ * @param[in] n         number of elements in the array
+ * @param[in,out] ids   identifiers list, it is sorted and overwritten
+ * @param[in] nids      number of identifiers
+ * @param[in] mailbox   receive mailbox of the matching frames, 1 or 2
+ * @return              The number of elements required, if greater than
+ *                      @p n then the array has not been completely filled.
+ *
+ * @api
+ */
+uint32_t canSTM32CompileExtendedFilters(CANRxExtendedFilter *efp,
+                                        uint32_t n, uint32_t *ids,
+                                        uint32_t nids, canmbx_t mailbox) {
+
+  osalDbgCheck((efp != NULL) && (ids != NULL) &&
+               ((mailbox == 1U) || (mailbox == 2U)));
+
+  return fdcan_compile((uint32_t *)(void *)efp, n, ids, nids,
+                       true, (uint32_t)mailbox);
+}
+
 #endif /* HAL_USE_CAN */
 
 /** @} */
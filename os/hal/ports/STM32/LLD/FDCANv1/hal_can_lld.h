@@ -436,6 +436,22 @@ struct CANDriver {
    * @brief   Pointer to FDCAN RAM base.
    */
   uint32_t                  *ram_base;
+  /**
+   * @brief   Standard filters loaded on start or @p NULL.
+   */
+  const CANRxStandardFilter *std_filters;
+  /**
+   * @brief   Number of standard filters.
+   */
+  uint32_t                  std_filters_num;
+  /**
+   * @brief   Extended filters loaded on start or @p NULL.
+   */
+  const CANRxExtendedFilter *ext_filters;
+  /**
+   * @brief   Number of extended filters.
+   */
+  uint32_t                  ext_filters_num;
 };
 
 /*===========================================================================*/
@@ -479,6 +495,15 @@ extern "C" {
   void can_lld_wakeup(CANDriver *canp);
 #endif /* CAN_USE_SLEEP_MODE */
   void can_lld_serve_interrupt(CANDriver *canp);
+  void canSTM32SetFilters(CANDriver *canp,
+                          const CANRxStandardFilter *sfp, uint32_t sfn,
+                          const CANRxExtendedFilter *efp, uint32_t efn);
+  uint32_t canSTM32CompileStandardFilters(CANRxStandardFilter *sfp,
+                                          uint32_t n, uint32_t *ids,
+                                          uint32_t nids, canmbx_t mailbox);
+  uint32_t canSTM32CompileExtendedFilters(CANRxExtendedFilter *efp,
+                                          uint32_t n, uint32_t *ids,
+                                          uint32_t nids, canmbx_t mailbox);
 #ifdef __cplusplus
 }
 #endif
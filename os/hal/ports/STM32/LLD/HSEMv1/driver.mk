@@ -0,0 +1,2 @@
+PLATFORMSRC += $(CHIBIOS)/os/hal/ports/STM32/LLD/HSEMv1/stm32_hsem.c
+PLATFORMINC += $(CHIBIOS)/os/hal/ports/STM32/LLD/HSEMv1
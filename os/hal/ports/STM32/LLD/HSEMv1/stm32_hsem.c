@@ -0,0 +1,191 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    HSEMv1/stm32_hsem.c
+ * @brief   HSEM helper driver code.
+ *
+ * @addtogroup STM32_HSEM
+ * @details HSEM helper driver. The hardware semaphores are used for
+ *          mutual exclusion between the cores and as doorbells: a core
+ *          enables the free notification of a semaphore, the other core
+ *          rings the doorbell by locking and unlocking the semaphore.
+ * @note    The HSEM ISR handler is declared into this module, the free
+ *          notifications are dispatched to the callbacks registered using
+ *          @p hsemEnableNotificationI().
+ * @{
+ */
+
+#include "hal.h"
+
+/* The following macro is only defined if some driver requiring HSEM services
+   has been enabled.*/
+#if defined(STM32_HSEM_REQUIRED) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Global HSEM-related data structures.
+ */
+static struct {
+  /**
+   * @brief   Notification callbacks.
+   */
+  stm32_hsemisr_t       func[STM32_HSEM_SEMAPHORES];
+  /**
+   * @brief   Notification callbacks parameters.
+   */
+  void                  *param[STM32_HSEM_SEMAPHORES];
+} hsem;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   HSEM interrupt handler of the current core.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_HSEM_HANDLER) {
+  uint32_t misr, id;
+
+  OSAL_IRQ_PROLOGUE();
+
+  misr = HSEM_COMMON->MISR;
+  HSEM_COMMON->ICR = misr;
+
+  for (id = 0U; misr != 0U; id++, misr >>= 1) {
+    if (((misr & 1U) != 0U) && (hsem.func[id] != NULL)) {
+      osalSysLockFromISR();
+      hsem.func[id](hsem.param[id]);
+      osalSysUnlockFromISR();
+    }
+  }
+
+  OSAL_IRQ_EPILOGUE();
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   STM32 HSEM helper initialization.
+ * @note    The notifications of the current core are disabled, the
+ *          semaphores state is not changed because it is shared with the
+ *          other core.
+ *
+ * @init
+ */
+void hsemInit(void) {
+  unsigned i;
+
+  rccEnableAHB4(RCC_AHB4ENR_HSEMEN, true);
+
+  for (i = 0U; i < STM32_HSEM_SEMAPHORES; i++) {
+    hsem.func[i]  = NULL;
+    hsem.param[i] = NULL;
+  }
+  HSEM_COMMON->IER = 0U;
+  HSEM_COMMON->ICR = 0xFFFFFFFFU;
+
+  nvicEnableVector(STM32_HSEM_NUMBER, STM32_IRQ_HSEM_PRIORITY);
+}
+
+/**
+ * @brief   Enables the free notification of a semaphore.
+ * @details The callback is invoked, from ISR context and with the kernel
+ *          locked, each time the semaphore is unlocked by any core.
+ *
+ * @param[in] id        semaphore id
+ * @param[in] func      notification callback
+ * @param[in] param     a parameter to be passed to the callback
+ *
+ * @iclass
+ */
+void hsemEnableNotificationI(uint32_t id, stm32_hsemisr_t func, void *param) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(STM32_HSEM_IS_VALID_ID(id) && (func != NULL));
+  osalDbgAssert(hsem.func[id] == NULL, "already enabled");
+
+  hsem.func[id]     = func;
+  hsem.param[id]    = param;
+  HSEM_COMMON->ICR  = 1U << id;
+  HSEM_COMMON->IER |= 1U << id;
+}
+
+/**
+ * @brief   Disables the free notification of a semaphore.
+ *
+ * @param[in] id        semaphore id
+ *
+ * @iclass
+ */
+void hsemDisableNotificationI(uint32_t id) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(STM32_HSEM_IS_VALID_ID(id));
+
+  HSEM_COMMON->IER &= ~(1U << id);
+  HSEM_COMMON->ICR  = 1U << id;
+  hsem.func[id]     = NULL;
+}
+
+/**
+ * @brief   Rings a doorbell.
+ * @details The semaphore is locked and immediately unlocked, the free
+ *          notification is generated on the cores having enabled it.
+ * @note    A semaphore used as doorbell must not be used for mutual
+ *          exclusion.
+ *
+ * @param[in] id        semaphore id
+ * @return              The operation status.
+ * @retval false        if the doorbell has been rung.
+ * @retval true         if the semaphore was locked by another core.
+ *
+ * @xclass
+ */
+bool hsemRingDoorbellX(uint32_t id) {
+
+  osalDbgCheck(STM32_HSEM_IS_VALID_ID(id));
+
+  if (hsemTryLockX(id)) {
+    return true;
+  }
+  hsemUnlockX(id);
+
+  return false;
+}
+
+#endif /* STM32_HSEM_REQUIRED */
+
+/** @} */
@@ -0,0 +1,163 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    HSEMv1/stm32_hsem.h
+ * @brief   HSEM helper driver header.
+ * @note    The helper is enabled by defining @p STM32_HSEM_REQUIRED in
+ *          mcuconf.h or in a driver header.
+ *
+ * @addtogroup STM32_HSEM
+ * @{
+ */
+
+#ifndef STM32_HSEM_H
+#define STM32_HSEM_H
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Total number of hardware semaphores.
+ */
+#define STM32_HSEM_SEMAPHORES       32U
+
+/**
+ * @brief   Checks if a semaphore id is within the valid range.
+ *
+ * @param[in] id        semaphore id
+ * @retval              The check result.
+ * @retval false        invalid semaphore.
+ * @retval true         correct semaphore.
+ */
+#define STM32_HSEM_IS_VALID_ID(id)  ((id) < STM32_HSEM_SEMAPHORES)
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   HSEM interrupt priority level setting.
+ */
+#if !defined(STM32_IRQ_HSEM_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_IRQ_HSEM_PRIORITY     10
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(STM32_HAS_HSEM)
+#error "STM32_HAS_HSEM missing in registry"
+#endif
+
+#if STM32_HAS_HSEM == FALSE
+#error "HSEM not present in the selected device"
+#endif
+
+/* Each core has its own HSEM interrupt line.*/
+#if defined(CORE_CM4)
+#define STM32_HSEM_HANDLER          STM32_HSEM2_HANDLER
+#define STM32_HSEM_NUMBER           STM32_HSEM2_NUMBER
+#else
+#define STM32_HSEM_HANDLER          STM32_HSEM1_HANDLER
+#define STM32_HSEM_NUMBER           STM32_HSEM1_NUMBER
+#endif
+
+#if !defined(STM32_HSEM_HANDLER)
+#error "STM32_HSEMn_HANDLER missing in registry"
+#endif
+
+#if !defined(STM32_HSEM_NUMBER)
+#error "STM32_HSEMn_NUMBER missing in registry"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_IRQ_HSEM_PRIORITY)
+#error "Invalid IRQ priority assigned to STM32_IRQ_HSEM_PRIORITY"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   STM32 HSEM notification function type.
+ *
+ * @param[in] p         parameter for the registered function
+ */
+typedef void (*stm32_hsemisr_t)(void *p);
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Tries to lock a semaphore.
+ * @details The semaphore is locked using the 1-step read lock procedure
+ *          with process identifier zero.
+ *
+ * @param[in] id        semaphore id
+ * @return              The operation status.
+ * @retval false        if the semaphore has been locked.
+ * @retval true         if the semaphore is already locked.
+ *
+ * @xclass
+ */
+#define hsemTryLockX(id)                                                    \
+  (bool)(HSEM->RLR[id] != (HSEM_R_LOCK | HSEM_CR_COREID_CURRENT))
+
+/**
+ * @brief   Unlocks a semaphore.
+ * @details A free notification is generated on the cores having enabled
+ *          the notification for the semaphore.
+ *
+ * @param[in] id        semaphore id
+ *
+ * @xclass
+ */
+#define hsemUnlockX(id) (HSEM->R[id] = HSEM_CR_COREID_CURRENT)
+
+/**
+ * @brief   Checks if a semaphore is locked.
+ *
+ * @param[in] id        semaphore id
+ * @return              The semaphore status.
+ * @retval false        if the semaphore is free.
+ * @retval true         if the semaphore is locked.
+ *
+ * @xclass
+ */
+#define hsemIsLockedX(id) (bool)((HSEM->R[id] & HSEM_R_LOCK) != 0U)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void hsemInit(void);
+  void hsemEnableNotificationI(uint32_t id, stm32_hsemisr_t func, void *param);
+  void hsemDisableNotificationI(uint32_t id);
+  bool hsemRingDoorbellX(uint32_t id);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_HSEM_H */
+
+/** @} */
@@ -51,6 +51,11 @@
 #define STM32_TIMINGR_SCLL(n)           ((n) << 0)
 /** @} */
 
+/**
+ * @brief   The requests queue is supported.
+ */
+#define I2C_LLD_SUPPORTS_QUEUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -400,6 +405,25 @@ struct I2CDriver {
 #if I2C_USE_MUTUAL_EXCLUSION || defined(__DOXYGEN__)
   mutex_t                   mutex;
 #endif /* I2C_USE_MUTUAL_EXCLUSION */
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Pending requests, in priority order.
+   */
+  i2c_request_t             *qhead;
+  /**
+   * @brief   Request in progress or @p NULL.
+   */
+  i2c_request_t             *qcurr;
+  /**
+   * @brief   Current segment of the request in progress or @p NULL.
+   */
+  const i2c_segment_t       *segp;
+  /**
+   * @brief   Segments left in the request in progress, including the
+   *          current one.
+   */
+  size_t                    segn;
+#endif /* I2C_USE_QUEUE == TRUE */
 #if defined(I2C_DRIVER_EXT_FIELDS)
   I2C_DRIVER_EXT_FIELDS
 #endif
@@ -498,6 +522,9 @@ extern "C" {
   msg_t i2c_lld_master_receive_timeout(I2CDriver *i2cp, i2caddr_t addr,
                                        uint8_t *rxbuf, size_t rxbytes,
                                        sysinterval_t timeout);
+#if I2C_USE_QUEUE == TRUE
+  void i2c_lld_start_segment(I2CDriver *i2cp, const i2c_segment_t *sp);
+#endif
 #ifdef __cplusplus
 }
 #endif
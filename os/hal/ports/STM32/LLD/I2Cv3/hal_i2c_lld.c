@@ -331,11 +331,33 @@ static void i2c_lld_serve_interrupt(I2CDriver *i2cp, uint32_t isr) {
     /* Make sure no more interrupts.*/
     dp->CR1 &= ~(I2C_CR1_TCIE | I2C_CR1_TXIE | I2C_CR1_RXIE);
 
-    /* Errors are signaled to the upper layer.*/
-    _i2c_wakeup_error_isr(i2cp);
+#if I2C_USE_QUEUE == TRUE
+    if (i2cp->segp != NULL) {
+      /* Queued request, it is completed on the STOP condition.*/
+      dp->CR1 |= I2C_CR1_STOPIE;
+      if ((isr & I2C_ISR_STOPF) == 0U) {
+        return;
+      }
+    }
+    else
+#endif
+    {
+      /* Errors are signaled to the upper layer.*/
+      _i2c_wakeup_error_isr(i2cp);
+
+      return;
+    }
+  }
 
+#if I2C_USE_QUEUE == TRUE
+  /* End of a queued request, the STOP condition has been sent.*/
+  if (((isr & I2C_ISR_STOPF) != 0U) && ((dp->CR1 & I2C_CR1_STOPIE) != 0U)) {
+    dp->CR1 &= ~I2C_CR1_STOPIE;
+    i2cp->state = I2C_READY;
+    _i2c_isr_end_request(i2cp);
     return;
   }
+#endif
 
 #if STM32_I2C_USE_DMA == FALSE
   /* Handling of data transfer if the DMA mode is disabled.*/
@@ -419,6 +441,18 @@ static void i2c_lld_serve_interrupt(I2CDriver *i2cp, uint32_t isr) {
 #endif
     }
 
+#if I2C_USE_QUEUE == TRUE
+    if (i2cp->segp != NULL) {
+      /* Queued request, the next segment is chained with a repeated start
+         else the request is completed on the STOP condition.*/
+      if (!_i2c_isr_next_segment(i2cp)) {
+        dp->CR2 |= I2C_CR2_STOP;
+        dp->CR1 = (dp->CR1 & ~I2C_CR1_TCIE) | I2C_CR1_STOPIE;
+      }
+      return;
+    }
+#endif
+
     /* Transaction finished sending the STOP.*/
     dp->CR2 |= I2C_CR2_STOP;
 
@@ -462,8 +496,20 @@ static void i2c_lld_serve_error_interrupt(I2CDriver *i2cp, uint32_t isr) {
     i2cp->errors |= I2C_TIMEOUT;
 
   /* If some error has been identified then wake the waiting thread.*/
-  if (i2cp->errors != I2C_NO_ERROR)
+  if (i2cp->errors != I2C_NO_ERROR) {
+#if I2C_USE_QUEUE == TRUE
+    if (i2cp->segp != NULL) {
+      /* Queued request, the peripheral is reset and the next request is
+         started.*/
+      i2c_lld_abort_operation(i2cp);
+      i2cp->i2c->CR1 &= ~(I2C_CR1_TCIE | I2C_CR1_STOPIE);
+      i2cp->state = I2C_READY;
+      _i2c_isr_end_request(i2cp);
+      return;
+    }
+#endif
     _i2c_wakeup_error_isr(i2cp);
+  }
 }
 
 /*===========================================================================*/
@@ -1311,6 +1357,92 @@ msg_t i2c_lld_master_transmit_timeout(I2CDriver *i2cp, i2caddr_t addr,
   return msg;
 }
 
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a request segment.
+ * @details The segment is started with a START condition, it is a repeated
+ *          start if the previous segment has not been terminated with a
+ *          STOP. The segment completion is handled in the ISR.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] sp        pointer to the @p i2c_segment_t object
+ *
+ * @notapi
+ */
+void i2c_lld_start_segment(I2CDriver *i2cp, const i2c_segment_t *sp) {
+  I2C_TypeDef *dp = i2cp->i2c;
+
+  osalDbgCheck((sp->txbytes > 0U) || (sp->rxbytes > 0U));
+
+  /* Sizes of transfer phases.*/
+  i2cp->txbytes = sp->txbytes;
+  i2cp->rxbytes = sp->rxbytes;
+
+#if STM32_I2C_USE_DMA == TRUE
+  /* TX and RX DMA setup.*/
+#if defined(STM32_I2C_DMA_REQUIRED) && defined(STM32_I2C_BDMA_REQUIRED)
+  if (i2cp->is_bdma)
+#endif
+#if defined(STM32_I2C_BDMA_REQUIRED)
+  {
+    bdmaStreamSetMode(i2cp->tx.bdma, i2cp->txdmamode);
+    bdmaStreamSetMemory(i2cp->tx.bdma, sp->txbuf);
+    bdmaStreamSetTransactionSize(i2cp->tx.bdma, sp->txbytes);
+
+    bdmaStreamSetMode(i2cp->rx.bdma, i2cp->rxdmamode);
+    bdmaStreamSetMemory(i2cp->rx.bdma, sp->rxbuf);
+    bdmaStreamSetTransactionSize(i2cp->rx.bdma, sp->rxbytes);
+  }
+#endif
+#if defined(STM32_I2C_DMA_REQUIRED) && defined(STM32_I2C_BDMA_REQUIRED)
+  else
+#endif
+#if defined(STM32_I2C_DMA_REQUIRED)
+  {
+    dmaStreamSetMode(i2cp->tx.dma, i2cp->txdmamode);
+    dmaStreamSetMemory0(i2cp->tx.dma, sp->txbuf);
+    dmaStreamSetTransactionSize(i2cp->tx.dma, sp->txbytes);
+
+    dmaStreamSetMode(i2cp->rx.dma, i2cp->rxdmamode);
+    dmaStreamSetMemory0(i2cp->rx.dma, sp->rxbuf);
+    dmaStreamSetTransactionSize(i2cp->rx.dma, sp->rxbytes);
+  }
+#endif
+#else
+  i2cp->txptr = sp->txbuf;
+  i2cp->rxptr = sp->rxbuf;
+#endif
+
+  /* Setting up the slave address.*/
+  i2c_lld_set_address(i2cp, sp->addr);
+
+  if (sp->txbytes > 0U) {
+    /* Write phase, the read phase follows from the ISR if required.*/
+    i2c_lld_setup_tx_transfer(i2cp);
+#if STM32_I2C_USE_DMA == TRUE
+    i2c_lld_start_tx_dma(i2cp);
+#else
+    dp->CR1 |= I2C_CR1_TXIE;
+#endif
+    i2cp->state = I2C_ACTIVE_TX;
+  }
+  else {
+    /* Read only segment.*/
+    i2c_lld_setup_rx_transfer(i2cp);
+#if STM32_I2C_USE_DMA == TRUE
+    i2c_lld_start_rx_dma(i2cp);
+#else
+    dp->CR1 |= I2C_CR1_RXIE;
+#endif
+    i2cp->state = I2C_ACTIVE_RX;
+  }
+
+  /* Transfer complete interrupt enabled and start.*/
+  dp->CR1 |= I2C_CR1_TCIE;
+  dp->CR2 |= I2C_CR2_START;
+}
+#endif /* I2C_USE_QUEUE == TRUE */
+
 #endif /* HAL_USE_I2C */
 
 /** @} */
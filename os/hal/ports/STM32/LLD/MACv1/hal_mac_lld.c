@@ -36,6 +36,27 @@
 
 #define BUFFER_SIZE ((((STM32_MAC_BUFFERS_SIZE - 1) | 3) + 1) / 4)
 
+#if MAC_USE_PTP
+/* PTP clock increment in nanoseconds, the accumulator overflows at half
+   the HCLK frequency at most.*/
+#define PTP_SSINC   ((2000000000U + STM32_HCLK - 1U) / STM32_HCLK)
+
+/* Nominal addend, the accumulator overflows at 1GHz / PTP_SSINC.*/
+#define PTP_ADDEND  ((uint32_t)((1000000000ULL << 32) /                     \
+                                ((uint64_t)PTP_SSINC * (uint64_t)STM32_HCLK)))
+
+/* Missing or misnamed definitions in ST headers.*/
+#if !defined(ETH_DMABMR_EDFE)
+#define ETH_DMABMR_EDFE (1U << 7)
+#endif
+#if !defined(ETH_PTPTSCR_TSSARFE) && defined(ETH_PTPTSSR_TSSARFE)
+#define ETH_PTPTSCR_TSSARFE ETH_PTPTSSR_TSSARFE
+#endif
+#if !defined(ETH_PTPTSCR_TSSSR) && defined(ETH_PTPTSSR_TSSSR)
+#define ETH_PTPTSCR_TSSSR ETH_PTPTSSR_TSSSR
+#endif
+#endif
+
 /* Fixing inconsistencies in ST headers.*/
 #if !defined(ETH_MACMIIAR_CR_Div102) && defined(ETH_MACMIIAR_CR_DIV102)
 #define ETH_MACMIIAR_CR_Div102 ETH_MACMIIAR_CR_DIV102
@@ -237,6 +258,12 @@ void mac_lld_init(void) {
      word is not initialized here but in mac_lld_start().*/
   for (i = 0; i < STM32_MAC_RECEIVE_BUFFERS; i++) {
     __eth_rd[i].rdes1 = STM32_RDES1_RCH | STM32_MAC_BUFFERS_SIZE;
+#if STM32_MAC_RX_COALESCE_FRAMES > 1
+    /* Only one descriptor every STM32_MAC_RX_COALESCE_FRAMES raises the
+       interrupt, the others are signaled by the watchdog timer.*/
+    if ((i % STM32_MAC_RX_COALESCE_FRAMES) != (STM32_MAC_RX_COALESCE_FRAMES - 1))
+      __eth_rd[i].rdes1 |= STM32_RDES1_DIC;
+#endif
     __eth_rd[i].rdes2 = (uint32_t)__eth_rb[i];
     __eth_rd[i].rdes3 = (uint32_t)&__eth_rd[(i + 1) % STM32_MAC_RECEIVE_BUFFERS];
   }
@@ -343,6 +370,24 @@ void mac_lld_start(MACDriver *macp) {
   else
     mac_lld_set_address(macp->config->mac_address);
 
+#if MAC_USE_PTP
+  /* PTP clock setup, fine correction with digital rollover, all the
+     frames are time stamped.*/
+  ETH->PTPTSCR   = ETH_PTPTSCR_TSE | ETH_PTPTSCR_TSFCU |
+                   ETH_PTPTSCR_TSSARFE | ETH_PTPTSCR_TSSSR;
+  ETH->PTPSSIR   = PTP_SSINC;
+  macp->ptpaddend = PTP_ADDEND;
+  ETH->PTPTSAR   = PTP_ADDEND;
+  ETH->PTPTSCR  |= ETH_PTPTSCR_TSARU;
+  while (ETH->PTPTSCR & ETH_PTPTSCR_TSARU)
+    ;
+  ETH->PTPTSHUR  = 0;
+  ETH->PTPTSLUR  = 0;
+  ETH->PTPTSCR  |= ETH_PTPTSCR_TSSTI;
+  while (ETH->PTPTSCR & ETH_PTPTSCR_TSSTI)
+    ;
+#endif
+
   /* Transmitter and receiver enabled.
      Note that the complete setup of the MAC is performed when the link
      status is detected.*/
@@ -357,12 +402,23 @@ void mac_lld_start(MACDriver *macp) {
   ETH->DMARDLAR = (uint32_t)__eth_rd;
   ETH->DMATDLAR = (uint32_t)__eth_td;
 
+#if STM32_MAC_RX_COALESCE_FRAMES > 1
+  /* Receive watchdog for the coalesced frames.*/
+  ETH->DMARSWTR = STM32_MAC_RX_COALESCE_TIMEOUT;
+#endif
+
   /* Enabling required interrupt sources.*/
   ETH->DMASR    = ETH->DMASR;
   ETH->DMAIER   = ETH_DMAIER_NISE | ETH_DMAIER_RIE | ETH_DMAIER_TIE;
 
-  /* DMA general settings.*/
+  /* DMA general settings, the enhanced descriptors format is required for
+     the time stamps.*/
+#if MAC_USE_PTP
+  ETH->DMABMR   = ETH_DMABMR_AAB | ETH_DMABMR_RDP_1Beat | ETH_DMABMR_PBL_1Beat |
+                  ETH_DMABMR_EDFE;
+#else
   ETH->DMABMR   = ETH_DMABMR_AAB | ETH_DMABMR_RDP_1Beat | ETH_DMABMR_PBL_1Beat;
+#endif
 
   /* Check because errata on some devices. There should be no need to
      disable flushing because the TXFIFO should be empty on macStart().*/
@@ -467,9 +523,15 @@ void mac_lld_release_transmit_descriptor(MACTransmitDescriptor *tdp) {
 
   /* Unlocks the descriptor and returns it to the DMA engine.*/
   tdp->physdesc->tdes1 = tdp->offset;
+#if MAC_USE_PTP
+  tdp->physdesc->tdes0 = STM32_TDES0_CIC(STM32_MAC_IP_CHECKSUM_OFFLOAD) |
+                         STM32_TDES0_IC | STM32_TDES0_LS | STM32_TDES0_FS |
+                         STM32_TDES0_TCH | STM32_TDES0_TTSE | STM32_TDES0_OWN;
+#else
   tdp->physdesc->tdes0 = STM32_TDES0_CIC(STM32_MAC_IP_CHECKSUM_OFFLOAD) |
                          STM32_TDES0_IC | STM32_TDES0_LS | STM32_TDES0_FS |
                          STM32_TDES0_TCH | STM32_TDES0_OWN;
+#endif
 
   /* Wait for the write to tdes0 to go through before resuming the DMA.*/
   __DSB();
@@ -505,7 +567,13 @@ msg_t mac_lld_get_receive_descriptor(MACDriver *macp,
      frames are discarded.*/
   while (!(rdes->rdes0 & STM32_RDES0_OWN)) {
     if (!(rdes->rdes0 & (STM32_RDES0_AFM | STM32_RDES0_ES))
-#if STM32_MAC_IP_CHECKSUM_OFFLOAD
+#if STM32_MAC_IP_CHECKSUM_OFFLOAD && MAC_USE_PTP
+        /* In the enhanced format the checksum errors are reported in the
+           extended status.*/
+        && (rdes->rdes0 & STM32_RDES0_FT)
+        && !((rdes->rdes0 & STM32_RDES0_ESA) &&
+             (rdes->rdes4 & (STM32_RDES4_IPHE | STM32_RDES4_IPPE)))
+#elif STM32_MAC_IP_CHECKSUM_OFFLOAD
         && (rdes->rdes0 & STM32_RDES0_FT)
         && !(rdes->rdes0 & (STM32_RDES0_IPHCE | STM32_RDES0_PCE))
 #endif
@@ -753,6 +821,143 @@ const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
 }
 #endif /* MAC_USE_ZERO_COPY */
 
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the current PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tp       pointer to the time value
+ *
+ * @notapi
+ */
+void mac_lld_ptp_get_time(MACDriver *macp, mac_ptp_time_t *tp) {
+  uint32_t sec;
+
+  (void)macp;
+
+  /* The seconds are read again in order to detect a rollover between the
+     two reads.*/
+  do {
+    sec      = ETH->PTPTSHR;
+    tp->nsec = ETH->PTPTSLR & ETH_PTPTSLR_STSS;
+  } while (sec != ETH->PTPTSHR);
+  tp->sec = sec;
+}
+
+/**
+ * @brief   Sets the PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] tp        pointer to the new time value
+ *
+ * @notapi
+ */
+void mac_lld_ptp_set_time(MACDriver *macp, const mac_ptp_time_t *tp) {
+
+  (void)macp;
+
+  while (ETH->PTPTSCR & (ETH_PTPTSCR_TSSTI | ETH_PTPTSCR_TSSTU))
+    ;
+  ETH->PTPTSHUR  = tp->sec;
+  ETH->PTPTSLUR  = tp->nsec;
+  ETH->PTPTSCR  |= ETH_PTPTSCR_TSSTI;
+}
+
+/**
+ * @brief   Steps the PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] offset    signed offset in nanoseconds
+ *
+ * @notapi
+ */
+void mac_lld_ptp_adjust_time(MACDriver *macp, int64_t offset) {
+  uint64_t mag;
+
+  (void)macp;
+
+  mag = offset < 0 ? (uint64_t)-offset : (uint64_t)offset;
+
+  while (ETH->PTPTSCR & (ETH_PTPTSCR_TSSTI | ETH_PTPTSCR_TSSTU))
+    ;
+  ETH->PTPTSHUR  = (uint32_t)(mag / 1000000000U);
+  if (offset < 0) {
+    ETH->PTPTSLUR = ETH_PTPTSLUR_TSUPNS | (uint32_t)(mag % 1000000000U);
+  }
+  else {
+    ETH->PTPTSLUR = (uint32_t)(mag % 1000000000U);
+  }
+  ETH->PTPTSCR  |= ETH_PTPTSCR_TSSTU;
+}
+
+/**
+ * @brief   Adjusts the PTP clock rate.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] ppb       rate correction in parts per billion
+ *
+ * @notapi
+ */
+void mac_lld_ptp_adjust_rate(MACDriver *macp, int32_t ppb) {
+  int64_t addend;
+
+  addend = (int64_t)macp->ptpaddend +
+           (((int64_t)macp->ptpaddend * (int64_t)ppb) / 1000000000);
+
+  while (ETH->PTPTSCR & ETH_PTPTSCR_TSARU)
+    ;
+  ETH->PTPTSAR   = (uint32_t)addend;
+  ETH->PTPTSCR  |= ETH_PTPTSCR_TSARU;
+}
+
+/**
+ * @brief   Returns the hardware time stamp of a transmitted frame.
+ *
+ * @param[in] tdp       pointer to a @p MACTransmitDescriptor structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ *
+ * @notapi
+ */
+bool mac_lld_get_transmit_timestamp(MACTransmitDescriptor *tdp,
+                                    mac_ptp_time_t *tp) {
+  stm32_eth_tx_descriptor_t *tdes = tdp->physdesc;
+
+  if ((tdes->tdes0 & (STM32_TDES0_OWN | STM32_TDES0_LOCKED |
+                      STM32_TDES0_TTSS)) != STM32_TDES0_TTSS) {
+    return false;
+  }
+
+  tp->nsec = tdes->tdes6;
+  tp->sec  = tdes->tdes7;
+
+  return true;
+}
+
+/**
+ * @brief   Returns the hardware time stamp of a received frame.
+ *
+ * @param[in] rdp       pointer to a @p MACReceiveDescriptor structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ *
+ * @notapi
+ */
+bool mac_lld_get_receive_timestamp(MACReceiveDescriptor *rdp,
+                                   mac_ptp_time_t *tp) {
+  stm32_eth_rx_descriptor_t *rdes = rdp->physdesc;
+
+  if (!(rdes->rdes0 & STM32_RDES0_TSV)) {
+    return false;
+  }
+
+  tp->nsec = rdes->rdes6;
+  tp->sec  = rdes->rdes7;
+
+  return true;
+}
+#endif /* MAC_USE_PTP */
+
 #endif /* HAL_USE_MAC */
 
 /** @} */
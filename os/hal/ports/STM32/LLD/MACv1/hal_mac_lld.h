@@ -36,6 +36,16 @@
  */
 #define MAC_SUPPORTS_ZERO_COPY      TRUE
 
+/**
+ * @brief   This implementation supports the PTP clock API.
+ * @note    The STM32F107 MAC lacks the enhanced descriptors format.
+ */
+#if !defined(STM32F10X_CL) || defined(__DOXYGEN__)
+#define MAC_SUPPORTS_PTP            TRUE
+#else
+#define MAC_SUPPORTS_PTP            FALSE
+#endif
+
 /**
  * @name    RDES0 constants
  * @{
@@ -52,6 +62,7 @@
 #define STM32_RDES0_FS              0x00000200
 #define STM32_RDES0_LS              0x00000100
 #define STM32_RDES0_IPHCE           0x00000080
+#define STM32_RDES0_TSV             0x00000080 /* Enhanced format */
 #define STM32_RDES0_LCO             0x00000040
 #define STM32_RDES0_FT              0x00000020
 #define STM32_RDES0_RWT             0x00000010
@@ -59,6 +70,7 @@
 #define STM32_RDES0_DE              0x00000004
 #define STM32_RDES0_CE              0x00000002
 #define STM32_RDES0_PCE             0x00000001
+#define STM32_RDES0_ESA             0x00000001 /* Enhanced format */
 /** @} */
 
 /**
@@ -72,6 +84,21 @@
 #define STM32_RDES1_RBS1_MASK       0x00001FFF
 /** @} */
 
+/**
+ * @name    RDES4 constants
+ * @{
+ */
+#define STM32_RDES4_PTPV            0x00002000
+#define STM32_RDES4_PTPFT           0x00001000
+#define STM32_RDES4_PMT_MASK        0x00000F00
+#define STM32_RDES4_IPV6PR          0x00000080
+#define STM32_RDES4_IPV4PR          0x00000040
+#define STM32_RDES4_IPCB            0x00000020
+#define STM32_RDES4_IPPE            0x00000010
+#define STM32_RDES4_IPHE            0x00000008
+#define STM32_RDES4_IPPT_MASK       0x00000007
+/** @} */
+
 /**
  * @name    TDES0 constants
  * @{
@@ -184,12 +211,72 @@
 #if !defined(STM32_MAC_IP_CHECKSUM_OFFLOAD) || defined(__DOXYGEN__)
 #define STM32_MAC_IP_CHECKSUM_OFFLOAD       0
 #endif
+
+/**
+ * @brief   Receive interrupt coalescing frames count.
+ * @details The receive interrupt is raised once every the specified number
+ *          of frames, frames in between are signaled by the receive
+ *          watchdog timer. A value of one raises an interrupt for each
+ *          frame.
+ * @note    The number of receive buffers must be a multiple of this value.
+ */
+#if !defined(STM32_MAC_RX_COALESCE_FRAMES) || defined(__DOXYGEN__)
+#define STM32_MAC_RX_COALESCE_FRAMES        1
+#endif
+
+/**
+ * @brief   Receive interrupt coalescing timeout.
+ * @details Maximum delay of a coalesced receive interrupt, in units of
+ *          256 HCLK cycles, the range is 1..255.
+ */
+#if !defined(STM32_MAC_RX_COALESCE_TIMEOUT) || defined(__DOXYGEN__)
+#define STM32_MAC_RX_COALESCE_TIMEOUT       255
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (STM32_MAC_IP_CHECKSUM_OFFLOAD < 0) || (STM32_MAC_IP_CHECKSUM_OFFLOAD > 3)
+#error "invalid STM32_MAC_IP_CHECKSUM_OFFLOAD value"
+#endif
+
+#if (STM32_MAC_RX_COALESCE_FRAMES < 1) ||                                   \
+    ((STM32_MAC_RECEIVE_BUFFERS % STM32_MAC_RX_COALESCE_FRAMES) != 0)
+#error "invalid STM32_MAC_RX_COALESCE_FRAMES value"
+#endif
+
+#if STM32_MAC_RX_COALESCE_FRAMES > 1
+#if defined(STM32F10X_CL)
+#error "receive interrupt coalescing not supported on this platform"
+#endif
+#if (STM32_MAC_RX_COALESCE_TIMEOUT < 1) || (STM32_MAC_RX_COALESCE_TIMEOUT > 255)
+#error "invalid STM32_MAC_RX_COALESCE_TIMEOUT value"
+#endif
+#endif
+
+/**
+ * @brief   Checksum operations performed by the hardware.
+ * @note    Received frames with checksum errors are discarded by the
+ *          driver when the offload is enabled. Mode 2 requires the
+ *          pseudo-header checksum in the payload checksum field, this
+ *          cannot be expressed by the flags so only the IP header
+ *          generation is exported.
+ */
+#if (STM32_MAC_IP_CHECKSUM_OFFLOAD == 3) || defined(__DOXYGEN__)
+#define MAC_CHECKSUM_OFFLOAD        (MAC_CHECKSUM_GEN_IP |                  \
+                                     MAC_CHECKSUM_GEN_UDP |                 \
+                                     MAC_CHECKSUM_GEN_TCP |                 \
+                                     MAC_CHECKSUM_GEN_ICMP |                \
+                                     MAC_CHECKSUM_CHECK_ALL)
+#elif STM32_MAC_IP_CHECKSUM_OFFLOAD != 0
+#define MAC_CHECKSUM_OFFLOAD        (MAC_CHECKSUM_GEN_IP |                  \
+                                     MAC_CHECKSUM_CHECK_ALL)
+#else
+#define MAC_CHECKSUM_OFFLOAD        0U
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -202,6 +289,13 @@ typedef struct {
   volatile uint32_t     rdes1;
   volatile uint32_t     rdes2;
   volatile uint32_t     rdes3;
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+  /* Enhanced format, extended status and time stamp.*/
+  volatile uint32_t     rdes4;
+  volatile uint32_t     rdes5;
+  volatile uint32_t     rdes6;
+  volatile uint32_t     rdes7;
+#endif
 } stm32_eth_rx_descriptor_t;
 
 /**
@@ -212,6 +306,13 @@ typedef struct {
   volatile uint32_t     tdes1;
   volatile uint32_t     tdes2;
   volatile uint32_t     tdes3;
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+  /* Enhanced format, time stamp.*/
+  volatile uint32_t     tdes4;
+  volatile uint32_t     tdes5;
+  volatile uint32_t     tdes6;
+  volatile uint32_t     tdes7;
+#endif
 } stm32_eth_tx_descriptor_t;
 
 /**
@@ -268,6 +369,12 @@ struct MACDriver {
    * @brief Transmit next frame pointer.
    */
   stm32_eth_tx_descriptor_t *txptr;
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+  /**
+   * @brief PTP clock nominal addend value.
+   */
+  uint32_t ptpaddend;
+#endif
 };
 
 /**
@@ -348,6 +455,16 @@ extern "C" {
   const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
                                                  size_t *sizep);
 #endif /* MAC_USE_ZERO_COPY */
+#if MAC_USE_PTP
+  void mac_lld_ptp_get_time(MACDriver *macp, mac_ptp_time_t *tp);
+  void mac_lld_ptp_set_time(MACDriver *macp, const mac_ptp_time_t *tp);
+  void mac_lld_ptp_adjust_time(MACDriver *macp, int64_t offset);
+  void mac_lld_ptp_adjust_rate(MACDriver *macp, int32_t ppb);
+  bool mac_lld_get_transmit_timestamp(MACTransmitDescriptor *tdp,
+                                      mac_ptp_time_t *tp);
+  bool mac_lld_get_receive_timestamp(MACReceiveDescriptor *rdp,
+                                     mac_ptp_time_t *tp);
+#endif /* MAC_USE_PTP */
 #ifdef __cplusplus
 }
 #endif
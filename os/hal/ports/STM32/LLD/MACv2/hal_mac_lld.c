@@ -63,12 +63,26 @@
 #define ETH_DMADSR_RPS_TRANSFERRING_Pos     (10U)
 #endif
 
+#if !defined(ETH_MACSSIR_SSINC_Pos) && defined(ETH_MACMACSSIR_SSINC_Pos)
+#define ETH_MACSSIR_SSINC_Pos               ETH_MACMACSSIR_SSINC_Pos
+#endif
+
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
 #define BUFFER_SIZE ((((STM32_MAC_BUFFERS_SIZE - 1) | 3) + 1) / 4)
 
+#if MAC_USE_PTP
+/* PTP clock increment in nanoseconds, the accumulator overflows at half
+   the HCLK frequency at most.*/
+#define PTP_SSINC   ((2000000000U + STM32_HCLK - 1U) / STM32_HCLK)
+
+/* Nominal addend, the accumulator overflows at 1GHz / PTP_SSINC.*/
+#define PTP_ADDEND  ((uint32_t)((1000000000ULL << 32) /                     \
+                                ((uint64_t)PTP_SSINC * (uint64_t)STM32_HCLK)))
+#endif
+
 /* Fixing inconsistencies in ST headers.*/
 #if !defined(ETH_MACMDIOAR_CR_Div124) && defined(ETH_MACMDIOAR_CR_DIV124)
 #define ETH_MACMDIOAR_CR_Div124 ETH_MACMDIOAR_CR_DIV124
@@ -232,6 +246,33 @@ static void mac_lld_set_address(const uint8_t *p) {
   ETH->MACHT1R   = 0;
 }
 
+/**
+ * @brief   Returns the current receive descriptor to the DMA and moves to
+ *          the next one.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ */
+static void mac_lld_recycle_receive_descriptor(MACDriver *macp) {
+
+  /* The buffer address is restored because the write-back format of the
+     context descriptors overwrites it.*/
+  __eth_rd[macp->rdindex].rdes0 = (uint32_t)__eth_rb[macp->rdindex];
+  __eth_rd[macp->rdindex].rdes3 = STM32_RDES3_OWN | STM32_RDES3_IOC |
+                                  STM32_RDES3_BUF1V;
+  __DSB();
+
+  /* If the DMA engine is stalled then a restart request is issued.*/
+  if ((ETH->DMADSR & ETH_DMADSR_RPS) == ETH_DMADSR_RPS_SUSPENDED) {
+    ETH->DMACSR   = ETH_DMACSR_RBU;
+  }
+  ETH->DMACRDTPR = 0;
+
+  /* Reposition in ring.*/
+  macp->rdindex++;
+  if (macp->rdindex >= STM32_MAC_RECEIVE_BUFFERS)
+    macp->rdindex = 0;
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -367,8 +408,10 @@ void mac_lld_start(MACDriver *macp) {
   unsigned i;
 
   /* Resets the state of all descriptors.*/
-  for (i = 0; i < STM32_MAC_RECEIVE_BUFFERS; i++)
+  for (i = 0; i < STM32_MAC_RECEIVE_BUFFERS; i++) {
+    __eth_rd[i].rdes0 = (uint32_t)__eth_rb[i];
     __eth_rd[i].rdes3 = STM32_RDES3_OWN | STM32_RDES3_IOC | STM32_RDES3_BUF1V;
+  }
   macp->rdindex = 0;
   for (i = 0; i < STM32_MAC_TRANSMIT_BUFFERS; i++)
     __eth_td[i].tdes3 = 0;
@@ -402,6 +445,24 @@ void mac_lld_start(MACDriver *macp) {
   else
     mac_lld_set_address(macp->config->mac_address);
 
+#if MAC_USE_PTP
+  /* PTP clock setup, fine correction with digital rollover, all the
+     frames are time stamped.*/
+  ETH->MACTSCR   = ETH_MACTSCR_TSENA | ETH_MACTSCR_TSCFUPDT |
+                   ETH_MACTSCR_TSENALL | ETH_MACTSCR_TSCTRLSSR;
+  ETH->MACSSIR   = PTP_SSINC << ETH_MACSSIR_SSINC_Pos;
+  macp->ptpaddend = PTP_ADDEND;
+  ETH->MACTSAR   = PTP_ADDEND;
+  ETH->MACTSCR  |= ETH_MACTSCR_TSADDREG;
+  while (ETH->MACTSCR & ETH_MACTSCR_TSADDREG)
+    ;
+  ETH->MACSTSUR  = 0;
+  ETH->MACSTNUR  = 0;
+  ETH->MACTSCR  |= ETH_MACTSCR_TSINIT;
+  while (ETH->MACTSCR & ETH_MACTSCR_TSINIT)
+    ;
+#endif
+
   /* Transmitter and receiver enabled.
      Note that the complete setup of the MAC is performed when the link
      status is detected.*/
@@ -499,14 +560,15 @@ msg_t mac_lld_get_transmit_descriptor(MACDriver *macp,
 
   /* Ensure that descriptor isn't owned by the Ethernet DMA or locked by
      another thread.*/
-  if ((tdes->tdes3 & (STM32_TDES3_OWN)) | (tdes->tdes1 > 0)) {
+  if (tdes->tdes3 & (STM32_TDES3_OWN | STM32_TDES3_LOCKED)) {
     return MSG_TIMEOUT;
   }
 
+  /* Marks the current descriptor as locked using the context bit, the
+     write-back of a transmitted frame overwrites the TDES0 and TDES1
+     words with the time stamp.*/
+  tdes->tdes3 = STM32_TDES3_LOCKED;
   tdes->tdes0 = (uint32_t )__eth_tb[macp->tdindex];
-  /* Marks the current descriptor as locked using a reserved bit.*/
-  /*tdes->tdes0 |= STM32_TDES0_LOCKED; */
-  tdes->tdes1++;
 
   /* Next TX descriptor to use.*/
   macp->tdindex++;
@@ -539,6 +601,9 @@ void mac_lld_release_transmit_descriptor(MACTransmitDescriptor *tdp) {
   /* Unlocks the descriptor and returns it to the DMA engine.*/
   tdp->physdesc->tdes1  = 0;
   tdp->physdesc->tdes2 = STM32_TDES2_IOC | (tdp->offset & STM32_TDES2_B1L_MASK);
+#if MAC_USE_PTP
+  tdp->physdesc->tdes2 |= STM32_TDES2_TTSE;
+#endif
 #if STM32_MAC_IP_CHECKSUM_OFFLOAD
   tdp->physdesc->tdes3 = STM32_TDES3_CIC(STM32_MAC_IP_CHECKSUM_OFFLOAD) |
                          STM32_TDES3_LD | STM32_TDES3_FD |
@@ -581,10 +646,30 @@ msg_t mac_lld_get_receive_descriptor(MACDriver *macp,
   /* Iterates through received frames until a valid one is found, invalid
      frames are discarded.*/
   while (!(rdes->rdes3 & STM32_RDES3_OWN)) {
+#if MAC_USE_PTP
+    stm32_eth_rx_descriptor_t *cdes = NULL;
+
+    if (rdes->rdes3 & STM32_RDES3_CTXT) {
+      /* Context descriptor of a discarded frame, purging.*/
+      mac_lld_recycle_receive_descriptor(macp);
+      rdes = (stm32_eth_rx_descriptor_t *)&__eth_rd[macp->rdindex];
+      continue;
+    }
+
+    if ((rdes->rdes3 & STM32_RDES3_LD) && (rdes->rdes1 & STM32_RDES1_TSA)) {
+      /* The time stamp is written in the following context descriptor,
+         the frame is not returned until it is available.*/
+      cdes = (stm32_eth_rx_descriptor_t *)
+             &__eth_rd[(macp->rdindex + 1U) % STM32_MAC_RECEIVE_BUFFERS];
+      if (cdes->rdes3 & STM32_RDES3_OWN) {
+        return MSG_TIMEOUT;
+      }
+    }
+#endif
     if (!(rdes->rdes3 & STM32_RDES3_ES)
         && !(rdes->rdes2 & STM32_RDES2_DAF)
 #if STM32_MAC_IP_CHECKSUM_OFFLOAD
-        && !(rdes->rdes1 & (STM32_RDES1_IHCE | STM32_RDES1_IPCE))
+        && !(rdes->rdes1 & (STM32_RDES1_IPHE | STM32_RDES1_IPCE))
 #endif
         && (rdes->rdes3 & STM32_RDES3_FD) && (rdes->rdes3 & STM32_RDES3_LD)) {
       /* Found a valid one.*/
@@ -596,11 +681,25 @@ msg_t mac_lld_get_receive_descriptor(MACDriver *macp,
       if (macp->rdindex >= STM32_MAC_RECEIVE_BUFFERS)
         macp->rdindex = 0;
 
+#if MAC_USE_PTP
+      /* Time stamp copied from the context descriptor, then the context
+         descriptor is returned to the DMA.*/
+      rdp->tsvalid = false;
+      if (cdes != NULL) {
+        if (cdes->rdes3 & STM32_RDES3_CTXT) {
+          rdp->timestamp.nsec = cdes->rdes0;
+          rdp->timestamp.sec  = cdes->rdes1;
+          rdp->tsvalid        = true;
+        }
+        mac_lld_recycle_receive_descriptor(macp);
+      }
+#endif
+
       return MSG_OK;
     }
     /* Invalid frame found, purging.*/
-    rdes->rdes3 = STM32_RDES3_OWN | STM32_RDES3_IOC | STM32_RDES3_BUF1V;
-    /* Reposition in ring.*/
+    mac_lld_recycle_receive_descriptor(macp);
+    rdes = (stm32_eth_rx_descriptor_t *)&__eth_rd[macp->rdindex];
   }
 
   return MSG_TIMEOUT;
@@ -768,6 +867,217 @@ size_t mac_lld_read_receive_descriptor(MACReceiveDescriptor *rdp,
   return size;
 }
 
+#if MAC_USE_ZERO_COPY || defined(__DOXYGEN__)
+/**
+ * @brief   Returns a pointer to the next transmit buffer in the descriptor
+ *          chain.
+ * @note    The API guarantees that enough buffers can be requested to fill
+ *          a whole frame.
+ *
+ * @param[in] tdp       pointer to a @p MACTransmitDescriptor structure
+ * @param[in] size      size of the requested buffer. Specify the frame size
+ *                      on the first call then scale the value down subtracting
+ *                      the amount of data already copied into the previous
+ *                      buffers.
+ * @param[out] sizep    pointer to variable receiving the buffer size, it is
+ *                      zero when the last buffer has already been returned.
+ *                      Note that a returned size lower than the amount
+ *                      requested means that more buffers must be requested
+ *                      in order to fill the frame data entirely.
+ * @return              Pointer to the returned buffer.
+ * @retval NULL         if the buffer chain has been entirely scanned.
+ *
+ * @notapi
+ */
+uint8_t *mac_lld_get_next_transmit_buffer(MACTransmitDescriptor *tdp,
+                                          size_t size,
+                                          size_t *sizep) {
+
+  osalDbgAssert(!(tdp->physdesc->tdes3 & STM32_TDES3_OWN),
+              "attempt to write descriptor already owned by DMA");
+
+  if (tdp->offset == 0) {
+    *sizep      = tdp->size;
+    tdp->offset = size;
+    return (uint8_t *)tdp->physdesc->tdes0;
+  }
+  *sizep = 0;
+  return NULL;
+}
+
+/**
+ * @brief   Returns a pointer to the next receive buffer in the descriptor
+ *          chain.
+ * @note    The API guarantees that the descriptor chain contains a whole
+ *          frame.
+ *
+ * @param[in] rdp       pointer to a @p MACReceiveDescriptor structure
+ * @param[out] sizep    pointer to variable receiving the buffer size, it is
+ *                      zero when the last buffer has already been returned.
+ * @return              Pointer to the returned buffer.
+ * @retval NULL         if the buffer chain has been entirely scanned.
+ *
+ * @notapi
+ */
+const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
+                                               size_t *sizep) {
+
+  osalDbgAssert(!(rdp->physdesc->rdes3 & STM32_RDES3_OWN),
+              "attempt to read descriptor already owned by DMA");
+
+  if (rdp->size > 0) {
+    cacheBufferInvalidate((uint8_t *)(rdp->physdesc->rdes0), rdp->size);
+    *sizep      = rdp->size;
+    rdp->offset = rdp->size;
+    rdp->size   = 0;
+    return (uint8_t *)rdp->physdesc->rdes0;
+  }
+  *sizep = 0;
+  return NULL;
+}
+#endif /* MAC_USE_ZERO_COPY */
+
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the current PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tp       pointer to the time value
+ *
+ * @notapi
+ */
+void mac_lld_ptp_get_time(MACDriver *macp, mac_ptp_time_t *tp) {
+  uint32_t sec;
+
+  (void)macp;
+
+  /* The seconds are read again in order to detect a rollover between the
+     two reads.*/
+  do {
+    sec      = ETH->MACSTSR;
+    tp->nsec = ETH->MACSTNR & ETH_MACSTNR_TSSS;
+  } while (sec != ETH->MACSTSR);
+  tp->sec = sec;
+}
+
+/**
+ * @brief   Sets the PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] tp        pointer to the new time value
+ *
+ * @notapi
+ */
+void mac_lld_ptp_set_time(MACDriver *macp, const mac_ptp_time_t *tp) {
+
+  (void)macp;
+
+  while (ETH->MACTSCR & (ETH_MACTSCR_TSINIT | ETH_MACTSCR_TSUPDT))
+    ;
+  ETH->MACSTSUR  = tp->sec;
+  ETH->MACSTNUR  = tp->nsec;
+  ETH->MACTSCR  |= ETH_MACTSCR_TSINIT;
+}
+
+/**
+ * @brief   Steps the PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] offset    signed offset in nanoseconds
+ *
+ * @notapi
+ */
+void mac_lld_ptp_adjust_time(MACDriver *macp, int64_t offset) {
+  uint64_t mag;
+  uint32_t sec, nsec;
+
+  (void)macp;
+
+  mag  = offset < 0 ? (uint64_t)-offset : (uint64_t)offset;
+  sec  = (uint32_t)(mag / 1000000000U);
+  nsec = (uint32_t)(mag % 1000000000U);
+
+  while (ETH->MACTSCR & (ETH_MACTSCR_TSINIT | ETH_MACTSCR_TSUPDT))
+    ;
+  if (offset < 0) {
+    /* With digital rollover a subtraction is programmed as complements
+       of the offset.*/
+    ETH->MACSTSUR = 0U - sec;
+    ETH->MACSTNUR = ETH_MACSTNUR_ADDSUB | (1000000000U - nsec);
+  }
+  else {
+    ETH->MACSTSUR = sec;
+    ETH->MACSTNUR = nsec;
+  }
+  ETH->MACTSCR  |= ETH_MACTSCR_TSUPDT;
+}
+
+/**
+ * @brief   Adjusts the PTP clock rate.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] ppb       rate correction in parts per billion
+ *
+ * @notapi
+ */
+void mac_lld_ptp_adjust_rate(MACDriver *macp, int32_t ppb) {
+  int64_t addend;
+
+  addend = (int64_t)macp->ptpaddend +
+           (((int64_t)macp->ptpaddend * (int64_t)ppb) / 1000000000);
+
+  while (ETH->MACTSCR & ETH_MACTSCR_TSADDREG)
+    ;
+  ETH->MACTSAR   = (uint32_t)addend;
+  ETH->MACTSCR  |= ETH_MACTSCR_TSADDREG;
+}
+
+/**
+ * @brief   Returns the hardware time stamp of a transmitted frame.
+ *
+ * @param[in] tdp       pointer to a @p MACTransmitDescriptor structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ *
+ * @notapi
+ */
+bool mac_lld_get_transmit_timestamp(MACTransmitDescriptor *tdp,
+                                    mac_ptp_time_t *tp) {
+  stm32_eth_tx_descriptor_t *tdes = tdp->physdesc;
+
+  if ((tdes->tdes3 & (STM32_TDES3_OWN | STM32_TDES3_LOCKED |
+                      STM32_TDES3_TTSS)) != STM32_TDES3_TTSS) {
+    return false;
+  }
+
+  tp->nsec = tdes->tdes0;
+  tp->sec  = tdes->tdes1;
+
+  return true;
+}
+
+/**
+ * @brief   Returns the hardware time stamp of a received frame.
+ *
+ * @param[in] rdp       pointer to a @p MACReceiveDescriptor structure
+ * @param[out] tp       pointer to the time stamp
+ * @return              The time stamp availability.
+ *
+ * @notapi
+ */
+bool mac_lld_get_receive_timestamp(MACReceiveDescriptor *rdp,
+                                   mac_ptp_time_t *tp) {
+
+  if (!rdp->tsvalid) {
+    return false;
+  }
+
+  *tp = rdp->timestamp;
+
+  return true;
+}
+#endif /* MAC_USE_PTP */
+
 #endif /* HAL_USE_MAC */
 
 /** @} */
@@ -32,9 +32,14 @@
 /*===========================================================================*/
 
 /**
- * @brief   This implementation does not support the zero-copy mode API.
+ * @brief   This implementation supports the zero-copy mode API.
  */
-#define MAC_SUPPORTS_ZERO_COPY      FALSE
+#define MAC_SUPPORTS_ZERO_COPY      TRUE
+
+/**
+ * @brief   This implementation supports the PTP clock API.
+ */
+#define MAC_SUPPORTS_PTP            TRUE
 
 /**
  * @name    RDES1 constants
@@ -114,6 +119,7 @@
  */
 #define STM32_TDES3_OWN             0x80000000
 #define STM32_TDES3_CTXT            0x40000000
+#define STM32_TDES3_LOCKED          0x40000000 /* NOTE: Pseudo flag.        */
 #define STM32_TDES3_FD              0x20000000
 #define STM32_TDES3_LD              0x10000000
 #define STM32_TDES3_CPC_MASK        0x0C000000
@@ -123,6 +129,7 @@
 #define STM32_TDES3_THL_MASK        0x00780000
 #define STM32_TDES3_THL(n)          ((n) << 19)
 #define STM32_TDES3_TSE             0x00040000
+#define STM32_TDES3_TTSS            0x00020000 /* Write */
 #define STM32_TDES3_CIC_MASK        0x00030000
 #define STM32_TDES3_CIC(n)          ((n) << 16)
 #define STM32_TDES3_TPL             0x00008000
@@ -206,6 +213,31 @@
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (STM32_MAC_IP_CHECKSUM_OFFLOAD < 0) || (STM32_MAC_IP_CHECKSUM_OFFLOAD > 3)
+#error "invalid STM32_MAC_IP_CHECKSUM_OFFLOAD value"
+#endif
+
+/**
+ * @brief   Checksum operations performed by the hardware.
+ * @note    Received frames with checksum errors are discarded by the
+ *          driver when the offload is enabled. Mode 2 requires the
+ *          pseudo-header checksum in the payload checksum field, this
+ *          cannot be expressed by the flags so only the IP header
+ *          generation is exported.
+ */
+#if (STM32_MAC_IP_CHECKSUM_OFFLOAD == 3) || defined(__DOXYGEN__)
+#define MAC_CHECKSUM_OFFLOAD        (MAC_CHECKSUM_GEN_IP |                  \
+                                     MAC_CHECKSUM_GEN_UDP |                 \
+                                     MAC_CHECKSUM_GEN_TCP |                 \
+                                     MAC_CHECKSUM_GEN_ICMP |                \
+                                     MAC_CHECKSUM_CHECK_ALL)
+#elif STM32_MAC_IP_CHECKSUM_OFFLOAD != 0
+#define MAC_CHECKSUM_OFFLOAD        (MAC_CHECKSUM_GEN_IP |                  \
+                                     MAC_CHECKSUM_CHECK_ALL)
+#else
+#define MAC_CHECKSUM_OFFLOAD        0U
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -284,6 +316,12 @@ struct MACDriver {
    * @brief Transmit next frame index.
    */
   uint16_t tdindex;
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+  /**
+   * @brief PTP clock nominal addend value.
+   */
+  uint32_t ptpaddend;
+#endif
 };
 
 /**
@@ -322,6 +360,16 @@ typedef struct {
    * @brief Pointer to the physical descriptor.
    */
   stm32_eth_rx_descriptor_t *physdesc;
+#if MAC_USE_PTP || defined(__DOXYGEN__)
+  /**
+   * @brief Receive time stamp, copied from the context descriptor.
+   */
+  mac_ptp_time_t            timestamp;
+  /**
+   * @brief Receive time stamp availability.
+   */
+  bool                      tsvalid;
+#endif
 } MACReceiveDescriptor;
 
 /*===========================================================================*/
@@ -357,6 +405,23 @@ extern "C" {
   size_t mac_lld_read_receive_descriptor(MACReceiveDescriptor *rdp,
                                          uint8_t *buf,
                                          size_t size);
+#if MAC_USE_ZERO_COPY
+  uint8_t *mac_lld_get_next_transmit_buffer(MACTransmitDescriptor *tdp,
+                                            size_t size,
+                                            size_t *sizep);
+  const uint8_t *mac_lld_get_next_receive_buffer(MACReceiveDescriptor *rdp,
+                                                 size_t *sizep);
+#endif /* MAC_USE_ZERO_COPY */
+#if MAC_USE_PTP
+  void mac_lld_ptp_get_time(MACDriver *macp, mac_ptp_time_t *tp);
+  void mac_lld_ptp_set_time(MACDriver *macp, const mac_ptp_time_t *tp);
+  void mac_lld_ptp_adjust_time(MACDriver *macp, int64_t offset);
+  void mac_lld_ptp_adjust_rate(MACDriver *macp, int32_t ppb);
+  bool mac_lld_get_transmit_timestamp(MACTransmitDescriptor *tdp,
+                                      mac_ptp_time_t *tp);
+  bool mac_lld_get_receive_timestamp(MACReceiveDescriptor *rdp,
+                                     mac_ptp_time_t *tp);
+#endif /* MAC_USE_PTP */
 #ifdef __cplusplus
 }
 #endif
@@ -84,6 +84,7 @@ static void mdma_serve_interrupt(const stm32_mdma_channel_t *mdmachp) {
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(STM32_MDMA_HANDLER) {
   uint32_t gisr = MDMA->GISR0;
   OSAL_IRQ_PROLOGUE();
@@ -320,6 +321,18 @@ void mdmaChannelFree(const stm32_mdma_channel_t *mdmachp) {
   osalSysUnlock();
 }
 
+/**
+ * @brief   Returns the mask of the allocated channels.
+ *
+ * @return              The allocated channels mask, bit N is channel N.
+ *
+ * @xclass
+ */
+uint32_t mdmaGetAllocatedMaskX(void) {
+
+  return mdma.allocated_mask;
+}
+
 /**
  * @brief   MDMA stream disable.
  * @details The function disables the specified stream, waits for the disable
@@ -452,6 +452,7 @@ extern "C" {
                                                void *param);
   void mdmaChannelFreeI(const stm32_mdma_channel_t *mdmachp);
   void mdmaChannelFree(const stm32_mdma_channel_t *mdmachp);
+  uint32_t mdmaGetAllocatedMaskX(void);
   void mdmaChannelDisableX(const stm32_mdma_channel_t *mdmachp);
 #ifdef __cplusplus
 }
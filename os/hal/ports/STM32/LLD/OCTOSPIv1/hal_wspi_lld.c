@@ -57,6 +57,40 @@ WSPIDriver WSPID2;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (WSPI_SUPPORTS_MEMMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the memory mapped area base address.
+ */
+static uint8_t *wspi_lld_get_mapped_base(WSPIDriver *wspip) {
+
+#if STM32_WSPI_USE_OCTOSPI2
+  if (&WSPID2 == wspip) {
+    return (uint8_t *)0x70000000U;
+  }
+#endif
+
+  (void)wspip;
+
+  return (uint8_t *)0x90000000U;
+}
+
+/**
+ * @brief   Returns the MPU region of the memory mapped RAM or -1.
+ */
+static int wspi_lld_get_mpu_region(WSPIDriver *wspip) {
+
+#if STM32_WSPI_USE_OCTOSPI2
+  if (&WSPID2 == wspip) {
+    return STM32_WSPI_OCTOSPI2_MPU_REGION;
+  }
+#endif
+
+  (void)wspip;
+
+  return STM32_WSPI_OCTOSPI1_MPU_REGION;
+}
+#endif /* WSPI_SUPPORTS_MEMMAP == TRUE */
+
 /**
  * @brief   Waits for completion of previous operation.
  */
@@ -239,6 +273,10 @@ void wspi_lld_start(WSPIDriver *wspip) {
   wspip->ospi->DCR2 = wspip->config->dcr2 |
                       STM32_DCR2_PRESCALER(STM32_WSPI_OCTOSPI1_PRESCALER_VALUE - 1U);
   wspip->ospi->DCR3 = wspip->config->dcr3;
+#if defined(OCTOSPI_DCR4_REFRESH)
+  wspip->ospi->DCR4 = wspip->config->dcr4;
+#endif
+  wspip->ospi->HLCR = wspip->config->hlcr;
   wspip->ospi->CR   = OCTOSPI_CR_TCIE | OCTOSPI_CR_DMAEN | OCTOSPI_CR_EN;
   wspip->ospi->FCR  = OCTOSPI_FCR_CTEF | OCTOSPI_FCR_CTCF |
                       OCTOSPI_FCR_CSMF | OCTOSPI_FCR_CTOF;
@@ -422,20 +460,9 @@ void wspi_lld_map_flash(WSPIDriver *wspip,
   wspip->ospi->WABR = 0U;
 
   /* Mapped flash absolute base address.*/
-#if STM32_WSPI_USE_OCTOSPI1
-  if (&WSPID1 == wspip) {
-    if (addrp != NULL) {
-      *addrp = (uint8_t *)0x90000000U;
-    }
+  if (addrp != NULL) {
+    *addrp = wspi_lld_get_mapped_base(wspip);
   }
-#endif
-#if STM32_WSPI_USE_OCTOSPI2
-  if (&WSPID2 == wspip) {
-    if (addrp != NULL) {
-      *addrp = (uint8_t *)0x70000000U;
-    }
-  }
-#endif
 }
 
 /**
@@ -448,6 +475,15 @@ void wspi_lld_map_flash(WSPIDriver *wspip,
  * @notapi
  */
 void wspi_lld_unmap_flash(WSPIDriver *wspip) {
+  int region = wspi_lld_get_mpu_region(wspip);
+
+  /* Writing back cached data of a mapped RAM then removing the region.*/
+  if (region >= 0) {
+    cacheBufferFlush(wspi_lld_get_mapped_base(wspip),
+                     (size_t)2U << ((wspip->config->dcr1 &
+                                     STM32_DCR1_DEVSIZE_MASK) >> 16U));
+    mpuConfigureRegion(region, 0U, 0U);
+  }
 
   /* Aborting memory mapped mode.*/
   wspip->ospi->CR |= OCTOSPI_CR_ABORT;
@@ -459,6 +495,64 @@ void wspi_lld_unmap_flash(WSPIDriver *wspip) {
 }
 #endif /* WSPI_SUPPORTS_MEMMAP == TRUE */
 
+#if (WSPI_SUPPORTS_MEMMAP_WRITE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Maps in memory space a WSPI RAM device.
+ * @details PSRAM and HyperRAM devices usually require DTR and DQS, both
+ *          are specified in the commands configuration. HyperBus devices
+ *          also require the HyperBus memory type in DCR1 and the latency
+ *          settings in HLCR.
+ * @note    If a MPU region is assigned to the OCTOSPI then it is
+ *          configured over the whole device as normal memory, unaligned
+ *          accesses and caching become possible.
+ * @pre     The memory device must be initialized appropriately before
+ *          mapping it in memory space.
+ *
+ * @param[in] wspip     pointer to the @p WSPIDriver object
+ * @param[in] rcmdp     pointer to the read command descriptor
+ * @param[in] wcmdp     pointer to the write command descriptor
+ * @param[out] addrp    pointer to the memory start address of the mapped
+ *                      memory or @p NULL
+ *
+ * @notapi
+ */
+void wspi_lld_map_memory(WSPIDriver *wspip,
+                         const wspi_command_t *rcmdp,
+                         const wspi_command_t *wcmdp,
+                         uint8_t **addrp) {
+  int region = wspi_lld_get_mpu_region(wspip);
+
+  /* Starting memory mapped mode with both read and write commands.*/
+  wspip->ospi->CR   = OCTOSPI_CR_FMODE_1 | OCTOSPI_CR_FMODE_0 | OCTOSPI_CR_EN;
+  wspip->ospi->TCR  = rcmdp->dummy;
+  wspip->ospi->CCR  = rcmdp->cfg;
+  wspip->ospi->IR   = rcmdp->cmd;
+  wspip->ospi->ABR  = rcmdp->alt;
+  wspip->ospi->AR   = 0U;
+  wspip->ospi->WTCR = wcmdp->dummy;
+  wspip->ospi->WCCR = wcmdp->cfg;
+  wspip->ospi->WIR  = wcmdp->cmd;
+  wspip->ospi->WABR = wcmdp->alt;
+
+  /* The default memory map attributes are replaced with a normal memory
+     region covering the whole device.*/
+  if (region >= 0) {
+    mpuConfigureRegion(region,
+                       wspi_lld_get_mapped_base(wspip),
+                       STM32_WSPI_MPU_RAM_ATTRIBUTES |
+                       MPU_RASR_SIZE((wspip->config->dcr1 &
+                                      STM32_DCR1_DEVSIZE_MASK) >> 16U) |
+                       MPU_RASR_ENABLE);
+    mpuEnable(MPU_CTRL_PRIVDEFENA);
+  }
+
+  /* Mapped memory absolute base address.*/
+  if (addrp != NULL) {
+    *addrp = wspi_lld_get_mapped_base(wspip);
+  }
+}
+#endif /* WSPI_SUPPORTS_MEMMAP_WRITE == TRUE */
+
 #endif /* HAL_USE_WSPI */
 
 /** @} */
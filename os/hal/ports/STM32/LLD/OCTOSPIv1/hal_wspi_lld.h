@@ -37,6 +37,7 @@
  */
 #define WSPI_SUPPORTS_MEMMAP                TRUE
 #define WSPI_DEFAULT_CFG_MASKS              TRUE
+#define WSPI_SUPPORTS_MEMMAP_WRITE          TRUE
 /** @} */
 
 /**
@@ -49,10 +50,22 @@
 #define STM32_DCR1_CSHT(n)                  ((n) << 8U)
 #define STM32_DCR1_DEVSIZE_MASK             (31U << 16U)
 #define STM32_DCR1_DEVSIZE(n)               ((n) << 16U)
-#define STM32_DCR1_MTYP_MASK                (7U << 16U)
+#define STM32_DCR1_MTYP_MASK                (7U << 24U)
 #define STM32_DCR1_MTYP(n)                  ((n) << 24U)
 /** @} */
 
+/**
+ * @name    DCR1 memory types
+ * @{
+ */
+#define STM32_MTYP_MICRON                   0U
+#define STM32_MTYP_MACRONIX                 1U
+#define STM32_MTYP_STANDARD                 2U
+#define STM32_MTYP_MACRONIX_RAM             3U
+#define STM32_MTYP_HYPERBUS_MEMORY          4U
+#define STM32_MTYP_HYPERBUS_REGISTER        5U
+/** @} */
+
 /**
  * @name    DCR2 register options
  * @{
@@ -79,6 +92,28 @@
 #define STM32_DCR4_REFRESH(n)               ((n) << 0U)
 /** @} */
 
+/**
+ * @name    HLCR register options
+ * @{
+ */
+#define STM32_HLCR_LM                       (1U << 0U)
+#define STM32_HLCR_WZL                      (1U << 1U)
+#define STM32_HLCR_TACC_MASK                (255U << 8U)
+#define STM32_HLCR_TACC(n)                  ((n) << 8U)
+#define STM32_HLCR_TRWR_MASK                (255U << 16U)
+#define STM32_HLCR_TRWR(n)                  ((n) << 16U)
+/** @} */
+
+/**
+ * @name    Timing options
+ * @note    These options can be ORed to the dummy cycles field of the
+ *          command descriptors.
+ * @{
+ */
+#define STM32_TCR_DHQC                      (1U << 28U)
+#define STM32_TCR_SSHIFT                    (1U << 30U)
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -173,6 +208,37 @@
 #if !defined(STM32_WSPI_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
 #define STM32_WSPI_DMA_ERROR_HOOK(qspip)    osalSysHalt("DMA failure")
 #endif
+
+/**
+ * @brief   MPU region for the OCTOSPI1 memory mapped RAM.
+ * @details The region is configured when a RAM device is mapped, its size
+ *          is the device size specified in DCR1, a negative value leaves
+ *          the MPU untouched.
+ */
+#if !defined(STM32_WSPI_OCTOSPI1_MPU_REGION) || defined(__DOXYGEN__)
+#define STM32_WSPI_OCTOSPI1_MPU_REGION      -1
+#endif
+
+/**
+ * @brief   MPU region for the OCTOSPI2 memory mapped RAM.
+ * @details The region is configured when a RAM device is mapped, its size
+ *          is the device size specified in DCR1, a negative value leaves
+ *          the MPU untouched.
+ */
+#if !defined(STM32_WSPI_OCTOSPI2_MPU_REGION) || defined(__DOXYGEN__)
+#define STM32_WSPI_OCTOSPI2_MPU_REGION      -1
+#endif
+
+/**
+ * @brief   MPU attributes of the memory mapped RAM regions.
+ * @note    The default is normal write-back memory, data only. Use
+ *          @p MPU_RASR_ATTR_NON_CACHEABLE for buffers shared with DMA
+ *          engines on devices with a data cache.
+ */
+#if !defined(STM32_WSPI_MPU_RAM_ATTRIBUTES) || defined(__DOXYGEN__)
+#define STM32_WSPI_MPU_RAM_ATTRIBUTES                                       \
+  (MPU_RASR_ATTR_AP_RW_RW | MPU_RASR_ATTR_CACHEABLE_WB_WA | MPU_RASR_ATTR_XN)
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -280,8 +346,10 @@
   uint32_t                  dcr2;                                           \
   /* DCR3 register initialization data.*/                                   \
   uint32_t                  dcr3;                                           \
-  /* DCR4 register initialization data.*/                                   \
-  uint32_t                  dcr4
+  /* DCR4 register initialization data, only on devices having it.*/        \
+  uint32_t                  dcr4;                                           \
+  /* HLCR register initialization data, HyperBus latency settings.*/        \
+  uint32_t                  hlcr
 
 /**
  * @brief   Low level fields of the WSPI driver structure.
@@ -323,6 +391,12 @@ extern "C" {
                           uint8_t **addrp);
   void wspi_lld_unmap_flash(WSPIDriver *wspip);
 #endif
+#if WSPI_SUPPORTS_MEMMAP_WRITE == TRUE
+  void wspi_lld_map_memory(WSPIDriver *wspip,
+                           const wspi_command_t *rcmdp,
+                           const wspi_command_t *wcmdp,
+                           uint8_t **addrp);
+#endif
 #ifdef __cplusplus
 }
 #endif
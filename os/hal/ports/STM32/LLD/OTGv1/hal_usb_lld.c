@@ -56,6 +56,17 @@
 
 #endif
 
+#if (STM32_USB_USE_OTG2 && STM32_USB_OTG2_USE_DMA) || defined(__DOXYGEN__)
+#define OTG_USE_DMA             TRUE
+#define otg_use_dma(usbp)       ((usbp) == &USBD2)
+#else
+#define OTG_USE_DMA             FALSE
+#endif
+
+/* Setup packets stored by the DMA, back-to-back packets are written in
+   sequence.*/
+#define EP0_SETUP_PACKETS       3
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -92,8 +103,10 @@ static union {
 
 /**
  * @brief   Buffer for the EP0 setup packets.
+ * @note    It is word aligned and large enough for the setup packets
+ *          written by the OTG DMA.
  */
-static uint8_t ep0setup_buffer[8];
+static uint32_t ep0setup_buffer[(EP0_SETUP_PACKETS * 8) / 4];
 
 /**
  * @brief   EP0 initialization structure.
@@ -108,7 +121,7 @@ static const USBEndpointConfig ep0config = {
   &ep0_state.in,
   &ep0_state.out,
   1,
-  ep0setup_buffer
+  (uint8_t *)ep0setup_buffer
 };
 
 #if STM32_USB_USE_OTG1
@@ -221,6 +234,51 @@ static uint32_t otg_ram_alloc(USBDriver *usbp, size_t size) {
   return next;
 }
 
+#if OTG_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Prepares EP0 for setup packets reception using the DMA.
+ * @details The OUT endpoint zero is enabled with the setup buffer as DMA
+ *          target if it is not already enabled.
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ *
+ * @notapi
+ */
+static void otg_ep0_dma_setup(USBDriver *usbp) {
+  stm32_otg_t *otgp = usbp->otg;
+
+  if ((otgp->oe[0].DOEPCTL & DOEPCTL_EPENA) == 0U) {
+    otgp->oe[0].DOEPDMA  = (uint32_t)usbp->epc[0]->setup_buf;
+    otgp->oe[0].DOEPTSIZ = DOEPTSIZ_STUPCNT(EP0_SETUP_PACKETS) |
+                           DOEPTSIZ_PKTCNT(1) |
+                           DOEPTSIZ_XFRSIZ(EP0_SETUP_PACKETS * 8);
+    otgp->oe[0].DOEPCTL |= DOEPCTL_EPENA;
+  }
+}
+#endif /* OTG_USE_DMA */
+
+/**
+ * @brief   OUT transfer size to be programmed for a receive operation.
+ * @details The size is rounded to a multiple of packet size because the
+ *          following requirement in the RM:
+ *          "For OUT transfers, the transfer size field in the endpoint's
+ *          transfer size register must be a multiple of the maximum packet
+ *          size of the endpoint, adjusted to the Word boundary".
+ *
+ * @param[in] usbp      pointer to the @p USBDriver object
+ * @param[in] ep        endpoint number
+ * @param[in] n         requested transfer size
+ * @return              The size in bytes.
+ *
+ * @notapi
+ */
+static uint32_t otg_out_xfrsize(USBDriver *usbp, usbep_t ep, size_t n) {
+  uint32_t pcnt;
+
+  pcnt = (n + usbp->epc[ep]->out_maxsize - 1U) / usbp->epc[ep]->out_maxsize;
+  return (pcnt * usbp->epc[ep]->out_maxsize + 3U) & 0xFFFFFFFCU;
+}
+
 /**
  * @brief   Writes to a TX FIFO.
  *
@@ -384,6 +442,14 @@ static void otg_epin_handler(USBDriver *usbp, usbep_t ep) {
     /* Transmit transfer complete.*/
     USBInEndpointState *isp = usbp->epc[ep]->in_state;
 
+#if OTG_USE_DMA
+    if (otg_use_dma(usbp)) {
+      /* The whole transaction has been read by the DMA.*/
+      isp->txbuf += isp->txsize;
+      isp->txcnt  = isp->txsize;
+    }
+#endif
+
     if (isp->txsize < isp->totsize) {
       /* In case the transaction covered only part of the total transfer
          then another transaction is immediately started in order to
@@ -397,6 +463,11 @@ static void otg_epin_handler(USBDriver *usbp, usbep_t ep) {
     else {
       /* End on IN transfer.*/
       _usb_isr_invoke_in_cb(usbp, ep);
+#if OTG_USE_DMA
+      if ((ep == 0U) && otg_use_dma(usbp)) {
+        otg_ep0_dma_setup(usbp);
+      }
+#endif
     }
   }
   if ((epint & DIEPINT_TXFE) &&
@@ -422,9 +493,28 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
   otgp->oe[ep].DOEPINT = epint;
 
   if ((epint & DOEPINT_STUP) && (otgp->DOEPMSK & DOEPMSK_STUPM)) {
+#if OTG_USE_DMA
+    if (otg_use_dma(usbp)) {
+      uint32_t stupcnt = (otgp->oe[ep].DOEPTSIZ & DOEPTSIZ_STUPCNT_MASK) >> 29;
+
+      /* In case of back-to-back setup packets the last one is moved at
+         the start of the buffer.*/
+      if (stupcnt < EP0_SETUP_PACKETS - 1U) {
+        memcpy(usbp->epc[ep]->setup_buf,
+               usbp->epc[ep]->setup_buf +
+               ((EP0_SETUP_PACKETS - 1U - stupcnt) * 8U), 8);
+      }
+    }
+#endif
+
     /* Setup packets handling, setup packets are handled using a
        specific callback.*/
     _usb_isr_invoke_setup_cb(usbp, ep);
+#if OTG_USE_DMA
+    if ((ep == 0U) && otg_use_dma(usbp)) {
+      otg_ep0_dma_setup(usbp);
+    }
+#endif
   }
 
   if ((epint & DOEPINT_XFRC) && (otgp->DOEPMSK & DOEPMSK_XFRCM)) {
@@ -433,6 +523,21 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
     /* OUT state structure pointer for this endpoint.*/
     osp = usbp->epc[ep]->out_state;
 
+#if OTG_USE_DMA
+    if (otg_use_dma(usbp)) {
+      uint32_t xfrsize, rem;
+
+      /* The data has already been written by the DMA, the received size
+         is what is missing from the programmed transfer size.*/
+      xfrsize = otg_out_xfrsize(usbp, ep, osp->rxsize);
+      rem     = otgp->oe[ep].DOEPTSIZ & DOEPTSIZ_XFRSIZ_MASK;
+      if (rem < xfrsize) {
+        osp->rxbuf += xfrsize - rem;
+        osp->rxcnt += xfrsize - rem;
+      }
+    }
+#endif
+
     /* EP0 requires special handling.*/
     if (ep == 0) {
 
@@ -461,6 +566,11 @@ static void otg_epout_handler(USBDriver *usbp, usbep_t ep) {
 
     /* End on OUT transfer.*/
     _usb_isr_invoke_out_cb(usbp, ep);
+#if OTG_USE_DMA
+    if ((ep == 0U) && otg_use_dma(usbp)) {
+      otg_ep0_dma_setup(usbp);
+    }
+#endif
   }
 }
 
@@ -490,6 +600,13 @@ static void otg_isoc_in_failed_handler(USBDriver *usbp) {
       /* Prepare data for next frame */
       _usb_isr_invoke_in_cb(usbp, ep);
 
+#if OTG_USE_DMA
+      /* With DMA the transfer is restarted directly by the callback.*/
+      if (otg_use_dma(usbp)) {
+        continue;
+      }
+#endif
+
       /* TX FIFO empty or emptying.*/
       otg_txfifo_handler(usbp, ep);
     }
@@ -839,6 +956,13 @@ void usb_lld_start(USBDriver *usbp) {
     /* Interrupts on TXFIFOs half empty.*/
     otgp->GAHBCFG = 0;
 
+#if OTG_USE_DMA
+    if (otg_use_dma(usbp)) {
+      /* Internal DMA enabled, INCR4 bursts.*/
+      otgp->GAHBCFG = GAHBCFG_DMAEN | GAHBCFG_HBSTLEN(3);
+    }
+#endif
+
     /* Endpoints re-initialization.*/
     otg_disable_ep(usbp);
 
@@ -943,6 +1067,12 @@ void usb_lld_reset(USBDriver *usbp) {
 
   /* Enables also EP-related interrupt sources.*/
   otgp->GINTMSK  |= GINTMSK_RXFLVLM | GINTMSK_OEPM  | GINTMSK_IEPM;
+#if OTG_USE_DMA
+  if (otg_use_dma(usbp)) {
+    /* The RX FIFO is emptied by the DMA.*/
+    otgp->GINTMSK &= ~GINTMSK_RXFLVLM;
+  }
+#endif
   otgp->DIEPMSK   = DIEPMSK_TOCM    | DIEPMSK_XFRCM;
   otgp->DOEPMSK   = DOEPMSK_STUPM   | DOEPMSK_XFRCM;
 
@@ -957,6 +1087,13 @@ void usb_lld_reset(USBDriver *usbp) {
   otgp->DIEPTXF0 = DIEPTXF_INEPTXFD(ep0config.in_maxsize / 4) |
                    DIEPTXF_INEPTXSA(otg_ram_alloc(usbp,
                                                   ep0config.in_maxsize / 4));
+
+#if OTG_USE_DMA
+  /* With DMA the EP0 must be enabled in order to receive setup packets.*/
+  if (otg_use_dma(usbp)) {
+    otg_ep0_dma_setup(usbp);
+  }
+#endif
 }
 
 /**
@@ -1139,19 +1276,28 @@ void usb_lld_start_out(USBDriver *usbp, usbep_t ep) {
   if ((ep == 0) && (osp->rxsize > EP0_MAX_OUTSIZE))
       osp->rxsize = EP0_MAX_OUTSIZE;
 
-  /* Transaction size is rounded to a multiple of packet size because the
-     following requirement in the RM:
-     "For OUT transfers, the transfer size field in the endpoint's transfer
-     size register must be a multiple of the maximum packet size of the
-     endpoint, adjusted to the Word boundary".*/
+  /* Transaction size is rounded to a multiple of packet size.*/
   pcnt   = (osp->rxsize + usbp->epc[ep]->out_maxsize - 1U) /
            usbp->epc[ep]->out_maxsize;
-  rxsize = (pcnt * usbp->epc[ep]->out_maxsize + 3U) & 0xFFFFFFFCU;
+  rxsize = otg_out_xfrsize(usbp, ep, osp->rxsize);
 
   /*Setting up transaction parameters in DOEPTSIZ.*/
   usbp->otg->oe[ep].DOEPTSIZ = DOEPTSIZ_STUPCNT(3) | DOEPTSIZ_PKTCNT(pcnt) |
                                DOEPTSIZ_XFRSIZ(rxsize);
 
+#if OTG_USE_DMA
+  if (otg_use_dma(usbp)) {
+    /* A zero sized transfer on EP0 is a status stage, the setup buffer
+       is kept as DMA target for the next setup packet.*/
+    if ((ep == 0U) && (osp->rxsize == 0U)) {
+      usbp->otg->oe[ep].DOEPDMA = (uint32_t)usbp->epc[ep]->setup_buf;
+    }
+    else {
+      usbp->otg->oe[ep].DOEPDMA = (uint32_t)osp->rxbuf;
+    }
+  }
+#endif
+
   /* Special case of isochronous endpoint.*/
   if ((usbp->epc[ep]->ep_mode & USB_EP_MODE_TYPE) == USB_EP_MODE_TYPE_ISOC) {
     /* Odd/even bit toggling for isochronous endpoint.*/
@@ -1203,6 +1349,15 @@ void usb_lld_start_in(USBDriver *usbp, usbep_t ep) {
       usbp->otg->ie[ep].DIEPCTL |= DIEPCTL_SODDFRM;
   }
 
+#if OTG_USE_DMA
+  if (otg_use_dma(usbp)) {
+    /* The TX FIFO is filled by the DMA, no FIFO empty interrupt.*/
+    usbp->otg->ie[ep].DIEPDMA = (uint32_t)isp->txbuf;
+    usbp->otg->ie[ep].DIEPCTL |= DIEPCTL_EPENA | DIEPCTL_CNAK;
+    return;
+  }
+#endif
+
   /* Starting operation.*/
   usbp->otg->ie[ep].DIEPCTL |= DIEPCTL_EPENA | DIEPCTL_CNAK;
   usbp->otg->DIEPEMPMSK |= DIEPEMPMSK_INEPTXFEM(ep);
@@ -109,6 +109,22 @@
 #define STM32_USE_USB_OTG2_HS               TRUE
 #endif
 
+/**
+ * @brief   Enables the OTG2 internal DMA.
+ * @details Endpoints data is moved by the OTG_HS DMA between the FIFO RAM
+ *          and the transfer buffers, the RX FIFO and TX FIFO empty
+ *          interrupts are not used and a multi-packet transfer is served
+ *          with a single interrupt on completion.
+ * @note    Transfer buffers must be word aligned and located in a memory
+ *          area accessible by the OTG_HS AHB master, on devices with a data
+ *          cache the buffers must be in a non-cacheable area.
+ * @note    OUT buffers must be able to hold the transfer size rounded up
+ *          to a multiple of the endpoint packet size.
+ */
+#if !defined(STM32_USB_OTG2_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_USB_OTG2_USE_DMA              FALSE
+#endif
+
 /**
  * @brief   Exception priority level during TXFIFOs operations.
  * @note    Because an undocumented silicon behavior the operation of
@@ -64,7 +64,8 @@ typedef struct {
   volatile uint32_t resvdC;
   volatile uint32_t DIEPTSIZ;   /**< @brief Device IN endpoint transfer size
                                             register.                       */
-  volatile uint32_t resvd14;
+  volatile uint32_t DIEPDMA;    /**< @brief Device IN endpoint DMA address
+                                            register (HS only).             */
   volatile uint32_t DTXFSTS;    /**< @brief Device IN endpoint transmit FIFO
                                             status register.                */
   volatile uint32_t resvd1C;
@@ -82,7 +83,8 @@ typedef struct {
   volatile uint32_t resvdC;
   volatile uint32_t DOEPTSIZ;   /**< @brief Device OUT endpoint transfer
                                             size register.                  */
-  volatile uint32_t resvd14;
+  volatile uint32_t DOEPDMA;    /**< @brief Device OUT endpoint DMA address
+                                            register (HS only).             */
   volatile uint32_t resvd18;
   volatile uint32_t resvd1C;
 } stm32_otg_out_ep_t;
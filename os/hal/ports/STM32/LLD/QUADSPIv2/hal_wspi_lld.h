@@ -37,6 +37,7 @@
  */
 #define WSPI_SUPPORTS_MEMMAP                TRUE
 #define WSPI_DEFAULT_CFG_MASKS              FALSE
+#define WSPI_SUPPORTS_MEMMAP_WRITE          FALSE
 /** @} */
 
 /**
@@ -51,10 +51,64 @@ static const TRNGConfig default_cfg = {.cr = 0};
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Shared RNG interrupt service routine.
+ * @details Moves the available random words into the entropy pool, the
+ *          interrupt is disabled when the pool is full.
+ *
+ * @param[in] trngp     pointer to the @p TRNGDriver object
+ */
+static void trng_lld_serve_interrupt(TRNGDriver *trngp) {
+  uint32_t sr = trngp->rng->SR;
+
+  /* On errors the pending data is discarded, a seed error also requires
+     the generator to be restarted.*/
+  if ((sr & (RNG_SR_CEIS | RNG_SR_SEIS)) != 0U) {
+    trngp->rng->SR = 0U;
+    if ((sr & RNG_SR_SEIS) != 0U) {
+      trngp->rng->CR &= ~RNG_CR_RNGEN;
+      trngp->rng->CR |= RNG_CR_RNGEN;
+    }
+    return;
+  }
+
+  while (((trngp->rng->SR & RNG_SR_DRDY) != 0U) &&
+         (_trng_pool_space_i(trngp) >= sizeof (uint32_t))) {
+    _trng_pool_put_i(trngp, trngp->rng->DR);
+  }
+
+  /* Pool full, the refill is restarted when data is taken from it.*/
+  if (_trng_pool_space_i(trngp) < sizeof (uint32_t)) {
+    trngp->rng->CR &= ~RNG_CR_IE;
+  }
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+#if (STM32_TRNG_USE_RNG1 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   RNG1 interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(STM32_RNG1_HANDLER) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  osalSysLockFromISR();
+  trng_lld_serve_interrupt(&TRNGD1);
+  osalSysUnlockFromISR();
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -92,11 +146,19 @@ void trng_lld_start(TRNGDriver *trngp) {
 #if STM32_TRNG_USE_RNG1 == TRUE
     if (&TRNGD1 == trngp) {
       rccEnableRNG(false);
+#if TRNG_USE_POOL == TRUE
+      nvicEnableVector(STM32_RNG1_NUMBER, STM32_TRNG_RNG1_IRQ_PRIORITY);
+#endif
     }
 #endif
   }
   /* Configures the peripheral.*/
+#if TRNG_USE_POOL == TRUE
+  /* The pool is refilled in background by the interrupt handler.*/
+  trngp->rng->CR |= RNG_CR_RNGEN | RNG_CR_IE;
+#else
   trngp->rng->CR |= RNG_CR_RNGEN;
+#endif
 }
 
 /**
@@ -110,11 +172,14 @@ void trng_lld_stop(TRNGDriver *trngp) {
 
   if (trngp->state == TRNG_READY) {
     /* Resets the peripheral.*/
-    trngp->rng->CR &= ~RNG_CR_RNGEN;
+    trngp->rng->CR &= ~(RNG_CR_RNGEN | RNG_CR_IE);
 
     /* Disables the peripheral.*/
 #if STM32_TRNG_USE_RNG1 == TRUE
     if (&TRNGD1 == trngp) {
+#if TRNG_USE_POOL == TRUE
+      nvicDisableVector(STM32_RNG1_NUMBER);
+#endif
       rccDisableRNG();
     }
 #endif
@@ -174,6 +239,21 @@ bool trng_lld_generate(TRNGDriver *trngp, size_t size, uint8_t *out) {
   }
 }
 
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Restarts the entropy pool refill.
+ * @note    Invoked when data is taken from the pool.
+ *
+ * @param[in] trngp             pointer to the @p TRNGDriver object
+ *
+ * @notapi
+ */
+void trng_lld_pool_refill_i(TRNGDriver *trngp) {
+
+  trngp->rng->CR |= RNG_CR_IE;
+}
+#endif
+
 #endif /* HAL_USE_TRNG == TRUE */
 
 /** @} */
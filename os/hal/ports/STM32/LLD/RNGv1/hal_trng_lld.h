@@ -63,6 +63,14 @@
 #if !defined(STM32_DATA_FETCH_ATTEMPTS) || defined(__DOXYGEN__)
 #define STM32_DATA_FETCH_ATTEMPTS           1000
 #endif
+
+/**
+ * @brief   TRNGD1 interrupt priority level setting.
+ * @note    Only used when the entropy pool is enabled.
+ */
+#if !defined(STM32_TRNG_RNG1_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_TRNG_RNG1_IRQ_PRIORITY        14
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -85,6 +93,16 @@
 #error "STM32_RNGCLK not defined in this HAL"
 #endif
 
+#if TRNG_USE_POOL == TRUE
+#if !defined(STM32_RNG1_HANDLER) || !defined(STM32_RNG1_NUMBER)
+#error "STM32_RNG1_HANDLER or STM32_RNG1_NUMBER not defined in this HAL"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_TRNG_RNG1_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to RNG1"
+#endif
+#endif
+
 #if ((STM32_RNGCLK < 47000000) || (STM32_RNGCLK > 49000000)) &&             \
     ((STM32_RNGCLK < 3500000)  || (STM32_RNGCLK > 4500000))
 #if !defined(STM32_DISABLE_RNG_CLOCK_CHECK)
@@ -93,6 +111,11 @@
 #endif
 #endif
 
+/**
+ * @brief   The entropy pool is supported.
+ */
+#define TRNG_LLD_SUPPORTS_POOL
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -130,6 +153,9 @@ extern "C" {
   void trng_lld_start(TRNGDriver *trngp);
   void trng_lld_stop(TRNGDriver *trngp);
   bool trng_lld_generate(TRNGDriver *trngp, size_t size, uint8_t *out);
+#if TRNG_USE_POOL == TRUE
+  void trng_lld_pool_refill_i(TRNGDriver *trngp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -207,6 +207,12 @@ static bool sdc_lld_prepare_write(SDCDriver *sdcp, uint32_t startblk,
     startblk *= MMCSD_BLOCK_SIZE;
 
   if (n > 1) {
+#if SDC_USE_PREERASE == TRUE
+    /* Declaring the number of blocks to be written for pre-erase.*/
+    if (_sdc_preerase(sdcp, n))
+      return HAL_FAILED;
+#endif
+
     /* Write multiple blocks command.*/
     if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_WRITE_MULTIPLE_BLOCK,
                                    startblk, resp) || MMCSD_R1_ERROR(resp[0]))
@@ -61,7 +61,11 @@ SDCDriver SDCD2;
  * @brief   SDIO default configuration.
  */
 static const SDCConfig sdc_default_cfg = {
-  SDC_MODE_4BIT
+  SDC_MODE_4BIT,
+#if SDC_UHS_SUPPORT == TRUE
+  SDC_SIGNALING_3V3,
+  NULL
+#endif
 };
 
 /*===========================================================================*/
@@ -85,6 +89,69 @@ static uint32_t sdc_lld_clkdiv(SDCDriver *sdcp, uint32_t f) {
   return (sdcp->clkfreq + (f * 2) - 1) / (f * 2);
 }
 
+#if ((SDC_UHS_SUPPORT == TRUE) && (STM32_SDC_SDMMC_HAS_DLYB == TRUE)) ||    \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Calibrates the delay block on the current clock period.
+ * @details Searches the smallest delay cell unit for which the twelve cells
+ *          line spans a whole clock period.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[out] unitp    pointer to the found unit delay
+ * @return              The number of selectable phases in a clock period,
+ *                      zero if the calibration failed.
+ *
+ * @notapi
+ */
+static unsigned sdc_lld_dlyb_calibrate(SDCDriver *sdcp, uint32_t *unitp) {
+  DLYB_TypeDef *dlyb = sdcp->dlyb;
+  uint32_t unit, lng;
+  unsigned phases;
+
+  dlyb->CR = DLYB_CR_DEN | DLYB_CR_SEN;
+  for (unit = 0U; unit < 128U; unit++) {
+    dlyb->CFGR = (12U << DLYB_CFGR_SEL_Pos) | (unit << DLYB_CFGR_UNIT_Pos);
+    while ((dlyb->CFGR & DLYB_CFGR_LNGF) == 0U)
+      ;
+
+    /* A clock edge must fall inside the line but not in its last cells.*/
+    lng = dlyb->CFGR & DLYB_CFGR_LNG;
+    if ((lng != 0U) && (lng < (DLYB_CFGR_LNG_10 | DLYB_CFGR_LNG_11))) {
+      *unitp = unit;
+
+      /* The last cell sampling a high clock marks the period end.*/
+      phases = 10U;
+      while ((phases > 0U) && ((lng & (DLYB_CFGR_LNG_0 << phases)) == 0U)) {
+        phases--;
+      }
+      return phases;
+    }
+  }
+
+  dlyb->CR = 0U;
+  return 0U;
+}
+
+/**
+ * @brief   Selects the delay block output phase.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] unit      unit delay found by the calibration
+ * @param[in] phase     output phase
+ *
+ * @notapi
+ */
+static void sdc_lld_dlyb_set_phase(SDCDriver *sdcp, uint32_t unit,
+                                   unsigned phase) {
+  DLYB_TypeDef *dlyb = sdcp->dlyb;
+
+  dlyb->CR   = DLYB_CR_DEN | DLYB_CR_SEN;
+  dlyb->CFGR = ((uint32_t)phase << DLYB_CFGR_SEL_Pos) |
+               (unit << DLYB_CFGR_UNIT_Pos);
+  dlyb->CR   = DLYB_CR_DEN;
+}
+#endif
+
 /**
  * @brief   Prepares to handle read transaction.
  * @details Designed for read special registers from card.
@@ -189,6 +256,12 @@ static bool sdc_lld_prepare_write(SDCDriver *sdcp, uint32_t startblk,
     startblk *= MMCSD_BLOCK_SIZE;
 
   if (n > 1) {
+#if SDC_USE_PREERASE == TRUE
+    /* Declaring the number of blocks to be written for pre-erase.*/
+    if (_sdc_preerase(sdcp, n))
+      return HAL_FAILED;
+#endif
+
     /* Write multiple blocks command.*/
     if (sdc_lld_send_cmd_short_crc(sdcp, SDMMC_CMD_CMDTRANS | MMCSD_CMD_WRITE_MULTIPLE_BLOCK,
                                    startblk, resp) || MMCSD_R1_ERROR(resp[0]))
@@ -317,6 +390,9 @@ void sdc_lld_init(void) {
   SDCD1.thread  = NULL;
   SDCD1.sdmmc   = SDMMC1;
   SDCD1.clkfreq = STM32_SDMMC1CLK;
+#if (SDC_UHS_SUPPORT == TRUE) && (STM32_SDC_SDMMC_HAS_DLYB == TRUE)
+  SDCD1.dlyb    = DLYB_SDMMC1;
+#endif
 #endif
 
 #if STM32_SDC_USE_SDMMC2
@@ -324,6 +400,9 @@ void sdc_lld_init(void) {
   SDCD2.thread  = NULL;
   SDCD2.sdmmc   = SDMMC2;
   SDCD2.clkfreq = STM32_SDMMC2CLK;
+#if (SDC_UHS_SUPPORT == TRUE) && (STM32_SDC_SDMMC_HAS_DLYB == TRUE)
+  SDCD2.dlyb    = DLYB_SDMMC2;
+#endif
 #endif
 }
 
@@ -408,6 +487,11 @@ void sdc_lld_stop(SDCDriver *sdcp) {
  */
 void sdc_lld_start_clk(SDCDriver *sdcp) {
 
+#if (SDC_UHS_SUPPORT == TRUE) && (STM32_SDC_SDMMC_HAS_DLYB == TRUE)
+  /* Tuning from a previous connection is discarded.*/
+  sdcp->dlyb->CR = 0U;
+#endif
+
   /* Initial clock setting: 400kHz, 1bit mode.*/
   sdcp->sdmmc->CLKCR  = sdc_lld_clkdiv(sdcp, 4000000);
   sdcp->sdmmc->POWER |= SDMMC_POWER_PWRCTRL_0 | SDMMC_POWER_PWRCTRL_1;
@@ -419,6 +503,8 @@ void sdc_lld_start_clk(SDCDriver *sdcp) {
 
 /**
  * @brief   Sets the SDIO clock to data mode (25/50 MHz or less).
+ * @note    The 100 and 200MHz modes are limited by the SDMMC clock, the
+ *          DDR mode cannot bypass the divider.
  *
  * @param[in] sdcp      pointer to the @p SDCDriver object
  * @param[in] clk       the clock mode
@@ -426,24 +512,41 @@ void sdc_lld_start_clk(SDCDriver *sdcp) {
  * @notapi
  */
 void sdc_lld_set_data_clk(SDCDriver *sdcp, sdcbusclk_t clk) {
+  uint32_t clkcr = sdcp->sdmmc->CLKCR & ~(SDMMC_CLKCR_CLKDIV |
+                                          SDMMC_CLKCR_DDR |
+                                          SDMMC_CLKCR_BUSSPEED);
 
-  if (SDC_CLK_50MHz == clk) {
-    sdcp->sdmmc->CLKCR = (sdcp->sdmmc->CLKCR & 0xFFFFFF00U) |
 #if STM32_SDC_SDMMC_PWRSAV
-                         sdc_lld_clkdiv(sdcp, 50000000) | SDMMC_CLKCR_PWRSAV;
-#else
-                         sdc_lld_clkdiv(sdcp, 50000000);
+  clkcr |= SDMMC_CLKCR_PWRSAV;
 #endif
-  }
-  else {
-#if STM32_SDC_SDMMC_PWRSAV
-    sdcp->sdmmc->CLKCR = (sdcp->sdmmc->CLKCR & 0xFFFFFF00U) |
-                         sdc_lld_clkdiv(sdcp, 25000000) | SDMMC_CLKCR_PWRSAV;
-#else
-    sdcp->sdmmc->CLKCR = (sdcp->sdmmc->CLKCR & 0xFFFFFF00U) |
-                         sdc_lld_clkdiv(sdcp, 25000000);
+
+  switch (clk) {
+  case SDC_CLK_50MHz:
+    clkcr |= sdc_lld_clkdiv(sdcp, 50000000);
+    break;
+#if SDC_UHS_SUPPORT == TRUE
+  case SDC_CLK_50MHz_DDR:
+    if (sdc_lld_clkdiv(sdcp, 50000000) == 0U) {
+      clkcr |= SDMMC_CLKCR_DDR | SDMMC_CLKCR_BUSSPEED | 1U;
+    }
+    else {
+      clkcr |= SDMMC_CLKCR_DDR | SDMMC_CLKCR_BUSSPEED |
+               sdc_lld_clkdiv(sdcp, 50000000);
+    }
+    break;
+  case SDC_CLK_100MHz:
+    clkcr |= SDMMC_CLKCR_BUSSPEED | sdc_lld_clkdiv(sdcp, 100000000);
+    break;
+  case SDC_CLK_200MHz:
+    clkcr |= SDMMC_CLKCR_BUSSPEED | sdc_lld_clkdiv(sdcp, 200000000);
+    break;
 #endif
+  default:
+    clkcr |= sdc_lld_clkdiv(sdcp, 25000000);
+    break;
   }
+
+  sdcp->sdmmc->CLKCR = clkcr;
 }
 
 /**
@@ -844,6 +947,134 @@ bool sdc_lld_sync(SDCDriver *sdcp) {
   return HAL_SUCCESS;
 }
 
+#if (SDC_UHS_SUPPORT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Switches the card I/O to 1.8V signaling.
+ * @details Sends CMD11 then, with the card clock stopped, invokes the board
+ *          callback and completes the switch checking that the card
+ *          released the data line.
+ * @note    The card is unusable if the procedure fails after CMD11, it
+ *          must be power cycled.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool sdc_lld_switch_voltage(SDCDriver *sdcp) {
+  uint32_t resp[1];
+  uint32_t sta;
+
+  osalDbgAssert(sdcp->config->vswitch_cb != NULL, "no voltage switch callback");
+
+  sdcp->sdmmc->POWER |= SDMMC_POWER_VSWITCHEN;
+  if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_VOLTAGE_SWITCH, 0, resp) ||
+      MMCSD_R1_ERROR(resp[0])) {
+    sdcp->sdmmc->POWER &= ~SDMMC_POWER_VSWITCHEN;
+    return HAL_FAILED;
+  }
+
+  /* The clock is stopped by the hardware after the response.*/
+  while ((sdcp->sdmmc->STA & SDMMC_STA_CKSTOP) == 0)
+    ;
+  sdcp->sdmmc->ICR = SDMMC_ICR_CKSTOPC;
+
+  /* Board switch then the hardware restarts the clock and waits for the
+     card to release the data line.*/
+  sdcp->config->vswitch_cb(sdcp);
+  sdcp->sdmmc->POWER |= SDMMC_POWER_VSWITCH;
+  while (((sta = sdcp->sdmmc->STA) & SDMMC_STA_VSWEND) == 0)
+    ;
+  sdcp->sdmmc->ICR    = SDMMC_ICR_VSWENDC;
+  sdcp->sdmmc->POWER &= ~(SDMMC_POWER_VSWITCHEN | SDMMC_POWER_VSWITCH);
+
+  if ((sta & SDMMC_STA_BUSYD0) != 0) {
+    return HAL_FAILED;
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Tunes the data sampling point.
+ * @details The delay block phases are swept reading the tuning block, the
+ *          middle of the widest window of error-free reads is selected.
+ *          Without a delay block the sampling point is fixed and the tuning
+ *          block is read once to verify it.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] cmd       tuning command, CMD19 for SD or CMD21 for eMMC
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool sdc_lld_execute_tuning(SDCDriver *sdcp, uint8_t cmd) {
+  size_t n;
+
+  /* The 8 bits bus eMMC tuning block is twice as large.*/
+  if ((sdcp->sdmmc->CLKCR & SDMMC_CLKCR_WIDBUS_1) != 0U) {
+    n = 128U;
+  }
+  else {
+    n = 64U;
+  }
+
+#if STM32_SDC_SDMMC_HAS_DLYB == TRUE
+  {
+    uint32_t unit = 0U;
+    unsigned phases, phase, start, len, best_start, best_len;
+
+    phases = sdc_lld_dlyb_calibrate(sdcp, &unit);
+    if (phases == 0U) {
+      return HAL_FAILED;
+    }
+
+    /* Sampling with the delay block feedback clock.*/
+    sdcp->sdmmc->CLKCR = (sdcp->sdmmc->CLKCR & ~SDMMC_CLKCR_SELCLKRX) |
+                         SDMMC_CLKCR_SELCLKRX_1;
+
+    start      = 0U;
+    len        = 0U;
+    best_start = 0U;
+    best_len   = 0U;
+    for (phase = 0U; phase <= phases; phase++) {
+      sdc_lld_dlyb_set_phase(sdcp, unit, phase);
+      if (sdc_lld_read_special(sdcp, sdcp->buf, n, cmd, 0)) {
+        len = 0U;
+        continue;
+      }
+      if (len == 0U) {
+        start = phase;
+      }
+      len++;
+      if (len > best_len) {
+        best_start = start;
+        best_len   = len;
+      }
+    }
+
+    /* Errors from the failed phases are not meaningful.*/
+    sdcp->errors = SDC_NO_ERROR;
+
+    if (best_len == 0U) {
+      sdcp->sdmmc->CLKCR &= ~SDMMC_CLKCR_SELCLKRX;
+      sdcp->dlyb->CR = 0U;
+      return HAL_FAILED;
+    }
+    sdc_lld_dlyb_set_phase(sdcp, unit, best_start + (best_len / 2U));
+  }
+#endif
+
+  return sdc_lld_read_special(sdcp, sdcp->buf, n, cmd, 0);
+}
+#endif /* SDC_UHS_SUPPORT == TRUE */
+
 /**
  * @brief   Shared service routine.
  *
@@ -31,6 +31,11 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   This driver supports the eMMC HS200/DDR52 and SD UHS-I modes.
+ */
+#define SDC_SUPPORTS_UHS                    TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -145,8 +150,21 @@
 #endif
 
 #if !defined(STM32_SDMMC_MAXCLK)
+#if SDC_UHS_SUPPORT == TRUE
+#define STM32_SDMMC_MAXCLK              200000000
+#else
 #define STM32_SDMMC_MAXCLK              50000000
 #endif
+#endif
+
+/**
+ * @brief   Delay block availability for the sampling point tuning.
+ */
+#if defined(DLYB_SDMMC1) || defined(__DOXYGEN__)
+#define STM32_SDC_SDMMC_HAS_DLYB        TRUE
+#else
+#define STM32_SDC_SDMMC_HAS_DLYB        FALSE
+#endif
 
 #if STM32_HAS_SDMMC1 && (STM32_SDMMC1CLK > STM32_SDMMC_MAXCLK)
 #error "STM32_SDMMC1CLK must not exceed STM32_SDMMC_MAXCLK"
@@ -175,6 +193,11 @@ typedef uint32_t sdcflags_t;
  */
 typedef struct SDCDriver SDCDriver;
 
+/**
+ * @brief   Type of a card I/O voltage switch callback.
+ */
+typedef void (*sdcvswitchcb_t)(SDCDriver *sdcp);
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -185,6 +208,22 @@ typedef struct {
    */
   sdcbusmode_t  bus_width;
   /* End of the mandatory fields.*/
+#if (SDC_UHS_SUPPORT == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Card I/O signaling capability of the board.
+   * @note    Use @p SDC_SIGNALING_1V8 for eMMC devices with a 1.8V VCCQ
+   *          and @p SDC_SIGNALING_SWITCHABLE for SD slots with a level
+   *          translator.
+   */
+  uint32_t      signaling;
+  /**
+   * @brief   Switches the board card I/O to 1.8V.
+   * @note    Required with @p SDC_SIGNALING_SWITCHABLE, it is invoked with
+   *          the card clock stopped. The board must restore 3.3V when the
+   *          card is powered down.
+   */
+  sdcvswitchcb_t vswitch_cb;
+#endif
 } SDCConfig;
 
 /**
@@ -241,6 +280,13 @@ struct SDCDriver {
    * @brief   Input clock frequency.
    */
   uint32_t                  clkfreq;
+#if ((SDC_UHS_SUPPORT == TRUE) && (STM32_SDC_SDMMC_HAS_DLYB == TRUE)) ||    \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Pointer to the delay block used for tuning.
+   */
+  DLYB_TypeDef              *dlyb;
+#endif
   /**
    * @brief   Buffer for internal operations.
    */
@@ -251,6 +297,17 @@ struct SDCDriver {
 /* Driver macros.                                                            */
 /*===========================================================================*/
 
+#if (SDC_UHS_SUPPORT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the card I/O signaling capability of the board.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @notapi
+ */
+#define sdc_lld_get_signaling(sdcp) ((sdcp)->config->signaling)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -290,6 +347,10 @@ extern "C" {
   bool sdc_lld_is_card_inserted(SDCDriver *sdcp);
   bool sdc_lld_is_write_protected(SDCDriver *sdcp);
   void sdc_lld_serve_interrupt(SDCDriver *sdcp);
+#if SDC_UHS_SUPPORT == TRUE
+  bool sdc_lld_switch_voltage(SDCDriver *sdcp);
+  bool sdc_lld_execute_tuning(SDCDriver *sdcp, uint8_t cmd);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -465,9 +465,20 @@ void spi_lld_start(SPIDriver *spip) {
 
   /* SPI setup and enable.*/
   spip->spi->CR1 &= ~SPI_CR1_SPE;
-  spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR;
-  spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH | SPI_CR2_SSOE |
-                    SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+#if SPI_USE_SLAVE == TRUE
+  if (spip->config->slave) {
+    /* Slave mode, NSS is an input and the clock comes from the master.*/
+    spip->spi->CR1  = spip->config->cr1 & ~SPI_CR1_MSTR;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH |
+                      SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+  }
+  else
+#endif
+  {
+    spip->spi->CR1  = spip->config->cr1 | SPI_CR1_MSTR;
+    spip->spi->CR2  = spip->config->cr2 | SPI_CR2_FRXTH | SPI_CR2_SSOE |
+                      SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+  }
   spip->spi->CR1 |= SPI_CR1_SPE;
 }
 
@@ -666,6 +677,8 @@ void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
 #if (SPI_SUPPORTS_CIRCULAR == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Aborts the ongoing SPI operation, if any.
+ * @note    In slave mode the words already preloaded in the TX FIFO are
+ *          not discarded, this peripheral can only flush it with a reset.
  *
  * @param[in] spip      pointer to the @p SPIDriver object
  *
@@ -676,6 +689,17 @@ void spi_lld_abort(SPIDriver *spip) {
   /* Stopping DMAs.*/
   dmaStreamDisable(spip->dmatx);
   dmaStreamDisable(spip->dmarx);
+
+#if SPI_USE_SLAVE == TRUE
+  /* Draining the RX FIFO of a slave, the master could have been clocking
+     while the DMA was being stopped.*/
+  if (spip->config->slave) {
+    while ((spip->spi->SR & SPI_SR_FRLVL) != 0U) {
+      (void)spip->spi->DR;
+    }
+    (void)spip->spi->SR;
+  }
+#endif
 }
 #endif /* SPI_SUPPORTS_CIRCULAR == TRUE */
 
@@ -36,6 +36,11 @@
  */
 #define SPI_SUPPORTS_CIRCULAR           TRUE
 
+/**
+ * @brief   Slave mode support flag.
+ */
+#define SPI_SUPPORTS_SLAVE_MODE         TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -494,6 +499,16 @@
   /* SPI CR2 register initialization data.*/                                \
   uint16_t                  cr2
 
+/**
+ * @brief   Returns the number of words left in the current RX cycle.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @return              The number of words not yet received.
+ *
+ * @notapi
+ */
+#define spi_lld_get_remaining(spip) dmaStreamGetTransactionSize((spip)->dmarx)
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
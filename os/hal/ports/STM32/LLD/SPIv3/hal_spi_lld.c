@@ -82,6 +82,18 @@ static void spi_lld_wait_complete(SPIDriver *spip) {
   spip->spi->IFCR = 0xFFFFFFFF;
 }
 
+static void spi_lld_start_transfer(SPIDriver *spip) {
+
+#if SPI_USE_SLAVE == TRUE
+  /* In slave mode the transfer is started by the master clock.*/
+  if (spip->config->slave) {
+    return;
+  }
+#endif
+
+  spip->spi->CR1 |= SPI_CR1_CSTART;
+}
+
 #if defined(STM32_SPI_BDMA_REQUIRED)
 /**
  * @brief   Shared DMA end-of-rx service routine.
@@ -713,8 +725,18 @@ void spi_lld_start(SPIDriver *spip) {
   spip->spi->CR2  = 0U;
   spip->spi->CFG1 = (spip->config->cfg1 & ~SPI_CFG1_FTHLV_Msk) |
                     SPI_CFG1_RXDMAEN | SPI_CFG1_TXDMAEN;
-  spip->spi->CFG2 = (spip->config->cfg2 | SPI_CFG2_MASTER | SPI_CFG2_SSOE) &
-                    ~SPI_CFG2_COMM_Msk;
+#if SPI_USE_SLAVE == TRUE
+  if (spip->config->slave) {
+    /* Slave mode, NSS is an input and the clock comes from the master.*/
+    spip->spi->CFG2 = spip->config->cfg2 &
+                      ~(SPI_CFG2_MASTER | SPI_CFG2_SSOE | SPI_CFG2_COMM_Msk);
+  }
+  else
+#endif
+  {
+    spip->spi->CFG2 = (spip->config->cfg2 | SPI_CFG2_MASTER | SPI_CFG2_SSOE) &
+                      ~SPI_CFG2_COMM_Msk;
+  }
   spip->spi->IER  = SPI_IER_OVRIE;
   spip->spi->IFCR = 0xFFFFFFFFU;
   spip->spi->CR1 |= SPI_CR1_SPE;
@@ -862,7 +884,7 @@ void spi_lld_ignore(SPIDriver *spip, size_t n) {
   }
 #endif
 
-  spip->spi->CR1 |= SPI_CR1_CSTART;
+  spi_lld_start_transfer(spip);
 }
 
 /**
@@ -922,7 +944,7 @@ void spi_lld_exchange(SPIDriver *spip, size_t n,
   }
 #endif
 
-  spip->spi->CR1 |= SPI_CR1_CSTART;
+  spi_lld_start_transfer(spip);
 }
 
 /**
@@ -979,7 +1001,7 @@ void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
   }
 #endif
 
-  spip->spi->CR1 |= SPI_CR1_CSTART;
+  spi_lld_start_transfer(spip);
 }
 
 /**
@@ -1036,7 +1058,7 @@ void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
   }
 #endif
 
-  spip->spi->CR1 |= SPI_CR1_CSTART;
+  spi_lld_start_transfer(spip);
 }
 
 #if (SPI_SUPPORTS_CIRCULAR == TRUE) || defined(__DOXYGEN__)
@@ -1049,10 +1071,15 @@ void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
  */
 void spi_lld_abort(SPIDriver *spip) {
 
-  /* Stopping SPI.*/
-  spip->spi->CR1 |= SPI_CR1_CSUSP;
+#if SPI_USE_SLAVE == TRUE
+  if (!spip->config->slave)
+#endif
+  {
+    /* Stopping SPI.*/
+    spip->spi->CR1 |= SPI_CR1_CSUSP;
 
-  spi_lld_wait_complete(spip);
+    spi_lld_wait_complete(spip);
+  }
 
   /* Stopping DMAs.*/
 #if defined(STM32_SPI_DMA_REQUIRED) && defined(STM32_SPI_BDMA_REQUIRED)
@@ -1073,9 +1100,49 @@ void spi_lld_abort(SPIDriver *spip) {
     dmaStreamDisable(spip->rx.dma);
   }
 #endif
+
+#if SPI_USE_SLAVE == TRUE
+  /* In slave mode the FIFOs are flushed by disabling the peripheral, the
+     next operation starts with a clean TX preload.*/
+  if (spip->config->slave) {
+    spip->spi->CR1 &= ~SPI_CR1_SPE;
+    spip->spi->IFCR = 0xFFFFFFFFU;
+    spip->spi->CR1 |= SPI_CR1_SPE;
+  }
+#endif
 }
 #endif /* SPI_SUPPORTS_CIRCULAR == TRUE */
 
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the number of words left in the current RX cycle.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @return              The number of words not yet received.
+ *
+ * @notapi
+ */
+size_t spi_lld_get_remaining(SPIDriver *spip) {
+
+#if defined(STM32_SPI_DMA_REQUIRED) && defined(STM32_SPI_BDMA_REQUIRED)
+  if (spip->is_bdma)
+#endif
+#if defined(STM32_SPI_BDMA_REQUIRED)
+  {
+    return bdmaStreamGetTransactionSize(spip->rx.bdma);
+  }
+#endif
+#if defined(STM32_SPI_DMA_REQUIRED) && defined(STM32_SPI_BDMA_REQUIRED)
+  else
+#endif
+#if defined(STM32_SPI_DMA_REQUIRED)
+  {
+    return dmaStreamGetTransactionSize(spip->rx.dma);
+  }
+#endif
+}
+#endif /* SPI_USE_SLAVE == TRUE */
+
 /**
  * @brief   Exchanges one frame using a polled wait.
  * @details This synchronous function exchanges one frame using a polled
@@ -36,6 +36,11 @@
  */
 #define SPI_SUPPORTS_CIRCULAR           TRUE
 
+/**
+ * @brief   Slave mode support flag.
+ */
+#define SPI_SUPPORTS_SLAVE_MODE         TRUE
+
 /**
  * @name    Register helpers not found in ST headers
  * @{
@@ -577,6 +582,9 @@ extern "C" {
   void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf);
 #if (SPI_SUPPORTS_CIRCULAR == TRUE) || defined(__DOXYGEN__)
   void spi_lld_abort(SPIDriver *spip);
+#endif
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+  size_t spi_lld_get_remaining(SPIDriver *spip);
 #endif
   uint32_t spi_lld_polled_exchange(SPIDriver *spip, uint32_t frame);
 #ifdef __cplusplus
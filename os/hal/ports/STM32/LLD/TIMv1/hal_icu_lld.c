@@ -210,6 +210,44 @@ static bool icu_lld_wait_edge(ICUDriver *icup) {
   return result;
 }
 
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   DMA capture mode stream interrupt handler.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void icu_lld_serve_dma_interrupt(ICUDriver *icup, uint32_t flags) {
+  const icu_dma_capture_t *half;
+
+  /* DMA errors handling.*/
+  if ((flags & STM32_DMA_ISR_TEIF) != 0U) {
+    STM32_ICU_DMA_ERROR_HOOK(icup);
+    return;
+  }
+
+  if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+    /* Second half of the ring filled.*/
+    half = &icup->config->dmabuf[icup->config->dmadepth / 2U];
+  }
+  else if ((flags & STM32_DMA_ISR_HTIF) != 0U) {
+    /* First half of the ring filled.*/
+    half = &icup->config->dmabuf[0];
+  }
+  else {
+    return;
+  }
+
+  osalSysLockFromISR();
+  if (icup->dmahalf != NULL) {
+    icup->dmaoverruns++;
+  }
+  icup->dmahalf = half;
+  osalThreadResumeI(&icup->dmathread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+#endif /* STM32_ICU_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -557,6 +595,13 @@ void icu_lld_start(ICUDriver *icup) {
                 "invalid input");
 
   if (icup->state == ICU_STOP) {
+#if STM32_ICU_USE_DMA == TRUE
+    icup->dma         = NULL;
+    icup->dmathread   = NULL;
+    icup->dmahalf     = NULL;
+    icup->dmaoverruns = 0U;
+#endif
+
     /* Clock activation and timer reset.*/
 #if STM32_ICU_USE_TIM1
     if (&ICUD1 == icup) {
@@ -846,6 +891,35 @@ void icu_lld_start(ICUDriver *icup) {
     icup->wccrp = &icup->tim->CCR[0];
     icup->pccrp = &icup->tim->CCR[1];
   }
+
+#if STM32_ICU_USE_DMA == TRUE
+  /* A previously allocated stream is released because the new
+     configuration could specify a different one.*/
+  if (icup->dma != NULL) {
+    dmaStreamFreeI(icup->dma);
+    icup->dma = NULL;
+  }
+
+  if (icup->config->dmabuf != NULL) {
+    osalDbgAssert((icup->config->dmadepth >= 2U) &&
+                  ((icup->config->dmadepth & 1U) == 0U),
+                  "invalid ring depth");
+
+    icup->dma = dmaStreamAllocI(icup->config->dmastream,
+                                STM32_ICU_DMA_IRQ_PRIORITY,
+                                (stm32_dmaisr_t)icu_lld_serve_dma_interrupt,
+                                (void *)icup);
+    osalDbgAssert(icup->dma != NULL, "unable to allocate stream");
+    dmaStreamSetPeripheral(icup->dma, &icup->tim->DMAR);
+#if STM32_DMA_SUPPORTS_DMAMUX
+    dmaSetRequestSource(icup->dma, icup->config->dmarequest);
+#endif
+
+    /* Each period capture request triggers a burst of two transfers
+       reading CCR1 and CCR2 through DMAR, CCR1 is register 13.*/
+    icup->tim->DCR = STM32_TIM_DCR_DBA(13U) | STM32_TIM_DCR_DBL(1U);
+  }
+#endif
 }
 
 /**
@@ -863,6 +937,13 @@ void icu_lld_stop(ICUDriver *icup) {
     icup->tim->DIER = 0;                    /* All IRQs disabled.           */
     icup->tim->SR   = 0;                    /* Clear eventual pending IRQs. */
 
+#if STM32_ICU_USE_DMA == TRUE
+    if (icup->dma != NULL) {
+      dmaStreamFreeI(icup->dma);
+      icup->dma = NULL;
+    }
+#endif
+
 #if STM32_ICU_USE_TIM1
     if (&ICUD1 == icup) {
 #if !defined(STM32_TIM1_SUPPRESS_ISR)
@@ -994,6 +1075,31 @@ void icu_lld_start_capture(ICUDriver *icup) {
   icup->tim->EGR |= STM32_TIM_EGR_UG;
   icup->tim->SR = 0;
 
+#if STM32_ICU_USE_DMA == TRUE
+  if (icup->dma != NULL) {
+    /* Circular transfer of two words per period capture.*/
+    icup->dmahalf = NULL;
+    dmaStreamSetMemory0(icup->dma, icup->config->dmabuf);
+    dmaStreamSetTransactionSize(icup->dma, icup->config->dmadepth * 2U);
+    dmaStreamSetMode(icup->dma, icup->config->dmamode |
+                                STM32_DMA_CR_PL(STM32_ICU_DMA_PRIORITY) |
+                                STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+                                STM32_DMA_CR_PSIZE_WORD |
+                                STM32_DMA_CR_MSIZE_WORD |
+                                STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE |
+                                STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE);
+    dmaStreamEnable(icup->dma);
+
+    /* DMA request on the period capture.*/
+    if (icup->config->channel == ICU_CHANNEL_1) {
+      icup->tim->DIER |= STM32_TIM_DIER_CC1DE;
+    }
+    else {
+      icup->tim->DIER |= STM32_TIM_DIER_CC2DE;
+    }
+  }
+#endif
+
   /* Timer is started.*/
   icup->tim->CR1 = STM32_TIM_CR1_URS | STM32_TIM_CR1_CEN;
 }
@@ -1036,6 +1142,17 @@ void icu_lld_stop_capture(ICUDriver *icup) {
 
   /* All interrupts disabled.*/
   icup->tim->DIER &= ~STM32_TIM_DIER_IRQ_MASK;
+
+#if STM32_ICU_USE_DMA == TRUE
+  if (icup->dma != NULL) {
+    /* Restoring the DMA settings of the configuration.*/
+    icup->tim->DIER = (icup->tim->DIER &
+                       ~(STM32_TIM_DIER_CC1DE | STM32_TIM_DIER_CC2DE)) |
+                      (icup->config->dier & ~STM32_TIM_DIER_IRQ_MASK);
+    dmaStreamDisable(icup->dma);
+    osalThreadResumeI(&icup->dmathread, MSG_RESET);
+  }
+#endif
 }
 
 /**
@@ -1130,6 +1247,95 @@ void icu_lld_serve_interrupt(ICUDriver *icup) {
     _icu_isr_invoke_overflow_cb(icup);
 }
 
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Waits for a filled half of the DMA capture ring.
+ * @details In DMA capture mode the entries are written in the ring without
+ *          CPU intervention, the waiting thread is woken once per half
+ *          ring and can process the filled half while the other half is
+ *          being written.
+ * @note    The returned entries must be consumed before the DMA wraps
+ *          around and overwrites them, halves not consumed in time are
+ *          counted in @p dmaoverruns.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[out] bufp     pointer to a variable receiving the address of the
+ *                      first entry of the filled half
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of entries in the filled half.
+ * @retval 0            if a timeout occurred or the capture has been
+ *                      stopped.
+ *
+ * @api
+ */
+size_t icuSTM32WaitCapturesTimeout(ICUDriver *icup,
+                                   const icu_dma_capture_t **bufp,
+                                   sysinterval_t timeout) {
+  size_t n = 0U;
+
+  osalDbgCheck((icup != NULL) && (bufp != NULL));
+
+  osalSysLock();
+  osalDbgAssert(((icup->state == ICU_WAITING) ||
+                 (icup->state == ICU_ACTIVE)) && (icup->dma != NULL),
+                "invalid state");
+
+  if ((icup->dmahalf != NULL) ||
+      (osalThreadSuspendTimeoutS(&icup->dmathread, timeout) == MSG_OK)) {
+    *bufp = icup->dmahalf;
+    icup->dmahalf = NULL;
+    n = icup->config->dmadepth / 2U;
+  }
+  osalSysUnlock();
+
+  return n;
+}
+
+/**
+ * @brief   Computes the statistics of a set of DMA capture ring entries.
+ * @details Average frequency and duty cycle of tachometer-like inputs are
+ *          obtained from the sums as @p frequency * @p n / @p period_sum
+ *          and @p width_sum / @p period_sum.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[in] buf       pointer to the first entry
+ * @param[in] n         number of entries
+ * @param[out] sp       pointer to the statistics to be filled
+ *
+ * @xclass
+ */
+void icuSTM32ComputeStats(ICUDriver *icup,
+                          const icu_dma_capture_t *buf,
+                          size_t n,
+                          icu_dma_stats_t *sp) {
+  size_t i;
+
+  osalDbgCheck((icup != NULL) && (buf != NULL) && (sp != NULL));
+
+  sp->n          = n;
+  sp->period_min = 0xFFFFFFFFU;
+  sp->period_max = 0U;
+  sp->period_sum = 0U;
+  sp->width_sum  = 0U;
+  for (i = 0U; i < n; i++) {
+    icucnt_t period = icuSTM32GetEntryPeriod(icup, &buf[i]);
+
+    if (period < sp->period_min) {
+      sp->period_min = period;
+    }
+    if (period > sp->period_max) {
+      sp->period_max = period;
+    }
+    sp->period_sum += (uint64_t)period;
+    sp->width_sum  += (uint64_t)icuSTM32GetEntryWidth(icup, &buf[i]);
+  }
+}
+#endif /* STM32_ICU_USE_DMA == TRUE */
+
 #endif /* HAL_USE_ICU */
 
 /** @} */
@@ -296,12 +296,57 @@
 #if !defined(STM32_ICU_TIM22_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_ICU_TIM22_IRQ_PRIORITY        7
 #endif
+
+/**
+ * @brief   Enables the DMA capture mode.
+ * @details In DMA capture mode the period and width values are streamed
+ *          into a ring buffer by a TIM DMA burst triggered by the period
+ *          capture, the consumer is notified once per half ring.
+ */
+#if !defined(STM32_ICU_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_ICU_USE_DMA                   FALSE
+#endif
+
+/**
+ * @brief   DMA capture mode DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_ICU_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_DMA_PRIORITY              2
+#endif
+
+/**
+ * @brief   DMA capture mode DMA interrupt priority level setting.
+ */
+#if !defined(STM32_ICU_DMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_ICU_DMA_IRQ_PRIORITY          7
+#endif
+
+/**
+ * @brief   ICU DMA error hook.
+ */
+#if !defined(STM32_ICU_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_ICU_DMA_ERROR_HOOK(icup)      osalSysHalt("DMA failure")
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if STM32_ICU_USE_DMA == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_ICU_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to ICU"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_ICU_DMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to ICU DMA"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* STM32_ICU_USE_DMA == TRUE */
+
 #if !defined(STM32_HAS_TIM1)
 #define STM32_HAS_TIM1                      FALSE
 #endif
@@ -681,6 +726,45 @@ typedef enum {
  */
 typedef uint32_t icucnt_t;
 
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a DMA capture ring entry.
+ * @details The entry contains the CCR1 and CCR2 registers captured at
+ *          a period edge, use @p icuSTM32GetEntryPeriod() and
+ *          @p icuSTM32GetEntryWidth() in order to decode it.
+ */
+typedef struct {
+  uint32_t                  ccr1;
+  uint32_t                  ccr2;
+} icu_dma_capture_t;
+
+/**
+ * @brief   Type of the statistics over a set of captures.
+ */
+typedef struct {
+  /**
+   * @brief   Number of captures.
+   */
+  size_t                    n;
+  /**
+   * @brief   Minimum period.
+   */
+  icucnt_t                  period_min;
+  /**
+   * @brief   Maximum period.
+   */
+  icucnt_t                  period_max;
+  /**
+   * @brief   Sum of the periods.
+   */
+  uint64_t                  period_sum;
+  /**
+   * @brief   Sum of the widths.
+   */
+  uint64_t                  width_sum;
+} icu_dma_stats_t;
+#endif /* STM32_ICU_USE_DMA == TRUE */
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -725,6 +809,32 @@ typedef struct {
    * @note  The value of this field should normally be equal to 0xFFFFFFFFU.
    */
   uint32_t                  arr;
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   DMA capture ring buffer or @p NULL for interrupt capture.
+   */
+  icu_dma_capture_t         *dmabuf;
+  /**
+   * @brief   Number of entries in the ring buffer, must be even.
+   */
+  size_t                    dmadepth;
+  /**
+   * @brief   DMA stream serving the CC request of the period channel.
+   */
+  uint32_t                  dmastream;
+  /**
+   * @brief   Additional DMA CR settings.
+   * @note    Channel selection bits are specified here on devices without
+   *          DMAMUX.
+   */
+  uint32_t                  dmamode;
+#if (STM32_DMA_SUPPORTS_DMAMUX == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   DMAMUX request of the period channel.
+   */
+  uint32_t                  dmarequest;
+#endif
+#endif /* STM32_ICU_USE_DMA == TRUE */
 } ICUConfig;
 
 /**
@@ -759,6 +869,24 @@ struct ICUDriver {
    * @brief CCR register used for period capture.
    */
   volatile uint32_t         *pccrp;
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief DMA stream or @p NULL in interrupt capture mode.
+   */
+  const stm32_dma_stream_t  *dma;
+  /**
+   * @brief Thread waiting for captures.
+   */
+  thread_reference_t        dmathread;
+  /**
+   * @brief Filled half of the ring not yet consumed or @p NULL.
+   */
+  const icu_dma_capture_t   *dmahalf;
+  /**
+   * @brief Number of ring halves overwritten before being consumed.
+   */
+  uint32_t                  dmaoverruns;
+#endif
 };
 
 /*===========================================================================*/
@@ -802,6 +930,33 @@ struct ICUDriver {
 #define icu_lld_are_notifications_enabled(icup)                             \
   (bool)(((icup)->tim->DIER & STM32_TIM_DIER_IRQ_MASK) != 0)
 
+#if (STM32_ICU_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the period of a DMA capture ring entry.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[in] cp        pointer to the @p icu_dma_capture_t entry
+ * @return              The number of ticks.
+ *
+ * @xclass
+ */
+#define icuSTM32GetEntryPeriod(icup, cp)                                    \
+  ((((icup)->config->channel == ICU_CHANNEL_1) ? (cp)->ccr1 : (cp)->ccr2) + 1U)
+
+/**
+ * @brief   Returns the width of a DMA capture ring entry.
+ * @note    The width is the one of the pulse preceding the period edge.
+ *
+ * @param[in] icup      pointer to the @p ICUDriver object
+ * @param[in] cp        pointer to the @p icu_dma_capture_t entry
+ * @return              The number of ticks.
+ *
+ * @xclass
+ */
+#define icuSTM32GetEntryWidth(icup, cp)                                     \
+  ((((icup)->config->channel == ICU_CHANNEL_1) ? (cp)->ccr2 : (cp)->ccr1) + 1U)
+#endif /* STM32_ICU_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -882,6 +1037,15 @@ extern "C" {
   void icu_lld_enable_notifications(ICUDriver *icup);
   void icu_lld_disable_notifications(ICUDriver *icup);
   void icu_lld_serve_interrupt(ICUDriver *icup);
+#if STM32_ICU_USE_DMA == TRUE
+  size_t icuSTM32WaitCapturesTimeout(ICUDriver *icup,
+                                     const icu_dma_capture_t **bufp,
+                                     sysinterval_t timeout);
+  void icuSTM32ComputeStats(ICUDriver *icup,
+                            const icu_dma_capture_t *buf,
+                            size_t n,
+                            icu_dma_stats_t *sp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -186,6 +186,35 @@ PWMDriver PWMD22;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (STM32_PWM_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   DMA burst mode stream interrupt handler.
+ *
+ * @param[in] pwmp      pointer to the @p PWMDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void pwm_lld_serve_dma_interrupt(PWMDriver *pwmp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+  if ((flags & STM32_DMA_ISR_TEIF) != 0U) {
+    STM32_PWM_DMA_ERROR_HOOK(pwmp);
+    return;
+  }
+
+  if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+    /* At the end of a one-shot burst the update requests are stopped,
+       the last compare values remain active.*/
+    if (!pwmp->circular) {
+      pwmp->tim->DIER &= ~STM32_TIM_DIER_UDE;
+    }
+
+    if (pwmp->config->burst_cb != NULL) {
+      pwmp->config->burst_cb(pwmp);
+    }
+  }
+}
+#endif /* STM32_PWM_USE_DMA == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -586,6 +615,11 @@ void pwm_lld_start(PWMDriver *pwmp) {
   uint32_t ccer;
 
   if (pwmp->state == PWM_STOP) {
+#if STM32_PWM_USE_DMA == TRUE
+    pwmp->dma      = NULL;
+    pwmp->circular = false;
+#endif
+
     /* Clock activation and timer reset.*/
 #if STM32_PWM_USE_TIM1
     if (&PWMD1 == pwmp) {
@@ -978,6 +1012,29 @@ void pwm_lld_start(PWMDriver *pwmp) {
   pwmp->tim->BDTR  = STM32_TIM_BDTR_MOE;
 #endif
 #endif
+
+#if STM32_PWM_USE_DMA == TRUE
+  /* A previously allocated stream is released because the new
+     configuration could specify a different one.*/
+  if (pwmp->dma != NULL) {
+    dmaStreamDisable(pwmp->dma);
+    dmaStreamFreeI(pwmp->dma);
+    pwmp->dma = NULL;
+  }
+
+  if (pwmp->config->burst) {
+    pwmp->dma = dmaStreamAllocI(pwmp->config->dmastream,
+                                STM32_PWM_DMA_IRQ_PRIORITY,
+                                (stm32_dmaisr_t)pwm_lld_serve_dma_interrupt,
+                                (void *)pwmp);
+    osalDbgAssert(pwmp->dma != NULL, "unable to allocate stream");
+    dmaStreamSetPeripheral(pwmp->dma, &pwmp->tim->DMAR);
+#if STM32_DMA_SUPPORTS_DMAMUX
+    dmaSetRequestSource(pwmp->dma, pwmp->config->dmarequest);
+#endif
+  }
+#endif
+
   /* Timer configured and started.*/
   pwmp->tim->CR1   = STM32_TIM_CR1_ARPE | STM32_TIM_CR1_URS |
                      STM32_TIM_CR1_CEN;
@@ -1001,6 +1058,14 @@ void pwm_lld_stop(PWMDriver *pwmp) {
     pwmp->tim->BDTR  = 0;
 #endif
 
+#if STM32_PWM_USE_DMA == TRUE
+    if (pwmp->dma != NULL) {
+      dmaStreamDisable(pwmp->dma);
+      dmaStreamFreeI(pwmp->dma);
+      pwmp->dma = NULL;
+    }
+#endif
+
 #if STM32_PWM_USE_TIM1
     if (&PWMD1 == pwmp) {
 #if !defined(STM32_TIM1_SUPPRESS_ISR)
@@ -1297,6 +1362,138 @@ void pwm_lld_serve_interrupt(PWMDriver *pwmp) {
     pwmp->config->callback(pwmp);
 }
 
+#if (STM32_PWM_USE_DMA == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a DMA burst.
+ * @details The buffer contains @p nch compare values for each period, on
+ *          each update event the values of the next period are written
+ *          into the CCRx registers of the channels from @p first to
+ *          @p first + @p nch - 1 using the TIM DMA burst interface. This
+ *          allows DShot-like or WS2812-like bit streams and multi-channel
+ *          waveforms without any CPU involvement.
+ * @note    The compare registers are preloaded so the values written
+ *          on an update event become active on the next period.
+ * @note    The channels must be enabled with @p pwmEnableChannel() before
+ *          starting the burst, their widths must not be changed while the
+ *          burst is active.
+ * @note    In one-shot mode the last values remain active after the end of
+ *          the burst, terminate the buffer with a period of zero values in
+ *          order to leave the outputs idle.
+ * @note    The buffer must stay valid and, on devices with data cache, be
+ *          flushed until the end of the burst.
+ *
+ * @param[in] pwmp      pointer to the @p PWMDriver object
+ * @param[in] buf       array of @p periods * @p nch compare values
+ * @param[in] periods   number of periods in the buffer
+ * @param[in] first     first channel to be reloaded (0...channels-1)
+ * @param[in] nch       number of consecutive channels reloaded per period
+ * @param[in] circular  @p true for restarting from the beginning of the
+ *                      buffer at its end
+ *
+ * @iclass
+ */
+void pwmSTM32StartBurstI(PWMDriver *pwmp,
+                         const uint32_t *buf,
+                         size_t periods,
+                         pwmchannel_t first,
+                         pwmchannel_t nch,
+                         bool circular) {
+  uint32_t mode;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((pwmp != NULL) && (buf != NULL) && (periods > 0U) &&
+               (nch > 0U) && ((size_t)first + (size_t)nch <= 4U) &&
+               ((size_t)first + (size_t)nch <= (size_t)pwmp->channels) &&
+               (periods * (size_t)nch <= 65535U));
+  osalDbgAssert((pwmp->state == PWM_READY) && (pwmp->dma != NULL),
+                "invalid state");
+
+  /* Stopping a previous burst, if any.*/
+  pwmp->tim->DIER &= ~STM32_TIM_DIER_UDE;
+  dmaStreamDisable(pwmp->dma);
+
+  /* Each update request triggers a burst of nch transfers starting from
+     the CCR of the first channel, CCR1 is register 13.*/
+  pwmp->tim->DCR = STM32_TIM_DCR_DBA(13U + (uint32_t)first) |
+                   STM32_TIM_DCR_DBL((uint32_t)nch - 1U);
+
+  mode = pwmp->config->dmamode | STM32_DMA_CR_PL(STM32_PWM_DMA_PRIORITY) |
+         STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_MINC |
+         STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+         STM32_DMA_CR_TCIE | STM32_DMA_CR_TEIE;
+  if (circular) {
+    mode |= STM32_DMA_CR_CIRC;
+  }
+  pwmp->circular = circular;
+  dmaStreamSetMemory0(pwmp->dma, buf);
+  dmaStreamSetTransactionSize(pwmp->dma, periods * (size_t)nch);
+  dmaStreamSetMode(pwmp->dma, mode);
+  dmaStreamEnable(pwmp->dma);
+
+  pwmp->tim->DIER |= STM32_TIM_DIER_UDE;
+}
+
+/**
+ * @brief   Starts a DMA burst.
+ * @details See @p pwmSTM32StartBurstI().
+ *
+ * @param[in] pwmp      pointer to the @p PWMDriver object
+ * @param[in] buf       array of @p periods * @p nch compare values
+ * @param[in] periods   number of periods in the buffer
+ * @param[in] first     first channel to be reloaded (0...channels-1)
+ * @param[in] nch       number of consecutive channels reloaded per period
+ * @param[in] circular  @p true for restarting from the beginning of the
+ *                      buffer at its end
+ *
+ * @api
+ */
+void pwmSTM32StartBurst(PWMDriver *pwmp,
+                        const uint32_t *buf,
+                        size_t periods,
+                        pwmchannel_t first,
+                        pwmchannel_t nch,
+                        bool circular) {
+
+  osalSysLock();
+  pwmSTM32StartBurstI(pwmp, buf, periods, first, nch, circular);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Stops a DMA burst.
+ * @note    The compare values written last remain active.
+ *
+ * @param[in] pwmp      pointer to the @p PWMDriver object
+ *
+ * @iclass
+ */
+void pwmSTM32StopBurstI(PWMDriver *pwmp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(pwmp != NULL);
+  osalDbgAssert((pwmp->state == PWM_READY) && (pwmp->dma != NULL),
+                "invalid state");
+
+  pwmp->tim->DIER &= ~STM32_TIM_DIER_UDE;
+  dmaStreamDisable(pwmp->dma);
+}
+
+/**
+ * @brief   Stops a DMA burst.
+ * @note    The compare values written last remain active.
+ *
+ * @param[in] pwmp      pointer to the @p PWMDriver object
+ *
+ * @api
+ */
+void pwmSTM32StopBurst(PWMDriver *pwmp) {
+
+  osalSysLock();
+  pwmSTM32StopBurstI(pwmp);
+  osalSysUnlock();
+}
+#endif /* STM32_PWM_USE_DMA == TRUE */
+
 #endif /* HAL_USE_PWM */
 
 /** @} */
@@ -378,12 +378,57 @@
 #if !defined(STM32_PWM_TIM22_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_PWM_TIM22_IRQ_PRIORITY        7
 #endif
+
+/**
+ * @brief   Enables the DMA burst mode.
+ * @details In DMA burst mode an array of compare values is streamed to
+ *          the timer on each update event using the TIM DMA burst
+ *          interface, one or more channels are reloaded per period.
+ */
+#if !defined(STM32_PWM_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_PWM_USE_DMA                   FALSE
+#endif
+
+/**
+ * @brief   DMA burst mode DMA priority (0..3|lowest..highest).
+ */
+#if !defined(STM32_PWM_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_PWM_DMA_PRIORITY              2
+#endif
+
+/**
+ * @brief   DMA burst mode DMA interrupt priority level setting.
+ */
+#if !defined(STM32_PWM_DMA_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_PWM_DMA_IRQ_PRIORITY          7
+#endif
+
+/**
+ * @brief   PWM DMA error hook.
+ */
+#if !defined(STM32_PWM_DMA_ERROR_HOOK) || defined(__DOXYGEN__)
+#define STM32_PWM_DMA_ERROR_HOOK(pwmp)      osalSysHalt("DMA failure")
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Configuration checks.                                                     */
 /*===========================================================================*/
 
+#if STM32_PWM_USE_DMA == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_PWM_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to PWM"
+#endif
+
+#if !OSAL_IRQ_IS_VALID_PRIORITY(STM32_PWM_DMA_IRQ_PRIORITY)
+#error "Invalid IRQ priority assigned to PWM DMA"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* STM32_PWM_USE_DMA == TRUE */
+
 #if !defined(STM32_HAS_TIM1)
 #define STM32_HAS_TIM1                      FALSE
 #endif
@@ -867,6 +912,33 @@ typedef struct {
     * @note  Only the DMA-related bits can be specified in this field.
     */
    uint32_t                 dier;
+#if (STM32_PWM_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Enables the DMA burst mode for this configuration.
+   * @note    The DMA stream is allocated on start.
+   */
+  bool                      burst;
+  /**
+   * @brief   DMA stream serving the update request of the timer.
+   */
+  uint32_t                  dmastream;
+  /**
+   * @brief   DMA stream mode bits, the channel selection on devices
+   *          without DMAMUX.
+   */
+  uint32_t                  dmamode;
+  /**
+   * @brief   DMAMUX request of the timer update event.
+   * @note    Ignored on devices without DMAMUX.
+   */
+  uint32_t                  dmarequest;
+  /**
+   * @brief   Burst callback or @p NULL.
+   * @details Invoked at the end of a one-shot burst or at the end of each
+   *          pass of a circular burst.
+   */
+  pwmcallback_t             burst_cb;
+#endif
 } PWMConfig;
 
 /**
@@ -905,6 +977,16 @@ struct PWMDriver {
    * @brief Pointer to the TIMx registers block.
    */
   stm32_tim_t               *tim;
+#if (STM32_PWM_USE_DMA == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   DMA burst mode stream or @p NULL.
+   */
+  const stm32_dma_stream_t  *dma;
+  /**
+   * @brief   The current burst is circular.
+   */
+  bool                      circular;
+#endif
 };
 
 /*===========================================================================*/
@@ -1023,6 +1105,22 @@ extern "C" {
   void pwm_lld_disable_channel_notification(PWMDriver *pwmp,
                                             pwmchannel_t channel);
   void pwm_lld_serve_interrupt(PWMDriver *pwmp);
+#if STM32_PWM_USE_DMA == TRUE
+  void pwmSTM32StartBurstI(PWMDriver *pwmp,
+                           const uint32_t *buf,
+                           size_t periods,
+                           pwmchannel_t first,
+                           pwmchannel_t nch,
+                           bool circular);
+  void pwmSTM32StartBurst(PWMDriver *pwmp,
+                          const uint32_t *buf,
+                          size_t periods,
+                          pwmchannel_t first,
+                          pwmchannel_t nch,
+                          bool circular);
+  void pwmSTM32StopBurstI(PWMDriver *pwmp);
+  void pwmSTM32StopBurst(PWMDriver *pwmp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -415,6 +415,11 @@
 #error "the selected ST frequency is not obtainable because TIM timer prescaler limits"
 #endif
 
+#if HAL_USE_CLOCK_SCALING == TRUE
+#define ST_CLOCK_POINT                                                      \
+  ((ST_CLOCK_SRC) == STM32_TIMCLK1 ? CLK_TIMCLK1 : CLK_TIMCLK2)
+#endif
+
 #endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
 
 #if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
@@ -435,6 +440,14 @@
 #error "the selected ST frequency is not obtainable because SysTick timer counter limits"
 #endif
 
+#if HAL_USE_CLOCK_SCALING == TRUE
+#if defined(STM32_CORE_CK)
+#define ST_CLOCK_POINT                      CLK_CORE
+#else
+#define ST_CLOCK_POINT                      CLK_HCLK
+#endif
+#endif
+
 #endif /* OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC */
 
 /*===========================================================================*/
@@ -449,10 +462,56 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Clock change listener.
+ */
+static hal_clock_listener_t st_clock_listener;
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Reprograms the ST timer after a clock change.
+ * @note    The counter is preserved, up to one tick can be lost on each
+ *          clock change.
+ *
+ * @param[in] param     not used
+ * @param[in] event     the clock change event
+ */
+static void st_clock_cb(void *param, halclkevent_t event) {
+  uint32_t clk;
+
+  (void)param;
+
+  if (event != HAL_CLOCK_POST_CHANGE) {
+    return;
+  }
+
+  clk = halClockGetPointX(ST_CLOCK_POINT);
+  osalDbgAssert((clk % OSAL_ST_FREQUENCY) == 0U, "clock not divisible");
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING
+  {
+    uint32_t cnt = STM32_ST_TIM->CNT;
+
+    /* The update event loads the new prescaler and clears the counter.*/
+    STM32_ST_TIM->PSC = (clk / OSAL_ST_FREQUENCY) - 1U;
+    STM32_ST_TIM->EGR = TIM_EGR_UG;
+    STM32_ST_TIM->CNT = cnt;
+  }
+#endif
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  SysTick->LOAD = (clk / OSAL_ST_FREQUENCY) - 1U;
+  SysTick->VAL  = 0U;
+#endif
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -463,6 +522,7 @@
  *
  * @isr
  */
+OSAL_FAST_CODE
 OSAL_IRQ_HANDLER(ST_HANDLER) {
 
   OSAL_IRQ_PROLOGUE();
@@ -530,11 +590,19 @@ void st_lld_init(void) {
   /* IRQ enabled.*/
   nvicSetSystemHandlerPriority(HANDLER_SYSTICK, STM32_ST_IRQ_PRIORITY);
 #endif /* OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC */
+
+#if HAL_USE_CLOCK_SCALING == TRUE
+  /* The tick frequency is kept constant across clock changes.*/
+  osalSysLock();
+  halClockRegisterListenerI(&st_clock_listener, st_clock_cb, NULL);
+  osalSysUnlock();
+#endif
 }
 
 /**
  * @brief   IRQ handling code.
  */
+OSAL_FAST_CODE
 void st_lld_serve_interrupt(void) {
 #if OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING
   uint32_t sr;
@@ -30,6 +30,88 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if STM32_SERIAL_USE_DMA
+#define USART1_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART1_RX_DMA_STREAM,                     \
+                       STM32_USART1_RX_DMA_CHN)
+
+#define USART1_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART1_TX_DMA_STREAM,                     \
+                       STM32_USART1_TX_DMA_CHN)
+
+#define USART2_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART2_RX_DMA_STREAM,                     \
+                       STM32_USART2_RX_DMA_CHN)
+
+#define USART2_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART2_TX_DMA_STREAM,                     \
+                       STM32_USART2_TX_DMA_CHN)
+
+#define USART3_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART3_RX_DMA_STREAM,                     \
+                       STM32_USART3_RX_DMA_CHN)
+
+#define USART3_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART3_TX_DMA_STREAM,                     \
+                       STM32_USART3_TX_DMA_CHN)
+
+#define UART4_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART4_RX_DMA_STREAM,                      \
+                       STM32_UART4_RX_DMA_CHN)
+
+#define UART4_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART4_TX_DMA_STREAM,                      \
+                       STM32_UART4_TX_DMA_CHN)
+
+#define UART5_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART5_RX_DMA_STREAM,                      \
+                       STM32_UART5_RX_DMA_CHN)
+
+#define UART5_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART5_TX_DMA_STREAM,                      \
+                       STM32_UART5_TX_DMA_CHN)
+
+#define USART6_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART6_RX_DMA_STREAM,                     \
+                       STM32_USART6_RX_DMA_CHN)
+
+#define USART6_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART6_TX_DMA_STREAM,                     \
+                       STM32_USART6_TX_DMA_CHN)
+
+#define UART7_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART7_RX_DMA_STREAM,                      \
+                       STM32_UART7_RX_DMA_CHN)
+
+#define UART7_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART7_TX_DMA_STREAM,                      \
+                       STM32_UART7_TX_DMA_CHN)
+
+#define UART8_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART8_RX_DMA_STREAM,                      \
+                       STM32_UART8_RX_DMA_CHN)
+
+#define UART8_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART8_TX_DMA_STREAM,                      \
+                       STM32_UART8_TX_DMA_CHN)
+
+#define UART9_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART9_RX_DMA_STREAM,                      \
+                       STM32_UART9_RX_DMA_CHN)
+
+#define UART9_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART9_TX_DMA_STREAM,                      \
+                       STM32_UART9_TX_DMA_CHN)
+
+#define UART10_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART10_RX_DMA_STREAM,                     \
+                       STM32_UART10_RX_DMA_CHN)
+
+#define UART10_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART10_TX_DMA_STREAM,                     \
+                       STM32_UART10_TX_DMA_CHN)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -128,10 +210,22 @@ static void usart_init(SerialDriver *sdp, const SerialConfig *config) {
 
   /* Note that some bits are enforced.*/
   u->CR2 = config->cr2 | USART_CR2_LBDIE;
-  u->CR3 = config->cr3 | USART_CR3_EIE;
-  u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
-                         USART_CR1_RXNEIE | USART_CR1_TE |
-                         USART_CR1_RE;
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL) {
+    /* Data moved by DMA, the idle line interrupt replaces RXNE.*/
+    u->CR3 = config->cr3 | USART_CR3_EIE | USART_CR3_DMAR | USART_CR3_DMAT;
+    u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
+                           USART_CR1_IDLEIE | USART_CR1_TE |
+                           USART_CR1_RE;
+  }
+  else
+#endif
+  {
+    u->CR3 = config->cr3 | USART_CR3_EIE;
+    u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
+                           USART_CR1_RXNEIE | USART_CR1_TE |
+                           USART_CR1_RE;
+  }
   u->SR = 0;
   (void)u->SR;  /* SR reset step 1.*/
   (void)u->DR;  /* SR reset step 2.*/
@@ -179,11 +273,244 @@ static void set_error(SerialDriver *sdp, uint16_t sr) {
   chnAddFlagsI(sdp, sts);
 }
 
+#if STM32_SERIAL_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Moves the data received by DMA into the input queue.
+ * @note    Must be invoked with the lock taken.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_rx_serve(SerialDriver *sdp) {
+  size_t pos;
+
+  pos = STM32_SERIAL_DMA_BUFFERS_SIZE -
+        dmaStreamGetTransactionSize(sdp->dmarx);
+  if (pos >= STM32_SERIAL_DMA_BUFFERS_SIZE)
+    pos = 0U;
+
+  /* Up to two contiguous blocks if the circular buffer wrapped.*/
+  while (sdp->rxdmapos != pos) {
+    uint8_t *bp = &sdp->rxdmabuf[sdp->rxdmapos];
+    size_t n;
+
+    if (pos > sdp->rxdmapos)
+      n = pos - sdp->rxdmapos;
+    else
+      n = STM32_SERIAL_DMA_BUFFERS_SIZE - sdp->rxdmapos;
+
+    /* The parity bit is not masked out by the DMA.*/
+    if (sdp->rxmask != 0xFFU) {
+      size_t i;
+
+      for (i = 0U; i < n; i++)
+        bp[i] &= sdp->rxmask;
+    }
+    sdIncomingDataBufferI(sdp, bp, n);
+
+    sdp->rxdmapos += n;
+    if (sdp->rxdmapos >= STM32_SERIAL_DMA_BUFFERS_SIZE)
+      sdp->rxdmapos = 0U;
+  }
+}
+
+/**
+ * @brief   Starts a DMA transmission from the output queue.
+ * @details Nothing is done if a transmission is already in progress, if the
+ *          output queue is empty then the transmission end interrupt is
+ *          enabled.
+ * @note    Must be invoked with the lock taken.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_tx_start(SerialDriver *sdp) {
+  size_t n;
+
+  if (sdp->txdmaactive)
+    return;
+
+  n = oqReadI(&sdp->oqueue, sdp->txdmabuf, STM32_SERIAL_DMA_BUFFERS_SIZE);
+  if (n == 0U) {
+    chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY);
+    sdp->usart->CR1 |= USART_CR1_TCIE;
+    return;
+  }
+
+  /* TC is cleared because it could be still set from the previous
+     transmission end.*/
+  sdp->txdmaactive = true;
+  sdp->usart->CR1 &= ~USART_CR1_TCIE;
+  sdp->usart->SR = ~USART_SR_TC;
+  dmaStreamDisable(sdp->dmatx);
+  dmaStreamSetMemory0(sdp->dmatx, sdp->txdmabuf);
+  dmaStreamSetTransactionSize(sdp->dmatx, n);
+  dmaStreamSetMode(sdp->dmatx, sdp->dmatxmode | STM32_DMA_CR_DIR_M2P |
+                               STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE);
+  dmaStreamEnable(sdp->dmatx);
+}
+
+/**
+ * @brief   RX DMA half and full buffer service routine.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_rx_irq(SerialDriver *sdp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+#if defined(STM32_SERIAL_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SERIAL_DMA_ERROR_HOOK(sdp);
+  }
+#else
+  (void)flags;
+#endif
+
+  osalSysLockFromISR();
+  usart_dma_rx_serve(sdp);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   TX DMA end service routine.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_tx_irq(SerialDriver *sdp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+#if defined(STM32_SERIAL_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SERIAL_DMA_ERROR_HOOK(sdp);
+  }
+#else
+  (void)flags;
+#endif
+
+  /* Chaining the next block, if any.*/
+  osalSysLockFromISR();
+  sdp->txdmaactive = false;
+  usart_dma_tx_start(sdp);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Allocates the DMA streams.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] rxstream  RX DMA stream identifier
+ * @param[in] txstream  TX DMA stream identifier
+ * @param[in] priority  DMA interrupts priority
+ */
+static void usart_dma_alloc(SerialDriver *sdp, uint32_t rxstream,
+                            uint32_t txstream, uint32_t priority) {
+
+  sdp->dmarx = dmaStreamAllocI(rxstream, priority,
+                               (stm32_dmaisr_t)usart_dma_rx_irq,
+                               (void *)sdp);
+  osalDbgAssert(sdp->dmarx != NULL, "unable to allocate stream");
+  sdp->dmatx = dmaStreamAllocI(txstream, priority,
+                               (stm32_dmaisr_t)usart_dma_tx_irq,
+                               (void *)sdp);
+  osalDbgAssert(sdp->dmatx != NULL, "unable to allocate stream");
+
+  sdp->dmarxmode = STM32_DMA_CR_PL(STM32_SERIAL_DMA_PRIORITY) |
+                   STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+  sdp->dmatxmode = STM32_DMA_CR_PL(STM32_SERIAL_DMA_PRIORITY) |
+                   STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+}
+
+/**
+ * @brief   Releases the DMA streams.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_free(SerialDriver *sdp) {
+
+  dmaStreamDisable(sdp->dmarx);
+  dmaStreamDisable(sdp->dmatx);
+  dmaStreamFreeI(sdp->dmarx);
+  dmaStreamFreeI(sdp->dmatx);
+  sdp->dmarx = NULL;
+  sdp->dmatx = NULL;
+}
+
+/**
+ * @brief   (Re)starts the DMA streams.
+ * @details The RX stream runs continuously in circular mode, the TX stream
+ *          is started when there is data in the output queue.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_start(SerialDriver *sdp) {
+
+  dmaStreamDisable(sdp->dmarx);
+  dmaStreamDisable(sdp->dmatx);
+  sdp->txdmaactive = false;
+  sdp->rxdmapos    = 0U;
+
+  dmaStreamSetPeripheral(sdp->dmarx, &sdp->usart->DR);
+  dmaStreamSetPeripheral(sdp->dmatx, &sdp->usart->DR);
+  dmaStreamSetMemory0(sdp->dmarx, sdp->rxdmabuf);
+  dmaStreamSetTransactionSize(sdp->dmarx, STM32_SERIAL_DMA_BUFFERS_SIZE);
+  dmaStreamSetMode(sdp->dmarx, sdp->dmarxmode | STM32_DMA_CR_DIR_P2M |
+                               STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC  |
+                               STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+  dmaStreamEnable(sdp->dmarx);
+}
+
+/**
+ * @brief   USART interrupt service routine in DMA mode.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] sr        USART SR register value
+ * @param[in] cr1       USART CR1 register value
+ */
+static void usart_dma_serve_interrupt(SerialDriver *sdp, uint16_t sr,
+                                      uint16_t cr1) {
+  USART_TypeDef *u = sdp->usart;
+
+  osalSysLockFromISR();
+
+  /* Special case, LIN break detection.*/
+  if (sr & USART_SR_LBD) {
+    chnAddFlagsI(sdp, SD_BREAK_DETECTED);
+    u->SR = ~USART_SR_LBD;
+  }
+
+  /* Error flags are cleared when the DMA reads the data register.*/
+  if (sr & (USART_SR_ORE | USART_SR_NE | USART_SR_FE | USART_SR_PE))
+    set_error(sdp, sr);
+
+  /* Idle line, the data received so far is moved into the input queue.
+     The flag is cleared by reading DR unless there is data pending for
+     the DMA.*/
+  if ((cr1 & USART_CR1_IDLEIE) && (sr & USART_SR_IDLE)) {
+    if ((sr & USART_SR_RXNE) == 0U)
+      (void)u->DR;
+    usart_dma_rx_serve(sdp);
+  }
+
+  /* Physical transmission end, TCIE is only enabled after the last DMA
+     block.*/
+  if ((cr1 & USART_CR1_TCIE) && (sr & USART_SR_TC)) {
+    chnAddFlagsI(sdp, CHN_TRANSMISSION_END);
+    u->CR1 &= ~USART_CR1_TCIE;
+  }
+
+  osalSysUnlockFromISR();
+}
+#endif
+
 #if STM32_SERIAL_USE_USART1 || defined(__DOXYGEN__)
 static void notify1(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD1);
+#else
   USART1->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -191,7 +518,11 @@ static void notify1(io_queue_t *qp) {
 static void notify2(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD2);
+#else
   USART2->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -199,7 +530,11 @@ static void notify2(io_queue_t *qp) {
 static void notify3(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD3);
+#else
   USART3->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -207,7 +542,11 @@ static void notify3(io_queue_t *qp) {
 static void notify4(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD4);
+#else
   UART4->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -215,7 +554,11 @@ static void notify4(io_queue_t *qp) {
 static void notify5(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD5);
+#else
   UART5->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -223,7 +566,11 @@ static void notify5(io_queue_t *qp) {
 static void notify6(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD6);
+#else
   USART6->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -231,7 +578,11 @@ static void notify6(io_queue_t *qp) {
 static void notify7(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD7);
+#else
   UART7->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -239,7 +590,11 @@ static void notify7(io_queue_t *qp) {
 static void notify8(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD8);
+#else
   UART8->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -247,7 +602,11 @@ static void notify8(io_queue_t *qp) {
 static void notify9(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD9);
+#else
   UART9->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -255,7 +614,11 @@ static void notify9(io_queue_t *qp) {
 static void notify10(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD10);
+#else
   UART10->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -594,54 +957,128 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
 #if STM32_SERIAL_USE_USART1
     if (&SD1 == sdp) {
       rccEnableUSART1(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART1_RX_DMA_STREAM,
+                      STM32_UART_USART1_TX_DMA_STREAM,
+                      STM32_SERIAL_USART1_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART1_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART1_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART2
     if (&SD2 == sdp) {
       rccEnableUSART2(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART2_RX_DMA_STREAM,
+                      STM32_UART_USART2_TX_DMA_STREAM,
+                      STM32_SERIAL_USART2_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART2_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART2_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART3
     if (&SD3 == sdp) {
       rccEnableUSART3(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART3_RX_DMA_STREAM,
+                      STM32_UART_USART3_TX_DMA_STREAM,
+                      STM32_SERIAL_USART3_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART3_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART3_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART4
     if (&SD4 == sdp) {
       rccEnableUART4(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART4_RX_DMA_STREAM,
+                      STM32_UART_UART4_TX_DMA_STREAM,
+                      STM32_SERIAL_UART4_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART4_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART4_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART5
     if (&SD5 == sdp) {
       rccEnableUART5(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART5_RX_DMA_STREAM,
+                      STM32_UART_UART5_TX_DMA_STREAM,
+                      STM32_SERIAL_UART5_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART5_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART5_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART6
     if (&SD6 == sdp) {
       rccEnableUSART6(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART6_RX_DMA_STREAM,
+                      STM32_UART_USART6_TX_DMA_STREAM,
+                      STM32_SERIAL_USART6_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART6_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART6_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART7
     if (&SD7 == sdp) {
       rccEnableUART7(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART7_RX_DMA_STREAM,
+                      STM32_UART_UART7_TX_DMA_STREAM,
+                      STM32_SERIAL_UART7_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART7_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART7_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART8
     if (&SD8 == sdp) {
       rccEnableUART8(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART8_RX_DMA_STREAM,
+                      STM32_UART_UART8_TX_DMA_STREAM,
+                      STM32_SERIAL_UART8_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART8_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART8_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART9
     if (&SD9 == sdp) {
       rccEnableUART9(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART9_RX_DMA_STREAM,
+                      STM32_UART_UART9_TX_DMA_STREAM,
+                      STM32_SERIAL_UART9_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART9_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART9_TX_DMA_CHANNEL);
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART10
     if (&SD10 == sdp) {
       rccEnableUART10(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART10_RX_DMA_STREAM,
+                      STM32_UART_UART10_TX_DMA_STREAM,
+                      STM32_SERIAL_UART10_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART10_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART10_TX_DMA_CHANNEL);
+#endif
     }
 #endif
   }
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL)
+    usart_dma_start(sdp);
+#endif
   usart_init(sdp, config);
 }
 
@@ -658,6 +1095,10 @@ void sd_lld_stop(SerialDriver *sdp) {
 
   if (sdp->state == SD_READY) {
     usart_deinit(sdp->usart);
+#if STM32_SERIAL_USE_DMA
+    if (sdp->dmarx != NULL)
+      usart_dma_free(sdp);
+#endif
 #if STM32_SERIAL_USE_USART1
     if (&SD1 == sdp) {
       rccDisableUSART1();
@@ -731,6 +1172,13 @@ void sd_lld_serve_interrupt(SerialDriver *sdp) {
   uint16_t cr1 = u->CR1;
   uint16_t sr = u->SR;
 
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL) {
+    usart_dma_serve_interrupt(sdp, sr, cr1);
+    return;
+  }
+#endif
+
   /* Special case, LIN break detection.*/
   if (sr & USART_SR_LBD) {
     osalSysLockFromISR();
@@ -198,6 +198,39 @@
 #if !defined(STM32_SERIAL_UART10_PRIORITY) || defined(__DOXYGEN__)
 #define STM32_SERIAL_UART10_PRIORITY        12
 #endif
+
+/**
+ * @brief   DMA mode enable switch.
+ * @details If set to @p TRUE the USARTs are served by DMA. Received data
+ *          is moved into the input queue in blocks on half buffer, full
+ *          buffer and idle line events, transmitted data is moved from the
+ *          output queue in blocks.
+ * @note    The DMA streams are the ones assigned to the UART driver using
+ *          the @p STM32_UART_xxx_RX_DMA_STREAM and
+ *          @p STM32_UART_xxx_TX_DMA_STREAM settings.
+ * @note    The DMA buffers are part of the driver structure, on devices
+ *          with a data cache the drivers must be placed in non-cacheable
+ *          memory.
+ */
+#if !defined(STM32_SERIAL_USE_DMA) || defined(__DOXYGEN__)
+#define STM32_SERIAL_USE_DMA                FALSE
+#endif
+
+/**
+ * @brief   Size of the DMA receive and transmit buffers.
+ * @note    Received data is moved every half buffer, the interrupt latency
+ *          must be lower than the time needed to receive half buffer.
+ */
+#if !defined(STM32_SERIAL_DMA_BUFFERS_SIZE) || defined(__DOXYGEN__)
+#define STM32_SERIAL_DMA_BUFFERS_SIZE       64
+#endif
+
+/**
+ * @brief   DMA streams priority level setting.
+ */
+#if !defined(STM32_SERIAL_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_SERIAL_DMA_PRIORITY           1
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -302,6 +335,72 @@
 #error "Invalid IRQ priority assigned to UART10"
 #endif
 
+#if STM32_SERIAL_USE_DMA
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_SERIAL_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to the serial driver"
+#endif
+
+#if (STM32_SERIAL_DMA_BUFFERS_SIZE < 2) ||                                   \
+    ((STM32_SERIAL_DMA_BUFFERS_SIZE % 2) != 0)
+#error "STM32_SERIAL_DMA_BUFFERS_SIZE must be even"
+#endif
+
+/* Check on the presence of the DMA streams settings in mcuconf.h.*/
+#if STM32_SERIAL_USE_USART1 && (!defined(STM32_UART_USART1_RX_DMA_STREAM) || \
+                                !defined(STM32_UART_USART1_TX_DMA_STREAM))
+#error "USART1 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_USART2 && (!defined(STM32_UART_USART2_RX_DMA_STREAM) || \
+                                !defined(STM32_UART_USART2_TX_DMA_STREAM))
+#error "USART2 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_USART3 && (!defined(STM32_UART_USART3_RX_DMA_STREAM) || \
+                                !defined(STM32_UART_USART3_TX_DMA_STREAM))
+#error "USART3 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART4 && (!defined(STM32_UART_UART4_RX_DMA_STREAM) ||   \
+                               !defined(STM32_UART_UART4_TX_DMA_STREAM))
+#error "UART4 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART5 && (!defined(STM32_UART_UART5_RX_DMA_STREAM) ||   \
+                               !defined(STM32_UART_UART5_TX_DMA_STREAM))
+#error "UART5 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_USART6 && (!defined(STM32_UART_USART6_RX_DMA_STREAM) || \
+                                !defined(STM32_UART_USART6_TX_DMA_STREAM))
+#error "USART6 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART7 && (!defined(STM32_UART_UART7_RX_DMA_STREAM) ||   \
+                               !defined(STM32_UART_UART7_TX_DMA_STREAM))
+#error "UART7 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART8 && (!defined(STM32_UART_UART8_RX_DMA_STREAM) ||   \
+                               !defined(STM32_UART_UART8_TX_DMA_STREAM))
+#error "UART8 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART9 && (!defined(STM32_UART_UART9_RX_DMA_STREAM) ||   \
+                               !defined(STM32_UART_UART9_TX_DMA_STREAM))
+#error "UART9 DMA streams not defined"
+#endif
+
+#if STM32_SERIAL_USE_UART10 && (!defined(STM32_UART_UART10_RX_DMA_STREAM) || \
+                                !defined(STM32_UART_UART10_TX_DMA_STREAM))
+#error "UART10 DMA streams not defined"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* STM32_SERIAL_USE_DMA */
+
 /* Checks on allocation of USARTx units.*/
 #if STM32_SERIAL_USE_USART1
 #if defined(STM32_USART1_IS_USED)
@@ -415,6 +514,31 @@ typedef struct {
   uint16_t                  cr3;
 } SerialConfig;
 
+#if STM32_SERIAL_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   @p SerialDriver DMA mode specific data.
+ */
+#define _serial_driver_dma_data                                             \
+  /* Receive DMA stream or @p NULL if served by interrupts.*/               \
+  const stm32_dma_stream_t  *dmarx;                                         \
+  /* Transmit DMA stream or @p NULL if served by interrupts.*/              \
+  const stm32_dma_stream_t  *dmatx;                                         \
+  /* RX DMA mode bit mask.*/                                                \
+  uint32_t                  dmarxmode;                                      \
+  /* TX DMA mode bit mask.*/                                                \
+  uint32_t                  dmatxmode;                                      \
+  /* Transmit DMA operation in progress.*/                                  \
+  bool                      txdmaactive;                                    \
+  /* Position of the next byte to be moved from the receive buffer.*/       \
+  size_t                    rxdmapos;                                       \
+  /* Receive DMA circular buffer.*/                                         \
+  uint8_t                   rxdmabuf[STM32_SERIAL_DMA_BUFFERS_SIZE];        \
+  /* Transmit DMA buffer.*/                                                 \
+  uint8_t                   txdmabuf[STM32_SERIAL_DMA_BUFFERS_SIZE];
+#else
+#define _serial_driver_dma_data
+#endif
+
 /**
  * @brief   @p SerialDriver specific data.
  */
@@ -436,7 +560,8 @@ typedef struct {
   /* Clock frequency for the associated USART/UART.*/                       \
   uint32_t                  clock;                                          \
   /* Mask to be applied on received frames.*/                               \
-  uint8_t                   rxmask;
+  uint8_t                   rxmask;                                         \
+  _serial_driver_dma_data
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
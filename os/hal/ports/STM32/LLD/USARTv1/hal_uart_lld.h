@@ -736,6 +736,11 @@
 #endif
 #endif
 
+/**
+ * @brief   The ring receive mode is supported.
+ */
+#define UART_LLD_SUPPORTS_RING
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -821,6 +826,14 @@ typedef struct {
    * @brief Initialization value for the CR3 register.
    */
   uint16_t                  cr3;
+#if (UART_USE_RING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Receive ring half filled callback.
+   * @note    In ring mode @p rxend_cb is invoked when the second half of
+   *          the ring is filled.
+   */
+  uartcb_t                  rxhalf_cb;
+#endif
 } UARTConfig;
 
 /**
@@ -863,6 +876,20 @@ struct UARTDriver {
    */
   mutex_t                   mutex;
 #endif /* UART_USE_MUTUAL_EXCLUSION */
+#if (UART_USE_RING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Receive ring buffer or @p NULL if not in ring mode.
+   */
+  uint8_t                   *rxring;
+  /**
+   * @brief   Receive ring buffer size.
+   */
+  size_t                    rxringsize;
+  /**
+   * @brief   Receive ring read index.
+   */
+  size_t                    rxrdptr;
+#endif /* UART_USE_RING */
 #if defined(UART_DRIVER_EXT_FIELDS)
   UART_DRIVER_EXT_FIELDS
 #endif
@@ -955,6 +982,10 @@ extern "C" {
   size_t uart_lld_stop_send(UARTDriver *uartp);
   void uart_lld_start_receive(UARTDriver *uartp, size_t n, void *rxbuf);
   size_t uart_lld_stop_receive(UARTDriver *uartp);
+#if UART_USE_RING == TRUE
+  void uart_lld_start_ring_receive(UARTDriver *uartp, size_t n, void *rxbuf);
+  size_t uart_lld_get_ring_wrptr(UARTDriver *uartp);
+#endif
   void uart_lld_serve_interrupt(UARTDriver *uartp);
 #ifdef __cplusplus
 }
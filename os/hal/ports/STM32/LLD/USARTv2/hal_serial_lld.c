@@ -30,6 +30,72 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if STM32_SERIAL_USE_DMA
+#define USART1_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART1_RX_DMA_STREAM,                     \
+                       STM32_USART1_RX_DMA_CHN)
+
+#define USART1_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART1_TX_DMA_STREAM,                     \
+                       STM32_USART1_TX_DMA_CHN)
+
+#define USART2_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART2_RX_DMA_STREAM,                     \
+                       STM32_USART2_RX_DMA_CHN)
+
+#define USART2_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART2_TX_DMA_STREAM,                     \
+                       STM32_USART2_TX_DMA_CHN)
+
+#define USART3_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART3_RX_DMA_STREAM,                     \
+                       STM32_USART3_RX_DMA_CHN)
+
+#define USART3_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART3_TX_DMA_STREAM,                     \
+                       STM32_USART3_TX_DMA_CHN)
+
+#define UART4_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART4_RX_DMA_STREAM,                      \
+                       STM32_UART4_RX_DMA_CHN)
+
+#define UART4_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART4_TX_DMA_STREAM,                      \
+                       STM32_UART4_TX_DMA_CHN)
+
+#define UART5_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART5_RX_DMA_STREAM,                      \
+                       STM32_UART5_RX_DMA_CHN)
+
+#define UART5_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART5_TX_DMA_STREAM,                      \
+                       STM32_UART5_TX_DMA_CHN)
+
+#define USART6_RX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART6_RX_DMA_STREAM,                     \
+                       STM32_USART6_RX_DMA_CHN)
+
+#define USART6_TX_DMA_CHANNEL                                               \
+  STM32_DMA_GETCHANNEL(STM32_UART_USART6_TX_DMA_STREAM,                     \
+                       STM32_USART6_TX_DMA_CHN)
+
+#define UART7_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART7_RX_DMA_STREAM,                      \
+                       STM32_UART7_RX_DMA_CHN)
+
+#define UART7_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART7_TX_DMA_STREAM,                      \
+                       STM32_UART7_TX_DMA_CHN)
+
+#define UART8_RX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART8_RX_DMA_STREAM,                      \
+                       STM32_UART8_RX_DMA_CHN)
+
+#define UART8_TX_DMA_CHANNEL                                                \
+  STM32_DMA_GETCHANNEL(STM32_UART_UART8_TX_DMA_STREAM,                      \
+                       STM32_UART8_TX_DMA_CHN)
+#endif
+
 /* For compatibility for those devices without LIN support in the USARTs.*/
 #if !defined(USART_ISR_LBDF)
 #define USART_ISR_LBDF                      0
@@ -223,17 +289,15 @@ static uint8_t sd_out_buflp1[STM32_SERIAL_LPUART1_OUT_BUF_SIZE];
 /*===========================================================================*/
 
 /**
- * @brief   USART initialization.
- * @details This function must be invoked with interrupts disabled.
+ * @brief   Computes the BRR value for the current USART clock.
  *
  * @param[in] sdp       pointer to a @p SerialDriver object
  * @param[in] config    the architecture-dependent serial driver configuration
+ * @return              The BRR register value.
  */
-static void usart_init(SerialDriver *sdp, const SerialConfig *config) {
+static uint32_t usart_get_brr(SerialDriver *sdp, const SerialConfig *config) {
   uint32_t brr;
-  USART_TypeDef *u = sdp->usart;
 
-  /* Baud rate setting.*/
 #if STM32_SERIAL_USE_LPUART1
   if (sdp == &LPSD1) {
     osalDbgAssert((sdp->clock >= config->speed * 3U) &&
@@ -257,14 +321,41 @@ static void usart_init(SerialDriver *sdp, const SerialConfig *config) {
 
     osalDbgAssert(brr < 0x10000, "invalid BRR value");
   }
-  u->BRR = brr;
+
+  return brr;
+}
+
+/**
+ * @brief   USART initialization.
+ * @details This function must be invoked with interrupts disabled.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] config    the architecture-dependent serial driver configuration
+ */
+static void usart_init(SerialDriver *sdp, const SerialConfig *config) {
+  USART_TypeDef *u = sdp->usart;
+
+  /* Baud rate setting.*/
+  u->BRR = usart_get_brr(sdp, config);
 
   /* Note that some bits are enforced.*/
   u->CR2 = config->cr2 | USART_CR2_LBDIE;
-  u->CR3 = config->cr3 | USART_CR3_EIE;
-  u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
-                         USART_CR1_RXNEIE | USART_CR1_TE |
-                         USART_CR1_RE;
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL) {
+    /* Data moved by DMA, the idle line interrupt replaces RXNE.*/
+    u->CR3 = config->cr3 | USART_CR3_EIE | USART_CR3_DMAR | USART_CR3_DMAT;
+    u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
+                           USART_CR1_IDLEIE | USART_CR1_TE |
+                           USART_CR1_RE;
+  }
+  else
+#endif
+  {
+    u->CR3 = config->cr3 | USART_CR3_EIE;
+    u->CR1 = config->cr1 | USART_CR1_UE | USART_CR1_PEIE |
+                           USART_CR1_RXNEIE | USART_CR1_TE |
+                           USART_CR1_RE;
+  }
   u->ICR = 0xFFFFFFFFU;
 
   /* Deciding mask to be applied on the data register on receive, this is
@@ -321,11 +412,274 @@ static void set_error(SerialDriver *sdp, uint32_t isr) {
   osalSysUnlockFromISR();
 }
 
+#if STM32_SERIAL_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Moves the data received by DMA into the input queue.
+ * @note    Must be invoked with the lock taken.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_rx_serve(SerialDriver *sdp) {
+  size_t pos;
+
+  pos = STM32_SERIAL_DMA_BUFFERS_SIZE -
+        dmaStreamGetTransactionSize(sdp->dmarx);
+  if (pos >= STM32_SERIAL_DMA_BUFFERS_SIZE)
+    pos = 0U;
+
+  /* Up to two contiguous blocks if the circular buffer wrapped.*/
+  while (sdp->rxdmapos != pos) {
+    uint8_t *bp = &sdp->rxdmabuf[sdp->rxdmapos];
+    size_t n;
+
+    if (pos > sdp->rxdmapos)
+      n = pos - sdp->rxdmapos;
+    else
+      n = STM32_SERIAL_DMA_BUFFERS_SIZE - sdp->rxdmapos;
+
+    /* The parity bit is not masked out by the DMA.*/
+    if (sdp->rxmask != 0xFFU) {
+      size_t i;
+
+      for (i = 0U; i < n; i++)
+        bp[i] &= sdp->rxmask;
+    }
+    sdIncomingDataBufferI(sdp, bp, n);
+
+    sdp->rxdmapos += n;
+    if (sdp->rxdmapos >= STM32_SERIAL_DMA_BUFFERS_SIZE)
+      sdp->rxdmapos = 0U;
+  }
+}
+
+/**
+ * @brief   Starts a DMA transmission from the output queue.
+ * @details Nothing is done if a transmission is already in progress, if the
+ *          output queue is empty then the transmission end interrupt is
+ *          enabled.
+ * @note    Must be invoked with the lock taken.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_tx_start(SerialDriver *sdp) {
+  size_t n;
+
+  if (sdp->txdmaactive)
+    return;
+
+  n = oqReadI(&sdp->oqueue, sdp->txdmabuf, STM32_SERIAL_DMA_BUFFERS_SIZE);
+  if (n == 0U) {
+    chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY);
+    sdp->usart->CR1 |= USART_CR1_TCIE;
+    return;
+  }
+
+  /* TC is cleared because it could be still set from the previous
+     transmission end.*/
+  sdp->txdmaactive = true;
+  sdp->usart->CR1 &= ~USART_CR1_TCIE;
+  sdp->usart->ICR = USART_ICR_TCCF;
+  dmaStreamDisable(sdp->dmatx);
+  dmaStreamSetMemory0(sdp->dmatx, sdp->txdmabuf);
+  dmaStreamSetTransactionSize(sdp->dmatx, n);
+  dmaStreamSetMode(sdp->dmatx, sdp->dmatxmode | STM32_DMA_CR_DIR_M2P |
+                               STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE);
+  dmaStreamEnable(sdp->dmatx);
+}
+
+/**
+ * @brief   RX DMA half and full buffer service routine.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_rx_irq(SerialDriver *sdp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+#if defined(STM32_SERIAL_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SERIAL_DMA_ERROR_HOOK(sdp);
+  }
+#else
+  (void)flags;
+#endif
+
+  osalSysLockFromISR();
+  usart_dma_rx_serve(sdp);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   TX DMA end service routine.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_tx_irq(SerialDriver *sdp, uint32_t flags) {
+
+  /* DMA errors handling.*/
+#if defined(STM32_SERIAL_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SERIAL_DMA_ERROR_HOOK(sdp);
+  }
+#else
+  (void)flags;
+#endif
+
+  /* Chaining the next block, if any.*/
+  osalSysLockFromISR();
+  sdp->txdmaactive = false;
+  usart_dma_tx_start(sdp);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Allocates the DMA streams.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] rxstream  RX DMA stream identifier
+ * @param[in] txstream  TX DMA stream identifier
+ * @param[in] priority  DMA interrupts priority
+ */
+static void usart_dma_alloc(SerialDriver *sdp, uint32_t rxstream,
+                            uint32_t txstream, uint32_t priority) {
+
+  sdp->dmarx = dmaStreamAllocI(rxstream, priority,
+                               (stm32_dmaisr_t)usart_dma_rx_irq,
+                               (void *)sdp);
+  osalDbgAssert(sdp->dmarx != NULL, "unable to allocate stream");
+  sdp->dmatx = dmaStreamAllocI(txstream, priority,
+                               (stm32_dmaisr_t)usart_dma_tx_irq,
+                               (void *)sdp);
+  osalDbgAssert(sdp->dmatx != NULL, "unable to allocate stream");
+
+  sdp->dmarxmode = STM32_DMA_CR_PL(STM32_SERIAL_DMA_PRIORITY) |
+                   STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+  sdp->dmatxmode = STM32_DMA_CR_PL(STM32_SERIAL_DMA_PRIORITY) |
+                   STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+}
+
+/**
+ * @brief   Releases the DMA streams.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_free(SerialDriver *sdp) {
+
+  dmaStreamDisable(sdp->dmarx);
+  dmaStreamDisable(sdp->dmatx);
+  dmaStreamFreeI(sdp->dmarx);
+  dmaStreamFreeI(sdp->dmatx);
+  sdp->dmarx = NULL;
+  sdp->dmatx = NULL;
+}
+
+/**
+ * @brief   (Re)starts the DMA streams.
+ * @details The RX stream runs continuously in circular mode, the TX stream
+ *          is started when there is data in the output queue.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ */
+static void usart_dma_start(SerialDriver *sdp) {
+
+  dmaStreamDisable(sdp->dmarx);
+  dmaStreamDisable(sdp->dmatx);
+  sdp->txdmaactive = false;
+  sdp->rxdmapos    = 0U;
+
+  dmaStreamSetPeripheral(sdp->dmarx, &sdp->usart->RDR);
+  dmaStreamSetPeripheral(sdp->dmatx, &sdp->usart->TDR);
+  dmaStreamSetMemory0(sdp->dmarx, sdp->rxdmabuf);
+  dmaStreamSetTransactionSize(sdp->dmarx, STM32_SERIAL_DMA_BUFFERS_SIZE);
+  dmaStreamSetMode(sdp->dmarx, sdp->dmarxmode | STM32_DMA_CR_DIR_P2M |
+                               STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC  |
+                               STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+  dmaStreamEnable(sdp->dmarx);
+}
+
+/**
+ * @brief   USART interrupt service routine in DMA mode.
+ * @note    The status flags have already been cleared by the caller.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver object
+ * @param[in] isr       USART ISR register value
+ * @param[in] cr1       USART CR1 register value
+ */
+static void usart_dma_serve_interrupt(SerialDriver *sdp, uint32_t isr,
+                                      uint32_t cr1) {
+  USART_TypeDef *u = sdp->usart;
+
+  /* Error condition detection.*/
+  if (isr & (USART_ISR_ORE | USART_ISR_NE | USART_ISR_FE  | USART_ISR_PE))
+    set_error(sdp, isr);
+
+  osalSysLockFromISR();
+
+  /* Special case, LIN break detection.*/
+  if (isr & USART_ISR_LBDF)
+    chnAddFlagsI(sdp, SD_BREAK_DETECTED);
+
+  /* Idle line, the data received so far is moved into the input queue.*/
+  if ((cr1 & USART_CR1_IDLEIE) && (isr & USART_ISR_IDLE))
+    usart_dma_rx_serve(sdp);
+
+  /* Physical transmission end, TCIE is only enabled after the last DMA
+     block.*/
+  if ((cr1 & USART_CR1_TCIE) && (isr & USART_ISR_TC)) {
+    chnAddFlagsI(sdp, CHN_TRANSMISSION_END);
+    u->CR1 &= ~USART_CR1_TCIE;
+  }
+
+  osalSysUnlockFromISR();
+}
+#endif
+
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Clock change callback.
+ * @details The USART is disabled after the frame in transmission has been
+ *          sent and re-enabled with the baud rate recomputed from the new
+ *          clock, a frame in reception during the switch can be lost.
+ *
+ * @param[in] param     pointer to a @p SerialDriver object
+ * @param[in] event     the clock change event
+ */
+static void usart_clock_cb(void *param, halclkevent_t event) {
+  SerialDriver *sdp = (SerialDriver *)param;
+  USART_TypeDef *u = sdp->usart;
+
+  if (event == HAL_CLOCK_PRE_CHANGE) {
+#if STM32_SERIAL_USE_DMA
+    /* The DMA would keep feeding the transmitter.*/
+    u->CR3 &= ~USART_CR3_DMAT;
+#endif
+    while ((u->ISR & USART_ISR_TC) == 0U) {
+    }
+    u->CR1 &= ~USART_CR1_UE;
+  }
+  else {
+    sdp->clock = halClockGetPointX(sdp->clkpt);
+    u->BRR     = usart_get_brr(sdp, sdp->config);
+    u->CR1    |= USART_CR1_UE;
+#if STM32_SERIAL_USE_DMA
+    if (sdp->dmarx != NULL) {
+      u->CR3 |= USART_CR3_DMAT;
+    }
+#endif
+  }
+}
+#endif
+
 #if STM32_SERIAL_USE_USART1 || defined(__DOXYGEN__)
 static void notify1(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD1);
+#else
   USART1->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -333,7 +687,11 @@ static void notify1(io_queue_t *qp) {
 static void notify2(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD2);
+#else
   USART2->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -341,7 +699,11 @@ static void notify2(io_queue_t *qp) {
 static void notify3(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD3);
+#else
   USART3->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -349,7 +711,11 @@ static void notify3(io_queue_t *qp) {
 static void notify4(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD4);
+#else
   UART4->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -357,7 +723,11 @@ static void notify4(io_queue_t *qp) {
 static void notify5(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD5);
+#else
   UART5->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -365,7 +735,11 @@ static void notify5(io_queue_t *qp) {
 static void notify6(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD6);
+#else
   USART6->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -373,7 +747,11 @@ static void notify6(io_queue_t *qp) {
 static void notify7(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD7);
+#else
   UART7->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -381,7 +759,11 @@ static void notify7(io_queue_t *qp) {
 static void notify8(io_queue_t *qp) {
 
   (void)qp;
+#if STM32_SERIAL_USE_DMA
+  usart_dma_tx_start(&SD8);
+#else
   UART8->CR1 |= USART_CR1_TXEIE | USART_CR1_TCIE;
+#endif
 }
 #endif
 
@@ -603,6 +985,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD1.oqueue, sd_out_buf1, sizeof sd_out_buf1, notify1, &SD1);
   SD1.usart = USART1;
   SD1.clock = STM32_USART1CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD1.clkpt = CLK_USART1;
+#endif
 #if !defined(STM32_USART1_SUPPRESS_ISR) && defined(STM32_USART1_NUMBER)
   nvicEnableVector(STM32_USART1_NUMBER, STM32_SERIAL_USART1_PRIORITY);
 #endif
@@ -614,6 +999,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD2.oqueue, sd_out_buf2, sizeof sd_out_buf2, notify2, &SD2);
   SD2.usart = USART2;
   SD2.clock = STM32_USART2CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD2.clkpt = CLK_USART2;
+#endif
 #if !defined(STM32_USART2_SUPPRESS_ISR) && defined(STM32_USART2_NUMBER)
   nvicEnableVector(STM32_USART2_NUMBER, STM32_SERIAL_USART2_PRIORITY);
 #endif
@@ -625,6 +1013,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD3.oqueue, sd_out_buf3, sizeof sd_out_buf3, notify3, &SD3);
   SD3.usart = USART3;
   SD3.clock = STM32_USART3CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD3.clkpt = CLK_USART3;
+#endif
 #if !defined(STM32_USART3_SUPPRESS_ISR) && defined(STM32_USART3_NUMBER)
   nvicEnableVector(STM32_USART3_NUMBER, STM32_SERIAL_USART3_PRIORITY);
 #endif
@@ -636,6 +1027,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD4.oqueue, sd_out_buf4, sizeof sd_out_buf4, notify4, &SD4);
   SD4.usart = UART4;
   SD4.clock = STM32_UART4CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD4.clkpt = CLK_UART4;
+#endif
 #if !defined(STM32_UART4_SUPPRESS_ISR) && defined(STM32_UART4_NUMBER)
   nvicEnableVector(STM32_UART4_NUMBER, STM32_SERIAL_UART4_PRIORITY);
 #endif
@@ -647,6 +1041,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD5.oqueue, sd_out_buf5, sizeof sd_out_buf5, notify5, &SD5);
   SD5.usart = UART5;
   SD5.clock = STM32_UART5CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD5.clkpt = CLK_UART5;
+#endif
 #if !defined(STM32_UART5_SUPPRESS_ISR) && defined(STM32_UART5_NUMBER)
   nvicEnableVector(STM32_UART5_NUMBER, STM32_SERIAL_UART5_PRIORITY);
 #endif
@@ -658,6 +1055,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD6.oqueue, sd_out_buf6, sizeof sd_out_buf6, notify6, &SD6);
   SD6.usart = USART6;
   SD6.clock = STM32_USART6CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD6.clkpt = CLK_USART6;
+#endif
 #if !defined(STM32_USART6_SUPPRESS_ISR) && defined(STM32_USART6_NUMBER)
   nvicEnableVector(STM32_USART6_NUMBER, STM32_SERIAL_USART6_PRIORITY);
 #endif
@@ -669,6 +1069,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD7.oqueue, sd_out_buf7, sizeof sd_out_buf7, notify7, &SD7);
   SD7.usart = UART7;
   SD7.clock = STM32_UART7CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD7.clkpt = CLK_UART7;
+#endif
 #if !defined(STM32_UART7_SUPPRESS_ISR) && defined(STM32_UART7_NUMBER)
   nvicEnableVector(STM32_UART7_NUMBER, STM32_SERIAL_UART7_PRIORITY);
 #endif
@@ -680,6 +1083,9 @@ void sd_lld_init(void) {
   oqObjectInit(&SD8.oqueue, sd_out_buf8, sizeof sd_out_buf8, notify8, &SD8);
   SD8.usart = UART8;
   SD8.clock = STM32_UART8CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  SD8.clkpt = CLK_UART8;
+#endif
 #if !defined(STM32_UART8_SUPPRESS_ISR) && defined(STM32_UART8_NUMBER)
   nvicEnableVector(STM32_UART8_NUMBER, STM32_SERIAL_UART8_PRIORITY);
 #endif
@@ -691,6 +1097,9 @@ void sd_lld_init(void) {
   oqObjectInit(&LPSD1.oqueue, sd_out_buflp1, sizeof sd_out_buflp1, notifylp1, &LPSD1);
   LPSD1.usart = LPUART1;
   LPSD1.clock = STM32_LPUART1CLK;
+#if HAL_USE_CLOCK_SCALING == TRUE
+  LPSD1.clkpt = CLK_LPUART1;
+#endif
 #if !defined(STM32_LPUART1_SUPPRESS_ISR) && defined(STM32_LPUART1_NUMBER)
   nvicEnableVector(STM32_LPUART1_NUMBER, STM32_SERIAL_LPUART1_PRIORITY);
 #endif
@@ -716,49 +1125,149 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
 #if STM32_SERIAL_USE_USART1
     if (&SD1 == sdp) {
       rccEnableUSART1(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART1_RX_DMA_STREAM,
+                      STM32_UART_USART1_TX_DMA_STREAM,
+                      STM32_SERIAL_USART1_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART1_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART1_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_USART1_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_USART1_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART2
     if (&SD2 == sdp) {
       rccEnableUSART2(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART2_RX_DMA_STREAM,
+                      STM32_UART_USART2_TX_DMA_STREAM,
+                      STM32_SERIAL_USART2_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART2_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART2_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_USART2_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_USART2_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART3
     if (&SD3 == sdp) {
       rccEnableUSART3(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART3_RX_DMA_STREAM,
+                      STM32_UART_USART3_TX_DMA_STREAM,
+                      STM32_SERIAL_USART3_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART3_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART3_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_USART3_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_USART3_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART4
     if (&SD4 == sdp) {
       rccEnableUART4(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART4_RX_DMA_STREAM,
+                      STM32_UART_UART4_TX_DMA_STREAM,
+                      STM32_SERIAL_UART4_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART4_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART4_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_UART4_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_UART4_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART5
     if (&SD5 == sdp) {
       rccEnableUART5(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART5_RX_DMA_STREAM,
+                      STM32_UART_UART5_TX_DMA_STREAM,
+                      STM32_SERIAL_UART5_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART5_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART5_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_UART5_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_UART5_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_USART6
     if (&SD6 == sdp) {
       rccEnableUSART6(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_USART6_RX_DMA_STREAM,
+                      STM32_UART_USART6_TX_DMA_STREAM,
+                      STM32_SERIAL_USART6_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(USART6_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(USART6_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_USART6_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_USART6_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART7
     if (&SD7 == sdp) {
       rccEnableUART7(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART7_RX_DMA_STREAM,
+                      STM32_UART_UART7_TX_DMA_STREAM,
+                      STM32_SERIAL_UART7_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART7_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART7_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_UART7_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_UART7_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_UART8
     if (&SD8 == sdp) {
       rccEnableUART8(true);
+#if STM32_SERIAL_USE_DMA
+      usart_dma_alloc(sdp, STM32_UART_UART8_RX_DMA_STREAM,
+                      STM32_UART_UART8_TX_DMA_STREAM,
+                      STM32_SERIAL_UART8_PRIORITY);
+      sdp->dmarxmode |= STM32_DMA_CR_CHSEL(UART8_RX_DMA_CHANNEL);
+      sdp->dmatxmode |= STM32_DMA_CR_CHSEL(UART8_TX_DMA_CHANNEL);
+#if STM32_DMA_SUPPORTS_DMAMUX
+      dmaSetRequestSource(sdp->dmarx, STM32_DMAMUX1_UART8_RX);
+      dmaSetRequestSource(sdp->dmatx, STM32_DMAMUX1_UART8_TX);
+#endif
+#endif
     }
 #endif
 #if STM32_SERIAL_USE_LPUART1
     if (&LPSD1 == sdp) {
       rccEnableLPUART1(true);
     }
+#endif
+#if HAL_USE_CLOCK_SCALING == TRUE
+    halClockRegisterListenerI(&sdp->clklistener, usart_clock_cb, sdp);
 #endif
   }
+#if HAL_USE_CLOCK_SCALING == TRUE
+  /* The clock level could have been changed since the driver init.*/
+  sdp->config = config;
+  sdp->clock  = halClockGetPointX(sdp->clkpt);
+#endif
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL)
+    usart_dma_start(sdp);
+#endif
   usart_init(sdp, config);
 }
 
@@ -774,8 +1283,16 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
 void sd_lld_stop(SerialDriver *sdp) {
 
   if (sdp->state == SD_READY) {
+#if HAL_USE_CLOCK_SCALING == TRUE
+    halClockUnregisterListenerI(&sdp->clklistener);
+#endif
+
     /* UART is de-initialized then clocks are disabled.*/
     usart_deinit(sdp->usart);
+#if STM32_SERIAL_USE_DMA
+    if (sdp->dmarx != NULL)
+      usart_dma_free(sdp);
+#endif
 
 #if STM32_SERIAL_USE_USART1
     if (&SD1 == sdp) {
@@ -848,6 +1365,13 @@ void sd_lld_serve_interrupt(SerialDriver *sdp) {
   isr = u->ISR;
   u->ICR = isr;
 
+#if STM32_SERIAL_USE_DMA
+  if (sdp->dmarx != NULL) {
+    usart_dma_serve_interrupt(sdp, isr, cr1);
+    return;
+  }
+#endif
+
   /* Error condition detection.*/
   if (isr & (USART_ISR_ORE | USART_ISR_NE | USART_ISR_FE  | USART_ISR_PE))
     set_error(sdp, isr);
@@ -863,13 +1387,24 @@ void sd_lld_serve_interrupt(SerialDriver *sdp) {
      1) Another byte arrived after removing the previous one, this would cause
         an extra interrupt to serve.
      2) FIFO mode is enabled on devices that support it, we need to empty
-        the FIFO.*/
-  while (isr & USART_ISR_RXNE) {
+        the FIFO.
+     The data is collected and moved into the input queue in blocks.*/
+  if (isr & USART_ISR_RXNE) {
+    uint8_t buf[16];
+    size_t n = 0U;
+
     osalSysLockFromISR();
-    sdIncomingDataI(sdp, (uint8_t)u->RDR & sdp->rxmask);
-    osalSysUnlockFromISR();
+    while (isr & USART_ISR_RXNE) {
+      buf[n++] = (uint8_t)u->RDR & sdp->rxmask;
+      if (n >= sizeof (buf)) {
+        sdIncomingDataBufferI(sdp, buf, n);
+        n = 0U;
+      }
 
-    isr = u->ISR;
+      isr = u->ISR;
+    }
+    sdIncomingDataBufferI(sdp, buf, n);
+    osalSysUnlockFromISR();
   }
 
   /* Transmission buffer empty, note it is a while in order to handle two
@@ -308,7 +308,7 @@ static void uart_lld_serve_rx_end_irq(UARTDriver *uartp, uint32_t flags) {
   if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
     STM32_UART_DMA_ERROR_HOOK(uartp);
   }
-#else
+#elif UART_USE_RING == FALSE
   (void)flags;
 #endif
 
@@ -317,6 +317,18 @@ static void uart_lld_serve_rx_end_irq(UARTDriver *uartp, uint32_t flags) {
        received character and then the driver stays in the same state.*/
     _uart_rx_idle_code(uartp);
   }
+#if UART_USE_RING == TRUE
+  else if (uartp->rxring != NULL) {
+    /* Receiver in ring mode, the DMA keeps running and a callback is
+       generated, if enabled, for each filled half of the ring.*/
+    if ((flags & STM32_DMA_ISR_HTIF) != 0U) {
+      _uart_rx_half_isr_code(uartp);
+    }
+    if ((flags & STM32_DMA_ISR_TCIF) != 0U) {
+      _uart_rx_ring_end_isr_code(uartp);
+    }
+  }
+#endif
   else {
     /* Receiver in active state, a callback is generated, if enabled, after
        a completed transfer.*/
@@ -1036,6 +1048,54 @@ size_t uart_lld_stop_receive(UARTDriver *uartp) {
   return n;
 }
 
+#if (UART_USE_RING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a receive operation in ring mode.
+ * @details The RX DMA stream runs continuously in circular mode over the
+ *          ring buffer with half and full buffer interrupts.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] n         size of the ring buffer
+ * @param[out] rxbuf    the pointer to the ring buffer
+ *
+ * @notapi
+ */
+void uart_lld_start_ring_receive(UARTDriver *uartp, size_t n, void *rxbuf) {
+
+  /* Stopping previous activity (idle state).*/
+  dmaStreamDisable(uartp->dmarx);
+
+  /* RX DMA channel preparation.*/
+  dmaStreamSetMemory0(uartp->dmarx, rxbuf);
+  dmaStreamSetTransactionSize(uartp->dmarx, n);
+  dmaStreamSetMode(uartp->dmarx, uartp->dmarxmode  | STM32_DMA_CR_DIR_P2M |
+                                 STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC    |
+                                 STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+
+  /* Starting transfer.*/
+  dmaStreamEnable(uartp->dmarx);
+}
+
+/**
+ * @brief   Returns the receive ring write index.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @return              The index of the next frame to be received.
+ *
+ * @notapi
+ */
+size_t uart_lld_get_ring_wrptr(UARTDriver *uartp) {
+  size_t wrptr;
+
+  wrptr = uartp->rxringsize - dmaStreamGetTransactionSize(uartp->dmarx);
+  if (wrptr >= uartp->rxringsize) {
+    wrptr = 0U;
+  }
+
+  return wrptr;
+}
+#endif /* UART_USE_RING == TRUE */
+
 /**
  * @brief   USART common service routine.
  *
@@ -236,6 +236,116 @@ __STATIC_INLINE void usart_init(SIODriver *siop) {
   u->CR3   = siop->config->cr3 & ~USART_CR3_CFG_FORBIDDEN;
 }
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   RX DMA half and full ring service routine.
+ * @details The RX-waiting thread is woken if the ring contains more data
+ *          than the configured threshold.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_rx_irq(SIODriver *siop, uint32_t flags) {
+  size_t n;
+
+  /* DMA errors handling.*/
+#if defined(STM32_SIO_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SIO_DMA_ERROR_HOOK(siop);
+  }
+#else
+  (void)flags;
+#endif
+
+  n = __sio_stream_rx_count(siop, sio_lld_stream_get_wrptr(siop));
+  if (n > siop->stream->rxthreshold) {
+
+    /* The callback is invoked if defined.*/
+    __sio_callback_rx(siop);
+
+    /* Waiting thread woken, if any.*/
+    __sio_wakeup_rx(siop, MSG_OK);
+  }
+}
+
+/**
+ * @brief   TX DMA end service routine.
+ * @details The transmitted buffer is removed from the chain and the next
+ *          one is started, after the last buffer the transmission end
+ *          interrupt is enabled.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] flags     pre-shifted content of the ISR register
+ */
+static void usart_dma_tx_irq(SIODriver *siop, uint32_t flags) {
+  sio_txbuf_t *tbp;
+
+  /* DMA errors handling.*/
+#if defined(STM32_SIO_DMA_ERROR_HOOK)
+  if ((flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) != 0) {
+    STM32_SIO_DMA_ERROR_HOOK(siop);
+  }
+#else
+  (void)flags;
+#endif
+
+  /* Chaining the next buffer, if any.*/
+  osalSysLockFromISR();
+  tbp = siop->txhead;
+  if (tbp == NULL) {
+    /* Operation stopped meanwhile.*/
+    osalSysUnlockFromISR();
+    return;
+  }
+  siop->txhead = tbp->next;
+  siop->txdone = tbp;
+  if (siop->txhead != NULL) {
+    sio_lld_stream_start_tx(siop, siop->txhead);
+  }
+  else {
+    siop->usart->CR1 |= USART_CR1_TCIE;
+  }
+  osalSysUnlockFromISR();
+
+  /* The callback is invoked if defined.*/
+  __sio_callback_tx(siop);
+
+  /* Waiting thread woken, if any.*/
+  __sio_wakeup_tx(siop, MSG_OK);
+}
+
+/**
+ * @brief   Allocates the DMA streams.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] rxstream  RX DMA stream identifier
+ * @param[in] txstream  TX DMA stream identifier
+ * @param[in] priority  DMA interrupts priority
+ */
+static void usart_dma_alloc(SIODriver *siop, uint32_t rxstream,
+                            uint32_t txstream, uint32_t priority) {
+
+  siop->dmarx = dmaStreamAllocI(rxstream, priority,
+                                (stm32_dmaisr_t)usart_dma_rx_irq,
+                                (void *)siop);
+  osalDbgAssert(siop->dmarx != NULL, "unable to allocate stream");
+  siop->dmatx = dmaStreamAllocI(txstream, priority,
+                                (stm32_dmaisr_t)usart_dma_tx_irq,
+                                (void *)siop);
+  osalDbgAssert(siop->dmatx != NULL, "unable to allocate stream");
+
+  siop->dmarxmode = STM32_DMA_CR_PL(STM32_SIO_DMA_PRIORITY) |
+                    STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC  |
+                    STM32_DMA_CR_CIRC    | STM32_DMA_CR_HTIE  |
+                    STM32_DMA_CR_TCIE    | STM32_DMA_CR_DMEIE |
+                    STM32_DMA_CR_TEIE;
+  siop->dmatxmode = STM32_DMA_CR_PL(STM32_SIO_DMA_PRIORITY) |
+                    STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_MINC  |
+                    STM32_DMA_CR_TCIE    | STM32_DMA_CR_DMEIE |
+                    STM32_DMA_CR_TEIE;
+}
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -320,6 +430,12 @@ bool sio_lld_start(SIODriver *siop) {
 
   if (siop->state == SIO_STOP) {
 
+#if SIO_USE_STREAMING == TRUE
+    /* Streams not allocated for units not supporting streaming.*/
+    siop->dmarx = NULL;
+    siop->dmatx = NULL;
+#endif
+
   /* Enables the peripheral.*/
     if (false) {
     }
@@ -327,48 +443,104 @@ bool sio_lld_start(SIODriver *siop) {
     else if (&SIOD1 == siop) {
       rccResetUSART1();
       rccEnableUSART1(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_USART1_RX_DMA_STREAM,
+                      STM32_UART_USART1_TX_DMA_STREAM,
+                      STM32_IRQ_USART1_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_USART1_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_USART1_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_USART2 == TRUE
     else if (&SIOD2 == siop) {
       rccResetUSART2();
       rccEnableUSART2(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_USART2_RX_DMA_STREAM,
+                      STM32_UART_USART2_TX_DMA_STREAM,
+                      STM32_IRQ_USART2_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_USART2_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_USART2_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_USART3 == TRUE
     else if (&SIOD3 == siop) {
       rccResetUSART3();
       rccEnableUSART3(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_USART3_RX_DMA_STREAM,
+                      STM32_UART_USART3_TX_DMA_STREAM,
+                      STM32_IRQ_USART3_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_USART3_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_USART3_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_UART4 == TRUE
     else if (&SIOD4 == siop) {
       rccResetUART4();
       rccEnableUART4(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_UART4_RX_DMA_STREAM,
+                      STM32_UART_UART4_TX_DMA_STREAM,
+                      STM32_IRQ_UART4_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_UART4_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_UART4_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_UART5 == TRUE
     else if (&SIOD5 == siop) {
       rccResetUART5();
       rccEnableUART5(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_UART5_RX_DMA_STREAM,
+                      STM32_UART_UART5_TX_DMA_STREAM,
+                      STM32_IRQ_UART5_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_UART5_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_UART5_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_USART6 == TRUE
     else if (&SIOD6 == siop) {
       rccResetUSART6();
       rccEnableUSART6(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_USART6_RX_DMA_STREAM,
+                      STM32_UART_USART6_TX_DMA_STREAM,
+                      STM32_IRQ_USART6_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_USART6_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_USART6_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_UART7 == TRUE
     else if (&SIOD7 == siop) {
       rccResetUART7();
       rccEnableUART7(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_UART7_RX_DMA_STREAM,
+                      STM32_UART_UART7_TX_DMA_STREAM,
+                      STM32_IRQ_UART7_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_UART7_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_UART7_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_UART8 == TRUE
     else if (&SIOD8 == siop) {
       rccResetUART8();
       rccEnableUART8(true);
+#if SIO_USE_STREAMING == TRUE
+      usart_dma_alloc(siop, STM32_UART_UART8_RX_DMA_STREAM,
+                      STM32_UART_UART8_TX_DMA_STREAM,
+                      STM32_IRQ_UART8_PRIORITY);
+      dmaSetRequestSource(siop->dmarx, STM32_DMAMUX1_UART8_RX);
+      dmaSetRequestSource(siop->dmatx, STM32_DMAMUX1_UART8_TX);
+#endif
     }
 #endif
 #if STM32_SIO_USE_LPUART1 == TRUE
@@ -409,6 +581,16 @@ void sio_lld_stop(SIODriver *siop) {
   if (siop->state == SIO_READY) {
     /* Resets the peripheral.*/
 
+#if SIO_USE_STREAMING == TRUE
+    /* Releasing the DMA streams, if allocated.*/
+    if (siop->dmarx != NULL) {
+      dmaStreamFreeI(siop->dmarx);
+      dmaStreamFreeI(siop->dmatx);
+      siop->dmarx = NULL;
+      siop->dmatx = NULL;
+    }
+#endif
+
     /* Disables the peripheral.*/
     if (false) {
     }
@@ -527,6 +709,15 @@ void sio_lld_start_operation(SIODriver *siop) {
  */
 void sio_lld_stop_operation(SIODriver *siop) {
 
+#if SIO_USE_STREAMING == TRUE
+  /* Stopping the DMA streams in streaming mode.*/
+  if (siop->stream != NULL) {
+    dmaStreamDisable(siop->dmarx);
+    dmaStreamDisable(siop->dmatx);
+    siop->usart->CR3 &= ~(USART_CR3_DMAR | USART_CR3_DMAT);
+  }
+#endif
+
   /* Stop operation.*/
   siop->usart->CR1 &= USART_CR1_CFG_FORBIDDEN;
   siop->usart->CR2 &= USART_CR2_CFG_FORBIDDEN;
@@ -714,6 +905,96 @@ msg_t sio_lld_control(SIODriver *siop, unsigned int operation, void *arg) {
   return MSG_OK;
 }
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a SIO operation in streaming mode.
+ * @details The RX DMA stream runs continuously in circular mode over the
+ *          ring buffer, the FIFO threshold interrupts are not used.
+ *
+ * @param[in] siop          pointer to an @p SIODriver structure
+ *
+ * @notapi
+ */
+void sio_lld_start_streaming(SIODriver *siop) {
+  uint32_t cr1irq, cr2irq, cr3irq;
+
+  osalDbgAssert(siop->dmarx != NULL, "streaming not supported");
+
+  /* The idle interrupt is always required for data notification, the
+     FIFO interrupts are replaced by the DMA ones.*/
+#if SIO_USE_SYNCHRONIZATION == TRUE
+  cr1irq  = USART_CR1_IDLEIE | USART_CR1_PEIE;
+  cr2irq  = USART_CR2_LBDIE;
+  cr3irq  = USART_CR3_EIE;
+#else
+  cr1irq  = USART_CR1_IDLEIE;
+  cr2irq  = 0U;
+  cr3irq  = 0U;
+  if (siop->operation->rx_evt_cb != NULL) {
+    cr1irq |= USART_CR1_PEIE;
+    cr2irq |= USART_CR2_LBDIE;
+    cr3irq |= USART_CR3_EIE;
+  }
+#endif
+
+  /* RX stream continuously running over the ring.*/
+  dmaStreamDisable(siop->dmarx);
+  dmaStreamDisable(siop->dmatx);
+  dmaStreamSetPeripheral(siop->dmarx, &siop->usart->RDR);
+  dmaStreamSetPeripheral(siop->dmatx, &siop->usart->TDR);
+  dmaStreamSetMemory0(siop->dmarx, siop->stream->rxbuf);
+  dmaStreamSetTransactionSize(siop->dmarx, siop->stream->rxsize);
+  dmaStreamSetMode(siop->dmarx, siop->dmarxmode);
+  dmaStreamEnable(siop->dmarx);
+
+  /* Setting up the operation.*/
+  siop->usart->ICR  = siop->usart->ISR;
+  siop->usart->CR2 |= cr2irq;
+  siop->usart->CR3 |= cr3irq | USART_CR3_DMAR | USART_CR3_DMAT;
+  siop->usart->CR1 |= cr1irq | USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+}
+
+/**
+ * @brief   Returns the streaming RX ring write index.
+ *
+ * @param[in] siop          pointer to an @p SIODriver structure
+ * @return                  The write index.
+ *
+ * @notapi
+ */
+size_t sio_lld_stream_get_wrptr(SIODriver *siop) {
+  size_t wrptr;
+
+  wrptr = siop->stream->rxsize - dmaStreamGetTransactionSize(siop->dmarx);
+  if (wrptr >= siop->stream->rxsize) {
+    wrptr = 0U;
+  }
+
+  return wrptr;
+}
+
+/**
+ * @brief   Starts the transmission of a streaming buffer.
+ *
+ * @param[in] siop          pointer to an @p SIODriver structure
+ * @param[in] tbp           pointer to the @p sio_txbuf_t object
+ *
+ * @notapi
+ */
+void sio_lld_stream_start_tx(SIODriver *siop, sio_txbuf_t *tbp) {
+
+  /* TC is cleared because it could be still set from the previous
+     transmission end.*/
+  siop->usart->CR1 &= ~USART_CR1_TCIE;
+  siop->usart->ICR  = USART_ICR_TCCF;
+  dmaStreamDisable(siop->dmatx);
+  dmaStreamSetMemory0(siop->dmatx, tbp->buffer);
+  dmaStreamSetTransactionSize(siop->dmatx, tbp->n);
+  dmaStreamSetMode(siop->dmatx, siop->dmatxmode);
+  dmaStreamEnable(siop->dmatx);
+}
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /**
  * @brief   Serves an USART interrupt.
  *
@@ -121,6 +121,17 @@
 #if !defined(STM32_SIO_USE_LPUART1) || defined(__DOXYGEN__)
 #define STM32_SIO_USE_LPUART1               FALSE
 #endif
+
+/**
+ * @brief   Streaming mode DMA streams priority level setting.
+ * @note    The DMA streams are the ones assigned to the UART driver using
+ *          the @p STM32_UART_xxx_RX_DMA_STREAM and
+ *          @p STM32_UART_xxx_TX_DMA_STREAM settings.
+ * @note    LPUART1 does not support the streaming mode.
+ */
+#if !defined(STM32_SIO_DMA_PRIORITY) || defined(__DOXYGEN__)
+#define STM32_SIO_DMA_PRIORITY              1
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -143,6 +154,57 @@
 #error "SIO driver activated but no USART/UART peripheral assigned"
 #endif
 
+#if SIO_USE_STREAMING == TRUE
+#if !STM32_DMA_IS_VALID_PRIORITY(STM32_SIO_DMA_PRIORITY)
+#error "Invalid DMA priority assigned to the SIO driver"
+#endif
+
+/* Check on the presence of the DMA streams settings in mcuconf.h.*/
+#if STM32_SIO_USE_USART1 && (!defined(STM32_UART_USART1_RX_DMA_STREAM) ||   \
+                             !defined(STM32_UART_USART1_TX_DMA_STREAM))
+#error "USART1 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_USART2 && (!defined(STM32_UART_USART2_RX_DMA_STREAM) ||   \
+                             !defined(STM32_UART_USART2_TX_DMA_STREAM))
+#error "USART2 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_USART3 && (!defined(STM32_UART_USART3_RX_DMA_STREAM) ||   \
+                             !defined(STM32_UART_USART3_TX_DMA_STREAM))
+#error "USART3 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_UART4 && (!defined(STM32_UART_UART4_RX_DMA_STREAM) ||     \
+                            !defined(STM32_UART_UART4_TX_DMA_STREAM))
+#error "UART4 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_UART5 && (!defined(STM32_UART_UART5_RX_DMA_STREAM) ||     \
+                            !defined(STM32_UART_UART5_TX_DMA_STREAM))
+#error "UART5 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_USART6 && (!defined(STM32_UART_USART6_RX_DMA_STREAM) ||   \
+                             !defined(STM32_UART_USART6_TX_DMA_STREAM))
+#error "USART6 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_UART7 && (!defined(STM32_UART_UART7_RX_DMA_STREAM) ||     \
+                            !defined(STM32_UART_UART7_TX_DMA_STREAM))
+#error "UART7 DMA streams not defined"
+#endif
+
+#if STM32_SIO_USE_UART8 && (!defined(STM32_UART_UART8_RX_DMA_STREAM) ||     \
+                            !defined(STM32_UART_UART8_TX_DMA_STREAM))
+#error "UART8 DMA streams not defined"
+#endif
+
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#endif /* SIO_USE_STREAMING == TRUE */
+
 /* Checks on allocation of USARTx units.*/
 #if STM32_SIO_USE_USART1
 #if defined(STM32_USART1_IS_USED)
@@ -216,6 +278,11 @@
 #endif
 #endif
 
+/**
+ * @brief   The streaming mode is supported, except on LPUART1.
+ */
+#define SIO_LLD_SUPPORTS_STREAMING
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -229,10 +296,28 @@
  */
 typedef uint32_t sio_events_mask_t;
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Low level fields of the SIO driver structure in streaming mode.
+ */
+#define sio_lld_driver_dma_fields                                           \
+  /* Receive DMA stream or @p NULL if streaming is not supported.*/         \
+  const stm32_dma_stream_t  *dmarx;                                         \
+  /* Transmit DMA stream or @p NULL if streaming is not supported.*/        \
+  const stm32_dma_stream_t  *dmatx;                                         \
+  /* RX DMA mode bit mask.*/                                                \
+  uint32_t                  dmarxmode;                                      \
+  /* TX DMA mode bit mask.*/                                                \
+  uint32_t                  dmatxmode;
+#else
+#define sio_lld_driver_dma_fields
+#endif
+
 /**
  * @brief   Low level fields of the SIO driver structure.
  */
 #define sio_lld_driver_fields                                               \
+  sio_lld_driver_dma_fields                                                 \
   /* Pointer to the USARTx registers block.*/                               \
   USART_TypeDef             *usart;                                         \
   /* USART clock frequency.*/                                               \
@@ -346,6 +431,11 @@ extern "C" {
   msg_t sio_lld_get(SIODriver *siop);
   void sio_lld_put(SIODriver *siop, uint_fast16_t data);
   msg_t sio_lld_control(SIODriver *siop, unsigned int operation, void *arg);
+#if SIO_USE_STREAMING == TRUE
+  void sio_lld_start_streaming(SIODriver *siop);
+  size_t sio_lld_stream_get_wrptr(SIODriver *siop);
+  void sio_lld_stream_start_tx(SIODriver *siop, sio_txbuf_t *tbp);
+#endif
   void sio_lld_serve_interrupt(SIODriver *siop);
 #ifdef __cplusplus
 }
@@ -148,6 +148,13 @@
 #define STM32_OTG2_EP1OUT_NUMBER            74
 #define STM32_OTG2_EP1IN_NUMBER             75
 
+/*
+ * RNG unit.
+ */
+#define STM32_RNG1_HANDLER                  Vector180
+
+#define STM32_RNG1_NUMBER                   80
+
 /*
  * SDIO unit.
  */
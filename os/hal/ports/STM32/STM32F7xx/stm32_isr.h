@@ -205,6 +205,13 @@
 
 #define STM32_QUADSPI1_NUMBER               92
 
+/*
+ * RNG unit.
+ */
+#define STM32_RNG1_HANDLER                  Vector180
+
+#define STM32_RNG1_NUMBER                   80
+
 /*
  * SDMMC units.
  */
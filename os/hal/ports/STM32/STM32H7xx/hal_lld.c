@@ -28,6 +28,28 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Mask of the USART clock points following the bus clocks.
+ */
+#define CLK_USART_SCALED_MASK                                               \
+  ((STM32_USART16SEL == STM32_USART16SEL_PCLK2 ?                            \
+    (1U << CLK_USART1) | (1U << CLK_USART6) : 0U) |                         \
+   (STM32_USART234578SEL == STM32_USART234578SEL_PCLK1 ?                    \
+    (1U << CLK_USART2) | (1U << CLK_USART3) | (1U << CLK_UART4) |           \
+    (1U << CLK_UART5) | (1U << CLK_UART7) | (1U << CLK_UART8) : 0U) |       \
+   (STM32_LPUART1SEL == STM32_LPUART1SEL_PCLK4 ?                            \
+    (1U << CLK_LPUART1) : 0U))
+
+/**
+ * @brief   Mask of the clock points affected by the clock level.
+ */
+#define CLK_SCALED_MASK                                                     \
+  ((1U << CLK_CORE) | (1U << CLK_HCLK) | (1U << CLK_PCLK1) |                \
+   (1U << CLK_PCLK2) | (1U << CLK_PCLK3) | (1U << CLK_PCLK4) |              \
+   (1U << CLK_TIMCLK1) | (1U << CLK_TIMCLK2) | CLK_USART_SCALED_MASK)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -42,10 +64,80 @@ uint32_t SystemCoreClock = STM32_CORE_CK;
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Clock points frequencies at the highest level.
+ */
+static const uint32_t clock_points[CLK_ARRAY_SIZE] = {
+  STM32_SYS_CK,
+  STM32_CORE_CK,
+  STM32_HCLK,
+  STM32_PCLK1,
+  STM32_PCLK2,
+  STM32_PCLK3,
+  STM32_PCLK4,
+  STM32_TIMCLK1,
+  STM32_TIMCLK2,
+  STM32_USART1CLK,
+  STM32_USART2CLK,
+  STM32_USART3CLK,
+  STM32_UART4CLK,
+  STM32_UART5CLK,
+  STM32_USART6CLK,
+  STM32_UART7CLK,
+  STM32_UART8CLK,
+  STM32_LPUART1CLK
+};
+
+/**
+ * @brief   Current D1CPRE divider as a power of two.
+ */
+static unsigned clock_shift;
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Flash wait states for an HCLK frequency.
+ * @note    The boot setting is the upper bound, lower levels never require
+ *          more wait states.
+ *
+ * @param[in] hclk      HCLK frequency
+ * @return              The flash latency bits.
+ */
+static uint32_t clock_flash_bits(uint32_t hclk) {
+
+  if (hclk <= STM32_0WS_THRESHOLD) {
+    return 0U;
+  }
+  if (hclk <= STM32_1WS_THRESHOLD) {
+    return 1U;
+  }
+  if (hclk <= STM32_2WS_THRESHOLD) {
+    return 2U;
+  }
+  if (hclk <= STM32_3WS_THRESHOLD) {
+    return 3U;
+  }
+  return STM32_FLASHBITS & FLASH_ACR_LATENCY;
+}
+
+/**
+ * @brief   Programs the flash wait states.
+ *
+ * @param[in] bits      the flash latency bits
+ */
+static void clock_set_flash(uint32_t bits) {
+
+  FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | bits;
+  while ((FLASH->ACR & FLASH_ACR_LATENCY) != bits) {
+  }
+}
+#endif
+
 /**
  * @brief   Initializes the backup domain.
  * @note    WARNING! Changing clock source impossible without resetting
@@ -163,6 +255,11 @@ void hal_lld_init(void) {
   mdmaInit();
 #endif
 
+  /* Inter-core semaphores initialization.*/
+#if defined(STM32_HSEM_REQUIRED)
+  hsemInit();
+#endif
+
   /* IRQ subsystem initialization.*/
   irqInit();
 
@@ -428,4 +525,60 @@ void stm32_clock_init(void) {
 #endif /* STM32_NO_INIT */
 }
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Switches the clock tree to a level.
+ * @details The D1CPRE divider is doubled for each level below the highest,
+ *          the flash wait states are raised before speeding up and lowered
+ *          after slowing down.
+ * @note    The voltage scaling is not changed because the PLLs keep
+ *          running at the configured frequencies.
+ *
+ * @param[in] level     the clock level
+ *
+ * @notapi
+ */
+void hal_lld_clock_set_level(unsigned level) {
+  static const uint32_t d1cpre[5] = {
+    STM32_D1CPRE_DIV1, STM32_D1CPRE_DIV2, STM32_D1CPRE_DIV4,
+    STM32_D1CPRE_DIV8, STM32_D1CPRE_DIV16
+  };
+  unsigned shift = (STM32_CLOCK_LEVELS - 1U) - level;
+  uint32_t bits = clock_flash_bits(STM32_HCLK >> shift);
+
+  if (shift < clock_shift) {
+    clock_set_flash(bits);
+  }
+
+  RCC->D1CFGR = (RCC->D1CFGR & ~RCC_D1CFGR_D1CPRE) | d1cpre[shift];
+  (void) RCC->D1CFGR;
+
+  if (shift > clock_shift) {
+    clock_set_flash(bits);
+  }
+
+  clock_shift     = shift;
+  SystemCoreClock = STM32_CORE_CK >> shift;
+}
+
+/**
+ * @brief   Returns the current frequency of a clock point.
+ *
+ * @param[in] clkpt     clock point identifier
+ * @return              The clock point frequency in Hz.
+ *
+ * @notapi
+ */
+uint32_t hal_lld_get_clock_point(halclkpt_t clkpt) {
+
+  osalDbgCheck(clkpt < CLK_ARRAY_SIZE);
+
+  if ((CLK_SCALED_MASK & (1U << clkpt)) != 0U) {
+    return clock_points[clkpt] >> clock_shift;
+  }
+
+  return clock_points[clkpt];
+}
+#endif /* HAL_USE_CLOCK_SCALING == TRUE */
+
 /** @} */
@@ -582,6 +582,31 @@
 #define STM32_LPUART1SEL_LSE_CK         RCC_D3CCIPR_LPUART1SEL_VALUE(5U)
 /** @} */
 
+/**
+ * @name    Clock points names
+ * @{
+ */
+#define CLK_SYSCLK                      0U
+#define CLK_CORE                        1U
+#define CLK_HCLK                        2U
+#define CLK_PCLK1                       3U
+#define CLK_PCLK2                       4U
+#define CLK_PCLK3                       5U
+#define CLK_PCLK4                       6U
+#define CLK_TIMCLK1                     7U
+#define CLK_TIMCLK2                     8U
+#define CLK_USART1                      9U
+#define CLK_USART2                      10U
+#define CLK_USART3                      11U
+#define CLK_UART4                       12U
+#define CLK_UART5                       13U
+#define CLK_USART6                      14U
+#define CLK_UART7                       15U
+#define CLK_UART8                       16U
+#define CLK_LPUART1                     17U
+#define CLK_ARRAY_SIZE                  18U
+/** @} */
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -1278,6 +1303,17 @@
 #if !defined(STM32_LPUART1SEL) || defined(__DOXYGEN__)
 #define STM32_LPUART1SEL                    STM32_LPUART1SEL_PCLK4
 #endif
+
+/**
+ * @brief   Number of runtime clock scaling levels.
+ * @details The highest level is the configured clock tree, each lower
+ *          level doubles the D1CPRE divider halving the core, bus and
+ *          timers clocks. PLLs and kernel clocks not taken from the buses
+ *          are not affected.
+ */
+#if !defined(STM32_CLOCK_LEVELS) || defined(__DOXYGEN__)
+#define STM32_CLOCK_LEVELS                  4
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -3015,10 +3051,33 @@
 #error "invalid source selected for STM32_ADCSEL clock"
 #endif
 
+/**
+ * @name    Clock scaling support
+ * @{
+ */
+#define HAL_LLD_SUPPORTS_CLOCK_SCALING  TRUE
+#define HAL_LLD_CLOCK_LEVELS            STM32_CLOCK_LEVELS
+/** @} */
+
+#if HAL_USE_CLOCK_SCALING == TRUE
+#if STM32_D1CPRE != STM32_D1CPRE_DIV1
+#error "clock scaling requires STM32_D1CPRE_DIV1"
+#endif
+
+#if (STM32_CLOCK_LEVELS < 1) || (STM32_CLOCK_LEVELS > 5)
+#error "invalid STM32_CLOCK_LEVELS value"
+#endif
+#endif /* HAL_USE_CLOCK_SCALING == TRUE */
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Type of a clock point identifier.
+ */
+typedef unsigned halclkpt_t;
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -3035,6 +3094,8 @@
 #include "stm32_mdma.h"
 #include "stm32_dma.h"
 #include "stm32_bdma.h"
+#include "stm32_xdma.h"
+#include "stm32_hsem.h"
 #include "stm32_exti.h"
 #include "stm32_rcc.h"
 #include "stm32_tim.h"
@@ -3044,6 +3105,10 @@ extern "C" {
 #endif
   void hal_lld_init(void);
   void stm32_clock_init(void);
+#if HAL_USE_CLOCK_SCALING == TRUE
+  void hal_lld_clock_set_level(unsigned level);
+  uint32_t hal_lld_get_clock_point(halclkpt_t clkpt);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -137,6 +137,15 @@
 
 #define STM32_MDMA_NUMBER                   122
 
+/*
+ * HSEM units.
+ */
+#define STM32_HSEM1_HANDLER                 Vector234
+#define STM32_HSEM2_HANDLER                 Vector238
+
+#define STM32_HSEM1_NUMBER                  125
+#define STM32_HSEM2_NUMBER                  126
+
 /*
  * ETH units.
  */
@@ -214,6 +223,13 @@
 
 #define STM32_QUADSPI1_NUMBER               92
 
+/*
+ * RNG unit.
+ */
+#define STM32_RNG1_HANDLER                  Vector180
+
+#define STM32_RNG1_NUMBER                   80
+
 /*
  * SDMMC units.
  */
@@ -517,6 +517,34 @@
 #define rccResetCRC() rccResetAHB4(RCC_AHB4RSTR_CRCRST)
 /** @} */
 
+/**
+ * @name    DCMI peripheral specific RCC operations
+ * @{
+ */
+/**
+ * @brief   Enables the DCMI peripheral clock.
+ *
+ * @param[in] lp        low power enable flag
+ *
+ * @api
+ */
+#define rccEnableDCMI(lp) rccEnableAHB2(RCC_AHB2ENR_DCMIEN, lp)
+
+/**
+ * @brief   Disables the DCMI peripheral clock.
+ *
+ * @api
+ */
+#define rccDisableDCMI() rccDisableAHB2(RCC_AHB2ENR_DCMIEN)
+
+/**
+ * @brief   Resets the DCMI peripheral.
+ *
+ * @api
+ */
+#define rccResetDCMI() rccResetAHB2(RCC_AHB2RSTR_DCMIRST)
+/** @} */
+
 /**
  * @name    CRYP peripheral specific RCC operations
  * @{
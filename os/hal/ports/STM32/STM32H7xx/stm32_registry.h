@@ -151,6 +151,9 @@
 /* MDMA attributes.*/
 #define STM32_HAS_MDMA1                     TRUE
 
+/* HSEM attributes.*/
+#define STM32_HAS_HSEM                      TRUE
+
 /* ETH attributes.*/
 #define STM32_HAS_ETH                       TRUE
 
@@ -372,6 +375,9 @@
 /* MDMA attributes.*/
 #define STM32_HAS_MDMA1                     TRUE
 
+/* HSEM attributes.*/
+#define STM32_HAS_HSEM                      TRUE
+
 /* ETH attributes.*/
 #define STM32_HAS_ETH                       TRUE
 
@@ -0,0 +1,349 @@
+/*
+    ChibiOS - Copyright (C) 2006..2019 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    STM32H7xx/stm32_xdma.c
+ * @brief   Unified DMA channels allocator code.
+ *
+ * @addtogroup STM32_XDMA
+ * @details The allocator sits on top of the DMA, BDMA and MDMA helper
+ *          drivers, channels allocated directly through those drivers are
+ *          considered in the load evaluation and in the statistics.
+ * @{
+ */
+
+#include "hal.h"
+
+#if defined(STM32_XDMA_REQUIRED) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Engines in order of preference when equally loaded.
+ * @note    MDMA comes first because the DMA and BDMA streams are also
+ *          needed for peripheral requests.
+ */
+static const uint32_t xdma_order[STM32_XDMA_NUM_ENGINES] = {
+  STM32_XDMA_MDMA, STM32_XDMA_DMA, STM32_XDMA_BDMA
+};
+
+/**
+ * @brief   Number of channels of each engine.
+ */
+static const uint32_t xdma_channels[STM32_XDMA_NUM_ENGINES] = {
+  STM32_DMA_STREAMS, STM32_BDMA_STREAMS, STM32_MDMA_CHANNELS
+};
+
+/**
+ * @brief   Allocator statistics.
+ */
+static struct {
+  uint32_t                  peak[STM32_XDMA_NUM_ENGINES];
+  uint32_t                  allocations[STM32_XDMA_NUM_ENGINES];
+  uint32_t                  failures;
+} xdma;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of allocated channels of an engine.
+ *
+ * @param[in] engine    engine identifier
+ * @return              The number of allocated channels.
+ */
+static uint32_t xdma_in_use(uint32_t engine) {
+  uint32_t mask, n;
+
+  switch (engine) {
+  case STM32_XDMA_DMA:
+    mask = dmaGetAllocatedMaskX();
+    break;
+  case STM32_XDMA_BDMA:
+    mask = bdmaGetAllocatedMaskX();
+    break;
+  default:
+    mask = mdmaGetAllocatedMaskX();
+    break;
+  }
+
+  n = 0U;
+  while (mask != 0U) {
+    mask &= mask - 1U;
+    n++;
+  }
+
+  return n;
+}
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the engines able to reach an address.
+ * @details The bus matrix of the STM32H7 allows:
+ *          - MDMA to reach all memories including the TCMs.
+ *          - DMA1/DMA2 to reach all memories except the TCMs.
+ *          - BDMA to only reach the D3 domain SRAM and peripherals.
+ *          .
+ *
+ * @param[in] addr      address to be checked
+ * @return              Mask of the engines able to reach the address.
+ *
+ * @xclass
+ */
+uint32_t xdmaGetReachableEnginesX(const void *addr) {
+  uint32_t a = (uint32_t)addr;
+
+  /* ITCM and DTCM.*/
+  if ((a < 0x00010000U) || ((a >= 0x20000000U) && (a < 0x20040000U))) {
+    return STM32_XDMA_ENGINE_MDMA;
+  }
+
+  /* D3 domain SRAM, backup SRAM and peripherals.*/
+  if (((a >= 0x38000000U) && (a < 0x40000000U)) ||
+      ((a >= 0x58000000U) && (a < 0x60000000U))) {
+    return STM32_XDMA_ENGINE_ANY;
+  }
+
+  /* Flash, D1/D2 SRAMs, D1/D2 peripherals and external memories.*/
+  if (((a >= 0x08000000U) && (a < 0x10000000U)) ||
+      ((a >= 0x24000000U) && (a < 0x38000000U)) ||
+      ((a >= 0x40000000U) && (a < 0x58000000U)) ||
+      ((a >= 0x60000000U) && (a < 0xE0000000U))) {
+    return STM32_XDMA_ENGINE_DMA | STM32_XDMA_ENGINE_MDMA;
+  }
+
+  return 0U;
+}
+
+/**
+ * @brief   Allocates a channel on the best available engine.
+ * @details The candidate engines are those accepted by the request, able
+ *          to reach all the specified addresses and having the required
+ *          capabilities. The channel is allocated on the candidate with
+ *          the highest ratio of free channels.
+ * @note    The @p priority parameter is the IRQ priority for DMA and BDMA
+ *          channels, MDMA channels use the shared MDMA vector.
+ *
+ * @param[out] xchp     pointer to the @p stm32_xdma_channel_t object
+ * @param[in] rp        pointer to the allocation request
+ * @param[in] priority  IRQ priority for the channel
+ * @param[in] func      handling function pointer, can be @p NULL
+ * @param[in] param     a parameter to be passed to the handling function
+ * @return              The operation status.
+ * @retval false        if a channel has been allocated.
+ * @retval true         if no channel is available.
+ *
+ * @iclass
+ */
+bool xdmaChannelAllocI(stm32_xdma_channel_t *xchp,
+                       const stm32_xdma_request_t *rp,
+                       uint32_t priority,
+                       stm32_xdmaisr_t func,
+                       void *param) {
+  uint32_t candidates, tried;
+  const void *chp;
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((xchp != NULL) && (rp != NULL));
+
+  candidates = rp->engines;
+  for (i = 0U; i < 2U; i++) {
+    if (rp->addr[i] != NULL) {
+      candidates &= xdmaGetReachableEnginesX(rp->addr[i]);
+    }
+  }
+  if ((rp->flags & STM32_XDMA_REQ_BURST) != 0U) {
+    candidates &= ~STM32_XDMA_ENGINE_BDMA;
+  }
+
+  /* Trying the candidates from the least loaded one.*/
+  tried = 0U;
+  while ((candidates & ~tried) != 0U) {
+    uint32_t best = STM32_XDMA_NUM_ENGINES, best_free = 0U;
+
+    for (i = 0U; i < STM32_XDMA_NUM_ENGINES; i++) {
+      uint32_t e = xdma_order[i];
+      uint32_t nfree;
+
+      if (((candidates & ~tried) & (1U << e)) == 0U) {
+        continue;
+      }
+
+      /* Free ratio in 1/256 units.*/
+      nfree = ((xdma_channels[e] - xdma_in_use(e)) * 256U) /
+              xdma_channels[e];
+      if ((best == STM32_XDMA_NUM_ENGINES) || (nfree > best_free)) {
+        best      = e;
+        best_free = nfree;
+      }
+    }
+    tried |= 1U << best;
+    if (best_free == 0U) {
+      continue;
+    }
+
+    xchp->engine = best;
+    switch (best) {
+    case STM32_XDMA_DMA:
+      xchp->ch.dma = dmaStreamAllocI(STM32_DMA_STREAM_ID_ANY, priority,
+                                     func, param);
+      chp = xchp->ch.dma;
+      break;
+    case STM32_XDMA_BDMA:
+      xchp->ch.bdma = bdmaStreamAllocI(STM32_BDMA_STREAM_ID_ANY, priority,
+                                       func, param);
+      chp = xchp->ch.bdma;
+      break;
+    default:
+      xchp->ch.mdma = mdmaChannelAllocI(STM32_MDMA_CHANNEL_ID_ANY,
+                                        func, param);
+      chp = xchp->ch.mdma;
+      break;
+    }
+
+    if (chp != NULL) {
+      uint32_t n = xdma_in_use(best);
+
+      xdma.allocations[best]++;
+      if (n > xdma.peak[best]) {
+        xdma.peak[best] = n;
+      }
+      return false;
+    }
+  }
+
+  xdma.failures++;
+
+  return true;
+}
+
+/**
+ * @brief   Allocates a channel on the best available engine.
+ * @details The candidate engines are those accepted by the request, able
+ *          to reach all the specified addresses and having the required
+ *          capabilities. The channel is allocated on the candidate with
+ *          the highest ratio of free channels.
+ * @note    The @p priority parameter is the IRQ priority for DMA and BDMA
+ *          channels, MDMA channels use the shared MDMA vector.
+ *
+ * @param[out] xchp     pointer to the @p stm32_xdma_channel_t object
+ * @param[in] rp        pointer to the allocation request
+ * @param[in] priority  IRQ priority for the channel
+ * @param[in] func      handling function pointer, can be @p NULL
+ * @param[in] param     a parameter to be passed to the handling function
+ * @return              The operation status.
+ * @retval false        if a channel has been allocated.
+ * @retval true         if no channel is available.
+ *
+ * @api
+ */
+bool xdmaChannelAlloc(stm32_xdma_channel_t *xchp,
+                      const stm32_xdma_request_t *rp,
+                      uint32_t priority,
+                      stm32_xdmaisr_t func,
+                      void *param) {
+  bool err;
+
+  osalSysLock();
+  err = xdmaChannelAllocI(xchp, rp, priority, func, param);
+  osalSysUnlock();
+
+  return err;
+}
+
+/**
+ * @brief   Releases a channel.
+ *
+ * @param[in] xchp      pointer to the @p stm32_xdma_channel_t object
+ *
+ * @iclass
+ */
+void xdmaChannelFreeI(stm32_xdma_channel_t *xchp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(xchp != NULL);
+
+  switch (xchp->engine) {
+  case STM32_XDMA_DMA:
+    dmaStreamFreeI(xchp->ch.dma);
+    break;
+  case STM32_XDMA_BDMA:
+    bdmaStreamFreeI(xchp->ch.bdma);
+    break;
+  default:
+    mdmaChannelFreeI(xchp->ch.mdma);
+    break;
+  }
+}
+
+/**
+ * @brief   Releases a channel.
+ *
+ * @param[in] xchp      pointer to the @p stm32_xdma_channel_t object
+ *
+ * @api
+ */
+void xdmaChannelFree(stm32_xdma_channel_t *xchp) {
+
+  osalSysLock();
+  xdmaChannelFreeI(xchp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Returns the allocator statistics.
+ *
+ * @param[out] sp       pointer to the statistics to be filled
+ *
+ * @iclass
+ */
+void xdmaGetStatsI(stm32_xdma_stats_t *sp) {
+  unsigned i;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(sp != NULL);
+
+  for (i = 0U; i < STM32_XDMA_NUM_ENGINES; i++) {
+    sp->engines[i].total       = xdma_channels[i];
+    sp->engines[i].in_use      = xdma_in_use(i);
+    sp->engines[i].peak        = xdma.peak[i];
+    sp->engines[i].allocations = xdma.allocations[i];
+  }
+  sp->failures = xdma.failures;
+}
+
+#endif /* STM32_XDMA_REQUIRED */
+
+/** @} */
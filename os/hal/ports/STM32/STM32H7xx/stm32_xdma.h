@@ -0,0 +1,212 @@
+/*
+    ChibiOS - Copyright (C) 2006..2019 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    STM32H7xx/stm32_xdma.h
+ * @brief   Unified DMA channels allocator header.
+ * @details The allocator selects a channel among the DMA1/DMA2, BDMA and
+ *          MDMA engines. The selection considers the engines able to
+ *          reach the involved addresses, the required capabilities and
+ *          the current load of each engine.
+ * @note    The allocator is enabled by defining @p STM32_XDMA_REQUIRED in
+ *          mcuconf.h or in a driver header.
+ *
+ * @addtogroup STM32_XDMA
+ * @{
+ */
+
+#ifndef STM32_XDMA_H
+#define STM32_XDMA_H
+
+/* The unified allocator requires all the DMA engines.*/
+#if defined(STM32_XDMA_REQUIRED)
+#if !defined(STM32_DMA_REQUIRED)
+#define STM32_DMA_REQUIRED
+#endif
+#if !defined(STM32_BDMA_REQUIRED)
+#define STM32_BDMA_REQUIRED
+#endif
+#if !defined(STM32_MDMA_REQUIRED)
+#define STM32_MDMA_REQUIRED
+#endif
+#endif
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    DMA engines identifiers
+ * @{
+ */
+#define STM32_XDMA_DMA                      0U
+#define STM32_XDMA_BDMA                     1U
+#define STM32_XDMA_MDMA                     2U
+#define STM32_XDMA_NUM_ENGINES              3U
+/** @} */
+
+/**
+ * @name    DMA engines masks
+ * @{
+ */
+#define STM32_XDMA_ENGINE_DMA               (1U << STM32_XDMA_DMA)
+#define STM32_XDMA_ENGINE_BDMA              (1U << STM32_XDMA_BDMA)
+#define STM32_XDMA_ENGINE_MDMA              (1U << STM32_XDMA_MDMA)
+#define STM32_XDMA_ENGINE_ANY               (STM32_XDMA_ENGINE_DMA |        \
+                                             STM32_XDMA_ENGINE_BDMA |       \
+                                             STM32_XDMA_ENGINE_MDMA)
+/** @} */
+
+/**
+ * @name    Request flags
+ * @{
+ */
+/**
+ * @brief   The transfer requires burst capability.
+ * @note    This excludes the BDMA engine.
+ */
+#define STM32_XDMA_REQ_BURST                (1U << 0)
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Unified DMA ISR function type.
+ * @note    The flags format depends on the engine of the channel.
+ *
+ * @param[in] p         parameter for the registered function
+ * @param[in] flags     pre-shifted content of the engine ISR register
+ */
+typedef void (*stm32_xdmaisr_t)(void *p, uint32_t flags);
+
+/**
+ * @brief   Type of a channel allocation request.
+ */
+typedef struct {
+  /**
+   * @brief   Mask of the acceptable engines.
+   * @note    Transfers triggered by a DMAMUX1 request must use
+   *          @p STM32_XDMA_ENGINE_DMA, transfers triggered by a DMAMUX2
+   *          request must use @p STM32_XDMA_ENGINE_BDMA.
+   */
+  uint32_t                  engines;
+  /**
+   * @brief   Request flags.
+   */
+  uint32_t                  flags;
+  /**
+   * @brief   Addresses the engine must be able to reach or @p NULL.
+   * @note    Memory areas must not cross domain boundaries.
+   */
+  const void                *addr[2];
+} stm32_xdma_request_t;
+
+/**
+ * @brief   Type of an allocated channel.
+ */
+typedef struct {
+  /**
+   * @brief   Engine of the channel.
+   */
+  uint32_t                  engine;
+  /**
+   * @brief   Engine-specific channel.
+   */
+  union {
+    const stm32_dma_stream_t    *dma;
+    const stm32_bdma_stream_t   *bdma;
+    const stm32_mdma_channel_t  *mdma;
+  } ch;
+} stm32_xdma_channel_t;
+
+/**
+ * @brief   Type of the statistics of a DMA engine.
+ */
+typedef struct {
+  /**
+   * @brief   Number of channels of the engine.
+   */
+  uint32_t                  total;
+  /**
+   * @brief   Currently allocated channels, by any user.
+   */
+  uint32_t                  in_use;
+  /**
+   * @brief   Highest number of allocated channels observed.
+   */
+  uint32_t                  peak;
+  /**
+   * @brief   Allocations served by the unified allocator.
+   */
+  uint32_t                  allocations;
+} stm32_xdma_engine_stats_t;
+
+/**
+ * @brief   Type of the allocator statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Per-engine statistics.
+   */
+  stm32_xdma_engine_stats_t engines[STM32_XDMA_NUM_ENGINES];
+  /**
+   * @brief   Allocations failed because no channel was available.
+   */
+  uint32_t                  failures;
+} stm32_xdma_stats_t;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint32_t xdmaGetReachableEnginesX(const void *addr);
+  bool xdmaChannelAllocI(stm32_xdma_channel_t *xchp,
+                         const stm32_xdma_request_t *rp,
+                         uint32_t priority,
+                         stm32_xdmaisr_t func,
+                         void *param);
+  bool xdmaChannelAlloc(stm32_xdma_channel_t *xchp,
+                        const stm32_xdma_request_t *rp,
+                        uint32_t priority,
+                        stm32_xdmaisr_t func,
+                        void *param);
+  void xdmaChannelFreeI(stm32_xdma_channel_t *xchp);
+  void xdmaChannelFree(stm32_xdma_channel_t *xchp);
+  void xdmaGetStatsI(stm32_xdma_stats_t *sp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32_XDMA_H */
+
+/** @} */
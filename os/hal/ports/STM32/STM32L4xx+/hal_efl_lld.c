@@ -172,6 +172,16 @@ static inline bool stm32_flash_dual_bank(EFlashDriver *eflp) {
   return false;
 }
 
+static inline uint32_t stm32_flash_offset_bank(EFlashDriver *eflp,
+                                               flash_offset_t offset) {
+
+  if (stm32_flash_dual_bank(eflp) &&
+      (offset >= eflp->descriptor->size / 2U)) {
+    return 1U;
+  }
+  return 0U;
+}
+
 static inline flash_error_t stm32_flash_check_errors(EFlashDriver *eflp) {
   uint32_t sr = eflp->flash->SR;
 
@@ -294,9 +304,17 @@ flash_error_t efl_lld_read(void *instance, flash_offset_t offset,
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No reading while erasing.*/
+  /* Reading while erasing is only possible from the other bank.*/
   if (devp->state == FLASH_ERASE) {
-    return FLASH_BUSY_ERASING;
+    if ((stm32_flash_offset_bank(devp, offset) == devp->erase_bank) ||
+        (stm32_flash_offset_bank(devp, offset + n - 1U) == devp->erase_bank)) {
+      return FLASH_BUSY_ERASING;
+    }
+
+    /* Read-while-write, the erase state and status bits are preserved.*/
+    memcpy((void *)rp, (const void *)(bank->address + offset), n);
+
+    return FLASH_NO_ERROR;
   }
 
   /* FLASH_READ state while the operation is performed.*/
@@ -349,7 +367,7 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No programming while erasing.*/
+  /* No programming while erasing, the controller is busy.*/
   if (devp->state == FLASH_ERASE) {
     return FLASH_BUSY_ERASING;
   }
@@ -389,6 +407,12 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
     }
     while ((n > 0U) & ((offset & STM32_FLASH_LINE_MASK) != 0U));
 
+    /* Lines left in the erased state do not need to be programmed, this
+       saves program time and leaves them available for a later write.*/
+    if ((line.w[0] == 0xFFFFFFFFU) && (line.w[1] == 0xFFFFFFFFU)) {
+      continue;
+    }
+
     /* Programming line.*/
     address[0] = line.w[0];
     address[1] = line.w[1];
@@ -440,6 +464,7 @@ flash_error_t efl_lld_start_erase_all(void *instance) {
 
     /* FLASH_ERASE state while the operation is performed.*/
     devp->state = FLASH_ERASE;
+    devp->erase_bank = 1U;
 
     /* Clearing error status bits.*/
     stm32_flash_clear_status(devp);
@@ -484,6 +509,7 @@ flash_error_t efl_lld_start_erase_sector(void *instance,
 
   /* FLASH_PGM state while the operation is performed.*/
   devp->state = FLASH_ERASE;
+  devp->erase_bank = efl_lld_get_sector_bank(devp, sector);
 
   /* Clearing error status bits.*/
   stm32_flash_clear_status(devp);
@@ -591,6 +617,7 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   uint32_t *address;
   const flash_descriptor_t *bank = efl_lld_get_descriptor(instance);
   flash_error_t err = FLASH_NO_ERROR;
+  flash_state_t state;
   unsigned i;
 
   osalDbgCheck(instance != NULL);
@@ -598,8 +625,9 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No verifying while erasing.*/
-  if (devp->state == FLASH_ERASE) {
+  /* Verifying while erasing is only possible on the other bank.*/
+  if ((devp->state == FLASH_ERASE) &&
+      (efl_lld_get_sector_bank(devp, sector) == devp->erase_bank)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -607,7 +635,9 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   address = (uint32_t *)(bank->address +
                         flashGetSectorOffset(getBaseFlash(devp), sector));
 
-  /* FLASH_READ state while the operation is performed.*/
+  /* FLASH_READ state while the operation is performed, an erase in
+     progress on the other bank is not affected.*/
+  state = devp->state;
   devp->state = FLASH_READ;
 
   /* Scanning the sector space.*/
@@ -620,12 +650,45 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
     address++;
   }
 
-  /* Ready state again.*/
-  devp->state = FLASH_READY;
+  /* Previous state again.*/
+  devp->state = state;
 
   return err;
 }
 
+/**
+ * @brief   Returns the number of active banks.
+ *
+ * @param[in] eflp                  pointer to a @p EFlashDriver structure
+ * @return                          The number of banks.
+ *
+ * @notapi
+ */
+uint32_t efl_lld_get_banks(EFlashDriver *eflp) {
+
+  return stm32_flash_dual_bank(eflp) ? 2U : 1U;
+}
+
+/**
+ * @brief   Returns the bank containing a sector.
+ * @note    In dual bank mode the first half of the sectors belongs to
+ *          bank 1, the bank swap option is not considered.
+ *
+ * @param[in] eflp                  pointer to a @p EFlashDriver structure
+ * @param[in] sector                sector index
+ * @return                          The bank index.
+ *
+ * @notapi
+ */
+uint32_t efl_lld_get_sector_bank(EFlashDriver *eflp, flash_sector_t sector) {
+
+  if (stm32_flash_dual_bank(eflp) &&
+      (sector >= eflp->descriptor->sectors_count / 2U)) {
+    return 1U;
+  }
+  return 0U;
+}
+
 #endif /* HAL_USE_EFL == TRUE */
 
 /** @} */
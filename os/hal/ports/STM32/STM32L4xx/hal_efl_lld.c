@@ -111,6 +111,12 @@ static inline void stm32_flash_wait_busy(EFlashDriver *eflp) {
   }
 }
 
+static inline uint32_t stm32_flash_offset_bank(flash_offset_t offset) {
+
+  return (uint32_t)(offset / (STM32_FLASH_SECTORS_PER_BANK *
+                              STM32_FLASH_SECTOR_SIZE));
+}
+
 static inline flash_error_t stm32_flash_check_errors(EFlashDriver *eflp) {
   uint32_t sr = eflp->flash->SR;
 
@@ -219,9 +225,17 @@ flash_error_t efl_lld_read(void *instance, flash_offset_t offset,
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No reading while erasing.*/
+  /* Reading while erasing is only possible from the other bank.*/
   if (devp->state == FLASH_ERASE) {
-    return FLASH_BUSY_ERASING;
+    if ((stm32_flash_offset_bank(offset) == devp->erase_bank) ||
+        (stm32_flash_offset_bank(offset + n - 1U) == devp->erase_bank)) {
+      return FLASH_BUSY_ERASING;
+    }
+
+    /* Read-while-write, the erase state and status bits are preserved.*/
+    memcpy((void *)rp, (const void *)efl_lld_descriptor.address + offset, n);
+
+    return FLASH_NO_ERROR;
   }
 
   /* FLASH_READY state while the operation is performed.*/
@@ -273,7 +287,7 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No programming while erasing.*/
+  /* No programming while erasing, the controller is busy.*/
   if (devp->state == FLASH_ERASE) {
     return FLASH_BUSY_ERASING;
   }
@@ -313,6 +327,12 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
     }
     while ((n > 0U) & ((offset & STM32_FLASH_LINE_MASK) != 0U));
 
+    /* Lines left in the erased state do not need to be programmed, this
+       saves program time and leaves them available for a later write.*/
+    if ((line.w[0] == 0xFFFFFFFFU) && (line.w[1] == 0xFFFFFFFFU)) {
+      continue;
+    }
+
     /* Programming line.*/
     address[0] = line.w[0];
     address[1] = line.w[1];
@@ -365,6 +385,7 @@ flash_error_t efl_lld_start_erase_all(void *instance) {
   stm32_flash_clear_status(devp);
 
 #if defined(FLASH_CR_MER2)
+  devp->erase_bank = 1U;
   devp->flash->CR |= FLASH_CR_MER2;
   devp->flash->CR |= FLASH_CR_STRT;
 #endif
@@ -400,6 +421,7 @@ flash_error_t efl_lld_start_erase_sector(void *instance,
 
   /* FLASH_PGM state while the operation is performed.*/
   devp->state = FLASH_ERASE;
+  devp->erase_bank = efl_lld_get_sector_bank(devp, sector);
 
   /* Clearing error status bits.*/
   stm32_flash_clear_status(devp);
@@ -503,6 +525,7 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   EFlashDriver *devp = (EFlashDriver *)instance;
   uint32_t *address;
   flash_error_t err = FLASH_NO_ERROR;
+  flash_state_t state;
   unsigned i;
 
   osalDbgCheck(instance != NULL);
@@ -510,8 +533,9 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
                 "invalid state");
 
-  /* No verifying while erasing.*/
-  if (devp->state == FLASH_ERASE) {
+  /* Verifying while erasing is only possible on the other bank.*/
+  if ((devp->state == FLASH_ERASE) &&
+      (efl_lld_get_sector_bank(devp, sector) == devp->erase_bank)) {
     return FLASH_BUSY_ERASING;
   }
 
@@ -519,7 +543,9 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
   address = (uint32_t *)(efl_lld_descriptor.address +
                          flashGetSectorOffset(getBaseFlash(devp), sector));
 
-  /* FLASH_READY state while the operation is performed.*/
+  /* FLASH_READ state while the operation is performed, an erase in
+     progress on the other bank is not affected.*/
+  state = devp->state;
   devp->state = FLASH_READ;
 
   /* Scanning the sector space.*/
@@ -531,12 +557,44 @@ flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector) {
     address++;
   }
 
-  /* Ready state again.*/
-  devp->state = FLASH_READY;
+  /* Previous state again.*/
+  devp->state = state;
 
   return err;
 }
 
+/**
+ * @brief   Returns the number of banks.
+ *
+ * @param[in] eflp                  pointer to a @p EFlashDriver structure
+ * @return                          The number of banks.
+ *
+ * @notapi
+ */
+uint32_t efl_lld_get_banks(EFlashDriver *eflp) {
+
+  (void)eflp;
+
+  return STM32_FLASH_NUMBER_OF_BANKS;
+}
+
+/**
+ * @brief   Returns the bank containing a sector.
+ * @note    The bank swap option is not considered.
+ *
+ * @param[in] eflp                  pointer to a @p EFlashDriver structure
+ * @param[in] sector                sector index
+ * @return                          The bank index.
+ *
+ * @notapi
+ */
+uint32_t efl_lld_get_sector_bank(EFlashDriver *eflp, flash_sector_t sector) {
+
+  (void)eflp;
+
+  return (uint32_t)(sector / STM32_FLASH_SECTORS_PER_BANK);
+}
+
 #endif /* HAL_USE_EFL == TRUE */
 
 /** @} */
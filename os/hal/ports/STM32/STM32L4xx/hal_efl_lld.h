@@ -31,6 +31,11 @@
 /* Driver constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   The driver describes the flash banks.
+ */
+#define EFL_LLD_SUPPORTS_BANKS              TRUE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -72,7 +77,9 @@
  */
 #define efl_lld_driver_fields                                               \
   /* Flash registers.*/                                                     \
-  FLASH_TypeDef             *flash
+  FLASH_TypeDef             *flash;                                         \
+  /* Bank of the erase operation in progress.*/                             \
+  uint32_t                  erase_bank
 
 /**
  * @brief   Low level fields of the embedded flash configuration structure.
@@ -105,6 +112,8 @@ extern "C" {
                                            flash_sector_t sector);
   flash_error_t efl_lld_query_erase(void *instance, uint32_t *msec);
   flash_error_t efl_lld_verify_erase(void *instance, flash_sector_t sector);
+  uint32_t efl_lld_get_banks(EFlashDriver *eflp);
+  uint32_t efl_lld_get_sector_bank(EFlashDriver *eflp, flash_sector_t sector);
 #ifdef __cplusplus
 }
 #endif
@@ -179,6 +179,13 @@
 
 #define STM32_QUADSPI1_NUMBER               71
 
+/*
+ * RNG unit.
+ */
+#define STM32_RNG1_HANDLER                  Vector180
+
+#define STM32_RNG1_NUMBER                   80
+
 /*
  * SDMMC unit.
  */
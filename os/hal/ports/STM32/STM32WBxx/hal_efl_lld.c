@@ -313,6 +313,12 @@ flash_error_t efl_lld_program(void *instance, flash_offset_t offset,
     }
     while ((n > 0U) & ((offset & STM32_FLASH_LINE_MASK) != 0U));
 
+    /* Lines left in the erased state do not need to be programmed, this
+       saves program time and leaves them available for a later write.*/
+    if ((line.w[0] == 0xFFFFFFFFU) && (line.w[1] == 0xFFFFFFFFU)) {
+      continue;
+    }
+
     /* Programming line.*/
     address[0] = line.w[0];
     address[1] = line.w[1];
@@ -42,6 +42,20 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Skips the maintenance of buffers in the @p .nocache section.
+ * @details If enabled the buffer maintenance macros do nothing for buffers
+ *          starting between @p __nocache_base__ and @p __nocache_end__,
+ *          this saves the full range operations on buffers that do not
+ *          need them.
+ * @note    The linker script must place the @p .nocache section into a
+ *          memory region marked as non-cacheable using the MPU.
+ * @note    Buffers must be fully contained in the section.
+ */
+#if !defined(CACHE_SKIP_NOCACHE) || defined(__DOXYGEN__)
+#define CACHE_SKIP_NOCACHE                  FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -56,6 +70,22 @@
 
 #if defined(__DCACHE_PRESENT) || defined(__DOXYGEN__)
 #if (__DCACHE_PRESENT != 0) || defined(__DOXYGEN__)
+#if (CACHE_SKIP_NOCACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checks if a buffer is located in the @p .nocache section.
+ *
+ * @param[in] addr      start address of the buffer
+ * @return              The check result.
+ * @retval false        if the buffer is cacheable.
+ * @retval true         if the buffer is in the @p .nocache section.
+ */
+#define CACHE_IS_NOCACHE(addr)                                              \
+  (((const uint8_t *)(addr) >= __nocache_base__) &&                         \
+   ((const uint8_t *)(addr) < __nocache_end__))
+#else
+#define CACHE_IS_NOCACHE(addr) false
+#endif
+
 /**
  * @brief   Aligns the specified size to a multiple of cache line size.
  * @note    This macros assumes that the size of the type @p t is a power of
@@ -82,15 +112,17 @@
  * @api
  */
 #define cacheBufferInvalidate(saddr, n) {                                   \
-  uint8_t *start = (uint8_t *)(saddr);                                      \
-  uint8_t *end = start + (size_t)(n);                                       \
-  __DSB();                                                                  \
-  while (start < end) {                                                     \
-    SCB->DCIMVAC = (uint32_t)start;                                         \
-    start += CACHE_LINE_SIZE;                                               \
+  if (!CACHE_IS_NOCACHE(saddr)) {                                           \
+    uint8_t *start = (uint8_t *)(saddr);                                    \
+    uint8_t *end = start + (size_t)(n);                                     \
+    __DSB();                                                                \
+    while (start < end) {                                                   \
+      SCB->DCIMVAC = (uint32_t)start;                                       \
+      start += CACHE_LINE_SIZE;                                             \
+    }                                                                       \
+    __DSB();                                                                \
+    __ISB();                                                                \
   }                                                                         \
-  __DSB();                                                                  \
-  __ISB();                                                                  \
 }
 
 /**
@@ -108,15 +140,17 @@
  * @api
  */
 #define cacheBufferFlush(saddr, n) {                                        \
-  uint8_t *start = (uint8_t *)(saddr);                                      \
-  uint8_t *end = start + (size_t)(n);                                       \
-  __DSB();                                                                  \
-  while (start < end) {                                                     \
-    SCB->DCCIMVAC = (uint32_t)start;                                        \
-    start += CACHE_LINE_SIZE;                                               \
+  if (!CACHE_IS_NOCACHE(saddr)) {                                           \
+    uint8_t *start = (uint8_t *)(saddr);                                    \
+    uint8_t *end = start + (size_t)(n);                                     \
+    __DSB();                                                                \
+    while (start < end) {                                                   \
+      SCB->DCCIMVAC = (uint32_t)start;                                      \
+      start += CACHE_LINE_SIZE;                                             \
+    }                                                                       \
+    __DSB();                                                                \
+    __ISB();                                                                \
   }                                                                         \
-  __DSB();                                                                  \
-  __ISB();                                                                  \
 }
 
 #else /* __DCACHE_PRESENT == 0 */
@@ -147,6 +181,11 @@
 /* External declarations.                                                    */
 /*===========================================================================*/
 
+#if (CACHE_SKIP_NOCACHE == TRUE) && !defined(__DOXYGEN__)
+extern const uint8_t __nocache_base__[];
+extern const uint8_t __nocache_end__[];
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
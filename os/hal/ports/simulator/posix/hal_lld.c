@@ -37,12 +37,60 @@
 /*===========================================================================*/
 
 static struct timeval nextcnt;
-static struct timeval tick = {0UL, 1000000UL / OSAL_ST_FREQUENCY};
+static struct timeval tick = {0UL, 1000000UL / (OSAL_ST_FREQUENCY *
+                                                SIM_TIME_SPEED)};
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   System tick simulation.
+ */
+static void sim_tick(void) {
+
+  CH_IRQ_PROLOGUE();
+
+  chSysLockFromISR();
+  chSysTimerHandlerI();
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+}
+
+#if (SIM_USE_VIRTUAL_TIME == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checks if the idle thread is running.
+ */
+static bool sim_is_idle(void) {
+
+#if defined(_CHIBIOS_NIL_)
+  return nil.current == &nil.threads[CH_CFG_MAX_THREADS];
+#else
+  return chThdGetPriorityX() == IDLEPRIO;
+#endif
+}
+
+/**
+ * @brief   Advances the simulated time up to the next event.
+ * @details Ticks are generated until a thread becomes ready, the loop is
+ *          limited to one second of simulated time so that the other
+ *          interrupt sources are checked periodically.
+ */
+static void sim_fast_forward(void) {
+  unsigned n = OSAL_ST_FREQUENCY;
+
+  do {
+    sim_tick();
+    n--;
+  } while ((n > 0U) && !chSchIsPreemptionRequired());
+
+  /* The wall-clock reference restarts from now.*/
+  gettimeofday(&nextcnt, NULL);
+  timeradd(&nextcnt, &tick, &nextcnt);
+}
+#endif
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -78,18 +126,20 @@ void _sim_check_for_interrupts(void) {
   }
 #endif
 
-  gettimeofday(&tv, NULL);
-  if (timercmp(&tv, &nextcnt, >=)) {
+#if SIM_USE_VIRTUAL_TIME == TRUE
+  if (!int_occurred && sim_is_idle()) {
     int_occurred = true;
-    timeradd(&nextcnt, &tick, &nextcnt);
-
-    CH_IRQ_PROLOGUE();
-
-    chSysLockFromISR();
-    chSysTimerHandlerI();
-    chSysUnlockFromISR();
-
-    CH_IRQ_EPILOGUE();
+    sim_fast_forward();
+  }
+  else
+#endif
+  {
+    gettimeofday(&tv, NULL);
+    if (timercmp(&tv, &nextcnt, >=)) {
+      int_occurred = true;
+      timeradd(&nextcnt, &tick, &nextcnt);
+      sim_tick();
+    }
   }
 
   if (int_occurred) {
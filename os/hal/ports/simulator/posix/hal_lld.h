@@ -53,10 +53,34 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Enables the virtual time mode.
+ * @details If enabled the system ticks are generated back to back while
+ *          the idle thread is running, the simulated time jumps to the
+ *          next event without waiting for it.
+ */
+#if !defined(SIM_USE_VIRTUAL_TIME) || defined(__DOXYGEN__)
+#define SIM_USE_VIRTUAL_TIME                FALSE
+#endif
+
+/**
+ * @brief   Simulated time speed multiplier.
+ * @details The system ticks are generated this many times faster than
+ *          the wall-clock time while threads are running.
+ */
+#if !defined(SIM_TIME_SPEED) || defined(__DOXYGEN__)
+#define SIM_TIME_SPEED                      1
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (SIM_TIME_SPEED < 1) ||                                                 \
+    (SIM_TIME_SPEED > 1000000 / OSAL_ST_FREQUENCY)
+#error "invalid SIM_TIME_SPEED value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
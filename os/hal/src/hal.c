@@ -61,6 +61,10 @@ void halInit(void) {
   /* Platform low level initializations.*/
   hal_lld_init();
 
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+  halClockInit();
+#endif
+
 #if (HAL_USE_PAL == TRUE) || defined(__DOXYGEN__)
 #if defined(PAL_NEW_INIT)
   palInit();
@@ -74,12 +78,18 @@ void halInit(void) {
 #if (HAL_USE_CAN == TRUE) || defined(__DOXYGEN__)
   canInit();
 #endif
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+  crcInit();
+#endif
 #if (HAL_USE_CRY == TRUE) || defined(__DOXYGEN__)
   cryInit();
 #endif
 #if (HAL_USE_DAC == TRUE) || defined(__DOXYGEN__)
   dacInit();
 #endif
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+  dcmiInit();
+#endif
 #if (HAL_USE_EFL == TRUE) || defined(__DOXYGEN__)
   eflInit();
 #endif
@@ -416,6 +416,83 @@ size_t ibqReadTimeout(input_buffers_queue_t *ibqp, uint8_t *bp,
   }
 }
 
+/**
+ * @brief   Borrows the current input buffer for in place access.
+ * @details The function returns a pointer to the data not yet read in the
+ *          current buffer, a new filled buffer is acquired if there is no
+ *          current buffer. The data is accessed without copies then the
+ *          buffer is returned using @p ibqReturnBuffer().
+ * @note    The borrowed data is valid until returned or until the queue
+ *          is reset.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ * @param[out] bpp      pointer to a variable receiving the data pointer
+ * @param[out] np       pointer to a variable receiving the data size
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been borrowed.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset or has been put in
+ *                      suspended state.
+ *
+ * @api
+ */
+msg_t ibqBorrowBufferTimeout(input_buffers_queue_t *ibqp,
+                             const uint8_t **bpp, size_t *np,
+                             sysinterval_t timeout) {
+  msg_t msg = MSG_OK;
+
+  osalDbgCheck((bpp != NULL) && (np != NULL));
+
+  osalSysLock();
+
+  /* A partially read buffer is continued.*/
+  if (ibqp->ptr == NULL) {
+    msg = ibqGetFullBufferTimeoutS(ibqp, timeout);
+  }
+
+  if (msg == MSG_OK) {
+    *bpp = ibqp->ptr;
+    *np  = (size_t)ibqp->top - (size_t)ibqp->ptr;
+  }
+
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Returns a borrowed input buffer.
+ * @details The specified amount of data is consumed, the buffer is
+ *          released back in the queue when all its data has been consumed.
+ * @note    Returning a buffer after a queue reset has no effect.
+ *
+ * @param[in] ibqp      pointer to the @p input_buffers_queue_t object
+ * @param[in] n         number of bytes consumed, it cannot be larger than
+ *                      the size returned by @p ibqBorrowBufferTimeout()
+ *
+ * @api
+ */
+void ibqReturnBuffer(input_buffers_queue_t *ibqp, size_t n) {
+
+  osalSysLock();
+
+  if (ibqp->ptr != NULL) {
+    osalDbgCheck(n <= ((size_t)ibqp->top - (size_t)ibqp->ptr));
+
+    ibqp->ptr += n;
+    if (ibqp->ptr >= ibqp->top) {
+      ibqReleaseEmptyBufferS(ibqp);
+    }
+  }
+
+  osalSysUnlock();
+}
+
 /**
  * @brief   Initializes an output buffers queue object.
  *
@@ -779,6 +856,85 @@ size_t obqWriteTimeout(output_buffers_queue_t *obqp, const uint8_t *bp,
   }
 }
 
+/**
+ * @brief   Borrows an empty output buffer for in place access.
+ * @details The function returns a pointer to an empty buffer, data can be
+ *          written directly into it then the buffer is returned using
+ *          @p obqReturnBuffer().
+ * @note    A partially filled current buffer is posted first, so the
+ *          borrowed buffer is never flushed while it is being written.
+ *
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @param[out] bpp      pointer to a variable receiving the buffer pointer
+ * @param[out] np       pointer to a variable receiving the buffer size
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been borrowed.
+ * @retval MSG_TIMEOUT  if the specified time expired.
+ * @retval MSG_RESET    if the queue has been reset or has been put in
+ *                      suspended state.
+ *
+ * @api
+ */
+msg_t obqBorrowBufferTimeout(output_buffers_queue_t *obqp,
+                             uint8_t **bpp, size_t *np,
+                             sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((bpp != NULL) && (np != NULL));
+
+  osalSysLock();
+
+  /* If there is a buffer partially filled then it is posted.*/
+  if (obqp->ptr != NULL) {
+    size_t size = ((size_t)obqp->ptr - (size_t)obqp->bwrptr) - sizeof (size_t);
+
+    if (size > 0U) {
+      obqPostFullBufferS(obqp, size);
+    }
+  }
+
+  msg = obqGetEmptyBufferTimeoutS(obqp, timeout);
+  if (msg == MSG_OK) {
+    *bpp = obqp->ptr;
+    *np  = (size_t)obqp->top - (size_t)obqp->ptr;
+  }
+
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Returns a borrowed output buffer.
+ * @details The buffer is posted in the queue if data has been written into
+ *          it, else it remains the current buffer.
+ * @note    Returning a buffer after a queue reset has no effect.
+ *
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @param[in] n         number of bytes written in the buffer, it cannot be
+ *                      larger than the size returned by
+ *                      @p obqBorrowBufferTimeout()
+ *
+ * @api
+ */
+void obqReturnBuffer(output_buffers_queue_t *obqp, size_t n) {
+
+  osalSysLock();
+
+  if ((obqp->ptr != NULL) && (n > 0U)) {
+    osalDbgCheck(n <= ((size_t)obqp->top - (size_t)obqp->ptr));
+
+    obqPostFullBufferS(obqp, n);
+  }
+
+  osalSysUnlock();
+}
+
 /**
  * @brief   Flushes the current, partially filled, buffer to the queue.
  * @note    The notification callback is not invoked because the function
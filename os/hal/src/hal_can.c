@@ -332,6 +332,66 @@ msg_t canReceiveTimeout(CANDriver *canp,
   return MSG_OK;
 }
 
+/**
+ * @brief   Can frames batch receive.
+ * @details The function waits until a frame is received then all the
+ *          pending frames, up to @p n, are copied in the array within the
+ *          same critical section. The receiving thread is woken once for
+ *          the whole batch.
+ * @note    Trying to receive while in sleep mode simply enqueues the thread.
+ *
+ * @param[in] canp      pointer to the @p CANDriver object
+ * @param[in] mailbox   mailbox number, @p CAN_ANY_MAILBOX for any mailbox
+ * @param[out] crfp     pointer to the array where the CAN frames are copied
+ * @param[in] n         number of elements in the array
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout (useful in an
+ *                        event driven scenario where a thread never blocks
+ *                        for I/O).
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of received frames or an error code.
+ * @retval MSG_TIMEOUT  The operation has timed out.
+ * @retval MSG_RESET    The driver has been stopped while waiting.
+ *
+ * @api
+ */
+msg_t canReceiveBatchTimeout(CANDriver *canp,
+                             canmbx_t mailbox,
+                             CANRxFrame *crfp,
+                             size_t n,
+                             sysinterval_t timeout) {
+  msg_t i;
+
+  osalDbgCheck((canp != NULL) && (crfp != NULL) && (n > 0U) &&
+               (mailbox <= (canmbx_t)CAN_RX_MAILBOXES));
+
+  osalSysLock();
+  osalDbgAssert((canp->state == CAN_READY) || (canp->state == CAN_SLEEP),
+                "invalid state");
+
+  /*lint -save -e9007 [13.5] Right side is supposed to be pure.*/
+  while ((canp->state == CAN_SLEEP) || !can_lld_is_rx_nonempty(canp, mailbox)) {
+  /*lint -restore*/
+    msg_t msg = osalThreadEnqueueTimeoutS(&canp->rxqueue, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+
+  /* Draining the pending frames.*/
+  i = 0;
+  do {
+    can_lld_receive(canp, mailbox, &crfp[i]);
+    i++;
+  } while (((size_t)i < n) && can_lld_is_rx_nonempty(canp, mailbox));
+  osalSysUnlock();
+
+  return i;
+}
+
 #if (CAN_USE_SLEEP_MODE == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Enters the sleep mode.
@@ -0,0 +1,269 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_clock.c
+ * @brief   Clock scaling code.
+ *
+ * @addtogroup HAL_CLOCK
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_CLOCK_SCALING == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Clock scaling state.
+ */
+static struct {
+  /**
+   * @brief   Current clock level.
+   */
+  unsigned                  level;
+  /**
+   * @brief   Highest requested level.
+   */
+  unsigned                  floor;
+  /**
+   * @brief   Registered listeners.
+   */
+  hal_clock_listener_t      *listeners;
+  /**
+   * @brief   Number of active requests for each level.
+   */
+  unsigned                  requests[HAL_LLD_CLOCK_LEVELS];
+} hal_clock;
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Notifies an event to all the listeners.
+ *
+ * @param[in] event     the clock change event
+ */
+static void clock_notify(halclkevent_t event) {
+  hal_clock_listener_t *lp;
+
+  for (lp = hal_clock.listeners; lp != NULL; lp = lp->next) {
+    lp->cb(lp->param, event);
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Clock scaling initialization.
+ * @note    This function is implicitly invoked by @p halInit(), there is
+ *          no need to explicitly initialize the subsystem.
+ *
+ * @init
+ */
+void halClockInit(void) {
+  unsigned i;
+
+  hal_clock.level     = HAL_CLOCK_LEVEL_MAX;
+  hal_clock.floor     = 0U;
+  hal_clock.listeners = NULL;
+  for (i = 0U; i < HAL_LLD_CLOCK_LEVELS; i++) {
+    hal_clock.requests[i] = 0U;
+  }
+}
+
+/**
+ * @brief   Registers a clock change listener.
+ *
+ * @param[out] lp       pointer to the @p hal_clock_listener_t object
+ * @param[in] cb        callback invoked on clock changes
+ * @param[in] param     parameter passed to the callback
+ *
+ * @iclass
+ */
+void halClockRegisterListenerI(hal_clock_listener_t *lp,
+                               halclkcb_t cb, void *param) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((lp != NULL) && (cb != NULL));
+
+  lp->cb              = cb;
+  lp->param           = param;
+  lp->next            = hal_clock.listeners;
+  hal_clock.listeners = lp;
+}
+
+/**
+ * @brief   Unregisters a clock change listener.
+ * @note    Unregistering a listener not registered is harmless.
+ *
+ * @param[in] lp        pointer to the @p hal_clock_listener_t object
+ *
+ * @iclass
+ */
+void halClockUnregisterListenerI(hal_clock_listener_t *lp) {
+  hal_clock_listener_t **lpp;
+
+  osalDbgCheckClassI();
+  osalDbgCheck(lp != NULL);
+
+  for (lpp = &hal_clock.listeners; *lpp != NULL; lpp = &(*lpp)->next) {
+    if (*lpp == lp) {
+      *lpp = lp->next;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief   Switches the clock tree to a level.
+ * @details The listeners are notified before and after the change, the
+ *          level is raised to the highest requested level if lower.
+ *
+ * @param[in] level     the clock level
+ * @return              The level actually set.
+ *
+ * @sclass
+ */
+unsigned halClockSetLevelS(unsigned level) {
+
+  osalDbgCheckClassS();
+  osalDbgCheck(level <= HAL_CLOCK_LEVEL_MAX);
+
+  if (level < hal_clock.floor) {
+    level = hal_clock.floor;
+  }
+
+  if (level != hal_clock.level) {
+    clock_notify(HAL_CLOCK_PRE_CHANGE);
+    hal_lld_clock_set_level(level);
+    hal_clock.level = level;
+    clock_notify(HAL_CLOCK_POST_CHANGE);
+  }
+
+  return level;
+}
+
+/**
+ * @brief   Switches the clock tree to a level.
+ * @details The listeners are notified before and after the change, the
+ *          level is raised to the highest requested level if lower.
+ *
+ * @param[in] level     the clock level
+ * @return              The level actually set.
+ *
+ * @api
+ */
+unsigned halClockSetLevel(unsigned level) {
+
+  osalSysLock();
+  level = halClockSetLevelS(level);
+  osalSysUnlock();
+
+  return level;
+}
+
+/**
+ * @brief   Returns the current clock level.
+ *
+ * @return              The current clock level.
+ *
+ * @xclass
+ */
+unsigned halClockGetLevelX(void) {
+
+  return hal_clock.level;
+}
+
+/**
+ * @brief   Returns the highest requested clock level.
+ *
+ * @return              The highest requested level or zero if there are
+ *                      no requests.
+ *
+ * @xclass
+ */
+unsigned halClockGetFloorX(void) {
+
+  return hal_clock.floor;
+}
+
+/**
+ * @brief   Requests a minimum clock level.
+ * @details The clock tree is switched immediately if the current level is
+ *          lower than the requested one.
+ * @note    Each request must be balanced by a call to
+ *          @p halClockReleaseLevel() with the same level.
+ *
+ * @param[in] level     the requested clock level
+ *
+ * @api
+ */
+void halClockRequestLevel(unsigned level) {
+
+  osalDbgCheck(level <= HAL_CLOCK_LEVEL_MAX);
+
+  osalSysLock();
+  hal_clock.requests[level]++;
+  if (level > hal_clock.floor) {
+    hal_clock.floor = level;
+    if (hal_clock.level < level) {
+      (void) halClockSetLevelS(level);
+    }
+  }
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Releases a minimum clock level request.
+ * @note    The current level is not lowered, it is up to the caller or to
+ *          a governor to select a lower level.
+ *
+ * @param[in] level     the released clock level
+ *
+ * @api
+ */
+void halClockReleaseLevel(unsigned level) {
+
+  osalDbgCheck(level <= HAL_CLOCK_LEVEL_MAX);
+
+  osalSysLock();
+  osalDbgAssert(hal_clock.requests[level] > 0U, "not requested");
+  hal_clock.requests[level]--;
+  while ((hal_clock.floor > 0U) &&
+         (hal_clock.requests[hal_clock.floor] == 0U)) {
+    hal_clock.floor--;
+  }
+  osalSysUnlock();
+}
+
+#endif /* HAL_USE_CLOCK_SCALING == TRUE */
+
+/** @} */
@@ -0,0 +1,358 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crc.c
+ * @brief   CRC Driver code.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+#if (CRC_USE_SW_FALLBACK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Generates the software fallback tables.
+ * @details The first table is the classic byte-wise table, each following
+ *          table accounts for one more zero byte after the indexed one.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ */
+static void crc_sw_init(CRCDriver *crcp) {
+  const CRCConfig *config = crcp->config;
+  uint32_t (*t)[256] = crcp->sw_tables;
+  uint32_t poly, c;
+  unsigned i, j;
+
+  if (config->reflect) {
+    /* Reflected polynomial, the register is right-aligned.*/
+    poly = 0U;
+    for (j = 0U; j < config->width; j++) {
+      if ((config->poly & (1U << j)) != 0U) {
+        poly |= 1U << (config->width - 1U - j);
+      }
+    }
+    for (i = 0U; i < 256U; i++) {
+      c = i;
+      for (j = 0U; j < 8U; j++) {
+        c = (c & 1U) != 0U ? (c >> 1) ^ poly : c >> 1;
+      }
+      t[0][i] = c;
+    }
+    for (j = 1U; j < CRC_SW_SLICES; j++) {
+      for (i = 0U; i < 256U; i++) {
+        c = t[j - 1U][i];
+        t[j][i] = (c >> 8) ^ t[0][c & 0xFFU];
+      }
+    }
+  }
+  else {
+    /* Normal polynomial, the register is left-aligned.*/
+    poly = config->poly << (32U - config->width);
+    for (i = 0U; i < 256U; i++) {
+      c = i << 24;
+      for (j = 0U; j < 8U; j++) {
+        c = (c & 0x80000000U) != 0U ? (c << 1) ^ poly : c << 1;
+      }
+      t[0][i] = c;
+    }
+    for (j = 1U; j < CRC_SW_SLICES; j++) {
+      for (i = 0U; i < 256U; i++) {
+        c = t[j - 1U][i];
+        t[j][i] = (c << 8) ^ t[0][c >> 24];
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Software CRC computation.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] crc       CRC value to continue from
+ * @param[in] n         number of bytes
+ * @param[in] p         pointer to the data
+ * @return              The updated CRC value.
+ */
+static uint32_t crc_sw_compute(CRCDriver *crcp, uint32_t crc,
+                               size_t n, const uint8_t *p) {
+  const uint32_t (*t)[256] = (const uint32_t (*)[256])crcp->sw_tables;
+  uint32_t shift = 32U - (uint32_t)crcp->config->width;
+
+  if (crcp->config->reflect) {
+    crc &= 0xFFFFFFFFU >> shift;
+#if CRC_SW_SLICES > 1
+    while (n >= CRC_SW_SLICES) {
+      crc ^= (uint32_t)p[0]         | ((uint32_t)p[1] << 8) |
+             ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+#if CRC_SW_SLICES == 8
+      crc = t[7][crc & 0xFFU]         ^ t[6][(crc >> 8) & 0xFFU] ^
+            t[5][(crc >> 16) & 0xFFU] ^ t[4][crc >> 24]          ^
+            t[3][p[4]] ^ t[2][p[5]]   ^ t[1][p[6]] ^ t[0][p[7]];
+#else
+      crc = t[3][crc & 0xFFU]         ^ t[2][(crc >> 8) & 0xFFU] ^
+            t[1][(crc >> 16) & 0xFFU] ^ t[0][crc >> 24];
+#endif
+      p += CRC_SW_SLICES;
+      n -= CRC_SW_SLICES;
+    }
+#endif
+    while (n > 0U) {
+      crc = (crc >> 8) ^ t[0][(crc ^ (uint32_t)*p) & 0xFFU];
+      p++;
+      n--;
+    }
+
+    return crc;
+  }
+
+  crc <<= shift;
+#if CRC_SW_SLICES > 1
+  while (n >= CRC_SW_SLICES) {
+    crc ^= ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  | (uint32_t)p[3];
+#if CRC_SW_SLICES == 8
+    crc = t[7][crc >> 24]          ^ t[6][(crc >> 16) & 0xFFU] ^
+          t[5][(crc >> 8) & 0xFFU] ^ t[4][crc & 0xFFU]         ^
+          t[3][p[4]] ^ t[2][p[5]]  ^ t[1][p[6]] ^ t[0][p[7]];
+#else
+    crc = t[3][crc >> 24]          ^ t[2][(crc >> 16) & 0xFFU] ^
+          t[1][(crc >> 8) & 0xFFU] ^ t[0][crc & 0xFFU];
+#endif
+    p += CRC_SW_SLICES;
+    n -= CRC_SW_SLICES;
+  }
+#endif
+  while (n > 0U) {
+    crc = (crc << 8) ^ t[0][(crc >> 24) ^ (uint32_t)*p];
+    p++;
+    n--;
+  }
+
+  return crc >> shift;
+}
+#endif /* CRC_USE_SW_FALLBACK == TRUE */
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   CRC Driver initialization.
+ * @note    This function is implicitly invoked by @p halInit(), there is
+ *          no need to explicitly initialize the driver.
+ *
+ * @init
+ */
+void crcInit(void) {
+
+  crc_lld_init();
+}
+
+/**
+ * @brief   Initializes the standard part of a @p CRCDriver structure.
+ *
+ * @param[out] crcp     pointer to the @p CRCDriver object
+ *
+ * @init
+ */
+void crcObjectInit(CRCDriver *crcp) {
+
+  crcp->state  = CRC_STOP;
+  crcp->config = NULL;
+#if CRC_USE_MUTUAL_EXCLUSION == TRUE
+  osalMutexObjectInit(&crcp->mutex);
+#endif
+#if CRC_USE_SW_FALLBACK == TRUE
+  crcp->sw     = false;
+#endif
+#if defined(CRC_DRIVER_EXT_INIT_HOOK)
+  CRC_DRIVER_EXT_INIT_HOOK(crcp);
+#endif
+}
+
+/**
+ * @brief   Configures and activates the CRC peripheral.
+ * @details If the configuration is not supported by the hardware then it
+ *          is served by the software fallback, the tables generation takes
+ *          a while.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] config    pointer to the @p CRCConfig object
+ *
+ * @api
+ */
+void crcStart(CRCDriver *crcp, const CRCConfig *config) {
+
+  osalDbgCheck((crcp != NULL) && (config != NULL) &&
+               (config->width >= 1U) && (config->width <= 32U));
+
+#if CRC_USE_SW_FALLBACK == TRUE
+  /* Switching between hardware and software requires stopping first.*/
+  if (crcp->sw || !crc_lld_is_supported(config)) {
+    crcStop(crcp);
+  }
+
+  if (!crc_lld_is_supported(config)) {
+    crcp->config = config;
+    crcp->sw     = true;
+    crc_sw_init(crcp);
+    crcp->state  = CRC_READY;
+    return;
+  }
+#else
+  osalDbgAssert(crc_lld_is_supported(config), "unsupported configuration");
+#endif
+
+  osalSysLock();
+  osalDbgAssert((crcp->state == CRC_STOP) || (crcp->state == CRC_READY),
+                "invalid state");
+  crcp->config = config;
+  crc_lld_start(crcp);
+  crcp->state = CRC_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Deactivates the CRC peripheral.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @api
+ */
+void crcStop(CRCDriver *crcp) {
+
+  osalDbgCheck(crcp != NULL);
+
+  osalSysLock();
+
+  osalDbgAssert((crcp->state == CRC_STOP) || (crcp->state == CRC_READY),
+                "invalid state");
+
+#if CRC_USE_SW_FALLBACK == TRUE
+  if (!crcp->sw) {
+    crc_lld_stop(crcp);
+  }
+  crcp->sw     = false;
+#else
+  crc_lld_stop(crcp);
+#endif
+  crcp->config = NULL;
+  crcp->state  = CRC_STOP;
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Computes the CRC of a data block.
+ * @details The computation continues from the specified CRC value, a new
+ *          computation is started by passing the initial value of the
+ *          CRC algorithm. The final XOR, if any, is not applied.
+ * @note    The function can sleep if the low level driver uses DMA for
+ *          large blocks.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] crc       CRC value to continue from
+ * @param[in] n         number of bytes
+ * @param[in] buf       pointer to the data
+ * @return              The updated CRC value.
+ *
+ * @api
+ */
+uint32_t crcCompute(CRCDriver *crcp, uint32_t crc,
+                    size_t n, const void *buf) {
+
+  osalDbgCheck((crcp != NULL) && ((n == 0U) || (buf != NULL)));
+
+  osalDbgAssert(crcp->state == CRC_READY, "not ready");
+
+  crcp->state = CRC_ACTIVE;
+
+#if CRC_USE_SW_FALLBACK == TRUE
+  if (crcp->sw) {
+    crc = crc_sw_compute(crcp, crc, n, (const uint8_t *)buf);
+  }
+  else {
+    crc = crc_lld_compute(crcp, crc, n, (const uint8_t *)buf);
+  }
+#else
+  crc = crc_lld_compute(crcp, crc, n, (const uint8_t *)buf);
+#endif
+
+  crcp->state = CRC_READY;
+
+  return crc;
+}
+
+#if (CRC_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Gains exclusive access to the CRC peripheral.
+ * @details This function tries to gain ownership to the CRC peripheral, if
+ *          the peripheral is already being used then the invoking thread
+ *          is queued.
+ * @pre     In order to use this function the option
+ *          @p CRC_USE_MUTUAL_EXCLUSION must be enabled.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @api
+ */
+void crcAcquireBus(CRCDriver *crcp) {
+
+  osalDbgCheck(crcp != NULL);
+
+  osalMutexLock(&crcp->mutex);
+}
+
+/**
+ * @brief   Releases exclusive access to the CRC peripheral.
+ * @pre     In order to use this function the option
+ *          @p CRC_USE_MUTUAL_EXCLUSION must be enabled.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @api
+ */
+void crcReleaseBus(CRCDriver *crcp) {
+
+  osalDbgCheck(crcp != NULL);
+
+  osalMutexUnlock(&crcp->mutex);
+}
+#endif /* CRC_USE_MUTUAL_EXCLUSION == TRUE */
+
+#endif /* HAL_USE_CRC == TRUE */
+
+/** @} */
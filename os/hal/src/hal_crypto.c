@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_CRY == TRUE) || defined(__DOXYGEN__)
@@ -42,6 +44,99 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_CRY_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Executes a job.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the @p cry_job_t object
+ * @return              The operation status.
+ */
+static cryerror_t cry_job_execute(CRYDriver *cryp, cry_job_t *jobp) {
+  const cry_segment_t *sp = jobp->segp;
+  uint8_t iv[16];
+  cryerror_t err;
+  size_t i;
+
+  switch (jobp->op) {
+  case cry_job_encrypt_aes_ecb:
+  case cry_job_decrypt_aes_ecb:
+    for (i = 0U; i < jobp->n; i++) {
+      if (jobp->op == cry_job_encrypt_aes_ecb) {
+        err = cryEncryptAES_ECB(cryp, jobp->key_id, sp[i].size,
+                                sp[i].in, sp[i].out);
+      }
+      else {
+        err = cryDecryptAES_ECB(cryp, jobp->key_id, sp[i].size,
+                                sp[i].in, sp[i].out);
+      }
+      if (err != CRY_NOERROR) {
+        return err;
+      }
+    }
+    return CRY_NOERROR;
+  case cry_job_encrypt_aes_cbc:
+  case cry_job_decrypt_aes_cbc:
+    /* Chaining across the entries, the next vector is the last cipher
+       text block.*/
+    memcpy(iv, jobp->iv, sizeof iv);
+    for (i = 0U; i < jobp->n; i++) {
+      uint8_t next[16];
+
+      osalDbgCheck(sp[i].size >= sizeof iv);
+
+      if (jobp->op == cry_job_encrypt_aes_cbc) {
+        err = cryEncryptAES_CBC(cryp, jobp->key_id, sp[i].size,
+                                sp[i].in, sp[i].out, iv);
+        memcpy(next, &sp[i].out[sp[i].size - sizeof iv], sizeof next);
+      }
+      else {
+        /* Saved before the operation, it could be in place.*/
+        memcpy(next, &sp[i].in[sp[i].size - sizeof iv], sizeof next);
+        err = cryDecryptAES_CBC(cryp, jobp->key_id, sp[i].size,
+                                sp[i].in, sp[i].out, iv);
+      }
+      if (err != CRY_NOERROR) {
+        return err;
+      }
+      memcpy(iv, next, sizeof iv);
+    }
+    return CRY_NOERROR;
+  case cry_job_encrypt_aes_ctr:
+    osalDbgCheck(jobp->n == 1U);
+    return cryEncryptAES_CTR(cryp, jobp->key_id, sp->size,
+                             sp->in, sp->out, jobp->iv);
+  case cry_job_decrypt_aes_ctr:
+    osalDbgCheck(jobp->n == 1U);
+    return cryDecryptAES_CTR(cryp, jobp->key_id, sp->size,
+                             sp->in, sp->out, jobp->iv);
+  case cry_job_encrypt_aes_gcm:
+    osalDbgCheck(jobp->n == 1U);
+    return cryEncryptAES_GCM(cryp, jobp->key_id,
+                             jobp->auth_size, jobp->auth_in,
+                             sp->size, sp->in, sp->out, jobp->iv,
+                             jobp->tag_size, jobp->tag);
+  case cry_job_decrypt_aes_gcm:
+    osalDbgCheck(jobp->n == 1U);
+    return cryDecryptAES_GCM(cryp, jobp->key_id,
+                             jobp->auth_size, jobp->auth_in,
+                             sp->size, sp->in, sp->out, jobp->iv,
+                             jobp->tag_size, jobp->tag);
+  case cry_job_sha256:
+    err = crySHA256Init(cryp, jobp->sha256ctxp);
+    for (i = 0U; (i < jobp->n) && (err == CRY_NOERROR); i++) {
+      err = crySHA256Update(cryp, jobp->sha256ctxp, sp[i].size, sp[i].in);
+    }
+    if (err != CRY_NOERROR) {
+      return err;
+    }
+    return crySHA256Final(cryp, jobp->sha256ctxp, jobp->digest);
+  default:
+    return CRY_ERR_INV_ALGO;
+  }
+}
+#endif /* HAL_CRY_USE_JOBS == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -147,7 +242,15 @@ cryerror_t cryLoadAESTransientKey(CRYDriver *cryp,
 
   osalDbgCheck((cryp != NULL) &&  (keyp != NULL));
 
-#if CRY_LLD_SUPPORTS_AES == TRUE
+#if (CRY_LLD_SUPPORTS_AES == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE) &&     \
+    (CRY_FALLBACK_NEEDS_AES == TRUE)
+  /* Some modes are served by the fallback, it needs the key too.*/
+  cryerror_t err = cry_lld_aes_loadkey(cryp, size, keyp);
+  if (err == CRY_NOERROR) {
+    err = cry_fallback_aes_loadkey(cryp, size, keyp);
+  }
+  return err;
+#elif CRY_LLD_SUPPORTS_AES == TRUE
   return cry_lld_aes_loadkey(cryp, size, keyp);
 #elif HAL_CRY_USE_FALLBACK == TRUE
   return cry_fallback_aes_loadkey(cryp, size, keyp);
@@ -1499,8 +1602,17 @@ cryerror_t cryLoadHMACTransientKey(CRYDriver *cryp,
 
   osalDbgCheck((cryp != NULL) &&  (keyp != NULL));
 
-#if (CRY_LLD_SUPPORTS_HMAC_SHA256 == TRUE) ||                               \
-    (CRY_LLD_SUPPORTS_HMAC_SHA512 == TRUE)
+#if ((CRY_LLD_SUPPORTS_HMAC_SHA256 == TRUE) ||                              \
+     (CRY_LLD_SUPPORTS_HMAC_SHA512 == TRUE)) &&                             \
+    (HAL_CRY_USE_FALLBACK == TRUE) && (CRY_FALLBACK_NEEDS_HMAC == TRUE)
+  /* One of the HMACs is served by the fallback, it needs the key too.*/
+  cryerror_t err = cry_lld_hmac_loadkey(cryp, size, keyp);
+  if (err == CRY_NOERROR) {
+    err = cry_fallback_hmac_loadkey(cryp, size, keyp);
+  }
+  return err;
+#elif (CRY_LLD_SUPPORTS_HMAC_SHA256 == TRUE) ||                             \
+      (CRY_LLD_SUPPORTS_HMAC_SHA512 == TRUE)
   return cry_lld_hmac_loadkey(cryp, size, keyp);
 #elif HAL_CRY_USE_FALLBACK == TRUE
   return cry_fallback_hmac_loadkey(cryp, size, keyp);
@@ -1731,6 +1843,215 @@ cryerror_t cryHMACSHA512Final(CRYDriver *cryp,
 #endif
 }
 
+/**
+ * @brief   Hashes a series of independent messages.
+ * @details Each entry is hashed as a complete message, the digests are
+ *          written in the output buffers of the entries. The processing
+ *          stops on the first failing entry, the entries before it are
+ *          complete.
+ * @note    HMAC algorithms use the transient HMAC key.
+ * @note    The messages are processed back to back so the hardware state
+ *          is never saved or restored between them.
+ *
+ * @param[in] cryp              pointer to the @p CRYDriver object
+ * @param[in] algo              hash algorithm
+ * @param[in] entries           array of entries
+ * @param[in] n                 number of entries
+ * @return                      The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_OP_FAILURE   if the operation failed, implementation
+ *                              dependent.
+ *
+ * @api
+ */
+cryerror_t cryHashBatch(CRYDriver *cryp,
+                        cryhashalgo_t algo,
+                        const cry_hash_entry_t *entries,
+                        size_t n) {
+  union {
+    SHA1Context             sha1;
+    SHA256Context           sha256;
+    SHA512Context           sha512;
+    HMACSHA256Context       hmacsha256;
+    HMACSHA512Context       hmacsha512;
+  } ctx;
+  cryerror_t err = CRY_NOERROR;
+  size_t i;
+
+  osalDbgCheck((cryp != NULL) && ((entries != NULL) || (n == 0U)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+  for (i = 0U; (i < n) && (err == CRY_NOERROR); i++) {
+    const cry_hash_entry_t *ep = &entries[i];
+
+    switch (algo) {
+    case cry_hash_sha1:
+      err = crySHA1Init(cryp, &ctx.sha1);
+      if (err == CRY_NOERROR) {
+        err = crySHA1Update(cryp, &ctx.sha1, ep->size, ep->in);
+      }
+      if (err == CRY_NOERROR) {
+        err = crySHA1Final(cryp, &ctx.sha1, ep->out);
+      }
+      break;
+    case cry_hash_sha256:
+      err = crySHA256Init(cryp, &ctx.sha256);
+      if (err == CRY_NOERROR) {
+        err = crySHA256Update(cryp, &ctx.sha256, ep->size, ep->in);
+      }
+      if (err == CRY_NOERROR) {
+        err = crySHA256Final(cryp, &ctx.sha256, ep->out);
+      }
+      break;
+    case cry_hash_sha512:
+      err = crySHA512Init(cryp, &ctx.sha512);
+      if (err == CRY_NOERROR) {
+        err = crySHA512Update(cryp, &ctx.sha512, ep->size, ep->in);
+      }
+      if (err == CRY_NOERROR) {
+        err = crySHA512Final(cryp, &ctx.sha512, ep->out);
+      }
+      break;
+    case cry_hash_hmac_sha256:
+      err = cryHMACSHA256Init(cryp, &ctx.hmacsha256);
+      if (err == CRY_NOERROR) {
+        err = cryHMACSHA256Update(cryp, &ctx.hmacsha256, ep->size, ep->in);
+      }
+      if (err == CRY_NOERROR) {
+        err = cryHMACSHA256Final(cryp, &ctx.hmacsha256, ep->out);
+      }
+      break;
+    case cry_hash_hmac_sha512:
+      err = cryHMACSHA512Init(cryp, &ctx.hmacsha512);
+      if (err == CRY_NOERROR) {
+        err = cryHMACSHA512Update(cryp, &ctx.hmacsha512, ep->size, ep->in);
+      }
+      if (err == CRY_NOERROR) {
+        err = cryHMACSHA512Final(cryp, &ctx.hmacsha512, ep->out);
+      }
+      break;
+    default:
+      err = CRY_ERR_INV_ALGO;
+      break;
+    }
+  }
+
+  return err;
+}
+
+#if (HAL_CRY_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a jobs queue.
+ *
+ * @param[out] jqp      pointer to the @p cry_jobs_queue_t object
+ * @param[in] cryp      pointer to the @p CRYDriver object executing the jobs
+ *
+ * @init
+ */
+void cryJobsObjectInit(cry_jobs_queue_t *jqp, CRYDriver *cryp) {
+
+  jqp->cryp   = cryp;
+  jqp->head   = NULL;
+  jqp->tail   = NULL;
+  jqp->server = NULL;
+}
+
+/**
+ * @brief   Submits a job.
+ * @details The job is appended to the queue and the service thread is
+ *          woken if waiting.
+ *
+ * @param[in] jqp       pointer to the @p cry_jobs_queue_t object
+ * @param[in] jobp      pointer to the @p cry_job_t object
+ *
+ * @iclass
+ */
+void cryJobSubmitI(cry_jobs_queue_t *jqp, cry_job_t *jobp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((jqp != NULL) && (jobp != NULL) &&
+               ((jobp->segp != NULL) || (jobp->n == 0U)));
+
+  jobp->next  = NULL;
+  jobp->error = CRY_NOERROR;
+  if (jqp->head == NULL) {
+    jqp->head = jobp;
+  }
+  else {
+    jqp->tail->next = jobp;
+  }
+  jqp->tail = jobp;
+
+  osalThreadResumeI(&jqp->server, MSG_OK);
+}
+
+/**
+ * @brief   Submits a job.
+ * @details The job is appended to the queue and the service thread is
+ *          woken if waiting.
+ *
+ * @param[in] jqp       pointer to the @p cry_jobs_queue_t object
+ * @param[in] jobp      pointer to the @p cry_job_t object
+ *
+ * @api
+ */
+void cryJobSubmit(cry_jobs_queue_t *jqp, cry_job_t *jobp) {
+
+  osalSysLock();
+  cryJobSubmitI(jqp, jobp);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Serves the next job.
+ * @details Waits for a job, executes it then invokes the completion
+ *          callback in the context of the calling thread.
+ * @note    This function is meant to be called in a loop by a service
+ *          thread created by the application, the jobs of a queue must
+ *          be served by a single thread.
+ *
+ * @param[in] jqp       pointer to the @p cry_jobs_queue_t object
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a job has been served.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+msg_t cryJobsServeTimeout(cry_jobs_queue_t *jqp, sysinterval_t timeout) {
+  cry_job_t *jobp;
+
+  osalDbgCheck(jqp != NULL);
+
+  osalSysLock();
+  while (jqp->head == NULL) {
+    msg_t msg = osalThreadSuspendTimeoutS(&jqp->server, timeout);
+    if (msg != MSG_OK) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+  jobp = jqp->head;
+  jqp->head = jobp->next;
+  osalSysUnlock();
+
+  jobp->error = cry_job_execute(jqp->cryp, jobp);
+  if (jobp->end_cb != NULL) {
+    jobp->end_cb(jqp->cryp, jobp);
+  }
+
+  return MSG_OK;
+}
+#endif /* HAL_CRY_USE_JOBS == TRUE */
+
 #endif /* HAL_USE_CRY == TRUE */
 
 /** @} */
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_DAC == TRUE) || defined(__DOXYGEN__)
@@ -42,6 +44,55 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Refills half of the samples buffer from the streaming queue.
+ * @details The samples of the next queued buffer are copied in the half
+ *          buffer, missing rows are filled holding the last row and
+ *          counted as an underrun.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] half      index of the half buffer to be refilled
+ *
+ * @notapi
+ */
+static void dac_stream_fill(DACDriver *dacp, unsigned half) {
+  size_t ch = (size_t)dacp->grpp->num_channels;
+  size_t n = ch * (dacp->depth / 2U);
+  dacsample_t *dp = dacp->samples + ((size_t)half * n);
+  size_t i = 0U;
+  uint8_t *bp;
+  size_t size;
+
+  bp = obqGetFullBufferI(dacp->obqp, &size);
+  if (bp != NULL) {
+    i = size / sizeof (dacsample_t);
+    if (i > n) {
+      i = n;
+    }
+    i -= i % ch;
+    memcpy((void *)dp, (const void *)bp, i * sizeof (dacsample_t));
+    obqReleaseEmptyBufferI(dacp->obqp);
+  }
+
+  if (i < n) {
+    /* Underrun, the previous row in the circular buffer is held.*/
+    const dacsample_t *rp = dacp->samples +
+                            (((size_t)half * n) + i + (2U * n) - ch) %
+                            (2U * n);
+    size_t j;
+
+    while (i < n) {
+      for (j = 0U; j < ch; j++) {
+        dp[i + j] = rp[j];
+      }
+      i += ch;
+    }
+    dacp->underruns++;
+  }
+}
+#endif /* DAC_USE_STREAMING == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -75,6 +126,10 @@ void dacObjectInit(DACDriver *dacp) {
 #if DAC_USE_MUTUAL_EXCLUSION
   osalMutexObjectInit(&dacp->mutex);
 #endif
+#if DAC_USE_STREAMING == TRUE
+  dacp->obqp = NULL;
+  dacp->underruns = 0U;
+#endif
 #if defined(DAC_DRIVER_EXT_INIT_HOOK)
   DAC_DRIVER_EXT_INIT_HOOK(dacp);
 #endif
@@ -208,6 +263,9 @@ void dacStartConversionI(DACDriver *dacp,
   dacp->samples  = samples;
   dacp->depth    = depth;
   dacp->grpp     = grpp;
+#if DAC_USE_STREAMING == TRUE
+  dacp->obqp     = NULL;
+#endif
   dacp->state    = DAC_ACTIVE;
   dac_lld_start_conversion(dacp);
 }
@@ -345,6 +403,106 @@ void dacReleaseBus(DACDriver *dacp) {
 }
 #endif /* DAC_USE_MUTUAL_EXCLUSION == TRUE */
 
+#if (DAC_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a DAC streaming conversion.
+ * @details Starts a circular conversion, each half of the samples buffer
+ *          is refilled from the buffers posted in the queue by a producer
+ *          thread as soon as the DAC consumed it.
+ * @note    The queue buffers should contain half the samples buffer,
+ *          larger buffers are truncated, smaller buffers are completed
+ *          holding the last row and counted as underruns.
+ * @note    The samples buffer is primed from the queue before starting,
+ *          the producer should post two buffers before calling this
+ *          function.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] grpp      pointer to a @p DACConversionGroup object
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @param[in] samples   pointer to the samples buffer
+ * @param[in] depth     buffer depth (matrix rows number), it must be an
+ *                      even number
+ *
+ * @api
+ */
+void dacStartStreaming(DACDriver *dacp,
+                       const DACConversionGroup *grpp,
+                       output_buffers_queue_t *obqp,
+                       dacsample_t *samples,
+                       size_t depth) {
+
+  osalSysLock();
+  dacStartStreamingI(dacp, grpp, obqp, samples, depth);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts a DAC streaming conversion.
+ * @details Starts a circular conversion, each half of the samples buffer
+ *          is refilled from the buffers posted in the queue by a producer
+ *          thread as soon as the DAC consumed it.
+ * @note    The queue buffers should contain half the samples buffer,
+ *          larger buffers are truncated, smaller buffers are completed
+ *          holding the last row and counted as underruns.
+ * @note    The samples buffer is primed from the queue before starting,
+ *          the producer should post two buffers before calling this
+ *          function.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] grpp      pointer to a @p DACConversionGroup object
+ * @param[in] obqp      pointer to the @p output_buffers_queue_t object
+ * @param[in] samples   pointer to the samples buffer
+ * @param[in] depth     buffer depth (matrix rows number), it must be an
+ *                      even number
+ *
+ * @iclass
+ */
+void dacStartStreamingI(DACDriver *dacp,
+                        const DACConversionGroup *grpp,
+                        output_buffers_queue_t *obqp,
+                        dacsample_t *samples,
+                        size_t depth) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((dacp != NULL) && (grpp != NULL) && (obqp != NULL) &&
+               (samples != NULL) && (depth >= 2U) && ((depth & 1U) == 0U));
+  osalDbgAssert((dacp->state == DAC_READY) ||
+                (dacp->state == DAC_COMPLETE) ||
+                (dacp->state == DAC_ERROR),
+                "not ready");
+
+  dacp->samples  = samples;
+  dacp->depth    = depth;
+  dacp->grpp     = grpp;
+  dacp->obqp     = obqp;
+
+  /* Priming both halves, missing samples are not counted as underruns.*/
+  dac_stream_fill(dacp, 0U);
+  dac_stream_fill(dacp, 1U);
+  dacp->underruns = 0U;
+
+  dacp->state    = DAC_ACTIVE;
+  dac_lld_start_conversion(dacp);
+}
+
+/**
+ * @brief   Refills a consumed half buffer from the streaming queue.
+ * @note    This function is meant to be used in the low level drivers
+ *          implementation only, through the common ISR code.
+ *
+ * @param[in] dacp      pointer to the @p DACDriver object
+ * @param[in] half      index of the consumed half buffer
+ *
+ * @notapi
+ */
+void _dac_isr_stream_refill(DACDriver *dacp, unsigned half) {
+
+  osalSysLockFromISR();
+  dac_stream_fill(dacp, half);
+  osalSysUnlockFromISR();
+}
+#endif /* DAC_USE_STREAMING == TRUE */
+
 #endif /* HAL_USE_DAC == TRUE */
 
 /** @} */
@@ -0,0 +1,231 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_dcmi.c
+ * @brief   DCMI Driver code.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   DCMI Driver initialization.
+ * @note    This function is implicitly invoked by @p halInit(), there is
+ *          no need to explicitly initialize the driver.
+ *
+ * @init
+ */
+void dcmiInit(void) {
+
+  dcmi_lld_init();
+}
+
+/**
+ * @brief   Initializes the standard part of a @p DCMIDriver structure.
+ *
+ * @param[out] dcmip    pointer to the @p DCMIDriver object
+ *
+ * @init
+ */
+void dcmiObjectInit(DCMIDriver *dcmip) {
+
+  dcmip->state   = DCMI_STOP;
+  dcmip->config  = NULL;
+  dcmip->fifo    = NULL;
+  dcmip->thread  = NULL;
+  dcmip->frames  = 0U;
+  dcmip->dropped = 0U;
+  dcmip->errors  = 0U;
+#if defined(DCMI_DRIVER_EXT_INIT_HOOK)
+  DCMI_DRIVER_EXT_INIT_HOOK(dcmip);
+#endif
+}
+
+/**
+ * @brief   Configures and activates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] config    pointer to the @p DCMIConfig object
+ *
+ * @api
+ */
+void dcmiStart(DCMIDriver *dcmip, const DCMIConfig *config) {
+
+  osalDbgCheck((dcmip != NULL) && (config != NULL) &&
+               (config->frame_size > 0U));
+
+  osalSysLock();
+  osalDbgAssert((dcmip->state == DCMI_STOP) || (dcmip->state == DCMI_READY),
+                "invalid state");
+  dcmip->config = config;
+  dcmi_lld_start(dcmip);
+  dcmip->state = DCMI_READY;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Deactivates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @api
+ */
+void dcmiStop(DCMIDriver *dcmip) {
+
+  osalDbgCheck(dcmip != NULL);
+
+  osalSysLock();
+  osalDbgAssert((dcmip->state == DCMI_STOP) || (dcmip->state == DCMI_READY),
+                "invalid state");
+  dcmi_lld_stop(dcmip);
+  dcmip->config = NULL;
+  dcmip->state  = DCMI_STOP;
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts a continuous capture.
+ * @details Frames are captured in buffers taken from the free objects of
+ *          the FIFO, each captured frame is posted in the FIFO. The
+ *          application receives the frames and returns the buffers when
+ *          done, if no free buffer is available when a new frame starts
+ *          then the frame in progress is dropped and its buffer reused.
+ * @note    The objects size must be at least the configured frame size,
+ *          the buffers must be aligned to the cache line size where a
+ *          data cache is present.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] ofp       pointer to the frames FIFO
+ * @return              The operation status.
+ * @retval MSG_OK       if the capture has been started.
+ * @retval MSG_RESET    if there is no free buffer in the FIFO.
+ *
+ * @api
+ */
+msg_t dcmiStartCapture(DCMIDriver *dcmip, objects_fifo_t *ofp) {
+  void *frame;
+
+  osalDbgCheck((dcmip != NULL) && (ofp != NULL));
+
+  osalSysLock();
+  osalDbgAssert(dcmip->state == DCMI_READY, "not ready");
+  osalDbgAssert(ofp->free.pool.object_size >= dcmip->config->frame_size,
+                "objects too small");
+
+  frame = chFifoTakeObjectI(ofp);
+  if (frame == NULL) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+
+  dcmip->fifo  = ofp;
+  dcmip->state = DCMI_ACTIVE;
+  dcmi_lld_start_capture(dcmip, frame);
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Stops a continuous capture.
+ * @details The frame in progress is discarded, the frames already posted
+ *          in the FIFO remain available to the application.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @api
+ */
+void dcmiStopCapture(DCMIDriver *dcmip) {
+
+  osalDbgCheck(dcmip != NULL);
+
+  osalSysLock();
+  osalDbgAssert((dcmip->state == DCMI_READY) ||
+                (dcmip->state == DCMI_ACTIVE), "invalid state");
+  if (dcmip->state == DCMI_ACTIVE) {
+    dcmi_lld_stop_capture(dcmip);
+    dcmip->state = DCMI_READY;
+  }
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Captures a single frame.
+ * @note    The buffer must be at least as large as the configured frame
+ *          size and aligned to the cache line size where a data cache is
+ *          present.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[out] buf      pointer to the frame buffer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if the frame has been captured.
+ * @retval MSG_TIMEOUT  if the frame has not been captured in time.
+ * @retval MSG_RESET    if a capture error occurred.
+ *
+ * @api
+ */
+msg_t dcmiSnapshot(DCMIDriver *dcmip, void *buf, sysinterval_t timeout) {
+  msg_t msg;
+
+  osalDbgCheck((dcmip != NULL) && (buf != NULL));
+
+  osalSysLock();
+  osalDbgAssert(dcmip->state == DCMI_READY, "not ready");
+
+  dcmip->state = DCMI_SNAPSHOT;
+  dcmi_lld_start_capture(dcmip, buf);
+  msg = osalThreadSuspendTimeoutS(&dcmip->thread, timeout);
+  if (msg == MSG_TIMEOUT) {
+    dcmi_lld_stop_capture(dcmip);
+    dcmip->state = DCMI_READY;
+  }
+  osalSysUnlock();
+
+  return msg;
+}
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+/** @} */
@@ -42,6 +42,22 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Erase suspend and resume are not supported by embedded flashes.
+ *
+ * @param[in] instance  instance pointer
+ * @return              An error code.
+ * @retval FLASH_ERROR_UNIMPLEMENTED always.
+ *
+ * @notapi
+ */
+static flash_error_t efl_suspend_resume_erase(void *instance) {
+
+  (void)instance;
+
+  return FLASH_ERROR_UNIMPLEMENTED;
+}
+
 static const struct EFlashDriverVMT vmt = {
   (size_t)0,
   efl_lld_get_descriptor,
@@ -50,7 +66,9 @@ static const struct EFlashDriverVMT vmt = {
   efl_lld_start_erase_all,
   efl_lld_start_erase_sector,
   efl_lld_query_erase,
-  efl_lld_verify_erase
+  efl_lld_verify_erase,
+  efl_suspend_resume_erase,
+  efl_suspend_resume_erase
 };
 
 /*===========================================================================*/
@@ -129,6 +147,164 @@ void eflStop(EFlashDriver *eflp) {
   osalSysUnlock();
 }
 
+/**
+ * @brief   Returns the number of active flash banks.
+ * @note    Devices whose LLD does not describe banks are handled as a
+ *          single bank.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @return              The number of banks.
+ *
+ * @api
+ */
+uint32_t eflGetBanksNumber(EFlashDriver *eflp) {
+
+  osalDbgCheck(eflp != NULL);
+
+#if EFL_LLD_SUPPORTS_BANKS == TRUE
+  return efl_lld_get_banks(eflp);
+#else
+  return 1U;
+#endif
+}
+
+/**
+ * @brief   Returns the bank containing a sector.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @param[in] sector    sector index
+ * @return              The bank index.
+ *
+ * @api
+ */
+uint32_t eflGetSectorBank(EFlashDriver *eflp, flash_sector_t sector) {
+
+  osalDbgCheck(eflp != NULL);
+  osalDbgCheck(sector < flashGetDescriptor(eflp)->sectors_count);
+
+#if EFL_LLD_SUPPORTS_BANKS == TRUE
+  return efl_lld_get_sector_bank(eflp, sector);
+#else
+  (void)sector;
+
+  return 0U;
+#endif
+}
+
+/**
+ * @brief   Returns the bank containing a memory address.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @param[in] addr      memory address
+ * @return              The bank index.
+ * @retval EFL_NO_BANK  if the address is not mapped on the flash.
+ *
+ * @api
+ */
+uint32_t eflGetAddressBank(EFlashDriver *eflp, const void *addr) {
+  const flash_descriptor_t *dp;
+  flash_offset_t offset;
+  flash_sector_t sector;
+
+  osalDbgCheck(eflp != NULL);
+
+  dp = flashGetDescriptor(eflp);
+  if (((const uint8_t *)addr < dp->address) ||
+      ((const uint8_t *)addr >= dp->address + dp->size)) {
+    return EFL_NO_BANK;
+  }
+  offset = (flash_offset_t)((const uint8_t *)addr - dp->address);
+
+  if (dp->sectors == NULL) {
+    sector = (flash_sector_t)(offset / dp->sectors_size);
+  }
+  else {
+    sector = 0U;
+    while ((sector < dp->sectors_count - 1U) &&
+           (offset >= dp->sectors[sector].offset + dp->sectors[sector].size)) {
+      sector++;
+    }
+  }
+
+  return eflGetSectorBank(eflp, sector);
+}
+
+/**
+ * @brief   Returns the bank the firmware is executing from.
+ * @details The bank is the one containing the code of this driver, the
+ *          firmware image is assumed to not span across banks.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @return              The bank index.
+ * @retval EFL_NO_BANK  if the code is not executed from the flash.
+ *
+ * @api
+ */
+uint32_t eflGetExecutionBank(EFlashDriver *eflp) {
+
+  return eflGetAddressBank(eflp, (const void *)(uint32_t)eflGetExecutionBank);
+}
+
+/**
+ * @brief   Checks if a sector can be modified without stalling execution.
+ * @details Program and erase operations on a bank stall any access to the
+ *          same bank, operations on a bank other than the execution bank
+ *          run concurrently with the CPU (read-while-write).
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @param[in] sector    sector index
+ * @return              The check result.
+ * @retval false        if operations on the sector stall the CPU.
+ * @retval true         if operations on the sector run concurrently.
+ *
+ * @api
+ */
+bool eflIsSectorConcurrent(EFlashDriver *eflp, flash_sector_t sector) {
+  uint32_t bank = eflGetExecutionBank(eflp);
+
+  return (bool)((bank == EFL_NO_BANK) ||
+                (bank != eflGetSectorBank(eflp, sector)));
+}
+
+/**
+ * @brief   Returns the sectors that can be modified without stalling
+ *          execution.
+ * @details The first contiguous range of sectors outside the execution
+ *          bank is returned, it is the recommended placement for data
+ *          written at runtime, for example the MFS banks.
+ *
+ * @param[in] eflp      pointer to a @p EFlashDriver structure
+ * @param[out] firstp   pointer to the first sector of the range
+ * @param[out] np       pointer to the number of sectors in the range
+ * @return              The operation status.
+ * @retval false        if a range has been found.
+ * @retval true         if all sectors are in the execution bank.
+ *
+ * @api
+ */
+bool eflGetConcurrentSectors(EFlashDriver *eflp,
+                             flash_sector_t *firstp,
+                             flash_sector_t *np) {
+  flash_sector_t sector, count;
+
+  osalDbgCheck((eflp != NULL) && (firstp != NULL) && (np != NULL));
+
+  count = flashGetDescriptor(eflp)->sectors_count;
+  for (sector = 0U; sector < count; sector++) {
+    if (eflIsSectorConcurrent(eflp, sector)) {
+      *firstp = sector;
+      do {
+        sector++;
+      } while ((sector < count) && eflIsSectorConcurrent(eflp, sector));
+      *np = sector - *firstp;
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
 #endif /* HAL_USE_EFL == TRUE */
 
 /** @} */
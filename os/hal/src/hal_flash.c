@@ -48,6 +48,7 @@
 
 /**
  * @brief   Waits until the current erase operation is finished.
+ * @note    A suspended erase operation must be resumed before waiting.
  *
  * @param[in] devp      pointer to a @p BaseFlash object
  *
@@ -45,6 +45,31 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the next queued request, if any.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+static void i2c_queue_next(I2CDriver *i2cp) {
+  i2c_request_t *reqp = i2cp->qhead;
+
+  i2cp->qcurr = reqp;
+  if (reqp != NULL) {
+    i2cp->qhead  = reqp->next;
+    i2cp->segp   = reqp->segp;
+    i2cp->segn   = reqp->n;
+    i2cp->errors = I2C_NO_ERROR;
+    i2c_lld_start_segment(i2cp, reqp->segp);
+  }
+  else {
+    i2cp->segp = NULL;
+  }
+}
+#endif /* I2C_USE_QUEUE == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -77,6 +102,13 @@ void i2cObjectInit(I2CDriver *i2cp) {
   osalMutexObjectInit(&i2cp->mutex);
 #endif
 
+#if I2C_USE_QUEUE == TRUE
+  i2cp->qhead = NULL;
+  i2cp->qcurr = NULL;
+  i2cp->segp  = NULL;
+  i2cp->segn  = 0U;
+#endif
+
 #if defined(I2C_DRIVER_EXT_INIT_HOOK)
   I2C_DRIVER_EXT_INIT_HOOK(i2cp);
 #endif
@@ -246,6 +278,153 @@ msg_t i2cMasterReceiveTimeout(I2CDriver *i2cp,
   return rdymsg;
 }
 
+#if (I2C_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Queues a request.
+ * @details The request is inserted in the queue in priority order, FIFO
+ *          among requests of equal priority. If the bus is idle then the
+ *          request is started immediately else it is started from the
+ *          completion interrupt of the previous request, back to back and
+ *          without thread involvement.
+ * @pre     The driver must not be busy with operations started using the
+ *          synchronous APIs.
+ * @post    At the end of the request its callback is invoked, if any.
+ * @note    The request and its segments must remain valid until the
+ *          request completes.
+ * @note    The bus busy condition is not checked before starting a
+ *          request, queued requests are not meant for multi-master buses.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] reqp      pointer to the @p i2c_request_t object
+ *
+ * @iclass
+ */
+void i2cQueueRequestI(I2CDriver *i2cp, i2c_request_t *reqp) {
+  i2c_request_t **pp;
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck((i2cp != NULL) && (reqp != NULL) &&
+               (reqp->segp != NULL) && (reqp->n > 0U));
+  osalDbgAssert((i2cp->state == I2C_READY) || (i2cp->qcurr != NULL),
+                "not ready");
+
+  reqp->errors = I2C_NO_ERROR;
+  reqp->thread = NULL;
+
+  /* Priority ordered insertion.*/
+  pp = &i2cp->qhead;
+  while ((*pp != NULL) && ((*pp)->prio >= reqp->prio)) {
+    pp = &(*pp)->next;
+  }
+  reqp->next = *pp;
+  *pp = reqp;
+
+  if (i2cp->qcurr == NULL) {
+    i2c_queue_next(i2cp);
+  }
+}
+
+/**
+ * @brief   Queues a request.
+ * @details The request is inserted in the queue in priority order, FIFO
+ *          among requests of equal priority.
+ * @pre     The driver must not be busy with operations started using the
+ *          synchronous APIs.
+ * @post    At the end of the request its callback is invoked, if any.
+ * @note    The request and its segments must remain valid until the
+ *          request completes.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] reqp      pointer to the @p i2c_request_t object
+ *
+ * @api
+ */
+void i2cQueueRequest(I2CDriver *i2cp, i2c_request_t *reqp) {
+
+  osalSysLock();
+  i2cQueueRequestI(i2cp, reqp);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Queues a request and waits for its completion.
+ * @pre     The driver must not be busy with operations started using the
+ *          synchronous APIs.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @param[in] reqp      pointer to the @p i2c_request_t object
+ * @return              The operation status.
+ * @retval MSG_OK       if the request succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors are
+ *                      stored in the request @p errors field.
+ *
+ * @api
+ */
+msg_t i2cRequest(I2CDriver *i2cp, i2c_request_t *reqp) {
+  msg_t msg;
+
+  osalSysLock();
+  i2cQueueRequestI(i2cp, reqp);
+  msg = osalThreadSuspendS(&reqp->thread);
+  osalSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Advances the current request to its next segment, if any.
+ * @details The next segment is started with a repeated start.
+ * @note    This function is meant to be used by the low level driver on
+ *          the completion of a segment.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ * @return              The segments state.
+ * @retval false        if the completed segment was the last one.
+ * @retval true         if the next segment has been started.
+ *
+ * @notapi
+ */
+bool _i2c_isr_next_segment(I2CDriver *i2cp) {
+
+  if (--i2cp->segn > 0U) {
+    i2cp->segp++;
+    i2c_lld_start_segment(i2cp, i2cp->segp);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Completes the current request and starts the next one.
+ * @note    This function is meant to be used by the low level driver
+ *          after the STOP condition of a request or after an error, the
+ *          driver state must be @p I2C_READY.
+ *
+ * @param[in] i2cp      pointer to the @p I2CDriver object
+ *
+ * @notapi
+ */
+void _i2c_isr_end_request(I2CDriver *i2cp) {
+  i2c_request_t *reqp = i2cp->qcurr;
+
+  osalSysLockFromISR();
+  reqp->errors = i2cp->errors;
+
+  /* Starting the next request first in order to minimize the bus idle
+     time.*/
+  i2c_queue_next(i2cp);
+  osalThreadResumeI(&reqp->thread,
+                    reqp->errors == I2C_NO_ERROR ? MSG_OK : MSG_RESET);
+  osalSysUnlockFromISR();
+
+  if (reqp->end_cb != NULL) {
+    reqp->end_cb(i2cp, reqp);
+  }
+}
+#endif /* I2C_USE_QUEUE == TRUE */
+
 #if (I2C_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Gains exclusive access to the I2C bus.
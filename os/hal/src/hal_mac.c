@@ -34,6 +34,11 @@
 #error "MAC_USE_ZERO_COPY not supported by this implementation"
 #endif
 
+#if (MAC_USE_PTP == TRUE) &&                                                \
+    (!defined(MAC_SUPPORTS_PTP) || (MAC_SUPPORTS_PTP == FALSE))
+#error "MAC_USE_PTP not supported by this implementation"
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -225,6 +230,58 @@ msg_t macWaitReceiveDescriptor(MACDriver *macp,
   return msg;
 }
 
+/**
+ * @brief   Waits for received frames.
+ * @details Stops until a frame is received then returns the descriptors of
+ *          all the buffered frames, up to @p n, in a single operation.
+ *          If a frame is not immediately available then the invoking
+ *          thread is queued until one is received.
+ * @note    Each returned descriptor must be released using
+ *          @p macReleaseReceiveDescriptor().
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] rdp      pointer to an array of @p n @p MACReceiveDescriptor
+ *                      structures
+ * @param[in] n         size of the descriptors array
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of descriptors obtained, zero if the
+ *                      operation timed out.
+ *
+ * @api
+ */
+size_t macWaitReceiveDescriptors(MACDriver *macp,
+                                 MACReceiveDescriptor *rdp,
+                                 size_t n,
+                                 sysinterval_t timeout) {
+  size_t i;
+
+  osalDbgCheck((macp != NULL) && (rdp != NULL) && (n > 0U));
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  osalSysLock();
+
+  while (mac_lld_get_receive_descriptor(macp, &rdp[0]) != MSG_OK) {
+    if (osalThreadEnqueueTimeoutS(&macp->rdqueue, timeout) == MSG_TIMEOUT) {
+      osalSysUnlock();
+      return 0U;
+    }
+  }
+
+  /* Collecting the other frames already buffered.*/
+  i = 1U;
+  while ((i < n) && (mac_lld_get_receive_descriptor(macp, &rdp[i]) == MSG_OK)) {
+    i++;
+  }
+
+  osalSysUnlock();
+
+  return i;
+}
+
 /**
  * @brief   Releases a receive descriptor.
  * @details The descriptor and its buffer are made available for more incoming
@@ -259,6 +316,80 @@ bool macPollLinkStatus(MACDriver *macp) {
   return mac_lld_poll_link_status(macp);
 }
 
+#if (MAC_USE_PTP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the current PTP clock time.
+ * @note    The PTP clock is started from zero by @p macStart().
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[out] tp       pointer to the time value
+ *
+ * @xclass
+ */
+void macPTPGetTimeX(MACDriver *macp, mac_ptp_time_t *tp) {
+
+  osalDbgCheck((macp != NULL) && (tp != NULL));
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  mac_lld_ptp_get_time(macp, tp);
+}
+
+/**
+ * @brief   Sets the PTP clock time.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] tp        pointer to the new time value
+ *
+ * @api
+ */
+void macPTPSetTime(MACDriver *macp, const mac_ptp_time_t *tp) {
+
+  osalDbgCheck((macp != NULL) && (tp != NULL) &&
+               (tp->nsec < 1000000000U));
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  mac_lld_ptp_set_time(macp, tp);
+}
+
+/**
+ * @brief   Steps the PTP clock time.
+ * @details The offset is added atomically by the hardware, there is no
+ *          read-modify-write window.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] offset    signed offset in nanoseconds
+ *
+ * @api
+ */
+void macPTPAdjustTime(MACDriver *macp, int64_t offset) {
+
+  osalDbgCheck(macp != NULL);
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  mac_lld_ptp_adjust_time(macp, offset);
+}
+
+/**
+ * @brief   Adjusts the PTP clock rate.
+ * @details The correction is relative to the nominal rate, it is not
+ *          cumulative with previous calls.
+ *
+ * @param[in] macp      pointer to the @p MACDriver object
+ * @param[in] ppb       rate correction in parts per billion, the range
+ *                      is -100000000..100000000
+ *
+ * @api
+ */
+void macPTPAdjustRate(MACDriver *macp, int32_t ppb) {
+
+  osalDbgCheck((macp != NULL) &&
+               (ppb >= -100000000) && (ppb <= 100000000));
+  osalDbgAssert(macp->state == MAC_ACTIVE, "not active");
+
+  mac_lld_ptp_adjust_rate(macp, ppb);
+}
+#endif /* MAC_USE_PTP == TRUE */
+
 #endif /* HAL_USE_MAC == TRUE */
 
 /** @} */
@@ -164,18 +164,20 @@ static uint8_t crc7(uint8_t crc, const uint8_t *buffer, size_t len) {
  */
 static void wait(MMCDriver *mmcp) {
   int i;
-  uint8_t buf[4];
+  uint8_t buf[MMC_POLL_SIZE];
 
+  /* Polling multiple bytes per transaction, the card is idle when the
+     last one is 0xFF.*/
   for (i = 0; i < 16; i++) {
-    spiReceive(mmcp->config->spip, 1, buf);
-    if (buf[0] == 0xFFU) {
+    spiReceive(mmcp->config->spip, MMC_POLL_SIZE, buf);
+    if (buf[MMC_POLL_SIZE - 1U] == 0xFFU) {
       return;
     }
   }
   /* Looks like it is a long wait.*/
   while (true) {
-    spiReceive(mmcp->config->spip, 1, buf);
-    if (buf[0] == 0xFFU) {
+    spiReceive(mmcp->config->spip, MMC_POLL_SIZE, buf);
+    if (buf[MMC_POLL_SIZE - 1U] == 0xFFU) {
       break;
     }
 #if MMC_NICE_WAITING == TRUE
@@ -345,6 +347,61 @@ static bool read_CxD(MMCDriver *mmcp, uint8_t cmd, uint32_t cxd[4]) {
   return HAL_FAILED;
 }
 
+/**
+ * @brief   Receives a data block within a sequential read.
+ * @details The data token is polled @p MMC_POLL_SIZE bytes at time, bytes
+ *          following the token are already part of the block. The block
+ *          CRC is received together with the first polling bytes of the
+ *          next block so that each block requires a single polling
+ *          transaction when the card is fast enough.
+ *
+ * @param[in] mmcp      pointer to the @p MMCDriver object
+ * @param[out] buffer   pointer to the read buffer
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  the operation succeeded.
+ * @retval HAL_FAILED   the operation failed.
+ *
+ * @notapi
+ */
+static bool read_block(MMCDriver *mmcp, uint8_t *buffer) {
+  SPIDriver *spip = mmcp->config->spip;
+  unsigned polled = 0U;
+
+  while (true) {
+    while (mmcp->lapos < mmcp->lacnt) {
+      uint8_t b = mmcp->lookahead[mmcp->lapos];
+
+      mmcp->lapos++;
+      if (b == 0xFEU) {
+        size_t n = mmcp->lacnt - mmcp->lapos;
+
+        /* Data token found, the remaining bytes are data.*/
+        memcpy(buffer, &mmcp->lookahead[mmcp->lapos], n);
+        spiReceive(spip, MMCSD_BLOCK_SIZE - n, buffer + n);
+
+        /* CRC ignored, polling ahead for the next token.*/
+        spiReceive(spip, sizeof mmcp->lookahead, mmcp->lookahead);
+        mmcp->lapos = 2U;
+        mmcp->lacnt = sizeof mmcp->lookahead;
+        return HAL_SUCCESS;
+      }
+      if (b != 0xFFU) {
+        /* Error token.*/
+        return HAL_FAILED;
+      }
+    }
+
+    if (polled >= MMC_WAIT_DATA) {
+      return HAL_FAILED;
+    }
+    spiReceive(spip, MMC_POLL_SIZE, mmcp->lookahead);
+    mmcp->lapos = 0U;
+    mmcp->lacnt = MMC_POLL_SIZE;
+    polled += MMC_POLL_SIZE;
+  }
+}
+
 /**
  * @brief   Waits that the card reaches an idle state.
  *
@@ -397,6 +454,8 @@ void mmcObjectInit(MMCDriver *mmcp) {
   mmcp->state = BLK_STOP;
   mmcp->config = NULL;
   mmcp->block_addresses = false;
+  mmcp->lapos = 0U;
+  mmcp->lacnt = 0U;
 }
 
 /**
@@ -628,6 +687,8 @@ bool mmcStartSequentialRead(MMCDriver *mmcp, uint32_t startblk) {
   else {
     send_hdr(mmcp, MMCSD_CMD_READ_MULTIPLE_BLOCK, startblk * MMCSD_BLOCK_SIZE);
   }
+  mmcp->lapos = 0U;
+  mmcp->lacnt = 0U;
 
   if (recvr1(mmcp) != 0x00U) {
     spiStop(mmcp->config->spip);
@@ -650,7 +711,6 @@ bool mmcStartSequentialRead(MMCDriver *mmcp, uint32_t startblk) {
  * @api
  */
 bool mmcSequentialRead(MMCDriver *mmcp, uint8_t *buffer) {
-  unsigned i;
 
   osalDbgCheck((mmcp != NULL) && (buffer != NULL));
 
@@ -658,16 +718,11 @@ bool mmcSequentialRead(MMCDriver *mmcp, uint8_t *buffer) {
     return HAL_FAILED;
   }
 
-  for (i = 0; i < MMC_WAIT_DATA; i++) {
-    spiReceive(mmcp->config->spip, 1, buffer);
-    if (buffer[0] == 0xFEU) {
-      spiReceive(mmcp->config->spip, MMCSD_BLOCK_SIZE, buffer);
-      /* CRC ignored. */
-      spiIgnore(mmcp->config->spip, 2);
-      return HAL_SUCCESS;
-    }
+  if (read_block(mmcp, buffer) == HAL_SUCCESS) {
+    return HAL_SUCCESS;
   }
-  /* Timeout.*/
+
+  /* Timeout or error token.*/
   spiUnselect(mmcp->config->spip);
   spiStop(mmcp->config->spip);
   mmcp->state = BLK_READY;
@@ -759,7 +814,7 @@ bool mmcStartSequentialWrite(MMCDriver *mmcp, uint32_t startblk) {
  */
 bool mmcSequentialWrite(MMCDriver *mmcp, const uint8_t *buffer) {
   static const uint8_t start[] = {0xFF, 0xFC};
-  uint8_t b[1];
+  uint8_t b[3];
 
   osalDbgCheck((mmcp != NULL) && (buffer != NULL));
 
@@ -769,9 +824,9 @@ bool mmcSequentialWrite(MMCDriver *mmcp, const uint8_t *buffer) {
 
   spiSend(mmcp->config->spip, sizeof(start), start);    /* Data prologue.   */
   spiSend(mmcp->config->spip, MMCSD_BLOCK_SIZE, buffer);/* Data.            */
-  spiIgnore(mmcp->config->spip, 2);                     /* CRC ignored.     */
-  spiReceive(mmcp->config->spip, 1, b);
-  if ((b[0] & 0x1FU) == 0x05U) {
+  spiReceive(mmcp->config->spip, 3, b);                 /* CRC ignored and  */
+                                                        /* data response.   */
+  if ((b[2] & 0x1FU) == 0x05U) {
     wait(mmcp);
     return HAL_SUCCESS;
   }
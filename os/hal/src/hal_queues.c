@@ -139,6 +139,104 @@ static size_t oq_write(output_queue_t *oqp, const uint8_t *bp, size_t n) {
   return n;
 }
 
+/**
+ * @brief   Non-blocking input queue write.
+ * @details The function writes data from a buffer to the low end of an
+ *          input queue. The operation completes when the specified amount
+ *          of data has been transferred or when the input queue has been
+ *          filled.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t iq_write(input_queue_t *iqp, const uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  osalDbgCheck(n > 0U);
+
+  /* Number of bytes that can be written in a single atomic operation.*/
+  if (n > iqGetEmptyI(iqp)) {
+    n = iqGetEmptyI(iqp);
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(iqp->q_top - iqp->q_wrptr);
+  /*lint -restore*/
+  if (n < s1) {
+    memcpy((void *)iqp->q_wrptr, (const void *)bp, n);
+    iqp->q_wrptr += n;
+  }
+  else if (n > s1) {
+    memcpy((void *)iqp->q_wrptr, (const void *)bp, s1);
+    bp += s1;
+    s2 = n - s1;
+    memcpy((void *)iqp->q_buffer, (const void *)bp, s2);
+    iqp->q_wrptr = iqp->q_buffer + s2;
+  }
+  else {
+    memcpy((void *)iqp->q_wrptr, (const void *)bp, n);
+    iqp->q_wrptr = iqp->q_buffer;
+  }
+
+  iqp->q_counter += n;
+  return n;
+}
+
+/**
+ * @brief   Non-blocking output queue read.
+ * @details The function reads data from the low end of an output queue
+ *          into a buffer. The operation completes when the specified amount
+ *          of data has been transferred or when the output queue has been
+ *          emptied.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t oq_read(output_queue_t *oqp, uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  osalDbgCheck(n > 0U);
+
+  /* Number of bytes that can be read in a single atomic operation.*/
+  if (n > oqGetFullI(oqp)) {
+    n = oqGetFullI(oqp);
+  }
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(oqp->q_top - oqp->q_rdptr);
+  /*lint -restore*/
+  if (n < s1) {
+    memcpy((void *)bp, (void *)oqp->q_rdptr, n);
+    oqp->q_rdptr += n;
+  }
+  else if (n > s1) {
+    memcpy((void *)bp, (void *)oqp->q_rdptr, s1);
+    bp += s1;
+    s2 = n - s1;
+    memcpy((void *)bp, (void *)oqp->q_buffer, s2);
+    oqp->q_rdptr = oqp->q_buffer + s2;
+  }
+  else {
+    memcpy((void *)bp, (void *)oqp->q_rdptr, n);
+    oqp->q_rdptr = oqp->q_buffer;
+  }
+
+  oqp->q_counter += n;
+  return n;
+}
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -241,6 +339,38 @@ msg_t iqPutI(input_queue_t *iqp, uint8_t b) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Input queue bulk write.
+ * @details The function writes data from a buffer to the low end of an
+ *          input queue. The operation completes immediately, the data that
+ *          does not fit in the queue is discarded.
+ * @note    The waiting threads are woken up once for the whole block, this
+ *          function is meant for interrupt handlers receiving data in
+ *          blocks, for example from a FIFO or by DMA.
+ *
+ * @param[in] iqp       pointer to an @p input_queue_t structure
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @iclass
+ */
+size_t iqWriteI(input_queue_t *iqp, const uint8_t *bp, size_t n) {
+  size_t wr;
+
+  osalDbgCheckClassI();
+
+  wr = iq_write(iqp, bp, n);
+
+  /* Waking up the readers if some data has been written.*/
+  if (wr > (size_t)0) {
+    osalThreadDequeueAllI(&iqp->q_waiting, MSG_OK);
+  }
+
+  return wr;
+}
+
 /**
  * @brief   Input queue non-blocking read.
  * @details This function reads a byte value from an input queue. The
@@ -600,6 +730,37 @@ msg_t oqGetI(output_queue_t *oqp) {
   return MSG_TIMEOUT;
 }
 
+/**
+ * @brief   Output queue bulk read.
+ * @details The function reads data from the low end of an output queue
+ *          into a buffer. The operation completes immediately.
+ * @note    The waiting threads are woken up once for the whole block, this
+ *          function is meant for interrupt handlers transmitting data in
+ *          blocks, for example into a FIFO or by DMA.
+ *
+ * @param[in] oqp       pointer to an @p output_queue_t structure
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @iclass
+ */
+size_t oqReadI(output_queue_t *oqp, uint8_t *bp, size_t n) {
+  size_t rd;
+
+  osalDbgCheckClassI();
+
+  rd = oq_read(oqp, bp, n);
+
+  /* Waking up the writers if some space has been freed.*/
+  if (rd > (size_t)0) {
+    osalThreadDequeueAllI(&oqp->q_waiting, MSG_OK);
+  }
+
+  return rd;
+}
+
 /**
  * @brief   Output queue non-blocking write.
  * @details The function writes data from a buffer to an output queue. The
@@ -60,6 +60,20 @@ typedef enum {
   SD_SWITCH_FUNCTION_CURRENT_LIMIT = 3
 } sd_switch_function_t;
 
+/**
+ * @brief   OCR bit requesting and accepting the 1.8V signaling switch.
+ */
+#define SDC_OCR_S18                         (1U << 24)
+
+/**
+ * @name    EXT_CSD fields used by the bus modes selection
+ * @{
+ */
+#define MMC_EXT_CSD_BUS_WIDTH               183U
+#define MMC_EXT_CSD_HS_TIMING               185U
+#define MMC_EXT_CSD_DEVICE_TYPE             196U
+/** @} */
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -185,6 +199,12 @@ static bool sdc_init(SDCDriver *sdcp) {
 
   if ((sdcp->cardmode &  SDC_MODE_CARDTYPE_MASK) == SDC_MODE_CARDTYPE_SDV20) {
     ocr = SDC_INIT_OCR_V20;
+#if SDC_UHS_SUPPORT == TRUE
+    /* Requesting 1.8V signaling if the board is able to switch.*/
+    if (sdc_lld_get_signaling(sdcp) == SDC_SIGNALING_SWITCHABLE) {
+      ocr |= SDC_OCR_S18;
+    }
+#endif
   }
   else {
     ocr = SDC_INIT_OCR;
@@ -211,6 +231,18 @@ static bool sdc_init(SDCDriver *sdcp) {
     osalThreadSleepMilliseconds(10);
   }
 
+#if SDC_UHS_SUPPORT == TRUE
+  /* The card accepted the 1.8V signaling, the switch must happen before
+     the identification.*/
+  if (((ocr & resp[0] & SDC_OCR_S18) != 0U) &&
+      ((sdcp->cardmode & SDC_MODE_HIGH_CAPACITY) != 0U)) {
+    if (sdc_lld_switch_voltage(sdcp)) {
+      return HAL_FAILED;
+    }
+    sdcp->cardmode |= SDC_MODE_LOW_VOLTAGE;
+  }
+#endif
+
   return HAL_SUCCESS;
 }
 
@@ -483,6 +515,141 @@ static bool mmc_set_bus_width(SDCDriver *sdcp) {
   return HAL_SUCCESS;
 }
 
+#if (SDC_UHS_SUPPORT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Switches SDC to the UHS-I SDR50 or SDR104 modes.
+ * @note    The card must already be in 1.8V signaling and 4 bits mode,
+ *          otherwise it is left in its current mode.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+static bool sdc_uhs_switch(SDCDriver *sdcp) {
+  uint32_t cmdarg, value;
+  uint16_t info;
+  sdcbusclk_t clk;
+  uint8_t *tmp = sdcp->buf;
+
+  if (((sdcp->cardmode & SDC_MODE_LOW_VOLTAGE) == 0U) ||
+      (SDC_MODE_4BIT != sdcp->config->bus_width)) {
+    return HAL_SUCCESS;
+  }
+
+  /* Read switch functions' register.*/
+  if (sdc_lld_read_special(sdcp, tmp, 64, MMCSD_CMD_SWITCH, 0)) {
+    return HAL_FAILED;
+  }
+
+  /* Fastest access mode supported by the card.*/
+  info = sdc_cmd6_extract_info(SD_SWITCH_FUNCTION_SPEED, tmp);
+  if ((info & 8U) != 0U) {
+    value = 3U;
+    clk   = SDC_CLK_200MHz;
+  }
+  else if ((info & 4U) != 0U) {
+    value = 2U;
+    clk   = SDC_CLK_100MHz;
+  }
+  else {
+    return HAL_SUCCESS;
+  }
+
+  cmdarg = sdc_cmd6_construct(SD_SWITCH_SET, SD_SWITCH_FUNCTION_SPEED, value);
+  if (sdc_lld_read_special(sdcp, tmp, 64, MMCSD_CMD_SWITCH, cmdarg)) {
+    return HAL_FAILED;
+  }
+  if (HAL_SUCCESS != sdc_cmd6_check_status(SD_SWITCH_FUNCTION_SPEED, tmp)) {
+    return HAL_SUCCESS;
+  }
+
+  /* New clock then sampling point tuning.*/
+  sdc_lld_set_data_clk(sdcp, clk);
+  return sdc_lld_execute_tuning(sdcp, MMCSD_CMD_SEND_TUNING_BLOCK);
+}
+
+/**
+ * @brief   Writes an EXT_CSD byte and waits for the MMC to complete it.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] idx       EXT_CSD byte number
+ * @param[in] value     value to be written
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+static bool mmc_write_ext_csd(SDCDriver *sdcp, uint32_t idx, uint32_t value) {
+  uint32_t resp[1];
+  uint32_t cmdarg = mmc_cmd6_construct(MMC_SWITCH_WRITE_BYTE, idx, value, 0);
+
+  if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_SWITCH, cmdarg, resp) ||
+      MMCSD_R1_ERROR(resp[0])) {
+    return HAL_FAILED;
+  }
+
+  return _sdc_wait_for_transfer_state(sdcp);
+}
+
+/**
+ * @brief   Switches MMC to the HS200 or DDR52 modes.
+ * @details HS200 is preferred if the board provides 1.8V signaling, DDR52
+ *          requires the high speed timing to be already selected.
+ * @note    The card must already be in 4 or 8 bits mode, otherwise it is
+ *          left in its current mode.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] clk       current bus clock mode
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+static bool mmc_uhs_switch(SDCDriver *sdcp, sdcbusclk_t clk) {
+  uint8_t *ext_csd = sdcp->buf;
+  uint32_t type;
+
+  if ((SDC_MODE_1BIT == sdcp->config->bus_width) ||
+      (_mmcsd_get_slice(sdcp->csd, MMCSD_CSD_MMC_CSD_STRUCTURE_SLICE) <= 1U)) {
+    return HAL_SUCCESS;
+  }
+
+  if (sdc_lld_read_special(sdcp, ext_csd, 512, MMCSD_CMD_SEND_EXT_CSD, 0)) {
+    return HAL_FAILED;
+  }
+  type = (uint32_t)ext_csd[MMC_EXT_CSD_DEVICE_TYPE];
+
+  /* HS200 at 1.8V, the bus width is already selected.*/
+  if (((type & 0x10U) != 0U) &&
+      (sdc_lld_get_signaling(sdcp) == SDC_SIGNALING_1V8)) {
+    if (mmc_write_ext_csd(sdcp, MMC_EXT_CSD_HS_TIMING, 2U)) {
+      return HAL_FAILED;
+    }
+    sdc_lld_set_data_clk(sdcp, SDC_CLK_200MHz);
+    return sdc_lld_execute_tuning(sdcp, MMCSD_CMD_SEND_TUNING_HS200);
+  }
+
+  /* DDR52 at 3V or 1.8V, selected with the DDR bus widths.*/
+  if (((type & 0x04U) != 0U) && (SDC_CLK_50MHz == clk)) {
+    if (mmc_write_ext_csd(sdcp, MMC_EXT_CSD_BUS_WIDTH,
+                          SDC_MODE_8BIT == sdcp->config->bus_width ? 6U : 5U)) {
+      return HAL_FAILED;
+    }
+    sdc_lld_set_data_clk(sdcp, SDC_CLK_50MHz_DDR);
+  }
+
+  return HAL_SUCCESS;
+}
+#endif /* SDC_UHS_SUPPORT == TRUE */
+
 /**
  * @brief   Wait for the card to complete pending operations.
  *
@@ -522,6 +689,46 @@ bool _sdc_wait_for_transfer_state(SDCDriver *sdcp) {
   }
 }
 
+#if (SDC_USE_PREERASE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Declares the number of blocks of the next multi-block write.
+ * @details Sends ACMD23 so that the card can pre-erase the blocks, MMC
+ *          cards do not support the command and are skipped.
+ * @note    This function is meant to be invoked by the LLD immediately
+ *          before the write multiple block command.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] n         number of blocks to be written
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+bool _sdc_preerase(SDCDriver *sdcp, uint32_t n) {
+  uint32_t resp[1];
+
+  if ((sdcp->cardmode & SDC_MODE_CARDTYPE_MASK) == SDC_MODE_CARDTYPE_MMC) {
+    return HAL_SUCCESS;
+  }
+
+  if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_APP_CMD,
+                                 sdcp->rca, resp) ||
+      MMCSD_R1_ERROR(resp[0])) {
+    return HAL_FAILED;
+  }
+
+  if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_APP_SET_WR_BLK_ERASE,
+                                 n, resp) ||
+      MMCSD_R1_ERROR(resp[0])) {
+    return HAL_FAILED;
+  }
+
+  return HAL_SUCCESS;
+}
+#endif /* SDC_USE_PREERASE == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -726,6 +933,20 @@ bool sdcConnect(SDCDriver *sdcp) {
     goto failed;
   }
 
+#if SDC_UHS_SUPPORT == TRUE
+  /* Switches to the fast bus modes, wide bus required.*/
+  if (SDC_MODE_CARDTYPE_MMC == (sdcp->cardmode & SDC_MODE_CARDTYPE_MASK)) {
+    if (HAL_FAILED == mmc_uhs_switch(sdcp, clk)) {
+      goto failed;
+    }
+  }
+  else {
+    if (HAL_FAILED == sdc_uhs_switch(sdcp)) {
+      goto failed;
+    }
+  }
+#endif
+
   /* Initialization complete.*/
   sdcp->state = BLK_READY;
   return HAL_SUCCESS;
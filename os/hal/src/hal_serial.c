@@ -248,6 +248,36 @@ void sdIncomingDataI(SerialDriver *sdp, uint8_t b) {
     chnAddFlagsI(sdp, SD_QUEUE_FULL_ERROR);
 }
 
+/**
+ * @brief   Handles incoming data blocks.
+ * @details This function must be called from the input interrupt service
+ *          routine of drivers receiving data in blocks, for example by DMA,
+ *          in order to enqueue incoming data and generate the related
+ *          events.
+ * @note    The incoming data event is generated once for the whole block
+ *          and only if the input queue was empty.
+ *
+ * @param[in] sdp       pointer to a @p SerialDriver structure
+ * @param[in] bp        pointer to the received data
+ * @param[in] n         number of bytes to be written in the driver's
+ *                      Input Queue
+ *
+ * @iclass
+ */
+void sdIncomingDataBufferI(SerialDriver *sdp, const uint8_t *bp, size_t n) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((sdp != NULL) && (bp != NULL));
+
+  if (n == 0U)
+    return;
+
+  if (iqIsEmptyI(&sdp->iqueue))
+    chnAddFlagsI(sdp, CHN_INPUT_AVAILABLE);
+  if (iqWriteI(&sdp->iqueue, bp, n) < n)
+    chnAddFlagsI(sdp, SD_QUEUE_FULL_ERROR);
+}
+
 /**
  * @brief   Handles outgoing data.
  * @details Must be called from the output interrupt service routine in order
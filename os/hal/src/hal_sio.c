@@ -228,6 +228,9 @@ void sioObjectInit(SIODriver *siop) {
 #endif
   siop->state   = SIO_STOP;
   siop->config  = NULL;
+#if SIO_USE_STREAMING == TRUE
+  siop->stream  = NULL;
+#endif
 
   /* Optional, user-defined initializer.*/
 #if defined(SIO_DRIVER_EXT_INIT_HOOK)
@@ -346,6 +349,12 @@ void sioStopOperation(SIODriver *siop) {
 
   sio_lld_stop_operation(siop);
 
+#if SIO_USE_STREAMING == TRUE
+  /* Buffers still in the transmit chain are abandoned.*/
+  siop->stream    = NULL;
+  siop->txhead    = NULL;
+  siop->txtail    = NULL;
+#endif
   siop->operation = NULL;
   siop->state     = SIO_READY;
 
@@ -428,11 +437,160 @@ size_t sioAsyncWrite(SIODriver *siop, const uint8_t *buffer, size_t n) {
   return n;
 }
 
+#if (SIO_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a SIO operation in streaming mode.
+ * @details Data is received continuously by DMA into the ring buffer
+ *          specified in the streaming configuration, transmission is
+ *          performed from the buffers queued using @p sioStreamWrite().
+ * @note    The @p rx_cb callback and the RX synchronization are triggered
+ *          when the amount of data in the ring reaches the configured
+ *          threshold, @p tx_cb is invoked after each transmitted buffer.
+ * @note    The FIFO-level functions and the channel interface must not be
+ *          used in streaming mode.
+ *
+ * @param[in] siop          pointer to an @p SIODriver structure
+ * @param[in] operation     pointer to an @p SIOOperation structure, can
+ *                          be @p NULL if callbacks are not required
+ * @param[in] scp           pointer to a @p SIOStreamConfig structure
+ *
+ * @api
+ */
+void sioStartStreaming(SIODriver *siop, const SIOOperation *operation,
+                       const SIOStreamConfig *scp) {
+
+  osalDbgCheck((siop != NULL) && (scp != NULL) && (scp->rxbuf != NULL) &&
+               (scp->rxsize >= 2U) && ((scp->rxsize & 1U) == 0U) &&
+               (scp->rxthreshold < scp->rxsize));
+
+  osalSysLock();
+
+  osalDbgAssert(siop->state == SIO_READY, "invalid state");
+
+  if (operation != NULL) {
+    siop->operation = operation;
+  }
+  else {
+    siop->operation = &default_operation;
+  }
+  siop->stream    = scp;
+  siop->rxrdptr   = 0U;
+  siop->txhead    = NULL;
+  siop->txtail    = NULL;
+  siop->txdone    = NULL;
+  siop->state     = SIO_ACTIVE;
+
+  sio_lld_start_streaming(siop);
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Returns the received data at the streaming RX ring read index.
+ * @details The returned block is contiguous, if the data wraps around the
+ *          end of the ring then the remaining part is returned by a
+ *          following call after releasing the first block.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[out] bpp      pointer to the returned block pointer
+ * @return              The size of the block.
+ * @retval 0            if there is no received data.
+ *
+ * @api
+ */
+size_t sioStreamPeekRX(SIODriver *siop, const uint8_t **bpp) {
+  size_t wrptr, rdptr;
+
+  osalDbgCheck((siop != NULL) && (bpp != NULL));
+  osalDbgAssert(siop->stream != NULL, "not streaming");
+
+  wrptr  = sioStreamGetWritePointerX(siop);
+  rdptr  = siop->rxrdptr;
+  *bpp   = &siop->stream->rxbuf[rdptr];
+  if (wrptr >= rdptr) {
+    return wrptr - rdptr;
+  }
+  return siop->stream->rxsize - rdptr;
+}
+
+/**
+ * @brief   Releases data from the streaming RX ring.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] n         number of bytes to be released
+ *
+ * @api
+ */
+void sioStreamReleaseRX(SIODriver *siop, size_t n) {
+  size_t rdptr;
+
+  osalDbgCheck(siop != NULL);
+  osalDbgAssert(siop->stream != NULL, "not streaming");
+
+  osalSysLock();
+
+  rdptr = siop->rxrdptr + n;
+  if (rdptr >= siop->stream->rxsize) {
+    rdptr -= siop->stream->rxsize;
+  }
+  siop->rxrdptr = rdptr;
+
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Queues a buffer for transmission in streaming mode.
+ * @details The buffer is appended to the transmit chain, the transmission
+ *          is started if the chain was empty.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] tbp       pointer to the @p sio_txbuf_t object
+ *
+ * @iclass
+ */
+void sioStreamWriteI(SIODriver *siop, sio_txbuf_t *tbp) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((siop != NULL) && (tbp != NULL) && (tbp->n > 0U));
+  osalDbgAssert(siop->stream != NULL, "not streaming");
+
+  tbp->next = NULL;
+  if (siop->txhead == NULL) {
+    siop->txhead = tbp;
+    siop->txtail = tbp;
+    sio_lld_stream_start_tx(siop, tbp);
+  }
+  else {
+    siop->txtail->next = tbp;
+    siop->txtail       = tbp;
+  }
+}
+
+/**
+ * @brief   Queues a buffer for transmission in streaming mode.
+ * @details The buffer is appended to the transmit chain, the transmission
+ *          is started if the chain was empty.
+ *
+ * @param[in] siop      pointer to the @p SIODriver object
+ * @param[in] tbp       pointer to the @p sio_txbuf_t object
+ *
+ * @api
+ */
+void sioStreamWrite(SIODriver *siop, sio_txbuf_t *tbp) {
+
+  osalSysLock();
+  sioStreamWriteI(siop, tbp);
+  osalSysUnlock();
+}
+#endif /* SIO_USE_STREAMING == TRUE */
+
 #if (SIO_USE_SYNCHRONIZATION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Synchronizes with RX FIFO data availability.
  * @note    The exact behavior depends on low level FIFO settings such
  *          as thresholds, etc.
+ * @note    In streaming mode the function waits for the RX ring to
+ *          contain more than the configured threshold.
  * @note    This function can only be called by a single thread at time.
  *
  * @param[in] siop          pointer to an @p SIODriver structure
@@ -453,6 +611,17 @@ msg_t sioSynchronizeRX(SIODriver *siop, sysinterval_t timeout) {
 
   osalDbgAssert(siop->state == SIO_ACTIVE, "invalid state");
 
+#if SIO_USE_STREAMING == TRUE
+  if (siop->stream != NULL) {
+    if (sioStreamGetRXCountX(siop) <= siop->stream->rxthreshold) {
+      msg = osalThreadSuspendTimeoutS(&siop->sync_rx, timeout);
+    }
+    else {
+      msg = MSG_OK;
+    }
+  }
+  else
+#endif
   if (sio_lld_is_rx_empty(siop)) {
     msg = osalThreadSuspendTimeoutS(&siop->sync_rx, timeout);
   }
@@ -469,6 +638,8 @@ msg_t sioSynchronizeRX(SIODriver *siop, sysinterval_t timeout) {
  * @brief   Synchronizes with TX FIFO space availability.
  * @note    The exact behavior depends on low level FIFO settings such
  *          as thresholds, etc.
+ * @note    In streaming mode the function waits for the transmission of
+ *          the buffer at the head of the transmit chain.
  * @note    This function can only be called by a single thread at time.
  *
  * @param[in] siop          pointer to an @p SIODriver structure
@@ -487,6 +658,17 @@ msg_t sioSynchronizeTX(SIODriver *siop, sysinterval_t timeout) {
 
   osalDbgAssert(siop->state == SIO_ACTIVE, "invalid state");
 
+#if SIO_USE_STREAMING == TRUE
+  if (siop->stream != NULL) {
+    if (siop->txhead != NULL) {
+      msg = osalThreadSuspendTimeoutS(&siop->sync_tx, timeout);
+    }
+    else {
+      msg = MSG_OK;
+    }
+  }
+  else
+#endif
   if (sio_lld_is_tx_full(siop)) {
     msg = osalThreadSuspendTimeoutS(&siop->sync_tx, timeout);
   }
@@ -518,6 +700,12 @@ msg_t sioSynchronizeTXEnd(SIODriver *siop, sysinterval_t timeout) {
 
   osalDbgAssert(siop->state == SIO_ACTIVE, "invalid state");
 
+#if SIO_USE_STREAMING == TRUE
+  if ((siop->stream != NULL) && (siop->txhead != NULL)) {
+    msg = osalThreadSuspendTimeoutS(&siop->sync_txend, timeout);
+  }
+  else
+#endif
   if (sio_lld_is_tx_ongoing(siop)) {
     msg = osalThreadSuspendTimeoutS(&siop->sync_txend, timeout);
   }
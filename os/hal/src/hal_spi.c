@@ -42,6 +42,19 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   NSS line event callback.
+ *
+ * @param[in] arg       pointer to the @p SPIDriver object
+ */
+static void spi_nss_cb(void *arg) {
+  SPIDriver *spip = (SPIDriver *)arg;
+
+  spip->config->nss_cb(spip);
+}
+#endif /* SPI_USE_SLAVE == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -75,6 +88,17 @@ void spiObjectInit(SPIDriver *spip) {
 #if SPI_USE_MUTUAL_EXCLUSION == TRUE
   osalMutexObjectInit(&spip->mutex);
 #endif
+#if SPI_USE_TRANSACTIONS == TRUE
+  spip->segp = NULL;
+  spip->segn = 0U;
+#endif
+#if SPI_USE_QUEUE == TRUE
+  spip->qhead = NULL;
+  spip->qcurr = NULL;
+#endif
+#if SPI_USE_SLAVE == TRUE
+  spip->slaven = 0U;
+#endif
 #if defined(SPI_DRIVER_EXT_INIT_HOOK)
   SPI_DRIVER_EXT_INIT_HOOK(spip);
 #endif
@@ -279,6 +303,14 @@ void spiAbortI(SPIDriver *spip) {
 
   spi_lld_abort(spip);
   spip->state = SPI_READY;
+#if SPI_USE_TRANSACTIONS == TRUE
+  spip->segp = NULL;
+#endif
+#if SPI_USE_SLAVE == TRUE
+  if (spip->config->slave && (spip->config->nss_cb != NULL)) {
+    palDisableLineEventI(spip->config->nssline);
+  }
+#endif
 #if SPI_USE_WAIT == TRUE
   osalThreadResumeI(&spip->thread, MSG_OK);
 #endif
@@ -304,6 +336,86 @@ void spiAbort(SPIDriver *spip) {
 }
 #endif
 
+#if (SPI_USE_SLAVE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a slave operation.
+ * @details Reception and transmission are performed continuously over
+ *          circular buffers of @p n words while the master clocks the bus,
+ *          the operation is stopped using @p spiAbort().
+ *          - The transmit buffer is preloaded, the peripheral TX FIFO is
+ *            filled before the master starts clocking so the first word
+ *            of a frame is always valid. Both buffers advance in lockstep,
+ *            the half not in use can be refilled from the callbacks.
+ *          - The configured @p end_cb callback is invoked at each half
+ *            and full buffer, see @p spiIsBufferComplete().
+ *          - The configured @p nss_cb callback is invoked on both edges
+ *            of the NSS line, @p spiGetSlavePositionX() sampled on the
+ *            edges delimits each frame.
+ *          .
+ * @pre     The driver must have been configured with both @p slave and
+ *          @p circular set to @p true.
+ * @note    The buffers are organized as uint8_t arrays for data sizes below
+ *          or equal to 8 bits else it is organized as uint16_t arrays.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words in the circular buffers
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL if
+ *                      idle words are to be sent
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @iclass
+ */
+void spiStartSlaveI(SPIDriver *spip, size_t n,
+                    const void *txbuf, void *rxbuf) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck((spip != NULL) && (n > 0U) && (rxbuf != NULL));
+  osalDbgAssert(spip->state == SPI_READY, "not ready");
+  osalDbgAssert(spip->config->slave && spip->config->circular,
+                "not a circular slave configuration");
+
+  spip->slaven = n;
+
+  /* NSS framing events.*/
+  if (spip->config->nss_cb != NULL) {
+    palSetLineCallbackI(spip->config->nssline, spi_nss_cb, (void *)spip);
+    palEnableLineEventI(spip->config->nssline, PAL_EVENT_MODE_BOTH_EDGES);
+  }
+
+  if (txbuf != NULL) {
+    spiStartExchangeI(spip, n, txbuf, rxbuf);
+  }
+  else {
+    spiStartReceiveI(spip, n, rxbuf);
+  }
+}
+
+/**
+ * @brief   Starts a slave operation.
+ * @details Reception and transmission are performed continuously over
+ *          circular buffers of @p n words while the master clocks the bus,
+ *          the operation is stopped using @p spiAbort().
+ * @pre     The driver must have been configured with both @p slave and
+ *          @p circular set to @p true.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of words in the circular buffers
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL if
+ *                      idle words are to be sent
+ * @param[out] rxbuf    the pointer to the receive buffer
+ *
+ * @api
+ */
+void spiStartSlave(SPIDriver *spip, size_t n,
+                   const void *txbuf, void *rxbuf) {
+
+  osalSysLock();
+  spiStartSlaveI(spip, n, txbuf, rxbuf);
+  osalSysUnlock();
+}
+#endif /* SPI_USE_SLAVE == TRUE */
+
 #if (SPI_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Ignores data on the SPI bus.
@@ -428,6 +540,295 @@ void spiReceive(SPIDriver *spip, size_t n, void *rxbuf) {
 }
 #endif /* SPI_USE_WAIT == TRUE */
 
+#if (SPI_USE_TRANSACTIONS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the current transaction segment.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+static void spi_start_segment(SPIDriver *spip) {
+  const spi_segment_t *sp = spip->segp;
+
+  if ((sp->flags & SPI_SEG_SELECT) != 0U) {
+    spiSelectI(spip);
+  }
+  if (sp->txbuf == NULL) {
+    if (sp->rxbuf == NULL) {
+      spiStartIgnoreI(spip, sp->n);
+    }
+    else {
+      spiStartReceiveI(spip, sp->n, sp->rxbuf);
+    }
+  }
+  else {
+    if (sp->rxbuf == NULL) {
+      spiStartSendI(spip, sp->n, sp->txbuf);
+    }
+    else {
+      spiStartExchangeI(spip, sp->n, sp->txbuf, sp->rxbuf);
+    }
+  }
+}
+
+#if (SPI_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts the next queued request, if any.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ *
+ * @notapi
+ */
+static void spi_queue_next(SPIDriver *spip) {
+  spi_request_t *reqp = spip->qhead;
+
+  spip->qcurr = reqp;
+  if (reqp != NULL) {
+    spip->qhead = reqp->next;
+    spiStartTransactionI(spip, reqp->segp, reqp->n);
+  }
+}
+#endif /* SPI_USE_QUEUE == TRUE */
+
+/**
+ * @brief   Starts a segmented transaction.
+ * @details This asynchronous function starts a chain of segments, each
+ *          one with its own buffers and chip select handling. Segments
+ *          are chained from the completion interrupt without thread
+ *          involvement, the configured callback is invoked once at the
+ *          end of the last segment.
+ * @pre     The driver must not be configured in circular mode.
+ * @post    At the end of the operation the configured callback is invoked.
+ * @note    The segments array must remain valid until the transaction
+ *          completes.
+ * @note    The buffers are organized as uint8_t arrays for data sizes below
+ *          or equal to 8 bits else it is organized as uint16_t arrays.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] segp      pointer to an array of @p spi_segment_t
+ * @param[in] n         number of segments in the array
+ *
+ * @iclass
+ */
+void spiStartTransactionI(SPIDriver *spip,
+                          const spi_segment_t *segp, size_t n) {
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck((spip != NULL) && (segp != NULL) && (n > 0U));
+#if SPI_SUPPORTS_CIRCULAR == TRUE
+  osalDbgCheck(spip->config->circular == false);
+#endif
+  osalDbgAssert(spip->state == SPI_READY, "not ready");
+
+  spip->segp = segp;
+  spip->segn = n;
+  spi_start_segment(spip);
+}
+
+/**
+ * @brief   Starts a segmented transaction.
+ * @details This asynchronous function starts a chain of segments, each
+ *          one with its own buffers and chip select handling.
+ * @pre     The driver must not be configured in circular mode.
+ * @post    At the end of the operation the configured callback is invoked.
+ * @note    The segments array must remain valid until the transaction
+ *          completes.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] segp      pointer to an array of @p spi_segment_t
+ * @param[in] n         number of segments in the array
+ *
+ * @api
+ */
+void spiStartTransaction(SPIDriver *spip,
+                         const spi_segment_t *segp, size_t n) {
+
+  osalSysLock();
+  spiStartTransactionI(spip, segp, n);
+  osalSysUnlock();
+}
+
+#if (SPI_USE_WAIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a segmented transaction.
+ * @details This synchronous function performs a chain of segments, the
+ *          calling thread is woken up once at the end of the last segment.
+ * @pre     In order to use this function the option @p SPI_USE_WAIT must be
+ *          enabled.
+ * @pre     In order to use this function the driver must have been configured
+ *          without callbacks (@p end_cb = @p NULL).
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] segp      pointer to an array of @p spi_segment_t
+ * @param[in] n         number of segments in the array
+ *
+ * @api
+ */
+void spiTransaction(SPIDriver *spip, const spi_segment_t *segp, size_t n) {
+
+  osalSysLock();
+  spiStartTransactionI(spip, segp, n);
+  (void) osalThreadSuspendS(&spip->thread);
+  osalSysUnlock();
+}
+#endif /* SPI_USE_WAIT == TRUE */
+
+#if (SPI_USE_QUEUE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Queues a request.
+ * @details The request is inserted in the queue in priority order, FIFO
+ *          among requests of equal priority. If the bus is idle then the
+ *          request is started immediately else it is started from the
+ *          completion interrupt of the previous request, back to back and
+ *          without thread involvement.
+ * @pre     The driver must not be busy with operations started using the
+ *          direct APIs.
+ * @post    At the end of the request its callback is invoked, if any.
+ * @note    The request and its segments must remain valid until the
+ *          request completes.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] reqp      pointer to the @p spi_request_t object
+ *
+ * @iclass
+ */
+void spiQueueRequestI(SPIDriver *spip, spi_request_t *reqp) {
+  spi_request_t **pp;
+
+  osalDbgCheckClassI();
+
+  osalDbgCheck((spip != NULL) && (reqp != NULL) &&
+               (reqp->segp != NULL) && (reqp->n > 0U));
+  osalDbgAssert((spip->state == SPI_READY) || (spip->qcurr != NULL),
+                "not ready");
+
+#if SPI_USE_WAIT == TRUE
+  reqp->thread = NULL;
+#endif
+
+  /* Priority ordered insertion.*/
+  pp = &spip->qhead;
+  while ((*pp != NULL) && ((*pp)->prio >= reqp->prio)) {
+    pp = &(*pp)->next;
+  }
+  reqp->next = *pp;
+  *pp = reqp;
+
+  if (spip->qcurr == NULL) {
+    spi_queue_next(spip);
+  }
+}
+
+/**
+ * @brief   Queues a request.
+ * @details The request is inserted in the queue in priority order, FIFO
+ *          among requests of equal priority.
+ * @pre     The driver must not be busy with operations started using the
+ *          direct APIs.
+ * @post    At the end of the request its callback is invoked, if any.
+ * @note    The request and its segments must remain valid until the
+ *          request completes.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] reqp      pointer to the @p spi_request_t object
+ *
+ * @api
+ */
+void spiQueueRequest(SPIDriver *spip, spi_request_t *reqp) {
+
+  osalSysLock();
+  spiQueueRequestI(spip, reqp);
+  osalSysUnlock();
+}
+
+#if (SPI_USE_WAIT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Queues a request and waits for its completion.
+ * @pre     In order to use this function the option @p SPI_USE_WAIT must be
+ *          enabled.
+ * @pre     The driver must not be busy with operations started using the
+ *          direct APIs.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] reqp      pointer to the @p spi_request_t object
+ *
+ * @api
+ */
+void spiRequest(SPIDriver *spip, spi_request_t *reqp) {
+
+  osalSysLock();
+  spiQueueRequestI(spip, reqp);
+  (void) osalThreadSuspendS(&reqp->thread);
+  osalSysUnlock();
+}
+#endif /* SPI_USE_WAIT == TRUE */
+#endif /* SPI_USE_QUEUE == TRUE */
+
+/**
+ * @brief   Advances the current transaction, if any.
+ * @details Handles the chip select of the completed segment and starts
+ *          the next one. When queued requests are enabled the completion
+ *          of a request starts the next queued request.
+ * @note    This function is meant to be used by @p _spi_isr_code() only.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @return              The completion state.
+ * @retval false        if there is no transaction in progress or the
+ *                      completed segment was the last one of a transaction
+ *                      started using the direct APIs.
+ * @retval true         if the completion has been handled here.
+ *
+ * @notapi
+ */
+bool _spi_isr_next_segment(SPIDriver *spip) {
+  const spi_segment_t *sp = spip->segp;
+  bool more = false;
+#if SPI_USE_QUEUE == TRUE
+  spi_request_t *reqp = NULL;
+  spirequestcb_t end_cb = NULL;
+#endif
+
+  if (sp != NULL) {
+    osalSysLockFromISR();
+    if ((sp->flags & SPI_SEG_UNSELECT) != 0U) {
+      spiUnselectI(spip);
+    }
+    if (--spip->segn > 0U) {
+      spip->segp = sp + 1;
+      spi_start_segment(spip);
+      more = true;
+    }
+    else {
+      spip->segp = NULL;
+#if SPI_USE_QUEUE == TRUE
+      reqp = spip->qcurr;
+      if (reqp != NULL) {
+        /* Starting the next request first in order to minimize the bus
+           idle time.*/
+        end_cb = reqp->end_cb;
+        spip->state = SPI_READY;
+        spi_queue_next(spip);
+#if SPI_USE_WAIT == TRUE
+        osalThreadResumeI(&reqp->thread, MSG_OK);
+#endif
+        more = true;
+      }
+#endif
+    }
+    osalSysUnlockFromISR();
+#if SPI_USE_QUEUE == TRUE
+    if (end_cb != NULL) {
+      end_cb(spip, reqp);
+    }
+#endif
+  }
+
+  return more;
+}
+#endif /* SPI_USE_TRANSACTIONS == TRUE */
+
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Gains exclusive access to the SPI bus.
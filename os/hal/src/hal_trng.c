@@ -42,6 +42,19 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Entropy pool consumer notification.
+ * @details Restarts the refill after data has been taken from the pool.
+ *
+ * @param[in] qp        pointer to the pool queue
+ */
+static void trng_pool_notify(io_queue_t *qp) {
+
+  trng_lld_pool_refill_i((TRNGDriver *)qGetLink(qp));
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -69,6 +82,10 @@ void trngObjectInit(TRNGDriver *trngp) {
 
   trngp->state  = TRNG_STOP;
   trngp->config = NULL;
+#if TRNG_USE_POOL == TRUE
+  iqObjectInit(&trngp->pool, trngp->pool_buf, sizeof trngp->pool_buf,
+               trng_pool_notify, (void *)trngp);
+#endif
 }
 
 /**
@@ -112,6 +129,10 @@ void trngStop(TRNGDriver *trngp) {
   trng_lld_stop(trngp);
   trngp->config = NULL;
   trngp->state  = TRNG_STOP;
+#if TRNG_USE_POOL == TRUE
+  iqResetI(&trngp->pool);
+  osalOsRescheduleS();
+#endif
 
   osalSysUnlock();
 }
@@ -120,6 +141,9 @@ void trngStop(TRNGDriver *trngp) {
  * @brief   True random numbers generator.
  * @note    The function is blocking and likely performs polled waiting
  *          inside the low level implementation.
+ * @note    If @p TRNG_USE_POOL is enabled then the data is taken from the
+ *          entropy pool, the calling thread sleeps while the pool is
+ *          refilled.
  *
  * @param[in] trngp             pointer to the @p TRNGDriver object
  * @param[in] size              size of output buffer
@@ -137,14 +161,58 @@ bool trngGenerate(TRNGDriver *trngp, size_t size, uint8_t *out) {
 
   osalDbgAssert(trngp->state == TRNG_READY, "not ready");
 
+#if TRNG_USE_POOL == TRUE
+  err = false;
+  if (size > 0U) {
+    err = iqReadTimeout(&trngp->pool, out, size,
+                        TIME_MS2I(TRNG_POOL_TIMEOUT)) < size;
+  }
+#else
   trngp->state = TRNG_RUNNING;
 
   err = trng_lld_generate(trngp, size, out);
 
   trngp->state = TRNG_READY;
+#endif
+
+  return err;
+}
+
+#if (TRNG_USE_POOL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Non-blocking true random numbers generator.
+ * @details The data is taken from the entropy pool, the function fails
+ *          without taking any data if the pool does not contain enough
+ *          bytes.
+ *
+ * @param[in] trngp             pointer to the @p TRNGDriver object
+ * @param[in] size              size of output buffer
+ * @param[out] out              output buffer
+ * @return                      The operation status.
+ * @retval false                if a random number has been generated.
+ * @retval true                 if the pool does not contain enough data.
+ *
+ * @api
+ */
+bool trngTryGenerate(TRNGDriver *trngp, size_t size, uint8_t *out) {
+  bool err = true;
+
+  osalDbgCheck((trngp != NULL) && (size > 0U) && (out != NULL));
+
+  osalSysLock();
+
+  osalDbgAssert(trngp->state == TRNG_READY, "not ready");
+
+  if (iqGetFullI(&trngp->pool) >= size) {
+    (void) iqReadI(&trngp->pool, out, size);
+    err = false;
+  }
+
+  osalSysUnlock();
 
   return err;
 }
+#endif /* TRNG_USE_POOL == TRUE */
 
 #endif /* HAL_USE_TRNG == TRUE */
 
@@ -79,6 +79,9 @@ void uartObjectInit(UARTDriver *uartp) {
 #if UART_USE_MUTUAL_EXCLUSION == TRUE
   osalMutexObjectInit(&uartp->mutex);
 #endif /* UART_USE_MUTUAL_EXCLUSION */
+#if UART_USE_RING == TRUE
+  uartp->rxring     = NULL;
+#endif
 
   /* Optional, user-defined initializer.*/
 #if defined(UART_DRIVER_EXT_INIT_HOOK)
@@ -129,6 +132,9 @@ void uartStop(UARTDriver *uartp) {
   uartp->state   = UART_STOP;
   uartp->txstate = UART_TX_IDLE;
   uartp->rxstate = UART_RX_IDLE;
+#if UART_USE_RING == TRUE
+  uartp->rxring  = NULL;
+#endif
 
   osalSysUnlock();
 }
@@ -309,6 +315,9 @@ size_t uartStopReceive(UARTDriver *uartp) {
   if (uartp->rxstate == UART_RX_ACTIVE) {
     n = uart_lld_stop_receive(uartp);
     uartp->rxstate = UART_RX_IDLE;
+#if UART_USE_RING == TRUE
+    uartp->rxring  = NULL;
+#endif
   }
   else {
     n = UART_ERR_NOT_ACTIVE;
@@ -340,11 +349,118 @@ size_t uartStopReceiveI(UARTDriver *uartp) {
   if (uartp->rxstate == UART_RX_ACTIVE) {
     size_t n = uart_lld_stop_receive(uartp);
     uartp->rxstate = UART_RX_IDLE;
+#if UART_USE_RING == TRUE
+    uartp->rxring  = NULL;
+#endif
     return n;
   }
   return UART_ERR_NOT_ACTIVE;
 }
 
+#if (UART_USE_RING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a receive operation in ring mode.
+ * @details The receiver runs continuously over the ring buffer, the
+ *          @p rxhalf_cb and @p rxend_cb callbacks are invoked each time
+ *          the first or the second half of the ring is filled. Received
+ *          data is accessed in place using @p uartRingGetSpanX() and
+ *          @p uartRingReleaseX().
+ * @note    The ring mode only supports frames of 8 bits or less.
+ * @note    The operation is terminated using @p uartStopReceive().
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] n         size of the ring buffer, must be even
+ * @param[in] rxbuf     the pointer to the ring buffer
+ *
+ * @api
+ */
+void uartStartRingReceive(UARTDriver *uartp, size_t n, uint8_t *rxbuf) {
+
+  osalSysLock();
+  uartStartRingReceiveI(uartp, n, rxbuf);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Starts a receive operation in ring mode.
+ * @details The receiver runs continuously over the ring buffer, the
+ *          @p rxhalf_cb and @p rxend_cb callbacks are invoked each time
+ *          the first or the second half of the ring is filled.
+ * @note    This function has to be invoked from a lock zone.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] n         size of the ring buffer, must be even
+ * @param[in] rxbuf     the pointer to the ring buffer
+ *
+ * @iclass
+ */
+void uartStartRingReceiveI(UARTDriver *uartp, size_t n, uint8_t *rxbuf) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((uartp != NULL) && (n >= 2U) && ((n & 1U) == 0U) &&
+               (rxbuf != NULL));
+  osalDbgAssert(uartp->state == UART_READY, "is active");
+  osalDbgAssert(uartp->rxstate != UART_RX_ACTIVE, "rx active");
+
+  uartp->rxring     = rxbuf;
+  uartp->rxringsize = n;
+  uartp->rxrdptr    = 0U;
+  uart_lld_start_ring_receive(uartp, n, rxbuf);
+  uartp->rxstate    = UART_RX_ACTIVE;
+}
+
+/**
+ * @brief   Returns the received data at the ring read index.
+ * @details The returned span is contiguous, if the data wraps around the
+ *          end of the ring then the remaining part is returned by a
+ *          following call after releasing the first span.
+ * @note    Data not released before being overwritten by the receiver is
+ *          lost, the ring must be consumed within one ring time.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[out] bpp      pointer to the returned span pointer
+ * @return              The size of the span.
+ * @retval 0            if there is no received data.
+ *
+ * @xclass
+ */
+size_t uartRingGetSpanX(UARTDriver *uartp, const uint8_t **bpp) {
+  size_t wrptr, rdptr;
+
+  osalDbgCheck((uartp != NULL) && (bpp != NULL));
+  osalDbgAssert(uartp->rxring != NULL, "not in ring mode");
+
+  wrptr = uart_lld_get_ring_wrptr(uartp);
+  rdptr = uartp->rxrdptr;
+  *bpp  = &uartp->rxring[rdptr];
+  if (wrptr >= rdptr) {
+    return wrptr - rdptr;
+  }
+  return uartp->rxringsize - rdptr;
+}
+
+/**
+ * @brief   Releases data from the ring.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[in] n         number of frames to be released
+ *
+ * @xclass
+ */
+void uartRingReleaseX(UARTDriver *uartp, size_t n) {
+  size_t rdptr;
+
+  osalDbgCheck(uartp != NULL);
+  osalDbgAssert(uartp->rxring != NULL, "not in ring mode");
+
+  rdptr = uartp->rxrdptr + n;
+  if (rdptr >= uartp->rxringsize) {
+    rdptr -= uartp->rxringsize;
+  }
+  uartp->rxrdptr = rdptr;
+}
+#endif /* UART_USE_RING == TRUE */
+
 #if (UART_USE_WAIT == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Performs a transmission on the UART peripheral.
@@ -369,6 +369,52 @@ void wspiUnmapFlash(WSPIDriver *wspip) {
 }
 #endif /* WSPI_SUPPORTS_MEMMAP == TRUE */
 
+#if (WSPI_SUPPORTS_MEMMAP_WRITE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Maps in memory space a WSPI RAM device.
+ * @details The memory is readable and writable, the read and write
+ *          accesses are performed using the specified commands. The
+ *          mapped area can then be handed to the memory allocators, for
+ *          example as a core memory region:
+ *          @code
+ *          uint8_t *p;
+ *
+ *          wspiMapMemory(&WSPID1, &cmd_read, &cmd_write, &p);
+ *          chCoreAddRegion(&psram, "PSRAM", MEM_ATTR_DMA,
+ *                          p, p + PSRAM_SIZE);
+ *          @endcode
+ * @pre     The memory device must be initialized appropriately before
+ *          mapping it in memory space.
+ * @note    The device is unmapped using @p wspiUnmapFlash().
+ *
+ * @param[in] wspip     pointer to the @p WSPIDriver object
+ * @param[in] rcmdp     pointer to the read command descriptor
+ * @param[in] wcmdp     pointer to the write command descriptor
+ * @param[out] addrp    pointer to the memory start address of the mapped
+ *                      memory or @p NULL
+ *
+ * @api
+ */
+void wspiMapMemory(WSPIDriver *wspip,
+                   const wspi_command_t *rcmdp,
+                   const wspi_command_t *wcmdp,
+                   uint8_t **addrp) {
+
+  osalDbgCheck((wspip != NULL) && (rcmdp != NULL) && (wcmdp != NULL));
+  osalDbgCheck((rcmdp->cfg & WSPI_CFG_DATA_MODE_MASK) != WSPI_CFG_DATA_MODE_NONE);
+  osalDbgCheck((wcmdp->cfg & WSPI_CFG_DATA_MODE_MASK) != WSPI_CFG_DATA_MODE_NONE);
+
+  osalSysLock();
+
+  osalDbgAssert(wspip->state == WSPI_READY, "not ready");
+
+  wspiMapMemoryI(wspip, rcmdp, wcmdp, addrp);
+  wspip->state = WSPI_MEMMAP;
+
+  osalSysUnlock();
+}
+#endif /* WSPI_SUPPORTS_MEMMAP_WRITE == TRUE */
+
 #if (WSPI_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Gains exclusive access to the WSPI bus.
@@ -0,0 +1,155 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crc_lld.c
+ * @brief   PLATFORM CRC subsystem low level driver source.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   CRCD1 driver identifier.
+ */
+#if (PLATFORM_CRC_USE_CRC1 == TRUE) || defined(__DOXYGEN__)
+CRCDriver CRCD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level CRC driver initialization.
+ *
+ * @notapi
+ */
+void crc_lld_init(void) {
+
+#if PLATFORM_CRC_USE_CRC1 == TRUE
+  /* Driver initialization.*/
+  crcObjectInit(&CRCD1);
+#endif
+}
+
+/**
+ * @brief   Checks if a configuration is supported by the hardware.
+ *
+ * @param[in] config    pointer to the @p CRCConfig object
+ * @return              The check result.
+ * @retval false        if the configuration requires the software fallback.
+ * @retval true         if the configuration is supported.
+ *
+ * @notapi
+ */
+bool crc_lld_is_supported(const CRCConfig *config) {
+
+  (void)config;
+
+  return false;
+}
+
+/**
+ * @brief   Configures and activates the CRC peripheral.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @notapi
+ */
+void crc_lld_start(CRCDriver *crcp) {
+
+  if (crcp->state == CRC_STOP) {
+    /* Enables the peripheral.*/
+#if PLATFORM_CRC_USE_CRC1 == TRUE
+    if (&CRCD1 == crcp) {
+
+    }
+#endif
+  }
+  /* Configures the peripheral.*/
+
+}
+
+/**
+ * @brief   Deactivates the CRC peripheral.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ *
+ * @notapi
+ */
+void crc_lld_stop(CRCDriver *crcp) {
+
+  if (crcp->state == CRC_READY) {
+    /* Resets the peripheral.*/
+
+    /* Disables the peripheral.*/
+#if PLATFORM_CRC_USE_CRC1 == TRUE
+    if (&CRCD1 == crcp) {
+
+    }
+#endif
+  }
+}
+
+/**
+ * @brief   Computes the CRC of a data block.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] crc       CRC value to continue from
+ * @param[in] n         number of bytes
+ * @param[in] buf       pointer to the data
+ * @return              The updated CRC value.
+ *
+ * @notapi
+ */
+uint32_t crc_lld_compute(CRCDriver *crcp, uint32_t crc,
+                         size_t n, const uint8_t *buf) {
+
+  (void)crcp;
+  (void)n;
+  (void)buf;
+
+  return crc;
+}
+
+#endif /* HAL_USE_CRC == TRUE */
+
+/** @} */
@@ -0,0 +1,103 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crc_lld.h
+ * @brief   PLATFORM CRC subsystem low level driver header.
+ *
+ * @addtogroup CRC
+ * @{
+ */
+
+#ifndef HAL_CRC_LLD_H
+#define HAL_CRC_LLD_H
+
+#if (HAL_USE_CRC == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    PLATFORM configuration options
+ * @{
+ */
+/**
+ * @brief   CRCD1 driver enable switch.
+ * @details If set to @p TRUE the support for CRCD1 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(PLATFORM_CRC_USE_CRC1) || defined(__DOXYGEN__)
+#define PLATFORM_CRC_USE_CRC1               FALSE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the CRC driver structure.
+ */
+#define crc_lld_driver_fields                                               \
+  /* Dummy field, it is not needed.*/                                       \
+  uint32_t                  dummy
+
+/**
+ * @brief   Low level fields of the CRC configuration structure.
+ */
+#define crc_lld_config_fields                                               \
+  /* Dummy configuration, it is not needed.*/                               \
+  uint32_t                  dummy
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (PLATFORM_CRC_USE_CRC1 == TRUE) && !defined(__DOXYGEN__)
+extern CRCDriver CRCD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void crc_lld_init(void);
+  bool crc_lld_is_supported(const CRCConfig *config);
+  void crc_lld_start(CRCDriver *crcp);
+  void crc_lld_stop(CRCDriver *crcp);
+  uint32_t crc_lld_compute(CRCDriver *crcp, uint32_t crc,
+                           size_t n, const uint8_t *buf);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_CRC == TRUE */
+
+#endif /* HAL_CRC_LLD_H */
+
+/** @} */
@@ -0,0 +1,146 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_dcmi_lld.c
+ * @brief   PLATFORM DCMI subsystem low level driver source.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#include "hal.h"
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   DCMID1 driver identifier.
+ */
+#if (PLATFORM_DCMI_USE_DCMI1 == TRUE) || defined(__DOXYGEN__)
+DCMIDriver DCMID1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level DCMI driver initialization.
+ *
+ * @notapi
+ */
+void dcmi_lld_init(void) {
+
+#if PLATFORM_DCMI_USE_DCMI1 == TRUE
+  /* Driver initialization.*/
+  dcmiObjectInit(&DCMID1);
+#endif
+}
+
+/**
+ * @brief   Configures and activates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_start(DCMIDriver *dcmip) {
+
+  if (dcmip->state == DCMI_STOP) {
+    /* Enables the peripheral.*/
+#if PLATFORM_DCMI_USE_DCMI1 == TRUE
+    if (&DCMID1 == dcmip) {
+
+    }
+#endif
+  }
+  /* Configures the peripheral.*/
+
+}
+
+/**
+ * @brief   Deactivates the DCMI peripheral.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_stop(DCMIDriver *dcmip) {
+
+  if (dcmip->state == DCMI_READY) {
+    /* Resets the peripheral.*/
+
+    /* Disables the peripheral.*/
+#if PLATFORM_DCMI_USE_DCMI1 == TRUE
+    if (&DCMID1 == dcmip) {
+
+    }
+#endif
+  }
+}
+
+/**
+ * @brief   Starts a capture.
+ * @details The mode depends on the driver state, @p DCMI_ACTIVE for
+ *          continuous capture or @p DCMI_SNAPSHOT for a single frame.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ * @param[in] frame     first frame buffer
+ *
+ * @notapi
+ */
+void dcmi_lld_start_capture(DCMIDriver *dcmip, void *frame) {
+
+  (void)dcmip;
+  (void)frame;
+}
+
+/**
+ * @brief   Stops a capture.
+ * @details The buffers owned by the driver are released.
+ *
+ * @param[in] dcmip     pointer to the @p DCMIDriver object
+ *
+ * @notapi
+ */
+void dcmi_lld_stop_capture(DCMIDriver *dcmip) {
+
+  (void)dcmip;
+}
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+/** @} */
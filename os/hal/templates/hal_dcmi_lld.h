@@ -0,0 +1,102 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_dcmi_lld.h
+ * @brief   PLATFORM DCMI subsystem low level driver header.
+ *
+ * @addtogroup DCMI
+ * @{
+ */
+
+#ifndef HAL_DCMI_LLD_H
+#define HAL_DCMI_LLD_H
+
+#if (HAL_USE_DCMI == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    PLATFORM configuration options
+ * @{
+ */
+/**
+ * @brief   DCMID1 driver enable switch.
+ * @details If set to @p TRUE the support for DCMID1 is included.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(PLATFORM_DCMI_USE_DCMI1) || defined(__DOXYGEN__)
+#define PLATFORM_DCMI_USE_DCMI1             FALSE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level fields of the DCMI driver structure.
+ */
+#define dcmi_lld_driver_fields                                              \
+  /* Dummy field, it is not needed.*/                                       \
+  uint32_t                  dummy
+
+/**
+ * @brief   Low level fields of the DCMI configuration structure.
+ */
+#define dcmi_lld_config_fields                                              \
+  /* Dummy configuration, it is not needed.*/                               \
+  uint32_t                  dummy
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (PLATFORM_DCMI_USE_DCMI1 == TRUE) && !defined(__DOXYGEN__)
+extern DCMIDriver DCMID1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dcmi_lld_init(void);
+  void dcmi_lld_start(DCMIDriver *dcmip);
+  void dcmi_lld_stop(DCMIDriver *dcmip);
+  void dcmi_lld_start_capture(DCMIDriver *dcmip, void *frame);
+  void dcmi_lld_stop_capture(DCMIDriver *dcmip);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_DCMI == TRUE */
+
+#endif /* HAL_DCMI_LLD_H */
+
+/** @} */
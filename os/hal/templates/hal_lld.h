@@ -57,6 +57,11 @@
 #error "Using a wrong mcuconf.h file, PLATFORM_MCUCONF not defined"
 #endif
 
+/**
+ * @brief   Runtime clock scaling support.
+ */
+#define HAL_LLD_SUPPORTS_CLOCK_SCALING  FALSE
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
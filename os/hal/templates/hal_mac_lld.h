@@ -36,6 +36,11 @@
  */
 #define MAC_SUPPORTS_ZERO_COPY      TRUE
 
+/**
+ * @brief   This implementation does not support the PTP clock API.
+ */
+#define MAC_SUPPORTS_PTP            FALSE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
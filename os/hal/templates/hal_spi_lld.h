@@ -36,6 +36,11 @@
  */
 #define SPI_SUPPORTS_CIRCULAR           TRUE
 
+/**
+ * @brief   Slave mode support flag.
+ */
+#define SPI_SUPPORTS_SLAVE_MODE         FALSE
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -54,6 +54,13 @@
 #define HAL_USE_CAN                         TRUE
 #endif
 
+/**
+ * @brief   Enables the CRC subsystem.
+ */
+#if !defined(HAL_USE_CRC) || defined(__DOXYGEN__)
+#define HAL_USE_CRC                         TRUE
+#endif
+
 /**
  * @brief   Enables the cryptographic subsystem.
  */
@@ -68,6 +75,13 @@
 #define HAL_USE_DAC                         TRUE
 #endif
 
+/**
+ * @brief   Enables the DCMI subsystem.
+ */
+#if !defined(HAL_USE_DCMI) || defined(__DOXYGEN__)
+#define HAL_USE_DCMI                        TRUE
+#endif
+
 /**
  * @brief   Enables the EFlash subsystem.
  */
@@ -201,6 +215,13 @@
 #define HAL_USE_WSPI                        TRUE
 #endif
 
+/**
+ * @brief   Enables the runtime clock scaling subsystem.
+ */
+#if !defined(HAL_USE_CLOCK_SCALING) || defined(__DOXYGEN__)
+#define HAL_USE_CLOCK_SCALING               FALSE
+#endif
+
 /*===========================================================================*/
 /* PAL driver related settings.                                              */
 /*===========================================================================*/
@@ -259,6 +280,35 @@
 #define CAN_ENFORCE_USE_CALLBACKS           FALSE
 #endif
 
+/*===========================================================================*/
+/* CRC driver related settings.                                              */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the @p crcAcquireBus() and @p crcReleaseBus() APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(CRC_USE_MUTUAL_EXCLUSION) || defined(__DOXYGEN__)
+#define CRC_USE_MUTUAL_EXCLUSION            TRUE
+#endif
+
+/**
+ * @brief   Enables the software fallback.
+ * @details Configurations not supported by the hardware are served by a
+ *          table-driven software implementation.
+ */
+#if !defined(CRC_USE_SW_FALLBACK) || defined(__DOXYGEN__)
+#define CRC_USE_SW_FALLBACK                 TRUE
+#endif
+
+/**
+ * @brief   Number of tables used by the software fallback.
+ * @note    Valid values are 1, 4 or 8, each table takes 1kB of RAM.
+ */
+#if !defined(CRC_SW_SLICES) || defined(__DOXYGEN__)
+#define CRC_SW_SLICES                       4
+#endif
+
 /*===========================================================================*/
 /* CRY driver related settings.                                              */
 /*===========================================================================*/
@@ -281,6 +331,16 @@
 #define HAL_CRY_ENFORCE_FALLBACK            FALSE
 #endif
 
+/**
+ * @brief   Enables the asynchronous jobs API.
+ * @details Jobs are queued by the callers and executed by a service thread
+ *          provided by the application, completion is notified using a
+ *          callback.
+ */
+#if !defined(HAL_CRY_USE_JOBS) || defined(__DOXYGEN__)
+#define HAL_CRY_USE_JOBS                    FALSE
+#endif
+
 /*===========================================================================*/
 /* DAC driver related settings.                                              */
 /*===========================================================================*/
@@ -301,6 +361,14 @@
 #define DAC_USE_MUTUAL_EXCLUSION            TRUE
 #endif
 
+/**
+ * @brief   Enables the @p dacStartStreaming() API.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(DAC_USE_STREAMING) || defined(__DOXYGEN__)
+#define DAC_USE_STREAMING                   FALSE
+#endif
+
 /*===========================================================================*/
 /* I2C driver related settings.                                              */
 /*===========================================================================*/
@@ -312,6 +380,14 @@
 #define I2C_USE_MUTUAL_EXCLUSION            TRUE
 #endif
 
+/**
+ * @brief   Enables the asynchronous requests queue APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(I2C_USE_QUEUE) || defined(__DOXYGEN__)
+#define I2C_USE_QUEUE                       FALSE
+#endif
+
 /*===========================================================================*/
 /* MAC driver related settings.                                              */
 /*===========================================================================*/
@@ -330,6 +406,13 @@
 #define MAC_USE_EVENTS                      TRUE
 #endif
 
+/**
+ * @brief   Enables the IEEE 1588 PTP hardware clock and time stamps API.
+ */
+#if !defined(MAC_USE_PTP) || defined(__DOXYGEN__)
+#define MAC_USE_PTP                         FALSE
+#endif
+
 /*===========================================================================*/
 /* MMC_SPI driver related settings.                                          */
 /*===========================================================================*/
@@ -377,6 +460,26 @@
 #define SDC_NICE_WAITING                    TRUE
 #endif
 
+/**
+ * @brief   Pre-erase of multi-block writes.
+ * @details If enabled, multi-block writes to SD cards are preceded by an
+ *          ACMD23 command declaring the number of blocks to be written,
+ *          the card can pre-erase the area and program it faster.
+ */
+#if !defined(SDC_USE_PREERASE) || defined(__DOXYGEN__)
+#define SDC_USE_PREERASE                    FALSE
+#endif
+
+/**
+ * @brief   Include support for the fast bus modes.
+ * @details If enabled, eMMC devices are switched to the HS200 or DDR52
+ *          modes and SD cards to the UHS-I SDR50 or SDR104 modes when
+ *          supported by the card, the board and the low level driver.
+ */
+#if !defined(SDC_UHS_SUPPORT) || defined(__DOXYGEN__)
+#define SDC_UHS_SUPPORT                     FALSE
+#endif
+
 /**
  * @brief   OCR initialization constant for V20 cards.
  */
@@ -435,6 +538,14 @@
 #define SIO_USE_SYNCHRONIZATION             TRUE
 #endif
 
+/**
+ * @brief   Support for the DMA streaming mode.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(SIO_USE_STREAMING) || defined(__DOXYGEN__)
+#define SIO_USE_STREAMING                   FALSE
+#endif
+
 /*===========================================================================*/
 /* SERIAL_USB driver related setting.                                        */
 /*===========================================================================*/
@@ -478,6 +589,32 @@
 #define SPI_USE_CIRCULAR                    FALSE
 #endif
 
+/**
+ * @brief   Enables the slave mode APIs.
+ * @note    Requires @p PAL_USE_CALLBACKS for the NSS framing events.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_SLAVE) || defined(__DOXYGEN__)
+#define SPI_USE_SLAVE                       FALSE
+#endif
+
+/**
+ * @brief   Enables the segmented transactions APIs.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_TRANSACTIONS) || defined(__DOXYGEN__)
+#define SPI_USE_TRANSACTIONS                FALSE
+#endif
+
+/**
+ * @brief   Enables the requests queue APIs.
+ * @note    Requires @p SPI_USE_TRANSACTIONS.
+ * @note    Disabling this option saves both code and data space.
+ */
+#if !defined(SPI_USE_QUEUE) || defined(__DOXYGEN__)
+#define SPI_USE_QUEUE                       FALSE
+#endif
+
 /**
  * @brief   Enables the @p spiAcquireBus() and @p spiReleaseBus() APIs.
  * @note    Disabling this option saves both code and data space.
@@ -494,6 +631,25 @@
 #define SPI_SELECT_MODE                     SPI_SELECT_MODE_PAD
 #endif
 
+/*===========================================================================*/
+/* TRNG driver related settings.                                             */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the entropy pool.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(TRNG_USE_POOL) || defined(__DOXYGEN__)
+#define TRNG_USE_POOL                       FALSE
+#endif
+
+/**
+ * @brief   Entropy pool size in bytes.
+ */
+#if !defined(TRNG_POOL_SIZE) || defined(__DOXYGEN__)
+#define TRNG_POOL_SIZE                      256
+#endif
+
 /*===========================================================================*/
 /* UART driver related settings.                                             */
 /*===========================================================================*/
@@ -514,6 +670,14 @@
 #define UART_USE_MUTUAL_EXCLUSION           TRUE
 #endif
 
+/**
+ * @brief   Enables the ring receive mode APIs.
+ * @note    Requires a low level driver supporting it.
+ */
+#if !defined(UART_USE_RING) || defined(__DOXYGEN__)
+#define UART_USE_RING                       FALSE
+#endif
+
 /*===========================================================================*/
 /* USB driver related settings.                                              */
 /*===========================================================================*/
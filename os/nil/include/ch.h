@@ -175,6 +175,14 @@
 #include "chconf.h"
 #include "chlicense.h"
 
+/**
+ * @brief   Threads bitmaps.
+ * @note    This option is optional in chconf.h, the default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_BITMAPS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_BITMAPS                  FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -511,6 +519,27 @@ struct nil_os_instance {
    *          or to an higher priority thread if a switch is required.
    */
   thread_t              *next;
+#if (CH_CFG_USE_BITMAPS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Mask of the ready threads.
+   * @note    The bit of the idle thread is always set.
+   */
+  uint32_t              rdymask;
+  /**
+   * @brief   Mask of the threads waiting with a timeout.
+   */
+  uint32_t              tmomask;
+#if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Ticks elapsed since the timeout counters have been updated.
+   */
+  sysinterval_t         tmoelapsed;
+  /**
+   * @brief   Lowest timeout counter, meaningful if @p tmomask is not zero.
+   */
+  sysinterval_t         tmonext;
+#endif
+#endif
 #if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
   /**
    * @brief   System time.
@@ -31,6 +31,13 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Bit of a thread in the threads bitmaps.
+ */
+#define NIL_THD_BIT(tp)     ((uint32_t)1 << (uint32_t)((tp) - &nil.threads[0]))
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -44,10 +51,102 @@ os_instance_t nil;
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   De Bruijn sequence table for the lowest bit set lookup.
+ * @note    Cores without a count leading zeros instruction, like the
+ *          Cortex-M0, only need a multiply and a table access.
+ */
+static const uint8_t nil_debruijn[32] = {
+  0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,
+  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+  31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,
+  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+};
+#endif
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_BITMAPS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the highest priority thread in a threads bitmap.
+ *
+ * @param[in] mask      threads bitmap, must not be zero
+ * @return              The pointer to the thread.
+ *
+ * @notapi
+ */
+static inline thread_t *nil_first_thread(uint32_t mask) {
+
+  return &nil.threads[nil_debruijn[((mask & (0U - mask)) *
+                                    0x077CB531U) >> 27]];
+}
+
+/**
+ * @brief   Timeout of a thread.
+ * @note    The lock is not released between threads because only the
+ *          threads waiting with a timeout are processed.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+static void nil_thread_timeout(thread_t *tp) {
+
+  /* Timeout on thread queues requires a special handling because the
+     counter must be incremented.*/
+  if (NIL_THD_IS_WTQUEUE(tp)) {
+    tp->u1.tqp->cnt++;
+  }
+  else {
+    if (NIL_THD_IS_SUSPENDED(tp)) {
+      *tp->u1.trp = NULL;
+    }
+  }
+  (void) chSchReadyI(tp, MSG_TIMEOUT);
+}
+
+#if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Updates the timeout counters of the waiting threads.
+ * @details The ticks elapsed since the previous update are subtracted from
+ *          the counters, the threads reaching zero are made ready.
+ *
+ * @notapi
+ */
+static void nil_update_timeouts(void) {
+  sysinterval_t elapsed = nil.tmoelapsed;
+  sysinterval_t next = TIME_MAX_INTERVAL;
+  uint32_t mask = nil.tmomask;
+
+  nil.tmoelapsed = (sysinterval_t)0;
+  while (mask != 0U) {
+    thread_t *tp = nil_first_thread(mask);
+    sysinterval_t timeout = tp->timeout;
+
+    mask &= mask - 1U;
+
+    chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
+    chDbgAssert(timeout >= elapsed, "skipped one");
+
+    /* The volatile field is updated once, here.*/
+    timeout -= elapsed;
+    tp->timeout = timeout;
+
+    if (timeout == (sysinterval_t)0) {
+      nil_thread_timeout(tp);
+    }
+    else if (timeout < next) {
+      next = timeout;
+    }
+  }
+  nil.tmonext = next;
+}
+#endif
+#endif /* CH_CFG_USE_BITMAPS == TRUE */
+
 /*===========================================================================*/
 /* Module interrupt handlers.                                                */
 /*===========================================================================*/
@@ -287,6 +386,9 @@ void chSysInit(void) {
   /* Making idle the current thread, this may change after rescheduling.*/
   nil.next = nil.current = &nil.threads[CH_CFG_MAX_THREADS];
   nil.current->state = NIL_STATE_READY;
+#if CH_CFG_USE_BITMAPS == TRUE
+  nil.rdymask = NIL_THD_BIT(nil.current);
+#endif
 
 #if CH_DBG_ENABLE_STACK_CHECK == TRUE
   /* The idle thread is a special case because its stack is set up by the
@@ -356,7 +458,17 @@ void chSysTimerHandlerI(void) {
 
   chDbgCheckClassI();
 
-#if CH_CFG_ST_TIMEDELTA == 0
+#if (CH_CFG_ST_TIMEDELTA == 0) && (CH_CFG_USE_BITMAPS == TRUE)
+  nil.systime++;
+
+  /* Counters are only updated when the lowest one expires.*/
+  if (nil.tmomask != 0U) {
+    nil.tmoelapsed++;
+    if (nil.tmoelapsed >= nil.tmonext) {
+      nil_update_timeouts();
+    }
+  }
+#elif CH_CFG_ST_TIMEDELTA == 0
   thread_t *tp = &nil.threads[0];
   nil.systime++;
   do {
@@ -389,6 +501,46 @@ void chSysTimerHandlerI(void) {
     tp++;
     chSysLockFromISR();
   } while (tp < &nil.threads[CH_CFG_MAX_THREADS]);
+#elif CH_CFG_USE_BITMAPS == TRUE
+  uint32_t mask = nil.tmomask;
+  sysinterval_t next = (sysinterval_t)0;
+
+  chDbgAssert(nil.nexttime == port_timer_get_alarm(), "time mismatch");
+
+  /* Only the threads waiting with a timeout are processed.*/
+  while (mask != 0U) {
+    thread_t *tp = nil_first_thread(mask);
+    sysinterval_t timeout = tp->timeout;
+
+    mask &= mask - 1U;
+
+    chDbgAssert(!NIL_THD_IS_READY(tp), "is ready");
+    chDbgAssert(timeout >= chTimeDiffX(nil.lasttime, nil.nexttime),
+                "skipped one");
+
+    /* The volatile field is updated once, here.*/
+    timeout -= chTimeDiffX(nil.lasttime, nil.nexttime);
+    tp->timeout = timeout;
+
+    if (timeout == (sysinterval_t)0) {
+      nil_thread_timeout(tp);
+    }
+    else {
+      if (timeout <= (sysinterval_t)(next - (sysinterval_t)1)) {
+        next = timeout;
+      }
+    }
+  }
+
+  nil.lasttime = nil.nexttime;
+  if (next > (sysinterval_t)0) {
+    nil.nexttime = chTimeAddX(nil.nexttime, next);
+    port_timer_set_alarm(nil.nexttime);
+  }
+  else {
+    /* No tick event needed.*/
+    port_timer_stop_alarm();
+  }
 #else
   thread_t *tp = &nil.threads[0];
   sysinterval_t next = (sysinterval_t)0;
@@ -588,6 +740,10 @@ thread_t *chSchReadyI(thread_t *tp, msg_t msg) {
   tp->u1.msg = msg;
   tp->state = NIL_STATE_READY;
   tp->timeout = (sysinterval_t)0;
+#if CH_CFG_USE_BITMAPS == TRUE
+  nil.rdymask |= NIL_THD_BIT(tp);
+  nil.tmomask &= ~NIL_THD_BIT(tp);
+#endif
   if (tp < nil.next) {
     nil.next = tp;
   }
@@ -670,6 +826,9 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
 
   /* Storing the wait object for the current thread.*/
   otp->state = newstate;
+#if CH_CFG_USE_BITMAPS == TRUE
+  nil.rdymask &= ~NIL_THD_BIT(otp);
+#endif
 
 #if CH_CFG_ST_TIMEDELTA > 0
   if (timeout != TIME_INFINITE) {
@@ -700,13 +859,46 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
 
     /* Timeout settings.*/
     otp->timeout = abstime - nil.lasttime;
+#if CH_CFG_USE_BITMAPS == TRUE
+    nil.tmomask |= NIL_THD_BIT(otp);
+#endif
   }
 #else
+#if CH_CFG_USE_BITMAPS == TRUE
+  if (timeout != TIME_INFINITE) {
+    if (nil.tmomask == 0U) {
+      nil.tmoelapsed = (sysinterval_t)0;
+      nil.tmonext    = timeout;
+    }
+    else {
+      /* Counters are relative to the last update, the counters are updated
+         now if the elapsed ticks cannot be added without overflowing.*/
+      if (timeout > (sysinterval_t)(TIME_MAX_INTERVAL - nil.tmoelapsed)) {
+        nil_update_timeouts();
+      }
+      timeout += nil.tmoelapsed;
+      if (timeout < nil.tmonext) {
+        nil.tmonext = timeout;
+      }
+    }
+    nil.tmomask |= NIL_THD_BIT(otp);
+  }
+#endif
 
   /* Timeout settings.*/
   otp->timeout = timeout;
 #endif
 
+#if CH_CFG_USE_BITMAPS == TRUE
+  /* The highest priority ready thread is found in the bitmap.*/
+  ntp = nil_first_thread(nil.rdymask);
+  nil.current = nil.next = ntp;
+  if (ntp == &nil.threads[CH_CFG_MAX_THREADS]) {
+    CH_CFG_IDLE_ENTER_HOOK();
+  }
+  port_switch(ntp, otp);
+  return nil.current->u1.msg;
+#else
   /* Scanning the whole threads array.*/
   ntp = nil.threads;
   while (true) {
@@ -725,6 +917,7 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
     chDbgAssert(ntp <= &nil.threads[CH_CFG_MAX_THREADS],
                 "pointer out of range");
   }
+#endif
 }
 
 /**
@@ -58,6 +58,17 @@
 #define CH_CFG_AUTOSTART_THREADS            TRUE
 #endif
 
+/**
+ * @brief   Threads bitmaps.
+ * @details If enabled the kernel keeps bitmaps of the ready threads and of
+ *          the threads waiting with a timeout, scheduling and timeouts
+ *          handling do not require to scan the threads array.
+ * @note    This option increases the code size slightly.
+ */
+#if !defined(CH_CFG_USE_BITMAPS)
+#define CH_CFG_USE_BITMAPS                  FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -217,6 +228,20 @@
 #define CH_CFG_USE_HEAP                     TRUE
 #endif
 
+/**
+ * @brief   Constant time heap allocator.
+ * @details If enabled then the memory heap uses a two levels segregated
+ *          fit allocator (TLSF) instead of a first-fit free list, the
+ *          allocation and release times do not depend on the heap
+ *          fragmentation.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -354,6 +379,15 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Number of buckets of the names hash index.
+ * @details If the specified value is zero then objects are searched by
+ *          scanning the lists, else it must be a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_BUCKETS)
+#define CH_CFG_FACTORY_HASH_BUCKETS         0
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -84,6 +84,73 @@ typedef msg_t (*delegate_fn3_t)(msg_t p1, msg_t p2, msg_t p3);
  */
 typedef msg_t (*delegate_fn4_t)(msg_t p1, msg_t p2, msg_t p3, msg_t p4);
 
+/**
+ * @brief   Type of an asynchronous delegate call.
+ */
+typedef struct ch_delegate_call delegate_call_t;
+
+/**
+ * @brief   Structure representing an asynchronous delegate call.
+ * @details The object is owned by the caller, it must not be modified
+ *          or reused until the call has been executed.
+ */
+struct ch_delegate_call {
+  /**
+   * @brief   Next call in the delegate queue.
+   */
+  delegate_call_t           *next;
+  /**
+   * @brief   Function to be called.
+   */
+  union {
+    delegate_fn0_t          fn0;
+    delegate_fn1_t          fn1;
+    delegate_fn2_t          fn2;
+    delegate_fn3_t          fn3;
+    delegate_fn4_t          fn4;
+  } func;
+  /**
+   * @brief   Number of function parameters.
+   */
+  unsigned                  argc;
+  /**
+   * @brief   Function parameters.
+   */
+  msg_t                     args[4];
+  /**
+   * @brief   Function return value, valid after execution.
+   */
+  msg_t                     result;
+  /**
+   * @brief   Call executed flag.
+   */
+  volatile bool             done;
+  /**
+   * @brief   Thread waiting for the call execution or @p NULL.
+   */
+  thread_reference_t        waiter;
+};
+
+/**
+ * @brief   Type of a delegate queue.
+ * @details Asynchronous calls are queued in FIFO order, the dispatcher
+ *          thread executes all the queued calls on each wakeup.
+ */
+typedef struct ch_delegate_queue {
+  /**
+   * @brief   First queued call or @p NULL.
+   */
+  delegate_call_t           *first;
+  /**
+   * @brief   Last queued call, valid if @p first is not @p NULL.
+   */
+  delegate_call_t           *last;
+  /**
+   * @brief   Waiting dispatcher thread or @p NULL.
+   */
+  thread_reference_t        tr;
+} delegate_queue_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -103,6 +170,11 @@ extern "C" {
   void chDelegateDispatch(void);
   msg_t chDelegateDispatchTimeout(sysinterval_t timeout);
   msg_t chDelegateCallVeneer(thread_t *tp, delegate_veneer_t veneer, ...);
+  void chDelegatePostI(delegate_queue_t *dqp, delegate_call_t *dcp);
+  void chDelegatePost(delegate_queue_t *dqp, delegate_call_t *dcp);
+  msg_t chDelegateWaitTimeout(delegate_call_t *dcp, sysinterval_t timeout);
+  msg_t chDelegateDispatchQueueTimeout(delegate_queue_t *dqp,
+                                       sysinterval_t timeout);
 #ifdef __cplusplus
 }
 #endif
@@ -201,6 +273,175 @@ static inline msg_t chDelegateCallDirect4(thread_t *tp, delegate_fn4_t func,
   return chDelegateCallVeneer(tp, __ch_delegate_fn4, func, p1, p2, p3, p4);
 }
 
+/**
+ * @brief   Initializes a delegate queue object.
+ *
+ * @param[out] dqp      pointer to a @p delegate_queue_t structure
+ *
+ * @init
+ */
+static inline void chDelegateQueueObjectInit(delegate_queue_t *dqp) {
+
+  dqp->first = NULL;
+  dqp->last  = NULL;
+  dqp->tr    = NULL;
+}
+
+/**
+ * @brief   Initializes an asynchronous call to a function with no
+ *          parameters.
+ *
+ * @param[out] dcp      pointer to a @p delegate_call_t structure
+ * @param[in] func      pointer to the function to be called
+ *
+ * @init
+ */
+static inline void chDelegateCallObjectInit0(delegate_call_t *dcp,
+                                             delegate_fn0_t func) {
+
+  dcp->func.fn0 = func;
+  dcp->argc     = 0U;
+  dcp->done     = true;
+  dcp->waiter   = NULL;
+}
+
+/**
+ * @brief   Initializes an asynchronous call to a function with one
+ *          parameter.
+ *
+ * @param[out] dcp      pointer to a @p delegate_call_t structure
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ *
+ * @init
+ */
+static inline void chDelegateCallObjectInit1(delegate_call_t *dcp,
+                                             delegate_fn1_t func,
+                                             msg_t p1) {
+
+  dcp->func.fn1 = func;
+  dcp->argc     = 1U;
+  dcp->args[0]  = p1;
+  dcp->done     = true;
+  dcp->waiter   = NULL;
+}
+
+/**
+ * @brief   Initializes an asynchronous call to a function with two
+ *          parameters.
+ *
+ * @param[out] dcp      pointer to a @p delegate_call_t structure
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ *
+ * @init
+ */
+static inline void chDelegateCallObjectInit2(delegate_call_t *dcp,
+                                             delegate_fn2_t func,
+                                             msg_t p1, msg_t p2) {
+
+  dcp->func.fn2 = func;
+  dcp->argc     = 2U;
+  dcp->args[0]  = p1;
+  dcp->args[1]  = p2;
+  dcp->done     = true;
+  dcp->waiter   = NULL;
+}
+
+/**
+ * @brief   Initializes an asynchronous call to a function with three
+ *          parameters.
+ *
+ * @param[out] dcp      pointer to a @p delegate_call_t structure
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ * @param[in] p3        parameter 3 passed as a @p msg_t
+ *
+ * @init
+ */
+static inline void chDelegateCallObjectInit3(delegate_call_t *dcp,
+                                             delegate_fn3_t func,
+                                             msg_t p1, msg_t p2, msg_t p3) {
+
+  dcp->func.fn3 = func;
+  dcp->argc     = 3U;
+  dcp->args[0]  = p1;
+  dcp->args[1]  = p2;
+  dcp->args[2]  = p3;
+  dcp->done     = true;
+  dcp->waiter   = NULL;
+}
+
+/**
+ * @brief   Initializes an asynchronous call to a function with four
+ *          parameters.
+ *
+ * @param[out] dcp      pointer to a @p delegate_call_t structure
+ * @param[in] func      pointer to the function to be called
+ * @param[in] p1        parameter 1 passed as a @p msg_t
+ * @param[in] p2        parameter 2 passed as a @p msg_t
+ * @param[in] p3        parameter 3 passed as a @p msg_t
+ * @param[in] p4        parameter 4 passed as a @p msg_t
+ *
+ * @init
+ */
+static inline void chDelegateCallObjectInit4(delegate_call_t *dcp,
+                                             delegate_fn4_t func,
+                                             msg_t p1, msg_t p2, msg_t p3,
+                                             msg_t p4) {
+
+  dcp->func.fn4 = func;
+  dcp->argc     = 4U;
+  dcp->args[0]  = p1;
+  dcp->args[1]  = p2;
+  dcp->args[2]  = p3;
+  dcp->args[3]  = p4;
+  dcp->done     = true;
+  dcp->waiter   = NULL;
+}
+
+/**
+ * @brief   Returns @p true if an asynchronous call has been executed.
+ * @note    A call object that has never been posted is reported as executed.
+ *
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ * @return              The call state.
+ *
+ * @xclass
+ */
+static inline bool chDelegateIsDoneX(const delegate_call_t *dcp) {
+
+  return dcp->done;
+}
+
+/**
+ * @brief   Returns the return value of an executed asynchronous call.
+ *
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ * @return              The function return value as a @p msg_t.
+ *
+ * @xclass
+ */
+static inline msg_t chDelegateGetResultX(const delegate_call_t *dcp) {
+
+  return dcp->result;
+}
+
+/**
+ * @brief   Dispatches the calls queued in a delegate queue.
+ * @details The function waits for queued calls then executes all of them.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t structure
+ *
+ * @api
+ */
+static inline void chDelegateDispatchQueue(delegate_queue_t *dqp) {
+
+  (void) chDelegateDispatchQueueTimeout(dqp, TIME_INFINITE);
+}
+
 #endif /* CH_CFG_USE_DELEGATES == TRUE */
 
 #endif /* CHDELEGATES_H */
@@ -96,6 +96,15 @@
 #define CH_CFG_FACTORY_PIPES                TRUE
 #endif
 
+/**
+ * @brief   Number of buckets of the names hash index.
+ * @details If the specified value is zero then objects are searched by
+ *          scanning the lists, else it must be a power of two.
+ */
+#if !defined(CH_CFG_FACTORY_HASH_BUCKETS) || defined(__DOXYGEN__)
+#define CH_CFG_FACTORY_HASH_BUCKETS         0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -143,6 +152,12 @@
 #error "invalid CH_CFG_FACTORY_MAX_NAMES_LENGTH value"
 #endif
 
+#if (CH_CFG_FACTORY_HASH_BUCKETS < 0) ||                                    \
+    (CH_CFG_FACTORY_HASH_BUCKETS > 256) ||                                  \
+    ((CH_CFG_FACTORY_HASH_BUCKETS & (CH_CFG_FACTORY_HASH_BUCKETS - 1)) != 0)
+#error "invalid CH_CFG_FACTORY_HASH_BUCKETS value"
+#endif
+
 #if (CH_CFG_USE_MUTEXES == FALSE) && (CH_CFG_USE_SEMAPHORES == FALSE)
 #error "CH_CFG_USE_FACTORY requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
@@ -175,6 +190,12 @@ typedef struct ch_dyn_element {
    * @brief   Number of references to this object.
    */
   ucnt_t                refs;
+#if (CH_CFG_FACTORY_HASH_BUCKETS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Hash of the object name.
+   */
+  uint32_t              hash;
+#endif
 #if (CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0) || defined(__DOXYGEN__)
   char                  name[CH_CFG_FACTORY_MAX_NAMES_LENGTH];
 #else
@@ -186,7 +207,14 @@ typedef struct ch_dyn_element {
  * @brief   Type of a dynamic object list.
  */
 typedef struct ch_dyn_list {
-    dyn_element_t       *next;
+#if (CH_CFG_FACTORY_HASH_BUCKETS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Hash buckets, each one is a @p NULL terminated list.
+   */
+  dyn_element_t         *buckets[CH_CFG_FACTORY_HASH_BUCKETS];
+#else
+  dyn_element_t         *next;
+#endif
 } dyn_list_t;
 
 #if (CH_CFG_FACTORY_OBJECTS_REGISTRY == TRUE) || defined(__DOXYGEN__)
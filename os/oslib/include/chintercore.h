@@ -0,0 +1,294 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chintercore.h
+ * @brief   Inter-core channels macros and structures.
+ * @details This module implements a channel of objects between two cores
+ *          sharing a memory area, the API is the same of the objects
+ *          FIFOs.<br>
+ *          The objects and two single producer single consumer rings of
+ *          objects indexes are allocated in the shared memory, each core
+ *          uses a local channel object referring to the shared part:
+ *          - <b>Take</b>: A free object is taken from the free ring, can
+ *            be blocking.
+ *          - <b>Send</b>: An object is posted in the sent ring and the
+ *            other core is notified, it is guaranteed to be non-blocking.
+ *          - <b>Receive</b>: An object is fetched from the sent ring, can
+ *            be blocking.
+ *          - <b>Return</b>: An object is posted in the free ring and the
+ *            other core is notified, it is guaranteed to be non-blocking.
+ *          .
+ *          The rings are lock-free, the notification of the other core is
+ *          performed by a callback, usually ringing a doorbell interrupt,
+ *          the doorbell handler on the other core must call
+ *          @p chICDoorbellI() in order to wake up the waiting threads.
+ * @pre     The shared memory area must not be cached or must be coherent
+ *          between the cores and must be mapped at the same address on
+ *          both cores.
+ *
+ * @addtogroup oslib_intercore
+ * @{
+ */
+
+#ifndef CHINTERCORE_H
+#define CHINTERCORE_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a notification callback.
+ * @note    The callback is invoked in I-class context.
+ *
+ * @param[in] p         parameter of the callback
+ */
+typedef void (*icnotify_t)(void *p);
+
+/**
+ * @brief   Type of a single producer single consumer ring.
+ * @note    The counters are free running, the number of objects in the
+ *          ring is their difference.
+ */
+typedef struct {
+  /**
+   * @brief   Number of objects written, updated by the producer core.
+   */
+  volatile uint32_t         wrcnt;
+  /**
+   * @brief   Number of objects read, updated by the consumer core.
+   */
+  volatile uint32_t         rdcnt;
+  /**
+   * @brief   Ring slots, one for each object.
+   */
+  volatile uint32_t         *slots;
+} ic_ring_t;
+
+/**
+ * @brief   Type of the shared part of an inter-core channel.
+ * @note    This structure must be allocated in the shared memory.
+ */
+typedef struct ch_ic_shared {
+  /**
+   * @brief   Ring of the sent objects.
+   */
+  ic_ring_t                 sent;
+  /**
+   * @brief   Ring of the free objects.
+   */
+  ic_ring_t                 free;
+  /**
+   * @brief   Size of objects.
+   */
+  size_t                    objsize;
+  /**
+   * @brief   Number of objects.
+   */
+  uint32_t                  objn;
+  /**
+   * @brief   Objects buffer.
+   */
+  uint8_t                   *objbuf;
+} ic_shared_t;
+
+/**
+ * @brief   Type of the local part of an inter-core channel.
+ */
+typedef struct ch_ic_channel {
+  /**
+   * @brief   Shared part of the channel.
+   */
+  ic_shared_t               *shp;
+  /**
+   * @brief   Notification of the other core.
+   */
+  icnotify_t                notify;
+  /**
+   * @brief   Notification callback parameter.
+   */
+  void                      *param;
+  /**
+   * @brief   Threads waiting for objects.
+   */
+  threads_queue_t           waiting;
+} ic_channel_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chICSharedObjectInit(ic_shared_t *shp, size_t objsize, uint32_t objn,
+                            void *objbuf, uint32_t *sentbuf,
+                            uint32_t *freebuf);
+  void chICObjectInit(ic_channel_t *icp, ic_shared_t *shp,
+                      icnotify_t notify, void *param);
+  void chICDoorbellI(ic_channel_t *icp);
+  void *chICTakeObjectI(ic_channel_t *icp);
+  void *chICTakeObjectTimeoutS(ic_channel_t *icp, sysinterval_t timeout);
+  void chICSendObjectI(ic_channel_t *icp, void *objp);
+  msg_t chICReceiveObjectI(ic_channel_t *icp, void **objpp);
+  msg_t chICReceiveObjectTimeoutS(ic_channel_t *icp, void **objpp,
+                                  sysinterval_t timeout);
+  void chICReturnObjectI(ic_channel_t *icp, void *objp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Allocates a free object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if an object is not available within the specified
+ *                      timeout.
+ *
+ * @api
+ */
+static inline void *chICTakeObjectTimeout(ic_channel_t *icp,
+                                          sysinterval_t timeout) {
+  void *objp;
+
+  chSysLock();
+  objp = chICTakeObjectTimeoutS(icp, timeout);
+  chSysUnlock();
+
+  return objp;
+}
+
+/**
+ * @brief   Posts an object.
+ * @note    By design the object can be always immediately posted.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be posted
+ *
+ * @sclass
+ */
+static inline void chICSendObjectS(ic_channel_t *icp, void *objp) {
+
+  chICSendObjectI(icp, objp);
+  chSchRescheduleS();
+}
+
+/**
+ * @brief   Posts an object.
+ * @note    By design the object can be always immediately posted.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be posted
+ *
+ * @api
+ */
+static inline void chICSendObject(ic_channel_t *icp, void *objp) {
+
+  chSysLock();
+  chICSendObjectS(icp, objp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Fetches an object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objpp     pointer to the fetched object reference
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t chICReceiveObjectTimeout(ic_channel_t *icp,
+                                             void **objpp,
+                                             sysinterval_t timeout) {
+  msg_t msg;
+
+  chSysLock();
+  msg = chICReceiveObjectTimeoutS(icp, objpp, timeout);
+  chSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Releases a fetched object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be released
+ *
+ * @sclass
+ */
+static inline void chICReturnObjectS(ic_channel_t *icp, void *objp) {
+
+  chICReturnObjectI(icp, objp);
+  chSchRescheduleS();
+}
+
+/**
+ * @brief   Releases a fetched object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be released
+ *
+ * @api
+ */
+static inline void chICReturnObject(ic_channel_t *icp, void *objp) {
+
+  chSysLock();
+  chICReturnObjectS(icp, objp);
+  chSysUnlock();
+}
+
+#endif /* CHINTERCORE_H */
+
+/** @} */
@@ -90,6 +90,18 @@ typedef struct ch_jobs_queue {
  */
 typedef void (*job_function_t)(void *arg);
 
+/**
+ * @brief   Type of a job completion object.
+ * @details A completion object is signaled each time a job referring it
+ *          has been executed, it can be shared among several jobs.
+ */
+typedef struct ch_job_completion {
+  /**
+   * @brief   Counter of the completed jobs.
+   */
+  semaphore_t               sem;
+} job_completion_t;
+
 /**
  * @brief   Type of a job descriptor.
  */
@@ -102,6 +114,11 @@ typedef struct ch_job_descriptor {
    * @brief   Argument to be passed to the job function.
    */
   void                      *jobarg;
+  /**
+   * @brief   Completion object to be signaled or @p NULL.
+   * @note    It is @p NULL in jobs returned by @p chJobGet() and variants.
+   */
+  job_completion_t          *completion;
 } job_descriptor_t;
 
 /*===========================================================================*/
@@ -140,9 +157,16 @@ static inline void chJobObjectInit(jobs_queue_t *jqp,
                                    size_t jobsn,
                                    job_descriptor_t *jobsbuf,
                                    msg_t *msgbuf) {
+  size_t i;
 
   chDbgCheck((jobsn > 0U) && (jobsbuf != NULL) && (msgbuf != NULL));
 
+  /* Free jobs have no completion object, it is restored when a job is
+     returned to the pool.*/
+  for (i = 0U; i < jobsn; i++) {
+    jobsbuf[i].completion = NULL;
+  }
+
   chGuardedPoolObjectInit(&jqp->free, sizeof (job_descriptor_t));
   chGuardedPoolLoadArray(&jqp->free, (void *)jobsbuf, jobsn);
   chMBObjectInit(&jqp->mbx, msgbuf, jobsn);
@@ -313,8 +337,118 @@ static inline void chJobPostAhead(jobs_queue_t *jqp, job_descriptor_t *jp) {
   chDbgAssert(msg == MSG_OK, "post failed");
 }
 
+/**
+ * @brief   Posts multiple job objects.
+ * @details All jobs are posted within the same critical zone, this allows
+ *          an ISR to enqueue a whole batch of jobs under a single lock.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] jqp       pointer to a @p jobs_queue_t structure
+ * @param[in] jpp       pointer to an array of pointers to the job objects
+ *                      to be posted
+ * @param[in] n         number of job objects to be posted
+ *
+ * @iclass
+ */
+static inline void chJobPostBatchI(jobs_queue_t *jqp,
+                                   job_descriptor_t * const *jpp,
+                                   size_t n) {
+
+  chDbgCheckClassI();
+  chDbgCheck((jpp != NULL) || (n == 0U));
+
+  while (n > 0U) {
+    chJobPostI(jqp, *jpp);
+    jpp++;
+    n--;
+  }
+}
+
+/**
+ * @brief   Posts multiple job objects.
+ * @details All jobs are posted within the same critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] jqp       pointer to a @p jobs_queue_t structure
+ * @param[in] jpp       pointer to an array of pointers to the job objects
+ *                      to be posted
+ * @param[in] n         number of job objects to be posted
+ *
+ * @api
+ */
+static inline void chJobPostBatch(jobs_queue_t *jqp,
+                                  job_descriptor_t * const *jpp,
+                                  size_t n) {
+
+  chSysLock();
+  chJobPostBatchI(jqp, jpp, n);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Initializes a job completion object.
+ *
+ * @param[out] jcp      pointer to a @p job_completion_t structure
+ *
+ * @init
+ */
+static inline void chJobCompletionObjectInit(job_completion_t *jcp) {
+
+  chSemObjectInit(&jcp->sem, (cnt_t)0);
+}
+
+/**
+ * @brief   Waits for the completion of a job.
+ * @details Each successful wait consumes one completed job among those
+ *          referring the completion object.
+ *
+ * @param[in] jcp       pointer to a @p job_completion_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The wait outcome.
+ * @retval MSG_OK       if a job has been completed.
+ * @retval MSG_TIMEOUT  if a timeout occurred.
+ *
+ * @api
+ */
+static inline msg_t chJobWaitCompletionTimeout(job_completion_t *jcp,
+                                               sysinterval_t timeout) {
+
+  return chSemWaitTimeout(&jcp->sem, timeout);
+}
+
+/**
+ * @brief   Executes a job and returns it to its queue.
+ *
+ * @param[in] jqp       pointer to the @p jobs_queue_t owning the job
+ * @param[in] jp        pointer to the job object to be executed
+ *
+ * @notapi
+ */
+static inline void __job_execute(jobs_queue_t *jqp, job_descriptor_t *jp) {
+  job_completion_t *jcp = jp->completion;
+
+  /* Invoking the job function.*/
+  jp->jobfunc(jp->jobarg);
+
+  /* Returning the job descriptor object.*/
+  jp->completion = NULL;
+  chGuardedPoolFree(&jqp->free, (void *)jp);
+
+  /* Signaling the job completion, if required.*/
+  if (jcp != NULL) {
+    chSemSignal(&jcp->sem);
+  }
+}
+
 /**
  * @brief   Waits for a job then executes it.
+ * @note    Multiple worker threads can dispatch from the same queue, jobs
+ *          are handed to the waiting workers in FIFO order.
  *
  * @param[in] jqp       pointer to a @p jobs_queue_t structure
  * @return              The function outcome.
@@ -333,12 +467,7 @@ static inline msg_t chJobDispatch(jobs_queue_t *jqp) {
     chDbgAssert(jp != NULL, "is NULL");
 
     if (jp->jobfunc != NULL) {
-
-      /* Invoking the job function.*/
-      jp->jobfunc(jp->jobarg);
-
-      /* Returning the job descriptor object.*/
-      chGuardedPoolFree(&jqp->free, (void *)jp);
+      __job_execute(jqp, jp);
     }
     else {
       msg = MSG_JOB_NULL;
@@ -375,12 +504,7 @@ static inline msg_t chJobDispatchTimeout(jobs_queue_t *jqp,
     chDbgAssert(jp != NULL, "is NULL");
 
     if (jp->jobfunc != NULL) {
-
-      /* Invoking the job function.*/
-      jp->jobfunc(jp->jobarg);
-
-      /* Returning the job descriptor object.*/
-      chGuardedPoolFree(&jqp->free, (void *)jp);
+      __job_execute(jqp, jp);
     }
     else {
       msg = MSG_JOB_NULL;
@@ -390,6 +514,51 @@ static inline msg_t chJobDispatchTimeout(jobs_queue_t *jqp,
   return msg;
 }
 
+/**
+ * @brief   Steals a job from a queue and executes it.
+ * @details The oldest pending job is taken from the queue without waiting,
+ *          this allows an idle worker to help with the jobs of another
+ *          queue. Null jobs are never stolen, they are meant for the
+ *          queue's own workers.
+ *
+ * @param[in] jqp       pointer to the @p jobs_queue_t to steal from
+ * @return              The function outcome.
+ * @retval MSG_OK       if a job has been stolen and executed.
+ * @retval MSG_TIMEOUT  if there was no job to be stolen.
+ *
+ * @api
+ */
+static inline msg_t chJobSteal(jobs_queue_t *jqp) {
+  job_descriptor_t *jp = NULL;
+
+  chSysLock();
+  if (chMBGetUsedCountI(&jqp->mbx) > (size_t)0) {
+    jp = (job_descriptor_t *)chMBPeekI(&jqp->mbx);
+
+    chDbgAssert(jp != NULL, "is NULL");
+
+    if (jp->jobfunc != NULL) {
+      msg_t msg, jmsg;
+
+      msg = chMBFetchI(&jqp->mbx, &jmsg);
+      chDbgAssert((msg == MSG_OK) && (jmsg == (msg_t)jp), "fetch failed");
+    }
+    else {
+      jp = NULL;
+    }
+  }
+  chSchRescheduleS();
+  chSysUnlock();
+
+  if (jp == NULL) {
+    return MSG_TIMEOUT;
+  }
+
+  __job_execute(jqp, jp);
+
+  return MSG_OK;
+}
+
 #endif /* CH_CFG_USE_JOBS == TRUE */
 
 #endif /* CHJOBS_H */
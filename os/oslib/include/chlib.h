@@ -227,14 +227,19 @@
 /* OS Library headers.*/
 #include "chbsem.h"
 #include "chmboxes.h"
+#include "chmemprof.h"
 #include "chmemcore.h"
 #include "chmemheaps.h"
 #include "chmempools.h"
 #include "chobjfifos.h"
 #include "chpipes.h"
+#include "chwaitmulti.h"
 #include "chobjcaches.h"
 #include "chdelegates.h"
 #include "chjobs.h"
+#include "chpipelines.h"
+#include "chsnapshots.h"
+#include "chintercore.h"
 #include "chfactory.h"
 
 /*===========================================================================*/
@@ -34,6 +34,34 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Memory regions attributes
+ * @{
+ */
+/**
+ * @brief   No specific attributes.
+ */
+#define MEM_ATTR_NONE                       0U
+/**
+ * @brief   CPU-local memory with no wait states, for example TCM.
+ */
+#define MEM_ATTR_FAST                       (1U << 0)
+/**
+ * @brief   Memory reachable by the DMA controllers.
+ */
+#define MEM_ATTR_DMA                        (1U << 1)
+/**
+ * @brief   Memory not cached by the CPU data cache.
+ */
+#define MEM_ATTR_NOCACHE                    (1U << 2)
+/**
+ * @brief   Application or platform defined attribute.
+ *
+ * @param[in] n         attribute number, from 0 to 23
+ */
+#define MEM_ATTR_USER(n)                    (1U << (8U + (n)))
+/** @} */
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -89,6 +117,67 @@ typedef struct {
   uint8_t *topmem;
 } memcore_t;
 
+/**
+ * @brief   Type of a memory core region.
+ */
+typedef struct memcore_region memcore_region_t;
+
+/**
+ * @brief   Structure representing a memory core region.
+ */
+struct memcore_region {
+  /**
+   * @brief   Next region in preference order.
+   */
+  memcore_region_t          *next;
+  /**
+   * @brief   Region name.
+   */
+  const char                *name;
+  /**
+   * @brief   Region attributes.
+   */
+  uint32_t                  attrs;
+  /**
+   * @brief   Region memory core.
+   */
+  memcore_t                 core;
+  /**
+   * @brief   Region size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Allocations served by the region.
+   */
+  ucnt_t                    allocations;
+  /**
+   * @brief   Allocations failed because the region was exhausted.
+   */
+  ucnt_t                    failures;
+};
+
+/**
+ * @brief   Type of the statistics of a memory core region.
+ */
+typedef struct {
+  /**
+   * @brief   Region size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Free memory in the region.
+   */
+  size_t                    free;
+  /**
+   * @brief   Allocations served by the region.
+   */
+  ucnt_t                    allocations;
+  /**
+   * @brief   Allocations failed because the region was exhausted.
+   */
+  ucnt_t                    failures;
+} memcore_region_stats_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -126,6 +215,16 @@ extern "C" {
   void *chCoreAllocFromBase(size_t size, unsigned align, size_t offset);
   void *chCoreAllocFromTop(size_t size, unsigned align, size_t offset);
   size_t chCoreGetStatusX(void);
+  void chCoreAddRegion(memcore_region_t *mrp, const char *name,
+                       uint32_t attrs, void *base, void *end);
+  void *chCoreAllocFromRegionI(memcore_region_t *mrp, size_t size,
+                               unsigned align, size_t offset);
+  void *chCoreAllocWithHintI(size_t size, unsigned align, size_t offset,
+                             uint32_t hint);
+  void *chCoreAllocWithHint(size_t size, unsigned align, size_t offset,
+                            uint32_t hint);
+  void chCoreGetRegionStatsX(memcore_region_t *mrp,
+                             memcore_region_stats_t *sp);
 #ifdef __cplusplus
 }
 #endif
@@ -34,10 +34,46 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of first level size classes in TLSF mode.
+ * @details Blocks larger than 2^(CH_HEAP_TLSF_FL_COUNT + 2) - 1 heap
+ *          alignment units are split, this is 2MB with 8 bytes units.
+ */
+#define CH_HEAP_TLSF_FL_COUNT   16U
+
+/**
+ * @brief   Number of second level size classes in TLSF mode.
+ */
+#define CH_HEAP_TLSF_SL_COUNT   8U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Constant time heap allocator.
+ * @details If enabled then the heap uses a two levels segregated fit
+ *          allocator (TLSF) instead of the first-fit free list, allocation
+ *          and release times do not depend on the heap fragmentation.
+ * @note    The TLSF heap descriptor requires about 600 bytes on 32 bits
+ *          architectures and each block header is twice as large.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_TLSF    FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
 /**
  * @brief   Minimum alignment used for heap.
  * @note    Cannot use the sizeof operator in this macro.
+ * @note    In first-fit mode the alignment is the block header size, the
+ *          header is doubled by @p CH_DBG_MEM_PROFILING.
  */
+#if (CH_DBG_MEM_PROFILING == FALSE) || (CH_CFG_USE_HEAP_TLSF == TRUE) ||    \
+    defined(__DOXYGEN__)
 #if (SIZEOF_PTR == 4) || defined(__DOXYGEN__)
 #define CH_HEAP_ALIGNMENT   8U
 #elif (SIZEOF_PTR == 2)
@@ -45,14 +81,15 @@
 #else
 #error "unsupported pointer size"
 #endif
-
-/*===========================================================================*/
-/* Module pre-compile time settings.                                         */
-/*===========================================================================*/
-
-/*===========================================================================*/
-/* Derived constants and error checks.                                       */
-/*===========================================================================*/
+#else /* (CH_DBG_MEM_PROFILING == TRUE) && (CH_CFG_USE_HEAP_TLSF == FALSE) */
+#if SIZEOF_PTR == 4
+#define CH_HEAP_ALIGNMENT   16U
+#elif SIZEOF_PTR == 2
+#define CH_HEAP_ALIGNMENT   8U
+#else
+#error "unsupported pointer size"
+#endif
+#endif /* (CH_DBG_MEM_PROFILING == TRUE) && (CH_CFG_USE_HEAP_TLSF == FALSE) */
 
 #if CH_CFG_USE_MEMCORE == FALSE
 #error "CH_CFG_USE_HEAP requires CH_CFG_USE_MEMCORE"
@@ -76,6 +113,7 @@ typedef struct memory_heap memory_heap_t;
  */
 typedef union heap_header heap_header_t;
 
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Memory heap block header.
  */
@@ -87,6 +125,10 @@ union heap_header {
   struct {
     memory_heap_t       *heap;      /**< @brief Block owner heap.           */
     size_t              size;       /**< @brief Size of the area in bytes.  */
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+    memprof_site_t      *site;      /**< @brief Allocation call site.       */
+    thread_t            *owner;     /**< @brief Allocating thread.          */
+#endif
   } used;
 };
 
@@ -103,6 +145,52 @@ struct memory_heap {
   semaphore_t           sem;        /**< @brief Heap access semaphore.      */
 #endif
 };
+#else /* CH_CFG_USE_HEAP_TLSF == TRUE */
+/**
+ * @brief   Memory heap block header, TLSF mode.
+ * @note    Both structures share the physical block information as common
+ *          initial sequence.
+ */
+union heap_header {
+  struct {
+    heap_header_t       *phys;      /**< @brief Previous physical block.    */
+    size_t              info;       /**< @brief Size in pages and flags.    */
+    heap_header_t       *next;      /**< @brief Next block in free list.    */
+    heap_header_t       *prev;      /**< @brief Previous block in free
+                                                list.                       */
+  } free;
+  struct {
+    heap_header_t       *phys;      /**< @brief Previous physical block.    */
+    size_t              info;       /**< @brief Size in pages and flags.    */
+    memory_heap_t       *heap;      /**< @brief Block owner heap.           */
+    size_t              size;       /**< @brief Size of the area in bytes.  */
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+    memprof_site_t      *site;      /**< @brief Allocation call site.       */
+    thread_t            *owner;     /**< @brief Allocating thread.          */
+#endif
+  } used;
+};
+
+/**
+ * @brief   Structure describing a memory heap, TLSF mode.
+ */
+struct memory_heap {
+  memgetfunc2_t         provider;   /**< @brief Memory blocks provider for
+                                                this heap.                  */
+  uint32_t              flmap;      /**< @brief First level bitmap.         */
+  uint32_t              slmap[CH_HEAP_TLSF_FL_COUNT];
+                                    /**< @brief Second level bitmaps.       */
+  heap_header_t         *blocks[CH_HEAP_TLSF_FL_COUNT][CH_HEAP_TLSF_SL_COUNT];
+                                    /**< @brief Free lists heads.           */
+  size_t                nfree;      /**< @brief Number of free blocks.      */
+  size_t                fpages;     /**< @brief Free pages.                 */
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+  mutex_t               mtx;        /**< @brief Heap access mutex.          */
+#else
+  semaphore_t           sem;        /**< @brief Heap access semaphore.      */
+#endif
+};
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
 
 /*===========================================================================*/
 /* Module macros.                                                            */
@@ -171,6 +259,22 @@ static inline size_t chHeapGetSize(const void *p) {
   return ((heap_header_t *)p - 1U)->used.size;
 }
 
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the thread that allocated a block.
+ * @note    The thread could have been terminated since the allocation.
+ *
+ * @param[in] p         pointer to the memory block
+ * @return              Pointer to the allocating thread.
+ *
+ * @xclass
+ */
+static inline thread_t *chHeapGetOwnerX(const void *p) {
+
+  return ((heap_header_t *)p - 1U)->used.owner;
+}
+#endif
+
 #endif /* CH_CFG_USE_HEAP == TRUE */
 
 #endif /* CHMEMHEAPS_H */
@@ -70,6 +70,22 @@ typedef struct {
                                                     for this pool.          */
 } memory_pool_t;
 
+/**
+ * @brief   Memory pool magazine descriptor.
+ * @details A magazine caches a few objects of a memory pool for the
+ *          exclusive use of a single thread, most allocations and releases
+ *          are served without entering a critical zone.
+ */
+typedef struct {
+  memory_pool_t         *pool;          /**< @brief Associated memory pool. */
+  struct pool_header    *next;          /**< @brief Pointer to the first
+                                                    cached object.          */
+  size_t                cnt;            /**< @brief Number of cached
+                                                    objects.                */
+  size_t                size;           /**< @brief Maximum number of cached
+                                                    objects.                */
+} pool_magazine_t;
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Guarded memory pool descriptor.
@@ -154,6 +170,12 @@ extern "C" {
   void *chPoolAlloc(memory_pool_t *mp);
   void chPoolFreeI(memory_pool_t *mp, void *objp);
   void chPoolFree(memory_pool_t *mp, void *objp);
+  void chPoolMagazineObjectInit(pool_magazine_t *pmp,
+                                memory_pool_t *mp,
+                                size_t size);
+  void *chPoolMagazineAlloc(pool_magazine_t *pmp);
+  void chPoolMagazineFree(pool_magazine_t *pmp, void *objp);
+  void chPoolMagazineFlush(pool_magazine_t *pmp);
 #if CH_CFG_USE_SEMAPHORES == TRUE
   void chGuardedPoolObjectInitAligned(guarded_memory_pool_t *gmp,
                                       size_t size,
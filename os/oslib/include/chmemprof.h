@@ -0,0 +1,218 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chmemprof.h
+ * @brief   Allocations profiler macros and structures.
+ *
+ * @addtogroup oslib_memprof
+ * @{
+ */
+
+#ifndef CHMEMPROF_H
+#define CHMEMPROF_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Allocators identifiers
+ * @{
+ */
+#define CH_MEMPROF_HEAP                     1U
+#define CH_MEMPROF_POOL                     2U
+#define CH_MEMPROF_CORE                     3U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Debug option, allocations profiling.
+ * @details If enabled then the allocations performed by @p chHeapAlloc(),
+ *          @p chHeapAllocAligned(), @p chPoolAlloc() and the core allocator
+ *          APIs are aggregated by call site in a table.
+ * @note    Heap blocks headers are enlarged in order to link each block
+ *          to its call site, in first-fit mode the heap alignment unit is
+ *          doubled.
+ */
+#if !defined(CH_DBG_MEM_PROFILING) || defined(__DOXYGEN__)
+#define CH_DBG_MEM_PROFILING                FALSE
+#endif
+
+/**
+ * @brief   Number of call sites in the allocations profiler.
+ * @note    Must be a power of two.
+ */
+#if !defined(CH_DBG_MEM_PROFILING_SITES) || defined(__DOXYGEN__)
+#define CH_DBG_MEM_PROFILING_SITES          32
+#endif
+
+/**
+ * @brief   Returns the return address of the calling function.
+ * @note    The default implementation relies on a GCC builtin, it can be
+ *          redefined for other compilers.
+ */
+#if !defined(__memprof_get_caller) || defined(__DOXYGEN__)
+#define __memprof_get_caller()              __builtin_return_address(0)
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+
+#if !defined(__CHIBIOS_RT__)
+#error "CH_DBG_MEM_PROFILING requires ChibiOS/RT"
+#endif
+
+#if CH_CFG_USE_TIMESTAMP == FALSE
+#error "CH_DBG_MEM_PROFILING requires CH_CFG_USE_TIMESTAMP"
+#endif
+
+#if (CH_DBG_MEM_PROFILING_SITES < 2) ||                                     \
+    (CH_DBG_MEM_PROFILING_SITES > 1024) ||                                  \
+    ((CH_DBG_MEM_PROFILING_SITES & (CH_DBG_MEM_PROFILING_SITES - 1)) != 0)
+#error "invalid CH_DBG_MEM_PROFILING_SITES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an allocations call site.
+ * @note    Pool objects have no header, pool call sites only count the
+ *          allocations, live and peak sizes are not tracked. Core memory is
+ *          never released, the live size of core call sites is the
+ *          allocated size.
+ */
+typedef struct {
+  /**
+   * @brief   Return address of the allocation call, @p NULL if unused.
+   */
+  const void                *pc;
+  /**
+   * @brief   Last thread allocating from the call site.
+   */
+  thread_t                  *tp;
+  /**
+   * @brief   Allocator identifier.
+   */
+  unsigned                  allocator;
+  /**
+   * @brief   Number of allocations.
+   */
+  ucnt_t                    allocs;
+  /**
+   * @brief   Number of releases.
+   */
+  ucnt_t                    frees;
+  /**
+   * @brief   Live allocated bytes.
+   */
+  size_t                    live;
+  /**
+   * @brief   Highest live allocated bytes.
+   */
+  size_t                    peak;
+} memprof_site_t;
+
+/**
+ * @brief   Type of the allocations profiler.
+ */
+typedef struct {
+  /**
+   * @brief   Call sites hash table.
+   */
+  memprof_site_t            sites[CH_DBG_MEM_PROFILING_SITES];
+  /**
+   * @brief   Time stamp of the last reset, zero at startup.
+   */
+  systimestamp_t            since;
+  /**
+   * @brief   Allocations not recorded because the table was full.
+   */
+  ucnt_t                    dropped;
+} memprof_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern memprof_t ch_memprof;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  memprof_site_t *__memprof_alloc(const void *pc, unsigned allocator,
+                                  size_t size);
+  void __memprof_free(memprof_site_t *sp, size_t size);
+  bool chMemProfReadSite(unsigned i, memprof_site_t *sp);
+  void chMemProfReset(void);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the time stamp of the last profiler reset.
+ * @note    Allocation rates are the call sites counters divided by the
+ *          time elapsed since this time stamp.
+ *
+ * @return              The time stamp.
+ *
+ * @xclass
+ */
+static inline systimestamp_t chMemProfGetStartX(void) {
+
+  return ch_memprof.since;
+}
+
+/**
+ * @brief   Returns the number of allocations not recorded.
+ * @details Allocations from new call sites are not recorded when the call
+ *          sites table is full.
+ *
+ * @return              The number of dropped allocations.
+ *
+ * @xclass
+ */
+static inline ucnt_t chMemProfGetDroppedX(void) {
+
+  return ch_memprof.dropped;
+}
+
+#endif /* CH_DBG_MEM_PROFILING == TRUE */
+
+#endif /* CHMEMPROF_H */
+
+/** @} */
@@ -216,11 +216,7 @@ struct ch_objects_cache {
    */
   oc_lru_header_t       lru;
   /**
-   * @brief   Semaphore for cache access.
-   */
-  semaphore_t           cache_sem;
-  /**
-   * @brief   Semaphore for LRU access.
+   * @brief   Counter semaphore of the objects in the LRU list.
    */
   semaphore_t           lru_sem;
   /**
@@ -263,6 +259,11 @@ extern "C" {
   bool chCacheWriteObject(objects_cache_t *ocp,
                           oc_object_t *objp,
                           bool async);
+  ucnt_t chCacheCleanObjects(objects_cache_t *ocp, ucnt_t n);
+  ucnt_t chCachePrefetch(objects_cache_t *ocp,
+                         uint32_t group,
+                         uint32_t key,
+                         ucnt_t n);
 #ifdef __cplusplus
 }
 #endif
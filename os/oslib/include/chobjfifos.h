@@ -360,6 +360,54 @@ static inline void chFifoSendObjectAhead(objects_fifo_t *ofp, void *objp) {
   chDbgAssert(msg == MSG_OK, "post failed");
 }
 
+/**
+ * @brief   Posts multiple objects.
+ * @details All objects are posted within the same critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[in] objpp     pointer to an array of pointers to the objects to be
+ *                      posted
+ * @param[in] n         number of objects to be posted
+ *
+ * @iclass
+ */
+static inline void chFifoSendObjectsI(objects_fifo_t *ofp,
+                                      void * const *objpp,
+                                      size_t n) {
+
+  chDbgCheckClassI();
+  chDbgCheck((objpp != NULL) || (n == 0U));
+
+  while (n > 0U) {
+    chFifoSendObjectI(ofp, *objpp);
+    objpp++;
+    n--;
+  }
+}
+
+/**
+ * @brief   Posts multiple objects.
+ * @details All objects are posted within the same critical zone.
+ * @note    By design the objects can be always immediately posted.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[in] objpp     pointer to an array of pointers to the objects to be
+ *                      posted
+ * @param[in] n         number of objects to be posted
+ *
+ * @api
+ */
+static inline void chFifoSendObjects(objects_fifo_t *ofp,
+                                     void * const *objpp,
+                                     size_t n) {
+
+  chSysLock();
+  chFifoSendObjectsI(ofp, objpp, n);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
 /**
  * @brief   Fetches an object.
  *
@@ -423,6 +471,102 @@ static inline msg_t chFifoReceiveObjectTimeout(objects_fifo_t *ofp,
   return chMBFetchTimeout(&ofp->mbx, (msg_t *)objpp, timeout);
 }
 
+/**
+ * @brief   Fetches multiple objects.
+ * @details Up to @p n objects are fetched without waiting.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array of fetched object references
+ * @param[in] n         maximum number of objects to be fetched
+ * @return              The number of fetched objects.
+ *
+ * @iclass
+ */
+static inline size_t chFifoReceiveObjectsI(objects_fifo_t *ofp,
+                                           void **objpp,
+                                           size_t n) {
+  size_t i;
+
+  chDbgCheckClassI();
+  chDbgCheck((objpp != NULL) || (n == 0U));
+
+  for (i = 0U; i < n; i++) {
+    if (chMBFetchI(&ofp->mbx, (msg_t *)&objpp[i]) != MSG_OK) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+/**
+ * @brief   Fetches multiple objects.
+ * @details The function waits for the first object then fetches, without
+ *          waiting, up to @p n objects within the same critical zone.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array of fetched object references
+ * @param[in] n         maximum number of objects to be fetched, it cannot
+ *                      be zero
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of fetched objects, zero if the operation
+ *                      has timed out.
+ *
+ * @sclass
+ */
+static inline size_t chFifoReceiveObjectsTimeoutS(objects_fifo_t *ofp,
+                                                  void **objpp,
+                                                  size_t n,
+                                                  sysinterval_t timeout) {
+  size_t i;
+
+  chDbgCheck((objpp != NULL) && (n > 0U));
+
+  if (chMBFetchTimeoutS(&ofp->mbx, (msg_t *)&objpp[0], timeout) != MSG_OK) {
+    return (size_t)0;
+  }
+  i = (size_t)1 + chFifoReceiveObjectsI(ofp, &objpp[1], n - (size_t)1);
+  chSchRescheduleS();
+
+  return i;
+}
+
+/**
+ * @brief   Fetches multiple objects.
+ * @details The function waits for the first object then fetches, without
+ *          waiting, up to @p n objects within the same critical zone.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t structure
+ * @param[out] objpp    pointer to an array of fetched object references
+ * @param[in] n         maximum number of objects to be fetched, it cannot
+ *                      be zero
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of fetched objects, zero if the operation
+ *                      has timed out.
+ *
+ * @api
+ */
+static inline size_t chFifoReceiveObjectsTimeout(objects_fifo_t *ofp,
+                                                 void **objpp,
+                                                 size_t n,
+                                                 sysinterval_t timeout) {
+  size_t i;
+
+  chSysLock();
+  i = chFifoReceiveObjectsTimeoutS(ofp, objpp, n, timeout);
+  chSysUnlock();
+
+  return i;
+}
+
 #endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
 
 #endif /* CHOBJFIFOS_H */
@@ -0,0 +1,344 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chpipelines.h
+ * @brief   Dataflow pipelines macros and structures.
+ *
+ * @addtogroup oslib_pipelines
+ * @{
+ */
+
+#ifndef CHPIPELINES_H
+#define CHPIPELINES_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Dataflow pipelines APIs.
+ * @details If enabled then processing chains can be built from stage
+ *          functions executed by the workers of a jobs queue, buffers
+ *          flow through the stages without copies.
+ */
+#if !defined(CH_CFG_USE_PIPELINES) || defined(__DOXYGEN__)
+#define CH_CFG_USE_PIPELINES                FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_PIPELINES == TRUE) || defined(__DOXYGEN__)
+
+#if CH_CFG_USE_OBJ_FIFOS == FALSE
+#error "CH_CFG_USE_PIPELINES requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+#if CH_CFG_USE_JOBS == FALSE
+#error "CH_CFG_USE_PIPELINES requires CH_CFG_USE_JOBS"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a stage function.
+ * @details The function processes the buffer in place.
+ *
+ * @param[in] arg       the stage argument
+ * @param[in,out] objp  pointer to the buffer
+ * @return              The processing outcome.
+ * @retval MSG_OK       if the buffer has to be passed to the next stage.
+ * @retval MSG_RESET    if the buffer has to be dropped, it is returned to
+ *                      the pipeline objects FIFO.
+ */
+typedef msg_t (*pipeline_func_t)(void *arg, void *objp);
+
+/**
+ * @brief   Type of a stage configuration.
+ */
+typedef struct {
+  /**
+   * @brief   Stage function.
+   */
+  pipeline_func_t           func;
+  /**
+   * @brief   Argument passed to the stage function.
+   */
+  void                      *arg;
+  /**
+   * @brief   Maximum number of buffers queued in front of this stage.
+   * @details The previous stage is held back while the limit is reached,
+   *          zero means no limit other than the number of buffers.
+   */
+  size_t                    depth;
+} pipeline_stage_config_t;
+
+/**
+ * @brief   Type of a stage queue slot.
+ */
+typedef struct {
+  /**
+   * @brief   Queued buffer.
+   */
+  void                      *objp;
+  /**
+   * @brief   Realtime counter value when the buffer was queued.
+   */
+  rtcnt_t                   stamp;
+} pipeline_slot_t;
+
+/**
+ * @brief   Type of the stage counters.
+ */
+typedef struct {
+  /**
+   * @brief   Number of buffers processed.
+   */
+  ucnt_t                    processed;
+  /**
+   * @brief   Number of buffers dropped by the stage function.
+   */
+  ucnt_t                    dropped;
+  /**
+   * @brief   Number of times the stage was held back by the next stage.
+   */
+  ucnt_t                    stalls;
+  /**
+   * @brief   Worst latency, from queuing to the processing end.
+   */
+  rtcnt_t                   worst;
+  /**
+   * @brief   Cumulative latency of the processed buffers.
+   */
+  uint64_t                  cumulative;
+} pipeline_stats_t;
+
+/**
+ * @brief   Type of a pipeline.
+ */
+typedef struct ch_pipeline pipeline_t;
+
+/**
+ * @brief   Type of a pipeline stage.
+ */
+typedef struct ch_pipeline_stage {
+  /**
+   * @brief   Stage configuration.
+   */
+  const pipeline_stage_config_t *config;
+  /**
+   * @brief   Pipeline owning the stage.
+   */
+  pipeline_t                *plp;
+  /**
+   * @brief   Input queue, one slot for each buffer of the pipeline.
+   */
+  pipeline_slot_t           *slots;
+  /**
+   * @brief   Index of the oldest queued buffer.
+   */
+  size_t                    rdidx;
+  /**
+   * @brief   Number of queued buffers.
+   */
+  size_t                    cnt;
+  /**
+   * @brief   A job for this stage has been posted and not yet finished.
+   */
+  bool                      running;
+  /**
+   * @brief   Stage counters.
+   */
+  pipeline_stats_t          stats;
+} pipeline_stage_t;
+
+/**
+ * @brief   Structure representing a pipeline.
+ */
+struct ch_pipeline {
+  /**
+   * @brief   Objects FIFO supplying the buffers.
+   * @details Free buffers are taken from the FIFO pool, the buffers
+   *          leaving the last stage are sent to the FIFO mailbox.
+   */
+  objects_fifo_t            *ofp;
+  /**
+   * @brief   Jobs queue executing the stages.
+   */
+  jobs_queue_t              *jqp;
+  /**
+   * @brief   Stages array.
+   */
+  pipeline_stage_t          *stages;
+  /**
+   * @brief   Number of stages.
+   */
+  size_t                    nstages;
+  /**
+   * @brief   Number of buffers in the objects FIFO.
+   */
+  size_t                    nobjs;
+  /**
+   * @brief   Buffers leaving the last stage are sent to the FIFO mailbox.
+   * @details If @p false then they are returned to the FIFO pool.
+   */
+  bool                      sink;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of queue slots required by a pipeline.
+ *
+ * @param[in] nstages   number of stages
+ * @param[in] nobjs     number of buffers in the objects FIFO
+ */
+#define CH_PIPELINE_SLOTS(nstages, nobjs) ((nstages) * (nobjs))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chPipelineObjectInit(pipeline_t *plp, objects_fifo_t *ofp,
+                            jobs_queue_t *jqp, pipeline_stage_t *stages,
+                            const pipeline_stage_config_t *configs,
+                            size_t nstages, pipeline_slot_t *slots,
+                            bool sink);
+  void chPipelineSubmitI(pipeline_t *plp, void *objp);
+  void chPipelineSubmit(pipeline_t *plp, void *objp);
+  void chPipelineResetStats(pipeline_t *plp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Allocates a free buffer.
+ * @details This is the backpressure point of the pipeline, the caller is
+ *          suspended while all the buffers are in flight.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The pointer to the allocated buffer.
+ * @retval NULL         if a buffer is not available within the specified
+ *                      timeout.
+ *
+ * @api
+ */
+static inline void *chPipelineTakeObjectTimeout(pipeline_t *plp,
+                                                sysinterval_t timeout) {
+
+  return chFifoTakeObjectTimeout(plp->ofp, timeout);
+}
+
+/**
+ * @brief   Allocates a free buffer.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @return              The pointer to the allocated buffer.
+ * @retval NULL         if a buffer is not immediately available.
+ *
+ * @iclass
+ */
+static inline void *chPipelineTakeObjectI(pipeline_t *plp) {
+
+  return chFifoTakeObjectI(plp->ofp);
+}
+
+/**
+ * @brief   Receives a buffer from the last stage.
+ * @pre     The pipeline must have been initialized as a sink.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[out] objpp    pointer to the received buffer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been correctly received.
+ * @retval MSG_RESET    if the FIFO has been reset.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t chPipelineReceiveObjectTimeout(pipeline_t *plp,
+                                                   void **objpp,
+                                                   sysinterval_t timeout) {
+
+  return chFifoReceiveObjectTimeout(plp->ofp, objpp, timeout);
+}
+
+/**
+ * @brief   Releases a received buffer.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[in] objp      pointer to the buffer to be released
+ *
+ * @api
+ */
+static inline void chPipelineReturnObject(pipeline_t *plp, void *objp) {
+
+  chFifoReturnObject(plp->ofp, objp);
+}
+
+/**
+ * @brief   Returns the counters of a stage.
+ * @note    The counters are not read atomically.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[in] n         stage index
+ * @return              Pointer to the stage counters.
+ *
+ * @xclass
+ */
+static inline const pipeline_stats_t *chPipelineGetStatsX(pipeline_t *plp,
+                                                          size_t n) {
+
+  chDbgCheck(n < plp->nstages);
+
+  return &plp->stages[n].stats;
+}
+
+#endif /* CH_CFG_USE_PIPELINES == TRUE */
+
+#endif /* CHPIPELINES_H */
+
+/** @} */
@@ -58,6 +58,13 @@ typedef struct {
   uint8_t               *rdptr;         /**< @brief Read pointer.           */
   size_t                cnt;            /**< @brief Bytes in the pipe.      */
   bool                  reset;          /**< @brief True if in reset state. */
+  bool                  spsc;           /**< @brief True if in single
+                                                    producer and single
+                                                    consumer mode.          */
+  volatile size_t       wrcnt;          /**< @brief Total bytes written,
+                                                    SPSC mode only.         */
+  volatile size_t       rdcnt;          /**< @brief Total bytes read, SPSC
+                                                    mode only.              */
   thread_reference_t    wtr;            /**< @brief Waiting writer.         */
   thread_reference_t    rtr;            /**< @brief Waiting reader.         */
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
@@ -92,6 +99,9 @@ typedef struct {
   (uint8_t *)(buffer),                                                      \
   (size_t)0,                                                                \
   false,                                                                    \
+  false,                                                                    \
+  (size_t)0,                                                                \
+  (size_t)0,                                                                \
   NULL,                                                                     \
   NULL,                                                                     \
   __MUTEX_DATA(name.cmtx),                                                  \
@@ -106,6 +116,9 @@ typedef struct {
   (uint8_t *)(buffer),                                                      \
   (size_t)0,                                                                \
   false,                                                                    \
+  false,                                                                    \
+  (size_t)0,                                                                \
+  (size_t)0,                                                                \
   NULL,                                                                     \
   NULL,                                                                     \
   __SEMAPHORE_DATA(name.csem, (cnt_t)1),                                    \
@@ -134,11 +147,18 @@ typedef struct {
 extern "C" {
 #endif
   void chPipeObjectInit(pipe_t *pp, uint8_t *buf, size_t n);
+  void chPipeObjectInitSPSC(pipe_t *pp, uint8_t *buf, size_t n);
   void chPipeReset(pipe_t *pp);
   size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
                             size_t n, sysinterval_t timeout);
   size_t chPipeReadTimeout(pipe_t *pp, uint8_t *bp,
                            size_t n, sysinterval_t timeout);
+  size_t chPipeWriteAcquireTimeout(pipe_t *pp, uint8_t **bpp,
+                                   sysinterval_t timeout);
+  void chPipeWriteCommit(pipe_t *pp, size_t n);
+  size_t chPipeReadAcquireTimeout(pipe_t *pp, const uint8_t **bpp,
+                                  sysinterval_t timeout);
+  void chPipeReadRelease(pipe_t *pp, size_t n);
 #ifdef __cplusplus
 }
 #endif
@@ -173,6 +193,10 @@ static inline size_t chPipeGetSize(const pipe_t *pp) {
  */
 static inline size_t chPipeGetUsedCount(const pipe_t *pp) {
 
+  if (pp->spsc) {
+    return pp->wrcnt - pp->rdcnt;
+  }
+
   return pp->cnt;
 }
 
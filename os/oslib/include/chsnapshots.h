@@ -0,0 +1,174 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chsnapshots.h
+ * @brief   Snapshots macros and structures.
+ *
+ * @addtogroup oslib_snapshots
+ * @{
+ */
+
+#ifndef CHSNAPSHOTS_H
+#define CHSNAPSHOTS_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Structure representing a snapshot object.
+ */
+typedef struct {
+  volatile ucnt_t       seq;            /**< @brief Sequence counter, odd
+                                                    while a version is
+                                                    being written.          */
+  uint8_t               *buffers[2];    /**< @brief Versions buffers.       */
+  size_t                size;           /**< @brief Size of the state.      */
+} snapshot_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Compiler barrier.
+ * @details The buffers accesses must not be moved across the updates of
+ *          the sequence counter.
+ *
+ * @notapi
+ */
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define __snap_barrier()        __asm volatile ("" : : : "memory")
+#else
+#define __snap_barrier()
+#endif
+
+/**
+ * @brief   Data part of a static snapshot initializer.
+ * @details This macro should be used when statically initializing a
+ *          snapshot that is part of a bigger structure.
+ * @note    The initial state is the content of the first buffer.
+ *
+ * @param[in] buf       pointer to a buffer of @p 2 * @p size bytes
+ * @param[in] size      size of the shared state
+ */
+#define __SNAPSHOT_DATA(buf, size) {                                        \
+  (ucnt_t)0,                                                                \
+  {(uint8_t *)(buf), (uint8_t *)(buf) + (size)},                            \
+  (size_t)(size)                                                            \
+}
+
+/**
+ * @brief   Static snapshot initializer.
+ * @details Statically initialized snapshots require no explicit
+ *          initialization using @p chSnapObjectInit().
+ *
+ * @param[in] name      the name of the snapshot variable
+ * @param[in] buf       pointer to a buffer of @p 2 * @p size bytes
+ * @param[in] size      size of the shared state
+ */
+#define SNAPSHOT_DECL(name, buf, size)                                      \
+  snapshot_t name = __SNAPSHOT_DATA(buf, size)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chSnapObjectInit(snapshot_t *sp, void *buf, size_t size);
+  void chSnapPublishX(snapshot_t *sp, const void *data);
+  ucnt_t chSnapReadX(snapshot_t *sp, void *data);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Starts writing a new version.
+ * @details The returned buffer is not visible to readers, the new
+ *          version can be built in place then published using
+ *          @p chSnapEndWriteX().
+ * @note    Writers must be serialized by the caller, the typical use is a
+ *          single writer thread or ISR.
+ * @note    The buffer content is the version preceding the current one, it
+ *          must be written entirely.
+ *
+ * @param[in] sp        pointer to a @p snapshot_t object
+ * @return              Pointer to the buffer of the new version.
+ *
+ * @xclass
+ */
+static inline void *chSnapBeginWriteX(snapshot_t *sp) {
+  ucnt_t seq = sp->seq + (ucnt_t)1;
+
+  sp->seq = seq;
+  __snap_barrier();
+
+  return (void *)sp->buffers[((seq + (ucnt_t)1) >> 1) & (ucnt_t)1];
+}
+
+/**
+ * @brief   Publishes the version started with @p chSnapBeginWriteX().
+ *
+ * @param[in] sp        pointer to a @p snapshot_t object
+ *
+ * @xclass
+ */
+static inline void chSnapEndWriteX(snapshot_t *sp) {
+
+  __snap_barrier();
+  sp->seq = sp->seq + (ucnt_t)1;
+}
+
+/**
+ * @brief   Returns the number of the last published version.
+ * @details The value can be used to detect changes without reading the
+ *          state.
+ *
+ * @param[in] sp        pointer to a @p snapshot_t object
+ * @return              The version number.
+ *
+ * @xclass
+ */
+static inline ucnt_t chSnapGetVersionX(snapshot_t *sp) {
+
+  return sp->seq >> 1;
+}
+
+#endif /* CHSNAPSHOTS_H */
+
+/** @} */
@@ -0,0 +1,237 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/include/chwaitmulti.h
+ * @brief   Multiple objects wait macros and structures.
+ *
+ * @addtogroup oslib_waitmulti
+ * @{
+ */
+
+#ifndef CHWAITMULTI_H
+#define CHWAITMULTI_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Wait item types
+ * @{
+ */
+#define CH_WAIT_SEMAPHORE                   0U
+#define CH_WAIT_MAILBOX                     1U
+#define CH_WAIT_PIPE                        2U
+#define CH_WAIT_EVENTS                      3U
+/** @} */
+
+/**
+ * @brief   Maximum number of items in a single wait.
+ */
+#define CH_WAIT_MAX_ITEMS                   32U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Multiple objects wait APIs.
+ * @details If enabled then a thread can wait on several semaphores,
+ *          mailboxes, objects FIFOs, pipes and events at once.
+ * @note    Adds a check to the signaling paths of those objects.
+ */
+#if !defined(CH_CFG_USE_WAIT_MULTIPLE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_WAIT_MULTIPLE            FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_WAIT_MULTIPLE == TRUE) || defined(__DOXYGEN__)
+
+#if !defined(__CHIBIOS_RT__)
+#error "CH_CFG_USE_WAIT_MULTIPLE requires ChibiOS/RT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a wait item.
+ */
+typedef struct {
+  /**
+   * @brief   Type of the waited object.
+   */
+  unsigned                  type;
+  /**
+   * @brief   Pointer to the waited object.
+   */
+  void                      *objp;
+  /**
+   * @brief   Waited events mask, @p CH_WAIT_EVENTS items only.
+   */
+  eventmask_t               events;
+} wait_item_t;
+
+/**
+ * @brief   Type of a thread waiting on multiple objects.
+ * @note    The object is allocated on the stack of the waiting thread.
+ */
+typedef struct {
+  /**
+   * @brief   Link in the list of the waiting threads.
+   */
+  ch_queue_t                link;
+  /**
+   * @brief   Reference to the suspended thread.
+   */
+  thread_reference_t        tr;
+  /**
+   * @brief   The waiting thread, owner of the waited events.
+   */
+  thread_t                  *tp;
+  /**
+   * @brief   Array of the waited items.
+   */
+  const wait_item_t         *items;
+  /**
+   * @brief   Number of waited items.
+   */
+  unsigned                  n;
+} wait_poller_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Semaphore wait item initializer.
+ * @details The item is ready when the semaphore counter is positive.
+ *
+ * @param[in] sp        pointer to a @p semaphore_t object
+ */
+#define WAIT_SEMAPHORE(sp)                                                  \
+  {CH_WAIT_SEMAPHORE, (void *)(sp), (eventmask_t)0}
+
+/**
+ * @brief   Mailbox wait item initializer.
+ * @details The item is ready when the mailbox contains messages.
+ *
+ * @param[in] mbp       pointer to a @p mailbox_t object
+ */
+#define WAIT_MAILBOX(mbp)                                                   \
+  {CH_WAIT_MAILBOX, (void *)(mbp), (eventmask_t)0}
+
+/**
+ * @brief   Objects FIFO wait item initializer.
+ * @details The item is ready when the FIFO contains objects.
+ *
+ * @param[in] ofp       pointer to a @p objects_fifo_t object
+ */
+#define WAIT_OBJ_FIFO(ofp)                                                  \
+  WAIT_MAILBOX(&(ofp)->mbx)
+
+/**
+ * @brief   Pipe wait item initializer.
+ * @details The item is ready when the pipe contains data.
+ *
+ * @param[in] pp        pointer to a @p pipe_t object
+ */
+#define WAIT_PIPE(pp)                                                       \
+  {CH_WAIT_PIPE, (void *)(pp), (eventmask_t)0}
+
+/**
+ * @brief   Events wait item initializer.
+ * @details The item is ready when any of the specified events is pending
+ *          for the waiting thread.
+ *
+ * @param[in] mask      mask of the waited events
+ */
+#define WAIT_EVENTS(mask)                                                   \
+  {CH_WAIT_EVENTS, NULL, (eventmask_t)(mask)}
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern ch_queue_t ch_wait_pollers;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint32_t chWaitMultipleTimeoutS(const wait_item_t *items, unsigned n,
+                                  sysinterval_t timeout);
+  uint32_t chWaitMultipleTimeout(const wait_item_t *items, unsigned n,
+                                 sysinterval_t timeout);
+  void __wait_notify_i(const void *objp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Notifies a state change of a waitable object.
+ * @details The threads waiting on the object are made ready, the check is
+ *          a single comparison when no thread is waiting.
+ * @note    This function does not reschedule.
+ *
+ * @param[in] objp      pointer to the object, or to the thread owning the
+ *                      signaled events
+ *
+ * @iclass
+ */
+static inline void chWaitNotifyI(const void *objp) {
+
+  chDbgCheckClassI();
+
+  if (ch_queue_notempty(&ch_wait_pollers)) {
+    __wait_notify_i(objp);
+  }
+}
+
+/**
+ * @brief   Notifies a state change of a waitable object.
+ * @details The threads waiting on the object are made ready.
+ *
+ * @param[in] objp      pointer to the object
+ *
+ * @api
+ */
+static inline void chWaitNotify(const void *objp) {
+
+  chSysLock();
+  chWaitNotifyI(objp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+#endif /* CH_CFG_USE_WAIT_MULTIPLE == TRUE */
+
+#endif /* CHWAITMULTI_H */
+
+/** @} */
@@ -26,27 +26,43 @@ endif
 ifneq ($(findstring CH_CFG_USE_MEMPOOLS TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/oslib/src/chmempools.c
 endif
+ifneq ($(findstring CH_DBG_MEM_PROFILING TRUE,$(CHLIBCONF)),)
+LIBSRC += $(CHIBIOS)/os/oslib/src/chmemprof.c
+endif
 ifneq ($(findstring CH_CFG_USE_PIPES TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/oslib/src/chpipes.c
 endif
+ifneq ($(findstring CH_CFG_USE_WAIT_MULTIPLE TRUE,$(CHLIBCONF)),)
+LIBSRC += $(CHIBIOS)/os/oslib/src/chwaitmulti.c
+endif
 ifneq ($(findstring CH_CFG_USE_OBJ_CACHES TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/oslib/src/chobjcaches.c
 endif
 ifneq ($(findstring CH_CFG_USE_DELEGATES TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/oslib/src/chdelegates.c
 endif
+ifneq ($(findstring CH_CFG_USE_PIPELINES TRUE,$(CHLIBCONF)),)
+LIBSRC += $(CHIBIOS)/os/oslib/src/chpipelines.c
+endif
 ifneq ($(findstring CH_CFG_USE_FACTORY TRUE,$(CHLIBCONF)),)
 LIBSRC += $(CHIBIOS)/os/oslib/src/chfactory.c
 endif
+LIBSRC += $(CHIBIOS)/os/oslib/src/chsnapshots.c
+LIBSRC += $(CHIBIOS)/os/oslib/src/chintercore.c
 else
 LIBSRC := $(CHIBIOS)/os/oslib/src/chmboxes.c \
           $(CHIBIOS)/os/oslib/src/chmemcore.c \
           $(CHIBIOS)/os/oslib/src/chmemheaps.c \
           $(CHIBIOS)/os/oslib/src/chmempools.c \
+          $(CHIBIOS)/os/oslib/src/chmemprof.c \
           $(CHIBIOS)/os/oslib/src/chpipes.c \
+          $(CHIBIOS)/os/oslib/src/chwaitmulti.c \
           $(CHIBIOS)/os/oslib/src/chobjcaches.c \
           $(CHIBIOS)/os/oslib/src/chdelegates.c \
-          $(CHIBIOS)/os/oslib/src/chfactory.c
+          $(CHIBIOS)/os/oslib/src/chpipelines.c \
+          $(CHIBIOS)/os/oslib/src/chfactory.c \
+          $(CHIBIOS)/os/oslib/src/chsnapshots.c \
+          $(CHIBIOS)/os/oslib/src/chintercore.c
 endif
 
 # Required include directories
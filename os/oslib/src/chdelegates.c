@@ -27,6 +27,12 @@
  *          encapsulating a library not designed for threading into a
  *          delegate thread. Other threads have access to the library without
  *          having to worry about mutual exclusion.
+ *          <h2>Asynchronous calls</h2>
+ *          Calls posted in a delegate queue do not block the caller, the
+ *          call objects are provided by the caller and work as futures,
+ *          the caller can wait for the execution and retrieve the return
+ *          value. The dispatcher thread executes all the queued calls on
+ *          each wakeup.
  * @pre     In order to use the pipes APIs the @p CH_CFG_USE_DELEGATES
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -73,6 +79,29 @@ typedef struct {
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Executes an asynchronous call.
+ *
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ * @return              The function return value.
+ */
+static msg_t delegate_execute(const delegate_call_t *dcp) {
+
+  switch (dcp->argc) {
+  case 0U:
+    return dcp->func.fn0();
+  case 1U:
+    return dcp->func.fn1(dcp->args[0]);
+  case 2U:
+    return dcp->func.fn2(dcp->args[0], dcp->args[1]);
+  case 3U:
+    return dcp->func.fn3(dcp->args[0], dcp->args[1], dcp->args[2]);
+  default:
+    return dcp->func.fn4(dcp->args[0], dcp->args[1], dcp->args[2],
+                         dcp->args[3]);
+  }
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -234,6 +263,150 @@ msg_t chDelegateDispatchTimeout(sysinterval_t timeout) {
   return MSG_OK;
 }
 
+/**
+ * @brief   Posts an asynchronous call in a delegate queue.
+ * @details The function returns immediately, the call is executed by the
+ *          thread dispatching the queue.
+ * @pre     The call object must have been initialized and must not be
+ *          already queued.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t structure
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ *
+ * @iclass
+ */
+void chDelegatePostI(delegate_queue_t *dqp, delegate_call_t *dcp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((dqp != NULL) && (dcp != NULL));
+  chDbgAssert(dcp->done, "call pending");
+
+  dcp->next   = NULL;
+  dcp->done   = false;
+  dcp->waiter = NULL;
+  if (dqp->first == NULL) {
+    dqp->first = dcp;
+  }
+  else {
+    dqp->last->next = dcp;
+  }
+  dqp->last = dcp;
+
+  /* Waking up the dispatcher, if waiting.*/
+  chThdResumeI(&dqp->tr, MSG_OK);
+}
+
+/**
+ * @brief   Posts an asynchronous call in a delegate queue.
+ * @details The function returns immediately, the call is executed by the
+ *          thread dispatching the queue.
+ * @pre     The call object must have been initialized and must not be
+ *          already queued.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t structure
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ *
+ * @api
+ */
+void chDelegatePost(delegate_queue_t *dqp, delegate_call_t *dcp) {
+
+  chSysLock();
+  chDelegatePostI(dqp, dcp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Waits for the execution of an asynchronous call.
+ * @note    Only one thread can wait on a call object.
+ *
+ * @param[in] dcp       pointer to a @p delegate_call_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The wait outcome, the function return value is
+ *                      retrieved using @p chDelegateGetResultX().
+ * @retval MSG_OK       if the call has been executed.
+ * @retval MSG_TIMEOUT  if a timeout occurred.
+ *
+ * @api
+ */
+msg_t chDelegateWaitTimeout(delegate_call_t *dcp, sysinterval_t timeout) {
+  msg_t msg = MSG_OK;
+
+  chDbgCheck(dcp != NULL);
+
+  chSysLock();
+  if (!dcp->done) {
+    msg = chThdSuspendTimeoutS(&dcp->waiter, timeout);
+  }
+  chSysUnlock();
+
+  return msg;
+}
+
+/**
+ * @brief   Dispatches the calls queued in a delegate queue.
+ * @details The function waits for queued calls then executes all of them,
+ *          the queue is emptied under a single critical zone and the
+ *          waiting threads are rescheduled once after the whole batch.
+ *
+ * @param[in] dqp       pointer to a @p delegate_queue_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The function outcome.
+ * @retval MSG_OK       if at least one function has been called.
+ * @retval MSG_TIMEOUT  if a timeout occurred.
+ *
+ * @api
+ */
+msg_t chDelegateDispatchQueueTimeout(delegate_queue_t *dqp,
+                                     sysinterval_t timeout) {
+  delegate_call_t *dcp;
+
+  chDbgCheck(dqp != NULL);
+
+  chSysLock();
+  if (dqp->first == NULL) {
+    if (chThdSuspendTimeoutS(&dqp->tr, timeout) == MSG_TIMEOUT) {
+      chSysUnlock();
+      return MSG_TIMEOUT;
+    }
+  }
+
+  /* Taking the whole batch of queued calls.*/
+  dcp = dqp->first;
+  dqp->first = NULL;
+  chSysUnlock();
+
+  do {
+    /* The call object can be reused by its owner as soon as it is marked
+       as executed, the link must be read before.*/
+    delegate_call_t *next = dcp->next;
+    msg_t ret = delegate_execute(dcp);
+
+    chSysLock();
+    dcp->result = ret;
+    dcp->done   = true;
+    chThdResumeI(&dcp->waiter, MSG_OK);
+    chSysUnlock();
+
+    dcp = next;
+  } while (dcp != NULL);
+
+  /* Waiters are rescheduled once for the whole batch.*/
+  chSysLock();
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return MSG_OK;
+}
+
 #endif /* CH_CFG_USE_DELEGATES == TRUE */
 
 /** @} */
@@ -95,6 +95,85 @@ static void copy_name(const char *sp, char *dp) {
   } while ((c != (char)0) && (i > 0U));
 }
 
+#if (CH_CFG_FACTORY_HASH_BUCKETS > 0) || defined(__DOXYGEN__)
+/*
+ * FNV-1a hash of the significant part of a name.
+ */
+static uint32_t dyn_hash(const char *name) {
+  uint32_t hash = 2166136261U;
+#if CH_CFG_FACTORY_MAX_NAMES_LENGTH > 0
+  unsigned i = CH_CFG_FACTORY_MAX_NAMES_LENGTH;
+
+  while ((*name != (char)0) && (i > 0U)) {
+    hash = (hash ^ (uint32_t)(uint8_t)*name++) * 16777619U;
+    i--;
+  }
+#else
+  while (*name != (char)0) {
+    hash = (hash ^ (uint32_t)(uint8_t)*name++) * 16777619U;
+  }
+#endif
+
+  return hash;
+}
+
+static inline dyn_element_t **dyn_list_bucket(dyn_list_t *dlp,
+                                              uint32_t hash) {
+
+  return &dlp->buckets[hash & ((uint32_t)CH_CFG_FACTORY_HASH_BUCKETS - 1U)];
+}
+
+static inline void dyn_list_init(dyn_list_t *dlp) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_FACTORY_HASH_BUCKETS; i++) {
+    dlp->buckets[i] = NULL;
+  }
+}
+
+static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
+  uint32_t hash = dyn_hash(name);
+  dyn_element_t *p = *dyn_list_bucket(dlp, hash);
+
+  while (p != NULL) {
+    if ((p->hash == hash) &&
+        (strncmp(p->name, name, CH_CFG_FACTORY_MAX_NAMES_LENGTH) == 0)) {
+      return p;
+    }
+    p = p->next;
+  }
+
+  return NULL;
+}
+
+static void dyn_list_link(dyn_element_t *element, dyn_list_t *dlp) {
+  dyn_element_t **bpp;
+
+  element->hash = dyn_hash(element->name);
+  bpp = dyn_list_bucket(dlp, element->hash);
+  element->next = *bpp;
+  *bpp = element;
+}
+
+static dyn_element_t *dyn_list_unlink(dyn_element_t *element,
+                                      dyn_list_t *dlp) {
+  dyn_element_t **prevp = dyn_list_bucket(dlp, element->hash);
+
+  /* Scanning the bucket.*/
+  while (*prevp != NULL) {
+    if (*prevp == element) {
+      /* Found.*/
+      *prevp = element->next;
+      return element;
+    }
+
+    /* Next element in the bucket.*/
+    prevp = &(*prevp)->next;
+  }
+
+  return NULL;
+}
+#else /* CH_CFG_FACTORY_HASH_BUCKETS == 0 */
 static inline void dyn_list_init(dyn_list_t *dlp) {
 
   dlp->next = (dyn_element_t *)dlp;
@@ -113,6 +192,12 @@ static dyn_element_t *dyn_list_find(const char *name, dyn_list_t *dlp) {
   return NULL;
 }
 
+static void dyn_list_link(dyn_element_t *element, dyn_list_t *dlp) {
+
+  element->next = dlp->next;
+  dlp->next = element;
+}
+
 static dyn_element_t *dyn_list_unlink(dyn_element_t *element,
                                       dyn_list_t *dlp) {
   dyn_element_t *prev = (dyn_element_t *)dlp;
@@ -131,6 +216,7 @@ static dyn_element_t *dyn_list_unlink(dyn_element_t *element,
 
   return NULL;
 }
+#endif /* CH_CFG_FACTORY_HASH_BUCKETS == 0 */
 
 #if CH_FACTORY_REQUIRES_HEAP || defined(__DOXYGEN__)
 static dyn_element_t *dyn_create_object_heap(const char *name,
@@ -155,10 +241,9 @@ static dyn_element_t *dyn_create_object_heap(const char *name,
   /* Initializing object list element.*/
   copy_name(name, dep->name);
   dep->refs = (ucnt_t)1;
-  dep->next = dlp->next;
 
   /* Updating factory list.*/
-  dlp->next = dep;
+  dyn_list_link(dep, dlp);
 
   return dep;
 }
@@ -200,10 +285,9 @@ static dyn_element_t *dyn_create_object_pool(const char *name,
   /* Initializing object list element.*/
   copy_name(name, dep->name);
   dep->refs = (ucnt_t)1;
-  dep->next = dlp->next;
 
   /* Updating factory list.*/
-  dlp->next = (dyn_element_t *)dep;
+  dyn_list_link(dep, dlp);
 
   return dep;
 }
@@ -0,0 +1,352 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chintercore.c
+ * @brief   Inter-core channels code.
+ * @details Objects channels between cores sharing memory.
+ *          <h2>Operation mode</h2>
+ *          Each ring has a single producer core and a single consumer
+ *          core, the sent ring is written by the sender core and the free
+ *          ring by the receiver core. On each core the accesses to the
+ *          rings are serialized by the kernel lock so any number of local
+ *          threads can use the channel.<br>
+ *          A thread finding a ring empty waits on the local queue of the
+ *          channel, the queue is woken up by @p chICDoorbellI() when the
+ *          other core notifies a posted object. The notification is
+ *          received with the kernel locked, a notification arriving
+ *          between the ring check and the wait is delayed until the
+ *          thread is waiting so it cannot be lost.
+ * @note    Compatible with RT and NIL.
+ *
+ * @addtogroup oslib_intercore
+ * @{
+ */
+
+#include "ch.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*
+ * Memory barrier, ring slots accesses must not be moved across the update
+ * of the ring counters. A hardware barrier is required because the
+ * counters are observed by the other core.
+ */
+#if !defined(IC_BARRIER)
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define IC_BARRIER()        __sync_synchronize()
+#else
+#error "IC_BARRIER() not defined for this compiler"
+#endif
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Writes an object index in a ring.
+ * @note    The ring cannot be full because it has a slot for each object.
+ *
+ * @param[in] shp       pointer to the shared part of the channel
+ * @param[in] rp        pointer to the ring
+ * @param[in] objp      pointer to the object
+ */
+static void ic_ring_put(ic_shared_t *shp, ic_ring_t *rp, void *objp) {
+  size_t offset = (size_t)((uint8_t *)objp - shp->objbuf);
+  uint32_t wr = rp->wrcnt;
+
+  chDbgAssert(((uint8_t *)objp >= shp->objbuf) &&
+              (offset < (shp->objsize * (size_t)shp->objn)) &&
+              ((offset % shp->objsize) == 0U), "not a channel object");
+  chDbgAssert((wr - rp->rdcnt) < shp->objn, "ring full");
+
+  rp->slots[wr % shp->objn] = (uint32_t)(offset / shp->objsize);
+  IC_BARRIER();
+  rp->wrcnt = wr + 1U;
+}
+
+/**
+ * @brief   Reads an object index from a ring.
+ *
+ * @param[in] shp       pointer to the shared part of the channel
+ * @param[in] rp        pointer to the ring
+ * @return              The pointer to the object.
+ * @retval NULL         if the ring is empty.
+ */
+static void *ic_ring_get(ic_shared_t *shp, ic_ring_t *rp) {
+  uint32_t rd = rp->rdcnt;
+  uint32_t idx;
+
+  if (rp->wrcnt == rd) {
+    return NULL;
+  }
+
+  IC_BARRIER();
+  idx = rp->slots[rd % shp->objn];
+  IC_BARRIER();
+  rp->rdcnt = rd + 1U;
+
+  return (void *)(shp->objbuf + ((size_t)idx * shp->objsize));
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the shared part of a channel.
+ * @details All the objects are placed in the free ring.
+ * @note    This function must be called by a single core before the
+ *          channel is used by both cores.
+ * @pre     The objects size must be a multiple of the alignment
+ *          requirement.
+ *
+ * @param[out] shp      pointer to a @p ic_shared_t structure
+ * @param[in] objsize   size of objects
+ * @param[in] objn      number of objects available
+ * @param[in] objbuf    pointer to the buffer of objects, it must be able
+ *                      to hold @p objn objects of @p objsize size
+ * @param[in] sentbuf   pointer to the sent ring slots, it must be able to
+ *                      hold @p objn indexes
+ * @param[in] freebuf   pointer to the free ring slots, it must be able to
+ *                      hold @p objn indexes
+ *
+ * @init
+ */
+void chICSharedObjectInit(ic_shared_t *shp, size_t objsize, uint32_t objn,
+                          void *objbuf, uint32_t *sentbuf,
+                          uint32_t *freebuf) {
+  uint32_t i;
+
+  chDbgCheck((shp != NULL) && (objsize > 0U) && (objn > 0U) &&
+             (objbuf != NULL) && (sentbuf != NULL) && (freebuf != NULL));
+
+  shp->objsize      = objsize;
+  shp->objn         = objn;
+  shp->objbuf       = (uint8_t *)objbuf;
+  shp->sent.wrcnt   = 0U;
+  shp->sent.rdcnt   = 0U;
+  shp->sent.slots   = sentbuf;
+  shp->free.rdcnt   = 0U;
+  shp->free.slots   = freebuf;
+  for (i = 0U; i < objn; i++) {
+    freebuf[i] = i;
+  }
+  IC_BARRIER();
+  shp->free.wrcnt   = objn;
+}
+
+/**
+ * @brief   Initializes the local part of a channel.
+ * @details The notification callback is invoked each time an object is
+ *          posted by this core, it must notify the other core which in
+ *          turn must call @p chICDoorbellI() on its own channel object.
+ *
+ * @param[out] icp      pointer to a @p ic_channel_t structure
+ * @param[in] shp       pointer to the shared part of the channel
+ * @param[in] notify    notification callback
+ * @param[in] param     parameter of the notification callback
+ *
+ * @init
+ */
+void chICObjectInit(ic_channel_t *icp, ic_shared_t *shp,
+                    icnotify_t notify, void *param) {
+
+  chDbgCheck((icp != NULL) && (shp != NULL) && (notify != NULL));
+
+  icp->shp    = shp;
+  icp->notify = notify;
+  icp->param  = param;
+  chThdQueueObjectInit(&icp->waiting);
+}
+
+/**
+ * @brief   Handles a notification from the other core.
+ * @details The threads waiting on the channel are woken up, they check
+ *          the rings again.
+ * @note    This function must be called from the doorbell interrupt
+ *          handler or from the notification callback of the other
+ *          channel object when both are on the same core.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ *
+ * @iclass
+ */
+void chICDoorbellI(ic_channel_t *icp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(icp != NULL);
+
+  chThdDequeueAllI(&icp->waiting, MSG_OK);
+}
+
+/**
+ * @brief   Allocates a free object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if an object is not immediately available.
+ *
+ * @iclass
+ */
+void *chICTakeObjectI(ic_channel_t *icp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(icp != NULL);
+
+  return ic_ring_get(icp->shp, &icp->shp->free);
+}
+
+/**
+ * @brief   Allocates a free object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if an object is not available within the specified
+ *                      timeout.
+ *
+ * @sclass
+ */
+void *chICTakeObjectTimeoutS(ic_channel_t *icp, sysinterval_t timeout) {
+  void *objp;
+
+  chDbgCheckClassS();
+  chDbgCheck(icp != NULL);
+
+  objp = ic_ring_get(icp->shp, &icp->shp->free);
+  while (objp == NULL) {
+    if (chThdEnqueueTimeoutS(&icp->waiting, timeout) != MSG_OK) {
+      return NULL;
+    }
+    objp = ic_ring_get(icp->shp, &icp->shp->free);
+  }
+
+  return objp;
+}
+
+/**
+ * @brief   Posts an object.
+ * @note    By design the object can be always immediately posted.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be posted
+ *
+ * @iclass
+ */
+void chICSendObjectI(ic_channel_t *icp, void *objp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((icp != NULL) && (objp != NULL));
+
+  ic_ring_put(icp->shp, &icp->shp->sent, objp);
+  icp->notify(icp->param);
+}
+
+/**
+ * @brief   Fetches an object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objpp     pointer to the fetched object reference
+ * @return              The operation status.
+ * @retval MSG_OK       if an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the channel is empty.
+ *
+ * @iclass
+ */
+msg_t chICReceiveObjectI(ic_channel_t *icp, void **objpp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((icp != NULL) && (objpp != NULL));
+
+  *objpp = ic_ring_get(icp->shp, &icp->shp->sent);
+
+  return *objpp != NULL ? MSG_OK : MSG_TIMEOUT;
+}
+
+/**
+ * @brief   Fetches an object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objpp     pointer to the fetched object reference
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if an object has been correctly fetched.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @sclass
+ */
+msg_t chICReceiveObjectTimeoutS(ic_channel_t *icp, void **objpp,
+                                sysinterval_t timeout) {
+
+  chDbgCheckClassS();
+  chDbgCheck((icp != NULL) && (objpp != NULL));
+
+  *objpp = ic_ring_get(icp->shp, &icp->shp->sent);
+  while (*objpp == NULL) {
+    if (chThdEnqueueTimeoutS(&icp->waiting, timeout) != MSG_OK) {
+      return MSG_TIMEOUT;
+    }
+    *objpp = ic_ring_get(icp->shp, &icp->shp->sent);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Releases a fetched object.
+ *
+ * @param[in] icp       pointer to a @p ic_channel_t structure
+ * @param[in] objp      pointer to the object to be released
+ *
+ * @iclass
+ */
+void chICReturnObjectI(ic_channel_t *icp, void *objp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((icp != NULL) && (objp != NULL));
+
+  ic_ring_put(icp->shp, &icp->shp->free, objp);
+  icp->notify(icp->param);
+}
+
+/** @} */
@@ -211,9 +211,18 @@ msg_t chMBPostTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
       }
       mbp->cnt++;
 
-      /* If there is a reader waiting then makes it ready.*/
-      chThdDequeueNextI(&mbp->qr, MSG_OK);
-      chSchRescheduleS();
+      /* If there is a reader waiting then makes it ready, the fast path
+         does not need to reschedule.*/
+      if (!chThdQueueIsEmptyI(&mbp->qr)) {
+        chThdDequeueNextI(&mbp->qr, MSG_OK);
+        chSchRescheduleS();
+      }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+      else {
+        chWaitNotifyI(mbp);
+        chSchRescheduleS();
+      }
+#endif
 
       return MSG_OK;
     }
@@ -260,6 +269,9 @@ msg_t chMBPostI(mailbox_t *mbp, msg_t msg) {
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+    chWaitNotifyI(mbp);
+#endif
 
     return MSG_OK;
   }
@@ -336,9 +348,18 @@ msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
       *mbp->rdptr = msg;
       mbp->cnt++;
 
-      /* If there is a reader waiting then makes it ready.*/
-      chThdDequeueNextI(&mbp->qr, MSG_OK);
-      chSchRescheduleS();
+      /* If there is a reader waiting then makes it ready, the fast path
+         does not need to reschedule.*/
+      if (!chThdQueueIsEmptyI(&mbp->qr)) {
+        chThdDequeueNextI(&mbp->qr, MSG_OK);
+        chSchRescheduleS();
+      }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+      else {
+        chWaitNotifyI(mbp);
+        chSchRescheduleS();
+      }
+#endif
 
       return MSG_OK;
     }
@@ -385,6 +406,9 @@ msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg) {
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+    chWaitNotifyI(mbp);
+#endif
 
     return MSG_OK;
   }
@@ -461,9 +485,12 @@ msg_t chMBFetchTimeoutS(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout) {
       }
       mbp->cnt--;
 
-      /* If there is a writer waiting then makes it ready.*/
-      chThdDequeueNextI(&mbp->qw, MSG_OK);
-      chSchRescheduleS();
+      /* If there is a writer waiting then makes it ready, the fast path
+         does not need to reschedule.*/
+      if (!chThdQueueIsEmptyI(&mbp->qw)) {
+        chThdDequeueNextI(&mbp->qw, MSG_OK);
+        chSchRescheduleS();
+      }
 
       return MSG_OK;
     }
@@ -38,6 +38,25 @@
  *          This allocator, alone, is also useful for very simple
  *          applications that just require a simple way to get memory
  *          blocks.
+ *          <h2>Memory regions</h2>
+ *          Additional memory areas can be added as regions having a set of
+ *          attributes, allocations with an hint are served by the first
+ *          region, in the order regions have been added, having all the
+ *          attributes specified by the hint. This allows to place CPU hot
+ *          data into TCM and DMA buffers into DMA-reachable RAM, for
+ *          example on STM32H7:
+ *          @code
+ *          extern uint8_t __ram5_free__[], __ram5_end__[];
+ *          extern uint8_t __ram4_free__[], __ram4_end__[];
+ *
+ *          chCoreAddRegion(&dtcm, "DTCM", MEM_ATTR_FAST,
+ *                          __ram5_free__, __ram5_end__);
+ *          chCoreAddRegion(&sram4, "SRAM4", MEM_ATTR_DMA | MEM_ATTR_USER(0),
+ *                          __ram4_free__, __ram4_end__);
+ *          @endcode
+ *          Heaps and pools can be placed in a region by using a block
+ *          allocated with an hint as heap buffer or by using, as pool
+ *          provider, a function calling @p chCoreAllocWithHintI().
  * @pre     In order to use the core memory manager APIs the @p CH_CFG_USE_MEMCORE
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -65,6 +84,11 @@ memcore_t ch_memcore;
 /* Module local variables.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Memory regions list in preference order.
+ */
+static memcore_region_t *regions;
+
 /*===========================================================================*/
 /* Module local functions.                                                   */
 /*===========================================================================*/
@@ -93,6 +117,7 @@ void __core_init(void) {
   ch_memcore.basemem = &static_heap[0];
   ch_memcore.topmem  = &static_heap[CH_CFG_MEMCORE_SIZE];
 #endif
+  regions = NULL;
 }
 
 /**
@@ -182,6 +207,13 @@ void *chCoreAllocFromBase(size_t size, unsigned align, size_t offset) {
   p = chCoreAllocFromBaseI(size, align, offset);
   chSysUnlock();
 
+#if CH_DBG_MEM_PROFILING == TRUE
+  if (p != NULL) {
+    (void) __memprof_alloc(__memprof_get_caller(), CH_MEMPROF_CORE,
+                           size + offset);
+  }
+#endif
+
   return p;
 }
 
@@ -206,6 +238,13 @@ void *chCoreAllocFromTop(size_t size, unsigned align, size_t offset) {
   p = chCoreAllocFromTopI(size, align, offset);
   chSysUnlock();
 
+#if CH_DBG_MEM_PROFILING == TRUE
+  if (p != NULL) {
+    (void) __memprof_alloc(__memprof_get_caller(), CH_MEMPROF_CORE,
+                           size + offset);
+  }
+#endif
+
   return p;
 }
 
@@ -222,6 +261,182 @@ size_t chCoreGetStatusX(void) {
   return (size_t)(ch_memcore.topmem - ch_memcore.basemem);
   /*lint -restore*/
 }
+
+/**
+ * @brief   Adds a memory region.
+ * @details The region is appended to the regions list, regions are
+ *          considered in the order they have been added.
+ * @note    The memory area must not overlap the default core memory or
+ *          other regions.
+ *
+ * @param[out] mrp      pointer to a @p memcore_region_t structure
+ * @param[in] name      region name
+ * @param[in] attrs     region attributes
+ * @param[in] base      region base address
+ * @param[in] end       region end address, the first address after the
+ *                      region
+ *
+ * @api
+ */
+void chCoreAddRegion(memcore_region_t *mrp, const char *name,
+                     uint32_t attrs, void *base, void *end) {
+  memcore_region_t **mrpp;
+
+  chDbgCheck((mrp != NULL) && ((uint8_t *)base <= (uint8_t *)end));
+
+  mrp->next         = NULL;
+  mrp->name         = name;
+  mrp->attrs        = attrs;
+  mrp->core.basemem = (uint8_t *)base;
+  mrp->core.topmem  = (uint8_t *)end;
+  /*lint -save -e9033 [10.8] The cast is safe.*/
+  mrp->size         = (size_t)((uint8_t *)end - (uint8_t *)base);
+  /*lint -restore*/
+  mrp->allocations  = (ucnt_t)0;
+  mrp->failures     = (ucnt_t)0;
+
+  chSysLock();
+  mrpp = &regions;
+  while (*mrpp != NULL) {
+    mrpp = &(*mrpp)->next;
+  }
+  *mrpp = mrp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Allocates a memory block from a region.
+ * @details This function allocates a block of @p offset + @p size bytes
+ *          starting from the top of the region. The returned pointer has
+ *          @p offset bytes before its address and @p size bytes after.
+ *
+ * @param[in] mrp       pointer to a @p memcore_region_t structure
+ * @param[in] size      the size of the block to be allocated.
+ * @param[in] align     desired memory alignment
+ * @param[in] offset    aligned pointer offset
+ * @return              A pointer to the allocated memory block.
+ * @retval NULL         allocation failed, region memory exhausted.
+ *
+ * @iclass
+ */
+void *chCoreAllocFromRegionI(memcore_region_t *mrp, size_t size,
+                             unsigned align, size_t offset) {
+  uint8_t *p, *prev;
+
+  chDbgCheckClassI();
+  chDbgCheck((mrp != NULL) && MEM_IS_VALID_ALIGNMENT(align));
+
+  p = (uint8_t *)MEM_ALIGN_PREV(mrp->core.topmem - size, align);
+  prev = p - offset;
+
+  /* Considering also the case where there is numeric overflow.*/
+  if ((prev < mrp->core.basemem) || (prev > mrp->core.topmem)) {
+    mrp->failures++;
+    return NULL;
+  }
+
+  mrp->core.topmem = prev;
+  mrp->allocations++;
+
+  return p;
+}
+
+/**
+ * @brief   Allocates a memory block using a placement hint.
+ * @details The block is allocated from the first region, in the order
+ *          regions have been added, having all the attributes specified
+ *          in @p hint and enough free memory. If @p hint is
+ *          @p MEM_ATTR_NONE then the block is allocated from the default
+ *          core memory.
+ *
+ * @param[in] size      the size of the block to be allocated.
+ * @param[in] align     desired memory alignment
+ * @param[in] offset    aligned pointer offset
+ * @param[in] hint      required region attributes
+ * @return              A pointer to the allocated memory block.
+ * @retval NULL         allocation failed, no matching region has enough
+ *                      free memory.
+ *
+ * @iclass
+ */
+void *chCoreAllocWithHintI(size_t size, unsigned align, size_t offset,
+                           uint32_t hint) {
+  memcore_region_t *mrp;
+
+  chDbgCheckClassI();
+
+  if (hint == MEM_ATTR_NONE) {
+    return chCoreAllocFromTopI(size, align, offset);
+  }
+
+  for (mrp = regions; mrp != NULL; mrp = mrp->next) {
+    if ((mrp->attrs & hint) == hint) {
+      void *p = chCoreAllocFromRegionI(mrp, size, align, offset);
+      if (p != NULL) {
+        return p;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Allocates a memory block using a placement hint.
+ * @details The block is allocated from the first region, in the order
+ *          regions have been added, having all the attributes specified
+ *          in @p hint and enough free memory. If @p hint is
+ *          @p MEM_ATTR_NONE then the block is allocated from the default
+ *          core memory.
+ *
+ * @param[in] size      the size of the block to be allocated.
+ * @param[in] align     desired memory alignment
+ * @param[in] offset    aligned pointer offset
+ * @param[in] hint      required region attributes
+ * @return              A pointer to the allocated memory block.
+ * @retval NULL         allocation failed, no matching region has enough
+ *                      free memory.
+ *
+ * @api
+ */
+void *chCoreAllocWithHint(size_t size, unsigned align, size_t offset,
+                          uint32_t hint) {
+  void *p;
+
+  chSysLock();
+  p = chCoreAllocWithHintI(size, align, offset, hint);
+  chSysUnlock();
+
+#if CH_DBG_MEM_PROFILING == TRUE
+  if (p != NULL) {
+    (void) __memprof_alloc(__memprof_get_caller(), CH_MEMPROF_CORE,
+                           size + offset);
+  }
+#endif
+
+  return p;
+}
+
+/**
+ * @brief   Returns the statistics of a memory region.
+ *
+ * @param[in] mrp       pointer to a @p memcore_region_t structure
+ * @param[out] sp       pointer to the statistics to be filled
+ *
+ * @xclass
+ */
+void chCoreGetRegionStatsX(memcore_region_t *mrp,
+                           memcore_region_stats_t *sp) {
+
+  chDbgCheck((mrp != NULL) && (sp != NULL));
+
+  sp->size        = mrp->size;
+  /*lint -save -e9033 [10.8] The cast is safe.*/
+  sp->free        = (size_t)(mrp->core.topmem - mrp->core.basemem);
+  /*lint -restore*/
+  sp->allocations = mrp->allocations;
+  sp->failures    = mrp->failures;
+}
 #endif /* CH_CFG_USE_MEMCORE == TRUE */
 
 /** @} */
@@ -29,6 +29,9 @@
  *          library functions. The main difference is that the OS heap APIs
  *          are guaranteed to be thread safe and there is the ability to
  *          return memory blocks aligned to arbitrary powers of two.<br>
+ *          If the @p CH_CFG_USE_HEAP_TLSF option is enabled then a two
+ *          levels segregated fit strategy is used instead, allocation and
+ *          release are performed in constant time.<br>
  * @pre     In order to use the heap APIs the @p CH_CFG_USE_HEAP option must
  *          be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -54,6 +57,24 @@
 #define H_UNLOCK(h)     chSemSignal(&(h)->sem)
 #endif
 
+/*
+ * Allocations profiling, the block is linked to its call site.
+ */
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+#define H_PROF_ALLOC(hp) {                                                  \
+  (hp)->used.site  = __memprof_alloc(__memprof_get_caller(),                \
+                                     CH_MEMPROF_HEAP, (hp)->used.size);     \
+  (hp)->used.owner = chThdGetSelfX();                                       \
+}
+
+#define H_PROF_FREE(hp) __memprof_free((hp)->used.site, (hp)->used.size)
+#else
+#define H_PROF_ALLOC(hp)
+
+#define H_PROF_FREE(hp)
+#endif
+
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
 #define H_BLOCK(hp)     ((hp) + 1U)
 
 #define H_LIMIT(hp)     (H_BLOCK(hp) + H_PAGES(hp))
@@ -74,6 +95,66 @@
   ((size_t)((p1) - (p2)))                                                   \
   /*lint -restore*/
 
+#else /* CH_CFG_USE_HEAP_TLSF == TRUE */
+/*
+ * TLSF mode, the block size in pages and the block flags are packed in the
+ * "info" field of the header.
+ */
+#define H_FREE_FLAG     1U
+
+#define H_LAST_FLAG     2U
+
+#define H_FLAGS_MASK    3U
+
+#define H_INFO(hp)      ((hp)->free.info)
+
+#define H_PHYS(hp)      ((hp)->free.phys)
+
+#define H_FNEXT(hp)     ((hp)->free.next)
+
+#define H_FPREV(hp)     ((hp)->free.prev)
+
+#define H_PAGES(hp)     (H_INFO(hp) >> 2)
+
+#define H_SET_PAGES(hp, n)                                                  \
+  (H_INFO(hp) = ((size_t)(n) << 2) | (H_INFO(hp) & (size_t)H_FLAGS_MASK))
+
+#define H_IS_FREE(hp)   ((H_INFO(hp) & (size_t)H_FREE_FLAG) != 0U)
+
+#define H_IS_LAST(hp)   ((H_INFO(hp) & (size_t)H_LAST_FLAG) != 0U)
+
+#define H_BLOCK(hp)     ((hp) + 1U)
+
+#define H_HEAP(hp)      ((hp)->used.heap)
+
+#define H_SIZE(hp)      ((hp)->used.size)
+
+/*
+ * Size of a block header in pages.
+ */
+#define H_HDR_PAGES     (sizeof (heap_header_t) / CH_HEAP_ALIGNMENT)
+
+/*
+ * Largest block size in pages.
+ */
+#define H_MAX_PAGES     (((size_t)1 << (CH_HEAP_TLSF_FL_COUNT + 2U)) - 1U)
+
+/*
+ * Number of pages between two pointers in a MISRA-compatible way.
+ */
+#define NPAGES(p1, p2)                                                      \
+  /*lint -save -e9033 [10.8] The cast is safe.*/                            \
+  ((size_t)((uint8_t *)(p1) - (uint8_t *)(p2)) / CH_HEAP_ALIGNMENT)         \
+  /*lint -restore*/
+
+/*
+ * Physical block following the specified one.
+ */
+#define H_PHYS_NEXT(hp)                                                     \
+  ((heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) +                       \
+                             (H_PAGES(hp) * CH_HEAP_ALIGNMENT)))
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -95,10 +176,237 @@ static memory_heap_t default_heap;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Index of the most significant bit set.
+ *
+ * @param[in] x         the value, must not be zero
+ * @return              The bit index.
+ *
+ * @notapi
+ */
+static unsigned heap_fls(uint32_t x) {
+#if defined(port_clz32)
+  return 31U - (unsigned)port_clz32(x);
+#else
+  unsigned n = 0U;
+
+  if ((x & 0xFFFF0000U) != 0U) {
+    x >>= 16;
+    n += 16U;
+  }
+  if ((x & 0x0000FF00U) != 0U) {
+    x >>= 8;
+    n += 8U;
+  }
+  if ((x & 0x000000F0U) != 0U) {
+    x >>= 4;
+    n += 4U;
+  }
+  if ((x & 0x0000000CU) != 0U) {
+    x >>= 2;
+    n += 2U;
+  }
+  if ((x & 0x00000002U) != 0U) {
+    n += 1U;
+  }
+
+  return n;
+#endif
+}
+
+/**
+ * @brief   Index of the least significant bit set.
+ *
+ * @param[in] x         the value, must not be zero
+ * @return              The bit index.
+ *
+ * @notapi
+ */
+static inline unsigned heap_ffs(uint32_t x) {
+
+  return heap_fls(x & (~x + 1U));
+}
+
+/**
+ * @brief   Size class of a number of pages.
+ *
+ * @param[in] pages     the number of pages, must not exceed
+ *                      @p H_MAX_PAGES
+ * @param[out] flp      first level index
+ * @param[out] slp      second level index
+ *
+ * @notapi
+ */
+static void heap_mapping(size_t pages, unsigned *flp, unsigned *slp) {
+
+  if (pages < (size_t)CH_HEAP_TLSF_SL_COUNT) {
+    *flp = 0U;
+    *slp = (unsigned)pages;
+  }
+  else {
+    unsigned f = heap_fls((uint32_t)pages);
+
+    *flp = f - 2U;
+    *slp = (unsigned)(pages >> (f - 3U)) - CH_HEAP_TLSF_SL_COUNT;
+  }
+}
+
+/**
+ * @brief   Inserts a block in the free lists.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block header
+ *
+ * @notapi
+ */
+static void heap_insert_free(memory_heap_t *heapp, heap_header_t *hp) {
+  unsigned fl, sl;
+
+  heap_mapping(H_PAGES(hp), &fl, &sl);
+
+  H_INFO(hp) |= (size_t)H_FREE_FLAG;
+  H_FPREV(hp) = NULL;
+  H_FNEXT(hp) = heapp->blocks[fl][sl];
+  if (H_FNEXT(hp) != NULL) {
+    H_FPREV(H_FNEXT(hp)) = hp;
+  }
+  heapp->blocks[fl][sl] = hp;
+  heapp->slmap[fl] |= 1U << sl;
+  heapp->flmap |= 1U << fl;
+
+  heapp->nfree++;
+  heapp->fpages += H_PAGES(hp);
+}
+
+/**
+ * @brief   Removes a block from the free lists.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block header
+ *
+ * @notapi
+ */
+static void heap_remove_free(memory_heap_t *heapp, heap_header_t *hp) {
+  unsigned fl, sl;
+
+  heap_mapping(H_PAGES(hp), &fl, &sl);
+
+  if (H_FNEXT(hp) != NULL) {
+    H_FPREV(H_FNEXT(hp)) = H_FPREV(hp);
+  }
+  if (H_FPREV(hp) != NULL) {
+    H_FNEXT(H_FPREV(hp)) = H_FNEXT(hp);
+  }
+  else {
+    heapp->blocks[fl][sl] = H_FNEXT(hp);
+    if (H_FNEXT(hp) == NULL) {
+      heapp->slmap[fl] &= ~(1U << sl);
+      if (heapp->slmap[fl] == 0U) {
+        heapp->flmap &= ~(1U << fl);
+      }
+    }
+  }
+  H_INFO(hp) &= ~(size_t)H_FREE_FLAG;
+
+  heapp->nfree--;
+  heapp->fpages -= H_PAGES(hp);
+}
+
+/**
+ * @brief   Finds a free block of at least the specified size.
+ * @details The size is rounded up to the next size class so that any block
+ *          in the found list is large enough, if no such list exists then
+ *          the list of the exact size class is searched.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] pages     the required number of pages
+ * @return              A pointer to a suitable free block.
+ * @retval NULL         if a suitable block does not exist.
+ *
+ * @notapi
+ */
+static heap_header_t *heap_find_free(memory_heap_t *heapp, size_t pages) {
+  heap_header_t *hp;
+  unsigned fl, sl;
+  uint32_t map;
+  size_t rpages = pages;
+
+  /* Rounding up to the next size class.*/
+  if (pages >= (size_t)CH_HEAP_TLSF_SL_COUNT) {
+    rpages += ((size_t)1 << (heap_fls((uint32_t)pages) - 3U)) - 1U;
+  }
+
+  if (rpages <= H_MAX_PAGES) {
+    heap_mapping(rpages, &fl, &sl);
+
+    /* Searching in the same first level class then in the larger ones.*/
+    map = heapp->slmap[fl] & (~0U << sl);
+    if (map == 0U) {
+      map = (fl + 1U < CH_HEAP_TLSF_FL_COUNT) ?
+            heapp->flmap & (~0U << (fl + 1U)) : 0U;
+      if (map != 0U) {
+        fl = heap_ffs(map);
+        map = heapp->slmap[fl];
+      }
+    }
+
+    if (map != 0U) {
+      return heapp->blocks[fl][heap_ffs(map)];
+    }
+  }
+
+  /* Last chance, blocks in the exact size class could fit.*/
+  heap_mapping(pages, &fl, &sl);
+  hp = heapp->blocks[fl][sl];
+  while (hp != NULL) {
+    if (H_PAGES(hp) >= pages) {
+      return hp;
+    }
+    hp = H_FNEXT(hp);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Splits the excess pages of a block in a new free block.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block header
+ * @param[in] pages     number of pages to be kept in the block
+ *
+ * @notapi
+ */
+static void heap_split(memory_heap_t *heapp, heap_header_t *hp, size_t pages) {
+  heap_header_t *fp;
+
+  /* The excess must be able to contain a header and a page at least.*/
+  if (H_PAGES(hp) <= pages + H_HDR_PAGES) {
+    return;
+  }
+
+  fp = (heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) +
+                                 (pages * CH_HEAP_ALIGNMENT));
+  H_INFO(fp) = ((H_PAGES(hp) - pages - H_HDR_PAGES) << 2) |
+               (H_INFO(hp) & (size_t)H_LAST_FLAG);
+  H_PHYS(fp) = hp;
+  if (!H_IS_LAST(fp)) {
+    H_PHYS(H_PHYS_NEXT(fp)) = fp;
+  }
+
+  H_INFO(hp) &= ~(size_t)H_LAST_FLAG;
+  H_SET_PAGES(hp, pages);
+
+  heap_insert_free(heapp, fp);
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_HEAP_TLSF == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Initializes the default heap.
  *
@@ -251,6 +559,8 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
       /* Releasing heap mutex/semaphore.*/
       H_UNLOCK(heapp);
 
+      H_PROF_ALLOC(hp);
+
       /*lint -save -e9087 [11.3] Safe cast.*/
       return (void *)H_BLOCK(hp);
       /*lint -restore*/
@@ -274,6 +584,8 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
       H_HEAP(hp) = heapp;
       H_SIZE(hp) = size;
 
+      H_PROF_ALLOC(hp);
+
       /*lint -save -e9087 [11.3] Safe cast.*/
       return (void *)ahp;
       /*lint -restore*/
@@ -302,6 +614,8 @@ void chHeapFree(void *p) {
   heapp = H_HEAP(hp);
   qp = &heapp->header;
 
+  H_PROF_FREE(hp);
+
   /* Size is converted in number of elementary allocation units.*/
   H_PAGES(hp) = MEM_ALIGN_NEXT(H_SIZE(hp),
                                CH_HEAP_ALIGNMENT) / CH_HEAP_ALIGNMENT;
@@ -393,6 +707,337 @@ size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
 
   return n;
 }
+#else /* CH_CFG_USE_HEAP_TLSF == TRUE */
+/**
+ * @brief   Initializes the default heap.
+ *
+ * @notapi
+ */
+void __heap_init(void) {
+  unsigned i, j;
+
+  default_heap.provider = chCoreAllocAlignedWithOffset;
+  default_heap.flmap = 0U;
+  for (i = 0U; i < CH_HEAP_TLSF_FL_COUNT; i++) {
+    default_heap.slmap[i] = 0U;
+    for (j = 0U; j < CH_HEAP_TLSF_SL_COUNT; j++) {
+      default_heap.blocks[i][j] = NULL;
+    }
+  }
+  default_heap.nfree = 0U;
+  default_heap.fpages = 0U;
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+  chMtxObjectInit(&default_heap.mtx);
+#else
+  chSemObjectInit(&default_heap.sem, (cnt_t)1);
+#endif
+}
+
+/**
+ * @brief   Initializes a memory heap from a static memory area.
+ * @note    The heap buffer base and size are adjusted if the passed buffer
+ *          is not aligned to @p CH_HEAP_ALIGNMENT. This mean that the
+ *          effective heap size can be less than @p size.
+ * @note    Areas larger than the maximum block size are divided in
+ *          multiple blocks.
+ *
+ * @param[out] heapp    pointer to the memory heap descriptor to be initialized
+ * @param[in] buf       heap buffer base
+ * @param[in] size      heap size
+ *
+ * @init
+ */
+void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
+  heap_header_t *hp = (heap_header_t *)MEM_ALIGN_NEXT(buf, CH_HEAP_ALIGNMENT);
+  heap_header_t *pp = NULL;
+  size_t pages;
+  unsigned i, j;
+
+  chDbgCheck((heapp != NULL) && (size > 0U));
+
+  /* Adjusting the size in case the initial block was not correctly
+     aligned.*/
+  /*lint -save -e9033 [10.8] Required cast operations.*/
+  size -= (size_t)((uint8_t *)hp - (uint8_t *)buf);
+  /*lint restore*/
+
+  /* Initializing the heap descriptor.*/
+  heapp->provider = NULL;
+  heapp->flmap = 0U;
+  for (i = 0U; i < CH_HEAP_TLSF_FL_COUNT; i++) {
+    heapp->slmap[i] = 0U;
+    for (j = 0U; j < CH_HEAP_TLSF_SL_COUNT; j++) {
+      heapp->blocks[i][j] = NULL;
+    }
+  }
+  heapp->nfree = 0U;
+  heapp->fpages = 0U;
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+  chMtxObjectInit(&heapp->mtx);
+#else
+  chSemObjectInit(&heapp->sem, (cnt_t)1);
+#endif
+
+  /* Dividing the area in free blocks.*/
+  pages = size / CH_HEAP_ALIGNMENT;
+  while (pages > H_HDR_PAGES) {
+    size_t bpages = pages - H_HDR_PAGES;
+
+    if (bpages > H_MAX_PAGES) {
+      bpages = H_MAX_PAGES;
+    }
+    pages -= bpages + H_HDR_PAGES;
+
+    H_PHYS(hp) = pp;
+    H_INFO(hp) = bpages << 2;
+    if (pages <= H_HDR_PAGES) {
+      H_INFO(hp) |= (size_t)H_LAST_FLAG;
+    }
+    heap_insert_free(heapp, hp);
+
+    pp = hp;
+    hp = H_PHYS_NEXT(hp);
+  }
+}
+
+/**
+ * @brief   Allocates a block of memory from the heap by using the TLSF
+ *          algorithm.
+ * @details The allocated block is guaranteed to be properly aligned to the
+ *          specified alignment.
+ *
+ * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
+ *                      access the default heap.
+ * @param[in] size      the size of the block to be allocated. Note that the
+ *                      allocated block may be a bit bigger than the requested
+ *                      size for alignment and fragmentation reasons.
+ * @param[in] align     desired memory alignment
+ * @return              A pointer to the aligned allocated block.
+ * @retval NULL         if the block cannot be allocated.
+ *
+ * @api
+ */
+void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
+  heap_header_t *hp, *ahp;
+  size_t pages, spages;
+
+  chDbgCheck((size > 0U) && MEM_IS_VALID_ALIGNMENT(align));
+
+  /* If an heap is not specified then the default system header is used.*/
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  /* Minimum alignment is constrained by the heap header structure size.*/
+  if (align < CH_HEAP_ALIGNMENT) {
+    align = CH_HEAP_ALIGNMENT;
+  }
+
+  /* Size is converted in number of elementary allocation units.*/
+  pages = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT) / CH_HEAP_ALIGNMENT;
+
+  /* Searched size, in case of stricter alignment there must be space for
+     splitting a non-empty free block in front of the aligned area.*/
+  spages = pages;
+  if (align > CH_HEAP_ALIGNMENT) {
+    spages += (H_HDR_PAGES * 2U) + ((size_t)align / CH_HEAP_ALIGNMENT) - 1U;
+  }
+
+  if (spages <= H_MAX_PAGES) {
+
+    /* Taking heap mutex/semaphore.*/
+    H_LOCK(heapp);
+
+    hp = heap_find_free(heapp, spages);
+    if ((hp == NULL) && (spages > pages)) {
+      /* The exact size could still be enough if the block happens to be
+         already aligned.*/
+      hp = heap_find_free(heapp, pages);
+      if ((hp != NULL) && !MEM_IS_ALIGNED(H_BLOCK(hp), align)) {
+        hp = NULL;
+      }
+    }
+
+    if (hp != NULL) {
+      heap_remove_free(heapp, hp);
+
+      if (!MEM_IS_ALIGNED(H_BLOCK(hp), align)) {
+        /* The block is not properly aligned, the leading part is left
+           as a free block.*/
+        ahp = (heap_header_t *)MEM_ALIGN_NEXT(H_BLOCK(hp) + 2U, align) - 1U;
+        H_INFO(ahp) = (NPAGES(H_PHYS_NEXT(hp), H_BLOCK(ahp)) << 2) |
+                      (H_INFO(hp) & (size_t)H_LAST_FLAG);
+        H_PHYS(ahp) = hp;
+        if (!H_IS_LAST(ahp)) {
+          H_PHYS(H_PHYS_NEXT(ahp)) = ahp;
+        }
+        H_INFO(hp) = NPAGES(ahp, H_BLOCK(hp)) << 2;
+        heap_insert_free(heapp, hp);
+        hp = ahp;
+      }
+
+      /* The block is bigger than required, must split the excess.*/
+      heap_split(heapp, hp, pages);
+
+      /* Setting in the block owner heap and size.*/
+      H_SIZE(hp) = size;
+      H_HEAP(hp) = heapp;
+
+      /* Releasing heap mutex/semaphore.*/
+      H_UNLOCK(heapp);
+
+      H_PROF_ALLOC(hp);
+
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      return (void *)H_BLOCK(hp);
+      /*lint -restore*/
+    }
+
+    /* Releasing heap mutex/semaphore.*/
+    H_UNLOCK(heapp);
+  }
+
+  /* More memory is required, tries to get it from the associated provider
+     else fails.*/
+  if (heapp->provider != NULL) {
+    ahp = heapp->provider(pages * CH_HEAP_ALIGNMENT,
+                          align,
+                          sizeof (heap_header_t));
+    if (ahp != NULL) {
+      hp = ahp - 1U;
+      H_PHYS(hp) = NULL;
+      H_INFO(hp) = (pages << 2) | (size_t)H_LAST_FLAG;
+      H_HEAP(hp) = heapp;
+      H_SIZE(hp) = size;
+
+      H_PROF_ALLOC(hp);
+
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      return (void *)ahp;
+      /*lint -restore*/
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Frees a previously allocated memory block.
+ * @note    Adjacent free blocks are merged unless the resulting block
+ *          would exceed the maximum block size.
+ *
+ * @param[in] p         pointer to the memory block to be freed
+ *
+ * @api
+ */
+void chHeapFree(void *p) {
+  heap_header_t *hp, *np;
+  memory_heap_t *heapp;
+
+  chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  hp = (heap_header_t *)p - 1U;
+  /*lint -restore*/
+  heapp = H_HEAP(hp);
+
+  H_PROF_FREE(hp);
+
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  chDbgAssert(!H_IS_FREE(hp), "already free");
+
+  /* Merge with the next physical block.*/
+  if (!H_IS_LAST(hp)) {
+    np = H_PHYS_NEXT(hp);
+    if (H_IS_FREE(np) &&
+        (H_PAGES(hp) + H_PAGES(np) + H_HDR_PAGES <= H_MAX_PAGES)) {
+      heap_remove_free(heapp, np);
+      H_INFO(hp) = ((H_PAGES(hp) + H_PAGES(np) + H_HDR_PAGES) << 2) |
+                   (H_INFO(np) & (size_t)H_LAST_FLAG);
+      if (!H_IS_LAST(hp)) {
+        H_PHYS(H_PHYS_NEXT(hp)) = hp;
+      }
+    }
+  }
+
+  /* Merge with the previous physical block.*/
+  np = H_PHYS(hp);
+  if ((np != NULL) && H_IS_FREE(np) &&
+      (H_PAGES(np) + H_PAGES(hp) + H_HDR_PAGES <= H_MAX_PAGES)) {
+    heap_remove_free(heapp, np);
+    H_INFO(np) = ((H_PAGES(np) + H_PAGES(hp) + H_HDR_PAGES) << 2) |
+                 (H_INFO(hp) & (size_t)H_LAST_FLAG);
+    if (!H_IS_LAST(np)) {
+      H_PHYS(H_PHYS_NEXT(np)) = np;
+    }
+    hp = np;
+  }
+
+  heap_insert_free(heapp, hp);
+
+  /* Releasing heap mutex/semaphore.*/
+  H_UNLOCK(heapp);
+
+  return;
+}
+
+/**
+ * @brief   Reports the heap status.
+ * @note    This function is meant to be used in the test suite, it should
+ *          not be really useful for the application code.
+ * @note    In TLSF mode the largest free block is searched in the highest
+ *          non-empty size class only.
+ *
+ * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
+ *                      access the default heap.
+ * @param[in] totalp    pointer to a variable that will receive the total
+ *                      fragmented free space or @p NULL
+ * @param[in] largestp  pointer to a variable that will receive the largest
+ *                      free free block found space or @p NULL
+ * @return              The number of fragments in the heap.
+ *
+ * @api
+ */
+size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
+  size_t n;
+
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  H_LOCK(heapp);
+  n = heapp->nfree;
+
+  /* Writing out fragmented free memory.*/
+  if (totalp != NULL) {
+    *totalp = heapp->fpages * CH_HEAP_ALIGNMENT;
+  }
+
+  /* Writing out unfragmented free memory.*/
+  if (largestp != NULL) {
+    size_t lpages = 0U;
+
+    if (heapp->flmap != 0U) {
+      heap_header_t *hp;
+      unsigned fl = heap_fls(heapp->flmap);
+
+      hp = heapp->blocks[fl][heap_fls(heapp->slmap[fl])];
+      while (hp != NULL) {
+        if (H_PAGES(hp) > lpages) {
+          lpages = H_PAGES(hp);
+        }
+        hp = H_FNEXT(hp);
+      }
+    }
+    *largestp = lpages * CH_HEAP_ALIGNMENT;
+  }
+  H_UNLOCK(heapp);
+
+  return n;
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
 
 #endif /* CH_CFG_USE_HEAP == TRUE */
 
@@ -29,7 +29,10 @@
  *          problems.<br>
  *          Memory Pools do not enforce any alignment constraint on the
  *          contained object however the objects must be properly aligned
- *          to contain a pointer to void.
+ *          to contain a pointer to void.<br>
+ *          Threads making heavy use of a pool can use a magazine, a small
+ *          private cache of objects refilled and drained in batches, in
+ *          order to reduce the time spent in critical zones.
  * @pre     In order to use the memory pools APIs the @p CH_CFG_USE_MEMPOOLS option
  *          must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -165,6 +168,13 @@ void *chPoolAlloc(memory_pool_t *mp) {
   objp = chPoolAllocI(mp);
   chSysUnlock();
 
+#if CH_DBG_MEM_PROFILING == TRUE
+  if (objp != NULL) {
+    (void) __memprof_alloc(__memprof_get_caller(), CH_MEMPROF_POOL,
+                           mp->object_size);
+  }
+#endif
+
   return objp;
 }
 
@@ -211,6 +221,161 @@ void chPoolFree(memory_pool_t *mp, void *objp) {
   chSysUnlock();
 }
 
+/**
+ * @brief   Initializes a memory pool magazine.
+ * @details The magazine is initially empty, objects are fetched from the
+ *          associated memory pool in batches when needed.
+ * @note    A magazine must only be used by a single thread, typically the
+ *          magazine is a local or thread-specific object.
+ *
+ * @param[out] pmp      pointer to a @p pool_magazine_t structure
+ * @param[in] mp        pointer to the associated @p memory_pool_t structure
+ * @param[in] size      maximum number of objects cached in the magazine, it
+ *                      must be greater than zero
+ *
+ * @init
+ */
+void chPoolMagazineObjectInit(pool_magazine_t *pmp,
+                              memory_pool_t *mp,
+                              size_t size) {
+
+  chDbgCheck((pmp != NULL) && (mp != NULL) && (size > (size_t)0));
+
+  pmp->pool = mp;
+  pmp->next = NULL;
+  pmp->cnt  = (size_t)0;
+  pmp->size = size;
+}
+
+/**
+ * @brief   Allocates an object using a memory pool magazine.
+ * @details If the magazine is empty then it is refilled with up to half of
+ *          its capacity taking the memory pool lock once, if the memory
+ *          pool is empty too then the pool provider is used, if any.
+ *
+ * @param[in] pmp       pointer to a @p pool_magazine_t structure
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if both the magazine and the pool are empty.
+ *
+ * @api
+ */
+void *chPoolMagazineAlloc(pool_magazine_t *pmp) {
+  struct pool_header *php;
+
+  chDbgCheck(pmp != NULL);
+
+  if (pmp->next == NULL) {
+    memory_pool_t *mp = pmp->pool;
+    size_t n = (size_t)0;
+
+    chSysLock();
+
+    /* Moving a batch of objects from the pool to the magazine.*/
+    while ((n < ((pmp->size + (size_t)1) / (size_t)2)) && (mp->next != NULL)) {
+      php = mp->next;
+      mp->next = php->next;
+      php->next = pmp->next;
+      pmp->next = php;
+      n++;
+    }
+
+    /* Pool empty, the provider is tried directly.*/
+    if (n == (size_t)0) {
+      void *objp = chPoolAllocI(mp);
+
+      chSysUnlock();
+
+      return objp;
+    }
+
+    chSysUnlock();
+
+    pmp->cnt = n;
+  }
+
+  php = pmp->next;
+  pmp->next = php->next;
+  pmp->cnt--;
+
+  return (void *)php;
+}
+
+/**
+ * @brief   Releases an object using a memory pool magazine.
+ * @details If the magazine is full then half of its content is returned to
+ *          the memory pool taking the memory pool lock once.
+ * @pre     The freed object must be of the right size for the associated
+ *          memory pool.
+ * @pre     The freed object must be properly aligned.
+ *
+ * @param[in] pmp       pointer to a @p pool_magazine_t structure
+ * @param[in] objp      the pointer to the object to be released
+ *
+ * @api
+ */
+void chPoolMagazineFree(pool_magazine_t *pmp, void *objp) {
+  struct pool_header *php = objp;
+
+  chDbgCheck((pmp != NULL) &&
+             (objp != NULL) &&
+             MEM_IS_ALIGNED(objp, pmp->pool->align));
+
+  if (pmp->cnt >= pmp->size) {
+    memory_pool_t *mp = pmp->pool;
+    struct pool_header *firstp, *lastp;
+    size_t n = (pmp->size + (size_t)1) / (size_t)2;
+
+    /* Detaching a batch of objects from the magazine.*/
+    pmp->cnt -= n;
+    firstp = pmp->next;
+    lastp = firstp;
+    while (--n > (size_t)0) {
+      lastp = lastp->next;
+    }
+    pmp->next = lastp->next;
+
+    /* Returning the whole batch to the pool.*/
+    chSysLock();
+    lastp->next = mp->next;
+    mp->next = firstp;
+    chSysUnlock();
+  }
+
+  php->next = pmp->next;
+  pmp->next = php;
+  pmp->cnt++;
+}
+
+/**
+ * @brief   Returns all the objects cached in a magazine to its pool.
+ *
+ * @param[in] pmp       pointer to a @p pool_magazine_t structure
+ *
+ * @api
+ */
+void chPoolMagazineFlush(pool_magazine_t *pmp) {
+  struct pool_header *lastp;
+
+  chDbgCheck(pmp != NULL);
+
+  if (pmp->next == NULL) {
+    return;
+  }
+
+  lastp = pmp->next;
+  while (lastp->next != NULL) {
+    lastp = lastp->next;
+  }
+
+  chSysLock();
+  lastp->next = pmp->pool->next;
+  pmp->pool->next = pmp->next;
+  chSysUnlock();
+
+  pmp->next = NULL;
+  pmp->cnt  = (size_t)0;
+}
+
 #if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Initializes an empty guarded memory pool.
@@ -0,0 +1,221 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chmemprof.c
+ * @brief   Allocations profiler code.
+ * @details Allocations profiler.
+ *          <h2>Operation mode</h2>
+ *          The allocators record each allocation in a fixed size hash table
+ *          indexed by the return address of the allocation call, the
+ *          table keeps the number of allocations and releases, the live
+ *          and peak allocated bytes and the last allocating thread of each
+ *          call site.<br>
+ *          Heap blocks are linked to their call site through the block
+ *          header so releases are accounted to the call site that
+ *          performed the allocation.<br>
+ *          Call sites are never removed from the table, allocations from
+ *          new call sites are dropped when the table is full.
+ * @pre     In order to use the allocations profiler the
+ *          @p CH_DBG_MEM_PROFILING option must be enabled in
+ *          @p chconf.h.
+ * @note    Compatible with RT only.
+ *
+ * @addtogroup oslib_memprof
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Allocations profiler.
+ */
+memprof_t ch_memprof;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static unsigned memprof_hash(const void *pc) {
+  uint32_t h = (uint32_t)(size_t)pc;
+
+  /* Return addresses are at least 16 bits aligned, the low bit carries
+     no information.*/
+  h = (h >> 1) * 0x9E3779B1U;
+
+  return (unsigned)(h >> 16) & ((unsigned)CH_DBG_MEM_PROFILING_SITES - 1U);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Records an allocation.
+ * @note    Not meant to be called directly, invoked by the allocators.
+ *
+ * @param[in] pc        return address of the allocation call
+ * @param[in] allocator allocator identifier
+ * @param[in] size      size of the allocated block
+ * @return              The pointer to the call site.
+ * @retval NULL         if the call sites table is full.
+ *
+ * @notapi
+ */
+memprof_site_t *__memprof_alloc(const void *pc, unsigned allocator,
+                                size_t size) {
+  unsigned i, n;
+  memprof_site_t *sp;
+
+  chSysLock();
+
+  /* Open addressing with linear probing, the first free slot in the probe
+     sequence starts a new call site.*/
+  i = memprof_hash(pc);
+  sp = NULL;
+  for (n = 0U; n < (unsigned)CH_DBG_MEM_PROFILING_SITES; n++) {
+    memprof_site_t *tsp = &ch_memprof.sites[i];
+
+    if (tsp->pc == pc) {
+      sp = tsp;
+      break;
+    }
+    if (tsp->pc == NULL) {
+      tsp->pc        = pc;
+      tsp->allocator = allocator;
+      sp = tsp;
+      break;
+    }
+    i = (i + 1U) & ((unsigned)CH_DBG_MEM_PROFILING_SITES - 1U);
+  }
+
+  if (sp != NULL) {
+    sp->tp = chThdGetSelfX();
+    sp->allocs++;
+    if (allocator != CH_MEMPROF_POOL) {
+      sp->live += size;
+      if (sp->live > sp->peak) {
+        sp->peak = sp->live;
+      }
+    }
+  }
+  else {
+    ch_memprof.dropped++;
+  }
+
+  chSysUnlock();
+
+  return sp;
+}
+
+/**
+ * @brief   Records a release.
+ * @note    Not meant to be called directly, invoked by the allocators.
+ *
+ * @param[in] sp        pointer to the call site of the allocation or
+ *                      @p NULL
+ * @param[in] size      size of the released block
+ *
+ * @notapi
+ */
+void __memprof_free(memprof_site_t *sp, size_t size) {
+
+  if (sp != NULL) {
+    chSysLock();
+
+    chDbgAssert(sp->live >= size, "live size underflow");
+
+    sp->frees++;
+    sp->live -= size;
+
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Reads a call site of the allocations profiler.
+ * @details The call site is copied atomically.
+ *
+ * @param[in] i         index of the call site, from zero to
+ *                      @p CH_DBG_MEM_PROFILING_SITES - 1
+ * @param[out] sp       pointer to the call site copy
+ * @return              The call site state.
+ * @retval false        if the table slot is unused.
+ * @retval true         if the call site has been copied.
+ *
+ * @api
+ */
+bool chMemProfReadSite(unsigned i, memprof_site_t *sp) {
+  bool used;
+
+  chDbgCheck((i < (unsigned)CH_DBG_MEM_PROFILING_SITES) && (sp != NULL));
+
+  chSysLock();
+  *sp = ch_memprof.sites[i];
+  used = sp->pc != NULL;
+  chSysUnlock();
+
+  return used;
+}
+
+/**
+ * @brief   Resets the allocations profiler counters.
+ * @details The allocations and releases counters are cleared and the peak
+ *          sizes are lowered to the live sizes, the call sites remain in
+ *          the table because live heap blocks refer to them.
+ *
+ * @api
+ */
+void chMemProfReset(void) {
+  unsigned i;
+
+  chSysLock();
+  for (i = 0U; i < (unsigned)CH_DBG_MEM_PROFILING_SITES; i++) {
+    memprof_site_t *sp = &ch_memprof.sites[i];
+
+    sp->allocs = (ucnt_t)0;
+    sp->frees  = (ucnt_t)0;
+    sp->peak   = sp->live;
+  }
+  ch_memprof.dropped = (ucnt_t)0;
+  ch_memprof.since   = chVTGetTimeStampI();
+  chSysUnlock();
+}
+
+#endif /* CH_DBG_MEM_PROFILING == TRUE */
+
+/** @} */
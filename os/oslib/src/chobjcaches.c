@@ -42,7 +42,19 @@
  *            media.
  *          - <b>Release Object</b>: Releases an object to the cache handling
  *            the media update, if required.
+ *          - <b>Clean Objects</b>: Writes back the lazily written objects
+ *            close to the LRU tail, this is meant to be called periodically
+ *            by a low priority thread so that evictions find clean buffers.
+ *          - <b>Prefetch</b>: Starts asynchronous reads of a sequence of
+ *            objects not yet in cache.
  *          .
+ *          <h2>Concurrency</h2>
+ *          The hash table and the LRU list are only accessed within short
+ *          critical zones, there is no cache-wide lock held during media
+ *          operations. Threads accessing different objects never wait for
+ *          each other, a thread only waits for the object it requested if
+ *          owned by another thread or, on a cache miss, for an object to
+ *          become available in the LRU list.
  * @pre     In order to use the pipes APIs the @p CH_CFG_USE_OBJ_CACHES
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -215,6 +227,42 @@ static oc_object_t *lru_get_last_s(objects_cache_t *ocp) {
   }
 }
 
+/**
+ * @brief   Takes the LRU tail object buffer if immediately reusable.
+ * @details The buffer is returned only if the LRU is not empty and the
+ *          tail object does not require a lazy write.
+ *
+ * @param[in] ocp       pointer to the @p objects_cache_t structure
+ * @return              The pointer to the retrieved object.
+ * @retval NULL         if there is no clean object on the LRU tail.
+ *
+ * @notapi
+ */
+static oc_object_t *lru_get_last_clean_s(objects_cache_t *ocp) {
+  oc_object_t *objp;
+
+  if (chSemGetCounterI(&ocp->lru_sem) <= (cnt_t)0) {
+    return NULL;
+  }
+
+  objp = ocp->lru.lru_prev;
+  if ((objp->obj_flags & OC_FLAG_LAZYWRITE) != 0U) {
+    return NULL;
+  }
+
+  LRU_REMOVE(objp);
+  chSemFastWaitI(&ocp->lru_sem);
+  chSemFastWaitI(&objp->obj_sem);
+
+  /* Removing from hash table if required.*/
+  if ((objp->obj_flags & OC_FLAG_INHASH) != 0U) {
+    HASH_REMOVE(objp);
+  }
+  objp->obj_flags = 0U;
+
+  return objp;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -253,7 +301,6 @@ void chCacheObjectInit(objects_cache_t *ocp,
              (objsz >= sizeof (oc_object_t)) &&
              ((objsz & (PORT_NATURAL_ALIGN - 1U)) == 0U));
 
-  chSemObjectInit(&ocp->cache_sem, (cnt_t)1);
   chSemObjectInit(&ocp->lru_sem, (cnt_t)objn);
   ocp->hashn            = hashn;
   ocp->hashp            = hashp;
@@ -324,9 +371,11 @@ oc_object_t *chCacheGetObject(objects_cache_t *ocp,
       chDbgAssert((objp->obj_flags & OC_FLAG_INLRU) == OC_FLAG_INLRU,
                   "not in LRU");
 
-      /* Removing the object from LRU, now it is "owned".*/
+      /* Removing the object from LRU, now it is "owned", the LRU counter
+         semaphore is decreased accordingly.*/
       LRU_REMOVE(objp);
       objp->obj_flags &= ~OC_FLAG_INLRU;
+      chSemFastWaitI(&ocp->lru_sem);
 
       /* Getting the object semaphore, we know there is no wait so
          using the "fast" variant.*/
@@ -486,6 +535,122 @@ bool chCacheWriteObject(objects_cache_t *ocp,
   return ocp->writef(ocp, objp, async);
 }
 
+/**
+ * @brief   Writes back lazily written objects close to the LRU tail.
+ * @details The @p n least recently used objects are examined, the objects
+ *          marked @p OC_FLAG_LAZYWRITE are written asynchronously and,
+ *          once released by the write function, go back on the LRU tail
+ *          as clean objects. Evictions then do not need to write back
+ *          objects in the context of the thread missing the cache.
+ * @note    This function is meant to be called periodically by a low
+ *          priority flusher thread.
+ *
+ * @param[in] ocp       pointer to the @p objects_cache_t structure
+ * @param[in] n         number of LRU positions to be examined
+ * @return              The number of objects whose write has been started.
+ *
+ * @api
+ */
+ucnt_t chCacheCleanObjects(objects_cache_t *ocp, ucnt_t n) {
+  ucnt_t cleaned = (ucnt_t)0;
+  oc_object_t *objp;
+
+  chDbgCheck(ocp != NULL);
+
+  chSysLock();
+  objp = ocp->lru.lru_prev;
+  while ((n > (ucnt_t)0) && (objp != (oc_object_t *)&ocp->lru)) {
+    n--;
+
+    if ((objp->obj_flags & OC_FLAG_LAZYWRITE) == 0U) {
+      /* Clean object, skipping to the next more recently used.*/
+      objp = objp->lru_prev;
+      continue;
+    }
+
+    /* Taking ownership of the dirty object, the LRU counter semaphore is
+       decreased accordingly.*/
+    LRU_REMOVE(objp);
+    chSemFastWaitI(&ocp->lru_sem);
+    chSemFastWaitI(&objp->obj_sem);
+    chSysUnlock();
+
+    /* Invoking the writer asynchronously, it will release the buffer once
+       it is written. The object goes back to the LRU tail.*/
+    objp->obj_flags = OC_FLAG_INHASH | OC_FLAG_FORGET;
+    (void) ocp->writef(ocp, objp, true);
+    cleaned++;
+
+    /* The LRU could have changed while out of the critical section,
+       restarting from the tail.*/
+    chSysLock();
+    objp = ocp->lru.lru_prev;
+  }
+  chSysUnlock();
+
+  return cleaned;
+}
+
+/**
+ * @brief   Starts asynchronous reads of a sequence of objects.
+ * @details Objects with keys from @p key to <tt>key + n - 1</tt> that are
+ *          not in cache are allocated and read asynchronously, the read
+ *          function releases them once loaded.
+ * @note    Prefetching never waits, it stops when there is no clean object
+ *          on the LRU tail to be reused.
+ *
+ * @param[in] ocp       pointer to the @p objects_cache_t structure
+ * @param[in] group     object group identifier
+ * @param[in] key       identifier of the first object within the group
+ * @param[in] n         number of objects to be prefetched
+ * @return              The number of objects whose read has been started.
+ *
+ * @api
+ */
+ucnt_t chCachePrefetch(objects_cache_t *ocp,
+                       uint32_t group,
+                       uint32_t key,
+                       ucnt_t n) {
+  ucnt_t started = (ucnt_t)0;
+
+  chDbgCheck(ocp != NULL);
+
+  while (n > (ucnt_t)0) {
+    oc_object_t *objp;
+
+    chSysLock();
+
+    /* Objects already in cache are skipped.*/
+    if (hash_get_s(ocp, group, key) == NULL) {
+      objp = lru_get_last_clean_s(ocp);
+      if (objp == NULL) {
+        chSysUnlock();
+        break;
+      }
+
+      /* Naming this object and publishing it in the hash table, other
+         threads requesting it wait for the read completion.*/
+      objp->obj_group = group;
+      objp->obj_key   = key;
+      objp->obj_flags = OC_FLAG_INHASH | OC_FLAG_NOTSYNC;
+      HASH_INSERT(ocp, objp, group, key);
+      chSysUnlock();
+
+      /* The read function releases the object when done.*/
+      (void) ocp->readf(ocp, objp, true);
+      started++;
+    }
+    else {
+      chSysUnlock();
+    }
+
+    key++;
+    n--;
+  }
+
+  return started;
+}
+
 #endif /* CH_CFG_USE_OBJ_CACHES == TRUE */
 
 /** @} */
@@ -0,0 +1,309 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chpipelines.c
+ * @brief   Dataflow pipelines code.
+ * @details Dataflow pipelines.
+ *          <h2>Operation mode</h2>
+ *          A pipeline is a chain of stage functions processing buffers
+ *          in place. The buffers belong to an objects FIFO, the producer
+ *          takes a free buffer from the FIFO, fills it and submits it to
+ *          the first stage, the buffers leaving the last stage are sent
+ *          to the FIFO mailbox for a consumer or directly returned to
+ *          the FIFO pool.<br>
+ *          Stages have no threads, a stage with queued buffers posts a
+ *          job on a jobs queue and any of the workers dispatching that
+ *          queue executes it. A stage processes one buffer at time so the
+ *          buffers order is preserved, different stages run in parallel
+ *          on different workers.<br>
+ *          The number of buffers bounds the data in flight, the producer
+ *          is suspended while all buffers are in use. A stage can also
+ *          limit the buffers queued in front of it, the previous stage
+ *          is not scheduled while the limit is reached.
+ * @pre     In order to use the pipelines APIs the @p CH_CFG_USE_PIPELINES
+ *          option must be enabled in @p chconf.h.
+ * @note    The jobs queue must have at least two jobs for each stage of
+ *          each pipeline using it, a stage has never more than one job
+ *          posted but it can post the next one while the descriptor of
+ *          the running one has not yet been returned.
+ *
+ * @addtogroup oslib_pipelines
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_PIPELINES == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void pl_stage_job(void *arg);
+
+/**
+ * @brief   Posts a job for a stage if it can run.
+ * @details A stage runs if it is not already running, it has queued
+ *          buffers and the next stage queue is below its depth limit.
+ *
+ * @param[in] plp       pointer to the @p pipeline_t object
+ * @param[in] stp       pointer to the @p pipeline_stage_t object
+ *
+ * @notapi
+ */
+static void pl_schedule(pipeline_t *plp, pipeline_stage_t *stp) {
+  job_descriptor_t *jp;
+
+  if (stp->running || (stp->cnt == (size_t)0)) {
+    return;
+  }
+
+  /* Backpressure from the next stage.*/
+  if (stp != &plp->stages[plp->nstages - (size_t)1]) {
+    pipeline_stage_t *nstp = stp + 1;
+
+    if ((nstp->config->depth > (size_t)0) &&
+        (nstp->cnt >= nstp->config->depth)) {
+      stp->stats.stalls++;
+      return;
+    }
+  }
+
+  jp = chJobGetI(plp->jqp);
+  chDbgAssert(jp != NULL, "no free jobs");
+
+  jp->jobfunc = pl_stage_job;
+  jp->jobarg  = (void *)stp;
+  stp->running = true;
+  chJobPostI(plp->jqp, jp);
+}
+
+/**
+ * @brief   Queues a buffer in a stage.
+ *
+ * @param[in] plp       pointer to the @p pipeline_t object
+ * @param[in] stp       pointer to the @p pipeline_stage_t object
+ * @param[in] objp      pointer to the buffer
+ *
+ * @notapi
+ */
+static void pl_enqueue(pipeline_t *plp, pipeline_stage_t *stp, void *objp) {
+  pipeline_slot_t *slp;
+
+  chDbgAssert(stp->cnt < plp->nobjs, "queue overflow");
+
+  slp = &stp->slots[(stp->rdidx + stp->cnt) % plp->nobjs];
+  slp->objp  = objp;
+  slp->stamp = chSysGetRealtimeCounterX();
+  stp->cnt++;
+
+  pl_schedule(plp, stp);
+}
+
+/**
+ * @brief   Stage job, processes the oldest buffer queued in a stage.
+ *
+ * @param[in] arg       pointer to the @p pipeline_stage_t object
+ *
+ * @notapi
+ */
+static void pl_stage_job(void *arg) {
+  pipeline_stage_t *stp = (pipeline_stage_t *)arg;
+  pipeline_t *plp = stp->plp;
+  pipeline_slot_t slot;
+  rtcnt_t latency;
+  msg_t msg;
+
+  /* Taking the oldest buffer, the previous stage could be waiting for
+     a free place in this stage queue.*/
+  chSysLock();
+  slot = stp->slots[stp->rdidx];
+  stp->rdidx = (stp->rdidx + (size_t)1) % plp->nobjs;
+  stp->cnt--;
+  if (stp != &plp->stages[0]) {
+    pl_schedule(plp, stp - 1);
+  }
+  chSysUnlock();
+
+  /* Processing, outside the critical zone.*/
+  msg = stp->config->func(stp->config->arg, slot.objp);
+
+  chSysLock();
+
+  /* Counters.*/
+  latency = chSysGetRealtimeCounterX() - slot.stamp;
+  stp->stats.processed++;
+  stp->stats.cumulative += (uint64_t)latency;
+  if (latency > stp->stats.worst) {
+    stp->stats.worst = latency;
+  }
+
+  /* Forwarding or dropping the buffer.*/
+  if (msg != MSG_OK) {
+    stp->stats.dropped++;
+    chFifoReturnObjectI(plp->ofp, slot.objp);
+  }
+  else if (stp != &plp->stages[plp->nstages - (size_t)1]) {
+    pl_enqueue(plp, stp + 1, slot.objp);
+  }
+  else if (plp->sink) {
+    chFifoSendObjectI(plp->ofp, slot.objp);
+  }
+  else {
+    chFifoReturnObjectI(plp->ofp, slot.objp);
+  }
+
+  /* Next buffer, if any.*/
+  stp->running = false;
+  pl_schedule(plp, stp);
+
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a pipeline object.
+ * @note    The objects FIFO must be already initialized, the number of
+ *          buffers is the size of its mailbox.
+ *
+ * @param[out] plp      pointer to a @p pipeline_t structure
+ * @param[in] ofp       pointer to the objects FIFO supplying the buffers
+ * @param[in] jqp       pointer to the jobs queue executing the stages
+ * @param[out] stages   pointer to an array of @p nstages stage objects
+ * @param[in] configs   pointer to an array of @p nstages stage
+ *                      configurations
+ * @param[in] nstages   number of stages
+ * @param[out] slots    pointer to the queue slots, it must be able to hold
+ *                      @p CH_PIPELINE_SLOTS(nstages, nobjs) elements
+ * @param[in] sink      if @p true then the buffers leaving the last stage
+ *                      are sent to the FIFO mailbox else they are returned
+ *                      to the FIFO pool
+ *
+ * @init
+ */
+void chPipelineObjectInit(pipeline_t *plp, objects_fifo_t *ofp,
+                          jobs_queue_t *jqp, pipeline_stage_t *stages,
+                          const pipeline_stage_config_t *configs,
+                          size_t nstages, pipeline_slot_t *slots,
+                          bool sink) {
+  size_t i;
+
+  chDbgCheck((plp != NULL) && (ofp != NULL) && (jqp != NULL) &&
+             (stages != NULL) && (configs != NULL) && (nstages > (size_t)0) &&
+             (slots != NULL));
+
+  plp->ofp     = ofp;
+  plp->jqp     = jqp;
+  plp->stages  = stages;
+  plp->nstages = nstages;
+  plp->nobjs   = chMBGetSizeI(&ofp->mbx);
+  plp->sink    = sink;
+
+  for (i = (size_t)0; i < nstages; i++) {
+    chDbgCheck(configs[i].func != NULL);
+
+    stages[i].config  = &configs[i];
+    stages[i].plp     = plp;
+    stages[i].slots   = &slots[i * plp->nobjs];
+    stages[i].rdidx   = (size_t)0;
+    stages[i].cnt     = (size_t)0;
+    stages[i].running = false;
+  }
+  chPipelineResetStats(plp);
+}
+
+/**
+ * @brief   Submits a buffer to the first stage.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[in] objp      pointer to a buffer taken from the pipeline
+ *
+ * @iclass
+ */
+void chPipelineSubmitI(pipeline_t *plp, void *objp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((plp != NULL) && (objp != NULL));
+
+  pl_enqueue(plp, &plp->stages[0], objp);
+}
+
+/**
+ * @brief   Submits a buffer to the first stage.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ * @param[in] objp      pointer to a buffer taken from the pipeline
+ *
+ * @api
+ */
+void chPipelineSubmit(pipeline_t *plp, void *objp) {
+
+  chSysLock();
+  chPipelineSubmitI(plp, objp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Clears the counters of all stages.
+ *
+ * @param[in] plp       pointer to a @p pipeline_t structure
+ *
+ * @api
+ */
+void chPipelineResetStats(pipeline_t *plp) {
+  size_t i;
+
+  chDbgCheck(plp != NULL);
+
+  for (i = (size_t)0; i < plp->nstages; i++) {
+    pipeline_stats_t *sp = &plp->stages[i].stats;
+
+    sp->processed  = (ucnt_t)0;
+    sp->dropped    = (ucnt_t)0;
+    sp->stalls     = (ucnt_t)0;
+    sp->worst      = (rtcnt_t)0;
+    sp->cumulative = (uint64_t)0;
+  }
+}
+
+#endif /* CH_CFG_USE_PIPELINES == TRUE */
+
+/** @} */
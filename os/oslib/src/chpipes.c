@@ -29,6 +29,13 @@
  *          - <b>Reset</b>: The pipe is emptied and all the stored data
  *            is lost.
  *          .
+ *          Pipes initialized using @p chPipeObjectInitSPSC() are restricted
+ *          to a single writer thread and a single reader thread, in this
+ *          mode transfers do not use mutexes nor the kernel lock unless
+ *          one side has to wait.<br>
+ *          Data can also be exchanged without copies by leasing pipe buffer
+ *          areas, see @p chPipeWriteAcquireTimeout() and
+ *          @p chPipeReadAcquireTimeout().
  * @pre     In order to use the pipes APIs the @p CH_CFG_USE_PIPES
  *          option must be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -72,6 +79,16 @@
 #define PR_UNLOCK(p)     chSemSignal(&(p)->rsem)
 #endif
 
+/*
+ * Compiler barrier, buffer accesses and the test of the waiting thread
+ * references must not be moved across the update of the SPSC counters.
+ */
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define PIPE_BARRIER()   __asm volatile ("" : : : "memory")
+#else
+#define PIPE_BARRIER()
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -89,30 +106,19 @@
 /*===========================================================================*/
 
 /**
- * @brief   Non-blocking pipe write.
- * @details The function writes data from a buffer to a pipe. The
- *          operation completes when the specified amount of data has been
- *          transferred or when the pipe buffer has been filled.
+ * @brief   Copies data into the pipe buffer.
+ * @details The write pointer is advanced, the amount of data is assumed to
+ *          fit in the free space of the buffer.
  *
  * @param[in] pp        the pointer to an initialized @p pipe_t object
  * @param[in] bp        pointer to the data buffer
- * @param[in] n         the maximum amount of data to be transferred, the
- *                      value 0 is reserved
- * @return              The number of bytes effectively transferred.
+ * @param[in] n         the amount of data to be transferred
  *
  * @notapi
  */
-static size_t pipe_write(pipe_t *pp, const uint8_t *bp, size_t n) {
+static void pipe_copy_in(pipe_t *pp, const uint8_t *bp, size_t n) {
   size_t s1, s2;
 
-  PC_LOCK(pp);
-
-  /* Number of bytes that can be written in a single atomic operation.*/
-  if (n > chPipeGetFreeCount(pp)) {
-    n = chPipeGetFreeCount(pp);
-  }
-  pp->cnt += n;
-
   /* Number of bytes before buffer limit.*/
   /*lint -save -e9033 [10.8] Checked to be safe.*/
   s1 = (size_t)(pp->top - pp->wrptr);
@@ -133,6 +139,69 @@ static size_t pipe_write(pipe_t *pp, const uint8_t *bp, size_t n) {
     memcpy((void *)pp->wrptr, (const void *)bp, n);
     pp->wrptr = pp->buffer;
   }
+}
+
+/**
+ * @brief   Copies data from the pipe buffer.
+ * @details The read pointer is advanced, the amount of data is assumed to
+ *          be available in the buffer.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the amount of data to be transferred
+ *
+ * @notapi
+ */
+static void pipe_copy_out(pipe_t *pp, uint8_t *bp, size_t n) {
+  size_t s1, s2;
+
+  /* Number of bytes before buffer limit.*/
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  s1 = (size_t)(pp->top - pp->rdptr);
+  /*lint -restore*/
+
+  if (n < s1) {
+    memcpy((void *)bp, (void *)pp->rdptr, n);
+    pp->rdptr += n;
+  }
+  else if (n > s1) {
+    memcpy((void *)bp, (void *)pp->rdptr, s1);
+    bp += s1;
+    s2 = n - s1;
+    memcpy((void *)bp, (void *)pp->buffer, s2);
+    pp->rdptr = pp->buffer + s2;
+  }
+  else {
+    memcpy((void *)bp, (void *)pp->rdptr, n);
+    pp->rdptr = pp->buffer;
+  }
+}
+
+/**
+ * @brief   Non-blocking pipe write.
+ * @details The function writes data from a buffer to a pipe. The
+ *          operation completes when the specified amount of data has been
+ *          transferred or when the pipe buffer has been filled.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_write(pipe_t *pp, const uint8_t *bp, size_t n) {
+
+  PC_LOCK(pp);
+
+  /* Number of bytes that can be written in a single atomic operation.*/
+  if (n > chPipeGetFreeCount(pp)) {
+    n = chPipeGetFreeCount(pp);
+  }
+  pp->cnt += n;
+
+  pipe_copy_in(pp, bp, n);
 
   PC_UNLOCK(pp);
 
@@ -154,7 +223,6 @@ static size_t pipe_write(pipe_t *pp, const uint8_t *bp, size_t n) {
  * @notapi
  */
 static size_t pipe_read(pipe_t *pp, uint8_t *bp, size_t n) {
-  size_t s1, s2;
 
   PC_LOCK(pp);
 
@@ -164,28 +232,245 @@ static size_t pipe_read(pipe_t *pp, uint8_t *bp, size_t n) {
   }
   pp->cnt -= n;
 
-  /* Number of bytes before buffer limit.*/
+  pipe_copy_out(pp, bp, n);
+
+  PC_UNLOCK(pp);
+
+  return n;
+}
+
+/**
+ * @brief   Lock-free pipe write, SPSC mode.
+ * @details Only the writer side updates the write pointer and the written
+ *          bytes counter, the reader side only reads them.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_spsc_write(pipe_t *pp, const uint8_t *bp, size_t n) {
+  size_t nfree = chPipeGetFreeCount(pp);
+
+  if (n > nfree) {
+    n = nfree;
+  }
+
+  if (n > (size_t)0) {
+    pipe_copy_in(pp, bp, n);
+
+    /* Data must be in the buffer before it is published to the reader.*/
+    PIPE_BARRIER();
+    pp->wrcnt += n;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Lock-free pipe read, SPSC mode.
+ * @details Only the reader side updates the read pointer and the read
+ *          bytes counter, the writer side only reads them.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the maximum amount of data to be transferred, the
+ *                      value 0 is reserved
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_spsc_read(pipe_t *pp, uint8_t *bp, size_t n) {
+  size_t nused = chPipeGetUsedCount(pp);
+
+  if (n > nused) {
+    n = nused;
+  }
+
+  if (n > (size_t)0) {
+    pipe_copy_out(pp, bp, n);
+
+    /* Data must be out of the buffer before the space is released to the
+       writer.*/
+    PIPE_BARRIER();
+    pp->rdcnt += n;
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Pipe write with timeout, SPSC mode.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         the number of bytes to be written, the value 0 is
+ *                      reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_spsc_write_timeout(pipe_t *pp, const uint8_t *bp,
+                                      size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  while (n > 0U) {
+    size_t done;
+
+    done = pipe_spsc_write(pp, bp, n);
+    if (done == (size_t)0) {
+      msg_t msg;
+
+      /* The reader could have released space after the check, the check
+         is repeated under lock before going to sleep.*/
+      chSysLock();
+      if (chPipeGetFreeCount(pp) > (size_t)0) {
+        chSysUnlock();
+        continue;
+      }
+      msg = chThdSuspendTimeoutS(&pp->wtr, timeout);
+      chSysUnlock();
+
+      /* Anything except MSG_OK causes the operation to stop.*/
+      if (msg != MSG_OK) {
+        break;
+      }
+    }
+    else {
+      n  -= done;
+      bp += done;
+
+      /* Resuming the reader, only if it is waiting. The reference must be
+         tested after the counter update or a reader going to sleep in the
+         meanwhile would not be resumed.*/
+      PIPE_BARRIER();
+      if (pp->rtr != NULL) {
+        chThdResume(&pp->rtr, MSG_OK);
+      }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+      chWaitNotify(pp);
+#endif
+    }
+  }
+
+  return max - n;
+}
+
+/**
+ * @brief   Pipe read with timeout, SPSC mode.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         the number of bytes to be read, the value 0 is
+ *                      reserved
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The number of bytes effectively transferred.
+ *
+ * @notapi
+ */
+static size_t pipe_spsc_read_timeout(pipe_t *pp, uint8_t *bp,
+                                     size_t n, sysinterval_t timeout) {
+  size_t max = n;
+
+  while (n > 0U) {
+    size_t done;
+
+    done = pipe_spsc_read(pp, bp, n);
+    if (done == (size_t)0) {
+      msg_t msg;
+
+      /* The writer could have added data after the check, the check is
+         repeated under lock before going to sleep.*/
+      chSysLock();
+      if (chPipeGetUsedCount(pp) > (size_t)0) {
+        chSysUnlock();
+        continue;
+      }
+      msg = chThdSuspendTimeoutS(&pp->rtr, timeout);
+      chSysUnlock();
+
+      /* Anything except MSG_OK causes the operation to stop.*/
+      if (msg != MSG_OK) {
+        break;
+      }
+    }
+    else {
+      n  -= done;
+      bp += done;
+
+      /* Resuming the writer, only if it is waiting. The reference must be
+         tested after the counter update or a writer going to sleep in the
+         meanwhile would not be resumed.*/
+      PIPE_BARRIER();
+      if (pp->wtr != NULL) {
+        chThdResume(&pp->wtr, MSG_OK);
+      }
+    }
+  }
+
+  return max - n;
+}
+
+/**
+ * @brief   Contiguous free space after the write pointer.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @return              The number of bytes that can be written in place.
+ *
+ * @notapi
+ */
+static size_t pipe_get_write_space(pipe_t *pp) {
+  size_t n;
+
+  if (!pp->spsc) {
+    PC_LOCK(pp);
+  }
+
+  n = chPipeGetFreeCount(pp);
+
+  if (!pp->spsc) {
+    PC_UNLOCK(pp);
+  }
+
   /*lint -save -e9033 [10.8] Checked to be safe.*/
-  s1 = (size_t)(pp->top - pp->rdptr);
+  if (n > (size_t)(pp->top - pp->wrptr)) {
+    n = (size_t)(pp->top - pp->wrptr);
+  }
   /*lint -restore*/
 
-  if (n < s1) {
-    memcpy((void *)bp, (void *)pp->rdptr, n);
-    pp->rdptr += n;
-  }
-  else if (n > s1) {
-    memcpy((void *)bp, (void *)pp->rdptr, s1);
-    bp += s1;
-    s2 = n - s1;
-    memcpy((void *)bp, (void *)pp->buffer, s2);
-    pp->rdptr = pp->buffer + s2;
+  return n;
+}
+
+/**
+ * @brief   Contiguous data after the read pointer.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @return              The number of bytes that can be read in place.
+ *
+ * @notapi
+ */
+static size_t pipe_get_read_space(pipe_t *pp) {
+  size_t n;
+
+  if (!pp->spsc) {
+    PC_LOCK(pp);
   }
-  else {
-    memcpy((void *)bp, (void *)pp->rdptr, n);
-    pp->rdptr = pp->buffer;
+
+  n = chPipeGetUsedCount(pp);
+
+  if (!pp->spsc) {
+    PC_UNLOCK(pp);
   }
 
-  PC_UNLOCK(pp);
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  if (n > (size_t)(pp->top - pp->rdptr)) {
+    n = (size_t)(pp->top - pp->rdptr);
+  }
+  /*lint -restore*/
 
   return n;
 }
@@ -214,6 +499,9 @@ void chPipeObjectInit(pipe_t *pp, uint8_t *buf, size_t n) {
   pp->top    = &buf[n];
   pp->cnt    = (size_t)0;
   pp->reset  = false;
+  pp->spsc   = false;
+  pp->wrcnt  = (size_t)0;
+  pp->rdcnt  = (size_t)0;
   pp->wtr    = NULL;
   pp->rtr    = NULL;
   PC_INIT(pp);
@@ -221,6 +509,29 @@ void chPipeObjectInit(pipe_t *pp, uint8_t *buf, size_t n) {
   PR_INIT(pp);
 }
 
+/**
+ * @brief   Initializes a @p pipe_t object in SPSC mode.
+ * @details In single producer and single consumer mode the pipe can only
+ *          be written by a single thread and read by a single thread, in
+ *          exchange data is transferred without using mutexes and the
+ *          kernel is only involved when a side has to wait.
+ * @note    Resetting a pipe in SPSC mode is only safe when no transfers
+ *          are in progress, waiting threads are resumed with @p MSG_RESET
+ *          as in the normal mode.
+ *
+ * @param[out] pp       the pointer to the @p pipe_t structure to be
+ *                      initialized
+ * @param[in] buf       pointer to the pipe buffer as an array of @p uint8_t
+ * @param[in] n         number of elements in the buffer array
+ *
+ * @init
+ */
+void chPipeObjectInitSPSC(pipe_t *pp, uint8_t *buf, size_t n) {
+
+  chPipeObjectInit(pp, buf, n);
+  pp->spsc = true;
+}
+
 /**
  * @brief   Resets a @p pipe_t object.
  * @details All the waiting threads are resumed with status @p MSG_RESET and
@@ -242,6 +553,7 @@ void chPipeReset(pipe_t *pp) {
   pp->wrptr = pp->buffer;
   pp->rdptr = pp->buffer;
   pp->cnt   = (size_t)0;
+  pp->rdcnt = pp->wrcnt;
   pp->reset = true;
 
   chSysLock();
@@ -286,6 +598,11 @@ size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
     return (size_t)0;
   }
 
+  /* SPSC mode, no mutual exclusion required.*/
+  if (pp->spsc) {
+    return pipe_spsc_write_timeout(pp, bp, n, timeout);
+  }
+
   PW_LOCK(pp);
 
   while (n > 0U) {
@@ -310,6 +627,9 @@ size_t chPipeWriteTimeout(pipe_t *pp, const uint8_t *bp,
 
       /* Resuming the reader, if present.*/
       chThdResume(&pp->rtr, MSG_OK);
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+      chWaitNotify(pp);
+#endif
     }
   }
 
@@ -351,6 +671,11 @@ size_t chPipeReadTimeout(pipe_t *pp, uint8_t *bp,
     return (size_t)0;
   }
 
+  /* SPSC mode, no mutual exclusion required.*/
+  if (pp->spsc) {
+    return pipe_spsc_read_timeout(pp, bp, n, timeout);
+  }
+
   PR_LOCK(pp);
 
   while (n > 0U) {
@@ -383,6 +708,236 @@ size_t chPipeReadTimeout(pipe_t *pp, uint8_t *bp,
   return max - n;
 }
 
+/**
+ * @brief   Leases a pipe buffer area for writing.
+ * @details The function returns a pointer to the write position inside the
+ *          pipe buffer and the number of bytes that can be written there
+ *          contiguously, if the pipe is full then the function waits for
+ *          free space. Data is made available to readers by calling
+ *          @p chPipeWriteCommit().
+ * @post    If the returned size is not zero then the write side of the pipe
+ *          is owned by the caller until @p chPipeWriteCommit() is invoked.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bpp      pointer to a variable receiving the buffer pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of contiguous bytes available for
+ *                      writing. Zero means that a timeout occurred or the
+ *                      pipe went in reset state.
+ *
+ * @api
+ */
+size_t chPipeWriteAcquireTimeout(pipe_t *pp, uint8_t **bpp,
+                                 sysinterval_t timeout) {
+  size_t n;
+
+  chDbgCheck((pp != NULL) && (bpp != NULL));
+
+  /* If the pipe is in reset state then returns immediately.*/
+  if (pp->reset) {
+    return (size_t)0;
+  }
+
+  if (!pp->spsc) {
+    PW_LOCK(pp);
+  }
+
+  while ((n = pipe_get_write_space(pp)) == (size_t)0) {
+    msg_t msg = MSG_OK;
+
+    /* The check is repeated under lock before going to sleep.*/
+    chSysLock();
+    if (chPipeGetFreeCount(pp) == (size_t)0) {
+      msg = chThdSuspendTimeoutS(&pp->wtr, timeout);
+    }
+    chSysUnlock();
+
+    /* Anything except MSG_OK causes the operation to stop.*/
+    if (msg != MSG_OK) {
+      if (!pp->spsc) {
+        PW_UNLOCK(pp);
+      }
+      return (size_t)0;
+    }
+  }
+
+  *bpp = pp->wrptr;
+
+  return n;
+}
+
+/**
+ * @brief   Commits data written in a leased pipe buffer area.
+ * @pre     The area must have been obtained using
+ *          @p chPipeWriteAcquireTimeout().
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] n         the number of bytes written in the leased area, it
+ *                      can be lower than the leased size or zero
+ *
+ * @api
+ */
+void chPipeWriteCommit(pipe_t *pp, size_t n) {
+
+  chDbgCheck(pp != NULL);
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  chDbgAssert(n <= (size_t)(pp->top - pp->wrptr), "out of leased area");
+  /*lint -restore*/
+
+  if (!pp->spsc) {
+    PC_LOCK(pp);
+    pp->cnt += n;
+  }
+
+  pp->wrptr += n;
+  if (pp->wrptr >= pp->top) {
+    pp->wrptr = pp->buffer;
+  }
+
+  if (!pp->spsc) {
+    PC_UNLOCK(pp);
+  }
+  else {
+    /* Data must be in the buffer before it is published to the reader.*/
+    PIPE_BARRIER();
+    pp->wrcnt += n;
+
+    /* The reader reference must be tested after the counter update.*/
+    PIPE_BARRIER();
+  }
+
+  /* Resuming the reader, only if it is waiting.*/
+  if ((n > (size_t)0) && (pp->rtr != NULL)) {
+    chThdResume(&pp->rtr, MSG_OK);
+  }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  if (n > (size_t)0) {
+    chWaitNotify(pp);
+  }
+#endif
+
+  if (!pp->spsc) {
+    PW_UNLOCK(pp);
+  }
+}
+
+/**
+ * @brief   Leases a pipe buffer area for reading.
+ * @details The function returns a pointer to the read position inside the
+ *          pipe buffer and the number of bytes that can be read there
+ *          contiguously, if the pipe is empty then the function waits for
+ *          data. The space is returned to writers by calling
+ *          @p chPipeReadRelease().
+ * @post    If the returned size is not zero then the read side of the pipe
+ *          is owned by the caller until @p chPipeReadRelease() is invoked.
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[out] bpp      pointer to a variable receiving the buffer pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of contiguous bytes available for
+ *                      reading. Zero means that a timeout occurred or the
+ *                      pipe went in reset state.
+ *
+ * @api
+ */
+size_t chPipeReadAcquireTimeout(pipe_t *pp, const uint8_t **bpp,
+                                sysinterval_t timeout) {
+  size_t n;
+
+  chDbgCheck((pp != NULL) && (bpp != NULL));
+
+  /* If the pipe is in reset state then returns immediately.*/
+  if (pp->reset) {
+    return (size_t)0;
+  }
+
+  if (!pp->spsc) {
+    PR_LOCK(pp);
+  }
+
+  while ((n = pipe_get_read_space(pp)) == (size_t)0) {
+    msg_t msg = MSG_OK;
+
+    /* The check is repeated under lock before going to sleep.*/
+    chSysLock();
+    if (chPipeGetUsedCount(pp) == (size_t)0) {
+      msg = chThdSuspendTimeoutS(&pp->rtr, timeout);
+    }
+    chSysUnlock();
+
+    /* Anything except MSG_OK causes the operation to stop.*/
+    if (msg != MSG_OK) {
+      if (!pp->spsc) {
+        PR_UNLOCK(pp);
+      }
+      return (size_t)0;
+    }
+  }
+
+  *bpp = pp->rdptr;
+
+  return n;
+}
+
+/**
+ * @brief   Releases data read from a leased pipe buffer area.
+ * @pre     The area must have been obtained using
+ *          @p chPipeReadAcquireTimeout().
+ *
+ * @param[in] pp        the pointer to an initialized @p pipe_t object
+ * @param[in] n         the number of bytes consumed from the leased area,
+ *                      it can be lower than the leased size or zero
+ *
+ * @api
+ */
+void chPipeReadRelease(pipe_t *pp, size_t n) {
+
+  chDbgCheck(pp != NULL);
+  /*lint -save -e9033 [10.8] Checked to be safe.*/
+  chDbgAssert(n <= (size_t)(pp->top - pp->rdptr), "out of leased area");
+  /*lint -restore*/
+
+  if (!pp->spsc) {
+    PC_LOCK(pp);
+    pp->cnt -= n;
+  }
+
+  pp->rdptr += n;
+  if (pp->rdptr >= pp->top) {
+    pp->rdptr = pp->buffer;
+  }
+
+  if (!pp->spsc) {
+    PC_UNLOCK(pp);
+  }
+  else {
+    /* Data must be out of the buffer before the space is released to the
+       writer.*/
+    PIPE_BARRIER();
+    pp->rdcnt += n;
+
+    /* The writer reference must be tested after the counter update.*/
+    PIPE_BARRIER();
+  }
+
+  /* Resuming the writer, only if it is waiting.*/
+  if ((n > (size_t)0) && (pp->wtr != NULL)) {
+    chThdResume(&pp->wtr, MSG_OK);
+  }
+
+  if (!pp->spsc) {
+    PR_UNLOCK(pp);
+  }
+}
+
 #endif /* CH_CFG_USE_PIPES == TRUE */
 
 /** @} */
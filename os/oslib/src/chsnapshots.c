@@ -0,0 +1,145 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chsnapshots.c
+ * @brief   Snapshots code.
+ * @details Read-mostly shared state publication.
+ *          <h2>Operation mode</h2>
+ *          A snapshot holds two versions of a shared state, the current
+ *          one and the one being written. Writers never wait, a new
+ *          version is written in the inactive buffer then made current
+ *          by updating a sequence counter. Readers copy the current
+ *          version and check the sequence counter afterward, the copy is
+ *          retried only if the buffer has been reused by a second writer
+ *          operation during the copy.<br>
+ *          No critical zones are used, the functions can be called from
+ *          any context. A reader ISR preempting a writer never retries.
+ * @note    Writers must be serialized by the caller.
+ * @note    The sequence counter is accessed without the kernel lock, the
+ *          mechanism relies on atomic accesses to @p ucnt_t and on a
+ *          single core memory ordering.
+ * @note    Compatible with RT and NIL.
+ *
+ * @addtogroup oslib_snapshots
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p snapshot_t object.
+ * @note    The initial state is the content of the first half of the
+ *          buffer.
+ *
+ * @param[out] sp       pointer to a @p snapshot_t object
+ * @param[in] buf       pointer to a buffer of @p 2 * @p size bytes
+ * @param[in] size      size of the shared state
+ *
+ * @init
+ */
+void chSnapObjectInit(snapshot_t *sp, void *buf, size_t size) {
+
+  chDbgCheck((sp != NULL) && (buf != NULL) && (size > (size_t)0));
+
+  sp->seq        = (ucnt_t)0;
+  sp->buffers[0] = (uint8_t *)buf;
+  sp->buffers[1] = (uint8_t *)buf + size;
+  sp->size       = size;
+}
+
+/**
+ * @brief   Publishes a new version.
+ * @details The state is copied in the inactive buffer which then becomes
+ *          the current one, the function never waits.
+ * @note    Writers must be serialized by the caller.
+ *
+ * @param[in] sp        pointer to a @p snapshot_t object
+ * @param[in] data      pointer to the new state
+ *
+ * @xclass
+ */
+void chSnapPublishX(snapshot_t *sp, const void *data) {
+
+  chDbgCheck((sp != NULL) && (data != NULL));
+
+  memcpy(chSnapBeginWriteX(sp), data, sp->size);
+  chSnapEndWriteX(sp);
+}
+
+/**
+ * @brief   Reads a consistent copy of the current version.
+ * @details The current buffer is copied then the sequence counter is
+ *          checked, the copy is valid unless a writer started reusing
+ *          the buffer, this requires two writer operations during the
+ *          copy. In that case the copy is retried.
+ *
+ * @param[in] sp        pointer to a @p snapshot_t object
+ * @param[out] data     pointer to the destination buffer
+ * @return              The number of the copied version.
+ *
+ * @xclass
+ */
+ucnt_t chSnapReadX(snapshot_t *sp, void *data) {
+  ucnt_t seq, base;
+
+  chDbgCheck((sp != NULL) && (data != NULL));
+
+  do {
+    seq = sp->seq;
+    __snap_barrier();
+
+    /* While a version is being written the current buffer is still the
+       one of the previous version.*/
+    memcpy(data, sp->buffers[(seq >> 1) & (ucnt_t)1], sp->size);
+
+    __snap_barrier();
+    base = seq & ~(ucnt_t)1;
+  } while ((ucnt_t)(sp->seq - base) > (ucnt_t)2);
+
+  return seq >> 1;
+}
+
+/** @} */
@@ -0,0 +1,254 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    oslib/src/chwaitmulti.c
+ * @brief   Multiple objects wait code.
+ * @details Multiple objects wait.
+ *          <h2>Operation mode</h2>
+ *          A thread can wait on an array of heterogeneous items: semaphores,
+ *          mailboxes, objects FIFOs, pipes and its own events. The wait
+ *          returns a mask of the items found ready, the objects are not
+ *          consumed, the thread performs the non-blocking operation on
+ *          the ready objects after the wait.<br>
+ *          The waiting thread is linked in a single list of pollers, the
+ *          signaling paths of the objects check the list and make ready
+ *          the threads waiting on the signaled object, the readiness of
+ *          all the items is then evaluated again by the woken thread.
+ * @pre     In order to use the multiple objects wait APIs the
+ *          @p CH_CFG_USE_WAIT_MULTIPLE option must be enabled in
+ *          @p chconf.h.
+ * @note    Compatible with RT only.
+ *
+ * @addtogroup oslib_waitmulti
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_WAIT_MULTIPLE == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   List of the threads waiting on multiple objects.
+ */
+ch_queue_t ch_wait_pollers = __CH_QUEUE_DATA(ch_wait_pollers);
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool wait_item_is_ready(const wait_item_t *wip, const thread_t *tp) {
+
+  switch (wip->type) {
+#if CH_CFG_USE_SEMAPHORES == TRUE
+  case CH_WAIT_SEMAPHORE:
+    return chSemGetCounterI((const semaphore_t *)wip->objp) > (cnt_t)0;
+#endif
+#if CH_CFG_USE_MAILBOXES == TRUE
+  case CH_WAIT_MAILBOX:
+    return chMBGetUsedCountI((const mailbox_t *)wip->objp) > (size_t)0;
+#endif
+#if CH_CFG_USE_PIPES == TRUE
+  case CH_WAIT_PIPE:
+    return chPipeGetUsedCount((const pipe_t *)wip->objp) > (size_t)0;
+#endif
+#if CH_CFG_USE_EVENTS == TRUE
+  case CH_WAIT_EVENTS:
+    return (tp->epending & wip->events) != (eventmask_t)0;
+#endif
+  default:
+    chDbgAssert(false, "invalid item type");
+    break;
+  }
+
+  (void)tp;
+
+  return false;
+}
+
+static uint32_t wait_poll(const wait_item_t *items, unsigned n,
+                          const thread_t *tp) {
+  uint32_t ready = 0U;
+  unsigned i;
+
+  for (i = 0U; i < n; i++) {
+    if (wait_item_is_ready(&items[i], tp)) {
+      ready |= (uint32_t)1U << i;
+    }
+  }
+
+  return ready;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Makes ready the threads waiting on an object.
+ * @note    Not meant to be called directly, use @p chWaitNotifyI().
+ *
+ * @param[in] objp      pointer to the object, or to the thread owning the
+ *                      signaled events
+ *
+ * @notapi
+ */
+void __wait_notify_i(const void *objp) {
+  ch_queue_t *qp = ch_wait_pollers.next;
+
+  while (qp != &ch_wait_pollers) {
+    wait_poller_t *wpp = (wait_poller_t *)qp;
+    unsigned i;
+
+    for (i = 0U; i < wpp->n; i++) {
+      const wait_item_t *wip = &wpp->items[i];
+
+      if (((wip->type == CH_WAIT_EVENTS) && ((void *)wpp->tp == objp)) ||
+          ((wip->type != CH_WAIT_EVENTS) && (wip->objp == objp))) {
+        chThdResumeI(&wpp->tr, MSG_OK);
+        break;
+      }
+    }
+    qp = qp->next;
+  }
+}
+
+/**
+ * @brief   Waits for any of the specified items to become ready.
+ * @details The function returns immediately if any item is already ready,
+ *          else the thread sleeps until an item is signaled or the
+ *          timeout expires.
+ * @note    The ready objects are not consumed, the non-blocking operations
+ *          on the ready items are performed by the caller, another thread
+ *          could consume an object before that.
+ *
+ * @param[in] items     array of wait items
+ * @param[in] n         number of items, up to @p CH_WAIT_MAX_ITEMS
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The mask of the ready items, bit @p i represents
+ *                      the item @p i of the array.
+ * @retval 0            if the operation has timed out.
+ *
+ * @sclass
+ */
+uint32_t chWaitMultipleTimeoutS(const wait_item_t *items, unsigned n,
+                                sysinterval_t timeout) {
+  thread_t *currtp = chThdGetSelfX();
+  sysinterval_t remaining = timeout;
+  wait_poller_t wp;
+  systime_t start;
+  uint32_t ready;
+
+  chDbgCheckClassS();
+  chDbgCheck((items != NULL) && (n > 0U) && (n <= CH_WAIT_MAX_ITEMS));
+
+  ready = wait_poll(items, n, currtp);
+  if ((ready != 0U) || (timeout == TIME_IMMEDIATE)) {
+    return ready;
+  }
+
+  /* Registering as poller, the signaling paths are checked against all
+     the items of the array at once.*/
+  wp.tr    = NULL;
+  wp.tp    = currtp;
+  wp.items = items;
+  wp.n     = n;
+  ch_queue_insert(&wp.link, &ch_wait_pollers);
+
+  start = chVTGetSystemTimeX();
+  while (true) {
+    msg_t msg = chThdSuspendTimeoutS(&wp.tr, remaining);
+
+    /* Any signaled item could have been consumed by another thread in the
+       meantime, all the items are checked again.*/
+    ready = wait_poll(items, n, currtp);
+    if ((ready != 0U) || (msg == MSG_TIMEOUT)) {
+      break;
+    }
+
+    if (timeout != TIME_INFINITE) {
+      sysinterval_t elapsed = chTimeDiffX(start, chVTGetSystemTimeX());
+
+      if (elapsed >= timeout) {
+        break;
+      }
+      remaining = timeout - elapsed;
+    }
+  }
+  (void) ch_queue_dequeue(&wp.link);
+
+  return ready;
+}
+
+/**
+ * @brief   Waits for any of the specified items to become ready.
+ * @details The function returns immediately if any item is already ready,
+ *          else the thread sleeps until an item is signaled or the
+ *          timeout expires.
+ * @note    The ready objects are not consumed, the non-blocking operations
+ *          on the ready items are performed by the caller, another thread
+ *          could consume an object before that.
+ *
+ * @param[in] items     array of wait items
+ * @param[in] n         number of items, up to @p CH_WAIT_MAX_ITEMS
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The mask of the ready items, bit @p i represents
+ *                      the item @p i of the array.
+ * @retval 0            if the operation has timed out.
+ *
+ * @api
+ */
+uint32_t chWaitMultipleTimeout(const wait_item_t *items, unsigned n,
+                               sysinterval_t timeout) {
+  uint32_t ready;
+
+  chSysLock();
+  ready = chWaitMultipleTimeoutS(items, n, timeout);
+  chSysUnlock();
+
+  return ready;
+}
+
+#endif /* CH_CFG_USE_WAIT_MULTIPLE == TRUE */
+
+/** @} */
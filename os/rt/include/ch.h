@@ -116,8 +116,11 @@
 #include "chsem.h"
 #include "chmtx.h"
 #include "chcond.h"
+#include "chrwlock.h"
 #include "chevents.h"
 #include "chmsg.h"
+#include "chres.h"
+#include "chtls.h"
 
 /* OSLIB.*/
 #include "chlib.h"
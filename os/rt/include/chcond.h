@@ -59,6 +59,10 @@
 typedef struct condition_variable {
   ch_queue_t            queue;              /**< @brief Condition variable
                                                  threads queue.             */
+  mutex_t               *mtxp;              /**< @brief Mutex released by
+                                                 the waiting threads,
+                                                 @p NULL if they released
+                                                 different mutexes.         */
 } condition_variable_t;
 
 /*===========================================================================*/
@@ -72,7 +76,7 @@ typedef struct condition_variable {
  *
  * @param[in] name      the name of the condition variable
  */
-#define __CONDVAR_DATA(name) {__CH_QUEUE_DATA(name.queue)}
+#define __CONDVAR_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL}
 
 /**
  * @brief Static condition variable initializer.
@@ -46,12 +46,46 @@
 #if !defined(CH_DBG_STACK_FILL_VALUE) || defined(__DOXYGEN__)
 #define CH_DBG_STACK_FILL_VALUE             0x55
 #endif
+
+/**
+ * @brief   Stack watermarks.
+ * @details If enabled then each thread keeps the minimum free stack space
+ *          observed, the stack pointer is sampled at each context switch
+ *          and, if the port provides @p port_get_thread_stack_pointer(), on
+ *          each interrupt entry.
+ * @note    The samples do not catch peaks between two sampling points so
+ *          the watermark is an upper bound of the free stack space, a
+ *          safety margin is still required when sizing stacks.
+ */
+#if !defined(CH_DBG_STACK_WATERMARK) || defined(__DOXYGEN__)
+#define CH_DBG_STACK_WATERMARK              FALSE
+#endif
+
+/**
+ * @brief   Expensive assertions.
+ * @details Assertions scanning lists or the registry are only enabled by
+ *          this switch, the other assertions and the parameter checks
+ *          have constant cost and can be left enabled in production.
+ * @note    The default is equal to @p CH_DBG_ENABLE_ASSERTS.
+ */
+#if !defined(CH_DBG_ENABLE_EXPENSIVE_ASSERTS) || defined(__DOXYGEN__)
+#define CH_DBG_ENABLE_EXPENSIVE_ASSERTS     CH_DBG_ENABLE_ASSERTS
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_DBG_STACK_WATERMARK == TRUE) && (CH_DBG_ENABLE_STACK_CHECK == FALSE)
+#error "CH_DBG_STACK_WATERMARK requires CH_DBG_ENABLE_STACK_CHECK"
+#endif
+
+#if (CH_DBG_ENABLE_EXPENSIVE_ASSERTS == TRUE) &&                            \
+    (CH_DBG_ENABLE_ASSERTS == FALSE)
+#error "CH_DBG_ENABLE_EXPENSIVE_ASSERTS requires CH_DBG_ENABLE_ASSERTS"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -100,6 +134,26 @@ typedef struct ch_system_debug {
 #define chDbgCheckClassS()
 #endif
 
+#if (CH_DBG_STACK_WATERMARK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Accounts a stack pointer sample for a thread.
+ * @note    Samples outside the thread working area are ignored, overflows
+ *          are detected by the stack check.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] sp        stack pointer sample
+ *
+ * @notapi
+ */
+#define __dbg_stack_sample(tp, sp) do {                                     \
+  uintptr_t __base = (uintptr_t)(tp)->wabase;                               \
+  uintptr_t __sp = (uintptr_t)(sp);                                         \
+  if ((__sp > __base) && ((__sp - __base) < (uintptr_t)(tp)->wmargin)) {    \
+    (tp)->wmargin = (size_t)(__sp - __base);                                \
+  }                                                                         \
+} while (false)
+#endif
+
 /**
  * @name    Macro Functions
  * @{
@@ -151,6 +205,31 @@ typedef struct ch_system_debug {
   }                                                                         \
 } while (false)
 #endif /* !defined(chDbgAssert) */
+
+/**
+ * @brief   Expensive condition assertion.
+ * @details If the condition check fails then the kernel panics with a
+ *          message and halts.
+ * @note    The condition is tested only if the
+ *          @p CH_DBG_ENABLE_EXPENSIVE_ASSERTS switch is specified in
+ *          @p chconf.h else the macro does nothing.
+ *
+ * @param[in] c         the condition to be verified to be true
+ * @param[in] r         a remark string
+ *
+ * @api
+ */
+#if !defined(chDbgAssertExpensive)
+#define chDbgAssertExpensive(c, r) do {                                     \
+  /*lint -save -e506 -e774 [2.1, 14.3] Can be a constant by design.*/       \
+  if (CH_DBG_ENABLE_EXPENSIVE_ASSERTS != FALSE) {                           \
+    if (!(c)) {                                                             \
+  /*lint -restore*/                                                         \
+      chSysHalt(__func__);                                                  \
+    }                                                                       \
+  }                                                                         \
+} while (false)
+#endif /* !defined(chDbgAssertExpensive) */
 /** @} */
 
 /*===========================================================================*/
@@ -61,10 +61,103 @@
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a threads pool.
+ */
+typedef struct ch_thread_pool thread_pool_t;
+
+/**
+ * @brief   Type of a threads pool worker.
+ * @note    This structure is placed at the base of each worker working
+ *          area, below the stack.
+ */
+typedef struct ch_thread_pool_worker {
+  /**
+   * @brief   Next worker in the parked or exited lists.
+   */
+  struct ch_thread_pool_worker  *next;
+  /**
+   * @brief   Owner threads pool.
+   */
+  thread_pool_t                 *pool;
+  /**
+   * @brief   Worker thread.
+   */
+  thread_t                      *tp;
+  /**
+   * @brief   Reference to the worker while parked.
+   */
+  thread_reference_t            tr;
+  /**
+   * @brief   Function to be executed or @p NULL.
+   */
+  tfunc_t                       func;
+  /**
+   * @brief   Argument of the function to be executed.
+   */
+  void                          *arg;
+} thread_pool_worker_t;
+
+/**
+ * @brief   Structure representing a threads pool.
+ */
+struct ch_thread_pool {
+  /**
+   * @brief   Memory pool of the working areas.
+   */
+  memory_pool_t                 *mp;
+  /**
+   * @brief   Name of the worker threads.
+   */
+  const char                    *name;
+  /**
+   * @brief   Priority of the worker threads.
+   */
+  tprio_t                       prio;
+  /**
+   * @brief   Maximum number of workers.
+   */
+  ucnt_t                        max;
+  /**
+   * @brief   Time after which a parked worker terminates.
+   */
+  sysinterval_t                 idle;
+  /**
+   * @brief   Current number of workers.
+   */
+  ucnt_t                        workers;
+  /**
+   * @brief   Highest number of workers reached.
+   */
+  ucnt_t                        high_water;
+  /**
+   * @brief   Parked workers, most recently parked first.
+   */
+  thread_pool_worker_t          *parked;
+  /**
+   * @brief   Terminated workers to be reclaimed.
+   */
+  thread_pool_worker_t          *exited;
+};
+#endif /* CH_CFG_USE_MEMPOOLS == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Size of a threads pool working area.
+ * @details The working area includes the worker structure.
+ *
+ * @param[in] n         the stack size to be assigned to the worker
+ */
+#define THD_POOL_WORKING_AREA_SIZE(n)                                       \
+  (MEM_ALIGN_NEXT(sizeof (thread_pool_worker_t), PORT_WORKING_AREA_ALIGN) + \
+   THD_WORKING_AREA_SIZE(n))
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -83,6 +176,11 @@ extern "C" {
 #if CH_CFG_USE_MEMPOOLS == TRUE
   thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
                                       tprio_t prio, tfunc_t pf, void *arg);
+  void chThdPoolObjectInit(thread_pool_t *tpp, memory_pool_t *mp,
+                           const char *name, tprio_t prio,
+                           ucnt_t max, sysinterval_t idle);
+  bool chThdPoolSubmit(thread_pool_t *tpp, tfunc_t func, void *arg);
+  ucnt_t chThdPoolPrestart(thread_pool_t *tpp, ucnt_t n);
 #endif
 #ifdef __cplusplus
 }
@@ -92,6 +190,21 @@ extern "C" {
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the highest number of workers reached by a threads pool.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @return              The highest number of workers.
+ *
+ * @xclass
+ */
+static inline ucnt_t chThdPoolGetHighWaterX(thread_pool_t *tpp) {
+
+  return tpp->high_water;
+}
+#endif
+
 #endif /* CH_CFG_USE_DYNAMIC == TRUE */
 
 #endif /* CHDYNAMIC_H */
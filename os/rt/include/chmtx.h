@@ -64,6 +64,11 @@ struct ch_mutex {
 #if (CH_CFG_USE_MUTEXES_RECURSIVE == TRUE) || defined(__DOXYGEN__)
   cnt_t                 cnt;        /**< @brief Mutex recursion counter.    */
 #endif
+#if (CH_CFG_USE_MUTEXES_CEILING == TRUE) || defined(__DOXYGEN__)
+  tprio_t               ceiling;    /**< @brief Ceiling priority or
+                                                @p NOPRIO for priority
+                                                inheritance.                */
+#endif
 };
 
 /*===========================================================================*/
@@ -77,12 +82,43 @@ struct ch_mutex {
  *
  * @param[in] name      the name of the mutex variable
  */
-#if (CH_CFG_USE_MUTEXES_RECURSIVE == TRUE) || defined(__DOXYGEN__)
+#if (CH_CFG_USE_MUTEXES_CEILING == TRUE) || defined(__DOXYGEN__)
+#define __MUTEX_DATA(name) __MUTEX_CEILING_DATA(name, NOPRIO)
+#elif CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
 #define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL, 0}
 #else
 #define __MUTEX_DATA(name) {__CH_QUEUE_DATA(name.queue), NULL, NULL}
 #endif
 
+#if (CH_CFG_USE_MUTEXES_CEILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Data part of a static priority ceiling mutex initializer.
+ * @details This macro should be used when statically initializing a
+ *          priority ceiling mutex that is part of a bigger structure.
+ *
+ * @param[in] name      the name of the mutex variable
+ * @param[in] prio      the ceiling priority
+ */
+#if (CH_CFG_USE_MUTEXES_RECURSIVE == TRUE) || defined(__DOXYGEN__)
+#define __MUTEX_CEILING_DATA(name, prio)                                    \
+  {__CH_QUEUE_DATA(name.queue), NULL, NULL, 0, prio}
+#else
+#define __MUTEX_CEILING_DATA(name, prio)                                    \
+  {__CH_QUEUE_DATA(name.queue), NULL, NULL, prio}
+#endif
+
+/**
+ * @brief   Static priority ceiling mutex initializer.
+ * @details Statically initialized mutexes require no explicit initialization
+ *          using @p chMtxCeilingObjectInit().
+ *
+ * @param[in] name      the name of the mutex variable
+ * @param[in] prio      the ceiling priority
+ */
+#define MUTEX_CEILING_DECL(name, prio)                                      \
+  mutex_t name = __MUTEX_CEILING_DATA(name, prio)
+#endif
+
 /**
  * @brief   Static mutex initializer.
  * @details Statically initialized mutexes require no explicit initialization
@@ -99,7 +135,11 @@ struct ch_mutex {
 #ifdef __cplusplus
 extern "C" {
 #endif
+  tprio_t __mtx_get_prio(thread_t *tp);
   void chMtxObjectInit(mutex_t *mp);
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+  void chMtxCeilingObjectInit(mutex_t *mp, tprio_t ceiling);
+#endif
   void chMtxLock(mutex_t *mp);
   void chMtxLockS(mutex_t *mp);
   bool chMtxTryLock(mutex_t *mp);
@@ -36,10 +36,261 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Bitmap-indexed ready list.
+ * @details If enabled then the ready list is indexed by a priority bitmap
+ *          and threads insertion becomes a constant time operation
+ *          regardless of the number of ready threads.
+ * @note    The index requires a pointer for each priority level, this is
+ *          about 1kB of RAM for each OS instance on 32 bits architectures.
+ */
+#if !defined(CH_CFG_USE_BITMAP_READYLIST) || defined(__DOXYGEN__)
+#define CH_CFG_USE_BITMAP_READYLIST         FALSE
+#endif
+
+/**
+ * @brief   Virtual timers wheel.
+ * @details If enabled then virtual timers are kept in a hashed timing wheel
+ *          instead of a delta list, arming and disarming a timer become
+ *          constant time operations regardless of the number of armed
+ *          timers.
+ */
+#if !defined(CH_CFG_USE_VT_WHEEL) || defined(__DOXYGEN__)
+#define CH_CFG_USE_VT_WHEEL                 FALSE
+#endif
+
+/**
+ * @brief   Number of slots in the virtual timers wheel.
+ * @note    Must be a power of two between 32 and 1024.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SLOTS) || defined(__DOXYGEN__)
+#define CH_CFG_VT_WHEEL_SLOTS               64
+#endif
+
+/**
+ * @brief   Deferred virtual timers.
+ * @details If enabled then virtual timers armed using @p chVTSetDeferredI()
+ *          execute their callbacks in a dedicated timers thread instead of
+ *          the system tick interrupt.
+ */
+#if !defined(CH_CFG_USE_VT_DEFERRED) || defined(__DOXYGEN__)
+#define CH_CFG_USE_VT_DEFERRED              FALSE
+#endif
+
+/**
+ * @brief   Priority of the deferred timers thread.
+ */
+#if !defined(CH_CFG_VT_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define CH_CFG_VT_THREAD_PRIORITY           HIGHPRIO
+#endif
+
+/**
+ * @brief   Stack size of the deferred timers thread.
+ */
+#if !defined(CH_CFG_VT_THREAD_STACK_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_VT_THREAD_STACK_SIZE         256
+#endif
+
+/**
+ * @brief   Virtual timers slack.
+ * @details If enabled then virtual timers armed using @p chVTDoSetSlackI()
+ *          can be delayed within a tolerance window in order to share the
+ *          deadline of an already armed timer.
+ */
+#if !defined(CH_CFG_USE_VT_SLACK) || defined(__DOXYGEN__)
+#define CH_CFG_USE_VT_SLACK                 FALSE
+#endif
+
+/**
+ * @brief   Deadline scheduling class.
+ * @details If enabled then threads can join an earliest deadline first
+ *          class, threads in the class run at @p CH_CFG_EDF_PRIORITY and
+ *          are ordered by absolute deadline within that priority level.
+ */
+#if !defined(CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_EDF                      FALSE
+#endif
+
+/**
+ * @brief   Priority level reserved to the deadline scheduling class.
+ * @note    Threads outside the class should not use this priority.
+ */
+#if !defined(CH_CFG_EDF_PRIORITY) || defined(__DOXYGEN__)
+#define CH_CFG_EDF_PRIORITY                 (HIGHPRIO - 1)
+#endif
+
+/**
+ * @brief   CPU budget reservations APIs.
+ * @details If enabled then groups of threads can be limited to a CPU time
+ *          budget for each replenishment period.
+ */
+#if !defined(CH_CFG_USE_RESERVATIONS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_RESERVATIONS             FALSE
+#endif
+
+/**
+ * @brief   Priority of the threads of an exhausted reservation.
+ * @details Threads of a reservation are moved to this priority level when
+ *          the budget is exhausted and restored when it is replenished.
+ */
+#if !defined(CH_CFG_RES_THROTTLE_PRIORITY) || defined(__DOXYGEN__)
+#define CH_CFG_RES_THROTTLE_PRIORITY        LOWPRIO
+#endif
+
+/**
+ * @brief   Thread local storage.
+ * @details If enabled then each thread owns a copy of the variables
+ *          declared @p __thread or @p _Thread_local, the copy is allocated
+ *          in the thread working area.
+ * @note    Requires port support.
+ */
+#if !defined(CH_CFG_USE_TLS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TLS                      FALSE
+#endif
+
+/**
+ * @brief   Maximum size of the thread local variables.
+ * @details This space is reserved in each thread working area, it must
+ *          accommodate the @p .tdata and @p .tbss sections.
+ */
+#if !defined(CH_CFG_TLS_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_TLS_SIZE                     64
+#endif
+
+/**
+ * @brief   Per-thread newlib reentrancy structure.
+ * @details If enabled then each thread owns a newlib @p _reent structure
+ *          allocated next to its TLS block, @p _impure_ptr is switched
+ *          with the thread.
+ * @note    Requires @p CH_CFG_USE_TLS.
+ */
+#if !defined(CH_CFG_USE_NEWLIB_REENT) || defined(__DOXYGEN__)
+#define CH_CFG_USE_NEWLIB_REENT             FALSE
+#endif
+
+/**
+ * @brief   Priority ceiling mutexes.
+ * @details If enabled then mutexes can be initialized with a ceiling
+ *          priority using the immediate priority ceiling protocol.
+ * @note    Requires @p CH_CFG_USE_MUTEXES.
+ */
+#if !defined(CH_CFG_USE_MUTEXES_CEILING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MUTEXES_CEILING          FALSE
+#endif
+
+/**
+ * @brief   Periodic threads APIs.
+ * @details If enabled then threads can be given a release period, the
+ *          kernel keeps the release times and measures jitter and
+ *          overruns of each periodic thread.
+ */
+#if !defined(CH_CFG_USE_PERIODIC) || defined(__DOXYGEN__)
+#define CH_CFG_USE_PERIODIC                 FALSE
+#endif
+
+/**
+ * @brief   Run-to-completion tasks APIs.
+ * @details If enabled then event-triggered tasks without a stack of their
+ *          own can be run, the tasks of a priority level share the stack
+ *          of a single runner thread.
+ */
+#if !defined(CH_CFG_USE_TASKS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TASKS                    FALSE
+#endif
+
+/**
+ * @brief   Preemption threshold.
+ * @details If enabled then threads can be given a preemption threshold, a
+ *          running thread can only be preempted by threads with priority
+ *          above its threshold.
+ */
+#if !defined(CH_CFG_USE_PREEMPT_THRESHOLD) || defined(__DOXYGEN__)
+#define CH_CFG_USE_PREEMPT_THRESHOLD        FALSE
+#endif
+
+/**
+ * @brief   Compact objects layout.
+ * @details If enabled then the kernel objects are made smaller at the cost
+ *          of some speed, the threads registry becomes a single linked
+ *          list and removing a thread from the registry requires a scan.
+ */
+#if !defined(CH_CFG_COMPACT_OBJECTS) || defined(__DOXYGEN__)
+#define CH_CFG_COMPACT_OBJECTS              FALSE
+#endif
+
+/**
+ * @brief   Idle governor.
+ * @details If enabled then the idle thread enters the deepest low power
+ *          state, among the ones registered using @p chSchSetIdleStates(),
+ *          that can be entered and exited before the next virtual timer
+ *          deadline.
+ * @note    Requires the tickless mode and the idle thread.
+ */
+#if !defined(CH_CFG_USE_IDLE_GOVERNOR) || defined(__DOXYGEN__)
+#define CH_CFG_USE_IDLE_GOVERNOR            FALSE
+#endif
+
+/**
+ * @brief   Threads IDs table size.
+ * @details If greater than zero then registered threads are assigned a
+ *          numeric ID and can be found by ID in constant time.
+ * @note    Must be zero or a power of two between 8 and 1024.
+ */
+#if !defined(CH_CFG_REGISTRY_ID_SLOTS) || defined(__DOXYGEN__)
+#define CH_CFG_REGISTRY_ID_SLOTS            0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) && (CH_CFG_ST_TIMEDELTA == 0)
+#error "CH_CFG_USE_IDLE_GOVERNOR requires the tickless mode"
+#endif
+
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) && (CH_CFG_NO_IDLE_THREAD == TRUE)
+#error "CH_CFG_USE_IDLE_GOVERNOR requires the idle thread"
+#endif
+
+#if (CH_CFG_USE_BITMAP_READYLIST == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of priority levels indexed in the ready list.
+ */
+#define CH_RLIST_PRIO_LEVELS                256U
+
+/**
+ * @brief   Number of 32 bits words in the ready list priority bitmap.
+ */
+#define CH_RLIST_MAP_WORDS                  (CH_RLIST_PRIO_LEVELS / 32U)
+#endif
+
+#if (CH_CFG_USE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+#if (CH_CFG_VT_WHEEL_SLOTS < 32) || (CH_CFG_VT_WHEEL_SLOTS > 1024) ||        \
+    ((CH_CFG_VT_WHEEL_SLOTS & (CH_CFG_VT_WHEEL_SLOTS - 1)) != 0)
+#error "CH_CFG_VT_WHEEL_SLOTS must be a power of two between 32 and 1024"
+#endif
+
+/**
+ * @brief   Number of 32 bits words in the timers wheel slots bitmap.
+ */
+#define CH_VT_WHEEL_MAP_WORDS               (CH_CFG_VT_WHEEL_SLOTS / 32)
+#endif
+
+#if (CH_CFG_USE_VT_SLACK == TRUE) && (CH_CFG_USE_VT_WHEEL == TRUE)
+#error "CH_CFG_USE_VT_SLACK is not compatible with CH_CFG_USE_VT_WHEEL"
+#endif
+
+#if CH_CFG_REGISTRY_ID_SLOTS > 0
+#if CH_CFG_USE_REGISTRY == FALSE
+#error "CH_CFG_REGISTRY_ID_SLOTS requires CH_CFG_USE_REGISTRY"
+#endif
+
+#if (CH_CFG_REGISTRY_ID_SLOTS < 8) || (CH_CFG_REGISTRY_ID_SLOTS > 1024) ||  \
+    ((CH_CFG_REGISTRY_ID_SLOTS & (CH_CFG_REGISTRY_ID_SLOTS - 1)) != 0)
+#error "invalid CH_CFG_REGISTRY_ID_SLOTS value"
+#endif
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -72,6 +323,30 @@ typedef struct ch_virtual_timer {
                                                 pointer.                    */
   void                  *par;       /**< @brief Timer callback function
                                                 parameter.                  */
+#if (CH_CFG_USE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timer expiration time.
+   * @note    When the timers wheel is in use the @p delta field of the
+   *          list element contains the interval still to be waited after
+   *          this time, it is only non-zero for very long delays.
+   */
+  systime_t             deadline;
+#endif
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Deferred callbacks queue element.
+   * @note    The @p next field is @p NULL when no callback is pending.
+   */
+  ch_queue_t            dqueue;
+  /**
+   * @brief   Deferred callback function pointer.
+   */
+  vtfunc_t              dfunc;
+  /**
+   * @brief   Deferred callback function parameter.
+   */
+  void                  *dpar;
+#endif
 } virtual_timer_t;
 
 /**
@@ -81,7 +356,29 @@ typedef struct ch_virtual_timer {
  *          timer is often used in the code.
  */
 typedef struct ch_virtual_timers_list {
+#if (CH_CFG_USE_VT_WHEEL == FALSE) || defined(__DOXYGEN__)
   delta_list_t          dlist;      /**< @brief Delta list header.          */
+#endif
+#if (CH_CFG_USE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Wheel slots, timers are hashed by expiration time.
+   */
+  delta_list_t          slots[CH_CFG_VT_WHEEL_SLOTS];
+  /**
+   * @brief   Non-empty slots bitmap.
+   */
+  uint32_t              slotmap[CH_VT_WHEEL_MAP_WORDS];
+  /**
+   * @brief   Number of armed timers.
+   */
+  ucnt_t                armed;
+#if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Currently programmed alarm time.
+   */
+  systime_t             alarm;
+#endif
+#endif
 #if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
   volatile systime_t    systime;    /**< @brief System Time counter.        */
 #endif
@@ -93,7 +390,26 @@ typedef struct ch_virtual_timers_list {
                                                 tick event.                 */
 #endif
 #if (CH_CFG_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
-  volatile uint64_t     laststamp;  /**< @brief Last generated time stamp.  */
+  /**
+   * @brief   Time stamps publication counter.
+   * @details The last generated time stamp is in
+   *          <tt>stamps[stampseq & 1]</tt>.
+   */
+  volatile ucnt_t       stampseq;
+  /**
+   * @brief   Last generated time stamps.
+   */
+  volatile uint64_t     stamps[2];
+#endif
+#if (CH_CFG_USE_VT_SLACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Number of timers armed with a slack.
+   */
+  ucnt_t                slackarms;
+  /**
+   * @brief   Number of timers aligned to an already armed deadline.
+   */
+  ucnt_t                coalesced;
 #endif
 } virtual_timers_list_t;
 
@@ -109,6 +425,179 @@ typedef struct ch_threads_queue {
   ch_queue_t            queue;      /**< @brief Threads queue header.       */
 } threads_queue_t;
 
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of the deadline scheduling statistics of a thread.
+ */
+typedef struct {
+  /**
+   * @brief   Number of completed jobs.
+   */
+  ucnt_t                jobs;
+  /**
+   * @brief   Number of jobs completed after their deadline.
+   */
+  ucnt_t                misses;
+  /**
+   * @brief   Worst completion time after a deadline.
+   */
+  sysinterval_t         maxlateness;
+} edf_stats_t;
+
+/**
+ * @brief   Type of the deadline scheduling parameters of a thread.
+ */
+typedef struct {
+  /**
+   * @brief   Relative deadline, zero if the thread is not in the class.
+   */
+  sysinterval_t         rdeadline;
+  /**
+   * @brief   Jobs release period.
+   */
+  sysinterval_t         period;
+  /**
+   * @brief   Release time of the current job.
+   */
+  systime_t             release;
+  /**
+   * @brief   Absolute deadline of the current job.
+   */
+  systime_t             deadline;
+  /**
+   * @brief   Priority of the thread before joining the class.
+   */
+  tprio_t               prevprio;
+  /**
+   * @brief   Deadline statistics.
+   */
+  edf_stats_t           stats;
+} thread_edf_t;
+#endif
+
+#if (CH_CFG_USE_PERIODIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of the periodic release statistics of a thread.
+ */
+typedef struct {
+  /**
+   * @brief   Number of releases.
+   */
+  ucnt_t                releases;
+  /**
+   * @brief   Number of jobs completed after the next release time.
+   */
+  ucnt_t                overruns;
+  /**
+   * @brief   Number of releases dropped by the skip policy.
+   */
+  ucnt_t                skipped;
+  /**
+   * @brief   Worst delay between a release time and the thread wakeup.
+   */
+  sysinterval_t         maxjitter;
+} periodic_stats_t;
+
+/**
+ * @brief   Type of the periodic release parameters of a thread.
+ */
+typedef struct {
+  /**
+   * @brief   Release period, zero if the thread is not periodic.
+   */
+  sysinterval_t         period;
+  /**
+   * @brief   Release time of the current job.
+   */
+  systime_t             release;
+  /**
+   * @brief   Overrun policy.
+   */
+  uint8_t               policy;
+#if ((CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)) ||    \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Thread CPU time at the start of the current job.
+   */
+  rttime_t              jobstart;
+  /**
+   * @brief   Measurement receiving the execution time of each job or
+   *          @p NULL.
+   */
+  named_measurement_t   *exectm;
+#endif
+  /**
+   * @brief   Release statistics.
+   */
+  periodic_stats_t      stats;
+} thread_periodic_t;
+#endif
+
+#if (CH_CFG_USE_TASKS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a run-to-completion task.
+ */
+typedef struct ch_task task_t;
+
+/**
+ * @brief   Type of a task function.
+ * @note    Task functions must return without blocking.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ * @param[in] events    events accumulated since the previous run
+ */
+typedef void (*taskfunc_t)(task_t *tkp, eventmask_t events);
+
+/**
+ * @brief   Type of a tasks priority level.
+ */
+typedef struct ch_task_level {
+  /**
+   * @brief   Ready tasks FIFO queue.
+   */
+  ch_queue_t            ready;
+  /**
+   * @brief   Runner thread waiting for tasks.
+   */
+  thread_reference_t    thread;
+  /**
+   * @brief   Runner thread.
+   */
+  thread_t              *runner;
+  /**
+   * @brief   Task being run or @p NULL.
+   */
+  task_t                *current;
+} task_level_t;
+
+/**
+ * @brief   Structure representing a run-to-completion task.
+ */
+struct ch_task {
+  /**
+   * @brief   Ready queue element.
+   * @note    The @p next field is @p NULL when the task is not ready.
+   */
+  ch_queue_t            link;
+  /**
+   * @brief   Priority level of the task.
+   */
+  task_level_t          *level;
+  /**
+   * @brief   Task function.
+   */
+  taskfunc_t            func;
+  /**
+   * @brief   Task function argument.
+   */
+  void                  *arg;
+  /**
+   * @brief   Pending events.
+   */
+  eventmask_t           events;
+};
+#endif
+
 /**
  * @brief   Structure representing a thread.
  * @note    Not all the listed fields are always needed, by switching off some
@@ -124,19 +613,38 @@ struct ch_thread {
   } hdr;
 #if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
   thread_t              *newer;     /**< @brief Newer registry element.     */
+#if (CH_CFG_COMPACT_OBJECTS == FALSE) || defined(__DOXYGEN__)
   thread_t              *older;     /**< @brief Older registry element.     */
+#else
+  /* The owner takes the place of the missing older link, the ports rely
+     on the context offset.*/
+  os_instance_t         *owner;
+#endif
 #endif
   /* End of the fields shared with the ReadyList structure. */
   /**
    * @brief   Processor context.
    */
   struct port_context   ctx;
+#if (CH_CFG_USE_REGISTRY == FALSE) || (CH_CFG_COMPACT_OBJECTS == FALSE) ||  \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   OS instance owner of this thread.
+   */
+  os_instance_t         *owner;
+#endif
 #if (CH_CFG_USE_REGISTRY == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Thread name or @p NULL.
    */
   const char            *name;
 #endif
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Thread ID or zero if the IDs table was full.
+   */
+  ucnt_t                id;
+#endif
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE) ||  \
     defined(__DOXYGEN__)
   /**
@@ -145,6 +653,12 @@ struct ch_thread {
    *          dynamic threading.
    */
   stkalign_t            *wabase;
+#endif
+#if (CH_DBG_STACK_WATERMARK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Minimum free stack space observed.
+   */
+  size_t                wmargin;
 #endif
   /**
    * @brief   Current thread state.
@@ -246,6 +760,16 @@ struct ch_thread {
    */
   ch_list_t             waiting;
 #endif
+#if ((CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                   \
+     ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_WAKEUP) != 0U)) ||             \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Object the thread is waiting on, for wakeup records.
+   * @note    The @p u.wtobjp field is overwritten by the wakeup message
+   *          before the thread is made ready on some paths.
+   */
+  void                  *wkobjp;
+#endif
 #if (CH_CFG_USE_MESSAGES == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Messages queue.
@@ -269,6 +793,58 @@ struct ch_thread {
    */
   tprio_t               realprio;
 #endif
+#if (CH_CFG_USE_PREEMPT_THRESHOLD == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Preemption threshold.
+   * @note    Thresholds not above the thread priority have no effect.
+   */
+  tprio_t               threshold;
+  /**
+   * @brief   Priority to be restored when the thread resumes.
+   * @details A thread preempted while its threshold is in effect waits in
+   *          the ready list at the threshold priority, this field is
+   *          @p NOPRIO when the thread is not queued that way.
+   */
+  tprio_t               preprio;
+#endif
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Deadline scheduling class parameters.
+   */
+  thread_edf_t          edf;
+#endif
+#if (CH_CFG_USE_PERIODIC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Periodic release parameters.
+   */
+  thread_periodic_t     periodic;
+#endif
+#if (CH_CFG_USE_RESERVATIONS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Reservation the thread belongs to or @p NULL.
+   */
+  struct ch_reservation *reservation;
+  /**
+   * @brief   Reservation threads list element.
+   */
+  ch_queue_t            resqueue;
+  /**
+   * @brief   Priority before throttling or @p NOPRIO.
+   */
+  tprio_t               resprio;
+#endif
+#if (CH_CFG_USE_TLS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Thread pointer, base of the thread TLS block.
+   */
+  void                  *tlsp;
+#if (CH_CFG_USE_NEWLIB_REENT == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Thread newlib reentrancy structure.
+   */
+  struct _reent         *reent;
+#endif
+#endif
 #if ((CH_CFG_USE_DYNAMIC == TRUE) && (CH_CFG_USE_MEMPOOLS == TRUE)) ||      \
     defined(__DOXYGEN__)
   /**
@@ -281,6 +857,12 @@ struct ch_thread {
    * @brief   Thread statistics.
    */
   time_measurement_t    stats;
+#if (CH_DBG_LATENCY_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Thread ready-to-run latency statistics.
+   */
+  latency_stats_t       latency;
+#endif
 #endif
 #if defined(CH_CFG_THREAD_EXTRA_FIELDS)
   /* Extra fields defined in chconf.h.*/
@@ -306,6 +888,8 @@ typedef struct ch_ready_list {
   thread_t              *newer;
   /**
    *  @brief    Older registry element.
+   *  @note     With @p CH_CFG_COMPACT_OBJECTS threads have no backward
+   *            link, this field still points to the newest thread.
    */
   thread_t              *older;
 #endif
@@ -314,6 +898,26 @@ typedef struct ch_ready_list {
    * @brief     The currently running thread.
    */
   thread_t              *current;
+#if (CH_CFG_USE_BITMAP_READYLIST == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief     Summary bitmap, a bit is set for each non-empty word of
+   *            @p prmap.
+   */
+  uint32_t              prsummary;
+  /**
+   * @brief     Priorities bitmap, a bit is set for each priority level
+   *            having threads in the ready list.
+   * @note      The bit of priority zero is always set, it represents the
+   *            list header itself.
+   */
+  uint32_t              prmap[CH_RLIST_MAP_WORDS];
+  /**
+   * @brief     First element of each priority level in the ready list.
+   * @note      Elements are only valid if the corresponding bit is set in
+   *            @p prmap.
+   */
+  ch_priority_queue_t   *prheads[CH_RLIST_PRIO_LEVELS];
+#endif
 } ready_list_t;
 
 /**
@@ -345,8 +949,43 @@ typedef struct ch_os_instance_config {
    */
   stkalign_t            *idlethread_end;
 #endif
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Lower limit of the deferred timers thread stack.
+   */
+  stkalign_t            *vtthread_base;
+  /**
+   * @brief   Upper limit of the deferred timers thread stack.
+   */
+  stkalign_t            *vtthread_end;
+#endif
 } os_instance_config_t;
 
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a low power state descriptor.
+ * @note    Latencies are expressed in system ticks and include the time
+ *          required for stopping and restarting clocks and peripherals.
+ */
+typedef struct {
+  /**
+   * @brief   Time required for entering the state.
+   */
+  sysinterval_t         entry_latency;
+  /**
+   * @brief   Time required for resuming execution after the wakeup event.
+   */
+  sysinterval_t         exit_latency;
+  /**
+   * @brief   Function entering the state.
+   * @note    The function is invoked with the kernel unlocked and must
+   *          return after the wakeup, the system alarm must be able to wake
+   *          up the system from the state.
+   */
+  void                  (*enter)(void);
+} idle_state_t;
+#endif
+
 /**
  * @brief   System instance data structure.
  */
@@ -359,6 +998,26 @@ struct ch_os_instance {
    * @brief   Virtual timers delta list header.
    */
   virtual_timers_list_t vtlist;
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Registered threads indexed by ID.
+   */
+  thread_t              *regids[CH_CFG_REGISTRY_ID_SLOTS];
+  /**
+   * @brief   Sequence number of the next ID.
+   */
+  ucnt_t                regseq;
+#endif
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Expired deferred timers waiting for their callbacks.
+   */
+  ch_queue_t            vtdeferred;
+  /**
+   * @brief   Deferred timers thread, if waiting.
+   */
+  thread_reference_t    vtthread;
+#endif
   /**
    * @brief   Main thread descriptor.
    */
@@ -379,12 +1038,36 @@ struct ch_os_instance {
    */
   tm_calibration_t      tmc;
 #endif
+#if ((CH_CFG_USE_TM == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)) ||        \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Named measurements registry.
+   */
+  named_measurement_t   *tmlist;
+#endif
+#if ((CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE)) ||         \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Profiled objects list.
+   */
+  wait_profile_t        *wplist;
+#endif
 #if (CH_DBG_STATISTICS == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Global kernel statistics.
    */
   kernel_stats_t        kernel_stats;
 #endif
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Low power states ordered by increasing depth.
+   */
+  const idle_state_t    *idle_states;
+  /**
+   * @brief   Number of low power states.
+   */
+  unsigned              idle_nstates;
+#endif
 #if defined(PORT_INSTANCE_EXTRA_FIELDS) || defined(__DOXYGEN__)
   /* Extra fields from port layer.*/
   PORT_INSTANCE_EXTRA_FIELDS
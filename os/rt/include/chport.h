@@ -137,6 +137,10 @@
 #define PORT_INSTANCE_ACCESS                (&ch)
 #endif
 
+#if !defined(CC_FAST_CODE)
+#define CC_FAST_CODE
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
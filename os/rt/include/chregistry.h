@@ -70,34 +70,115 @@ typedef struct {
   uint8_t   off_time;               /**< @brief Offset of @p time field.    */
 } chdebug_t;
 
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a thread information record.
+ */
+typedef struct {
+  /**
+   * @brief   Thread ID.
+   */
+  ucnt_t                    id;
+  /**
+   * @brief   Thread name or @p NULL.
+   */
+  const char                *name;
+  /**
+   * @brief   Thread priority.
+   */
+  tprio_t                   prio;
+  /**
+   * @brief   Thread state.
+   */
+  tstate_t                  state;
+  /**
+   * @brief   Thread flags.
+   */
+  tmode_t                   flags;
+#if (CH_DBG_STACK_WATERMARK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Minimum free stack space observed.
+   */
+  size_t                    wmargin;
+#endif
+#if (CH_DBG_THREADS_PROFILING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Thread consumed time in ticks.
+   */
+  systime_t                 time;
+#endif
+} reg_thread_info_t;
+#endif
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+#if (CH_CFG_COMPACT_OBJECTS == FALSE) || defined(__DOXYGEN__)
 /**
- * @brief   Removes a thread from the registry list.
+ * @brief   Unlinks a thread from the registry list.
  * @note    This macro is not meant for use in application code.
  *
- * @param[in] tp        thread to remove from the registry
+ * @param[in] tp        thread to unlink from the registry
  */
-#define REG_REMOVE(tp) do {                                                 \
+#define __REG_UNLINK(tp) do {                                               \
   (tp)->older->newer = (tp)->newer;                                         \
   (tp)->newer->older = (tp)->older;                                         \
 } while (false)
 
 /**
- * @brief   Adds a thread to the registry list.
+ * @brief   Links a thread to the registry list.
  * @note    This macro is not meant for use in application code.
  *
  * @param[in] oip       pointer to the OS instance
- * @param[in] tp        thread to add to the registry
+ * @param[in] tp        thread to link to the registry
  */
-#define REG_INSERT(oip, tp) do {                                            \
+#define __REG_LINK(oip, tp) do {                                            \
   (tp)->newer = (thread_t *)&(oip)->rlist;                                  \
   (tp)->older = (oip)->rlist.older;                                         \
   (tp)->older->newer = (tp);                                                \
   (oip)->rlist.older = (tp);                                                \
 } while (false)
+#else
+#define __REG_UNLINK(tp) __reg_unlink(tp)
+
+#define __REG_LINK(oip, tp) do {                                            \
+  (tp)->newer = (thread_t *)&(oip)->rlist;                                  \
+  (oip)->rlist.older->newer = (tp);                                         \
+  (oip)->rlist.older = (tp);                                                \
+} while (false)
+#endif
+
+/**
+ * @brief   Removes a thread from the registry list.
+ * @note    This macro is not meant for use in application code.
+ *
+ * @param[in] tp        thread to remove from the registry
+ */
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+#define REG_REMOVE(tp) do {                                                 \
+  __REG_UNLINK(tp);                                                         \
+  __reg_id_release(tp);                                                     \
+} while (false)
+#else
+#define REG_REMOVE(tp) __REG_UNLINK(tp)
+#endif
+
+/**
+ * @brief   Adds a thread to the registry list.
+ * @note    This macro is not meant for use in application code.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        thread to add to the registry
+ */
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+#define REG_INSERT(oip, tp) do {                                            \
+  __REG_LINK(oip, tp);                                                      \
+  __reg_id_assign(oip, tp);                                                 \
+} while (false)
+#else
+#define REG_INSERT(oip, tp) __REG_LINK(oip, tp)
+#endif
 
 /*===========================================================================*/
 /* External declarations.                                                    */
@@ -112,6 +193,16 @@ extern "C" {
   thread_t *chRegFindThreadByName(const char *name);
   thread_t *chRegFindThreadByPointer(thread_t *tp);
   thread_t *chRegFindThreadByWorkingArea(stkalign_t *wa);
+#if CH_CFG_COMPACT_OBJECTS == TRUE
+  void __reg_unlink(thread_t *tp);
+#endif
+#if CH_CFG_REGISTRY_ID_SLOTS > 0
+  void __reg_id_init(os_instance_t *oip);
+  void __reg_id_assign(os_instance_t *oip, thread_t *tp);
+  void __reg_id_release(thread_t *tp);
+  thread_t *chRegFindThreadById(ucnt_t id);
+  bool chRegGetThreadInfo(ucnt_t *cursorp, reg_thread_info_t *rip);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -181,6 +272,23 @@ static inline void chRegSetThreadNameX(thread_t *tp, const char *name) {
 #endif
 }
 
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the ID of the specified thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The thread ID.
+ * @retval 0            if the IDs table was full when the thread has been
+ *                      created.
+ *
+ * @xclass
+ */
+static inline ucnt_t chRegGetThreadIdX(thread_t *tp) {
+
+  return tp->id;
+}
+#endif
+
 #endif /* CHREGISTRY_H */
 
 /** @} */
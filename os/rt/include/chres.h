@@ -0,0 +1,178 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    rt/include/chres.h
+ * @brief   CPU budget reservations macros and structures.
+ *
+ * @addtogroup reservations
+ * @{
+ */
+
+#ifndef CHRES_H
+#define CHRES_H
+
+#if (CH_CFG_USE_RESERVATIONS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of the statistics of a reservation.
+ */
+typedef struct {
+  /**
+   * @brief   Number of budget exhaustions.
+   */
+  ucnt_t                throttles;
+  /**
+   * @brief   Highest CPU time used in a period.
+   */
+  sysinterval_t         maxused;
+} res_stats_t;
+
+/**
+ * @brief   Type of a CPU budget reservation.
+ */
+typedef struct ch_reservation {
+  /**
+   * @brief   Threads belonging to the reservation.
+   */
+  ch_queue_t            threads;
+  /**
+   * @brief   CPU time budget for each period.
+   */
+  sysinterval_t         budget;
+  /**
+   * @brief   Replenishment period.
+   */
+  sysinterval_t         period;
+  /**
+   * @brief   Budget left in the current period.
+   */
+  sysinterval_t         remaining;
+  /**
+   * @brief   CPU time used in the current period.
+   */
+  sysinterval_t         used;
+  /**
+   * @brief   Start of the not yet accounted execution.
+   */
+  systime_t             last;
+  /**
+   * @brief   The budget is exhausted and the threads are throttled.
+   */
+  bool                  throttled;
+  /**
+   * @brief   Replenishment timer.
+   */
+  virtual_timer_t       rvt;
+  /**
+   * @brief   Budget enforcement timer.
+   */
+  virtual_timer_t       evt;
+  /**
+   * @brief   Reservation statistics.
+   */
+  res_stats_t           stats;
+} reservation_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Context switch accounting.
+ * @note    Only switches involving threads belonging to reservations
+ *          are accounted.
+ *
+ * @param[in] ntp       the thread to be switched in
+ * @param[in] otp       the thread to be switched out
+ *
+ * @notapi
+ */
+#define __res_switch(ntp, otp) {                                            \
+  if (((ntp)->reservation != NULL) || ((otp)->reservation != NULL)) {       \
+    __res_account(ntp, otp);                                                \
+  }                                                                         \
+}
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chResObjectInit(reservation_t *rsp,
+                       sysinterval_t budget,
+                       sysinterval_t period);
+  void chResStart(reservation_t *rsp);
+  void chResStop(reservation_t *rsp);
+  void chResJoin(reservation_t *rsp);
+  void chResLeave(void);
+  void chResGetStats(reservation_t *rsp, res_stats_t *rssp);
+  void __res_account(thread_t *ntp, thread_t *otp);
+  void __res_leave(thread_t *tp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns @p true if the reservation budget is exhausted.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ * @return              The throttling state.
+ *
+ * @iclass
+ */
+static inline bool chResIsThrottledI(reservation_t *rsp) {
+
+  chDbgCheckClassI();
+
+  return rsp->throttled;
+}
+
+#else /* CH_CFG_USE_RESERVATIONS == FALSE */
+
+/* No accounting.*/
+#define __res_switch(ntp, otp)
+
+#endif /* CH_CFG_USE_RESERVATIONS == FALSE */
+
+#endif /* CHRES_H */
+
+/** @} */
@@ -0,0 +1,151 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    rt/include/chrwlock.h
+ * @brief   Reader-Writer Locks macros and structures.
+ *
+ * @addtogroup rwlocks
+ * @{
+ */
+
+#ifndef CHRWLOCK_H
+#define CHRWLOCK_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Reader-Writer Locks APIs.
+ * @details If enabled then the reader-writer locks APIs are included in the
+ *          kernel.
+ */
+#if !defined(CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+#define CH_CFG_USE_RWLOCKS                  FALSE
+#endif
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_MUTEXES == FALSE
+#error "CH_CFG_USE_RWLOCKS requires CH_CFG_USE_MUTEXES"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a reader-writer lock structure.
+ */
+typedef struct ch_rwlock {
+  mutex_t               wmtx;               /**< @brief Writers mutex, owned
+                                                 by the active writer or by
+                                                 the writer waiting for the
+                                                 readers to leave.          */
+  threads_queue_t       qr;                 /**< @brief Queue of the waiting
+                                                 readers.                   */
+  threads_queue_t       qw;                 /**< @brief Queue of the writer
+                                                 waiting for the readers to
+                                                 leave.                     */
+  cnt_t                 readers;            /**< @brief Number of active
+                                                 readers.                   */
+} rwlock_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Data part of a static reader-writer lock initializer.
+ * @details This macro should be used when statically initializing a
+ *          reader-writer lock that is part of a bigger structure.
+ *
+ * @param[in] name      the name of the reader-writer lock variable
+ */
+#define __RWLOCK_DATA(name) {__MUTEX_DATA(name.wmtx),                       \
+                             __THREADS_QUEUE_DATA(name.qr),                 \
+                             __THREADS_QUEUE_DATA(name.qw),                 \
+                             (cnt_t)0}
+
+/**
+ * @brief   Static reader-writer lock initializer.
+ * @details Statically initialized reader-writer locks require no explicit
+ *          initialization using @p chRWLockObjectInit().
+ *
+ * @param[in] name      the name of the reader-writer lock variable
+ */
+#define RWLOCK_DECL(name) rwlock_t name = __RWLOCK_DATA(name)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void chRWLockObjectInit(rwlock_t *rwp);
+  void chRWLockReadLock(rwlock_t *rwp);
+  void chRWLockReadLockS(rwlock_t *rwp);
+  bool chRWLockTryRead(rwlock_t *rwp);
+  bool chRWLockTryReadS(rwlock_t *rwp);
+  void chRWLockReadUnlock(rwlock_t *rwp);
+  void chRWLockReadUnlockS(rwlock_t *rwp);
+  void chRWLockWriteLock(rwlock_t *rwp);
+  void chRWLockWriteLockS(rwlock_t *rwp);
+  bool chRWLockTryWrite(rwlock_t *rwp);
+  bool chRWLockTryWriteS(rwlock_t *rwp);
+  void chRWLockWriteUnlock(rwlock_t *rwp);
+  void chRWLockWriteUnlockS(rwlock_t *rwp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of active readers.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ * @return              The number of threads holding the lock for reading.
+ *
+ * @iclass
+ */
+static inline cnt_t chRWLockGetReadersI(rwlock_t *rwp) {
+
+  chDbgCheckClassI();
+
+  return rwp->readers;
+}
+
+#endif /* CH_CFG_USE_RWLOCKS == TRUE */
+
+#endif /* CHRWLOCK_H */
+
+/** @} */
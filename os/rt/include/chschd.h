@@ -104,6 +104,13 @@
                                                  from a Memory Pool.        */
 #define CH_FLAG_TERMINATE   (tmode_t)4U     /**< @brief Termination requested
                                                  flag.                      */
+#define CH_FLAG_COND_WAIT   (tmode_t)8U     /**< @brief Waiting on a condition
+                                                 variable, can be moved on
+                                                 the mutex queue.           */
+#define CH_FLAG_COND_RESET  (tmode_t)16U    /**< @brief Moved on the mutex
+                                                 queue by a broadcast.      */
+#define CH_FLAG_TASK_RUN    (tmode_t)32U    /**< @brief Running a
+                                                 run-to-completion task.    */
 /** @} */
 
 /*===========================================================================*/
@@ -122,6 +129,26 @@
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @name    Waits on kernel objects
+ * @details The waits are measured when @p CH_DBG_WAIT_PROFILING is enabled,
+ *          else they are plain sleeps.
+ * @{
+ */
+#if ((CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE)) ||         \
+    defined(__DOXYGEN__)
+#define __sch_wait_s(newstate, objp)                                        \
+  (void) __tm_wait_s(newstate, TIME_INFINITE, objp)
+#define __sch_wait_timeout_s(newstate, timeout, objp)                       \
+  __tm_wait_s(newstate, timeout, objp)
+#else
+#define __sch_wait_s(newstate, objp)                                        \
+  chSchGoSleepS(newstate)
+#define __sch_wait_timeout_s(newstate, timeout, objp)                       \
+  chSchGoSleepTimeoutS(newstate, timeout)
+#endif
+/** @} */
+
 /**
  * @brief   Returns the priority of the first thread on the given ready list.
  *
@@ -154,7 +181,13 @@ extern "C" {
   void chSchObjectInit(os_instance_t *oip,
                        const os_instance_config_t *oicp);
   thread_t *chSchReadyI(thread_t *tp);
+  thread_t *chSchBatchAddI(ch_priority_queue_t *bqp, thread_t *tp);
+  void chSchBatchReadyI(ch_priority_queue_t *bqp);
+#if CH_CFG_USE_IDLE_GOVERNOR == TRUE
+  void chSchSetIdleStates(const idle_state_t *states, unsigned n);
+#endif
   void chSchGoSleepS(tstate_t newstate);
+  void chSchGoSleepSwitchS(tstate_t newstate, thread_t *ntp);
   msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout);
   void chSchWakeupS(thread_t *ntp, msg_t msg);
   void chSchRescheduleS(void);
@@ -163,9 +196,20 @@ extern "C" {
   void chSchPreemption(void);
   void chSchDoYieldS(void);
   thread_t *chSchSelectFirstI(void);
+  thread_t *__sch_ready_remove(os_instance_t *oip, thread_t *tp, tprio_t prio);
 #if CH_CFG_OPTIMIZE_SPEED == FALSE
   void ch_sch_prio_insert(ch_queue_t *tp, ch_queue_t *qp);
 #endif /* CH_CFG_OPTIMIZE_SPEED == FALSE */
+#if CH_CFG_USE_TASKS == TRUE
+  thread_t *chTaskLevelCreateStatic(task_level_t *tlp, void *wsp,
+                                    size_t size, tprio_t prio);
+  void chTaskLevelStop(task_level_t *tlp);
+  void chTaskObjectInit(task_t *tkp, task_level_t *tlp,
+                        taskfunc_t func, void *arg);
+  void chTaskActivateI(task_t *tkp, eventmask_t events);
+  void chTaskActivate(task_t *tkp, eventmask_t events);
+  void chTaskCancelI(task_t *tkp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -179,18 +223,61 @@ extern "C" {
 #if CH_CFG_OPTIMIZE_SPEED == TRUE
 static inline void ch_sch_prio_insert(ch_queue_t *tp, ch_queue_t *qp) {
 
-  ch_queue_t *cp = qp;
-  do {
-    cp = cp->next;
-  } while ((cp != qp) &&
-           (((thread_t *)cp)->hdr.pqueue.prio >= ((thread_t *)tp)->hdr.pqueue.prio));
-  tp->next       = cp;
-  tp->prev       = cp->prev;
-  tp->prev->next = tp;
-  cp->prev       = tp;
+  tprio_t prio = ((thread_t *)tp)->hdr.pqueue.prio;
+  ch_queue_t *cp = qp->prev;
+
+  /* If the first element has lower priority then all elements have lower
+     priority and the thread goes first, else the list is scanned from the
+     tail, threads waiting on the same object are expected to have mostly
+     equal priorities so the scan is usually short.*/
+  if ((qp->next != qp) &&
+      (((thread_t *)qp->next)->hdr.pqueue.prio < prio)) {
+    cp = qp;
+  }
+  else {
+    while ((cp != qp) && (((thread_t *)cp)->hdr.pqueue.prio < prio)) {
+      cp = cp->prev;
+    }
+  }
+
+  /* Insertion on next.*/
+  tp->prev       = cp;
+  tp->next       = cp->next;
+  tp->next->prev = tp;
+  cp->next       = tp;
 }
 #endif /* CH_CFG_OPTIMIZE_SPEED == TRUE */
 
+#if (CH_CFG_USE_TASKS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the argument of a task.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ * @return              The task function argument.
+ *
+ * @xclass
+ */
+static inline void *chTaskGetArgX(task_t *tkp) {
+
+  return tkp->arg;
+}
+
+/**
+ * @brief   Checks if a task is ready to run.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ * @return              The task state.
+ *
+ * @iclass
+ */
+static inline bool chTaskIsReadyI(task_t *tkp) {
+
+  chDbgCheckClassI();
+
+  return tkp->link.next != NULL;
+}
+#endif /* CH_CFG_USE_TASKS == TRUE */
+
 #endif /* CHSCHD_H */
 
 /** @} */
@@ -38,18 +38,125 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
-#if CH_CFG_USE_TM == FALSE
-#error "CH_DBG_STATISTICS requires CH_CFG_USE_TM"
+/**
+ * @brief   Ready-to-run latency histograms.
+ * @details If enabled then each thread keeps an histogram of the time spent
+ *          in the ready list before running, measured using the realtime
+ *          counter.
+ */
+#if !defined(CH_DBG_LATENCY_HISTOGRAMS) || defined(__DOXYGEN__)
+#define CH_DBG_LATENCY_HISTOGRAMS           FALSE
+#endif
+
+/**
+ * @brief   Number of buckets in latency histograms.
+ * @details Each bucket counts latencies up to twice the limit of the
+ *          previous one, the last bucket counts all larger latencies.
+ */
+#if !defined(CH_DBG_LATENCY_BUCKETS) || defined(__DOXYGEN__)
+#define CH_DBG_LATENCY_BUCKETS              8
+#endif
+
+/**
+ * @brief   Resolution of latency histograms.
+ * @details The first bucket counts latencies below
+ *          <tt>2^CH_DBG_LATENCY_RESOLUTION</tt> realtime counter cycles.
+ */
+#if !defined(CH_DBG_LATENCY_RESOLUTION) || defined(__DOXYGEN__)
+#define CH_DBG_LATENCY_RESOLUTION           6
+#endif
+
+/**
+ * @brief   Number of recorded critical zones offenders.
+ * @details If different from zero then the longest threads critical zones
+ *          are recorded together with the thread and the return address
+ *          of the function that entered the zone.
+ */
+#if !defined(CH_DBG_CRIT_OFFENDERS) || defined(__DOXYGEN__)
+#define CH_DBG_CRIT_OFFENDERS               0
+#endif
+
+/**
+ * @brief   Critical zones duration threshold.
+ * @details If different from zero then threads critical zones longer than
+ *          this number of realtime counter cycles invoke the
+ *          @p CH_CFG_CRIT_THRESHOLD_HOOK hook and, if user trace records are
+ *          enabled, write an user record with the caller address as first
+ *          parameter and the duration as second parameter.
+ */
+#if !defined(CH_DBG_CRIT_THRESHOLD) || defined(__DOXYGEN__)
+#define CH_DBG_CRIT_THRESHOLD               0
+#endif
+
+/**
+ * @brief   Critical zone threshold hook.
+ * @details This hook is invoked, still inside the critical zone, when a
+ *          threads critical zone exceeds @p CH_DBG_CRIT_THRESHOLD.
+ * @note    Kernel APIs cannot be invoked from this hook.
+ */
+#if !defined(CH_CFG_CRIT_THRESHOLD_HOOK) || defined(__DOXYGEN__)
+#define CH_CFG_CRIT_THRESHOLD_HOOK(caller, duration) {                      \
+  (void)(caller);                                                           \
+  (void)(duration);                                                         \
+}
+#endif
+
+/**
+ * @brief   Returns the return address of the calling function.
+ * @note    The default implementation relies on a GCC builtin, it can be
+ *          redefined for other compilers.
+ */
+#if !defined(__stats_get_caller) || defined(__DOXYGEN__)
+#define __stats_get_caller()                __builtin_return_address(0)
 #endif
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if CH_CFG_USE_TM == FALSE
+#error "CH_DBG_STATISTICS requires CH_CFG_USE_TM"
+#endif
+
+#if (CH_DBG_LATENCY_BUCKETS < 2) || (CH_DBG_LATENCY_BUCKETS > 32)
+#error "invalid CH_DBG_LATENCY_BUCKETS value"
+#endif
+
+#if (CH_DBG_LATENCY_RESOLUTION < 0) || (CH_DBG_LATENCY_RESOLUTION > 24)
+#error "invalid CH_DBG_LATENCY_RESOLUTION value"
+#endif
+
+#if (CH_DBG_CRIT_OFFENDERS < 0) || (CH_DBG_CRIT_OFFENDERS > 32)
+#error "invalid CH_DBG_CRIT_OFFENDERS value"
+#endif
+
+#if CH_DBG_CRIT_THRESHOLD < 0
+#error "invalid CH_DBG_CRIT_THRESHOLD value"
+#endif
+
+/**
+ * @brief   Critical zones attribution enabled.
+ */
+#define CH_STATS_CRIT_ATTRIBUTION                                           \
+  ((CH_DBG_CRIT_OFFENDERS > 0) || (CH_DBG_CRIT_THRESHOLD > 0))
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
 
+#if (CH_DBG_CRIT_OFFENDERS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a critical zone offender record.
+ */
+typedef struct {
+  rtcnt_t               duration;   /**< @brief Critical zone duration.     */
+  void                  *caller;    /**< @brief Return address of the
+                                                function entering the
+                                                zone.                       */
+  thread_t              *tp;        /**< @brief Thread entering the zone.   */
+} crit_offender_t;
+#endif
+
 /**
  * @brief   Type of a kernel statistics structure.
  */
@@ -60,8 +167,34 @@ typedef struct {
                                                 critical zones duration.    */
   time_measurement_t    m_crit_isr; /**< @brief Measurement of ISRs critical
                                                 zones duration.             */
+#if CH_STATS_CRIT_ATTRIBUTION || defined(__DOXYGEN__)
+  void                  *crit_caller; /**< @brief Caller of the current
+                                                threads critical zone.      */
+  thread_t              *crit_tp;   /**< @brief Thread of the current
+                                                threads critical zone.      */
+#endif
+#if (CH_DBG_CRIT_OFFENDERS > 0) || defined(__DOXYGEN__)
+  crit_offender_t       crit_offenders[CH_DBG_CRIT_OFFENDERS]; /**< @brief
+                                                Longest threads critical
+                                                zones, in decreasing
+                                                duration order.             */
+#endif
 } kernel_stats_t;
 
+#if (CH_DBG_LATENCY_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a thread latency statistics structure.
+ */
+typedef struct {
+  rtcnt_t               ready;      /**< @brief Time stamp of the last
+                                                insertion in the ready
+                                                list.                       */
+  rtcnt_t               worst;      /**< @brief Worst latency.              */
+  ucnt_t                hist[CH_DBG_LATENCY_BUCKETS]; /**< @brief Latency
+                                                histogram.                  */
+} latency_stats_t;
+#endif
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -76,10 +209,16 @@ extern "C" {
   void __stats_init(void);
   void __stats_increase_irq(void);
   void __stats_ctxswc(thread_t *ntp, thread_t *otp);
+#if CH_DBG_LATENCY_HISTOGRAMS == TRUE
+  void __stats_ready(thread_t *tp);
+#endif
   void __stats_start_measure_crit_thd(void);
   void __stats_stop_measure_crit_thd(void);
   void __stats_start_measure_crit_isr(void);
   void __stats_stop_measure_crit_isr(void);
+#if CH_DBG_CRIT_OFFENDERS > 0
+  void chStatsResetCritOffenders(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -102,13 +241,51 @@ static inline void __stats_object_init(kernel_stats_t *ksp) {
   ksp->n_ctxswc = (ucnt_t)0;
   chTMObjectInit(&ksp->m_crit_thd);
   chTMObjectInit(&ksp->m_crit_isr);
+#if CH_STATS_CRIT_ATTRIBUTION
+  ksp->crit_caller = NULL;
+  ksp->crit_tp     = NULL;
+#endif
+#if CH_DBG_CRIT_OFFENDERS > 0
+  {
+    unsigned i;
+
+    for (i = 0U; i < (unsigned)CH_DBG_CRIT_OFFENDERS; i++) {
+      ksp->crit_offenders[i].duration = (rtcnt_t)0;
+      ksp->crit_offenders[i].caller   = NULL;
+      ksp->crit_offenders[i].tp       = NULL;
+    }
+  }
+#endif
 }
 
+#if (CH_DBG_LATENCY_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Latency statistics initialization.
+ * @note    Internal use only.
+ *
+ * @param[out] lsp      pointer to the @p latency_stats_t structure
+ *
+ * @notapi
+ */
+static inline void __stats_latency_init(latency_stats_t *lsp) {
+  unsigned i;
+
+  lsp->ready = (rtcnt_t)0;
+  lsp->worst = (rtcnt_t)0;
+  for (i = 0U; i < (unsigned)CH_DBG_LATENCY_BUCKETS; i++) {
+    lsp->hist[i] = (ucnt_t)0;
+  }
+}
+#else
+#define __stats_ready(tp)
+#endif
+
 #else /* CH_DBG_STATISTICS == FALSE */
 
 /* Stub functions for when the statistics module is disabled. */
 #define __stats_increase_irq()
 #define __stats_ctxswc(old, new)
+#define __stats_ready(tp)
 #define __stats_start_measure_crit_thd()
 #define __stats_stop_measure_crit_thd()
 #define __stats_start_measure_crit_isr()
@@ -65,6 +65,45 @@
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+#if (CH_DBG_STACK_WATERMARK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Samples the stack pointer of a thread being switched out.
+ * @note    Without port support the address of a local variable is used
+ *          as stack pointer approximation.
+ *
+ * @param[in] otp       pointer to the current thread
+ *
+ * @notapi
+ */
+#if defined(port_get_thread_stack_pointer) || defined(__DOXYGEN__)
+#define __dbg_stack_watermark(otp)                                          \
+  __dbg_stack_sample(otp, (uintptr_t)port_get_thread_stack_pointer())
+#else
+#define __dbg_stack_watermark(otp) do {                                     \
+  uint8_t __local;                                                          \
+  __dbg_stack_sample(otp, &__local);                                        \
+} while (false)
+#endif
+
+/**
+ * @brief   Samples the stack pointer of the interrupted thread.
+ * @note    Only effective if the port provides
+ *          @p port_get_thread_stack_pointer().
+ *
+ * @notapi
+ */
+#if defined(port_get_thread_stack_pointer) || defined(__DOXYGEN__)
+#define __dbg_stack_watermark_isr()                                         \
+  __dbg_stack_sample(currcore->rlist.current,                               \
+                     (uintptr_t)port_get_thread_stack_pointer())
+#else
+#define __dbg_stack_watermark_isr()
+#endif
+#else /* CH_DBG_STACK_WATERMARK == FALSE */
+#define __dbg_stack_watermark(otp)
+#define __dbg_stack_watermark_isr()
+#endif /* CH_DBG_STACK_WATERMARK == FALSE */
+
 /**
  * @name    ISRs abstraction macros
  */
@@ -114,6 +153,7 @@
 #define CH_IRQ_PROLOGUE()                                                   \
   PORT_IRQ_PROLOGUE();                                                      \
   CH_CFG_IRQ_PROLOGUE_HOOK();                                               \
+  __dbg_stack_watermark_isr();                                              \
   __stats_increase_irq();                                                   \
   __trace_isr_enter(__func__);                                              \
   __dbg_check_enter_isr()
@@ -272,6 +312,9 @@
                                                                             \
   __trace_switch(ntp, otp);                                                 \
   __stats_ctxswc(ntp, otp);                                                 \
+  __dbg_stack_watermark(otp);                                               \
+  __res_switch(ntp, otp);                                                   \
+  __tls_switch(ntp);                                                        \
   CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp);                                     \
   port_switch(ntp, otp);                                                    \
 }
@@ -384,9 +427,16 @@ static inline void chSysUnlock(void) {
      in a critical section not followed by a chSchRescheduleS(), this means
      that the current thread has a lower priority than the next thread in
      the ready list.*/
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  chDbgAssert((currcore->rlist.pqueue.next == &currcore->rlist.pqueue) ||
+              (currcore->rlist.current->hdr.pqueue.prio >= currcore->rlist.pqueue.next->prio) ||
+              (currcore->rlist.current->threshold >= currcore->rlist.pqueue.next->prio),
+              "priority order violation");
+#else
   chDbgAssert((currcore->rlist.pqueue.next == &currcore->rlist.pqueue) ||
               (currcore->rlist.current->hdr.pqueue.prio >= currcore->rlist.pqueue.next->prio),
               "priority order violation");
+#endif
 
   port_unlock();
 }
@@ -34,6 +34,22 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @name    Periodic threads overrun policies
+ * @{
+ */
+/**
+ * @brief   Late releases are executed back to back until the thread
+ *          catches up with the release times.
+ */
+#define CH_PERIODIC_CATCHUP                 0U
+/**
+ * @brief   Late releases are dropped, the next job is released at the
+ *          first release time in the future.
+ */
+#define CH_PERIODIC_SKIP                    1U
+/** @} */
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -79,6 +95,23 @@ typedef struct {
    * @brief   Thread argument.
    */
   void              *arg;
+#if (CH_CFG_USE_PERIODIC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Release period, zero for a non periodic thread.
+   * @note    The first job is released when the thread is started.
+   */
+  sysinterval_t     period;
+  /**
+   * @brief   Overrun policy of a periodic thread.
+   */
+  uint8_t           policy;
+#endif
+#if (CH_CFG_USE_PREEMPT_THRESHOLD == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Preemption threshold, zero for no threshold.
+   */
+  tprio_t           threshold;
+#endif
 } thread_descriptor_t;
 
 /*===========================================================================*/
@@ -113,6 +146,7 @@ typedef struct {
  */
 /**
  * @brief   Calculates the total Working Area size.
+ * @note    The TLS area, if enabled, is included.
  *
  * @param[in] n         the stack size to be assigned to the thread
  * @return              The total used memory in bytes.
@@ -120,7 +154,8 @@ typedef struct {
  * @api
  */
 #define THD_WORKING_AREA_SIZE(n)                                            \
-  MEM_ALIGN_NEXT(sizeof(thread_t) + PORT_WA_SIZE(n), PORT_STACK_ALIGN)
+  MEM_ALIGN_NEXT(sizeof(thread_t) + CH_TLS_AREA_SIZE + PORT_WA_SIZE(n),     \
+                 PORT_STACK_ALIGN)
 
 /**
  * @brief   Static working area allocation.
@@ -244,6 +279,9 @@ extern "C" {
   msg_t chThdWait(thread_t *tp);
 #endif
   tprio_t chThdSetPriority(tprio_t newprio);
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  tprio_t chThdSetPreemptionThreshold(tprio_t threshold);
+#endif
   void chThdTerminate(thread_t *tp);
   msg_t chThdSuspendS(thread_reference_t *trp);
   msg_t chThdSuspendTimeoutS(thread_reference_t *trp, sysinterval_t timeout);
@@ -257,6 +295,20 @@ extern "C" {
   void chThdSleepUntil(systime_t time);
   systime_t chThdSleepUntilWindowed(systime_t prev, systime_t next);
   void chThdYield(void);
+#if CH_CFG_USE_EDF == TRUE
+  void chThdSetDeadline(sysinterval_t deadline, sysinterval_t period);
+  void chThdClearDeadline(void);
+  bool chThdWaitNextPeriod(void);
+  void chThdGetDeadlineStats(thread_t *tp, edf_stats_t *esp);
+#endif
+#if CH_CFG_USE_PERIODIC == TRUE
+  void chThdSetPeriodic(sysinterval_t period, uint8_t policy);
+  bool chThdWaitNextRelease(void);
+  void chThdGetPeriodicStats(thread_t *tp, periodic_stats_t *psp);
+#if (CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)
+  void chThdSetPeriodicMeasurement(named_measurement_t *nmp);
+#endif
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -290,6 +342,20 @@ static inline tprio_t chThdGetPriorityX(void) {
   return chThdGetSelfX()->hdr.pqueue.prio;
 }
 
+#if (CH_CFG_USE_PREEMPT_THRESHOLD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the current thread preemption threshold.
+ *
+ * @return              The current thread preemption threshold.
+ *
+ * @xclass
+ */
+static inline tprio_t chThdGetPreemptionThresholdX(void) {
+
+  return chThdGetSelfX()->threshold;
+}
+#endif
+
 /**
  * @brief   Returns the number of ticks consumed by the specified thread.
  * @note    This function is only available when the
@@ -323,6 +389,21 @@ static inline stkalign_t *chThdGetWorkingAreaX(thread_t *tp) {
 }
 #endif /* CH_DBG_ENABLE_STACK_CHECK == TRUE */
 
+#if (CH_DBG_STACK_WATERMARK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the minimum free stack space observed for a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The stack watermark in bytes.
+ *
+ * @xclass
+ */
+static inline size_t chThdGetStackMarginX(thread_t *tp) {
+
+  return tp->wmargin;
+}
+#endif /* CH_DBG_STACK_WATERMARK == TRUE */
+
 /**
  * @brief   Verifies if the specified thread is in the @p CH_STATE_FINAL state.
  *
@@ -95,6 +95,71 @@
 #error "CH_CFG_INTERVALS_SIZE must be >= CH_CFG_ST_RESOLUTION"
 #endif
 
+/**
+ * @brief   Powers of two common to @p n and @p m, up to 2^6.
+ */
+#define __TIME_GCD2(n, m)                                                   \
+  (((((n) % 64U) == 0U) && (((m) % 64U) == 0U)) ? 64U :                     \
+   ((((n) % 32U) == 0U) && (((m) % 32U) == 0U)) ? 32U :                     \
+   ((((n) % 16U) == 0U) && (((m) % 16U) == 0U)) ? 16U :                     \
+   ((((n) % 8U) == 0U) && (((m) % 8U) == 0U)) ? 8U :                        \
+   ((((n) % 4U) == 0U) && (((m) % 4U) == 0U)) ? 4U :                        \
+   ((((n) % 2U) == 0U) && (((m) % 2U) == 0U)) ? 2U : 1U)
+
+/**
+ * @brief   Powers of five common to @p n and @p m, up to 5^6.
+ */
+#define __TIME_GCD5(n, m)                                                   \
+  (((((n) % 15625U) == 0U) && (((m) % 15625U) == 0U)) ? 15625U :            \
+   ((((n) % 3125U) == 0U) && (((m) % 3125U) == 0U)) ? 3125U :               \
+   ((((n) % 625U) == 0U) && (((m) % 625U) == 0U)) ? 625U :                  \
+   ((((n) % 125U) == 0U) && (((m) % 125U) == 0U)) ? 125U :                  \
+   ((((n) % 25U) == 0U) && (((m) % 25U) == 0U)) ? 25U :                     \
+   ((((n) % 5U) == 0U) && (((m) % 5U) == 0U)) ? 5U : 1U)
+
+/**
+ * @brief   Greatest common divisor of @p n and a power of ten @p m.
+ * @note    The power of ten must not exceed 10^6.
+ */
+#define __TIME_GCD10(n, m)  (__TIME_GCD2(n, m) * __TIME_GCD5(n, m))
+
+/**
+ * @name    Reduced conversion factors
+ * @details The ratios between the system tick frequency and the time units
+ *          are reduced by their common factors at compile time. When the
+ *          frequency is a multiple or a divisor of a time unit one of the
+ *          factors is one and the conversion requires a single native
+ *          width multiplication or division by a constant, the compiler
+ *          implements the latter as a reciprocal multiplication. When the
+ *          remaining divisor is a power of two the division becomes a
+ *          shift.
+ * @{
+ */
+/**
+ * @brief   Ticks per millisecond numerator.
+ */
+#define TIME_MS_NUM                                                         \
+  ((CH_CFG_ST_FREQUENCY) / __TIME_GCD10(CH_CFG_ST_FREQUENCY, 1000U))
+
+/**
+ * @brief   Ticks per millisecond denominator.
+ */
+#define TIME_MS_DEN                                                         \
+  (1000U / __TIME_GCD10(CH_CFG_ST_FREQUENCY, 1000U))
+
+/**
+ * @brief   Ticks per microsecond numerator.
+ */
+#define TIME_US_NUM                                                         \
+  ((CH_CFG_ST_FREQUENCY) / __TIME_GCD10(CH_CFG_ST_FREQUENCY, 1000000U))
+
+/**
+ * @brief   Ticks per microsecond denominator.
+ */
+#define TIME_US_DEN                                                         \
+  (1000000U / __TIME_GCD10(CH_CFG_ST_FREQUENCY, 1000000U))
+/** @} */
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -199,9 +264,9 @@ typedef uint32_t time_conv_t;
  * @api
  */
 #define TIME_MS2I(msecs)                                                    \
-  ((sysinterval_t)((((time_conv_t)(msecs) *                                 \
-                     (time_conv_t)CH_CFG_ST_FREQUENCY) +                    \
-                    (time_conv_t)999) / (time_conv_t)1000))
+  ((sysinterval_t)((((time_conv_t)(msecs) * (time_conv_t)TIME_MS_NUM) +     \
+                    (time_conv_t)TIME_MS_DEN - (time_conv_t)1) /            \
+                   (time_conv_t)TIME_MS_DEN))
 
 /**
  * @brief   Microseconds to time interval.
@@ -217,9 +282,9 @@ typedef uint32_t time_conv_t;
  * @api
  */
 #define TIME_US2I(usecs)                                                    \
-  ((sysinterval_t)((((time_conv_t)(usecs) *                                 \
-                     (time_conv_t)CH_CFG_ST_FREQUENCY) +                    \
-                    (time_conv_t)999999) / (time_conv_t)1000000))
+  ((sysinterval_t)((((time_conv_t)(usecs) * (time_conv_t)TIME_US_NUM) +     \
+                    (time_conv_t)TIME_US_DEN - (time_conv_t)1) /            \
+                   (time_conv_t)TIME_US_DEN))
 
 /**
  * @brief   Time interval to seconds.
@@ -253,9 +318,9 @@ typedef uint32_t time_conv_t;
  * @api
  */
 #define TIME_I2MS(interval)                                                 \
-  (time_msecs_t)((((time_conv_t)(interval) * (time_conv_t)1000) +           \
-                  (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /      \
-                 (time_conv_t)CH_CFG_ST_FREQUENCY)
+  (time_msecs_t)((((time_conv_t)(interval) * (time_conv_t)TIME_MS_DEN) +    \
+                  (time_conv_t)TIME_MS_NUM - (time_conv_t)1) /              \
+                 (time_conv_t)TIME_MS_NUM)
 
 /**
  * @brief   Time interval to microseconds.
@@ -271,9 +336,9 @@ typedef uint32_t time_conv_t;
  * @api
  */
 #define TIME_I2US(interval)                                                 \
-  (time_msecs_t)((((time_conv_t)(interval) * (time_conv_t)1000000) +        \
-                  (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /      \
-                 (time_conv_t)CH_CFG_ST_FREQUENCY)
+  (time_usecs_t)((((time_conv_t)(interval) * (time_conv_t)TIME_US_DEN) +    \
+                  (time_conv_t)TIME_US_NUM - (time_conv_t)1) /              \
+                 (time_conv_t)TIME_US_NUM)
 /** @} */
 
 /*===========================================================================*/
@@ -333,8 +398,17 @@ static inline sysinterval_t chTimeS2I(time_secs_t secs) {
 static inline sysinterval_t chTimeMS2I(time_msecs_t msec) {
   time_conv_t ticks;
 
-  ticks = (((time_conv_t)msec * (time_conv_t)CH_CFG_ST_FREQUENCY) +
-           (time_conv_t)999) / (time_conv_t)1000;
+#if TIME_MS_NUM == 1U
+  /* Integer number of milliseconds per tick, native width division.*/
+  ticks = (time_conv_t)((uint32_t)msec / (uint32_t)TIME_MS_DEN);
+  if (((uint32_t)msec % (uint32_t)TIME_MS_DEN) != 0U) {
+    ticks++;
+  }
+#else
+  ticks = (((time_conv_t)msec * (time_conv_t)TIME_MS_NUM) +
+           (time_conv_t)TIME_MS_DEN - (time_conv_t)1) /
+          (time_conv_t)TIME_MS_DEN;
+#endif
 
   chDbgAssert(ticks <= (time_conv_t)TIME_MAX_INTERVAL,
               "conversion overflow");
@@ -355,8 +429,17 @@ static inline sysinterval_t chTimeMS2I(time_msecs_t msec) {
 static inline sysinterval_t chTimeUS2I(time_usecs_t usec) {
   time_conv_t ticks;
 
-  ticks = (((time_conv_t)usec * (time_conv_t)CH_CFG_ST_FREQUENCY) +
-           (time_conv_t)999999) / (time_conv_t)1000000;
+#if TIME_US_NUM == 1U
+  /* Integer number of microseconds per tick, native width division.*/
+  ticks = (time_conv_t)((uint32_t)usec / (uint32_t)TIME_US_DEN);
+  if (((uint32_t)usec % (uint32_t)TIME_US_DEN) != 0U) {
+    ticks++;
+  }
+#else
+  ticks = (((time_conv_t)usec * (time_conv_t)TIME_US_NUM) +
+           (time_conv_t)TIME_US_DEN - (time_conv_t)1) /
+          (time_conv_t)TIME_US_DEN;
+#endif
 
   chDbgAssert(ticks <= (time_conv_t)TIME_MAX_INTERVAL,
               "conversion overflow");
@@ -377,9 +460,17 @@ static inline sysinterval_t chTimeUS2I(time_usecs_t usec) {
 static inline time_secs_t chTimeI2S(sysinterval_t interval) {
   time_conv_t secs;
 
+#if CH_CFG_INTERVALS_SIZE <= 32
+  /* Native width division.*/
+  secs = (time_conv_t)((uint32_t)interval / (uint32_t)CH_CFG_ST_FREQUENCY);
+  if (((uint32_t)interval % (uint32_t)CH_CFG_ST_FREQUENCY) != 0U) {
+    secs++;
+  }
+#else
   secs = ((time_conv_t)interval +
           (time_conv_t)CH_CFG_ST_FREQUENCY -
           (time_conv_t)1) / (time_conv_t)CH_CFG_ST_FREQUENCY;
+#endif
 
   chDbgAssert(secs < (time_conv_t)((time_secs_t)-1),
               "conversion overflow");
@@ -400,9 +491,17 @@ static inline time_secs_t chTimeI2S(sysinterval_t interval) {
 static inline time_msecs_t chTimeI2MS(sysinterval_t interval) {
   time_conv_t msecs;
 
-  msecs = (((time_conv_t)interval * (time_conv_t)1000) +
-           (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /
-          (time_conv_t)CH_CFG_ST_FREQUENCY;
+#if (TIME_MS_DEN == 1U) && (CH_CFG_INTERVALS_SIZE <= 32)
+  /* Integer number of ticks per millisecond, native width division.*/
+  msecs = (time_conv_t)((uint32_t)interval / (uint32_t)TIME_MS_NUM);
+  if (((uint32_t)interval % (uint32_t)TIME_MS_NUM) != 0U) {
+    msecs++;
+  }
+#else
+  msecs = (((time_conv_t)interval * (time_conv_t)TIME_MS_DEN) +
+           (time_conv_t)TIME_MS_NUM - (time_conv_t)1) /
+          (time_conv_t)TIME_MS_NUM;
+#endif
 
   chDbgAssert(msecs < (time_conv_t)((time_msecs_t)-1),
               "conversion overflow");
@@ -423,9 +522,17 @@ static inline time_msecs_t chTimeI2MS(sysinterval_t interval) {
 static inline time_usecs_t chTimeI2US(sysinterval_t interval) {
   time_conv_t usecs;
 
-  usecs = (((time_conv_t)interval * (time_conv_t)1000000) +
-           (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /
-          (time_conv_t)CH_CFG_ST_FREQUENCY;
+#if (TIME_US_DEN == 1U) && (CH_CFG_INTERVALS_SIZE <= 32)
+  /* Integer number of ticks per microsecond, native width division.*/
+  usecs = (time_conv_t)((uint32_t)interval / (uint32_t)TIME_US_NUM);
+  if (((uint32_t)interval % (uint32_t)TIME_US_NUM) != 0U) {
+    usecs++;
+  }
+#else
+  usecs = (((time_conv_t)interval * (time_conv_t)TIME_US_DEN) +
+           (time_conv_t)TIME_US_NUM - (time_conv_t)1) /
+          (time_conv_t)TIME_US_NUM;
+#endif
 
   chDbgAssert(usecs <= (time_conv_t)((time_usecs_t)-1),
               "conversion overflow");
@@ -0,0 +1,156 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file    rt/include/chtls.h
+ * @brief   Thread local storage macros and structures.
+ *
+ * @addtogroup thread_local_storage
+ * @{
+ */
+
+#ifndef CHTLS_H
+#define CHTLS_H
+
+#if (CH_CFG_USE_TLS == TRUE) || defined(__DOXYGEN__)
+
+#if (CH_CFG_USE_NEWLIB_REENT == TRUE) || defined(__DOXYGEN__)
+#include <reent.h>
+#endif
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(PORT_SUPPORTS_TLS) || (PORT_SUPPORTS_TLS == FALSE)
+#error "CH_CFG_USE_TLS not supported by this port"
+#endif
+
+#if CH_CFG_TLS_SIZE < 0
+#error "invalid CH_CFG_TLS_SIZE value"
+#endif
+
+/**
+ * @brief   Size of a TLS block.
+ * @details The block starts with the port-defined thread control block
+ *          followed by the thread local variables, the thread pointer
+ *          points to the block base.
+ */
+#define CH_TLS_BLOCK_SIZE                                                   \
+  MEM_ALIGN_NEXT(PORT_TLS_TCB_SIZE + (size_t)CH_CFG_TLS_SIZE,               \
+                 PORT_STACK_ALIGN)
+
+/**
+ * @brief   Size of the TLS area in a thread working area.
+ */
+#if (CH_CFG_USE_NEWLIB_REENT == TRUE) || defined(__DOXYGEN__)
+#define CH_TLS_AREA_SIZE                                                    \
+  (CH_TLS_BLOCK_SIZE +                                                      \
+   MEM_ALIGN_NEXT(sizeof (struct _reent), PORT_STACK_ALIGN))
+#else
+#define CH_TLS_AREA_SIZE                    CH_TLS_BLOCK_SIZE
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Context switch TLS update.
+ *
+ * @param[in] ntp       the thread to be switched in
+ *
+ * @notapi
+ */
+#if (CH_CFG_USE_NEWLIB_REENT == TRUE) || defined(__DOXYGEN__)
+#define __tls_switch(ntp) do {                                              \
+  ch_tls_tp   = (ntp)->tlsp;                                                \
+  _impure_ptr = (ntp)->reent;                                               \
+} while (false)
+#else
+#define __tls_switch(ntp) do {                                              \
+  ch_tls_tp   = (ntp)->tlsp;                                                \
+} while (false)
+#endif
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern void *ch_tls_tp;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void __tls_object_init(thread_t *tp, void *base);
+  void __tls_main_init(thread_t *tp);
+#if CH_CFG_USE_NEWLIB_REENT == TRUE
+  void __tls_reclaim(thread_t *tp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the TLS block of a thread.
+ * @details The thread local variables of the thread are located at fixed
+ *          offsets from the returned thread pointer.
+ *
+ * @param[in] tp        pointer to the thread
+ * @return              The thread pointer of the thread.
+ *
+ * @xclass
+ */
+static inline void *chThdGetTLSX(thread_t *tp) {
+
+  return tp->tlsp;
+}
+
+#else /* CH_CFG_USE_TLS == FALSE */
+
+/* No TLS area.*/
+#define CH_TLS_AREA_SIZE                    0U
+
+/* No TLS switch.*/
+#define __tls_switch(ntp)
+
+#endif /* CH_CFG_USE_TLS == FALSE */
+
+#endif /* CHTLS_H */
+
+/** @} */
@@ -38,6 +38,45 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Named measurements registry.
+ * @details If enabled then named measurements with histograms can be
+ *          registered, enumerated and queried for percentiles.
+ */
+#if !defined(CH_CFG_USE_TM_REGISTRY) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TM_REGISTRY              FALSE
+#endif
+
+/**
+ * @brief   Resolution of measurement histograms.
+ * @details Each power of two interval is split in
+ *          <tt>2^CH_CFG_TM_HISTOGRAM_RESOLUTION</tt> buckets, the relative
+ *          error of percentiles is bounded by
+ *          <tt>2^-CH_CFG_TM_HISTOGRAM_RESOLUTION</tt>.
+ */
+#if !defined(CH_CFG_TM_HISTOGRAM_RESOLUTION) || defined(__DOXYGEN__)
+#define CH_CFG_TM_HISTOGRAM_RESOLUTION      2
+#endif
+
+/**
+ * @brief   Range of measurement histograms.
+ * @details Measurements of <tt>2^CH_CFG_TM_HISTOGRAM_RANGE</tt> realtime
+ *          counter cycles or more are counted in the last bucket.
+ */
+#if !defined(CH_CFG_TM_HISTOGRAM_RANGE) || defined(__DOXYGEN__)
+#define CH_CFG_TM_HISTOGRAM_RANGE           24
+#endif
+
+/**
+ * @brief   Debug option, wait time profiling.
+ * @details If enabled then the time spent by threads waiting on the kernel
+ *          objects registered using @p chTMRegisterWait() is recorded in
+ *          named measurements.
+ */
+#if !defined(CH_DBG_WAIT_PROFILING) || defined(__DOXYGEN__)
+#define CH_DBG_WAIT_PROFILING               FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -46,6 +85,27 @@
 #error "CH_CFG_USE_TM requires PORT_SUPPORTS_RT"
 #endif
 
+#if (CH_CFG_TM_HISTOGRAM_RESOLUTION < 0) ||                                 \
+    (CH_CFG_TM_HISTOGRAM_RESOLUTION > 4)
+#error "invalid CH_CFG_TM_HISTOGRAM_RESOLUTION value"
+#endif
+
+#if (CH_CFG_TM_HISTOGRAM_RANGE <= CH_CFG_TM_HISTOGRAM_RESOLUTION) ||        \
+    (CH_CFG_TM_HISTOGRAM_RANGE > 31)
+#error "invalid CH_CFG_TM_HISTOGRAM_RANGE value"
+#endif
+
+#if (CH_DBG_WAIT_PROFILING == TRUE) && (CH_CFG_USE_TM_REGISTRY == FALSE)
+#error "CH_DBG_WAIT_PROFILING requires CH_CFG_USE_TM_REGISTRY"
+#endif
+
+/**
+ * @brief   Number of buckets in measurement histograms.
+ */
+#define CH_TM_HISTOGRAM_BUCKETS                                             \
+  ((CH_CFG_TM_HISTOGRAM_RANGE - CH_CFG_TM_HISTOGRAM_RESOLUTION + 1) <<      \
+   CH_CFG_TM_HISTOGRAM_RESOLUTION)
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -77,6 +137,69 @@ typedef struct {
   rttime_t              cumulative;     /**< @brief Cumulative measurement. */
 } time_measurement_t;
 
+#if (CH_CFG_USE_TM_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a named measurement object.
+ * @details A time measurement with a log-scale histogram, linked in the
+ *          measurements registry.
+ */
+typedef struct ch_named_measurement {
+  /**
+   * @brief   Next measurement in the registry.
+   */
+  struct ch_named_measurement *next;
+  /**
+   * @brief   Measurement name.
+   */
+  const char            *name;
+  /**
+   * @brief   Measurement statistics.
+   */
+  time_measurement_t    tm;
+  /**
+   * @brief   Measurements histogram.
+   */
+  ucnt_t                hist[CH_TM_HISTOGRAM_BUCKETS];
+} named_measurement_t;
+
+/**
+ * @brief   Type of an exported measurement summary.
+ */
+typedef struct {
+  const char            *name;          /**< @brief Measurement name.       */
+  ucnt_t                n;              /**< @brief Number of measurements. */
+  rtcnt_t               best;           /**< @brief Best measurement.       */
+  rtcnt_t               worst;          /**< @brief Worst measurement.      */
+  rtcnt_t               p50;            /**< @brief Median.                 */
+  rtcnt_t               p99;            /**< @brief 99th percentile.        */
+  rtcnt_t               p999;           /**< @brief 99.9th percentile.      */
+  rttime_t              cumulative;     /**< @brief Cumulative measurement. */
+} tm_summary_t;
+#endif /* CH_CFG_USE_TM_REGISTRY == TRUE */
+
+#if (CH_DBG_WAIT_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a wait profile object.
+ * @details A named measurement of the time spent by threads waiting on a
+ *          kernel object, the number of measurements is the number of
+ *          times the object has been found contended.
+ */
+typedef struct ch_wait_profile {
+  /**
+   * @brief   Next profile in the profiled objects list.
+   */
+  struct ch_wait_profile *next;
+  /**
+   * @brief   The profiled object.
+   */
+  const void            *objp;
+  /**
+   * @brief   Wait time measurement.
+   */
+  named_measurement_t   nm;
+} wait_profile_t;
+#endif /* CH_DBG_WAIT_PROFILING == TRUE */
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -94,6 +217,26 @@ extern "C" {
   NOINLINE void chTMStopMeasurementX(time_measurement_t *tmp);
   NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
                                         time_measurement_t *tmp2);
+#if CH_CFG_USE_TM_REGISTRY == TRUE
+  void chTMRegister(named_measurement_t *nmp, const char *name);
+  void chTMUnregister(named_measurement_t *nmp);
+  void chTMResetNamedX(named_measurement_t *nmp);
+  NOINLINE void chTMStopNamedMeasurementX(named_measurement_t *nmp);
+  void chTMAddNamedSampleX(named_measurement_t *nmp, rtcnt_t sample);
+  rtcnt_t chTMGetPercentileX(const named_measurement_t *nmp,
+                             unsigned permille);
+  void chTMGetSummaryX(const named_measurement_t *nmp, tm_summary_t *tsp);
+  named_measurement_t *chTMRegistryFirstX(void);
+  named_measurement_t *chTMRegistryNextX(named_measurement_t *nmp);
+  unsigned chTMExportRegistry(tm_summary_t *tsp, unsigned n);
+#endif
+#if CH_DBG_WAIT_PROFILING == TRUE
+  void chTMRegisterWait(wait_profile_t *wpp, const void *objp,
+                        const char *name);
+  void chTMUnregisterWait(wait_profile_t *wpp);
+  msg_t __tm_wait_s(tstate_t newstate, sysinterval_t timeout,
+                    const void *objp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -102,6 +245,20 @@ extern "C" {
 /* Module inline functions.                                                  */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TM_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a named measurement.
+ *
+ * @param[in,out] nmp   pointer to a @p named_measurement_t structure
+ *
+ * @xclass
+ */
+static inline void chTMStartNamedMeasurementX(named_measurement_t *nmp) {
+
+  chTMStartMeasurementX(&nmp->tm);
+}
+#endif /* CH_CFG_USE_TM_REGISTRY == TRUE */
+
 #endif /* CH_CFG_USE_TM == TRUE */
 
 #endif /* CHTM_H */
@@ -43,8 +43,16 @@
 #define CH_TRACE_TYPE_ISR_LEAVE             4U
 #define CH_TRACE_TYPE_HALT                  5U
 #define CH_TRACE_TYPE_USER                  6U
+#define CH_TRACE_TYPE_WAKEUP                7U
 /** @} */
 
+/**
+ * @brief   Wakeup record flag, the thread has been woken by an ISR.
+ * @note    The flag is added to the waiting state in the record
+ *          @p state field.
+ */
+#define CH_TRACE_WAKEUP_FROM_ISR            16U
+
 /**
  * @name    Events to trace
  * @{
@@ -56,15 +64,18 @@
 #define CH_DBG_TRACE_MASK_ISR               4U
 #define CH_DBG_TRACE_MASK_HALT              8U
 #define CH_DBG_TRACE_MASK_USER              16U
+#define CH_DBG_TRACE_MASK_WAKEUP            32U
 #define CH_DBG_TRACE_MASK_SLOW              (CH_DBG_TRACE_MASK_READY |      \
                                              CH_DBG_TRACE_MASK_SWITCH |     \
                                              CH_DBG_TRACE_MASK_HALT |       \
-                                             CH_DBG_TRACE_MASK_USER)
+                                             CH_DBG_TRACE_MASK_USER |       \
+                                             CH_DBG_TRACE_MASK_WAKEUP)
 #define CH_DBG_TRACE_MASK_ALL               (CH_DBG_TRACE_MASK_READY |      \
                                              CH_DBG_TRACE_MASK_SWITCH |     \
                                              CH_DBG_TRACE_MASK_ISR |        \
                                              CH_DBG_TRACE_MASK_HALT |       \
-                                             CH_DBG_TRACE_MASK_USER)
+                                             CH_DBG_TRACE_MASK_USER |       \
+                                             CH_DBG_TRACE_MASK_WAKEUP)
 /** @} */
 
 /*===========================================================================*/
@@ -112,6 +123,8 @@ typedef struct {
   uint32_t              type:3;
   /**
    * @brief   Switched out thread state.
+   * @note    In ready and wakeup records this is the state of the thread
+   *          being woken.
    */
   uint32_t              state:5;
   /**
@@ -151,6 +164,22 @@ typedef struct {
        */
       msg_t                 msg;
     } rdy;
+    /**
+     * @brief   Structure representing the cause of a thread wakeup.
+     * @note    The waker is the current thread or, if the
+     *          @p CH_TRACE_WAKEUP_FROM_ISR flag is set in the @p state
+     *          field, the ISR being served.
+     */
+    struct {
+      /**
+       * @brief   Thread woken up.
+       */
+      thread_t              *tp;
+      /**
+       * @brief   Object the thread was waiting on or @p NULL.
+       */
+      void                  *objp;
+    } wkp;
     /**
      * @brief   Structure representing an ISR enter.
      */
@@ -202,6 +231,11 @@ typedef struct {
    * @brief   Pointer to the buffer front.
    */
   trace_event_t         *ptr;
+  /**
+   * @brief   Number of records written since initialization.
+   * @note    The counter wraps, records are numbered from zero.
+   */
+  uint32_t              seq;
   /**
    * @brief   Ring buffer.
    */
@@ -232,6 +266,9 @@ typedef struct {
 #if !defined(__trace_halt)
 #define __trace_halt(reason)
 #endif
+#if !defined(__trace_crit)
+#define __trace_crit(caller, duration)
+#endif
 #if !defined(chDbgWriteTraceI)
 #define chDbgWriteTraceI(up1, up2)
 #endif
@@ -254,12 +291,15 @@ extern "C" {
   void __trace_isr_enter(const char *isr);
   void __trace_isr_leave(const char *isr);
   void __trace_halt(const char *reason);
+  void __trace_crit(void *caller, rtcnt_t duration);
   void chDbgWriteTraceI(void *up1, void *up2);
   void chDbgWriteTrace(void *up1, void *up2);
   void chDbgSuspendTraceI(uint16_t mask);
   void chDbgSuspendTrace(uint16_t mask);
   void chDbgResumeTraceI(uint16_t mask);
   void chDbgResumeTrace(uint16_t mask);
+  uint32_t chDbgGetTraceSequenceX(void);
+  bool chDbgReadTraceI(uint32_t seq, trace_event_t *tep);
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 #ifdef __cplusplus
 }
@@ -75,10 +75,24 @@ extern "C" {
                   vtfunc_t vtfunc, void *par);
   void chVTDoResetI(virtual_timer_t *vtp);
   void chVTDoTickI(void);
+#if CH_CFG_USE_VT_WHEEL == TRUE
+  bool chVTGetTimersStateI(sysinterval_t *timep);
+#endif
 #if CH_CFG_USE_TIMESTAMP == TRUE
   systimestamp_t chVTGetTimeStampI(void);
+  systimestamp_t chVTGetTimeStampX(void);
   void chVTResetTimeStampI(void);
 #endif
+#if CH_CFG_USE_VT_DEFERRED == TRUE
+  void chVTSetDeferredI(virtual_timer_t *vtp, sysinterval_t delay,
+                        vtfunc_t vtfunc, void *par);
+  void chVTResetDeferredI(virtual_timer_t *vtp);
+  void __vt_thread(void *p);
+#endif
+#if CH_CFG_USE_VT_SLACK == TRUE
+  void chVTDoSetSlackI(virtual_timer_t *vtp, sysinterval_t delay,
+                       sysinterval_t slack, vtfunc_t vtfunc, void *par);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -101,6 +115,9 @@ extern "C" {
 static inline void chVTObjectInit(virtual_timer_t *vtp) {
 
   vtp->func = NULL;
+#if CH_CFG_USE_VT_DEFERRED == TRUE
+  vtp->dqueue.next = NULL;
+#endif
 }
 
 /**
@@ -194,6 +211,7 @@ static inline bool chVTIsSystemTimeWithin(systime_t start, systime_t end) {
   return chTimeIsInRangeX(chVTGetSystemTime(), start, end);
 }
 
+#if (CH_CFG_USE_VT_WHEEL == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Returns the time interval until the next timer event.
  * @note    The return value is not perfectly accurate and can report values
@@ -231,6 +249,7 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
 
   return true;
 }
+#endif /* CH_CFG_USE_VT_WHEEL == FALSE */
 
 /**
  * @brief   Returns @p true if the specified timer is armed.
@@ -362,32 +381,151 @@ static inline void chVTSet(virtual_timer_t *vtp, sysinterval_t delay,
   chSysUnlock();
 }
 
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a deferred virtual timer.
+ * @details The callback is executed by the timers thread after the timer
+ *          expiration, see @p chVTSetDeferredI().
+ * @pre     The timer must have been initialized using @p chVTObjectInit().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ * @param[in] vtfunc    the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @api
+ */
+static inline void chVTSetDeferred(virtual_timer_t *vtp, sysinterval_t delay,
+                                   vtfunc_t vtfunc, void *par) {
+
+  chSysLock();
+  chVTSetDeferredI(vtp, delay, vtfunc, par);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Disables a deferred virtual timer.
+ * @details The timer is disarmed and a callback still waiting to be
+ *          executed by the timers thread is cancelled.
+ * @pre     The timer must have been initialized using @p chVTObjectInit().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @api
+ */
+static inline void chVTResetDeferred(virtual_timer_t *vtp) {
+
+  chSysLock();
+  chVTResetDeferredI(vtp);
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_VT_DEFERRED == TRUE */
+
+#if (CH_CFG_USE_VT_SLACK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a virtual timer with a slack.
+ * @details If the virtual timer was already enabled then it is re-enabled
+ *          using the new parameters, see @p chVTDoSetSlackI().
+ * @pre     The timer must have been initialized using @p chVTObjectInit()
+ *          or @p chVTDoSetI().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the minimum number of ticks before the expiration,
+ *                      @a TIME_IMMEDIATE is not allowed
+ * @param[in] slack     the maximum number of ticks the expiration can be
+ *                      delayed by
+ * @param[in] vtfunc    the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+static inline void chVTSetSlackI(virtual_timer_t *vtp, sysinterval_t delay,
+                                 sysinterval_t slack,
+                                 vtfunc_t vtfunc, void *par) {
+
+  chVTResetI(vtp);
+  chVTDoSetSlackI(vtp, delay, slack, vtfunc, par);
+}
+
+/**
+ * @brief   Enables a virtual timer with a slack.
+ * @details If the virtual timer was already enabled then it is re-enabled
+ *          using the new parameters, see @p chVTDoSetSlackI().
+ * @pre     The timer must have been initialized using @p chVTObjectInit()
+ *          or @p chVTDoSetI().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the minimum number of ticks before the expiration,
+ *                      @a TIME_IMMEDIATE is not allowed
+ * @param[in] slack     the maximum number of ticks the expiration can be
+ *                      delayed by
+ * @param[in] vtfunc    the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @api
+ */
+static inline void chVTSetSlack(virtual_timer_t *vtp, sysinterval_t delay,
+                                sysinterval_t slack,
+                                vtfunc_t vtfunc, void *par) {
+
+  chSysLock();
+  chVTSetSlackI(vtp, delay, slack, vtfunc, par);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the number of timers armed with a slack.
+ *
+ * @return              The number of timers armed with a slack since
+ *                      system start.
+ *
+ * @xclass
+ */
+static inline ucnt_t chVTGetSlackArmsX(void) {
+
+  return currcore->vtlist.slackarms;
+}
+
+/**
+ * @brief   Returns the number of coalesced timers.
+ * @details A timer is coalesced when its expiration is delayed in order
+ *          to share the deadline of an already armed timer, each coalesced
+ *          timer saves an alarm event.
+ *
+ * @return              The number of coalesced timers since system start.
+ *
+ * @xclass
+ */
+static inline ucnt_t chVTGetCoalescedX(void) {
+
+  return currcore->vtlist.coalesced;
+}
+#endif /* CH_CFG_USE_VT_SLACK == TRUE */
+
 #if (CH_CFG_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Generates a monotonic time stamp.
  * @details This function generates a monotonic time stamp synchronized with
  *          the system time. The time stamp has the same resolution of
  *          system time.
- * @note    There is an assumption, this function must be called at
- *          least once before the system time wraps back to zero or
- *          synchronization is lost. You may use a periodic virtual timer with
- *          a very large interval in order to keep time stamps synchronized
- *          by calling this function.
+ * @note    The time stamp is read without entering a critical zone, see
+ *          @p chVTGetTimeStampX().
  *
  * @return              The time stamp.
  *
  * @api
  */
 static inline systimestamp_t chVTGetTimeStamp(void) {
-  systimestamp_t stamp;
-
-  chSysLock();
-
-  stamp = chVTGetTimeStampI();
-
-  chSysUnlock();
 
-  return stamp;
+  return chVTGetTimeStampX();
 }
 
 /**
@@ -417,16 +555,39 @@ static inline void chVTResetTimeStamp(void) {
  */
 static inline void __vt_object_init(virtual_timers_list_t *vtlp) {
 
+#if CH_CFG_USE_VT_WHEEL == TRUE
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SLOTS; i++) {
+    vtlp->slots[i].next  = &vtlp->slots[i];
+    vtlp->slots[i].prev  = &vtlp->slots[i];
+    vtlp->slots[i].delta = (sysinterval_t)0;
+  }
+  for (i = 0U; i < (unsigned)CH_VT_WHEEL_MAP_WORDS; i++) {
+    vtlp->slotmap[i] = 0U;
+  }
+  vtlp->armed = (ucnt_t)0;
+#if CH_CFG_ST_TIMEDELTA > 0
+  vtlp->alarm = (systime_t)0;
+#endif
+#else /* CH_CFG_USE_VT_WHEEL == FALSE */
   vtlp->dlist.next  = &vtlp->dlist;
   vtlp->dlist.prev  = &vtlp->dlist;
   vtlp->dlist.delta = (sysinterval_t)-1;
+#endif /* CH_CFG_USE_VT_WHEEL == FALSE */
 #if CH_CFG_ST_TIMEDELTA == 0
   vtlp->systime = (systime_t)0;
 #else /* CH_CFG_ST_TIMEDELTA > 0 */
   vtlp->lasttime = (systime_t)0;
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
 #if CH_CFG_USE_TIMESTAMP == TRUE
-  ch.vtlist.laststamp = (systimestamp_t)chVTGetSystemTimeX();
+  ch.vtlist.stampseq  = (ucnt_t)0;
+  ch.vtlist.stamps[0] = (systimestamp_t)chVTGetSystemTimeX();
+  ch.vtlist.stamps[1] = ch.vtlist.stamps[0];
+#endif
+#if CH_CFG_USE_VT_SLACK == TRUE
+  vtlp->slackarms = (ucnt_t)0;
+  vtlp->coalesced = (ucnt_t)0;
 #endif
 }
 
@@ -32,6 +32,14 @@
  *          The condition variable is a synchronization object meant to be
  *          used inside a zone protected by a mutex. Mutexes and condition
  *          variables together can implement a Monitor construct.
+ *          <h2>Wait morphing</h2>
+ *          When a condition variable is signaled by the thread owning the
+ *          associated mutex then the released threads are moved directly
+ *          on the mutex queue instead of being made ready, the threads
+ *          are resumed when the mutex is assigned to them without having
+ *          to contend for it. If the threads waiting on a condition
+ *          variable released different mutexes then they are simply made
+ *          ready and take their own mutex again.
  * @pre     In order to use the condition variable APIs the @p CH_CFG_USE_CONDVARS
  *          option must be enabled in @p chconf.h.
  * @{
@@ -61,6 +69,80 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Moves a released thread on the mutex queue.
+ * @details The thread is moved if it is waiting without timeout and the
+ *          mutex is owned by the current thread, the current thread
+ *          inherits the priority of the moved thread.
+ *
+ * @param[in] cp        pointer to the @p condition_variable_t structure
+ * @param[in] tp        the thread removed from the condition variable queue
+ * @param[in] msg       the message to be returned to the thread
+ * @return              The operation status.
+ * @retval false        if the thread has not been moved.
+ * @retval true         if the thread has been moved on the mutex queue.
+ *
+ * @notapi
+ */
+static bool cond_morph(condition_variable_t *cp, thread_t *tp, msg_t msg) {
+  thread_t *currtp = chThdGetSelfX();
+  mutex_t *mp = cp->mtxp;
+
+  /* A NULL mutex means that the waiting threads released different
+     mutexes, the thread cannot be moved.*/
+  if (((tp->flags & CH_FLAG_COND_WAIT) == (tmode_t)0) ||
+      (mp == NULL) || (mp->owner != currtp)) {
+    return false;
+  }
+
+  /* The cleared flag tells the thread that the mutex has been assigned
+     to it, the message is encoded in another flag.*/
+  tp->flags &= (tmode_t)~CH_FLAG_COND_WAIT;
+  if (msg == MSG_RESET) {
+    tp->flags |= CH_FLAG_COND_RESET;
+  }
+
+  /* Priority inheritance, the owner is the current thread so it does not
+     need to be re-enqueued.*/
+  if (tp->hdr.pqueue.prio > currtp->hdr.pqueue.prio) {
+    currtp->hdr.pqueue.prio = tp->hdr.pqueue.prio;
+  }
+
+  tp->state = CH_STATE_WTMTX;
+  tp->u.wtmtxp = mp;
+  ch_sch_prio_insert(&tp->hdr.queue, &mp->queue);
+
+  return true;
+}
+
+/**
+ * @brief   Completes a wait on a condition variable.
+ * @details The mutex is taken again unless it has already been assigned to
+ *          the thread by @p cond_morph().
+ *
+ * @param[in] mp        the mutex to be taken again
+ * @return              The message returned to the thread.
+ *
+ * @notapi
+ */
+static msg_t cond_wait_done(mutex_t *mp) {
+  thread_t *currtp = chThdGetSelfX();
+  msg_t msg;
+
+  if ((currtp->flags & CH_FLAG_COND_WAIT) == (tmode_t)0) {
+    msg = (currtp->flags & CH_FLAG_COND_RESET) != (tmode_t)0 ? MSG_RESET :
+                                                               MSG_OK;
+    currtp->flags &= (tmode_t)~CH_FLAG_COND_RESET;
+  }
+  else {
+    currtp->flags &= (tmode_t)~CH_FLAG_COND_WAIT;
+    msg = currtp->u.rdymsg;
+    chMtxLockS(mp);
+  }
+
+  return msg;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -77,10 +159,13 @@ void chCondObjectInit(condition_variable_t *cp) {
   chDbgCheck(cp != NULL);
 
   ch_queue_init(&cp->queue);
+  cp->mtxp = NULL;
 }
 
 /**
  * @brief   Signals one thread that is waiting on the condition variable.
+ * @note    If the invoking thread owns the associated mutex then the
+ *          signaled thread is moved on the mutex queue.
  *
  * @param[in] cp        pointer to the @p condition_variable_t structure
  *
@@ -92,7 +177,16 @@ void chCondSignal(condition_variable_t *cp) {
 
   chSysLock();
   if (ch_queue_notempty(&cp->queue)) {
-    chSchWakeupS((thread_t *)ch_queue_fifo_remove(&cp->queue), MSG_OK);
+    thread_t *tp = (thread_t *)ch_queue_fifo_remove(&cp->queue);
+    bool morphed = cond_morph(cp, tp, MSG_OK);
+
+    /* The mutex is forgotten before the thread can run and wait again.*/
+    if (ch_queue_isempty(&cp->queue)) {
+      cp->mtxp = NULL;
+    }
+    if (!morphed) {
+      chSchWakeupS(tp, MSG_OK);
+    }
   }
   chSysUnlock();
 }
@@ -115,6 +209,9 @@ void chCondSignalI(condition_variable_t *cp) {
 
   if (ch_queue_notempty(&cp->queue)) {
     thread_t *tp = (thread_t *)ch_queue_fifo_remove(&cp->queue);
+    if (ch_queue_isempty(&cp->queue)) {
+      cp->mtxp = NULL;
+    }
     tp->u.rdymsg = MSG_OK;
     (void) chSchReadyI(tp);
   }
@@ -122,6 +219,9 @@ void chCondSignalI(condition_variable_t *cp) {
 
 /**
  * @brief   Signals all threads that are waiting on the condition variable.
+ * @note    If the invoking thread owns the associated mutex then the
+ *          signaled threads are moved on the mutex queue, this avoids
+ *          waking up threads that would immediately block on the mutex.
  *
  * @param[in] cp        pointer to the @p condition_variable_t structure
  *
@@ -129,8 +229,16 @@ void chCondSignalI(condition_variable_t *cp) {
  */
 void chCondBroadcast(condition_variable_t *cp) {
 
+  chDbgCheck(cp != NULL);
+
   chSysLock();
-  chCondBroadcastI(cp);
+  while (ch_queue_notempty(&cp->queue)) {
+    thread_t *tp = (thread_t *)ch_queue_fifo_remove(&cp->queue);
+    if (!cond_morph(cp, tp, MSG_RESET)) {
+      chSchReadyI(tp)->u.rdymsg = MSG_RESET;
+    }
+  }
+  cp->mtxp = NULL;
   chSchRescheduleS();
   chSysUnlock();
 }
@@ -157,6 +265,7 @@ void chCondBroadcastI(condition_variable_t *cp) {
   while (ch_queue_notempty(&cp->queue)) {
     chSchReadyI((thread_t *)ch_queue_fifo_remove(&cp->queue))->u.rdymsg = MSG_RESET;
   }
+  cp->mtxp = NULL;
 }
 
 /**
@@ -205,7 +314,6 @@ msg_t chCondWait(condition_variable_t *cp) {
 msg_t chCondWaitS(condition_variable_t *cp) {
   thread_t *currtp = chThdGetSelfX();
   mutex_t *mp = chMtxGetNextMutexX();
-  msg_t msg;
 
   chDbgCheckClassS();
   chDbgCheck(cp != NULL);
@@ -215,14 +323,24 @@ msg_t chCondWaitS(condition_variable_t *cp) {
   chMtxUnlockS(mp);
 
   /* Start waiting on the condition variable, on exit the mutex is taken
-     again.*/
+     again or it has already been assigned to this thread.*/
   currtp->u.wtobjp = cp;
+  currtp->flags |= CH_FLAG_COND_WAIT;
+  if (ch_queue_isempty(&cp->queue)) {
+    cp->mtxp = mp;
+  }
+  else if (cp->mtxp != mp) {
+    /* Waiting threads with different mutexes, no wait morphing until the
+       queue is emptied.*/
+    cp->mtxp = NULL;
+  }
+  else {
+    /* Same mutex of the other waiting threads.*/
+  }
   ch_sch_prio_insert(&currtp->hdr.queue, &cp->queue);
-  chSchGoSleepS(CH_STATE_WTCOND);
-  msg = currtp->u.rdymsg;
-  chMtxLockS(mp);
+  __sch_wait_s(CH_STATE_WTCOND, cp);
 
-  return msg;
+  return cond_wait_done(mp);
 }
 
 #if (CH_CFG_USE_CONDVARS_TIMEOUT == TRUE) || defined(__DOXYGEN__)
@@ -236,6 +354,8 @@ msg_t chCondWaitS(condition_variable_t *cp) {
  *          in order to use this function.
  * @post    Exiting the function because a timeout does not re-acquire the
  *          mutex, the mutex ownership is lost.
+ * @note    Threads waiting with a timeout are always made ready when
+ *          signaled, they are never moved on the mutex queue.
  *
  * @param[in] cp        pointer to the @p condition_variable_t structure
  * @param[in] timeout   the number of ticks before the operation timeouts, the
@@ -274,6 +394,8 @@ msg_t chCondWaitTimeout(condition_variable_t *cp, sysinterval_t timeout) {
  *          in order to use this function.
  * @post    Exiting the function because a timeout does not re-acquire the
  *          mutex, the mutex ownership is lost.
+ * @note    Threads waiting with a timeout are always made ready when
+ *          signaled, they are never moved on the mutex queue.
  *
  * @param[in] cp        pointer to the @p condition_variable_t structure
  * @param[in] timeout   the number of ticks before the operation timeouts, the
@@ -308,7 +430,7 @@ msg_t chCondWaitTimeoutS(condition_variable_t *cp, sysinterval_t timeout) {
      again.*/
   currtp->u.wtobjp = cp;
   ch_sch_prio_insert(&currtp->hdr.queue, &cp->queue);
-  msg = chSchGoSleepTimeoutS(CH_STATE_WTCOND, timeout);
+  msg = __sch_wait_timeout_s(CH_STATE_WTCOND, timeout, cp);
   if (msg != MSG_TIMEOUT) {
     chMtxLockS(mp);
   }
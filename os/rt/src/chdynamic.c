@@ -23,6 +23,13 @@
  *
  * @addtogroup dynamic_threads
  * @details Dynamic threads related APIs and services.
+ *          <h2>Threads pools</h2>
+ *          A threads pool keeps terminated workers parked with their
+ *          working area ready, submitting a function resumes a parked
+ *          worker instead of creating a new thread. New workers are
+ *          created on demand up to a maximum and workers parked for
+ *          longer than an idle time terminate, their working areas are
+ *          returned to the memory pool on the next submission.
  * @{
  */
 
@@ -50,6 +57,135 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Threads pool worker thread.
+ *
+ * @param[in] arg       pointer to the @p thread_pool_worker_t structure
+ */
+static void thd_pool_worker(void *arg) {
+  thread_pool_worker_t *wp = (thread_pool_worker_t *)arg;
+  thread_pool_t *tpp = wp->pool;
+
+  while (true) {
+    if (wp->func != NULL) {
+      wp->func(wp->arg);
+    }
+
+    /* Parking.*/
+    chSysLock();
+    wp->next    = tpp->parked;
+    tpp->parked = wp;
+    if (chThdSuspendTimeoutS(&wp->tr, tpp->idle) == MSG_TIMEOUT) {
+      thread_pool_worker_t **wpp = &tpp->parked;
+
+      /* Idle for too long, removing itself from the parked list, if
+         still there, and terminating.*/
+      while (*wpp != NULL) {
+        if (*wpp == wp) {
+          *wpp = wp->next;
+          break;
+        }
+        wpp = &(*wpp)->next;
+      }
+      tpp->workers--;
+      wp->next    = tpp->exited;
+      tpp->exited = wp;
+      chThdExitS(MSG_OK);
+    }
+    chSysUnlock();
+  }
+}
+
+/**
+ * @brief   Reclaims the working areas of the terminated workers.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ */
+static void thd_pool_reclaim(thread_pool_t *tpp) {
+  thread_pool_worker_t *wp;
+
+  chSysLock();
+  wp = tpp->exited;
+  tpp->exited = NULL;
+  chSysUnlock();
+
+  while (wp != NULL) {
+    thread_pool_worker_t *next = wp->next;
+
+    /* Workers are static threads, releasing the last reference only
+       removes them from the registry.*/
+    chThdRelease(wp->tp);
+    chPoolFree(tpp->mp, (void *)wp);
+    wp = next;
+  }
+}
+
+/**
+ * @brief   Creates a new worker.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] func      function to be executed by the worker or @p NULL
+ * @param[in] arg       argument of the function
+ * @return              The operation status.
+ * @retval false        if the worker has been created.
+ * @retval true         if the maximum number of workers has been reached
+ *                      or the memory pool is empty.
+ */
+static bool thd_pool_spawn(thread_pool_t *tpp, tfunc_t func, void *arg) {
+  thread_pool_worker_t *wp;
+  thread_t *tp;
+  size_t offset = MEM_ALIGN_NEXT(sizeof (thread_pool_worker_t),
+                                 PORT_WORKING_AREA_ALIGN);
+
+  chSysLock();
+  if (tpp->workers >= tpp->max) {
+    chSysUnlock();
+    return true;
+  }
+  tpp->workers++;
+  if (tpp->workers > tpp->high_water) {
+    tpp->high_water = tpp->workers;
+  }
+  chSysUnlock();
+
+  wp = (thread_pool_worker_t *)chPoolAlloc(tpp->mp);
+  if (wp == NULL) {
+    chSysLock();
+    tpp->workers--;
+    chSysUnlock();
+    return true;
+  }
+  wp->pool = tpp;
+  wp->tr   = NULL;
+  wp->func = func;
+  wp->arg  = arg;
+
+  thread_descriptor_t td = {
+    .name  = tpp->name,
+    .wbase = (stkalign_t *)((uint8_t *)wp + offset),
+    .wend  = (stkalign_t *)((uint8_t *)wp + tpp->mp->object_size),
+    .prio  = tpp->prio,
+    .funcp = thd_pool_worker,
+    .arg   = (void *)wp
+  };
+
+#if CH_DBG_FILL_THREADS == TRUE
+  __thd_memfill((uint8_t *)wp + offset,
+                (uint8_t *)wp + tpp->mp->object_size,
+                CH_DBG_STACK_FILL_VALUE);
+#endif
+
+  chSysLock();
+  tp = chThdCreateSuspendedI(&td);
+  wp->tp = tp;
+  chSchWakeupS(tp, MSG_OK);
+  chSysUnlock();
+
+  return false;
+}
+#endif /* CH_CFG_USE_MEMPOOLS == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -91,12 +227,12 @@ thread_t *chThdCreateFromHeap(memory_heap_t *heapp, size_t size,
   }
 
   thread_descriptor_t td = {
-    name,
-    wsp,
-    (stkalign_t *)((uint8_t *)wsp + size),
-    prio,
-    pf,
-    arg
+    .name  = name,
+    .wbase = wsp,
+    .wend  = (stkalign_t *)((uint8_t *)wsp + size),
+    .prio  = prio,
+    .funcp = pf,
+    .arg   = arg
   };
 
 #if CH_DBG_FILL_THREADS == TRUE
@@ -155,12 +291,12 @@ thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
   }
 
   thread_descriptor_t td = {
-    name,
-    wsp,
-    (stkalign_t *)((uint8_t *)wsp + mp->object_size),
-    prio,
-    pf,
-    arg
+    .name  = name,
+    .wbase = wsp,
+    .wend  = (stkalign_t *)((uint8_t *)wsp + mp->object_size),
+    .prio  = prio,
+    .funcp = pf,
+    .arg   = arg
   };
 
 #if CH_DBG_FILL_THREADS == TRUE
@@ -178,6 +314,116 @@ thread_t *chThdCreateFromMemoryPool(memory_pool_t *mp, const char *name,
 
   return tp;
 }
+
+/**
+ * @brief   Initializes a threads pool.
+ * @pre     The memory pool must be initialized to contain only objects
+ *          with alignment @p PORT_WORKING_AREA_ALIGN and size
+ *          @p THD_POOL_WORKING_AREA_SIZE().
+ *
+ * @param[out] tpp      pointer to a @p thread_pool_t structure
+ * @param[in] mp        pointer to the memory pool of the working areas
+ * @param[in] name      name of the worker threads
+ * @param[in] prio      priority of the worker threads
+ * @param[in] max       maximum number of workers
+ * @param[in] idle      time after which a parked worker terminates, the
+ *                      special value @p TIME_INFINITE keeps the workers
+ *                      parked forever
+ *
+ * @init
+ */
+void chThdPoolObjectInit(thread_pool_t *tpp, memory_pool_t *mp,
+                         const char *name, tprio_t prio,
+                         ucnt_t max, sysinterval_t idle) {
+
+  chDbgCheck((tpp != NULL) && (mp != NULL) && (max > (ucnt_t)0) &&
+             (idle != TIME_IMMEDIATE));
+
+  tpp->mp         = mp;
+  tpp->name       = name;
+  tpp->prio       = prio;
+  tpp->max        = max;
+  tpp->idle       = idle;
+  tpp->workers    = (ucnt_t)0;
+  tpp->high_water = (ucnt_t)0;
+  tpp->parked     = NULL;
+  tpp->exited     = NULL;
+}
+
+/**
+ * @brief   Executes a function on a threads pool worker.
+ * @details The most recently parked worker is resumed, if no worker is
+ *          parked then a new one is created.
+ * @note    The function runs on a worker thread, returning from the
+ *          function parks the worker.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] func      the function to be executed
+ * @param[in] arg       an argument passed to the function, it can be
+ *                      @p NULL
+ * @return              The operation status.
+ * @retval false        if the function has been submitted.
+ * @retval true         if no worker is parked and the maximum number of
+ *                      workers has been reached or the memory pool is
+ *                      empty.
+ *
+ * @api
+ */
+bool chThdPoolSubmit(thread_pool_t *tpp, tfunc_t func, void *arg) {
+  thread_pool_worker_t *wp;
+
+  chDbgCheck((tpp != NULL) && (func != NULL));
+
+  /* Returning the working areas of terminated workers to the memory
+     pool first.*/
+  if (tpp->exited != NULL) {
+    thd_pool_reclaim(tpp);
+  }
+
+  chSysLock();
+  while (tpp->parked != NULL) {
+    wp = tpp->parked;
+    tpp->parked = wp->next;
+
+    /* A worker whose idle timeout just expired is no more suspended, it
+       is skipped and it will terminate.*/
+    if (wp->tr != NULL) {
+      wp->func = func;
+      wp->arg  = arg;
+      chThdResumeI(&wp->tr, MSG_OK);
+      chSchRescheduleS();
+      chSysUnlock();
+
+      return false;
+    }
+  }
+  chSysUnlock();
+
+  return thd_pool_spawn(tpp, func, arg);
+}
+
+/**
+ * @brief   Creates parked workers in advance.
+ *
+ * @param[in] tpp       pointer to a @p thread_pool_t structure
+ * @param[in] n         number of workers to be created
+ * @return              The number of created workers.
+ *
+ * @api
+ */
+ucnt_t chThdPoolPrestart(thread_pool_t *tpp, ucnt_t n) {
+  ucnt_t i;
+
+  chDbgCheck(tpp != NULL);
+
+  for (i = (ucnt_t)0; i < n; i++) {
+    if (thd_pool_spawn(tpp, NULL, NULL)) {
+      break;
+    }
+  }
+
+  return i;
+}
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
 #endif /* CH_CFG_USE_DYNAMIC == TRUE */
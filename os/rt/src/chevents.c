@@ -81,6 +81,25 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Checks if the pending events satisfy the thread wait condition.
+ *
+ * @param[in] tp        the thread to be checked
+ * @return              The wakeup condition.
+ * @retval false        if the thread is not waiting or the condition is not
+ *                      satisfied.
+ * @retval true         if the thread must be woken up.
+ *
+ * @notapi
+ */
+static inline bool evt_is_satisfied(const thread_t *tp) {
+
+  return ((tp->state == CH_STATE_WTOREVT) &&
+          ((tp->epending & tp->u.ewmask) != (eventmask_t)0)) ||
+         ((tp->state == CH_STATE_WTANDEVT) &&
+          ((tp->epending & tp->u.ewmask) == tp->u.ewmask));
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -226,10 +245,15 @@ eventmask_t chEvtAddEvents(eventmask_t events) {
  */
 void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags) {
   event_listener_t *elp;
+  ch_priority_queue_t batch;
 
   chDbgCheckClassI();
   chDbgCheck(esp != NULL);
 
+  /* Woken threads are collected in a local batch and moved in the ready
+     list in a single pass at the end.*/
+  ch_pqueue_init(&batch);
+
   elp = esp->next;
   /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
   while (elp != (event_listener_t *)esp) {
@@ -239,10 +263,23 @@ void chEvtBroadcastFlagsI(event_source_t *esp, eventflags_t flags) {
        source does not emit any flag.*/
     if ((flags == (eventflags_t)0) ||
         ((flags & elp->wflags) != (eventflags_t)0)) {
-      chEvtSignalI(elp->listener, elp->events);
+      thread_t *tp = elp->listener;
+
+      tp->epending |= elp->events;
+      if (evt_is_satisfied(tp)) {
+        tp->u.rdymsg = MSG_OK;
+        (void) chSchBatchAddI(&batch, tp);
+      }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+      else {
+        chWaitNotifyI(tp);
+      }
+#endif
     }
     elp = elp->next;
   }
+
+  chSchBatchReadyI(&batch);
 }
 
 /**
@@ -304,13 +341,17 @@ void chEvtSignalI(thread_t *tp, eventmask_t events) {
 
   tp->epending |= events;
   /* Test on the AND/OR conditions wait states.*/
-  if (((tp->state == CH_STATE_WTOREVT) &&
-       ((tp->epending & tp->u.ewmask) != (eventmask_t)0)) ||
-      ((tp->state == CH_STATE_WTANDEVT) &&
-       ((tp->epending & tp->u.ewmask) == tp->u.ewmask))) {
+  if (evt_is_satisfied(tp)) {
     tp->u.rdymsg = MSG_OK;
     (void) chSchReadyI(tp);
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  else {
+    /* Threads waiting on multiple objects are waiting on their events
+       too.*/
+    chWaitNotifyI(tp);
+  }
+#endif
 }
 
 /**
@@ -93,9 +93,12 @@ msg_t chMsgSend(thread_t *tp, msg_t msg) {
   currtp->u.sentmsg = msg;
   msg_insert(currtp, &tp->msgqueue);
   if (tp->state == CH_STATE_WTMSG) {
-    (void) chSchReadyI(tp);
+    /* Direct handoff to the waiting receiver, if allowed by priorities.*/
+    chSchGoSleepSwitchS(CH_STATE_SNDMSGQ, tp);
+  }
+  else {
+    chSchGoSleepS(CH_STATE_SNDMSGQ);
   }
-  chSchGoSleepS(CH_STATE_SNDMSGQ);
   msg = currtp->u.rdymsg;
   chSysUnlock();
 
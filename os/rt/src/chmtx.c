@@ -62,6 +62,15 @@
  *          The mechanism works with any number of nested mutexes and any
  *          number of involved threads. The algorithm complexity (worst case)
  *          is N with N equal to the number of nested mutexes.
+ *
+ *          <h2>Priority ceiling mode</h2>
+ *          If the option @p CH_CFG_USE_MUTEXES_CEILING is enabled then
+ *          mutexes initialized using @p chMtxCeilingObjectInit() implement
+ *          the immediate priority ceiling protocol. The owner priority is
+ *          raised to the mutex ceiling when locking, this is a constant
+ *          time operation and, if the ceiling is correctly assigned, no
+ *          thread can contend the mutex so inheritance chains are never
+ *          walked.
  * @pre     In order to use the mutex APIs the @p CH_CFG_USE_MUTEXES option
  *          must be enabled in @p chconf.h.
  * @post    Enabling mutexes requires 5-12 (depending on the architecture)
@@ -89,10 +98,116 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Repositions a boosted thread in a priority ordered queue.
+ * @details The thread is moved only if its new priority is higher than the
+ *          priority of the preceding thread, otherwise it is already in the
+ *          same position a re-insertion would give and the queue is not
+ *          scanned.
+ *
+ * @param[in] tp        the boosted thread
+ * @param[in] qp        the queue containing the thread
+ *
+ * @notapi
+ */
+static void mtx_requeue(thread_t *tp, ch_queue_t *qp) {
+  ch_queue_t *pp = tp->hdr.queue.prev;
+
+  if ((pp != qp) &&
+      (((thread_t *)pp)->hdr.pqueue.prio < tp->hdr.pqueue.prio)) {
+    ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue), qp);
+  }
+}
+
+/**
+ * @brief   Raises the priority of a new owner to the mutex ceiling.
+ * @note    Priority inheritance mutexes are not affected.
+ *
+ * @param[in] mp        the mutex
+ * @param[in] tp        the new owner, it must not be in the ready list
+ *
+ * @notapi
+ */
+static inline void mtx_raise(mutex_t *mp, thread_t *tp) {
+
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+  if (mp->ceiling != NOPRIO) {
+    chDbgAssert(tp->realprio <= mp->ceiling, "ceiling violation");
+
+    if (tp->hdr.pqueue.prio < mp->ceiling) {
+      tp->hdr.pqueue.prio = mp->ceiling;
+    }
+  }
+#else
+  (void)mp;
+  (void)tp;
+#endif
+}
+
+/**
+ * @brief   Calculates the priority of a mutexes owner.
+ * @details The priority is the highest among the thread base priority, the
+ *          priority of the threads waiting on the owned mutexes and the
+ *          ceilings of the owned mutexes.
+ * @note    The base priority of a thread belonging to a throttled
+ *          reservation is the throttling priority, the real priority is
+ *          saved in order to be restored on replenishment.
+ *
+ * @param[in] tp        the owner thread
+ * @return              The calculated priority.
+ *
+ * @notapi
+ */
+static tprio_t mtx_get_prio(thread_t *tp) {
+  tprio_t newprio = tp->realprio;
+  mutex_t *lmp = tp->mtxlist;
+
+#if CH_CFG_USE_RESERVATIONS == TRUE
+  if ((tp->reservation != NULL) && tp->reservation->throttled &&
+      (newprio > CH_CFG_RES_THROTTLE_PRIORITY)) {
+    tp->resprio = newprio;
+    newprio = CH_CFG_RES_THROTTLE_PRIORITY;
+  }
+#endif
+
+  while (lmp != NULL) {
+    /* If the highest priority thread waiting in the mutexes list has a
+       greater priority than the current thread base priority then the
+       final priority will have at least that priority.*/
+    if (chMtxQueueNotEmptyS(lmp) &&
+        (((thread_t *)lmp->queue.next)->hdr.pqueue.prio > newprio)) {
+      newprio = ((thread_t *)lmp->queue.next)->hdr.pqueue.prio;
+    }
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+    if (lmp->ceiling > newprio) {
+      newprio = lmp->ceiling;
+    }
+#endif
+    lmp = lmp->next;
+  }
+
+  return newprio;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
+/**
+ * @brief   Calculates the priority of a mutexes owner.
+ * @details Used when the priority of a thread waiting on a mutex is
+ *          changed outside of this module.
+ *
+ * @param[in] tp        the owner thread
+ * @return              The calculated priority.
+ *
+ * @notapi
+ */
+tprio_t __mtx_get_prio(thread_t *tp) {
+
+  return mtx_get_prio(tp);
+}
+
 /**
  * @brief   Initializes s @p mutex_t structure.
  *
@@ -109,7 +224,37 @@ void chMtxObjectInit(mutex_t *mp) {
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   mp->cnt = (cnt_t)0;
 #endif
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+  mp->ceiling = NOPRIO;
+#endif
+}
+
+#if (CH_CFG_USE_MUTEXES_CEILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p mutex_t structure as a priority ceiling mutex.
+ * @details The owner of a priority ceiling mutex immediately runs at the
+ *          ceiling priority, other threads locking the mutex cannot run
+ *          while it is owned so there is no contention and no priority
+ *          inheritance.
+ * @note    The ceiling must be higher or equal than the priority of any
+ *          thread locking the mutex.
+ * @note    A thread owning a priority ceiling mutex must not wait for other
+ *          threads, in case of contention the mutex falls back to the
+ *          priority inheritance mechanism.
+ *
+ * @param[out] mp       pointer to a @p mutex_t structure
+ * @param[in] ceiling   the ceiling priority
+ *
+ * @init
+ */
+void chMtxCeilingObjectInit(mutex_t *mp, tprio_t ceiling) {
+
+  chDbgCheck((mp != NULL) && (ceiling > NOPRIO) && (ceiling <= HIGHPRIO));
+
+  chMtxObjectInit(mp);
+  mp->ceiling = ceiling;
 }
+#endif
 
 /**
  * @brief   Locks the specified mutex.
@@ -163,6 +308,8 @@ void chMtxLockS(mutex_t *mp) {
       /* Does the running thread have higher priority than the mutex
          owning thread? */
       while (tp->hdr.pqueue.prio < currtp->hdr.pqueue.prio) {
+        tprio_t oldprio = tp->hdr.pqueue.prio;
+
         /* Make priority of thread tp match the running thread's priority.*/
         tp->hdr.pqueue.prio = currtp->hdr.pqueue.prio;
 
@@ -170,8 +317,7 @@ void chMtxLockS(mutex_t *mp) {
         switch (tp->state) {
         case CH_STATE_WTMTX:
           /* Re-enqueues the mutex owner with its new priority.*/
-          ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue),
-                             &tp->u.wtmtxp->queue);
+          mtx_requeue(tp, &tp->u.wtmtxp->queue);
           tp = tp->u.wtmtxp->owner;
           /*lint -e{9042} [16.1] Continues the while.*/
           continue;
@@ -191,17 +337,19 @@ void chMtxLockS(mutex_t *mp) {
         case CH_STATE_SNDMSGQ:
 #endif
           /* Re-enqueues tp with its new priority on the queue.*/
-          ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue),
-                             &tp->u.wtmtxp->queue);
+          mtx_requeue(tp, &tp->u.wtmtxp->queue);
           break;
 #endif
         case CH_STATE_READY:
+          /* Removing tp from the ready list, the old priority is required
+             in order to update the ready list index.*/
+          (void) __sch_ready_remove(currcore, tp, oldprio);
 #if CH_DBG_ENABLE_ASSERTS == TRUE
           /* Prevents an assertion in chSchReadyI().*/
           tp->state = CH_STATE_CURRENT;
 #endif
           /* Re-enqueues tp with its new priority on the ready list.*/
-          (void) chSchReadyI((thread_t *)ch_queue_dequeue(&tp->hdr.queue));
+          (void) chSchReadyI(tp);
           break;
         default:
           /* Nothing to do for other states.*/
@@ -213,7 +361,7 @@ void chMtxLockS(mutex_t *mp) {
       /* Sleep on the mutex.*/
       ch_sch_prio_insert(&currtp->hdr.queue, &mp->queue);
       currtp->u.wtmtxp = mp;
-      chSchGoSleepS(CH_STATE_WTMTX);
+      __sch_wait_s(CH_STATE_WTMTX, mp);
 
       /* It is assumed that the thread performing the unlock operation assigns
          the mutex to this thread.*/
@@ -234,6 +382,7 @@ void chMtxLockS(mutex_t *mp) {
     mp->owner = currtp;
     mp->next = currtp->mtxlist;
     currtp->mtxlist = mp;
+    mtx_raise(mp, currtp);
   }
 }
 
@@ -308,6 +457,7 @@ bool chMtxTryLockS(mutex_t *mp) {
   mp->owner = currtp;
   mp->next = currtp->mtxlist;
   currtp->mtxlist = mp;
+  mtx_raise(mp, currtp);
   return true;
 }
 
@@ -325,7 +475,6 @@ bool chMtxTryLockS(mutex_t *mp) {
  */
 void chMtxUnlock(mutex_t *mp) {
   thread_t *currtp = chThdGetSelfX();
-  mutex_t *lmp;
 
   chDbgCheck(mp != NULL);
 
@@ -350,24 +499,9 @@ void chMtxUnlock(mutex_t *mp) {
     if (chMtxQueueNotEmptyS(mp)) {
       thread_t *tp;
 
-      /* Recalculates the optimal thread priority by scanning the owned
-         mutexes list.*/
-      tprio_t newprio = currtp->realprio;
-      lmp = currtp->mtxlist;
-      while (lmp != NULL) {
-        /* If the highest priority thread waiting in the mutexes list has a
-           greater priority than the current thread base priority then the
-           final priority will have at least that priority.*/
-        if (chMtxQueueNotEmptyS(lmp) &&
-            (((thread_t *)lmp->queue.next)->hdr.pqueue.prio > newprio)) {
-          newprio = ((thread_t *)lmp->queue.next)->hdr.pqueue.prio;
-        }
-        lmp = lmp->next;
-      }
-
       /* Assigns to the current thread the highest priority among all the
-         waiting threads.*/
-      currtp->hdr.pqueue.prio = newprio;
+         waiting threads and the ceilings of the still owned mutexes.*/
+      currtp->hdr.pqueue.prio = mtx_get_prio(currtp);
 
       /* Awakens the highest priority thread waiting for the unlocked mutex and
          assigns the mutex to it.*/
@@ -378,6 +512,7 @@ void chMtxUnlock(mutex_t *mp) {
       mp->owner = tp;
       mp->next = tp->mtxlist;
       tp->mtxlist = mp;
+      mtx_raise(mp, tp);
 
       /* Note, not using chSchWakeupS() because that function expects the
          current thread to have the higher or equal priority than the ones
@@ -388,6 +523,14 @@ void chMtxUnlock(mutex_t *mp) {
     }
     else {
       mp->owner = NULL;
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+      /* Leaving the ceiling, the priority returns to the one required by
+         the still owned mutexes.*/
+      if (mp->ceiling != NOPRIO) {
+        currtp->hdr.pqueue.prio = mtx_get_prio(currtp);
+        chSchRescheduleS();
+      }
+#endif
     }
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   }
@@ -412,7 +555,6 @@ void chMtxUnlock(mutex_t *mp) {
  */
 void chMtxUnlockS(mutex_t *mp) {
   thread_t *currtp = chThdGetSelfX();
-  mutex_t *lmp;
 
   chDbgCheckClassS();
   chDbgCheck(mp != NULL);
@@ -436,24 +578,9 @@ void chMtxUnlockS(mutex_t *mp) {
     if (chMtxQueueNotEmptyS(mp)) {
       thread_t *tp;
 
-      /* Recalculates the optimal thread priority by scanning the owned
-         mutexes list.*/
-      tprio_t newprio = currtp->realprio;
-      lmp = currtp->mtxlist;
-      while (lmp != NULL) {
-        /* If the highest priority thread waiting in the mutexes list has a
-           greater priority than the current thread base priority then the
-           final priority will have at least that priority.*/
-        if (chMtxQueueNotEmptyS(lmp) &&
-            (((thread_t *)lmp->queue.next)->hdr.pqueue.prio > newprio)) {
-          newprio = ((thread_t *)lmp->queue.next)->hdr.pqueue.prio;
-        }
-        lmp = lmp->next;
-      }
-
       /* Assigns to the current thread the highest priority among all the
-         waiting threads.*/
-      currtp->hdr.pqueue.prio = newprio;
+         waiting threads and the ceilings of the still owned mutexes.*/
+      currtp->hdr.pqueue.prio = mtx_get_prio(currtp);
 
       /* Awakens the highest priority thread waiting for the unlocked mutex and
          assigns the mutex to it.*/
@@ -464,10 +591,18 @@ void chMtxUnlockS(mutex_t *mp) {
       mp->owner = tp;
       mp->next = tp->mtxlist;
       tp->mtxlist = mp;
+      mtx_raise(mp, tp);
       (void) chSchReadyI(tp);
     }
     else {
       mp->owner = NULL;
+#if CH_CFG_USE_MUTEXES_CEILING == TRUE
+      /* Leaving the ceiling, the priority returns to the one required by
+         the still owned mutexes.*/
+      if (mp->ceiling != NOPRIO) {
+        currtp->hdr.pqueue.prio = mtx_get_prio(currtp);
+      }
+#endif
     }
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   }
@@ -503,6 +638,7 @@ void chMtxUnlockAllS(void) {
         mp->owner   = tp;
         mp->next    = tp->mtxlist;
         tp->mtxlist = mp;
+        mtx_raise(mp, tp);
         (void) chSchReadyI(tp);
       }
       else {
@@ -512,7 +648,7 @@ void chMtxUnlockAllS(void) {
         mp->owner = NULL;
       }
     } while (currtp->mtxlist != NULL);
-    currtp->hdr.pqueue.prio = currtp->realprio;
+    currtp->hdr.pqueue.prio = mtx_get_prio(currtp);
     chSchRescheduleS();
   }
 }
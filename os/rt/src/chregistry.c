@@ -40,6 +40,19 @@
  *          terminating threads can pulse an event source and an event handler
  *          can perform a scansion of the registry in order to recover the
  *          memory.
+ *          <h2>Threads IDs</h2>
+ *          If @p CH_CFG_REGISTRY_ID_SLOTS is greater than zero then each
+ *          registered thread is also assigned a numeric ID stored in a table
+ *          indexed by the low bits of the ID itself:
+ *          - <b>FindById</b>, returns the thread having the specified ID
+ *            in constant time.
+ *          - <b>GetThreadInfo</b>, copies the information of the registered
+ *            threads one at time, the kernel is locked for a single copy
+ *            and no references are taken so monitoring threads do not
+ *            disturb the other threads.
+ *          .
+ *          IDs are assigned sequentially so a terminated thread ID is not
+ *          reused until all the other table slots have been used.
  * @pre     In order to use the threads registry the @p CH_CFG_USE_REGISTRY
  *          option must be enabled in @p chconf.h.
  * @{
@@ -93,7 +106,11 @@ ROMCONST chdebug_t ch_debug = {
   (uint8_t)_offsetof(thread_t, hdr.pqueue.prio),
   (uint8_t)_offsetof(thread_t, ctx),
   (uint8_t)_offsetof(thread_t, newer),
+#if CH_CFG_COMPACT_OBJECTS == FALSE
   (uint8_t)_offsetof(thread_t, older),
+#else
+  (uint8_t)0,
+#endif
   (uint8_t)_offsetof(thread_t, name),
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
   (uint8_t)_offsetof(thread_t, wabase),
@@ -263,6 +280,186 @@ thread_t *chRegFindThreadByWorkingArea(stkalign_t *wa) {
 }
 #endif
 
+#if (CH_CFG_COMPACT_OBJECTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Unlinks a thread from the single linked registry list.
+ * @details The previous thread is found scanning the list from the oldest
+ *          thread.
+ * @note    This is an internal functions, do not use it in application code.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+void __reg_unlink(thread_t *tp) {
+  ready_list_t *rlp = &tp->owner->rlist;
+  /*lint -save -e9087 -e740 [11.3, 1.3] Cast required by list handling.*/
+  thread_t *ptp = (thread_t *)rlp;
+  /*lint -restore*/
+
+  while (ptp->newer != tp) {
+    ptp = ptp->newer;
+  }
+  ptp->newer = tp->newer;
+  if (rlp->older == tp) {
+    rlp->older = ptp;
+  }
+}
+#endif
+
+#if (CH_CFG_REGISTRY_ID_SLOTS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes the threads IDs table of an OS instance.
+ * @note    This is an internal functions, do not use it in application code.
+ *
+ * @param[out] oip      pointer to the OS instance
+ *
+ * @notapi
+ */
+void __reg_id_init(os_instance_t *oip) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)CH_CFG_REGISTRY_ID_SLOTS; i++) {
+    oip->regids[i] = NULL;
+  }
+
+  /* IDs below the table size are never assigned so zero is not a valid
+     ID.*/
+  oip->regseq = (ucnt_t)CH_CFG_REGISTRY_ID_SLOTS;
+}
+
+/**
+ * @brief   Assigns an ID to a thread being registered.
+ * @note    This is an internal functions, do not use it in application code.
+ * @note    If the table is full then the thread ID is zero and the thread
+ *          cannot be found by ID.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+void __reg_id_assign(os_instance_t *oip, thread_t *tp) {
+  unsigned i;
+
+  tp->id = (ucnt_t)0;
+  for (i = 0U; i < (unsigned)CH_CFG_REGISTRY_ID_SLOTS; i++) {
+    ucnt_t id = oip->regseq;
+    thread_t **slotp;
+
+    slotp = &oip->regids[id & ((ucnt_t)CH_CFG_REGISTRY_ID_SLOTS - 1U)];
+    oip->regseq++;
+    if (oip->regseq == (ucnt_t)0) {
+      oip->regseq = (ucnt_t)CH_CFG_REGISTRY_ID_SLOTS;
+    }
+    if (*slotp == NULL) {
+      *slotp = tp;
+      tp->id = id;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief   Releases the ID of a thread being removed from the registry.
+ * @note    This is an internal functions, do not use it in application code.
+ *
+ * @param[in] tp        pointer to the thread
+ *
+ * @notapi
+ */
+void __reg_id_release(thread_t *tp) {
+  ucnt_t slot = tp->id & ((ucnt_t)CH_CFG_REGISTRY_ID_SLOTS - 1U);
+
+  if (tp->id != (ucnt_t)0) {
+    tp->owner->regids[slot] = NULL;
+  }
+}
+
+/**
+ * @brief   Retrieves a thread pointer by ID.
+ * @details The search is a single table lookup.
+ * @note    The reference counter of the found thread is increased by one so
+ *          it cannot be disposed incidentally after the pointer has been
+ *          returned.
+ *
+ * @param[in] id        the thread ID
+ * @return              A pointer to the found thread.
+ * @retval NULL         if a matching thread has not been found.
+ *
+ * @api
+ */
+thread_t *chRegFindThreadById(ucnt_t id) {
+  thread_t *tp;
+
+  chSysLock();
+  tp = currcore->regids[id & ((ucnt_t)CH_CFG_REGISTRY_ID_SLOTS - 1U)];
+  if ((tp != NULL) && (tp->id == id)) {
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chDbgAssert(tp->refs < (trefs_t)255, "too many references");
+    tp->refs++;
+#endif
+  }
+  else {
+    tp = NULL;
+  }
+  chSysUnlock();
+
+  return tp;
+}
+
+/**
+ * @brief   Returns information about the next registered thread.
+ * @details The IDs table is scanned starting from the position specified
+ *          by the cursor, the information of the first registered thread
+ *          found is copied and the cursor is advanced past it. The kernel
+ *          is locked only while examining a single table slot and no
+ *          references are taken.
+ * @note    The cursor must be initialized to zero before starting a scan.
+ * @note    Threads created or terminated during a scan may or may not be
+ *          reported.
+ *
+ * @param[in,out] cursorp   pointer to the scan cursor
+ * @param[out] rip          pointer to the information record to be filled
+ * @return                  The operation status.
+ * @retval true             if a thread has been found and @p rip filled.
+ * @retval false            if the scan is finished.
+ *
+ * @api
+ */
+bool chRegGetThreadInfo(ucnt_t *cursorp, reg_thread_info_t *rip) {
+  os_instance_t *oip = currcore;
+
+  while (*cursorp < (ucnt_t)CH_CFG_REGISTRY_ID_SLOTS) {
+    thread_t *tp;
+
+    chSysLock();
+    tp = oip->regids[*cursorp];
+    if (tp != NULL) {
+      rip->id      = tp->id;
+      rip->name    = tp->name;
+      rip->prio    = tp->hdr.pqueue.prio;
+      rip->state   = tp->state;
+      rip->flags   = tp->flags;
+#if CH_DBG_STACK_WATERMARK == TRUE
+      rip->wmargin = tp->wmargin;
+#endif
+#if CH_DBG_THREADS_PROFILING == TRUE
+      rip->time    = tp->time;
+#endif
+    }
+    chSysUnlock();
+
+    (*cursorp)++;
+    if (tp != NULL) {
+      return true;
+    }
+  }
+
+  return false;
+}
+#endif /* CH_CFG_REGISTRY_ID_SLOTS > 0 */
+
 #endif /* CH_CFG_USE_REGISTRY == TRUE */
 
 /** @} */
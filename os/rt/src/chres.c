@@ -0,0 +1,507 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    rt/src/chres.c
+ * @brief   CPU budget reservations code.
+ *
+ * @addtogroup reservations
+ * @details A reservation limits the CPU time used by a group of threads,
+ *          each period the threads can run for the budget time then they
+ *          are throttled to @p CH_CFG_RES_THROTTLE_PRIORITY until the
+ *          budget is replenished at the beginning of the next period.
+ *          <br>The CPU time is accounted on context switches with the
+ *          resolution of the system time, the budget exhaustion is
+ *          detected by a virtual timer armed when the group threads run.
+ * @pre     In order to use the reservations APIs the
+ *          @p CH_CFG_USE_RESERVATIONS option must be enabled in
+ *          @p chconf.h.
+ * @note    Threads owning mutexes are not throttled in order to not
+ *          extend the priority inversion of other threads.
+ * @note    Threads waiting on priority ordered queues are not moved when
+ *          their priority changes because throttling.
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_RESERVATIONS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Thread owning a reservation queue element.
+ */
+#define __res_thread(qp)                                                    \
+  /*lint -save -e9005 -e9033 -e413 [11.8, 10.8 1.3] Normal pointers
+    arithmetic, it is safe.*/                                               \
+  ((thread_t *)(void *)((char *)(qp) -                                      \
+   ((char *)&((thread_t *)0)->resqueue - (char *)0)))                       \
+  /*lint -restore*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Changes the priority of a thread.
+ * @details Ready threads are repositioned in the ready list, threads
+ *          waiting in priority ordered queues are repositioned in their
+ *          queue. If the thread is waiting on a mutex then the priority
+ *          of the owner is calculated again, the change is propagated
+ *          along the chain of owners.
+ * @note    Threads waiting to send a message are not repositioned because
+ *          the queue is not reachable from the thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[in] prio      the new priority
+ */
+static void res_set_prio(thread_t *tp, tprio_t prio) {
+
+  while (tp->hdr.pqueue.prio != prio) {
+    tprio_t oldprio = tp->hdr.pqueue.prio;
+
+    tp->hdr.pqueue.prio = prio;
+
+    /* The following states need priority queues reordering.*/
+    switch (tp->state) {
+    case CH_STATE_READY:
+      /* Removing tp from the ready list, the old priority is required
+         in order to update the ready list index.*/
+      (void) __sch_ready_remove(currcore, tp, oldprio);
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+      /* Prevents an assertion in chSchReadyI().*/
+      tp->state = CH_STATE_CURRENT;
+#endif
+      (void) chSchReadyI(tp);
+      return;
+#if CH_CFG_USE_MUTEXES == TRUE
+    case CH_STATE_WTMTX:
+      /* Re-enqueues tp with its new priority then the owner priority is
+         calculated again.*/
+      ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue),
+                         &tp->u.wtmtxp->queue);
+      tp = tp->u.wtmtxp->owner;
+      prio = __mtx_get_prio(tp);
+      /*lint -e{9042} [16.1] Continues the while.*/
+      continue;
+#endif
+#if (CH_CFG_USE_CONDVARS == TRUE) ||                                        \
+    ((CH_CFG_USE_SEMAPHORES == TRUE) &&                                     \
+     (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE))
+#if CH_CFG_USE_CONDVARS == TRUE
+    case CH_STATE_WTCOND:
+#endif
+#if (CH_CFG_USE_SEMAPHORES == TRUE) &&                                      \
+    (CH_CFG_USE_SEMAPHORES_PRIORITY == TRUE)
+    case CH_STATE_WTSEM:
+#endif
+      /* Re-enqueues tp with its new priority on the queue, the queue
+         header is the first field of the waited object.*/
+      ch_sch_prio_insert(ch_queue_dequeue(&tp->hdr.queue),
+                         (ch_queue_t *)tp->u.wtobjp);
+      return;
+#endif
+    default:
+      /* Nothing to do for other states.*/
+      return;
+    }
+  }
+}
+
+/**
+ * @brief   Charges the CPU time used since the last accounting.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ * @param[in] now       current system time
+ */
+static void res_charge(reservation_t *rsp, systime_t now) {
+  sysinterval_t used = chTimeDiffX(rsp->last, now);
+
+  rsp->last  = now;
+  rsp->used += used;
+  if (used < rsp->remaining) {
+    rsp->remaining -= used;
+  }
+  else {
+    rsp->remaining = (sysinterval_t)0;
+  }
+}
+
+/**
+ * @brief   Throttles the threads of an exhausted reservation.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ */
+static void res_throttle(reservation_t *rsp) {
+  ch_queue_t *qp = rsp->threads.next;
+
+  rsp->throttled = true;
+  rsp->stats.throttles++;
+
+  while (qp != &rsp->threads) {
+    thread_t *tp = __res_thread(qp);
+
+    qp = qp->next;
+    tp->resprio = NOPRIO;
+#if CH_CFG_USE_MUTEXES == TRUE
+    if (tp->mtxlist != NULL) {
+      continue;
+    }
+#endif
+    if (tp->hdr.pqueue.prio > CH_CFG_RES_THROTTLE_PRIORITY) {
+      tp->resprio = tp->hdr.pqueue.prio;
+      res_set_prio(tp, CH_CFG_RES_THROTTLE_PRIORITY);
+    }
+  }
+}
+
+/**
+ * @brief   Restores the threads of a replenished reservation.
+ * @note    Threads whose priority changed while throttled keep the new
+ *          priority.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ */
+static void res_unthrottle(reservation_t *rsp) {
+  ch_queue_t *qp = rsp->threads.next;
+
+  rsp->throttled = false;
+
+  while (qp != &rsp->threads) {
+    thread_t *tp = __res_thread(qp);
+
+    qp = qp->next;
+    if ((tp->resprio != NOPRIO) &&
+        (tp->hdr.pqueue.prio == CH_CFG_RES_THROTTLE_PRIORITY)) {
+      res_set_prio(tp, tp->resprio);
+    }
+    tp->resprio = NOPRIO;
+  }
+}
+
+/**
+ * @brief   Budget enforcement timer callback.
+ *
+ * @param[in] p         pointer to the @p reservation_t structure
+ */
+static void res_enforce_cb(void *p) {
+  reservation_t *rsp = (reservation_t *)p;
+
+  chSysLockFromISR();
+
+  /* Only relevant if a thread of the group is running, else the timer is
+     armed again when one of the threads is switched in.*/
+  if (chThdGetSelfX()->reservation == rsp) {
+    res_charge(rsp, chVTGetSystemTimeX());
+    if (rsp->remaining == (sysinterval_t)0) {
+      if (!rsp->throttled) {
+        res_throttle(rsp);
+      }
+    }
+    else {
+      chVTDoSetI(&rsp->evt, rsp->remaining, res_enforce_cb, p);
+    }
+  }
+
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Arms the enforcement timer if not already armed.
+ * @details The timer expires when the budget would be exhausted if the
+ *          group threads used all the CPU time from now.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ */
+static void res_arm_enforcement(reservation_t *rsp) {
+
+  if (!rsp->throttled && chVTIsArmedI(&rsp->rvt) &&
+      !chVTIsArmedI(&rsp->evt)) {
+    sysinterval_t delay = rsp->remaining;
+
+    if (delay == (sysinterval_t)0) {
+      delay = (sysinterval_t)1;
+    }
+    chVTDoSetI(&rsp->evt, delay, res_enforce_cb, (void *)rsp);
+  }
+}
+
+/**
+ * @brief   Budget replenishment timer callback.
+ *
+ * @param[in] p         pointer to the @p reservation_t structure
+ */
+static void res_replenish_cb(void *p) {
+  reservation_t *rsp = (reservation_t *)p;
+  bool running;
+
+  chSysLockFromISR();
+
+  /* Closing the accounting of the period.*/
+  running = (bool)(chThdGetSelfX()->reservation == rsp);
+  if (running) {
+    res_charge(rsp, chVTGetSystemTimeX());
+  }
+  if (rsp->used > rsp->stats.maxused) {
+    rsp->stats.maxused = rsp->used;
+  }
+  rsp->used      = (sysinterval_t)0;
+  rsp->remaining = rsp->budget;
+
+  /* Next period.*/
+  chVTDoSetI(&rsp->rvt, rsp->period, res_replenish_cb, (void *)rsp);
+
+  if (rsp->throttled) {
+    res_unthrottle(rsp);
+  }
+  if (running) {
+    res_arm_enforcement(rsp);
+  }
+
+  chSysUnlockFromISR();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Context switch accounting.
+ * @details The CPU time is charged to the reservation of the thread being
+ *          switched out, the enforcement timer of the reservation of the
+ *          thread being switched in is armed.
+ * @note    Switches between threads of the same reservation are not
+ *          accounted, the CPU time is charged on the first switch out of
+ *          the group.
+ *
+ * @param[in] ntp       the thread to be switched in
+ * @param[in] otp       the thread to be switched out
+ *
+ * @notapi
+ */
+void __res_account(thread_t *ntp, thread_t *otp) {
+  reservation_t *orsp = otp->reservation;
+  reservation_t *nrsp = ntp->reservation;
+  systime_t now;
+
+  if (orsp == nrsp) {
+    return;
+  }
+
+  now = chVTGetSystemTimeX();
+  if (orsp != NULL) {
+    res_charge(orsp, now);
+  }
+  if (nrsp != NULL) {
+    nrsp->last = now;
+    res_arm_enforcement(nrsp);
+  }
+}
+
+/**
+ * @brief   Removes a thread from its reservation.
+ * @details The CPU time used by the thread is charged and the thread
+ *          priority is restored if throttled.
+ * @note    The thread must be the current one.
+ *
+ * @param[in] tp        the thread
+ *
+ * @notapi
+ */
+void __res_leave(thread_t *tp) {
+  reservation_t *rsp = tp->reservation;
+
+  res_charge(rsp, chVTGetSystemTimeX());
+
+  (void) ch_queue_dequeue(&tp->resqueue);
+  tp->reservation = NULL;
+
+  if ((tp->resprio != NOPRIO) &&
+      (tp->hdr.pqueue.prio == CH_CFG_RES_THROTTLE_PRIORITY)) {
+    tp->hdr.pqueue.prio = tp->resprio;
+  }
+  tp->resprio = NOPRIO;
+}
+
+/**
+ * @brief   Initializes a @p reservation_t structure.
+ *
+ * @param[out] rsp      pointer to the @p reservation_t structure
+ * @param[in] budget    CPU time budget for each period
+ * @param[in] period    replenishment period
+ *
+ * @init
+ */
+void chResObjectInit(reservation_t *rsp,
+                     sysinterval_t budget,
+                     sysinterval_t period) {
+
+  chDbgCheck((rsp != NULL) && (budget > (sysinterval_t)0) &&
+             (budget <= period) && (period != TIME_INFINITE));
+
+  ch_queue_init(&rsp->threads);
+  rsp->budget          = budget;
+  rsp->period          = period;
+  rsp->remaining       = budget;
+  rsp->used            = (sysinterval_t)0;
+  rsp->last            = (systime_t)0;
+  rsp->throttled       = false;
+  chVTObjectInit(&rsp->rvt);
+  chVTObjectInit(&rsp->evt);
+  rsp->stats.throttles = (ucnt_t)0;
+  rsp->stats.maxused   = (sysinterval_t)0;
+}
+
+/**
+ * @brief   Starts the budget enforcement of a reservation.
+ * @details The first period starts immediately with a full budget.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ *
+ * @api
+ */
+void chResStart(reservation_t *rsp) {
+
+  chDbgCheck(rsp != NULL);
+
+  chSysLock();
+  chDbgAssert(!chVTIsArmedI(&rsp->rvt), "already started");
+
+  rsp->remaining = rsp->budget;
+  rsp->used      = (sysinterval_t)0;
+  rsp->last      = chVTGetSystemTimeX();
+  chVTDoSetI(&rsp->rvt, rsp->period, res_replenish_cb, (void *)rsp);
+  if (chThdGetSelfX()->reservation == rsp) {
+    res_arm_enforcement(rsp);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stops the budget enforcement of a reservation.
+ * @details Throttled threads are restored.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ *
+ * @api
+ */
+void chResStop(reservation_t *rsp) {
+
+  chDbgCheck(rsp != NULL);
+
+  chSysLock();
+  if (chVTIsArmedI(&rsp->rvt)) {
+    chVTDoResetI(&rsp->rvt);
+  }
+  if (chVTIsArmedI(&rsp->evt)) {
+    chVTDoResetI(&rsp->evt);
+  }
+  if (rsp->throttled) {
+    res_unthrottle(rsp);
+  }
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Adds the current thread to a reservation.
+ * @details The thread is throttled immediately if the reservation budget
+ *          is exhausted.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ *
+ * @api
+ */
+void chResJoin(reservation_t *rsp) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chDbgCheck(rsp != NULL);
+
+  chSysLock();
+  chDbgAssert(currtp->reservation == NULL, "already in a reservation");
+
+  ch_queue_insert(&currtp->resqueue, &rsp->threads);
+  currtp->reservation = rsp;
+  currtp->resprio     = NOPRIO;
+  rsp->last           = chVTGetSystemTimeX();
+
+  if (rsp->throttled) {
+    if (currtp->hdr.pqueue.prio > CH_CFG_RES_THROTTLE_PRIORITY) {
+      currtp->resprio         = currtp->hdr.pqueue.prio;
+      currtp->hdr.pqueue.prio = CH_CFG_RES_THROTTLE_PRIORITY;
+      chSchRescheduleS();
+    }
+  }
+  else {
+    res_arm_enforcement(rsp);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Removes the current thread from its reservation.
+ * @details The thread priority is restored if throttled.
+ *
+ * @api
+ */
+void chResLeave(void) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chSysLock();
+  chDbgAssert(currtp->reservation != NULL, "not in a reservation");
+
+  __res_leave(currtp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the statistics of a reservation.
+ *
+ * @param[in] rsp       pointer to the @p reservation_t structure
+ * @param[out] rssp     pointer to the statistics to be filled
+ *
+ * @api
+ */
+void chResGetStats(reservation_t *rsp, res_stats_t *rssp) {
+
+  chDbgCheck((rsp != NULL) && (rssp != NULL));
+
+  chSysLock();
+  *rssp = rsp->stats;
+  chSysUnlock();
+}
+
+#endif /* CH_CFG_USE_RESERVATIONS == TRUE */
+
+/** @} */
@@ -0,0 +1,343 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    rt/src/chrwlock.c
+ * @brief   Reader-Writer Locks code.
+ *
+ * @addtogroup rwlocks
+ * @details This module implements the Reader-Writer Locks mechanism.
+ *          Reader-writer locks are an extension to the mutex subsystem and
+ *          cannot work alone.
+ *          <h2>Operation mode</h2>
+ *          A reader-writer lock can be held by any number of readers or by
+ *          a single writer.<br>
+ *          Writers are serialized by an internal mutex so the priority
+ *          inheritance protocol applies among writers, a writer owns the
+ *          mutex while waiting for the active readers to leave.<br>
+ *          Writers have precedence, new readers are blocked while a writer
+ *          is active or waiting, this prevents writers starvation.
+ * @pre     In order to use the reader-writer locks APIs the
+ *          @p CH_CFG_USE_RWLOCKS option must be enabled in @p chconf.h.
+ * @note    Readers do not take part in the priority inheritance protocol.
+ * @note    The write lock follows the same ordering rules of mutexes, it
+ *          must be released in reverse lock order with respect to other
+ *          owned mutexes.
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_CFG_USE_RWLOCKS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes s @p rwlock_t structure.
+ *
+ * @param[out] rwp      pointer to a @p rwlock_t structure
+ *
+ * @init
+ */
+void chRWLockObjectInit(rwlock_t *rwp) {
+
+  chDbgCheck(rwp != NULL);
+
+  chMtxObjectInit(&rwp->wmtx);
+  chThdQueueObjectInit(&rwp->qr);
+  chThdQueueObjectInit(&rwp->qw);
+  rwp->readers = (cnt_t)0;
+}
+
+/**
+ * @brief   Locks the specified reader-writer lock for reading.
+ * @details The invoking thread waits while a writer is active or waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWLockReadLock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWLockReadLockS(rwp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Locks the specified reader-writer lock for reading.
+ * @details The invoking thread waits while a writer is active or waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWLockReadLockS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  /* Writers have precedence, waiting until no writer owns the mutex.*/
+  while (rwp->wmtx.owner != NULL) {
+    (void) chThdEnqueueTimeoutS(&rwp->qr, TIME_INFINITE);
+  }
+  rwp->readers++;
+}
+
+/**
+ * @brief   Tries to lock the specified reader-writer lock for reading.
+ * @details This function attempts to lock the reader-writer lock for
+ *          reading, if a writer is active or waiting then the function
+ *          exits without waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ * @return              The operation status.
+ * @retval true         if the lock has been successfully acquired
+ * @retval false        if the lock was not acquired.
+ *
+ * @api
+ */
+bool chRWLockTryRead(rwlock_t *rwp) {
+  bool b;
+
+  chSysLock();
+  b = chRWLockTryReadS(rwp);
+  chSysUnlock();
+
+  return b;
+}
+
+/**
+ * @brief   Tries to lock the specified reader-writer lock for reading.
+ * @details This function attempts to lock the reader-writer lock for
+ *          reading, if a writer is active or waiting then the function
+ *          exits without waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ * @return              The operation status.
+ * @retval true         if the lock has been successfully acquired
+ * @retval false        if the lock was not acquired.
+ *
+ * @sclass
+ */
+bool chRWLockTryReadS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  if (rwp->wmtx.owner != NULL) {
+    return false;
+  }
+  rwp->readers++;
+
+  return true;
+}
+
+/**
+ * @brief   Unlocks the specified reader-writer lock held for reading.
+ * @details The last leaving reader wakes up the waiting writer, if any.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWLockReadUnlock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWLockReadUnlockS(rwp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Unlocks the specified reader-writer lock held for reading.
+ * @details The last leaving reader wakes up the waiting writer, if any.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWLockReadUnlockS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+  chDbgAssert(rwp->readers > (cnt_t)0, "not locked");
+
+  rwp->readers--;
+  if (rwp->readers == (cnt_t)0) {
+    chThdDequeueNextI(&rwp->qw, MSG_OK);
+  }
+}
+
+/**
+ * @brief   Locks the specified reader-writer lock for writing.
+ * @details The invoking thread first takes the writers mutex, then waits
+ *          for the active readers to leave.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWLockWriteLock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWLockWriteLockS(rwp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Locks the specified reader-writer lock for writing.
+ * @details The invoking thread first takes the writers mutex, then waits
+ *          for the active readers to leave.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWLockWriteLockS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  /* Serialization among writers, priority inheritance applies here.*/
+  chMtxLockS(&rwp->wmtx);
+
+  /* New readers are now blocked, waiting for the active ones to leave.*/
+  while (rwp->readers > (cnt_t)0) {
+    (void) chThdEnqueueTimeoutS(&rwp->qw, TIME_INFINITE);
+  }
+}
+
+/**
+ * @brief   Tries to lock the specified reader-writer lock for writing.
+ * @details This function attempts to lock the reader-writer lock for
+ *          writing, if readers or another writer hold the lock then the
+ *          function exits without waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ * @return              The operation status.
+ * @retval true         if the lock has been successfully acquired
+ * @retval false        if the lock was not acquired.
+ *
+ * @api
+ */
+bool chRWLockTryWrite(rwlock_t *rwp) {
+  bool b;
+
+  chSysLock();
+  b = chRWLockTryWriteS(rwp);
+  chSysUnlock();
+
+  return b;
+}
+
+/**
+ * @brief   Tries to lock the specified reader-writer lock for writing.
+ * @details This function attempts to lock the reader-writer lock for
+ *          writing, if readers or another writer hold the lock then the
+ *          function exits without waiting.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ * @return              The operation status.
+ * @retval true         if the lock has been successfully acquired
+ * @retval false        if the lock was not acquired.
+ *
+ * @sclass
+ */
+bool chRWLockTryWriteS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+
+  if ((rwp->readers > (cnt_t)0) || (rwp->wmtx.owner != NULL)) {
+    return false;
+  }
+
+  return chMtxTryLockS(&rwp->wmtx);
+}
+
+/**
+ * @brief   Unlocks the specified reader-writer lock held for writing.
+ * @details The lock is passed to the next waiting writer, if any, else the
+ *          waiting readers are released.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @api
+ */
+void chRWLockWriteUnlock(rwlock_t *rwp) {
+
+  chSysLock();
+  chRWLockWriteUnlockS(rwp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Unlocks the specified reader-writer lock held for writing.
+ * @details The lock is passed to the next waiting writer, if any, else the
+ *          waiting readers are released.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel.
+ *
+ * @param[in] rwp       pointer to the @p rwlock_t structure
+ *
+ * @sclass
+ */
+void chRWLockWriteUnlockS(rwlock_t *rwp) {
+
+  chDbgCheckClassS();
+  chDbgCheck(rwp != NULL);
+  chDbgAssert(rwp->readers == (cnt_t)0, "readers active");
+
+  chMtxUnlockS(&rwp->wmtx);
+
+  /* If no other writer took the mutex then the readers are released.*/
+  if (rwp->wmtx.owner == NULL) {
+    chThdDequeueAllI(&rwp->qr, MSG_OK);
+  }
+}
+
+#endif /* CH_CFG_USE_RWLOCKS == TRUE */
+
+/** @} */
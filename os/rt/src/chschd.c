@@ -32,6 +32,28 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+/*
+ * Ready list operations, when the bitmap index is not enabled the ready
+ * list is a simple priority queue.
+ */
+#if (CH_CFG_USE_BITMAP_READYLIST == FALSE) || defined(__DOXYGEN__)
+#define __sch_rlist_init(rlp)                                               \
+  ch_pqueue_init(&(rlp)->pqueue)
+#define __sch_rlist_remove_highest(rlp)                                     \
+  ch_pqueue_remove_highest(&(rlp)->pqueue)
+#define __sch_rlist_insert_behind(rlp, p)                                   \
+  ch_pqueue_insert_behind(&(rlp)->pqueue, p)
+#define __sch_rlist_insert_ahead(rlp, p)                                    \
+  ch_pqueue_insert_ahead(&(rlp)->pqueue, p)
+#endif
+
+/*
+ * Leading zeros count, the port can provide an accelerated implementation.
+ */
+#if (CH_CFG_USE_BITMAP_READYLIST == TRUE) && defined(port_clz32)
+#define __sch_clz32(n)                  ((uint32_t)port_clz32(n))
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -48,6 +70,64 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Idle governor.
+ * @details The deepest low power state that can be entered and exited before
+ *          the next virtual timer deadline is selected, the system alarm is
+ *          anticipated by the state exit latency so that the deadline is
+ *          met. If no state fits then the processor just waits for an
+ *          interrupt.
+ * @note    An anticipated alarm is harmless, the timers processing
+ *          reprograms the alarm on the actual deadline.
+ *
+ * @param[in] oip       pointer to the OS instance
+ *
+ * @notapi
+ */
+static void __idle_governor(os_instance_t *oip) {
+  const idle_state_t *isp = NULL;
+  sysinterval_t next;
+  bool armed;
+  unsigned i;
+
+  chSysLock();
+
+  armed = chVTGetTimersStateI(&next);
+
+  /* States are ordered by increasing depth, the search starts from the
+     deepest one.*/
+  for (i = oip->idle_nstates; i > 0U; i--) {
+    const idle_state_t *sp = &oip->idle_states[i - 1U];
+
+    if (!armed ||
+        (next > (sp->entry_latency + sp->exit_latency +
+                 (sysinterval_t)CH_CFG_ST_TIMEDELTA))) {
+      isp = sp;
+      break;
+    }
+  }
+
+  /* Compensating the wakeup latency.*/
+  if (armed && (isp != NULL) && (isp->exit_latency > (sysinterval_t)0)) {
+    port_timer_set_alarm(chTimeAddX(chVTGetSystemTimeX(),
+                                    next - isp->exit_latency));
+  }
+
+  chSysUnlock();
+
+  if (isp != NULL) {
+    isp->enter();
+  }
+  else {
+    /*lint -save -e522 [2.2] Apparently no side effects because it contains
+      an asm instruction.*/
+    port_wait_for_interrupt();
+    /*lint -restore*/
+  }
+}
+#endif /* CH_CFG_USE_IDLE_GOVERNOR == TRUE */
+
 #if (CH_CFG_NO_IDLE_THREAD == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   This function implements the idle thread infinite loop.
@@ -64,15 +144,435 @@ static void __idle_thread(void *p) {
   (void)p;
 
   while (true) {
+#if CH_CFG_USE_IDLE_GOVERNOR == TRUE
+    __idle_governor(currcore);
+#else
     /*lint -save -e522 [2.2] Apparently no side effects because it contains
       an asm instruction.*/
     port_wait_for_interrupt();
     /*lint -restore*/
+#endif
     CH_CFG_IDLE_LOOP_HOOK();
   }
 }
 #endif /* CH_CFG_NO_IDLE_THREAD == FALSE */
 
+#if (CH_CFG_USE_BITMAP_READYLIST == TRUE) || defined(__DOXYGEN__)
+#if !defined(__sch_clz32) || defined(__DOXYGEN__)
+/**
+ * @brief   Portable leading zeros count.
+ * @note    The value zero is not allowed.
+ *
+ * @param[in] n         the value to be scanned
+ * @return              The number of leading zero bits.
+ *
+ * @notapi
+ */
+static inline uint32_t __sch_clz32(uint32_t n) {
+  uint32_t c = 0U;
+
+  if ((n & 0xFFFF0000U) == 0U) {
+    c += 16U;
+    n <<= 16;
+  }
+  if ((n & 0xFF000000U) == 0U) {
+    c += 8U;
+    n <<= 8;
+  }
+  if ((n & 0xF0000000U) == 0U) {
+    c += 4U;
+    n <<= 4;
+  }
+  if ((n & 0xC0000000U) == 0U) {
+    c += 2U;
+    n <<= 2;
+  }
+  if ((n & 0x80000000U) == 0U) {
+    c += 1U;
+  }
+
+  return c;
+}
+#endif
+
+/**
+ * @brief   Ready list initialization.
+ * @note    The priority zero level is permanently marked as non-empty, its
+ *          head is the list header itself.
+ *
+ * @param[out] rlp      pointer to the ready list
+ *
+ * @notapi
+ */
+static void __sch_rlist_init(ready_list_t *rlp) {
+  unsigned i;
+
+  ch_pqueue_init(&rlp->pqueue);
+  for (i = 0U; i < CH_RLIST_MAP_WORDS; i++) {
+    rlp->prmap[i] = 0U;
+  }
+  rlp->prmap[0]   = 1U;
+  rlp->prsummary  = 1U;
+  rlp->prheads[0] = &rlp->pqueue;
+}
+
+/**
+ * @brief   Returns the highest non-empty priority level below the specified
+ *          one.
+ * @note    The search always succeeds because the priority zero level is
+ *          never empty.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] prio      the priority level, must be greater than zero
+ * @return              The non-empty priority level.
+ *
+ * @notapi
+ */
+static inline tprio_t __sch_rlist_lower(const ready_list_t *rlp,
+                                        tprio_t prio) {
+  uint32_t w = (uint32_t)prio >> 5;
+  uint32_t m = rlp->prmap[w] & ((1U << ((uint32_t)prio & 31U)) - 1U);
+
+  if (m == 0U) {
+    w = 31U - __sch_clz32(rlp->prsummary & ((1U << w) - 1U));
+    m = rlp->prmap[w];
+  }
+
+  return (tprio_t)((w << 5) + (31U - __sch_clz32(m)));
+}
+
+/**
+ * @brief   Marks a priority level as non-empty.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void __sch_rlist_set(ready_list_t *rlp, tprio_t prio) {
+  uint32_t w = (uint32_t)prio >> 5;
+
+  rlp->prmap[w] |= 1U << ((uint32_t)prio & 31U);
+  rlp->prsummary |= 1U << w;
+}
+
+/**
+ * @brief   Unlinks the head of a priority level updating the index.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] p         the pointer to the level head
+ * @param[in] prio      the priority level
+ *
+ * @notapi
+ */
+static inline void __sch_rlist_unlink_head(ready_list_t *rlp,
+                                           ch_priority_queue_t *p,
+                                           tprio_t prio) {
+
+  if (p->next->prio == prio) {
+    /* The next element becomes the new level head.*/
+    rlp->prheads[prio] = p->next;
+  }
+  else {
+    /* The level becomes empty.*/
+    uint32_t w = (uint32_t)prio >> 5;
+
+    rlp->prmap[w] &= ~(1U << ((uint32_t)prio & 31U));
+    if (rlp->prmap[w] == 0U) {
+      rlp->prsummary &= ~(1U << w);
+    }
+  }
+}
+
+/**
+ * @brief   Removes the highest priority element from the ready list.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @return              The removed element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_remove_highest(ready_list_t *rlp) {
+  ch_priority_queue_t *p = rlp->pqueue.next;
+
+  __sch_rlist_unlink_head(rlp, p, p->prio);
+
+  rlp->pqueue.next = p->next;
+  p->next->prev    = &rlp->pqueue;
+
+  return p;
+}
+
+/**
+ * @brief   Inserts an element in the ready list placing it behind its peers.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] p         the pointer to the element to be inserted
+ * @return              The inserted element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_insert_behind(ready_list_t *rlp,
+                                                             ch_priority_queue_t *p) {
+  tprio_t prio = p->prio;
+  ch_priority_queue_t *np;
+
+  chDbgAssert((prio > NOPRIO) && (prio < CH_RLIST_PRIO_LEVELS),
+              "invalid priority");
+
+  /* The element goes in front of the first element having lower priority.*/
+  np = rlp->prheads[__sch_rlist_lower(rlp, prio)];
+  if (np->prev->prio != prio) {
+    /* The level was empty.*/
+    rlp->prheads[prio] = p;
+    __sch_rlist_set(rlp, prio);
+  }
+
+  /* Insertion on prev.*/
+  p->next       = np;
+  p->prev       = np->prev;
+  p->prev->next = p;
+  np->prev      = p;
+
+  return p;
+}
+
+/**
+ * @brief   Inserts an element in the ready list placing it ahead of its
+ *          peers.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] p         the pointer to the element to be inserted
+ * @return              The inserted element pointer.
+ *
+ * @notapi
+ */
+static inline ch_priority_queue_t *__sch_rlist_insert_ahead(ready_list_t *rlp,
+                                                            ch_priority_queue_t *p) {
+  tprio_t prio = p->prio;
+  ch_priority_queue_t *np;
+
+  chDbgAssert((prio > NOPRIO) && (prio < CH_RLIST_PRIO_LEVELS),
+              "invalid priority");
+
+  /* The element goes in front of the current level head or, if the level
+     is empty, in front of the first element having lower priority.*/
+  np = rlp->prheads[__sch_rlist_lower(rlp, prio)];
+  if (np->prev->prio == prio) {
+    np = rlp->prheads[prio];
+  }
+  else {
+    __sch_rlist_set(rlp, prio);
+  }
+  rlp->prheads[prio] = p;
+
+  /* Insertion on prev.*/
+  p->next       = np;
+  p->prev       = np->prev;
+  p->prev->next = p;
+  np->prev      = p;
+
+  return p;
+}
+#endif /* CH_CFG_USE_BITMAP_READYLIST == TRUE */
+
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Deadline order of two threads at the deadline class priority.
+ * @details Threads outside the class, at that priority because of priority
+ *          inheritance, precede all the threads in the class.
+ * @note    Deadlines are compared to each other so they must be within half
+ *          of the system time range.
+ *
+ * @param[in] tp1       the first thread
+ * @param[in] tp2       the second thread
+ * @return              The comparison result.
+ * @retval true         if @p tp1 strictly precedes @p tp2.
+ * @retval false        otherwise.
+ *
+ * @notapi
+ */
+static inline bool __sch_edf_precedes(const thread_t *tp1,
+                                      const thread_t *tp2) {
+  sysinterval_t d;
+
+  if (tp2->edf.rdeadline == (sysinterval_t)0) {
+    return false;
+  }
+  if (tp1->edf.rdeadline == (sysinterval_t)0) {
+    return true;
+  }
+
+  d = chTimeDiffX(tp1->edf.deadline, tp2->edf.deadline);
+
+  return (d > (sysinterval_t)0) &&
+         (d <= ((sysinterval_t)TIME_MAX_SYSTIME >> 1));
+}
+
+/**
+ * @brief   Inserts a thread in the deadline class priority level.
+ * @details The level is scanned from its head, the thread is placed in
+ *          deadline order behind or ahead of threads with the same
+ *          deadline.
+ *
+ * @param[in] rlp       pointer to the ready list
+ * @param[in] tp        the thread to be inserted
+ * @param[in] ahead     placement among threads with the same deadline
+ * @return              The inserted element pointer.
+ *
+ * @notapi
+ */
+static ch_priority_queue_t *__sch_rlist_insert_edf(ready_list_t *rlp,
+                                                   thread_t *tp,
+                                                   bool ahead) {
+  ch_priority_queue_t *p = &tp->hdr.pqueue;
+  tprio_t prio = p->prio;
+  ch_priority_queue_t *np;
+
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+  np = rlp->prheads[__sch_rlist_lower(rlp, prio)];
+  if (np->prev->prio == prio) {
+    np = rlp->prheads[prio];
+  }
+  else {
+    __sch_rlist_set(rlp, prio);
+  }
+#else
+  np = rlp->pqueue.next;
+  while (np->prio > prio) {
+    np = np->next;
+  }
+#endif
+
+  /* The scan stops at the first element of lower priority, the header
+     priority is zero so the scan always terminates.*/
+  while ((np->prio == prio) &&
+         (ahead ? __sch_edf_precedes((thread_t *)np, tp) :
+                  !__sch_edf_precedes(tp, (thread_t *)np))) {
+    np = np->next;
+  }
+
+  /* Insertion on prev.*/
+  p->next       = np;
+  p->prev       = np->prev;
+  p->prev->next = p;
+  np->prev      = p;
+
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+  if (p->prev->prio != prio) {
+    rlp->prheads[prio] = p;
+  }
+#endif
+
+  return p;
+}
+#endif /* CH_CFG_USE_EDF == TRUE */
+
+/**
+ * @brief   Scheduling order of a thread compared to another thread.
+ * @details The order is given by the priorities, the deadline class
+ *          priority level is ordered by deadline.
+ *
+ * @param[in] tp1       the first thread
+ * @param[in] tp2       the second thread
+ * @return              The comparison result.
+ * @retval true         if @p tp1 must run before @p tp2.
+ * @retval false        otherwise.
+ *
+ * @notapi
+ */
+static inline bool __sch_thd_higher(const thread_t *tp1,
+                                    const thread_t *tp2) {
+
+#if CH_CFG_USE_EDF == TRUE
+  if ((tp1->hdr.pqueue.prio == CH_CFG_EDF_PRIORITY) &&
+      (tp2->hdr.pqueue.prio == CH_CFG_EDF_PRIORITY)) {
+    return __sch_edf_precedes(tp1, tp2);
+  }
+#endif
+
+  return tp1->hdr.pqueue.prio > tp2->hdr.pqueue.prio;
+}
+
+/**
+ * @brief   Scheduling order of the first ready thread compared to a thread.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        the thread to be compared
+ * @param[in] peers     also returns @p true if the first ready thread is a
+ *                      peer of @p tp
+ * @return              The comparison result.
+ * @retval true         if the first ready thread must run before @p tp.
+ * @retval false        otherwise.
+ *
+ * @notapi
+ */
+static inline bool __sch_first_higher(const os_instance_t *oip,
+                                      const thread_t *tp,
+                                      bool peers) {
+  tprio_t p1 = firstprio(&oip->rlist.pqueue);
+  tprio_t p2 = tp->hdr.pqueue.prio;
+
+#if CH_CFG_USE_EDF == TRUE
+  if ((p1 == CH_CFG_EDF_PRIORITY) && (p2 == CH_CFG_EDF_PRIORITY)) {
+    const thread_t *ftp = (const thread_t *)oip->rlist.pqueue.next;
+
+    return peers ? !__sch_edf_precedes(tp, ftp) :
+                   __sch_edf_precedes(ftp, tp);
+  }
+#endif
+
+  return peers ? (p1 >= p2) : (p1 > p2);
+}
+
+/**
+ * @brief   Checks if the first ready thread preempts a running thread.
+ * @details A thread with a preemption threshold above its priority can
+ *          only be preempted by threads with priority above the threshold,
+ *          round robin among peers is suspended.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        the running thread
+ * @param[in] peers     also returns @p true if the first ready thread is a
+ *                      peer of @p tp
+ * @return              The preemption condition.
+ *
+ * @notapi
+ */
+static inline bool __sch_first_preempts(const os_instance_t *oip,
+                                        const thread_t *tp,
+                                        bool peers) {
+
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  if (tp->threshold > tp->hdr.pqueue.prio) {
+    return firstprio(&oip->rlist.pqueue) > tp->threshold;
+  }
+#endif
+
+  return __sch_first_higher(oip, tp, peers);
+}
+
+/**
+ * @brief   Checks if a thread being made ready preempts a running thread.
+ *
+ * @param[in] ntp       the thread being made ready
+ * @param[in] otp       the running thread
+ * @return              The preemption condition.
+ *
+ * @notapi
+ */
+static inline bool __sch_thd_preempts(const thread_t *ntp,
+                                      const thread_t *otp) {
+
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  if (otp->threshold > otp->hdr.pqueue.prio) {
+    return ntp->hdr.pqueue.prio > otp->threshold;
+  }
+#endif
+
+  return __sch_thd_higher(ntp, otp);
+}
+
 /**
  * @brief   Inserts a thread in the Ready List placing it behind its peers.
  * @details The thread is positioned behind all threads with higher or equal
@@ -90,6 +590,7 @@ static void __idle_thread(void *p) {
  *
  * @notapi
  */
+CC_FAST_CODE
 static thread_t *__sch_ready_behind(os_instance_t *oip, thread_t *tp) {
 
   chDbgAssert((tp->state != CH_STATE_READY) &&
@@ -101,10 +602,18 @@ static thread_t *__sch_ready_behind(os_instance_t *oip, thread_t *tp) {
 
   /* The thread is marked ready.*/
   tp->state = CH_STATE_READY;
+  __stats_ready(tp);
+
+#if CH_CFG_USE_EDF == TRUE
+  /* The deadline class level is ordered by deadline.*/
+  if (tp->hdr.pqueue.prio == CH_CFG_EDF_PRIORITY) {
+    return (thread_t *)__sch_rlist_insert_edf(&oip->rlist, tp, false);
+  }
+#endif
 
   /* Insertion in the priority queue.*/
-  return (thread_t *)ch_pqueue_insert_behind(&oip->rlist.pqueue,
-                                             &tp->hdr.pqueue);
+  return (thread_t *)__sch_rlist_insert_behind(&oip->rlist,
+                                               &tp->hdr.pqueue);
 }
 
 /**
@@ -124,6 +633,7 @@ static thread_t *__sch_ready_behind(os_instance_t *oip, thread_t *tp) {
  *
  * @notapi
  */
+CC_FAST_CODE
 static thread_t *__sch_ready_ahead(os_instance_t *oip, thread_t *tp) {
 
   chDbgAssert((tp->state != CH_STATE_READY) &&
@@ -135,10 +645,72 @@ static thread_t *__sch_ready_ahead(os_instance_t *oip, thread_t *tp) {
 
   /* The thread is marked ready.*/
   tp->state = CH_STATE_READY;
+  __stats_ready(tp);
+
+#if CH_CFG_USE_EDF == TRUE
+  /* The deadline class level is ordered by deadline.*/
+  if (tp->hdr.pqueue.prio == CH_CFG_EDF_PRIORITY) {
+    return (thread_t *)__sch_rlist_insert_edf(&oip->rlist, tp, true);
+  }
+#endif
 
   /* Insertion in the priority queue.*/
-  return (thread_t *)ch_pqueue_insert_ahead(&oip->rlist.pqueue,
-                                            &tp->hdr.pqueue);
+  return (thread_t *)__sch_rlist_insert_ahead(&oip->rlist,
+                                              &tp->hdr.pqueue);
+}
+
+/**
+ * @brief   Inserts a preempted thread in the Ready List.
+ * @details A thread preempted while its preemption threshold is in effect
+ *          is queued at the threshold priority ahead of its peers, so only
+ *          threads with priority above the threshold can run before it
+ *          resumes.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        the preempted thread
+ * @param[in] ahead     if @p true the thread is placed ahead of its peers
+ *                      else behind them
+ * @return              The thread pointer.
+ *
+ * @notapi
+ */
+static inline thread_t *__sch_ready_preempted(os_instance_t *oip,
+                                              thread_t *tp,
+                                              bool ahead) {
+
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  if (tp->threshold > tp->hdr.pqueue.prio) {
+    tp->preprio         = tp->hdr.pqueue.prio;
+    tp->hdr.pqueue.prio = tp->threshold;
+    ahead               = true;
+  }
+#endif
+
+  return ahead ? __sch_ready_ahead(oip, tp) : __sch_ready_behind(oip, tp);
+}
+
+/**
+ * @brief   Restores the priority of a thread being switched in.
+ * @details Undoes the effect of @p __sch_ready_preempted(), if the priority
+ *          has been raised above the threshold by priority inheritance
+ *          while the thread was queued then it is kept.
+ *
+ * @param[in] tp        the thread being switched in
+ *
+ * @notapi
+ */
+static inline void __sch_resume_prio(thread_t *tp) {
+
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  if (tp->preprio != NOPRIO) {
+    if (tp->hdr.pqueue.prio == tp->threshold) {
+      tp->hdr.pqueue.prio = tp->preprio;
+    }
+    tp->preprio = NOPRIO;
+  }
+#else
+  (void)tp;
+#endif
 }
 
 /**
@@ -158,8 +730,9 @@ static void __sch_reschedule_behind(os_instance_t *oip) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = (thread_t *)ch_pqueue_remove_highest(&oip->rlist.pqueue);
+  ntp = (thread_t *)__sch_rlist_remove_highest(&oip->rlist);
   ntp->state = CH_STATE_CURRENT;
+  __sch_resume_prio(ntp);
   __sch_set_currthread(oip, ntp);
 
   /* Handling idle-leave hook.*/
@@ -173,7 +746,7 @@ static void __sch_reschedule_behind(os_instance_t *oip) {
 #endif
 
   /* Placing in ready list behind peers.*/
-  otp = __sch_ready_behind(oip, otp);
+  otp = __sch_ready_preempted(oip, otp, false);
 
   /* Swap operation as tail call.*/
   chSysSwitch(ntp, otp);
@@ -195,8 +768,9 @@ static void __sch_reschedule_ahead(os_instance_t *oip) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = (thread_t *)ch_pqueue_remove_highest(&oip->rlist.pqueue);
+  ntp = (thread_t *)__sch_rlist_remove_highest(&oip->rlist);
   ntp->state = CH_STATE_CURRENT;
+  __sch_resume_prio(ntp);
   __sch_set_currthread(oip, ntp);
 
   /* Handling idle-leave hook.*/
@@ -205,7 +779,7 @@ static void __sch_reschedule_ahead(os_instance_t *oip) {
   }
 
   /* Placing in ready list ahead of peers.*/
-  otp = __sch_ready_ahead(oip, otp);
+  otp = __sch_ready_preempted(oip, otp, true);
 
   /* Swap operation as tail call.*/
   chSysSwitch(ntp, otp);
@@ -253,6 +827,48 @@ static void __sch_wakeup(void *p) {
   chSysUnlockFromISR();
 }
 
+#if (CH_CFG_USE_TASKS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Runner thread of a tasks priority level.
+ * @details Ready tasks are run in FIFO order on the runner stack, the runner
+ *          sleeps when there are no ready tasks.
+ *
+ * @param[in] p         pointer to the @p task_level_t object
+ */
+static void __sch_tasks_thread(void *p) {
+  task_level_t *tlp = (task_level_t *)p;
+  thread_t *tp = chThdGetSelfX();
+
+  chSysLock();
+  while ((tp->flags & CH_FLAG_TERMINATE) == (tmode_t)0) {
+    task_t *tkp;
+    eventmask_t events;
+
+    if (ch_queue_isempty(&tlp->ready)) {
+      (void) chThdSuspendS(&tlp->thread);
+      continue;
+    }
+
+    /* Next ready task, the events are taken atomically and activations
+       during the run make the task ready again.*/
+    tkp = (task_t *)ch_queue_fifo_remove(&tlp->ready);
+    tkp->link.next = NULL;
+    events = tkp->events;
+    tkp->events = (eventmask_t)0;
+    tlp->current = tkp;
+    tp->flags |= CH_FLAG_TASK_RUN;
+    chSysUnlock();
+
+    tkp->func(tkp, events);
+
+    chSysLock();
+    tp->flags &= (tmode_t)~CH_FLAG_TASK_RUN;
+    tlp->current = NULL;
+  }
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_TASKS == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -260,8 +876,11 @@ static void __sch_wakeup(void *p) {
 #if (CH_CFG_OPTIMIZE_SPEED == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   Inserts a thread into a priority ordered queue.
- * @note    The insertion is done by scanning the list from the highest
- *          priority toward the lowest.
+ * @details The thread is positioned behind all threads with higher or equal
+ *          priority.
+ * @note    Insertions at the head and at the tail of the list are
+ *          constant-time, in the other cases the list is scanned from the
+ *          lowest priority toward the highest.
  *
  * @param[in] tp        the pointer to the thread to be inserted in the list
  * @param[in] tqp       the pointer to the threads list header
@@ -270,15 +889,28 @@ static void __sch_wakeup(void *p) {
  */
 void ch_sch_prio_insert(ch_queue_t *tp, ch_queue_t *qp) {
 
-  ch_queue_t *cp = qp;
-  do {
-    cp = cp->next;
-  } while ((cp != qp) &&
-           (((thread_t *)cp)->hdr.pqueue.prio >= ((thread_t *)tp)->hdr.pqueue.prio));
-  tp->next       = cp;
-  tp->prev       = cp->prev;
-  tp->prev->next = tp;
-  cp->prev       = tp;
+  tprio_t prio = ((thread_t *)tp)->hdr.pqueue.prio;
+  ch_queue_t *cp = qp->prev;
+
+  /* If the first element has lower priority then all elements have lower
+     priority and the thread goes first, else the list is scanned from the
+     tail, threads waiting on the same object are expected to have mostly
+     equal priorities so the scan is usually short.*/
+  if ((qp->next != qp) &&
+      (((thread_t *)qp->next)->hdr.pqueue.prio < prio)) {
+    cp = qp;
+  }
+  else {
+    while ((cp != qp) && (((thread_t *)cp)->hdr.pqueue.prio < prio)) {
+      cp = cp->prev;
+    }
+  }
+
+  /* Insertion on next.*/
+  tp->prev       = cp;
+  tp->next       = cp->next;
+  tp->next->prev = tp;
+  cp->next       = tp;
 }
 #endif /* CH_CFG_OPTIMIZE_SPEED */
 
@@ -298,12 +930,15 @@ void chSchObjectInit(os_instance_t *oip,
   port_init(oip);
 
   /* Ready list initialization.*/
-  ch_pqueue_init(&oip->rlist.pqueue);
+  __sch_rlist_init(&oip->rlist);
 
   /* Registry initialization.*/
 #if CH_CFG_USE_REGISTRY == TRUE
   oip->rlist.newer = (thread_t *)&oip->rlist;
   oip->rlist.older = (thread_t *)&oip->rlist;
+#if CH_CFG_REGISTRY_ID_SLOTS > 0
+  __reg_id_init(oip);
+#endif
 #endif
 
   /* Virtual timers list initialization.*/
@@ -320,6 +955,12 @@ void chSchObjectInit(os_instance_t *oip,
   /* Time Measurement initialization.*/
 #if CH_CFG_USE_TM == TRUE
   __tm_calibration_init(&oip->tmc);
+#if CH_CFG_USE_TM_REGISTRY == TRUE
+  oip->tmlist = NULL;
+#endif
+#if CH_DBG_WAIT_PROFILING == TRUE
+  oip->wplist = NULL;
+#endif
 #endif
 
   /* Statistics initialization.*/
@@ -327,6 +968,12 @@ void chSchObjectInit(os_instance_t *oip,
   __stats_object_init(&oip->kernel_stats);
 #endif
 
+  /* Idle governor initialization, no low power states.*/
+#if CH_CFG_USE_IDLE_GOVERNOR == TRUE
+  oip->idle_states  = NULL;
+  oip->idle_nstates = 0U;
+#endif
+
 #if CH_CFG_NO_IDLE_THREAD == FALSE
   /* Now this instructions flow becomes the main thread.*/
 #if CH_CFG_USE_REGISTRY == TRUE
@@ -345,6 +992,15 @@ void chSchObjectInit(os_instance_t *oip,
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
   oip->rlist.current->wabase = oicp->mainthread_base;
 #endif
+#if CH_DBG_STACK_WATERMARK == TRUE
+  oip->rlist.current->wmargin = (size_t)((uint8_t *)oicp->mainthread_end -
+                                         (uint8_t *)oicp->mainthread_base);
+#endif
+
+#if CH_CFG_USE_TLS == TRUE
+  /* The caller TLS block is statically allocated.*/
+  __tls_main_init(oip->rlist.current);
+#endif
 
   /* Setting up the caller as current thread.*/
   oip->rlist.current->state = CH_STATE_CURRENT;
@@ -369,6 +1025,25 @@ void chSchObjectInit(os_instance_t *oip,
     (void) chThdCreateI(&idle_descriptor);
   }
 #endif
+
+#if CH_CFG_USE_VT_DEFERRED == TRUE
+  {
+    thread_descriptor_t vt_descriptor = {
+      .name     = "timers",
+      .wbase    = oicp->vtthread_base,
+      .wend     = oicp->vtthread_end,
+      .prio     = CH_CFG_VT_THREAD_PRIORITY,
+      .funcp    = __vt_thread,
+      .arg      = (void *)oip,
+    };
+
+    /* Deferred timers queue and service thread, the thread runs on the
+       first reschedule and waits for expired timers.*/
+    ch_queue_init(&oip->vtdeferred);
+    oip->vtthread = NULL;
+    (void) chThdCreateI(&vt_descriptor);
+  }
+#endif
 }
 
 /**
@@ -387,16 +1062,174 @@ void chSchObjectInit(os_instance_t *oip,
  *
  * @iclass
  */
+CC_FAST_CODE
 thread_t *chSchReadyI(thread_t *tp) {
   os_instance_t *oip = currcore;
 
   chDbgCheckClassI();
   chDbgCheck(tp != NULL);
+  chDbgAssert(tp->owner == oip, "not owned by this instance");
 
   /* The thread is handled by the local core.*/
   return __sch_ready_behind(oip, tp);
 }
 
+#if (CH_CFG_USE_IDLE_GOVERNOR == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Registers the low power states used by the idle governor.
+ * @details The states are registered on the current OS instance, this
+ *          function is meant to be invoked by the HAL or by the application
+ *          after the system initialization.
+ * @pre     The states must be ordered by increasing depth, deeper states
+ *          are expected to have larger latencies.
+ *
+ * @param[in] states    pointer to an array of @p idle_state_t, the array
+ *                      must remain valid while registered, @p NULL
+ *                      unregisters all states
+ * @param[in] n         number of elements in the array
+ *
+ * @api
+ */
+void chSchSetIdleStates(const idle_state_t *states, unsigned n) {
+  os_instance_t *oip = currcore;
+
+  chDbgCheck((states != NULL) || (n == 0U));
+
+  chSysLock();
+  oip->idle_states  = states;
+  oip->idle_nstates = n;
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_IDLE_GOVERNOR == TRUE */
+
+/**
+ * @brief   Adds a thread to a batch of threads to be made ready.
+ * @details The thread is marked as ready and positioned in the batch behind
+ *          all threads with higher or equal priority, the batch is then
+ *          moved in the ready list using @p chSchBatchReadyI().
+ * @pre     The batch header must have been initialized using
+ *          @p ch_pqueue_init().
+ * @pre     The thread must not be already inserted in any list through its
+ *          @p next and @p prev or list corruption would occur.
+ * @note    The ready list is left untouched, the thread is not eligible for
+ *          scheduling until the batch is moved in the ready list.
+ *
+ * @param[in] bqp       pointer to the batch header
+ * @param[in] tp        the thread to be made ready
+ * @return              The thread pointer.
+ *
+ * @iclass
+ */
+thread_t *chSchBatchAddI(ch_priority_queue_t *bqp, thread_t *tp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((bqp != NULL) && (tp != NULL));
+  chDbgAssert(tp->owner == currcore, "not owned by this instance");
+  chDbgAssert((tp->state != CH_STATE_READY) &&
+              (tp->state != CH_STATE_FINAL),
+              "invalid state");
+
+  /* Tracing the event.*/
+  __trace_ready(tp, tp->u.rdymsg);
+
+  /* The thread is marked ready.*/
+  tp->state = CH_STATE_READY;
+  __stats_ready(tp);
+
+  /* Insertion in the batch.*/
+  return (thread_t *)ch_pqueue_insert_behind(bqp, &tp->hdr.pqueue);
+}
+
+/**
+ * @brief   Moves a batch of threads in the Ready List.
+ * @details Each thread is positioned behind all threads with higher or equal
+ *          priority, the result is the same of a sequence of
+ *          @p chSchReadyI() calls but the ready list is scanned only once.
+ * @post    The batch is left empty.
+ * @post    This function does not reschedule so a call to a rescheduling
+ *          function must be performed before unlocking the kernel. Note that
+ *          interrupt handlers always reschedule on exit so an explicit
+ *          reschedule must not be performed in ISRs.
+ *
+ * @param[in] bqp       pointer to the batch header
+ *
+ * @iclass
+ */
+void chSchBatchReadyI(ch_priority_queue_t *bqp) {
+  os_instance_t *oip = currcore;
+#if CH_CFG_USE_BITMAP_READYLIST == FALSE
+  ch_priority_queue_t *cp = &oip->rlist.pqueue;
+#endif
+
+  chDbgCheckClassI();
+  chDbgCheck(bqp != NULL);
+
+  while (bqp->next != bqp) {
+    ch_priority_queue_t *p = ch_pqueue_remove_highest(bqp);
+
+#if CH_CFG_USE_EDF == TRUE
+    /* The deadline class level is ordered by deadline, the following
+       elements have lower or equal priority so the scan can restart from
+       the inserted element.*/
+    if (p->prio == CH_CFG_EDF_PRIORITY) {
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+      (void) __sch_rlist_insert_edf(&oip->rlist, (thread_t *)p, false);
+#else
+      cp = __sch_rlist_insert_edf(&oip->rlist, (thread_t *)p, false);
+#endif
+      continue;
+    }
+#endif
+
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+    /* Insertion is already constant-time using the bitmap index.*/
+    (void) __sch_rlist_insert_behind(&oip->rlist, p);
+#else
+    /* The batch is ordered by decreasing priority so the scan restarts
+       from the previous insertion point, the header priority is zero so
+       the scan always terminates.*/
+    do {
+      cp = cp->next;
+    } while (cp->prio >= p->prio);
+
+    /* Insertion on prev.*/
+    p->next       = cp;
+    p->prev       = cp->prev;
+    p->prev->next = p;
+    cp->prev      = p;
+    cp            = p;
+#endif
+  }
+}
+
+/**
+ * @brief   Removes a thread from the Ready List.
+ * @note    The priority is required because the thread priority could have
+ *          been already changed by the caller.
+ *
+ * @param[in] oip       pointer to the OS instance
+ * @param[in] tp        the thread to be removed
+ * @param[in] prio      the priority the thread has been inserted with
+ * @return              The thread pointer.
+ *
+ * @notapi
+ */
+thread_t *__sch_ready_remove(os_instance_t *oip, thread_t *tp, tprio_t prio) {
+
+  chDbgAssert(tp->state == CH_STATE_READY, "not ready");
+
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+  if (oip->rlist.prheads[prio] == &tp->hdr.pqueue) {
+    __sch_rlist_unlink_head(&oip->rlist, &tp->hdr.pqueue, prio);
+  }
+#else
+  (void)oip;
+  (void)prio;
+#endif
+
+  return (thread_t *)ch_queue_dequeue(&tp->hdr.queue);
+}
+
 /**
  * @brief   Puts the current thread to sleep into the specified state.
  * @details The thread goes into a sleeping state. The possible
@@ -406,12 +1239,17 @@ thread_t *chSchReadyI(thread_t *tp) {
  *
  * @sclass
  */
+CC_FAST_CODE
 void chSchGoSleepS(tstate_t newstate) {
   os_instance_t *oip = currcore;
   thread_t *otp = __sch_get_currthread(oip);
   thread_t *ntp;
 
   chDbgCheckClassS();
+#if CH_CFG_USE_TASKS == TRUE
+  chDbgAssert((otp->flags & CH_FLAG_TASK_RUN) == (tmode_t)0,
+              "blocking in a task");
+#endif
 
   /* New state.*/
   otp->state = newstate;
@@ -423,8 +1261,9 @@ void chSchGoSleepS(tstate_t newstate) {
 #endif
 
   /* Next thread in ready list becomes current.*/
-  ntp = (thread_t *)ch_pqueue_remove_highest(&oip->rlist.pqueue);
+  ntp = (thread_t *)__sch_rlist_remove_highest(&oip->rlist);
   ntp->state = CH_STATE_CURRENT;
+  __sch_resume_prio(ntp);
   __sch_set_currthread(oip, ntp);
 
   /* Handling idle-enter hook.*/
@@ -436,6 +1275,62 @@ void chSchGoSleepS(tstate_t newstate) {
   chSysSwitch(ntp, otp);
 }
 
+/**
+ * @brief   Puts the current thread to sleep and switches to a thread.
+ * @details The specified thread becomes running directly, without going
+ *          through the ready list, if it has a priority strictly greater
+ *          than the first thread in the ready list. Otherwise the thread is
+ *          made ready and the current thread goes to sleep normally. In both
+ *          cases the resulting scheduling is the same of a
+ *          @p chSchReadyI() followed by a @p chSchGoSleepS().
+ * @pre     The thread must not be already inserted in any list through its
+ *          @p next and @p prev or list corruption would occur.
+ *
+ * @param[in] newstate  the new thread state
+ * @param[in] ntp       the thread to be switched in
+ *
+ * @sclass
+ */
+void chSchGoSleepSwitchS(tstate_t newstate, thread_t *ntp) {
+  os_instance_t *oip = currcore;
+  thread_t *otp = __sch_get_currthread(oip);
+
+  chDbgCheckClassS();
+  chDbgAssert(ntp->owner == oip, "not owned by this instance");
+#if CH_CFG_USE_TASKS == TRUE
+  chDbgAssert((otp->flags & CH_FLAG_TASK_RUN) == (tmode_t)0,
+              "blocking in a task");
+#endif
+
+  /* If another thread would run first then the normal path is used in
+     order to preserve the scheduling order.*/
+  if (ntp->hdr.pqueue.prio <= firstprio(&oip->rlist.pqueue)) {
+    (void) __sch_ready_behind(oip, ntp);
+    chSchGoSleepS(newstate);
+    return;
+  }
+
+  /* New state.*/
+  otp->state = newstate;
+
+#if CH_CFG_TIME_QUANTUM > 0
+  /* The thread is renouncing its remaining time slices so it will have a new
+     time quantum when it will wakeup.*/
+  otp->ticks = (tslices_t)CH_CFG_TIME_QUANTUM;
+#endif
+
+  /* Tracing and statistics as if the thread went through the ready list.*/
+  __trace_ready(ntp, ntp->u.rdymsg);
+  __stats_ready(ntp);
+
+  /* The target thread becomes current.*/
+  ntp->state = CH_STATE_CURRENT;
+  __sch_set_currthread(oip, ntp);
+
+  /* Swap operation as tail call.*/
+  chSysSwitch(ntp, otp);
+}
+
 /**
  * @brief   Puts the current thread to sleep into the specified state with
  *          timeout specification.
@@ -495,15 +1390,24 @@ msg_t chSchGoSleepTimeoutS(tstate_t newstate, sysinterval_t timeout) {
  *
  * @sclass
  */
+CC_FAST_CODE
 void chSchWakeupS(thread_t *ntp, msg_t msg) {
   os_instance_t *oip = currcore;
   thread_t *otp = __sch_get_currthread(oip);
 
   chDbgCheckClassS();
 
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  chDbgAssert((oip->rlist.pqueue.next == &oip->rlist.pqueue) ||
+              (oip->rlist.current->hdr.pqueue.prio >= oip->rlist.pqueue.next->prio) ||
+              (oip->rlist.current->threshold >= oip->rlist.pqueue.next->prio),
+              "priority order violation");
+#else
   chDbgAssert((oip->rlist.pqueue.next == &oip->rlist.pqueue) ||
               (oip->rlist.current->hdr.pqueue.prio >= oip->rlist.pqueue.next->prio),
               "priority order violation");
+#endif
+  chDbgAssert(ntp->owner == oip, "not owned by this instance");
 
   /* Storing the message to be retrieved by the target thread when it will
      restart execution.*/
@@ -513,13 +1417,13 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
      one then it is just inserted in the ready list else it made
      running immediately and the invoking thread goes in the ready
      list instead.*/
-  if (ntp->hdr.pqueue.prio <= otp->hdr.pqueue.prio) {
+  if (!__sch_thd_preempts(ntp, otp)) {
     (void) __sch_ready_behind(oip, ntp);
   }
   else {
     /* The old thread goes back in the ready list ahead of its peers
        because it has not exhausted its time slice.*/
-    otp = __sch_ready_ahead(oip, otp);
+    otp = __sch_ready_preempted(oip, otp, true);
 
     /* Handling idle-leave hook.*/
     if (otp->hdr.pqueue.prio == IDLEPRIO) {
@@ -528,6 +1432,7 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
 
     /* The extracted thread is marked as current.*/
     ntp->state = CH_STATE_CURRENT;
+    __stats_ready(ntp);
     __sch_set_currthread(oip, ntp);
 
     /* Swap operation as tail call.*/
@@ -544,13 +1449,14 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
  *
  * @sclass
  */
+CC_FAST_CODE
 void chSchRescheduleS(void) {
   os_instance_t *oip = currcore;
   thread_t *tp = __sch_get_currthread(oip);
 
   chDbgCheckClassS();
 
-  if (firstprio(&oip->rlist.pqueue) > tp->hdr.pqueue.prio) {
+  if (__sch_first_preempts(oip, tp, false)) {
     __sch_reschedule_ahead(oip);
   }
 }
@@ -569,23 +1475,21 @@ void chSchRescheduleS(void) {
  *
  * @special
  */
+CC_FAST_CODE
 bool chSchIsPreemptionRequired(void) {
   os_instance_t *oip = currcore;
   thread_t *tp = __sch_get_currthread(oip);
 
-  tprio_t p1 = firstprio(&oip->rlist.pqueue);
-  tprio_t p2 = tp->hdr.pqueue.prio;
-
 #if CH_CFG_TIME_QUANTUM > 0
   /* If the running thread has not reached its time quantum, reschedule only
      if the first thread on the ready queue has a higher priority.
      Otherwise, if the running thread has used up its time quantum, reschedule
      if the first thread on the ready queue has equal or higher priority.*/
-  return (tp->ticks > (tslices_t)0) ? (p1 > p2) : (p1 >= p2);
+  return __sch_first_preempts(oip, tp, tp->ticks == (tslices_t)0);
 #else
   /* If the round robin preemption feature is not enabled then performs a
      simpler comparison.*/
-  return p1 > p2;
+  return __sch_first_preempts(oip, tp, false);
 #endif
 }
 #endif /* !defined(CH_SCH_IS_PREEMPTION_REQUIRED_HOOKED) */
@@ -601,14 +1505,16 @@ bool chSchIsPreemptionRequired(void) {
  *
  * @special
  */
+CC_FAST_CODE
 void chSchDoPreemption(void) {
   os_instance_t *oip = currcore;
   thread_t *otp = __sch_get_currthread(oip);
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = (thread_t *)ch_pqueue_remove_highest(&oip->rlist.pqueue);
+  ntp = (thread_t *)__sch_rlist_remove_highest(&oip->rlist);
   ntp->state = CH_STATE_CURRENT;
+  __sch_resume_prio(ntp);
   __sch_set_currthread(oip, ntp);
 
   /* Handling idle-leave hook.*/
@@ -623,7 +1529,7 @@ void chSchDoPreemption(void) {
 
     /* The thread consumed its time quantum so it is enqueued behind threads
        with same priority level, however, it acquires a new time quantum.*/
-    otp = __sch_ready_behind(oip, otp);
+    otp = __sch_ready_preempted(oip, otp, false);
 
     /* The thread being swapped out receives a new time quantum.*/
     otp->ticks = (tslices_t)CH_CFG_TIME_QUANTUM;
@@ -631,12 +1537,12 @@ void chSchDoPreemption(void) {
   else {
     /* The thread didn't consume all its time quantum so it is put ahead of
        threads with equal priority and does not acquire a new time quantum.*/
-    otp = __sch_ready_ahead(oip, otp);
+    otp = __sch_ready_preempted(oip, otp, true);
   }
 #else /* !(CH_CFG_TIME_QUANTUM > 0) */
   /* If the round-robin mechanism is disabled then the thread goes always
      ahead of its peers.*/
-  otp = __sch_ready_ahead(oip, otp);
+  otp = __sch_ready_preempted(oip, otp, true);
 #endif /* !(CH_CFG_TIME_QUANTUM > 0) */
 
   /* Swap operation as tail call.*/
@@ -655,22 +1561,20 @@ void chSchDoPreemption(void) {
 void chSchPreemption(void) {
   os_instance_t *oip = currcore;
   thread_t *tp = __sch_get_currthread(oip);
-  tprio_t p1 = firstprio(&oip->rlist.pqueue);
-  tprio_t p2 = tp->hdr.pqueue.prio;
 
 #if CH_CFG_TIME_QUANTUM > 0
   if (tp->ticks > (tslices_t)0) {
-    if (p1 > p2) {
+    if (__sch_first_preempts(oip, tp, false)) {
       __sch_reschedule_ahead(oip);
     }
   }
   else {
-    if (p1 >= p2) {
+    if (__sch_first_preempts(oip, tp, true)) {
       __sch_reschedule_behind(oip);
     }
   }
 #else /* CH_CFG_TIME_QUANTUM == 0 */
-  if (p1 > p2) {
+  if (__sch_first_preempts(oip, tp, false)) {
     __sch_reschedule_ahead(oip);
   }
 #endif /* CH_CFG_TIME_QUANTUM == 0 */
@@ -681,6 +1585,8 @@ void chSchPreemption(void) {
  * @brief   Yields the time slot.
  * @details Yields the CPU control to the next thread in the ready list with
  *          equal or higher priority, if any.
+ * @note    While a preemption threshold is in effect only threads with
+ *          priority above the threshold are considered.
  *
  * @sclass
  */
@@ -690,7 +1596,7 @@ void chSchDoYieldS(void) {
 
   chDbgCheckClassS();
 
-  if (firstprio(&oip->rlist.pqueue) >= tp->hdr.pqueue.prio) {
+  if (__sch_first_preempts(oip, tp, true)) {
     __sch_reschedule_behind(oip);
   }
 }
@@ -713,8 +1619,9 @@ thread_t *chSchSelectFirstI(void) {
   thread_t *ntp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  ntp = (thread_t *)ch_pqueue_remove_highest(&oip->rlist.pqueue);
+  ntp = (thread_t *)__sch_rlist_remove_highest(&oip->rlist);
   ntp->state = CH_STATE_CURRENT;
+  __sch_resume_prio(ntp);
   __sch_set_currthread(oip, ntp);
 
   /* Handling idle-leave hook.*/
@@ -723,9 +1630,154 @@ thread_t *chSchSelectFirstI(void) {
   }
 
   /* Placing in ready list ahead of peers.*/
-  (void) __sch_ready_ahead(oip, otp);
+  (void) __sch_ready_preempted(oip, otp, true);
 
   return ntp;
 }
 
+#if (CH_CFG_USE_TASKS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Creates a tasks priority level.
+ * @details The tasks of the level are run by a thread at the specified
+ *          priority, all the tasks share the stack of that thread.
+ * @note    The stack must be sized for the deepest task function.
+ *
+ * @param[out] tlp      pointer to the @p task_level_t object
+ * @param[out] wsp      pointer to a working area dedicated to the runner
+ * @param[in] size      size of the working area
+ * @param[in] prio      priority level of the tasks
+ * @return              The pointer to the runner @p thread_t.
+ *
+ * @api
+ */
+thread_t *chTaskLevelCreateStatic(task_level_t *tlp, void *wsp,
+                                  size_t size, tprio_t prio) {
+  thread_descriptor_t td = {
+    .name  = "tasks",
+    .wbase = (stkalign_t *)wsp,
+    .wend  = (stkalign_t *)((uint8_t *)wsp + size),
+    .prio  = prio,
+    .funcp = __sch_tasks_thread,
+    .arg   = (void *)tlp
+  };
+
+  chDbgCheck(tlp != NULL);
+
+  ch_queue_init(&tlp->ready);
+  tlp->thread  = NULL;
+  tlp->current = NULL;
+  tlp->runner  = chThdCreate(&td);
+
+  return tlp->runner;
+}
+
+/**
+ * @brief   Stops a tasks priority level.
+ * @details The runner terminates after completing the task being run, if
+ *          any, ready tasks are not run. The runner can be waited using
+ *          @p chThdWait().
+ *
+ * @param[in] tlp       pointer to the @p task_level_t object
+ *
+ * @api
+ */
+void chTaskLevelStop(task_level_t *tlp) {
+
+  chDbgCheck(tlp != NULL);
+
+  chSysLock();
+  tlp->runner->flags |= CH_FLAG_TERMINATE;
+  chThdResumeS(&tlp->thread, MSG_RESET);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Initializes a run-to-completion task.
+ *
+ * @param[out] tkp      pointer to the @p task_t object
+ * @param[in] tlp       pointer to the @p task_level_t object of the task
+ * @param[in] func      task function
+ * @param[in] arg       task function argument
+ *
+ * @init
+ */
+void chTaskObjectInit(task_t *tkp, task_level_t *tlp,
+                      taskfunc_t func, void *arg) {
+
+  chDbgCheck((tkp != NULL) && (tlp != NULL) && (func != NULL));
+
+  tkp->link.next = NULL;
+  tkp->level     = tlp;
+  tkp->func      = func;
+  tkp->arg       = arg;
+  tkp->events    = (eventmask_t)0;
+}
+
+/**
+ * @brief   Activates a task.
+ * @details The events are added to the pending events of the task and the
+ *          task is made ready if it is not already, activations before the
+ *          task runs are merged into a single run.
+ * @note    A task activating itself runs again after the other ready tasks
+ *          of its level.
+ * @note    This function does not reschedule.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ * @param[in] events    events to be passed to the task
+ *
+ * @iclass
+ */
+void chTaskActivateI(task_t *tkp, eventmask_t events) {
+
+  chDbgCheckClassI();
+  chDbgCheck(tkp != NULL);
+
+  tkp->events |= events;
+  if (tkp->link.next == NULL) {
+    ch_queue_insert(&tkp->link, &tkp->level->ready);
+    chThdResumeI(&tkp->level->thread, MSG_OK);
+  }
+}
+
+/**
+ * @brief   Activates a task.
+ * @details The events are added to the pending events of the task and the
+ *          task is made ready if it is not already, activations before the
+ *          task runs are merged into a single run.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ * @param[in] events    events to be passed to the task
+ *
+ * @api
+ */
+void chTaskActivate(task_t *tkp, eventmask_t events) {
+
+  chSysLock();
+  chTaskActivateI(tkp, events);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Cancels a pending activation of a task.
+ * @details The task is removed from the ready tasks and its pending events
+ *          are discarded, a task being run is not affected.
+ *
+ * @param[in] tkp       pointer to the @p task_t object
+ *
+ * @iclass
+ */
+void chTaskCancelI(task_t *tkp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(tkp != NULL);
+
+  if (tkp->link.next != NULL) {
+    (void) ch_queue_dequeue(&tkp->link);
+    tkp->link.next = NULL;
+  }
+  tkp->events = (eventmask_t)0;
+}
+#endif /* CH_CFG_USE_TASKS == TRUE */
+
 /** @} */
@@ -152,6 +152,11 @@ void chSemResetWithMessageI(semaphore_t *sp, cnt_t n, msg_t msg) {
   while (ch_queue_notempty(&sp->queue)) {
     chSchReadyI((thread_t *)ch_queue_lifo_remove(&sp->queue))->u.rdymsg = msg;
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  if (n > (cnt_t)0) {
+    chWaitNotifyI(sp);
+  }
+#endif
 }
 
 /**
@@ -200,7 +205,7 @@ msg_t chSemWaitS(semaphore_t *sp) {
     thread_t *currtp = chThdGetSelfX();
     currtp->u.wtsemp = sp;
     sem_insert(currtp, &sp->queue);
-    chSchGoSleepS(CH_STATE_WTSEM);
+    __sch_wait_s(CH_STATE_WTSEM, sp);
 
     return currtp->u.rdymsg;
   }
@@ -274,7 +279,7 @@ msg_t chSemWaitTimeoutS(semaphore_t *sp, sysinterval_t timeout) {
     currtp->u.wtsemp = sp;
     sem_insert(currtp, &sp->queue);
 
-    return chSchGoSleepTimeoutS(CH_STATE_WTSEM, timeout);
+    return __sch_wait_timeout_s(CH_STATE_WTSEM, timeout, sp);
   }
 
   return MSG_OK;
@@ -298,6 +303,12 @@ void chSemSignal(semaphore_t *sp) {
   if (++sp->cnt <= (cnt_t)0) {
     chSchWakeupS((thread_t *)ch_queue_fifo_remove(&sp->queue), MSG_OK);
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  else {
+    chWaitNotifyI(sp);
+    chSchRescheduleS();
+  }
+#endif
   chSysUnlock();
 }
 
@@ -327,6 +338,11 @@ void chSemSignalI(semaphore_t *sp) {
     tp->u.rdymsg = MSG_OK;
     (void) chSchReadyI(tp);
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  else {
+    chWaitNotifyI(sp);
+  }
+#endif
 }
 
 /**
@@ -356,6 +372,11 @@ void chSemAddCounterI(semaphore_t *sp, cnt_t n) {
     }
     n--;
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  if (sp->cnt > (cnt_t)0) {
+    chWaitNotifyI(sp);
+  }
+#endif
 }
 
 /**
@@ -386,11 +407,16 @@ msg_t chSemSignalWait(semaphore_t *sps, semaphore_t *spw) {
   if (++sps->cnt <= (cnt_t)0) {
     chSchReadyI((thread_t *)ch_queue_fifo_remove(&sps->queue))->u.rdymsg = MSG_OK;
   }
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+  else {
+    chWaitNotifyI(sps);
+  }
+#endif
   if (--spw->cnt < (cnt_t)0) {
     thread_t *currtp = chThdGetSelfX();
     sem_insert(currtp, &spw->queue);
     currtp->u.wtsemp = spw;
-    chSchGoSleepS(CH_STATE_WTSEM);
+    __sch_wait_s(CH_STATE_WTSEM, spw);
     msg = currtp->u.rdymsg;
   }
   else {
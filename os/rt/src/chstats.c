@@ -50,6 +50,70 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_DBG_LATENCY_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Accounts a ready-to-run latency sample.
+ *
+ * @param[in] lsp       pointer to the @p latency_stats_t structure
+ * @param[in] now       current realtime counter value
+ */
+static void stats_latency_sample(latency_stats_t *lsp, rtcnt_t now) {
+  rtcnt_t lat = now - lsp->ready;
+  rtcnt_t n = lat >> CH_DBG_LATENCY_RESOLUTION;
+  unsigned i = 0U;
+
+  if (lat > lsp->worst) {
+    lsp->worst = lat;
+  }
+
+  while ((n != (rtcnt_t)0) && (i < ((unsigned)CH_DBG_LATENCY_BUCKETS - 1U))) {
+    n >>= 1;
+    i++;
+  }
+  lsp->hist[i]++;
+}
+#endif
+
+#if CH_STATS_CRIT_ATTRIBUTION || defined(__DOXYGEN__)
+/**
+ * @brief   Accounts the duration of a threads critical zone.
+ * @details The offenders table keeps a single record for each caller, a
+ *          caller already in the table is only moved up if the new duration
+ *          is longer than the recorded one.
+ *
+ * @param[in] ksp       pointer to the @p kernel_stats_t structure
+ * @param[in] duration  duration of the critical zone
+ */
+static void stats_crit_sample(kernel_stats_t *ksp, rtcnt_t duration) {
+#if CH_DBG_CRIT_OFFENDERS > 0
+  crit_offender_t *cop = &ksp->crit_offenders[0];
+  unsigned i = 0U;
+
+  /* Record of the same caller or the last one.*/
+  while ((i < ((unsigned)CH_DBG_CRIT_OFFENDERS - 1U)) &&
+         (cop[i].caller != ksp->crit_caller)) {
+    i++;
+  }
+  if (duration > cop[i].duration) {
+    /* Shifting down the shorter records.*/
+    while ((i > 0U) && (duration > cop[i - 1U].duration)) {
+      cop[i] = cop[i - 1U];
+      i--;
+    }
+    cop[i].duration = duration;
+    cop[i].caller   = ksp->crit_caller;
+    cop[i].tp       = ksp->crit_tp;
+  }
+#endif
+#if CH_DBG_CRIT_THRESHOLD > 0
+  if (duration > (rtcnt_t)CH_DBG_CRIT_THRESHOLD) {
+    __trace_crit(ksp->crit_caller, duration);
+    CH_CFG_CRIT_THRESHOLD_HOOK(ksp->crit_caller, duration);
+  }
+#endif
+}
+#endif
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -74,13 +138,32 @@ void __stats_ctxswc(thread_t *ntp, thread_t *otp) {
 
   currcore->kernel_stats.n_ctxswc++;
   chTMChainMeasurementToX(&otp->stats, &ntp->stats);
+#if CH_DBG_LATENCY_HISTOGRAMS == TRUE
+  stats_latency_sample(&ntp->latency, ntp->stats.last);
+#endif
 }
 
+#if (CH_DBG_LATENCY_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Marks the insertion of a thread in the ready list.
+ *
+ * @param[in] tp        the thread made ready
+ */
+void __stats_ready(thread_t *tp) {
+
+  tp->latency.ready = chSysGetRealtimeCounterX();
+}
+#endif
+
 /**
  * @brief   Starts the measurement of a thread critical zone.
  */
 void __stats_start_measure_crit_thd(void) {
 
+#if CH_STATS_CRIT_ATTRIBUTION
+  currcore->kernel_stats.crit_caller = __stats_get_caller();
+  currcore->kernel_stats.crit_tp     = chThdGetSelfX();
+#endif
   chTMStartMeasurementX(&currcore->kernel_stats.m_crit_thd);
 }
 
@@ -90,6 +173,10 @@ void __stats_start_measure_crit_thd(void) {
 void __stats_stop_measure_crit_thd(void) {
 
   chTMStopMeasurementX(&currcore->kernel_stats.m_crit_thd);
+#if CH_STATS_CRIT_ATTRIBUTION
+  stats_crit_sample(&currcore->kernel_stats,
+                    currcore->kernel_stats.m_crit_thd.last);
+#endif
 }
 
 /**
@@ -108,6 +195,26 @@ void __stats_stop_measure_crit_isr(void) {
   chTMStopMeasurementX(&currcore->kernel_stats.m_crit_isr);
 }
 
+#if (CH_DBG_CRIT_OFFENDERS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Clears the critical zones offenders table.
+ *
+ * @api
+ */
+void chStatsResetCritOffenders(void) {
+  crit_offender_t *cop = &currcore->kernel_stats.crit_offenders[0];
+  unsigned i;
+
+  chSysLock();
+  for (i = 0U; i < (unsigned)CH_DBG_CRIT_OFFENDERS; i++) {
+    cop[i].duration = (rtcnt_t)0;
+    cop[i].caller   = NULL;
+    cop[i].tp       = NULL;
+  }
+  chSysUnlock();
+}
+#endif
+
 #endif /* CH_DBG_STATISTICS == TRUE */
 
 /** @} */
@@ -53,6 +53,13 @@ os_instance_t ch;
 THD_WORKING_AREA(ch_idle_thread_wa, PORT_IDLE_THREAD_STACK_SIZE);
 #endif
 
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Default instance deferred timers thread working area.
+ */
+THD_WORKING_AREA(ch_vt_thread_wa, CH_CFG_VT_THREAD_STACK_SIZE);
+#endif
+
 /*===========================================================================*/
 /* Module local types.                                                       */
 /*===========================================================================*/
@@ -102,13 +109,23 @@ void chSysInit(void) {
 #endif
 #if CH_CFG_NO_IDLE_THREAD == FALSE
       .idlethread_base  = THD_WORKING_AREA_BASE(ch_idle_thread_wa),
-      .idlethread_end   = THD_WORKING_AREA_END(ch_idle_thread_wa)
+      .idlethread_end   = THD_WORKING_AREA_END(ch_idle_thread_wa),
+#endif
+#if CH_CFG_USE_VT_DEFERRED == TRUE
+      .vtthread_base    = THD_WORKING_AREA_BASE(ch_vt_thread_wa),
+      .vtthread_end     = THD_WORKING_AREA_END(ch_vt_thread_wa)
 #endif
     };
 
     chSchObjectInit(&ch, &default_cfg);
   }
 
+#if CH_CFG_USE_VT_DEFERRED == TRUE
+  /* The timers thread has higher priority than the main thread, letting
+     it reach its waiting state.*/
+  chSchRescheduleS();
+#endif
+
   /* It is alive now.*/
   chSysUnlock();
 }
@@ -196,11 +213,79 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+
+#if CH_CFG_USE_BITMAP_READYLIST == TRUE
+    {
+      tprio_t prio;
+
+      /* Each priority level start must be indexed as level head.*/
+      pqp = oip->rlist.pqueue.next;
+      while (pqp != &oip->rlist.pqueue) {
+        if (pqp->prev->prio != pqp->prio) {
+          if (oip->rlist.prheads[pqp->prio] != pqp) {
+            return true;
+          }
+          n++;
+        }
+        pqp = pqp->next;
+      }
+
+      /* The number of non-empty levels must match the bitmap.*/
+      for (prio = (tprio_t)1; prio < (tprio_t)CH_RLIST_PRIO_LEVELS; prio++) {
+        if ((oip->rlist.prmap[prio >> 5] & (1U << (prio & 31U))) != 0U) {
+          n--;
+        }
+      }
+      if (n != (cnt_t)0) {
+        return true;
+      }
+    }
+#endif
   }
 
   /* Timers list integrity check.*/
   if ((testmask & CH_INTEGRITY_VTLIST) != 0U) {
     delta_list_t *dlp;
+#if CH_CFG_USE_VT_WHEEL == TRUE
+    unsigned i;
+    cnt_t total = (cnt_t)0;
+
+    for (i = 0U; i < (unsigned)CH_CFG_VT_WHEEL_SLOTS; i++) {
+      delta_list_t *hp = &oip->vtlist.slots[i];
+      bool used = (oip->vtlist.slotmap[i / 32U] & (1U << (i % 32U))) != 0U;
+
+      /* Scanning the slot forward.*/
+      n = (cnt_t)0;
+      dlp = hp->next;
+      while (dlp != hp) {
+        n++;
+        dlp = dlp->next;
+      }
+      total += n;
+
+      /* The slot map must reflect the slot state.*/
+      if (used != (n != (cnt_t)0)) {
+        return true;
+      }
+
+      /* Scanning the slot backward.*/
+      dlp = hp->prev;
+      while (dlp != hp) {
+        n--;
+        dlp = dlp->prev;
+      }
+
+      /* The number of elements must match.*/
+      if (n != (cnt_t)0) {
+        return true;
+      }
+    }
+
+    /* The number of timers in the wheel must match the armed counter.*/
+    if (total != (cnt_t)oip->vtlist.armed) {
+      return true;
+    }
+#else /* CH_CFG_USE_VT_WHEEL == FALSE */
 
     /* Scanning the timers list forward.*/
     n = (cnt_t)0;
@@ -221,12 +306,14 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+#endif /* CH_CFG_USE_VT_WHEEL == FALSE */
   }
 
 #if CH_CFG_USE_REGISTRY == TRUE
   if ((testmask & CH_INTEGRITY_REGISTRY) != 0U) {
     thread_t *tp;
 
+#if CH_CFG_COMPACT_OBJECTS == FALSE
     /* Scanning the ready list forward.*/
     n = (cnt_t)0;
     tp = oip->rlist.newer;
@@ -246,6 +333,17 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+#else
+    /* Scanning the single linked list forward, the last element must be
+       the newest thread.*/
+    tp = (thread_t *)&oip->rlist;
+    while (tp->newer != (thread_t *)&oip->rlist) {
+      tp = tp->newer;
+    }
+    if (tp != oip->rlist.older) {
+      return true;
+    }
+#endif
   }
 #endif /* CH_CFG_USE_REGISTRY == TRUE */
 
@@ -269,6 +367,7 @@ bool chSysIntegrityCheckI(unsigned testmask) {
  *
  * @iclass
  */
+CC_FAST_CODE
 void chSysTimerHandlerI(void) {
 #if (CH_CFG_TIME_QUANTUM > 0) || (CH_DBG_THREADS_PROFILING == TRUE)
   thread_t *currtp = chThdGetSelfX();
@@ -70,6 +70,24 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if ((CH_CFG_USE_PERIODIC == TRUE) && (CH_DBG_STATISTICS == TRUE) &&        \
+     (CH_CFG_USE_TM_REGISTRY == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the CPU time consumed by the running thread.
+ * @note    The measurement of the running thread has been started at
+ *          the last context switch, the elapsed part is added to the
+ *          cumulative time.
+ *
+ * @param[in] tp        pointer to the running thread
+ * @return              The CPU time in realtime counter cycles.
+ */
+static rttime_t thd_get_cpu_time(thread_t *tp) {
+
+  return tp->stats.cumulative +
+         (rttime_t)(chSysGetRealtimeCounterX() - tp->stats.last);
+}
+#endif
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -94,8 +112,7 @@ thread_t *__thd_object_init(os_instance_t *oip,
   tp->hdr.pqueue.prio   = prio;
   tp->state             = CH_STATE_WTSTART;
   tp->flags             = CH_FLAG_MODE_STATIC;
-
-  (void)oip;
+  tp->owner             = oip;
 
 #if CH_CFG_TIME_QUANTUM > 0
   tp->ticks             = (tslices_t)CH_CFG_TIME_QUANTUM;
@@ -104,6 +121,27 @@ thread_t *__thd_object_init(os_instance_t *oip,
   tp->realprio          = prio;
   tp->mtxlist           = NULL;
 #endif
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  tp->threshold         = IDLEPRIO;
+  tp->preprio           = NOPRIO;
+#endif
+#if CH_CFG_USE_EDF == TRUE
+  tp->edf.rdeadline     = (sysinterval_t)0;
+#endif
+#if CH_CFG_USE_RESERVATIONS == TRUE
+  tp->reservation       = NULL;
+#endif
+#if CH_CFG_USE_PERIODIC == TRUE
+  tp->periodic.period   = (sysinterval_t)0;
+  tp->periodic.stats.releases  = (ucnt_t)0;
+  tp->periodic.stats.overruns  = (ucnt_t)0;
+  tp->periodic.stats.skipped   = (ucnt_t)0;
+  tp->periodic.stats.maxjitter = (sysinterval_t)0;
+#if (CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)
+  tp->periodic.jobstart = (rttime_t)0;
+  tp->periodic.exectm   = NULL;
+#endif
+#endif
 #if CH_CFG_USE_EVENTS == TRUE
   tp->epending          = (eventmask_t)0;
 #endif
@@ -125,6 +163,9 @@ thread_t *__thd_object_init(os_instance_t *oip,
 #endif
 #if CH_DBG_STATISTICS == TRUE
   chTMObjectInit(&tp->stats);
+#if CH_DBG_LATENCY_HISTOGRAMS == TRUE
+  __stats_latency_init(&tp->latency);
+#endif
 #endif
   CH_CFG_THREAD_INIT_HOOK(tp);
   return tp;
@@ -173,6 +214,7 @@ void __thd_memfill(uint8_t *startp, uint8_t *endp, uint8_t v) {
  */
 thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp) {
   thread_t *tp;
+  uint8_t *wtop;
 
   chDbgCheckClassI();
   chDbgCheck(tdp != NULL);
@@ -181,6 +223,12 @@ thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp) {
              (tdp->wend > tdp->wbase) &&
              (((size_t)tdp->wend - (size_t)tdp->wbase) >= THD_WORKING_AREA_SIZE(0)));
   chDbgCheck((tdp->prio <= HIGHPRIO) && (tdp->funcp != NULL));
+#if CH_CFG_USE_PERIODIC == TRUE
+  chDbgCheck(tdp->policy <= CH_PERIODIC_SKIP);
+#endif
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  chDbgCheck(tdp->threshold <= HIGHPRIO);
+#endif
 
   /* The thread structure is laid out in the upper part of the thread
      workspace. The thread position structure is aligned to the required
@@ -188,15 +236,39 @@ thread_t *chThdCreateSuspendedI(const thread_descriptor_t *tdp) {
   tp = (thread_t *)((uint8_t *)tdp->wend -
                     MEM_ALIGN_NEXT(sizeof (thread_t), PORT_STACK_ALIGN));
 
+  /* The TLS area, if any, is laid out below the thread structure, the
+     stack starts below it.*/
+  wtop = (uint8_t *)tp - CH_TLS_AREA_SIZE;
+
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
   /* Stack boundary.*/
   tp->wabase = tdp->wbase;
 #endif
+#if CH_DBG_STACK_WATERMARK == TRUE
+  tp->wmargin = (size_t)(wtop - (uint8_t *)tdp->wbase);
+#endif
 
   /* Setting up the port-dependent part of the working area.*/
-  PORT_SETUP_CONTEXT(tp, tdp->wbase, tp, tdp->funcp, tdp->arg);
+  PORT_SETUP_CONTEXT(tp, tdp->wbase, wtop, tdp->funcp, tdp->arg);
+
+  tp = __thd_object_init(currcore, tp, tdp->name, tdp->prio);
+
+#if CH_CFG_USE_TLS == TRUE
+  __tls_object_init(tp, (void *)wtop);
+#endif
 
-  return __thd_object_init(currcore, tp, tdp->name, tdp->prio);
+#if CH_CFG_USE_PERIODIC == TRUE
+  /* Periodic threads, the first release is the creation time, it is
+     moved to the start time by chThdStart().*/
+  tp->periodic.period   = tdp->period;
+  tp->periodic.policy   = tdp->policy;
+  tp->periodic.release  = chVTGetSystemTimeX();
+#endif
+#if CH_CFG_USE_PREEMPT_THRESHOLD == TRUE
+  tp->threshold         = tdp->threshold;
+#endif
+
+  return tp;
 }
 
 /**
@@ -223,8 +295,8 @@ thread_t *chThdCreateSuspended(const thread_descriptor_t *tdp) {
   thread_t *tp;
 
 #if CH_CFG_USE_REGISTRY == TRUE
-  chDbgAssert(chRegFindThreadByWorkingArea(tdp->wbase) == NULL,
-              "working area in use");
+  chDbgAssertExpensive(chRegFindThreadByWorkingArea(tdp->wbase) == NULL,
+                       "working area in use");
 #endif
 
 #if CH_DBG_FILL_THREADS == TRUE
@@ -288,8 +360,8 @@ thread_t *chThdCreate(const thread_descriptor_t *tdp) {
 
 #if (CH_CFG_USE_REGISTRY == TRUE) &&                                        \
     ((CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE))
-  chDbgAssert(chRegFindThreadByWorkingArea(tdp->wbase) == NULL,
-              "working area in use");
+  chDbgAssertExpensive(chRegFindThreadByWorkingArea(tdp->wbase) == NULL,
+                       "working area in use");
 #endif
 
 #if CH_DBG_FILL_THREADS == TRUE
@@ -329,6 +401,7 @@ thread_t *chThdCreate(const thread_descriptor_t *tdp) {
 thread_t *chThdCreateStatic(void *wsp, size_t size,
                             tprio_t prio, tfunc_t pf, void *arg) {
   thread_t *tp;
+  uint8_t *wtop;
 
   chDbgCheck((wsp != NULL) &&
              MEM_IS_ALIGNED(wsp, PORT_WORKING_AREA_ALIGN) &&
@@ -338,8 +411,8 @@ thread_t *chThdCreateStatic(void *wsp, size_t size,
 
 #if (CH_CFG_USE_REGISTRY == TRUE) &&                                        \
     ((CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE))
-  chDbgAssert(chRegFindThreadByWorkingArea(wsp) == NULL,
-              "working area in use");
+  chDbgAssertExpensive(chRegFindThreadByWorkingArea(wsp) == NULL,
+                       "working area in use");
 #endif
 
 #if CH_DBG_FILL_THREADS == TRUE
@@ -356,16 +429,27 @@ thread_t *chThdCreateStatic(void *wsp, size_t size,
   tp = (thread_t *)((uint8_t *)wsp + size -
                     MEM_ALIGN_NEXT(sizeof (thread_t), PORT_STACK_ALIGN));
 
+  /* The TLS area, if any, is laid out below the thread structure, the
+     stack starts below it.*/
+  wtop = (uint8_t *)tp - CH_TLS_AREA_SIZE;
+
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
   /* Stack boundary.*/
   tp->wabase = (stkalign_t *)wsp;
 #endif
+#if CH_DBG_STACK_WATERMARK == TRUE
+  tp->wmargin = (size_t)(wtop - (uint8_t *)wsp);
+#endif
 
   /* Setting up the port-dependent part of the working area.*/
-  PORT_SETUP_CONTEXT(tp, wsp, tp, pf, arg);
+  PORT_SETUP_CONTEXT(tp, wsp, wtop, pf, arg);
 
   tp = __thd_object_init(currcore, tp, "noname", prio);
 
+#if CH_CFG_USE_TLS == TRUE
+  __tls_object_init(tp, (void *)wtop);
+#endif
+
   /* Starting the thread immediately.*/
   chSchWakeupS(tp, MSG_OK);
   chSysUnlock();
@@ -386,6 +470,9 @@ thread_t *chThdStart(thread_t *tp) {
 
   chSysLock();
   chDbgAssert(tp->state == CH_STATE_WTSTART, "wrong state");
+#if CH_CFG_USE_PERIODIC == TRUE
+  tp->periodic.release = chVTGetSystemTimeX();
+#endif
   chSchWakeupS(tp, MSG_OK);
   chSysUnlock();
 
@@ -443,6 +530,11 @@ void chThdRelease(thread_t *tp) {
     REG_REMOVE(tp);
     chSysUnlock();
 
+#if CH_CFG_USE_NEWLIB_REENT == TRUE
+    /* Releasing the newlib resources of the terminated thread.*/
+    __tls_reclaim(tp);
+#endif
+
 #if CH_CFG_USE_DYNAMIC == TRUE
     switch (tp->flags & CH_FLAG_MODE_MASK) {
 #if CH_CFG_USE_HEAP == TRUE
@@ -513,6 +605,13 @@ void chThdExitS(msg_t msg) {
   /* Exit handler hook.*/
   CH_CFG_THREAD_EXIT_HOOK(tp);
 
+#if CH_CFG_USE_RESERVATIONS == TRUE
+  /* Leaving the reservation, the thread CPU time is charged.*/
+  if (currtp->reservation != NULL) {
+    __res_leave(currtp);
+  }
+#endif
+
 #if CH_CFG_USE_WAITEXIT == TRUE
   /* Waking up any waiting thread.*/
   while (ch_list_notempty(&currtp->waiting)) {
@@ -626,6 +725,42 @@ tprio_t chThdSetPriority(tprio_t newprio) {
   return oldprio;
 }
 
+#if (CH_CFG_USE_PREEMPT_THRESHOLD == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Changes the running thread preemption threshold then reschedules
+ *          if necessary.
+ * @details While running, the thread can only be preempted by threads with
+ *          priority above the threshold, threads with priority between the
+ *          thread priority and the threshold run when the thread blocks
+ *          or lowers the threshold. If preempted, the thread waits in the
+ *          ready list at the threshold priority so it resumes before any
+ *          thread not above the threshold. Groups of threads sharing a
+ *          threshold do not preempt each other and can be analyzed as
+ *          sharing a stack.
+ * @note    A threshold not above the thread priority has no effect, zero
+ *          removes the threshold.
+ *
+ * @param[in] threshold the new preemption threshold
+ * @return              The old preemption threshold.
+ *
+ * @api
+ */
+tprio_t chThdSetPreemptionThreshold(tprio_t threshold) {
+  thread_t *currtp = chThdGetSelfX();
+  tprio_t oldthreshold;
+
+  chDbgCheck(threshold <= HIGHPRIO);
+
+  chSysLock();
+  oldthreshold = currtp->threshold;
+  currtp->threshold = threshold;
+  chSchRescheduleS();
+  chSysUnlock();
+
+  return oldthreshold;
+}
+#endif
+
 /**
  * @brief   Requests a thread termination.
  * @pre     The target thread must be written to invoke periodically
@@ -729,6 +864,286 @@ void chThdYield(void) {
   chSysUnlock();
 }
 
+#if (CH_CFG_USE_EDF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Moves the running thread in the deadline scheduling class.
+ * @details The thread priority is set to @p CH_CFG_EDF_PRIORITY, threads
+ *          in the class are scheduled by earliest absolute deadline. The
+ *          first job is released at the current time, following jobs are
+ *          released by @p chThdWaitNextPeriod().
+ * @note    Deadlines are not inherited, a thread in the class owning a
+ *          mutex requested by another thread in the class keeps its own
+ *          deadline.
+ *
+ * @param[in] deadline  relative deadline of each job
+ * @param[in] period    jobs release period
+ *
+ * @api
+ */
+void chThdSetDeadline(sysinterval_t deadline, sysinterval_t period) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chDbgCheck((deadline > (sysinterval_t)0) && (period > (sysinterval_t)0) &&
+             (deadline <= ((sysinterval_t)TIME_MAX_SYSTIME >> 1)) &&
+             (period <= (sysinterval_t)TIME_MAX_SYSTIME));
+  chDbgAssert(currtp->edf.rdeadline == (sysinterval_t)0, "already set");
+
+  chSysLock();
+  currtp->edf.rdeadline         = deadline;
+  currtp->edf.period            = period;
+  currtp->edf.release           = chVTGetSystemTimeX();
+  currtp->edf.deadline          = chTimeAddX(currtp->edf.release, deadline);
+  currtp->edf.stats.jobs        = (ucnt_t)0;
+  currtp->edf.stats.misses      = (ucnt_t)0;
+  currtp->edf.stats.maxlateness = (sysinterval_t)0;
+  chSysUnlock();
+
+  currtp->edf.prevprio = chThdSetPriority(CH_CFG_EDF_PRIORITY);
+}
+
+/**
+ * @brief   Removes the running thread from the deadline scheduling class.
+ * @details The thread priority before @p chThdSetDeadline() is restored.
+ *
+ * @api
+ */
+void chThdClearDeadline(void) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chDbgAssert(currtp->edf.rdeadline > (sysinterval_t)0, "not set");
+
+  chSysLock();
+  currtp->edf.rdeadline = (sysinterval_t)0;
+  chSysUnlock();
+
+  (void) chThdSetPriority(currtp->edf.prevprio);
+}
+
+/**
+ * @brief   Completes the current job and waits for the next release.
+ * @details A deadline miss is detected if the job completes after its
+ *          absolute deadline. The next job is released one period after
+ *          the current one, if that time already passed then the function
+ *          returns immediately and the next job starts late.
+ *
+ * @return              The deadline status of the completed job.
+ * @retval false        if the deadline was met.
+ * @retval true         if the deadline was missed.
+ *
+ * @api
+ */
+bool chThdWaitNextPeriod(void) {
+  thread_t *currtp = chThdGetSelfX();
+  sysinterval_t elapsed;
+  bool missed;
+
+  chDbgAssert(currtp->edf.rdeadline > (sysinterval_t)0, "not set");
+
+  chSysLock();
+  elapsed = chTimeDiffX(currtp->edf.release, chVTGetSystemTimeX());
+
+  /* Deadline miss detection.*/
+  currtp->edf.stats.jobs++;
+  missed = (bool)(elapsed > currtp->edf.rdeadline);
+  if (missed) {
+    sysinterval_t lateness = elapsed - currtp->edf.rdeadline;
+
+    currtp->edf.stats.misses++;
+    if (lateness > currtp->edf.stats.maxlateness) {
+      currtp->edf.stats.maxlateness = lateness;
+    }
+  }
+
+  /* Next job, the deadline is updated before sleeping so the thread is
+     made ready in the right position.*/
+  currtp->edf.release  = chTimeAddX(currtp->edf.release,
+                                    currtp->edf.period);
+  currtp->edf.deadline = chTimeAddX(currtp->edf.release,
+                                    currtp->edf.rdeadline);
+  if (elapsed < currtp->edf.period) {
+    chThdSleepS(currtp->edf.period - elapsed);
+  }
+  chSysUnlock();
+
+  return missed;
+}
+
+/**
+ * @brief   Returns the deadline statistics of a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[out] esp      pointer to the statistics to be filled
+ *
+ * @api
+ */
+void chThdGetDeadlineStats(thread_t *tp, edf_stats_t *esp) {
+
+  chDbgCheck((tp != NULL) && (esp != NULL));
+
+  chSysLock();
+  *esp = tp->edf.stats;
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_EDF == TRUE */
+
+#if (CH_CFG_USE_PERIODIC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Makes the running thread periodic.
+ * @details The first job is released at the current time, following jobs
+ *          are released by @p chThdWaitNextRelease() at multiples of the
+ *          period from the first release so there is no cumulative drift.
+ *          The release statistics are cleared.
+ * @note    Threads created from a descriptor specifying a period are
+ *          already periodic.
+ *
+ * @param[in] period    release period, zero makes the thread non periodic
+ * @param[in] policy    overrun policy:
+ *                      - @a CH_PERIODIC_CATCHUP, late releases are
+ *                        executed back to back.
+ *                      - @a CH_PERIODIC_SKIP, late releases are dropped.
+ *                      .
+ *
+ * @api
+ */
+void chThdSetPeriodic(sysinterval_t period, uint8_t policy) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chDbgCheck((period <= (sysinterval_t)TIME_MAX_SYSTIME) &&
+             (policy <= CH_PERIODIC_SKIP));
+
+  chSysLock();
+  currtp->periodic.period          = period;
+  currtp->periodic.policy          = policy;
+  currtp->periodic.release         = chVTGetSystemTimeX();
+  currtp->periodic.stats.releases  = (ucnt_t)0;
+  currtp->periodic.stats.overruns  = (ucnt_t)0;
+  currtp->periodic.stats.skipped   = (ucnt_t)0;
+  currtp->periodic.stats.maxjitter = (sysinterval_t)0;
+#if (CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)
+  currtp->periodic.jobstart        = thd_get_cpu_time(currtp);
+#endif
+  chSysUnlock();
+}
+
+/**
+ * @brief   Completes the current job and waits for the next release.
+ * @details The next release time is one period after the current one. If
+ *          that time already passed then the job overran its period and
+ *          the overrun policy is applied:
+ *          - @a CH_PERIODIC_CATCHUP, the function returns immediately and
+ *            the next job starts late.
+ *          - @a CH_PERIODIC_SKIP, the releases in the past are dropped and
+ *            the thread waits for the first release in the future.
+ *          .
+ *          The release jitter is measured against the system time after
+ *          the thread wakeup.
+ * @note    If @p chThdSetPeriodicMeasurement() has been used then the
+ *          execution time of the completed job is added to the named
+ *          measurement.
+ *
+ * @return              The status of the completed job.
+ * @retval false        if the job completed within its period.
+ * @retval true         if the job overran its period.
+ *
+ * @api
+ */
+bool chThdWaitNextRelease(void) {
+  thread_t *currtp = chThdGetSelfX();
+  thread_periodic_t *pp = &currtp->periodic;
+  sysinterval_t elapsed, jitter;
+  bool overrun;
+
+  chDbgAssert(pp->period > (sysinterval_t)0, "not periodic");
+
+  chSysLock();
+#if (CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)
+  if (pp->exectm != NULL) {
+    chTMAddNamedSampleX(pp->exectm,
+                        (rtcnt_t)(thd_get_cpu_time(currtp) - pp->jobstart));
+  }
+#endif
+
+  /* Overrun detection, the next release time already passed.*/
+  elapsed = chTimeDiffX(pp->release, chVTGetSystemTimeX());
+  overrun = (bool)(elapsed > pp->period);
+  if (overrun) {
+    pp->stats.overruns++;
+    if (pp->policy == CH_PERIODIC_SKIP) {
+      sysinterval_t missed = elapsed / pp->period;
+
+      /* Moving to the last release in the past, it is dropped with the
+         previous ones.*/
+      pp->stats.skipped += (ucnt_t)missed;
+      pp->release        = chTimeAddX(pp->release, missed * pp->period);
+      elapsed           -= missed * pp->period;
+    }
+  }
+
+  /* Next release, computed from the previous one so errors in the wakeup
+     time do not accumulate.*/
+  pp->release = chTimeAddX(pp->release, pp->period);
+  if (elapsed < pp->period) {
+    chThdSleepS(pp->period - elapsed);
+  }
+
+  /* Release statistics.*/
+  jitter = chTimeDiffX(pp->release, chVTGetSystemTimeX());
+  pp->stats.releases++;
+  if (jitter > pp->stats.maxjitter) {
+    pp->stats.maxjitter = jitter;
+  }
+#if (CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)
+  pp->jobstart = thd_get_cpu_time(currtp);
+#endif
+  chSysUnlock();
+
+  return overrun;
+}
+
+/**
+ * @brief   Returns the periodic release statistics of a thread.
+ *
+ * @param[in] tp        pointer to the thread
+ * @param[out] psp      pointer to the statistics to be filled
+ *
+ * @api
+ */
+void chThdGetPeriodicStats(thread_t *tp, periodic_stats_t *psp) {
+
+  chDbgCheck((tp != NULL) && (psp != NULL));
+
+  chSysLock();
+  *psp = tp->periodic.stats;
+  chSysUnlock();
+}
+
+#if ((CH_DBG_STATISTICS == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)) ||    \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Sets the measurement of the jobs execution time.
+ * @details The CPU time consumed by each job of the running thread is
+ *          added as a sample to the specified named measurement, the
+ *          measurement histogram gives the distribution of the execution
+ *          time per period.
+ * @pre     The options @p CH_DBG_STATISTICS and @p CH_CFG_USE_TM_REGISTRY
+ *          must be enabled in order to use this function.
+ *
+ * @param[in] nmp       pointer to a registered @p named_measurement_t
+ *                      structure or @p NULL to stop sampling
+ *
+ * @api
+ */
+void chThdSetPeriodicMeasurement(named_measurement_t *nmp) {
+  thread_t *currtp = chThdGetSelfX();
+
+  chSysLock();
+  currtp->periodic.exectm   = nmp;
+  currtp->periodic.jobstart = thd_get_cpu_time(currtp);
+  chSysUnlock();
+}
+#endif
+#endif /* CH_CFG_USE_PERIODIC == TRUE */
+
 /**
  * @brief   Sends the current thread sleeping and sets a reference variable.
  * @note    This function must reschedule, it can only be called from thread
@@ -879,7 +1294,7 @@ msg_t chThdEnqueueTimeoutS(threads_queue_t *tqp, sysinterval_t timeout) {
 
   ch_queue_insert((ch_queue_t *)currtp, &tqp->queue);
 
-  return chSchGoSleepTimeoutS(CH_STATE_QUEUED, timeout);
+  return __sch_wait_timeout_s(CH_STATE_QUEUED, timeout, tqp);
 }
 
 /**
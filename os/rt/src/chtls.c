@@ -0,0 +1,168 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/**
+ * @file    rt/src/chtls.c
+ * @brief   Thread local storage code.
+ *
+ * @addtogroup thread_local_storage
+ * @details Each thread owns a TLS block allocated in the upper part of its
+ *          working area, below the thread structure. The block is
+ *          initialized from the @p .tdata and @p .tbss sections when the
+ *          thread is created. The thread pointer of the running thread is
+ *          kept in @p ch_tls_tp, the port reads it when the compiler
+ *          accesses a thread local variable, no lookup is performed.
+ *          <br>Optionally a newlib reentrancy structure is allocated next
+ *          to the TLS block and @p _impure_ptr is switched with the
+ *          thread.
+ * @pre     In order to use the TLS the @p CH_CFG_USE_TLS option must be
+ *          enabled in @p chconf.h.
+ * @pre     The linker script must define the @p __tdata_base__,
+ *          @p __tdata_end__, @p __tbss_base__ and @p __tbss_end__
+ *          symbols around the TLS sections.
+ * @note    Thread local variables alignment cannot exceed
+ *          @p PORT_STACK_ALIGN.
+ * @note    The main thread TLS block is statically allocated, the main
+ *          thread keeps the newlib reentrancy structure in use before
+ *          the kernel initialization.
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+
+#if (CH_CFG_USE_TLS == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Thread pointer of the current thread.
+ */
+void *ch_tls_tp;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Linker-defined TLS sections limits.
+ * @{
+ */
+extern uint8_t __tdata_base__[], __tdata_end__[];
+extern uint8_t __tbss_base__[], __tbss_end__[];
+/** @} */
+
+/**
+ * @brief   Main thread TLS block.
+ */
+static stkalign_t ch_tls_main[CH_TLS_BLOCK_SIZE / sizeof (stkalign_t)];
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void tls_block_init(void *base) {
+  uint8_t *vp = (uint8_t *)base + PORT_TLS_TCB_SIZE;
+  size_t tdata = (size_t)(__tdata_end__ - __tdata_base__);
+  size_t total = (size_t)(__tbss_end__ - __tdata_base__);
+
+  memcpy((void *)vp, (const void *)__tdata_base__, tdata);
+  memset((void *)(vp + tdata), 0, total - tdata);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the TLS area of a thread.
+ * @details The thread local variables are initialized from the
+ *          @p .tdata image, the @p .tbss part is cleared.
+ *
+ * @param[out] tp       pointer to the thread
+ * @param[in] base      base of the TLS area
+ *
+ * @notapi
+ */
+void __tls_object_init(thread_t *tp, void *base) {
+
+  tls_block_init(base);
+  tp->tlsp = base;
+
+#if CH_CFG_USE_NEWLIB_REENT == TRUE
+  tp->reent = (struct _reent *)((uint8_t *)base + CH_TLS_BLOCK_SIZE);
+  _REENT_INIT_PTR(tp->reent);
+#endif
+}
+
+/**
+ * @brief   Initializes the TLS of the main thread.
+ * @note    Invoked during the kernel initialization, the main thread
+ *          becomes the TLS owner.
+ *
+ * @param[out] tp       pointer to the main thread
+ *
+ * @notapi
+ */
+void __tls_main_init(thread_t *tp) {
+
+  chDbgAssert((size_t)(__tbss_end__ - __tdata_base__) <=
+              (size_t)CH_CFG_TLS_SIZE, "CH_CFG_TLS_SIZE too small");
+
+  tls_block_init((void *)ch_tls_main);
+  tp->tlsp = (void *)ch_tls_main;
+
+#if CH_CFG_USE_NEWLIB_REENT == TRUE
+  tp->reent = _impure_ptr;
+#endif
+
+  ch_tls_tp = tp->tlsp;
+}
+
+#if (CH_CFG_USE_NEWLIB_REENT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Releases the newlib resources owned by a terminated thread.
+ * @note    Must be invoked from another thread, newlib does not reclaim
+ *          the reentrancy structure in use.
+ *
+ * @param[in] tp        pointer to the terminated thread
+ *
+ * @notapi
+ */
+void __tls_reclaim(thread_t *tp) {
+
+  _reclaim_reent(tp->reent);
+}
+#endif /* CH_CFG_USE_NEWLIB_REENT == TRUE */
+
+#endif /* CH_CFG_USE_TLS == TRUE */
+
+/** @} */
@@ -72,6 +72,61 @@ static inline void tm_stop(time_measurement_t *tmp,
   }
 }
 
+#if (CH_CFG_USE_TM_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the histogram bucket of a measurement.
+ * @details Values below <tt>2^CH_CFG_TM_HISTOGRAM_RESOLUTION</tt> have a
+ *          bucket each, larger values are grouped by their most significant
+ *          bits.
+ *
+ * @param[in] x         the measurement
+ * @return              The bucket index.
+ */
+static unsigned tm_hist_index(rtcnt_t x) {
+  unsigned s;
+
+  if (x < ((rtcnt_t)1 << CH_CFG_TM_HISTOGRAM_RESOLUTION)) {
+    return (unsigned)x;
+  }
+  if (x >= ((rtcnt_t)1 << CH_CFG_TM_HISTOGRAM_RANGE)) {
+    return (unsigned)CH_TM_HISTOGRAM_BUCKETS - 1U;
+  }
+
+  /* Shift bringing the value in the top interval of the mantissa.*/
+  s = 0U;
+  while ((x >> s) >= ((rtcnt_t)2 << CH_CFG_TM_HISTOGRAM_RESOLUTION)) {
+    s++;
+  }
+
+  return ((s + 1U) << CH_CFG_TM_HISTOGRAM_RESOLUTION) +
+         ((unsigned)(x >> s) - (1U << CH_CFG_TM_HISTOGRAM_RESOLUTION));
+}
+
+/**
+ * @brief   Returns the largest measurement counted in an histogram bucket.
+ *
+ * @param[in] i         the bucket index
+ * @return              The bucket upper limit.
+ */
+static rtcnt_t tm_hist_limit(unsigned i) {
+  unsigned s;
+  rtcnt_t m;
+
+  if (i < (1U << CH_CFG_TM_HISTOGRAM_RESOLUTION)) {
+    return (rtcnt_t)i;
+  }
+  if (i >= ((unsigned)CH_TM_HISTOGRAM_BUCKETS - 1U)) {
+    return (rtcnt_t)-1;
+  }
+
+  s = (i >> CH_CFG_TM_HISTOGRAM_RESOLUTION) - 1U;
+  m = (rtcnt_t)(i & ((1U << CH_CFG_TM_HISTOGRAM_RESOLUTION) - 1U)) +
+      ((rtcnt_t)1 << CH_CFG_TM_HISTOGRAM_RESOLUTION);
+
+  return ((m + (rtcnt_t)1) << s) - (rtcnt_t)1;
+}
+#endif /* CH_CFG_USE_TM_REGISTRY == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -166,6 +221,306 @@ NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
   tm_stop(tmp1, tmp2->last, (rtcnt_t)0);
 }
 
+#if (CH_CFG_USE_TM_REGISTRY == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a named measurement and adds it to the registry.
+ *
+ * @param[out] nmp      pointer to a @p named_measurement_t structure
+ * @param[in] name      measurement name
+ *
+ * @api
+ */
+void chTMRegister(named_measurement_t *nmp, const char *name) {
+
+  chDbgCheck((nmp != NULL) && (name != NULL));
+
+  nmp->name = name;
+  chTMResetNamedX(nmp);
+
+  chSysLock();
+  nmp->next = currcore->tmlist;
+  currcore->tmlist = nmp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Removes a named measurement from the registry.
+ *
+ * @param[in] nmp       pointer to a @p named_measurement_t structure
+ *
+ * @api
+ */
+void chTMUnregister(named_measurement_t *nmp) {
+  named_measurement_t **pp;
+
+  chDbgCheck(nmp != NULL);
+
+  chSysLock();
+  pp = &currcore->tmlist;
+  while (*pp != NULL) {
+    if (*pp == nmp) {
+      *pp = nmp->next;
+      break;
+    }
+    pp = &(*pp)->next;
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Clears the statistics of a named measurement.
+ *
+ * @param[out] nmp      pointer to a @p named_measurement_t structure
+ *
+ * @xclass
+ */
+void chTMResetNamedX(named_measurement_t *nmp) {
+  unsigned i;
+
+  chTMObjectInit(&nmp->tm);
+  for (i = 0U; i < (unsigned)CH_TM_HISTOGRAM_BUCKETS; i++) {
+    nmp->hist[i] = (ucnt_t)0;
+  }
+}
+
+/**
+ * @brief   Stops a named measurement.
+ *
+ * @param[in,out] nmp   pointer to a @p named_measurement_t structure
+ *
+ * @xclass
+ */
+NOINLINE void chTMStopNamedMeasurementX(named_measurement_t *nmp) {
+
+  tm_stop(&nmp->tm, chSysGetRealtimeCounterX(), currcore->tmc.offset);
+  nmp->hist[tm_hist_index(nmp->tm.last)]++;
+}
+
+/**
+ * @brief   Adds an externally measured sample to a named measurement.
+ *
+ * @param[in,out] nmp   pointer to a @p named_measurement_t structure
+ * @param[in] sample    the measurement in realtime counter cycles
+ *
+ * @xclass
+ */
+void chTMAddNamedSampleX(named_measurement_t *nmp, rtcnt_t sample) {
+
+  nmp->tm.last = (rtcnt_t)0;
+  tm_stop(&nmp->tm, sample, (rtcnt_t)0);
+  nmp->hist[tm_hist_index(sample)]++;
+}
+
+/**
+ * @brief   Returns a percentile of a named measurement.
+ * @details The returned value is the upper limit of the histogram bucket
+ *          containing the percentile, clamped to the worst measurement.
+ *
+ * @param[in] nmp       pointer to a @p named_measurement_t structure
+ * @param[in] permille  the percentile in thousandths, 500 is the median,
+ *                      990 the 99th and 999 the 99.9th percentile
+ * @return              The percentile in realtime counter cycles, zero if
+ *                      there are no measurements.
+ *
+ * @xclass
+ */
+rtcnt_t chTMGetPercentileX(const named_measurement_t *nmp,
+                           unsigned permille) {
+  rttime_t total, rank, acc;
+  unsigned i;
+
+  chDbgCheck(permille <= 1000U);
+
+  total = (rttime_t)0;
+  for (i = 0U; i < (unsigned)CH_TM_HISTOGRAM_BUCKETS; i++) {
+    total += (rttime_t)nmp->hist[i];
+  }
+  if (total == (rttime_t)0) {
+    return (rtcnt_t)0;
+  }
+
+  /* Rank of the percentile, rounded up.*/
+  rank = ((total * (rttime_t)permille) + (rttime_t)999) / (rttime_t)1000;
+  if (rank == (rttime_t)0) {
+    rank = (rttime_t)1;
+  }
+
+  acc = (rttime_t)0;
+  for (i = 0U; i < ((unsigned)CH_TM_HISTOGRAM_BUCKETS - 1U); i++) {
+    acc += (rttime_t)nmp->hist[i];
+    if (acc >= rank) {
+      break;
+    }
+  }
+
+  return tm_hist_limit(i) < nmp->tm.worst ? tm_hist_limit(i) : nmp->tm.worst;
+}
+
+/**
+ * @brief   Returns a summary of a named measurement.
+ *
+ * @param[in] nmp       pointer to a @p named_measurement_t structure
+ * @param[out] tsp      pointer to a @p tm_summary_t structure
+ *
+ * @xclass
+ */
+void chTMGetSummaryX(const named_measurement_t *nmp, tm_summary_t *tsp) {
+
+  tsp->name       = nmp->name;
+  tsp->n          = nmp->tm.n;
+  tsp->best       = nmp->tm.best;
+  tsp->worst      = nmp->tm.worst;
+  tsp->p50        = chTMGetPercentileX(nmp, 500U);
+  tsp->p99        = chTMGetPercentileX(nmp, 990U);
+  tsp->p999       = chTMGetPercentileX(nmp, 999U);
+  tsp->cumulative = nmp->tm.cumulative;
+}
+
+/**
+ * @brief   Returns the first measurement in the registry.
+ * @note    Measurements must not be unregistered while the registry is
+ *          being scanned.
+ *
+ * @return              The first named measurement or @p NULL.
+ *
+ * @xclass
+ */
+named_measurement_t *chTMRegistryFirstX(void) {
+
+  return currcore->tmlist;
+}
+
+/**
+ * @brief   Returns the next measurement in the registry.
+ *
+ * @param[in] nmp       pointer to a @p named_measurement_t structure
+ * @return              The next named measurement or @p NULL.
+ *
+ * @xclass
+ */
+named_measurement_t *chTMRegistryNextX(named_measurement_t *nmp) {
+
+  return nmp->next;
+}
+
+/**
+ * @brief   Exports the summaries of all the registered measurements.
+ * @note    Measurements must not be unregistered while the registry is
+ *          being exported.
+ *
+ * @param[out] tsp      pointer to an array of @p tm_summary_t structures
+ * @param[in] n         number of elements in the array
+ * @return              The number of exported summaries.
+ *
+ * @api
+ */
+unsigned chTMExportRegistry(tm_summary_t *tsp, unsigned n) {
+  named_measurement_t *nmp;
+  unsigned i;
+
+  chDbgCheck((tsp != NULL) || (n == 0U));
+
+  i = 0U;
+  nmp = chTMRegistryFirstX();
+  while ((nmp != NULL) && (i < n)) {
+    chTMGetSummaryX(nmp, &tsp[i]);
+    i++;
+    nmp = chTMRegistryNextX(nmp);
+  }
+
+  return i;
+}
+#endif /* CH_CFG_USE_TM_REGISTRY == TRUE */
+
+#if (CH_DBG_WAIT_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts profiling the waits on a kernel object.
+ * @details The wait profile measurement is added to the named measurements
+ *          registry.
+ * @note    Semaphores, mutexes and condition variables are profiled by
+ *          passing the object, threads queues by passing the queue, for
+ *          example the @p qr and @p qw queues of a mailbox.
+ *
+ * @param[out] wpp      pointer to a @p wait_profile_t structure
+ * @param[in] objp      pointer to the profiled object
+ * @param[in] name      profile name
+ *
+ * @api
+ */
+void chTMRegisterWait(wait_profile_t *wpp, const void *objp,
+                      const char *name) {
+
+  chDbgCheck((wpp != NULL) && (objp != NULL));
+
+  wpp->objp = objp;
+  chTMRegister(&wpp->nm, name);
+
+  chSysLock();
+  wpp->next = currcore->wplist;
+  currcore->wplist = wpp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Stops profiling the waits on a kernel object.
+ *
+ * @param[in] wpp       pointer to a @p wait_profile_t structure
+ *
+ * @api
+ */
+void chTMUnregisterWait(wait_profile_t *wpp) {
+  wait_profile_t **pp;
+
+  chDbgCheck(wpp != NULL);
+
+  chSysLock();
+  pp = &currcore->wplist;
+  while (*pp != NULL) {
+    if (*pp == wpp) {
+      *pp = wpp->next;
+      break;
+    }
+    pp = &(*pp)->next;
+  }
+  chSysUnlock();
+
+  chTMUnregister(&wpp->nm);
+}
+
+/**
+ * @brief   Puts the current thread to sleep measuring the wait.
+ * @details The wait time is added to the profile of the object, if any.
+ * @note    Not meant to be called directly, the kernel objects use it
+ *          in place of @p chSchGoSleepTimeoutS().
+ *
+ * @param[in] newstate  the new thread state
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @param[in] objp      pointer to the object being waited
+ * @return              The wakeup message.
+ *
+ * @sclass
+ */
+msg_t __tm_wait_s(tstate_t newstate, sysinterval_t timeout,
+                  const void *objp) {
+  rtcnt_t start = chSysGetRealtimeCounterX();
+  wait_profile_t *wpp;
+  msg_t msg;
+
+  msg = chSchGoSleepTimeoutS(newstate, timeout);
+
+  wpp = currcore->wplist;
+  while (wpp != NULL) {
+    if (wpp->objp == objp) {
+      chTMAddNamedSampleX(&wpp->nm, chSysGetRealtimeCounterX() - start);
+      break;
+    }
+    wpp = wpp->next;
+  }
+
+  return msg;
+}
+#endif /* CH_DBG_WAIT_PROFILING == TRUE */
+
 #endif /* CH_CFG_USE_TM == TRUE */
 
 /** @} */
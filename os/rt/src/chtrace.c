@@ -32,6 +32,17 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+/*
+ * Wakeup records, the waited object is saved in the thread when it is
+ * switched out.
+ */
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_WAKEUP) != 0U)
+#define TRACE_WAKEUP                        TRUE
+#else
+#define TRACE_WAKEUP                        FALSE
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -69,6 +80,33 @@ NOINLINE static void trace_next(os_instance_t *oip) {
   if (++oip->trace_buffer.ptr >= &oip->trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
     oip->trace_buffer.ptr = &oip->trace_buffer.buffer[0];
   }
+  oip->trace_buffer.seq++;
+}
+#endif
+
+#if (TRACE_WAKEUP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checks if a thread state refers a waited object.
+ *
+ * @param[in] state     the thread state
+ * @return              The object check result.
+ * @retval false        if @p u.wtobjp does not refer an object.
+ * @retval true         if @p u.wtobjp refers the waited object.
+ *
+ * @notapi
+ */
+static bool trace_has_object(tstate_t state) {
+
+  switch (state) {
+  case CH_STATE_SUSPENDED:
+  case CH_STATE_QUEUED:
+  case CH_STATE_WTSEM:
+  case CH_STATE_WTMTX:
+  case CH_STATE_WTCOND:
+    return true;
+  default:
+    return false;
+  }
 }
 #endif
 
@@ -91,6 +129,7 @@ void __trace_init(os_instance_t *oip) {
   oip->trace_buffer.suspended = (uint16_t)~CH_DBG_TRACE_MASK;
   oip->trace_buffer.size      = CH_DBG_TRACE_BUFFER_SIZE;
   oip->trace_buffer.ptr       = &oip->trace_buffer.buffer[0];
+  oip->trace_buffer.seq       = 0U;
   for (i = 0U; i < (unsigned)CH_DBG_TRACE_BUFFER_SIZE; i++) {
     oip->trace_buffer.buffer[i].type = CH_TRACE_TYPE_UNUSED;
   }
@@ -107,6 +146,22 @@ void __trace_init(os_instance_t *oip) {
 void __trace_ready(thread_t *tp, msg_t msg) {
   os_instance_t *oip = currcore;
 
+#if TRACE_WAKEUP == TRUE
+  if ((oip->trace_buffer.suspended & CH_DBG_TRACE_MASK_WAKEUP) == 0U) {
+    uint8_t state = (uint8_t)tp->state;
+
+    if (port_is_isr_context()) {
+      state |= (uint8_t)CH_TRACE_WAKEUP_FROM_ISR;
+    }
+    oip->trace_buffer.ptr->type        = CH_TRACE_TYPE_WAKEUP;
+    oip->trace_buffer.ptr->state       = state;
+    oip->trace_buffer.ptr->u.wkp.tp    = tp;
+    oip->trace_buffer.ptr->u.wkp.objp  = trace_has_object(tp->state) ?
+                                         tp->wkobjp : NULL;
+    trace_next(oip);
+  }
+#endif
+
   if ((oip->trace_buffer.suspended & CH_DBG_TRACE_MASK_READY) == 0U) {
     oip->trace_buffer.ptr->type        = CH_TRACE_TYPE_READY;
     oip->trace_buffer.ptr->state       = (uint8_t)tp->state;
@@ -127,6 +182,11 @@ void __trace_ready(thread_t *tp, msg_t msg) {
 void __trace_switch(thread_t *ntp, thread_t *otp) {
   os_instance_t *oip = currcore;
 
+#if TRACE_WAKEUP == TRUE
+  /* The waited object is no more available when the thread is woken.*/
+  otp->wkobjp = trace_has_object(otp->state) ? otp->u.wtobjp : NULL;
+#endif
+
   if ((oip->trace_buffer.suspended & CH_DBG_TRACE_MASK_SWITCH) == 0U) {
     oip->trace_buffer.ptr->type        = CH_TRACE_TYPE_SWITCH;
     oip->trace_buffer.ptr->state       = (uint8_t)otp->state;
@@ -194,6 +254,30 @@ void __trace_halt(const char *reason) {
   }
 }
 
+/**
+ * @brief   Inserts in the circular debug trace buffer a critical zone record.
+ * @details The record is an user record with the caller address as first
+ *          parameter and the zone duration as second parameter.
+ * @note    This function is invoked from within the critical zone being
+ *          terminated.
+ *
+ * @param[in] caller    return address of the function entering the zone
+ * @param[in] duration  zone duration in realtime counter cycles
+ *
+ * @notapi
+ */
+void __trace_crit(void *caller, rtcnt_t duration) {
+  os_instance_t *oip = currcore;
+
+  if ((oip->trace_buffer.suspended & CH_DBG_TRACE_MASK_USER) == 0U) {
+    oip->trace_buffer.ptr->type       = CH_TRACE_TYPE_USER;
+    oip->trace_buffer.ptr->state      = 0;
+    oip->trace_buffer.ptr->u.user.up1 = caller;
+    oip->trace_buffer.ptr->u.user.up2 = (void *)(uintptr_t)duration;
+    trace_next(oip);
+  }
+}
+
 /**
  * @brief   Adds an user trace record to the trace buffer.
  *
@@ -286,6 +370,61 @@ void chDbgResumeTrace(uint16_t mask) {
   chDbgResumeTraceI(mask);
   chSysUnlock();
 }
+
+/**
+ * @brief   Returns the number of trace records written.
+ * @details The value is the sequence number of the next record to be
+ *          written, the last @p CH_DBG_TRACE_BUFFER_SIZE records can be
+ *          read using @p chDbgReadTraceI().
+ *
+ * @return              The trace records counter.
+ *
+ * @xclass
+ */
+uint32_t chDbgGetTraceSequenceX(void) {
+
+  return currcore->trace_buffer.seq;
+}
+
+/**
+ * @brief   Reads a record from the trace buffer.
+ * @details The record is identified by its sequence number, readers can
+ *          copy the buffer a record at a time, each copy is consistent and
+ *          records overwritten in the meantime are detected.
+ *
+ * @param[in] seq       sequence number of the record
+ * @param[out] tep      pointer to the @p trace_event_t to be filled
+ * @return              The operation result.
+ * @retval true         if the record has been copied.
+ * @retval false        if the record has been overwritten or has not been
+ *                      written yet.
+ *
+ * @iclass
+ */
+bool chDbgReadTraceI(uint32_t seq, trace_event_t *tep) {
+  trace_buffer_t *tbp = &currcore->trace_buffer;
+  uint32_t age;
+  unsigned idx;
+
+  chDbgCheckClassI();
+  chDbgCheck(tep != NULL);
+
+  /* Records written after the requested one, the requested one included,
+     the arithmetic is modulo 2^32.*/
+  age = tbp->seq - seq;
+  if ((age == 0U) || (age > (uint32_t)CH_DBG_TRACE_BUFFER_SIZE)) {
+    return false;
+  }
+
+  idx = (unsigned)(tbp->ptr - &tbp->buffer[0]) +
+        (unsigned)CH_DBG_TRACE_BUFFER_SIZE - (unsigned)age;
+  if (idx >= (unsigned)CH_DBG_TRACE_BUFFER_SIZE) {
+    idx -= (unsigned)CH_DBG_TRACE_BUFFER_SIZE;
+  }
+  *tep = tbp->buffer[idx];
+
+  return true;
+}
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 
 /** @} */
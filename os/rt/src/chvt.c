@@ -32,6 +32,31 @@
 /* Module local definitions.                                                 */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Compiler barrier.
+ * @details The time stamp slots accesses must not be moved across the
+ *          updates of the publication counter.
+ */
+#if defined(__GNUC__) || defined(__DOXYGEN__)
+#define __vt_stamp_barrier()    __asm volatile ("" : : : "memory")
+#else
+#define __vt_stamp_barrier()
+#endif
+#endif
+
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Timer owning a deferred callbacks queue element.
+ */
+#define __vt_dqueue_owner(qp)                                               \
+  /*lint -save -e9005 -e9033 -e413 [11.8, 10.8 1.3] Normal pointers
+    arithmetic, it is safe.*/                                               \
+  ((virtual_timer_t *)(void *)((char *)(qp) -                               \
+   ((char *)&((virtual_timer_t *)0)->dqueue - (char *)0)))                  \
+  /*lint -restore*/
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -60,6 +85,308 @@ static inline bool is_vtlist_empty(delta_list_t *dlhp) {
   return (bool)(dlhp == dlhp->next);
 }
 
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Expiration callback of the deferred timers.
+ * @details The timer is queued for the timers thread. The thread is only
+ *          awakened by the first queued timer, all the timers expiring in
+ *          the same tick are served by a single thread activation.
+ *
+ * @param[in] p         pointer to the expired @p virtual_timer_t object
+ *
+ * @notapi
+ */
+static void vt_deferred_cb(void *p) {
+  virtual_timer_t *vtp = (virtual_timer_t *)p;
+  os_instance_t *oip = currcore;
+
+  chSysLockFromISR();
+
+  /* A timer expiring again before the execution of its callback is not
+     queued twice.*/
+  if (vtp->dqueue.next == NULL) {
+    ch_queue_insert(&vtp->dqueue, &oip->vtdeferred);
+    chThdResumeI(&oip->vtthread, MSG_OK);
+  }
+
+  chSysUnlockFromISR();
+}
+#endif
+
+#if (CH_CFG_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Publishes a new time stamp.
+ * @details The stamp is written into the slot not visible to readers then
+ *          the counter is incremented making it visible, readers are never
+ *          exposed to a partially written stamp, not even readers running
+ *          in fast interrupts preempting this function.
+ *
+ * @param[in] stamp     the new time stamp
+ *
+ * @notapi
+ */
+static inline void vt_stamp_publish(systimestamp_t stamp) {
+  ucnt_t seq = ch.vtlist.stampseq + (ucnt_t)1;
+
+  ch.vtlist.stamps[seq & (ucnt_t)1] = stamp;
+  __vt_stamp_barrier();
+  ch.vtlist.stampseq = seq;
+}
+
+/**
+ * @brief   Re-synchronizes the time stamps if required.
+ * @details A new stamp is published when more than half of the system
+ *          time range elapsed since the last one, this keeps lock-free
+ *          readers synchronized as long as virtual timers are processed.
+ *
+ * @notapi
+ */
+static inline void vt_stamp_refresh(void) {
+  systime_t last = (systime_t)ch.vtlist.stamps[ch.vtlist.stampseq &
+                                               (ucnt_t)1];
+  systime_t now = chVTGetSystemTimeX();
+
+  if (chTimeDiffX(last, now) > (sysinterval_t)(((systime_t)-1) >> 1)) {
+    (void) chVTGetTimeStampI();
+  }
+}
+#endif
+
+#if (CH_CFG_USE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Wheel slot index for a given expiration time.
+ *
+ * @param[in] t         the expiration time
+ *
+ * @notapi
+ */
+#define vt_wheel_slot(t)                                                    \
+  ((unsigned)((t) & (systime_t)(CH_CFG_VT_WHEEL_SLOTS - 1)))
+
+/**
+ * @brief   Longest delay handled by a single wheel arming.
+ * @details Longer delays are split and the timer is re-armed internally
+ *          until the whole delay has elapsed. In tickless mode the value
+ *          is also the longest interval between consecutive alarms, this
+ *          keeps all the expiration times within half of the system time
+ *          range from the last processed time.
+ */
+#if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
+#define VT_WHEEL_MAX_DELAY          ((sysinterval_t)TIME_MAX_SYSTIME)
+#else
+#define VT_WHEEL_MAX_DELAY          ((sysinterval_t)(TIME_MAX_SYSTIME / 4U))
+#endif
+
+/**
+ * @brief   Slot empty check.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] slot      the slot index
+ *
+ * @notapi
+ */
+static inline bool is_slot_used(virtual_timers_list_t *vtlp, unsigned slot) {
+
+  return (bool)((vtlp->slotmap[slot / 32U] & (1U << (slot % 32U))) != 0U);
+}
+
+/**
+ * @brief   Links a timer in the slot of its expiration time.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @notapi
+ */
+static inline void vt_wheel_link(virtual_timers_list_t *vtlp,
+                                 virtual_timer_t *vtp) {
+  unsigned slot = vt_wheel_slot(vtp->deadline);
+  delta_list_t *hp = &vtlp->slots[slot];
+
+  vtp->dlist.next       = hp;
+  vtp->dlist.prev       = hp->prev;
+  vtp->dlist.prev->next = &vtp->dlist;
+  hp->prev              = &vtp->dlist;
+
+  vtlp->slotmap[slot / 32U] |= 1U << (slot % 32U);
+}
+
+/**
+ * @brief   Unlinks a timer from its slot.
+ * @note    The timer could be in a temporary list created while processing
+ *          its slot, this is handled transparently.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @notapi
+ */
+static inline void vt_wheel_unlink(virtual_timers_list_t *vtlp,
+                                   virtual_timer_t *vtp) {
+  unsigned slot = vt_wheel_slot(vtp->deadline);
+  delta_list_t *hp = &vtlp->slots[slot];
+
+  vtp->dlist.prev->next = vtp->dlist.next;
+  vtp->dlist.next->prev = vtp->dlist.prev;
+
+  if (is_vtlist_empty(hp)) {
+    vtlp->slotmap[slot / 32U] &= ~(1U << (slot % 32U));
+  }
+}
+
+/**
+ * @brief   Places a timer in the wheel.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] base      time from which the delay is counted
+ * @param[in] delay     the delay, must be greater than zero
+ *
+ * @notapi
+ */
+static void vt_wheel_arm(virtual_timers_list_t *vtlp,
+                         virtual_timer_t *vtp,
+                         systime_t base,
+                         sysinterval_t delay) {
+
+  if (delay > VT_WHEEL_MAX_DELAY) {
+    vtp->dlist.delta = delay - VT_WHEEL_MAX_DELAY;
+    delay = VT_WHEEL_MAX_DELAY;
+  }
+  else {
+    vtp->dlist.delta = (sysinterval_t)0;
+  }
+  vtp->deadline = chTimeAddX(base, delay);
+
+  vt_wheel_link(vtlp, vtp);
+}
+
+/**
+ * @brief   Processes a wheel slot.
+ * @details Timers expiring within the interval starting after @p last and
+ *          lasting @p elapsed ticks are triggered, the other timers are
+ *          left in place.
+ * @note    The system lock is released around callbacks.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] slot      the slot index
+ * @param[in] last      last already processed time
+ * @param[in] elapsed   ticks elapsed since @p last
+ *
+ * @notapi
+ */
+static void vt_wheel_process_slot(virtual_timers_list_t *vtlp,
+                                  unsigned slot,
+                                  systime_t last,
+                                  sysinterval_t elapsed) {
+  delta_list_t *hp = &vtlp->slots[slot];
+  delta_list_t pending;
+
+  /* The slot content is moved in a temporary list so that timers armed
+     by callbacks are not processed in this round.*/
+  pending.next       = hp->next;
+  pending.prev       = hp->prev;
+  pending.next->prev = &pending;
+  pending.prev->next = &pending;
+  hp->next           = hp;
+  hp->prev           = hp;
+  vtlp->slotmap[slot / 32U] &= ~(1U << (slot % 32U));
+
+  while (!is_vtlist_empty(&pending)) {
+    virtual_timer_t *vtp = (virtual_timer_t *)pending.next;
+    sysinterval_t late;
+    vtfunc_t fn;
+
+    /* Removing the timer from the temporary list.*/
+    pending.next       = vtp->dlist.next;
+    pending.next->prev = &pending;
+
+    /* Timers belonging to a future round go back in their slot.*/
+    if (chTimeDiffX(last, vtp->deadline) > elapsed) {
+      vt_wheel_link(vtlp, vtp);
+      continue;
+    }
+
+    /* Long delays are re-armed for the remaining interval.*/
+    late = elapsed - chTimeDiffX(last, vtp->deadline);
+    if (vtp->dlist.delta > late) {
+      vt_wheel_arm(vtlp, vtp, chTimeAddX(last, elapsed),
+                   vtp->dlist.delta - late);
+      continue;
+    }
+
+    /* Calling the associated function and then marking the timer as
+       non active.*/
+    fn = vtp->func;
+    vtp->func = NULL;
+    vtlp->armed--;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+    /* If the wheel becomes empty then the timer is stopped.*/
+    if (vtlp->armed == (ucnt_t)0) {
+      port_timer_stop_alarm();
+    }
+#endif
+
+    /* The callback is invoked outside the kernel critical zone.*/
+    chSysUnlockFromISR();
+    fn(vtp->par);
+    chSysLockFromISR();
+  }
+}
+
+/**
+ * @brief   Finds the nearest expiration time in the wheel.
+ * @pre     All timers must expire after @p last.
+ *
+ * @param[in] vtlp      pointer to the timers wheel
+ * @param[in] last      reference time
+ * @param[out] intp     interval between @p last and the nearest expiration
+ * @return              The wheel state.
+ * @retval false        if the wheel is empty.
+ * @retval true         if the wheel contains at least one timer.
+ *
+ * @notapi
+ */
+static bool vt_wheel_nearest(virtual_timers_list_t *vtlp,
+                             systime_t last,
+                             sysinterval_t *intp) {
+  sysinterval_t nearest = (sysinterval_t)-1;
+  unsigned i;
+
+  if (vtlp->armed == (ucnt_t)0) {
+    return false;
+  }
+
+  /* Slots are scanned in expiration order, timers in the slot at distance
+     "i" expire after at least "i" ticks so the scan can be stopped as soon
+     as a closer timer has been found.*/
+  for (i = 1U; i <= (unsigned)CH_CFG_VT_WHEEL_SLOTS; i++) {
+    unsigned slot = vt_wheel_slot(chTimeAddX(last, (sysinterval_t)i));
+
+    if (is_slot_used(vtlp, slot)) {
+      delta_list_t *dlp = vtlp->slots[slot].next;
+
+      while (dlp != &vtlp->slots[slot]) {
+        sysinterval_t delta = chTimeDiffX(last,
+                                          ((virtual_timer_t *)dlp)->deadline);
+        if (delta < nearest) {
+          nearest = delta;
+        }
+        dlp = dlp->next;
+      }
+
+      if (nearest <= (sysinterval_t)i) {
+        break;
+      }
+    }
+  }
+
+  *intp = nearest;
+
+  return true;
+}
+#else /* CH_CFG_USE_VT_WHEEL == FALSE */
 #if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
 /**
  * @brief   Last timer in the list check.
@@ -128,11 +455,241 @@ static void vt_list_compress(virtual_timers_list_t *vtlp,
   }
 }
 #endif
+#endif /* CH_CFG_USE_VT_WHEEL == FALSE */
 
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_VT_WHEEL == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a virtual timer.
+ * @details The timer is enabled and programmed to trigger after the delay
+ *          specified as parameter.
+ * @pre     The timer must not be already armed before calling this function.
+ * @note    The callback function is invoked from interrupt context.
+ *
+ * @param[out] vtp      the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ * @param[in] vtfunc    the timer callback function. After invoking the
+ *                      callback the timer is disabled and the structure can
+ *                      be disposed or reused.
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
+                vtfunc_t vtfunc, void *par) {
+  virtual_timers_list_t *vtlp = &currcore->vtlist;
+
+  chDbgCheckClassI();
+  chDbgCheck((vtp != NULL) && (vtfunc != NULL) && (delay != TIME_IMMEDIATE));
+
+  vtp->par = par;
+  vtp->func = vtfunc;
+
+#if CH_CFG_ST_TIMEDELTA == 0
+  vt_wheel_arm(vtlp, vtp, vtlp->systime, delay);
+  vtlp->armed++;
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  {
+    systime_t now = chVTGetSystemTimeX();
+
+    /* If the requested delay is lower than the minimum safe delta then it
+       is raised to the minimum safe value.*/
+    if (delay < (sysinterval_t)CH_CFG_ST_TIMEDELTA) {
+      delay = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
+    }
+
+    /* Special case where the wheel is empty, the current time becomes the
+       new reference time and the alarm timer is started.*/
+    if (vtlp->armed == (ucnt_t)0) {
+      vtlp->lasttime = now;
+      vt_wheel_arm(vtlp, vtp, now, delay);
+      vtlp->armed = (ucnt_t)1;
+      vtlp->alarm = vtp->deadline;
+      port_timer_start_alarm(vtlp->alarm);
+
+      return;
+    }
+
+    vt_wheel_arm(vtlp, vtp, now, delay);
+    vtlp->armed++;
+
+    /* The alarm is moved if this timer expires before it, if the alarm
+       time has already been reached then the event is pending and the
+       alarm is left untouched.*/
+    if ((chTimeDiffX(vtlp->lasttime, now) <
+         chTimeDiffX(vtlp->lasttime, vtlp->alarm)) &&
+        (chTimeDiffX(vtlp->lasttime, vtp->deadline) <
+         chTimeDiffX(vtlp->lasttime, vtlp->alarm))) {
+      vtlp->alarm = vtp->deadline;
+      port_timer_set_alarm(vtlp->alarm);
+    }
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+
+/**
+ * @brief   Disables a Virtual Timer.
+ * @pre     The timer must be in armed state before calling this function.
+ * @note    In tickless mode the alarm is not moved, an alarm with no
+ *          expired timers is simply ignored.
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @iclass
+ */
+void chVTDoResetI(virtual_timer_t *vtp) {
+  virtual_timers_list_t *vtlp = &currcore->vtlist;
+
+  chDbgCheckClassI();
+  chDbgCheck(vtp != NULL);
+  chDbgAssert(vtp->func != NULL, "timer not set or already triggered");
+
+  vt_wheel_unlink(vtlp, vtp);
+  vtp->func = NULL;
+  vtlp->armed--;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* If the wheel becomes empty then the alarm timer is stopped.*/
+  if (vtlp->armed == (ucnt_t)0) {
+    port_timer_stop_alarm();
+  }
+#endif
+}
+
+/**
+ * @brief   Virtual timers ticker.
+ * @note    The system lock is released before entering the callback and
+ *          re-acquired immediately after. It is callback's responsibility
+ *          to acquire the lock if needed. This is done in order to reduce
+ *          interrupts jitter when many timers are in use.
+ *
+ * @iclass
+ */
+CC_FAST_CODE
+void chVTDoTickI(void) {
+  virtual_timers_list_t *vtlp = &currcore->vtlist;
+
+  chDbgCheckClassI();
+
+#if CH_CFG_USE_TIMESTAMP == TRUE
+  vt_stamp_refresh();
+#endif
+
+#if CH_CFG_ST_TIMEDELTA == 0
+  vtlp->systime++;
+  if (vtlp->armed > (ucnt_t)0) {
+    systime_t now = vtlp->systime;
+
+    /* Only the slot of the current tick needs to be processed.*/
+    if (is_slot_used(vtlp, vt_wheel_slot(now))) {
+      vt_wheel_process_slot(vtlp, vt_wheel_slot(now),
+                            now - (systime_t)1, (sysinterval_t)1);
+    }
+  }
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  systime_t now = chVTGetSystemTimeX();
+  sysinterval_t nearest, elapsed;
+
+  while (true) {
+    systime_t last = vtlp->lasttime;
+    sysinterval_t i, n;
+
+    /* Processing all the slots between the last processed time and now, if
+       more than a whole round elapsed then all slots are processed.*/
+    elapsed = chTimeDiffX(last, now);
+    n = elapsed < (sysinterval_t)CH_CFG_VT_WHEEL_SLOTS ?
+        elapsed : (sysinterval_t)CH_CFG_VT_WHEEL_SLOTS;
+    for (i = (sysinterval_t)1; i <= n; i++) {
+      unsigned slot = vt_wheel_slot(chTimeAddX(last, i));
+
+      if (is_slot_used(vtlp, slot)) {
+        vt_wheel_process_slot(vtlp, slot, last, elapsed);
+      }
+    }
+    vtlp->lasttime = now;
+
+    /* If the wheel is empty, nothing else to do.*/
+    if (!vt_wheel_nearest(vtlp, now, &nearest)) {
+      return;
+    }
+
+    /* Callbacks could have taken time, if the nearest timer already expired
+       then another processing round is performed.*/
+    now = chVTGetSystemTimeX();
+    elapsed = chTimeDiffX(vtlp->lasttime, now);
+    if (nearest > elapsed) {
+      break;
+    }
+  }
+
+  /* Recalculating the next alarm time.*/
+  if ((nearest - elapsed) < (sysinterval_t)CH_CFG_ST_TIMEDELTA) {
+    vtlp->alarm = chTimeAddX(now, (sysinterval_t)CH_CFG_ST_TIMEDELTA);
+  }
+  else {
+    if (nearest > VT_WHEEL_MAX_DELAY) {
+      nearest = VT_WHEEL_MAX_DELAY;
+    }
+    vtlp->alarm = chTimeAddX(vtlp->lasttime, nearest);
+  }
+  port_timer_set_alarm(vtlp->alarm);
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+
+/**
+ * @brief   Returns the time interval until the next timer event.
+ * @note    The return value is not perfectly accurate and can report values
+ *          in excess of @p CH_CFG_ST_TIMEDELTA ticks.
+ * @note    The interval returned by this function is only meaningful if
+ *          more timers are not added to the list until the returned time.
+ *
+ * @param[out] timep    pointer to a variable that will contain the time
+ *                      interval until the next timer elapses. This pointer
+ *                      can be @p NULL if the information is not required.
+ * @return              The time, in ticks, until next time event.
+ * @retval false        if the timers list is empty.
+ * @retval true         if the timers list contains at least one timer.
+ *
+ * @iclass
+ */
+bool chVTGetTimersStateI(sysinterval_t *timep) {
+  virtual_timers_list_t *vtlp = &currcore->vtlist;
+  sysinterval_t nearest;
+
+  chDbgCheckClassI();
+
+#if CH_CFG_ST_TIMEDELTA == 0
+  if (!vt_wheel_nearest(vtlp, vtlp->systime, &nearest)) {
+    return false;
+  }
+
+  if (timep != NULL) {
+    *timep = nearest;
+  }
+#else
+  if (!vt_wheel_nearest(vtlp, vtlp->lasttime, &nearest)) {
+    return false;
+  }
+
+  if (timep != NULL) {
+    *timep = (nearest + (sysinterval_t)CH_CFG_ST_TIMEDELTA) -
+             chTimeDiffX(vtlp->lasttime, chVTGetSystemTimeX());
+  }
+#endif
+
+  return true;
+}
+
+#else /* CH_CFG_USE_VT_WHEEL == FALSE */
 /**
  * @brief   Enables a virtual timer.
  * @details The timer is enabled and programmed to trigger after the delay
@@ -239,7 +796,7 @@ void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
   dlp = vtlp->dlist.next;
   while (dlp->delta < delta) {
     /* Debug assert if the timer is already in the list.*/
-    chDbgAssert(dlp != &vtp->dlist, "timer already armed");
+    chDbgAssertExpensive(dlp != &vtp->dlist, "timer already armed");
 
     delta -= dlp->delta;
     dlp = dlp->next;
@@ -366,11 +923,16 @@ void chVTDoResetI(virtual_timer_t *vtp) {
  *
  * @iclass
  */
+CC_FAST_CODE
 void chVTDoTickI(void) {
   virtual_timers_list_t *vtlp = &currcore->vtlist;
 
   chDbgCheckClassI();
 
+#if CH_CFG_USE_TIMESTAMP == TRUE
+  vt_stamp_refresh();
+#endif
+
 #if CH_CFG_ST_TIMEDELTA == 0
   vtlp->systime++;
   if (!is_vtlist_empty(&vtlp->dlist)) {
@@ -472,6 +1034,78 @@ void chVTDoTickI(void) {
               "exceeding delta");
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
 }
+#endif /* CH_CFG_USE_VT_WHEEL == FALSE */
+
+#if (CH_CFG_USE_VT_SLACK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a virtual timer with a slack.
+ * @details The timer is enabled and programmed to trigger after the delay
+ *          specified as parameter or up to @p slack ticks later. If an
+ *          already armed timer expires within that window then the new
+ *          timer is aligned to it and both are served by the same alarm,
+ *          this reduces the number of alarm events in tickless mode.
+ * @pre     The timer must not be already armed before calling this function.
+ * @note    The callback function is invoked from interrupt context.
+ * @note    Timers armed using @p chVTDoSetI() have exact deadlines, they
+ *          are never moved but timers with a slack can be aligned to them.
+ *
+ * @param[out] vtp      the @p virtual_timer_t structure pointer
+ * @param[in] delay     the minimum number of ticks before the expiration,
+ *                      @a TIME_IMMEDIATE is not allowed
+ * @param[in] slack     the maximum number of ticks the expiration can be
+ *                      delayed by
+ * @param[in] vtfunc    the timer callback function. After invoking the
+ *                      callback the timer is disabled and the structure can
+ *                      be disposed or reused.
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+void chVTDoSetSlackI(virtual_timer_t *vtp, sysinterval_t delay,
+                     sysinterval_t slack, vtfunc_t vtfunc, void *par) {
+  virtual_timers_list_t *vtlp = &currcore->vtlist;
+  sysinterval_t base, target, deadline;
+  delta_list_t *dlp;
+
+  chDbgCheckClassI();
+  chDbgCheck((vtp != NULL) && (vtfunc != NULL) && (delay != TIME_IMMEDIATE));
+
+  vtlp->slackarms++;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  /* Deadlines in the delta list are relative to the last tick event.*/
+  base = chTimeDiffX(vtlp->lasttime, chVTGetSystemTimeX());
+#else
+  base = (sysinterval_t)0;
+#endif
+  target = base + delay;
+
+  /* Searching for the first armed deadline within the window, the search
+     is skipped if the window exceeds the numeric range.*/
+  if ((target >= base) && ((target + slack) >= target)) {
+    deadline = (sysinterval_t)0;
+    dlp = vtlp->dlist.next;
+    while (dlp != &vtlp->dlist) {
+      deadline += dlp->delta;
+      if (deadline > (target + slack)) {
+        break;
+      }
+      if (deadline >= target) {
+        /* An equal deadline is already shared, no need to move.*/
+        if (deadline > target) {
+          delay = deadline - base;
+          vtlp->coalesced++;
+        }
+        break;
+      }
+      dlp = dlp->next;
+    }
+  }
+
+  chVTDoSetI(vtp, delay, vtfunc, par);
+}
+#endif /* CH_CFG_USE_VT_SLACK == TRUE */
 
 #if (CH_CFG_USE_TIMESTAMP == TRUE) || defined(__DOXYGEN__)
 /**
@@ -481,9 +1115,10 @@ void chVTDoTickI(void) {
  *          system time.
  * @note    There is an assumption, this function must be called at
  *          least once before the system time wraps back to zero or
- *          synchronization is lost. You may use a periodic virtual timer with
- *          a very large interval in order to keep time stamps synchronized
- *          by calling this function.
+ *          synchronization is lost. This is done automatically while
+ *          virtual timers are being processed, in tick-less mode you may
+ *          use a periodic virtual timer with a very large interval in
+ *          order to keep time stamps synchronized.
  *
  * @return              The time stamp.
  *
@@ -499,21 +1134,53 @@ systimestamp_t chVTGetTimeStampI(void) {
   now = chVTGetSystemTimeX();
 
   /* Last time stamp generated.*/
-  last = ch.vtlist.laststamp;
+  last = ch.vtlist.stamps[ch.vtlist.stampseq & (ucnt_t)1];
 
   /* Interval between the last time stamp and current time used for a new
      time stamp. Note that this fails if the interval is larger than a
      systime_t type.*/
   stamp = last + (systimestamp_t)chTimeDiffX((systime_t)last, now);
 
-  chDbgAssert(ch.vtlist.laststamp <= stamp, "wrapped");
+  chDbgAssert(last <= stamp, "wrapped");
 
-  /* Storing the new stamp.*/
-  ch.vtlist.laststamp = stamp;
+  /* Publishing the new stamp.*/
+  vt_stamp_publish(stamp);
 
   return stamp;
 }
 
+/**
+ * @brief   Generates a monotonic time stamp without locking.
+ * @details This function returns the same time base of
+ *          @p chVTGetTimeStampI() without entering a critical zone and
+ *          without updating the last published stamp. It can be called
+ *          from any context including fast interrupts.
+ * @note    The time stamps are kept synchronized by the kernel while
+ *          virtual timers are processed, see @p chVTGetTimeStampI().
+ *
+ * @return              The time stamp.
+ *
+ * @xclass
+ */
+systimestamp_t chVTGetTimeStampX(void) {
+  systimestamp_t last;
+  systime_t now;
+  ucnt_t seq;
+
+  /* The published slot is read and the operation is retried if a new
+     stamp has been published meanwhile, the read slot could have been
+     overwritten by a second publication.*/
+  do {
+    seq = ch.vtlist.stampseq;
+    __vt_stamp_barrier();
+    last = ch.vtlist.stamps[seq & (ucnt_t)1];
+    now  = chVTGetSystemTimeX();
+    __vt_stamp_barrier();
+  } while (seq != ch.vtlist.stampseq);
+
+  return last + (systimestamp_t)chTimeDiffX((systime_t)last, now);
+}
+
 /**
  * @brief   Resets and re-synchronizes the time stamps monotonic counter.
  *
@@ -523,9 +1190,108 @@ void chVTResetTimeStampI(void) {
 
   chDbgCheckClassI();
 
-  ch.vtlist.laststamp = (systimestamp_t)chVTGetSystemTimeX();
+  vt_stamp_publish((systimestamp_t)chVTGetSystemTimeX());
 }
 
 #endif /* CH_CFG_USE_TIMESTAMP == TRUE */
 
+#if (CH_CFG_USE_VT_DEFERRED == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Enables a deferred virtual timer.
+ * @details The callback is not executed in the system tick interrupt, the
+ *          expired timer is queued and the callback is executed by the
+ *          timers thread, with the kernel unlocked. Deferred callbacks can
+ *          use any API including blocking ones.
+ * @note    If the timer expires again before the execution of its callback
+ *          then the callback is executed once.
+ * @note    A callback still waiting to be executed is not cancelled by
+ *          re-arming the timer, it is executed using the new function and
+ *          parameter.
+ * @pre     The timer must have been initialized using @p chVTObjectInit().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @param[in] delay     the number of ticks before the operation timeouts, the
+ *                      special values are handled as follow:
+ *                      - @a TIME_INFINITE is allowed but interpreted as a
+ *                        normal time specification.
+ *                      - @a TIME_IMMEDIATE this value is not allowed.
+ *                      .
+ * @param[in] vtfunc    the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+void chVTSetDeferredI(virtual_timer_t *vtp, sysinterval_t delay,
+                      vtfunc_t vtfunc, void *par) {
+
+  chDbgCheckClassI();
+  chDbgCheck((vtp != NULL) && (vtfunc != NULL));
+
+  chVTResetI(vtp);
+  vtp->dfunc = vtfunc;
+  vtp->dpar  = par;
+  chVTDoSetI(vtp, delay, vt_deferred_cb, (void *)vtp);
+}
+
+/**
+ * @brief   Disables a deferred virtual timer.
+ * @details The timer is disarmed and a callback still waiting to be
+ *          executed by the timers thread is cancelled.
+ * @pre     The timer must have been initialized using @p chVTObjectInit().
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ *
+ * @iclass
+ */
+void chVTResetDeferredI(virtual_timer_t *vtp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(vtp != NULL);
+
+  chVTResetI(vtp);
+  if (vtp->dqueue.next != NULL) {
+    (void) ch_queue_dequeue(&vtp->dqueue);
+    vtp->dqueue.next = NULL;
+  }
+}
+
+/**
+ * @brief   Deferred timers thread.
+ * @details Executes the callbacks of the expired deferred timers in
+ *          expiration order.
+ *
+ * @param[in] p         pointer to the owner @p os_instance_t object
+ *
+ * @notapi
+ */
+void __vt_thread(void *p) {
+  os_instance_t *oip = (os_instance_t *)p;
+
+  chSysLock();
+  while (true) {
+    virtual_timer_t *vtp;
+    vtfunc_t fn;
+    void *par;
+
+    if (ch_queue_isempty(&oip->vtdeferred)) {
+      (void) chThdSuspendS(&oip->vtthread);
+      continue;
+    }
+
+    /* Removing the timer from the queue, from now on the timer can be
+       queued again.*/
+    vtp = __vt_dqueue_owner(ch_queue_fifo_remove(&oip->vtdeferred));
+    vtp->dqueue.next = NULL;
+    fn  = vtp->dfunc;
+    par = vtp->dpar;
+
+    /* The callback is invoked outside the kernel critical zone.*/
+    chSysUnlock();
+    fn(par);
+    chSysLock();
+  }
+}
+#endif /* CH_CFG_USE_VT_DEFERRED == TRUE */
+
 /** @} */
@@ -38,6 +38,7 @@
  */
 #define SB_ERR_NOERROR          0U
 #define SB_ERR_ENOENT           ((uint32_t)(-2))
+#define SB_ERR_ENOMEM           ((uint32_t)(-12))
 #define SB_ERR_EFAULT           ((uint32_t)(-14))
 #define SB_ERR_EBUSY            ((uint32_t)(-16))
 #define SB_ERR_EINVAL           ((uint32_t)(-22))
@@ -0,0 +1,170 @@
+/*
+    ChibiOS - Copyright (C) 2006..2019 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/common/sbring.h
+ * @brief   ARMv7-M sandbox syscall ring macros and structures.
+ * @details The syscall ring is a memory area inside the sandbox shared with
+ *          the host. The sandbox queues requests in the submission queue
+ *          then a single SVC makes the host execute all of them, the
+ *          results are appended to the completion queue where the sandbox
+ *          can collect them without further traps.
+ *
+ * @addtogroup ARM_SANDBOX_RING
+ * @{
+ */
+
+#ifndef SBRING_H
+#define SBRING_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   SVC number of the ring enter service.
+ */
+#define SB_RING_SVC             13U
+
+/**
+ * @brief   Maximum number of entries in a ring.
+ */
+#define SB_RING_MAX_ENTRIES     256U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a submission queue entry.
+ */
+typedef struct {
+  /**
+   * @brief   SVC number of the requested service.
+   */
+  uint32_t                  opcode;
+  /**
+   * @brief   Service arguments, passed in r0...r3.
+   */
+  uint32_t                  args[4];
+  /**
+   * @brief   Opaque value copied in the matching completion entry.
+   */
+  uint32_t                  user_data;
+} sb_sqe_t;
+
+/**
+ * @brief   Type of a completion queue entry.
+ */
+typedef struct {
+  /**
+   * @brief   Value of the @p user_data field of the request.
+   */
+  uint32_t                  user_data;
+  /**
+   * @brief   Service result, the value returned in r0.
+   */
+  uint32_t                  result;
+} sb_cqe_t;
+
+/**
+ * @brief   Type of a syscall ring header.
+ * @details The header is followed in memory by @p entries submission
+ *          entries then by @p entries completion entries.
+ * @note    Indexes are free running, the slot is the index masked by
+ *          @p entries minus one.
+ */
+typedef struct {
+  /**
+   * @brief   Next submission entry to be consumed, written by the host.
+   */
+  volatile uint32_t         sq_head;
+  /**
+   * @brief   Next submission entry to be filled, written by the sandbox.
+   */
+  volatile uint32_t         sq_tail;
+  /**
+   * @brief   Next completion entry to be consumed, written by the sandbox.
+   */
+  volatile uint32_t         cq_head;
+  /**
+   * @brief   Next completion entry to be filled, written by the host.
+   */
+  volatile uint32_t         cq_tail;
+  /**
+   * @brief   Number of entries of both queues, must be a power of two.
+   */
+  uint32_t                  entries;
+} sb_ring_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a ring memory area.
+ *
+ * @param[in] n         number of entries
+ */
+#define SB_RING_SIZE(n)                                                     \
+  (sizeof (sb_ring_t) + ((size_t)(n) * (sizeof (sb_sqe_t) +                 \
+                                        sizeof (sb_cqe_t))))
+
+/**
+ * @brief   Pointer to the submission entries of a ring.
+ *
+ * @param[in] rp        pointer to the ring header
+ */
+#define SB_RING_SQES(rp)        ((sb_sqe_t *)((rp) + 1))
+
+/**
+ * @brief   Pointer to the completion entries of a ring.
+ *
+ * @param[in] rp        pointer to the ring header
+ * @param[in] n         number of entries
+ */
+#define SB_RING_CQES(rp, n)     ((sb_cqe_t *)(SB_RING_SQES(rp) + (n)))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* SBRING_H */
+
+/** @} */
@@ -1,7 +1,8 @@
 # List of the ChibiOS ARMv7-M sandbox host files.
 SBHOSTSRC = $(CHIBIOS)/os/sb/host/sbhost.c \
 			$(CHIBIOS)/os/sb/host/sbapi.c \
-			$(CHIBIOS)/os/sb/host/sbposix.c
+			$(CHIBIOS)/os/sb/host/sbposix.c \
+			$(CHIBIOS)/os/sb/host/sbloader.c
           
 SBHOSTASM = $(CHIBIOS)/os/sb/host/compilers/GCC/sbexc.S
 
@@ -78,6 +78,31 @@
 #define SB_NUM_REGIONS                      2
 #endif
 
+/**
+ * @brief   Number of shared I/O windows for each sandbox.
+ * @note    Windows are validated once on registration then I/O on them
+ *          requires no further range checks, zero disables the feature.
+ */
+#if !defined(SB_NUM_WINDOWS) || defined(__DOXYGEN__)
+#define SB_NUM_WINDOWS                      2
+#endif
+
+/**
+ * @brief   Enables the execute-in-place images loader.
+ */
+#if !defined(SB_USE_XIP) || defined(__DOXYGEN__)
+#define SB_USE_XIP                          FALSE
+#endif
+
+/**
+ * @brief   Number of entries of the verified images cache.
+ * @note    Images are verified once then loaded again without computing
+ *          the check value as long as they remain in the cache.
+ */
+#if !defined(SB_XIP_CACHE_SIZE) || defined(__DOXYGEN__)
+#define SB_XIP_CACHE_SIZE                   16
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -117,6 +142,14 @@
 #error "invalid SB_NUM_REGIONS value"
 #endif
 
+#if (SB_NUM_WINDOWS < 0) || (SB_NUM_WINDOWS > 8)
+#error "invalid SB_NUM_WINDOWS value"
+#endif
+
+#if (SB_USE_XIP == TRUE) && (SB_XIP_CACHE_SIZE < 1)
+#error "invalid SB_XIP_CACHE_SIZE value"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -142,7 +175,9 @@ extern "C" {
 /*===========================================================================*/
 
 #include "sberr.h"
+#include "sbring.h"
 #include "sbhost.h"
+#include "sbloader.h"
 #include "sbapi.h"
 #include "sbposix.h"
 
@@ -52,6 +52,13 @@
 #define SB_SVC9_HANDLER         sb_api_wait_any_timeout
 #define SB_SVC10_HANDLER        sb_api_wait_all_timeout
 #define SB_SVC11_HANDLER        sb_api_broadcast_flags
+#define SB_SVC12_HANDLER        sb_api_sem_wait_timeout
+#define SB_SVC13_HANDLER        sb_api_ring_enter
+#define SB_SVC14_HANDLER        sb_api_window_register
+#define SB_SVC15_HANDLER        sb_api_window_read
+#define SB_SVC16_HANDLER        sb_api_window_write
+#define SB_SVC17_HANDLER        sb_api_virq_set_handler
+#define SB_SVC18_HANDLER        sb_api_virq_return
 /** @} */
 
 #define __SVC(x) asm volatile ("svc " #x)
@@ -1064,4 +1071,213 @@ void sb_api_broadcast_flags(struct port_extctx *ectxp) {
 #endif
 }
 
+void sb_api_sem_wait_timeout(struct port_extctx *ectxp) {
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  volatile int32_t *cntp = (volatile int32_t *)ectxp->r0;
+  msg_t msg = MSG_OK;
+
+  if ((((uint32_t)cntp & 3U) != 0U) ||
+      !sb_is_valid_write_range(sbcp, (void *)cntp, sizeof (int32_t))) {
+    ectxp->r0 = SB_ERR_EFAULT;
+    return;
+  }
+
+  chSysLock();
+
+  /* The counter has already been decremented by the sandbox, if a signal
+     arrived in the meanwhile then there is no need to wait.*/
+  if (*cntp < (int32_t)0) {
+    sbcp->sem_cntp = cntp;
+    msg = chThdSuspendTimeoutS(&sbcp->sem_trp, (sysinterval_t )ectxp->r1);
+    sbcp->sem_cntp = NULL;
+
+    /* On timeout the decrement is reverted.*/
+    if (msg != MSG_OK) {
+      (*cntp)++;
+    }
+  }
+
+  chSysUnlock();
+
+  ectxp->r0 = (uint32_t)msg;
+}
+
+void sb_api_ring_enter(struct port_extctx *ectxp) {
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  sb_ring_t *rp = (sb_ring_t *)ectxp->r0;
+  uint32_t n, mask, sq_head, sq_tail, cq_head, cq_tail, count;
+  sb_sqe_t *sqes;
+  sb_cqe_t *cqes;
+
+  if ((((uint32_t)rp & 3U) != 0U) ||
+      !sb_is_valid_write_range(sbcp, (void *)rp, sizeof (sb_ring_t))) {
+    ectxp->r0 = SB_ERR_EFAULT;
+    return;
+  }
+
+  /* Number of entries, it must be a power of two.*/
+  n = rp->entries;
+  if ((n == 0U) || (n > SB_RING_MAX_ENTRIES) || ((n & (n - 1U)) != 0U)) {
+    ectxp->r0 = SB_ERR_EINVAL;
+    return;
+  }
+  if (!sb_is_valid_write_range(sbcp, (void *)rp, SB_RING_SIZE(n))) {
+    ectxp->r0 = SB_ERR_EFAULT;
+    return;
+  }
+
+  /* Indexes are read once, inconsistent values are rejected.*/
+  mask    = n - 1U;
+  sq_head = rp->sq_head;
+  sq_tail = rp->sq_tail;
+  cq_head = rp->cq_head;
+  cq_tail = rp->cq_tail;
+  if (((sq_tail - sq_head) > n) || ((cq_tail - cq_head) > n)) {
+    ectxp->r0 = SB_ERR_EINVAL;
+    return;
+  }
+
+  /* Serving requests while there is room for the completions.*/
+  sqes  = SB_RING_SQES(rp);
+  cqes  = SB_RING_CQES(rp, n);
+  count = 0U;
+  while ((sq_head != sq_tail) && ((cq_tail - cq_head) < n)) {
+    sb_sqe_t *sqep = &sqes[sq_head & mask];
+    sb_cqe_t *cqep = &cqes[cq_tail & mask];
+    uint32_t opcode = sqep->opcode;
+    struct port_extctx ectx;
+
+    ectx.r0 = sqep->args[0];
+    ectx.r1 = sqep->args[1];
+    ectx.r2 = sqep->args[2];
+    ectx.r3 = sqep->args[3];
+
+    /* Nested ring entries are not allowed.*/
+    if ((opcode < 256U) && (opcode != SB_RING_SVC)) {
+      sb_syscalls[opcode](&ectx);
+    }
+    else {
+      ectx.r0 = SB_ERR_ENOSYS;
+    }
+
+    cqep->user_data = sqep->user_data;
+    cqep->result    = ectx.r0;
+
+    /* Indexes are updated after each request because a service could
+       not return, the sandbox sees a consistent ring in any case.*/
+    sq_head++;
+    cq_tail++;
+    rp->sq_head = sq_head;
+    rp->cq_tail = cq_tail;
+    count++;
+  }
+
+  ectxp->r0 = count;
+}
+
+void sb_api_window_register(struct port_extctx *ectxp) {
+#if SB_NUM_WINDOWS > 0
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  uint32_t id = ectxp->r0;
+  uint8_t *base = (uint8_t *)ectxp->r1;
+  size_t size = (size_t)ectxp->r2;
+  bool writeable = (bool)(ectxp->r3 != 0U);
+  sb_window_t *wp;
+
+  if (id >= (uint32_t)SB_NUM_WINDOWS) {
+    ectxp->r0 = SB_ERR_EINVAL;
+    return;
+  }
+  wp = &sbcp->windows[id];
+
+  /* Zero size unregisters the window.*/
+  if (size == (size_t)0) {
+    wp->base      = NULL;
+    wp->size      = (size_t)0;
+    wp->writeable = false;
+    ectxp->r0 = SB_ERR_NOERROR;
+    return;
+  }
+
+  /* This is the only range check performed on the window.*/
+  if (writeable ? !sb_is_valid_write_range(sbcp, (void *)base, size) :
+                  !sb_is_valid_read_range(sbcp, (const void *)base, size)) {
+    ectxp->r0 = SB_ERR_EFAULT;
+    return;
+  }
+
+  wp->base      = base;
+  wp->size      = size;
+  wp->writeable = writeable;
+  ectxp->r0 = SB_ERR_NOERROR;
+#else
+  ectxp->r0 = SB_ERR_ENOSYS;
+#endif
+}
+
+void sb_api_window_read(struct port_extctx *ectxp) {
+#if SB_NUM_WINDOWS > 0
+
+  ectxp->r0 = sb_posix_read_window(ectxp->r0, ectxp->r1,
+                                   (size_t)ectxp->r2, (size_t)ectxp->r3);
+#else
+  ectxp->r0 = SB_ERR_ENOSYS;
+#endif
+}
+
+void sb_api_window_write(struct port_extctx *ectxp) {
+#if SB_NUM_WINDOWS > 0
+
+  ectxp->r0 = sb_posix_write_window(ectxp->r0, ectxp->r1,
+                                    (size_t)ectxp->r2, (size_t)ectxp->r3);
+#else
+  ectxp->r0 = SB_ERR_ENOSYS;
+#endif
+}
+
+void sb_api_virq_set_handler(struct port_extctx *ectxp) {
+#if CH_CFG_USE_EVENTS == TRUE
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  uint32_t entry = ectxp->r0;
+
+  /* The entry point must be in sandbox code, zero unregisters the
+     handler.*/
+  if ((entry != 0U) &&
+      !sb_is_valid_read_range(sbcp, (const void *)(entry & ~1U), 2U)) {
+    ectxp->r0 = SB_ERR_EFAULT;
+    return;
+  }
+
+  sbcp->virq_entry = entry;
+  sbcp->virq_mask  = (eventmask_t)ectxp->r1;
+  ectxp->r0 = SB_ERR_NOERROR;
+#else
+  ectxp->r0 = SB_ERR_ENOSYS;
+#endif
+}
+
+void sb_api_virq_return(struct port_extctx *ectxp) {
+#if CH_CFG_USE_EVENTS == TRUE
+  thread_t *tp = chThdGetSelfX();
+  sb_class_t *sbcp = (sb_class_t *)tp->ctx.syscall.p;
+  struct port_linkctx *lctxp;
+
+  lctxp = (struct port_linkctx *)((uint32_t)tp->ctx.syscall.psp -
+                                  sizeof (struct port_linkctx));
+
+  /* Only allowed from a real SVC in the handler, not from a ring.*/
+  if ((sbcp->virq_ctxp == NULL) || (lctxp->ectxp != ectxp)) {
+    ectxp->r0 = SB_ERR_EBUSY;
+    return;
+  }
+
+  /* Resuming the interrupted context, further pending virtual IRQs are
+     delivered immediately.*/
+  lctxp->ectxp    = sbcp->virq_ctxp;
+  sbcp->virq_ctxp = NULL;
+#else
+  ectxp->r0 = SB_ERR_ENOSYS;
+#endif
+}
+
 /** @} */
@@ -114,6 +114,13 @@ extern "C" {
   void sb_api_wait_any_timeout(struct port_extctx *ctxp);
   void sb_api_wait_all_timeout(struct port_extctx *ctxp);
   void sb_api_broadcast_flags(struct port_extctx *ctxp);
+  void sb_api_sem_wait_timeout(struct port_extctx *ctxp);
+  void sb_api_ring_enter(struct port_extctx *ctxp);
+  void sb_api_window_register(struct port_extctx *ctxp);
+  void sb_api_window_read(struct port_extctx *ctxp);
+  void sb_api_window_write(struct port_extctx *ctxp);
+  void sb_api_virq_set_handler(struct port_extctx *ctxp);
+  void sb_api_virq_return(struct port_extctx *ctxp);
 #ifdef __cplusplus
 }
 #endif
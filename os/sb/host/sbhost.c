@@ -57,7 +57,7 @@ bool sb_is_valid_read_range(sb_class_t *sbcp, const void *start, size_t size) {
 
   do {
     if (((uint32_t)start >= rp->base) && ((uint32_t)start < rp->end) &&
-        (size <= ((size_t)rp->base - (size_t)start))) {
+        (size <= ((size_t)rp->end - (size_t)start))) {
       return true;
     }
     rp++;
@@ -71,7 +71,7 @@ bool sb_is_valid_write_range(sb_class_t *sbcp, void *start, size_t size) {
 
   do {
     if (((uint32_t)start >= rp->base) && ((uint32_t)start < rp->end) &&
-        (size <= ((size_t)rp->base - (size_t)start))) {
+        (size <= ((size_t)rp->end - (size_t)start))) {
       return rp->writeable;
     }
     rp++;
@@ -88,6 +88,9 @@ bool sb_is_valid_write_range(sb_class_t *sbcp, void *start, size_t size) {
  * @init
  */
 void sbObjectInit(sb_class_t *sbcp) {
+#if SB_NUM_WINDOWS > 0
+  unsigned i;
+#endif
 
   sbcp->config = NULL;
   sbcp->tp     = NULL;
@@ -96,6 +99,20 @@ void sbObjectInit(sb_class_t *sbcp) {
 #endif
 #if CH_CFG_USE_EVENTS == TRUE
   chEvtObjectInit(&sbcp->es);
+#endif
+  sbcp->sem_trp  = NULL;
+  sbcp->sem_cntp = NULL;
+#if CH_CFG_USE_EVENTS == TRUE
+  sbcp->virq_entry = 0U;
+  sbcp->virq_mask  = (eventmask_t)0;
+  sbcp->virq_ctxp  = NULL;
+#endif
+#if SB_NUM_WINDOWS > 0
+  for (i = 0U; i < (unsigned)SB_NUM_WINDOWS; i++) {
+    sbcp->windows[i].base      = NULL;
+    sbcp->windows[i].size      = (size_t)0;
+    sbcp->windows[i].writeable = false;
+  }
 #endif
 }
 
@@ -119,16 +136,23 @@ void sbStart(sb_class_t *sbcp, const sb_config_t *config) {
     return;
   }
 
-  /* Checking header size and alignment.*/
-  if (sbhp->hdr_size != sizeof (sb_header_t)) {
+  /* Checking header size and alignment, the PSP initial address depends
+     on the image type.*/
+  if (sbhp->hdr_size == sizeof (sb_header_t)) {
+    psp = config->regions[config->data_region].end;
+  }
+#if SB_USE_XIP == TRUE
+  else if ((sbhp->hdr_size == sizeof (sb_xip_header_t)) &&
+           (((const sb_xip_header_t *)sbhp)->xip_magic == SB_XIP_MAGIC)) {
+    psp = sb_xip_get_psp(config);
+  }
+#endif
+  else {
     return;
   }
 
   /* PC initial address, by convention it is immediately after the header.*/
-  pc = (config->regions[config->code_region].base + sizeof (sb_header_t)) | 1U;
-
-  /* PSP initial address.*/
-  psp = config->regions[config->data_region].end;
+  pc = (config->regions[config->code_region].base + sbhp->hdr_size) | 1U;
 
   /* Additional context information.*/
   sbcp->config = config;
@@ -190,4 +214,101 @@ msg_t sbSendMessageTimeout(sb_class_t *sbcp,
 }
 #endif /* CH_CFG_USE_MESSAGES == TRUE */
 
+/**
+ * @brief   Signals a sandbox semaphore.
+ * @details The counter is located in sandbox memory, the sandbox thread is
+ *          woken up only if it is waiting on the same semaphore.
+ *
+ * @param[in] sbcp      pointer to the sandbox object
+ * @param[in] cntp      pointer to the semaphore counter in sandbox memory
+ *
+ * @iclass
+ */
+void sbSemSignalI(sb_class_t *sbcp, volatile int32_t *cntp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((sbcp != NULL) && (cntp != NULL));
+
+  (*cntp)++;
+  if ((*cntp <= (int32_t)0) && (sbcp->sem_cntp == cntp)) {
+    chThdResumeI(&sbcp->sem_trp, MSG_OK);
+  }
+}
+
+/**
+ * @brief   Signals a sandbox semaphore.
+ * @details The counter is located in sandbox memory, the sandbox thread is
+ *          woken up only if it is waiting on the same semaphore.
+ *
+ * @param[in] sbcp      pointer to the sandbox object
+ * @param[in] cntp      pointer to the semaphore counter in sandbox memory
+ *
+ * @api
+ */
+void sbSemSignal(sb_class_t *sbcp, volatile int32_t *cntp) {
+
+  chSysLock();
+  sbSemSignalI(sbcp, cntp);
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Delivers pending virtual IRQs to the sandbox.
+ * @details Invoked on return from each sandbox syscall. If a virtual IRQ
+ *          is pending and the handler is not already running then the
+ *          return context is redirected to the handler, the interrupted
+ *          context is left on the sandbox stack and restored by the
+ *          handler return syscall.
+ * @note    Not meant to be used in the application code.
+ *
+ * @notapi
+ */
+void sb_virq_deliver(void) {
+#if CH_CFG_USE_EVENTS == TRUE
+  thread_t *tp = chThdGetSelfX();
+  sb_class_t *sbcp = (sb_class_t *)tp->ctx.syscall.p;
+  struct port_linkctx *lctxp;
+  struct port_extctx *ectxp, *newctxp;
+  eventmask_t pending;
+
+  if ((sbcp->virq_entry == 0U) || (sbcp->virq_ctxp != NULL)) {
+    return;
+  }
+
+  /* The link context is always at the top of the supervisor stack, it
+     holds the context the syscall is going to return to.*/
+  lctxp = (struct port_linkctx *)((uint32_t)tp->ctx.syscall.psp -
+                                  sizeof (struct port_linkctx));
+  ectxp   = lctxp->ectxp;
+  newctxp = ectxp - 1;
+
+  /* The handler context is built just below the interrupted one, the
+     sandbox stack must have space for it.*/
+  if (!sb_is_valid_write_range(sbcp, (void *)newctxp,
+                               sizeof (struct port_extctx))) {
+    return;
+  }
+
+  chSysLock();
+  pending = tp->epending & sbcp->virq_mask;
+  tp->epending &= ~pending;
+  chSysUnlock();
+
+  if (pending == (eventmask_t)0) {
+    return;
+  }
+
+  /* Handler context, the pending IRQs mask is the handler parameter.*/
+  *newctxp        = *ectxp;
+  newctxp->r0     = (uint32_t)pending;
+  newctxp->lr_thd = 0U;
+  newctxp->pc     = sbcp->virq_entry & ~1U;
+  newctxp->xpsr   = 0x01000000U;
+
+  sbcp->virq_ctxp = ectxp;
+  lctxp->ectxp    = newctxp;
+#endif
+}
+
 /** @} */
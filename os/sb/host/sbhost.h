@@ -72,6 +72,25 @@ typedef struct {
   bool                          writeable;
 } sb_memory_region_t;
 
+/**
+ * @brief   Type of a shared I/O window.
+ */
+typedef struct {
+  /**
+   * @brief   Window base.
+   * @note    @p NULL if not registered.
+   */
+  uint8_t                       *base;
+  /**
+   * @brief   Window size.
+   */
+  size_t                        size;
+  /**
+   * @brief   Writable window.
+   */
+  bool                          writeable;
+} sb_window_t;
+
 /**
  * @brief   Type of a sandbox configuration structure.
  */
@@ -135,6 +154,36 @@ typedef struct {
 #endif
 #if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
   event_source_t                es;
+#endif
+  /**
+   * @brief   Reference to the sandbox thread waiting on a semaphore.
+   */
+  thread_reference_t            sem_trp;
+  /**
+   * @brief   Counter of the semaphore the sandbox is waiting on.
+   */
+  volatile int32_t              *sem_cntp;
+#if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Virtual IRQs entry point in sandbox code, zero if not
+   *          registered.
+   */
+  uint32_t                      virq_entry;
+  /**
+   * @brief   Events delivered as virtual IRQs.
+   */
+  eventmask_t                   virq_mask;
+  /**
+   * @brief   Context interrupted by the virtual IRQ being served.
+   * @note    @p NULL if no virtual IRQ is being served.
+   */
+  struct port_extctx            *virq_ctxp;
+#endif
+#if (SB_NUM_WINDOWS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Shared I/O windows registered by the sandbox.
+   */
+  sb_window_t                   windows[SB_NUM_WINDOWS];
 #endif
 } sb_class_t;
 
@@ -179,6 +228,9 @@ extern "C" {
   msg_t sbSendMessageTimeout(sb_class_t *sbcp,
                              msg_t msg,
                              sysinterval_t timeout);
+  void sbSemSignalI(sb_class_t *sbcp, volatile int32_t *cntp);
+  void sbSemSignal(sb_class_t *sbcp, volatile int32_t *cntp);
+  void sb_virq_deliver(void);
 #ifdef __cplusplus
 }
 #endif
@@ -223,6 +275,28 @@ static inline msg_t sbSendMessage(sb_class_t *sbcp, msg_t msg) {
 }
 #endif /* CH_CFG_USE_MESSAGES == TRUE */
 
+#if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Raises virtual IRQs on a sandbox.
+ * @details The IRQs are marked as pending events of the sandbox thread,
+ *          a sandbox waiting for those events is woken up directly. If the
+ *          sandbox registered a virtual IRQs handler for the events then
+ *          the handler is invoked the next time the sandbox returns from
+ *          the host.
+ * @note    This function is meant to be called from device ISRs, there is
+ *          no need for relay threads in the host.
+ *
+ * @param[in] sbcp      pointer to the sandbox object
+ * @param[in] mask      mask of the virtual IRQs to be raised
+ *
+ * @iclass
+ */
+static inline void sbVIRQSignalI(sb_class_t *sbcp, eventmask_t mask) {
+
+  chEvtSignalI(sbcp->tp, mask);
+}
+#endif /* CH_CFG_USE_EVENTS == TRUE */
+
 #if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Adds a set of event flags directly to the specified sandbox.
@@ -264,6 +338,36 @@ static inline event_source_t *sbGetEventSourceX(sb_class_t *sbcp) {
 }
 #endif /* CH_CFG_USE_EVENTS == TRUE */
 
+#if (SB_NUM_WINDOWS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns a shared I/O window of a sandbox.
+ * @details The window has been validated on registration, host code and
+ *          drivers can access it, also using DMA, without further checks.
+ * @note    The window can be unregistered by the sandbox at any time, the
+ *          returned pointer is meant to be used for the duration of a
+ *          single operation requested by the sandbox.
+ *
+ * @param[in] sbcp      pointer to the sandbox object
+ * @param[in] id        window identifier
+ * @param[out] sizep    pointer to the variable receiving the window size
+ * @return              The window base address.
+ * @retval NULL         if the window is not registered.
+ *
+ * @xclass
+ */
+static inline uint8_t *sbGetWindowX(sb_class_t *sbcp,
+                                    uint32_t id,
+                                    size_t *sizep) {
+
+  if (id >= (uint32_t)SB_NUM_WINDOWS) {
+    return NULL;
+  }
+
+  *sizep = sbcp->windows[id].size;
+  return sbcp->windows[id].base;
+}
+#endif /* SB_NUM_WINDOWS > 0 */
+
 #endif /* SBHOST_H */
 
 /** @} */
@@ -0,0 +1,263 @@
+/*
+    ChibiOS - Copyright (C) 2006..2019 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/host/sbloader.c
+ * @brief   ARM sandbox execute-in-place loader code.
+ *
+ * @addtogroup ARM_SANDBOX
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "sb.h"
+
+#if (SB_USE_XIP == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a verified images cache entry.
+ */
+typedef struct {
+  /**
+   * @brief   Verified image header or @p NULL if the entry is unused.
+   */
+  const sb_xip_header_t         *hp;
+  /**
+   * @brief   Check value of the verified image.
+   */
+  uint32_t                      crc;
+} sb_xip_cache_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Verified images cache.
+ */
+static sb_xip_cache_t xip_cache[SB_XIP_CACHE_SIZE];
+
+/**
+ * @brief   Next cache entry to be replaced.
+ */
+static unsigned xip_cache_next;
+
+/**
+ * @brief   CRC32 nibble table.
+ */
+static const uint32_t crc32_table[16] = {
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+  0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+  0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static uint32_t xip_crc32(const uint8_t *p, size_t n) {
+  uint32_t crc = 0xFFFFFFFFU;
+
+  while (n > 0U) {
+    crc ^= (uint32_t)*p++;
+    crc = (crc >> 4) ^ crc32_table[crc & 15U];
+    crc = (crc >> 4) ^ crc32_table[crc & 15U];
+    n--;
+  }
+
+  return crc ^ 0xFFFFFFFFU;
+}
+
+static bool xip_is_cached(const sb_xip_header_t *hp) {
+  bool cached = false;
+  unsigned i;
+
+  chSysLock();
+  for (i = 0U; i < (unsigned)SB_XIP_CACHE_SIZE; i++) {
+    if ((xip_cache[i].hp == hp) && (xip_cache[i].crc == hp->crc)) {
+      cached = true;
+      break;
+    }
+  }
+  chSysUnlock();
+
+  return cached;
+}
+
+static void xip_cache_insert(const sb_xip_header_t *hp) {
+
+  chSysLock();
+  xip_cache[xip_cache_next].hp  = hp;
+  xip_cache[xip_cache_next].crc = hp->crc;
+  xip_cache_next = (xip_cache_next + 1U) % (unsigned)SB_XIP_CACHE_SIZE;
+  chSysUnlock();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Loads an execute-in-place sandbox image.
+ * @details The image is verified, the outcome is cached so the check value
+ *          is computed only the first time an image is loaded. The
+ *          initialized data is then copied at the base of the RAM area,
+ *          the zero-initialized data is cleared and the data relocations
+ *          are applied, the code is never copied nor modified.
+ * @note    The @p code_region and @p data_region fields of the
+ *          configuration must be already initialized, the two regions
+ *          are filled by this function, the remaining fields are not
+ *          modified.
+ * @note    The verification result is associated to the image address and
+ *          check value, if an image is replaced then the cache is bypassed
+ *          only if the check value changes.
+ *
+ * @param[in,out] config    pointer to the sandbox configuration
+ * @param[in] image         pointer to the image in memory-mapped storage
+ * @param[in] ram_base      base of the RAM area for data and stack
+ * @param[in] ram_end       end of the RAM area (non inclusive)
+ * @return                  The operation status.
+ * @retval SB_ERR_NOERROR   if the image has been loaded.
+ * @retval SB_ERR_EINVAL    if the image header is not valid.
+ * @retval SB_ERR_EFAULT    if the image is corrupted.
+ * @retval SB_ERR_ENOMEM    if the RAM area is too small.
+ *
+ * @api
+ */
+uint32_t sbLoadXIP(sb_config_t *config, const void *image,
+                   uint32_t ram_base, uint32_t ram_end) {
+  const sb_xip_header_t *hp = (const sb_xip_header_t *)image;
+  const uint8_t *base = (const uint8_t *)image;
+  const uint32_t *rp;
+  uint32_t i, size, required;
+
+  chDbgCheck((config != NULL) && (image != NULL) && (ram_base < ram_end) &&
+             (config->code_region < (uint32_t)SB_NUM_REGIONS) &&
+             (config->data_region < (uint32_t)SB_NUM_REGIONS));
+
+  /* Checking header and layout, all sizes are multiple of 4.*/
+  if ((((uint32_t)image & 3U) != 0U) ||
+      (hp->hdr.hdr_magic1 != SB_MAGIC1) ||
+      (hp->hdr.hdr_magic2 != SB_MAGIC2) ||
+      (hp->hdr.hdr_size != sizeof (sb_xip_header_t)) ||
+      (hp->xip_magic != SB_XIP_MAGIC) ||
+      (hp->text_size <= sizeof (sb_xip_header_t)) ||
+      (((hp->text_size | hp->data_size | hp->bss_size) & 3U) != 0U) ||
+      (hp->data_size > (0xFFFFFFFFU - hp->text_size)) ||
+      (hp->reloc_count > ((0xFFFFFFFFU - hp->text_size - hp->data_size) /
+                          sizeof (uint32_t)))) {
+    return SB_ERR_EINVAL;
+  }
+
+  /* Checking the RAM area, it must be word aligned and must accommodate
+     data, stack and the startup parameters.*/
+  if (((ram_base & 3U) != 0U) || ((ram_end & 7U) != 0U)) {
+    return SB_ERR_EINVAL;
+  }
+  required = hp->data_size + SB_XIP_PARAMS_SIZE;
+  if ((hp->bss_size > (0xFFFFFFFFU - required)) ||
+      (hp->stack_size > (0xFFFFFFFFU - required - hp->bss_size)) ||
+      ((ram_end - ram_base) < (required + hp->bss_size + hp->stack_size))) {
+    return SB_ERR_ENOMEM;
+  }
+
+  /* Verifying the image, only once.*/
+  size = hp->text_size + hp->data_size +
+         (hp->reloc_count * (uint32_t)sizeof (uint32_t));
+  if (!xip_is_cached(hp)) {
+    if (xip_crc32(base + sizeof (sb_xip_header_t),
+                  (size_t)(size - sizeof (sb_xip_header_t))) != hp->crc) {
+      return SB_ERR_EFAULT;
+    }
+    xip_cache_insert(hp);
+  }
+
+  /* Data segment, the only part copied in RAM.*/
+  memcpy((void *)ram_base, (const void *)(base + hp->text_size),
+         (size_t)hp->data_size);
+  memset((void *)(ram_base + hp->data_size), 0, (size_t)hp->bss_size);
+
+  /* Relocations, only words in the RAM copy of the data are patched.*/
+  rp = (const uint32_t *)(base + hp->text_size + hp->data_size);
+  for (i = 0U; i < hp->reloc_count; i++) {
+    uint32_t offset = rp[i] & SB_XIP_RELOC_OFFSET_MASK;
+    uint32_t *wp;
+
+    if (((offset & 3U) != 0U) || (offset >= hp->data_size)) {
+      return SB_ERR_EFAULT;
+    }
+
+    wp = (uint32_t *)(ram_base + offset);
+    if ((rp[i] & SB_XIP_RELOC_DATA) != 0U) {
+      *wp += ram_base;
+    }
+    else {
+      *wp += (uint32_t)image;
+    }
+  }
+
+  /* Regions, the code region only covers code and read only data.*/
+  config->regions[config->code_region].base      = (uint32_t)image;
+  config->regions[config->code_region].end       = (uint32_t)image +
+                                                   hp->text_size;
+  config->regions[config->code_region].writeable = false;
+  config->regions[config->data_region].base      = ram_base;
+  config->regions[config->data_region].end       = ram_end;
+  config->regions[config->data_region].writeable = true;
+
+  return SB_ERR_NOERROR;
+}
+
+/**
+ * @brief   Prepares the startup parameters of an execute-in-place image.
+ * @details The data base address is stored on top of the stack.
+ * @note    Not meant to be used in the application code.
+ *
+ * @param[in] config    pointer to the sandbox configuration
+ * @return              The initial PSP value.
+ *
+ * @notapi
+ */
+uint32_t sb_xip_get_psp(const sb_config_t *config) {
+  uint32_t psp;
+
+  psp = config->regions[config->data_region].end - SB_XIP_PARAMS_SIZE;
+  *(uint32_t *)psp = config->regions[config->data_region].base;
+
+  return psp;
+}
+
+#endif /* SB_USE_XIP == TRUE */
+
+/** @} */
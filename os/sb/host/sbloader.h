@@ -0,0 +1,160 @@
+/*
+    ChibiOS - Copyright (C) 2006..2019 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sb/host/sbloader.h
+ * @brief   ARM sandbox execute-in-place loader macros and structures.
+ * @details Execute-in-place images are position independent, the code
+ *          runs from the flash or memory-mapped NOR location where the
+ *          image is stored while only the initialized data is copied in
+ *          RAM. The image layout is:
+ *          - @p sb_xip_header_t header, the entry point immediately
+ *            follows it.
+ *          - Code and read only data, up to @p text_size bytes from the
+ *            image base, header included.
+ *          - Initialized data, @p data_size bytes.
+ *          - Relocations table, @p reloc_count words.
+ *          .
+ *          The sandbox code is expected to be compiled with a single PIC
+ *          base register, on entry the data base address is found in the
+ *          word pointed by the stack pointer.
+ *
+ * @addtogroup ARM_SANDBOX
+ * @{
+ */
+
+#ifndef SBLOADER_H
+#define SBLOADER_H
+
+#if (SB_USE_XIP == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Execute-in-place header magic number.
+ */
+#define SB_XIP_MAGIC                        0x50495853U
+
+/**
+ * @brief   Space reserved on top of the stack for the startup parameters.
+ */
+#define SB_XIP_PARAMS_SIZE                  8U
+
+/**
+ * @name    Relocation entries fields
+ * @{
+ */
+/**
+ * @brief   The relocated word refers to the data segment.
+ * @details If this bit is set the data base address is added to the word
+ *          else the image base address is added.
+ */
+#define SB_XIP_RELOC_DATA                   0x80000000U
+/**
+ * @brief   Offset of the relocated word within the data segment.
+ */
+#define SB_XIP_RELOC_OFFSET_MASK            0x7FFFFFFFU
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an execute-in-place image header.
+ */
+typedef struct {
+  /**
+   * @brief   Common sandbox header.
+   * @note    The @p hdr_size field must be the size of this structure.
+   */
+  sb_header_t                   hdr;
+  /**
+   * @brief   Execute-in-place magic number.
+   */
+  uint32_t                      xip_magic;
+  /**
+   * @brief   Size of the code segment, header included.
+   */
+  uint32_t                      text_size;
+  /**
+   * @brief   Size of the initialized data segment.
+   */
+  uint32_t                      data_size;
+  /**
+   * @brief   Size of the zero-initialized data segment.
+   */
+  uint32_t                      bss_size;
+  /**
+   * @brief   Number of entries in the relocations table.
+   */
+  uint32_t                      reloc_count;
+  /**
+   * @brief   Minimum stack size required by the sandbox.
+   */
+  uint32_t                      stack_size;
+  /**
+   * @brief   Image check value.
+   * @details CRC32 of the image after the header up to the end of the
+   *          relocations table.
+   */
+  uint32_t                      crc;
+  /**
+   * @brief   Reserved, defaulted to zero.
+   */
+  uint32_t                      reserved;
+} sb_xip_header_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint32_t sbLoadXIP(sb_config_t *config, const void *image,
+                     uint32_t ram_base, uint32_t ram_end);
+  uint32_t sb_xip_get_psp(const sb_config_t *config);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* SB_USE_XIP == TRUE */
+
+#endif /* SBLOADER_H */
+
+/** @} */
@@ -48,6 +48,48 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+static uint32_t sb_stream_read(sb_class_t *sbcp, uint32_t fd,
+                               uint8_t *buf, size_t count) {
+
+  if (fd == 0U) {
+    SandboxStream *ssp = sbcp->config->stdin_stream;
+
+    if ((count == 0U) || (ssp == NULL)) {
+      return 0U;
+    }
+
+    return (uint32_t)ssp->vmt->read((void *)ssp, buf, count);
+  }
+
+  return SB_ERR_EBADFD;
+}
+
+static uint32_t sb_stream_write(sb_class_t *sbcp, uint32_t fd,
+                                const uint8_t *buf, size_t count) {
+
+  if (fd == 1U) {
+    SandboxStream *ssp = sbcp->config->stdout_stream;
+
+    if ((count == 0U) || (ssp == NULL)) {
+      return 0U;
+    }
+
+    return (uint32_t)ssp->vmt->write((void *)ssp, buf, count);
+  }
+
+  if (fd == 2U) {
+    SandboxStream *ssp = sbcp->config->stderr_stream;
+
+    if ((count == 0U) || (ssp == NULL)) {
+      return 0U;
+    }
+
+    return (uint32_t)ssp->vmt->write((void *)ssp, buf, count);
+  }
+
+  return SB_ERR_EBADFD;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -77,17 +119,7 @@ uint32_t sb_posix_read(uint32_t fd, uint8_t *buf, size_t count) {
     return SB_ERR_EFAULT;
   }
 
-  if (fd == 0U) {
-    SandboxStream *ssp = sbcp->config->stdin_stream;
-
-    if ((count == 0U) || (ssp == NULL)) {
-      return 0U;
-    }
-
-    return (uint32_t)ssp->vmt->read((void *)ssp, buf, count);
-  }
-
-  return SB_ERR_EBADFD;
+  return sb_stream_read(sbcp, fd, buf, count);
 }
 
 uint32_t sb_posix_write(uint32_t fd, const uint8_t *buf, size_t count) {
@@ -97,40 +129,58 @@ uint32_t sb_posix_write(uint32_t fd, const uint8_t *buf, size_t count) {
     return SB_ERR_EFAULT;
   }
 
-  if (fd == 1U) {
-    SandboxStream *ssp = sbcp->config->stdout_stream;
-
-    if ((count == 0U) || (ssp == NULL)) {
-      return 0U;
-    }
+  return sb_stream_write(sbcp, fd, buf, count);
+}
 
-    return (uint32_t)ssp->vmt->write((void *)ssp, buf, count);
-  }
+uint32_t sb_posix_lseek(uint32_t fd, uint32_t offset, uint32_t whence) {
 
-  if (fd == 2U) {
-    SandboxStream *ssp = sbcp->config->stderr_stream;
+  (void)offset;
+  (void)whence;
 
-    if ((count == 0U) || (ssp == NULL)) {
-      return 0U;
-    }
+  if ((fd == 0U) || (fd == 1U) || (fd == 2U)) {
 
-    return (uint32_t)ssp->vmt->write((void *)ssp, buf, count);
+    return SB_ERR_ESPIPE;
   }
 
   return SB_ERR_EBADFD;
 }
 
-uint32_t sb_posix_lseek(uint32_t fd, uint32_t offset, uint32_t whence) {
+#if (SB_NUM_WINDOWS > 0) || defined(__DOXYGEN__)
+uint32_t sb_posix_read_window(uint32_t fd, uint32_t id,
+                              size_t offset, size_t count) {
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  const sb_window_t *wp;
 
-  (void)offset;
-  (void)whence;
+  /* The window has been validated on registration, only the offset and
+     size within the window need to be checked here.*/
+  if (id >= (uint32_t)SB_NUM_WINDOWS) {
+    return SB_ERR_EINVAL;
+  }
+  wp = &sbcp->windows[id];
+  if ((wp->base == NULL) || !wp->writeable ||
+      (offset > wp->size) || (count > wp->size - offset)) {
+    return SB_ERR_EFAULT;
+  }
 
-  if ((fd == 0U) || (fd == 1U) || (fd == 2U)) {
+  return sb_stream_read(sbcp, fd, wp->base + offset, count);
+}
 
-    return SB_ERR_ESPIPE;
+uint32_t sb_posix_write_window(uint32_t fd, uint32_t id,
+                               size_t offset, size_t count) {
+  sb_class_t *sbcp = (sb_class_t *)chThdGetSelfX()->ctx.syscall.p;
+  const sb_window_t *wp;
+
+  if (id >= (uint32_t)SB_NUM_WINDOWS) {
+    return SB_ERR_EINVAL;
+  }
+  wp = &sbcp->windows[id];
+  if ((wp->base == NULL) ||
+      (offset > wp->size) || (count > wp->size - offset)) {
+    return SB_ERR_EFAULT;
   }
 
-  return SB_ERR_EBADFD;
+  return sb_stream_write(sbcp, fd, wp->base + offset, count);
 }
+#endif /* SB_NUM_WINDOWS > 0 */
 
 /** @} */
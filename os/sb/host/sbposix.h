@@ -60,6 +60,12 @@ extern "C" {
   uint32_t sb_posix_read(uint32_t fd, uint8_t *buf, size_t count);
   uint32_t sb_posix_write(uint32_t fd, const uint8_t *buf, size_t count);
   uint32_t sb_posix_lseek(uint32_t fd, uint32_t offset, uint32_t whence);
+#if SB_NUM_WINDOWS > 0
+  uint32_t sb_posix_read_window(uint32_t fd, uint32_t id,
+                                size_t offset, size_t count);
+  uint32_t sb_posix_write_window(uint32_t fd, uint32_t id,
+                                 size_t offset, size_t count);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,25 @@ sbapi_state_t sb;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Virtual IRQs entry point.
+ * @details The host enters here with the mask of the IRQs to be served,
+ *          the interrupted context is resumed by the return syscall.
+ *
+ * @param[in] irqs      mask of the virtual IRQs being served
+ */
+__attribute__((noreturn))
+static void sb_virq_entry(eventmask_t irqs) {
+
+  sb.virq_handler(irqs);
+
+  __syscall0(18);
+
+  /* Cannot get here.*/
+  while (true) {
+  }
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -71,4 +90,28 @@ void sbApiInit(void) {
   sb.frequency = (time_conv_t)sbGetFrequency();
 }
 
+/**
+ * @brief   Registers the virtual IRQs handler.
+ * @details The specified events are delivered by the host as virtual IRQs,
+ *          the handler is invoked on return from any host call while the
+ *          events are pending, other host calls are allowed from within
+ *          the handler, IRQs raised meanwhile are served after the
+ *          handler returns.
+ * @note    Events delivered as virtual IRQs are not seen by the events
+ *          wait functions unless the wait is performed on them and the
+ *          events become pending during the wait.
+ *
+ * @param[in] handler   the handler function or @p NULL to unregister it
+ * @param[in] irqs      mask of the events to be delivered as virtual IRQs
+ * @return              Operation result.
+ *
+ * @api
+ */
+uint32_t sbVIRQSetHandler(sbvirqhandler_t handler, eventmask_t irqs) {
+
+  sb.virq_handler = handler;
+  __syscall2r(17, handler != NULL ? sb_virq_entry : NULL, irqs);
+  return r0;
+}
+
 /** @} */
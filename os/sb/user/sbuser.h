@@ -29,6 +29,7 @@
 #define SBUSER_H
 
 #include "sberr.h"
+#include "sbring.h"
 
 /*===========================================================================*/
 /* Module constants.                                                         */
@@ -91,6 +92,13 @@ typedef uint32_t eventmask_t;
  */
 typedef uint32_t eventflags_t;
 
+/**
+ * @brief   Type of a virtual IRQs handler.
+ *
+ * @param[in] irqs      mask of the virtual IRQs being served
+ */
+typedef void (*sbvirqhandler_t)(eventmask_t irqs);
+
 /**
  * @brief   Type of a sandbox API internal state variables.
  */
@@ -99,6 +107,10 @@ typedef struct {
    * @brief   System tick frequency.
    */
   time_conv_t               frequency;
+  /**
+   * @brief   Virtual IRQs handler.
+   */
+  sbvirqhandler_t           virq_handler;
 } sbapi_state_t;
 
 /*===========================================================================*/
@@ -132,6 +144,21 @@ typedef struct {
 #define TIME_MAX_SYSTIME    ((systime_t)-1)
 /** @} */
 
+/**
+ * @brief   Type of a lightweight semaphore.
+ * @details The counter is located in sandbox memory and changed atomically
+ *          in user context, the host is invoked only when the sandbox needs
+ *          to wait. The host signals the semaphore using @p sbSemSignalI()
+ *          or @p sbSemSignal() on the counter address.
+ * @note    Only the sandbox thread can wait on a lightweight semaphore.
+ */
+typedef struct {
+  /**
+   * @brief   Semaphore counter.
+   */
+  volatile int32_t          cnt;
+} sb_semaphore_t;
+
 /**
  * @name   SVC instruction wrappers.
  * @{
@@ -178,6 +205,7 @@ extern sbapi_state_t sb;
 extern "C" {
 #endif
   void sbApiInit(void);
+  uint32_t sbVIRQSetHandler(sbvirqhandler_t handler, eventmask_t irqs);
 #ifdef __cplusplus
 }
 #endif
@@ -260,6 +288,62 @@ static inline uint32_t sbFileSeek(uint32_t fd,
   return (size_t)r0;
 }
 
+/**
+ * @brief   Registers a shared I/O window.
+ * @details The window is validated by the host once, I/O operations on
+ *          the window do not require further validation.
+ *
+ * @param[in] id        window identifier
+ * @param[in] buf       window base
+ * @param[in] size      window size, zero unregisters the window
+ * @param[in] writeable @p true if the host is allowed to write the window
+ * @return              Operation result.
+ */
+static inline uint32_t sbWindowRegister(uint32_t id,
+                                        void *buf,
+                                        size_t size,
+                                        bool writeable) {
+
+  __syscall4r(14, id, buf, size, writeable);
+  return r0;
+}
+
+/**
+ * @brief   Posix-style file read into a shared I/O window.
+ *
+ * @param[in] fd        file descriptor
+ * @param[in] id        window identifier
+ * @param[in] offset    offset within the window
+ * @param[in] count     number of bytes
+ * @return              The number of bytes really transferred or an error.
+ */
+static inline size_t sbFileReadWindow(uint32_t fd,
+                                      uint32_t id,
+                                      size_t offset,
+                                      size_t count) {
+
+  __syscall4r(15, fd, id, offset, count);
+  return (size_t)r0;
+}
+
+/**
+ * @brief   Posix-style file write from a shared I/O window.
+ *
+ * @param[in] fd        file descriptor
+ * @param[in] id        window identifier
+ * @param[in] offset    offset within the window
+ * @param[in] count     number of bytes
+ * @return              The number of bytes really transferred or an error.
+ */
+static inline size_t sbFileWriteWindow(uint32_t fd,
+                                       uint32_t id,
+                                       size_t offset,
+                                       size_t count) {
+
+  __syscall4r(16, fd, id, offset, count);
+  return (size_t)r0;
+}
+
 /**
  * @brief   Terminates the sandbox.
  *
@@ -440,6 +524,209 @@ static inline uint32_t sbEventBroadcastFlags(eventflags_t flags) {
   return (uint32_t)r0;
 }
 
+/**
+ * @brief   Initializes a lightweight semaphore.
+ *
+ * @param[out] sp       pointer to a @p sb_semaphore_t structure
+ * @param[in] n         initial value of the semaphore counter
+ *
+ * @init
+ */
+static inline void sbSemObjectInit(sb_semaphore_t *sp, int32_t n) {
+
+  sp->cnt = n;
+}
+
+/**
+ * @brief   Performs a wait operation on a lightweight semaphore.
+ * @details The counter is decremented atomically in user context, the host
+ *          is invoked only if the counter becomes negative.
+ *
+ * @param[in] sp        pointer to a @p sb_semaphore_t structure
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              A message specifying how the invoking thread has been
+ *                      released from the semaphore.
+ * @retval MSG_OK       if the thread has not stopped on the semaphore or the
+ *                      semaphore has been signaled.
+ * @retval MSG_TIMEOUT  if the semaphore has not been signaled or reset within
+ *                      the specified timeout.
+ *
+ * @api
+ */
+static inline msg_t sbSemWaitTimeout(sb_semaphore_t *sp,
+                                     sysinterval_t timeout) {
+
+  if (__atomic_sub_fetch(&sp->cnt, 1, __ATOMIC_ACQUIRE) >= 0) {
+    return MSG_OK;
+  }
+
+  __syscall2r(12, &sp->cnt, timeout);
+  return (msg_t)r0;
+}
+
+/**
+ * @brief   Performs a wait operation on a lightweight semaphore.
+ * @details The counter is decremented atomically in user context, the host
+ *          is invoked only if the counter becomes negative.
+ *
+ * @param[in] sp        pointer to a @p sb_semaphore_t structure
+ * @return              A message specifying how the invoking thread has been
+ *                      released from the semaphore.
+ * @retval MSG_OK       if the thread has not stopped on the semaphore or the
+ *                      semaphore has been signaled.
+ *
+ * @api
+ */
+static inline msg_t sbSemWait(sb_semaphore_t *sp) {
+
+  return sbSemWaitTimeout(sp, TIME_INFINITE);
+}
+
+/**
+ * @brief   Performs a signal operation on a lightweight semaphore.
+ * @note    The sandbox thread is the only possible waiter so a signal from
+ *          the sandbox never needs to invoke the host.
+ *
+ * @param[in] sp        pointer to a @p sb_semaphore_t structure
+ *
+ * @api
+ */
+static inline void sbSemSignal(sb_semaphore_t *sp) {
+
+  (void) __atomic_add_fetch(&sp->cnt, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Initializes a syscall ring.
+ * @note    The memory area must be word aligned and at least
+ *          @p SB_RING_SIZE(n) bytes large.
+ *
+ * @param[out] rp       pointer to the ring memory area
+ * @param[in] n         number of entries, must be a power of two not
+ *                      greater than @p SB_RING_MAX_ENTRIES
+ *
+ * @init
+ */
+static inline void sbRingObjectInit(sb_ring_t *rp, uint32_t n) {
+
+  rp->sq_head = 0U;
+  rp->sq_tail = 0U;
+  rp->cq_head = 0U;
+  rp->cq_tail = 0U;
+  rp->entries = n;
+}
+
+/**
+ * @brief   Returns the next free submission entry.
+ * @details The entry is queued by @p sbRingSubmit() after being filled.
+ *
+ * @param[in] rp        pointer to the ring
+ * @return              Pointer to the submission entry.
+ * @retval NULL         if the submission queue is full.
+ *
+ * @api
+ */
+static inline sb_sqe_t *sbRingGetSQE(sb_ring_t *rp) {
+
+  if ((rp->sq_tail - rp->sq_head) >= rp->entries) {
+    return NULL;
+  }
+
+  return &SB_RING_SQES(rp)[rp->sq_tail & (rp->entries - 1U)];
+}
+
+/**
+ * @brief   Fills a submission entry.
+ *
+ * @param[out] sqep     pointer to the submission entry
+ * @param[in] opcode    SVC number of the requested service
+ * @param[in] p1        first service argument
+ * @param[in] p2        second service argument
+ * @param[in] p3        third service argument
+ * @param[in] p4        fourth service argument
+ * @param[in] user_data value returned in the completion entry
+ *
+ * @api
+ */
+static inline void sbRingPrepSQE(sb_sqe_t *sqep, uint32_t opcode,
+                                 uint32_t p1, uint32_t p2,
+                                 uint32_t p3, uint32_t p4,
+                                 uint32_t user_data) {
+
+  sqep->opcode    = opcode;
+  sqep->args[0]   = p1;
+  sqep->args[1]   = p2;
+  sqep->args[2]   = p3;
+  sqep->args[3]   = p4;
+  sqep->user_data = user_data;
+}
+
+/**
+ * @brief   Queues the entry returned by @p sbRingGetSQE().
+ *
+ * @param[in] rp        pointer to the ring
+ *
+ * @api
+ */
+static inline void sbRingSubmit(sb_ring_t *rp) {
+
+  rp->sq_tail = rp->sq_tail + 1U;
+}
+
+/**
+ * @brief   Makes the host serve the queued requests.
+ * @details Requests are served in order, each completion is appended to
+ *          the completion queue. The operation stops when the submission
+ *          queue is empty or the completion queue is full.
+ * @note    Blocking services block the sandbox until they complete, the
+ *          requests behind them are served after.
+ *
+ * @param[in] rp        pointer to the ring
+ * @return              The number of served requests or an error.
+ *
+ * @api
+ */
+static inline uint32_t sbRingEnter(sb_ring_t *rp) {
+
+  __syscall1r(13, rp);
+  return (uint32_t)r0;
+}
+
+/**
+ * @brief   Returns the oldest completion entry.
+ * @details The entry is released by @p sbRingSeenCQE() after being used.
+ *
+ * @param[in] rp        pointer to the ring
+ * @return              Pointer to the completion entry.
+ * @retval NULL         if the completion queue is empty.
+ *
+ * @api
+ */
+static inline sb_cqe_t *sbRingPeekCQE(sb_ring_t *rp) {
+
+  if (rp->cq_head == rp->cq_tail) {
+    return NULL;
+  }
+
+  return &SB_RING_CQES(rp, rp->entries)[rp->cq_head & (rp->entries - 1U)];
+}
+
+/**
+ * @brief   Releases the entry returned by @p sbRingPeekCQE().
+ *
+ * @param[in] rp        pointer to the ring
+ *
+ * @api
+ */
+static inline void sbRingSeenCQE(sb_ring_t *rp) {
+
+  rp->cq_head = rp->cq_head + 1U;
+}
+
 /**
  * @brief   Seconds to time interval.
  * @details Converts from seconds to system ticks number.
@@ -0,0 +1,178 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adcstream.c
+ * @brief   ADC streaming code.
+ *
+ * @addtogroup adc_stream
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "adcstream.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the stream owning the current conversion group.
+ */
+static adc_stream_t *adcs_get_stream(ADCDriver *adcp) {
+
+  return (adc_stream_t *)(void *)((uint8_t *)(void *)adcp->grpp -
+                                  offsetof(adc_stream_t, grp));
+}
+
+/**
+ * @brief   Half ring callback, the filled half is moved into a buffer.
+ */
+static void adcs_end_cb(ADCDriver *adcp) {
+  adc_stream_t *asp = adcs_get_stream(adcp);
+  const ADCStreamConfig *config = asp->config;
+  size_t n = (size_t)asp->grp.num_channels * config->depth;
+  const adcsample_t *src;
+  adc_stream_buffer_t *bp;
+
+  /* Filled half of the ring.*/
+  src = adcIsBufferComplete(adcp) ? &config->ring[n] : config->ring;
+
+  chSysLockFromISR();
+  bp = (adc_stream_buffer_t *)chFifoTakeObjectI(config->ofp);
+  if (bp == NULL) {
+    /* No free buffers, the processing thread is late.*/
+    asp->sequence++;
+    asp->lost++;
+    chSysUnlockFromISR();
+    return;
+  }
+  bp->timestamp = chVTGetTimeStampI();
+  chSysUnlockFromISR();
+
+  bp->sequence = asp->sequence++;
+
+  /* The DMA wrote the ring behind the data cache.*/
+  cacheBufferInvalidate(src, n * sizeof (adcsample_t));
+
+  if (config->filter != NULL) {
+    bp->depth = config->filter(asp, adcsGetSamples(bp), src, config->depth);
+  }
+  else {
+    memcpy((void *)adcsGetSamples(bp), (const void *)src,
+           n * sizeof (adcsample_t));
+    bp->depth = config->depth;
+  }
+
+  chSysLockFromISR();
+  chFifoSendObjectI(config->ofp, (void *)bp);
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Error callback, the error is forwarded to the group callback.
+ */
+static void adcs_error_cb(ADCDriver *adcp, adcerror_t err) {
+  adc_stream_t *asp = adcs_get_stream(adcp);
+
+  if (asp->config->grpp->error_cb != NULL) {
+    asp->config->grpp->error_cb(adcp, err);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p adc_stream_t object.
+ *
+ * @param[out] asp      pointer to the @p adc_stream_t object
+ *
+ * @init
+ */
+void adcsObjectInit(adc_stream_t *asp) {
+
+  asp->config   = NULL;
+  asp->sequence = 0U;
+  asp->lost     = 0U;
+}
+
+/**
+ * @brief   Starts streaming.
+ * @details A circular conversion is started on the DMA ring, each filled
+ *          half of the ring is moved into a buffer taken from the objects
+ *          FIFO, time stamped and posted to the FIFO.
+ *
+ * @param[in] asp       pointer to the @p adc_stream_t object
+ * @param[in] config    pointer to the @p ADCStreamConfig object
+ *
+ * @api
+ */
+void adcsStart(adc_stream_t *asp, const ADCStreamConfig *config) {
+
+  chDbgCheck((asp != NULL) && (config != NULL) && (config->ring != NULL) &&
+             (config->depth > 0U) && (config->ofp != NULL) &&
+             ((config->filter != NULL) ||
+              (config->bufdepth == config->depth)));
+
+  asp->config       = config;
+  asp->grp          = *config->grpp;
+  asp->grp.circular = true;
+  asp->grp.end_cb   = adcs_end_cb;
+  asp->grp.error_cb = adcs_error_cb;
+  asp->sequence     = 0U;
+  asp->lost         = 0U;
+
+  adcStartConversion(config->adcp, &asp->grp, config->ring,
+                     config->depth * 2U);
+}
+
+/**
+ * @brief   Stops streaming.
+ * @note    Buffers already posted remain in the objects FIFO.
+ *
+ * @param[in] asp       pointer to the @p adc_stream_t object
+ *
+ * @api
+ */
+void adcsStop(adc_stream_t *asp) {
+
+  chDbgCheck((asp != NULL) && (asp->config != NULL));
+
+  adcStopConversion(asp->config->adcp);
+}
+
+/** @} */
@@ -0,0 +1,248 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    adcstream.h
+ * @brief   ADC streaming structures and macros.
+ *
+ * @addtogroup adc_stream
+ * @{
+ */
+
+#ifndef ADCSTREAM_H
+#define ADCSTREAM_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_OBJ_FIFOS != TRUE
+#error "ADC streaming requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+#if CH_CFG_USE_TIMESTAMP != TRUE
+#error "ADC streaming requires CH_CFG_USE_TIMESTAMP"
+#endif
+
+#if HAL_USE_ADC != TRUE
+#error "ADC streaming requires HAL_USE_ADC"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an ADC stream object.
+ */
+typedef struct adc_stream adc_stream_t;
+
+/**
+ * @brief   Type of a stream buffer header.
+ * @note    The samples follow the header, see @p adcsGetSamples().
+ */
+typedef struct {
+  /**
+   * @brief   Time stamp of the buffer completion.
+   */
+  systimestamp_t        timestamp;
+  /**
+   * @brief   Buffer sequence number.
+   * @note    Gaps in the sequence are buffers lost because no free
+   *          objects were available in the FIFO.
+   */
+  uint32_t              sequence;
+  /**
+   * @brief   Number of sample rows in the buffer.
+   */
+  size_t                depth;
+} adc_stream_buffer_t;
+
+/**
+ * @brief   Type of a decimation hook.
+ * @details The hook is invoked from the ADC ISR for each filled half of
+ *          the DMA ring, it processes the source rows into the stream
+ *          buffer.
+ *
+ * @param[in] asp       pointer to the @p adc_stream_t object
+ * @param[out] dst      destination samples in the stream buffer, the area
+ *                      is large enough for @p bufdepth rows
+ * @param[in] src       source samples, @p depth rows
+ * @param[in] depth     number of source rows
+ * @return              The number of rows written in @p dst.
+ */
+typedef size_t (*adcsfilter_t)(adc_stream_t *asp,
+                               adcsample_t *dst,
+                               const adcsample_t *src,
+                               size_t depth);
+
+/**
+ * @brief   ADC stream configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   ADC driver, it must be started.
+   */
+  ADCDriver                 *adcp;
+  /**
+   * @brief   Conversion group.
+   * @note    The group is copied in the stream object, the circular mode
+   *          is forced and the callbacks are replaced, the error callback
+   *          is still invoked on errors.
+   */
+  const ADCConversionGroup  *grpp;
+  /**
+   * @brief   DMA ring buffer, it must be able to contain two times
+   *          @p depth rows.
+   */
+  adcsample_t               *ring;
+  /**
+   * @brief   Number of rows in each half of the DMA ring.
+   */
+  size_t                    depth;
+  /**
+   * @brief   Objects FIFO of the stream buffers.
+   * @note    The objects size must be at least
+   *          @p ADCS_BUFFER_SIZE(num_channels, bufdepth).
+   */
+  objects_fifo_t            *ofp;
+  /**
+   * @brief   Maximum number of rows in a stream buffer.
+   * @note    Without a decimation hook it must be equal to @p depth.
+   */
+  size_t                    bufdepth;
+  /**
+   * @brief   Decimation hook or @p NULL.
+   * @note    Without a decimation hook the rows are copied unchanged.
+   */
+  adcsfilter_t              filter;
+  /**
+   * @brief   Hook argument.
+   */
+  void                      *arg;
+} ADCStreamConfig;
+
+/**
+ * @brief   Structure representing an ADC stream.
+ */
+struct adc_stream {
+  /**
+   * @brief   Current configuration data.
+   */
+  const ADCStreamConfig     *config;
+  /**
+   * @brief   Working copy of the conversion group.
+   */
+  ADCConversionGroup        grp;
+  /**
+   * @brief   Sequence number of the next buffer.
+   */
+  uint32_t                  sequence;
+  /**
+   * @brief   Number of lost buffers.
+   */
+  uint32_t                  lost;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a stream buffer object.
+ *
+ * @param[in] n         number of channels
+ * @param[in] depth     number of rows
+ */
+#define ADCS_BUFFER_SIZE(n, depth)                                          \
+  (sizeof (adc_stream_buffer_t) +                                           \
+   ((size_t)(n) * (size_t)(depth) * sizeof (adcsample_t)))
+
+/**
+ * @brief   Returns the samples of a stream buffer.
+ *
+ * @param[in] bp        pointer to the @p adc_stream_buffer_t object
+ * @return              Pointer to the first sample.
+ */
+#define adcsGetSamples(bp) ((adcsample_t *)(void *)((bp) + 1))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void adcsObjectInit(adc_stream_t *asp);
+  void adcsStart(adc_stream_t *asp, const ADCStreamConfig *config);
+  void adcsStop(adc_stream_t *asp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Receives a filled stream buffer.
+ *
+ * @param[in] asp       pointer to the @p adc_stream_t object
+ * @param[out] bpp      pointer to the received buffer pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been received.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t adcsReceiveBufferTimeout(adc_stream_t *asp,
+                                             adc_stream_buffer_t **bpp,
+                                             sysinterval_t timeout) {
+
+  return chFifoReceiveObjectTimeout(asp->config->ofp,
+                                    (void **)bpp, timeout);
+}
+
+/**
+ * @brief   Returns a processed stream buffer to the free objects.
+ *
+ * @param[in] asp       pointer to the @p adc_stream_t object
+ * @param[in] bp        pointer to the buffer to be returned
+ *
+ * @api
+ */
+static inline void adcsReleaseBuffer(adc_stream_t *asp,
+                                     adc_stream_buffer_t *bp) {
+
+  chFifoReturnObject(asp->config->ofp, (void *)bp);
+}
+
+#endif /* ADCSTREAM_H */
+
+/** @} */
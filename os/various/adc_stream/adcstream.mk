@@ -0,0 +1,8 @@
+# ADC streaming files.
+ADCSSRC = $(CHIBIOS)/os/various/adc_stream/adcstream.c
+
+ADCSINC = $(CHIBIOS)/os/various/adc_stream
+
+# Shared variables
+ALLCSRC += $(ADCSSRC)
+ALLINC  += $(ADCSINC)
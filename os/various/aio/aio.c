@@ -0,0 +1,382 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    aio.c
+ * @brief   Asynchronous channels I/O code.
+ *
+ * @addtogroup aio
+ * @details A single thread serves read and write operations on any number
+ *          of @p BaseAsynchronousChannel objects:
+ *          - Each channel is attached to the loop as a port, a listener
+ *            on the channel event source wakes the loop thread on the
+ *            @p CHN_INPUT_AVAILABLE, @p CHN_OUTPUT_EMPTY and
+ *            @p CHN_DISCONNECTED conditions.
+ *          - Operations are advanced by non-blocking reads and writes
+ *            directly between the channel queues and the operation
+ *            buffers.
+ *          - Completion callbacks are invoked by @p aioDispatchTimeout()
+ *            in the loop thread.
+ *          .
+ * @{
+ */
+
+#include "aio.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Channel conditions waking the loop.
+ */
+#define AIO_CHN_FLAGS                                                       \
+  (CHN_INPUT_AVAILABLE | CHN_OUTPUT_EMPTY | CHN_DISCONNECTED)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Advances an operation.
+ *
+ * @return              The operation is complete.
+ */
+static bool aio_advance(aio_op_t *aop, eventflags_t flags, systime_t now) {
+  BaseAsynchronousChannel *chp = aop->port->chp;
+
+  if (aop->done < aop->n) {
+    if ((aop->mode & AIO_OP_WRITE) != 0U) {
+      aop->done += chnWriteTimeout(chp, aop->buf + aop->done,
+                                   aop->n - aop->done, TIME_IMMEDIATE);
+    }
+    else {
+      aop->done += chnReadTimeout(chp, aop->buf + aop->done,
+                                  aop->n - aop->done, TIME_IMMEDIATE);
+    }
+  }
+
+  if ((aop->done >= aop->n) ||
+      (((aop->mode & AIO_OP_SOME) != 0U) && (aop->done > 0U))) {
+    aop->result = MSG_OK;
+  }
+  else if ((flags & CHN_DISCONNECTED) != 0U) {
+    aop->result = MSG_RESET;
+  }
+  else if ((aop->timeout != TIME_INFINITE) &&
+           (chTimeDiffX(aop->start, now) >= aop->timeout)) {
+    aop->result = MSG_TIMEOUT;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Advances the pending operations of all ports.
+ *
+ * @return              The number of completed operations.
+ */
+static unsigned aio_pass(aio_loop_t *lp) {
+  systime_t now = chVTGetSystemTimeX();
+  unsigned completed = 0U;
+  aio_port_t *pp;
+
+  (void) chEvtGetAndClearEvents(lp->events);
+
+  for (pp = lp->ports; pp != NULL; pp = pp->next) {
+    eventflags_t flags = chEvtGetAndClearFlags(&pp->el);
+    aio_op_t *aop;
+
+    /* The slots are freed before the callbacks, the callbacks can start
+       the next operation on the same port.*/
+    aop = pp->rdop;
+    if ((aop != NULL) && aio_advance(aop, flags, now)) {
+      pp->rdop  = NULL;
+      aop->port = NULL;
+      completed++;
+      if (aop->cb != NULL) {
+        aop->cb(aop);
+      }
+    }
+
+    aop = pp->wrop;
+    if ((aop != NULL) && aio_advance(aop, flags, now)) {
+      pp->wrop  = NULL;
+      aop->port = NULL;
+      completed++;
+      if (aop->cb != NULL) {
+        aop->cb(aop);
+      }
+    }
+  }
+
+  return completed;
+}
+
+/**
+ * @brief   Returns the time to the nearest operation timeout.
+ */
+static sysinterval_t aio_next_timeout(aio_loop_t *lp, sysinterval_t timeout) {
+  systime_t now = chVTGetSystemTimeX();
+  aio_port_t *pp;
+
+  for (pp = lp->ports; pp != NULL; pp = pp->next) {
+    aio_op_t *ops[2] = {pp->rdop, pp->wrop};
+    unsigned i;
+
+    for (i = 0U; i < 2U; i++) {
+      aio_op_t *aop = ops[i];
+      sysinterval_t elapsed;
+
+      if ((aop == NULL) || (aop->timeout == TIME_INFINITE)) {
+        continue;
+      }
+      elapsed = chTimeDiffX(aop->start, now);
+      if (elapsed >= aop->timeout) {
+        return TIME_IMMEDIATE;
+      }
+      if ((timeout == TIME_INFINITE) || (aop->timeout - elapsed < timeout)) {
+        timeout = aop->timeout - elapsed;
+      }
+    }
+  }
+
+  return timeout;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p aio_loop_t object.
+ * @note    The calling thread becomes the loop thread, the ports must be
+ *          attached and the loop dispatched by this thread.
+ *
+ * @param[out] lp       pointer to the @p aio_loop_t object
+ * @param[in] id        numeric identifier of the event used by the loop,
+ *                      it must not be used by other event sources of the
+ *                      thread
+ *
+ * @init
+ */
+void aioLoopObjectInit(aio_loop_t *lp, eventid_t id) {
+
+  chDbgCheck(lp != NULL);
+
+  lp->ports  = NULL;
+  lp->events = EVENT_MASK(id);
+  lp->owner  = chThdGetSelfX();
+}
+
+/**
+ * @brief   Attaches a channel to a loop.
+ *
+ * @param[in] lp        pointer to the @p aio_loop_t object
+ * @param[out] pp       pointer to the @p aio_port_t object
+ * @param[in] chp       pointer to a @p BaseAsynchronousChannel or derived
+ *                      class
+ *
+ * @api
+ */
+void aioAttach(aio_loop_t *lp, aio_port_t *pp,
+               BaseAsynchronousChannel *chp) {
+
+  chDbgCheck((lp != NULL) && (pp != NULL) && (chp != NULL));
+  chDbgAssert(lp->owner == chThdGetSelfX(), "not the loop thread");
+
+  pp->loop = lp;
+  pp->chp  = chp;
+  pp->rdop = NULL;
+  pp->wrop = NULL;
+  chEvtRegisterMaskWithFlags(chnGetEventSource(chp), &pp->el,
+                             lp->events, AIO_CHN_FLAGS);
+  pp->next  = lp->ports;
+  lp->ports = pp;
+}
+
+/**
+ * @brief   Detaches a channel from its loop.
+ * @details Pending operations are cancelled without invoking their
+ *          callbacks.
+ * @note    This function cannot be called from completion callbacks.
+ *
+ * @param[in] pp        pointer to the @p aio_port_t object
+ *
+ * @api
+ */
+void aioDetach(aio_port_t *pp) {
+  aio_port_t **ppp;
+
+  chDbgCheck((pp != NULL) && (pp->loop != NULL));
+  chDbgAssert(pp->loop->owner == chThdGetSelfX(), "not the loop thread");
+
+  if (pp->rdop != NULL) {
+    (void) aioCancel(pp->rdop);
+  }
+  if (pp->wrop != NULL) {
+    (void) aioCancel(pp->wrop);
+  }
+  chEvtUnregister(chnGetEventSource(pp->chp), &pp->el);
+
+  ppp = &pp->loop->ports;
+  while (*ppp != pp) {
+    ppp = &(*ppp)->next;
+  }
+  *ppp = pp->next;
+  pp->loop = NULL;
+}
+
+/**
+ * @brief   Initializes an @p aio_op_t object.
+ *
+ * @param[out] aop      pointer to the @p aio_op_t object
+ * @param[in] cb        completion callback or @p NULL
+ * @param[in] arg       application defined field
+ *
+ * @init
+ */
+void aioOpObjectInit(aio_op_t *aop, aio_cb_t cb, void *arg) {
+
+  chDbgCheck(aop != NULL);
+
+  aop->port   = NULL;
+  aop->done   = 0U;
+  aop->result = MSG_OK;
+  aop->cb     = cb;
+  aop->arg    = arg;
+}
+
+/**
+ * @brief   Starts an operation.
+ * @details One read and one write operation can be pending on each port,
+ *          the operation is advanced and completed by
+ *          @p aioDispatchTimeout().
+ *
+ * @param[in] pp        pointer to the @p aio_port_t object
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @param[in] mode      operation mode, @p AIO_OP_READ or @p AIO_OP_WRITE
+ *                      optionally or-ed with @p AIO_OP_SOME
+ * @param[in,out] bp    pointer to the data buffer
+ * @param[in] n         number of bytes to be transferred
+ * @param[in] timeout   operation timeout or @p TIME_INFINITE
+ *
+ * @api
+ */
+void aioStart(aio_port_t *pp, aio_op_t *aop, unsigned mode,
+              uint8_t *bp, size_t n, sysinterval_t timeout) {
+  aio_op_t **slotp;
+
+  chDbgCheck((pp != NULL) && (pp->loop != NULL) && (aop != NULL) &&
+             (bp != NULL) && (n > 0U));
+  chDbgAssert(pp->loop->owner == chThdGetSelfX(), "not the loop thread");
+  chDbgAssert(aop->port == NULL, "operation pending");
+
+  slotp = (mode & AIO_OP_WRITE) != 0U ? &pp->wrop : &pp->rdop;
+  chDbgAssert(*slotp == NULL, "port busy");
+
+  aop->mode    = mode;
+  aop->buf     = bp;
+  aop->n       = n;
+  aop->done    = 0U;
+  aop->start   = chVTGetSystemTimeX();
+  aop->timeout = timeout;
+  aop->result  = MSG_OK;
+  aop->port    = pp;
+  *slotp       = aop;
+}
+
+/**
+ * @brief   Cancels a pending operation.
+ * @details The callback is not invoked, the data already transferred is
+ *          not returned to the channel.
+ *
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @return              The number of bytes transferred before the
+ *                      cancellation.
+ *
+ * @api
+ */
+size_t aioCancel(aio_op_t *aop) {
+  aio_port_t *pp;
+
+  chDbgCheck(aop != NULL);
+
+  pp = aop->port;
+  if (pp != NULL) {
+    if (pp->rdop == aop) {
+      pp->rdop = NULL;
+    }
+    else {
+      pp->wrop = NULL;
+    }
+    aop->port   = NULL;
+    aop->result = MSG_RESET;
+  }
+
+  return aop->done;
+}
+
+/**
+ * @brief   Dispatches the loop.
+ * @details Pending operations are advanced, if none completes the thread
+ *          waits for a channel condition, for the nearest operation
+ *          timeout or for the specified timeout then the operations are
+ *          advanced again. Completion callbacks are invoked by this
+ *          function.
+ *
+ * @param[in] lp        pointer to the @p aio_loop_t object
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The number of completed operations.
+ *
+ * @api
+ */
+unsigned aioDispatchTimeout(aio_loop_t *lp, sysinterval_t timeout) {
+  unsigned completed;
+
+  chDbgCheck(lp != NULL);
+  chDbgAssert(lp->owner == chThdGetSelfX(), "not the loop thread");
+
+  completed = aio_pass(lp);
+  if ((completed > 0U) || (timeout == TIME_IMMEDIATE)) {
+    return completed;
+  }
+
+  (void) chEvtWaitAnyTimeout(lp->events, aio_next_timeout(lp, timeout));
+
+  return aio_pass(lp);
+}
+
+/** @} */
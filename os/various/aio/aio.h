@@ -0,0 +1,284 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    aio.h
+ * @brief   Asynchronous channels I/O structures and macros.
+ *
+ * @addtogroup aio
+ * @{
+ */
+
+#ifndef AIO_H
+#define AIO_H
+
+#include "ch.h"
+#include "hal.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Operation modes
+ * @{
+ */
+/** @brief Read operation.*/
+#define AIO_OP_READ                         0U
+/** @brief Write operation.*/
+#define AIO_OP_WRITE                        1U
+/** @brief Completion after the first transferred bytes.*/
+#define AIO_OP_SOME                         2U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_EVENTS != TRUE
+#error "asynchronous I/O requires CH_CFG_USE_EVENTS"
+#endif
+
+#if CH_CFG_USE_EVENTS_TIMEOUT != TRUE
+#error "asynchronous I/O requires CH_CFG_USE_EVENTS_TIMEOUT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an I/O loop object.
+ */
+typedef struct aio_loop aio_loop_t;
+
+/**
+ * @brief   Type of a channel attached to a loop.
+ */
+typedef struct aio_port aio_port_t;
+
+/**
+ * @brief   Type of an I/O operation.
+ */
+typedef struct aio_op aio_op_t;
+
+/**
+ * @brief   Type of an operation completion callback.
+ * @note    Callbacks are invoked by @p aioDispatchTimeout() in the loop
+ *          thread context, new operations can be started from callbacks.
+ *
+ * @param[in] aop       pointer to the completed @p aio_op_t object
+ */
+typedef void (*aio_cb_t)(aio_op_t *aop);
+
+/**
+ * @brief   Structure representing an I/O operation.
+ */
+struct aio_op {
+  /**
+   * @brief   Port the operation is pending on or @p NULL.
+   */
+  aio_port_t                *port;
+  /**
+   * @brief   Operation mode.
+   */
+  unsigned                  mode;
+  /**
+   * @brief   Data buffer.
+   */
+  uint8_t                   *buf;
+  /**
+   * @brief   Number of bytes to be transferred.
+   */
+  size_t                    n;
+  /**
+   * @brief   Number of bytes transferred.
+   */
+  size_t                    done;
+  /**
+   * @brief   Operation start time.
+   */
+  systime_t                 start;
+  /**
+   * @brief   Operation timeout.
+   */
+  sysinterval_t             timeout;
+  /**
+   * @brief   Completion status.
+   */
+  msg_t                     result;
+  /**
+   * @brief   Completion callback.
+   */
+  aio_cb_t                  cb;
+  /**
+   * @brief   Application defined field.
+   */
+  void                      *arg;
+};
+
+/**
+ * @brief   Structure representing a channel attached to a loop.
+ */
+struct aio_port {
+  /**
+   * @brief   Next port in the loop.
+   */
+  aio_port_t                *next;
+  /**
+   * @brief   Loop the port is attached to.
+   */
+  aio_loop_t                *loop;
+  /**
+   * @brief   Attached channel.
+   */
+  BaseAsynchronousChannel   *chp;
+  /**
+   * @brief   Listener on the channel event source.
+   */
+  event_listener_t          el;
+  /**
+   * @brief   Pending read operation or @p NULL.
+   */
+  aio_op_t                  *rdop;
+  /**
+   * @brief   Pending write operation or @p NULL.
+   */
+  aio_op_t                  *wrop;
+};
+
+/**
+ * @brief   Structure representing an I/O loop.
+ */
+struct aio_loop {
+  /**
+   * @brief   Attached ports.
+   */
+  aio_port_t                *ports;
+  /**
+   * @brief   Event used by the channel listeners.
+   */
+  eventmask_t               events;
+  /**
+   * @brief   Thread running the loop.
+   */
+  thread_t                  *owner;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of bytes transferred by an operation.
+ *
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @return              The number of bytes transferred.
+ *
+ * @xclass
+ */
+#define aioGetTransferredX(aop) ((aop)->done)
+
+/**
+ * @brief   Returns the completion status of an operation.
+ *
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @return              The completion status.
+ * @retval MSG_OK       if the requested bytes have been transferred.
+ * @retval MSG_TIMEOUT  if the operation timed out.
+ * @retval MSG_RESET    if the channel has been disconnected.
+ *
+ * @xclass
+ */
+#define aioGetResultX(aop) ((aop)->result)
+
+/**
+ * @brief   Checks if an operation is pending.
+ *
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @return              The operation status.
+ *
+ * @xclass
+ */
+#define aioIsPendingX(aop) ((aop)->port != NULL)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void aioLoopObjectInit(aio_loop_t *lp, eventid_t id);
+  void aioAttach(aio_loop_t *lp, aio_port_t *pp,
+                 BaseAsynchronousChannel *chp);
+  void aioDetach(aio_port_t *pp);
+  void aioOpObjectInit(aio_op_t *aop, aio_cb_t cb, void *arg);
+  void aioStart(aio_port_t *pp, aio_op_t *aop, unsigned mode,
+                uint8_t *bp, size_t n, sysinterval_t timeout);
+  size_t aioCancel(aio_op_t *aop);
+  unsigned aioDispatchTimeout(aio_loop_t *lp, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Starts a read operation.
+ *
+ * @param[in] pp        pointer to the @p aio_port_t object
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @param[out] bp       pointer to the data buffer
+ * @param[in] n         number of bytes to be read
+ * @param[in] timeout   operation timeout or @p TIME_INFINITE
+ *
+ * @api
+ */
+static inline void aioStartRead(aio_port_t *pp, aio_op_t *aop,
+                                uint8_t *bp, size_t n,
+                                sysinterval_t timeout) {
+
+  aioStart(pp, aop, AIO_OP_READ, bp, n, timeout);
+}
+
+/**
+ * @brief   Starts a write operation.
+ *
+ * @param[in] pp        pointer to the @p aio_port_t object
+ * @param[in] aop       pointer to the @p aio_op_t object
+ * @param[in] bp        pointer to the data buffer
+ * @param[in] n         number of bytes to be written
+ * @param[in] timeout   operation timeout or @p TIME_INFINITE
+ *
+ * @api
+ */
+static inline void aioStartWrite(aio_port_t *pp, aio_op_t *aop,
+                                 const uint8_t *bp, size_t n,
+                                 sysinterval_t timeout) {
+
+  aioStart(pp, aop, AIO_OP_WRITE, (uint8_t *)bp, n, timeout);
+}
+
+#endif /* AIO_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Asynchronous channels I/O files.
+AIOSRC = $(CHIBIOS)/os/various/aio/aio.c
+
+AIOINC = $(CHIBIOS)/os/various/aio
+
+# Shared variables
+ALLCSRC += $(AIOSRC)
+ALLINC  += $(AIOINC)
@@ -0,0 +1,738 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.c
+ * @brief   Cached block device code.
+ *
+ * @addtogroup blkcache
+ * @{
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "hal.h"
+#include "blkcache.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Cache group of the blocks.
+ */
+#define BCD_GROUP                           0U
+
+/**
+ * @brief   Returns the device owning an objects cache.
+ */
+#define bcd_from_cache(ocp)                                                 \
+  ((CachedBlockDevice *)(void *)((uint8_t *)(ocp) -                         \
+                                 offsetof(CachedBlockDevice, cache)))
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static bool bcd_is_inserted(void *instance);
+static bool bcd_is_protected(void *instance);
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct CachedBlockDeviceVMT bcd_vmt = {
+  (size_t)0,
+  bcd_is_inserted,
+  bcd_is_protected,
+  (bool (*)(void *))bcdConnect,
+  (bool (*)(void *))bcdDisconnect,
+  (bool (*)(void *, uint32_t, uint8_t *, uint32_t))bcdRead,
+  (bool (*)(void *, uint32_t, const uint8_t *, uint32_t))bcdWrite,
+  (bool (*)(void *))bcdSync,
+  (bool (*)(void *, BlockDeviceInfo *))bcdGetInfo
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool bcd_is_inserted(void *instance) {
+  CachedBlockDevice *bcdp = (CachedBlockDevice *)instance;
+
+  if (bcdp->config == NULL) {
+    return false;
+  }
+
+  return blkIsInserted(bcdp->config->blkp);
+}
+
+static bool bcd_is_protected(void *instance) {
+  CachedBlockDevice *bcdp = (CachedBlockDevice *)instance;
+
+  if (bcdp->config == NULL) {
+    return true;
+  }
+
+  return blkIsWriteProtected(bcdp->config->blkp);
+}
+
+/**
+ * @brief   Returns the cache buffer of a block, if cached.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] blk       block number
+ * @return              The cache buffer or @p NULL if not cached.
+ *
+ * @notapi
+ */
+static bcd_buffer_t *bcd_lookup(CachedBlockDevice *bcdp, uint32_t blk) {
+  bcd_buffer_t *bp = bcdp->config->bufp;
+  ucnt_t i;
+
+  for (i = (ucnt_t)0; i < bcdp->config->bufn; i++, bp++) {
+    if (((bp->obj.obj_flags & OC_FLAG_INHASH) != 0U) &&
+        (bp->obj.obj_key == blk)) {
+      return bp;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Determines if a block is cached and dirty.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] blk       block number
+ * @return              The block state.
+ * @retval false        if the block is not cached or clean.
+ * @retval true         if the block is dirty.
+ *
+ * @notapi
+ */
+static bool bcd_is_dirty(CachedBlockDevice *bcdp, uint32_t blk) {
+  bcd_buffer_t *bp = bcd_lookup(bcdp, blk);
+
+  return (bp != NULL) && ((bp->obj.obj_flags & OC_FLAG_LAZYWRITE) != 0U);
+}
+
+/**
+ * @brief   Gets ownership of the cache buffer of a cached block.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] ownedp    buffer already owned by the caller or @p NULL
+ * @param[in] blk       block number
+ * @return              The owned buffer.
+ *
+ * @notapi
+ */
+static bcd_buffer_t *bcd_acquire(CachedBlockDevice *bcdp,
+                                 bcd_buffer_t *ownedp,
+                                 uint32_t blk) {
+
+  if ((ownedp != NULL) && (ownedp->obj.obj_key == blk)) {
+    return ownedp;
+  }
+
+  return (bcd_buffer_t *)chCacheGetObject(&bcdp->cache, BCD_GROUP, blk);
+}
+
+/**
+ * @brief   Releases a buffer obtained with @p bcd_acquire().
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] ownedp    buffer already owned by the caller or @p NULL
+ * @param[in] bp        buffer to be released
+ *
+ * @notapi
+ */
+static void bcd_release(CachedBlockDevice *bcdp,
+                        bcd_buffer_t *ownedp,
+                        bcd_buffer_t *bp) {
+
+  if (bp != ownedp) {
+    chCacheReleaseObject(&bcdp->cache, &bp->obj);
+  }
+}
+
+/**
+ * @brief   Writes back the run of dirty blocks containing a block.
+ * @details The run extends in both directions up to the size of the
+ *          coalescing buffer and is written with a single multi-block
+ *          operation. Blocks are marked clean only after a successful
+ *          write.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] ownedp    buffer of @p blk if already owned by the caller
+ *                      or @p NULL
+ * @param[in] blk       dirty block number
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @notapi
+ */
+static bool bcd_write_run(CachedBlockDevice *bcdp,
+                          bcd_buffer_t *ownedp,
+                          uint32_t blk) {
+  const CachedBlockDeviceConfig *config = bcdp->config;
+  bcd_buffer_t *bp;
+  uint32_t first, n, i;
+  bool err;
+
+  first = blk;
+  n     = 1U;
+  if (config->wbuf != NULL) {
+    while ((n < config->wbufn) && (first > 0U) &&
+           bcd_is_dirty(bcdp, first - 1U)) {
+      first--;
+      n++;
+    }
+    while ((n < config->wbufn) && bcd_is_dirty(bcdp, first + n)) {
+      n++;
+    }
+  }
+
+  if (n == 1U) {
+    /* Single block, written directly from its buffer.*/
+    bp = bcd_acquire(bcdp, ownedp, blk);
+    err = blkWrite(config->blkp, blk, bp->data, 1U);
+    if (!err) {
+      bp->obj.obj_flags &= ~OC_FLAG_LAZYWRITE;
+    }
+    bcd_release(bcdp, ownedp, bp);
+
+    return err;
+  }
+
+  /* Gathering the run into the coalescing buffer, the blocks stay dirty
+     until written.*/
+  for (i = 0U; i < n; i++) {
+    bp = bcd_acquire(bcdp, ownedp, first + i);
+    memcpy(config->wbuf + (i * BCD_BLOCK_SIZE), bp->data, BCD_BLOCK_SIZE);
+    bcd_release(bcdp, ownedp, bp);
+  }
+
+  err = blkWrite(config->blkp, first, config->wbuf, n);
+  if (!err) {
+    for (i = 0U; i < n; i++) {
+      bp = bcd_acquire(bcdp, ownedp, first + i);
+      bp->obj.obj_flags &= ~OC_FLAG_LAZYWRITE;
+      bcd_release(bcdp, ownedp, bp);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Cache object read function.
+ *
+ * @param[in] ocp       pointer to the @p objects_cache_t structure
+ * @param[in] objp      pointer to the @p oc_object_t structure
+ * @param[in] async     releases the object after the operation
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool bcd_readf(objects_cache_t *ocp, oc_object_t *objp, bool async) {
+  CachedBlockDevice *bcdp = bcd_from_cache(ocp);
+  bool err;
+
+  err = blkRead(bcdp->config->blkp, objp->obj_key,
+                ((bcd_buffer_t *)objp)->data, 1U);
+  if (!err) {
+    objp->obj_flags &= ~OC_FLAG_NOTSYNC;
+  }
+
+  if (async) {
+    chCacheReleaseObject(ocp, objp);
+    return false;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Cache object write function.
+ * @note    The cache invokes this function asynchronously when evicting
+ *          a dirty block, the neighbouring dirty blocks are written back
+ *          with it.
+ *
+ * @param[in] ocp       pointer to the @p objects_cache_t structure
+ * @param[in] objp      pointer to the @p oc_object_t structure
+ * @param[in] async     releases the object after the operation
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool bcd_writef(objects_cache_t *ocp, oc_object_t *objp, bool async) {
+  CachedBlockDevice *bcdp = bcd_from_cache(ocp);
+  bool err;
+
+  err = bcd_write_run(bcdp, (bcd_buffer_t *)objp, objp->obj_key);
+
+  if (async) {
+    /* On failure the evicted block is lost, the error is reported by the
+       next synchronization.*/
+    if (err) {
+      bcdp->write_failed = true;
+      objp->obj_flags |= OC_FLAG_NOTSYNC;
+    }
+    chCacheReleaseObject(ocp, objp);
+    return false;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Updates the cached copies of blocks written bypassing the cache.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] startblk  first block written
+ * @param[in] buf       pointer to the written data
+ * @param[in] n         number of blocks written
+ * @param[in] dirty     leaves the updated blocks marked as dirty
+ *
+ * @notapi
+ */
+static void bcd_update_cached(CachedBlockDevice *bcdp, uint32_t startblk,
+                              const uint8_t *buf, uint32_t n, bool dirty) {
+  bcd_buffer_t *bp = bcdp->config->bufp;
+  ucnt_t i;
+
+  for (i = (ucnt_t)0; i < bcdp->config->bufn; i++, bp++) {
+    uint32_t blk = bp->obj.obj_key;
+
+    if (((bp->obj.obj_flags & OC_FLAG_INHASH) != 0U) &&
+        (blk >= startblk) && ((blk - startblk) < n)) {
+      oc_object_t *objp = chCacheGetObject(&bcdp->cache, BCD_GROUP, blk);
+
+      memcpy(bp->data, buf + ((blk - startblk) * BCD_BLOCK_SIZE),
+             BCD_BLOCK_SIZE);
+      objp->obj_flags &= ~(OC_FLAG_NOTSYNC | OC_FLAG_LAZYWRITE);
+      if (dirty) {
+        objp->obj_flags |= OC_FLAG_LAZYWRITE;
+      }
+      chCacheReleaseObject(&bcdp->cache, objp);
+    }
+  }
+}
+
+/**
+ * @brief   Overlays the dirty cached blocks on data read bypassing the cache.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] startblk  first block read
+ * @param[out] buf      pointer to the read data
+ * @param[in] n         number of blocks read
+ *
+ * @notapi
+ */
+static void bcd_overlay_dirty(CachedBlockDevice *bcdp, uint32_t startblk,
+                              uint8_t *buf, uint32_t n) {
+  bcd_buffer_t *bp = bcdp->config->bufp;
+  ucnt_t i;
+
+  for (i = (ucnt_t)0; i < bcdp->config->bufn; i++, bp++) {
+    uint32_t blk = bp->obj.obj_key;
+
+    if (((bp->obj.obj_flags & (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) ==
+         (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) &&
+        (blk >= startblk) && ((blk - startblk) < n)) {
+      memcpy(buf + ((blk - startblk) * BCD_BLOCK_SIZE), bp->data,
+             BCD_BLOCK_SIZE);
+    }
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a cached block device object.
+ *
+ * @param[out] bcdp     pointer to the @p CachedBlockDevice object
+ *
+ * @init
+ */
+void bcdObjectInit(CachedBlockDevice *bcdp) {
+
+  bcdp->vmt          = &bcd_vmt;
+  bcdp->state        = BLK_STOP;
+  bcdp->config       = NULL;
+  bcdp->write_failed = false;
+}
+
+/**
+ * @brief   Configures and activates the cached block device.
+ * @note    The wrapped device must be already started.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] config    pointer to the @p CachedBlockDeviceConfig object
+ *
+ * @api
+ */
+void bcdStart(CachedBlockDevice *bcdp, const CachedBlockDeviceConfig *config) {
+
+  osalDbgCheck((bcdp != NULL) && (config != NULL) &&
+               (config->blkp != NULL) && (config->bufp != NULL));
+  osalDbgAssert((bcdp->state == BLK_STOP) || (bcdp->state == BLK_ACTIVE),
+                "invalid state");
+
+  bcdp->config = config;
+  chCacheObjectInit(&bcdp->cache,
+                    config->hashn, config->hashp,
+                    config->bufn, sizeof (bcd_buffer_t),
+                    (void *)config->bufp,
+                    bcd_readf, bcd_writef);
+  bcdp->state = BLK_ACTIVE;
+}
+
+/**
+ * @brief   Deactivates the cached block device.
+ * @note    The wrapped device is not stopped.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ *
+ * @api
+ */
+void bcdStop(CachedBlockDevice *bcdp) {
+
+  osalDbgCheck(bcdp != NULL);
+  osalDbgAssert((bcdp->state == BLK_STOP) || (bcdp->state == BLK_ACTIVE),
+                "invalid state");
+
+  bcdp->config = NULL;
+  bcdp->state  = BLK_STOP;
+}
+
+/**
+ * @brief   Connects the wrapped device.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed or the block size of the wrapped
+ *                      device is not @p BCD_BLOCK_SIZE.
+ *
+ * @api
+ */
+bool bcdConnect(CachedBlockDevice *bcdp) {
+  BlockDeviceInfo bdi;
+
+  osalDbgCheck(bcdp != NULL);
+  osalDbgAssert((bcdp->state == BLK_ACTIVE) || (bcdp->state == BLK_READY),
+                "invalid state");
+
+  /* Already connected.*/
+  if (bcdp->state == BLK_READY) {
+    return HAL_SUCCESS;
+  }
+
+  bcdp->state = BLK_CONNECTING;
+
+  if (blkConnect(bcdp->config->blkp)) {
+    bcdp->state = BLK_ACTIVE;
+    return HAL_FAILED;
+  }
+
+  if (blkGetInfo(bcdp->config->blkp, &bdi) ||
+      (bdi.blk_size != BCD_BLOCK_SIZE)) {
+    (void) blkDisconnect(bcdp->config->blkp);
+    bcdp->state = BLK_ACTIVE;
+    return HAL_FAILED;
+  }
+
+  bcdp->write_failed = false;
+  bcdp->state        = BLK_READY;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Disconnects the wrapped device.
+ * @details Dirty blocks are written back and the cache is invalidated.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed, dirty blocks could have been lost.
+ *
+ * @api
+ */
+bool bcdDisconnect(CachedBlockDevice *bcdp) {
+  bool err;
+
+  osalDbgCheck(bcdp != NULL);
+  osalDbgAssert((bcdp->state == BLK_ACTIVE) || (bcdp->state == BLK_READY),
+                "invalid state");
+
+  if (bcdp->state == BLK_ACTIVE) {
+    return HAL_SUCCESS;
+  }
+
+  err = bcdSync(bcdp);
+
+  bcdp->state = BLK_DISCONNECTING;
+  bcdInvalidate(bcdp);
+  if (blkDisconnect(bcdp->config->blkp)) {
+    err = HAL_FAILED;
+  }
+  bcdp->state = BLK_ACTIVE;
+
+  return err;
+}
+
+/**
+ * @brief   Reads one or more blocks.
+ * @details Transfers of at least @p bypassn blocks are read directly from
+ *          the wrapped device, the dirty cached blocks are then copied
+ *          over the read data.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] startblk  first block to read
+ * @param[out] buf      pointer to the read buffer
+ * @param[in] n         number of blocks to read
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool bcdRead(CachedBlockDevice *bcdp, uint32_t startblk,
+             uint8_t *buf, uint32_t n) {
+  const CachedBlockDeviceConfig *config;
+  uint32_t i;
+
+  osalDbgCheck((bcdp != NULL) && (buf != NULL) && (n > 0U));
+  osalDbgAssert(bcdp->state == BLK_READY, "invalid state");
+
+  config = bcdp->config;
+  bcdp->state = BLK_READING;
+
+  if ((config->bypassn > 0U) && (n >= config->bypassn)) {
+    if (blkRead(config->blkp, startblk, buf, n)) {
+      bcdp->state = BLK_READY;
+      return HAL_FAILED;
+    }
+    bcd_overlay_dirty(bcdp, startblk, buf, n);
+    bcdp->state = BLK_READY;
+    return HAL_SUCCESS;
+  }
+
+  for (i = 0U; i < n; i++) {
+    oc_object_t *objp = chCacheGetObject(&bcdp->cache, BCD_GROUP,
+                                         startblk + i);
+
+    /* Cache miss, the object is released invalidated on failure.*/
+    if ((objp->obj_flags & OC_FLAG_NOTSYNC) != 0U) {
+      if (chCacheReadObject(&bcdp->cache, objp, false)) {
+        chCacheReleaseObject(&bcdp->cache, objp);
+        bcdp->state = BLK_READY;
+        return HAL_FAILED;
+      }
+    }
+
+    memcpy(buf + (i * BCD_BLOCK_SIZE), ((bcd_buffer_t *)objp)->data,
+           BCD_BLOCK_SIZE);
+    chCacheReleaseObject(&bcdp->cache, objp);
+  }
+
+  bcdp->state = BLK_READY;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes one or more blocks.
+ * @details Blocks are written into the cache and marked as dirty, they are
+ *          written back on synchronization or when evicted. Transfers of
+ *          at least @p bypassn blocks are written directly to the wrapped
+ *          device and the cached copies updated.
+ * @note    Failures during the write back of evicted blocks are reported
+ *          by the next @p bcdSync().
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[in] startblk  first block to write
+ * @param[in] buf       pointer to the write buffer
+ * @param[in] n         number of blocks to write
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool bcdWrite(CachedBlockDevice *bcdp, uint32_t startblk,
+              const uint8_t *buf, uint32_t n) {
+  const CachedBlockDeviceConfig *config;
+  uint32_t i;
+
+  osalDbgCheck((bcdp != NULL) && (buf != NULL) && (n > 0U));
+  osalDbgAssert(bcdp->state == BLK_READY, "invalid state");
+
+  config = bcdp->config;
+  bcdp->state = BLK_WRITING;
+
+  if ((config->bypassn > 0U) && (n >= config->bypassn)) {
+    /* On failure the cached copies are left dirty so the data is written
+       again by the next synchronization.*/
+    bool err = blkWrite(config->blkp, startblk, buf, n);
+    bcd_update_cached(bcdp, startblk, buf, n, err);
+    bcdp->state = BLK_READY;
+    return err;
+  }
+
+  for (i = 0U; i < n; i++) {
+    oc_object_t *objp = chCacheGetObject(&bcdp->cache, BCD_GROUP,
+                                         startblk + i);
+
+    memcpy(((bcd_buffer_t *)objp)->data, buf + (i * BCD_BLOCK_SIZE),
+           BCD_BLOCK_SIZE);
+    objp->obj_flags &= ~OC_FLAG_NOTSYNC;
+    objp->obj_flags |= OC_FLAG_LAZYWRITE;
+    chCacheReleaseObject(&bcdp->cache, objp);
+  }
+
+  bcdp->state = BLK_READY;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes back all the dirty blocks.
+ * @details Dirty blocks are written in ascending order, contiguous blocks
+ *          are coalesced in multi-block writes, then the wrapped device
+ *          is synchronized.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed or a write back of an evicted
+ *                      block failed since the previous synchronization.
+ *
+ * @api
+ */
+bool bcdSync(CachedBlockDevice *bcdp) {
+  bool err = HAL_SUCCESS;
+
+  osalDbgCheck(bcdp != NULL);
+  osalDbgAssert(bcdp->state == BLK_READY, "invalid state");
+
+  bcdp->state = BLK_SYNCING;
+
+  while (true) {
+    bcd_buffer_t *bp = bcdp->config->bufp;
+    bcd_buffer_t *firstp = NULL;
+    ucnt_t i;
+
+    /* Searching the lowest dirty block, the run starts there.*/
+    for (i = (ucnt_t)0; i < bcdp->config->bufn; i++, bp++) {
+      if (((bp->obj.obj_flags & (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) ==
+           (OC_FLAG_INHASH | OC_FLAG_LAZYWRITE)) &&
+          ((firstp == NULL) || (bp->obj.obj_key < firstp->obj.obj_key))) {
+        firstp = bp;
+      }
+    }
+
+    if (firstp == NULL) {
+      break;
+    }
+
+    /* Stopping on failure, the remaining blocks stay dirty.*/
+    if (bcd_write_run(bcdp, NULL, firstp->obj.obj_key)) {
+      err = HAL_FAILED;
+      break;
+    }
+  }
+
+  if (blkSync(bcdp->config->blkp)) {
+    err = HAL_FAILED;
+  }
+
+  if (bcdp->write_failed) {
+    bcdp->write_failed = false;
+    err = HAL_FAILED;
+  }
+
+  bcdp->state = BLK_READY;
+
+  return err;
+}
+
+/**
+ * @brief   Returns a media information structure.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ * @param[out] bdip     pointer to a @p BlockDeviceInfo structure
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool bcdGetInfo(CachedBlockDevice *bcdp, BlockDeviceInfo *bdip) {
+
+  osalDbgCheck((bcdp != NULL) && (bdip != NULL));
+
+  if (bcdp->state != BLK_READY) {
+    return HAL_FAILED;
+  }
+
+  return blkGetInfo(bcdp->config->blkp, bdip);
+}
+
+/**
+ * @brief   Invalidates the whole cache.
+ * @note    Dirty blocks are discarded, use @p bcdSync() before invalidating
+ *          if the data must be preserved.
+ *
+ * @param[in] bcdp      pointer to the @p CachedBlockDevice object
+ *
+ * @api
+ */
+void bcdInvalidate(CachedBlockDevice *bcdp) {
+  bcd_buffer_t *bp;
+  ucnt_t i;
+
+  osalDbgCheck(bcdp != NULL);
+  osalDbgAssert(bcdp->state != BLK_STOP, "invalid state");
+
+  bp = bcdp->config->bufp;
+  for (i = (ucnt_t)0; i < bcdp->config->bufn; i++, bp++) {
+    if ((bp->obj.obj_flags & OC_FLAG_INHASH) != 0U) {
+      oc_object_t *objp = chCacheGetObject(&bcdp->cache, BCD_GROUP,
+                                           bp->obj.obj_key);
+
+      objp->obj_flags &= ~OC_FLAG_LAZYWRITE;
+      objp->obj_flags |= OC_FLAG_NOTSYNC;
+      chCacheReleaseObject(&bcdp->cache, objp);
+    }
+  }
+}
+
+/** @} */
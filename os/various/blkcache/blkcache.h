@@ -0,0 +1,196 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkcache.h
+ * @brief   Cached block device structures and macros.
+ *
+ * @addtogroup blkcache
+ * @{
+ */
+
+#ifndef BLKCACHE_H
+#define BLKCACHE_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the cached blocks.
+ * @note    The wrapped device must have this block size, the connection
+ *          fails otherwise.
+ */
+#if !defined(BCD_BLOCK_SIZE) || defined(__DOXYGEN__)
+#define BCD_BLOCK_SIZE                      512U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_OBJ_CACHES != TRUE
+#error "the cached block device requires CH_CFG_USE_OBJ_CACHES"
+#endif
+
+#if BCD_BLOCK_SIZE == 0U
+#error "invalid BCD_BLOCK_SIZE value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a cache buffer.
+ * @note    The device configuration provides an array of these, buffers
+ *          are used as DMA targets so the array should be aligned
+ *          as required by the wrapped device.
+ */
+typedef struct {
+  /**
+   * @brief   Cached object header.
+   */
+  oc_object_t           obj;
+  /**
+   * @brief   Block data.
+   */
+  uint8_t               data[BCD_BLOCK_SIZE];
+} bcd_buffer_t;
+
+/**
+ * @brief   Cached block device configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Wrapped block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   Number of elements in the hash table, must be a power of two
+   *          and not lower than @p bufn.
+   */
+  ucnt_t                hashn;
+  /**
+   * @brief   Pointer to the hash table.
+   */
+  oc_hash_header_t      *hashp;
+  /**
+   * @brief   Number of cache buffers.
+   */
+  ucnt_t                bufn;
+  /**
+   * @brief   Pointer to the cache buffers array.
+   */
+  bcd_buffer_t          *bufp;
+  /**
+   * @brief   Coalescing buffer for multi-block writes or @p NULL.
+   * @note    Without this buffer each dirty block is written with a
+   *          single block operation.
+   */
+  uint8_t               *wbuf;
+  /**
+   * @brief   Size of the coalescing buffer in blocks.
+   */
+  uint32_t              wbufn;
+  /**
+   * @brief   Transfers of this number of blocks or more bypass the cache.
+   * @note    Zero disables the bypass.
+   */
+  uint32_t              bypassn;
+} CachedBlockDeviceConfig;
+
+/**
+ * @brief   @p CachedBlockDevice specific methods.
+ */
+#define _cached_block_device_methods                                        \
+  _base_block_device_methods
+
+/**
+ * @brief   @p CachedBlockDevice specific data.
+ */
+#define _cached_block_device_data                                           \
+  _base_block_device_data                                                   \
+  /* Current configuration data.*/                                          \
+  const CachedBlockDeviceConfig *config;                                    \
+  /* Blocks cache.*/                                                        \
+  objects_cache_t       cache;                                              \
+  /* A lazy write failed since the last synchronization.*/                  \
+  bool                  write_failed;
+
+/**
+ * @extends BaseBlockDeviceVMT
+ *
+ * @brief   @p CachedBlockDevice virtual methods table.
+ */
+struct CachedBlockDeviceVMT {
+  _cached_block_device_methods
+};
+
+/**
+ * @extends BaseBlockDevice
+ *
+ * @brief   Cached block device class.
+ * @details This class wraps another block device with a write-back blocks
+ *          cache, dirty blocks are written back coalesced in multi-block
+ *          writes on synchronization or when evicted.
+ * @note    Like the wrapped drivers, the device is not thread safe, it
+ *          must be accessed by one thread at time.
+ */
+typedef struct {
+  /** @brief Virtual Methods Table.*/
+  const struct CachedBlockDeviceVMT *vmt;
+  _cached_block_device_data
+} CachedBlockDevice;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void bcdObjectInit(CachedBlockDevice *bcdp);
+  void bcdStart(CachedBlockDevice *bcdp, const CachedBlockDeviceConfig *config);
+  void bcdStop(CachedBlockDevice *bcdp);
+  bool bcdConnect(CachedBlockDevice *bcdp);
+  bool bcdDisconnect(CachedBlockDevice *bcdp);
+  bool bcdRead(CachedBlockDevice *bcdp, uint32_t startblk,
+               uint8_t *buf, uint32_t n);
+  bool bcdWrite(CachedBlockDevice *bcdp, uint32_t startblk,
+                const uint8_t *buf, uint32_t n);
+  bool bcdSync(CachedBlockDevice *bcdp);
+  bool bcdGetInfo(CachedBlockDevice *bcdp, BlockDeviceInfo *bdip);
+  void bcdInvalidate(CachedBlockDevice *bcdp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* BLKCACHE_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Cached block device files.
+BCDSRC = $(CHIBIOS)/os/various/blkcache/blkcache.c
+
+BCDINC = $(CHIBIOS)/os/various/blkcache
+
+# Shared variables
+ALLCSRC += $(BCDSRC)
+ALLINC  += $(BCDINC)
@@ -0,0 +1,125 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    clkgov.c
+ * @brief   Clock governor code.
+ *
+ * @addtogroup clock_governor
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "clkgov.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a clock governor object.
+ *
+ * @param[out] cgp      pointer to the @p clk_governor_t object
+ *
+ * @init
+ */
+void clkgovObjectInit(clk_governor_t *cgp) {
+
+  chDbgCheck(cgp != NULL);
+
+  chSysLock();
+  cgp->last_time = chSysGetRealtimeCounterX();
+  cgp->last_idle = chSysGetIdleThreadX()->stats.cumulative;
+  chSysUnlock();
+  cgp->load      = 100U;
+}
+
+/**
+ * @brief   Measures the load and selects the clock level.
+ * @details The load is the fraction of time not spent in the idle thread
+ *          since the previous sample. Above the up threshold the highest
+ *          level is selected at once, below the down threshold the level
+ *          is lowered by one, levels requested by drivers are respected.
+ * @note    This function must be called periodically from a thread, the
+ *          period must be shorter than the realtime counter wrap time.
+ *
+ * @param[in] cgp       pointer to the @p clk_governor_t object
+ * @return              The selected clock level.
+ *
+ * @api
+ */
+unsigned clkgovSample(clk_governor_t *cgp) {
+  rtcnt_t now, elapsed;
+  rttime_t idle, idled;
+  unsigned level;
+
+  chDbgCheck(cgp != NULL);
+
+  chSysLock();
+
+  /* The idle thread is not running, its time is up to date.*/
+  now  = chSysGetRealtimeCounterX();
+  idle = chSysGetIdleThreadX()->stats.cumulative;
+
+  elapsed = now - cgp->last_time;
+  idled   = idle - cgp->last_idle;
+  cgp->last_time = now;
+  cgp->last_idle = idle;
+
+  if ((elapsed == (rtcnt_t)0) || (idled >= (rttime_t)elapsed)) {
+    cgp->load = 0U;
+  }
+  else {
+    cgp->load = 100U - (unsigned)((idled * 100U) / (rttime_t)elapsed);
+  }
+
+  level = halClockGetLevelX();
+  if (cgp->load > (unsigned)CLKGOV_CFG_UP_THRESHOLD) {
+    level = HAL_CLOCK_LEVEL_MAX;
+  }
+  else if ((cgp->load < (unsigned)CLKGOV_CFG_DOWN_THRESHOLD) &&
+           (level > 0U)) {
+    level--;
+  }
+  level = halClockSetLevelS(level);
+
+  chSysUnlock();
+
+  return level;
+}
+
+/** @} */
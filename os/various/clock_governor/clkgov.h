@@ -0,0 +1,132 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    clkgov.h
+ * @brief   Clock governor structures and macros.
+ *
+ * @addtogroup clock_governor
+ * @{
+ */
+
+#ifndef CLKGOV_H
+#define CLKGOV_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Load percentage above which the highest level is selected.
+ */
+#if !defined(CLKGOV_CFG_UP_THRESHOLD) || defined(__DOXYGEN__)
+#define CLKGOV_CFG_UP_THRESHOLD             80
+#endif
+
+/**
+ * @brief   Load percentage below which the level is lowered by one.
+ */
+#if !defined(CLKGOV_CFG_DOWN_THRESHOLD) || defined(__DOXYGEN__)
+#define CLKGOV_CFG_DOWN_THRESHOLD           30
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_DBG_STATISTICS != TRUE
+#error "clock governor requires CH_DBG_STATISTICS"
+#endif
+
+#if CH_CFG_NO_IDLE_THREAD != FALSE
+#error "clock governor requires the idle thread"
+#endif
+
+#if HAL_USE_CLOCK_SCALING != TRUE
+#error "clock governor requires HAL_USE_CLOCK_SCALING"
+#endif
+
+#if (CLKGOV_CFG_DOWN_THRESHOLD < 0) ||                                      \
+    (CLKGOV_CFG_DOWN_THRESHOLD >= CLKGOV_CFG_UP_THRESHOLD) ||               \
+    (CLKGOV_CFG_UP_THRESHOLD > 100)
+#error "invalid clock governor thresholds"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a clock governor object.
+ */
+typedef struct {
+  /**
+   * @brief   Realtime counter at the last sample.
+   */
+  rtcnt_t                   last_time;
+  /**
+   * @brief   Idle thread cumulative time at the last sample.
+   */
+  rttime_t                  last_idle;
+  /**
+   * @brief   Load percentage measured by the last sample.
+   */
+  unsigned                  load;
+} clk_governor_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the load percentage measured by the last sample.
+ *
+ * @param[in] cgp       pointer to the @p clk_governor_t object
+ * @return              The load percentage.
+ *
+ * @xclass
+ */
+#define clkgovGetLoadX(cgp) ((cgp)->load)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void clkgovObjectInit(clk_governor_t *cgp);
+  unsigned clkgovSample(clk_governor_t *cgp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* CLKGOV_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Clock governor files.
+CLKGOVSRC = $(CHIBIOS)/os/various/clock_governor/clkgov.c
+
+CLKGOVINC = $(CHIBIOS)/os/various/clock_governor
+
+# Shared variables
+ALLCSRC += $(CLKGOVSRC)
+ALLINC  += $(CLKGOVINC)
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <new>
+
 #include <ch.h>
 
 #ifndef _CH_HPP_
@@ -1470,12 +1472,13 @@ namespace chibios_rt {
   public:
     /**
      * @brief   Threads queue constructor.
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
      *
      * @init
      */
-    ThreadsQueue() {
-
-      chThdQueueObjectInit(&threads_queue);
+    constexpr ThreadsQueue() :
+      threads_queue{{&threads_queue.queue, &threads_queue.queue}} {
     }
 
     /* Prohibit copy construction and assignment.*/
@@ -1553,14 +1556,16 @@ namespace chibios_rt {
      * @brief   CounterSemaphore constructor.
      * @details The embedded @p Semaphore structure is initialized.
      *
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
+     *
      * @param[in] n             the semaphore counter value, must be greater
      *                          or equal to zero
      *
      * @init
      */
-    CounterSemaphore(cnt_t n) {
-
-      chSemObjectInit(&sem, n);
+    constexpr CounterSemaphore(cnt_t n) :
+      sem{{&sem.queue, &sem.queue}, n} {
     }
 
     /**
@@ -1784,12 +1789,14 @@ namespace chibios_rt {
      *                      - @a false, the initial state is not taken.
      *                      - @a true, the initial state is taken.
      *                      .
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
      *
      * @init
      */
-    BinarySemaphore(bool taken) {
-
-      chBSemObjectInit(&bsem, taken);
+    constexpr BinarySemaphore(bool taken) :
+      bsem{{{&bsem.sem.queue, &bsem.sem.queue},
+            taken ? (cnt_t)0 : (cnt_t)1}} {
     }
 
     /**
@@ -1965,12 +1972,17 @@ namespace chibios_rt {
     /**
      * @brief   Mutex object constructor.
      * @details The embedded @p mutex_t structure is initialized.
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
      *
      * @init
      */
-    Mutex(void) {
-
-      chMtxObjectInit(&mutex);
+    constexpr Mutex(void) :
+#if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
+      mutex{{&mutex.queue, &mutex.queue}, nullptr, nullptr, (cnt_t)0} {
+#else
+      mutex{{&mutex.queue, &mutex.queue}, nullptr, nullptr} {
+#endif
     }
 
     /**
@@ -2468,6 +2480,8 @@ namespace chibios_rt {
    /**
      * @brief   Mailbox constructor.
      * @details The embedded @p mailbox_t structure is initialized.
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
      *
      * @param[in] buf       pointer to the messages buffer as an array of
      *                      @p msg_t
@@ -2475,9 +2489,10 @@ namespace chibios_rt {
      *
      * @init
      */
-    MailboxBase(msg_t *buf, cnt_t n) {
-
-      chMBObjectInit(&mb, buf, n);
+    constexpr MailboxBase(msg_t *buf, cnt_t n) :
+      mb{buf, buf + n, buf, buf, (size_t)0, false,
+         {{&mb.qw.queue, &mb.qw.queue}},
+         {{&mb.qr.queue, &mb.qr.queue}}} {
     }
 
     /**
@@ -2764,11 +2779,14 @@ namespace chibios_rt {
   public:
     /**
      * @brief   Mailbox constructor.
+     * @note    The constructor is @p constexpr, objects with static storage
+     *          are initialized at compile time.
      *
      * @init
      */
-    Mailbox(void) :
-      MailboxBase<T>(mb_buf, (cnt_t)(sizeof mb_buf / sizeof (msg_t))) {
+    constexpr Mailbox(void) :
+      MailboxBase<T>(mb_buf, (cnt_t)(sizeof mb_buf / sizeof (msg_t))),
+      mb_buf{} {
     }
   };
 #endif /* CH_CFG_USE_MAILBOXES == TRUE */
@@ -3060,6 +3078,556 @@ namespace chibios_rt {
   };
 #endif /* CH_CFG_USE_MEMPOOLS == TRUE */
 
+#if (CH_CFG_USE_OBJ_FIFOS == TRUE) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::Channel                                                    *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Template class encapsulating an objects FIFO and its buffers.
+   * @details Objects are exchanged by pointer, the producer builds them in
+   *          place into a free slot and the consumer returns the slot after
+   *          use, no copies are performed.
+   *
+   * @param T               type of the exchanged objects
+   * @param N               number of objects
+   */
+  template <typename T, size_t N>
+  class Channel {
+
+    static_assert(N > 0U, "invalid number of objects");
+
+    /**
+     * @brief   Alignment of the objects slots.
+     */
+    static constexpr size_t objalign =
+      alignof (T) > PORT_NATURAL_ALIGN ? alignof (T) : PORT_NATURAL_ALIGN;
+
+    /**
+     * @brief   Size of the objects slots, a multiple of the alignment.
+     */
+    static constexpr size_t objsize =
+      ((sizeof (T) + objalign - 1U) / objalign) * objalign;
+
+    /**
+     * @brief   Embedded @p objects_fifo_t structure.
+     */
+    objects_fifo_t fifo;
+
+    /**
+     * @brief   Objects slots.
+     */
+    alignas(objalign) uint8_t obj_buf[N * objsize];
+
+    /**
+     * @brief   Messages buffer.
+     */
+    msg_t msg_buf[N];
+
+  public:
+    /**
+     * @brief   Channel constructor.
+     *
+     * @init
+     */
+    Channel(void) {
+
+      chFifoObjectInitAligned(&fifo, objsize, N, (unsigned)objalign,
+                              obj_buf, msg_buf);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+
+    /**
+     * @brief   Allocates a free slot.
+     * @note    The returned slot is raw memory, no constructor is invoked.
+     *
+     * @return              The pointer to the allocated slot.
+     * @retval nullptr      if a slot is not immediately available.
+     *
+     * @iclass
+     */
+    T *takeI(void) {
+
+      return static_cast<T *>(chFifoTakeObjectI(&fifo));
+    }
+
+    /**
+     * @brief   Allocates a free slot.
+     * @note    The returned slot is raw memory, no constructor is invoked.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The pointer to the allocated slot.
+     * @retval nullptr      if the operation timed out.
+     *
+     * @api
+     */
+    T *take(sysinterval_t timeout) {
+
+      return static_cast<T *>(chFifoTakeObjectTimeout(&fifo, timeout));
+    }
+
+    /**
+     * @brief   Allocates a free slot and constructs an object in place.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @param[in] args      arguments for the @p T constructor
+     * @return              The pointer to the constructed object.
+     * @retval nullptr      if the operation timed out.
+     *
+     * @api
+     */
+    template <typename... Args>
+    T *emplace(sysinterval_t timeout, Args&&... args) {
+      void *p = chFifoTakeObjectTimeout(&fifo, timeout);
+
+      if (p == nullptr) {
+        return nullptr;
+      }
+      return new (p) T(static_cast<Args&&>(args)...);
+    }
+
+    /**
+     * @brief   Releases a slot without destroying its content.
+     *
+     * @param[in] objp      pointer to the slot to be released
+     *
+     * @iclass
+     */
+    void returnObjectI(T *objp) {
+
+      chFifoReturnObjectI(&fifo, objp);
+    }
+
+    /**
+     * @brief   Releases a slot without destroying its content.
+     *
+     * @param[in] objp      pointer to the slot to be released
+     *
+     * @api
+     */
+    void returnObject(T *objp) {
+
+      chFifoReturnObject(&fifo, objp);
+    }
+
+    /**
+     * @brief   Destroys an object and releases its slot.
+     *
+     * @param[in] objp      pointer to the object to be destroyed
+     *
+     * @api
+     */
+    void destroy(T *objp) {
+
+      objp->~T();
+      chFifoReturnObject(&fifo, objp);
+    }
+
+    /**
+     * @brief   Posts an object.
+     * @note    By design the object can be always immediately posted.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @iclass
+     */
+    void sendI(T *objp) {
+
+      chFifoSendObjectI(&fifo, objp);
+    }
+
+    /**
+     * @brief   Posts an object.
+     * @note    By design the object can be always immediately posted.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @sclass
+     */
+    void sendS(T *objp) {
+
+      chFifoSendObjectS(&fifo, objp);
+    }
+
+    /**
+     * @brief   Posts an object.
+     * @note    By design the object can be always immediately posted.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @api
+     */
+    void send(T *objp) {
+
+      chFifoSendObject(&fifo, objp);
+    }
+
+    /**
+     * @brief   Posts an high priority object.
+     * @note    By design the object can be always immediately posted.
+     *
+     * @param[in] objp      pointer to the object to be posted
+     *
+     * @api
+     */
+    void sendAhead(T *objp) {
+
+      chFifoSendObjectAhead(&fifo, objp);
+    }
+
+    /**
+     * @brief   Posts multiple objects.
+     * @details All objects are posted within the same critical zone.
+     *
+     * @param[in] objpp     pointer to an array of pointers to the objects
+     * @param[in] n         number of objects to be posted
+     *
+     * @api
+     */
+    void send(T * const *objpp, size_t n) {
+
+      chFifoSendObjects(&fifo, reinterpret_cast<void * const *>(objpp), n);
+    }
+
+    /**
+     * @brief   Posts an array of objects.
+     * @details All objects are posted within the same critical zone.
+     *
+     * @param[in] objs      array of pointers to the objects
+     *
+     * @api
+     */
+    template <size_t M>
+    void send(T * const (&objs)[M]) {
+
+      send(objs, M);
+    }
+
+    /**
+     * @brief   Fetches an object.
+     *
+     * @param[out] objp     reference to the fetched object pointer
+     * @return              The operation status.
+     * @retval MSG_OK       if an object has been correctly fetched.
+     * @retval MSG_TIMEOUT  if the FIFO is empty.
+     *
+     * @iclass
+     */
+    msg_t receiveI(T *&objp) {
+
+      return chFifoReceiveObjectI(&fifo, reinterpret_cast<void **>(&objp));
+    }
+
+    /**
+     * @brief   Fetches an object.
+     *
+     * @param[out] objp     reference to the fetched object pointer
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The operation status.
+     * @retval MSG_OK       if an object has been correctly fetched.
+     * @retval MSG_TIMEOUT  if the operation has timed out.
+     *
+     * @api
+     */
+    msg_t receive(T *&objp, sysinterval_t timeout) {
+
+      return chFifoReceiveObjectTimeout(&fifo,
+                                        reinterpret_cast<void **>(&objp),
+                                        timeout);
+    }
+
+    /**
+     * @brief   Fetches multiple objects.
+     * @details The function waits for the first object then fetches, without
+     *          waiting, up to @p n objects within the same critical zone.
+     *
+     * @param[out] objpp    pointer to an array of fetched object pointers
+     * @param[in] n         maximum number of objects to be fetched, it
+     *                      cannot be zero
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of fetched objects, zero if the
+     *                      operation has timed out.
+     *
+     * @api
+     */
+    size_t receive(T **objpp, size_t n, sysinterval_t timeout) {
+
+      return chFifoReceiveObjectsTimeout(&fifo,
+                                         reinterpret_cast<void **>(objpp),
+                                         n, timeout);
+    }
+
+    /**
+     * @brief   Fetches objects into an array.
+     * @details The function waits for the first object then fetches, without
+     *          waiting, up to @p M objects within the same critical zone.
+     *
+     * @param[out] objs     array of fetched object pointers
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of fetched objects, zero if the
+     *                      operation has timed out.
+     *
+     * @api
+     */
+    template <size_t M>
+    size_t receive(T *(&objs)[M], sysinterval_t timeout) {
+
+      return receive(objs, M, timeout);
+    }
+  };
+#endif /* CH_CFG_USE_OBJ_FIFOS == TRUE */
+
+#if (CH_CFG_USE_PIPES == TRUE) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::Pipe                                                       *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Template class encapsulating a pipe and its buffer.
+   *
+   * @param N               size of the pipe buffer in bytes
+   */
+  template <size_t N>
+  class Pipe {
+
+    static_assert(N > 0U, "invalid pipe size");
+
+    /**
+     * @brief   Embedded @p pipe_t structure.
+     */
+    pipe_t pipe;
+
+    /**
+     * @brief   Pipe buffer.
+     */
+    uint8_t pipe_buf[N];
+
+  public:
+    /**
+     * @brief   Pipe constructor.
+     *
+     * @param[in] spsc      @p true for the single producer and single
+     *                      consumer mode
+     *
+     * @init
+     */
+    Pipe(bool spsc=false) {
+
+      if (spsc) {
+        chPipeObjectInitSPSC(&pipe, pipe_buf, N);
+      }
+      else {
+        chPipeObjectInit(&pipe, pipe_buf, N);
+      }
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    Pipe(const Pipe &) = delete;
+    Pipe &operator=(const Pipe &) = delete;
+
+    /**
+     * @brief   Resets the pipe.
+     * @details All the waiting threads are resumed with status @p MSG_RESET
+     *          and the queued data is lost.
+     *
+     * @api
+     */
+    void reset(void) {
+
+      chPipeReset(&pipe);
+    }
+
+    /**
+     * @brief   Terminates the reset state.
+     *
+     * @api
+     */
+    void resume(void) {
+
+      chPipeResume(&pipe);
+    }
+
+    /**
+     * @brief   Returns the number of used byte slots.
+     *
+     * @api
+     */
+    size_t getUsedCount(void) const {
+
+      return chPipeGetUsedCount(&pipe);
+    }
+
+    /**
+     * @brief   Returns the number of free byte slots.
+     *
+     * @api
+     */
+    size_t getFreeCount(void) const {
+
+      return chPipeGetFreeCount(&pipe);
+    }
+
+    /**
+     * @brief   Pipe write.
+     *
+     * @param[in] bp        pointer to the data buffer
+     * @param[in] n         the number of bytes to be written
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of bytes effectively transferred.
+     *
+     * @api
+     */
+    size_t write(const uint8_t *bp, size_t n, sysinterval_t timeout) {
+
+      return chPipeWriteTimeout(&pipe, bp, n, timeout);
+    }
+
+    /**
+     * @brief   Pipe write of a whole array.
+     *
+     * @param[in] buf       the data array
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of bytes effectively transferred.
+     *
+     * @api
+     */
+    template <size_t M>
+    size_t write(const uint8_t (&buf)[M], sysinterval_t timeout) {
+
+      return chPipeWriteTimeout(&pipe, buf, M, timeout);
+    }
+
+    /**
+     * @brief   Pipe read.
+     *
+     * @param[out] bp       pointer to the data buffer
+     * @param[in] n         the number of bytes to be read
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of bytes effectively transferred.
+     *
+     * @api
+     */
+    size_t read(uint8_t *bp, size_t n, sysinterval_t timeout) {
+
+      return chPipeReadTimeout(&pipe, bp, n, timeout);
+    }
+
+    /**
+     * @brief   Pipe read filling a whole array.
+     *
+     * @param[out] buf      the data array
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of bytes effectively transferred.
+     *
+     * @api
+     */
+    template <size_t M>
+    size_t read(uint8_t (&buf)[M], sysinterval_t timeout) {
+
+      return chPipeReadTimeout(&pipe, buf, M, timeout);
+    }
+
+    /**
+     * @brief   Leases a buffer area for writing in place.
+     *
+     * @param[out] bp       reference to the leased area pointer
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of contiguous bytes available for
+     *                      writing, zero on timeout or reset.
+     *
+     * @api
+     */
+    size_t writeAcquire(uint8_t *&bp, sysinterval_t timeout) {
+
+      return chPipeWriteAcquireTimeout(&pipe, &bp, timeout);
+    }
+
+    /**
+     * @brief   Commits bytes written in the leased area.
+     *
+     * @param[in] n         number of bytes written in the leased area
+     *
+     * @api
+     */
+    void writeCommit(size_t n) {
+
+      chPipeWriteCommit(&pipe, n);
+    }
+
+    /**
+     * @brief   Leases a buffer area for reading in place.
+     *
+     * @param[out] bp       reference to the leased area pointer
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The number of contiguous bytes available for
+     *                      reading, zero on timeout or reset.
+     *
+     * @api
+     */
+    size_t readAcquire(const uint8_t *&bp, sysinterval_t timeout) {
+
+      return chPipeReadAcquireTimeout(&pipe, &bp, timeout);
+    }
+
+    /**
+     * @brief   Releases bytes consumed from the leased area.
+     *
+     * @param[in] n         number of bytes consumed from the leased area
+     *
+     * @api
+     */
+    void readRelease(size_t n) {
+
+      chPipeReadRelease(&pipe, n);
+    }
+  };
+#endif /* CH_CFG_USE_PIPES == TRUE */
+
   /*------------------------------------------------------------------------*
    * chibios_rt::BaseSequentialStreamInterface                              *
    *------------------------------------------------------------------------*/
@@ -0,0 +1,1411 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    chcoro.hpp
+ * @brief   C++20 coroutines classes and definitions.
+ * @details Coroutines are run by executors, an executor is a jobs queue
+ *          dispatched by one or more threads. A suspended coroutine uses
+ *          no stack, when the awaited condition occurs its resumption is
+ *          posted as a job, from thread or ISR context.
+ * @note    Kernel semaphores, mailboxes and event sources can only wake
+ *          threads, the asynchronous objects defined here are their
+ *          equivalents for coroutines. They can be signaled from threads
+ *          and ISRs.
+ *
+ * @addtogroup cpp_library
+ * @{
+ */
+
+#include <coroutine>
+#include <new>
+
+#include "ch.hpp"
+
+#ifndef _CHCORO_HPP_
+#define _CHCORO_HPP_
+
+#if !defined(__cpp_impl_coroutine)
+#error "chcoro.hpp requires C++20 coroutines"
+#endif
+
+#if CH_CFG_USE_JOBS != TRUE
+#error "chcoro.hpp requires CH_CFG_USE_JOBS"
+#endif
+
+namespace chibios_rt {
+
+  /* Forward declaration of some classes.*/
+  class ExecutorBase;
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::Task                                                       *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Return type of the coroutines run by executors.
+   * @details A coroutine returning @p Task starts suspended, it runs once
+   *          spawned on an executor and its frame is released when it
+   *          returns.
+   * @note    Frames are allocated using the non-throwing @p new operator, a
+   *          failed allocation returns an empty task.
+   */
+  class Task {
+  public:
+    /**
+     * @brief   Coroutine promise.
+     */
+    struct promise_type {
+      /**
+       * @brief   Executor running the coroutine.
+       */
+      ExecutorBase *executor = nullptr;
+
+      Task get_return_object(void) noexcept {
+
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      static Task get_return_object_on_allocation_failure(void) noexcept {
+
+        return Task();
+      }
+
+      std::suspend_always initial_suspend(void) noexcept {
+
+        return {};
+      }
+
+      std::suspend_never final_suspend(void) noexcept {
+
+        return {};
+      }
+
+      void return_void(void) noexcept {
+      }
+
+      void unhandled_exception(void) noexcept {
+
+        chSysHalt("unhandled exception");
+      }
+    };
+
+    /**
+     * @brief   Type of a handle to a task coroutine.
+     */
+    typedef std::coroutine_handle<promise_type> handle_t;
+
+  private:
+    friend class ExecutorBase;
+
+    /**
+     * @brief   Coroutine handle, empty once spawned.
+     */
+    handle_t handle;
+
+    explicit Task(handle_t h) noexcept : handle(h) {
+    }
+
+  public:
+    /**
+     * @brief   Empty task constructor.
+     */
+    Task(void) noexcept : handle(nullptr) {
+    }
+
+    Task(Task &&other) noexcept : handle(other.handle) {
+
+      other.handle = nullptr;
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    /**
+     * @brief   Task destructor.
+     * @details A coroutine never spawned is destroyed.
+     */
+    ~Task() {
+
+      if (handle) {
+        handle.destroy();
+      }
+    }
+
+    /**
+     * @brief   Checks if the task holds a coroutine.
+     *
+     * @return              The task state.
+     * @retval false        if the coroutine frame allocation failed or the
+     *                      task has been spawned.
+     */
+    bool isValid(void) const noexcept {
+
+      return (bool)handle;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::ExecutorBase                                               *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Base class of the coroutines executors.
+   * @details Each resumption of a coroutine is a job of the executor
+   *          queue, the queue is dispatched by one or more threads.
+   */
+  class ExecutorBase {
+
+    /**
+     * @brief   Job resuming a coroutine.
+     */
+    static void resume_job(void *arg) {
+
+      std::coroutine_handle<>::from_address(arg).resume();
+    }
+
+  protected:
+    /**
+     * @brief   Embedded @p jobs_queue_t structure.
+     */
+    jobs_queue_t jobs;
+
+    /**
+     * @brief   ExecutorBase constructor.
+     *
+     * @param[in] n         number of jobs, the maximum number of tasks
+     *                      running or spawned at the same time
+     * @param[in] jobsbuf   pointer to the jobs buffer
+     * @param[in] msgbuf    pointer to the messages buffer
+     *
+     * @init
+     */
+    ExecutorBase(size_t n, job_descriptor_t *jobsbuf, msg_t *msgbuf) {
+
+      chJobObjectInit(&jobs, n, jobsbuf, msgbuf);
+    }
+
+  public:
+    /* Prohibit copy construction and assignment.*/
+    ExecutorBase(const ExecutorBase &) = delete;
+    ExecutorBase &operator=(const ExecutorBase &) = delete;
+
+    /**
+     * @brief   Posts the resumption of a suspended coroutine.
+     * @note    A suspended coroutine has at most one resumption posted,
+     *          a job is always available if the number of tasks does not
+     *          exceed the number of jobs.
+     *
+     * @param[in] h         handle of the coroutine
+     *
+     * @iclass
+     */
+    static void resumeI(Task::handle_t h) {
+      ExecutorBase *ep = h.promise().executor;
+      job_descriptor_t *jp;
+
+      chDbgCheckClassI();
+
+      jp = chJobGetI(&ep->jobs);
+      chDbgAssert(jp != NULL, "too many tasks");
+
+      jp->jobfunc = resume_job;
+      jp->jobarg  = h.address();
+      chJobPostI(&ep->jobs, jp);
+    }
+
+    /**
+     * @brief   Spawns a task on the executor.
+     * @details The coroutine first runs in one of the dispatching threads.
+     *
+     * @param[in] task      the task to be spawned
+     * @return              The operation status.
+     * @retval false        if the task is empty.
+     *
+     * @api
+     */
+    bool spawn(Task &&task) {
+      Task::handle_t h = task.handle;
+
+      if (!h) {
+        return false;
+      }
+      task.handle = nullptr;
+      h.promise().executor = this;
+
+      chSysLock();
+      resumeI(h);
+      chSchRescheduleS();
+      chSysUnlock();
+
+      return true;
+    }
+
+    /**
+     * @brief   Runs the next coroutine.
+     * @details Waits for a coroutine to be resumed then runs it until its
+     *          next suspension point.
+     *
+     * @return              The operation status.
+     * @retval MSG_OK       if a coroutine has been run.
+     * @retval MSG_JOB_NULL if the executor has been stopped.
+     *
+     * @api
+     */
+    msg_t dispatch(void) {
+
+      return chJobDispatch(&jobs);
+    }
+
+    /**
+     * @brief   Runs the next coroutine with timeout.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              The operation status.
+     * @retval MSG_OK       if a coroutine has been run.
+     * @retval MSG_TIMEOUT  if no coroutine has been resumed in time.
+     * @retval MSG_JOB_NULL if the executor has been stopped.
+     *
+     * @api
+     */
+    msg_t dispatchTimeout(sysinterval_t timeout) {
+
+      return chJobDispatchTimeout(&jobs, timeout);
+    }
+
+    /**
+     * @brief   Runs coroutines until the executor is stopped.
+     *
+     * @api
+     */
+    void run(void) {
+
+      while (chJobDispatch(&jobs) != MSG_JOB_NULL) {
+      }
+    }
+
+    /**
+     * @brief   Stops one of the threads running the executor.
+     * @note    Suspended coroutines are not destroyed.
+     *
+     * @api
+     */
+    void stop(void) {
+      job_descriptor_t *jp = chJobGet(&jobs);
+
+      jp->jobfunc = NULL;
+      jp->jobarg  = NULL;
+      chJobPost(&jobs, jp);
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::Executor                                                   *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Template class encapsulating an executor and its buffers.
+   *
+   * @param N               number of jobs, the maximum number of tasks
+   *                        running or spawned at the same time
+   */
+  template <size_t N>
+  class Executor : public ExecutorBase {
+
+    static_assert(N > 0U, "invalid number of jobs");
+
+    /**
+     * @brief   Jobs buffer.
+     */
+    job_descriptor_t jobs_buf[N];
+
+    /**
+     * @brief   Messages buffer.
+     */
+    msg_t msg_buf[N];
+
+  public:
+    /**
+     * @brief   Executor constructor.
+     *
+     * @init
+     */
+    Executor(void) : ExecutorBase(N, jobs_buf, msg_buf) {
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncWaiter                                                *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Base class of the awaiters waiting in a queue.
+   * @details The awaiter lives in the coroutine frame while the coroutine
+   *          is suspended, it is queued on the awaited object and, if a
+   *          timeout is specified, a virtual timer is armed.
+   */
+  class AsyncWaiter {
+  protected:
+    /**
+     * @brief   Queue element, @p next is @p NULL when not queued.
+     */
+    ch_queue_t link;
+
+    /**
+     * @brief   Suspended coroutine.
+     */
+    Task::handle_t handle;
+
+    /**
+     * @brief   Timeout virtual timer.
+     */
+    virtual_timer_t vt;
+
+    /**
+     * @brief   Wait timeout.
+     */
+    sysinterval_t timeout;
+
+    /**
+     * @brief   Wakeup message.
+     */
+    msg_t msg;
+
+    /**
+     * @brief   Timeout callback.
+     * @note    Virtual timers callbacks run outside the critical zone, the
+     *          awaiter may have been woken in the meantime.
+     */
+    static void timeout_cb(void *p) {
+      AsyncWaiter *wp = static_cast<AsyncWaiter *>(p);
+
+      chSysLockFromISR();
+      if (wp->link.next != NULL) {
+        wp->wakeupI(MSG_TIMEOUT);
+      }
+      chSysUnlockFromISR();
+    }
+
+    /**
+     * @brief   AsyncWaiter constructor.
+     *
+     * @param[in] timeout   the number of ticks before the wait timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     */
+    explicit AsyncWaiter(sysinterval_t timeout) noexcept :
+      handle(nullptr), timeout(timeout), msg(MSG_OK) {
+
+      link.next = NULL;
+      link.prev = NULL;
+      chVTObjectInit(&vt);
+    }
+
+    /**
+     * @brief   Queues the awaiter.
+     *
+     * @param[in] qp        pointer to the queue header
+     * @param[in] h         handle of the coroutine
+     * @return              The suspension state.
+     * @retval false        if the timeout is @p TIME_IMMEDIATE, the awaiter
+     *                      is not queued and the message is @p MSG_TIMEOUT.
+     *
+     * @sclass
+     */
+    bool suspendS(ch_queue_t *qp, Task::handle_t h) {
+
+      if (timeout == TIME_IMMEDIATE) {
+        msg = MSG_TIMEOUT;
+        return false;
+      }
+
+      handle = h;
+      ch_queue_insert(&link, qp);
+      if (timeout != TIME_INFINITE) {
+        chVTSetI(&vt, timeout, timeout_cb, this);
+      }
+
+      return true;
+    }
+
+  public:
+    /* Prohibit copy construction and assignment.*/
+    AsyncWaiter(const AsyncWaiter &) = delete;
+    AsyncWaiter &operator=(const AsyncWaiter &) = delete;
+
+    /**
+     * @brief   Returns the awaiter of a queue element.
+     *
+     * @param[in] p         pointer to the queue element
+     * @return              The awaiter.
+     */
+    static AsyncWaiter *fromLink(ch_queue_t *p) noexcept {
+
+      return reinterpret_cast<AsyncWaiter *>(p);
+    }
+
+    /**
+     * @brief   Dequeues the awaiter and resumes its coroutine.
+     *
+     * @param[in] m         wakeup message
+     *
+     * @iclass
+     */
+    void wakeupI(msg_t m) {
+
+      (void) ch_queue_dequeue(&link);
+      link.next = NULL;
+      chVTResetI(&vt);
+      msg = m;
+      ExecutorBase::resumeI(handle);
+    }
+
+    /**
+     * @brief   Wakes all the awaiters in a queue.
+     *
+     * @param[in] qp        pointer to the queue header
+     * @param[in] m         wakeup message
+     *
+     * @iclass
+     */
+    static void wakeupAllI(ch_queue_t *qp, msg_t m) {
+
+      while (ch_queue_notempty(qp)) {
+        fromLink(qp->next)->wakeupI(m);
+      }
+    }
+
+    bool await_ready(void) const noexcept {
+
+      return false;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncSleep                                                 *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Awaiter suspending a coroutine for an interval.
+   * @details A zero interval yields to the other coroutines of the
+   *          executor.
+   */
+  class AsyncSleep {
+
+    /**
+     * @brief   Sleep virtual timer.
+     */
+    virtual_timer_t vt;
+
+    /**
+     * @brief   Sleep interval.
+     */
+    sysinterval_t interval;
+
+    /**
+     * @brief   Suspended coroutine.
+     */
+    Task::handle_t handle;
+
+    static void wakeup_cb(void *p) {
+      AsyncSleep *sp = static_cast<AsyncSleep *>(p);
+
+      chSysLockFromISR();
+      ExecutorBase::resumeI(sp->handle);
+      chSysUnlockFromISR();
+    }
+
+  public:
+    /**
+     * @brief   AsyncSleep constructor.
+     *
+     * @param[in] interval  the number of ticks to sleep, @p TIME_INFINITE
+     *                      is not allowed
+     */
+    explicit AsyncSleep(sysinterval_t interval) noexcept :
+      interval(interval), handle(nullptr) {
+
+      chDbgCheck(interval != TIME_INFINITE);
+
+      chVTObjectInit(&vt);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    AsyncSleep(const AsyncSleep &) = delete;
+    AsyncSleep &operator=(const AsyncSleep &) = delete;
+
+    bool await_ready(void) const noexcept {
+
+      return false;
+    }
+
+    void await_suspend(Task::handle_t h) {
+
+      handle = h;
+      chSysLock();
+      if (interval == TIME_IMMEDIATE) {
+        ExecutorBase::resumeI(h);
+      }
+      else {
+        chVTSetI(&vt, interval, wakeup_cb, this);
+      }
+      chSysUnlock();
+    }
+
+    void await_resume(void) const noexcept {
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncSemaphore                                             *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Counter semaphore awaited by coroutines.
+   */
+  class AsyncSemaphore {
+
+    /**
+     * @brief   Waiting coroutines.
+     */
+    ch_queue_t queue;
+
+    /**
+     * @brief   Semaphore counter.
+     */
+    cnt_t cnt;
+
+  public:
+    /**
+     * @brief   Awaiter of a semaphore wait.
+     */
+    class Awaiter : public AsyncWaiter {
+      AsyncSemaphore *sp;
+
+    public:
+      Awaiter(AsyncSemaphore *sp, sysinterval_t timeout) noexcept :
+        AsyncWaiter(timeout), sp(sp) {
+      }
+
+      bool await_suspend(Task::handle_t h) {
+        bool suspended = false;
+
+        chSysLock();
+        if (sp->cnt > (cnt_t)0) {
+          sp->cnt--;
+        }
+        else {
+          suspended = suspendS(&sp->queue, h);
+        }
+        chSysUnlock();
+
+        return suspended;
+      }
+
+      /**
+       * @return            The wait result.
+       * @retval MSG_OK     if the semaphore has been signaled.
+       * @retval MSG_TIMEOUT if the wait timed out.
+       * @retval MSG_RESET  if the semaphore has been reset.
+       */
+      msg_t await_resume(void) const noexcept {
+
+        return msg;
+      }
+    };
+
+    /**
+     * @brief   AsyncSemaphore constructor.
+     *
+     * @param[in] n         initial value of the semaphore counter, must be
+     *                      non-negative
+     *
+     * @init
+     */
+    explicit AsyncSemaphore(cnt_t n) noexcept : cnt(n) {
+
+      chDbgCheck(n >= (cnt_t)0);
+
+      ch_queue_init(&queue);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    AsyncSemaphore(const AsyncSemaphore &) = delete;
+    AsyncSemaphore &operator=(const AsyncSemaphore &) = delete;
+
+    /**
+     * @brief   Waits on the semaphore.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              An awaiter returning the wait result.
+     *
+     * @api
+     */
+    Awaiter wait(sysinterval_t timeout = TIME_INFINITE) noexcept {
+
+      return Awaiter(this, timeout);
+    }
+
+    /**
+     * @brief   Signals the semaphore.
+     * @details The first waiting coroutine, if any, is resumed.
+     *
+     * @iclass
+     */
+    void signalI(void) {
+
+      chDbgCheckClassI();
+
+      if (ch_queue_notempty(&queue)) {
+        AsyncWaiter::fromLink(queue.next)->wakeupI(MSG_OK);
+      }
+      else {
+        cnt++;
+      }
+    }
+
+    /**
+     * @brief   Signals the semaphore.
+     *
+     * @api
+     */
+    void signal(void) {
+
+      chSysLock();
+      signalI();
+      chSchRescheduleS();
+      chSysUnlock();
+    }
+
+    /**
+     * @brief   Resets the semaphore.
+     * @details The waiting coroutines are resumed with @p MSG_RESET.
+     *
+     * @param[in] n         the new value of the semaphore counter, must be
+     *                      non-negative
+     *
+     * @iclass
+     */
+    void resetI(cnt_t n) {
+
+      chDbgCheckClassI();
+      chDbgCheck(n >= (cnt_t)0);
+
+      cnt = n;
+      AsyncWaiter::wakeupAllI(&queue, MSG_RESET);
+    }
+
+    /**
+     * @brief   Returns the semaphore counter.
+     *
+     * @return              The semaphore counter.
+     *
+     * @iclass
+     */
+    cnt_t getCounterI(void) const {
+
+      chDbgCheckClassI();
+
+      return cnt;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncEventFlags                                            *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Event flags awaited by coroutines.
+   * @details Broadcast flags are delivered to all the coroutines waiting
+   *          for any of them, flags not delivered remain pending until a
+   *          coroutine waits for them.
+   */
+  class AsyncEventFlags {
+
+    /**
+     * @brief   Waiting coroutines.
+     */
+    ch_queue_t queue;
+
+    /**
+     * @brief   Pending flags.
+     */
+    eventflags_t flags;
+
+  public:
+    /**
+     * @brief   Awaiter of an event flags wait.
+     */
+    class Awaiter : public AsyncWaiter {
+      friend class AsyncEventFlags;
+
+      AsyncEventFlags *efp;
+      eventflags_t mask;
+
+    public:
+      Awaiter(AsyncEventFlags *efp, eventflags_t mask,
+              sysinterval_t timeout) noexcept :
+        AsyncWaiter(timeout), efp(efp), mask(mask) {
+      }
+
+      bool await_suspend(Task::handle_t h) {
+        bool suspended = false;
+
+        chSysLock();
+        if ((efp->flags & mask) != (eventflags_t)0) {
+          mask &= efp->flags;
+          efp->flags &= ~mask;
+        }
+        else {
+          suspended = suspendS(&efp->queue, h);
+        }
+        chSysUnlock();
+
+        return suspended;
+      }
+
+      /**
+       * @return            The received flags.
+       * @retval 0          if the wait timed out.
+       */
+      eventflags_t await_resume(void) const noexcept {
+
+        return msg == MSG_OK ? mask : (eventflags_t)0;
+      }
+    };
+
+    /**
+     * @brief   AsyncEventFlags constructor.
+     *
+     * @init
+     */
+    AsyncEventFlags(void) noexcept : flags((eventflags_t)0) {
+
+      ch_queue_init(&queue);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    AsyncEventFlags(const AsyncEventFlags &) = delete;
+    AsyncEventFlags &operator=(const AsyncEventFlags &) = delete;
+
+    /**
+     * @brief   Waits for any of the specified flags.
+     * @details The received flags are cleared.
+     *
+     * @param[in] mask      flags to be waited for
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              An awaiter returning the received flags.
+     *
+     * @api
+     */
+    Awaiter wait(eventflags_t mask,
+                 sysinterval_t timeout = TIME_INFINITE) noexcept {
+
+      return Awaiter(this, mask, timeout);
+    }
+
+    /**
+     * @brief   Broadcasts flags.
+     *
+     * @param[in] f         flags to be broadcast
+     *
+     * @iclass
+     */
+    void broadcastFlagsI(eventflags_t f) {
+      ch_queue_t *p;
+      eventflags_t delivered = (eventflags_t)0;
+
+      chDbgCheckClassI();
+
+      flags |= f;
+      p = queue.next;
+      while (p != &queue) {
+        Awaiter *wp = static_cast<Awaiter *>(AsyncWaiter::fromLink(p));
+
+        p = p->next;
+        if ((flags & wp->mask) != (eventflags_t)0) {
+          wp->mask  &= flags;
+          delivered |= wp->mask;
+          wp->wakeupI(MSG_OK);
+        }
+      }
+      flags &= ~delivered;
+    }
+
+    /**
+     * @brief   Broadcasts flags.
+     *
+     * @param[in] f         flags to be broadcast
+     *
+     * @api
+     */
+    void broadcastFlags(eventflags_t f) {
+
+      chSysLock();
+      broadcastFlagsI(f);
+      chSchRescheduleS();
+      chSysUnlock();
+    }
+
+    /**
+     * @brief   Returns and clears the pending flags.
+     *
+     * @param[in] mask      flags to be returned and cleared
+     * @return              The pending flags.
+     *
+     * @iclass
+     */
+    eventflags_t getAndClearFlagsI(eventflags_t mask) {
+      eventflags_t f;
+
+      chDbgCheckClassI();
+
+      f = flags & mask;
+      flags &= ~f;
+
+      return f;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncMailboxBase                                           *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Mailbox awaited by coroutines.
+   * @details Messages are passed directly to waiting receivers, senders
+   *          wait while the buffer is full.
+   */
+  class AsyncMailboxBase {
+
+    /**
+     * @brief   Messages buffer.
+     */
+    msg_t *buf;
+
+    /**
+     * @brief   Messages buffer size.
+     */
+    size_t size;
+
+    /**
+     * @brief   Read index.
+     */
+    size_t rdidx;
+
+    /**
+     * @brief   Number of messages in the buffer.
+     */
+    size_t cnt;
+
+    /**
+     * @brief   Coroutines waiting for a message.
+     */
+    ch_queue_t rdqueue;
+
+    /**
+     * @brief   Coroutines waiting for a free slot.
+     */
+    ch_queue_t wrqueue;
+
+  public:
+    /**
+     * @brief   Awaiter of a post or fetch operation.
+     */
+    class Awaiter : public AsyncWaiter {
+      friend class AsyncMailboxBase;
+
+      AsyncMailboxBase *mbp;
+      msg_t *msgp;
+      msg_t outmsg;
+
+    public:
+      Awaiter(AsyncMailboxBase *mbp, msg_t *msgp, msg_t outmsg,
+              sysinterval_t timeout) noexcept :
+        AsyncWaiter(timeout), mbp(mbp), msgp(msgp), outmsg(outmsg) {
+      }
+
+      bool await_suspend(Task::handle_t h) {
+        bool suspended = false;
+
+        chSysLock();
+        if (msgp != nullptr) {
+          if (mbp->fetchI(msgp) != MSG_OK) {
+            suspended = suspendS(&mbp->rdqueue, h);
+          }
+        }
+        else {
+          if (mbp->postI(outmsg) != MSG_OK) {
+            suspended = suspendS(&mbp->wrqueue, h);
+          }
+        }
+        chSysUnlock();
+
+        return suspended;
+      }
+
+      /**
+       * @return            The operation result.
+       * @retval MSG_OK     if the message has been posted or fetched.
+       * @retval MSG_TIMEOUT if the operation timed out.
+       * @retval MSG_RESET  if the mailbox has been reset.
+       */
+      msg_t await_resume(void) const noexcept {
+
+        return msg;
+      }
+    };
+
+  protected:
+    /**
+     * @brief   AsyncMailboxBase constructor.
+     *
+     * @param[in] buf       pointer to the messages buffer
+     * @param[in] n         number of elements in the buffer
+     *
+     * @init
+     */
+    AsyncMailboxBase(msg_t *buf, size_t n) noexcept :
+      buf(buf), size(n), rdidx(0U), cnt(0U) {
+
+      ch_queue_init(&rdqueue);
+      ch_queue_init(&wrqueue);
+    }
+
+  public:
+    /* Prohibit copy construction and assignment.*/
+    AsyncMailboxBase(const AsyncMailboxBase &) = delete;
+    AsyncMailboxBase &operator=(const AsyncMailboxBase &) = delete;
+
+    /**
+     * @brief   Posts a message, waiting for a free slot.
+     *
+     * @param[in] m         the message to be posted
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              An awaiter returning the operation result.
+     *
+     * @api
+     */
+    Awaiter post(msg_t m, sysinterval_t timeout = TIME_INFINITE) noexcept {
+
+      return Awaiter(this, nullptr, m, timeout);
+    }
+
+    /**
+     * @brief   Fetches a message, waiting for one.
+     *
+     * @param[out] msgp     pointer to the message variable
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              An awaiter returning the operation result.
+     *
+     * @api
+     */
+    Awaiter fetch(msg_t *msgp,
+                  sysinterval_t timeout = TIME_INFINITE) noexcept {
+
+      chDbgCheck(msgp != nullptr);
+
+      return Awaiter(this, msgp, MSG_OK, timeout);
+    }
+
+    /**
+     * @brief   Posts a message without waiting.
+     *
+     * @param[in] m         the message to be posted
+     * @return              The operation result.
+     * @retval MSG_OK       if the message has been posted.
+     * @retval MSG_TIMEOUT  if the mailbox is full.
+     *
+     * @iclass
+     */
+    msg_t postI(msg_t m) {
+
+      chDbgCheckClassI();
+
+      if (ch_queue_notempty(&rdqueue)) {
+        Awaiter *wp = static_cast<Awaiter *>(
+                        AsyncWaiter::fromLink(rdqueue.next));
+
+        *wp->msgp = m;
+        wp->wakeupI(MSG_OK);
+        return MSG_OK;
+      }
+
+      if (cnt >= size) {
+        return MSG_TIMEOUT;
+      }
+
+      buf[(rdidx + cnt) % size] = m;
+      cnt++;
+
+      return MSG_OK;
+    }
+
+    /**
+     * @brief   Posts a message without waiting.
+     *
+     * @param[in] m         the message to be posted
+     * @return              The operation result.
+     * @retval MSG_OK       if the message has been posted.
+     * @retval MSG_TIMEOUT  if the mailbox is full.
+     *
+     * @api
+     */
+    msg_t tryPost(msg_t m) {
+      msg_t msg;
+
+      chSysLock();
+      msg = postI(m);
+      chSchRescheduleS();
+      chSysUnlock();
+
+      return msg;
+    }
+
+    /**
+     * @brief   Fetches a message without waiting.
+     *
+     * @param[out] msgp     pointer to the message variable
+     * @return              The operation result.
+     * @retval MSG_OK       if a message has been fetched.
+     * @retval MSG_TIMEOUT  if the mailbox is empty.
+     *
+     * @iclass
+     */
+    msg_t fetchI(msg_t *msgp) {
+
+      chDbgCheckClassI();
+
+      if (cnt == 0U) {
+        return MSG_TIMEOUT;
+      }
+
+      *msgp = buf[rdidx];
+      rdidx = (rdidx + 1U) % size;
+      cnt--;
+
+      /* The freed slot goes to the first waiting sender.*/
+      if (ch_queue_notempty(&wrqueue)) {
+        Awaiter *wp = static_cast<Awaiter *>(
+                        AsyncWaiter::fromLink(wrqueue.next));
+
+        buf[(rdidx + cnt) % size] = wp->outmsg;
+        cnt++;
+        wp->wakeupI(MSG_OK);
+      }
+
+      return MSG_OK;
+    }
+
+    /**
+     * @brief   Resets the mailbox.
+     * @details The messages are discarded and the waiting coroutines are
+     *          resumed with @p MSG_RESET.
+     *
+     * @iclass
+     */
+    void resetI(void) {
+
+      chDbgCheckClassI();
+
+      rdidx = 0U;
+      cnt   = 0U;
+      AsyncWaiter::wakeupAllI(&rdqueue, MSG_RESET);
+      AsyncWaiter::wakeupAllI(&wrqueue, MSG_RESET);
+    }
+
+    /**
+     * @brief   Returns the number of messages in the mailbox.
+     *
+     * @return              The number of messages.
+     *
+     * @iclass
+     */
+    size_t getUsedCountI(void) const {
+
+      chDbgCheckClassI();
+
+      return cnt;
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncMailbox                                               *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Template class encapsulating an asynchronous mailbox and its
+   *          messages buffer.
+   *
+   * @param N               size of the mailbox
+   */
+  template <size_t N>
+  class AsyncMailbox : public AsyncMailboxBase {
+
+    static_assert(N > 0U, "invalid mailbox size");
+
+    msg_t mb_buf[N];
+
+  public:
+    /**
+     * @brief   AsyncMailbox constructor.
+     *
+     * @init
+     */
+    AsyncMailbox(void) noexcept : AsyncMailboxBase(mb_buf, N) {
+    }
+  };
+
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncCompletion                                            *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Completion of an asynchronous operation.
+   * @details A coroutine starts a driver operation then awaits the
+   *          completion, the driver callback signals it. For example, with
+   *          a UART transmission:
+   * @code
+   *  static AsyncCompletion txdone;
+   *
+   *  static void txend2(UARTDriver *uartp) {
+   *
+   *    (void)uartp;
+   *    chSysLockFromISR();
+   *    txdone.signalI(MSG_OK);
+   *    chSysUnlockFromISR();
+   *  }
+   *
+   *  ...
+   *    uartStartSend(&UARTD1, n, buf);
+   *    msg = co_await txdone.wait(TIME_MS2I(100));
+   * @endcode
+   */
+  class AsyncCompletion {
+
+    /**
+     * @brief   Waiting coroutines.
+     */
+    ch_queue_t queue;
+
+    /**
+     * @brief   The completion has been signaled and not yet awaited.
+     */
+    bool pending;
+
+    /**
+     * @brief   Completion message.
+     */
+    msg_t result;
+
+  public:
+    /**
+     * @brief   Awaiter of a completion.
+     */
+    class Awaiter : public AsyncWaiter {
+      AsyncCompletion *cp;
+
+    public:
+      Awaiter(AsyncCompletion *cp, sysinterval_t timeout) noexcept :
+        AsyncWaiter(timeout), cp(cp) {
+      }
+
+      bool await_suspend(Task::handle_t h) {
+        bool suspended = false;
+
+        chSysLock();
+        if (cp->pending) {
+          cp->pending = false;
+          msg = cp->result;
+        }
+        else {
+          suspended = suspendS(&cp->queue, h);
+        }
+        chSysUnlock();
+
+        return suspended;
+      }
+
+      /**
+       * @return            The completion message.
+       * @retval MSG_TIMEOUT if the wait timed out.
+       */
+      msg_t await_resume(void) const noexcept {
+
+        return msg;
+      }
+    };
+
+    /**
+     * @brief   AsyncCompletion constructor.
+     *
+     * @init
+     */
+    AsyncCompletion(void) noexcept : pending(false), result(MSG_OK) {
+
+      ch_queue_init(&queue);
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    AsyncCompletion(const AsyncCompletion &) = delete;
+    AsyncCompletion &operator=(const AsyncCompletion &) = delete;
+
+    /**
+     * @brief   Waits for the completion.
+     *
+     * @param[in] timeout   the number of ticks before the operation timeouts,
+     *                      the following special values are allowed:
+     *                      - @a TIME_IMMEDIATE immediate timeout.
+     *                      - @a TIME_INFINITE no timeout.
+     *                      .
+     * @return              An awaiter returning the completion message.
+     *
+     * @api
+     */
+    Awaiter wait(sysinterval_t timeout = TIME_INFINITE) noexcept {
+
+      return Awaiter(this, timeout);
+    }
+
+    /**
+     * @brief   Signals the completion.
+     * @details The first waiting coroutine is resumed, if there is none
+     *          the completion is kept for the next wait.
+     *
+     * @param[in] m         completion message
+     *
+     * @iclass
+     */
+    void signalI(msg_t m) {
+
+      chDbgCheckClassI();
+
+      if (ch_queue_notempty(&queue)) {
+        AsyncWaiter::fromLink(queue.next)->wakeupI(m);
+      }
+      else {
+        pending = true;
+        result  = m;
+      }
+    }
+
+    /**
+     * @brief   Discards a completion not yet awaited.
+     *
+     * @iclass
+     */
+    void clearI(void) {
+
+      chDbgCheckClassI();
+
+      pending = false;
+    }
+  };
+
+#if (defined(HAL_USE_SPI) && (HAL_USE_SPI == TRUE) &&                       \
+     (SPI_USE_QUEUE == TRUE)) || defined(__DOXYGEN__)
+  /*------------------------------------------------------------------------*
+   * chibios_rt::AsyncSpiRequest                                            *
+   *------------------------------------------------------------------------*/
+  /**
+   * @brief   Awaiter of a queued SPI request.
+   * @details The request is queued when awaited, the coroutine is resumed
+   *          by the request completion.
+   * @note    Requires @p hal.h to be included before this header.
+   */
+  class AsyncSpiRequest {
+
+    /**
+     * @brief   Embedded @p spi_request_t structure, first member.
+     */
+    spi_request_t req;
+
+    /**
+     * @brief   Driver the request is queued on.
+     */
+    SPIDriver *spip;
+
+    /**
+     * @brief   Suspended coroutine.
+     */
+    Task::handle_t handle;
+
+    static void end_cb(SPIDriver *spip, spi_request_t *reqp) {
+      AsyncSpiRequest *rp = reinterpret_cast<AsyncSpiRequest *>(reqp);
+
+      (void)spip;
+      chSysLockFromISR();
+      ExecutorBase::resumeI(rp->handle);
+      chSysUnlockFromISR();
+    }
+
+  public:
+    /**
+     * @brief   AsyncSpiRequest constructor.
+     *
+     * @param[in] spip      pointer to the @p SPIDriver object
+     * @param[in] segp      pointer to the transaction segments
+     * @param[in] n         number of segments
+     * @param[in] prio      request priority, higher values are served first
+     */
+    AsyncSpiRequest(SPIDriver *spip, const spi_segment_t *segp, size_t n,
+                    uint32_t prio = 0U) noexcept :
+      spip(spip), handle(nullptr) {
+
+      req.next   = NULL;
+      req.prio   = prio;
+      req.segp   = segp;
+      req.n      = n;
+      req.end_cb = end_cb;
+    }
+
+    /* Prohibit copy construction and assignment.*/
+    AsyncSpiRequest(const AsyncSpiRequest &) = delete;
+    AsyncSpiRequest &operator=(const AsyncSpiRequest &) = delete;
+
+    bool await_ready(void) const noexcept {
+
+      return false;
+    }
+
+    void await_suspend(Task::handle_t h) {
+
+      handle = h;
+      spiQueueRequest(spip, &req);
+    }
+
+    void await_resume(void) const noexcept {
+    }
+  };
+#endif /* HAL_USE_SPI == TRUE && SPI_USE_QUEUE == TRUE */
+}
+
+#endif /* _CHCORO_HPP_ */
+
+/** @} */
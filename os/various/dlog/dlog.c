@@ -0,0 +1,285 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    dlog.c
+ * @brief   Deferred logging code.
+ *
+ * @addtogroup dlog
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "dlog.h"
+#if DLOG_USE_TEXT_DRAIN == TRUE
+#include "chprintf.h"
+#endif
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum size of a record in words.
+ */
+#define DLOG_MAX_RECORD_SIZE                (DLOG_HEADER_SIZE + DLOG_MAX_ARGS)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Writes a record in the words ring.
+ * @pre     The caller must be in a critical zone.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] id        format identifier
+ * @param[in] args      pointer to the arguments
+ * @param[in] n         number of arguments
+ * @return              The operation result.
+ * @retval false        if the record has been written.
+ * @retval true         if there is not enough space in the ring.
+ */
+static bool dlog_write_record(dlog_t *dlp, uint32_t id,
+                              const uint32_t *args, size_t n) {
+  size_t i, wridx;
+
+  if ((n + DLOG_HEADER_SIZE) > (dlp->size - dlp->cnt)) {
+    return true;
+  }
+
+  wridx = dlp->wridx;
+  dlp->buffer[wridx] = id;
+  if (++wridx >= dlp->size) {
+    wridx = 0U;
+  }
+  dlp->buffer[wridx] = ((uint32_t)chVTGetSystemTimeX() << 4) | (uint32_t)n;
+  if (++wridx >= dlp->size) {
+    wridx = 0U;
+  }
+  for (i = 0U; i < n; i++) {
+    dlp->buffer[wridx] = args[i];
+    if (++wridx >= dlp->size) {
+      wridx = 0U;
+    }
+  }
+  dlp->wridx = wridx;
+  dlp->cnt  += n + DLOG_HEADER_SIZE;
+
+  return false;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p dlog_t object.
+ *
+ * @param[out] dlp      pointer to the @p dlog_t object
+ * @param[in] buf       pointer to the words ring buffer
+ * @param[in] size      size of the words ring buffer
+ *
+ * @init
+ */
+void dlogObjectInit(dlog_t *dlp, uint32_t *buf, size_t size) {
+
+  chDbgCheck((dlp != NULL) && (buf != NULL) &&
+             (size >= DLOG_MAX_RECORD_SIZE));
+
+  dlp->buffer = buf;
+  dlp->size   = size;
+  dlp->rdidx  = 0U;
+  dlp->wridx  = 0U;
+  dlp->cnt    = 0U;
+  dlp->lost   = 0U;
+}
+
+/**
+ * @brief   Writes a log record.
+ * @details The record is written within a short critical zone so this
+ *          function can be called from threads and ISRs, its cost is the
+ *          copy of a few words. If the ring is full then the record is
+ *          dropped and a record reporting the number of lost records is
+ *          written as soon as there is space again.
+ * @note    Use the @p dlogPrint() and @p dlogPuts() macros, the format
+ *          strings must be placed in the @p DLOG_FMT_SECTION section.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] fmt       pointer to the format string
+ * @param[in] args      pointer to the arguments
+ * @param[in] n         number of arguments
+ *
+ * @xclass
+ */
+void dlogWriteX(dlog_t *dlp, const char *fmt,
+                const uint32_t *args, size_t n) {
+  syssts_t sts;
+
+  chDbgCheck(n <= DLOG_MAX_ARGS);
+
+  sts = chSysGetStatusAndLockX();
+
+  /* Reporting lost records first.*/
+  if (dlp->lost > 0U) {
+    if (dlog_write_record(dlp, DLOG_ID_LOST, &dlp->lost, 1U)) {
+      dlp->lost++;
+      chSysRestoreStatusX(sts);
+      return;
+    }
+    dlp->lost = 0U;
+  }
+
+  if (dlog_write_record(dlp, (uint32_t)fmt, args, n)) {
+    dlp->lost = 1U;
+  }
+
+  chSysRestoreStatusX(sts);
+}
+
+/**
+ * @brief   Reads a record from the ring.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[out] rp       pointer to a buffer of @p DLOG_HEADER_SIZE plus
+ *                      @p DLOG_MAX_ARGS words
+ * @return              The size of the record in words.
+ * @retval 0            if the ring is empty.
+ *
+ * @iclass
+ */
+size_t dlogReadRecordI(dlog_t *dlp, uint32_t *rp) {
+  size_t i, n;
+
+  chDbgCheckClassI();
+
+  if (dlp->cnt == 0U) {
+    return 0U;
+  }
+
+  rp[0] = dlp->buffer[dlp->rdidx];
+  i = dlp->rdidx + 1U;
+  if (i >= dlp->size) {
+    i = 0U;
+  }
+  rp[1] = dlp->buffer[i];
+  n = DLOG_HEADER_SIZE + (size_t)(rp[1] & 15U);
+  for (i = 0U; i < n; i++) {
+    rp[i] = dlp->buffer[dlp->rdidx];
+    if (++dlp->rdidx >= dlp->size) {
+      dlp->rdidx = 0U;
+    }
+  }
+  dlp->cnt -= n;
+
+  return n;
+}
+
+/**
+ * @brief   Drains the pending records to a stream in binary form.
+ * @details The records are written as little endian words, the stream is
+ *          decoded on the host using the dlogdecode.py script. It is meant
+ *          to be invoked from a low priority thread.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] sp        pointer to a @p BaseSequentialStream object
+ * @return              The number of drained records.
+ *
+ * @api
+ */
+size_t dlogDrainBinary(dlog_t *dlp, BaseSequentialStream *sp) {
+  uint32_t rec[DLOG_MAX_RECORD_SIZE];
+  uint8_t buf[DLOG_MAX_RECORD_SIZE * 4U];
+  size_t n, i, nrec = 0U;
+
+  while (true) {
+    chSysLock();
+    n = dlogReadRecordI(dlp, rec);
+    chSysUnlock();
+
+    if (n == 0U) {
+      return nrec;
+    }
+
+    for (i = 0U; i < n; i++) {
+      buf[(i * 4U) + 0U] = (uint8_t)rec[i];
+      buf[(i * 4U) + 1U] = (uint8_t)(rec[i] >> 8);
+      buf[(i * 4U) + 2U] = (uint8_t)(rec[i] >> 16);
+      buf[(i * 4U) + 3U] = (uint8_t)(rec[i] >> 24);
+    }
+    (void) streamWrite(sp, buf, n * 4U);
+    nrec++;
+  }
+}
+
+#if (DLOG_USE_TEXT_DRAIN == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Drains the pending records to a stream in text form.
+ * @details Records are formatted on the device using chprintf(), one line
+ *          for each record prefixed by the system time.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] sp        pointer to a @p BaseSequentialStream object
+ * @return              The number of drained records.
+ *
+ * @api
+ */
+size_t dlogDrainText(dlog_t *dlp, BaseSequentialStream *sp) {
+  uint32_t rec[DLOG_HEADER_SIZE + 15U];
+  size_t n, nrec = 0U;
+
+  while (true) {
+    chSysLock();
+    n = dlogReadRecordI(dlp, rec);
+    chSysUnlock();
+
+    if (n == 0U) {
+      return nrec;
+    }
+
+    /* Unused arguments are ignored by the formatting.*/
+    for (; n < DLOG_HEADER_SIZE + 15U; n++) {
+      rec[n] = 0U;
+    }
+    chprintf(sp, "%10U ", rec[1] >> 4);
+    if (rec[0] == DLOG_ID_LOST) {
+      chprintf(sp, "*** %U records lost", rec[2]);
+    }
+    else {
+      chprintf(sp, (const char *)rec[0], rec[2], rec[3], rec[4], rec[5],
+               rec[6], rec[7], rec[8], rec[9], rec[10], rec[11], rec[12],
+               rec[13], rec[14], rec[15], rec[16]);
+    }
+    chprintf(sp, "\r\n");
+    nrec++;
+  }
+}
+#endif /* DLOG_USE_TEXT_DRAIN == TRUE */
+
+/** @} */
@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    dlog.h
+ * @brief   Deferred logging structures and macros.
+ *
+ * @addtogroup dlog
+ * @{
+ */
+
+#ifndef DLOG_H
+#define DLOG_H
+
+#include "ccportab.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Format identifier of records reporting lost records.
+ */
+#define DLOG_ID_LOST                        0U
+
+/**
+ * @brief   Number of header words of a record.
+ */
+#define DLOG_HEADER_SIZE                    2U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum number of arguments of a log record.
+ * @note    The maximum value is 15.
+ */
+#if !defined(DLOG_MAX_ARGS) || defined(__DOXYGEN__)
+#define DLOG_MAX_ARGS                       8U
+#endif
+
+/**
+ * @brief   Section of the format strings.
+ * @details The format strings are only referenced by address in the
+ *          records, the host decoder finds them in the ELF file using the
+ *          @p __dlog_fmt symbols.
+ */
+#if !defined(DLOG_FMT_SECTION) || defined(__DOXYGEN__)
+#define DLOG_FMT_SECTION                    ".rodata.dlog_fmt"
+#endif
+
+/**
+ * @brief   Enables the on-device text drain.
+ * @note    It requires chprintf(), floating point and strings arguments
+ *          are not supported by this drain.
+ */
+#if !defined(DLOG_USE_TEXT_DRAIN) || defined(__DOXYGEN__)
+#define DLOG_USE_TEXT_DRAIN                 FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (DLOG_MAX_ARGS < 1) || (DLOG_MAX_ARGS > 15)
+#error "invalid DLOG_MAX_ARGS value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a deferred log object.
+ * @details Records are written in a words ring, each record is made of
+ *          the format string address, a word containing the system time
+ *          and the number of arguments, then the raw arguments.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the words ring.
+   */
+  uint32_t              *buffer;
+  /**
+   * @brief   Size of the words ring.
+   */
+  size_t                size;
+  /**
+   * @brief   Read index.
+   */
+  size_t                rdidx;
+  /**
+   * @brief   Write index.
+   */
+  size_t                wridx;
+  /**
+   * @brief   Number of words in the ring.
+   */
+  size_t                cnt;
+  /**
+   * @brief   Number of records lost since the last written record.
+   */
+  uint32_t              lost;
+} dlog_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Writes a log record.
+ * @details Only the format string address and the raw arguments are
+ *          stored, formatting is deferred to the drain or to the host.
+ * @note    Arguments are converted to @p uint32_t, floating point values
+ *          must be passed using @p dlogFloat().
+ * @note    This macro can be used from any context.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] fmt       format string literal, chprintf() syntax
+ * @param[in] ...       arguments, from 1 to @p DLOG_MAX_ARGS
+ *
+ * @special
+ */
+#define dlogPrint(dlp, fmt, ...) do {                                       \
+  static const char __dlog_fmt[] CC_SECTION(DLOG_FMT_SECTION) = fmt;        \
+  const uint32_t __dlog_args[] = {__VA_ARGS__};                             \
+  dlogWriteX(dlp, __dlog_fmt, __dlog_args,                                  \
+             sizeof __dlog_args / sizeof __dlog_args[0]);                   \
+} while (false)
+
+/**
+ * @brief   Writes a log record without arguments.
+ *
+ * @param[in] dlp       pointer to the @p dlog_t object
+ * @param[in] fmt       format string literal
+ *
+ * @special
+ */
+#define dlogPuts(dlp, fmt) do {                                             \
+  static const char __dlog_fmt[] CC_SECTION(DLOG_FMT_SECTION) = fmt;        \
+  dlogWriteX(dlp, __dlog_fmt, NULL, 0U);                                    \
+} while (false)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dlogObjectInit(dlog_t *dlp, uint32_t *buf, size_t size);
+  void dlogWriteX(dlog_t *dlp, const char *fmt,
+                  const uint32_t *args, size_t n);
+  size_t dlogReadRecordI(dlog_t *dlp, uint32_t *rp);
+  size_t dlogDrainBinary(dlog_t *dlp, BaseSequentialStream *sp);
+#if DLOG_USE_TEXT_DRAIN == TRUE
+  size_t dlogDrainText(dlog_t *dlp, BaseSequentialStream *sp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the raw representation of a floating point argument.
+ *
+ * @param[in] f         the value
+ * @return              The value bits.
+ *
+ * @xclass
+ */
+static inline uint32_t dlogFloat(float f) {
+  union {
+    float       f;
+    uint32_t    u;
+  } v;
+
+  v.f = f;
+
+  return v.u;
+}
+
+#endif /* DLOG_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Deferred logging files.
+DLOGSRC = $(CHIBIOS)/os/various/dlog/dlog.c
+
+DLOGINC = $(CHIBIOS)/os/various/dlog
+
+# Shared variables
+ALLCSRC += $(DLOGSRC)
+ALLINC  += $(DLOGINC)
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+#
+#    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+"""Decoder for the ChibiOS deferred log binary stream.
+
+The format strings are extracted from the firmware ELF file, they can be
+saved in a dictionary as a build step using -x and used later with -d.
+
+Usage: dlogdecode.py -x <elf> [-o <dictionary>]
+       dlogdecode.py (-e <elf> | -d <dictionary>) [-t <systime bits>]
+                     [input]
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+SYMBOL_PREFIX = "__dlog_fmt"
+
+SPEC = re.compile(r"%([-+0]*)(\*|\d*)(?:\.(\*|\d*))?([lL]?)(.)")
+
+
+def read_elf_formats(path):
+    """Returns a dictionary of the format strings found in an ELF32 file,
+    the keys are the strings addresses."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        raise ValueError("not a little endian ELF32 file")
+
+    shoff, = struct.unpack_from("<I", elf, 0x20)
+    shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+    sections = []
+    for i in range(shnum):
+        sections.append(struct.unpack_from("<IIIIIIIIII", elf,
+                                           shoff + i * shentsize))
+
+    def read_string(addr):
+        for (_, stype, _, saddr, soff, ssize, _, _, _, _) in sections:
+            if stype == 1 and saddr <= addr < saddr + ssize:
+                start = soff + addr - saddr
+                end = elf.index(b"\0", start)
+                return elf[start:end].decode("latin-1")
+        return None
+
+    formats = {}
+    for (_, stype, _, _, soff, ssize, link, _, _, entsize) in sections:
+        if stype != 2:
+            continue
+        strtab = sections[link]
+        for i in range(ssize // entsize):
+            name, value, _, _, _, _ = struct.unpack_from(
+                "<IIIBBH", elf, soff + i * entsize)
+            start = strtab[4] + name
+            sym = elf[start:elf.index(b"\0", start)].decode("latin-1")
+            if sym.startswith(SYMBOL_PREFIX):
+                text = read_string(value)
+                if text is not None:
+                    formats[value] = text
+    return formats
+
+
+def format_record(fmt, args):
+    """Formats a record using the chprintf() conversions."""
+    args = list(args)
+
+    def arg():
+        return args.pop(0) if args else 0
+
+    def convert(m):
+        flags, width, prec, _, conv = m.groups()
+        if width == "*":
+            width = str(arg())
+        if prec == "*":
+            prec = str(arg())
+        spec = "%" + flags + width + ("." + prec if prec else "")
+        if conv in "dDiI":
+            value = arg()
+            return (spec + "d") % (value - (1 << 32) if value & 0x80000000
+                                   else value)
+        if conv in "uU":
+            return (spec + "d") % arg()
+        if conv in "xXpP":
+            return (spec + "X") % arg()
+        if conv in "oO":
+            return (spec + "o") % arg()
+        if conv == "c":
+            return (spec + "c") % chr(arg() & 0xFF)
+        if conv == "f":
+            value, = struct.unpack("<f", struct.pack("<I", arg()))
+            return (spec + "f") % value
+        if conv == "s":
+            return (spec + "s") % ("<%08x>" % arg())
+        return conv
+
+    return SPEC.sub(convert, fmt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-x", "--extract", metavar="ELF",
+                        help="extract the format strings dictionary")
+    parser.add_argument("-o", "--output", help="dictionary output file")
+    parser.add_argument("-e", "--elf", help="firmware ELF file")
+    parser.add_argument("-d", "--dict", help="format strings dictionary")
+    parser.add_argument("-t", "--tbits", type=int, default=32,
+                        help="system time width in bits (default 32)")
+    parser.add_argument("input", nargs="?", help="input file or device")
+    args = parser.parse_args()
+
+    if args.extract:
+        formats = read_elf_formats(args.extract)
+        out = open(args.output, "w") if args.output else sys.stdout
+        json.dump({"%08x" % k: v for k, v in sorted(formats.items())},
+                  out, indent=1)
+        out.write("\n")
+        return
+
+    if args.elf:
+        formats = read_elf_formats(args.elf)
+    elif args.dict:
+        with open(args.dict) as f:
+            formats = {int(k, 16): v for k, v in json.load(f).items()}
+    else:
+        parser.error("one of -e or -d is required")
+
+    tmask = (1 << min(args.tbits, 28)) - 1
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    while True:
+        header = stream.read(8)
+        if len(header) < 8:
+            break
+        fid, word = struct.unpack("<II", header)
+        n = word & 15
+        data = stream.read(4 * n)
+        if len(data) < 4 * n:
+            break
+        values = struct.unpack("<%dI" % n, data)
+        line = "%10d " % ((word >> 4) & tmask)
+        if fid == 0:
+            line += "*** %d records lost" % (values[0] if values else 0)
+        elif fid in formats:
+            line += format_record(formats[fid], values)
+        else:
+            line += "*** unknown format %08x %s" % (
+                fid, " ".join("%08x" % v for v in values))
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,180 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    dmabuf.c
+ * @brief   DMA buffers allocator code.
+ *
+ * @addtogroup dmabuf
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "ccportab.h"
+#include "dmabuf.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Buffers arena.
+ */
+#if DMABUF_USE_NOCACHE == TRUE
+static CC_SECTION(".nocache") CC_ALIGN(DMABUF_ALIGN)
+uint8_t dmabuf_arena[DMABUF_ARENA_SIZE];
+#else
+static CC_ALIGN(DMABUF_ALIGN) uint8_t dmabuf_arena[DMABUF_ARENA_SIZE];
+#endif
+
+/**
+ * @brief   Heap allocating from the arena.
+ */
+static memory_heap_t dmabuf_heap;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Memory provider for the DMA buffers pools.
+ *
+ * @param[in] size      size of the object to be allocated
+ * @param[in] align     required alignment
+ * @return              The allocated object or @p NULL.
+ */
+static void *dmabuf_provider(size_t size, unsigned align) {
+
+  return chHeapAllocAligned(&dmabuf_heap, size, align);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the DMA buffers allocator.
+ *
+ * @init
+ */
+void dmabufInit(void) {
+
+  chHeapObjectInit(&dmabuf_heap, dmabuf_arena, sizeof dmabuf_arena);
+}
+
+/**
+ * @brief   Allocates a DMA buffer.
+ * @details The buffer is aligned to a cache line and its size is padded
+ *          to whole cache lines so that cache maintenance on it never
+ *          affects other data.
+ *
+ * @param[in] size      buffer size in bytes
+ * @return              The buffer pointer.
+ * @retval NULL         if the arena is exhausted.
+ *
+ * @api
+ */
+void *dmabufAlloc(size_t size) {
+
+  osalDbgCheck(size > 0U);
+
+  return chHeapAllocAligned(&dmabuf_heap, DMABUF_SIZE_ALIGN(size),
+                            DMABUF_ALIGN);
+}
+
+/**
+ * @brief   Frees a buffer allocated using @p dmabufAlloc().
+ *
+ * @param[in] p         buffer pointer
+ *
+ * @api
+ */
+void dmabufFree(void *p) {
+
+  chHeapFree(p);
+}
+
+/**
+ * @brief   Initializes a pool of fixed size DMA buffers.
+ * @details The pool takes its buffers from the arena when empty, buffers
+ *          returned to the pool are not released to the arena. Pools are
+ *          preferable for buffers allocated and freed at each transfer.
+ *
+ * @param[out] mp       pointer to a @p memory_pool_t structure
+ * @param[in] size      buffers size in bytes
+ *
+ * @init
+ */
+void dmabufPoolObjectInit(memory_pool_t *mp, size_t size) {
+
+  osalDbgCheck(size > 0U);
+
+  chPoolObjectInitAligned(mp, DMABUF_SIZE_ALIGN(size), DMABUF_ALIGN,
+                          dmabuf_provider);
+}
+
+/**
+ * @brief   Checks if a buffer requires cache maintenance.
+ *
+ * @param[in] p         buffer pointer
+ * @return              The check result.
+ * @retval false        if the buffer is cacheable.
+ * @retval true         if the buffer is in non-cacheable memory.
+ *
+ * @xclass
+ */
+bool dmabufIsNonCacheable(const void *p) {
+
+#if DMABUF_USE_NOCACHE == TRUE
+  return ((const uint8_t *)p >= &dmabuf_arena[0]) &&
+         ((const uint8_t *)p < &dmabuf_arena[DMABUF_ARENA_SIZE]);
+#else
+  (void)p;
+
+  return false;
+#endif
+}
+
+/**
+ * @brief   Reports the arena status.
+ *
+ * @param[out] totalp   pointer to a variable that will receive the total
+ *                      fragmented free space or @p NULL
+ * @param[out] largestp pointer to a variable that will receive the largest
+ *                      free block found space or @p NULL
+ * @return              The number of fragments in the arena.
+ *
+ * @api
+ */
+size_t dmabufStatus(size_t *totalp, size_t *largestp) {
+
+  return chHeapStatus(&dmabuf_heap, totalp, largestp);
+}
+
+/** @} */
@@ -0,0 +1,124 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    dmabuf.h
+ * @brief   DMA buffers allocator macros and structures.
+ *
+ * @addtogroup dmabuf
+ * @{
+ */
+
+#ifndef DMABUF_H
+#define DMABUF_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Alignment of the allocated buffers.
+ * @details Buffers never share a cache line with other data.
+ */
+#if defined(__DOXYGEN__) ||                                                 \
+    (defined(CACHE_LINE_SIZE) && (CACHE_LINE_SIZE > 0U))
+#define DMABUF_ALIGN                        CACHE_LINE_SIZE
+#else
+#define DMABUF_ALIGN                        PORT_NATURAL_ALIGN
+#endif
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the buffers arena.
+ */
+#if !defined(DMABUF_ARENA_SIZE) || defined(__DOXYGEN__)
+#define DMABUF_ARENA_SIZE                   8192U
+#endif
+
+/**
+ * @brief   Places the arena in the @p .nocache section.
+ * @details If enabled the buffers are allocated in the non-cacheable
+ *          memory and require no cache maintenance, the maintenance
+ *          performed by drivers is skipped if @p CACHE_SKIP_NOCACHE is
+ *          also enabled. If disabled the buffers are allocated in normal
+ *          memory, aligned and padded to whole cache lines.
+ * @note    The linker script must map the @p .nocache section on a memory
+ *          region marked non-cacheable using the MPU.
+ */
+#if !defined(DMABUF_USE_NOCACHE) || defined(__DOXYGEN__)
+#define DMABUF_USE_NOCACHE                  TRUE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_HEAP != TRUE
+#error "the DMA buffers allocator requires CH_CFG_USE_HEAP"
+#endif
+
+#if CH_CFG_USE_MEMPOOLS != TRUE
+#error "the DMA buffers allocator requires CH_CFG_USE_MEMPOOLS"
+#endif
+
+#if (DMABUF_ARENA_SIZE == 0U) || ((DMABUF_ARENA_SIZE % DMABUF_ALIGN) != 0U)
+#error "invalid DMABUF_ARENA_SIZE value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Rounds a size to a multiple of @p DMABUF_ALIGN.
+ *
+ * @param[in] n         size in bytes
+ * @return              The padded size.
+ */
+#define DMABUF_SIZE_ALIGN(n)                                                \
+  ((((size_t)(n) - 1U) | ((size_t)DMABUF_ALIGN - 1U)) + 1U)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void dmabufInit(void);
+  void *dmabufAlloc(size_t size);
+  void dmabufFree(void *p);
+  void dmabufPoolObjectInit(memory_pool_t *mp, size_t size);
+  bool dmabufIsNonCacheable(const void *p);
+  size_t dmabufStatus(size_t *totalp, size_t *largestp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* DMABUF_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# DMA buffers allocator files.
+DMABUFSRC = $(CHIBIOS)/os/various/dmabuf/dmabuf.c
+
+DMABUFINC = $(CHIBIOS)/os/various/dmabuf
+
+# Shared variables
+ALLCSRC += $(DMABUFSRC)
+ALLINC  += $(DMABUFINC)
@@ -54,6 +54,21 @@ static void tmrcb(void *p) {
   chSysUnlockFromISR();
 }
 
+static void grpcb(void *p) {
+  event_timer_group_t *etgp = p;
+  event_group_timer_t *egtp;
+
+  chSysLockFromISR();
+  for (egtp = etgp->etg_first; egtp != NULL; egtp = egtp->egt_next) {
+    if (--egtp->egt_count == 0U) {
+      egtp->egt_count = egtp->egt_period;
+      chEvtBroadcastI(&egtp->egt_es);
+    }
+  }
+  chVTDoSetI(&etgp->etg_vt, etgp->etg_base, grpcb, etgp);
+  chSysUnlockFromISR();
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -82,4 +97,111 @@ void evtStart(event_timer_t *etp) {
   chVTSet(&etp->et_vt, etp->et_interval, tmrcb, etp);
 }
 
+/**
+ * @brief   Initializes an @p event_timer_group_t structure.
+ * @details Timers with periods multiple of the base interval share the
+ *          group virtual timer, the virtual timers list only contains one
+ *          element for the whole group and a single callback broadcasts
+ *          all the timers expiring on a tick.
+ *
+ * @param[out] etgp     the @p event_timer_group_t structure to be
+ *                      initialized
+ * @param[in] base      the group base interval in system ticks
+ */
+void evtGroupObjectInit(event_timer_group_t *etgp, systime_t base) {
+
+  chDbgCheck((etgp != NULL) && (base > (systime_t)0));
+
+  chVTObjectInit(&etgp->etg_vt);
+  etgp->etg_base  = base;
+  etgp->etg_first = NULL;
+}
+
+/**
+ * @brief   Starts a timers group.
+ * @details If the group was already running then it is restarted.
+ *
+ * @param[in] etgp      pointer to an initialized @p event_timer_group_t
+ *                      structure.
+ */
+void evtGroupStart(event_timer_group_t *etgp) {
+
+  chVTSet(&etgp->etg_vt, etgp->etg_base, grpcb, etgp);
+}
+
+/**
+ * @brief   Initializes an @p event_group_timer_t structure.
+ * @details The period is rounded up to a multiple of the base interval of
+ *          the group the timer is meant to be added to.
+ *
+ * @param[out] egtp     the @p event_group_timer_t structure to be
+ *                      initialized
+ * @param[in] etgp      pointer to the timers group
+ * @param[in] time      the interval in system ticks
+ */
+void evtGroupTimerObjectInit(event_group_timer_t *egtp,
+                             event_timer_group_t *etgp,
+                             systime_t time) {
+  unsigned period;
+
+  chDbgCheck((egtp != NULL) && (etgp != NULL));
+
+  period = (unsigned)((time + etgp->etg_base - (systime_t)1) /
+                      etgp->etg_base);
+  if (period == 0U) {
+    period = 1U;
+  }
+
+  chEvtObjectInit(&egtp->egt_es);
+  egtp->egt_next   = NULL;
+  egtp->egt_period = period;
+  egtp->egt_count  = period;
+}
+
+/**
+ * @brief   Adds a timer to a group.
+ * @details The timer first expires one period after the next group tick.
+ *
+ * @param[in] etgp      pointer to an initialized @p event_timer_group_t
+ *                      structure.
+ * @param[in] egtp      pointer to an initialized @p event_group_timer_t
+ *                      structure.
+ */
+void evtGroupAdd(event_timer_group_t *etgp, event_group_timer_t *egtp) {
+
+  chDbgCheck((etgp != NULL) && (egtp != NULL));
+
+  chSysLock();
+  egtp->egt_count = egtp->egt_period;
+  egtp->egt_next  = etgp->etg_first;
+  etgp->etg_first = egtp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Removes a timer from a group.
+ * @details If the timer is not part of the group then the function has no
+ *          effect.
+ *
+ * @param[in] etgp      pointer to an initialized @p event_timer_group_t
+ *                      structure.
+ * @param[in] egtp      pointer to the @p event_group_timer_t structure.
+ */
+void evtGroupRemove(event_timer_group_t *etgp, event_group_timer_t *egtp) {
+  event_group_timer_t **egtpp;
+
+  chDbgCheck((etgp != NULL) && (egtp != NULL));
+
+  chSysLock();
+  for (egtpp = &etgp->etg_first; *egtpp != NULL;
+       egtpp = &(*egtpp)->egt_next) {
+    if (*egtpp == egtp) {
+      *egtpp = egtp->egt_next;
+      egtp->egt_next = NULL;
+      break;
+    }
+  }
+  chSysUnlock();
+}
+
 /** @} */
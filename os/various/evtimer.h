@@ -57,6 +57,28 @@ typedef struct {
   systime_t             et_interval;
 } event_timer_t;
 
+/**
+ * @brief   Type of a grouped event timer structure.
+ */
+typedef struct event_group_timer {
+  struct event_group_timer *egt_next;
+  event_source_t        egt_es;
+  unsigned              egt_period;
+  unsigned              egt_count;
+} event_group_timer_t;
+
+/**
+ * @brief   Type of an event timers group structure.
+ * @details All the timers in a group are driven by a single virtual timer
+ *          ticking at the group base interval, the timers expiring on the
+ *          same tick are broadcast within the same callback.
+ */
+typedef struct {
+  virtual_timer_t       etg_vt;
+  systime_t             etg_base;
+  event_group_timer_t   *etg_first;
+} event_timer_group_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -70,6 +92,13 @@ extern "C" {
 #endif
   void evtObjectInit(event_timer_t *etp, systime_t time);
   void evtStart(event_timer_t *etp);
+  void evtGroupObjectInit(event_timer_group_t *etgp, systime_t base);
+  void evtGroupStart(event_timer_group_t *etgp);
+  void evtGroupTimerObjectInit(event_group_timer_t *egtp,
+                               event_timer_group_t *etgp,
+                               systime_t time);
+  void evtGroupAdd(event_timer_group_t *etgp, event_group_timer_t *egtp);
+  void evtGroupRemove(event_timer_group_t *etgp, event_group_timer_t *egtp);
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +118,19 @@ static inline void evtStop(event_timer_t *etp) {
   chVTReset(&etp->et_vt);
 }
 
+/**
+ * @brief   Stops a timers group.
+ * @details If the group was already stopped then the function has no
+ *          effect.
+ *
+ * @param[in] etgp      pointer to an initialized @p event_timer_group_t
+ *                      structure.
+ */
+static inline void evtGroupStop(event_timer_group_t *etgp) {
+
+  chVTReset(&etgp->etg_vt);
+}
+
 #endif /* EVTIMER_H */
 
 /** @} */
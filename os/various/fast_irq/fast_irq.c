@@ -0,0 +1,154 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fast_irq.c
+ * @brief   Fast interrupts notification code.
+ *
+ * @addtogroup fast_irq
+ * @{
+ */
+
+#include "ch.h"
+#include "fast_irq.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Notifications queue.
+ */
+fast_irq_t fast_irq;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Drain vector handler.
+ * @details The pending mask is fetched and cleared atomically, then the
+ *          callbacks of the pending sources are invoked with the kernel
+ *          locked, lower numbered sources first.
+ */
+CH_IRQ_HANDLER(FAST_IRQ_HANDLER) {
+  uint32_t pending;
+
+  CH_IRQ_PROLOGUE();
+
+  do {
+    pending = __LDREXW(&fast_irq.pending);
+  } while (__STREXW(0U, &fast_irq.pending) != 0U);
+  __DMB();
+
+  chSysLockFromISR();
+  while (pending != 0U) {
+    uint32_t n = __CLZ(__RBIT(pending));
+
+    pending &= ~(1U << n);
+    if (fast_irq.sources[n].cb != NULL) {
+      fast_irq.sources[n].cb(fast_irq.sources[n].arg,
+                             fast_irq.sources[n].data);
+    }
+  }
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the fast interrupts notification.
+ * @details The drain vector is enabled, fast ISRs can post notifications
+ *          after this call.
+ *
+ * @init
+ */
+void fastIrqInit(void) {
+  uint32_t i;
+
+  fast_irq.pending = 0U;
+  for (i = 0U; i < FAST_IRQ_NUM_SOURCES; i++) {
+    fast_irq.sources[i].cb   = NULL;
+    fast_irq.sources[i].arg  = NULL;
+    fast_irq.sources[i].data = 0U;
+  }
+
+  NVIC_SetPriority((IRQn_Type)FAST_IRQ_NUMBER, FAST_IRQ_PRIORITY);
+  NVIC_ClearPendingIRQ((IRQn_Type)FAST_IRQ_NUMBER);
+  NVIC_EnableIRQ((IRQn_Type)FAST_IRQ_NUMBER);
+}
+
+/**
+ * @brief   Associates a callback to a notification source.
+ * @details The callback is invoked from ISR context with the kernel
+ *          locked, only I-class and X-class functions can be called from
+ *          it, for example for waking threads or broadcasting events.
+ *
+ * @param[in] n         source number
+ * @param[in] cb        callback or @p NULL
+ * @param[in] arg       callback argument
+ *
+ * @iclass
+ */
+void fastIrqSetSourceI(uint32_t n, fastirqcb_t cb, void *arg) {
+
+  chDbgCheckClassI();
+  chDbgCheck(n < FAST_IRQ_NUM_SOURCES);
+
+  fast_irq.sources[n].cb  = cb;
+  fast_irq.sources[n].arg = arg;
+}
+
+/**
+ * @brief   Associates a callback to a notification source.
+ * @details The callback is invoked from ISR context with the kernel
+ *          locked, only I-class and X-class functions can be called from
+ *          it, for example for waking threads or broadcasting events.
+ *
+ * @param[in] n         source number
+ * @param[in] cb        callback or @p NULL
+ * @param[in] arg       callback argument
+ *
+ * @api
+ */
+void fastIrqSetSource(uint32_t n, fastirqcb_t cb, void *arg) {
+
+  chSysLock();
+  fastIrqSetSourceI(n, cb, arg);
+  chSysUnlock();
+}
+
+/** @} */
@@ -0,0 +1,185 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fast_irq.h
+ * @brief   Fast interrupts notification macros and structures.
+ * @details ISRs with priority above the kernel priority cannot call any
+ *          kernel API, this module allows them to post notifications which
+ *          are served from a software triggered vector at kernel priority.
+ *          The vector is specified by defining @p FAST_IRQ_NUMBER and
+ *          @p FAST_IRQ_HANDLER, for example in mcuconf.h.
+ *
+ * @addtogroup fast_irq
+ * @{
+ */
+
+#ifndef FAST_IRQ_H
+#define FAST_IRQ_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of notification sources.
+ */
+#define FAST_IRQ_NUM_SOURCES                32U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Priority of the drain vector.
+ * @note    The default is the highest kernel priority, this minimizes the
+ *          latency between a post and the callback.
+ */
+#if !defined(FAST_IRQ_PRIORITY) || defined(__DOXYGEN__)
+#define FAST_IRQ_PRIORITY                   CORTEX_MAX_KERNEL_PRIORITY
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/* The drain vector must be an unused vector of the device, it is only
+   triggered by software.*/
+#if !defined(FAST_IRQ_NUMBER)
+#error "FAST_IRQ_NUMBER not defined"
+#endif
+
+#if !defined(FAST_IRQ_HANDLER)
+#error "FAST_IRQ_HANDLER not defined"
+#endif
+
+#if CORTEX_SIMPLIFIED_PRIORITY == TRUE
+#error "fast interrupts notification requires advanced kernel mode"
+#endif
+
+#if !defined(PORT_ARCHITECTURE_ARM_v7M) &&                                  \
+    !defined(PORT_ARCHITECTURE_ARM_v7ME)
+#error "fast interrupts notification requires an ARMv7-M core"
+#endif
+
+#if !PORT_IRQ_IS_VALID_KERNEL_PRIORITY(FAST_IRQ_PRIORITY)
+#error "invalid FAST_IRQ_PRIORITY value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a notification callback.
+ *
+ * @param[in] arg       argument specified with the callback
+ * @param[in] data      data of the last post
+ */
+typedef void (*fastirqcb_t)(void *arg, uint32_t data);
+
+/**
+ * @brief   Type of a notification source.
+ */
+typedef struct {
+  /**
+   * @brief   Callback or @p NULL.
+   */
+  fastirqcb_t               cb;
+  /**
+   * @brief   Callback argument.
+   */
+  void                      *arg;
+  /**
+   * @brief   Data of the last post.
+   */
+  volatile uint32_t         data;
+} fast_irq_source_t;
+
+/**
+ * @brief   Type of the notifications queue.
+ */
+typedef struct {
+  /**
+   * @brief   Mask of the sources with pending notifications.
+   */
+  volatile uint32_t         pending;
+  /**
+   * @brief   Notification sources.
+   */
+  fast_irq_source_t         sources[FAST_IRQ_NUM_SOURCES];
+} fast_irq_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+extern fast_irq_t fast_irq;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void fastIrqInit(void);
+  void fastIrqSetSourceI(uint32_t n, fastirqcb_t cb, void *arg);
+  void fastIrqSetSource(uint32_t n, fastirqcb_t cb, void *arg);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Posts a notification.
+ * @details The notification is queued without locks and without masking
+ *          interrupts. The callback of the source is invoked later from
+ *          the drain vector.
+ * @note    This function can be called from ISRs above the kernel priority,
+ *          this is its intended use.
+ * @note    Notifications of the same source posted before the callback
+ *          runs are merged, the callback receives the data of the last
+ *          post.
+ *
+ * @param[in] n         source number
+ * @param[in] data      data to be passed to the callback
+ *
+ * @special
+ */
+static inline void fastIrqPostX(uint32_t n, uint32_t data) {
+  uint32_t pending;
+
+  chDbgCheck(n < FAST_IRQ_NUM_SOURCES);
+
+  /* Data written before making the notification visible.*/
+  fast_irq.sources[n].data = data;
+  __DMB();
+
+  /* Atomic update of the mask, posts from nested fast ISRs are retried.*/
+  do {
+    pending = __LDREXW(&fast_irq.pending);
+  } while (__STREXW(pending | (1U << n), &fast_irq.pending) != 0U);
+
+  NVIC_SetPendingIRQ((IRQn_Type)FAST_IRQ_NUMBER);
+}
+
+#endif /* FAST_IRQ_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Fast interrupts notification files.
+FASTIRQSRC = $(CHIBIOS)/os/various/fast_irq/fast_irq.c
+
+FASTIRQINC = $(CHIBIOS)/os/various/fast_irq
+
+# Shared variables
+ALLCSRC += $(FASTIRQSRC)
+ALLINC  += $(FASTIRQINC)
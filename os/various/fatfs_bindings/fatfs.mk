@@ -1,10 +1,13 @@
 # FATFS files.
 FATFSSRC = $(CHIBIOS)/os/various/fatfs_bindings/fatfs_diskio.c \
            $(CHIBIOS)/os/various/fatfs_bindings/fatfs_syscall.c \
+           $(CHIBIOS)/os/various/fatfs_bindings/fatfs_stream.c \
+           $(CHIBIOS)/os/various/fatfs_bindings/fatfs_log.c \
            $(CHIBIOS)/ext/fatfs/source/ff.c \
            $(CHIBIOS)/ext/fatfs/source/ffunicode.c
 
-FATFSINC = $(CHIBIOS)/ext/fatfs/source
+FATFSINC = $(CHIBIOS)/ext/fatfs/source \
+           $(CHIBIOS)/os/various/fatfs_bindings
 
 # Shared variables
 ALLCSRC += $(FATFSSRC)
@@ -30,6 +30,31 @@ extern SDCDriver FATFS_HAL_DEVICE;
 #error "MMC_SPI or SDC driver must be specified"
 #endif
 
+#if !defined(FATFS_USE_BLKCACHE)
+#define FATFS_USE_BLKCACHE FALSE
+#endif
+
+#if FATFS_USE_BLKCACHE == TRUE
+#include "blkcache.h"
+
+#if !defined(FATFS_BLKCACHE_DEVICE)
+#define FATFS_BLKCACHE_DEVICE BCD1
+#endif
+
+/* Sectors are read, written and synchronized through the cached block
+   device wrapping FATFS_HAL_DEVICE.*/
+extern CachedBlockDevice FATFS_BLKCACHE_DEVICE;
+#endif
+
+#include "fatfs_stream.h"
+
+/* Block device used by the streaming mode and the cached block device.*/
+#if FATFS_USE_BLKCACHE == TRUE
+#define FATFS_BLK_DEVICE ((BaseBlockDevice *)&FATFS_BLKCACHE_DEVICE)
+#else
+#define FATFS_BLK_DEVICE ((BaseBlockDevice *)&FATFS_HAL_DEVICE)
+#endif
+
 #if HAL_USE_RTC
 extern RTCDriver RTCD1;
 #endif
@@ -51,6 +76,12 @@ DSTATUS disk_initialize (
 {
   DSTATUS stat;
 
+#if FATFS_USE_STREAMING == TRUE
+  /* Buffered data of a previous mount is discarded.*/
+  if (pdrv == 0)
+    ffsInit(FATFS_BLK_DEVICE);
+#endif
+
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
   case MMC:
@@ -122,6 +153,20 @@ DRESULT disk_read (
     UINT count        /* Number of sectors to read (1..255) */
 )
 {
+#if (FATFS_USE_STREAMING == TRUE) || (FATFS_USE_BLKCACHE == TRUE)
+  if (pdrv == 0) {
+    if (blkGetDriverState(FATFS_BLK_DEVICE) != BLK_READY)
+      return RES_NOTRDY;
+#if FATFS_USE_STREAMING == TRUE
+    if (ffsRead(sector, buff, count))
+#else
+    if (blkRead(FATFS_BLK_DEVICE, sector, buff, count))
+#endif
+      return RES_ERROR;
+    return RES_OK;
+  }
+#endif
+
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
   case MMC:
@@ -163,6 +208,22 @@ DRESULT disk_write (
     UINT count        /* Number of sectors to write (1..255) */
 )
 {
+#if (FATFS_USE_STREAMING == TRUE) || (FATFS_USE_BLKCACHE == TRUE)
+  if (pdrv == 0) {
+    if (blkGetDriverState(FATFS_BLK_DEVICE) != BLK_READY)
+      return RES_NOTRDY;
+    if (blkIsWriteProtected(FATFS_BLK_DEVICE))
+      return RES_WRPRT;
+#if FATFS_USE_STREAMING == TRUE
+    if (ffsWrite(sector, buff, count))
+#else
+    if (blkWrite(FATFS_BLK_DEVICE, sector, buff, count))
+#endif
+      return RES_ERROR;
+    return RES_OK;
+  }
+#endif
+
   switch (pdrv) {
 #if HAL_USE_MMC_SPI
   case MMC:
@@ -212,6 +273,13 @@ DRESULT disk_ioctl (
   case MMC:
     switch (cmd) {
     case CTRL_SYNC:
+#if FATFS_USE_STREAMING == TRUE
+        if (ffsSync())
+            return RES_ERROR;
+#elif FATFS_USE_BLKCACHE == TRUE
+        if (blkSync(FATFS_BLK_DEVICE))
+            return RES_ERROR;
+#endif
         return RES_OK;
 #if FF_MAX_SS > FF_MIN_SS
     case GET_SECTOR_SIZE:
@@ -230,6 +298,13 @@ DRESULT disk_ioctl (
   case SDC:
     switch (cmd) {
     case CTRL_SYNC:
+#if FATFS_USE_STREAMING == TRUE
+        if (ffsSync())
+            return RES_ERROR;
+#elif FATFS_USE_BLKCACHE == TRUE
+        if (blkSync(FATFS_BLK_DEVICE))
+            return RES_ERROR;
+#endif
         return RES_OK;
     case GET_SECTOR_COUNT:
         *((DWORD *)buff) = mmcsdGetCardCapacity(&FATFS_HAL_DEVICE);
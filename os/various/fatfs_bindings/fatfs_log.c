@@ -0,0 +1,295 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_log.c
+ * @brief   FatFS bindings log files code.
+ *
+ * @addtogroup FATFS_LOG
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "ff.h"
+#include "diskio.h"
+#include "fatfs_log.h"
+
+#if (FATFS_USE_LOG == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Writes whole sectors of a log file.
+ * @details The sectors are written by the disk I/O layer in a single
+ *          multi-block transfer, the file is contiguous so the sector
+ *          address is computed from the file offset.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @param[in] buf       pointer to the data
+ * @param[in] offset    file offset, multiple of the sector size
+ * @param[in] n         number of sectors
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static FRESULT ffl_write_sectors(ffl_file_t *flp, const BYTE *buf,
+                                 FSIZE_t offset, UINT n) {
+
+  if (disk_write(flp->file.obj.fs->pdrv, buf,
+                 flp->sector + (LBA_t)(offset / FF_MAX_SS), n) != RES_OK) {
+    return FR_DISK_ERR;
+  }
+
+  return FR_OK;
+}
+
+/**
+ * @brief   Writes the buffered sectors of a log file.
+ * @details The whole sectors are written and removed from the buffer, the
+ *          partial sector is moved to the buffer start.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @param[in] partial   also writes the partial sector padded with zeros,
+ *                      it is kept in the buffer and rewritten later
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static FRESULT ffl_flush(ffl_file_t *flp, bool partial) {
+  BYTE *bp = (BYTE *)flp->buffer;
+  UINT n, rem;
+  FRESULT res;
+
+  n   = flp->count / FF_MAX_SS;
+  rem = flp->count % FF_MAX_SS;
+
+  if ((rem > 0U) && partial) {
+    memset(bp + flp->count, 0, FF_MAX_SS - rem);
+    res = ffl_write_sectors(flp, bp, flp->offset, n + 1U);
+  }
+  else if (n > 0U) {
+    res = ffl_write_sectors(flp, bp, flp->offset, n);
+  }
+  else {
+    return FR_OK;
+  }
+  if (res != FR_OK) {
+    return res;
+  }
+
+  if (n > 0U) {
+    memmove(bp, bp + (n * FF_MAX_SS), rem);
+    flp->offset += (FSIZE_t)n * FF_MAX_SS;
+    flp->count   = rem;
+  }
+
+  return FR_OK;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Creates a log file.
+ * @details The file is created with @p size bytes allocated in contiguous
+ *          clusters, the allocation is written to the media at this time
+ *          and the fast seek mode is enabled on the file.
+ * @note    An existing file with the same name is overwritten.
+ * @note    The file size on the media is the allocated size until the
+ *          file is closed.
+ *
+ * @param[out] flp      pointer to the @p ffl_file_t object
+ * @param[in] path      file path
+ * @param[in] size      size to be allocated in bytes
+ * @return              The operation status.
+ * @retval FR_OK        operation succeeded.
+ * @retval FR_DENIED    contiguous space not available.
+ *
+ * @api
+ */
+FRESULT fflOpen(ffl_file_t *flp, const TCHAR *path, FSIZE_t size) {
+  FRESULT res;
+  FATFS *fs;
+
+  osalDbgCheck((flp != NULL) && (path != NULL) && (size > (FSIZE_t)0));
+
+  res = f_open(&flp->file, path, FA_CREATE_ALWAYS | FA_WRITE);
+  if (res != FR_OK) {
+    return res;
+  }
+
+  /* Clusters allocated and chained at once, no metadata updates while
+     writing.*/
+  res = f_expand(&flp->file, size, 1);
+  if (res == FR_OK) {
+    /* The link map makes seeking independent from the file size.*/
+    flp->clmt[0]    = (DWORD)FFL_CLMT_SIZE;
+    flp->file.cltbl = flp->clmt;
+    res = f_lseek(&flp->file, CREATE_LINKMAP);
+  }
+  if (res != FR_OK) {
+    (void) f_close(&flp->file);
+    return res;
+  }
+
+  fs = flp->file.obj.fs;
+  flp->sector = fs->database +
+                ((LBA_t)fs->csize * (LBA_t)(flp->file.obj.sclust - 2U));
+  flp->offset = (FSIZE_t)0;
+  flp->count  = 0U;
+
+  return FR_OK;
+}
+
+/**
+ * @brief   Appends data to a log file.
+ * @details Data is collected in the write buffer and written when the
+ *          buffer is full. Large writes with nothing buffered are written
+ *          directly from the caller buffer if it is word aligned.
+ * @note    Writes exceeding the allocated size are truncated, the number
+ *          of written bytes is returned in @p bwp.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @param[in] buf       pointer to the data
+ * @param[in] n         number of bytes to write
+ * @param[out] bwp      pointer to the number of written bytes
+ * @return              The operation status.
+ *
+ * @api
+ */
+FRESULT fflWrite(ffl_file_t *flp, const void *buf, UINT n, UINT *bwp) {
+  const BYTE *p = (const BYTE *)buf;
+  FSIZE_t space;
+  FRESULT res;
+
+  osalDbgCheck((flp != NULL) && (buf != NULL) && (bwp != NULL));
+
+  *bwp  = 0U;
+  space = f_size(&flp->file) - fflGetSize(flp);
+  if ((FSIZE_t)n > space) {
+    n = (UINT)space;
+  }
+
+  while (n > 0U) {
+    UINT cnt;
+
+    if ((flp->count == 0U) && (n >= FFL_BUFFER_SIZE) &&
+        (((size_t)p & 3U) == 0U)) {
+      cnt = n - (n % FF_MAX_SS);
+      res = ffl_write_sectors(flp, p, flp->offset, cnt / FF_MAX_SS);
+      if (res != FR_OK) {
+        return res;
+      }
+      flp->offset += (FSIZE_t)cnt;
+    }
+    else {
+      cnt = FFL_BUFFER_SIZE - flp->count;
+      if (cnt > n) {
+        cnt = n;
+      }
+      memcpy((BYTE *)flp->buffer + flp->count, p, cnt);
+      flp->count += cnt;
+      if (flp->count == FFL_BUFFER_SIZE) {
+        res = ffl_flush(flp, false);
+        if (res != FR_OK) {
+          return res;
+        }
+      }
+    }
+
+    p    += cnt;
+    n    -= cnt;
+    *bwp += cnt;
+  }
+
+  return FR_OK;
+}
+
+/**
+ * @brief   Writes the buffered data of a log file to the media.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @return              The operation status.
+ *
+ * @api
+ */
+FRESULT fflSync(ffl_file_t *flp) {
+  FRESULT res;
+
+  osalDbgCheck(flp != NULL);
+
+  res = ffl_flush(flp, true);
+  if (res != FR_OK) {
+    return res;
+  }
+
+  return f_sync(&flp->file);
+}
+
+/**
+ * @brief   Closes a log file.
+ * @details The buffered data is written and the file is truncated to the
+ *          written size, the unused clusters are released.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @return              The operation status.
+ *
+ * @api
+ */
+FRESULT fflClose(ffl_file_t *flp) {
+  FRESULT res;
+
+  osalDbgCheck(flp != NULL);
+
+  res = ffl_flush(flp, true);
+  if (res == FR_OK) {
+    res = f_lseek(&flp->file, fflGetSize(flp));
+  }
+  if (res == FR_OK) {
+    res = f_truncate(&flp->file);
+  }
+  if (res != FR_OK) {
+    (void) f_close(&flp->file);
+    return res;
+  }
+
+  return f_close(&flp->file);
+}
+
+#endif /* FATFS_USE_LOG == TRUE */
+
+/** @} */
@@ -0,0 +1,177 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_log.h
+ * @brief   FatFS bindings log files macros and structures.
+ *
+ * @addtogroup FATFS_LOG
+ * @{
+ */
+
+#ifndef FATFS_LOG_H
+#define FATFS_LOG_H
+
+#include "ff.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the cluster link map table of a contiguous file.
+ * @details Table size, one fragment and the terminator.
+ */
+#define FFL_CLMT_SIZE                       4U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the log files support of the FatFS bindings.
+ * @details Log files are allocated contiguously on creation and written
+ *          directly to the device with multi-block transfers, bypassing
+ *          the FatFS sector buffers.
+ */
+#if !defined(FATFS_USE_LOG) || defined(__DOXYGEN__)
+#define FATFS_USE_LOG                       FALSE
+#endif
+
+/**
+ * @brief   Size of the log files write buffer in sectors.
+ */
+#if !defined(FFL_BUFFER_BLOCKS) || defined(__DOXYGEN__)
+#define FFL_BUFFER_BLOCKS                   8U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if FATFS_USE_LOG == TRUE
+
+#if FF_FS_READONLY != 0
+#error "FATFS_USE_LOG requires FF_FS_READONLY == 0"
+#endif
+
+#if FF_USE_EXPAND != 1
+#error "FATFS_USE_LOG requires FF_USE_EXPAND"
+#endif
+
+#if FF_USE_FASTSEEK != 1
+#error "FATFS_USE_LOG requires FF_USE_FASTSEEK"
+#endif
+
+#if FF_MAX_SS != FF_MIN_SS
+#error "FATFS_USE_LOG requires a fixed sector size"
+#endif
+
+#if FFL_BUFFER_BLOCKS < 1U
+#error "invalid FFL_BUFFER_BLOCKS value"
+#endif
+
+#endif /* FATFS_USE_LOG == TRUE */
+
+/**
+ * @brief   Size of the log files write buffer in bytes.
+ */
+#define FFL_BUFFER_SIZE                     (FFL_BUFFER_BLOCKS * FF_MAX_SS)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a log file.
+ */
+typedef struct {
+  /**
+   * @brief   FatFS file object.
+   */
+  FIL                   file;
+  /**
+   * @brief   Cluster link map table enabling the fast seek mode.
+   */
+  DWORD                 clmt[FFL_CLMT_SIZE];
+  /**
+   * @brief   First sector of the file data.
+   */
+  LBA_t                 sector;
+  /**
+   * @brief   File offset of the first byte in the write buffer.
+   * @note    It is always a multiple of the sector size.
+   */
+  FSIZE_t               offset;
+  /**
+   * @brief   Number of bytes in the write buffer.
+   */
+  UINT                  count;
+  /**
+   * @brief   Write buffer.
+   * @note    Declared as words in order to be usable as DMA buffer.
+   */
+  uint32_t              buffer[FFL_BUFFER_SIZE / 4U];
+} ffl_file_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the number of bytes written in a log file.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @return              The number of bytes written.
+ *
+ * @api
+ */
+#define fflGetSize(flp) ((flp)->offset + (FSIZE_t)(flp)->count)
+
+/**
+ * @brief   Returns the allocated size of a log file.
+ *
+ * @param[in] flp       pointer to the @p ffl_file_t object
+ * @return              The allocated size in bytes.
+ *
+ * @api
+ */
+#define fflGetAllocatedSize(flp) f_size(&(flp)->file)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (FATFS_USE_LOG == TRUE) || defined(__DOXYGEN__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+  FRESULT fflOpen(ffl_file_t *flp, const TCHAR *path, FSIZE_t size);
+  FRESULT fflWrite(ffl_file_t *flp, const void *buf, UINT n, UINT *bwp);
+  FRESULT fflSync(ffl_file_t *flp);
+  FRESULT fflClose(ffl_file_t *flp);
+#ifdef __cplusplus
+}
+#endif
+#endif /* FATFS_USE_LOG == TRUE */
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* FATFS_LOG_H */
+
+/** @} */
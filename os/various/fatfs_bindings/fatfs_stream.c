@@ -0,0 +1,588 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_stream.c
+ * @brief   FatFS bindings streaming mode code.
+ *
+ * @addtogroup FATFS_STREAM
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "ff.h"
+#include "fatfs_stream.h"
+
+#if (FATFS_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the read-ahead window in sectors.
+ */
+#define FFS_WINDOW_BLOCKS       (FFS_READ_BUFFERS * FFS_BUFFER_BLOCKS)
+
+/**
+ * @brief   Size of a buffer in words.
+ */
+#define FFS_BUFFER_WORDS        ((FFS_BUFFER_BLOCKS * FFS_BLOCK_SIZE) / 4U)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Read-ahead buffer states.
+ */
+typedef enum {
+  FFS_EMPTY = 0,                    /**< Not in use.                        */
+  FFS_QUEUED = 1,                   /**< Waiting for the read-ahead thread. */
+  FFS_READING = 2,                  /**< Read in progress.                  */
+  FFS_VALID = 3,                    /**< Contains valid data.               */
+  FFS_FAILED = 4                    /**< Read failed.                       */
+} ffs_bufstate_t;
+
+/**
+ * @brief   Type of a read-ahead buffer.
+ */
+typedef struct {
+  /**
+   * @brief   Buffer state.
+   */
+  ffs_bufstate_t        state;
+  /**
+   * @brief   First sector in the buffer.
+   */
+  uint32_t              start;
+  /**
+   * @brief   Pointer to the buffer data.
+   */
+  uint8_t               *data;
+} ffs_buffer_t;
+
+/**
+ * @brief   Type of the streaming mode state.
+ */
+typedef struct {
+  /**
+   * @brief   Block device.
+   */
+  BaseBlockDevice       *blkp;
+  /**
+   * @brief   Device size in sectors or zero if unknown.
+   */
+  uint32_t              blk_num;
+  /**
+   * @brief   Mutex protecting the read-ahead buffers.
+   */
+  mutex_t               mtx;
+  /**
+   * @brief   Mutex serializing the device accesses.
+   */
+  mutex_t               devmtx;
+  /**
+   * @brief   Signaled when a buffer is queued.
+   */
+  condition_variable_t  reqcond;
+  /**
+   * @brief   Broadcasted when a buffer read is complete.
+   */
+  condition_variable_t  donecond;
+  /**
+   * @brief   Read-ahead buffers ring.
+   */
+  ffs_buffer_t          rbuf[FFS_READ_BUFFERS];
+  /**
+   * @brief   Sector following the last read.
+   */
+  uint32_t              next;
+  /**
+   * @brief   Sector following the last queued read-ahead.
+   */
+  uint32_t              ahead;
+  /**
+   * @brief   First sector in the write buffer.
+   */
+  uint32_t              wstart;
+  /**
+   * @brief   Number of sectors in the write buffer.
+   */
+  uint32_t              wn;
+  /**
+   * @brief   Read-ahead thread.
+   */
+  thread_t              *tp;
+} ffs_stream_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Streaming mode state.
+ */
+static ffs_stream_t ffss;
+
+/**
+ * @brief   Read-ahead buffers data.
+ * @note    Declared as words in order to be usable as DMA buffers.
+ */
+static uint32_t ffs_rdata[FFS_READ_BUFFERS][FFS_BUFFER_WORDS];
+
+/**
+ * @brief   Write buffer data.
+ */
+static uint32_t ffs_wdata[FFS_BUFFER_WORDS];
+
+/**
+ * @brief   Read-ahead thread working area.
+ */
+static THD_WORKING_AREA(ffs_wa, FFS_THREAD_STACK_SIZE);
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool ffs_overlaps(uint32_t s1, uint32_t n1, uint32_t s2, uint32_t n2) {
+
+  return (s1 < (s2 + n2)) && (s2 < (s1 + n1));
+}
+
+static bool ffs_dev_read(uint32_t startblk, uint8_t *buf, uint32_t n) {
+  bool err;
+
+  chMtxLock(&ffss.devmtx);
+  err = blkRead(ffss.blkp, startblk, buf, n);
+  chMtxUnlock(&ffss.devmtx);
+
+  return err;
+}
+
+static bool ffs_dev_write(uint32_t startblk, const uint8_t *buf, uint32_t n) {
+  bool err;
+
+  chMtxLock(&ffss.devmtx);
+  err = blkWrite(ffss.blkp, startblk, buf, n);
+  chMtxUnlock(&ffss.devmtx);
+
+  return err;
+}
+
+/**
+ * @brief   Waits for the completion of a buffer read in progress.
+ * @note    Must be called with the buffers mutex locked.
+ *
+ * @param[in] bp        pointer to the buffer
+ *
+ * @notapi
+ */
+static void ffs_wait_idle(ffs_buffer_t *bp) {
+
+  while (bp->state == FFS_READING) {
+    (void) chCondWait(&ffss.donecond);
+  }
+}
+
+/**
+ * @brief   Discards the read-ahead buffers overlapping a range.
+ * @note    Must be called with the buffers mutex locked.
+ *
+ * @param[in] startblk  first sector of the range
+ * @param[in] n         number of sectors in the range
+ *
+ * @notapi
+ */
+static void ffs_discard(uint32_t startblk, uint32_t n) {
+  ucnt_t i;
+
+  for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+    ffs_buffer_t *bp = &ffss.rbuf[i];
+
+    if ((bp->state != FFS_EMPTY) &&
+        ffs_overlaps(bp->start, FFS_BUFFER_BLOCKS, startblk, n)) {
+      ffs_wait_idle(bp);
+      bp->state = FFS_EMPTY;
+    }
+  }
+}
+
+/**
+ * @brief   Writes the merged sectors.
+ * @details Read-ahead buffers overlapping the written sectors could have
+ *          been read before the write and are discarded.
+ *
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static bool ffs_flush(void) {
+  bool err;
+
+  if (ffss.wn == 0U) {
+    return HAL_SUCCESS;
+  }
+
+  err = ffs_dev_write(ffss.wstart, (uint8_t *)ffs_wdata, ffss.wn);
+
+  chMtxLock(&ffss.mtx);
+  ffs_discard(ffss.wstart, ffss.wn);
+  chMtxUnlock(&ffss.mtx);
+
+  ffss.wn = 0U;
+
+  return err;
+}
+
+/**
+ * @brief   Returns the read-ahead buffer containing a sector.
+ * @note    Must be called with the buffers mutex locked.
+ *
+ * @param[in] blk       sector number
+ * @return              The buffer or @p NULL if not found.
+ *
+ * @notapi
+ */
+static ffs_buffer_t *ffs_find(uint32_t blk) {
+  ucnt_t i;
+
+  for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+    ffs_buffer_t *bp = &ffss.rbuf[i];
+
+    if ((bp->state != FFS_EMPTY) && (blk >= bp->start) &&
+        ((blk - bp->start) < FFS_BUFFER_BLOCKS)) {
+      return bp;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Queues the read-ahead of the sectors following the last read.
+ * @details Buffers outside the read-ahead window are recycled, the free
+ *          buffers are queued to the read-ahead thread in ascending
+ *          order.
+ * @note    Must be called with the buffers mutex locked.
+ *
+ * @notapi
+ */
+static void ffs_read_ahead(void) {
+  uint32_t wend = ffss.next + FFS_WINDOW_BLOCKS;
+  ucnt_t i;
+
+  /* Restarting from the last read if the previous read-ahead is not
+     related to this stream.*/
+  if ((ffss.ahead < ffss.next) || (ffss.ahead > wend)) {
+    ffss.ahead = ffss.next;
+  }
+
+  /* Recycling stale buffers, buffers being read are left alone.*/
+  for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+    ffs_buffer_t *bp = &ffss.rbuf[i];
+
+    if ((bp->state != FFS_EMPTY) && (bp->state != FFS_READING) &&
+        !ffs_overlaps(bp->start, FFS_BUFFER_BLOCKS,
+                      ffss.next, FFS_WINDOW_BLOCKS)) {
+      bp->state = FFS_EMPTY;
+    }
+  }
+
+  for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+    ffs_buffer_t *bp = &ffss.rbuf[i];
+
+    if ((ffss.ahead + FFS_BUFFER_BLOCKS > wend) ||
+        ((ffss.blk_num > 0U) &&
+         (ffss.ahead + FFS_BUFFER_BLOCKS > ffss.blk_num))) {
+      break;
+    }
+
+    if (bp->state == FFS_EMPTY) {
+      bp->start = ffss.ahead;
+      bp->state = FFS_QUEUED;
+      ffss.ahead += FFS_BUFFER_BLOCKS;
+      chCondSignal(&ffss.reqcond);
+    }
+  }
+}
+
+/**
+ * @brief   Read-ahead thread.
+ */
+static THD_FUNCTION(ffs_thread, arg) {
+
+  (void)arg;
+  chRegSetThreadName("fatfs_stream");
+
+  chMtxLock(&ffss.mtx);
+  while (true) {
+    ffs_buffer_t *bp = NULL;
+    ucnt_t i;
+    bool err;
+
+    /* Serving the queued buffers in ascending sectors order.*/
+    for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+      if ((ffss.rbuf[i].state == FFS_QUEUED) &&
+          ((bp == NULL) || (ffss.rbuf[i].start < bp->start))) {
+        bp = &ffss.rbuf[i];
+      }
+    }
+
+    if (bp == NULL) {
+      (void) chCondWait(&ffss.reqcond);
+      continue;
+    }
+
+    bp->state = FFS_READING;
+    chMtxUnlock(&ffss.mtx);
+    err = ffs_dev_read(bp->start, bp->data, FFS_BUFFER_BLOCKS);
+    chMtxLock(&ffss.mtx);
+    bp->state = err ? FFS_FAILED : FFS_VALID;
+    chCondBroadcast(&ffss.donecond);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the streaming mode.
+ * @details The read-ahead thread is created on the first call, subsequent
+ *          calls discard the buffered data.
+ * @note    Sectors merged and not yet written are discarded, the volume
+ *          must be synchronized before being initialized again.
+ *
+ * @param[in] blkp      pointer to the block device
+ *
+ * @api
+ */
+void ffsInit(BaseBlockDevice *blkp) {
+  BlockDeviceInfo bdi;
+  ucnt_t i;
+
+  osalDbgCheck(blkp != NULL);
+
+  if (ffss.tp == NULL) {
+    chMtxObjectInit(&ffss.mtx);
+    chMtxObjectInit(&ffss.devmtx);
+    chCondObjectInit(&ffss.reqcond);
+    chCondObjectInit(&ffss.donecond);
+    for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+      ffss.rbuf[i].state = FFS_EMPTY;
+      ffss.rbuf[i].data  = (uint8_t *)ffs_rdata[i];
+    }
+    ffss.blkp = blkp;
+    ffss.tp   = chThdCreateStatic(ffs_wa, sizeof (ffs_wa),
+                                 FFS_THREAD_PRIORITY, ffs_thread, NULL);
+  }
+  else {
+    chMtxLock(&ffss.mtx);
+    for (i = (ucnt_t)0; i < (ucnt_t)FFS_READ_BUFFERS; i++) {
+      ffs_wait_idle(&ffss.rbuf[i]);
+      ffss.rbuf[i].state = FFS_EMPTY;
+    }
+    ffss.blkp = blkp;
+    chMtxUnlock(&ffss.mtx);
+  }
+
+  ffss.next    = 0U;
+  ffss.ahead   = 0U;
+  ffss.wn      = 0U;
+  ffss.blk_num = blkGetInfo(blkp, &bdi) == HAL_SUCCESS ? bdi.blk_num : 0U;
+}
+
+/**
+ * @brief   Reads one or more sectors.
+ * @details Sectors are taken from the read-ahead buffers when available,
+ *          a read starting where the previous one ended queues the
+ *          read-ahead of the following sectors.
+ *
+ * @param[in] startblk  first sector to read
+ * @param[out] buf      pointer to the read buffer
+ * @param[in] n         number of sectors to read
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool ffsRead(uint32_t startblk, uint8_t *buf, uint32_t n) {
+  bool sequential;
+
+  osalDbgCheck((buf != NULL) && (n > 0U));
+
+  /* Merged sectors in the range must reach the device first.*/
+  if ((ffss.wn > 0U) && ffs_overlaps(startblk, n, ffss.wstart, ffss.wn)) {
+    if (ffs_flush()) {
+      return HAL_FAILED;
+    }
+  }
+
+  chMtxLock(&ffss.mtx);
+
+  sequential = (startblk == ffss.next);
+  ffss.next   = startblk + n;
+
+  while (n > 0U) {
+    ffs_buffer_t *bp = ffs_find(startblk);
+    uint32_t offset, cnt;
+
+    if (bp == NULL) {
+      bool err;
+
+      /* Not read ahead, reading the remaining sectors directly.*/
+      chMtxUnlock(&ffss.mtx);
+      err = ffs_dev_read(startblk, buf, n);
+      chMtxLock(&ffss.mtx);
+      if (err) {
+        chMtxUnlock(&ffss.mtx);
+        return HAL_FAILED;
+      }
+      break;
+    }
+
+    while ((bp->state == FFS_QUEUED) || (bp->state == FFS_READING)) {
+      (void) chCondWait(&ffss.donecond);
+    }
+
+    /* Failed read-ahead, the sectors are read again directly.*/
+    if (bp->state != FFS_VALID) {
+      bp->state = FFS_EMPTY;
+      continue;
+    }
+
+    offset = startblk - bp->start;
+    cnt    = FFS_BUFFER_BLOCKS - offset;
+    if (cnt > n) {
+      cnt = n;
+    }
+    memcpy(buf, bp->data + (offset * FFS_BLOCK_SIZE), cnt * FFS_BLOCK_SIZE);
+    startblk += cnt;
+    buf      += cnt * FFS_BLOCK_SIZE;
+    n        -= cnt;
+
+    /* Fully consumed buffers are recycled.*/
+    if ((offset + cnt) == FFS_BUFFER_BLOCKS) {
+      bp->state = FFS_EMPTY;
+    }
+  }
+
+  if (sequential) {
+    ffs_read_ahead();
+  }
+
+  chMtxUnlock(&ffss.mtx);
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes one or more sectors.
+ * @details Adjacent writes are merged in the write buffer and written in
+ *          a single multi-block transfer when the buffer is full, when a
+ *          non adjacent sector is written, when an overlapping range is
+ *          read and on synchronization.
+ * @note    Failures writing merged sectors are reported by the operation
+ *          causing the write.
+ *
+ * @param[in] startblk  first sector to write
+ * @param[in] buf       pointer to the write buffer
+ * @param[in] n         number of sectors to write
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool ffsWrite(uint32_t startblk, const uint8_t *buf, uint32_t n) {
+
+  osalDbgCheck((buf != NULL) && (n > 0U));
+
+  /* Read-ahead data in the range becomes stale.*/
+  chMtxLock(&ffss.mtx);
+  ffs_discard(startblk, n);
+  chMtxUnlock(&ffss.mtx);
+
+  if (ffss.wn > 0U) {
+    /* Sectors already in the write buffer are updated in place.*/
+    if ((startblk >= ffss.wstart) &&
+        ((startblk + n) <= (ffss.wstart + ffss.wn))) {
+      memcpy((uint8_t *)ffs_wdata +
+             ((startblk - ffss.wstart) * FFS_BLOCK_SIZE),
+             buf, n * FFS_BLOCK_SIZE);
+      return HAL_SUCCESS;
+    }
+
+    /* Adjacent sectors are appended if there is space.*/
+    if ((startblk == (ffss.wstart + ffss.wn)) &&
+        ((ffss.wn + n) <= FFS_BUFFER_BLOCKS)) {
+      memcpy((uint8_t *)ffs_wdata + (ffss.wn * FFS_BLOCK_SIZE),
+             buf, n * FFS_BLOCK_SIZE);
+      ffss.wn += n;
+      return HAL_SUCCESS;
+    }
+
+    if (ffs_flush()) {
+      return HAL_FAILED;
+    }
+  }
+
+  /* Large writes are already multi-block transfers.*/
+  if (n >= FFS_BUFFER_BLOCKS) {
+    return ffs_dev_write(startblk, buf, n);
+  }
+
+  memcpy(ffs_wdata, buf, n * FFS_BLOCK_SIZE);
+  ffss.wstart = startblk;
+  ffss.wn     = n;
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief   Writes the merged sectors and synchronizes the device.
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool ffsSync(void) {
+  bool err;
+
+  err = ffs_flush();
+
+  chMtxLock(&ffss.devmtx);
+  if (blkSync(ffss.blkp)) {
+    err = HAL_FAILED;
+  }
+  chMtxUnlock(&ffss.devmtx);
+
+  return err;
+}
+
+#endif /* FATFS_USE_STREAMING == TRUE */
+
+/** @} */
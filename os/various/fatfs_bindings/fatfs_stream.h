@@ -0,0 +1,140 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    fatfs_stream.h
+ * @brief   FatFS bindings streaming mode macros and structures.
+ *
+ * @addtogroup FATFS_STREAM
+ * @{
+ */
+
+#ifndef FATFS_STREAM_H
+#define FATFS_STREAM_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the streaming mode of the FatFS bindings.
+ * @details Sequential reads are detected and the following sectors are
+ *          read ahead by a worker thread, adjacent writes are merged into
+ *          multi-block transfers.
+ */
+#if !defined(FATFS_USE_STREAMING) || defined(__DOXYGEN__)
+#define FATFS_USE_STREAMING                 FALSE
+#endif
+
+/**
+ * @brief   Sector size.
+ */
+#if !defined(FFS_BLOCK_SIZE) || defined(__DOXYGEN__)
+#define FFS_BLOCK_SIZE                      512U
+#endif
+
+/**
+ * @brief   Number of read-ahead buffers in the ring.
+ */
+#if !defined(FFS_READ_BUFFERS) || defined(__DOXYGEN__)
+#define FFS_READ_BUFFERS                    2U
+#endif
+
+/**
+ * @brief   Size of the read-ahead and write buffers in sectors.
+ */
+#if !defined(FFS_BUFFER_BLOCKS) || defined(__DOXYGEN__)
+#define FFS_BUFFER_BLOCKS                   8U
+#endif
+
+/**
+ * @brief   Read-ahead thread priority.
+ */
+#if !defined(FFS_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define FFS_THREAD_PRIORITY                 NORMALPRIO
+#endif
+
+/**
+ * @brief   Read-ahead thread stack size.
+ */
+#if !defined(FFS_THREAD_STACK_SIZE) || defined(__DOXYGEN__)
+#define FFS_THREAD_STACK_SIZE               512U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if FATFS_USE_STREAMING == TRUE
+
+#if CH_CFG_USE_MUTEXES != TRUE
+#error "FATFS_USE_STREAMING requires CH_CFG_USE_MUTEXES"
+#endif
+
+#if CH_CFG_USE_CONDVARS != TRUE
+#error "FATFS_USE_STREAMING requires CH_CFG_USE_CONDVARS"
+#endif
+
+#if FFS_READ_BUFFERS < 1U
+#error "invalid FFS_READ_BUFFERS value"
+#endif
+
+#if FFS_BUFFER_BLOCKS < 2U
+#error "invalid FFS_BUFFER_BLOCKS value"
+#endif
+
+#if (FFS_BLOCK_SIZE % 4U) != 0U
+#error "FFS_BLOCK_SIZE must be a multiple of 4"
+#endif
+
+#endif /* FATFS_USE_STREAMING == TRUE */
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (FATFS_USE_STREAMING == TRUE) || defined(__DOXYGEN__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ffsInit(BaseBlockDevice *blkp);
+  bool ffsRead(uint32_t startblk, uint8_t *buf, uint32_t n);
+  bool ffsWrite(uint32_t startblk, const uint8_t *buf, uint32_t n);
+  bool ffsSync(void);
+#ifdef __cplusplus
+}
+#endif
+#endif /* FATFS_USE_STREAMING == TRUE */
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* FATFS_STREAM_H */
+
+/** @} */
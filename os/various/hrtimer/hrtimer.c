@@ -0,0 +1,344 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hrtimer.c
+ * @brief   High resolution timers code.
+ * @details Each armed timer occupies an alarm channel of the system timer
+ *          when one is available. When all channels are in use a timer
+ *          with a nearer deadline than the farthest one on a channel takes
+ *          that channel and the displaced timer continues on the virtual
+ *          timers list, otherwise the new timer goes to the virtual timers
+ *          list. Timers are not moved back from the virtual timers list
+ *          when a channel becomes free.
+ * @note    The callbacks are invoked from ISR context with the kernel
+ *          unlocked, the same rules of the virtual timers callbacks apply.
+ *
+ * @addtogroup hrtimer
+ * @{
+ */
+
+#include "hal.h"
+#include "hrtimer.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Module state.
+ */
+static struct {
+#if (HRT_NUM_ALARMS > 0U) || defined(__DOXYGEN__)
+  /**
+   * @brief   Timers served by the alarm channels.
+   */
+  hrtimer_t                 *alarms[HRT_NUM_ALARMS];
+#endif
+  /**
+   * @brief   Statistics.
+   */
+  hrt_stats_t               stats;
+} hrt;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Time remaining before a deadline.
+ * @details Deadlines more than half the system time range away are
+ *          considered in the past.
+ *
+ * @param[in] now       current system time
+ * @param[in] deadline  the deadline
+ * @return              The remaining time, zero if the deadline passed.
+ */
+static sysinterval_t hrt_remaining(systime_t now, systime_t deadline) {
+  sysinterval_t delta = chTimeDiffX(now, deadline);
+
+  if (delta > ((sysinterval_t)TIME_MAX_SYSTIME >> 1)) {
+    return (sysinterval_t)0;
+  }
+
+  return delta;
+}
+
+/**
+ * @brief   Virtual timers fallback callback.
+ *
+ * @param[in] p         pointer to the @p hrtimer_t object
+ */
+static void hrt_vt_cb(void *p) {
+  hrtimer_t *hrtp = (hrtimer_t *)p;
+  vtfunc_t fn;
+
+  chSysLockFromISR();
+  fn = hrtp->func;
+  p  = hrtp->par;
+  hrtp->func = NULL;
+  chSysUnlockFromISR();
+
+  if (fn != NULL) {
+    fn(p);
+  }
+}
+
+/**
+ * @brief   Places a timer on the virtual timers list.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] delay     remaining delay
+ */
+static void hrt_vt_set(hrtimer_t *hrtp, sysinterval_t delay) {
+
+  if (delay == (sysinterval_t)0) {
+    delay = (sysinterval_t)1;
+  }
+  hrtp->alarm = 0U;
+  chVTSetI(&hrtp->vt, delay, hrt_vt_cb, (void *)hrtp);
+}
+
+#if (HRT_NUM_ALARMS > 0U) || defined(__DOXYGEN__)
+/**
+ * @brief   Alarm channels callback.
+ *
+ * @param[in] alarm     the expired alarm channel
+ */
+static void hrt_st_cb(unsigned alarm) {
+  hrtimer_t *hrtp;
+  vtfunc_t fn = NULL;
+  void *par = NULL;
+
+  chSysLockFromISR();
+  stStopAlarmN(alarm);
+  hrtp = hrt.alarms[alarm - HRT_FIRST_ALARM];
+  hrt.alarms[alarm - HRT_FIRST_ALARM] = NULL;
+  if (hrtp != NULL) {
+    fn  = hrtp->func;
+    par = hrtp->par;
+    hrtp->func  = NULL;
+    hrtp->alarm = 0U;
+  }
+  chSysUnlockFromISR();
+
+  if (fn != NULL) {
+    fn(par);
+  }
+}
+
+/**
+ * @brief   Assigns an alarm channel to a timer.
+ * @details A free channel is used if available, else the channel serving
+ *          the farthest deadline is taken if that deadline comes after the
+ *          new one.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] now       current system time
+ * @param[in] delay     delay of the new timer
+ * @return              The assigned channel or zero.
+ */
+static unsigned hrt_alarm_alloc(hrtimer_t *hrtp,
+                                systime_t now,
+                                sysinterval_t delay) {
+  sysinterval_t farthest = delay;
+  unsigned i, victim = HRT_NUM_ALARMS;
+
+  for (i = 0U; i < HRT_NUM_ALARMS; i++) {
+    sysinterval_t remaining;
+
+    if (hrt.alarms[i] == NULL) {
+      victim = i;
+      break;
+    }
+
+    /* Channels about to expire are never taken.*/
+    remaining = hrt_remaining(now, hrt.alarms[i]->deadline);
+    if (remaining > farthest) {
+      farthest = remaining;
+      victim   = i;
+    }
+  }
+
+  if (victim == HRT_NUM_ALARMS) {
+    return 0U;
+  }
+
+  /* The displaced timer continues on the virtual timers list.*/
+  if (hrt.alarms[victim] != NULL) {
+    stStopAlarmN(victim + HRT_FIRST_ALARM);
+    hrt_vt_set(hrt.alarms[victim], farthest);
+    hrt.stats.displaced++;
+  }
+
+  hrt.alarms[victim] = hrtp;
+
+  return victim + HRT_FIRST_ALARM;
+}
+#endif /* HRT_NUM_ALARMS > 0U */
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Module initialization.
+ * @note    The function must be invoked after @p halInit() and before
+ *          arming any timer.
+ *
+ * @init
+ */
+void hrtInit(void) {
+#if HRT_NUM_ALARMS > 0U
+  unsigned i;
+
+  for (i = 0U; i < HRT_NUM_ALARMS; i++) {
+    hrt.alarms[i] = NULL;
+  }
+#endif
+  hrt.stats.alarms    = (ucnt_t)0;
+  hrt.stats.fallbacks = (ucnt_t)0;
+  hrt.stats.displaced = (ucnt_t)0;
+}
+
+/**
+ * @brief   Initializes a @p hrtimer_t object.
+ *
+ * @param[out] hrtp     pointer to the @p hrtimer_t object
+ *
+ * @init
+ */
+void hrtObjectInit(hrtimer_t *hrtp) {
+
+  chDbgCheck(hrtp != NULL);
+
+  chVTObjectInit(&hrtp->vt);
+  hrtp->func  = NULL;
+  hrtp->par   = NULL;
+  hrtp->alarm = 0U;
+}
+
+/**
+ * @brief   Arms a timer at an absolute deadline.
+ * @details The timer is served by an alarm channel if one can be assigned,
+ *          else by the virtual timers.
+ * @note    Deadlines closer than @p HRT_MIN_DELAY ticks, or in the past,
+ *          are moved to @p HRT_MIN_DELAY ticks from now. Deadlines more
+ *          than half the system time range away are considered in the past.
+ * @note    If the timer is already armed then it is re-armed.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] deadline  expiration time
+ * @param[in] func      the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+void hrtSetAtI(hrtimer_t *hrtp, systime_t deadline,
+               vtfunc_t func, void *par) {
+  systime_t now;
+  sysinterval_t delay;
+
+  chDbgCheckClassI();
+  chDbgCheck((hrtp != NULL) && (func != NULL));
+
+  hrtResetI(hrtp);
+
+  now   = chVTGetSystemTimeX();
+  delay = hrt_remaining(now, deadline);
+  if (delay < (sysinterval_t)HRT_MIN_DELAY) {
+    delay    = (sysinterval_t)HRT_MIN_DELAY;
+    deadline = chTimeAddX(now, delay);
+  }
+
+  hrtp->func     = func;
+  hrtp->par      = par;
+  hrtp->deadline = deadline;
+
+#if HRT_NUM_ALARMS > 0U
+  hrtp->alarm = hrt_alarm_alloc(hrtp, now, delay);
+  if (hrtp->alarm != 0U) {
+    stStartAlarmN(hrtp->alarm, deadline, hrt_st_cb);
+    hrt.stats.alarms++;
+    return;
+  }
+#endif
+
+  hrt_vt_set(hrtp, delay);
+  hrt.stats.fallbacks++;
+}
+
+/**
+ * @brief   Disarms a timer.
+ * @note    The function has no effect if the timer is not armed.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ *
+ * @iclass
+ */
+void hrtResetI(hrtimer_t *hrtp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(hrtp != NULL);
+
+  if (hrtp->func == NULL) {
+    return;
+  }
+
+#if HRT_NUM_ALARMS > 0U
+  if (hrtp->alarm != 0U) {
+    stStopAlarmN(hrtp->alarm);
+    hrt.alarms[hrtp->alarm - HRT_FIRST_ALARM] = NULL;
+    hrtp->alarm = 0U;
+  }
+  else
+#endif
+  if (chVTIsArmedI(&hrtp->vt)) {
+    chVTResetI(&hrtp->vt);
+  }
+
+  hrtp->func = NULL;
+}
+
+/**
+ * @brief   Returns the module statistics.
+ *
+ * @param[out] sp       pointer to the statistics to be filled
+ *
+ * @iclass
+ */
+void hrtGetStatsI(hrt_stats_t *sp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(sp != NULL);
+
+  *sp = hrt.stats;
+}
+
+/** @} */
@@ -0,0 +1,263 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hrtimer.h
+ * @brief   High resolution timers macros and structures.
+ * @details One-shot timers served by the additional alarm channels of the
+ *          system timer, the callback is invoked by the channel compare
+ *          interrupt at the exact deadline instead of by the virtual
+ *          timers processing. When all the channels are in use the timers
+ *          with the farthest deadlines are served by the virtual timers.
+ *
+ * @addtogroup hrtimer
+ * @{
+ */
+
+#ifndef HRTIMER_H
+#define HRTIMER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   First system timer alarm channel used by the module.
+ */
+#if !defined(HRT_FIRST_ALARM) || defined(__DOXYGEN__)
+#define HRT_FIRST_ALARM                     1U
+#endif
+
+/**
+ * @brief   Last system timer alarm channel used by the module.
+ * @note    The default is the last channel of the system timer, channels
+ *          can be reserved to the application by reducing the range.
+ */
+#if !defined(HRT_LAST_ALARM) || defined(__DOXYGEN__)
+#define HRT_LAST_ALARM                      (ST_LLD_NUM_ALARMS - 1U)
+#endif
+
+/**
+ * @brief   Minimum distance in ticks of a deadline from the current time.
+ * @details Closer deadlines are moved forward, the compare event would
+ *          otherwise be missed.
+ */
+#if !defined(HRT_MIN_DELAY) || defined(__DOXYGEN__)
+#define HRT_MIN_DELAY                       2U
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of alarm channels used by the module.
+ * @note    Zero when the system timer is not free running or has no
+ *          additional channels, all the timers are then served by the
+ *          virtual timers.
+ */
+#if ((OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING) &&                          \
+     (ST_LLD_NUM_ALARMS > 1) && (HRT_LAST_ALARM >= HRT_FIRST_ALARM)) ||     \
+    defined(__DOXYGEN__)
+#define HRT_NUM_ALARMS                      ((HRT_LAST_ALARM -               \
+                                              HRT_FIRST_ALARM) + 1U)
+#else
+#define HRT_NUM_ALARMS                      0U
+#endif
+
+#if HRT_NUM_ALARMS > 0U
+#if HRT_FIRST_ALARM < 1U
+#error "invalid HRT_FIRST_ALARM value"
+#endif
+
+#if HRT_LAST_ALARM > (ST_LLD_NUM_ALARMS - 1U)
+#error "invalid HRT_LAST_ALARM value"
+#endif
+
+#if HRT_MIN_DELAY < 2U
+#error "invalid HRT_MIN_DELAY value"
+#endif
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a high resolution timer.
+ */
+typedef struct {
+  /**
+   * @brief   Virtual timer used when no alarm channel is available.
+   */
+  virtual_timer_t           vt;
+  /**
+   * @brief   Callback function or @p NULL if the timer is not armed.
+   */
+  vtfunc_t                  func;
+  /**
+   * @brief   Callback function parameter.
+   */
+  void                      *par;
+  /**
+   * @brief   Expiration time.
+   */
+  systime_t                 deadline;
+  /**
+   * @brief   Alarm channel serving the timer or zero.
+   */
+  unsigned                  alarm;
+} hrtimer_t;
+
+/**
+ * @brief   Type of the module statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Timers served by an alarm channel.
+   */
+  ucnt_t                    alarms;
+  /**
+   * @brief   Timers served by the virtual timers.
+   */
+  ucnt_t                    fallbacks;
+  /**
+   * @brief   Timers moved from a channel to the virtual timers by timers
+   *          with a nearer deadline.
+   */
+  ucnt_t                    displaced;
+} hrt_stats_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void hrtInit(void);
+  void hrtObjectInit(hrtimer_t *hrtp);
+  void hrtSetAtI(hrtimer_t *hrtp, systime_t deadline,
+                 vtfunc_t func, void *par);
+  void hrtResetI(hrtimer_t *hrtp);
+  void hrtGetStatsI(hrt_stats_t *sp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns @p true if the specified timer is armed.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @return              true if the timer is armed.
+ *
+ * @iclass
+ */
+static inline bool hrtIsArmedI(const hrtimer_t *hrtp) {
+
+  chDbgCheckClassI();
+
+  return (bool)(hrtp->func != NULL);
+}
+
+/**
+ * @brief   Arms a timer after a delay.
+ * @details The deadline is computed from the current system time, see
+ *          @p hrtSetAtI().
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] delay     delay in system ticks
+ * @param[in] func      the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @iclass
+ */
+static inline void hrtSetI(hrtimer_t *hrtp, sysinterval_t delay,
+                           vtfunc_t func, void *par) {
+
+  hrtSetAtI(hrtp, chTimeAddX(chVTGetSystemTimeX(), delay), func, par);
+}
+
+/**
+ * @brief   Arms a timer at an absolute deadline.
+ * @details See @p hrtSetAtI().
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] deadline  expiration time
+ * @param[in] func      the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @api
+ */
+static inline void hrtSetAt(hrtimer_t *hrtp, systime_t deadline,
+                            vtfunc_t func, void *par) {
+
+  chSysLock();
+  hrtSetAtI(hrtp, deadline, func, par);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Arms a timer after a delay.
+ * @details See @p hrtSetAtI().
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ * @param[in] delay     delay in system ticks
+ * @param[in] func      the timer callback function
+ * @param[in] par       a parameter that will be passed to the callback
+ *                      function
+ *
+ * @api
+ */
+static inline void hrtSet(hrtimer_t *hrtp, sysinterval_t delay,
+                          vtfunc_t func, void *par) {
+
+  chSysLock();
+  hrtSetI(hrtp, delay, func, par);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Disarms a timer.
+ *
+ * @param[in] hrtp      pointer to the @p hrtimer_t object
+ *
+ * @api
+ */
+static inline void hrtReset(hrtimer_t *hrtp) {
+
+  chSysLock();
+  hrtResetI(hrtp);
+  chSysUnlock();
+}
+
+#endif /* HRTIMER_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# High resolution timers files.
+HRTIMERSRC = $(CHIBIOS)/os/various/hrtimer/hrtimer.c
+
+HRTIMERINC = $(CHIBIOS)/os/various/hrtimer
+
+# Shared variables
+ALLCSRC += $(HRTIMERSRC)
+ALLINC  += $(HRTIMERINC)
@@ -0,0 +1,1020 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    isotp.c
+ * @brief   ISO 15765-2 transport layer code.
+ *
+ * @addtogroup isotp
+ * @details The driver receives the frames of a CAN bus using batched
+ *          receives and dispatches them to the open channels:
+ *          - Segments are copied directly into the buffer provided by the
+ *            receiving thread, no intermediate buffers are used.
+ *          - Segments are sent directly from the buffer provided by the
+ *            sending thread.
+ *          - Each channel has its own N_Bs, N_Cr and separation timers,
+ *            any number of channels can be active at the same time.
+ *          - Flow control and consecutive frames are queued on a transmit
+ *            list served from the timers, from the receive thread and from
+ *            @p isotpTxCompleteI().
+ *          .
+ *          Classic CAN frames are used, 8 data bytes with normal
+ *          addressing.
+ * @{
+ */
+
+#include <string.h>
+
+#include "isotp.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @name    Protocol control information types
+ * @{
+ */
+#define ISOTP_PCI_SF                        0x00U
+#define ISOTP_PCI_FF                        0x10U
+#define ISOTP_PCI_CF                        0x20U
+#define ISOTP_PCI_FC                        0x30U
+/** @} */
+
+/**
+ * @name    Pending frames mask
+ * @{
+ */
+#define ISOTP_PEND_FC                       1U
+#define ISOTP_PEND_TX                       2U
+/** @} */
+
+/**
+ * @brief   Data bytes in a classic CAN frame.
+ */
+#define ISOTP_FRAME_SIZE                    8U
+
+/**
+ * @brief   Largest message length encoded in 12 bits.
+ */
+#define ISOTP_FF_DL_12BITS                  4095U
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void isotp_pump_i(ISOTPDriver *ip);
+
+#if defined(CAN_IDE_EXT) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the identifier of a received frame.
+ */
+static uint32_t isotp_get_id(const CANRxFrame *crfp) {
+
+  if (crfp->IDE == CAN_IDE_EXT) {
+    return (uint32_t)crfp->EID | ISOTP_ID_EXT;
+  }
+  return (uint32_t)crfp->SID;
+}
+
+/**
+ * @brief   Sets the identifier of a frame to be sent.
+ */
+static void isotp_set_id(CANTxFrame *ctfp, uint32_t id) {
+
+  ctfp->RTR = CAN_RTR_DATA;
+  if ((id & ISOTP_ID_EXT) != 0U) {
+    ctfp->IDE = CAN_IDE_EXT;
+    ctfp->EID = id & ~ISOTP_ID_EXT;
+  }
+  else {
+    ctfp->IDE = CAN_IDE_STD;
+    ctfp->SID = id;
+  }
+}
+#else
+/* Frames layout of the FDCAN drivers.*/
+static uint32_t isotp_get_id(const CANRxFrame *crfp) {
+
+  if (crfp->common.XTD != 0U) {
+    return (uint32_t)crfp->ext.EID | ISOTP_ID_EXT;
+  }
+  return (uint32_t)crfp->std.SID;
+}
+
+static void isotp_set_id(CANTxFrame *ctfp, uint32_t id) {
+
+  if ((id & ISOTP_ID_EXT) != 0U) {
+    ctfp->common.XTD = 1U;
+    ctfp->ext.EID = id & ~ISOTP_ID_EXT;
+  }
+  else {
+    ctfp->std.SID = id;
+  }
+}
+#endif
+
+/**
+ * @brief   Returns the hash bucket of an identifier.
+ */
+static unsigned isotp_hash(uint32_t id) {
+
+  return (unsigned)((id ^ (id >> 8) ^ (id >> 16)) &
+                    ((uint32_t)ISOTP_HASH_SIZE - 1U));
+}
+
+/**
+ * @brief   Decodes a separation time.
+ */
+static sysinterval_t isotp_decode_stmin(uint8_t stmin) {
+
+  if (stmin <= 0x7FU) {
+    return TIME_MS2I((time_msecs_t)stmin);
+  }
+  if ((stmin >= 0xF1U) && (stmin <= 0xF9U)) {
+    return TIME_US2I((time_usecs_t)(stmin - 0xF0U) * 100U);
+  }
+
+  /* Reserved values are handled as the longest time.*/
+  return TIME_MS2I(127);
+}
+
+/**
+ * @brief   Prepares a frame to be sent on a channel.
+ */
+static void isotp_init_frame(ISOTPChannel *chp, CANTxFrame *ctfp) {
+
+  memset(ctfp, 0, sizeof (CANTxFrame));
+  isotp_set_id(ctfp, chp->config->tx_id);
+#if ISOTP_USE_PADDING == TRUE
+  memset(ctfp->data8, ISOTP_PADDING_BYTE, ISOTP_FRAME_SIZE);
+#endif
+}
+
+/**
+ * @brief   Sets the data length of a frame to be sent.
+ */
+static void isotp_set_length(CANTxFrame *ctfp, size_t n) {
+
+#if ISOTP_USE_PADDING == TRUE
+  (void)n;
+  ctfp->DLC = ISOTP_FRAME_SIZE;
+#else
+  ctfp->DLC = (uint8_t)n;
+#endif
+}
+
+/**
+ * @brief   Queues a frame for sending.
+ */
+static void isotp_queue_i(ISOTPChannel *chp, uint8_t mask) {
+  ISOTPDriver *ip = chp->ip;
+
+  if (chp->pending == 0U) {
+    chp->pnext = NULL;
+    if (ip->pend_tail == NULL) {
+      ip->pend_head = chp;
+    }
+    else {
+      ip->pend_tail->pnext = chp;
+    }
+    ip->pend_tail = chp;
+  }
+  chp->pending |= mask;
+}
+
+/**
+ * @brief   Removes pending frames from the transmit list.
+ */
+static void isotp_unqueue_i(ISOTPChannel *chp, uint8_t mask) {
+  ISOTPDriver *ip = chp->ip;
+  ISOTPChannel *prev, *p;
+
+  chp->pending &= (uint8_t)~mask;
+  if (chp->pending != 0U) {
+    return;
+  }
+
+  prev = NULL;
+  p = ip->pend_head;
+  while (p != NULL) {
+    if (p == chp) {
+      if (prev == NULL) {
+        ip->pend_head = p->pnext;
+      }
+      else {
+        prev->pnext = p->pnext;
+      }
+      if (ip->pend_tail == p) {
+        ip->pend_tail = prev;
+      }
+      return;
+    }
+    prev = p;
+    p = p->pnext;
+  }
+}
+
+/**
+ * @brief   Queues a flow control frame.
+ */
+static void isotp_send_fc_i(ISOTPChannel *chp, uint8_t fs) {
+
+  chp->rx_fs = fs;
+  isotp_queue_i(chp, ISOTP_PEND_FC);
+}
+
+/**
+ * @brief   Terminates the pending receive.
+ */
+static void isotp_rx_complete_i(ISOTPChannel *chp, isotp_result_t result) {
+
+  chVTResetI(&chp->rx_vt);
+  chp->rx_state = ISOTP_RX_IDLE;
+  chThdResumeI(&chp->rx_thread, (msg_t)result);
+}
+
+/**
+ * @brief   Terminates the pending send.
+ */
+static void isotp_tx_complete_i(ISOTPChannel *chp, isotp_result_t result) {
+
+  chVTResetI(&chp->tx_vt);
+  isotp_unqueue_i(chp, ISOTP_PEND_TX);
+  chp->tx_state = ISOTP_TX_IDLE;
+  chThdResumeI(&chp->tx_thread, (msg_t)result);
+}
+
+/**
+ * @brief   Receive timer callback.
+ * @details Expiration of N_Cr while receiving, repetition of the wait
+ *          frames while a first frame is held.
+ */
+static void isotp_rx_vt_cb(void *p) {
+  ISOTPChannel *chp = (ISOTPChannel *)p;
+
+  chSysLockFromISR();
+  if (chp->rx_state == ISOTP_RX_DATA) {
+    isotp_rx_complete_i(chp, ISOTP_ERR_TIMEOUT);
+  }
+  else if (chp->rx_state == ISOTP_RX_HELD_FF) {
+    if (++chp->rx_wft < (uint8_t)ISOTP_MAX_WFT) {
+      isotp_send_fc_i(chp, ISOTP_FS_WAIT);
+      chVTSetI(&chp->rx_vt, ISOTP_WFT_INTERVAL, isotp_rx_vt_cb, chp);
+    }
+    else {
+      /* No buffer in time, the sender is told to abort.*/
+      isotp_send_fc_i(chp, ISOTP_FS_OVFLW);
+      chp->rx_state = ISOTP_RX_IDLE;
+    }
+  }
+  isotp_pump_i(chp->ip);
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Transmit timer callback.
+ * @details Expiration of N_Bs or of the separation time.
+ */
+static void isotp_tx_vt_cb(void *p) {
+  ISOTPChannel *chp = (ISOTPChannel *)p;
+
+  chSysLockFromISR();
+  if (chp->tx_state == ISOTP_TX_WAIT_FC) {
+    isotp_tx_complete_i(chp, ISOTP_ERR_TIMEOUT);
+  }
+  else if (chp->tx_state == ISOTP_TX_STMIN) {
+    chp->tx_state = ISOTP_TX_SEND;
+    isotp_queue_i(chp, ISOTP_PEND_TX);
+  }
+  isotp_pump_i(chp->ip);
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Transmission retry timer callback.
+ */
+static void isotp_retry_vt_cb(void *p) {
+
+  chSysLockFromISR();
+  isotp_pump_i((ISOTPDriver *)p);
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   Builds a flow control frame.
+ */
+static void isotp_build_fc(ISOTPChannel *chp, CANTxFrame *ctfp) {
+
+  isotp_init_frame(chp, ctfp);
+  ctfp->data8[0] = (uint8_t)(ISOTP_PCI_FC | chp->rx_fs);
+  ctfp->data8[1] = chp->config->bs;
+  ctfp->data8[2] = chp->config->stmin;
+  isotp_set_length(ctfp, 3U);
+}
+
+/**
+ * @brief   Builds the next data frame of the pending send.
+ *
+ * @return              The number of message bytes in the frame.
+ */
+static size_t isotp_build_data(ISOTPChannel *chp, CANTxFrame *ctfp) {
+  size_t n, offset;
+
+  isotp_init_frame(chp, ctfp);
+  if (chp->tx_pos == 0U) {
+    if (chp->tx_len < ISOTP_FRAME_SIZE) {
+      ctfp->data8[0] = (uint8_t)(ISOTP_PCI_SF | chp->tx_len);
+      offset = 1U;
+    }
+    else if (chp->tx_len <= ISOTP_FF_DL_12BITS) {
+      ctfp->data8[0] = (uint8_t)(ISOTP_PCI_FF | (chp->tx_len >> 8));
+      ctfp->data8[1] = (uint8_t)chp->tx_len;
+      offset = 2U;
+    }
+    else {
+      /* Escape sequence, 32 bits length.*/
+      ctfp->data8[0] = (uint8_t)ISOTP_PCI_FF;
+      ctfp->data8[1] = 0U;
+      ctfp->data8[2] = (uint8_t)(chp->tx_len >> 24);
+      ctfp->data8[3] = (uint8_t)(chp->tx_len >> 16);
+      ctfp->data8[4] = (uint8_t)(chp->tx_len >> 8);
+      ctfp->data8[5] = (uint8_t)chp->tx_len;
+      offset = 6U;
+    }
+  }
+  else {
+    ctfp->data8[0] = (uint8_t)(ISOTP_PCI_CF | chp->tx_sn);
+    offset = 1U;
+  }
+
+  n = ISOTP_FRAME_SIZE - offset;
+  if (n > chp->tx_len - chp->tx_pos) {
+    n = chp->tx_len - chp->tx_pos;
+  }
+  memcpy(&ctfp->data8[offset], &chp->tx_buf[chp->tx_pos], n);
+  isotp_set_length(ctfp, offset + n);
+
+  return n;
+}
+
+/**
+ * @brief   Advances the pending send after a data frame has been queued.
+ */
+static void isotp_tx_advance_i(ISOTPChannel *chp, size_t n) {
+  bool first = chp->tx_pos == 0U;
+
+  chp->tx_pos += n;
+  if (chp->tx_pos >= chp->tx_len) {
+    isotp_tx_complete_i(chp, ISOTP_OK);
+    return;
+  }
+
+  if (first) {
+    chp->tx_sn = 1U;
+  }
+  else {
+    chp->tx_sn = (chp->tx_sn + 1U) & 0x0FU;
+    if ((chp->tx_bs == 0U) || (++chp->tx_bs_cnt < chp->tx_bs)) {
+      if (chp->tx_stmin > (sysinterval_t)0) {
+        chp->pending &= (uint8_t)~ISOTP_PEND_TX;
+        chp->tx_state = ISOTP_TX_STMIN;
+        chVTSetI(&chp->tx_vt, chp->tx_stmin, isotp_tx_vt_cb, chp);
+      }
+      return;
+    }
+  }
+
+  /* First frame sent or block completed.*/
+  chp->pending &= (uint8_t)~ISOTP_PEND_TX;
+  chp->tx_state = ISOTP_TX_WAIT_FC;
+  chVTSetI(&chp->tx_vt, ISOTP_N_TIMEOUT, isotp_tx_vt_cb, chp);
+}
+
+/**
+ * @brief   Sends the queued frames.
+ * @details Channels are served round robin one frame at time until the
+ *          transmit list is empty or the TX mailboxes are full.
+ */
+static void isotp_pump_i(ISOTPDriver *ip) {
+  ISOTPChannel *chp;
+  CANTxFrame ctf;
+
+  while ((chp = ip->pend_head) != NULL) {
+    bool fc = (chp->pending & ISOTP_PEND_FC) != 0U;
+    size_t n = 0U;
+
+    if (fc) {
+      isotp_build_fc(chp, &ctf);
+    }
+    else {
+      n = isotp_build_data(chp, &ctf);
+    }
+
+    if (canTryTransmitI(ip->config->canp, CAN_ANY_MAILBOX, &ctf)) {
+      /* Mailboxes full, anticipated by isotpTxCompleteI().*/
+      if (!chVTIsArmedI(&ip->retry_vt)) {
+        chVTSetI(&ip->retry_vt, ISOTP_TX_RETRY_INTERVAL,
+                 isotp_retry_vt_cb, ip);
+      }
+      return;
+    }
+
+    /* The channel is removed from the list head and appended again if
+       more frames are pending.*/
+    ip->pend_head = chp->pnext;
+    if (ip->pend_head == NULL) {
+      ip->pend_tail = NULL;
+    }
+    if (fc) {
+      chp->pending &= (uint8_t)~ISOTP_PEND_FC;
+    }
+    else {
+      chp->pending &= (uint8_t)~ISOTP_PEND_TX;
+      isotp_tx_advance_i(chp, n);
+      if (chp->tx_state == ISOTP_TX_SEND) {
+        chp->pending |= ISOTP_PEND_TX;
+      }
+    }
+    if (chp->pending != 0U) {
+      uint8_t mask = chp->pending;
+
+      chp->pending = 0U;
+      isotp_queue_i(chp, mask);
+    }
+  }
+}
+
+/**
+ * @brief   Handles a single frame.
+ */
+static void isotp_rx_sf_i(ISOTPChannel *chp, const uint8_t *dp, size_t n) {
+  size_t len = (size_t)(dp[0] & 0x0FU);
+
+  if ((len == 0U) || (len > n - 1U)) {
+    return;
+  }
+
+  /* A single frame interrupts any reception in progress.*/
+  if ((chp->rx_state == ISOTP_RX_ARMED) || (chp->rx_state == ISOTP_RX_DATA)) {
+    if (len > chp->rx_size) {
+      isotp_rx_complete_i(chp, ISOTP_ERR_OVERFLOW);
+      return;
+    }
+    memcpy(chp->rx_buf, &dp[1], len);
+    chp->rx_len = len;
+    isotp_rx_complete_i(chp, ISOTP_OK);
+  }
+  else {
+    chVTResetI(&chp->rx_vt);
+    memcpy(chp->rx_held, &dp[1], len);
+    chp->rx_len = len;
+    chp->rx_state = ISOTP_RX_HELD_SF;
+  }
+}
+
+/**
+ * @brief   Handles a first frame.
+ */
+static void isotp_rx_ff_i(ISOTPChannel *chp, const uint8_t *dp, size_t n) {
+  size_t len, offset;
+
+  if (n < ISOTP_FRAME_SIZE) {
+    return;
+  }
+
+  len = ((size_t)(dp[0] & 0x0FU) << 8) | (size_t)dp[1];
+  offset = 2U;
+  if (len == 0U) {
+    len = ((size_t)dp[2] << 24) | ((size_t)dp[3] << 16) |
+          ((size_t)dp[4] << 8) | (size_t)dp[5];
+    offset = 6U;
+    if (len <= ISOTP_FF_DL_12BITS) {
+      return;
+    }
+  }
+  else if (len < ISOTP_FRAME_SIZE) {
+    return;
+  }
+
+  chp->rx_len = len;
+  chp->rx_pos = ISOTP_FRAME_SIZE - offset;
+  chp->rx_sn = 1U;
+  chp->rx_bs_cnt = 0U;
+
+  if ((chp->rx_state == ISOTP_RX_ARMED) || (chp->rx_state == ISOTP_RX_DATA)) {
+    if (len > chp->rx_size) {
+      isotp_send_fc_i(chp, ISOTP_FS_OVFLW);
+      isotp_rx_complete_i(chp, ISOTP_ERR_OVERFLOW);
+      return;
+    }
+    memcpy(chp->rx_buf, &dp[offset], chp->rx_pos);
+    chp->rx_state = ISOTP_RX_DATA;
+    isotp_send_fc_i(chp, ISOTP_FS_CTS);
+    chVTSetI(&chp->rx_vt, ISOTP_N_TIMEOUT, isotp_rx_vt_cb, chp);
+  }
+  else {
+    /* No buffer yet, the sender is asked to wait.*/
+    memcpy(chp->rx_held, &dp[offset], chp->rx_pos);
+    chp->rx_state = ISOTP_RX_HELD_FF;
+    chp->rx_wft = 0U;
+    isotp_send_fc_i(chp, ISOTP_FS_WAIT);
+    chVTSetI(&chp->rx_vt, ISOTP_WFT_INTERVAL, isotp_rx_vt_cb, chp);
+  }
+}
+
+/**
+ * @brief   Handles a consecutive frame.
+ */
+static void isotp_rx_cf_i(ISOTPChannel *chp, const uint8_t *dp, size_t n) {
+  size_t len;
+
+  if (chp->rx_state != ISOTP_RX_DATA) {
+    return;
+  }
+
+  if ((dp[0] & 0x0FU) != chp->rx_sn) {
+    isotp_rx_complete_i(chp, ISOTP_ERR_WRONG_SN);
+    return;
+  }
+
+  len = chp->rx_len - chp->rx_pos;
+  if (len > n - 1U) {
+    len = n - 1U;
+  }
+  memcpy(&chp->rx_buf[chp->rx_pos], &dp[1], len);
+  chp->rx_pos += len;
+  chp->rx_sn = (chp->rx_sn + 1U) & 0x0FU;
+
+  if (chp->rx_pos >= chp->rx_len) {
+    isotp_rx_complete_i(chp, ISOTP_OK);
+    return;
+  }
+
+  if ((chp->config->bs != 0U) && (++chp->rx_bs_cnt >= chp->config->bs)) {
+    chp->rx_bs_cnt = 0U;
+    isotp_send_fc_i(chp, ISOTP_FS_CTS);
+  }
+  chVTSetI(&chp->rx_vt, ISOTP_N_TIMEOUT, isotp_rx_vt_cb, chp);
+}
+
+/**
+ * @brief   Handles a flow control frame.
+ */
+static void isotp_rx_fc_i(ISOTPChannel *chp, const uint8_t *dp, size_t n) {
+
+  if ((chp->tx_state != ISOTP_TX_WAIT_FC) || (n < 3U)) {
+    return;
+  }
+
+  switch (dp[0] & 0x0FU) {
+  case ISOTP_FS_CTS:
+    chp->tx_wft = 0U;
+    chp->tx_bs = dp[1];
+    chp->tx_bs_cnt = 0U;
+    chp->tx_stmin = isotp_decode_stmin(dp[2]);
+    chVTResetI(&chp->tx_vt);
+    chp->tx_state = ISOTP_TX_SEND;
+    isotp_queue_i(chp, ISOTP_PEND_TX);
+    break;
+  case ISOTP_FS_WAIT:
+    if (++chp->tx_wft >= (uint8_t)ISOTP_MAX_WFT) {
+      isotp_tx_complete_i(chp, ISOTP_ERR_WFT_OVRN);
+      break;
+    }
+    chVTSetI(&chp->tx_vt, ISOTP_N_TIMEOUT, isotp_tx_vt_cb, chp);
+    break;
+  case ISOTP_FS_OVFLW:
+    isotp_tx_complete_i(chp, ISOTP_ERR_OVERFLOW);
+    break;
+  default:
+    isotp_tx_complete_i(chp, ISOTP_ERR_INVALID_FS);
+    break;
+  }
+}
+
+/**
+ * @brief   Dispatches a received frame to its channel.
+ *
+ * @return              The frame has been handled by a channel.
+ */
+static bool isotp_dispatch_i(ISOTPDriver *ip, const CANRxFrame *crfp) {
+  uint32_t id = isotp_get_id(crfp);
+  ISOTPChannel *chp;
+  size_t n;
+
+  chp = ip->buckets[isotp_hash(id)];
+  while ((chp != NULL) && (chp->config->rx_id != id)) {
+    chp = chp->hnext;
+  }
+  if (chp == NULL) {
+    return false;
+  }
+
+  /* Longer DLC codes only exist in FD frames, not used here.*/
+  n = (size_t)crfp->DLC;
+  if ((n == 0U) || (n > ISOTP_FRAME_SIZE)) {
+    return true;
+  }
+
+  switch (crfp->data8[0] & 0xF0U) {
+  case ISOTP_PCI_SF:
+    isotp_rx_sf_i(chp, crfp->data8, n);
+    break;
+  case ISOTP_PCI_FF:
+    isotp_rx_ff_i(chp, crfp->data8, n);
+    break;
+  case ISOTP_PCI_CF:
+    isotp_rx_cf_i(chp, crfp->data8, n);
+    break;
+  case ISOTP_PCI_FC:
+    isotp_rx_fc_i(chp, crfp->data8, n);
+    break;
+  default:
+    break;
+  }
+
+  return true;
+}
+
+/**
+ * @brief   Receive thread, frames are fetched in batches.
+ */
+static THD_FUNCTION(isotp_thread, arg) {
+  ISOTPDriver *ip = (ISOTPDriver *)arg;
+  const ISOTPConfig *config = ip->config;
+
+  chRegSetThreadName("isotp");
+
+  while (!chThdShouldTerminateX()) {
+    msg_t i, n;
+
+    n = canReceiveBatchTimeout(config->canp, config->mailbox, ip->frames,
+                               (size_t)ISOTP_RX_BATCH_SIZE,
+                               ISOTP_POLL_INTERVAL);
+    if (n == MSG_RESET) {
+      chThdSleep(ISOTP_POLL_INTERVAL);
+      continue;
+    }
+
+    for (i = 0; i < n; i++) {
+      bool handled;
+
+      chSysLock();
+      handled = isotp_dispatch_i(ip, &ip->frames[i]);
+      isotp_pump_i(ip);
+      chSchRescheduleS();
+      chSysUnlock();
+
+      if (!handled) {
+        ip->unhandled++;
+        if (config->unhandled_cb != NULL) {
+          config->unhandled_cb(ip, &ip->frames[i]);
+        }
+      }
+    }
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p ISOTPDriver object.
+ *
+ * @param[out] ip       pointer to the @p ISOTPDriver object
+ *
+ * @init
+ */
+void isotpObjectInit(ISOTPDriver *ip) {
+  unsigned i;
+
+  ip->config    = NULL;
+  ip->thread    = NULL;
+  ip->pend_head = NULL;
+  ip->pend_tail = NULL;
+  ip->unhandled = 0U;
+  for (i = 0U; i < (unsigned)ISOTP_HASH_SIZE; i++) {
+    ip->buckets[i] = NULL;
+  }
+  chVTObjectInit(&ip->retry_vt);
+}
+
+/**
+ * @brief   Starts the driver.
+ * @details A thread is spawned, it receives all the frames of the
+ *          configured mailbox and dispatches them to the open channels.
+ *
+ * @param[in] ip        pointer to the @p ISOTPDriver object
+ * @param[in] config    pointer to the @p ISOTPConfig object
+ *
+ * @api
+ */
+void isotpStart(ISOTPDriver *ip, const ISOTPConfig *config) {
+
+  chDbgCheck((ip != NULL) && (config != NULL) &&
+             (config->canp != NULL) && (config->wsp != NULL));
+  chDbgAssert(ip->thread == NULL, "already started");
+
+  ip->config    = config;
+  ip->unhandled = 0U;
+  ip->thread    = chThdCreateStatic(config->wsp, config->wssize,
+                                    config->prio, isotp_thread, (void *)ip);
+}
+
+/**
+ * @brief   Stops the driver.
+ * @details The function waits for the receive thread to terminate, this
+ *          can take up to @p ISOTP_POLL_INTERVAL.
+ * @pre     All the channels must have been closed.
+ *
+ * @param[in] ip        pointer to the @p ISOTPDriver object
+ *
+ * @api
+ */
+void isotpStop(ISOTPDriver *ip) {
+
+  chDbgCheck((ip != NULL) && (ip->thread != NULL));
+
+  chThdTerminate(ip->thread);
+  (void) chThdWait(ip->thread);
+  ip->thread = NULL;
+
+  chSysLock();
+  chVTResetI(&ip->retry_vt);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Resumes the queued transmissions.
+ * @note    This function is meant to be called from the CAN @p txempty_cb
+ *          callback, it can be omitted at the cost of a timer tick
+ *          between bursts of frames:
+ * @code
+ *  static void can_txempty_cb(CANDriver *canp, uint32_t flags) {
+ *
+ *    (void)canp;
+ *    (void)flags;
+ *    osalSysLockFromISR();
+ *    isotpTxCompleteI(&ISOTPD1);
+ *    osalSysUnlockFromISR();
+ *  }
+ * @endcode
+ *
+ * @param[in] ip        pointer to the @p ISOTPDriver object
+ *
+ * @iclass
+ */
+void isotpTxCompleteI(ISOTPDriver *ip) {
+
+  chDbgCheckClassI();
+
+  if (ip->thread != NULL) {
+    isotp_pump_i(ip);
+  }
+}
+
+/**
+ * @brief   Opens a channel.
+ *
+ * @param[in] ip        pointer to the @p ISOTPDriver object
+ * @param[out] chp      pointer to the @p ISOTPChannel object
+ * @param[in] config    pointer to the @p ISOTPChannelConfig object
+ *
+ * @api
+ */
+void isotpOpen(ISOTPDriver *ip, ISOTPChannel *chp,
+               const ISOTPChannelConfig *config) {
+  unsigned h;
+
+  chDbgCheck((ip != NULL) && (chp != NULL) && (config != NULL));
+
+  chp->ip        = ip;
+  chp->config    = config;
+  chp->pnext     = NULL;
+  chp->pending   = 0U;
+  chp->rx_state  = ISOTP_RX_IDLE;
+  chp->rx_buf    = NULL;
+  chp->rx_thread = NULL;
+  chp->tx_state  = ISOTP_TX_IDLE;
+  chp->tx_thread = NULL;
+  chVTObjectInit(&chp->rx_vt);
+  chVTObjectInit(&chp->tx_vt);
+
+  h = isotp_hash(config->rx_id);
+
+  chSysLock();
+#if CH_DBG_ENABLE_ASSERTS == TRUE
+  {
+    ISOTPChannel *p;
+
+    for (p = ip->buckets[h]; p != NULL; p = p->hnext) {
+      chDbgAssert(p->config->rx_id != config->rx_id, "identifier in use");
+    }
+  }
+#endif
+  chp->hnext = ip->buckets[h];
+  ip->buckets[h] = chp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Closes a channel.
+ * @details The pending receive and send are terminated with
+ *          @p ISOTP_ERR_RESET.
+ *
+ * @param[in] chp       pointer to the @p ISOTPChannel object
+ *
+ * @api
+ */
+void isotpClose(ISOTPChannel *chp) {
+  ISOTPChannel **pp;
+
+  chDbgCheck((chp != NULL) && (chp->ip != NULL));
+
+  chSysLock();
+  pp = &chp->ip->buckets[isotp_hash(chp->config->rx_id)];
+  while (*pp != chp) {
+    pp = &(*pp)->hnext;
+  }
+  *pp = chp->hnext;
+
+  isotp_unqueue_i(chp, ISOTP_PEND_FC | ISOTP_PEND_TX);
+  if (chp->tx_state != ISOTP_TX_IDLE) {
+    isotp_tx_complete_i(chp, ISOTP_ERR_RESET);
+  }
+  if ((chp->rx_state == ISOTP_RX_ARMED) || (chp->rx_state == ISOTP_RX_DATA)) {
+    isotp_rx_complete_i(chp, ISOTP_ERR_RESET);
+  }
+  chVTResetI(&chp->rx_vt);
+  chp->rx_state = ISOTP_RX_IDLE;
+  chp->ip = NULL;
+  chSchRescheduleS();
+  chSysUnlock();
+}
+
+/**
+ * @brief   Receives a message.
+ * @details The segments are copied directly into the buffer. A single or
+ *          first frame received while no receive is pending is held, a
+ *          held first frame is answered with wait frames until this
+ *          function provides a buffer.
+ *
+ * @param[in] chp       pointer to the @p ISOTPChannel object
+ * @param[out] buf      buffer for the message
+ * @param[in] size      size of the buffer
+ * @param[out] np       length of the received message
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval ISOTP_OK     if a message has been received.
+ *
+ * @api
+ */
+isotp_result_t isotpReceiveTimeout(ISOTPChannel *chp, uint8_t *buf,
+                                   size_t size, size_t *np,
+                                   sysinterval_t timeout) {
+  msg_t msg;
+
+  chDbgCheck((chp != NULL) && (chp->ip != NULL) &&
+             (buf != NULL) && (size > 0U) && (np != NULL));
+
+  chSysLock();
+  chDbgAssert(chp->rx_thread == NULL, "receive in progress");
+
+  chp->rx_buf  = buf;
+  chp->rx_size = size;
+
+  if (chp->rx_state == ISOTP_RX_HELD_SF) {
+    chp->rx_state = ISOTP_RX_IDLE;
+    if (chp->rx_len > size) {
+      chSysUnlock();
+      return ISOTP_ERR_OVERFLOW;
+    }
+    memcpy(buf, chp->rx_held, chp->rx_len);
+    *np = chp->rx_len;
+    chSysUnlock();
+    return ISOTP_OK;
+  }
+
+  if (chp->rx_state == ISOTP_RX_HELD_FF) {
+    if (chp->rx_len > size) {
+      chVTResetI(&chp->rx_vt);
+      chp->rx_state = ISOTP_RX_IDLE;
+      isotp_send_fc_i(chp, ISOTP_FS_OVFLW);
+      isotp_pump_i(chp->ip);
+      chSysUnlock();
+      return ISOTP_ERR_OVERFLOW;
+    }
+    memcpy(buf, chp->rx_held, chp->rx_pos);
+    chp->rx_state = ISOTP_RX_DATA;
+    isotp_send_fc_i(chp, ISOTP_FS_CTS);
+    isotp_pump_i(chp->ip);
+    chVTSetI(&chp->rx_vt, ISOTP_N_TIMEOUT, isotp_rx_vt_cb, chp);
+  }
+  else {
+    chp->rx_state = ISOTP_RX_ARMED;
+  }
+
+  msg = chThdSuspendTimeoutS(&chp->rx_thread, timeout);
+  chp->rx_buf = NULL;
+  if (msg == MSG_TIMEOUT) {
+    /* Abandoned reception, following segments are ignored.*/
+    chVTResetI(&chp->rx_vt);
+    chp->rx_state = ISOTP_RX_IDLE;
+    chSysUnlock();
+    return ISOTP_ERR_TIMEOUT;
+  }
+  *np = chp->rx_len;
+  chSysUnlock();
+
+  return (isotp_result_t)msg;
+}
+
+/**
+ * @brief   Sends a message.
+ * @details The segments are sent directly from the buffer, the function
+ *          returns when the last frame has been queued in a TX mailbox.
+ * @note    Messages longer than 4095 bytes use the 32 bits length
+ *          encoding.
+ *
+ * @param[in] chp       pointer to the @p ISOTPChannel object
+ * @param[in] buf       message to be sent
+ * @param[in] n         length of the message
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval ISOTP_OK     if the message has been sent.
+ *
+ * @api
+ */
+isotp_result_t isotpSendTimeout(ISOTPChannel *chp, const uint8_t *buf,
+                                size_t n, sysinterval_t timeout) {
+  msg_t msg;
+
+  chDbgCheck((chp != NULL) && (chp->ip != NULL) &&
+             (buf != NULL) && (n > 0U));
+
+  chSysLock();
+  chDbgAssert(chp->tx_state == ISOTP_TX_IDLE, "send in progress");
+
+  chp->tx_buf   = buf;
+  chp->tx_len   = n;
+  chp->tx_pos   = 0U;
+  chp->tx_wft   = 0U;
+  chp->tx_state = ISOTP_TX_SEND;
+  isotp_queue_i(chp, ISOTP_PEND_TX);
+  isotp_pump_i(chp->ip);
+
+  /* Single frames can be completed by the pump.*/
+  if (chp->tx_state == ISOTP_TX_IDLE) {
+    chSysUnlock();
+    return ISOTP_OK;
+  }
+
+  msg = chThdSuspendTimeoutS(&chp->tx_thread, timeout);
+  if (msg == MSG_TIMEOUT) {
+    chVTResetI(&chp->tx_vt);
+    isotp_unqueue_i(chp, ISOTP_PEND_TX);
+    chp->tx_state = ISOTP_TX_IDLE;
+    chSysUnlock();
+    return ISOTP_ERR_TIMEOUT;
+  }
+  chSysUnlock();
+
+  return (isotp_result_t)msg;
+}
+
+/** @} */
@@ -0,0 +1,402 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    isotp.h
+ * @brief   ISO 15765-2 transport layer structures and macros.
+ *
+ * @addtogroup isotp
+ * @{
+ */
+
+#ifndef ISOTP_H
+#define ISOTP_H
+
+#include "ch.h"
+#include "hal.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Flag marking a 29 bits identifier in channel configurations.
+ */
+#define ISOTP_ID_EXT                        0x80000000U
+
+/**
+ * @name    Flow control status values
+ * @{
+ */
+#define ISOTP_FS_CTS                        0U
+#define ISOTP_FS_WAIT                       1U
+#define ISOTP_FS_OVFLW                      2U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of frames fetched by each batched receive.
+ */
+#if !defined(ISOTP_RX_BATCH_SIZE) || defined(__DOXYGEN__)
+#define ISOTP_RX_BATCH_SIZE                 8
+#endif
+
+/**
+ * @brief   Size of the channels hash table.
+ * @note    Must be a power of two.
+ */
+#if !defined(ISOTP_HASH_SIZE) || defined(__DOXYGEN__)
+#define ISOTP_HASH_SIZE                     16
+#endif
+
+/**
+ * @brief   Receive thread polling interval.
+ * @details The thread checks for termination after waiting this interval
+ *          without receiving frames.
+ */
+#if !defined(ISOTP_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define ISOTP_POLL_INTERVAL                 TIME_MS2I(100)
+#endif
+
+/**
+ * @brief   N_Bs and N_Cr timeout.
+ * @details Maximum wait for a flow control frame while sending and for a
+ *          consecutive frame while receiving.
+ */
+#if !defined(ISOTP_N_TIMEOUT) || defined(__DOXYGEN__)
+#define ISOTP_N_TIMEOUT                     TIME_MS2I(1000)
+#endif
+
+/**
+ * @brief   Transmission retry interval when the TX mailboxes are full.
+ * @note    The retry is anticipated by @p isotpTxCompleteI().
+ */
+#if !defined(ISOTP_TX_RETRY_INTERVAL) || defined(__DOXYGEN__)
+#define ISOTP_TX_RETRY_INTERVAL             ((sysinterval_t)1)
+#endif
+
+/**
+ * @brief   Maximum number of wait flow control frames.
+ * @details A first frame received while no receive is pending is held
+ *          and answered with wait frames until a buffer is provided, the
+ *          message is rejected after this number of frames. A send is
+ *          aborted after receiving this number of wait frames in a row.
+ */
+#if !defined(ISOTP_MAX_WFT) || defined(__DOXYGEN__)
+#define ISOTP_MAX_WFT                       8
+#endif
+
+/**
+ * @brief   Interval between wait flow control frames.
+ * @note    Must be lower than the sender N_Bs timeout.
+ */
+#if !defined(ISOTP_WFT_INTERVAL) || defined(__DOXYGEN__)
+#define ISOTP_WFT_INTERVAL                  TIME_MS2I(250)
+#endif
+
+/**
+ * @brief   Frames padding.
+ * @details When enabled all frames are sent with 8 data bytes.
+ */
+#if !defined(ISOTP_USE_PADDING) || defined(__DOXYGEN__)
+#define ISOTP_USE_PADDING                   TRUE
+#endif
+
+/**
+ * @brief   Padding byte value.
+ */
+#if !defined(ISOTP_PADDING_BYTE) || defined(__DOXYGEN__)
+#define ISOTP_PADDING_BYTE                  0xCCU
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_USE_CAN != TRUE
+#error "ISO-TP requires HAL_USE_CAN"
+#endif
+
+#if CH_CFG_USE_WAITEXIT != TRUE
+#error "ISO-TP requires CH_CFG_USE_WAITEXIT"
+#endif
+
+#if (ISOTP_HASH_SIZE < 1) || ((ISOTP_HASH_SIZE & (ISOTP_HASH_SIZE - 1)) != 0)
+#error "ISOTP_HASH_SIZE must be a power of two"
+#endif
+
+#if ISOTP_RX_BATCH_SIZE < 1
+#error "invalid ISOTP_RX_BATCH_SIZE value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an ISO-TP driver object.
+ */
+typedef struct isotp_driver ISOTPDriver;
+
+/**
+ * @brief   Type of an ISO-TP channel object.
+ */
+typedef struct isotp_channel ISOTPChannel;
+
+/**
+ * @brief   Type of a transfer result.
+ */
+typedef enum {
+  ISOTP_OK = 0,                     /**< Transfer completed.                */
+  ISOTP_ERR_TIMEOUT = 1,            /**< N_Bs, N_Cr or caller timeout.      */
+  ISOTP_ERR_WRONG_SN = 2,           /**< Consecutive frame out of sequence. */
+  ISOTP_ERR_OVERFLOW = 3,           /**< Message larger than the buffer.    */
+  ISOTP_ERR_INVALID_FS = 4,         /**< Invalid flow control status.       */
+  ISOTP_ERR_WFT_OVRN = 5,           /**< Too many wait frames received.     */
+  ISOTP_ERR_RESET = 6               /**< Channel closed.                    */
+} isotp_result_t;
+
+/**
+ * @brief   Type of a receive state.
+ */
+typedef enum {
+  ISOTP_RX_IDLE = 0,                /**< No receive pending.                */
+  ISOTP_RX_ARMED = 1,               /**< Buffer ready, waiting SF or FF.    */
+  ISOTP_RX_DATA = 2,                /**< Receiving consecutive frames.      */
+  ISOTP_RX_HELD_SF = 3,             /**< SF held, waiting a buffer.         */
+  ISOTP_RX_HELD_FF = 4              /**< FF held, waiting a buffer.         */
+} isotp_rx_state_t;
+
+/**
+ * @brief   Type of a transmit state.
+ */
+typedef enum {
+  ISOTP_TX_IDLE = 0,                /**< No send pending.                   */
+  ISOTP_TX_SEND = 1,                /**< Next frame queued for sending.     */
+  ISOTP_TX_WAIT_FC = 2,             /**< Waiting a flow control frame.      */
+  ISOTP_TX_STMIN = 3                /**< Waiting the separation time.       */
+} isotp_tx_state_t;
+
+/**
+ * @brief   Type of a callback for frames not belonging to channels.
+ *
+ * @param[in] ip        pointer to the @p ISOTPDriver object
+ * @param[in] crfp      pointer to the received frame
+ */
+typedef void (*isotp_frame_cb_t)(ISOTPDriver *ip, const CANRxFrame *crfp);
+
+/**
+ * @brief   ISO-TP driver configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   CAN driver, it must be started.
+   */
+  CANDriver                 *canp;
+  /**
+   * @brief   Receive mailbox.
+   */
+  canmbx_t                  mailbox;
+  /**
+   * @brief   Callback for frames not belonging to channels or @p NULL.
+   * @note    Called from the receive thread.
+   */
+  isotp_frame_cb_t          unhandled_cb;
+  /**
+   * @brief   Receive thread priority.
+   */
+  tprio_t                   prio;
+  /**
+   * @brief   Receive thread working area.
+   */
+  void                      *wsp;
+  /**
+   * @brief   Receive thread working area size.
+   */
+  size_t                    wssize;
+} ISOTPConfig;
+
+/**
+ * @brief   ISO-TP channel configuration structure.
+ * @note    Identifiers with @p ISOTP_ID_EXT set are 29 bits identifiers.
+ */
+typedef struct {
+  /**
+   * @brief   Identifier of the sent frames.
+   */
+  uint32_t                  tx_id;
+  /**
+   * @brief   Identifier of the received frames.
+   */
+  uint32_t                  rx_id;
+  /**
+   * @brief   Block size requested to the sender, zero for no limit.
+   */
+  uint8_t                   bs;
+  /**
+   * @brief   Separation time requested to the sender, ISO encoding.
+   */
+  uint8_t                   stmin;
+} ISOTPChannelConfig;
+
+/**
+ * @brief   Structure representing an ISO-TP channel.
+ * @details A channel is a pair of identifiers, receive and send can be
+ *          active at the same time.
+ */
+struct isotp_channel {
+  /**
+   * @brief   Driver the channel is open on or @p NULL.
+   */
+  ISOTPDriver               *ip;
+  /**
+   * @brief   Current configuration data.
+   */
+  const ISOTPChannelConfig  *config;
+  /**
+   * @brief   Next channel in the hash bucket.
+   */
+  ISOTPChannel              *hnext;
+  /**
+   * @brief   Next channel in the transmit list.
+   */
+  ISOTPChannel              *pnext;
+  /**
+   * @brief   Pending frames mask.
+   */
+  uint8_t                   pending;
+  /**
+   * @name    Receive state
+   * @{
+   */
+  isotp_rx_state_t          rx_state;
+  uint8_t                   *rx_buf;
+  size_t                    rx_size;
+  size_t                    rx_len;
+  size_t                    rx_pos;
+  uint8_t                   rx_sn;
+  uint8_t                   rx_bs_cnt;
+  uint8_t                   rx_fs;
+  uint8_t                   rx_wft;
+  uint8_t                   rx_held[7];
+  virtual_timer_t           rx_vt;
+  thread_reference_t        rx_thread;
+  /** @} */
+  /**
+   * @name    Transmit state
+   * @{
+   */
+  isotp_tx_state_t          tx_state;
+  const uint8_t             *tx_buf;
+  size_t                    tx_len;
+  size_t                    tx_pos;
+  uint8_t                   tx_sn;
+  uint8_t                   tx_bs;
+  uint8_t                   tx_bs_cnt;
+  uint8_t                   tx_wft;
+  sysinterval_t             tx_stmin;
+  virtual_timer_t           tx_vt;
+  thread_reference_t        tx_thread;
+  /** @} */
+};
+
+/**
+ * @brief   Structure representing an ISO-TP driver.
+ * @details One driver serves all the channels on a CAN bus.
+ */
+struct isotp_driver {
+  /**
+   * @brief   Current configuration data.
+   */
+  const ISOTPConfig         *config;
+  /**
+   * @brief   Receive thread or @p NULL.
+   */
+  thread_t                  *thread;
+  /**
+   * @brief   Channels by receive identifier.
+   */
+  ISOTPChannel              *buckets[ISOTP_HASH_SIZE];
+  /**
+   * @brief   Channels with frames waiting to be sent.
+   */
+  ISOTPChannel              *pend_head;
+  /**
+   * @brief   Last channel in the transmit list.
+   */
+  ISOTPChannel              *pend_tail;
+  /**
+   * @brief   Transmission retry timer.
+   */
+  virtual_timer_t           retry_vt;
+  /**
+   * @brief   Received frames batch.
+   */
+  CANRxFrame                frames[ISOTP_RX_BATCH_SIZE];
+  /**
+   * @brief   Number of frames not belonging to channels.
+   */
+  uint32_t                  unhandled;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Encodes a separation time in microseconds.
+ * @note    Values over 127ms are clamped.
+ *
+ * @param[in] us        separation time in microseconds
+ */
+#define ISOTP_STMIN_US(us)                                                  \
+  ((us) == 0U ? 0U :                                                        \
+   (us) <= 900U ? (uint8_t)(0xF0U + (((us) + 99U) / 100U)) :                \
+   (us) < 127000U ? (uint8_t)(((us) + 999U) / 1000U) : 0x7FU)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void isotpObjectInit(ISOTPDriver *ip);
+  void isotpStart(ISOTPDriver *ip, const ISOTPConfig *config);
+  void isotpStop(ISOTPDriver *ip);
+  void isotpTxCompleteI(ISOTPDriver *ip);
+  void isotpOpen(ISOTPDriver *ip, ISOTPChannel *chp,
+                 const ISOTPChannelConfig *config);
+  void isotpClose(ISOTPChannel *chp);
+  isotp_result_t isotpReceiveTimeout(ISOTPChannel *chp, uint8_t *buf,
+                                     size_t size, size_t *np,
+                                     sysinterval_t timeout);
+  isotp_result_t isotpSendTimeout(ISOTPChannel *chp, const uint8_t *buf,
+                                  size_t n, sysinterval_t timeout);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* ISOTP_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# ISO-TP transport layer files.
+ISOTPSRC = $(CHIBIOS)/os/various/isotp/isotp.c
+
+ISOTPINC = $(CHIBIOS)/os/various/isotp
+
+# Shared variables
+ALLCSRC += $(ISOTPSRC)
+ALLINC  += $(ISOTPINC)
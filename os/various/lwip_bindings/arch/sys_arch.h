@@ -65,4 +65,29 @@ typedef syssts_t        sys_prot_t;
 /* let sys.h use binary semaphores for mutexes */
 #define LWIP_COMPAT_MUTEX 1
 
+/* Inlined lightweight protection, the kernel is locked without the ISR
+   context check and unlocked without rescheduling because protected
+   sections never make threads ready. Usable on single-core builds where
+   lwIP is never invoked from ISRs.*/
+#ifndef CH_LWIP_USE_FAST_PROTECT
+#define CH_LWIP_USE_FAST_PROTECT FALSE
+#endif
+
+#if CH_LWIP_USE_FAST_PROTECT
+#define SYS_ARCH_DECL_PROTECT(lev)  sys_prot_t lev
+#define SYS_ARCH_PROTECT(lev)                                               \
+  do {                                                                      \
+    (lev) = port_get_irq_status();                                          \
+    if (port_irq_enabled(lev)) {                                            \
+      chSysLock();                                                          \
+    }                                                                       \
+  } while (0)
+#define SYS_ARCH_UNPROTECT(lev)                                             \
+  do {                                                                      \
+    if (port_irq_enabled(lev)) {                                            \
+      chSysUnlock();                                                        \
+    }                                                                       \
+  } while (0)
+#endif
+
 #endif /* __SYS_ARCH_H__ */
@@ -13,6 +13,22 @@ LWBINDSRC = \
 LWSRC_REQUIRED = $(COREFILES) $(CORE4FILES) $(APIFILES) $(LWBINDSRC) $(NETIFFILES)
 LWSRC_EXTRAS ?= $(HTTPFILES)
 
+# lwIP network interface on a USB CDC-NCM function, requires hal_usb_ncm.mk.
+# When set to "only" there is no MAC and lwipthread.c is not built.
+ifneq ($(filter yes only,$(USE_LWIP_NCMIF)),)
+  LWBINDSRC += $(CHIBIOS)/os/various/lwip_bindings/ncmif.c
+endif
+ifeq ($(USE_LWIP_NCMIF),only)
+  LWBINDSRC := $(filter-out %/lwipthread.c,$(LWBINDSRC))
+endif
+
+# lwIP memory pools on ChibiOS memory pools, replaces the lwIP memp module.
+ifeq ($(USE_LWIP_MEMP_POOLS),yes)
+  LWSRC_REQUIRED := $(filter-out $(LWIPDIR)/core/memp.c,$(LWSRC_REQUIRED)) \
+                    $(CHIBIOS)/os/various/lwip_bindings/lwipmemp.c
+  DDEFS += -DLWIP_USE_MEMP_POOLS=TRUE
+endif
+
 LWINC = \
         $(CHIBIOS)/os/various/lwip_bindings \
         $(LWIPDIR)/include
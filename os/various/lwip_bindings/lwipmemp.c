@@ -0,0 +1,444 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    lwipmemp.c
+ * @brief   lwIP memory pools on ChibiOS memory pools.
+ * @details Replacement of the lwIP memp module. Each lwIP pool is a
+ *          @p memory_pool_t filled during the lwIP initialization from
+ *          the provider selected by @p LWIP_MEMP_PROVIDER(), so each pool
+ *          can be placed in a different RAM region. The tcpip thread
+ *          goes through per-pool magazines, the other threads and the
+ *          ISRs access the pools directly.
+ * @note    The module is built instead of the lwIP memp.c when
+ *          @p USE_LWIP_MEMP_POOLS is set to "yes" in the makefile.
+ *
+ * @addtogroup LWIP_MEMP
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+
+#include <lwip/opt.h>
+#include <lwip/memp.h>
+#include <lwip/sys.h>
+#include <lwip/stats.h>
+
+/* Everything required by the size calculations in memp_std.h.*/
+#include <lwip/pbuf.h>
+#include <lwip/raw.h>
+#include <lwip/udp.h>
+#include <lwip/tcp.h>
+#include <lwip/priv/tcp_priv.h>
+#include <lwip/altcp.h>
+#include <lwip/ip4_frag.h>
+#include <lwip/netbuf.h>
+#include <lwip/api.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <lwip/priv/api_msg.h>
+#include <lwip/priv/sockets_priv.h>
+#include <lwip/etharp.h>
+#include <lwip/igmp.h>
+#include <lwip/timeouts.h>
+#include <netif/ppp/ppp_opts.h>
+#include <lwip/netdb.h>
+#include <lwip/dns.h>
+#include <lwip/priv/nd6_priv.h>
+#include <lwip/ip6_frag.h>
+#include <lwip/mld6.h>
+
+#include "lwipmemp.h"
+
+#if MEMP_MEM_MALLOC || MEM_USE_POOLS
+#error "lwipmemp.c requires MEMP_MEM_MALLOC and MEM_USE_POOLS disabled"
+#endif
+
+#if MEMP_OVERFLOW_CHECK
+#error "lwipmemp.c does not support MEMP_OVERFLOW_CHECK"
+#endif
+
+#if CH_CFG_USE_MEMPOOLS == FALSE
+#error "lwipmemp.c requires CH_CFG_USE_MEMPOOLS"
+#endif
+
+/*
+ * Alignment of the objects.
+ */
+#define POOL_ALIGN                                                          \
+  ((unsigned)(MEM_ALIGNMENT > PORT_NATURAL_ALIGN ? MEM_ALIGNMENT :           \
+                                                   PORT_NATURAL_ALIGN))
+
+/*
+ * Names of the pools in the lwIP statistics.
+ */
+#if MEMP_STATS && (defined(LWIP_DEBUG) || LWIP_STATS_DISPLAY)
+#define POOL_USE_NAMES          1
+#else
+#define POOL_USE_NAMES          0
+#endif
+
+/*
+ * State of an lwIP pool.
+ */
+typedef struct {
+  memory_pool_t             pool;
+#if LWIP_MEMP_MAGAZINE_SIZE > 0
+  pool_magazine_t           magazine;
+  bool                      cached;
+#endif
+  size_t                    num;
+  size_t                    max;
+  /* Counters written with the pool locked.*/
+  int                       used;
+  size_t                    err;
+  /* Counters written by the magazine owner only, objects allocated by
+     other threads can be freed by the owner so the count can be
+     negative.*/
+  int                       owner_used;
+  size_t                    owner_err;
+#if MEMP_STATS
+  struct stats_mem          stats;
+#endif
+} lwip_pool_t;
+
+/*
+ * Objects size and number of the lwIP pools.
+ */
+static const struct {
+  u16_t                     size;
+  u16_t                     num;
+} pool_specs[MEMP_MAX] = {
+#define LWIP_MEMPOOL(name, num, size, desc) {LWIP_MEM_ALIGN_SIZE(size), (num)},
+#include "lwip/priv/memp_std.h"
+};
+
+#if POOL_USE_NAMES
+static const char * const pool_names[MEMP_MAX] = {
+#define LWIP_MEMPOOL(name, num, size, desc) desc,
+#include "lwip/priv/memp_std.h"
+};
+#endif
+
+static lwip_pool_t pools[MEMP_MAX];
+
+/*
+ * Thread using the magazines.
+ */
+static thread_t *magazines_owner;
+
+/*
+ * Updates the high watermark and the lwIP statistics.
+ */
+static void pool_update_stats(lwip_pool_t *lpp) {
+  int used = lpp->used + lpp->owner_used;
+
+  if ((used > 0) && ((size_t)used > lpp->max)) {
+    lpp->max = (size_t)used;
+  }
+#if MEMP_STATS
+  lpp->stats.used = (mem_size_t)used;
+  lpp->stats.max  = (mem_size_t)lpp->max;
+  lpp->stats.err  = (STAT_COUNTER)(lpp->err + lpp->owner_err);
+#endif
+}
+
+#if LWIP_MEMP_MAGAZINE_SIZE > 0
+/*
+ * Checks if the magazine of a pool can be used by the caller.
+ */
+static inline bool pool_use_magazine(const lwip_pool_t *lpp) {
+
+  return lpp->cached && !port_is_isr_context() &&
+         (chThdGetSelfX() == magazines_owner);
+}
+#endif
+
+/**
+ * @brief   Initializes the lwIP pools.
+ * @details Each pool is filled with objects allocated at once from the
+ *          provider selected by @p LWIP_MEMP_PROVIDER().
+ * @note    Called by @p lwip_init().
+ */
+void memp_init(void) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)MEMP_MAX; i++) {
+    lwip_pool_t *lpp = &pools[i];
+    size_t size = MEM_ALIGN_NEXT(pool_specs[i].size, POOL_ALIGN);
+    memgetfunc_t provider = LWIP_MEMP_PROVIDER((memp_t)i);
+    void *p;
+
+    if (size < sizeof (void *)) {
+      size = MEM_ALIGN_NEXT(sizeof (void *), POOL_ALIGN);
+    }
+
+    chPoolObjectInitAligned(&lpp->pool, size, POOL_ALIGN, NULL);
+    lpp->num        = (size_t)0;
+    lpp->max        = (size_t)0;
+    lpp->used       = 0;
+    lpp->err        = (size_t)0;
+    lpp->owner_used = 0;
+    lpp->owner_err  = (size_t)0;
+
+    if (pool_specs[i].num > 0U) {
+      chSysLock();
+      p = provider(size * pool_specs[i].num, POOL_ALIGN);
+      chSysUnlock();
+      chDbgAssert(p != NULL, "pool allocation failed");
+      if (p != NULL) {
+#if MEMP_MEM_INIT
+        memset(p, 0, size * pool_specs[i].num);
+#endif
+        chPoolLoadArray(&lpp->pool, p, pool_specs[i].num);
+        lpp->num = pool_specs[i].num;
+      }
+    }
+
+#if LWIP_MEMP_MAGAZINE_SIZE > 0
+    /* Objects cached by the owner are not available to the other threads,
+       the magazine is limited to a quarter of the pool.*/
+    lpp->cached = (bool)((lpp->num / 4U) > 0U);
+    if (lpp->cached) {
+      chPoolMagazineObjectInit(&lpp->magazine, &lpp->pool,
+                               LWIP_MIN((size_t)LWIP_MEMP_MAGAZINE_SIZE,
+                                        lpp->num / 4U));
+    }
+#endif
+
+#if MEMP_STATS
+    memset(&lpp->stats, 0, sizeof (lpp->stats));
+    lpp->stats.avail = (mem_size_t)lpp->num;
+#if POOL_USE_NAMES
+    lpp->stats.name  = pool_names[i];
+#endif
+    lwip_stats.memp[i] = &lpp->stats;
+#endif
+  }
+}
+
+/**
+ * @brief   Allocates an object from an lwIP pool.
+ *
+ * @param[in] type      the pool type
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if the pool is empty.
+ */
+void *memp_malloc(memp_t type) {
+  lwip_pool_t *lpp;
+  syssts_t sts;
+  void *objp;
+
+  LWIP_ERROR("memp_malloc: type < MEMP_MAX", (type < MEMP_MAX), return NULL;);
+
+  lpp = &pools[type];
+
+#if LWIP_MEMP_MAGAZINE_SIZE > 0
+  if (pool_use_magazine(lpp)) {
+    objp = chPoolMagazineAlloc(&lpp->magazine);
+    if (objp != NULL) {
+      lpp->owner_used++;
+    }
+    else {
+      lpp->owner_err++;
+    }
+    pool_update_stats(lpp);
+
+    return objp;
+  }
+#endif
+
+  /* Can be called from ISRs too.*/
+  sts = chSysGetStatusAndLockX();
+  objp = chPoolAllocI(&lpp->pool);
+  if (objp != NULL) {
+    lpp->used++;
+  }
+  else {
+    lpp->err++;
+  }
+  pool_update_stats(lpp);
+  chSysRestoreStatusX(sts);
+
+  return objp;
+}
+
+/**
+ * @brief   Returns an object to an lwIP pool.
+ *
+ * @param[in] type      the pool type
+ * @param[in] mem       pointer to the object or @p NULL
+ */
+void memp_free(memp_t type, void *mem) {
+  lwip_pool_t *lpp;
+  syssts_t sts;
+
+  LWIP_ERROR("memp_free: type < MEMP_MAX", (type < MEMP_MAX), return;);
+
+  if (mem == NULL) {
+    return;
+  }
+
+  lpp = &pools[type];
+
+#if LWIP_MEMP_MAGAZINE_SIZE > 0
+  if (pool_use_magazine(lpp)) {
+    chPoolMagazineFree(&lpp->magazine, mem);
+    lpp->owner_used--;
+    pool_update_stats(lpp);
+
+    return;
+  }
+#endif
+
+  sts = chSysGetStatusAndLockX();
+  chPoolFreeI(&lpp->pool, mem);
+  lpp->used--;
+  pool_update_stats(lpp);
+  chSysRestoreStatusX(sts);
+}
+
+/**
+ * @brief   Initializes a private pool.
+ * @details Private pools are declared using @p LWIP_MEMPOOL_DECLARE(),
+ *          their objects are in the static array of the declaration.
+ *
+ * @param[in] desc      the pool descriptor
+ */
+void memp_init_pool(const struct memp_desc *desc) {
+  struct memp *memp;
+  u16_t i;
+
+  *desc->tab = NULL;
+  memp = (struct memp *)LWIP_MEM_ALIGN(desc->base);
+#if MEMP_MEM_INIT
+  memset(memp, 0, (size_t)desc->num * (MEMP_SIZE + desc->size));
+#endif
+  for (i = 0U; i < desc->num; i++) {
+    memp->next = *desc->tab;
+    *desc->tab = memp;
+    memp = (struct memp *)(void *)((u8_t *)memp + MEMP_SIZE + desc->size);
+  }
+
+#if MEMP_STATS
+  desc->stats->avail = desc->num;
+#if POOL_USE_NAMES
+  desc->stats->name  = desc->desc;
+#endif
+#endif
+}
+
+/**
+ * @brief   Allocates an object from a private pool.
+ *
+ * @param[in] desc      the pool descriptor
+ * @return              The pointer to the allocated object.
+ * @retval NULL         if the pool is empty.
+ */
+void *memp_malloc_pool(const struct memp_desc *desc) {
+  struct memp *memp;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  LWIP_ERROR("memp_malloc_pool: desc != NULL", (desc != NULL), return NULL;);
+
+  SYS_ARCH_PROTECT(old_level);
+  memp = *desc->tab;
+  if (memp != NULL) {
+    *desc->tab = memp->next;
+#if MEMP_STATS
+    desc->stats->used++;
+    if (desc->stats->used > desc->stats->max) {
+      desc->stats->max = desc->stats->used;
+    }
+#endif
+  }
+#if MEMP_STATS
+  else {
+    desc->stats->err++;
+  }
+#endif
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return (memp != NULL) ? ((u8_t *)memp + MEMP_SIZE) : NULL;
+}
+
+/**
+ * @brief   Returns an object to a private pool.
+ *
+ * @param[in] desc      the pool descriptor
+ * @param[in] mem       pointer to the object or @p NULL
+ */
+void memp_free_pool(const struct memp_desc *desc, void *mem) {
+  struct memp *memp;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  LWIP_ERROR("memp_free_pool: desc != NULL", (desc != NULL), return;);
+
+  if (mem == NULL) {
+    return;
+  }
+
+  memp = (struct memp *)(void *)((u8_t *)mem - MEMP_SIZE);
+
+  SYS_ARCH_PROTECT(old_level);
+  memp->next = *desc->tab;
+  *desc->tab = memp;
+#if MEMP_STATS
+  desc->stats->used--;
+#endif
+  SYS_ARCH_UNPROTECT(old_level);
+}
+
+/**
+ * @brief   Makes the calling thread the owner of the magazines.
+ * @note    The function has the signature of a @p tcpip_init() callback,
+ *          the lwIP thread passes it in order to attach the tcpip thread.
+ *
+ * @param[in] arg       not used
+ */
+void lwipMempAttachThread(void *arg) {
+
+  (void)arg;
+
+  magazines_owner = chThdGetSelfX();
+}
+
+/**
+ * @brief   Returns the usage statistics of an lwIP pool.
+ *
+ * @param[in] type      the pool type
+ * @param[out] stp      pointer to the statistics structure
+ */
+void lwipMempGetStats(memp_t type, lwip_memp_stats_t *stp) {
+  const lwip_pool_t *lpp;
+  int used;
+
+  chDbgCheck((type < MEMP_MAX) && (stp != NULL));
+
+  lpp = &pools[type];
+
+  chSysLock();
+  used = lpp->used + lpp->owner_used;
+  stp->size = lpp->pool.object_size;
+  stp->num  = lpp->num;
+  stp->used = used > 0 ? (size_t)used : (size_t)0;
+  stp->max  = lpp->max;
+  stp->err  = lpp->err + lpp->owner_err;
+  chSysUnlock();
+}
+
+/** @} */
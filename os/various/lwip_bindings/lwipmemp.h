@@ -0,0 +1,108 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    lwipmemp.h
+ * @brief   lwIP memory pools on ChibiOS memory pools.
+ *
+ * @addtogroup LWIP_MEMP
+ * @{
+ */
+
+#ifndef LWIPMEMP_H
+#define LWIPMEMP_H
+
+#include <lwip/opt.h>
+#include <lwip/memp.h>
+
+/**
+ * @brief   lwIP memory pools on ChibiOS memory pools.
+ * @note    This option is defined by lwip.mk when @p USE_LWIP_MEMP_POOLS
+ *          is set to "yes", the lwIP memp module is replaced by
+ *          lwipmemp.c.
+ */
+#if !defined(LWIP_USE_MEMP_POOLS) || defined(__DOXYGEN__)
+#define LWIP_USE_MEMP_POOLS                 FALSE
+#endif
+
+/**
+ * @brief   Memory provider of an lwIP pool.
+ * @details The macro is evaluated once for each @p memp_t pool during
+ *          the lwIP initialization, it must return a @p memgetfunc_t
+ *          function, the objects of the pool are allocated at once from
+ *          it. It allows to place each pool in a different RAM region,
+ *          for example:
+ * @code
+ *  #define LWIP_MEMP_PROVIDER(type)                                        \
+ *    ((type) == MEMP_PBUF_POOL ? dma_ram_alloc : dtcm_alloc)
+ * @endcode
+ */
+#if !defined(LWIP_MEMP_PROVIDER) || defined(__DOXYGEN__)
+#define LWIP_MEMP_PROVIDER(type)            chCoreAllocAlignedI
+#endif
+
+/**
+ * @brief   Size of the tcpip thread magazines.
+ * @details The tcpip thread allocates and frees the lwIP objects through
+ *          per-pool magazines, the pools are locked once per batch.
+ * @note    The magazine of a pool is limited to a quarter of its objects,
+ *          pools with less than four objects are not cached.
+ * @note    Zero disables the magazines.
+ */
+#if !defined(LWIP_MEMP_MAGAZINE_SIZE) || defined(__DOXYGEN__)
+#define LWIP_MEMP_MAGAZINE_SIZE             4
+#endif
+
+/**
+ * @brief   Usage statistics of an lwIP pool.
+ */
+typedef struct {
+  /**
+   * @brief   Objects size.
+   */
+  size_t                    size;
+  /**
+   * @brief   Number of objects.
+   */
+  size_t                    num;
+  /**
+   * @brief   Objects currently allocated by the stack.
+   */
+  size_t                    used;
+  /**
+   * @brief   Highest number of allocated objects.
+   * @note    The value is sampled without locking, it can miss a peak
+   *          reached concurrently by two threads.
+   */
+  size_t                    max;
+  /**
+   * @brief   Failed allocations.
+   */
+  size_t                    err;
+} lwip_memp_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void lwipMempAttachThread(void *arg);
+  void lwipMempGetStats(memp_t type, lwip_memp_stats_t *stp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIPMEMP_H */
+
+/** @} */
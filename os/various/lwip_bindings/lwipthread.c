@@ -56,18 +56,20 @@
  */
 
 #include "hal.h"
-#include "evtimer.h"
 
 #include "lwipthread.h"
+#include "lwipmemp.h"
 
 #include <lwip/opt.h>
 #include <lwip/def.h>
 #include <lwip/mem.h>
+#include <lwip/memp.h>
 #include <lwip/pbuf.h>
 #include <lwip/sys.h>
 #include <lwip/stats.h>
 #include <lwip/snmp.h>
 #include <lwip/tcpip.h>
+#include <lwip/timeouts.h>
 #include <netif/etharp.h>
 #include <lwip/netifapi.h>
 
@@ -79,9 +81,37 @@
 #include <lwip/autoip.h>
 #endif
 
-#define PERIODIC_TIMER_ID       1
+#define LINK_CHANGED_ID         1
 #define FRAME_RECEIVED_ID       2
 
+#if LWIP_USE_ZERO_COPY
+#if !MAC_USE_ZERO_COPY
+#error "LWIP_USE_ZERO_COPY requires MAC_USE_ZERO_COPY"
+#endif
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "LWIP_USE_ZERO_COPY requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+#if ETH_PAD_SIZE
+#error "LWIP_USE_ZERO_COPY requires ETH_PAD_SIZE to be zero"
+#endif
+#if LWIP_ZERO_COPY_RX_PBUFS < 1
+#error "invalid LWIP_ZERO_COPY_RX_PBUFS value"
+#endif
+#endif
+
+#if !LWIP_LINK_EVENTS
+#if MEMP_NUM_SYS_TIMEOUT < LWIP_NUM_SYS_TIMEOUT_INTERNAL + 1
+#error "the link poll requires one more MEMP_NUM_SYS_TIMEOUT"
+#endif
+#endif
+
+#if LWIP_USE_RXTX_THREADS
+#if (LWIP_RXTX_QUEUE_SIZE < 2) ||                                           \
+    ((LWIP_RXTX_QUEUE_SIZE & (LWIP_RXTX_QUEUE_SIZE - 1)) != 0)
+#error "LWIP_RXTX_QUEUE_SIZE must be a power of two"
+#endif
+#endif
+
 /*
  * Suspension point for initialization procedure.
  */
@@ -92,6 +122,144 @@ thread_reference_t lwip_trp = NULL;
  */
 static THD_WORKING_AREA(wa_lwip_thread, LWIP_THREAD_STACK_SIZE);
 
+#if LWIP_LINK_EVENTS
+/*
+ * The LWIP-MAC thread, target of the link change events.
+ */
+static thread_t *lwip_tp;
+#endif
+
+#if LWIP_USE_RXTX_THREADS
+/*
+ * Single producer single consumer frames queue, each index is only
+ * written by its owner side so no locking is required.
+ */
+typedef struct {
+  struct pbuf * volatile    frames[LWIP_RXTX_QUEUE_SIZE];
+  volatile unsigned         wridx;
+  volatile unsigned         rdidx;
+} frames_queue_t;
+
+/*
+ * Number of queued frames.
+ */
+static inline unsigned fq_count(const frames_queue_t *fqp) {
+
+  return fqp->wridx - fqp->rdidx;
+}
+
+/*
+ * Inserts a frame, the queue must not be full.
+ */
+static inline void fq_put(frames_queue_t *fqp, struct pbuf *p) {
+
+  fqp->frames[fqp->wridx & (LWIP_RXTX_QUEUE_SIZE - 1U)] = p;
+  fqp->wridx++;
+}
+
+/*
+ * Removes a frame, the queue must not be empty.
+ */
+static inline struct pbuf *fq_get(frames_queue_t *fqp) {
+  struct pbuf *p;
+
+  p = fqp->frames[fqp->rdidx & (LWIP_RXTX_QUEUE_SIZE - 1U)];
+  fqp->rdidx++;
+  return p;
+}
+
+/*
+ * Received frames, from the RX thread to the tcpip thread.
+ */
+static frames_queue_t rxq;
+static binary_semaphore_t rxq_space;
+static struct tcpip_callback_msg *rxq_msg;
+static volatile bool rxq_posted;
+
+/*
+ * Frames to be transmitted, from the tcpip thread to the TX thread.
+ */
+static frames_queue_t txq;
+static binary_semaphore_t txq_data;
+static binary_semaphore_t txq_space;
+
+/*
+ * Stack areas for the RX and TX threads.
+ */
+static THD_WORKING_AREA(wa_lwip_rx_thread, LWIP_RX_THREAD_STACK_SIZE);
+static THD_WORKING_AREA(wa_lwip_tx_thread, LWIP_TX_THREAD_STACK_SIZE);
+#endif
+
+#if LWIP_USE_ZERO_COPY
+/*
+ * Custom pbuf referencing a MAC receive buffer, the descriptor is kept
+ * until the pbuf is freed.
+ */
+typedef struct {
+  struct pbuf_custom p;
+  MACReceiveDescriptor rd;
+} rx_pbuf_t;
+
+LWIP_MEMPOOL_DECLARE(RX_PBUF_POOL, LWIP_ZERO_COPY_RX_PBUFS,
+                     sizeof(rx_pbuf_t), "Zero-copy RX pbufs");
+
+/*
+ * Releases the receive descriptor of a custom pbuf.
+ */
+static void rx_pbuf_free(struct pbuf *p) {
+  rx_pbuf_t *rxp = (rx_pbuf_t *)p;
+
+  macReleaseReceiveDescriptor(&rxp->rd);
+  LWIP_MEMPOOL_FREE(RX_PBUF_POOL, rxp);
+}
+
+/*
+ * Wraps a received frame into a custom pbuf, returns NULL if no custom
+ * pbufs are available or the frame is not in a single buffer.
+ */
+static struct pbuf *rx_pbuf_alloc(const MACReceiveDescriptor *rdp) {
+  rx_pbuf_t *rxp;
+  const uint8_t *buf;
+  size_t size;
+
+  rxp = (rx_pbuf_t *)LWIP_MEMPOOL_ALLOC(RX_PBUF_POOL);
+  if (rxp == NULL)
+    return NULL;
+
+  /* Working on a copy of the descriptor, the original one is left
+     untouched for the copy fallback.*/
+  rxp->rd = *rdp;
+  buf = macGetNextReceiveBuffer(&rxp->rd, &size);
+  if ((buf == NULL) || (size != rdp->size)) {
+    LWIP_MEMPOOL_FREE(RX_PBUF_POOL, rxp);
+    return NULL;
+  }
+
+  rxp->p.custom_free_function = rx_pbuf_free;
+  return pbuf_alloced_custom(PBUF_RAW, (u16_t)size, PBUF_REF, &rxp->p,
+                             (void *)buf, (u16_t)size);
+}
+#endif
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+/*
+ * Checksum operations that can be offloaded to the MAC.
+ */
+static const struct {
+  unsigned mac_flag;
+  u16_t    netif_flag;
+} checksum_offload_map[] = {
+  {MAC_CHECKSUM_GEN_IP,     NETIF_CHECKSUM_GEN_IP},
+  {MAC_CHECKSUM_GEN_UDP,    NETIF_CHECKSUM_GEN_UDP},
+  {MAC_CHECKSUM_GEN_TCP,    NETIF_CHECKSUM_GEN_TCP},
+  {MAC_CHECKSUM_GEN_ICMP,   NETIF_CHECKSUM_GEN_ICMP},
+  {MAC_CHECKSUM_CHECK_IP,   NETIF_CHECKSUM_CHECK_IP},
+  {MAC_CHECKSUM_CHECK_UDP,  NETIF_CHECKSUM_CHECK_UDP},
+  {MAC_CHECKSUM_CHECK_TCP,  NETIF_CHECKSUM_CHECK_TCP},
+  {MAC_CHECKSUM_CHECK_ICMP, NETIF_CHECKSUM_CHECK_ICMP}
+};
+#endif
+
 /*
  * Initialization.
  */
@@ -106,6 +274,20 @@ static void low_level_init(struct netif *netif) {
   /* don't set NETIF_FLAG_ETHARP if this device is not an Ethernet one */
   netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+  /* checksums offloaded to the MAC are not handled by the stack */
+  {
+    u16_t flags = NETIF_CHECKSUM_ENABLE_ALL;
+    unsigned i;
+
+    for (i = 0; i < sizeof (checksum_offload_map) / sizeof (checksum_offload_map[0]); i++) {
+      if ((MAC_CHECKSUM_OFFLOAD & checksum_offload_map[i].mac_flag) != 0U)
+        flags &= (u16_t)~checksum_offload_map[i].netif_flag;
+    }
+    NETIF_SET_CHECKSUM_CTRL(netif, flags);
+  }
+#endif
+
   /* Do whatever else is needed to initialize interface. */
 }
 
@@ -124,8 +306,10 @@ static void low_level_init(struct netif *netif) {
  *       to become available since the stack doesn't retry to send a packet
  *       dropped because of memory failure (except for the TCP timers).
  */
-static err_t low_level_output(struct netif *netif, struct pbuf *p) {
+static err_t low_level_transmit(struct netif *netif, struct pbuf *p) {
+#if !LWIP_USE_ZERO_COPY
   struct pbuf *q;
+#endif
   MACTransmitDescriptor td;
 
   (void)netif;
@@ -136,9 +320,26 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p) {
   pbuf_header(p, -ETH_PAD_SIZE);        /* drop the padding word */
 #endif
 
+#if LWIP_USE_ZERO_COPY
+  {
+    uint8_t *buf;
+    size_t size;
+    u16_t offset = 0;
+
+    /* Assembling the frame directly into the MAC buffers.*/
+    while ((offset < p->tot_len) &&
+           ((buf = macGetNextTransmitBuffer(&td, p->tot_len - offset,
+                                            &size)) != NULL)) {
+      if (size > (size_t)(p->tot_len - offset))
+        size = (size_t)(p->tot_len - offset);
+      offset += pbuf_copy_partial(p, buf, (u16_t)size, offset);
+    }
+  }
+#else
   /* Iterates through the pbuf chain. */
   for(q = p; q != NULL; q = q->next)
     macWriteTransmitDescriptor(&td, (uint8_t *)q->payload, (size_t)q->len);
+#endif
   macReleaseTransmitDescriptor(&td);
 
   MIB2_STATS_NETIF_ADD(netif, ifoutoctets, p->tot_len);
@@ -161,6 +362,53 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p) {
   return ERR_OK;
 }
 
+/*
+ * Link output function, the frame is either transmitted or queued for
+ * the TX thread.
+ */
+static err_t low_level_output(struct netif *netif, struct pbuf *p) {
+#if LWIP_USE_RXTX_THREADS
+  struct pbuf *q;
+
+  (void)netif;
+
+  /* The frame is transmitted after returning, volatile payloads are
+     copied, the other ones are just referenced.*/
+  for (q = p; q != NULL; q = q->next) {
+    if (PBUF_NEEDS_COPY(q))
+      break;
+  }
+  if (q != NULL) {
+    p = pbuf_clone(PBUF_RAW, PBUF_RAM, p);
+    if (p == NULL) {
+      LINK_STATS_INC(link.memerr);
+      LINK_STATS_INC(link.drop);
+      return ERR_MEM;
+    }
+  }
+  else
+    pbuf_ref(p);
+
+  while (fq_count(&txq) >= LWIP_RXTX_QUEUE_SIZE) {
+    if (chBSemWaitTimeout(&txq_space,
+                          TIME_MS2I(LWIP_SEND_TIMEOUT)) == MSG_TIMEOUT) {
+      pbuf_free(p);
+      LINK_STATS_INC(link.drop);
+      return ERR_TIMEOUT;
+    }
+  }
+
+  /* The TX thread only sleeps after finding the queue empty.*/
+  fq_put(&txq, p);
+  if (fq_count(&txq) == 1U)
+    chBSemSignal(&txq_data);
+
+  return ERR_OK;
+#else
+  return low_level_transmit(netif, p);
+#endif
+}
+
 /*
  * Receives a frame.
  * Allocates a pbuf and transfers the bytes of the incoming
@@ -174,6 +422,7 @@ static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
   MACReceiveDescriptor rd;
   struct pbuf *q;
   u16_t len;
+  bool ref = false;
 
   (void)netif;
 
@@ -188,6 +437,13 @@ static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
   len += ETH_PAD_SIZE;        /* allow room for Ethernet padding */
 #endif
 
+#if LWIP_USE_ZERO_COPY
+  /* Referencing the receive buffer if possible, the descriptor is
+     released when the pbuf is freed.*/
+  *pbuf = rx_pbuf_alloc(&rd);
+  ref = (bool)(*pbuf != NULL);
+  if (!ref)
+#endif
   /* We allocate a pbuf chain of pbufs from the pool. */
   *pbuf = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
 
@@ -196,10 +452,12 @@ static bool low_level_input(struct netif *netif, struct pbuf **pbuf) {
     pbuf_header(*pbuf, -ETH_PAD_SIZE); /* drop the padding word */
 #endif
 
-    /* Iterates through the pbuf chain. */
-    for(q = *pbuf; q != NULL; q = q->next)
-      macReadReceiveDescriptor(&rd, (uint8_t *)q->payload, (size_t)q->len);
-    macReleaseReceiveDescriptor(&rd);
+    if (!ref) {
+      /* Iterates through the pbuf chain. */
+      for(q = *pbuf; q != NULL; q = q->next)
+        macReadReceiveDescriptor(&rd, (uint8_t *)q->payload, (size_t)q->len);
+      macReleaseReceiveDescriptor(&rd);
+    }
 
     MIB2_STATS_NETIF_ADD(netif, ifinoctets, (*pbuf)->tot_len);
 
@@ -269,6 +527,8 @@ static err_t ethernetif_init(struct netif *netif) {
 static net_addr_mode_t addressMode;
 static ip4_addr_t ip, gateway, netmask;
 static struct netif thisif;
+static tcpip_callback_fn link_up_cb;
+static tcpip_callback_fn link_down_cb;
 
 void lwipDefaultLinkUpCB(void *p)
 {
@@ -298,6 +558,146 @@ void lwipDefaultLinkDownCB(void *p)
 #endif
 }
 
+/*
+ * Updates the interface link status, runs in the tcpip thread.
+ */
+static void link_check(void *arg) {
+  bool current_link_status;
+
+  (void)arg;
+
+  current_link_status = macPollLinkStatus(&ETHD1);
+  if (current_link_status != netif_is_link_up(&thisif)) {
+    if (current_link_status) {
+      netif_set_link_up(&thisif);
+      link_up_cb(&thisif);
+    }
+    else {
+      netif_set_link_down(&thisif);
+      link_down_cb(&thisif);
+    }
+  }
+}
+
+#if !LWIP_LINK_EVENTS
+/*
+ * Link status poll, it is an lwIP timeout so the tcpip thread keeps a
+ * single wakeup for all the timed activities.
+ */
+static void link_poll(void *arg) {
+
+  link_check(arg);
+  sys_timeout((u32_t)TIME_I2MS(LWIP_LINK_POLL_INTERVAL), link_poll, NULL);
+}
+#endif
+
+#if LWIP_USE_RXTX_THREADS
+/*
+ * Passes the queued frames to the stack, runs in the tcpip thread.
+ */
+static void rxq_drain(void *arg) {
+
+  (void)arg;
+
+  /* Cleared before draining, frames queued from now on post the message
+     again.*/
+  rxq_posted = false;
+  while (fq_count(&rxq) > 0U) {
+    struct pbuf *p = fq_get(&rxq);
+
+    /* The RX thread only sleeps after finding the queue full.*/
+    if (fq_count(&rxq) == LWIP_RXTX_QUEUE_SIZE - 1U)
+      chBSemSignal(&rxq_space);
+
+    if (ethernet_input(p, &thisif) != ERR_OK) {
+      LWIP_DEBUGF(NETIF_DEBUG, ("ethernetif_input: IP input error\n"));
+      pbuf_free(p);
+    }
+  }
+}
+
+/**
+ * @brief   lwIP driver RX thread.
+ *
+ * @param[in] arg       not used
+ * @return              The function does not return.
+ */
+static THD_FUNCTION(lwip_rx_thread, arg) {
+  event_listener_t el;
+
+  (void)arg;
+  chRegSetThreadName(LWIP_THREAD_NAME "_rx");
+
+  chEvtRegisterMask(macGetReceiveEventSource(&ETHD1), &el, FRAME_RECEIVED_ID);
+  chEvtAddEvents(FRAME_RECEIVED_ID);
+
+  while (true) {
+    struct pbuf *p;
+
+    (void) chEvtWaitAny(FRAME_RECEIVED_ID);
+
+    while (true) {
+      /* Frames are left in the MAC while the queue is full.*/
+      while (fq_count(&rxq) >= LWIP_RXTX_QUEUE_SIZE)
+        (void) chBSemWait(&rxq_space);
+
+      if (!low_level_input(&thisif, &p))
+        break;
+      if (p == NULL)
+        continue;
+
+      switch (htons(((struct eth_hdr *)p->payload)->type)) {
+      /* IP or ARP packet? */
+      case ETHTYPE_IP:
+      case ETHTYPE_ARP:
+        break;
+      default:
+        pbuf_free(p);
+        continue;
+      }
+
+      /* A single message is posted for all the frames queued before the
+         tcpip thread drains the queue.*/
+      fq_put(&rxq, p);
+      if (!rxq_posted) {
+        rxq_posted = true;
+        while (tcpip_callbackmsg_trycallback(rxq_msg) != ERR_OK)
+          chThdSleepMilliseconds(1);
+      }
+    }
+  }
+}
+
+/**
+ * @brief   lwIP driver TX thread.
+ *
+ * @param[in] p         not used
+ * @return              The function does not return.
+ */
+static THD_FUNCTION(lwip_tx_thread, p) {
+
+  (void)p;
+  chRegSetThreadName(LWIP_THREAD_NAME "_tx");
+
+  while (true) {
+    struct pbuf *q;
+
+    while (fq_count(&txq) == 0U)
+      (void) chBSemWait(&txq_data);
+
+    q = fq_get(&txq);
+
+    /* The tcpip thread only sleeps after finding the queue full.*/
+    if (fq_count(&txq) == LWIP_RXTX_QUEUE_SIZE - 1U)
+      chBSemSignal(&txq_space);
+
+    if (low_level_transmit(&thisif, q) != ERR_OK)
+      LINK_STATS_INC(link.drop);
+    pbuf_free(q);
+  }
+}
+#endif
+
 /**
  * @brief LWIP handling thread.
  *
@@ -305,17 +705,21 @@ void lwipDefaultLinkDownCB(void *p)
  * @return The function does not return.
  */
 static THD_FUNCTION(lwip_thread, p) {
-  event_timer_t evt;
-  event_listener_t el0, el1;
+#if !LWIP_USE_RXTX_THREADS
+  event_listener_t el;
+#endif
   static const MACConfig mac_config = {thisif.hwaddr};
   err_t result;
-  tcpip_callback_fn link_up_cb = NULL;
-  tcpip_callback_fn link_down_cb = NULL;
 
   chRegSetThreadName(LWIP_THREAD_NAME);
 
   /* Initializes the thing.*/
+#if LWIP_USE_MEMP_POOLS
+  /* The tcpip thread owns the pools magazines.*/
+  tcpip_init(lwipMempAttachThread, NULL);
+#else
   tcpip_init(NULL, NULL);
+#endif
 
   /* TCP/IP parameters, runtime or compile time.*/
   if (p) {
@@ -366,6 +770,10 @@ static THD_FUNCTION(lwip_thread, p) {
     thisif.hostname = LWIP_NETIF_HOSTNAME_STRING;
 #endif
 
+#if LWIP_USE_ZERO_COPY
+  LWIP_MEMPOOL_INIT(RX_PBUF_POOL);
+#endif
+
   macStart(&ETHD1, &mac_config);
 
   MIB2_INIT_NETIF(&thisif, snmp_ifType_ethernet_csmacd, 0);
@@ -378,38 +786,55 @@ static THD_FUNCTION(lwip_thread, p) {
     osalSysHalt("netif_add error");   // Not sure what else we can do if an error occurs here.
   };
 
+#if LWIP_USE_RXTX_THREADS
+  /* Driver threads, started before the interface is brought up.*/
+  rxq_msg = tcpip_callbackmsg_new(rxq_drain, NULL);
+  osalDbgAssert(rxq_msg != NULL, "callback message allocation failed");
+  chBSemObjectInit(&rxq_space, true);
+  chBSemObjectInit(&txq_data, true);
+  chBSemObjectInit(&txq_space, true);
+  chThdCreateStatic(wa_lwip_rx_thread, sizeof (wa_lwip_rx_thread),
+                    LWIP_RX_THREAD_PRIORITY, lwip_rx_thread, NULL);
+  chThdCreateStatic(wa_lwip_tx_thread, sizeof (wa_lwip_tx_thread),
+                    LWIP_TX_THREAD_PRIORITY, lwip_tx_thread, NULL);
+#endif
+
   netifapi_netif_set_default(&thisif);
   netifapi_netif_set_up(&thisif);
 
+  /* Initial link status, then either link change events or a poll
+     running as an lwIP timeout, this thread never wakes up on time.*/
+#if LWIP_LINK_EVENTS
+  lwip_tp = chThdGetSelfX();
+  tcpip_callback_with_block(link_check, NULL, 1);
+#else
+  tcpip_callback_with_block(link_poll, NULL, 1);
+#endif
+
   /* Setup event sources.*/
-  evtObjectInit(&evt, LWIP_LINK_POLL_INTERVAL);
-  evtStart(&evt);
-  chEvtRegisterMask(&evt.et_es, &el0, PERIODIC_TIMER_ID);
-  chEvtRegisterMask(macGetReceiveEventSource(&ETHD1), &el1, FRAME_RECEIVED_ID);
-  chEvtAddEvents(PERIODIC_TIMER_ID | FRAME_RECEIVED_ID);
+#if !LWIP_USE_RXTX_THREADS
+  chEvtRegisterMask(macGetReceiveEventSource(&ETHD1), &el, FRAME_RECEIVED_ID);
+  chEvtAddEvents(FRAME_RECEIVED_ID);
+#endif
 
   /* Resumes the caller and goes to the final priority.*/
   chThdResume(&lwip_trp, MSG_OK);
   chThdSetPriority(LWIP_THREAD_PRIORITY);
 
+#if LWIP_USE_RXTX_THREADS && !LWIP_LINK_EVENTS
+  /* Nothing left to be done by this thread.*/
+  chThdExit(MSG_OK);
+#else
   while (true) {
     eventmask_t mask = chEvtWaitAny(ALL_EVENTS);
-    if (mask & PERIODIC_TIMER_ID) {
-      bool current_link_status = macPollLinkStatus(&ETHD1);
-      if (current_link_status != netif_is_link_up(&thisif)) {
-        if (current_link_status) {
-          tcpip_callback_with_block((tcpip_callback_fn) netif_set_link_up,
-                                     &thisif, 0);
-          tcpip_callback_with_block(link_up_cb, &thisif, 0);
-        }
-        else {
-          tcpip_callback_with_block((tcpip_callback_fn) netif_set_link_down,
-                                     &thisif, 0);
-          tcpip_callback_with_block(link_down_cb, &thisif, 0);
-        }
-      }
+#if LWIP_LINK_EVENTS
+    if (mask & LINK_CHANGED_ID) {
+      /* Bursts of events are merged, the status is read only once.*/
+      tcpip_callback_with_block(link_check, NULL, 1);
     }
+#endif
 
+#if !LWIP_USE_RXTX_THREADS
     if (mask & FRAME_RECEIVED_ID) {
       struct pbuf *p;
       while (low_level_input(&thisif, &p)) {
@@ -430,7 +855,9 @@ static THD_FUNCTION(lwip_thread, p) {
         }
       }
     }
+#endif
   }
+#endif
 }
 
 /**
@@ -454,6 +881,25 @@ void lwipInit(const lwipthread_opts_t *opts) {
   chSysUnlock();
 }
 
+#if LWIP_LINK_EVENTS || defined(__DOXYGEN__)
+/**
+ * @brief   Notifies a link status change.
+ * @details The link status is read again and the interface updated, the
+ *          function is meant to be called from the PHY interrupt handler.
+ * @note    Notifications received before the end of @p lwipInit() are
+ *          ignored, the link status is read anyway after initialization.
+ *
+ * @iclass
+ */
+void lwipLinkChangedI(void) {
+
+  chDbgCheckClassI();
+
+  if (lwip_tp != NULL)
+    chEvtSignalI(lwip_tp, LINK_CHANGED_ID);
+}
+#endif
+
 typedef struct lwip_reconf_params {
   const lwipreconf_opts_t *opts;
   semaphore_t completion;
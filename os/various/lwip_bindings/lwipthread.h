@@ -63,11 +63,22 @@
 
 /**
  * @brief   Link poll interval.
+ * @note    The poll runs as an lwIP timeout in the tcpip thread, it
+ *          requires one more @p MEMP_NUM_SYS_TIMEOUT.
  */
 #if !defined(LWIP_LINK_POLL_INTERVAL) || defined(__DOXYGEN__)
 #define LWIP_LINK_POLL_INTERVAL             TIME_S2I(5)
 #endif
 
+/**
+ * @brief   Enables the event-driven link status.
+ * @details The link status is not polled, it is read when the PHY
+ *          interrupt handler calls @p lwipLinkChangedI().
+ */
+#if !defined(LWIP_LINK_EVENTS) || defined(__DOXYGEN__)
+#define LWIP_LINK_EVENTS                    FALSE
+#endif
+
 /**
  *  @brief  IP Address.
  */
@@ -103,6 +114,77 @@
 #define LWIP_LINK_SPEED                     100000000
 #endif
 
+/**
+ * @brief   Enables the zero-copy mode.
+ * @details Received frames are passed to the stack as custom pbufs
+ *          referencing the MAC receive buffers, the descriptors are
+ *          released when the pbufs are freed. Transmitted frames are
+ *          assembled directly into the MAC transmit buffers.
+ * @note    Requires @p MAC_USE_ZERO_COPY and @p LWIP_SUPPORT_CUSTOM_PBUF,
+ *          @p ETH_PAD_SIZE must be zero.
+ */
+#if !defined(LWIP_USE_ZERO_COPY) || defined(__DOXYGEN__)
+#define LWIP_USE_ZERO_COPY                  FALSE
+#endif
+
+/**
+ * @brief   Number of received frames that can be referenced by pbufs.
+ * @note    Each referenced frame holds a MAC receive descriptor, this
+ *          value should be lower than the number of receive descriptors
+ *          or the MAC could stall while the stack holds the frames. When
+ *          all the references are in use the received frames are copied
+ *          into pool pbufs.
+ */
+#if !defined(LWIP_ZERO_COPY_RX_PBUFS) || defined(__DOXYGEN__)
+#define LWIP_ZERO_COPY_RX_PBUFS             2
+#endif
+
+/**
+ * @brief   Enables the dedicated driver RX and TX threads.
+ * @details Received frames are read by an RX thread and passed to the
+ *          tcpip thread in batches through a lock-free queue, transmitted
+ *          frames are queued by the tcpip thread and written into the MAC
+ *          by a TX thread.
+ */
+#if !defined(LWIP_USE_RXTX_THREADS) || defined(__DOXYGEN__)
+#define LWIP_USE_RXTX_THREADS               FALSE
+#endif
+
+/**
+ * @brief   RX and TX queues size, must be a power of two.
+ */
+#if !defined(LWIP_RXTX_QUEUE_SIZE) || defined(__DOXYGEN__)
+#define LWIP_RXTX_QUEUE_SIZE                8
+#endif
+
+/**
+ * @brief   RX thread priority.
+ */
+#if !defined(LWIP_RX_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define LWIP_RX_THREAD_PRIORITY             LWIP_THREAD_PRIORITY
+#endif
+
+/**
+ * @brief   RX thread stack size.
+ */
+#if !defined(LWIP_RX_THREAD_STACK_SIZE) || defined(__DOXYGEN__)
+#define LWIP_RX_THREAD_STACK_SIZE           512
+#endif
+
+/**
+ * @brief   TX thread priority.
+ */
+#if !defined(LWIP_TX_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define LWIP_TX_THREAD_PRIORITY             LWIP_THREAD_PRIORITY
+#endif
+
+/**
+ * @brief   TX thread stack size.
+ */
+#if !defined(LWIP_TX_THREAD_STACK_SIZE) || defined(__DOXYGEN__)
+#define LWIP_TX_THREAD_STACK_SIZE           384
+#endif
+
 /**
  * @brief   MAC Address byte 0.
  */
@@ -265,6 +347,9 @@ extern "C" {
   void lwipDefaultLinkUpCB(void *p);
   void lwipDefaultLinkDownCB(void *p);
   void lwipInit(const lwipthread_opts_t *opts);
+#if LWIP_LINK_EVENTS
+  void lwipLinkChangedI(void);
+#endif
   void lwipReconfigure(const lwipreconf_opts_t *opts);
 #ifdef __cplusplus
 }
@@ -0,0 +1,254 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ncmif.c
+ * @brief   lwIP network interface on a USB CDC-NCM function.
+ * @details The interface is added passing the @p USBNcmDriver object as
+ *          state and @p ncmifInit() as init function, the Ethernet
+ *          address must be set in the netif before adding it:
+ * @code
+ *  netifapi_netif_add(&ncmif, &ip, &netmask, &gateway,
+ *                     &NCMD1, ncmifInit, tcpip_input);
+ * @endcode
+ *          Received datagrams are read by a dedicated thread, transmitted
+ *          datagrams are copied directly into the NTB being assembled.
+ *
+ * @addtogroup LWIP_NCMIF
+ * @{
+ */
+
+#include "hal.h"
+
+#include "ncmif.h"
+
+#include <lwip/def.h>
+#include <lwip/memp.h>
+#include <lwip/pbuf.h>
+#include <lwip/stats.h>
+#include <lwip/snmp.h>
+#include <lwip/netifapi.h>
+#include <netif/etharp.h>
+
+#if NCMIF_USE_ZERO_COPY
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "NCMIF_USE_ZERO_COPY requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+#if ETH_PAD_SIZE
+#error "NCMIF_USE_ZERO_COPY requires ETH_PAD_SIZE to be zero"
+#endif
+#if NCMIF_ZERO_COPY_RX_PBUFS < 1
+#error "invalid NCMIF_ZERO_COPY_RX_PBUFS value"
+#endif
+#endif
+
+static THD_WORKING_AREA(wa_ncmif_thread, NCMIF_THREAD_STACK_SIZE);
+
+#if NCMIF_USE_ZERO_COPY
+/*
+ * Custom pbuf referencing a datagram inside a received NTB.
+ */
+typedef struct {
+  struct pbuf_custom p;
+  USBNcmDriver *ncmp;
+} rx_pbuf_t;
+
+LWIP_MEMPOOL_DECLARE(NCMIF_RX_PBUF_POOL, NCMIF_ZERO_COPY_RX_PBUFS,
+                     sizeof(rx_pbuf_t), "NCM zero-copy RX pbufs");
+
+/*
+ * Releases the datagram referenced by a custom pbuf.
+ */
+static void rx_pbuf_free(struct pbuf *p) {
+  rx_pbuf_t *rxp = (rx_pbuf_t *)p;
+
+  ncmReleaseReceiveDatagram(rxp->ncmp);
+  LWIP_MEMPOOL_FREE(NCMIF_RX_PBUF_POOL, rxp);
+}
+
+/*
+ * Wraps a received datagram into a custom pbuf, returns NULL if no custom
+ * pbufs are available.
+ */
+static struct pbuf *rx_pbuf_alloc(USBNcmDriver *ncmp,
+                                  const uint8_t *dp, size_t n) {
+  rx_pbuf_t *rxp;
+
+  rxp = (rx_pbuf_t *)LWIP_MEMPOOL_ALLOC(NCMIF_RX_PBUF_POOL);
+  if (rxp == NULL)
+    return NULL;
+
+  rxp->ncmp = ncmp;
+  rxp->p.custom_free_function = rx_pbuf_free;
+  return pbuf_alloced_custom(PBUF_RAW, (u16_t)n, PBUF_REF, &rxp->p,
+                             (void *)dp, (u16_t)n);
+}
+#endif
+
+/*
+ * Link output function, the frame is copied into the NTB being assembled.
+ */
+static err_t ncmif_output(struct netif *netif, struct pbuf *p) {
+  USBNcmDriver *ncmp = (USBNcmDriver *)netif->state;
+  uint8_t *buf;
+
+  if (p->tot_len > USB_NCM_MAX_DATAGRAM_SIZE) {
+    LINK_STATS_INC(link.lenerr);
+    LINK_STATS_INC(link.drop);
+    return ERR_BUF;
+  }
+
+  if (ncmGetTransmitBufferTimeout(ncmp, (size_t)p->tot_len, &buf,
+                                  TIME_MS2I(NCMIF_SEND_TIMEOUT)) != MSG_OK) {
+    LINK_STATS_INC(link.drop);
+    MIB2_STATS_NETIF_INC(netif, ifoutdiscards);
+    return ERR_TIMEOUT;
+  }
+
+  (void) pbuf_copy_partial(p, buf, p->tot_len, 0);
+  ncmCommitTransmitBuffer(ncmp, (size_t)p->tot_len);
+
+  MIB2_STATS_NETIF_ADD(netif, ifoutoctets, p->tot_len);
+  if (((u8_t *)p->payload)[0] & 1) {
+    /* broadcast or multicast packet*/
+    MIB2_STATS_NETIF_INC(netif, ifoutnucastpkts);
+  }
+  else {
+    /* unicast packet */
+    MIB2_STATS_NETIF_INC(netif, ifoutucastpkts);
+  }
+  LINK_STATS_INC(link.xmit);
+
+  return ERR_OK;
+}
+
+/*
+ * Wraps or copies a received datagram into a pbuf, the datagram is
+ * released if it is not referenced.
+ */
+static struct pbuf *ncmif_input(struct netif *netif, USBNcmDriver *ncmp,
+                                const uint8_t *dp, size_t n) {
+  struct pbuf *p;
+
+  (void)netif;
+
+#if NCMIF_USE_ZERO_COPY
+  p = rx_pbuf_alloc(ncmp, dp, n);
+  if (p != NULL)
+    return p;
+#endif
+
+  p = pbuf_alloc(PBUF_RAW, (u16_t)n, PBUF_POOL);
+  if (p != NULL)
+    (void) pbuf_take(p, dp, (u16_t)n);
+  ncmReleaseReceiveDatagram(ncmp);
+
+  return p;
+}
+
+/**
+ * @brief   Interface RX thread.
+ * @details Received datagrams are passed to the stack, the link status
+ *          follows the connection status of the NCM function.
+ *
+ * @param[in] arg       pointer to the @p netif structure
+ * @return              The function does not return.
+ */
+static THD_FUNCTION(ncmif_thread, arg) {
+  struct netif *netif = (struct netif *)arg;
+  USBNcmDriver *ncmp = (USBNcmDriver *)netif->state;
+  bool up = false;
+
+  chRegSetThreadName("ncmif");
+
+  while (true) {
+    const uint8_t *dp;
+    size_t n;
+    struct pbuf *p;
+    msg_t msg;
+
+    msg = ncmGetReceiveDatagramTimeout(ncmp, &dp, &n,
+                                       NCMIF_LINK_POLL_INTERVAL);
+
+    if (ncmIsConnectedX(ncmp) != up) {
+      up = !up;
+      if (up)
+        (void) netifapi_netif_set_link_up(netif);
+      else
+        (void) netifapi_netif_set_link_down(netif);
+    }
+
+    if (msg != MSG_OK) {
+      /* Not connected, the driver returns immediately.*/
+      if (msg == MSG_RESET)
+        chThdSleep(NCMIF_LINK_POLL_INTERVAL);
+      continue;
+    }
+
+    p = ncmif_input(netif, ncmp, dp, n);
+    if (p == NULL) {
+      LINK_STATS_INC(link.memerr);
+      LINK_STATS_INC(link.drop);
+      MIB2_STATS_NETIF_INC(netif, ifindiscards);
+      continue;
+    }
+
+    MIB2_STATS_NETIF_ADD(netif, ifinoctets, p->tot_len);
+    LINK_STATS_INC(link.recv);
+
+    if (netif->input(p, netif) != ERR_OK)
+      pbuf_free(p);
+  }
+}
+
+/**
+ * @brief   Network interface initialization.
+ * @details To be passed to @p netif_add() with the @p USBNcmDriver object
+ *          as state, the RX thread is started. The link is initially down.
+ * @pre     The NCM function must have been started.
+ * @note    A single interface is supported.
+ *
+ * @param[in] netif     the lwIP network interface structure
+ * @return              The initialization status.
+ * @retval ERR_OK       if the interface has been initialized.
+ */
+err_t ncmifInit(struct netif *netif) {
+
+  osalDbgAssert((netif != NULL) && (netif->state != NULL),
+                "invalid netif");
+
+  MIB2_INIT_NETIF(netif, snmp_ifType_ethernet_csmacd,
+                  ((USBNcmDriver *)netif->state)->config->speed);
+
+  netif->name[0] = NCMIF_IFNAME0;
+  netif->name[1] = NCMIF_IFNAME1;
+  netif->output = etharp_output;
+  netif->linkoutput = ncmif_output;
+  netif->hwaddr_len = ETHARP_HWADDR_LEN;
+  netif->mtu = USB_NCM_MAX_DATAGRAM_SIZE - SIZEOF_ETH_HDR;
+  netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP;
+
+#if NCMIF_USE_ZERO_COPY
+  LWIP_MEMPOOL_INIT(NCMIF_RX_PBUF_POOL);
+#endif
+
+  chThdCreateStatic(wa_ncmif_thread, sizeof (wa_ncmif_thread),
+                    NCMIF_THREAD_PRIORITY, ncmif_thread, netif);
+
+  return ERR_OK;
+}
+
+/** @} */
@@ -0,0 +1,110 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ncmif.h
+ * @brief   lwIP network interface on a USB CDC-NCM function.
+ *
+ * @addtogroup LWIP_NCMIF
+ * @{
+ */
+
+#ifndef NCMIF_H
+#define NCMIF_H
+
+#include <lwip/opt.h>
+#include <lwip/netif.h>
+
+#include "hal_usb_ncm.h"
+
+/**
+ * @brief   Priority of the interface RX thread.
+ */
+#if !defined(NCMIF_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define NCMIF_THREAD_PRIORITY               LOWPRIO
+#endif
+
+/**
+ * @brief   Stack size of the interface RX thread.
+ */
+#if !defined(NCMIF_THREAD_STACK_SIZE) || defined(__DOXYGEN__)
+#define NCMIF_THREAD_STACK_SIZE             512
+#endif
+
+/**
+ * @brief   Link status check interval.
+ * @details The RX thread checks the connection status when a datagram is
+ *          received or after waiting this interval.
+ */
+#if !defined(NCMIF_LINK_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define NCMIF_LINK_POLL_INTERVAL            TIME_MS2I(100)
+#endif
+
+/**
+ * @brief   Transmit timeout in milliseconds.
+ */
+#if !defined(NCMIF_SEND_TIMEOUT) || defined(__DOXYGEN__)
+#define NCMIF_SEND_TIMEOUT                  50
+#endif
+
+/**
+ * @brief   Enables the zero-copy receive mode.
+ * @details Received datagrams are passed to the stack as custom pbufs
+ *          referencing the NTB buffer, the datagrams are released when
+ *          the pbufs are freed.
+ * @note    Requires @p LWIP_SUPPORT_CUSTOM_PBUF, @p ETH_PAD_SIZE must be
+ *          zero.
+ */
+#if !defined(NCMIF_USE_ZERO_COPY) || defined(__DOXYGEN__)
+#define NCMIF_USE_ZERO_COPY                 TRUE
+#endif
+
+/**
+ * @brief   Number of received datagrams that can be referenced by pbufs.
+ * @note    A NTB is returned to the driver after all its datagrams have
+ *          been freed, datagrams held by the stack delay the reception of
+ *          the following NTBs. When all the references are in use the
+ *          received datagrams are copied into pool pbufs.
+ */
+#if !defined(NCMIF_ZERO_COPY_RX_PBUFS) || defined(__DOXYGEN__)
+#define NCMIF_ZERO_COPY_RX_PBUFS            8
+#endif
+
+/**
+ * @brief   Interface name, first character.
+ */
+#if !defined(NCMIF_IFNAME0) || defined(__DOXYGEN__)
+#define NCMIF_IFNAME0                       'u'
+#endif
+
+/**
+ * @brief   Interface name, second character.
+ */
+#if !defined(NCMIF_IFNAME1) || defined(__DOXYGEN__)
+#define NCMIF_IFNAME1                       's'
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  err_t ncmifInit(struct netif *netif);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NCMIF_H */
+
+/** @} */
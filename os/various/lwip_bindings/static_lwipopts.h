@@ -29,6 +29,9 @@
 #define LWIP_TIMERS                     1
 #define LWIP_TIMERS_CUSTOM              0
 
+/* One more timeout for the link status poll.*/
+#define MEMP_NUM_SYS_TIMEOUT            (LWIP_NUM_SYS_TIMEOUT_INTERNAL + 1)
+
 #define LWIP_TCPIP_CORE_LOCKING         1
 #define LWIP_TCPIP_CORE_LOCKING_INPUT   0
 #define LWIP_COMPAT_MUTEX_ALLOWED
@@ -0,0 +1,827 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ota.c
+ * @brief   Firmware update engine code.
+ *
+ * @addtogroup ota
+ * @details The update is processed by a pipeline of three stages:
+ *          - The writer thread copies the received data into the
+ *            received data buffers using @p otaWrite().
+ *          - The decoding stage parses the image header, decompresses
+ *            the received data and fills the decoded data buffers.
+ *          - The programming stage erases the image area one sector ahead,
+ *            programs the decoded data buffers, reads them back and
+ *            updates the image hash.
+ *          .
+ *          The decoding and programming stages are jobs posted on the
+ *          configured jobs queue, each stage is re-posted when data is
+ *          available for it, the stages run concurrently if the queue is
+ *          served by two or more threads.
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "ota.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Checks for match bytes still to be decoded.
+ */
+#if (OTA_USE_LZ == TRUE) || defined(__DOXYGEN__)
+#define ota_lz_pending(otap)                ((otap)->lz_length > 0U)
+#else
+#define ota_lz_pending(otap)                false
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void ota_decode_job(void *arg);
+static void ota_program_job(void *arg);
+
+/**
+ * @brief   Reads a little endian 32 bits value.
+ *
+ * @param[in] p         pointer to the value
+ * @return              The value.
+ */
+static uint32_t ota_le32(const uint8_t *p) {
+
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief   Records an error, the first one is kept.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] err       error code
+ */
+static void ota_set_error(OTADriver *otap, ota_error_t err) {
+
+  chSysLock();
+  if (otap->error == OTA_NO_ERROR) {
+    otap->error = err;
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Posts the job of a stage if it is not already running.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] runningp  pointer to the stage running flag
+ * @param[in] jobfunc   stage job function
+ */
+static void ota_kick(OTADriver *otap, bool *runningp, job_function_t jobfunc) {
+
+  chSysLock();
+  if (!*runningp) {
+    job_descriptor_t *jp;
+
+    *runningp = true;
+    jp = chJobGetTimeoutS(otap->config->jqp, TIME_INFINITE);
+    jp->jobfunc = jobfunc;
+    jp->jobarg  = (void *)otap;
+    chJobPostS(otap->config->jqp, jp);
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Parses the image header.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @return              The operation status.
+ */
+static ota_error_t ota_parse_header(OTADriver *otap) {
+  uint32_t flags;
+
+  if (ota_le32(&otap->header[0]) != OTA_IMAGE_MAGIC) {
+    return OTA_ERR_INV_HEADER;
+  }
+
+  otap->image_size = ota_le32(&otap->header[8]);
+  if (otap->image_size > otap->area_end - otap->prog_offset) {
+    return OTA_ERR_OVERFLOW;
+  }
+
+  flags = ota_le32(&otap->header[4]);
+  if ((flags & OTA_IMAGE_FLAG_LZ) == 0U) {
+    otap->dec_state = OTA_DEC_RAW;
+    return OTA_NO_ERROR;
+  }
+
+#if OTA_USE_LZ == TRUE
+  if (((flags & OTA_IMAGE_WBITS_MASK) >> OTA_IMAGE_WBITS_POS) !=
+      OTA_LZ_WINDOW_BITS) {
+    return OTA_ERR_INV_HEADER;
+  }
+  otap->dec_state = OTA_DEC_FLAGS;
+
+  return OTA_NO_ERROR;
+#else
+  return OTA_ERR_INV_HEADER;
+#endif
+}
+
+/**
+ * @brief   Makes space available for a decoded byte.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @return              The buffer availability.
+ * @retval false        if there are no free decoded data buffers.
+ * @retval true         if a decoded byte can be stored.
+ */
+static bool ota_out_acquire(OTADriver *otap) {
+
+  if (otap->out_owned) {
+    return true;
+  }
+
+  chSysLock();
+  if (otap->out_free == 0U) {
+    chSysUnlock();
+    return false;
+  }
+  otap->out_free--;
+  chSysUnlock();
+
+  otap->out_owned = true;
+  otap->out_fill  = 0U;
+
+  return true;
+}
+
+/**
+ * @brief   Hands the current decoded data buffer to the programming stage.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ */
+static void ota_out_push(OTADriver *otap) {
+
+  chSysLock();
+  otap->out_last = otap->out_fill;
+  otap->out_ready++;
+  chSysUnlock();
+
+  otap->out_head  = (otap->out_head + 1U) % otap->config->outbufn;
+  otap->out_owned = false;
+
+  ota_kick(otap, &otap->prog_running, ota_program_job);
+}
+
+/**
+ * @brief   Stores a decoded byte.
+ * @pre     Space has been made available using @p ota_out_acquire().
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] b         decoded byte
+ */
+static void ota_out_byte(OTADriver *otap, uint8_t b) {
+
+  if (otap->dec_total >= otap->image_size) {
+    ota_set_error(otap, OTA_ERR_OVERFLOW);
+    return;
+  }
+
+  otap->config->outbufs[(otap->out_head * otap->config->outbufsize) +
+                        otap->out_fill] = b;
+#if OTA_USE_LZ == TRUE
+  otap->window[otap->dec_total & (OTA_LZ_WINDOW_SIZE - 1U)] = b;
+#endif
+  otap->dec_total++;
+
+  otap->out_fill++;
+  if (otap->out_fill >= otap->config->outbufsize) {
+    ota_out_push(otap);
+  }
+}
+
+/**
+ * @brief   Decodes received data until the buffer end or a stall.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] bp        pointer to the received data buffer
+ * @param[in] n         number of valid bytes in the buffer
+ */
+static void ota_decode(OTADriver *otap, const uint8_t *bp, size_t n) {
+
+  while (otap->error == OTA_NO_ERROR) {
+    uint8_t c;
+
+#if OTA_USE_LZ == TRUE
+    /* Pending match bytes are copied from the window.*/
+    if (otap->lz_length > 0U) {
+      if (!ota_out_acquire(otap)) {
+        return;
+      }
+      otap->lz_length--;
+      ota_out_byte(otap, otap->window[(otap->dec_total - otap->lz_offset) &
+                                      (OTA_LZ_WINDOW_SIZE - 1U)]);
+      continue;
+    }
+#endif
+
+    if (otap->in_pos >= n) {
+      return;
+    }
+    c = bp[otap->in_pos];
+
+    switch (otap->dec_state) {
+    case OTA_DEC_HEADER:
+      otap->header[otap->hdr_fill++] = c;
+      otap->in_pos++;
+      if (otap->hdr_fill >= OTA_IMAGE_HEADER_SIZE) {
+        ota_error_t err = ota_parse_header(otap);
+        if (err != OTA_NO_ERROR) {
+          ota_set_error(otap, err);
+        }
+      }
+      break;
+    case OTA_DEC_RAW:
+      if (!ota_out_acquire(otap)) {
+        return;
+      }
+      otap->in_pos++;
+      ota_out_byte(otap, c);
+      break;
+#if OTA_USE_LZ == TRUE
+    case OTA_DEC_FLAGS:
+      /* Flags of the next 8 items, LSB first, one for literals.*/
+      otap->lz_flags  = c;
+      otap->lz_nflags = 8U;
+      otap->in_pos++;
+      otap->dec_state = OTA_DEC_ITEM;
+      break;
+    case OTA_DEC_ITEM:
+      if (otap->lz_nflags == 0U) {
+        otap->dec_state = OTA_DEC_FLAGS;
+        break;
+      }
+      if ((otap->lz_flags & 1U) != 0U) {
+        if (!ota_out_acquire(otap)) {
+          return;
+        }
+        otap->in_pos++;
+        otap->lz_flags >>= 1;
+        otap->lz_nflags--;
+        ota_out_byte(otap, c);
+      }
+      else {
+        otap->lz_token  = c;
+        otap->in_pos++;
+        otap->dec_state = OTA_DEC_TOKEN;
+      }
+      break;
+    case OTA_DEC_TOKEN:
+      {
+        uint32_t token = ((uint32_t)otap->lz_token << 8) | (uint32_t)c;
+
+        /* Big endian token, distance minus one in the high bits and
+           length minus the minimum match in the low bits.*/
+        otap->in_pos++;
+        otap->lz_offset = (token >> OTA_LZ_LENGTH_BITS) + 1U;
+        otap->lz_length = (token & ((1U << OTA_LZ_LENGTH_BITS) - 1U)) +
+                          OTA_LZ_MIN_MATCH;
+        otap->lz_flags >>= 1;
+        otap->lz_nflags--;
+        otap->dec_state = OTA_DEC_ITEM;
+        if (otap->lz_offset > otap->dec_total) {
+          ota_set_error(otap, OTA_ERR_CORRUPTED);
+        }
+      }
+      break;
+#endif
+    default:
+      ota_set_error(otap, OTA_ERR_INV_HEADER);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief   Decoding stage job.
+ *
+ * @param[in] arg       pointer to the @p OTADriver object
+ */
+static void ota_decode_job(void *arg) {
+  OTADriver *otap = (OTADriver *)arg;
+
+  while (true) {
+    size_t n;
+
+    /* Checking for work, the running flag is cleared atomically with the
+       check, producers post the job again after adding work.*/
+    chSysLock();
+    if ((otap->error == OTA_NO_ERROR) && !otap->out_owned &&
+        (otap->out_free == 0U) &&
+        ((otap->in_ready > 0U) || ota_lz_pending(otap))) {
+      /* Stalled waiting for a decoded data buffer.*/
+      otap->dec_running = false;
+      chSysUnlock();
+      return;
+    }
+    if (otap->in_ready == 0U) {
+      if (otap->in_eos && !otap->out_eos) {
+        chSysUnlock();
+
+        /* End of stream, the pending match and the last partial buffer
+           are handed over.*/
+        if (otap->error == OTA_NO_ERROR) {
+          ota_decode(otap, NULL, 0U);
+          if (ota_lz_pending(otap)) {
+            continue;
+          }
+          if (otap->out_owned) {
+            ota_out_push(otap);
+          }
+        }
+        chSysLock();
+        otap->out_eos     = true;
+        otap->dec_running = false;
+        chSysUnlock();
+        ota_kick(otap, &otap->prog_running, ota_program_job);
+        return;
+      }
+      otap->dec_running = false;
+      chSysUnlock();
+      return;
+    }
+    n = (otap->in_eos && (otap->in_ready == 1U)) ? otap->in_last :
+                                                   otap->config->inbufsize;
+    chSysUnlock();
+
+    if (otap->error == OTA_NO_ERROR) {
+      ota_decode(otap, otap->config->inbufs +
+                       (otap->in_tail * otap->config->inbufsize), n);
+    }
+    else {
+      /* After an error the received data is discarded.*/
+      otap->in_pos = n;
+    }
+
+    /* Releasing the received data buffer if fully consumed.*/
+    if (otap->in_pos >= n) {
+      otap->in_pos  = 0U;
+      otap->in_tail = (otap->in_tail + 1U) % otap->config->inbufn;
+      chSysLock();
+      otap->in_ready--;
+      chSemSignalI(&otap->in_sem);
+      chSchRescheduleS();
+      chSysUnlock();
+    }
+  }
+}
+
+/**
+ * @brief   Waits for the erase in progress, if any.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @return              The operation status.
+ */
+static ota_error_t ota_erase_wait(OTADriver *otap) {
+  BaseFlash *flashp = otap->config->flashp;
+
+  if (otap->erasing) {
+    otap->erasing = false;
+    if (flashWaitErase(flashp) != FLASH_NO_ERROR) {
+      return OTA_ERR_FLASH_FAILURE;
+    }
+    otap->erased_end += flashGetSectorSize(flashp, otap->config->start_sector +
+                                                   otap->erase_sector);
+    otap->erase_sector++;
+  }
+
+  return OTA_NO_ERROR;
+}
+
+/**
+ * @brief   Starts the erase of the next sector of the image area.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @return              The operation status.
+ */
+static ota_error_t ota_erase_next(OTADriver *otap) {
+
+  if (otap->erase_sector >= otap->config->sectors) {
+    return OTA_ERR_OVERFLOW;
+  }
+  if (flashStartEraseSector(otap->config->flashp,
+                            otap->config->start_sector +
+                            otap->erase_sector) != FLASH_NO_ERROR) {
+    return OTA_ERR_FLASH_FAILURE;
+  }
+  otap->erasing = true;
+
+  return OTA_NO_ERROR;
+}
+
+/**
+ * @brief   Programs a decoded data buffer.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] bp        pointer to the decoded data buffer
+ * @param[in] n         number of valid bytes in the buffer
+ * @return              The operation status.
+ */
+static ota_error_t ota_program(OTADriver *otap, uint8_t *bp, size_t n) {
+  BaseFlash *flashp = otap->config->flashp;
+  ota_error_t err;
+
+  /* Erasing up to the end of the data, the flash must be idle before
+     programming.*/
+  while (otap->erased_end < otap->prog_offset + (flash_offset_t)n) {
+    if (!otap->erasing) {
+      err = ota_erase_next(otap);
+      if (err != OTA_NO_ERROR) {
+        return err;
+      }
+    }
+    err = ota_erase_wait(otap);
+    if (err != OTA_NO_ERROR) {
+      return err;
+    }
+  }
+  err = ota_erase_wait(otap);
+  if (err != OTA_NO_ERROR) {
+    return err;
+  }
+
+  if (flashProgram(flashp, otap->prog_offset, n, bp) != FLASH_NO_ERROR) {
+    return OTA_ERR_FLASH_FAILURE;
+  }
+
+#if OTA_USE_HASH == TRUE
+  /* The hash is computed on the data read back from the flash.*/
+  if (flashRead(flashp, otap->prog_offset, n, bp) != FLASH_NO_ERROR) {
+    return OTA_ERR_FLASH_FAILURE;
+  }
+  if (crySHA256Update(otap->config->cryp, &otap->sha, n, bp) != CRY_NOERROR) {
+    return OTA_ERR_CRYPTO_FAILURE;
+  }
+#endif
+  otap->prog_offset += (flash_offset_t)n;
+
+  /* Erase-ahead, the next sector is erased while the next buffer is
+     being decoded.*/
+  if ((otap->erased_end - otap->prog_offset < otap->config->outbufsize) &&
+      (otap->erase_sector < otap->config->sectors)) {
+    return ota_erase_next(otap);
+  }
+
+  return OTA_NO_ERROR;
+}
+
+/**
+ * @brief   Programming stage job.
+ *
+ * @param[in] arg       pointer to the @p OTADriver object
+ */
+static void ota_program_job(void *arg) {
+  OTADriver *otap = (OTADriver *)arg;
+
+  while (true) {
+    size_t n;
+
+    chSysLock();
+    if (otap->out_ready == 0U) {
+      if (otap->out_eos) {
+        chSysUnlock();
+
+        /* Pipeline drained, the flash is left idle.*/
+        if (otap->erasing) {
+          otap->erasing = false;
+          (void) flashWaitErase(otap->config->flashp);
+        }
+
+        chSysLock();
+        chBSemSignalI(&otap->done);
+      }
+      otap->prog_running = false;
+      chSchRescheduleS();
+      chSysUnlock();
+      return;
+    }
+    n = (otap->out_eos && (otap->out_ready == 1U)) ? otap->out_last :
+                                                     otap->config->outbufsize;
+    chSysUnlock();
+
+    if (otap->error == OTA_NO_ERROR) {
+      ota_error_t err;
+
+      err = ota_program(otap, otap->config->outbufs +
+                              (otap->out_tail * otap->config->outbufsize), n);
+      if (err != OTA_NO_ERROR) {
+        ota_set_error(otap, err);
+      }
+    }
+
+    /* Releasing the decoded data buffer.*/
+    otap->out_tail = (otap->out_tail + 1U) % otap->config->outbufn;
+    chSysLock();
+    otap->out_ready--;
+    otap->out_free++;
+    chSysUnlock();
+
+    ota_kick(otap, &otap->dec_running, ota_decode_job);
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] otap     pointer to the @p OTADriver object
+ *
+ * @init
+ */
+void otaObjectInit(OTADriver *otap) {
+
+  osalDbgCheck(otap != NULL);
+
+  otap->state  = OTA_STOP;
+  otap->config = NULL;
+  otap->error  = OTA_NO_ERROR;
+}
+
+/**
+ * @brief   Starts an update.
+ * @details The first sector of the image area is erased immediately, the
+ *          erase proceeds while the first data is received.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] config    pointer to the configuration
+ * @return              The operation status.
+ * @retval OTA_NO_ERROR if the update has been started.
+ * @retval OTA_ERR_INV_STATE if an update is already in progress.
+ * @retval OTA_ERR_FLASH_FAILURE if the flash erase failed.
+ * @retval OTA_ERR_CRYPTO_FAILURE if the hash initialization failed.
+ *
+ * @api
+ */
+ota_error_t otaStart(OTADriver *otap, const OTAConfig *config) {
+  ota_error_t err;
+
+  osalDbgCheck((otap != NULL) && (config != NULL));
+  osalDbgCheck((config->flashp != NULL) && (config->jqp != NULL) &&
+               (config->sectors > 0U) &&
+               (config->inbufs != NULL) && (config->inbufn > 0U) &&
+               (config->inbufsize > 0U) &&
+               (config->outbufs != NULL) && (config->outbufn > 0U) &&
+               (config->outbufsize > 0U));
+  osalDbgAssert(config->outbufsize %
+                flashGetDescriptor(config->flashp)->page_size == 0U,
+                "not a multiple of the page size");
+
+  if (otap->state == OTA_ACTIVE) {
+    return OTA_ERR_INV_STATE;
+  }
+
+  otap->config = config;
+  otap->error  = OTA_NO_ERROR;
+  chSemObjectInit(&otap->in_sem, (cnt_t)config->inbufn);
+  chBSemObjectInit(&otap->done, true);
+
+  otap->in_head      = 0U;
+  otap->in_tail      = 0U;
+  otap->in_ready     = 0U;
+  otap->in_fill      = 0U;
+  otap->in_pos       = 0U;
+  otap->in_last      = 0U;
+  otap->in_owned     = false;
+  otap->in_eos       = false;
+  otap->out_head     = 0U;
+  otap->out_tail     = 0U;
+  otap->out_ready    = 0U;
+  otap->out_free     = config->outbufn;
+  otap->out_fill     = 0U;
+  otap->out_last     = 0U;
+  otap->out_owned    = false;
+  otap->out_eos      = false;
+  otap->dec_running  = false;
+  otap->prog_running = false;
+  otap->dec_state    = OTA_DEC_HEADER;
+  otap->hdr_fill     = 0U;
+  otap->image_size   = 0U;
+  otap->dec_total    = 0U;
+#if OTA_USE_LZ == TRUE
+  otap->lz_flags     = 0U;
+  otap->lz_nflags    = 0U;
+  otap->lz_offset    = 0U;
+  otap->lz_length    = 0U;
+#endif
+  otap->prog_offset  = flashGetSectorOffset(config->flashp,
+                                            config->start_sector);
+  otap->erased_end   = otap->prog_offset;
+  otap->area_end     = flashGetSectorOffset(config->flashp,
+                                            config->start_sector +
+                                            config->sectors - 1U) +
+                       flashGetSectorSize(config->flashp,
+                                          config->start_sector +
+                                          config->sectors - 1U);
+  otap->erase_sector = 0U;
+  otap->erasing      = false;
+
+#if OTA_USE_HASH == TRUE
+  if (crySHA256Init(config->cryp, &otap->sha) != CRY_NOERROR) {
+    return OTA_ERR_CRYPTO_FAILURE;
+  }
+#endif
+
+  err = ota_erase_next(otap);
+  if (err != OTA_NO_ERROR) {
+    return err;
+  }
+
+  otap->state = OTA_ACTIVE;
+
+  return OTA_NO_ERROR;
+}
+
+/**
+ * @brief   Feeds received image data.
+ * @details Data is copied in the received data buffers, the function
+ *          waits for a free buffer when all of them are queued.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @param[in] bp        pointer to the received data
+ * @param[in] n         number of bytes
+ * @return              The operation status.
+ * @retval OTA_NO_ERROR if the data has been queued.
+ * @retval OTA_ERR_INV_STATE if there is no update in progress.
+ * @retval ...          the pipeline error, the update must be terminated
+ *                      using @p otaFinish().
+ *
+ * @api
+ */
+ota_error_t otaWrite(OTADriver *otap, const uint8_t *bp, size_t n) {
+  const OTAConfig *config;
+
+  osalDbgCheck((otap != NULL) && ((bp != NULL) || (n == 0U)));
+
+  if (otap->state != OTA_ACTIVE) {
+    return OTA_ERR_INV_STATE;
+  }
+  config = otap->config;
+
+  while ((n > 0U) && (otap->error == OTA_NO_ERROR)) {
+    size_t chunk;
+
+    if (!otap->in_owned) {
+      (void) chSemWait(&otap->in_sem);
+      otap->in_owned = true;
+      otap->in_fill  = 0U;
+    }
+
+    chunk = config->inbufsize - otap->in_fill;
+    if (chunk > n) {
+      chunk = n;
+    }
+    memcpy((void *)(config->inbufs + (otap->in_head * config->inbufsize) +
+                    otap->in_fill), (const void *)bp, chunk);
+    otap->in_fill += chunk;
+    bp            += chunk;
+    n             -= chunk;
+
+    /* Full buffers are handed to the decoding stage.*/
+    if (otap->in_fill >= config->inbufsize) {
+      otap->in_head  = (otap->in_head + 1U) % config->inbufn;
+      otap->in_owned = false;
+      chSysLock();
+      otap->in_ready++;
+      chSysUnlock();
+      ota_kick(otap, &otap->dec_running, ota_decode_job);
+    }
+  }
+
+  return otap->error;
+}
+
+/**
+ * @brief   Terminates an update.
+ * @details The remaining data is processed then the image is verified
+ *          against the size and the hash in its header.
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ * @return              The operation status.
+ * @retval OTA_NO_ERROR if the image has been programmed and verified.
+ * @retval OTA_ERR_INV_STATE if there is no update in progress.
+ * @retval OTA_ERR_CORRUPTED if the image is truncated.
+ * @retval OTA_ERR_HASH if the programmed image hash does not match.
+ * @retval ...          the first error encountered by the pipeline.
+ *
+ * @api
+ */
+ota_error_t otaFinish(OTADriver *otap) {
+  ota_error_t err;
+
+  osalDbgCheck(otap != NULL);
+
+  if (otap->state != OTA_ACTIVE) {
+    return OTA_ERR_INV_STATE;
+  }
+
+  /* Handing the last partial buffer and waiting for the pipeline to be
+     drained.*/
+  chSysLock();
+  if (otap->in_owned) {
+    otap->in_owned = false;
+    otap->in_head  = (otap->in_head + 1U) % otap->config->inbufn;
+    otap->in_last  = otap->in_fill;
+    otap->in_ready++;
+  }
+  else {
+    otap->in_last  = otap->config->inbufsize;
+  }
+  otap->in_eos = true;
+  chSysUnlock();
+  ota_kick(otap, &otap->dec_running, ota_decode_job);
+  (void) chBSemWait(&otap->done);
+
+  err = otap->error;
+  if (err == OTA_NO_ERROR) {
+    if ((otap->dec_state == OTA_DEC_HEADER) ||
+        (otap->dec_total != otap->image_size)) {
+      err = OTA_ERR_CORRUPTED;
+    }
+  }
+
+#if OTA_USE_HASH == TRUE
+  if (err == OTA_NO_ERROR) {
+    uint8_t digest[32];
+
+    if (crySHA256Final(otap->config->cryp, &otap->sha,
+                       digest) != CRY_NOERROR) {
+      err = OTA_ERR_CRYPTO_FAILURE;
+    }
+    else if (memcmp((const void *)digest,
+                    (const void *)&otap->header[16],
+                    sizeof digest) != 0) {
+      err = OTA_ERR_HASH;
+    }
+  }
+#endif
+
+  otap->error = err;
+  otap->state = err == OTA_NO_ERROR ? OTA_COMPLETE : OTA_ERROR;
+
+  return err;
+}
+
+/**
+ * @brief   Stops the engine.
+ * @pre     There is no update in progress, an update is terminated using
+ *          @p otaFinish().
+ *
+ * @param[in] otap      pointer to the @p OTADriver object
+ *
+ * @api
+ */
+void otaStop(OTADriver *otap) {
+
+  osalDbgCheck(otap != NULL);
+  osalDbgAssert(otap->state != OTA_ACTIVE, "update in progress");
+
+  otap->state  = OTA_STOP;
+  otap->config = NULL;
+}
+
+/** @} */
@@ -0,0 +1,324 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ota.h
+ * @brief   Firmware update engine structures and macros.
+ *
+ * @addtogroup ota
+ * @{
+ */
+
+#ifndef OTA_H
+#define OTA_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Image header fields
+ * @{
+ */
+#define OTA_IMAGE_MAGIC                     0x3141544FU
+#define OTA_IMAGE_HEADER_SIZE               48U
+#define OTA_IMAGE_FLAG_LZ                   (1U << 0)
+#define OTA_IMAGE_WBITS_POS                 8U
+#define OTA_IMAGE_WBITS_MASK                (15U << OTA_IMAGE_WBITS_POS)
+/** @} */
+
+/**
+ * @brief   Shortest match encoded by the LZ codec.
+ */
+#define OTA_LZ_MIN_MATCH                    3U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Compressed images support.
+ */
+#if !defined(OTA_USE_LZ) || defined(__DOXYGEN__)
+#define OTA_USE_LZ                          TRUE
+#endif
+
+/**
+ * @brief   LZ window size as a power of two.
+ * @note    The window is part of the @p OTADriver object, the image must
+ *          be compressed using the same value.
+ */
+#if !defined(OTA_LZ_WINDOW_BITS) || defined(__DOXYGEN__)
+#define OTA_LZ_WINDOW_BITS                  12
+#endif
+
+/**
+ * @brief   SHA-256 verification of the programmed image.
+ * @note    The hash is computed through a @p CRYDriver on the data read
+ *          back from the flash.
+ */
+#if !defined(OTA_USE_HASH) || defined(__DOXYGEN__)
+#define OTA_USE_HASH                        TRUE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_JOBS != TRUE
+#error "the OTA engine requires CH_CFG_USE_JOBS"
+#endif
+
+#if (OTA_USE_HASH == TRUE) && (HAL_USE_CRY != TRUE)
+#error "OTA_USE_HASH requires HAL_USE_CRY"
+#endif
+
+#if (OTA_LZ_WINDOW_BITS < 8) || (OTA_LZ_WINDOW_BITS > 14)
+#error "invalid OTA_LZ_WINDOW_BITS value"
+#endif
+
+/**
+ * @brief   LZ window size.
+ */
+#define OTA_LZ_WINDOW_SIZE                  (1U << OTA_LZ_WINDOW_BITS)
+
+/**
+ * @brief   Bits of the match length in a LZ token.
+ */
+#define OTA_LZ_LENGTH_BITS                  (16U - OTA_LZ_WINDOW_BITS)
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of an OTA engine state.
+ */
+typedef enum {
+  OTA_UNINIT = 0,
+  OTA_STOP = 1,
+  OTA_ACTIVE = 2,
+  OTA_COMPLETE = 3,
+  OTA_ERROR = 4
+} ota_state_t;
+
+/**
+ * @brief   Type of an OTA engine error code.
+ */
+typedef enum {
+  OTA_NO_ERROR = 0,
+  OTA_ERR_INV_STATE = -1,
+  OTA_ERR_INV_HEADER = -2,
+  OTA_ERR_OVERFLOW = -3,
+  OTA_ERR_CORRUPTED = -4,
+  OTA_ERR_HASH = -5,
+  OTA_ERR_FLASH_FAILURE = -6,
+  OTA_ERR_CRYPTO_FAILURE = -7
+} ota_error_t;
+
+/**
+ * @brief   Type of the decoder states.
+ */
+typedef enum {
+  OTA_DEC_HEADER = 0,
+  OTA_DEC_RAW = 1,
+  OTA_DEC_FLAGS = 2,
+  OTA_DEC_ITEM = 3,
+  OTA_DEC_TOKEN = 4
+} ota_dec_state_t;
+
+/**
+ * @brief   Type of an OTA engine configuration.
+ */
+typedef struct {
+  /**
+   * @brief   Flash receiving the image.
+   * @note    Program and erase operations run from the jobs, any flash
+   *          implementing @p BaseFlash can be used.
+   */
+  BaseFlash                 *flashp;
+  /**
+   * @brief   First sector of the image area.
+   */
+  flash_sector_t            start_sector;
+  /**
+   * @brief   Number of sectors of the image area.
+   */
+  flash_sector_t            sectors;
+  /**
+   * @brief   Jobs queue running the pipeline stages.
+   * @note    Each stage has at most one job queued, the queue must have
+   *          at least two free descriptors. The decoding and programming
+   *          stages run concurrently if two or more threads dispatch
+   *          the queue.
+   */
+  jobs_queue_t              *jqp;
+  /**
+   * @brief   Received data buffers, @p inbufn buffers of @p inbufsize
+   *          bytes.
+   */
+  uint8_t                   *inbufs;
+  /**
+   * @brief   Number of received data buffers.
+   */
+  uint32_t                  inbufn;
+  /**
+   * @brief   Size of a received data buffer.
+   */
+  size_t                    inbufsize;
+  /**
+   * @brief   Decoded data buffers, @p outbufn buffers of @p outbufsize
+   *          bytes.
+   */
+  uint8_t                   *outbufs;
+  /**
+   * @brief   Number of decoded data buffers.
+   * @note    Two or more buffers allow decoding while programming.
+   */
+  uint32_t                  outbufn;
+  /**
+   * @brief   Size of a decoded data buffer.
+   * @note    It must be a multiple of the flash page size.
+   */
+  size_t                    outbufsize;
+#if (OTA_USE_HASH == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Crypto driver used for the image hash.
+   */
+  CRYDriver                 *cryp;
+#endif
+} OTAConfig;
+
+/**
+ * @brief   Structure representing an OTA engine.
+ */
+typedef struct {
+  /**
+   * @brief   Engine state.
+   */
+  ota_state_t               state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const OTAConfig           *config;
+  /**
+   * @brief   First error, it stops the pipeline.
+   */
+  ota_error_t               error;
+  /**
+   * @brief   Free received data buffers.
+   */
+  semaphore_t               in_sem;
+  /**
+   * @brief   Signaled when the pipeline has been drained.
+   */
+  binary_semaphore_t        done;
+  /**
+   * @name    Received data buffers ring
+   * @{
+   */
+  uint32_t                  in_head;
+  uint32_t                  in_tail;
+  uint32_t                  in_ready;
+  size_t                    in_fill;
+  size_t                    in_pos;
+  size_t                    in_last;
+  bool                      in_owned;
+  bool                      in_eos;
+  /** @} */
+  /**
+   * @name    Decoded data buffers ring
+   * @{
+   */
+  uint32_t                  out_head;
+  uint32_t                  out_tail;
+  uint32_t                  out_ready;
+  uint32_t                  out_free;
+  size_t                    out_fill;
+  size_t                    out_last;
+  bool                      out_owned;
+  bool                      out_eos;
+  /** @} */
+  /**
+   * @name    Stages state
+   * @{
+   */
+  bool                      dec_running;
+  bool                      prog_running;
+  /** @} */
+  /**
+   * @name    Decoder state
+   * @{
+   */
+  ota_dec_state_t           dec_state;
+  uint8_t                   header[OTA_IMAGE_HEADER_SIZE];
+  size_t                    hdr_fill;
+  uint32_t                  image_size;
+  uint32_t                  dec_total;
+#if (OTA_USE_LZ == TRUE) || defined(__DOXYGEN__)
+  uint8_t                   lz_flags;
+  uint8_t                   lz_nflags;
+  uint8_t                   lz_token;
+  uint32_t                  lz_offset;
+  uint32_t                  lz_length;
+  uint8_t                   window[OTA_LZ_WINDOW_SIZE];
+#endif
+  /** @} */
+  /**
+   * @name    Programming state
+   * @{
+   */
+  flash_offset_t            prog_offset;
+  flash_offset_t            erased_end;
+  flash_offset_t            area_end;
+  flash_sector_t            erase_sector;
+  bool                      erasing;
+  /** @} */
+#if (OTA_USE_HASH == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Hash of the programmed data.
+   */
+  SHA256Context             sha;
+#endif
+} OTADriver;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void otaObjectInit(OTADriver *otap);
+  ota_error_t otaStart(OTADriver *otap, const OTAConfig *config);
+  ota_error_t otaWrite(OTADriver *otap, const uint8_t *bp, size_t n);
+  ota_error_t otaFinish(OTADriver *otap);
+  void otaStop(OTADriver *otap);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* OTA_H */
+
+/** @} */
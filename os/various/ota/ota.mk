@@ -0,0 +1,8 @@
+# Firmware update engine files.
+OTASRC = $(CHIBIOS)/os/various/ota/ota.c
+
+OTAINC = $(CHIBIOS)/os/various/ota
+
+# Shared variables
+ALLCSRC += $(OTASRC)
+ALLINC  += $(OTAINC)
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+#
+#    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+"""Packer of firmware images for the ChibiOS OTA engine.
+
+The image is prefixed by a header containing its size and SHA-256 hash
+and, optionally, compressed with the engine LZ codec.
+
+Usage: otapack.py [-z] [-w <window bits>] <input> <output>
+       otapack.py -u <image> <output>
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = 0x3141544F
+FLAG_LZ = 1 << 0
+MIN_MATCH = 3
+HASH_DEPTH = 64
+
+
+def compress(data, wbits):
+    """Compresses data, groups of 8 items are preceded by a flags byte,
+    LSB first, a set flag is a literal byte, a cleared flag is a big
+    endian token with the distance minus one in the high bits and the
+    length minus MIN_MATCH in the low bits."""
+    lbits = 16 - wbits
+    window = 1 << wbits
+    max_match = (1 << lbits) - 1 + MIN_MATCH
+    out = bytearray()
+    items = []
+    chains = {}
+    i = 0
+
+    def flush():
+        flags = 0
+        for n, (literal, _) in enumerate(items):
+            if literal:
+                flags |= 1 << n
+        out.append(flags)
+        for _, item in items:
+            out.extend(item)
+        items.clear()
+
+    def insert(pos):
+        if pos + MIN_MATCH <= len(data):
+            chains.setdefault(data[pos:pos + MIN_MATCH], []).append(pos)
+
+    while i < len(data):
+        best_len, best_dist = 0, 0
+        for pos in reversed(chains.get(data[i:i + MIN_MATCH], [])[-HASH_DEPTH:]):
+            dist = i - pos
+            if dist > window:
+                break
+            n = 0
+            while (n < max_match and i + n < len(data) and
+                   data[pos + n] == data[i + n]):
+                n += 1
+            if n > best_len:
+                best_len, best_dist = n, dist
+                if n == max_match:
+                    break
+        if best_len >= MIN_MATCH:
+            token = ((best_dist - 1) << lbits) | (best_len - MIN_MATCH)
+            items.append((False, struct.pack(">H", token)))
+            for pos in range(i, i + best_len):
+                insert(pos)
+            i += best_len
+        else:
+            items.append((True, data[i:i + 1]))
+            insert(i)
+            i += 1
+        if len(items) == 8:
+            flush()
+    if items:
+        flush()
+    return bytes(out)
+
+
+def decompress(data, size, wbits):
+    """Reference decoder."""
+    lbits = 16 - wbits
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        flags = data[i]
+        i += 1
+        for _ in range(8):
+            if len(out) >= size:
+                break
+            if flags & 1:
+                out.append(data[i])
+                i += 1
+            else:
+                token = (data[i] << 8) | data[i + 1]
+                i += 2
+                dist = (token >> lbits) + 1
+                for _ in range((token & ((1 << lbits) - 1)) + MIN_MATCH):
+                    out.append(out[-dist])
+            flags >>= 1
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-z", "--compress", action="store_true",
+                        help="compress the image")
+    parser.add_argument("-w", "--wbits", type=int, default=12,
+                        help="LZ window bits, OTA_LZ_WINDOW_BITS (default 12)")
+    parser.add_argument("-u", "--unpack", action="store_true",
+                        help="verify and unpack an image")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    if args.unpack:
+        magic, flags, size, _ = struct.unpack_from("<IIII", data)
+        if magic != MAGIC:
+            sys.exit("invalid image")
+        payload = data[48:]
+        if flags & FLAG_LZ:
+            payload = decompress(payload, size, (flags >> 8) & 15)
+        if len(payload) != size or hashlib.sha256(payload).digest() != data[16:48]:
+            sys.exit("corrupted image")
+        with open(args.output, "wb") as f:
+            f.write(payload)
+        return
+
+    if not 8 <= args.wbits <= 14:
+        parser.error("window bits must be in range 8..14")
+    flags = 0
+    payload = data
+    if args.compress:
+        flags = FLAG_LZ | (args.wbits << 8)
+        payload = compress(data, args.wbits)
+    header = struct.pack("<IIII", MAGIC, flags, len(data), 0)
+    header += hashlib.sha256(data).digest()
+    with open(args.output, "wb") as f:
+        f.write(header + payload)
+    print("%s: %d -> %d bytes" % (args.output, len(data), len(payload)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,289 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    perfmon.c
+ * @brief   Performance counters monitor code.
+ *
+ * @addtogroup perf_monitor
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "perfmon.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   DWT event counters enable mask.
+ */
+#define PMON_DWT_EVENTS     (DWT_CTRL_CPIEVTENA_Msk  |                      \
+                             DWT_CTRL_EXCEVTENA_Msk  |                      \
+                             DWT_CTRL_SLEEPEVTENA_Msk |                     \
+                             DWT_CTRL_LSUEVTENA_Msk  |                      \
+                             DWT_CTRL_FOLDEVTENA_Msk)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Performance monitor data.
+ */
+perf_monitor_t perfmon;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the increment of an 8 bits counter.
+ *
+ * @param[in] cnt       current counter value
+ * @param[in,out] lastp pointer to the last counter value
+ * @return              The counter increment since the last value.
+ */
+static uint32_t pmon_delta8(uint32_t cnt, uint8_t *lastp) {
+  uint8_t delta = (uint8_t)((uint8_t)cnt - *lastp);
+
+  *lastp = (uint8_t)cnt;
+
+  return (uint32_t)delta;
+}
+
+/**
+ * @brief   Takes the current counters as reference for the next increments.
+ */
+static void pmon_rebase(void) {
+
+  perfmon.cyccnt   = DWT->CYCCNT;
+  perfmon.cpicnt   = (uint8_t)DWT->CPICNT;
+  perfmon.exccnt   = (uint8_t)DWT->EXCCNT;
+  perfmon.sleepcnt = (uint8_t)DWT->SLEEPCNT;
+  perfmon.lsucnt   = (uint8_t)DWT->LSUCNT;
+  perfmon.foldcnt  = (uint8_t)DWT->FOLDCNT;
+#if PMON_USE_ICACHE_MONITORS == TRUE
+  ICACHE->CR |= ICACHE_CR_HITMRST | ICACHE_CR_MISSMRST;
+  ICACHE->CR &= ~(ICACHE_CR_HITMRST | ICACHE_CR_MISSMRST);
+#endif
+}
+
+/**
+ * @brief   Adds the counters increments to a set of counters.
+ *
+ * @param[in,out] pcp   pointer to the @p pmon_counters_t object
+ */
+static void pmon_accumulate(pmon_counters_t *pcp) {
+  uint32_t cyccnt = DWT->CYCCNT;
+
+  pcp->samples++;
+  pcp->cycles   += (uint64_t)(cyccnt - perfmon.cyccnt);
+  perfmon.cyccnt = cyccnt;
+  pcp->cpi      += pmon_delta8(DWT->CPICNT, &perfmon.cpicnt);
+  pcp->exc      += pmon_delta8(DWT->EXCCNT, &perfmon.exccnt);
+  pcp->sleep    += pmon_delta8(DWT->SLEEPCNT, &perfmon.sleepcnt);
+  pcp->lsu      += pmon_delta8(DWT->LSUCNT, &perfmon.lsucnt);
+  pcp->fold     += pmon_delta8(DWT->FOLDCNT, &perfmon.foldcnt);
+#if PMON_USE_ICACHE_MONITORS == TRUE
+  /* The monitors saturate, they are read and restarted, the events
+     occurring in between are lost.*/
+  pcp->ichits   += ICACHE->HMONR;
+  pcp->icmisses += ICACHE->MMONR & ICACHE_MMONR_MISSMON_Msk;
+  ICACHE->CR |= ICACHE_CR_HITMRST | ICACHE_CR_MISSMRST;
+  ICACHE->CR &= ~(ICACHE_CR_HITMRST | ICACHE_CR_MISSMRST);
+#endif
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Performance monitor initialization.
+ * @details The DWT event counters and the ICACHE monitors are enabled, the
+ *          DWT cycle counter is enabled by the port.
+ *
+ * @init
+ */
+void pmonInit(void) {
+
+  memset((void *)&perfmon, 0, sizeof (perf_monitor_t));
+
+  DWT->CTRL |= PMON_DWT_EVENTS;
+#if PMON_USE_ICACHE_MONITORS == TRUE
+  ICACHE->CR |= ICACHE_CR_HITMEN | ICACHE_CR_MISSMEN;
+#endif
+  pmon_rebase();
+}
+
+/**
+ * @brief   Attaches a performance record to the current thread.
+ * @details The counters are accumulated into the record while the thread
+ *          is running, the record is added to the monitor list.
+ *
+ * @param[out] ptp      pointer to the @p pmon_thread_t object
+ *
+ * @api
+ */
+void pmonAttach(pmon_thread_t *ptp) {
+  thread_t *tp = chThdGetSelfX();
+
+  chDbgCheck(ptp != NULL);
+  chDbgAssert(tp->perf == NULL, "record attached");
+
+  memset((void *)&ptp->counters, 0, sizeof (pmon_counters_t));
+  ptp->tp = tp;
+
+  chSysLock();
+  /* Execution so far is accounted to the previous record.*/
+  pmon_accumulate(&perfmon.others);
+  ptp->next       = perfmon.threads;
+  perfmon.threads = ptp;
+  tp->perf        = ptp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Detaches the performance record of the current thread.
+ * @details The record is removed from the monitor list, this function
+ *          must be called before the thread terminates.
+ *
+ * @api
+ */
+void pmonDetach(void) {
+  thread_t *tp = chThdGetSelfX();
+  pmon_thread_t **pp;
+
+  chDbgAssert(tp->perf != NULL, "no record attached");
+
+  chSysLock();
+  pmon_accumulate(&tp->perf->counters);
+  for (pp = &perfmon.threads; *pp != NULL; pp = &(*pp)->next) {
+    if (*pp == tp->perf) {
+      *pp = tp->perf->next;
+      break;
+    }
+  }
+  tp->perf = NULL;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Accounts the counters to a thread being switched out.
+ * @note    This function is meant to be invoked from
+ *          @p CH_CFG_CONTEXT_SWITCH_HOOK.
+ *
+ * @param[in] otp       the thread being switched out
+ *
+ * @iclass
+ */
+void pmonSwitchI(thread_t *otp) {
+
+  pmon_accumulate(otp->perf != NULL ? &otp->perf->counters : &perfmon.others);
+}
+
+/**
+ * @brief   Accounts the counters to the current thread.
+ * @details The DWT stall counters are 8 bits wide, threads running for
+ *          long periods without context switches must be sampled often
+ *          enough to not lose counter wraps.
+ * @note    This function can be called from a periodic timer ISR or from
+ *          @p CH_CFG_SYSTEM_TICK_HOOK.
+ *
+ * @iclass
+ */
+void pmonSampleI(void) {
+
+  chDbgCheckClassI();
+
+  pmonSwitchI(chThdGetSelfX());
+}
+
+/**
+ * @brief   Returns the counters of a performance record.
+ *
+ * @param[in] ptp       pointer to the @p pmon_thread_t object
+ * @param[out] pcp      pointer to the @p pmon_counters_t object
+ *
+ * @api
+ */
+void pmonGetCounters(pmon_thread_t *ptp, pmon_counters_t *pcp) {
+
+  chDbgCheck((ptp != NULL) && (pcp != NULL));
+
+  chSysLock();
+  *pcp = ptp->counters;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the counters of the threads without a record.
+ *
+ * @param[out] pcp      pointer to the @p pmon_counters_t object
+ *
+ * @api
+ */
+void pmonGetOthers(pmon_counters_t *pcp) {
+
+  chDbgCheck(pcp != NULL);
+
+  chSysLock();
+  *pcp = perfmon.others;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Clears all the accumulated counters.
+ *
+ * @iclass
+ */
+void pmonResetI(void) {
+  pmon_thread_t *ptp;
+
+  chDbgCheckClassI();
+
+  for (ptp = perfmon.threads; ptp != NULL; ptp = ptp->next) {
+    memset((void *)&ptp->counters, 0, sizeof (pmon_counters_t));
+  }
+  memset((void *)&perfmon.others, 0, sizeof (pmon_counters_t));
+  pmon_rebase();
+}
+
+/**
+ * @brief   Clears all the accumulated counters.
+ *
+ * @api
+ */
+void pmonReset(void) {
+
+  chSysLock();
+  pmonResetI();
+  chSysUnlock();
+}
+
+/** @} */
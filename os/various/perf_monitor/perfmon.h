@@ -0,0 +1,217 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    perfmon.h
+ * @brief   Performance counters monitor structures and macros.
+ * @details The monitor requires a @p perf field in the thread structure
+ *          and the context switch hook, see @p CH_CFG_THREAD_EXTRA_FIELDS
+ *          and @p CH_CFG_CONTEXT_SWITCH_HOOK:
+ * @code
+ *  #define CH_CFG_THREAD_EXTRA_FIELDS                                      \
+ *    struct pmon_thread *perf;
+ *
+ *  #define CH_CFG_THREAD_INIT_HOOK(tp) {                                   \
+ *    (tp)->perf = NULL;                                                    \
+ *  }
+ *
+ *  #define CH_CFG_CONTEXT_SWITCH_HOOK(ntp, otp) {                          \
+ *    extern void pmonSwitchI(thread_t *otp);                               \
+ *    pmonSwitchI(otp);                                                     \
+ *  }
+ * @endcode
+ *
+ * @addtogroup perf_monitor
+ * @{
+ */
+
+#ifndef PERFMON_H
+#define PERFMON_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Enables the STM32 ICACHE hit and miss monitors.
+ * @details The default is enabled on devices with the ICACHE monitors.
+ */
+#if !defined(PMON_USE_ICACHE_MONITORS) || defined(__DOXYGEN__)
+#if defined(ICACHE_CR_HITMEN) || defined(__DOXYGEN__)
+#define PMON_USE_ICACHE_MONITORS            TRUE
+#else
+#define PMON_USE_ICACHE_MONITORS            FALSE
+#endif
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !defined(DWT_CTRL_CPIEVTENA_Msk)
+#error "DWT profiling counters not available on this core"
+#endif
+
+#if (PMON_USE_ICACHE_MONITORS == TRUE) && !defined(ICACHE_CR_HITMEN)
+#error "ICACHE monitors not available on this device"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a set of accumulated counters.
+ * @note    The stall counters are accumulated from the 8 bits DWT
+ *          counters, see the module notes about their wrapping.
+ */
+typedef struct {
+  /**
+   * @brief   Number of times the counters were accumulated.
+   */
+  uint32_t              samples;
+  /**
+   * @brief   Clock cycles.
+   */
+  uint64_t              cycles;
+  /**
+   * @brief   Additional cycles of multi-cycle instructions and
+   *          instruction fetch stalls.
+   */
+  uint32_t              cpi;
+  /**
+   * @brief   Cycles spent in exceptions entry and exit.
+   */
+  uint32_t              exc;
+  /**
+   * @brief   Cycles spent sleeping.
+   */
+  uint32_t              sleep;
+  /**
+   * @brief   Additional cycles of load and store instructions.
+   */
+  uint32_t              lsu;
+  /**
+   * @brief   Folded instructions.
+   */
+  uint32_t              fold;
+#if (PMON_USE_ICACHE_MONITORS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   ICACHE hits.
+   */
+  uint32_t              ichits;
+  /**
+   * @brief   ICACHE misses.
+   */
+  uint32_t              icmisses;
+#endif
+} pmon_counters_t;
+
+/**
+ * @brief   Type of a thread performance record.
+ */
+typedef struct pmon_thread {
+  /**
+   * @brief   Next record in the monitor list.
+   */
+  struct pmon_thread    *next;
+  /**
+   * @brief   Thread owning the record.
+   */
+  thread_t              *tp;
+  /**
+   * @brief   Counters accumulated while the thread was running.
+   */
+  pmon_counters_t       counters;
+} pmon_thread_t;
+
+/**
+ * @brief   Type of a performance monitor object.
+ */
+typedef struct {
+  /**
+   * @brief   List of the attached records.
+   */
+  pmon_thread_t         *threads;
+  /**
+   * @brief   Counters of the threads without a record.
+   */
+  pmon_counters_t       others;
+  /**
+   * @brief   Last cycle counter value.
+   */
+  uint32_t              cyccnt;
+  /**
+   * @brief   Last CPI counter value.
+   */
+  uint8_t               cpicnt;
+  /**
+   * @brief   Last exception overhead counter value.
+   */
+  uint8_t               exccnt;
+  /**
+   * @brief   Last sleep counter value.
+   */
+  uint8_t               sleepcnt;
+  /**
+   * @brief   Last LSU counter value.
+   */
+  uint8_t               lsucnt;
+  /**
+   * @brief   Last folded instructions counter value.
+   */
+  uint8_t               foldcnt;
+} perf_monitor_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern perf_monitor_t perfmon;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void pmonInit(void);
+  void pmonAttach(pmon_thread_t *ptp);
+  void pmonDetach(void);
+  void pmonSwitchI(thread_t *otp);
+  void pmonSampleI(void);
+  void pmonGetCounters(pmon_thread_t *ptp, pmon_counters_t *pcp);
+  void pmonGetOthers(pmon_counters_t *pcp);
+  void pmonResetI(void);
+  void pmonReset(void);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* PERFMON_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Performance monitor files.
+PMONSRC = $(CHIBIOS)/os/various/perf_monitor/perfmon.c
+
+PMONINC = $(CHIBIOS)/os/various/perf_monitor
+
+# Shared variables
+ALLCSRC += $(PMONSRC)
+ALLINC  += $(PMONINC)
@@ -0,0 +1,427 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    poolalloc.c
+ * @brief   Size classes allocator code.
+ *
+ * @addtogroup pool_alloc
+ * @details Blocks up to @p POOLALLOC_MAX_CLASS_SIZE bytes are served by a
+ *          memory pool for each size class:
+ *          - The pools grow one page at time from a reserved area, the
+ *            class of a block is found from its page on release so the
+ *            blocks have no header.
+ *          - Threads with a cache use a memory pool magazine for each
+ *            class, most operations do not enter a critical zone.
+ *          - Larger blocks, and small blocks when the area is exhausted,
+ *            are allocated from the default heap.
+ *          .
+ * @{
+ */
+
+#include <string.h>
+
+#include "poolalloc.h"
+
+#if POOLALLOC_USE_NEWLIB == TRUE
+#include <errno.h>
+#include <reent.h>
+#endif
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of pages in the area.
+ */
+#define POOLALLOC_NUM_PAGES                                                 \
+  ((size_t)POOLALLOC_ARENA_SIZE / (size_t)POOLALLOC_PAGE_SIZE)
+
+/**
+ * @brief   Checks if a block belongs to the area.
+ */
+#define palloc_in_arena(p)                                                  \
+  (((const uint8_t *)(p) >= arena) &&                                       \
+   ((const uint8_t *)(p) < &arena[POOLALLOC_ARENA_SIZE]))
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static void *palloc_provider(size_t size, unsigned align);
+
+/**
+ * @brief   Size of each class.
+ */
+static const size_t class_sizes[POOLALLOC_NUM_CLASSES] = {
+  16U, 32U, 48U, 64U, 96U, 128U, 192U, 256U
+};
+
+/**
+ * @brief   Class of each size, in 16 bytes steps.
+ */
+static const uint8_t size_classes[(POOLALLOC_MAX_CLASS_SIZE / 16U) + 1U] = {
+  0U, 0U, 1U, 2U, 3U, 4U, 4U, 5U, 5U, 6U, 6U, 6U, 6U, 7U, 7U, 7U, 7U
+};
+
+/**
+ * @brief   Pools of the size classes.
+ * @note    Statically initialized, allocations are possible before the
+ *          system initialization.
+ */
+static memory_pool_t pools[POOLALLOC_NUM_CLASSES] = {
+  __MEMORYPOOL_DATA(pools[0], 16U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[1], 32U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[2], 48U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[3], 64U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[4], 96U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[5], 128U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[6], 192U, POOLALLOC_ALIGN, palloc_provider),
+  __MEMORYPOOL_DATA(pools[7], 256U, POOLALLOC_ALIGN, palloc_provider)
+};
+
+/**
+ * @brief   Area reserved to the size classes.
+ */
+static uint8_t arena[POOLALLOC_ARENA_SIZE]
+  __attribute__((aligned(POOLALLOC_ALIGN)));
+
+/**
+ * @brief   Class of each page plus one, zero for unused pages.
+ */
+static uint8_t page_classes[POOLALLOC_NUM_PAGES];
+
+/**
+ * @brief   Number of pages in use.
+ */
+static size_t pages_used;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Pools provider, a page is assigned to the class.
+ * @details Called by @p chPoolAllocI() when a pool is empty, the first
+ *          object of the page is returned and the others are added to the
+ *          pool.
+ */
+static void *palloc_provider(size_t size, unsigned align) {
+  unsigned cls;
+  uint8_t *page, *objp;
+  size_t i, n;
+
+  (void)align;
+
+  if (pages_used >= POOLALLOC_NUM_PAGES) {
+    return NULL;
+  }
+
+  cls = (unsigned)size_classes[(size + 15U) / 16U];
+  page = &arena[pages_used * (size_t)POOLALLOC_PAGE_SIZE];
+  page_classes[pages_used] = (uint8_t)(cls + 1U);
+  pages_used++;
+
+  n = (size_t)POOLALLOC_PAGE_SIZE / size;
+  objp = page + size;
+  for (i = 1U; i < n; i++) {
+    chPoolFreeI(&pools[cls], (void *)objp);
+    objp += size;
+  }
+
+  return (void *)page;
+}
+
+/**
+ * @brief   Returns the class of a block in the area.
+ */
+static unsigned palloc_block_class(const void *p) {
+  size_t page = (size_t)((const uint8_t *)p - arena) /
+                (size_t)POOLALLOC_PAGE_SIZE;
+
+  chDbgAssert(page_classes[page] != 0U, "not an allocated block");
+
+  return (unsigned)page_classes[page] - 1U;
+}
+
+#if (POOLALLOC_USE_THREAD_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the cache of the current thread or @p NULL.
+ * @note    There is no current thread before the system initialization.
+ */
+static palloc_cache_t *palloc_get_cache(void) {
+  thread_t *tp = chThdGetSelfX();
+
+  return tp != NULL ? tp->palloc_cache : NULL;
+}
+#endif
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Allocates a block.
+ *
+ * @param[in] size      size of the block
+ * @return              A pointer to the block aligned to
+ *                      @p POOLALLOC_ALIGN bytes if it is served by a size
+ *                      class, to @p CH_HEAP_ALIGNMENT bytes otherwise.
+ * @retval NULL         if the memory is exhausted.
+ *
+ * @api
+ */
+void *pallocAlloc(size_t size) {
+
+  if (size <= POOLALLOC_MAX_CLASS_SIZE) {
+    unsigned cls = (unsigned)size_classes[(size + 15U) / 16U];
+    void *p;
+
+#if POOLALLOC_USE_THREAD_CACHE == TRUE
+    palloc_cache_t *cp = palloc_get_cache();
+
+    if (cp != NULL) {
+      p = chPoolMagazineAlloc(&cp->mags[cls]);
+    }
+    else {
+      p = chPoolAlloc(&pools[cls]);
+    }
+#else
+    p = chPoolAlloc(&pools[cls]);
+#endif
+    if (p != NULL) {
+      return p;
+    }
+
+    /* Area exhausted.*/
+    if (size == 0U) {
+      size = 1U;
+    }
+  }
+
+  return chHeapAlloc(NULL, size);
+}
+
+/**
+ * @brief   Releases a block.
+ *
+ * @param[in] p         pointer to the block or @p NULL
+ *
+ * @api
+ */
+void pallocFree(void *p) {
+
+  if (p == NULL) {
+    return;
+  }
+
+  if (palloc_in_arena(p)) {
+    unsigned cls = palloc_block_class(p);
+
+#if POOLALLOC_USE_THREAD_CACHE == TRUE
+    palloc_cache_t *cp = palloc_get_cache();
+
+    if (cp != NULL) {
+      chPoolMagazineFree(&cp->mags[cls], p);
+      return;
+    }
+#endif
+    chPoolFree(&pools[cls], p);
+    return;
+  }
+
+  chHeapFree(p);
+}
+
+/**
+ * @brief   Resizes a block.
+ * @details The block is kept if the new size fits in it, otherwise the
+ *          content is moved to a new block.
+ *
+ * @param[in] p         pointer to the block or @p NULL
+ * @param[in] size      new size of the block, zero releases it
+ * @return              A pointer to the resized block.
+ * @retval NULL         if the memory is exhausted or @p size is zero, in
+ *                      the first case the original block is unchanged.
+ *
+ * @api
+ */
+void *pallocRealloc(void *p, size_t size) {
+  size_t oldsize;
+  void *np;
+
+  if (p == NULL) {
+    return pallocAlloc(size);
+  }
+
+  if (size == 0U) {
+    pallocFree(p);
+    return NULL;
+  }
+
+  oldsize = pallocGetSize(p);
+  if (size <= oldsize) {
+    return p;
+  }
+
+  np = pallocAlloc(size);
+  if (np != NULL) {
+    memcpy(np, p, oldsize);
+    pallocFree(p);
+  }
+
+  return np;
+}
+
+/**
+ * @brief   Returns the usable size of a block.
+ *
+ * @param[in] p         pointer to the block
+ * @return              The block size.
+ *
+ * @xclass
+ */
+size_t pallocGetSize(const void *p) {
+
+  chDbgCheck(p != NULL);
+
+  if (palloc_in_arena(p)) {
+    return class_sizes[palloc_block_class(p)];
+  }
+
+  return chHeapGetSize(p);
+}
+
+#if (POOLALLOC_USE_THREAD_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Attaches a cache to the current thread.
+ *
+ * @param[out] cp       pointer to the @p palloc_cache_t object
+ *
+ * @api
+ */
+void pallocCacheAttach(palloc_cache_t *cp) {
+  unsigned i;
+
+  chDbgCheck(cp != NULL);
+  chDbgAssert(chThdGetSelfX()->palloc_cache == NULL, "cache attached");
+
+  for (i = 0U; i < POOLALLOC_NUM_CLASSES; i++) {
+    chPoolMagazineObjectInit(&cp->mags[i], &pools[i],
+                             (size_t)POOLALLOC_CACHE_SIZE);
+  }
+  chThdGetSelfX()->palloc_cache = cp;
+}
+
+/**
+ * @brief   Detaches the cache of the current thread.
+ * @details The cached blocks are returned to the size classes, this
+ *          function must be called before the thread terminates.
+ *
+ * @api
+ */
+void pallocCacheDetach(void) {
+  palloc_cache_t *cp = chThdGetSelfX()->palloc_cache;
+  unsigned i;
+
+  chDbgAssert(cp != NULL, "no cache attached");
+
+  chThdGetSelfX()->palloc_cache = NULL;
+  for (i = 0U; i < POOLALLOC_NUM_CLASSES; i++) {
+    chPoolMagazineFlush(&cp->mags[i]);
+  }
+}
+#endif
+
+#if (POOLALLOC_USE_NEWLIB == TRUE) || defined(__DOXYGEN__)
+/*
+ * Newlib allocator replacement, the library allocator is not linked when
+ * all these functions are provided.
+ */
+__attribute__((used))
+void *_malloc_r(struct _reent *r, size_t size) {
+  void *p = pallocAlloc(size);
+
+  if (p == NULL) {
+    __errno_r(r) = ENOMEM;
+  }
+  return p;
+}
+
+__attribute__((used))
+void _free_r(struct _reent *r, void *p) {
+
+  (void)r;
+  pallocFree(p);
+}
+
+__attribute__((used))
+void *_calloc_r(struct _reent *r, size_t n, size_t size) {
+  void *p;
+
+  if ((size != 0U) && (n > (size_t)-1 / size)) {
+    __errno_r(r) = ENOMEM;
+    return NULL;
+  }
+
+  p = _malloc_r(r, n * size);
+  if (p != NULL) {
+    memset(p, 0, n * size);
+  }
+  return p;
+}
+
+__attribute__((used))
+void *_realloc_r(struct _reent *r, void *p, size_t size) {
+  void *np = pallocRealloc(p, size);
+
+  if ((np == NULL) && (size != 0U)) {
+    __errno_r(r) = ENOMEM;
+  }
+  return np;
+}
+
+void *malloc(size_t size) {
+
+  return _malloc_r(_REENT, size);
+}
+
+void free(void *p) {
+
+  pallocFree(p);
+}
+
+void *calloc(size_t n, size_t size) {
+
+  return _calloc_r(_REENT, n, size);
+}
+
+void *realloc(void *p, size_t size) {
+
+  return _realloc_r(_REENT, p, size);
+}
+#endif
+
+/** @} */
@@ -0,0 +1,179 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    poolalloc.h
+ * @brief   Size classes allocator structures and macros.
+ *
+ * @addtogroup pool_alloc
+ * @{
+ */
+
+#ifndef POOLALLOC_H
+#define POOLALLOC_H
+
+#include "ch.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of size classes.
+ */
+#define POOLALLOC_NUM_CLASSES               8U
+
+/**
+ * @brief   Largest size served by the size classes.
+ */
+#define POOLALLOC_MAX_CLASS_SIZE            256U
+
+/**
+ * @brief   Alignment of the allocated blocks.
+ */
+#define POOLALLOC_ALIGN                     8U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the area reserved to the size classes.
+ * @note    When the area is exhausted small blocks are allocated from the
+ *          heap too.
+ */
+#if !defined(POOLALLOC_ARENA_SIZE) || defined(__DOXYGEN__)
+#define POOLALLOC_ARENA_SIZE                16384
+#endif
+
+/**
+ * @brief   Size of the pages assigned to the size classes.
+ * @note    Must be a power of two multiple of @p POOLALLOC_MAX_CLASS_SIZE.
+ */
+#if !defined(POOLALLOC_PAGE_SIZE) || defined(__DOXYGEN__)
+#define POOLALLOC_PAGE_SIZE                 1024
+#endif
+
+/**
+ * @brief   Replaces the newlib allocator.
+ * @details When enabled @p malloc(), @p free(), @p calloc(), @p realloc()
+ *          and their reentrant variants are provided by this module.
+ */
+#if !defined(POOLALLOC_USE_NEWLIB) || defined(__DOXYGEN__)
+#define POOLALLOC_USE_NEWLIB                TRUE
+#endif
+
+/**
+ * @brief   Enables the per-thread caches.
+ * @details Threads with a cache allocate and release the small blocks
+ *          through memory pool magazines, the size class locks are taken
+ *          once per batch of blocks.
+ * @note    Requires a @p palloc_cache field in the thread structure, see
+ *          @p CH_CFG_THREAD_EXTRA_FIELDS:
+ * @code
+ *  #define CH_CFG_THREAD_EXTRA_FIELDS                                      \
+ *    struct palloc_cache *palloc_cache;
+ *
+ *  #define CH_CFG_THREAD_INIT_HOOK(tp) {                                   \
+ *    (tp)->palloc_cache = NULL;                                            \
+ *  }
+ * @endcode
+ */
+#if !defined(POOLALLOC_USE_THREAD_CACHE) || defined(__DOXYGEN__)
+#define POOLALLOC_USE_THREAD_CACHE          FALSE
+#endif
+
+/**
+ * @brief   Number of blocks cached for each size class.
+ */
+#if !defined(POOLALLOC_CACHE_SIZE) || defined(__DOXYGEN__)
+#define POOLALLOC_CACHE_SIZE                8
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_MEMPOOLS != TRUE
+#error "pool allocator requires CH_CFG_USE_MEMPOOLS"
+#endif
+
+#if CH_CFG_USE_HEAP != TRUE
+#error "pool allocator requires CH_CFG_USE_HEAP"
+#endif
+
+#if (POOLALLOC_PAGE_SIZE < POOLALLOC_MAX_CLASS_SIZE) ||                     \
+    ((POOLALLOC_PAGE_SIZE & (POOLALLOC_PAGE_SIZE - 1)) != 0)
+#error "invalid POOLALLOC_PAGE_SIZE value"
+#endif
+
+#if (POOLALLOC_ARENA_SIZE < POOLALLOC_PAGE_SIZE) ||                         \
+    ((POOLALLOC_ARENA_SIZE % POOLALLOC_PAGE_SIZE) != 0)
+#error "POOLALLOC_ARENA_SIZE must be a multiple of POOLALLOC_PAGE_SIZE"
+#endif
+
+#if (POOLALLOC_ARENA_SIZE / POOLALLOC_PAGE_SIZE) > 255
+#error "too many pages in POOLALLOC_ARENA_SIZE"
+#endif
+
+#if POOLALLOC_CACHE_SIZE < 1
+#error "invalid POOLALLOC_CACHE_SIZE value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a per-thread cache.
+ */
+typedef struct palloc_cache {
+  /**
+   * @brief   A magazine for each size class.
+   */
+  pool_magazine_t           mags[POOLALLOC_NUM_CLASSES];
+} palloc_cache_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void *pallocAlloc(size_t size);
+  void pallocFree(void *p);
+  void *pallocRealloc(void *p, size_t size);
+  size_t pallocGetSize(const void *p);
+#if POOLALLOC_USE_THREAD_CACHE == TRUE
+  void pallocCacheAttach(palloc_cache_t *cp);
+  void pallocCacheDetach(void);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* POOLALLOC_H */
+
+/** @} */
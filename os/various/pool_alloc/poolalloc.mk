@@ -0,0 +1,11 @@
+# Size classes allocator files.
+POOLALLOCSRC = $(CHIBIOS)/os/various/pool_alloc/poolalloc.c
+
+POOLALLOCCPPSRC = $(CHIBIOS)/os/various/pool_alloc/poolalloc_cpp.cpp
+
+POOLALLOCINC = $(CHIBIOS)/os/various/pool_alloc
+
+# Shared variables
+ALLCSRC   += $(POOLALLOCSRC)
+ALLCPPSRC += $(POOLALLOCCPPSRC)
+ALLINC    += $(POOLALLOCINC)
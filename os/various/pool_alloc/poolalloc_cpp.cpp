@@ -0,0 +1,75 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    poolalloc_cpp.cpp
+ * @brief   C++ allocation operators on the size classes allocator.
+ *
+ * @addtogroup pool_alloc
+ * @{
+ */
+
+#include <new>
+
+#include "poolalloc.h"
+
+void *operator new(size_t size) {
+  void *p = pallocAlloc(size);
+
+  if (p == NULL) {
+    chSysHalt("out of memory");
+  }
+  return p;
+}
+
+void *operator new[](size_t size) {
+
+  return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+
+  return pallocAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+
+  return pallocAlloc(size);
+}
+
+void operator delete(void *p) noexcept {
+
+  pallocFree(p);
+}
+
+void operator delete[](void *p) noexcept {
+
+  pallocFree(p);
+}
+
+void operator delete(void *p, size_t size) noexcept {
+
+  (void)size;
+  pallocFree(p);
+}
+
+void operator delete[](void *p, size_t size) noexcept {
+
+  (void)size;
+  pallocFree(p);
+}
+
+/** @} */
@@ -0,0 +1,172 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    profiler.c
+ * @brief   Sampling profiler code.
+ *
+ * @addtogroup profiler
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "profiler.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Profiler data.
+ */
+profiler_t profiler;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Hashes a PC block address into a bucket index.
+ *
+ * @param[in] pc        the PC block address
+ * @return              The first bucket to be probed.
+ */
+static unsigned prf_hash(uint32_t pc) {
+
+  /* Multiplicative hashing, the upper bits are the best mixed.*/
+  return (unsigned)(((pc >> PRF_PC_SHIFT) * 2654435761U) >> 16) &
+         (PRF_BUCKETS - 1U);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Profiler initialization.
+ *
+ * @init
+ */
+void prfInit(void) {
+
+  memset((void *)&profiler, 0, sizeof (profiler_t));
+}
+
+/**
+ * @brief   Clears all the collected samples.
+ *
+ * @iclass
+ */
+void prfResetI(void) {
+
+  osalDbgCheckClassI();
+
+  memset((void *)&profiler, 0, sizeof (profiler_t));
+}
+
+/**
+ * @brief   Clears all the collected samples.
+ *
+ * @api
+ */
+void prfReset(void) {
+
+  osalSysLock();
+  prfResetI();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Takes a sample.
+ * @details The PC interrupted by the current ISR and the current thread
+ *          are recorded in the hash table.
+ * @note    This function must be called from the ISR of a periodic timer,
+ *          the timer interrupt priority should be the highest among the
+ *          interrupts allowed to invoke system APIs so that the ISR does
+ *          not itself skew the samples.
+ *
+ * @iclass
+ */
+void prfSampleI(void) {
+  uint32_t pc;
+  unsigned i, n;
+
+  osalDbgCheckClassI();
+
+  profiler.samples++;
+
+  pc = PRF_GET_INTERRUPTED_PC();
+  if (pc == 0U) {
+    profiler.isr++;
+    return;
+  }
+  pc &= ~((1U << PRF_PC_SHIFT) - 1U);
+
+  /* Linear probing, the number of probes is bounded.*/
+  i = prf_hash(pc);
+  n = PRF_MAX_PROBES;
+  do {
+    prf_bucket_t *bp = &profiler.buckets[i];
+
+    if (bp->hits == 0U) {
+      bp->pc = pc;
+    }
+    if (bp->pc == pc) {
+      bp->tp = chThdGetSelfX();
+      bp->hits++;
+      return;
+    }
+    i = (i + 1U) & (PRF_BUCKETS - 1U);
+  } while (--n > 0U);
+
+  profiler.dropped++;
+}
+
+#if (HAL_USE_GPT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   GPT callback taking a sample.
+ * @details This function can be used directly as callback in the
+ *          @p GPTConfig structure of a continuous GPT.
+ *
+ * @param[in] gptp      pointer to the @p GPTDriver object
+ *
+ * @notapi
+ */
+void prfGPTCallback(GPTDriver *gptp) {
+
+  (void)gptp;
+
+  osalSysLockFromISR();
+  prfSampleI();
+  osalSysUnlockFromISR();
+}
+#endif
+
+/** @} */
@@ -0,0 +1,185 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    profiler.h
+ * @brief   Sampling profiler structures and macros.
+ *
+ * @addtogroup profiler
+ * @{
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of PC buckets.
+ * @note    It must be a power of two.
+ */
+#if !defined(PRF_BUCKETS) || defined(__DOXYGEN__)
+#define PRF_BUCKETS                         256U
+#endif
+
+/**
+ * @brief   Maximum number of probes when looking up a bucket.
+ * @details Samples not finding a bucket within this number of probes are
+ *          counted as dropped, it bounds the time spent in the ISR.
+ */
+#if !defined(PRF_MAX_PROBES) || defined(__DOXYGEN__)
+#define PRF_MAX_PROBES                      8U
+#endif
+
+/**
+ * @brief   PC resolution as a power of two.
+ * @details PC values are aggregated in blocks of <tt>1 << PRF_PC_SHIFT</tt>
+ *          bytes, larger values trade precision for table space.
+ */
+#if !defined(PRF_PC_SHIFT) || defined(__DOXYGEN__)
+#define PRF_PC_SHIFT                        1U
+#endif
+
+/**
+ * @brief   Returns the PC interrupted by the sampling ISR.
+ * @details The default implementation takes the PC from the exception
+ *          frame on the PSP stack for the architectures implementing the
+ *          @p RETTOBASE bit, ARMv7-M and ARMv8-M Mainline. It must return
+ *          zero when the PC is not available, for example when the
+ *          sampling ISR preempted another ISR.
+ * @note    Ports without a default implementation can redefine this
+ *          macro.
+ */
+#if !defined(PRF_GET_INTERRUPTED_PC) || defined(__DOXYGEN__)
+#define PRF_GET_INTERRUPTED_PC()            prf_get_interrupted_pc()
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (PRF_BUCKETS & (PRF_BUCKETS - 1U)) != 0U
+#error "PRF_BUCKETS must be a power of two"
+#endif
+
+#if (PRF_MAX_PROBES < 1U) || (PRF_MAX_PROBES > PRF_BUCKETS)
+#error "invalid PRF_MAX_PROBES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a PC bucket.
+ */
+typedef struct {
+  /**
+   * @brief   PC block address.
+   */
+  uint32_t              pc;
+  /**
+   * @brief   Thread interrupted by the last sample in this bucket.
+   */
+  thread_t              *tp;
+  /**
+   * @brief   Number of samples, zero if the bucket is free.
+   */
+  uint32_t              hits;
+} prf_bucket_t;
+
+/**
+ * @brief   Type of a profiler object.
+ */
+typedef struct {
+  /**
+   * @brief   Total number of samples.
+   */
+  uint32_t              samples;
+  /**
+   * @brief   Samples without an interrupted PC.
+   * @note    These are usually samples taken while serving another ISR.
+   */
+  uint32_t              isr;
+  /**
+   * @brief   Samples not finding a free bucket.
+   */
+  uint32_t              dropped;
+  /**
+   * @brief   PC buckets hash table.
+   */
+  prf_bucket_t          buckets[PRF_BUCKETS];
+} profiler_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if !defined(__DOXYGEN__)
+extern profiler_t profiler;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void prfInit(void);
+  void prfResetI(void);
+  void prfReset(void);
+  void prfSampleI(void);
+#if HAL_USE_GPT == TRUE
+  void prfGPTCallback(GPTDriver *gptp);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns the PC interrupted by the current ISR.
+ *
+ * @return              The interrupted PC or zero if not available.
+ *
+ * @notapi
+ */
+static inline uint32_t prf_get_interrupted_pc(void) {
+
+#if defined(SCB_ICSR_RETTOBASE_Msk)
+  /* If there are no other active exceptions then the ISR interrupted a
+     thread and the exception frame is on the PSP stack.*/
+  if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) != 0U) {
+    return ((struct port_extctx *)__get_PSP())->pc;
+  }
+#endif
+
+  return 0U;
+}
+
+#endif /* PROFILER_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Sampling profiler files.
+PRFSRC = $(CHIBIOS)/os/various/profiler/profiler.c
+
+PRFINC = $(CHIBIOS)/os/various/profiler
+
+# Shared variables
+ALLCSRC += $(PRFSRC)
+ALLINC  += $(PRFINC)
@@ -0,0 +1,214 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ptpsync.c
+ * @brief   PTP time synchronization code.
+ *
+ * @addtogroup ptp_sync
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "ptpsync.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Nominal PTP nanoseconds per kernel tick, 32.32 fixed point.
+ */
+#define PTPS_NOMINAL_RATE                                                   \
+  ((1000000000ULL << 32) / (uint64_t)CH_CFG_ST_FREQUENCY)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Reads the PTP clock in nanoseconds.
+ */
+static uint64_t ptps_read(MACDriver *macp) {
+  mac_ptp_time_t t;
+
+  macPTPGetTimeX(macp, &t);
+
+  return PTPS_TIME2NS(&t);
+}
+
+/**
+ * @brief   Scales a number of ticks in PTP nanoseconds.
+ * @note    The number of ticks must be lower than 2^32.
+ */
+static uint64_t ptps_scale(uint64_t ticks, uint64_t rate) {
+
+  return (ticks * (rate >> 32)) + ((ticks * (rate & 0xFFFFFFFFU)) >> 32);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a PTP synchronization object.
+ *
+ * @param[out] psp      pointer to the @p ptp_sync_t object
+ * @param[in] macp      pointer to the @p MACDriver object, the PTP clock
+ *                      must be running when samples are taken
+ *
+ * @init
+ */
+void ptpsObjectInit(ptp_sync_t *psp, MACDriver *macp) {
+
+  chDbgCheck((psp != NULL) && (macp != NULL));
+
+  psp->macp    = macp;
+  psp->samples = 0U;
+  psp->stamp   = (systimestamp_t)0;
+  psp->time    = 0U;
+  psp->rate    = PTPS_NOMINAL_RATE;
+}
+
+/**
+ * @brief   Takes a synchronization sample.
+ * @details The PTP clock is read in a tight loop until the system time
+ *          increments, the tick edge is located between the last two
+ *          readings and paired with the kernel time stamp of the new
+ *          tick. The first sample sets the offset, the following ones
+ *          also refine the rate estimate.
+ * @note    The function busy waits up to one system tick, it is meant
+ *          to be called periodically, for example once per second.
+ * @note    After a step of the PTP clock the object must be initialized
+ *          again.
+ *
+ * @param[in] psp       pointer to the @p ptp_sync_t object
+ *
+ * @api
+ */
+void ptpsSample(ptp_sync_t *psp) {
+  systime_t prev, now;
+  systimestamp_t stamp;
+  uint64_t t0, t1, time, rate;
+
+  chDbgCheck(psp != NULL);
+
+  /* Locating the tick edge, the sample is retried if the edge is not
+     bracketed tightly enough or if another tick occurred before the
+     time stamp was taken.*/
+  do {
+    t1  = ptps_read(psp->macp);
+    now = chVTGetSystemTimeX();
+    do {
+      prev = now;
+      t0   = t1;
+      t1   = ptps_read(psp->macp);
+      now  = chVTGetSystemTimeX();
+    } while (now == prev);
+    stamp = chVTGetTimeStampX();
+  } while (((t1 - t0) > (uint64_t)PTPS_CFG_MAX_WINDOW) ||
+           ((systime_t)stamp != now));
+  time = t0 + ((t1 - t0) / 2U);
+
+  /* Rate measured since the previous sample and filtered, this is done
+     outside the critical zone because this function is the only writer.*/
+  rate = psp->rate;
+  if ((psp->samples > 0U) && (time > psp->time) &&
+      ((stamp - psp->stamp) <= (systimestamp_t)0xFFFFFFFFU)) {
+    uint64_t dt = time - psp->time;
+    uint64_t ds = (uint64_t)(stamp - psp->stamp);
+    int64_t meas;
+
+    meas = (int64_t)(((dt / ds) << 32) + (((dt % ds) << 32) / ds));
+    rate = (uint64_t)((int64_t)rate + ((meas - (int64_t)rate) /
+                                       (1 << PTPS_CFG_FILTER_SHIFT)));
+  }
+
+  chSysLock();
+  psp->stamp = stamp;
+  psp->time  = time;
+  psp->rate  = rate;
+  psp->samples++;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Converts a kernel time stamp in PTP time.
+ * @note    The stamp must be within 2^32 ticks of the last sample.
+ *
+ * @param[in] psp       pointer to the @p ptp_sync_t object
+ * @param[in] stamp     kernel time stamp
+ * @return              The PTP time in nanoseconds.
+ *
+ * @iclass
+ */
+uint64_t ptpsStampToTimeI(ptp_sync_t *psp, systimestamp_t stamp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(psp != NULL);
+  chDbgAssert(psp->samples > 0U, "not synchronized");
+
+  if (stamp >= psp->stamp) {
+    return psp->time + ptps_scale((uint64_t)(stamp - psp->stamp), psp->rate);
+  }
+
+  return psp->time - ptps_scale((uint64_t)(psp->stamp - stamp), psp->rate);
+}
+
+/**
+ * @brief   Converts a PTP time in kernel time stamp.
+ * @note    The time must be within 2^48 nanoseconds of the last sample.
+ *
+ * @param[in] psp       pointer to the @p ptp_sync_t object
+ * @param[in] time      PTP time in nanoseconds
+ * @return              The kernel time stamp, rounded down to the tick.
+ *
+ * @iclass
+ */
+systimestamp_t ptpsTimeToStampI(ptp_sync_t *psp, uint64_t time) {
+  uint64_t d;
+
+  chDbgCheckClassI();
+  chDbgCheck(psp != NULL);
+  chDbgAssert(psp->samples > 0U, "not synchronized");
+
+  if (time >= psp->time) {
+    d = time - psp->time;
+    chDbgAssert(d < (1ULL << 48), "out of range");
+
+    return psp->stamp + (systimestamp_t)((d << 16) / (psp->rate >> 16));
+  }
+
+  d = psp->time - time;
+  chDbgAssert(d < (1ULL << 48), "out of range");
+
+  return psp->stamp - (systimestamp_t)((d << 16) / (psp->rate >> 16));
+}
+
+/** @} */
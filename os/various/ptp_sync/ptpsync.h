@@ -0,0 +1,177 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ptpsync.h
+ * @brief   PTP time synchronization structures and macros.
+ *
+ * @addtogroup ptp_sync
+ * @{
+ */
+
+#ifndef PTPSYNC_H
+#define PTPSYNC_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Maximum uncertainty of a sample in nanoseconds.
+ * @details Samples are retried when the tick edge cannot be located
+ *          within this window, for example because of an interrupt.
+ */
+#if !defined(PTPS_CFG_MAX_WINDOW) || defined(__DOXYGEN__)
+#define PTPS_CFG_MAX_WINDOW                 1000
+#endif
+
+/**
+ * @brief   Rate estimate filter.
+ * @details Each new rate measurement is weighted 1/2^n in the estimate.
+ */
+#if !defined(PTPS_CFG_FILTER_SHIFT) || defined(__DOXYGEN__)
+#define PTPS_CFG_FILTER_SHIFT               2
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_TIMESTAMP != TRUE
+#error "PTP synchronization requires CH_CFG_USE_TIMESTAMP"
+#endif
+
+#if (HAL_USE_MAC != TRUE) || (MAC_USE_PTP != TRUE)
+#error "PTP synchronization requires HAL_USE_MAC and MAC_USE_PTP"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a PTP synchronization object.
+ * @details The object keeps a linear mapping between the kernel time
+ *          stamps and the PTP clock of a MAC driver, the mapping is
+ *          refreshed by periodic samples.
+ */
+typedef struct {
+  /**
+   * @brief   MAC driver owning the PTP clock.
+   */
+  MACDriver                 *macp;
+  /**
+   * @brief   Number of samples taken.
+   */
+  uint32_t                  samples;
+  /**
+   * @brief   Kernel time stamp of the last sample.
+   */
+  systimestamp_t            stamp;
+  /**
+   * @brief   PTP time of the last sample in nanoseconds.
+   */
+  uint64_t                  time;
+  /**
+   * @brief   Estimated PTP nanoseconds per kernel tick, 32.32 fixed point.
+   */
+  uint64_t                  rate;
+} ptp_sync_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts a PTP time value in nanoseconds.
+ *
+ * @param[in] tp        pointer to a @p mac_ptp_time_t object
+ * @return              The time in nanoseconds.
+ */
+#define PTPS_TIME2NS(tp)                                                    \
+  (((uint64_t)(tp)->sec * 1000000000ULL) + (uint64_t)(tp)->nsec)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ptpsObjectInit(ptp_sync_t *psp, MACDriver *macp);
+  void ptpsSample(ptp_sync_t *psp);
+  uint64_t ptpsStampToTimeI(ptp_sync_t *psp, systimestamp_t stamp);
+  systimestamp_t ptpsTimeToStampI(ptp_sync_t *psp, uint64_t time);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Converts a kernel time stamp in PTP time.
+ *
+ * @param[in] psp       pointer to the @p ptp_sync_t object
+ * @param[in] stamp     kernel time stamp
+ * @return              The PTP time in nanoseconds.
+ *
+ * @api
+ */
+static inline uint64_t ptpsStampToTime(ptp_sync_t *psp,
+                                       systimestamp_t stamp) {
+  uint64_t time;
+
+  chSysLock();
+  time = ptpsStampToTimeI(psp, stamp);
+  chSysUnlock();
+
+  return time;
+}
+
+/**
+ * @brief   Converts a PTP time in kernel time stamp.
+ *
+ * @param[in] psp       pointer to the @p ptp_sync_t object
+ * @param[in] time      PTP time in nanoseconds
+ * @return              The kernel time stamp.
+ *
+ * @api
+ */
+static inline systimestamp_t ptpsTimeToStamp(ptp_sync_t *psp,
+                                             uint64_t time) {
+  systimestamp_t stamp;
+
+  chSysLock();
+  stamp = ptpsTimeToStampI(psp, time);
+  chSysUnlock();
+
+  return stamp;
+}
+
+#endif /* PTPSYNC_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# PTP time synchronization files.
+PTPSSRC = $(CHIBIOS)/os/various/ptp_sync/ptpsync.c
+
+PTPSINC = $(CHIBIOS)/os/various/ptp_sync
+
+# Shared variables
+ALLCSRC += $(PTPSSRC)
+ALLINC  += $(PTPSINC)
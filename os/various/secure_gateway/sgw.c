@@ -0,0 +1,252 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sgw.c
+ * @brief   TrustZone secure gateway code.
+ * @details This file is part of the secure image only.
+ *
+ * @addtogroup secure_gateway
+ * @{
+ */
+
+#include "ch.h"
+#include "sgw.h"
+
+#include <arm_cmse.h>
+
+#if !defined(__ARM_FEATURE_CMSE) || (__ARM_FEATURE_CMSE != 3)
+#error "the secure gateway requires compiling with -mcmse"
+#endif
+
+#if (SGW_CFG_USE_WORKER == TRUE) && (CH_CFG_USE_MESSAGES == FALSE)
+#error "SGW_CFG_USE_WORKER requires CH_CFG_USE_MESSAGES"
+#endif
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Non-secure callable entry attribute.
+ * @details The compiler generates the secure gateway veneer and clears the
+ *          registers not carrying the result on return, no context is
+ *          saved beyond the callee-saved registers.
+ */
+#define SGW_ENTRY           __attribute__((cmse_nonsecure_entry))
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Gateway state.
+ */
+static struct {
+  /**
+   * @brief   Services table.
+   */
+  const sgw_service_t   *services;
+  /**
+   * @brief   Number of services.
+   */
+  uint32_t              n;
+#if (SGW_CFG_USE_WORKER == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Worker thread.
+   */
+  thread_t              *worker;
+#endif
+} sgw;
+
+#if (SGW_CFG_USE_WORKER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Worker thread working area.
+ */
+static THD_WORKING_AREA(sgw_worker_wa, SGW_CFG_WORKER_STACK_SIZE);
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+#if (SGW_CFG_USE_WORKER == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Worker thread, it executes the requests sent by the gateway.
+ */
+static THD_FUNCTION(sgw_worker, arg) {
+
+  (void)arg;
+
+  chRegSetThreadName("sgw");
+  while (true) {
+    thread_t *tp = chMsgWait();
+    sgw_request_t *rp = (sgw_request_t *)chMsgGet(tp);
+
+    rp->result = sgw.services[rp->id].fn(rp->args[0], rp->args[1],
+                                         rp->args[2]);
+    chMsgRelease(tp, MSG_OK);
+  }
+}
+#endif
+
+/**
+ * @brief   Executes a request.
+ * @note    The request must be in secure memory.
+ *
+ * @param[in,out] rp    pointer to the @p sgw_request_t object
+ * @return              The service result.
+ */
+static uint32_t sgw_execute(sgw_request_t *rp) {
+  const sgw_service_t *sp;
+
+  if (rp->id >= sgw.n) {
+    return SGW_ERROR_SERVICE;
+  }
+  sp = &sgw.services[rp->id];
+
+#if SGW_CFG_USE_WORKER == TRUE
+  if ((sp->flags & SGW_SVC_WORKER) != 0U) {
+    (void) chMsgSend(sgw.worker, (msg_t)rp);
+    return rp->result;
+  }
+#endif
+
+  return sp->fn(rp->args[0], rp->args[1], rp->args[2]);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Gateway initialization.
+ * @details The service identifiers are the indexes in the services table.
+ *
+ * @param[in] services  pointer to the services table
+ * @param[in] n         number of services in the table
+ *
+ * @init
+ */
+void sgwInit(const sgw_service_t *services, uint32_t n) {
+
+  chDbgCheck((services != NULL) && (n > 0U));
+
+  sgw.services = services;
+  sgw.n        = n;
+#if SGW_CFG_USE_WORKER == TRUE
+  sgw.worker   = chThdCreateStatic(sgw_worker_wa, sizeof (sgw_worker_wa),
+                                   SGW_CFG_WORKER_PRIORITY, sgw_worker, NULL);
+#endif
+}
+
+/**
+ * @brief   Checks a buffer passed by the non-secure side.
+ * @details Services must validate pointer arguments before accessing
+ *          them, the whole range must be non-secure and accessible.
+ *
+ * @param[in] p         buffer pointer
+ * @param[in] size      buffer size
+ * @param[in] writable  the buffer is written by the service
+ * @return              The buffer pointer or @p NULL if not accessible.
+ *
+ * @api
+ */
+void *sgwCheckBuffer(void *p, size_t size, bool writable) {
+
+  return cmse_check_address_range(p, size,
+                                  CMSE_NONSECURE |
+                                  (writable ? CMSE_MPU_READWRITE :
+                                              CMSE_MPU_READ));
+}
+
+/**
+ * @brief   Calls a secure service.
+ * @details Arguments and result are passed in registers only, there is no
+ *          shared memory involved. Services not executed by the worker
+ *          thread run on the stack of the calling thread.
+ * @note    This function is a non-secure callable entry.
+ *
+ * @param[in] id        service identifier
+ * @param[in] a0        first argument
+ * @param[in] a1        second argument
+ * @param[in] a2        third argument
+ * @return              The service result.
+ * @retval SGW_ERROR_SERVICE unknown service identifier.
+ *
+ * @api
+ */
+SGW_ENTRY uint32_t sgwCall(uint32_t id, uint32_t a0,
+                           uint32_t a1, uint32_t a2) {
+
+  /* Fast path, no request structure is built.*/
+  if ((id < sgw.n) && ((sgw.services[id].flags & SGW_SVC_WORKER) == 0U)) {
+    return sgw.services[id].fn(a0, a1, a2);
+  }
+  else {
+    sgw_request_t req;
+
+    req.id      = id;
+    req.args[0] = a0;
+    req.args[1] = a1;
+    req.args[2] = a2;
+    return sgw_execute(&req);
+  }
+}
+
+/**
+ * @brief   Calls a batch of secure services.
+ * @details The requests are executed in order within a single security
+ *          state transition, the result of each request is written in
+ *          its @p result field.
+ * @note    This function is a non-secure callable entry.
+ *
+ * @param[in,out] reqs  pointer to an array of @p sgw_request_t objects
+ * @param[in] n         number of requests
+ * @return              The number of executed requests.
+ * @retval SGW_ERROR_ACCESS the requests array is not accessible.
+ *
+ * @api
+ */
+SGW_ENTRY uint32_t sgwCallBatch(sgw_request_t *reqs, uint32_t n) {
+  uint32_t i;
+
+  if ((n == 0U) || (n > SGW_CFG_MAX_BATCH) ||
+      (sgwCheckBuffer(reqs, n * sizeof (sgw_request_t), true) == NULL)) {
+    return SGW_ERROR_ACCESS;
+  }
+
+  for (i = 0U; i < n; i++) {
+    sgw_request_t req;
+
+    /* Each request is copied in secure memory before being examined, the
+       non-secure side could modify it meanwhile.*/
+    req = reqs[i];
+    reqs[i].result = sgw_execute(&req);
+  }
+
+  return n;
+}
+
+/** @} */
@@ -0,0 +1,189 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sgw.h
+ * @brief   TrustZone secure gateway macros and structures.
+ * @details This header is shared by the secure and the non-secure images,
+ *          the non-secure image links the gateway entries from the import
+ *          library generated when linking the secure image.
+ *
+ * @addtogroup secure_gateway
+ * @{
+ */
+
+#ifndef SGW_H
+#define SGW_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Gateway errors
+ * @{
+ */
+/**
+ * @brief   Unknown service identifier.
+ */
+#define SGW_ERROR_SERVICE                   0xFFFFFFFFU
+
+/**
+ * @brief   Memory not accessible by the non-secure caller.
+ */
+#define SGW_ERROR_ACCESS                    0xFFFFFFFEU
+/** @} */
+
+/**
+ * @name    Service flags
+ * @{
+ */
+/**
+ * @brief   The service is executed by the gateway worker thread.
+ */
+#define SGW_SVC_WORKER                      1U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Enables the gateway worker thread.
+ * @details Services flagged with @p SGW_SVC_WORKER are executed by a
+ *          secure thread with its own stack instead of the stack of the
+ *          thread running the non-secure code.
+ */
+#if !defined(SGW_CFG_USE_WORKER) || defined(__DOXYGEN__)
+#define SGW_CFG_USE_WORKER                  FALSE
+#endif
+
+/**
+ * @brief   Stack size of the gateway worker thread.
+ */
+#if !defined(SGW_CFG_WORKER_STACK_SIZE) || defined(__DOXYGEN__)
+#define SGW_CFG_WORKER_STACK_SIZE           1024
+#endif
+
+/**
+ * @brief   Priority of the gateway worker thread.
+ */
+#if !defined(SGW_CFG_WORKER_PRIORITY) || defined(__DOXYGEN__)
+#define SGW_CFG_WORKER_PRIORITY             NORMALPRIO
+#endif
+
+/**
+ * @brief   Maximum number of requests in a batch.
+ */
+#if !defined(SGW_CFG_MAX_BATCH) || defined(__DOXYGEN__)
+#define SGW_CFG_MAX_BATCH                   16U
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if SGW_CFG_MAX_BATCH < 1U
+#error "invalid SGW_CFG_MAX_BATCH value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a service function.
+ * @note    Pointer arguments come from the non-secure side, they must be
+ *          validated using @p sgwCheckBuffer() before use.
+ *
+ * @param[in] a0        first argument
+ * @param[in] a1        second argument
+ * @param[in] a2        third argument
+ * @return              The service result.
+ */
+typedef uint32_t (*sgw_function_t)(uint32_t a0, uint32_t a1, uint32_t a2);
+
+/**
+ * @brief   Type of a service descriptor.
+ */
+typedef struct {
+  /**
+   * @brief   Service function.
+   */
+  sgw_function_t        fn;
+  /**
+   * @brief   Service flags.
+   */
+  uint32_t              flags;
+} sgw_service_t;
+
+/**
+ * @brief   Type of a batched request.
+ */
+typedef struct {
+  /**
+   * @brief   Service identifier.
+   */
+  uint32_t              id;
+  /**
+   * @brief   Service arguments.
+   */
+  uint32_t              args[3];
+  /**
+   * @brief   Service result, written by the gateway.
+   */
+  uint32_t              result;
+} sgw_request_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  /* Gateway entries, callable from the non-secure side.*/
+  uint32_t sgwCall(uint32_t id, uint32_t a0, uint32_t a1, uint32_t a2);
+  uint32_t sgwCallBatch(sgw_request_t *reqs, uint32_t n);
+#if defined(__ARM_FEATURE_CMSE) && (__ARM_FEATURE_CMSE == 3)
+  /* Secure side functions.*/
+  void sgwInit(const sgw_service_t *services, uint32_t n);
+  void *sgwCheckBuffer(void *p, size_t size, bool writable);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* SGW_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Secure gateway files, secure image only.
+SGWSRC = $(CHIBIOS)/os/various/secure_gateway/sgw.c
+
+SGWINC = $(CHIBIOS)/os/various/secure_gateway
+
+# Shared variables
+ALLCSRC += $(SGWSRC)
+ALLINC  += $(SGWINC)
@@ -0,0 +1,198 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensorhub.c
+ * @brief   Sensors hub code.
+ *
+ * @addtogroup sensor_hub
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "sensorhub.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Reads a source into a hub buffer and posts it.
+ */
+static void shub_read_source(sensor_hub_t *shp, uint32_t i) {
+  const SensorHubConfig *config = shp->config;
+  const sensor_hub_source_t *srcp = &config->sources[i];
+  sensor_hub_buffer_t *bp;
+  size_t sets;
+  msg_t msg;
+
+  /* Without free buffers the FIFO data is left in the sensor until the
+     next cycle.*/
+  bp = (sensor_hub_buffer_t *)chFifoTakeObjectTimeout(config->ofp,
+                                                      TIME_IMMEDIATE);
+  if (bp == NULL) {
+    shp->sequence++;
+    shp->lost++;
+    return;
+  }
+
+  if (srcp->fifo != NULL) {
+    bp->width = sensorFIFOGetSetSize(srcp->fifo);
+    msg = sensorFIFOReadRawSets(srcp->fifo, shubGetSamples(bp),
+                                config->maxsets, &sets);
+  }
+  else {
+    bp->width = sensorGetChannelNumber(srcp->sensor);
+    msg = sensorReadRaw(srcp->sensor, shubGetSamples(bp));
+    sets = 1U;
+  }
+
+  if ((msg != MSG_OK) || (sets == 0U)) {
+    if (msg != MSG_OK) {
+      shp->errors++;
+    }
+    chFifoReturnObject(config->ofp, (void *)bp);
+    return;
+  }
+
+  bp->timestamp = chVTGetTimeStamp();
+  bp->sequence  = shp->sequence++;
+  bp->source    = i;
+  bp->sets      = sets;
+  chFifoSendObject(config->ofp, (void *)bp);
+}
+
+/**
+ * @brief   Hub thread, all the sources are read on each cycle.
+ */
+static THD_FUNCTION(shub_thread, arg) {
+  sensor_hub_t *shp = (sensor_hub_t *)arg;
+  uint32_t i;
+
+  chRegSetThreadName("sensorhub");
+
+  while (!chThdShouldTerminateX()) {
+    (void) chEvtWaitAnyTimeout(SHUB_EVT_DATA, shp->config->period);
+
+    for (i = 0U; i < (uint32_t)shp->config->nsources; i++) {
+      shub_read_source(shp, i);
+    }
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p sensor_hub_t object.
+ *
+ * @param[out] shp      pointer to the @p sensor_hub_t object
+ *
+ * @init
+ */
+void shubObjectInit(sensor_hub_t *shp) {
+
+  shp->config   = NULL;
+  shp->thread   = NULL;
+  shp->sequence = 0U;
+  shp->lost     = 0U;
+  shp->errors   = 0U;
+}
+
+/**
+ * @brief   Starts the hub.
+ * @details A thread is spawned, on each cycle all sources are read, the
+ *          sources exposing a FIFO are drained using burst reads of whole
+ *          samples sets. Each read is time stamped and posted to the
+ *          objects FIFO as a separate buffer.
+ *
+ * @param[in] shp       pointer to the @p sensor_hub_t object
+ * @param[in] config    pointer to the @p SensorHubConfig object
+ *
+ * @api
+ */
+void shubStart(sensor_hub_t *shp, const SensorHubConfig *config) {
+
+  chDbgCheck((shp != NULL) && (config != NULL) &&
+             (config->sources != NULL) && (config->nsources > 0U) &&
+             (config->ofp != NULL) && (config->maxsets > 0U) &&
+             (config->wsp != NULL));
+  chDbgAssert(shp->thread == NULL, "already started");
+
+  shp->config   = config;
+  shp->sequence = 0U;
+  shp->lost     = 0U;
+  shp->errors   = 0U;
+  shp->thread   = chThdCreateStatic(config->wsp, config->wssize,
+                                    config->prio, shub_thread, (void *)shp);
+}
+
+/**
+ * @brief   Stops the hub.
+ * @details The function waits for the hub thread to terminate.
+ * @note    Buffers already posted remain in the objects FIFO.
+ *
+ * @param[in] shp       pointer to the @p sensor_hub_t object
+ *
+ * @api
+ */
+void shubStop(sensor_hub_t *shp) {
+
+  chDbgCheck((shp != NULL) && (shp->thread != NULL));
+
+  chThdTerminate(shp->thread);
+  chEvtSignal(shp->thread, SHUB_EVT_DATA);
+  (void) chThdWait(shp->thread);
+  shp->thread = NULL;
+}
+
+/**
+ * @brief   Triggers a hub cycle.
+ * @note    This function is meant to be called from the sensors data ready
+ *          or FIFO watermark interrupt handlers.
+ *
+ * @param[in] shp       pointer to the @p sensor_hub_t object
+ *
+ * @iclass
+ */
+void shubSignalI(sensor_hub_t *shp) {
+
+  chDbgCheckClassI();
+
+  if (shp->thread != NULL) {
+    chEvtSignalI(shp->thread, SHUB_EVT_DATA);
+  }
+}
+
+/** @} */
@@ -0,0 +1,266 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensorhub.h
+ * @brief   Sensors hub structures and macros.
+ *
+ * @addtogroup sensor_hub
+ * @{
+ */
+
+#ifndef SENSORHUB_H
+#define SENSORHUB_H
+
+#include "ex_sensors.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Event flag used by @p shubSignalI().
+ */
+#define SHUB_EVT_DATA                       EVENT_MASK(0)
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CH_CFG_USE_OBJ_FIFOS != TRUE
+#error "sensors hub requires CH_CFG_USE_OBJ_FIFOS"
+#endif
+
+#if CH_CFG_USE_TIMESTAMP != TRUE
+#error "sensors hub requires CH_CFG_USE_TIMESTAMP"
+#endif
+
+#if CH_CFG_USE_EVENTS != TRUE
+#error "sensors hub requires CH_CFG_USE_EVENTS"
+#endif
+
+#if CH_CFG_USE_WAITEXIT != TRUE
+#error "sensors hub requires CH_CFG_USE_WAITEXIT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a sensors hub object.
+ */
+typedef struct sensor_hub sensor_hub_t;
+
+/**
+ * @brief   Type of a hub buffer header.
+ * @note    The samples follow the header, see @p shubGetSamples().
+ */
+typedef struct {
+  /**
+   * @brief   Time stamp of the read completion.
+   */
+  systimestamp_t        timestamp;
+  /**
+   * @brief   Buffer sequence number.
+   * @note    Gaps in the sequence are reads skipped because no free
+   *          objects were available in the FIFO.
+   */
+  uint32_t              sequence;
+  /**
+   * @brief   Index of the source in the configuration.
+   */
+  uint32_t              source;
+  /**
+   * @brief   Number of samples sets in the buffer.
+   */
+  size_t                sets;
+  /**
+   * @brief   Number of values in each samples set.
+   */
+  size_t                width;
+} sensor_hub_buffer_t;
+
+/**
+ * @brief   Type of a hub source.
+ * @note    Sources exposing a FIFO are read in bursts, the other sources
+ *          are read once per cycle.
+ */
+typedef struct {
+  /**
+   * @brief   FIFO interface of the sensor or @p NULL.
+   */
+  BaseSensorFIFO            *fifo;
+  /**
+   * @brief   Sensor interface, used when @p fifo is @p NULL.
+   */
+  BaseSensor                *sensor;
+} sensor_hub_source_t;
+
+/**
+ * @brief   Sensors hub configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief   Array of sources, the sensors must be started.
+   */
+  const sensor_hub_source_t *sources;
+  /**
+   * @brief   Number of sources.
+   */
+  size_t                    nsources;
+  /**
+   * @brief   Objects FIFO of the hub buffers.
+   * @note    The objects size must be at least
+   *          @p SHUB_BUFFER_SIZE(width, maxsets) for the widest source.
+   */
+  objects_fifo_t            *ofp;
+  /**
+   * @brief   Maximum number of samples sets in a hub buffer.
+   */
+  size_t                    maxsets;
+  /**
+   * @brief   Polling period.
+   * @note    A cycle is also triggered by @p shubSignalI(), this allows
+   *          to use the sensors data ready or FIFO watermark interrupts.
+   */
+  sysinterval_t             period;
+  /**
+   * @brief   Hub thread priority.
+   */
+  tprio_t                   prio;
+  /**
+   * @brief   Hub thread working area.
+   */
+  void                      *wsp;
+  /**
+   * @brief   Hub thread working area size.
+   */
+  size_t                    wssize;
+} SensorHubConfig;
+
+/**
+ * @brief   Structure representing a sensors hub.
+ */
+struct sensor_hub {
+  /**
+   * @brief   Current configuration data.
+   */
+  const SensorHubConfig     *config;
+  /**
+   * @brief   Hub thread or @p NULL.
+   */
+  thread_t                  *thread;
+  /**
+   * @brief   Sequence number of the next buffer.
+   */
+  uint32_t                  sequence;
+  /**
+   * @brief   Number of reads skipped for lack of free buffers.
+   */
+  uint32_t                  lost;
+  /**
+   * @brief   Number of failed reads.
+   */
+  uint32_t                  errors;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of a hub buffer object.
+ *
+ * @param[in] width     number of values in a samples set
+ * @param[in] sets      number of samples sets
+ */
+#define SHUB_BUFFER_SIZE(width, sets)                                       \
+  (sizeof (sensor_hub_buffer_t) +                                           \
+   ((size_t)(width) * (size_t)(sets) * sizeof (int32_t)))
+
+/**
+ * @brief   Returns the samples of a hub buffer.
+ *
+ * @param[in] bp        pointer to the @p sensor_hub_buffer_t object
+ * @return              Pointer to the first sample.
+ */
+#define shubGetSamples(bp) ((int32_t *)(void *)((bp) + 1))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void shubObjectInit(sensor_hub_t *shp);
+  void shubStart(sensor_hub_t *shp, const SensorHubConfig *config);
+  void shubStop(sensor_hub_t *shp);
+  void shubSignalI(sensor_hub_t *shp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief   Receives a filled hub buffer.
+ *
+ * @param[in] shp       pointer to the @p sensor_hub_t object
+ * @param[out] bpp      pointer to the received buffer pointer
+ * @param[in] timeout   the number of ticks before the operation timeouts,
+ *                      the following special values are allowed:
+ *                      - @a TIME_IMMEDIATE immediate timeout.
+ *                      - @a TIME_INFINITE no timeout.
+ *                      .
+ * @return              The operation status.
+ * @retval MSG_OK       if a buffer has been received.
+ * @retval MSG_TIMEOUT  if the operation has timed out.
+ *
+ * @api
+ */
+static inline msg_t shubReceiveBufferTimeout(sensor_hub_t *shp,
+                                             sensor_hub_buffer_t **bpp,
+                                             sysinterval_t timeout) {
+
+  return chFifoReceiveObjectTimeout(shp->config->ofp,
+                                    (void **)bpp, timeout);
+}
+
+/**
+ * @brief   Returns a processed hub buffer to the free objects.
+ *
+ * @param[in] shp       pointer to the @p sensor_hub_t object
+ * @param[in] bp        pointer to the buffer to be returned
+ *
+ * @api
+ */
+static inline void shubReleaseBuffer(sensor_hub_t *shp,
+                                     sensor_hub_buffer_t *bp) {
+
+  chFifoReturnObject(shp->config->ofp, (void *)bp);
+}
+
+#endif /* SENSORHUB_H */
+
+/** @} */
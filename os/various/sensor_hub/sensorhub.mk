@@ -0,0 +1,9 @@
+# Sensors hub files.
+SHUBSRC = $(CHIBIOS)/os/various/sensor_hub/sensorhub.c
+
+SHUBINC = $(CHIBIOS)/os/various/sensor_hub \
+          $(CHIBIOS)/os/ex/include
+
+# Shared variables
+ALLCSRC += $(SHUBSRC)
+ALLINC  += $(SHUBINC)
@@ -22,6 +22,7 @@
  * @{
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "ch.h"
@@ -30,6 +31,14 @@
 #include "shell_cmd.h"
 #include "chprintf.h"
 
+#if (SHELL_CMD_PROF_ENABLED == TRUE) || defined(__DOXYGEN__)
+#include "profiler.h"
+#endif
+
+#if (SHELL_CMD_PERF_ENABLED == TRUE) || defined(__DOXYGEN__)
+#include "perfmon.h"
+#endif
+
 #if (SHELL_CMD_TEST_ENABLED == TRUE) || defined(__DOXYGEN__)
 #include "rt_test_root.h"
 #include "oslib_test_root.h"
@@ -131,9 +140,45 @@ static void cmd_systime(BaseSequentialStream *chp, int argc, char *argv[]) {
 static void cmd_mem(BaseSequentialStream *chp, int argc, char *argv[]) {
   size_t n, total, largest;
 
+#if CH_DBG_MEM_PROFILING == TRUE
+  static const char *allocators[] = {"-", "heap", "pool", "core"};
+  memprof_site_t site;
+  uint32_t secs;
+  unsigned i;
+
+  if ((argc == 1) && !strcmp(argv[0], "reset")) {
+    chMemProfReset();
+    return;
+  }
+  if ((argc == 1) && !strcmp(argv[0], "sites")) {
+    secs = (uint32_t)((chVTGetTimeStamp() - chMemProfGetStartX()) /
+                      (systimestamp_t)CH_CFG_ST_FREQUENCY);
+    chprintf(chp, "pc       alloc    allocs     frees      live      peak"
+                  "  allocs/m thread" SHELL_NEWLINE_STR);
+    for (i = 0U; i < (unsigned)CH_DBG_MEM_PROFILING_SITES; i++) {
+      if (chMemProfReadSite(i, &site)) {
+        chprintf(chp, "%08lx %5s %9lu %9lu %9lu %9lu %9lu %08lx"
+                      SHELL_NEWLINE_STR,
+                 (uint32_t)site.pc, allocators[site.allocator],
+                 (uint32_t)site.allocs, (uint32_t)site.frees,
+                 (uint32_t)site.live, (uint32_t)site.peak,
+                 secs == 0U ? 0U :
+                   (uint32_t)(((uint64_t)site.allocs * 60U) / secs),
+                 (uint32_t)site.tp);
+      }
+    }
+    chprintf(chp, "dropped: %lu" SHELL_NEWLINE_STR,
+             (uint32_t)chMemProfGetDroppedX());
+    return;
+  }
+#endif
   (void)argv;
   if (argc > 0) {
+#if CH_DBG_MEM_PROFILING == TRUE
+    shellUsage(chp, "mem [sites|reset]");
+#else
     shellUsage(chp, "mem");
+#endif
     return;
   }
   n = chHeapStatus(NULL, &total, &largest);
@@ -141,6 +186,8 @@ static void cmd_mem(BaseSequentialStream *chp, int argc, char *argv[]) {
   chprintf(chp, "heap fragments   : %u" SHELL_NEWLINE_STR, n);
   chprintf(chp, "heap free total  : %u bytes" SHELL_NEWLINE_STR, total);
   chprintf(chp, "heap free largest: %u bytes" SHELL_NEWLINE_STR, largest);
+  chprintf(chp, "heap fragmentation: %u%%" SHELL_NEWLINE_STR,
+           total == 0U ? 0U : 100U - (unsigned)((largest * 100U) / total));
 }
 #endif
 
@@ -154,7 +201,12 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
     shellUsage(chp, "threads");
     return;
   }
+#if CH_DBG_STACK_WATERMARK == TRUE
+  chprintf(chp, "stklimit    stack     addr refs prio     state         name"
+                " margin\r\n" SHELL_NEWLINE_STR);
+#else
   chprintf(chp, "stklimit    stack     addr refs prio     state         name\r\n" SHELL_NEWLINE_STR);
+#endif
   tp = chRegFirstThread();
   do {
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
@@ -162,12 +214,370 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
 #else
     uint32_t stklimit = 0U;
 #endif
-    chprintf(chp, "%08lx %08lx %08lx %4lu %4lu %9s %12s" SHELL_NEWLINE_STR,
+    chprintf(chp, "%08lx %08lx %08lx %4lu %4lu %9s %12s",
              stklimit, (uint32_t)tp->ctx.sp, (uint32_t)tp,
              (uint32_t)tp->refs - 1, (uint32_t)tp->hdr.pqueue.prio, states[tp->state],
              tp->name == NULL ? "" : tp->name);
+#if CH_DBG_STACK_WATERMARK == TRUE
+    chprintf(chp, " %6lu", (uint32_t)chThdGetStackMarginX(tp));
+#endif
+    chprintf(chp, SHELL_NEWLINE_STR);
+    tp = chRegNextThread(tp);
+  } while (tp != NULL);
+}
+#endif
+
+#if (SHELL_CMD_STATS_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void cmd_stats(BaseSequentialStream *chp, int argc, char *argv[]) {
+  thread_t *tp;
+
+#if CH_DBG_CRIT_OFFENDERS > 0
+  if ((argc == 1) && !strcmp(argv[0], "reset")) {
+    chStatsResetCritOffenders();
+    return;
+  }
+#endif
+  if (argc > 0) {
+    shellUsage(chp, "stats [reset]");
+    return;
+  }
+  chprintf(chp, "    addr prio         cycles switches worst latency"
+                " histogram name" SHELL_NEWLINE_STR);
+  tp = chRegFirstThread();
+  do {
+    chprintf(chp, "%08lx %4lu %08lx%08lx %8lu",
+             (uint32_t)tp, (uint32_t)tp->hdr.pqueue.prio,
+             (uint32_t)(tp->stats.cumulative >> 32),
+             (uint32_t)tp->stats.cumulative, (uint32_t)tp->stats.n);
+#if CH_DBG_LATENCY_HISTOGRAMS == TRUE
+    {
+      unsigned i;
+
+      chprintf(chp, " %13lu ", (uint32_t)tp->latency.worst);
+      for (i = 0U; i < (unsigned)CH_DBG_LATENCY_BUCKETS; i++) {
+        chprintf(chp, "%lu/", (uint32_t)tp->latency.hist[i]);
+      }
+    }
+#endif
+    chprintf(chp, " %s" SHELL_NEWLINE_STR, tp->name == NULL ? "" : tp->name);
+    tp = chRegNextThread(tp);
+  } while (tp != NULL);
+#if CH_DBG_CRIT_OFFENDERS > 0
+  {
+    crit_offender_t offenders[CH_DBG_CRIT_OFFENDERS];
+    unsigned i;
+
+    chSysLock();
+    memcpy(offenders, currcore->kernel_stats.crit_offenders,
+           sizeof (offenders));
+    chSysUnlock();
+    chprintf(chp, SHELL_NEWLINE_STR "duration   caller   thread"
+                  SHELL_NEWLINE_STR);
+    for (i = 0U; i < (unsigned)CH_DBG_CRIT_OFFENDERS; i++) {
+      if (offenders[i].caller != NULL) {
+        chprintf(chp, "%8lu %08lx %08lx" SHELL_NEWLINE_STR,
+                 (uint32_t)offenders[i].duration,
+                 (uint32_t)offenders[i].caller, (uint32_t)offenders[i].tp);
+      }
+    }
+  }
+#endif
+}
+#endif
+
+#if (SHELL_CMD_TOP_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void cmd_top(BaseSequentialStream *chp, int argc, char *argv[]) {
+  struct {
+    thread_t    *tp;
+    rttime_t    cycles;
+    ucnt_t      switches;
+  } snap[SHELL_CMD_TOP_THREADS];
+  rttime_t total;
+  sysinterval_t interval;
+  thread_t *tp;
+  unsigned i, n;
+
+  if (argc > 1) {
+    shellUsage(chp, "top [ms]");
+    return;
+  }
+  interval = TIME_MS2I(argc == 1 ? atoi(argv[0]) : 1000);
+  if (interval == (sysinterval_t)0) {
+    shellUsage(chp, "top [ms]");
+    return;
+  }
+
+  /* Taking a snapshot of the threads counters then again after the
+     interval, snapshot pointers are only compared and never dereferenced
+     because threads could terminate in the meantime.*/
+  n = 0U;
+  tp = chRegFirstThread();
+  do {
+    if (n < (unsigned)SHELL_CMD_TOP_THREADS) {
+      chSysLock();
+      snap[n].tp       = tp;
+      snap[n].cycles   = tp->stats.cumulative;
+      snap[n].switches = tp->stats.n;
+      chSysUnlock();
+      n++;
+    }
     tp = chRegNextThread(tp);
   } while (tp != NULL);
+
+  chThdSleep(interval);
+
+  /* Deltas are computed in place, threads not found anymore have a null
+     pointer.*/
+  for (i = 0U; i < n; i++) {
+    thread_t *stp = snap[i].tp;
+
+    snap[i].tp = NULL;
+    tp = chRegFirstThread();
+    do {
+      if (tp == stp) {
+        chSysLock();
+        if (tp->stats.cumulative >= snap[i].cycles) {
+          snap[i].tp       = tp;
+          snap[i].cycles   = tp->stats.cumulative - snap[i].cycles;
+          snap[i].switches = tp->stats.n - snap[i].switches;
+        }
+        chSysUnlock();
+      }
+      tp = chRegNextThread(tp);
+    } while (tp != NULL);
+  }
+
+  total = (rttime_t)0;
+  for (i = 0U; i < n; i++) {
+    if (snap[i].tp != NULL) {
+      total += snap[i].cycles;
+    }
+  }
+  if (total == (rttime_t)0) {
+    return;
+  }
+
+  chprintf(chp, "    addr prio    cpu switches name" SHELL_NEWLINE_STR);
+  for (i = 0U; i < n; i++) {
+    uint32_t permille;
+
+    if (snap[i].tp == NULL) {
+      continue;
+    }
+    permille = (uint32_t)((snap[i].cycles * (rttime_t)1000) / total);
+    chprintf(chp, "%08lx %4lu %3lu.%lu%% %8lu %s" SHELL_NEWLINE_STR,
+             (uint32_t)snap[i].tp, (uint32_t)snap[i].tp->hdr.pqueue.prio,
+             permille / 10U, permille % 10U, (uint32_t)snap[i].switches,
+             snap[i].tp->name == NULL ? "" : snap[i].tp->name);
+  }
+}
+#endif
+
+#if (SHELL_CMD_TRACE_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void cmd_trace(BaseSequentialStream *chp, int argc, char *argv[]) {
+  static const char *types[] = {"-", "READY", "SWITCH", "ISR_ENTER",
+                                "ISR_LEAVE", "HALT", "USER", "WAKEUP"};
+  trace_buffer_t *tbp = &currcore->trace_buffer;
+  uint32_t seq;
+  unsigned n;
+
+  if ((argc == 2) && !strcmp(argv[0], "suspend")) {
+    chDbgSuspendTrace((uint16_t)strtoul(argv[1], NULL, 0));
+    return;
+  }
+  if ((argc == 2) && !strcmp(argv[0], "resume")) {
+    chDbgResumeTrace((uint16_t)strtoul(argv[1], NULL, 0));
+    return;
+  }
+  if (argc > 1) {
+    shellUsage(chp, "trace [n]|suspend <mask>|resume <mask>");
+    return;
+  }
+  n = argc == 1 ? (unsigned)atoi(argv[0]) : 16U;
+  if (n > (unsigned)CH_DBG_TRACE_BUFFER_SIZE) {
+    n = (unsigned)CH_DBG_TRACE_BUFFER_SIZE;
+  }
+
+  chprintf(chp, "suspended: %04x" SHELL_NEWLINE_STR,
+           (unsigned)tbp->suspended);
+  chprintf(chp, "       seq       time   rtstamp type      data"
+           SHELL_NEWLINE_STR);
+
+  /* Printing the last n records from the oldest, each record is copied
+     under lock because the buffer is written by the kernel, records
+     overwritten while printing are skipped.*/
+  seq = chDbgGetTraceSequenceX() - (uint32_t)n;
+  while (n > 0U) {
+    trace_event_t te;
+    bool ok;
+
+    chSysLock();
+    ok = chDbgReadTraceI(seq, &te);
+    chSysUnlock();
+    seq++;
+    n--;
+    if (!ok || (te.type == CH_TRACE_TYPE_UNUSED) ||
+        (te.type > CH_TRACE_TYPE_WAKEUP)) {
+      continue;
+    }
+
+    chprintf(chp, "%10lu %10lu  %06lx %-9s ", seq - 1U, (uint32_t)te.time,
+             (uint32_t)te.rtstamp, types[te.type]);
+    switch (te.type) {
+    case CH_TRACE_TYPE_READY:
+      chprintf(chp, "tp=%08lx msg=%ld", (uint32_t)te.u.rdy.tp,
+               (int32_t)te.u.rdy.msg);
+      break;
+    case CH_TRACE_TYPE_SWITCH:
+      chprintf(chp, "ntp=%08lx wtobjp=%08lx", (uint32_t)te.u.sw.ntp,
+               (uint32_t)te.u.sw.wtobjp);
+      break;
+    case CH_TRACE_TYPE_ISR_ENTER:
+    case CH_TRACE_TYPE_ISR_LEAVE:
+      chprintf(chp, "%s", te.u.isr.name);
+      break;
+    case CH_TRACE_TYPE_HALT:
+      chprintf(chp, "%s", te.u.halt.reason);
+      break;
+    case CH_TRACE_TYPE_WAKEUP:
+      chprintf(chp, "tp=%08lx objp=%08lx%s", (uint32_t)te.u.wkp.tp,
+               (uint32_t)te.u.wkp.objp,
+               (te.state & CH_TRACE_WAKEUP_FROM_ISR) != 0U ? " isr" : "");
+      break;
+    default:
+      chprintf(chp, "up1=%08lx up2=%08lx", (uint32_t)te.u.user.up1,
+               (uint32_t)te.u.user.up2);
+      break;
+    }
+    chprintf(chp, SHELL_NEWLINE_STR);
+  }
+}
+#endif
+
+#if (SHELL_CMD_TM_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void cmd_tm(BaseSequentialStream *chp, int argc, char *argv[]) {
+  named_measurement_t *nmp;
+
+  if ((argc == 1) && !strcmp(argv[0], "reset")) {
+    nmp = chTMRegistryFirstX();
+    while (nmp != NULL) {
+      chTMResetNamedX(nmp);
+      nmp = chTMRegistryNextX(nmp);
+    }
+    return;
+  }
+  if (argc > 0) {
+    shellUsage(chp, "tm [reset]");
+    return;
+  }
+  chprintf(chp, "       n     best      p50      p99     p999    worst"
+                " name" SHELL_NEWLINE_STR);
+  nmp = chTMRegistryFirstX();
+  while (nmp != NULL) {
+    tm_summary_t ts;
+
+    chTMGetSummaryX(nmp, &ts);
+    chprintf(chp, "%8lu %8lu %8lu %8lu %8lu %8lu %s" SHELL_NEWLINE_STR,
+             (uint32_t)ts.n, ts.n == (ucnt_t)0 ? 0U : (uint32_t)ts.best,
+             (uint32_t)ts.p50, (uint32_t)ts.p99, (uint32_t)ts.p999,
+             (uint32_t)ts.worst, ts.name);
+    nmp = chTMRegistryNextX(nmp);
+  }
+}
+#endif
+
+#if (SHELL_CMD_PROF_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void cmd_prof(BaseSequentialStream *chp, int argc, char *argv[]) {
+  uint32_t samples, lasthits;
+  unsigned i, n, last;
+
+  if ((argc == 1) && !strcmp(argv[0], "reset")) {
+    prfReset();
+    return;
+  }
+  if (argc > 0) {
+    shellUsage(chp, "prof [reset]");
+    return;
+  }
+  samples = profiler.samples;
+  chprintf(chp, "samples: %lu isr: %lu dropped: %lu" SHELL_NEWLINE_STR,
+           samples, profiler.isr, profiler.dropped);
+  if (samples == 0U) {
+    return;
+  }
+  chprintf(chp, "      pc     hits    %%   thread" SHELL_NEWLINE_STR);
+
+  /* Printing the hottest buckets in decreasing order, each pass selects
+     the bucket following the previous one in (hits, index) order, the
+     table is not locked so the figures are approximate.*/
+  lasthits = 0xFFFFFFFFU;
+  last = PRF_BUCKETS;
+  for (n = 0U; n < SHELL_CMD_PROF_TOP; n++) {
+    uint32_t maxhits = 0U;
+    unsigned max = PRF_BUCKETS;
+
+    for (i = 0U; i < PRF_BUCKETS; i++) {
+      uint32_t hits = profiler.buckets[i].hits;
+
+      if (((hits < lasthits) || ((hits == lasthits) && (i > last))) &&
+          (hits > maxhits)) {
+        maxhits = hits;
+        max = i;
+      }
+    }
+    if (max == PRF_BUCKETS) {
+      break;
+    }
+    chprintf(chp, "%08lx %8lu %3lu%% %08lx" SHELL_NEWLINE_STR,
+             profiler.buckets[max].pc, maxhits,
+             (maxhits * 100U) / samples,
+             (uint32_t)profiler.buckets[max].tp);
+    lasthits = maxhits;
+    last = max;
+  }
+}
+#endif
+
+#if (SHELL_CMD_PERF_ENABLED == TRUE) || defined(__DOXYGEN__)
+static void perf_print(BaseSequentialStream *chp, uint32_t id,
+                       const pmon_counters_t *pcp) {
+
+  chprintf(chp, "%08lx %10lu %10lu %10lu %10lu %10lu",
+           id, (uint32_t)(pcp->cycles / 1000U), pcp->cpi, pcp->lsu,
+           pcp->exc, pcp->sleep);
+#if PMON_USE_ICACHE_MONITORS == TRUE
+  chprintf(chp, " %10lu %10lu", pcp->ichits, pcp->icmisses);
+#endif
+  chprintf(chp, SHELL_NEWLINE_STR);
+}
+
+static void cmd_perf(BaseSequentialStream *chp, int argc, char *argv[]) {
+  pmon_thread_t *ptp;
+  pmon_counters_t pc;
+
+  if ((argc == 1) && !strcmp(argv[0], "reset")) {
+    pmonReset();
+    return;
+  }
+  if (argc > 0) {
+    shellUsage(chp, "perf [reset]");
+    return;
+  }
+  chprintf(chp, "  thread    kcycles        cpi        lsu        exc"
+                "      sleep");
+#if PMON_USE_ICACHE_MONITORS == TRUE
+  chprintf(chp, "     ichits   icmisses");
+#endif
+  chprintf(chp, SHELL_NEWLINE_STR);
+
+  /* The list is not locked while printing, records must not be detached
+     meanwhile.*/
+  for (ptp = perfmon.threads; ptp != NULL; ptp = ptp->next) {
+    pmonGetCounters(ptp, &pc);
+    perf_print(chp, (uint32_t)ptp->tp, &pc);
+  }
+  pmonGetOthers(&pc);
+  perf_print(chp, 0U, &pc);
 }
 #endif
 
@@ -238,6 +648,24 @@ const ShellCommand shell_local_commands[] = {
 #if SHELL_CMD_THREADS_ENABLED == TRUE
   {"threads", cmd_threads},
 #endif
+#if SHELL_CMD_STATS_ENABLED == TRUE
+  {"stats", cmd_stats},
+#endif
+#if SHELL_CMD_TOP_ENABLED == TRUE
+  {"top", cmd_top},
+#endif
+#if SHELL_CMD_TRACE_ENABLED == TRUE
+  {"trace", cmd_trace},
+#endif
+#if SHELL_CMD_TM_ENABLED == TRUE
+  {"tm", cmd_tm},
+#endif
+#if SHELL_CMD_PROF_ENABLED == TRUE
+  {"prof", cmd_prof},
+#endif
+#if SHELL_CMD_PERF_ENABLED == TRUE
+  {"perf", cmd_perf},
+#endif
 #if SHELL_CMD_TEST_ENABLED == TRUE
   {"test", cmd_test},
 #endif
@@ -57,6 +57,38 @@
 #define SHELL_CMD_THREADS_ENABLED           TRUE
 #endif
 
+#if !defined(SHELL_CMD_STATS_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_STATS_ENABLED             FALSE
+#endif
+
+#if !defined(SHELL_CMD_TOP_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_TOP_ENABLED               FALSE
+#endif
+
+#if !defined(SHELL_CMD_TOP_THREADS) || defined(__DOXYGEN__)
+#define SHELL_CMD_TOP_THREADS               16U
+#endif
+
+#if !defined(SHELL_CMD_TRACE_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_TRACE_ENABLED             FALSE
+#endif
+
+#if !defined(SHELL_CMD_TM_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_TM_ENABLED                FALSE
+#endif
+
+#if !defined(SHELL_CMD_PROF_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_PROF_ENABLED              FALSE
+#endif
+
+#if !defined(SHELL_CMD_PROF_TOP) || defined(__DOXYGEN__)
+#define SHELL_CMD_PROF_TOP                  16U
+#endif
+
+#if !defined(SHELL_CMD_PERF_ENABLED) || defined(__DOXYGEN__)
+#define SHELL_CMD_PERF_ENABLED              FALSE
+#endif
+
 #if !defined(SHELL_CMD_TEST_ENABLED) || defined(__DOXYGEN__)
 #define SHELL_CMD_TEST_ENABLED              TRUE
 #endif
@@ -81,6 +113,31 @@
 #error "SHELL_CMD_THREADS_ENABLED requires CH_CFG_USE_REGISTRY"
 #endif
 
+#if (SHELL_CMD_STATS_ENABLED == TRUE) && (CH_CFG_USE_REGISTRY == FALSE)
+#error "SHELL_CMD_STATS_ENABLED requires CH_CFG_USE_REGISTRY"
+#endif
+
+#if (SHELL_CMD_STATS_ENABLED == TRUE) && (CH_DBG_STATISTICS == FALSE)
+#error "SHELL_CMD_STATS_ENABLED requires CH_DBG_STATISTICS"
+#endif
+
+#if (SHELL_CMD_TOP_ENABLED == TRUE) && (CH_CFG_USE_REGISTRY == FALSE)
+#error "SHELL_CMD_TOP_ENABLED requires CH_CFG_USE_REGISTRY"
+#endif
+
+#if (SHELL_CMD_TOP_ENABLED == TRUE) && (CH_DBG_STATISTICS == FALSE)
+#error "SHELL_CMD_TOP_ENABLED requires CH_DBG_STATISTICS"
+#endif
+
+#if (SHELL_CMD_TRACE_ENABLED == TRUE) &&                                    \
+    (CH_DBG_TRACE_MASK == CH_DBG_TRACE_MASK_DISABLED)
+#error "SHELL_CMD_TRACE_ENABLED requires CH_DBG_TRACE_MASK"
+#endif
+
+#if (SHELL_CMD_TM_ENABLED == TRUE) && (CH_CFG_USE_TM_REGISTRY == FALSE)
+#error "SHELL_CMD_TM_ENABLED requires CH_CFG_USE_TM_REGISTRY"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
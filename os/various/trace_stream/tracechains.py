@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+#
+#    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+"""Wakeup chains analyzer for the ChibiOS/RT trace stream.
+
+Reconstructs the wakeup chains from the WAKEUP records of a trace stream,
+an ISR or a thread waking a thread that in turn wakes another thread and
+so on, and prints the latency statistics of each hop and of each chain
+from the first wakeup to the last thread going back to wait.
+
+Usage: tracechains.py [-t <systime bits>] [-b <threads base>]
+                      [-s <threads shift>] [-S] [-f <rt frequency>] [input]
+"""
+
+import argparse
+import sys
+
+import tracedecode
+
+
+class Stats:
+    """Latency statistics accumulator."""
+
+    def __init__(self):
+        self.n = 0
+        self.min = None
+        self.max = 0
+        self.sum = 0
+
+    def add(self, value):
+        self.n += 1
+        self.sum += value
+        self.max = max(self.max, value)
+        self.min = value if self.min is None else min(self.min, value)
+
+
+class Chains:
+    """Wakeup chains tracker."""
+
+    def __init__(self):
+        self.current = None
+        self.isrs = []
+        # Threads woken and not yet running: path, chain start, wakeup time.
+        self.pending = {}
+        # Running or preempted threads belonging to a chain: path, start and
+        # a flag set if the thread propagated the chain waking another one.
+        self.active = {}
+        self.hops = {}
+        self.chains = {}
+
+    def record(self, rec):
+        rtype = rec["type"]
+        if rtype == "LOST":
+            # The sequence of events is broken, chains are restarted.
+            self.pending.clear()
+            self.active.clear()
+            self.isrs = []
+        elif rtype == "ISR_ENTER":
+            self.isrs.append(rec["isr"])
+        elif rtype == "ISR_LEAVE":
+            if self.isrs:
+                self.isrs.pop()
+        elif rtype == "WAKEUP":
+            self.wakeup(rec)
+        elif rtype == "SWITCH":
+            self.switch(rec)
+
+    def wakeup(self, rec):
+        now = rec["rtabs"]
+        if rec["isr"]:
+            isr = self.isrs[-1] if self.isrs else 0
+            path, start = ("isr:%08x" % isr,), now
+        elif self.current in self.active:
+            chain = self.active[self.current]
+            chain[2] = True
+            path, start = chain[0], chain[1]
+        elif self.current is not None:
+            path, start = ("%08x" % self.current,), now
+        else:
+            return
+        self.pending[rec["tp"]] = (path + ("%08x" % rec["tp"],), start, now)
+
+    def switch(self, rec):
+        now = rec["rtabs"]
+        otp, ntp = self.current, rec["ntp"]
+
+        # The outgoing thread going back to wait ends its chain, unless the
+        # chain continues in a thread it woke.
+        if (otp in self.active) and (rec["state"] != 0):
+            path, start, propagated = self.active.pop(otp)
+            if not propagated:
+                self.chains.setdefault(path, Stats()).add(now - start)
+
+        if ntp in self.pending:
+            path, start, woken = self.pending.pop(ntp)
+            self.hops.setdefault(path[-2:], Stats()).add(now - woken)
+            self.active[ntp] = [path, start, False]
+        self.current = ntp
+
+
+def report(title, table, fmt):
+    print(title)
+    for key, st in sorted(table.items(), key=lambda kv: -kv[1].max):
+        print("  %7d %10s %10s %10s  %s" % (st.n, fmt(st.min),
+                                             fmt(st.sum / st.n), fmt(st.max),
+                                             " > ".join(key)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-t", "--tbits", type=int, default=32,
+                        help="system time width in bits (default 32)")
+    parser.add_argument("-b", "--tbase", type=lambda x: int(x, 0),
+                        default=0, help="TRS_THREADS_BASE (default 0)")
+    parser.add_argument("-s", "--tshift", type=int, default=2,
+                        help="TRS_THREADS_SHIFT (default 2)")
+    parser.add_argument("-S", "--synced", action="store_true",
+                        help="input starts on a frame boundary")
+    parser.add_argument("-f", "--freq", type=float, default=0,
+                        help="realtime counter frequency in Hz, latencies "
+                             "are printed in microseconds if specified")
+    parser.add_argument("input", nargs="?", help="input file or device")
+    args = parser.parse_args()
+
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    decoder = tracedecode.Decoder(args.tbits, args.tbase, args.tshift)
+    chains = Chains()
+
+    for frame in tracedecode.frames(stream, args.synced):
+        try:
+            chains.record(decoder.parse(frame))
+        except (ValueError, IndexError):
+            pass
+
+    if args.freq > 0:
+        fmt = lambda v: "%.2f" % (v * 1000000.0 / args.freq)
+        unit = "us"
+    else:
+        fmt = lambda v: "%d" % v
+        unit = "cycles"
+
+    print("        n %10s %10s %10s  (%s)" % ("min", "avg", "max", unit))
+    report("Wakeup to run latency per hop:", chains.hops, fmt)
+    report("End to end latency per chain:", chains.chains, fmt)
+
+
+if __name__ == "__main__":
+    main()
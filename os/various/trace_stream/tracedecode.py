@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+#
+#    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+"""Decoder for the ChibiOS/RT trace stream.
+
+Reads the raw stream produced by tracestream.c from a file, a serial port
+device or the standard input and prints one line for each trace record.
+
+Usage: tracedecode.py [-t <systime bits>] [-b <threads base>]
+                      [-s <threads shift>] [-S] [input]
+"""
+
+import argparse
+import sys
+
+TYPES = {1: "READY", 2: "SWITCH", 3: "ISR_ENTER", 4: "ISR_LEAVE",
+         5: "HALT", 6: "USER", 7: "WAKEUP"}
+
+WAKEUP_FROM_ISR = 16
+
+STATES = ["READY", "CURRENT", "WTSTART", "SUSPENDED", "QUEUED", "WTSEM",
+          "WTMTX", "WTCOND", "SLEEPING", "WTEXIT", "WTOREVT", "WTANDEVT",
+          "SNDMSGQ", "SNDMSG", "WTMSG", "FINAL"]
+
+
+def state_name(state):
+    """Returns the name of a thread state."""
+    return STATES[state] if state < len(STATES) else str(state)
+
+
+def cobs_decode(frame):
+    """Decodes a COBS frame without the zero delimiter."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            raise ValueError("malformed frame")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def get_varint(data, pos):
+    """Decodes a base-128 value, returns the value and the next position."""
+    value = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if b < 0x80:
+            return value, pos
+
+
+def get_svarint(data, pos):
+    """Decodes a zig-zag base-128 value."""
+    value, pos = get_varint(data, pos)
+    return (value >> 1) ^ -(value & 1), pos
+
+
+class Decoder:
+    """Trace stream decoder state."""
+
+    def __init__(self, tbits, tbase, tshift):
+        self.tmask = (1 << tbits) - 1
+        self.tbase = tbase
+        self.tshift = tshift
+        self.time = 0
+        self.rt = 0
+        self.rtabs = 0
+
+    def parse(self, data):
+        """Decodes a single frame, returns a dictionary of the fields.
+
+        The "rtabs" field is the realtime counter not wrapped at 24 bits,
+        it is only meaningful if the gaps between records are shorter than
+        the counter range.
+        """
+        rtype = data[0] & 7
+        state = data[0] >> 3
+        if rtype == 7 and state == 0:
+            lost, _ = get_varint(data, 1)
+            return {"type": "LOST", "lost": lost}
+
+        dtime, pos = get_varint(data, 1)
+        drt, pos = get_varint(data, pos)
+        self.time = (self.time + dtime) & self.tmask
+        self.rt = (self.rt + drt) & 0xFFFFFF
+        self.rtabs += drt
+        rec = {"type": TYPES.get(rtype, "?%d" % rtype), "state": state,
+               "time": self.time, "rt": self.rt, "rtabs": self.rtabs}
+
+        if rtype == 1:
+            tp, pos = get_varint(data, pos)
+            rec["tp"] = self.thread(tp)
+            rec["msg"], pos = get_svarint(data, pos)
+        elif rtype == 2:
+            ntp, pos = get_varint(data, pos)
+            rec["ntp"] = self.thread(ntp)
+            rec["wtobjp"], pos = get_varint(data, pos)
+        elif rtype in (3, 4):
+            rec["isr"], pos = get_varint(data, pos)
+        elif rtype == 5:
+            rec["reason"], pos = get_varint(data, pos)
+        elif rtype == 6:
+            rec["up1"], pos = get_varint(data, pos)
+            rec["up2"], pos = get_varint(data, pos)
+        elif rtype == 7:
+            tp, pos = get_varint(data, pos)
+            rec["tp"] = self.thread(tp)
+            rec["objp"], pos = get_varint(data, pos)
+            rec["isr"] = (state & WAKEUP_FROM_ISR) != 0
+            rec["state"] = state & ~WAKEUP_FROM_ISR
+        return rec
+
+    def record(self, data):
+        """Decodes a single frame, returns a printable line."""
+        rec = self.parse(data)
+        rtype = rec["type"]
+        if rtype == "LOST":
+            return "*** %d records lost" % rec["lost"]
+
+        line = "%10d %08x %-9s" % (rec["time"], rec["rt"], rtype)
+        if rtype == "READY":
+            line += " tp=%08x msg=%d" % (rec["tp"], rec["msg"])
+        elif rtype == "SWITCH":
+            line += " ntp=%08x wtobjp=%08x otp_state=%s" % (
+                rec["ntp"], rec["wtobjp"], state_name(rec["state"]))
+        elif rtype in ("ISR_ENTER", "ISR_LEAVE"):
+            line += " isr=%08x" % rec["isr"]
+        elif rtype == "HALT":
+            line += " reason=%08x" % rec["reason"]
+        elif rtype == "USER":
+            line += " up1=%08x up2=%08x" % (rec["up1"], rec["up2"])
+        elif rtype == "WAKEUP":
+            line += " tp=%08x objp=%08x tp_state=%s waker=%s" % (
+                rec["tp"], rec["objp"], state_name(rec["state"]),
+                "isr" if rec["isr"] else "thread")
+        return line
+
+    def thread(self, value):
+        """Reconstructs a thread pointer from its encoded offset."""
+        return ((value << self.tshift) + self.tbase) & 0xFFFFFFFF
+
+
+def frames(stream, synced):
+    """Yields the COBS frames of a stream, decoded.
+
+    The data preceding the first delimiter is discarded unless the stream
+    is known to start on a frame boundary, the capture could have been
+    started in the middle of a frame. Malformed frames are yielded as
+    they are and fail to parse.
+    """
+    frame = bytearray()
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            break
+        if chunk[0] != 0:
+            frame += chunk
+            continue
+        if synced and frame:
+            try:
+                yield cobs_decode(bytes(frame))
+            except ValueError:
+                yield b""
+        synced = True
+        frame = bytearray()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-t", "--tbits", type=int, default=32,
+                        help="system time width in bits (default 32)")
+    parser.add_argument("-b", "--tbase", type=lambda x: int(x, 0),
+                        default=0, help="TRS_THREADS_BASE (default 0)")
+    parser.add_argument("-s", "--tshift", type=int, default=2,
+                        help="TRS_THREADS_SHIFT (default 2)")
+    parser.add_argument("-S", "--synced", action="store_true",
+                        help="input starts on a frame boundary, use it for "
+                             "ring dumps taken from rdidx")
+    parser.add_argument("input", nargs="?", help="input file or device")
+    args = parser.parse_args()
+
+    stream = open(args.input, "rb") if args.input else sys.stdin.buffer
+    decoder = Decoder(args.tbits, args.tbase, args.tshift)
+
+    for frame in frames(stream, args.synced):
+        try:
+            print(decoder.record(frame))
+        except (ValueError, IndexError):
+            print("*** malformed frame")
+
+
+if __name__ == "__main__":
+    main()
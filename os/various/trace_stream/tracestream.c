@@ -0,0 +1,451 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    tracestream.c
+ * @brief   Trace streaming code.
+ *
+ * @addtogroup trace_stream
+ * @{
+ */
+
+#include "hal.h"
+#include "tracestream.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum size of a frame before encoding.
+ */
+#define TRS_MAX_RAW_SIZE                    (TRS_MAX_FRAME_SIZE - 2U)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Appends an unsigned value using a base-128 variable length
+ *          encoding.
+ *
+ * @param[out] p        pointer to the destination
+ * @param[in] x         value to be encoded
+ * @return              The number of bytes written.
+ */
+static size_t trs_put_varint(uint8_t *p, uint32_t x) {
+  size_t n = 0U;
+
+  while (x >= 0x80U) {
+    p[n++] = (uint8_t)(x | 0x80U);
+    x >>= 7;
+  }
+  p[n++] = (uint8_t)x;
+
+  return n;
+}
+
+/**
+ * @brief   Appends a signed value using a zig-zag base-128 encoding.
+ *
+ * @param[out] p        pointer to the destination
+ * @param[in] x         value to be encoded
+ * @return              The number of bytes written.
+ */
+static size_t trs_put_svarint(uint8_t *p, int32_t x) {
+
+  return trs_put_varint(p, ((uint32_t)x << 1) ^ (uint32_t)(x >> 31));
+}
+
+/**
+ * @brief   Appends a thread reference.
+ *
+ * @param[out] p        pointer to the destination
+ * @param[in] tp        thread pointer to be encoded
+ * @return              The number of bytes written.
+ */
+static size_t trs_put_thread(uint8_t *p, const thread_t *tp) {
+
+  return trs_put_varint(p, ((uint32_t)tp - (uint32_t)TRS_THREADS_BASE) >>
+                           TRS_THREADS_SHIFT);
+}
+
+/**
+ * @brief   COBS encodes a raw frame and appends the zero delimiter.
+ * @note    Raw frames are shorter than 254 bytes so a single code block
+ *          is never split.
+ *
+ * @param[out] dst      pointer to the destination
+ * @param[in] src       pointer to the raw frame
+ * @param[in] n         size of the raw frame
+ * @return              The size of the encoded frame.
+ */
+static size_t trs_cobs_encode(uint8_t *dst, const uint8_t *src, size_t n) {
+  size_t codeidx = 0U, o = 1U, i;
+  uint8_t code = 1U;
+
+  for (i = 0U; i < n; i++) {
+    if (src[i] == 0U) {
+      dst[codeidx] = code;
+      codeidx = o++;
+      code = 1U;
+    }
+    else {
+      dst[o++] = src[i];
+      code++;
+    }
+  }
+  dst[codeidx] = code;
+  dst[o++] = 0U;
+
+  return o;
+}
+
+/**
+ * @brief   Writes an encoded frame in the bytes ring.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[in] raw       pointer to the raw frame
+ * @param[in] n         size of the raw frame
+ * @return              The operation result.
+ * @retval false        if the frame has been written.
+ * @retval true         if there is not enough space in the ring.
+ */
+static bool trs_write_frame(trace_stream_t *tsp, const uint8_t *raw,
+                            size_t n) {
+  uint8_t frame[TRS_MAX_FRAME_SIZE];
+  size_t i, fn;
+
+  fn = trs_cobs_encode(frame, raw, n);
+  while (fn > (tsp->size - tsp->cnt)) {
+    uint8_t b;
+
+    if (!tsp->overwrite) {
+      return true;
+    }
+
+    /* Discarding the oldest frame, the read index stays on a frame
+       boundary.*/
+    do {
+      b = tsp->buffer[tsp->rdidx];
+      if (++tsp->rdidx >= tsp->size) {
+        tsp->rdidx = 0U;
+      }
+      tsp->cnt--;
+    } while (b != 0U);
+  }
+
+  for (i = 0U; i < fn; i++) {
+    tsp->buffer[tsp->wridx] = frame[i];
+    if (++tsp->wridx >= tsp->size) {
+      tsp->wridx = 0U;
+    }
+  }
+  tsp->cnt += fn;
+
+  return false;
+}
+
+#if (TRS_USE_UART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   UART drain thread.
+ *
+ * @param[in] p         pointer to the @p trace_stream_t object
+ */
+static THD_FUNCTION(trs_uart_thread, p) {
+  trace_stream_t *tsp = (trace_stream_t *)p;
+
+  chRegSetThreadName("trace");
+  while (true) {
+    const uint8_t *buf;
+    size_t n;
+
+    chSysLock();
+    n = trsGetDataI(tsp, &buf);
+    chSysUnlock();
+
+    if (n == 0U) {
+      chThdSleep(TRS_UART_POLL_INTERVAL);
+      continue;
+    }
+
+    /* The data is not overwritten until released, the DMA can read it
+       directly from the ring.*/
+    (void) uartSendFullTimeout(tsp->uartp, &n, buf, TIME_INFINITE);
+
+    chSysLock();
+    trsReleaseI(tsp, n);
+    chSysUnlock();
+  }
+}
+#endif /* TRS_USE_UART == TRUE */
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a @p trace_stream_t object.
+ *
+ * @param[out] tsp      pointer to the @p trace_stream_t object
+ * @param[in] buf       pointer to the bytes ring buffer
+ * @param[in] size      size of the bytes ring buffer, it should be large
+ *                      enough for the records generated between two
+ *                      drain operations
+ *
+ * @init
+ */
+void trsObjectInit(trace_stream_t *tsp, uint8_t *buf, size_t size) {
+
+  osalDbgCheck((tsp != NULL) && (buf != NULL) &&
+               (size >= TRS_MAX_FRAME_SIZE));
+
+  tsp->buffer    = buf;
+  tsp->size      = size;
+  tsp->rdidx     = 0U;
+  tsp->wridx     = 0U;
+  tsp->cnt       = 0U;
+  tsp->overwrite = false;
+  tsp->lost      = 0U;
+  tsp->lasttime  = (systime_t)0;
+  tsp->lastrt    = 0U;
+#if TRS_USE_UART == TRUE
+  tsp->uartp     = NULL;
+#endif
+}
+
+/**
+ * @brief   Sets the stream overwrite mode.
+ * @details In overwrite mode the stream works as a flight recorder, when
+ *          the ring is full the oldest frames are discarded and the ring
+ *          always contains the most recent history. The ring content is
+ *          the sequence of @p cnt bytes starting from @p rdidx, it can be
+ *          retrieved using a debugger or drained as usual.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[in] overwrite the new overwrite mode
+ *
+ * @iclass
+ */
+void trsSetOverwriteI(trace_stream_t *tsp, bool overwrite) {
+
+  osalDbgCheckClassI();
+
+  tsp->overwrite = overwrite;
+}
+
+/**
+ * @brief   Encodes a trace record into the stream.
+ * @details The record is encoded as a frame containing an header byte with
+ *          the record type and state, the system time and realtime stamp
+ *          deltas from the previous emitted record and then the record
+ *          payload. If the ring is full then the record is dropped and
+ *          a frame reporting the number of lost records is emitted as soon
+ *          as there is space again.
+ * @note    This function is meant to be invoked from the
+ *          @p CH_CFG_TRACE_HOOK() hook.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[in] tep       pointer to the trace record
+ *
+ * @iclass
+ */
+void trsEncodeI(trace_stream_t *tsp, const trace_event_t *tep) {
+  uint8_t raw[TRS_MAX_RAW_SIZE];
+  uint32_t rt = (uint32_t)tep->rtstamp;
+  size_t n;
+
+  /* Reporting lost records first.*/
+  if (tsp->lost > 0U) {
+    raw[0] = (uint8_t)TRS_TYPE_LOST;
+    n = 1U + trs_put_varint(&raw[1], tsp->lost);
+    if (trs_write_frame(tsp, raw, n)) {
+      tsp->lost++;
+      return;
+    }
+    tsp->lost = 0U;
+  }
+
+  /* Header and time stamps.*/
+  raw[0] = (uint8_t)(tep->type | (tep->state << 3));
+  n = 1U;
+  n += trs_put_varint(&raw[n], (uint32_t)chTimeDiffX(tsp->lasttime,
+                                                     tep->time));
+  n += trs_put_varint(&raw[n], (rt - tsp->lastrt) & 0x00FFFFFFU);
+
+  /* Payload.*/
+  switch (tep->type) {
+  case CH_TRACE_TYPE_READY:
+    n += trs_put_thread(&raw[n], tep->u.rdy.tp);
+    n += trs_put_svarint(&raw[n], (int32_t)tep->u.rdy.msg);
+    break;
+  case CH_TRACE_TYPE_SWITCH:
+    n += trs_put_thread(&raw[n], tep->u.sw.ntp);
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.sw.wtobjp);
+    break;
+  case CH_TRACE_TYPE_ISR_ENTER:
+  case CH_TRACE_TYPE_ISR_LEAVE:
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.isr.name);
+    break;
+  case CH_TRACE_TYPE_HALT:
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.halt.reason);
+    break;
+  case CH_TRACE_TYPE_USER:
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.user.up1);
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.user.up2);
+    break;
+  case CH_TRACE_TYPE_WAKEUP:
+    n += trs_put_thread(&raw[n], tep->u.wkp.tp);
+    n += trs_put_varint(&raw[n], (uint32_t)tep->u.wkp.objp);
+    break;
+  default:
+    break;
+  }
+
+  if (trs_write_frame(tsp, raw, n)) {
+    tsp->lost = 1U;
+    return;
+  }
+
+  /* Time stamps are updated only for emitted records.*/
+  tsp->lasttime = tep->time;
+  tsp->lastrt   = rt;
+}
+
+/**
+ * @brief   Returns the contiguous block of pending stream data.
+ * @details The data remains valid until released using @p trsReleaseI(),
+ *          new records never overwrite it.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[out] bufp     pointer to the start of pending data
+ * @return              The size of the contiguous block.
+ *
+ * @iclass
+ */
+size_t trsGetDataI(trace_stream_t *tsp, const uint8_t **bufp) {
+  size_t n;
+
+  osalDbgCheckClassI();
+
+  n = tsp->size - tsp->rdidx;
+  if (n > tsp->cnt) {
+    n = tsp->cnt;
+  }
+  *bufp = &tsp->buffer[tsp->rdidx];
+
+  return n;
+}
+
+/**
+ * @brief   Releases stream data returned by @p trsGetDataI().
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[in] n         number of bytes to be released
+ *
+ * @iclass
+ */
+void trsReleaseI(trace_stream_t *tsp, size_t n) {
+
+  osalDbgCheckClassI();
+  osalDbgAssert(n <= tsp->cnt, "out of range");
+
+  tsp->cnt   -= n;
+  tsp->rdidx += n;
+  if (tsp->rdidx >= tsp->size) {
+    tsp->rdidx -= tsp->size;
+  }
+}
+
+#if (TRS_USE_ITM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Drains pending stream data through an ITM stimulus port.
+ * @details The function never waits, it writes data as long the ITM
+ *          stimulus port FIFO accepts it. It is meant to be invoked from
+ *          @p CH_CFG_IDLE_LOOP_HOOK() or from a low priority thread.
+ * @note    The ITM stimulus port and the SWO output must be enabled by the
+ *          debugger or by the application.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ *
+ * @api
+ */
+void trsDrainITM(trace_stream_t *tsp) {
+  const uint8_t *buf;
+  size_t n, i;
+
+  if (((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0U) ||
+      ((ITM->TER & (1UL << TRS_ITM_PORT)) == 0U)) {
+    return;
+  }
+
+  osalSysLock();
+  n = trsGetDataI(tsp, &buf);
+  osalSysUnlock();
+
+  i = 0U;
+  while ((i < n) && (ITM->PORT[TRS_ITM_PORT].u32 != 0U)) {
+    ITM->PORT[TRS_ITM_PORT].u8 = buf[i++];
+  }
+
+  osalSysLock();
+  trsReleaseI(tsp, i);
+  osalSysUnlock();
+}
+#endif /* TRS_USE_ITM == TRUE */
+
+#if (TRS_USE_UART == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a thread draining stream data through an UART.
+ * @details Pending data is sent by DMA directly from the ring, the thread
+ *          polls the stream when there is no pending data.
+ * @pre     The UART driver must have been started.
+ * @note    On devices with data cache the ring must be located in a non
+ *          cacheable area.
+ *
+ * @param[in] tsp       pointer to the @p trace_stream_t object
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ * @param[out] wsp      pointer to a working area dedicated to the thread
+ * @param[in] size      size of the working area
+ * @param[in] prio      priority of the thread
+ * @return              The pointer to the drain thread.
+ *
+ * @api
+ */
+thread_t *trsStartUARTDrain(trace_stream_t *tsp, UARTDriver *uartp,
+                            void *wsp, size_t size, tprio_t prio) {
+
+  osalDbgCheck((tsp != NULL) && (uartp != NULL));
+
+  tsp->uartp = uartp;
+
+  return chThdCreateStatic(wsp, size, prio, trs_uart_thread, (void *)tsp);
+}
+#endif /* TRS_USE_UART == TRUE */
+
+/** @} */
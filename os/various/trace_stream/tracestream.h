@@ -0,0 +1,206 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    tracestream.h
+ * @brief   Trace streaming structures and macros.
+ *
+ * @addtogroup trace_stream
+ * @{
+ */
+
+#ifndef TRACESTREAM_H
+#define TRACESTREAM_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Stream record type reporting lost trace records.
+ * @note    This type is only present in the stream, it shares the code of
+ *          the kernel wakeup records with a zero state, wakeup records
+ *          never have a zero state.
+ */
+#define TRS_TYPE_LOST                       7U
+
+/**
+ * @brief   Maximum size of an encoded frame including the delimiter.
+ */
+#define TRS_MAX_FRAME_SIZE                  24U
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Base address of thread pointers.
+ * @details Thread pointers are encoded as offsets from this address scaled
+ *          by the threads alignment, setting it to the start of the RAM
+ *          area holding the threads makes thread references one or two
+ *          bytes long.
+ */
+#if !defined(TRS_THREADS_BASE) || defined(__DOXYGEN__)
+#define TRS_THREADS_BASE                    0U
+#endif
+
+/**
+ * @brief   Alignment of thread structures as a power of two.
+ */
+#if !defined(TRS_THREADS_SHIFT) || defined(__DOXYGEN__)
+#define TRS_THREADS_SHIFT                   2U
+#endif
+
+/**
+ * @brief   Enables the ITM/SWO drain.
+ */
+#if !defined(TRS_USE_ITM) || defined(__DOXYGEN__)
+#define TRS_USE_ITM                         FALSE
+#endif
+
+/**
+ * @brief   ITM stimulus port used by the ITM/SWO drain.
+ */
+#if !defined(TRS_ITM_PORT) || defined(__DOXYGEN__)
+#define TRS_ITM_PORT                        1U
+#endif
+
+/**
+ * @brief   Enables the UART drain.
+ */
+#if !defined(TRS_USE_UART) || defined(__DOXYGEN__)
+#define TRS_USE_UART                        FALSE
+#endif
+
+/**
+ * @brief   Polling interval of the UART drain thread.
+ */
+#if !defined(TRS_UART_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define TRS_UART_POLL_INTERVAL              TIME_MS2I(5)
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if CH_DBG_TRACE_MASK == CH_DBG_TRACE_MASK_DISABLED
+#error "Trace streaming requires CH_DBG_TRACE_MASK"
+#endif
+
+#if (TRS_USE_UART == TRUE) && ((HAL_USE_UART == FALSE) ||                   \
+                               (UART_USE_WAIT == FALSE))
+#error "TRS_USE_UART requires HAL_USE_UART and UART_USE_WAIT"
+#endif
+
+#if (TRS_ITM_PORT < 0) || (TRS_ITM_PORT > 31)
+#error "invalid TRS_ITM_PORT value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a trace stream object.
+ * @details The object encodes trace records into a bytes ring, one frame
+ *          for each record. Frames are COBS encoded and terminated by a
+ *          zero byte so that a decoder can synchronize at any point of the
+ *          stream.
+ */
+typedef struct {
+  /**
+   * @brief   Pointer to the bytes ring.
+   */
+  uint8_t               *buffer;
+  /**
+   * @brief   Size of the bytes ring.
+   */
+  size_t                size;
+  /**
+   * @brief   Read index.
+   */
+  size_t                rdidx;
+  /**
+   * @brief   Write index.
+   */
+  size_t                wridx;
+  /**
+   * @brief   Number of bytes in the ring.
+   */
+  size_t                cnt;
+  /**
+   * @brief   Overwrite mode.
+   * @details In overwrite mode the oldest frames are discarded in order
+   *          to make space for new ones.
+   */
+  bool                  overwrite;
+  /**
+   * @brief   Number of records lost since the last emitted frame.
+   */
+  uint32_t              lost;
+  /**
+   * @brief   System time of the last emitted record.
+   */
+  systime_t             lasttime;
+  /**
+   * @brief   Realtime stamp of the last emitted record.
+   */
+  uint32_t              lastrt;
+#if (TRS_USE_UART == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   UART driver used by the UART drain.
+   */
+  UARTDriver            *uartp;
+#endif
+} trace_stream_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void trsObjectInit(trace_stream_t *tsp, uint8_t *buf, size_t size);
+  void trsSetOverwriteI(trace_stream_t *tsp, bool overwrite);
+  void trsEncodeI(trace_stream_t *tsp, const trace_event_t *tep);
+  size_t trsGetDataI(trace_stream_t *tsp, const uint8_t **bufp);
+  void trsReleaseI(trace_stream_t *tsp, size_t n);
+#if TRS_USE_ITM == TRUE
+  void trsDrainITM(trace_stream_t *tsp);
+#endif
+#if TRS_USE_UART == TRUE
+  thread_t *trsStartUARTDrain(trace_stream_t *tsp, UARTDriver *uartp,
+                              void *wsp, size_t size, tprio_t prio);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* TRACESTREAM_H */
+
+/** @} */
@@ -0,0 +1,8 @@
+# Trace streaming files.
+TRSSRC = $(CHIBIOS)/os/various/trace_stream/tracestream.c
+
+TRSINC = $(CHIBIOS)/os/various/trace_stream
+
+# Shared variables
+ALLCSRC += $(TRSSRC)
+ALLINC  += $(TRSINC)
@@ -0,0 +1,157 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+/*
+ * **** This file incorporates work covered by the following copyright and ****
+ * **** permission notice:                                                 ****
+ *
+ * Copyright (C) 2006-2017 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ *
+ */
+#include "hal.h"
+#include "wolfssl_chibios.h"
+
+#if defined(WOLF_CRYPTO_DEV)
+
+#include "wolfssl/wolfcrypt/aes.h"
+#include "wolfssl/wolfcrypt/cryptodev.h"
+#include "wolfssl/wolfcrypt/error-crypt.h"
+
+/*
+ * Crypto device callbacks on top of the HAL crypto driver.
+ *
+ * AES-GCM record protection is performed by the crypto driver, operations
+ * the driver cannot perform return NOT_COMPILED_IN and wolfSSL falls back
+ * to its software implementation. Hashes are left to software because the
+ * device interface has no hook for releasing per-object driver contexts.
+ * The crypto driver must be started by the application and reserved to
+ * wolfSSL, wolfSSL is configured SINGLE_THREADED.
+ */
+
+/* Builds the GCM J0 block from a 96 bits IV, the only size used by TLS. */
+static int gcm_j0(byte *j0, const byte *iv, word32 ivSz)
+{
+    if (ivSz != GCM_NONCE_MID_SZ)
+        return 0;
+    XMEMCPY(j0, iv, GCM_NONCE_MID_SZ);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+    return 1;
+}
+
+static int aes_gcm_encrypt(CRYDriver *cryp, wc_CryptoInfo *info)
+{
+    static const byte empty[1] = {0};
+    Aes *aes = info->cipher.aesgcm_enc.aes;
+    byte j0[AES_BLOCK_SIZE];
+    cryerror_t err;
+
+    if ((info->cipher.aesgcm_enc.sz == 0) ||
+        !gcm_j0(j0, info->cipher.aesgcm_enc.iv, info->cipher.aesgcm_enc.ivSz))
+        return NOT_COMPILED_IN;
+
+    if (cryLoadAESTransientKey(cryp, aes->keylen,
+                               (const uint8_t *)aes->devKey) != CRY_NOERROR)
+        return NOT_COMPILED_IN;
+
+    err = cryEncryptAES_GCM(cryp, (crykey_t)0,
+                            info->cipher.aesgcm_enc.authInSz,
+                            info->cipher.aesgcm_enc.authIn ?
+                              info->cipher.aesgcm_enc.authIn : empty,
+                            info->cipher.aesgcm_enc.sz,
+                            info->cipher.aesgcm_enc.in,
+                            info->cipher.aesgcm_enc.out,
+                            j0,
+                            info->cipher.aesgcm_enc.authTagSz,
+                            info->cipher.aesgcm_enc.authTag);
+    if (err == CRY_ERR_INV_ALGO)
+        return NOT_COMPILED_IN;
+    return err == CRY_NOERROR ? 0 : WC_HW_E;
+}
+
+static int aes_gcm_decrypt(CRYDriver *cryp, wc_CryptoInfo *info)
+{
+    static const byte empty[1] = {0};
+    Aes *aes = info->cipher.aesgcm_dec.aes;
+    byte j0[AES_BLOCK_SIZE];
+    cryerror_t err;
+
+    if ((info->cipher.aesgcm_dec.sz == 0) ||
+        !gcm_j0(j0, info->cipher.aesgcm_dec.iv, info->cipher.aesgcm_dec.ivSz))
+        return NOT_COMPILED_IN;
+
+    if (cryLoadAESTransientKey(cryp, aes->keylen,
+                               (const uint8_t *)aes->devKey) != CRY_NOERROR)
+        return NOT_COMPILED_IN;
+
+    err = cryDecryptAES_GCM(cryp, (crykey_t)0,
+                            info->cipher.aesgcm_dec.authInSz,
+                            info->cipher.aesgcm_dec.authIn ?
+                              info->cipher.aesgcm_dec.authIn : empty,
+                            info->cipher.aesgcm_dec.sz,
+                            info->cipher.aesgcm_dec.in,
+                            info->cipher.aesgcm_dec.out,
+                            j0,
+                            info->cipher.aesgcm_dec.authTagSz,
+                            info->cipher.aesgcm_dec.authTag);
+    if (err == CRY_ERR_INV_ALGO)
+        return NOT_COMPILED_IN;
+    if (err == CRY_ERR_AUTH_FAILED)
+        return AES_GCM_AUTH_E;
+    return err == CRY_NOERROR ? 0 : WC_HW_E;
+}
+
+static int chibios_cry_cb(int devId, wc_CryptoInfo *info, void *ctx)
+{
+    CRYDriver *cryp = (CRYDriver *)ctx;
+    (void)devId;
+
+    if ((info->algo_type == WC_ALGO_TYPE_CIPHER) &&
+        (info->cipher.type == WC_CIPHER_AES_GCM)) {
+        if (info->cipher.enc)
+            return aes_gcm_encrypt(cryp, info);
+        return aes_gcm_decrypt(cryp, info);
+    }
+
+    return NOT_COMPILED_IN;
+}
+
+/* Registers a started crypto driver as the WOLFSSL_CHIBIOS_DEVID crypto
+   device, contexts created by sslconn_new() use it. */
+int wolfssl_chibios_cry_register(CRYDriver *cryp)
+{
+    return wc_CryptoDev_RegisterDevice(WOLFSSL_CHIBIOS_DEVID,
+                                       chibios_cry_cb, cryp);
+}
+
+#endif /* defined(WOLF_CRYPTO_DEV) */
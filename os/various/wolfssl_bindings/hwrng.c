@@ -41,6 +41,34 @@
 #include "wolfssl_chibios.h"
 #include "user_settings.h"
 
+#if defined(WOLFSSL_CHIBIOS_USE_TRNG)
+#include "hal.h"
+
+/* TRNG driver used as random source, it must be started by the
+   application. */
+#ifndef WOLFSSL_CHIBIOS_TRNG
+#define WOLFSSL_CHIBIOS_TRNG TRNGD1
+#endif
+
+unsigned int chibios_rand_generate(void)
+{
+  unsigned int value = 0;
+
+  (void)custom_rand_generate_block((unsigned char *)&value, sizeof value);
+  return value;
+}
+
+int custom_rand_generate_block(unsigned char* output, unsigned int sz)
+{
+  /* Whole blocks are served by the driver, from its entropy pool when
+     enabled, without going through the software DRBG. */
+  if (trngGenerate(&WOLFSSL_CHIBIOS_TRNG, sz, output))
+    return -1;
+  return 0;
+}
+
+#else /* !defined(WOLFSSL_CHIBIOS_USE_TRNG) */
+
 unsigned int chibios_rand_generate(void)
 {
   static unsigned int last_value=0;
@@ -78,3 +106,4 @@ int custom_rand_generate_block(unsigned char* output, unsigned int sz)
     return 0;
 }
 
+#endif /* !defined(WOLFSSL_CHIBIOS_USE_TRNG) */
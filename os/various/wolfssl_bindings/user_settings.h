@@ -47,9 +47,21 @@
 unsigned int chibios_rand_generate(void);
 int custom_rand_generate_block(unsigned char* output, unsigned int sz);
 
+#if defined(WOLFSSL_CHIBIOS_USE_TRNG)
+/* Random blocks served by the HAL TRNG driver (and its entropy pool). */
+#define CUSTOM_RAND_GENERATE_BLOCK custom_rand_generate_block
+#else
 #define CUSTOM_RAND_GENERATE chibios_rand_generate
+#endif
 #define CUSTOM_RAND_TYPE uint32_t
 
+/* HW crypto support */
+
+#if defined(WOLFSSL_CHIBIOS_USE_CRY)
+/* AES-GCM offloaded to the HAL crypto driver, see hwcrypto.c. */
+#define WOLF_CRYPTO_DEV
+#endif
+
 #define HAVE_ED25519
 #define HAVE_POLY1305
 #define HAVE_SHA512
@@ -62,6 +62,8 @@ sslconn *sslconn_accept(sslconn *sk)
       return NULL;
   new->conn = newconn;
   new->ctx = sk->ctx;
+  new->inbuf = NULL;
+  new->inoff = 0;
   new->ssl = wolfSSL_new(new->ctx);
   wolfSSL_SetIOReadCtx(new->ssl, new);
   wolfSSL_SetIOWriteCtx(new->ssl, new);
@@ -97,6 +99,11 @@ sslconn *sslconn_new(enum netconn_type t, WOLFSSL_METHOD* method)
         goto error;
     wolfSSL_SetIORecv(sk->ctx, wolfssl_recv_cb);
     wolfSSL_SetIOSend(sk->ctx, wolfssl_send_cb);
+#if defined(WOLF_CRYPTO_DEV)
+    /* Symmetric crypto offloaded to the HAL crypto driver, see
+       wolfssl_chibios_cry_register(). */
+    wolfSSL_CTX_SetDevId(sk->ctx, WOLFSSL_CHIBIOS_DEVID);
+#endif
     return sk;
 
 error:
@@ -108,6 +115,8 @@ error:
 
 void sslconn_close(sslconn *sk)
 {
+    if (sk->inbuf)
+        netbuf_delete(sk->inbuf);
     netconn_delete(sk->conn);
     wolfSSL_free(sk->ssl);
     chHeapFree(sk);
@@ -128,55 +137,35 @@ int wolfssl_send_cb(WOLFSSL* ssl, char *buf, int sz, void *ctx)
 }
 
 
-#define MAX_SSL_BUF 1460
-static uint8_t ssl_recv_buffer[MAX_SSL_BUF];
-static int ssl_rb_len = 0;
-static int ssl_rb_off = 0;
-
 int wolfssl_recv_cb(WOLFSSL *ssl, char *buf, int sz, void *ctx)
 {
     sslconn *sk = (sslconn *)ctx;
-    struct netbuf *inbuf = NULL;
-    uint8_t *net_buf;
-    uint16_t buflen;
-    (void)ssl;
+    uint16_t n;
     err_t err;
+    (void)ssl;
 
-    if (ssl_rb_len > 0) {
-        if (sz > ssl_rb_len - ssl_rb_off)
-            sz = ssl_rb_len - ssl_rb_off;
-        memcpy(buf, ssl_recv_buffer + ssl_rb_off, sz);
-        ssl_rb_off += sz;
-        if (ssl_rb_off >= ssl_rb_len) {
-            ssl_rb_len = 0;
-            ssl_rb_off = 0;
+    /* Records are copied straight out of the lwIP buffers, including
+       chained pbufs, a partially consumed netbuf is kept in the connection
+       for the next call. */
+    if (sk->inbuf == NULL) {
+        err = netconn_recv(sk->conn, &sk->inbuf);
+        if (err != ERR_OK) {
+            sk->inbuf = NULL;
+            return 0;
+            //return WOLFSSL_CBIO_ERR_WANT_READ;
         }
-        return sz;
+        sk->inoff = 0;
     }
 
-
-    err = netconn_recv(sk->conn, &inbuf);
-    if (err == ERR_OK) {
-        netbuf_data(inbuf, (void **)&net_buf, &buflen);
-        ssl_rb_len = buflen;
-        if (ssl_rb_len > MAX_SSL_BUF)
-            ssl_rb_len = MAX_SSL_BUF;
-        memcpy(ssl_recv_buffer, net_buf, ssl_rb_len);
-        ssl_rb_off = 0;
-        if (sz > ssl_rb_len)
-            sz = ssl_rb_len;
-        memcpy(buf, ssl_recv_buffer, sz);
-        ssl_rb_off += sz;
-        if (ssl_rb_off >= ssl_rb_len) {
-            ssl_rb_len = 0;
-            ssl_rb_off = 0;
-        }
-        netbuf_delete(inbuf);
-        return sz;
+    if (sz > 0xFFFF)
+        sz = 0xFFFF;
+    n = netbuf_copy_partial(sk->inbuf, buf, (uint16_t)sz, sk->inoff);
+    sk->inoff += n;
+    if (sk->inoff >= netbuf_len(sk->inbuf)) {
+        netbuf_delete(sk->inbuf);
+        sk->inbuf = NULL;
     }
-    else
-        return 0;
-    //return WOLFSSL_CBIO_ERR_WANT_READ;
+    return n;
 }
 
 #ifndef ST2S
@@ -48,10 +48,18 @@
 #define XMALLOC(s,h,t) chibios_alloc(h,s)
 #define XFREE(p,h,t)   chibios_free(p)
 
+/* Crypto device identifier of the HAL crypto driver. */
+#ifndef WOLFSSL_CHIBIOS_DEVID
+#define WOLFSSL_CHIBIOS_DEVID 1
+#endif
+
 struct sslconn {
     WOLFSSL_CTX *ctx;
     WOLFSSL *ssl;
     struct netconn *conn;
+    /* Partially consumed receive buffer. */
+    struct netbuf *inbuf;
+    uint16_t inoff;
 };
 
 typedef struct sslconn sslconn;
@@ -63,6 +71,11 @@ void sslconn_close(sslconn *sk);
 int wolfssl_send_cb(WOLFSSL* ssl, char *buf, int sz, void *ctx);
 int wolfssl_recv_cb(WOLFSSL *ssl, char *buf, int sz, void *ctx);
 
+#if defined(WOLF_CRYPTO_DEV)
+struct CRYDriver;
+int wolfssl_chibios_cry_register(struct CRYDriver *cryp);
+#endif
+
 void *chibios_alloc(void *heap, int size);
 void chibios_free(void *ptr);
 word32 LowResTimer(void);
@@ -0,0 +1,5 @@
+# List of all the ChibiOS/RT benchmark files.
+TESTSRC += ${CHIBIOS}/test/bench/source/bench.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/bench/source
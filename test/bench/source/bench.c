@@ -0,0 +1,859 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    bench.c
+ * @brief   Kernel benchmarks code.
+ * @details Each benchmark repeats an operation for @p BMK_CFG_DURATION
+ *          milliseconds, the results are emitted in a machine-readable
+ *          format in order to be compared across releases and boards.
+ *
+ * @addtogroup BENCH
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "bench.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of benchmark threads.
+ */
+#define BMK_MAX_THREADS             4
+
+/**
+ * @brief   Working area size of the benchmark threads.
+ */
+#define BMK_WA_SIZE MEM_ALIGN_NEXT(THD_WORKING_AREA_SIZE(BMK_CFG_STACK_SIZE), \
+                                   PORT_WORKING_AREA_ALIGN)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a benchmark descriptor.
+ */
+typedef struct {
+  const char            *name;          /**< @brief Result name.            */
+  const char            *unit;          /**< @brief Result unit.            */
+  uint32_t              (*execute)(void); /**< @brief Benchmark function,
+                                               returns the number of
+                                               operations performed.        */
+} bmk_benchmark_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static BaseSequentialStream *bmk_chp;
+static bmk_format_t bmk_format;
+static bool bmk_first;
+static const uint8_t *bmk_replay_seq;
+static size_t bmk_replay_n;
+
+static ALIGNED_VAR(PORT_WORKING_AREA_ALIGN)
+  uint8_t bmk_buffer[BMK_WA_SIZE * BMK_MAX_THREADS];
+static thread_t *bmk_threads[BMK_MAX_THREADS];
+
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+static semaphore_t bmk_sem;
+#endif
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+static mutex_t bmk_mtx;
+#endif
+#if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
+static event_source_t bmk_es;
+#endif
+#if (CH_CFG_USE_MAILBOXES == TRUE) || defined(__DOXYGEN__)
+static mailbox_t bmk_mb;
+static msg_t bmk_mb_buffer[4];
+#endif
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+static memory_pool_t bmk_mp;
+static ALIGNED_VAR(PORT_NATURAL_ALIGN) uint8_t bmk_mp_buffer[4][32];
+#endif
+#if (CH_CFG_USE_HEAP == TRUE) || defined(__DOXYGEN__)
+static memory_heap_t bmk_heap;
+static ALIGNED_VAR(CH_HEAP_ALIGNMENT) uint8_t bmk_heap_buffer[256];
+#endif
+#if (CH_CFG_USE_PIPES == TRUE) || defined(__DOXYGEN__)
+static uint8_t bmk_pipe_buffer[32];
+static PIPE_DECL(bmk_pipe, bmk_pipe_buffer, sizeof (bmk_pipe_buffer));
+#endif
+#if (CH_CFG_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+static jobs_queue_t bmk_jq;
+static job_descriptor_t bmk_jobs[4];
+static msg_t bmk_jobs_msgs[4];
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void bmk_print(const char *msgp) {
+
+  while (*msgp != '\0') {
+    streamPut(bmk_chp, (uint8_t)*msgp++);
+  }
+}
+
+static void bmk_print_string(const char *msgp) {
+
+  streamPut(bmk_chp, (uint8_t)'"');
+  while (*msgp != '\0') {
+    if ((*msgp == '"') || (*msgp == '\\')) {
+      streamPut(bmk_chp, (uint8_t)'\\');
+    }
+    streamPut(bmk_chp, (uint8_t)*msgp++);
+  }
+  streamPut(bmk_chp, (uint8_t)'"');
+}
+
+static void bmk_printn(uint32_t n) {
+  char buf[16], *p;
+
+  p = buf;
+  do {
+    *p++ = (char)((n % 10U) + (uint32_t)'0');
+    n /= 10U;
+  } while (n > 0U);
+  while (p > buf) {
+    streamPut(bmk_chp, (uint8_t)*--p);
+  }
+}
+
+static void bmk_info(const char *name, const char *value) {
+
+  if (bmk_format == BMK_FORMAT_JSON) {
+    bmk_print(bmk_first ? "  " : ",\r\n  ");
+    bmk_print_string(name);
+    bmk_print(": ");
+    bmk_print_string(value);
+  }
+  else {
+    bmk_print(name);
+    bmk_print(",");
+    bmk_print(value);
+#if defined(BMK_CFG_INSTR_COUNTER)
+    bmk_print(",,\r\n");
+#else
+    bmk_print(",\r\n");
+#endif
+  }
+  bmk_first = false;
+}
+
+/*
+ * Emits a result, the instructions per operation are only emitted if
+ * not zero.
+ */
+static void bmk_result(const char *name, uint32_t value, const char *unit,
+                       uint32_t instr) {
+
+  if (bmk_format == BMK_FORMAT_JSON) {
+    bmk_print(bmk_first ? "    {\"name\": " : ",\r\n    {\"name\": ");
+    bmk_print_string(name);
+    bmk_print(", \"value\": ");
+    bmk_printn(value);
+    bmk_print(", \"unit\": ");
+    bmk_print_string(unit);
+    if (instr > 0U) {
+      bmk_print(", \"instr\": ");
+      bmk_printn(instr);
+    }
+    bmk_print("}");
+  }
+  else {
+    bmk_print(name);
+    bmk_print(",");
+    bmk_printn(value);
+    bmk_print(",");
+    bmk_print(unit);
+#if defined(BMK_CFG_INSTR_COUNTER)
+    bmk_print(",");
+    if (instr > 0U) {
+      bmk_printn(instr);
+    }
+#endif
+    bmk_print("\r\n");
+  }
+  bmk_first = false;
+}
+
+static void bmk_header(BaseSequentialStream *stream, bmk_format_t format) {
+
+  bmk_chp    = stream;
+  bmk_format = format;
+
+  /* System information.*/
+  bmk_first  = true;
+  if (format == BMK_FORMAT_JSON) {
+    bmk_print("{\r\n");
+  }
+  else {
+#if defined(BMK_CFG_INSTR_COUNTER)
+    bmk_print("name,value,unit,instr\r\n");
+#else
+    bmk_print("name,value,unit\r\n");
+#endif
+  }
+  bmk_info("kernel", CH_KERNEL_VERSION);
+#if defined(PORT_ARCHITECTURE_NAME)
+  bmk_info("architecture", PORT_ARCHITECTURE_NAME);
+#endif
+#if defined(PORT_CORE_VARIANT_NAME)
+  bmk_info("core", PORT_CORE_VARIANT_NAME);
+#endif
+#if defined(PORT_COMPILER_NAME)
+  bmk_info("compiler", PORT_COMPILER_NAME);
+#endif
+#if defined(PORT_INFO)
+  bmk_info("port", PORT_INFO);
+#endif
+
+  /* Results.*/
+  if (format == BMK_FORMAT_JSON) {
+    bmk_print(",\r\n  \"results\": [\r\n");
+  }
+  bmk_first = true;
+}
+
+static void bmk_footer(void) {
+
+  if (bmk_format == BMK_FORMAT_JSON) {
+    bmk_print("\r\n  ]\r\n}\r\n");
+  }
+}
+
+static void *bmk_wa(unsigned i) {
+
+  return (void *)&bmk_buffer[BMK_WA_SIZE * i];
+}
+
+static void bmk_wait_threads(void) {
+  unsigned i;
+
+  for (i = 0U; i < BMK_MAX_THREADS; i++) {
+    if (bmk_threads[i] != NULL) {
+      chThdWait(bmk_threads[i]);
+      bmk_threads[i] = NULL;
+    }
+  }
+}
+
+/*
+ * Delays execution until next system time tick then returns the end of
+ * the measurement window.
+ */
+static systime_t bmk_start(systime_t *startp) {
+
+  chThdSleep((sysinterval_t)1);
+  *startp = chVTGetSystemTime();
+  return chTimeAddX(*startp, TIME_MS2I(BMK_CFG_DURATION));
+}
+
+static inline bool bmk_running(systime_t start, systime_t end) {
+
+#if defined(SIMULATOR)
+  _sim_check_for_interrupts();
+#endif
+  return chVTIsSystemTimeWithinX(start, end);
+}
+
+/*
+ * Benchmark threads.
+ */
+
+static THD_FUNCTION(bmk_thread_exit, p) {
+
+  chThdExit((msg_t)p);
+}
+
+static THD_FUNCTION(bmk_thread_suspend, p) {
+  msg_t msg;
+  thread_t *self = chThdGetSelfX();
+
+  (void)p;
+  chSysLock();
+  do {
+    chSchGoSleepS(CH_STATE_SUSPENDED);
+    msg = self->u.rdymsg;
+  } while (msg == MSG_OK);
+  chSysUnlock();
+}
+
+static THD_FUNCTION(bmk_thread_yield, p) {
+
+  do {
+    chThdYield();
+    chThdYield();
+    chThdYield();
+    chThdYield();
+    (*(uint32_t *)p) += 4U;
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  } while (!chThdShouldTerminateX());
+}
+
+#if (CH_CFG_USE_MESSAGES == TRUE) || defined(__DOXYGEN__)
+static THD_FUNCTION(bmk_thread_msg, p) {
+  thread_t *tp;
+  msg_t msg;
+
+  (void)p;
+  do {
+    tp = chMsgWait();
+    msg = chMsgGet(tp);
+    chMsgRelease(tp, msg);
+  } while (msg != (msg_t)0);
+}
+#endif
+
+#if (CH_CFG_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+static THD_FUNCTION(bmk_thread_jobs, p) {
+
+  (void)p;
+  while (chJobDispatch(&bmk_jq) == MSG_OK) {
+  }
+}
+
+static void bmk_job(void *arg) {
+
+  (void)arg;
+}
+#endif
+
+#if (CH_CFG_USE_DELEGATES == TRUE) || defined(__DOXYGEN__)
+static THD_FUNCTION(bmk_thread_delegates, p) {
+
+  (void)p;
+  do {
+    chDelegateDispatch();
+  } while (!chThdShouldTerminateX());
+}
+
+static msg_t bmk_delegate(void) {
+
+  return MSG_OK;
+}
+#endif
+
+static THD_FUNCTION(bmk_thread_replay, p) {
+  thread_t *self = chThdGetSelfX();
+
+  (void)p;
+  chSysLock();
+  do {
+    chSchGoSleepS(CH_STATE_SUSPENDED);
+  } while (self->u.rdymsg == MSG_OK);
+  chSysUnlock();
+}
+
+static void bmk_tmo(void *param) {
+
+  (void)param;
+}
+
+/*
+ * Benchmarks.
+ */
+
+#if (CH_CFG_USE_MESSAGES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_msg_loop(tprio_t prio) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  bmk_threads[0] = chThdCreateStatic(bmk_wa(0U), BMK_WA_SIZE, prio,
+                                     bmk_thread_msg, NULL);
+  end = bmk_start(&start);
+  do {
+    (void)chMsgSend(bmk_threads[0], (msg_t)1);
+    n++;
+  } while (bmk_running(start, end));
+  (void)chMsgSend(bmk_threads[0], (msg_t)0);
+  bmk_wait_threads();
+
+  return n;
+}
+
+static uint32_t bmk_run_msg_higher(void) {
+
+  return bmk_run_msg_loop(chThdGetPriorityX() + 1);
+}
+
+static uint32_t bmk_run_msg_lower(void) {
+
+  return bmk_run_msg_loop(chThdGetPriorityX() - 1);
+}
+#endif
+
+static uint32_t bmk_run_ctxswc(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  bmk_threads[0] = chThdCreateStatic(bmk_wa(0U), BMK_WA_SIZE,
+                                     chThdGetPriorityX() + 1,
+                                     bmk_thread_suspend, NULL);
+  end = bmk_start(&start);
+  do {
+    chSysLock();
+    chSchWakeupS(bmk_threads[0], MSG_OK);
+    chSysUnlock();
+    n += 2U;
+  } while (bmk_running(start, end));
+  chSysLock();
+  chSchWakeupS(bmk_threads[0], MSG_TIMEOUT);
+  chSysUnlock();
+  bmk_wait_threads();
+
+  return n;
+}
+
+static uint32_t bmk_run_threads_cycle(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  tprio_t prio = chThdGetPriorityX() + 1;
+
+  end = bmk_start(&start);
+  do {
+    chThdWait(chThdCreateStatic(bmk_wa(0U), BMK_WA_SIZE, prio,
+                                bmk_thread_exit, NULL));
+    n++;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+
+static uint32_t bmk_run_threads_yield(void) {
+  uint32_t n = 0U;
+  unsigned i;
+  tprio_t prio = chThdGetPriorityX() - 1;
+
+  for (i = 0U; i < BMK_MAX_THREADS; i++) {
+    bmk_threads[i] = chThdCreateStatic(bmk_wa(i), BMK_WA_SIZE, prio,
+                                       bmk_thread_yield, (void *)&n);
+  }
+  chThdSleepMilliseconds(BMK_CFG_DURATION);
+  for (i = 0U; i < BMK_MAX_THREADS; i++) {
+    chThdTerminate(bmk_threads[i]);
+  }
+  bmk_wait_threads();
+
+  return n;
+}
+
+static uint32_t bmk_run_vt(void) {
+  static virtual_timer_t vt1, vt2;
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chVTObjectInit(&vt1);
+  chVTObjectInit(&vt2);
+  end = bmk_start(&start);
+  do {
+    chSysLock();
+    chVTDoSetI(&vt1, (sysinterval_t)1, bmk_tmo, NULL);
+    chVTDoSetI(&vt2, (sysinterval_t)10000, bmk_tmo, NULL);
+    chVTDoResetI(&vt1);
+    chVTDoResetI(&vt2);
+    chSysUnlock();
+    n += 2U;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+
+#if (CH_CFG_USE_SEMAPHORES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_sem(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chSemObjectInit(&bmk_sem, 1);
+  end = bmk_start(&start);
+  do {
+    (void)chSemWait(&bmk_sem);
+    chSemSignal(&bmk_sem);
+    (void)chSemWait(&bmk_sem);
+    chSemSignal(&bmk_sem);
+    n += 2U;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_mtx(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chMtxObjectInit(&bmk_mtx);
+  end = bmk_start(&start);
+  do {
+    chMtxLock(&bmk_mtx);
+    chMtxUnlock(&bmk_mtx);
+    chMtxLock(&bmk_mtx);
+    chMtxUnlock(&bmk_mtx);
+    n += 2U;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_EVENTS == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_events(void) {
+  event_listener_t el;
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chEvtObjectInit(&bmk_es);
+  chEvtRegisterMask(&bmk_es, &el, EVENT_MASK(0));
+  end = bmk_start(&start);
+  do {
+    chEvtBroadcast(&bmk_es);
+    (void)chEvtWaitAny(EVENT_MASK(0));
+    n++;
+  } while (bmk_running(start, end));
+  chEvtUnregister(&bmk_es, &el);
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_MAILBOXES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_mailboxes(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  msg_t msg;
+
+  chMBObjectInit(&bmk_mb, bmk_mb_buffer, 4U);
+  end = bmk_start(&start);
+  do {
+    (void)chMBPostTimeout(&bmk_mb, (msg_t)1, TIME_IMMEDIATE);
+    (void)chMBFetchTimeout(&bmk_mb, &msg, TIME_IMMEDIATE);
+    n++;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_PIPES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_pipes(void) {
+  static uint8_t buf[16];
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chPipeReset(&bmk_pipe);
+  chPipeResume(&bmk_pipe);
+  end = bmk_start(&start);
+  do {
+    (void)chPipeWriteTimeout(&bmk_pipe, buf, sizeof (buf), TIME_IMMEDIATE);
+    (void)chPipeReadTimeout(&bmk_pipe, buf, sizeof (buf), TIME_IMMEDIATE);
+    n++;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_MEMPOOLS == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_pools(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chPoolObjectInit(&bmk_mp, sizeof (bmk_mp_buffer[0]), NULL);
+  chPoolLoadArray(&bmk_mp, bmk_mp_buffer, 4U);
+  end = bmk_start(&start);
+  do {
+    chPoolFree(&bmk_mp, chPoolAlloc(&bmk_mp));
+    chPoolFree(&bmk_mp, chPoolAlloc(&bmk_mp));
+    n += 2U;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_HEAP == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_heap(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  chHeapObjectInit(&bmk_heap, bmk_heap_buffer, sizeof (bmk_heap_buffer));
+  end = bmk_start(&start);
+  do {
+    chHeapFree(chHeapAlloc(&bmk_heap, 32U));
+    chHeapFree(chHeapAlloc(&bmk_heap, 32U));
+    n += 2U;
+  } while (bmk_running(start, end));
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_jobs_post(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  job_descriptor_t *jp;
+
+  chJobObjectInit(&bmk_jq, 4U, bmk_jobs, bmk_jobs_msgs);
+  bmk_threads[0] = chThdCreateStatic(bmk_wa(0U), BMK_WA_SIZE,
+                                     chThdGetPriorityX() + 1,
+                                     bmk_thread_jobs, NULL);
+  end = bmk_start(&start);
+  do {
+    jp = chJobGet(&bmk_jq);
+    jp->jobfunc = bmk_job;
+    jp->jobarg  = NULL;
+    chJobPost(&bmk_jq, jp);
+    n++;
+  } while (bmk_running(start, end));
+
+  /* A null job terminates the dispatcher.*/
+  jp = chJobGet(&bmk_jq);
+  jp->jobfunc = NULL;
+  chJobPost(&bmk_jq, jp);
+  bmk_wait_threads();
+
+  return n;
+}
+#endif
+
+#if (CH_CFG_USE_DELEGATES == TRUE) || defined(__DOXYGEN__)
+static uint32_t bmk_run_delegates(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  bmk_threads[0] = chThdCreateStatic(bmk_wa(0U), BMK_WA_SIZE,
+                                     chThdGetPriorityX() + 1,
+                                     bmk_thread_delegates, NULL);
+  end = bmk_start(&start);
+  do {
+    (void)chDelegateCallDirect0(bmk_threads[0], bmk_delegate);
+    n++;
+  } while (bmk_running(start, end));
+
+  /* The last call lets the dispatcher check the termination request.*/
+  chThdTerminate(bmk_threads[0]);
+  (void)chDelegateCallDirect0(bmk_threads[0], bmk_delegate);
+  bmk_wait_threads();
+
+  return n;
+}
+#endif
+
+/*
+ * Replays the scheduling events of a sequence, ready events insert the
+ * thread in the ready list, switch events also reschedule so all the
+ * ready threads run once before returning to the replaying thread.
+ */
+static uint32_t bmk_run_replay(void) {
+  systime_t start, end;
+  uint32_t n = 0U;
+  size_t i = 0U;
+  unsigned j;
+
+  for (j = 0U; j < BMK_REPLAY_THREADS; j++) {
+    bmk_threads[j] = chThdCreateStatic(bmk_wa(j), BMK_WA_SIZE,
+                                       chThdGetPriorityX() + 1,
+                                       bmk_thread_replay, NULL);
+  }
+  end = bmk_start(&start);
+  do {
+    uint8_t ev = bmk_replay_seq[i];
+    thread_t *tp = bmk_threads[(ev & ~BMK_REPLAY_SWITCH) % BMK_REPLAY_THREADS];
+
+    chSysLock();
+    if (tp->state == CH_STATE_SUSPENDED) {
+      tp->u.rdymsg = MSG_OK;
+      (void)chSchReadyI(tp);
+    }
+    if ((ev & BMK_REPLAY_SWITCH) != 0U) {
+      chSchRescheduleS();
+    }
+    chSysUnlock();
+    n++;
+    if (++i >= bmk_replay_n) {
+      i = 0U;
+    }
+  } while (bmk_running(start, end));
+
+  /* Letting the threads still ready run then terminating all of them.*/
+  chSysLock();
+  chSchRescheduleS();
+  for (j = 0U; j < BMK_REPLAY_THREADS; j++) {
+    chSchWakeupS(bmk_threads[j], MSG_TIMEOUT);
+  }
+  chSysUnlock();
+  bmk_wait_threads();
+
+  return n;
+}
+
+/**
+ * @brief   Benchmarks table.
+ */
+static const bmk_benchmark_t bmk_benchmarks[] = {
+#if CH_CFG_USE_MESSAGES == TRUE
+  {"msg.send.higher",   "msgs/s",     bmk_run_msg_higher},
+  {"msg.send.lower",    "msgs/s",     bmk_run_msg_lower},
+#endif
+  {"thd.wakeup",        "ctxswc/s",   bmk_run_ctxswc},
+  {"thd.cycle",         "threads/s",  bmk_run_threads_cycle},
+  {"thd.yield",         "ctxswc/s",   bmk_run_threads_yield},
+  {"vt.setreset",       "timers/s",   bmk_run_vt},
+#if CH_CFG_USE_SEMAPHORES == TRUE
+  {"sem.waitsignal",    "ops/s",      bmk_run_sem},
+#endif
+#if CH_CFG_USE_MUTEXES == TRUE
+  {"mtx.lockunlock",    "ops/s",      bmk_run_mtx},
+#endif
+#if CH_CFG_USE_EVENTS == TRUE
+  {"evt.broadcastwait", "ops/s",      bmk_run_events},
+#endif
+#if CH_CFG_USE_MAILBOXES == TRUE
+  {"mbx.postfetch",     "ops/s",      bmk_run_mailboxes},
+#endif
+#if CH_CFG_USE_PIPES == TRUE
+  {"pipe.writeread16",  "ops/s",      bmk_run_pipes},
+#endif
+#if CH_CFG_USE_MEMPOOLS == TRUE
+  {"pool.allocfree",    "ops/s",      bmk_run_pools},
+#endif
+#if CH_CFG_USE_HEAP == TRUE
+  {"heap.allocfree",    "ops/s",      bmk_run_heap},
+#endif
+#if CH_CFG_USE_JOBS == TRUE
+  {"jobs.post",         "jobs/s",     bmk_run_jobs_post},
+#endif
+#if CH_CFG_USE_DELEGATES == TRUE
+  {"delegate.call",     "calls/s",    bmk_run_delegates},
+#endif
+};
+
+static void bmk_execute(const bmk_benchmark_t *bp) {
+  uint32_t n, instr = 0U;
+#if defined(BMK_CFG_INSTR_COUNTER)
+  uint64_t i0 = BMK_CFG_INSTR_COUNTER();
+#endif
+
+  n = bp->execute();
+#if defined(BMK_CFG_INSTR_COUNTER)
+  if ((i0 > 0U) && (n > 0U)) {
+    instr = (uint32_t)((BMK_CFG_INSTR_COUNTER() - i0) / (uint64_t)n);
+  }
+#endif
+  bmk_result(bp->name,
+             (uint32_t)(((uint64_t)n * 1000U) / (uint64_t)BMK_CFG_DURATION),
+             bp->unit, instr);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Runs all the benchmarks.
+ * @details The results are emitted on the specified stream, in CSV format
+ *          each result is a "name,value,unit" line, in JSON format a single
+ *          object is emitted containing the system information and an
+ *          array of results.
+ * @note    The calling thread priority must allow for threads one priority
+ *          level above and below it.
+ *
+ * @param[in] stream    pointer to a @p BaseSequentialStream object
+ * @param[in] format    the output format
+ *
+ * @api
+ */
+void bmkExecute(BaseSequentialStream *stream, bmk_format_t format) {
+  unsigned i;
+
+  bmk_header(stream, format);
+  for (i = 0U; i < sizeof (bmk_benchmarks) / sizeof (bmk_benchmarks[0]); i++) {
+    bmk_execute(&bmk_benchmarks[i]);
+  }
+
+  /* RAM footprint of the kernel objects.*/
+  bmk_result("size.os_instance", (uint32_t)sizeof (os_instance_t),
+             "bytes", 0U);
+  bmk_result("size.thread", (uint32_t)sizeof (thread_t), "bytes", 0U);
+  bmk_result("size.virtual_timer", (uint32_t)sizeof (virtual_timer_t),
+             "bytes", 0U);
+#if CH_CFG_USE_SEMAPHORES == TRUE
+  bmk_result("size.semaphore", (uint32_t)sizeof (semaphore_t),
+             "bytes", 0U);
+#endif
+#if CH_CFG_USE_MUTEXES == TRUE
+  bmk_result("size.mutex", (uint32_t)sizeof (mutex_t), "bytes", 0U);
+#endif
+#if CH_CFG_USE_EVENTS == TRUE
+  bmk_result("size.event_source", (uint32_t)sizeof (event_source_t),
+             "bytes", 0U);
+#endif
+#if CH_CFG_USE_MAILBOXES == TRUE
+  bmk_result("size.mailbox", (uint32_t)sizeof (mailbox_t), "bytes", 0U);
+#endif
+
+  bmk_footer();
+}
+
+/**
+ * @brief   Replays a sequence of scheduling events.
+ * @details The sequence is repeated for @p BMK_CFG_DURATION milliseconds
+ *          and the number of replayed events per second is emitted as
+ *          the "replay.events" result. Sequences are usually obtained
+ *          from a recorded trace buffer, see the simulator test build.
+ * @note    The calling thread priority must allow for threads one priority
+ *          level above it.
+ *
+ * @param[in] stream    pointer to a @p BaseSequentialStream object
+ * @param[in] format    the output format
+ * @param[in] seq       the events sequence, each element is a thread index
+ *                      optionally ORed with @p BMK_REPLAY_SWITCH
+ * @param[in] n         number of elements in the sequence
+ *
+ * @api
+ */
+void bmkReplay(BaseSequentialStream *stream, bmk_format_t format,
+               const uint8_t *seq, size_t n) {
+  static const bmk_benchmark_t replay = {
+    "replay.events", "events/s", bmk_run_replay
+  };
+
+  chDbgCheck((seq != NULL) && (n > 0U));
+
+  bmk_replay_seq = seq;
+  bmk_replay_n   = n;
+  bmk_header(stream, format);
+  bmk_execute(&replay);
+  bmk_footer();
+}
+
+/** @} */
@@ -0,0 +1,132 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    bench.h
+ * @brief   Kernel benchmarks header.
+ *
+ * @addtogroup BENCH
+ * @{
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Replay sequence encoding
+ * @{
+ */
+/**
+ * @brief   Number of threads available to a replay sequence.
+ * @note    The low bits of each sequence element are the thread index.
+ */
+#define BMK_REPLAY_THREADS                  4U
+
+/**
+ * @brief   The event is a switch to the thread rather than a ready event.
+ */
+#define BMK_REPLAY_SWITCH                   0x80U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Duration of each benchmark in milliseconds.
+ */
+#if !defined(BMK_CFG_DURATION) || defined(__DOXYGEN__)
+#define BMK_CFG_DURATION                    1000
+#endif
+
+/**
+ * @brief   Stack size of the benchmark threads.
+ */
+#if !defined(BMK_CFG_STACK_SIZE) || defined(__DOXYGEN__)
+#if defined(PORT_ARCHITECTURE_SIMIA32)
+#define BMK_CFG_STACK_SIZE                  512
+#else
+#define BMK_CFG_STACK_SIZE                  128
+#endif
+#endif
+
+/**
+ * @brief   Instructions counter function.
+ * @details If defined then it is the name of a <tt>uint64_t f(void)</tt>
+ *          function returning the number of instructions executed so far,
+ *          the average instructions per operation are reported with each
+ *          result. The function returns zero if the counter is not
+ *          available.
+ * @note    The count includes the benchmark loop overhead and the
+ *          instructions executed while waiting for the first tick.
+ */
+#if defined(__DOXYGEN__)
+#define BMK_CFG_INSTR_COUNTER               bmk_instr_counter
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if BMK_CFG_DURATION < 100
+#error "invalid BMK_CFG_DURATION value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Output formats.
+ */
+typedef enum {
+  BMK_FORMAT_CSV = 0,                   /**< One "name,value,unit" line for
+                                             each result.                   */
+  BMK_FORMAT_JSON = 1                   /**< A single JSON object.          */
+} bmk_format_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void bmkExecute(BaseSequentialStream *stream, bmk_format_t format);
+  void bmkReplay(BaseSequentialStream *stream, bmk_format_t format,
+                 const uint8_t *seq, size_t n);
+#if defined(BMK_CFG_INSTR_COUNTER)
+  uint64_t BMK_CFG_INSTR_COUNTER(void);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* BENCH_H */
+
+/** @} */
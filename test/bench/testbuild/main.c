@@ -0,0 +1,166 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "ch.h"
+#include "hal.h"
+#include "bench.h"
+#include "console.h"
+
+/*
+ * Size of a trace record and offset of the thread pointer as recorded on
+ * 32 bits targets.
+ */
+#define TRACE_RECORD_SIZE       16U
+#define TRACE_RECORD_TP         8U
+
+/*
+ * Maximum number of replayed events.
+ */
+#define REPLAY_MAX_EVENTS       4096U
+
+static uint8_t replay_seq[REPLAY_MAX_EVENTS];
+
+/*
+ * Instructions counter for the benchmarks, it uses the hardware counters
+ * where the host allows it else it returns zero and the instructions per
+ * operation are not reported.
+ */
+uint64_t sim_instr_counter(void) {
+#if defined(__linux__)
+  static int fd = -2;
+  uint64_t count;
+
+  if (fd == -2) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof (attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof (attr);
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+  if ((fd < 0) || (read(fd, &count, sizeof (count)) != sizeof (count))) {
+    return 0U;
+  }
+  return count;
+#else
+  return 0U;
+#endif
+}
+
+/*
+ * Loads the ready and switch events of a raw trace buffer dump, threads are
+ * numbered in order of appearance. The dump starts from the record at
+ * index "first", the trace buffer is circular.
+ */
+static size_t replay_load(const char *name, unsigned first) {
+  static uint8_t buf[REPLAY_MAX_EVENTS * TRACE_RECORD_SIZE];
+  uint32_t threads[BMK_REPLAY_THREADS];
+  size_t i, size, nrec, n = 0U;
+  unsigned nthreads = 0U;
+  FILE *f;
+
+  f = fopen(name, "rb");
+  if (f == NULL) {
+    return 0U;
+  }
+  size = fread(buf, 1, sizeof (buf), f);
+  fclose(f);
+
+  nrec = size / TRACE_RECORD_SIZE;
+  for (i = 0U; (i < nrec) && (n < REPLAY_MAX_EVENTS); i++) {
+    const uint8_t *rp = &buf[((first + i) % nrec) * TRACE_RECORD_SIZE];
+    unsigned type = rp[0] & 7U;
+    uint32_t tp;
+    unsigned j;
+
+    if ((type != CH_TRACE_TYPE_READY) && (type != CH_TRACE_TYPE_SWITCH)) {
+      continue;
+    }
+    tp = (uint32_t)rp[TRACE_RECORD_TP] |
+         ((uint32_t)rp[TRACE_RECORD_TP + 1U] << 8) |
+         ((uint32_t)rp[TRACE_RECORD_TP + 2U] << 16) |
+         ((uint32_t)rp[TRACE_RECORD_TP + 3U] << 24);
+    for (j = 0U; (j < nthreads) && (threads[j] != tp); j++) {
+    }
+    if (j == nthreads) {
+      if (nthreads < BMK_REPLAY_THREADS) {
+        threads[nthreads++] = tp;
+      }
+      else {
+        /* Threads in excess share the available ones.*/
+        j = j % BMK_REPLAY_THREADS;
+      }
+    }
+    replay_seq[n++] = (uint8_t)(j | (type == CH_TRACE_TYPE_SWITCH ?
+                                     BMK_REPLAY_SWITCH : 0U));
+  }
+
+  return n;
+}
+
+/*
+ * Simulator main, the output format is selected by the first argument,
+ * "csv" (default) or "json", or "replay <file> [first]" replays a raw
+ * trace buffer dump.
+ */
+int main(int argc, char *argv[]) {
+  bmk_format_t format = BMK_FORMAT_CSV;
+  size_t n = 0U;
+
+  if ((argc > 1) && (strcmp(argv[1], "json") == 0)) {
+    format = BMK_FORMAT_JSON;
+  }
+  else if ((argc > 2) && (strcmp(argv[1], "replay") == 0)) {
+    n = replay_load(argv[2], argc > 3 ? (unsigned)atoi(argv[3]) : 0U);
+    if (n == 0U) {
+      fprintf(stderr, "%s: no events to replay\n", argv[2]);
+      exit(1);
+    }
+  }
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  conInit();
+  chSysInit();
+
+  if (n > 0U) {
+    bmkReplay((BaseSequentialStream *)&CD1, format, replay_seq, n);
+  }
+  else {
+    bmkExecute((BaseSequentialStream *)&CD1, format);
+  }
+  exit(0);
+}
@@ -0,0 +1,5 @@
+# List of all the crypto benchmark files.
+TESTSRC += ${CHIBIOS}/test/crypto/source/bench/cry_bench.c
+
+# Required include directories
+TESTINC += ${CHIBIOS}/test/crypto/source/bench
@@ -0,0 +1,281 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cry_bench.c
+ * @brief   Crypto throughput benchmarks code.
+ * @details Each benchmark repeats an operation on a buffer of
+ *          @p CRYBMK_CFG_BUFFER_SIZE bytes for @p CRYBMK_CFG_DURATION
+ *          milliseconds, the results are emitted as "name,value,unit"
+ *          lines with the throughput in bytes per second. Operations not
+ *          supported by the driver, in hardware or by the fallback, are
+ *          reported with a zero throughput.
+ *
+ * @addtogroup CRY_BENCH
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "cry_bench.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a benchmark descriptor.
+ */
+typedef struct {
+  const char            *name;          /**< @brief Result name.            */
+  cryerror_t            (*execute)(CRYDriver *cryp); /**< @brief Buffer
+                                               operation.                   */
+} crybmk_benchmark_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static BaseSequentialStream *crybmk_chp;
+
+static uint8_t crybmk_in[CRYBMK_CFG_BUFFER_SIZE];
+static uint8_t crybmk_out[CRYBMK_CFG_BUFFER_SIZE];
+static uint8_t crybmk_digest[64];
+
+static const uint8_t crybmk_key[32] = {
+  0x60U, 0x3DU, 0xEBU, 0x10U, 0x15U, 0xCAU, 0x71U, 0xBEU,
+  0x2BU, 0x73U, 0xAEU, 0xF0U, 0x85U, 0x7DU, 0x77U, 0x81U,
+  0x1FU, 0x35U, 0x2CU, 0x07U, 0x3BU, 0x61U, 0x08U, 0xD7U,
+  0x2DU, 0x98U, 0x10U, 0xA3U, 0x09U, 0x14U, 0xDFU, 0xF4U
+};
+
+static const uint8_t crybmk_iv[16] = {
+  0xCAU, 0xFEU, 0xBAU, 0xBEU, 0xFAU, 0xCEU, 0xDBU, 0xADU,
+  0xDEU, 0xCAU, 0xF8U, 0x88U, 0x00U, 0x00U, 0x00U, 0x01U
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void crybmk_print(const char *msgp) {
+
+  while (*msgp != '\0') {
+    streamPut(crybmk_chp, (uint8_t)*msgp++);
+  }
+}
+
+static void crybmk_printn(uint32_t n) {
+  char buf[16], *p;
+
+  p = buf;
+  do {
+    *p++ = (char)((n % 10U) + (uint32_t)'0');
+    n /= 10U;
+  } while (n > 0U);
+  while (p > buf) {
+    streamPut(crybmk_chp, (uint8_t)*--p);
+  }
+}
+
+/*
+ * Benchmarks.
+ */
+
+static cryerror_t crybmk_aes_ecb(CRYDriver *cryp) {
+
+  return cryEncryptAES_ECB(cryp, (crykey_t)0, sizeof crybmk_in,
+                           crybmk_in, crybmk_out);
+}
+
+static cryerror_t crybmk_aes_cbc(CRYDriver *cryp) {
+
+  return cryEncryptAES_CBC(cryp, (crykey_t)0, sizeof crybmk_in,
+                           crybmk_in, crybmk_out, crybmk_iv);
+}
+
+static cryerror_t crybmk_aes_cbc_dec(CRYDriver *cryp) {
+
+  return cryDecryptAES_CBC(cryp, (crykey_t)0, sizeof crybmk_in,
+                           crybmk_in, crybmk_out, crybmk_iv);
+}
+
+static cryerror_t crybmk_aes_ctr(CRYDriver *cryp) {
+
+  return cryEncryptAES_CTR(cryp, (crykey_t)0, sizeof crybmk_in,
+                           crybmk_in, crybmk_out, crybmk_iv);
+}
+
+static cryerror_t crybmk_aes_gcm(CRYDriver *cryp) {
+
+  return cryEncryptAES_GCM(cryp, (crykey_t)0, (size_t)0, crybmk_in,
+                           sizeof crybmk_in, crybmk_in, crybmk_out,
+                           crybmk_iv, (size_t)16, crybmk_digest);
+}
+
+static cryerror_t crybmk_sha256(CRYDriver *cryp) {
+  SHA256Context ctx;
+  cryerror_t err;
+
+  err = crySHA256Init(cryp, &ctx);
+  if (err == CRY_NOERROR) {
+    err = crySHA256Update(cryp, &ctx, sizeof crybmk_in, crybmk_in);
+  }
+  if (err == CRY_NOERROR) {
+    err = crySHA256Final(cryp, &ctx, crybmk_digest);
+  }
+
+  return err;
+}
+
+static cryerror_t crybmk_sha512(CRYDriver *cryp) {
+  SHA512Context ctx;
+  cryerror_t err;
+
+  err = crySHA512Init(cryp, &ctx);
+  if (err == CRY_NOERROR) {
+    err = crySHA512Update(cryp, &ctx, sizeof crybmk_in, crybmk_in);
+  }
+  if (err == CRY_NOERROR) {
+    err = crySHA512Final(cryp, &ctx, crybmk_digest);
+  }
+
+  return err;
+}
+
+static cryerror_t crybmk_hmac_sha256(CRYDriver *cryp) {
+  HMACSHA256Context ctx;
+  cryerror_t err;
+
+  err = cryHMACSHA256Init(cryp, &ctx);
+  if (err == CRY_NOERROR) {
+    err = cryHMACSHA256Update(cryp, &ctx, sizeof crybmk_in, crybmk_in);
+  }
+  if (err == CRY_NOERROR) {
+    err = cryHMACSHA256Final(cryp, &ctx, crybmk_digest);
+  }
+
+  return err;
+}
+
+/*
+ * Benchmarks table, the AES benchmarks are repeated for each key size.
+ */
+static const crybmk_benchmark_t crybmk_aes_benchmarks[] = {
+  {"ecb",               crybmk_aes_ecb},
+  {"cbc",               crybmk_aes_cbc},
+  {"cbc.dec",           crybmk_aes_cbc_dec},
+  {"ctr",               crybmk_aes_ctr},
+  {"gcm",               crybmk_aes_gcm}
+};
+
+static const crybmk_benchmark_t crybmk_hash_benchmarks[] = {
+  {"sha256",            crybmk_sha256},
+  {"sha512",            crybmk_sha512},
+  {"hmac.sha256",       crybmk_hmac_sha256}
+};
+
+/*
+ * Executes a benchmark for CRYBMK_CFG_DURATION milliseconds and emits the
+ * throughput in bytes per second.
+ */
+static void crybmk_execute(CRYDriver *cryp, const char *prefix,
+                           const crybmk_benchmark_t *bp) {
+  systime_t start, end;
+  uint32_t n = 0U;
+
+  /* Synchronizing with the system tick.*/
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTime();
+  end = chTimeAddX(start, TIME_MS2I(CRYBMK_CFG_DURATION));
+  do {
+    if (bp->execute(cryp) != CRY_NOERROR) {
+      n = 0U;
+      break;
+    }
+    n++;
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  crybmk_print(prefix);
+  crybmk_print(bp->name);
+  crybmk_print(",");
+  crybmk_printn((uint32_t)(((uint64_t)n * CRYBMK_CFG_BUFFER_SIZE * 1000U) /
+                           (uint64_t)CRYBMK_CFG_DURATION));
+  crybmk_print(",B/s\r\n");
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Runs all the benchmarks.
+ * @details The results are emitted on the specified stream, each result is
+ *          a "name,value,unit" line.
+ * @note    The driver must have been started, the transient AES and HMAC
+ *          keys are overwritten.
+ *
+ * @param[in] stream    pointer to a @p BaseSequentialStream object
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ *
+ * @api
+ */
+void cryBenchExecute(BaseSequentialStream *stream, CRYDriver *cryp) {
+  static const struct {
+    const char          *prefix;
+    size_t              size;
+  } keys[] = {
+    {"aes128.",         16U},
+    {"aes256.",         32U}
+  };
+  unsigned i, j;
+
+  crybmk_chp = stream;
+
+  for (i = 0U; i < sizeof crybmk_in; i++) {
+    crybmk_in[i] = (uint8_t)i;
+  }
+
+  crybmk_print("name,value,unit\r\n");
+  for (i = 0U; i < sizeof keys / sizeof keys[0]; i++) {
+    if (cryLoadAESTransientKey(cryp, keys[i].size,
+                               crybmk_key) != CRY_NOERROR) {
+      continue;
+    }
+    for (j = 0U;
+         j < sizeof crybmk_aes_benchmarks / sizeof crybmk_aes_benchmarks[0];
+         j++) {
+      crybmk_execute(cryp, keys[i].prefix, &crybmk_aes_benchmarks[j]);
+    }
+  }
+
+  (void)cryLoadHMACTransientKey(cryp, sizeof crybmk_key, crybmk_key);
+  for (j = 0U;
+       j < sizeof crybmk_hash_benchmarks / sizeof crybmk_hash_benchmarks[0];
+       j++) {
+    crybmk_execute(cryp, "", &crybmk_hash_benchmarks[j]);
+  }
+}
+
+/** @} */
@@ -0,0 +1,89 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    cry_bench.h
+ * @brief   Crypto throughput benchmarks header.
+ *
+ * @addtogroup CRY_BENCH
+ * @{
+ */
+
+#ifndef CRY_BENCH_H
+#define CRY_BENCH_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Duration of each benchmark in milliseconds.
+ */
+#if !defined(CRYBMK_CFG_DURATION) || defined(__DOXYGEN__)
+#define CRYBMK_CFG_DURATION                 1000
+#endif
+
+/**
+ * @brief   Size of the data processed by each operation.
+ * @note    Must be a multiple of 16.
+ */
+#if !defined(CRYBMK_CFG_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define CRYBMK_CFG_BUFFER_SIZE              1024
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if CRYBMK_CFG_DURATION < 100
+#error "invalid CRYBMK_CFG_DURATION value"
+#endif
+
+#if (CRYBMK_CFG_BUFFER_SIZE < 16) || ((CRYBMK_CFG_BUFFER_SIZE % 16) != 0)
+#error "invalid CRYBMK_CFG_BUFFER_SIZE value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void cryBenchExecute(BaseSequentialStream *stream, CRYDriver *cryp);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* CRY_BENCH_H */
+
+/** @} */
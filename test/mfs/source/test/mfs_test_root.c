@@ -24,6 +24,7 @@
  * - @subpage mfs_test_sequence_001
  * - @subpage mfs_test_sequence_002
  * - @subpage mfs_test_sequence_003
+ * - @subpage mfs_test_sequence_004
  * .
  */
 
@@ -48,6 +49,7 @@ const testsequence_t * const mfs_test_suite_array[] = {
   &mfs_test_sequence_001,
   &mfs_test_sequence_002,
   &mfs_test_sequence_003,
+  &mfs_test_sequence_004,
   NULL
 };
 
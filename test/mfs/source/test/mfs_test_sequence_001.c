@@ -37,6 +37,11 @@
  * - @subpage mfs_test_001_005
  * - @subpage mfs_test_001_006
  * - @subpage mfs_test_001_007
+ * - @subpage mfs_test_001_008
+ * - @subpage mfs_test_001_009
+ * - @subpage mfs_test_001_010
+ * - @subpage mfs_test_001_011
+ * - @subpage mfs_test_001_012
  * .
  */
 
@@ -47,6 +52,26 @@
 #include <string.h>
 #include "hal_mfs.h"
 
+#if MFS_CFG_USE_WARM_RESTART == TRUE
+static uint32_t mfs_wr_area[(sizeof (wr_area_header_t) +
+                             sizeof (wr_slot_header_t) +
+                             sizeof (mfs_warm_state_t) + 3U) / 4U];
+
+static const wr_slot_t mfs_wr_slots[1] = {
+  {0x4D465331U, sizeof (mfs_warm_state_t)}
+};
+
+static const WRConfig mfs_wrcfg = {
+  mfs_wr_area,
+  sizeof mfs_wr_area,
+  mfs_wr_slots,
+  1U
+};
+
+static WRDriver mfs_wr;
+static MFSConfig mfs_wr_mfscfg;
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -805,6 +830,656 @@ static const testcase_t mfs_test_001_007 = {
   mfs_test_001_007_execute
 };
 
+/**
+ * @page mfs_test_001_008 [1.8] Writing and reading multiple records
+ *
+ * <h2>Description</h2>
+ * Multiple records are created, updated and read back using the multiple
+ * records APIs, the state and the content of the records are checked.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.8.1] Records 1, 2 and 3 are created in a single operation,
+ *   MFS_NO_ERROR is expected.
+ * - [1.8.2] Records 1, 2, 3 and 4 are read back in a single operation,
+ *   MFS_ERR_NOT_FOUND is expected because record 4 does not exist, size
+ *   and content of the other records are checked.
+ * - [1.8.3] Records 1 and 3 are updated in a single operation,
+ *   MFS_NO_ERROR is expected, the used space and the content of the
+ *   records are checked.
+ * - [1.8.4] Writing records exceeding the available space,
+ *   MFS_ERR_OUT_OF_MEM is expected and the state must not change.
+ * .
+ */
+
+static void mfs_test_001_008_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_008_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_008_execute(void) {
+
+  /* [1.8.1] Records 1, 2 and 3 are created in a single operation,
+     MFS_NO_ERROR is expected.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+    mfs_record_io_t records[3] = {
+      {1, sizeof mfs_pattern16, (uint8_t *)mfs_pattern16},
+      {2, sizeof mfs_pattern32, (uint8_t *)mfs_pattern32},
+      {3, sizeof mfs_pattern10, (uint8_t *)mfs_pattern10}
+    };
+
+    err = mfsWriteRecords(&mfs1, 3, records);
+    test_assert(err == MFS_NO_ERROR, "error creating the records");
+  }
+  test_end_step(1);
+
+  /* [1.8.2] Records 1, 2, 3 and 4 are read back in a single operation,
+     MFS_ERR_NOT_FOUND is expected because record 4 does not exist,
+     size and content of the other records are checked.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+    uint8_t buf1[16], buf2[32], buf3[16], buf4[16];
+    mfs_record_io_t records[4] = {
+      {1, sizeof buf1, buf1},
+      {2, sizeof buf2, buf2},
+      {3, sizeof buf3, buf3},
+      {4, sizeof buf4, buf4}
+    };
+
+    err = mfsReadRecords(&mfs1, 4, records);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record 4 found");
+    test_assert(records[0].size == sizeof mfs_pattern16, "unexpected record 1 length");
+    test_assert(memcmp(mfs_pattern16, buf1, sizeof mfs_pattern16) == 0,
+                "wrong record 1 content");
+    test_assert(records[1].size == sizeof mfs_pattern32, "unexpected record 2 length");
+    test_assert(memcmp(mfs_pattern32, buf2, sizeof mfs_pattern32) == 0,
+                "wrong record 2 content");
+    test_assert(records[2].size == sizeof mfs_pattern10, "unexpected record 3 length");
+    test_assert(memcmp(mfs_pattern10, buf3, sizeof mfs_pattern10) == 0,
+                "wrong record 3 content");
+    test_assert(records[3].size == 0U, "unexpected record 4 length");
+  }
+  test_end_step(2);
+
+  /* [1.8.3] Records 1 and 3 are updated in a single operation,
+     MFS_NO_ERROR is expected, the used space and the content of the
+     records are checked.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+    flash_offset_t used_space = mfs1.used_space;
+    mfs_record_io_t records[2] = {
+      {1, sizeof mfs_pattern10, (uint8_t *)mfs_pattern10},
+      {3, sizeof mfs_pattern16, (uint8_t *)mfs_pattern16}
+    };
+
+    err = mfsWriteRecords(&mfs1, 2, records);
+    test_assert(err == MFS_NO_ERROR, "error updating the records");
+    test_assert(mfs1.used_space == used_space, "unexpected used space");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(size == sizeof mfs_pattern10, "unexpected record 1 length");
+    test_assert(memcmp(mfs_pattern10, mfs_buffer, size) == 0,
+                "wrong record 1 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 3, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 3 not found");
+    test_assert(size == sizeof mfs_pattern16, "unexpected record 3 length");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 3 content");
+  }
+  test_end_step(3);
+
+  /* [1.8.4] Writing records exceeding the available space,
+     MFS_ERR_OUT_OF_MEM is expected and the state must not change.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+    flash_offset_t next_offset = mfs1.next_offset;
+    mfs_record_io_t records[2] = {
+      {4, mfscfg1.bank_size / 2U, (uint8_t *)mfs_pattern512},
+      {5, mfscfg1.bank_size / 2U, (uint8_t *)mfs_pattern512}
+    };
+
+    err = mfsWriteRecords(&mfs1, 2, records);
+    test_assert(err == MFS_ERR_OUT_OF_MEM, "unexpected error");
+    test_assert(mfs1.next_offset == next_offset, "state changed");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t mfs_test_001_008 = {
+  "Writing and reading multiple records",
+  mfs_test_001_008_setup,
+  mfs_test_001_008_teardown,
+  mfs_test_001_008_execute
+};
+
+#if (MFS_CFG_USE_CHECKPOINTS) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_009 [1.9] Mounting from a checkpoint
+ *
+ * <h2>Description</h2>
+ * A checkpoint is written then more records are written and erased, the
+ * storage is mounted again and the state is checked.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.9.1] Records 1, 2 and 3 are created then a checkpoint is
+ *   written, MFS_NO_ERROR is expected.
+ * - [1.9.2] Record 2 is updated, record 3 is erased and record 4 is
+ *   created after the checkpoint, MFS_NO_ERROR is expected.
+ * - [1.9.3] The storage is mounted again, MFS_NO_ERROR is expected, the
+ *   state and the content of the records are checked.
+ * .
+ */
+
+static void mfs_test_001_009_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_009_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_009_execute(void) {
+
+  /* [1.9.1] Records 1, 2 and 3 are created then a checkpoint is
+     written, MFS_NO_ERROR is expected.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern16, mfs_pattern16);
+    test_assert(err == MFS_NO_ERROR, "error creating record 1");
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_NO_ERROR, "error creating record 2");
+    err = mfsWriteRecord(&mfs1, 3, sizeof mfs_pattern10, mfs_pattern10);
+    test_assert(err == MFS_NO_ERROR, "error creating record 3");
+    err = mfsWriteCheckpoint(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error writing the checkpoint");
+  }
+  test_end_step(1);
+
+  /* [1.9.2] Record 2 is updated, record 3 is erased and record 4 is
+     created after the checkpoint, MFS_NO_ERROR is expected.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern10, mfs_pattern10);
+    test_assert(err == MFS_NO_ERROR, "error updating record 2");
+    err = mfsEraseRecord(&mfs1, 3);
+    test_assert(err == MFS_NO_ERROR, "error erasing record 3");
+    err = mfsWriteRecord(&mfs1, 4, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_NO_ERROR, "error creating record 4");
+  }
+  test_end_step(2);
+
+  /* [1.9.3] The storage is mounted again, MFS_NO_ERROR is expected, the
+     state and the content of the records are checked.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+    flash_offset_t used_space = mfs1.used_space;
+    flash_offset_t next_offset = mfs1.next_offset;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    test_assert(mfs1.used_space == used_space, "unexpected used space");
+    test_assert(mfs1.next_offset == next_offset, "unexpected next offset");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(size == sizeof mfs_pattern16, "unexpected record 1 length");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 1 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 2 not found");
+    test_assert(size == sizeof mfs_pattern10, "unexpected record 2 length");
+    test_assert(memcmp(mfs_pattern10, mfs_buffer, size) == 0,
+                "wrong record 2 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 3, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record 3 not erased");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 4, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 4 not found");
+    test_assert(size == sizeof mfs_pattern32, "unexpected record 4 length");
+    test_assert(memcmp(mfs_pattern32, mfs_buffer, size) == 0,
+                "wrong record 4 content");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t mfs_test_001_009 = {
+  "Mounting from a checkpoint",
+  mfs_test_001_009_setup,
+  mfs_test_001_009_teardown,
+  mfs_test_001_009_execute
+};
+#endif /* MFS_CFG_USE_CHECKPOINTS */
+
+#if (MFS_CFG_USE_INCREMENTAL_GC) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_010 [1.10] Incremental garbage collection
+ *
+ * <h2>Description</h2>
+ * A garbage collection is performed in small steps while records are
+ * updated and erased between steps, the resulting state is checked before
+ * and after mounting the storage again.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.10.1] Records 1, 2 and 3 are created then record 2 is updated,
+ *   MFS_NO_ERROR is expected.
+ * - [1.10.2] Garbage collection steps are performed until record 1 has
+ *   been copied, MFS_WARN_GC_PENDING is expected and the current bank
+ *   must not change.
+ * - [1.10.3] Record 1 is updated and record 3 is erased between steps,
+ *   MFS_NO_ERROR is expected.
+ * - [1.10.4] Steps are performed until the garbage collection is
+ *   completed, MFS_NO_ERROR is expected, the bank and the content of
+ *   the records are checked.
+ * - [1.10.5] The storage is mounted again, MFS_NO_ERROR is expected,
+ *   the state must not change.
+ * .
+ */
+
+static void mfs_test_001_010_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_010_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_010_execute(void) {
+
+  /* [1.10.1] Records 1, 2 and 3 are created then record 2 is updated,
+     MFS_NO_ERROR is expected.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern16, mfs_pattern16);
+    test_assert(err == MFS_NO_ERROR, "error creating record 1");
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_NO_ERROR, "error creating record 2");
+    err = mfsWriteRecord(&mfs1, 3, sizeof mfs_pattern10, mfs_pattern10);
+    test_assert(err == MFS_NO_ERROR, "error creating record 3");
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern16, mfs_pattern16);
+    test_assert(err == MFS_NO_ERROR, "error updating record 2");
+  }
+  test_end_step(1);
+
+  /* [1.10.2] Garbage collection steps are performed until record 1 has
+     been copied, MFS_WARN_GC_PENDING is expected and the current bank
+     must not change.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    do {
+      err = mfsPerformGarbageCollectionStep(&mfs1, 8U);
+      test_assert(err == MFS_WARN_GC_PENDING, "unexpected step result");
+    } while (mfs1.gc_index < 1U);
+    test_assert(mfs1.current_bank == MFS_BANK_0, "bank changed");
+  }
+  test_end_step(2);
+
+  /* [1.10.3] Record 1 is updated and record 3 is erased between steps,
+     MFS_NO_ERROR is expected.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_NO_ERROR, "error updating record 1");
+    err = mfsPerformGarbageCollectionStep(&mfs1, 8U);
+    test_assert(err == MFS_WARN_GC_PENDING, "unexpected step result");
+    err = mfsEraseRecord(&mfs1, 3);
+    test_assert(err == MFS_NO_ERROR, "error erasing record 3");
+  }
+  test_end_step(3);
+
+  /* [1.10.4] Steps are performed until the garbage collection is
+     completed, MFS_NO_ERROR is expected, the bank and the content of
+     the records are checked.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    do {
+      err = mfsPerformGarbageCollectionStep(&mfs1, 8U);
+      test_assert(!MFS_IS_ERROR(err), "step failed");
+    } while (err == MFS_WARN_GC_PENDING);
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.current_counter == 2, "unexpected counter");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(size == sizeof mfs_pattern32, "unexpected record 1 length");
+    test_assert(memcmp(mfs_pattern32, mfs_buffer, size) == 0,
+                "wrong record 1 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 2 not found");
+    test_assert(size == sizeof mfs_pattern16, "unexpected record 2 length");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 2 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 3, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record 3 not erased");
+  }
+  test_end_step(4);
+
+  /* [1.10.5] The storage is mounted again, MFS_NO_ERROR is expected,
+     the state must not change.*/
+  test_set_step(5);
+  {
+    mfs_error_t err;
+    size_t size;
+    flash_offset_t used_space = mfs1.used_space;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.used_space == used_space, "unexpected used space");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(memcmp(mfs_pattern32, mfs_buffer, size) == 0,
+                "wrong record 1 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 2 not found");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 2 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 3, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record 3 not erased");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t mfs_test_001_010 = {
+  "Incremental garbage collection",
+  mfs_test_001_010_setup,
+  mfs_test_001_010_teardown,
+  mfs_test_001_010_execute
+};
+#endif /* MFS_CFG_USE_INCREMENTAL_GC */
+
+#if (MFS_CFG_USE_COMPRESSION) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_011 [1.11] Compressed records
+ *
+ * <h2>Description</h2>
+ * Records larger than the compression threshold are stored compressed,
+ * sizes and contents are checked before and after mounting the storage
+ * again.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.11.1] A compressible record of 512 bytes is written, MFS_NO_ERROR
+ *   is expected, the stored size must be smaller than the record size.
+ * - [1.11.2] A record smaller than the threshold is written, MFS_NO_ERROR
+ *   is expected, the record must be stored uncompressed.
+ * - [1.11.3] The compressed record is read using a buffer one byte smaller
+ *   than the record, MFS_ERR_INV_SIZE is expected.
+ * - [1.11.4] The storage is mounted again and the records are read back,
+ *   MFS_NO_ERROR is expected, the original sizes and contents must be
+ *   returned.
+ * .
+ */
+
+static void mfs_test_001_011_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_011_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_011_execute(void) {
+
+  /* [1.11.1] A compressible record of 512 bytes is written, MFS_NO_ERROR
+     is expected, the stored size must be smaller than the record size.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+    unsigned i;
+
+    for (i = 0; i < sizeof mfs_buffer; i++) {
+      mfs_buffer[i] = (uint8_t)(i / 16U);
+    }
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_buffer, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "error creating record 1");
+    test_assert(mfs1.descriptors[0].size < sizeof mfs_buffer,
+                "record 1 not compressed");
+  }
+  test_end_step(1);
+
+  /* [1.11.2] A record smaller than the threshold is written, MFS_NO_ERROR
+     is expected, the record must be stored uncompressed.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern16, mfs_pattern16);
+    test_assert(err == MFS_NO_ERROR, "error creating record 2");
+    test_assert(mfs1.descriptors[1].size == sizeof mfs_pattern16,
+                "record 2 compressed");
+  }
+  test_end_step(2);
+
+  /* [1.11.3] The compressed record is read using a buffer one byte smaller
+     than the record, MFS_ERR_INV_SIZE is expected.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    size = sizeof mfs_buffer - 1U;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_INV_SIZE, "size error not detected");
+  }
+  test_end_step(3);
+
+  /* [1.11.4] The storage is mounted again and the records are read back,
+     MFS_NO_ERROR is expected, the original sizes and contents must be
+     returned.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+    size_t size;
+    unsigned i;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    memset(mfs_buffer, 0, sizeof mfs_buffer);
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(size == sizeof mfs_buffer, "unexpected record 1 length");
+    for (i = 0; i < sizeof mfs_buffer; i++) {
+      test_assert(mfs_buffer[i] == (uint8_t)(i / 16U),
+                  "wrong record 1 content");
+    }
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 2 not found");
+    test_assert(size == sizeof mfs_pattern16, "unexpected record 2 length");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 2 content");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t mfs_test_001_011 = {
+  "Compressed records",
+  mfs_test_001_011_setup,
+  mfs_test_001_011_teardown,
+  mfs_test_001_011_execute
+};
+#endif /* MFS_CFG_USE_COMPRESSION */
+
+#if (MFS_CFG_USE_WARM_RESTART) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_012 [1.12] Warm restart
+ *
+ * <h2>Description</h2>
+ * The records index is checkpointed in a warm restart slot, the storage
+ * is mounted again from the slot, after flash modifications the slot
+ * must be ignored.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.12.1] Records 1 and 2 are created, the slot must be invalid,
+ *   then the state is saved, MFS_NO_ERROR is expected and the slot must
+ *   be valid.
+ * - [1.12.2] The storage is mounted again from the slot, MFS_NO_ERROR
+ *   is expected, the state and the content of the records are checked.
+ * - [1.12.3] Record 3 is created without saving the state then the
+ *   storage is mounted again, MFS_NO_ERROR is expected, record 3 must
+ *   be found and the slot must be valid again.
+ * - [1.12.4] The flash is erased using a low level function while the
+ *   slot is valid, the storage is mounted again, the slot must be
+ *   ignored and the records must not be found.
+ * .
+ */
+
+static void mfs_test_001_012_setup(void) {
+  mfs_wr_mfscfg = mfscfg1;
+  mfs_wr_mfscfg.wrp     = &mfs_wr;
+  mfs_wr_mfscfg.wr_slot = 0U;
+  wrObjectInit(&mfs_wr);
+  wrStart(&mfs_wr, &mfs_wrcfg);
+  mfsStart(&mfs1, &mfs_wr_mfscfg);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_012_teardown(void) {
+  mfsStop(&mfs1);
+  wrStop(&mfs_wr);
+}
+
+static void mfs_test_001_012_execute(void) {
+
+  /* [1.12.1] Records 1 and 2 are created, the slot must be invalid, then
+     the state is saved, MFS_NO_ERROR is expected and the slot must be
+     valid.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_pattern16, mfs_pattern16);
+    test_assert(err == MFS_NO_ERROR, "error creating record 1");
+    err = mfsWriteRecord(&mfs1, 2, sizeof mfs_pattern32, mfs_pattern32);
+    test_assert(err == MFS_NO_ERROR, "error creating record 2");
+    test_assert(wrGetSlot(&mfs_wr, 0U) == NULL, "slot not invalidated");
+    err = mfsSaveWarmState(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error saving the state");
+    test_assert(wrGetSlot(&mfs_wr, 0U) != NULL, "slot not saved");
+  }
+  test_end_step(1);
+
+  /* [1.12.2] The storage is mounted again from the slot, MFS_NO_ERROR is
+     expected, the state and the content of the records are checked.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+    size_t size;
+    flash_offset_t used_space = mfs1.used_space;
+    flash_offset_t next_offset = mfs1.next_offset;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfs_wr_mfscfg);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    test_assert(mfs1.warm_valid, "state not restored");
+    test_assert(mfs1.used_space == used_space, "unexpected used space");
+    test_assert(mfs1.next_offset == next_offset, "unexpected next offset");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 1 not found");
+    test_assert(size == sizeof mfs_pattern16, "unexpected record 1 length");
+    test_assert(memcmp(mfs_pattern16, mfs_buffer, size) == 0,
+                "wrong record 1 content");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 2 not found");
+    test_assert(size == sizeof mfs_pattern32, "unexpected record 2 length");
+    test_assert(memcmp(mfs_pattern32, mfs_buffer, size) == 0,
+                "wrong record 2 content");
+  }
+  test_end_step(2);
+
+  /* [1.12.3] Record 3 is created without saving the state then the
+     storage is mounted again, MFS_NO_ERROR is expected, record 3 must be
+     found and the slot must be valid again.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    err = mfsWriteRecord(&mfs1, 3, sizeof mfs_pattern10, mfs_pattern10);
+    test_assert(err == MFS_NO_ERROR, "error creating record 3");
+    test_assert(wrGetSlot(&mfs_wr, 0U) == NULL, "slot not invalidated");
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfs_wr_mfscfg);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    test_assert(wrGetSlot(&mfs_wr, 0U) != NULL, "slot not saved on mount");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 3, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record 3 not found");
+    test_assert(size == sizeof mfs_pattern10, "unexpected record 3 length");
+    test_assert(memcmp(mfs_pattern10, mfs_buffer, size) == 0,
+                "wrong record 3 content");
+  }
+  test_end_step(3);
+
+  /* [1.12.4] The flash is erased using a low level function while the
+     slot is valid, the storage is mounted again, the slot must be ignored
+     and the records must not be found.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    mfsStop(&mfs1);
+    test_assert(bank_erase(MFS_BANK_0) == FLASH_NO_ERROR, "Bank 0 erase failure");
+    test_assert(bank_erase(MFS_BANK_1) == FLASH_NO_ERROR, "Bank 1 erase failure");
+    err = mfsStart(&mfs1, &mfs_wr_mfscfg);
+    test_assert(err == MFS_NO_ERROR, "restart failed");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "stale record 1 found");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t mfs_test_001_012 = {
+  "Warm restart",
+  mfs_test_001_012_setup,
+  mfs_test_001_012_teardown,
+  mfs_test_001_012_execute
+};
+#endif /* MFS_CFG_USE_WARM_RESTART */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -820,6 +1495,19 @@ const testcase_t * const mfs_test_sequence_001_array[] = {
   &mfs_test_001_005,
   &mfs_test_001_006,
   &mfs_test_001_007,
+  &mfs_test_001_008,
+#if (MFS_CFG_USE_CHECKPOINTS) || defined(__DOXYGEN__)
+  &mfs_test_001_009,
+#endif
+#if (MFS_CFG_USE_INCREMENTAL_GC) || defined(__DOXYGEN__)
+  &mfs_test_001_010,
+#endif
+#if (MFS_CFG_USE_COMPRESSION) || defined(__DOXYGEN__)
+  &mfs_test_001_011,
+#endif
+#if (MFS_CFG_USE_WARM_RESTART) || defined(__DOXYGEN__)
+  &mfs_test_001_012,
+#endif
   NULL
 };
 
@@ -0,0 +1,382 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_004.c
+ * @brief   Test Sequence 004 code.
+ *
+ * @page mfs_test_sequence_004 [4] Benchmarks
+ *
+ * File: @ref mfs_test_sequence_004.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures the MFS performance on an emulated flash, the
+ * RAM flash driver accounts the time the flash operations would take on
+ * a typical serial NOR device so the results are reproducible on any
+ * port including the simulators. Times do not include the CPU time,
+ * results are printed as comma separated lines starting with "--- BMK,"
+ * in order to be extracted from the test log.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_004_001
+ * - @subpage mfs_test_004_002
+ * - @subpage mfs_test_004_003
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "hal_mfs.h"
+#include "hal_ram_flash.h"
+
+#define BMK_SECTOR_SIZE             4096U
+#define BMK_BANK_SECTORS            2U
+#define BMK_RECORD_SIZE             32U
+#define BMK_WRITES                  256U
+
+static uint8_t bmk_flash_buffer[BMK_SECTOR_SIZE * BMK_BANK_SECTORS * 2U];
+static RFLDriver bmk_rfl;
+static uint32_t bmk_samples[BMK_WRITES];
+
+/* Timing model of a serial NOR device, times are in nanoseconds.*/
+static const RFLConfig bmk_rflcfg = {
+  .buffer           = bmk_flash_buffer,
+  .attributes       = FLASH_ATTR_ERASED_IS_ONE | FLASH_ATTR_REWRITABLE,
+  .page_size        = 256U,
+  .sectors_count    = BMK_BANK_SECTORS * 2U,
+  .sectors_size     = BMK_SECTOR_SIZE,
+  .read_setup       = 1000U,
+  .read_byte        = 40U,
+  .program_setup    = 1000U,
+  .program_page     = 400000U,
+  .erase_sector     = 45000000U
+};
+
+static const MFSConfig bmk_mfscfg = {
+  .flashp           = (BaseFlash *)&bmk_rfl,
+  .erased           = 0xFFFFFFFFU,
+  .bank_size        = BMK_SECTOR_SIZE * BMK_BANK_SECTORS,
+  .bank0_start      = 0U,
+  .bank0_sectors    = BMK_BANK_SECTORS,
+  .bank1_start      = BMK_BANK_SECTORS,
+  .bank1_sectors    = BMK_BANK_SECTORS
+};
+
+static void bmk_start(void) {
+
+  memset(bmk_flash_buffer, 0xFF, sizeof bmk_flash_buffer);
+  rflObjectInit(&bmk_rfl);
+  rflStart(&bmk_rfl, &bmk_rflcfg);
+  mfsObjectInit(&mfs1);
+  mfsStart(&mfs1, &bmk_mfscfg);
+  mfsErase(&mfs1);
+}
+
+static void bmk_stop(void) {
+
+  mfsStop(&mfs1);
+  rflStop(&bmk_rfl);
+}
+
+/* Modeled flash time in microseconds.*/
+static uint32_t bmk_time(void) {
+  rfl_statistics_t stats;
+
+  rflGetStatistics(&bmk_rfl, &stats);
+  return (uint32_t)(stats.time / 1000U);
+}
+
+static void bmk_print_field(uint32_t n) {
+
+  test_print(",");
+  test_printn(n);
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_004_001 [4.1] Mount time
+ *
+ * <h2>Description</h2>
+ * The storage is filled with an increasing number of records, each
+ * record written one or more times, then the time required by
+ * mfsStart() is measured. The output fields are records, writes per
+ * record, mount time in microseconds and number of read operations.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.1.1] Measuring the mount time for each configuration.
+ * .
+ */
+
+static void mfs_test_004_001_setup(void) {
+  bmk_start();
+}
+
+static void mfs_test_004_001_teardown(void) {
+  bmk_stop();
+}
+
+static void mfs_test_004_001_execute(void) {
+
+  /* [4.1.1] Measuring the mount time for each configuration.*/
+  test_set_step(1);
+  {
+    static const uint32_t records[] = {1U, 4U, 8U, 16U, 32U, 64U};
+    unsigned i, u, n;
+
+    test_println("--- BMK,mount,records,writes,time_us,reads");
+    for (i = 0U; i < sizeof records / sizeof records[0]; i++) {
+      if (records[i] > MFS_CFG_MAX_RECORDS) {
+        break;
+      }
+      for (u = 1U; u <= 4U; u *= 4U) {
+        rfl_statistics_t stats;
+        mfs_error_t err;
+
+        err = mfsErase(&mfs1);
+        test_assert(err == MFS_NO_ERROR, "error erasing the storage");
+        for (n = 0U; n < records[i] * u; n++) {
+          err = mfsWriteRecord(&mfs1, (mfs_id_t)((n % records[i]) + 1U),
+                               BMK_RECORD_SIZE, mfs_pattern512);
+          test_assert(err == MFS_NO_ERROR, "error creating the record");
+        }
+        mfsStop(&mfs1);
+
+        rflResetStatistics(&bmk_rfl);
+        err = mfsStart(&mfs1, &bmk_mfscfg);
+        test_assert(err == MFS_NO_ERROR, "mount failed");
+        rflGetStatistics(&bmk_rfl, &stats);
+
+        test_print("--- BMK,mount");
+        bmk_print_field(records[i]);
+        bmk_print_field(u);
+        bmk_print_field((uint32_t)(stats.time / 1000U));
+        bmk_print_field(stats.reads);
+        test_println("");
+      }
+    }
+  }
+  test_end_step(1);
+}
+
+static const testcase_t mfs_test_004_001 = {
+  "Mount time",
+  mfs_test_004_001_setup,
+  mfs_test_004_001_teardown,
+  mfs_test_004_001_execute
+};
+
+/**
+ * @page mfs_test_004_002 [4.2] Write latency distribution
+ *
+ * <h2>Description</h2>
+ * A set of eight records is updated repeatedly, the storage fills and
+ * garbage collections are triggered. The latency of each write is
+ * recorded and the distribution is printed, the output fields are
+ * record size, number of writes, minimum, median, 90th and 99th
+ * percentiles and maximum latency in microseconds, number of writes
+ * that triggered a garbage collection and their maximum latency.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] Measuring the writes latency for each record size.
+ * .
+ */
+
+static void mfs_test_004_002_setup(void) {
+  bmk_start();
+}
+
+static void mfs_test_004_002_teardown(void) {
+  bmk_stop();
+}
+
+static void mfs_test_004_002_execute(void) {
+
+  /* [4.2.1] Measuring the writes latency for each record size.*/
+  test_set_step(1);
+  {
+    static const size_t sizes[] = {16U, 128U, 512U};
+    unsigned i, n, j;
+
+    test_println("--- BMK,write,size,writes,min_us,p50_us,p90_us,p99_us,max_us,gcs,gc_max_us");
+    for (i = 0U; i < sizeof sizes / sizeof sizes[0]; i++) {
+      uint32_t gcs = 0U, gcmax = 0U;
+      mfs_error_t err;
+
+      err = mfsErase(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "error erasing the storage");
+      for (n = 0U; n < BMK_WRITES; n++) {
+        uint32_t t;
+
+        t = bmk_time();
+        err = mfsWriteRecord(&mfs1, (mfs_id_t)((n % 8U) + 1U),
+                             sizes[i], mfs_pattern512);
+        t = bmk_time() - t;
+        test_assert(!MFS_IS_ERROR(err), "error writing the record");
+
+        if (err == MFS_WARN_GC) {
+          gcs++;
+          if (t > gcmax) {
+            gcmax = t;
+          }
+        }
+
+        /* Insertion in the sorted samples array.*/
+        for (j = n; (j > 0U) && (bmk_samples[j - 1U] > t); j--) {
+          bmk_samples[j] = bmk_samples[j - 1U];
+        }
+        bmk_samples[j] = t;
+      }
+
+      test_print("--- BMK,write");
+      bmk_print_field((uint32_t)sizes[i]);
+      bmk_print_field(BMK_WRITES);
+      bmk_print_field(bmk_samples[0]);
+      bmk_print_field(bmk_samples[BMK_WRITES / 2U]);
+      bmk_print_field(bmk_samples[(BMK_WRITES * 90U) / 100U]);
+      bmk_print_field(bmk_samples[(BMK_WRITES * 99U) / 100U]);
+      bmk_print_field(bmk_samples[BMK_WRITES - 1U]);
+      bmk_print_field(gcs);
+      bmk_print_field(gcmax);
+      test_println("");
+    }
+  }
+  test_end_step(1);
+}
+
+static const testcase_t mfs_test_004_002 = {
+  "Write latency distribution",
+  mfs_test_004_002_setup,
+  mfs_test_004_002_teardown,
+  mfs_test_004_002_execute
+};
+
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_004_003 [4.3] Transaction commit cost
+ *
+ * <h2>Description</h2>
+ * An increasing number of records is written within a transaction, the
+ * time spent writing the records and the time spent committing the
+ * transaction are measured and compared with the time required to write
+ * the same records outside a transaction. The output fields are
+ * records, time of the writes, time of the commit and time of the non
+ * transactional writes, all in microseconds.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.3.1] Measuring the transactions cost for each number of records.
+ * .
+ */
+
+static void mfs_test_004_003_setup(void) {
+  bmk_start();
+}
+
+static void mfs_test_004_003_teardown(void) {
+  bmk_stop();
+}
+
+static void mfs_test_004_003_execute(void) {
+
+  /* [4.3.1] Measuring the transactions cost for each number of
+     records.*/
+  test_set_step(1);
+  {
+    unsigned i, n;
+
+    test_println("--- BMK,transaction,records,writes_us,commit_us,single_us");
+    for (i = 1U; (i <= MFS_CFG_TRANSACTION_MAX) && (i <= MFS_CFG_MAX_RECORDS); i *= 2U) {
+      uint32_t t0, t1, t2, single;
+      mfs_error_t err;
+
+      /* Reference time, same records outside a transaction.*/
+      err = mfsErase(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "error erasing the storage");
+      t0 = bmk_time();
+      for (n = 0U; n < i; n++) {
+        err = mfsWriteRecord(&mfs1, (mfs_id_t)(n + 1U),
+                             BMK_RECORD_SIZE, mfs_pattern512);
+        test_assert(err == MFS_NO_ERROR, "error writing the record");
+      }
+      single = bmk_time() - t0;
+
+      err = mfsErase(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "error erasing the storage");
+      err = mfsStartTransaction(&mfs1,
+                                i * (MFS_ALIGN_NEXT(sizeof (mfs_data_header_t)) +
+                                     MFS_ALIGN_NEXT(BMK_RECORD_SIZE)));
+      test_assert(err == MFS_NO_ERROR, "error starting transaction");
+      t0 = bmk_time();
+      for (n = 0U; n < i; n++) {
+        err = mfsWriteRecord(&mfs1, (mfs_id_t)(n + 1U),
+                             BMK_RECORD_SIZE, mfs_pattern512);
+        test_assert(err == MFS_NO_ERROR, "error writing the record");
+      }
+      t1 = bmk_time();
+      err = mfsCommitTransaction(&mfs1);
+      test_assert(err == MFS_NO_ERROR, "error committing transaction");
+      t2 = bmk_time();
+
+      test_print("--- BMK,transaction");
+      bmk_print_field(i);
+      bmk_print_field(t1 - t0);
+      bmk_print_field(t2 - t1);
+      bmk_print_field(single);
+      test_println("");
+    }
+  }
+  test_end_step(1);
+}
+
+static const testcase_t mfs_test_004_003 = {
+  "Transaction commit cost",
+  mfs_test_004_003_setup,
+  mfs_test_004_003_teardown,
+  mfs_test_004_003_execute
+};
+#endif /* MFS_CFG_TRANSACTION_MAX > 0 */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_004_array[] = {
+  &mfs_test_004_001,
+  &mfs_test_004_002,
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+  &mfs_test_004_003,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t mfs_test_sequence_004 = {
+  "Benchmarks",
+  mfs_test_sequence_004_array
+};
@@ -217,6 +217,20 @@
 #define CH_CFG_USE_HEAP                     TRUE
 #endif
 
+/**
+ * @brief   Constant time heap allocator.
+ * @details If enabled then the memory heap uses a two levels segregated
+ *          fit allocator (TLSF) instead of a first-fit free list, the
+ *          allocation and release times do not depend on the heap
+ *          fragmentation.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
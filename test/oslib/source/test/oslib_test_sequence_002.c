@@ -39,6 +39,7 @@
  * - @subpage oslib_test_002_001
  * - @subpage oslib_test_002_002
  * - @subpage oslib_test_002_003
+ * - @subpage oslib_test_002_004
  * .
  */
 
@@ -53,6 +54,17 @@
 static msg_t mb_buffer[MB_SIZE];
 static MAILBOX_DECL(mb1, mb_buffer, MB_SIZE);
 
+#if CH_CFG_USE_WAIT_MULTIPLE == TRUE
+static semaphore_t sem1;
+
+static void mb_post_cb(void *p) {
+
+  chSysLockFromISR();
+  (void) chMBPostI(&mb1, (msg_t)p);
+  chSysUnlockFromISR();
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -410,6 +422,89 @@ static const testcase_t oslib_test_002_003 = {
   oslib_test_002_003_execute
 };
 
+#if (CH_CFG_USE_WAIT_MULTIPLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_002_004 [2.4] Waiting on multiple objects
+ *
+ * <h2>Description</h2>
+ * A semaphore and a mailbox are waited at once using
+ * chWaitMultipleTimeout(), readiness, wakeup and timeout are tested.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_WAIT_MULTIPLE == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.4.1] Testing the timeout, no item is ready.
+ * - [2.4.2] Signaling the semaphore, the item is reported ready and the
+ *   semaphore is not consumed.
+ * - [2.4.3] Posting a message from a timer callback while waiting, the
+ *   thread is woken by the mailbox item.
+ * .
+ */
+
+static void oslib_test_002_004_setup(void) {
+  chMBObjectInit(&mb1, mb_buffer, MB_SIZE);
+  chSemObjectInit(&sem1, 0);
+}
+
+static void oslib_test_002_004_teardown(void) {
+  chMBReset(&mb1);
+}
+
+static void oslib_test_002_004_execute(void) {
+  virtual_timer_t vt;
+  wait_item_t items[2] = {WAIT_SEMAPHORE(&sem1), WAIT_MAILBOX(&mb1)};
+  uint32_t ready;
+  msg_t msg1, msg2;
+
+  /* [2.4.1] Testing the timeout, no item is ready.*/
+  test_set_step(1);
+  {
+    ready = chWaitMultipleTimeout(items, 2, TIME_IMMEDIATE);
+    test_assert(ready == 0U, "item ready");
+    ready = chWaitMultipleTimeout(items, 2, TIME_MS2I(10));
+    test_assert(ready == 0U, "item ready");
+  }
+  test_end_step(1);
+
+  /* [2.4.2] Signaling the semaphore, the item is reported ready and the
+     semaphore is not consumed.*/
+  test_set_step(2);
+  {
+    chSemSignal(&sem1);
+    ready = chWaitMultipleTimeout(items, 2, TIME_MS2I(10));
+    test_assert(ready == 1U, "wrong ready mask");
+    msg1 = chSemWaitTimeout(&sem1, TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_OK, "semaphore consumed");
+  }
+  test_end_step(2);
+
+  /* [2.4.3] Posting a message from a timer callback while waiting, the
+     thread is woken by the mailbox item.*/
+  test_set_step(3);
+  {
+    chVTObjectInit(&vt);
+    chVTSet(&vt, TIME_MS2I(10), mb_post_cb, (void *)'A');
+    ready = chWaitMultipleTimeout(items, 2, TIME_INFINITE);
+    test_assert(ready == 2U, "wrong ready mask");
+    msg1 = chMBFetchTimeout(&mb1, &msg2, TIME_IMMEDIATE);
+    test_assert(msg1 == MSG_OK, "wrong wake-up message");
+    test_assert(msg2 == 'A', "wrong message");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_002_004 = {
+  "Waiting on multiple objects",
+  oslib_test_002_004_setup,
+  oslib_test_002_004_teardown,
+  oslib_test_002_004_execute
+};
+#endif /* CH_CFG_USE_WAIT_MULTIPLE == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -421,6 +516,9 @@ const testcase_t * const oslib_test_sequence_002_array[] = {
   &oslib_test_002_001,
   &oslib_test_002_002,
   &oslib_test_002_003,
+#if (CH_CFG_USE_WAIT_MULTIPLE == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_002_004,
+#endif
   NULL
 };
 
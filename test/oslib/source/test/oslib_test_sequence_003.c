@@ -38,6 +38,8 @@
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_003_001
  * - @subpage oslib_test_003_002
+ * - @subpage oslib_test_003_003
+ * - @subpage oslib_test_003_004
  * .
  */
 
@@ -356,6 +358,261 @@ static const testcase_t oslib_test_003_002 = {
   oslib_test_003_002_execute
 };
 
+/**
+ * @page oslib_test_003_003 [3.3] Pipes SPSC mode
+ *
+ * <h2>Description</h2>
+ * The pipe functionality is tested in single producer and single
+ * consumer mode, data transfers and the reset state are tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] Filling whole pipe.
+ * - [3.3.2] Writing while pipe is full.
+ * - [3.3.3] Small read.
+ * - [3.3.4] Write wrapping buffer boundary.
+ * - [3.3.5] Read wrapping buffer boundary.
+ * - [3.3.6] Reading while pipe is empty.
+ * - [3.3.7] Resetting pipe.
+ * .
+ */
+
+static void oslib_test_003_003_setup(void) {
+  chPipeObjectInitSPSC(&pipe1, buffer, PIPE_SIZE);
+}
+
+static void oslib_test_003_003_execute(void) {
+
+  /* [3.3.1] Filling whole pipe.*/
+  test_set_step(1);
+  {
+    size_t n;
+
+    n = chPipeWriteTimeout(&pipe1, pipe_pattern, PIPE_SIZE, TIME_IMMEDIATE);
+    test_assert(n == PIPE_SIZE, "wrong size");
+    test_assert((pipe1.rdptr == pipe1.buffer) &&
+                (pipe1.wrptr == pipe1.buffer) &&
+                (chPipeGetUsedCount(&pipe1) == PIPE_SIZE),
+                "invalid pipe state");
+  }
+  test_end_step(1);
+
+  /* [3.3.2] Writing while pipe is full.*/
+  test_set_step(2);
+  {
+    size_t n;
+
+    n = chPipeWriteTimeout(&pipe1, pipe_pattern, 1, TIME_IMMEDIATE);
+    test_assert(n == 0, "wrong size");
+    test_assert(chPipeGetUsedCount(&pipe1) == PIPE_SIZE, "invalid pipe state");
+  }
+  test_end_step(2);
+
+  /* [3.3.3] Small read.*/
+  test_set_step(3);
+  {
+    size_t n;
+    uint8_t buf[PIPE_SIZE];
+
+    n = chPipeReadTimeout(&pipe1, buf, 4, TIME_IMMEDIATE);
+    test_assert(n == 4, "wrong size");
+    test_assert((pipe1.rdptr != pipe1.buffer) &&
+                (pipe1.wrptr == pipe1.buffer) &&
+                (chPipeGetUsedCount(&pipe1) == PIPE_SIZE - 4),
+                "invalid pipe state");
+    test_assert(memcmp(pipe_pattern, buf, 4) == 0, "content mismatch");
+  }
+  test_end_step(3);
+
+  /* [3.3.4] Write wrapping buffer boundary.*/
+  test_set_step(4);
+  {
+    size_t n;
+
+    n = chPipeWriteTimeout(&pipe1, pipe_pattern, 4, TIME_IMMEDIATE);
+    test_assert(n == 4, "wrong size");
+    test_assert((pipe1.rdptr == pipe1.wrptr) &&
+                (pipe1.wrptr != pipe1.buffer) &&
+                (chPipeGetUsedCount(&pipe1) == PIPE_SIZE),
+                "invalid pipe state");
+  }
+  test_end_step(4);
+
+  /* [3.3.5] Read wrapping buffer boundary.*/
+  test_set_step(5);
+  {
+    size_t n;
+    uint8_t buf[PIPE_SIZE];
+
+    n = chPipeReadTimeout(&pipe1, buf, PIPE_SIZE, TIME_IMMEDIATE);
+    test_assert(n == PIPE_SIZE, "wrong size");
+    test_assert((pipe1.rdptr == pipe1.wrptr) &&
+                (chPipeGetUsedCount(&pipe1) == 0),
+                "invalid pipe state");
+    test_assert(memcmp(pipe_pattern + 4, buf, PIPE_SIZE - 4) == 0, "content mismatch");
+    test_assert(memcmp(pipe_pattern, buf + PIPE_SIZE - 4, 4) == 0, "content mismatch");
+  }
+  test_end_step(5);
+
+  /* [3.3.6] Reading while pipe is empty.*/
+  test_set_step(6);
+  {
+    size_t n;
+    uint8_t buf[PIPE_SIZE];
+
+    n = chPipeReadTimeout(&pipe1, buf, PIPE_SIZE, TIME_IMMEDIATE);
+    test_assert(n == 0, "wrong size");
+    test_assert(chPipeGetUsedCount(&pipe1) == 0, "invalid pipe state");
+  }
+  test_end_step(6);
+
+  /* [3.3.7] Resetting pipe.*/
+  test_set_step(7);
+  {
+    size_t n;
+
+    n = chPipeWriteTimeout(&pipe1, pipe_pattern, 4, TIME_IMMEDIATE);
+    test_assert(n == 4, "wrong size");
+    chPipeReset(&pipe1);
+    test_assert((pipe1.rdptr == pipe1.buffer) &&
+                (pipe1.wrptr == pipe1.buffer) &&
+                (chPipeGetUsedCount(&pipe1) == 0),
+                "invalid pipe state");
+    chPipeResume(&pipe1);
+  }
+  test_end_step(7);
+}
+
+static const testcase_t oslib_test_003_003 = {
+  "Pipes SPSC mode",
+  oslib_test_003_003_setup,
+  NULL,
+  oslib_test_003_003_execute
+};
+
+/**
+ * @page oslib_test_003_004 [3.4] Pipes lease API
+ *
+ * <h2>Description</h2>
+ * The zero-copy pipe API is tested by leasing buffer areas for writing and
+ * reading, wrapping of the buffer boundary is also tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.4.1] Leasing write area on empty pipe.
+ * - [3.4.2] Leasing read area.
+ * - [3.4.3] Leasing write area up to buffer boundary.
+ * - [3.4.4] Leasing wrapped write area, nothing committed.
+ * - [3.4.5] Consuming all data.
+ * - [3.4.6] Leasing read area on empty pipe.
+ * .
+ */
+
+static void oslib_test_003_004_setup(void) {
+  chPipeObjectInit(&pipe1, buffer, PIPE_SIZE);
+}
+
+static void oslib_test_003_004_execute(void) {
+
+  /* [3.4.1] Leasing write area on empty pipe.*/
+  test_set_step(1);
+  {
+    size_t n;
+    uint8_t *bp;
+
+    n = chPipeWriteAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert((n == PIPE_SIZE) && (bp == pipe1.buffer), "wrong lease");
+    memcpy(bp, pipe_pattern, 4);
+    chPipeWriteCommit(&pipe1, 4);
+    test_assert((pipe1.rdptr == pipe1.buffer) &&
+                (pipe1.wrptr == pipe1.buffer + 4) &&
+                (pipe1.cnt == 4),
+                "invalid pipe state");
+  }
+  test_end_step(1);
+
+  /* [3.4.2] Leasing read area.*/
+  test_set_step(2);
+  {
+    size_t n;
+    const uint8_t *bp;
+
+    n = chPipeReadAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert((n == 4) && (bp == pipe1.buffer), "wrong lease");
+    test_assert(memcmp(pipe_pattern, bp, 4) == 0, "content mismatch");
+    chPipeReadRelease(&pipe1, 4);
+    test_assert((pipe1.rdptr == pipe1.wrptr) &&
+                (pipe1.cnt == 0),
+                "invalid pipe state");
+  }
+  test_end_step(2);
+
+  /* [3.4.3] Leasing write area up to buffer boundary.*/
+  test_set_step(3);
+  {
+    size_t n;
+    uint8_t *bp;
+
+    n = chPipeWriteAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert((n == PIPE_SIZE - 4) && (bp == pipe1.buffer + 4), "wrong lease");
+    memcpy(bp, pipe_pattern, n);
+    chPipeWriteCommit(&pipe1, n);
+    test_assert((pipe1.rdptr == pipe1.buffer + 4) &&
+                (pipe1.wrptr == pipe1.buffer) &&
+                (pipe1.cnt == PIPE_SIZE - 4),
+                "invalid pipe state");
+  }
+  test_end_step(3);
+
+  /* [3.4.4] Leasing wrapped write area, nothing committed.*/
+  test_set_step(4);
+  {
+    size_t n;
+    uint8_t *bp;
+
+    n = chPipeWriteAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert((n == 4) && (bp == pipe1.buffer), "wrong lease");
+    chPipeWriteCommit(&pipe1, 0);
+    test_assert((pipe1.wrptr == pipe1.buffer) &&
+                (pipe1.cnt == PIPE_SIZE - 4),
+                "invalid pipe state");
+  }
+  test_end_step(4);
+
+  /* [3.4.5] Consuming all data.*/
+  test_set_step(5);
+  {
+    size_t n;
+    const uint8_t *bp;
+
+    n = chPipeReadAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert((n == PIPE_SIZE - 4) && (bp == pipe1.buffer + 4), "wrong lease");
+    test_assert(memcmp(pipe_pattern, bp, n) == 0, "content mismatch");
+    chPipeReadRelease(&pipe1, n);
+    test_assert((pipe1.rdptr == pipe1.buffer) &&
+                (pipe1.wrptr == pipe1.buffer) &&
+                (pipe1.cnt == 0),
+                "invalid pipe state");
+  }
+  test_end_step(5);
+
+  /* [3.4.6] Leasing read area on empty pipe.*/
+  test_set_step(6);
+  {
+    size_t n;
+    const uint8_t *bp;
+
+    n = chPipeReadAcquireTimeout(&pipe1, &bp, TIME_IMMEDIATE);
+    test_assert(n == 0, "wrong size");
+  }
+  test_end_step(6);
+}
+
+static const testcase_t oslib_test_003_004 = {
+  "Pipes lease API",
+  oslib_test_003_004_setup,
+  NULL,
+  oslib_test_003_004_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -366,6 +623,8 @@ static const testcase_t oslib_test_003_002 = {
 const testcase_t * const oslib_test_sequence_003_array[] = {
   &oslib_test_003_001,
   &oslib_test_003_002,
+  &oslib_test_003_003,
+  &oslib_test_003_004,
   NULL
 };
 
@@ -37,6 +37,9 @@
  *
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_004_001
+ * - @subpage oslib_test_004_002
+ * - @subpage oslib_test_004_003
+ * - @subpage oslib_test_004_004
  * .
  */
 
@@ -70,6 +73,39 @@ static THD_FUNCTION(Thread1, arg) {
   } while (msg == MSG_OK);
 }
 
+#if (CH_CFG_USE_PIPELINES) || defined(__DOXYGEN__)
+#define PIPELINE_OBJS 4
+
+static objects_fifo_t pl_fifo;
+static uint32_t pl_objs[PIPELINE_OBJS];
+static msg_t pl_msgs[PIPELINE_OBJS];
+static pipeline_t pl;
+static pipeline_stage_t pl_stages[2];
+static pipeline_slot_t pl_slots[CH_PIPELINE_SLOTS(2, PIPELINE_OBJS)];
+
+static msg_t stage_filter(void *arg, void *objp) {
+  uint32_t *p = (uint32_t *)objp;
+
+  (void)arg;
+
+  test_emit_token('a' + (char)*p);
+  return (*p & 1U) != 0U ? MSG_RESET : MSG_OK;
+}
+
+static msg_t stage_add(void *arg, void *objp) {
+  uint32_t *p = (uint32_t *)objp;
+
+  test_emit_token('A' + (char)*p);
+  *p += (uint32_t)arg;
+  return MSG_OK;
+}
+
+static const pipeline_stage_config_t pl_configs[2] = {
+  {stage_filter, NULL,                 0},
+  {stage_add,    (void *)PIPELINE_OBJS, 1}
+};
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -165,6 +201,331 @@ static const testcase_t oslib_test_004_001 = {
   oslib_test_004_001_execute
 };
 
+/**
+ * @page oslib_test_004_002 [4.2] Batch posting and completion test
+ *
+ * <h2>Description</h2>
+ * A batch of jobs sharing a completion object is posted under a single
+ * lock and executed by two dispatcher threads, completion is waited for
+ * all jobs.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] Initializing the Jobs Queue object and the completion
+ *   object.
+ * - [4.2.2] Starting the dispatcher threads.
+ * - [4.2.3] Posting a batch of jobs sharing the completion object.
+ * - [4.2.4] Waiting for the completion of all jobs, no further
+ *   completions are expected.
+ * - [4.2.5] Sending two null jobs to make threads exit.
+ * .
+ */
+
+static void oslib_test_004_002_execute(void) {
+  thread_t *tp1, *tp2;
+  job_completion_t jc;
+
+  /* [4.2.1] Initializing the Jobs Queue object and the completion
+     object.*/
+  test_set_step(1);
+  {
+    chJobObjectInit(&jq, JOBS_QUEUE_SIZE, jobs, msg_queue);
+    chJobCompletionObjectInit(&jc);
+  }
+  test_end_step(1);
+
+  /* [4.2.2] Starting the dispatcher threads.*/
+  test_set_step(2);
+  {
+    thread_descriptor_t td1 = {
+      .name  = "dispatcher1",
+      .wbase = wa1Thread1,
+      .wend  = THD_WORKING_AREA_END(wa1Thread1),
+      .prio  = chThdGetPriorityX() - 1,
+      .funcp = Thread1,
+      .arg   = NULL
+    };
+    tp1 = chThdCreate(&td1);
+
+    thread_descriptor_t td2 = {
+      .name  = "dispatcher2",
+      .wbase = wa2Thread1,
+      .wend  = THD_WORKING_AREA_END(wa2Thread1),
+      .prio  = chThdGetPriorityX() - 2,
+      .funcp = Thread1,
+      .arg   = NULL
+    };
+    tp2 = chThdCreate(&td2);
+  }
+  test_end_step(2);
+
+  /* [4.2.3] Posting a batch of jobs sharing the completion object.*/
+  test_set_step(3);
+  {
+    unsigned i;
+    job_descriptor_t *jdps[JOBS_QUEUE_SIZE];
+
+    for (i = 0; i < JOBS_QUEUE_SIZE; i++) {
+      jdps[i] = chJobGet(&jq);
+      test_assert(jdps[i]->completion == NULL, "completion not cleared");
+      jdps[i]->jobfunc    = job_slow;
+      jdps[i]->jobarg     = (void *)('a' + i);
+      jdps[i]->completion = &jc;
+    }
+    chJobPostBatch(&jq, jdps, JOBS_QUEUE_SIZE);
+  }
+  test_end_step(3);
+
+  /* [4.2.4] Waiting for the completion of all jobs, no further
+     completions are expected.*/
+  test_set_step(4);
+  {
+    unsigned i;
+    msg_t msg;
+
+    for (i = 0; i < JOBS_QUEUE_SIZE; i++) {
+      msg = chJobWaitCompletionTimeout(&jc, TIME_INFINITE);
+      test_assert(msg == MSG_OK, "wrong wait message");
+    }
+    msg = chJobWaitCompletionTimeout(&jc, TIME_IMMEDIATE);
+    test_assert(msg == MSG_TIMEOUT, "unexpected completion");
+    test_assert_sequence("abcd", "unexpected tokens");
+  }
+  test_end_step(4);
+
+  /* [4.2.5] Sending two null jobs to make threads exit.*/
+  test_set_step(5);
+  {
+    job_descriptor_t *jdp;
+
+    jdp = chJobGet(&jq);
+    jdp->jobfunc = NULL;
+    jdp->jobarg  = NULL;
+    chJobPost(&jq, jdp);
+    jdp = chJobGet(&jq);
+    jdp->jobfunc = NULL;
+    jdp->jobarg  = NULL;
+    chJobPost(&jq, jdp);
+    (void) chThdWait(tp1);
+    (void) chThdWait(tp2);
+  }
+  test_end_step(5);
+}
+
+static const testcase_t oslib_test_004_002 = {
+  "Batch posting and completion test",
+  NULL,
+  NULL,
+  oslib_test_004_002_execute
+};
+
+/**
+ * @page oslib_test_004_003 [4.3] Jobs stealing test
+ *
+ * <h2>Description</h2>
+ * Jobs posted in a queue without dispatcher threads are stolen and
+ * executed by the test thread, null jobs must not be stolen.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.3.1] Initializing the Jobs Queue object.
+ * - [4.3.2] Posting two jobs, nobody is dispatching the queue.
+ * - [4.3.3] Stealing the jobs, both must be executed in order then the
+ *   queue must be empty.
+ * - [4.3.4] Posting a null job, it must not be stolen.
+ * .
+ */
+
+static void oslib_test_004_003_execute(void) {
+
+  /* [4.3.1] Initializing the Jobs Queue object.*/
+  test_set_step(1);
+  {
+    chJobObjectInit(&jq, JOBS_QUEUE_SIZE, jobs, msg_queue);
+  }
+  test_end_step(1);
+
+  /* [4.3.2] Posting two jobs, nobody is dispatching the queue.*/
+  test_set_step(2);
+  {
+    unsigned i;
+    job_descriptor_t *jdp;
+
+    for (i = 0; i < 2; i++) {
+      jdp = chJobGet(&jq);
+      jdp->jobfunc = job_slow;
+      jdp->jobarg  = (void *)('a' + i);
+      chJobPost(&jq, jdp);
+    }
+  }
+  test_end_step(2);
+
+  /* [4.3.3] Stealing the jobs, both must be executed in order then the
+     queue must be empty.*/
+  test_set_step(3);
+  {
+    msg_t msg;
+
+    msg = chJobSteal(&jq);
+    test_assert(msg == MSG_OK, "job not stolen");
+    msg = chJobSteal(&jq);
+    test_assert(msg == MSG_OK, "job not stolen");
+    msg = chJobSteal(&jq);
+    test_assert(msg == MSG_TIMEOUT, "unexpected job");
+    test_assert_sequence("ab", "unexpected tokens");
+    test_assert_lock(chGuardedPoolGetCounterI(&jq.free) == JOBS_QUEUE_SIZE,
+                     "jobs not returned");
+  }
+  test_end_step(3);
+
+  /* [4.3.4] Posting a null job, it must not be stolen.*/
+  test_set_step(4);
+  {
+    msg_t msg;
+    job_descriptor_t *jdp;
+
+    jdp = chJobGet(&jq);
+    jdp->jobfunc = NULL;
+    jdp->jobarg  = NULL;
+    chJobPost(&jq, jdp);
+    msg = chJobSteal(&jq);
+    test_assert(msg == MSG_TIMEOUT, "null job stolen");
+    msg = chJobDispatchTimeout(&jq, TIME_IMMEDIATE);
+    test_assert(msg == MSG_JOB_NULL, "null job lost");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_004_003 = {
+  "Jobs stealing test",
+  NULL,
+  NULL,
+  oslib_test_004_003_execute
+};
+
+#if (CH_CFG_USE_PIPELINES) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_004_004 [4.4] Pipeline test
+ *
+ * <h2>Description</h2>
+ * A two stages pipeline is executed by stealing its jobs from a queue
+ * without dispatcher threads, buffers order, dropping, backpressure and
+ * counters are checked.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_PIPELINES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [4.4.1] Initializing the objects FIFO, the Jobs Queue and a two
+ *   stages pipeline, the second stage accepts one queued buffer.
+ * - [4.4.2] Submitting four buffers, nobody is dispatching the queue.
+ * - [4.4.3] Stealing the stage jobs, the buffers must flow in order and
+ *   the odd values must be dropped by the first stage.
+ * - [4.4.4] Receiving the buffers from the sink, both must have been
+ *   processed by the second stage.
+ * - [4.4.5] Checking the stages counters, the first stage stalled twice
+ *   on the depth limit of the second stage.
+ * .
+ */
+
+static void oslib_test_004_004_execute(void) {
+
+  /* [4.4.1] Initializing the objects FIFO, the Jobs Queue and a two
+     stages pipeline, the second stage accepts one queued buffer.*/
+  test_set_step(1);
+  {
+    chFifoObjectInit(&pl_fifo, sizeof (uint32_t), PIPELINE_OBJS,
+                     pl_objs, pl_msgs);
+    chJobObjectInit(&jq, JOBS_QUEUE_SIZE, jobs, msg_queue);
+    chPipelineObjectInit(&pl, &pl_fifo, &jq, pl_stages, pl_configs, 2,
+                         pl_slots, true);
+  }
+  test_end_step(1);
+
+  /* [4.4.2] Submitting four buffers, nobody is dispatching the queue.*/
+  test_set_step(2);
+  {
+    uint32_t i, *p;
+
+    for (i = 0; i < PIPELINE_OBJS; i++) {
+      p = (uint32_t *)chPipelineTakeObjectTimeout(&pl, TIME_IMMEDIATE);
+      test_assert(p != NULL, "buffer not available");
+      *p = i;
+      chPipelineSubmit(&pl, (void *)p);
+    }
+    test_assert(chPipelineTakeObjectTimeout(&pl, TIME_IMMEDIATE) == NULL,
+                "unexpected buffer");
+  }
+  test_end_step(2);
+
+  /* [4.4.3] Stealing the stage jobs, the buffers must flow in order and
+     the odd values must be dropped by the first stage.*/
+  test_set_step(3);
+  {
+    unsigned n = 0;
+
+    while (chJobSteal(&jq) == MSG_OK) {
+      n++;
+    }
+    test_assert(n == 6, "wrong number of jobs");
+    test_assert_sequence("aAbcCd", "unexpected tokens");
+    test_assert_lock(chGuardedPoolGetCounterI(&jq.free) == JOBS_QUEUE_SIZE,
+                     "jobs not returned");
+  }
+  test_end_step(3);
+
+  /* [4.4.4] Receiving the buffers from the sink, both must have been
+     processed by the second stage.*/
+  test_set_step(4);
+  {
+    uint32_t *p;
+    msg_t msg;
+
+    msg = chPipelineReceiveObjectTimeout(&pl, (void **)&p, TIME_IMMEDIATE);
+    test_assert(msg == MSG_OK, "buffer not received");
+    test_assert(*p == PIPELINE_OBJS, "wrong value");
+    chPipelineReturnObject(&pl, (void *)p);
+    msg = chPipelineReceiveObjectTimeout(&pl, (void **)&p, TIME_IMMEDIATE);
+    test_assert(msg == MSG_OK, "buffer not received");
+    test_assert(*p == PIPELINE_OBJS + 2, "wrong value");
+    chPipelineReturnObject(&pl, (void *)p);
+    msg = chPipelineReceiveObjectTimeout(&pl, (void **)&p, TIME_IMMEDIATE);
+    test_assert(msg == MSG_TIMEOUT, "unexpected buffer");
+    test_assert_lock(chGuardedPoolGetCounterI(&pl_fifo.free) == PIPELINE_OBJS,
+                     "buffers not returned");
+  }
+  test_end_step(4);
+
+  /* [4.4.5] Checking the stages counters, the first stage stalled twice
+     on the depth limit of the second stage.*/
+  test_set_step(5);
+  {
+    const pipeline_stats_t *sp;
+
+    sp = chPipelineGetStatsX(&pl, 0);
+    test_assert(sp->processed == 4, "wrong processed counter");
+    test_assert(sp->dropped == 2, "wrong dropped counter");
+    test_assert(sp->stalls == 2, "wrong stalls counter");
+    sp = chPipelineGetStatsX(&pl, 1);
+    test_assert(sp->processed == 2, "wrong processed counter");
+    test_assert(sp->dropped == 0, "wrong dropped counter");
+    test_assert(sp->stalls == 0, "wrong stalls counter");
+    chPipelineResetStats(&pl);
+    test_assert(chPipelineGetStatsX(&pl, 0)->processed == 0,
+                "counters not cleared");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t oslib_test_004_004 = {
+  "Pipeline test",
+  NULL,
+  NULL,
+  oslib_test_004_004_execute
+};
+#endif /* CH_CFG_USE_PIPELINES */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -174,6 +535,11 @@ static const testcase_t oslib_test_004_001 = {
  */
 const testcase_t * const oslib_test_sequence_004_array[] = {
   &oslib_test_004_001,
+  &oslib_test_004_002,
+  &oslib_test_004_003,
+#if (CH_CFG_USE_PIPELINES) || defined(__DOXYGEN__)
+  &oslib_test_004_004,
+#endif
   NULL
 };
 
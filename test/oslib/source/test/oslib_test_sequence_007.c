@@ -39,6 +39,7 @@
  * - @subpage oslib_test_007_001
  * - @subpage oslib_test_007_002
  * - @subpage oslib_test_007_003
+ * - @subpage oslib_test_007_004
  * .
  */
 
@@ -288,6 +289,94 @@ static const testcase_t oslib_test_007_003 = {
 };
 #endif /* CH_CFG_USE_SEMAPHORES */
 
+/**
+ * @page oslib_test_007_004 [7.4] Memory Pools magazines
+ *
+ * <h2>Description</h2>
+ * The memory pool magazines functionality is tested by allocating and
+ * releasing objects through a magazine, refill, drain and flush operations
+ * are tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [7.4.1] Adding the objects to the pool and initializing the
+ *   magazine.
+ * - [7.4.2] Emptying the pool through the magazine, the last allocation
+ *   must fail.
+ * - [7.4.3] Releasing all the objects, the magazine must keep at most
+ *   its capacity.
+ * - [7.4.4] Flushing the magazine, all objects must be back in the
+ *   pool.
+ * .
+ */
+
+static void oslib_test_007_004_setup(void) {
+  chPoolObjectInit(&mp1, sizeof (uint32_t), NULL);
+}
+
+static void oslib_test_007_004_execute(void) {
+  pool_magazine_t pm1;
+
+  /* [7.4.1] Adding the objects to the pool and initializing the
+     magazine.*/
+  test_set_step(1);
+  {
+    chPoolLoadArray(&mp1, objects, MEMORY_POOL_SIZE);
+    chPoolMagazineObjectInit(&pm1, &mp1, 2);
+    test_assert((pm1.cnt == 0) && (pm1.next == NULL), "not empty");
+  }
+  test_end_step(1);
+
+  /* [7.4.2] Emptying the pool through the magazine, the last allocation
+     must fail.*/
+  test_set_step(2);
+  {
+    unsigned i;
+
+    for (i = 0; i < MEMORY_POOL_SIZE; i++) {
+      test_assert(chPoolMagazineAlloc(&pm1) != NULL, "list empty");
+    }
+    test_assert(chPoolMagazineAlloc(&pm1) == NULL, "list not empty");
+    test_assert(mp1.next == NULL, "pool not empty");
+  }
+  test_end_step(2);
+
+  /* [7.4.3] Releasing all the objects, the magazine must keep at most
+     its capacity.*/
+  test_set_step(3);
+  {
+    unsigned i;
+
+    for (i = 0; i < MEMORY_POOL_SIZE; i++) {
+      chPoolMagazineFree(&pm1, &objects[i]);
+      test_assert(pm1.cnt <= 2, "magazine overflow");
+    }
+    test_assert(pm1.cnt == 2, "wrong magazine content");
+  }
+  test_end_step(3);
+
+  /* [7.4.4] Flushing the magazine, all objects must be back in the
+     pool.*/
+  test_set_step(4);
+  {
+    unsigned i;
+
+    chPoolMagazineFlush(&pm1);
+    test_assert((pm1.cnt == 0) && (pm1.next == NULL), "not empty");
+    for (i = 0; i < MEMORY_POOL_SIZE; i++) {
+      test_assert(chPoolAlloc(&mp1) != NULL, "list empty");
+    }
+    test_assert(chPoolAlloc(&mp1) == NULL, "list not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t oslib_test_007_004 = {
+  "Memory Pools magazines",
+  oslib_test_007_004_setup,
+  NULL,
+  oslib_test_007_004_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -303,6 +392,7 @@ const testcase_t * const oslib_test_sequence_007_array[] = {
 #if (CH_CFG_USE_SEMAPHORES) || defined(__DOXYGEN__)
   &oslib_test_007_003,
 #endif
+  &oslib_test_007_004,
   NULL
 };
 
@@ -38,6 +38,7 @@
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_008_001
  * - @subpage oslib_test_008_002
+ * - @subpage oslib_test_008_003
  * .
  */
 
@@ -48,7 +49,11 @@
  ****************************************************************************/
 
 #define ALLOC_SIZE 16
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+#define HEAP_SIZE (ALLOC_SIZE * 16)
+#else
 #define HEAP_SIZE (ALLOC_SIZE * 8)
+#endif
 
 static memory_heap_t test_heap;
 static uint8_t test_heap_buffer[HEAP_SIZE];
@@ -268,6 +273,96 @@ static const testcase_t oslib_test_008_002 = {
   oslib_test_008_002_execute
 };
 
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_008_003 [8.3] Allocations profiling
+ *
+ * <h2>Description</h2>
+ * The allocations profiler is tested, allocations and releases from a
+ * call site are accounted to the call site.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_DBG_MEM_PROFILING == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [8.3.1] Two blocks are allocated from the same call site, the call
+ *   site must account both blocks to the current thread.
+ * - [8.3.2] One block is freed, the live size must decrease and the
+ *   peak size must not change.
+ * - [8.3.3] The other block is freed and the profiler is reset, the
+ *   call site must remain in the table with cleared counters.
+ * .
+ */
+
+static void oslib_test_008_003_setup(void) {
+  chHeapObjectInit(&test_heap, test_heap_buffer, sizeof(test_heap_buffer));
+}
+
+static void oslib_test_008_003_execute(void) {
+  void *p[2];
+  memprof_site_t site;
+  unsigned i;
+
+  /* [8.3.1] Two blocks are allocated from the same call site, the call
+     site must account both blocks to the current thread.*/
+  test_set_step(1);
+  {
+    chMemProfReset();
+    for (i = 0U; i < 2U; i++) {
+      p[i] = chHeapAlloc(&test_heap, ALLOC_SIZE);
+      test_assert(p[i] != NULL, "allocation failed");
+    }
+    for (i = 0U; i < (unsigned)CH_DBG_MEM_PROFILING_SITES; i++) {
+      if (chMemProfReadSite(i, &site) &&
+          (site.allocator == CH_MEMPROF_HEAP) && (site.allocs == 2U)) {
+        break;
+      }
+    }
+    test_assert(i < (unsigned)CH_DBG_MEM_PROFILING_SITES, "call site not found");
+    test_assert(site.live == ALLOC_SIZE * 2U, "wrong live size");
+    test_assert(site.peak == ALLOC_SIZE * 2U, "wrong peak size");
+    test_assert(site.tp == chThdGetSelfX(), "wrong thread");
+    test_assert(chHeapGetOwnerX(p[0]) == chThdGetSelfX(), "wrong owner");
+  }
+  test_end_step(1);
+
+  /* [8.3.2] One block is freed, the live size must decrease and the
+     peak size must not change.*/
+  test_set_step(2);
+  {
+    chHeapFree(p[0]);
+    (void) chMemProfReadSite(i, &site);
+    test_assert(site.frees == 1U, "wrong frees counter");
+    test_assert(site.live == ALLOC_SIZE, "wrong live size");
+    test_assert(site.peak == ALLOC_SIZE * 2U, "wrong peak size");
+  }
+  test_end_step(2);
+
+  /* [8.3.3] The other block is freed and the profiler is reset, the
+     call site must remain in the table with cleared counters.*/
+  test_set_step(3);
+  {
+    chHeapFree(p[1]);
+    chMemProfReset();
+    test_assert(chMemProfReadSite(i, &site), "call site removed");
+    test_assert(site.allocs == 0U, "allocations counter not cleared");
+    test_assert(site.live == 0U, "wrong live size");
+    test_assert(site.peak == 0U, "peak size not cleared");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t oslib_test_008_003 = {
+  "Allocations profiling",
+  oslib_test_008_003_setup,
+  NULL,
+  oslib_test_008_003_execute
+};
+#endif /* CH_DBG_MEM_PROFILING == TRUE */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -278,6 +373,9 @@ static const testcase_t oslib_test_008_002 = {
 const testcase_t * const oslib_test_sequence_008_array[] = {
   &oslib_test_008_001,
   &oslib_test_008_002,
+#if (CH_DBG_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_008_003,
+#endif
   NULL
 };
 
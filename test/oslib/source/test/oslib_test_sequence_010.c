@@ -0,0 +1,523 @@
+/*
+    ChibiOS - Copyright (C) 2006..2017 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "oslib_test_root.h"
+
+/**
+ * @file    oslib_test_sequence_010.c
+ * @brief   Test Sequence 010 code.
+ *
+ * @page oslib_test_sequence_010 [10] Benchmarks
+ *
+ * File: @ref oslib_test_sequence_010.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures the throughput of the library communication
+ * primitives while the number of producer and consumer threads, the
+ * payload size and the priority of the consumers relative to the
+ * producers vary. Each configuration is measured over a fixed time
+ * window, the results are printed as comma separated lines starting
+ * with "--- BMK," in order to be extracted from the test log, the
+ * fields are primitive, producers, consumers, payload size in bytes,
+ * consumers priority and transfers per second.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_MAILBOXES == TRUE) || (CH_CFG_USE_PIPES == TRUE)
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage oslib_test_010_001
+ * - @subpage oslib_test_010_002
+ * - @subpage oslib_test_010_003
+ * - @subpage oslib_test_010_004
+ * .
+ */
+
+#if ((CH_CFG_USE_MAILBOXES == TRUE) || (CH_CFG_USE_PIPES == TRUE)) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+#define BMK_WINDOW_MS               100
+#define BMK_TIMEOUT                 TIME_MS2I(5)
+#define BMK_WA_SIZE                 256
+#define BMK_MAX_THREADS             4
+#define BMK_QUEUE_SIZE              8
+#define BMK_MAX_PAYLOAD             64
+
+typedef struct {
+  const char    *name;
+  void          (*init)(void);
+  void          (*produce)(size_t size);
+  size_t        (*consume)(size_t size);
+} bmk_primitive_t;
+
+static const char * const bmk_prio_names[3] = {"lower", "same", "higher"};
+
+static THD_WORKING_AREA(bmk_wa0, BMK_WA_SIZE);
+static THD_WORKING_AREA(bmk_wa1, BMK_WA_SIZE);
+static THD_WORKING_AREA(bmk_wa2, BMK_WA_SIZE);
+static THD_WORKING_AREA(bmk_wa3, BMK_WA_SIZE);
+static void * const bmk_wa[BMK_MAX_THREADS] = {bmk_wa0, bmk_wa1,
+                                               bmk_wa2, bmk_wa3};
+static thread_t *bmk_threads[BMK_MAX_THREADS];
+static volatile uint32_t bmk_bytes[BMK_MAX_THREADS];
+static const bmk_primitive_t *bmk_primp;
+static size_t bmk_size;
+
+static uint8_t bmk_payload[BMK_MAX_PAYLOAD];
+static uint8_t bmk_sink[BMK_MAX_PAYLOAD];
+
+#if (CH_CFG_USE_MAILBOXES == TRUE) || defined(__DOXYGEN__)
+static mailbox_t bmk_mb;
+static msg_t bmk_mb_buffer[BMK_QUEUE_SIZE];
+
+static void bmk_mb_init(void) {
+
+  chMBObjectInit(&bmk_mb, bmk_mb_buffer, BMK_QUEUE_SIZE);
+}
+
+static void bmk_mb_produce(size_t size) {
+
+  (void)size;
+  (void)chMBPostTimeout(&bmk_mb, (msg_t)0x55, BMK_TIMEOUT);
+}
+
+static size_t bmk_mb_consume(size_t size) {
+  msg_t msg;
+
+  if (chMBFetchTimeout(&bmk_mb, &msg, BMK_TIMEOUT) == MSG_OK) {
+    return size;
+  }
+  return 0U;
+}
+
+static const bmk_primitive_t bmk_mailbox = {
+  "mailbox", bmk_mb_init, bmk_mb_produce, bmk_mb_consume
+};
+#endif
+
+#if (CH_CFG_USE_OBJ_FIFOS == TRUE) || defined(__DOXYGEN__)
+static objects_fifo_t bmk_fifo;
+static msg_t bmk_fifo_msgs[BMK_QUEUE_SIZE];
+static msg_t bmk_fifo_objects[BMK_QUEUE_SIZE][BMK_MAX_PAYLOAD / sizeof (msg_t)];
+
+static void bmk_fifo_init(void) {
+
+  chFifoObjectInit(&bmk_fifo, sizeof bmk_fifo_objects[0], BMK_QUEUE_SIZE,
+                   bmk_fifo_objects, bmk_fifo_msgs);
+}
+
+static void bmk_fifo_produce(size_t size) {
+  void *objp;
+
+  objp = chFifoTakeObjectTimeout(&bmk_fifo, BMK_TIMEOUT);
+  if (objp != NULL) {
+    memcpy(objp, bmk_payload, size);
+    chFifoSendObject(&bmk_fifo, objp);
+  }
+}
+
+static size_t bmk_fifo_consume(size_t size) {
+  void *objp;
+
+  if (chFifoReceiveObjectTimeout(&bmk_fifo, &objp, BMK_TIMEOUT) == MSG_OK) {
+    memcpy(bmk_sink, objp, size);
+    chFifoReturnObject(&bmk_fifo, objp);
+    return size;
+  }
+  return 0U;
+}
+
+static const bmk_primitive_t bmk_objects_fifo = {
+  "objects_fifo", bmk_fifo_init, bmk_fifo_produce, bmk_fifo_consume
+};
+#endif
+
+#if (CH_CFG_USE_PIPES == TRUE) || defined(__DOXYGEN__)
+static pipe_t bmk_pipe;
+static uint8_t bmk_pipe_buffer[BMK_QUEUE_SIZE * BMK_MAX_PAYLOAD / 4U];
+
+static void bmk_pipe_init(void) {
+
+  chPipeObjectInit(&bmk_pipe, bmk_pipe_buffer, sizeof bmk_pipe_buffer);
+}
+
+static void bmk_pipe_produce(size_t size) {
+
+  (void)chPipeWriteTimeout(&bmk_pipe, bmk_payload, size, BMK_TIMEOUT);
+}
+
+static size_t bmk_pipe_consume(size_t size) {
+
+  return chPipeReadTimeout(&bmk_pipe, bmk_sink, size, BMK_TIMEOUT);
+}
+
+static const bmk_primitive_t bmk_pipes = {
+  "pipe", bmk_pipe_init, bmk_pipe_produce, bmk_pipe_consume
+};
+#endif
+
+#if (CH_CFG_USE_JOBS == TRUE) || defined(__DOXYGEN__)
+static jobs_queue_t bmk_jq;
+static job_descriptor_t bmk_jobs[BMK_QUEUE_SIZE];
+static msg_t bmk_jobs_msgs[BMK_QUEUE_SIZE];
+
+static void bmk_job(void *arg) {
+
+  (void)arg;
+}
+
+static void bmk_jobs_init(void) {
+
+  chJobObjectInit(&bmk_jq, BMK_QUEUE_SIZE, bmk_jobs, bmk_jobs_msgs);
+}
+
+static void bmk_jobs_produce(size_t size) {
+  job_descriptor_t *jdp;
+
+  (void)size;
+  jdp = chJobGetTimeout(&bmk_jq, BMK_TIMEOUT);
+  if (jdp != NULL) {
+    jdp->jobfunc = bmk_job;
+    jdp->jobarg  = (void *)bmk_payload;
+    chJobPost(&bmk_jq, jdp);
+  }
+}
+
+static size_t bmk_jobs_consume(size_t size) {
+
+  if (chJobDispatchTimeout(&bmk_jq, BMK_TIMEOUT) == MSG_OK) {
+    return size;
+  }
+  return 0U;
+}
+
+static const bmk_primitive_t bmk_jobs_queue = {
+  "jobs", bmk_jobs_init, bmk_jobs_produce, bmk_jobs_consume
+};
+#endif
+
+static THD_FUNCTION(bmk_producer, arg) {
+
+  (void)arg;
+  while (!chThdShouldTerminateX()) {
+    bmk_primp->produce(bmk_size);
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  }
+}
+
+static THD_FUNCTION(bmk_consumer, arg) {
+  volatile uint32_t *bp = (volatile uint32_t *)arg;
+
+  while (!chThdShouldTerminateX()) {
+    *bp += (uint32_t)bmk_primp->consume(bmk_size);
+#if defined(SIMULATOR)
+    _sim_check_for_interrupts();
+#endif
+  }
+}
+
+static uint32_t bmk_get_bytes(unsigned consumers) {
+  uint32_t bytes = 0U;
+  unsigned i;
+
+  for (i = 0U; i < consumers; i++) {
+    bytes += bmk_bytes[i];
+  }
+  return bytes;
+}
+
+/*
+ * Runs a single configuration, producers run two priority levels below
+ * the test thread, consumers one level below, at the same level or one
+ * level above the producers. Returns the transfers per second.
+ */
+static uint32_t bmk_run(const bmk_primitive_t *primp, unsigned producers,
+                        unsigned consumers, size_t size, unsigned prio) {
+  tprio_t pprio = chThdGetPriorityX() - 2;
+  systime_t start;
+  uint32_t bytes;
+  unsigned i;
+
+  bmk_primp = primp;
+  bmk_size  = size;
+  primp->init();
+  for (i = 0U; i < consumers; i++) {
+    bmk_bytes[i] = 0U;
+    bmk_threads[i] = chThdCreateStatic(bmk_wa[i],
+                                       THD_WORKING_AREA_SIZE(BMK_WA_SIZE),
+                                       pprio - 1 + (tprio_t)prio,
+                                       bmk_consumer, (void *)&bmk_bytes[i]);
+  }
+  for (i = consumers; i < consumers + producers; i++) {
+    bmk_threads[i] = chThdCreateStatic(bmk_wa[i],
+                                       THD_WORKING_AREA_SIZE(BMK_WA_SIZE),
+                                       pprio, bmk_producer, NULL);
+  }
+
+  /* The threads run while the test thread sleeps, the first tick lets
+     the pipeline settle.*/
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTime();
+  bytes = bmk_get_bytes(consumers);
+  chThdSleepUntil(chTimeAddX(start, TIME_MS2I(BMK_WINDOW_MS)));
+  bytes = bmk_get_bytes(consumers) - bytes;
+
+  for (i = 0U; i < consumers + producers; i++) {
+    chThdTerminate(bmk_threads[i]);
+  }
+  for (i = 0U; i < consumers + producers; i++) {
+    (void)chThdWait(bmk_threads[i]);
+  }
+
+  return (uint32_t)(bytes / size) * (1000U / BMK_WINDOW_MS);
+}
+
+/*
+ * Runs all the combinations of 1 or 2 producers, 1 or 2 consumers, the
+ * specified payload sizes and the three consumers priorities.
+ */
+static void bmk_matrix(const bmk_primitive_t *primp,
+                       const size_t *sizes, unsigned nsizes) {
+  unsigned s, p, c, prio;
+
+  test_println("--- BMK,primitive,producers,consumers,size,prio,ops_per_s");
+  for (s = 0U; s < nsizes; s++) {
+    for (p = 1U; p <= BMK_MAX_THREADS / 2U; p++) {
+      for (c = 1U; c <= BMK_MAX_THREADS / 2U; c++) {
+        for (prio = 0U; prio < 3U; prio++) {
+          uint32_t n = bmk_run(primp, p, c, sizes[s], prio);
+
+          test_print("--- BMK,");
+          test_print(primp->name);
+          test_print(",");
+          test_printn(p);
+          test_print(",");
+          test_printn(c);
+          test_print(",");
+          test_printn((uint32_t)sizes[s]);
+          test_print(",");
+          test_print(bmk_prio_names[prio]);
+          test_print(",");
+          test_printn(n);
+          test_println("");
+        }
+      }
+    }
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+#if (CH_CFG_USE_MAILBOXES) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_010_001 [10.1] Mailboxes throughput
+ *
+ * <h2>Description</h2>
+ * The messages throughput of a mailbox is measured for all the
+ * combinations of producers, consumers and priorities, the payload is a
+ * single message.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MAILBOXES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [10.1.1] Running the benchmark matrix.
+ * .
+ */
+
+static void oslib_test_010_001_execute(void) {
+  /* [10.1.1] Running the benchmark matrix.*/
+  test_set_step(1);
+  {
+    static const size_t sizes[] = {sizeof (msg_t)};
+
+    bmk_matrix(&bmk_mailbox, sizes, 1U);
+  }
+  test_end_step(1);
+}
+
+static const testcase_t oslib_test_010_001 = {
+  "Mailboxes throughput",
+  NULL,
+  NULL,
+  oslib_test_010_001_execute
+};
+#endif /* CH_CFG_USE_MAILBOXES */
+
+#if (CH_CFG_USE_OBJ_FIFOS) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_010_002 [10.2] Objects FIFOs throughput
+ *
+ * <h2>Description</h2>
+ * The objects throughput of an objects FIFO is measured for all the
+ * combinations of producers, consumers, payload sizes and priorities,
+ * the payload is copied into and out of the objects.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_OBJ_FIFOS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [10.2.1] Running the benchmark matrix.
+ * .
+ */
+
+static void oslib_test_010_002_execute(void) {
+  /* [10.2.1] Running the benchmark matrix.*/
+  test_set_step(1);
+  {
+    static const size_t sizes[] = {4U, 16U, BMK_MAX_PAYLOAD};
+
+    bmk_matrix(&bmk_objects_fifo, sizes, 3U);
+  }
+  test_end_step(1);
+}
+
+static const testcase_t oslib_test_010_002 = {
+  "Objects FIFOs throughput",
+  NULL,
+  NULL,
+  oslib_test_010_002_execute
+};
+#endif /* CH_CFG_USE_OBJ_FIFOS */
+
+#if (CH_CFG_USE_PIPES) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_010_003 [10.3] Pipes throughput
+ *
+ * <h2>Description</h2>
+ * The throughput of a pipe is measured for all the combinations of
+ * producers, consumers, transfer sizes and priorities, the result is in
+ * transfers of the specified size per second.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_PIPES
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [10.3.1] Running the benchmark matrix.
+ * .
+ */
+
+static void oslib_test_010_003_execute(void) {
+  /* [10.3.1] Running the benchmark matrix.*/
+  test_set_step(1);
+  {
+    static const size_t sizes[] = {1U, 16U, BMK_MAX_PAYLOAD};
+
+    bmk_matrix(&bmk_pipes, sizes, 3U);
+  }
+  test_end_step(1);
+}
+
+static const testcase_t oslib_test_010_003 = {
+  "Pipes throughput",
+  NULL,
+  NULL,
+  oslib_test_010_003_execute
+};
+#endif /* CH_CFG_USE_PIPES */
+
+#if (CH_CFG_USE_JOBS) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_010_004 [10.4] Jobs Queues throughput
+ *
+ * <h2>Description</h2>
+ * The jobs throughput of a jobs queue is measured for all the
+ * combinations of posting threads, dispatcher threads and priorities,
+ * the jobs are empty functions receiving a pointer argument.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_JOBS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [10.4.1] Running the benchmark matrix.
+ * .
+ */
+
+static void oslib_test_010_004_execute(void) {
+  /* [10.4.1] Running the benchmark matrix.*/
+  test_set_step(1);
+  {
+    static const size_t sizes[] = {sizeof (void *)};
+
+    bmk_matrix(&bmk_jobs_queue, sizes, 1U);
+  }
+  test_end_step(1);
+}
+
+static const testcase_t oslib_test_010_004 = {
+  "Jobs Queues throughput",
+  NULL,
+  NULL,
+  oslib_test_010_004_execute
+};
+#endif /* CH_CFG_USE_JOBS */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const oslib_test_sequence_010_array[] = {
+#if (CH_CFG_USE_MAILBOXES) || defined(__DOXYGEN__)
+  &oslib_test_010_001,
+#endif
+#if (CH_CFG_USE_OBJ_FIFOS) || defined(__DOXYGEN__)
+  &oslib_test_010_002,
+#endif
+#if (CH_CFG_USE_PIPES) || defined(__DOXYGEN__)
+  &oslib_test_010_003,
+#endif
+#if (CH_CFG_USE_JOBS) || defined(__DOXYGEN__)
+  &oslib_test_010_004,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t oslib_test_sequence_010 = {
+  "Benchmarks",
+  oslib_test_sequence_010_array
+};
+
+#endif /* (CH_CFG_USE_MAILBOXES == TRUE) || (CH_CFG_USE_PIPES == TRUE) */
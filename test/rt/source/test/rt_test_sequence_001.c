@@ -33,6 +33,7 @@
  * - @subpage rt_test_001_001
  * - @subpage rt_test_001_002
  * - @subpage rt_test_001_003
+ * - @subpage rt_test_001_004
  * .
  */
 
@@ -269,6 +270,63 @@ static const testcase_t rt_test_001_003 = {
   rt_test_001_003_execute
 };
 
+/**
+ * @page rt_test_001_004 [1.4] Objects Size
+ *
+ * <h2>Description</h2>
+ * The size of the kernel objects is reported, the report depends on the
+ * configuration options.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.4.1] Prints the size of the kernel objects.
+ * .
+ */
+
+static void rt_test_001_004_execute(void) {
+
+  /* [1.4.1] Prints the size of the kernel objects.*/
+  test_set_step(1);
+  {
+    test_print("--- sizeof (thread_t):                  ");
+    test_printn(sizeof (thread_t));
+    test_println("");
+    test_print("--- sizeof (virtual_timer_t):           ");
+    test_printn(sizeof (virtual_timer_t));
+    test_println("");
+    #if CH_CFG_USE_SEMAPHORES == TRUE
+    test_print("--- sizeof (semaphore_t):               ");
+    test_printn(sizeof (semaphore_t));
+    test_println("");
+    #endif
+    #if CH_CFG_USE_MUTEXES == TRUE
+    test_print("--- sizeof (mutex_t):                   ");
+    test_printn(sizeof (mutex_t));
+    test_println("");
+    #endif
+    #if CH_CFG_USE_CONDVARS == TRUE
+    test_print("--- sizeof (condition_variable_t):      ");
+    test_printn(sizeof (condition_variable_t));
+    test_println("");
+    #endif
+    #if CH_CFG_USE_EVENTS == TRUE
+    test_print("--- sizeof (event_source_t):            ");
+    test_printn(sizeof (event_source_t));
+    test_println("");
+    test_print("--- sizeof (event_listener_t):          ");
+    test_printn(sizeof (event_listener_t));
+    test_println("");
+    #endif
+  }
+  test_end_step(1);
+}
+
+static const testcase_t rt_test_001_004 = {
+  "Objects Size",
+  NULL,
+  NULL,
+  rt_test_001_004_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -280,6 +338,7 @@ const testcase_t * const rt_test_sequence_001_array[] = {
   &rt_test_001_001,
   &rt_test_001_002,
   &rt_test_001_003,
+  &rt_test_001_004,
   NULL
 };
 
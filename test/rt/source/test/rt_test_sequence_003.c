@@ -32,6 +32,9 @@
  * <h2>Test Cases</h2>
  * - @subpage rt_test_003_001
  * - @subpage rt_test_003_002
+ * - @subpage rt_test_003_003
+ * - @subpage rt_test_003_004
+ * - @subpage rt_test_003_005
  * .
  */
 
@@ -153,6 +156,270 @@ static const testcase_t rt_test_003_002 = {
   rt_test_003_002_execute
 };
 
+#if ((CH_CFG_USE_TM == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_003_003 [3.3] Named measurements functionality.
+ *
+ * <h2>Description</h2>
+ * The named measurements registry and the percentiles computation are
+ * tested.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] Registering two measurements, the registry is expected to
+ *   contain both in reverse registration order.
+ * - [3.3.2] Adding the samples from 1 to 1000, percentiles must be
+ *   within the histogram resolution.
+ * - [3.3.3] Performing a single measurement, all percentiles are
+ *   expected to match the measurement.
+ * - [3.3.4] Exporting the registry, the summaries are expected to match
+ *   the measurements.
+ * - [3.3.5] Unregistering the measurements, the registry is expected to
+ *   be empty.
+ * .
+ */
+
+static void rt_test_003_003_execute(void) {
+  static named_measurement_t nm1, nm2;
+  tm_summary_t ts[3];
+  rtcnt_t x;
+
+  /* [3.3.1] Registering two measurements, the registry is expected to
+     contain both in reverse registration order.*/
+  test_set_step(1);
+  {
+    chTMRegister(&nm1, "nm1");
+    chTMRegister(&nm2, "nm2");
+    test_assert(chTMRegistryFirstX() == &nm2, "not first");
+    test_assert(chTMRegistryNextX(&nm2) == &nm1, "not next");
+  }
+  test_end_step(1);
+
+  /* [3.3.2] Adding the samples from 1 to 1000, percentiles must be
+     within the histogram resolution.*/
+  test_set_step(2);
+  {
+    for (x = (rtcnt_t)1; x <= (rtcnt_t)1000; x++) {
+      chTMAddNamedSampleX(&nm1, x);
+    }
+    test_assert(nm1.tm.n == (ucnt_t)1000, "wrong count");
+    test_assert(nm1.tm.best == (rtcnt_t)1, "wrong best");
+    test_assert(nm1.tm.worst == (rtcnt_t)1000, "wrong worst");
+    x = chTMGetPercentileX(&nm1, 500U);
+    test_assert((x >= (rtcnt_t)500) && (x <= (rtcnt_t)625), "wrong p50");
+    x = chTMGetPercentileX(&nm1, 990U);
+    test_assert((x >= (rtcnt_t)990) && (x <= (rtcnt_t)1000), "wrong p99");
+    x = chTMGetPercentileX(&nm1, 1000U);
+    test_assert(x == (rtcnt_t)1000, "wrong p100");
+    x = chTMGetPercentileX(&nm1, 0U);
+    test_assert(x == (rtcnt_t)1, "wrong p0");
+  }
+  test_end_step(2);
+
+  /* [3.3.3] Performing a single measurement, all percentiles are
+     expected to match the measurement.*/
+  test_set_step(3);
+  {
+    chTMStartNamedMeasurementX(&nm2);
+    chTMStopNamedMeasurementX(&nm2);
+    test_assert(nm2.tm.n == (ucnt_t)1, "wrong count");
+    test_assert(chTMGetPercentileX(&nm2, 500U) == nm2.tm.last, "wrong p50");
+    test_assert(chTMGetPercentileX(&nm2, 999U) == nm2.tm.last, "wrong p999");
+  }
+  test_end_step(3);
+
+  /* [3.3.4] Exporting the registry, the summaries are expected to match
+     the measurements.*/
+  test_set_step(4);
+  {
+    test_assert(chTMExportRegistry(ts, 3U) == 2U, "wrong export count");
+    test_assert(ts[0].n == (ucnt_t)1, "wrong summary");
+    test_assert(ts[1].n == (ucnt_t)1000, "wrong summary");
+    test_assert(ts[1].p50 == chTMGetPercentileX(&nm1, 500U), "wrong summary");
+    test_assert(ts[1].p999 <= ts[1].worst, "wrong summary");
+  }
+  test_end_step(4);
+
+  /* [3.3.5] Unregistering the measurements, the registry is expected to
+     be empty.*/
+  test_set_step(5);
+  {
+    chTMUnregister(&nm2);
+    test_assert(chTMRegistryFirstX() == &nm1, "not first");
+    chTMUnregister(&nm1);
+    test_assert(chTMRegistryFirstX() == NULL, "not empty");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t rt_test_003_003 = {
+  "Named measurements functionality.",
+  NULL,
+  NULL,
+  rt_test_003_003_execute
+};
+#endif /* (CH_CFG_USE_TM == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE) */
+
+/**
+ * @page rt_test_003_004 [3.4] Time conversions functionality
+ *
+ * <h2>Description</h2>
+ * The time conversion functions and macros are compared with the
+ * reference formulas using a division by the system tick frequency.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.4.1] Converting milliseconds and microseconds to intervals, the
+ *   results are expected to match the reference formulas.
+ * - [3.4.2] Converting intervals to seconds, milliseconds and
+ *   microseconds, the results are expected to match the reference
+ *   formulas.
+ * .
+ */
+
+static void rt_test_003_004_execute(void) {
+  time_conv_t x, ref;
+
+  /* [3.4.1] Converting milliseconds and microseconds to intervals, the
+     results are expected to match the reference formulas.*/
+  test_set_step(1);
+  {
+    for (x = (time_conv_t)0; x <= (time_conv_t)0xFFFF; x++) {
+      ref = ((x * (time_conv_t)CH_CFG_ST_FREQUENCY) + (time_conv_t)999) /
+            (time_conv_t)1000;
+      if (ref <= (time_conv_t)TIME_MAX_INTERVAL) {
+        test_assert((time_conv_t)chTimeMS2I((time_msecs_t)x) == ref,
+                    "wrong chTimeMS2I()");
+        test_assert((time_conv_t)TIME_MS2I(x) == ref, "wrong TIME_MS2I()");
+      }
+      ref = ((x * (time_conv_t)CH_CFG_ST_FREQUENCY) + (time_conv_t)999999) /
+            (time_conv_t)1000000;
+      if (ref <= (time_conv_t)TIME_MAX_INTERVAL) {
+        test_assert((time_conv_t)chTimeUS2I((time_usecs_t)x) == ref,
+                    "wrong chTimeUS2I()");
+        test_assert((time_conv_t)TIME_US2I(x) == ref, "wrong TIME_US2I()");
+      }
+    }
+  }
+  test_end_step(1);
+
+  /* [3.4.2] Converting intervals to seconds, milliseconds and
+     microseconds, the results are expected to match the reference
+     formulas.*/
+  test_set_step(2);
+  {
+    for (x = (time_conv_t)0; x <= (time_conv_t)0xFFFE; x++) {
+      ref = (x + (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /
+            (time_conv_t)CH_CFG_ST_FREQUENCY;
+      test_assert((time_conv_t)chTimeI2S((sysinterval_t)x) == ref,
+                  "wrong chTimeI2S()");
+      ref = ((x * (time_conv_t)1000) +
+             (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /
+            (time_conv_t)CH_CFG_ST_FREQUENCY;
+      if (ref < (time_conv_t)((time_msecs_t)-1)) {
+        test_assert((time_conv_t)chTimeI2MS((sysinterval_t)x) == ref,
+                    "wrong chTimeI2MS()");
+        test_assert((time_conv_t)TIME_I2MS(x) == ref, "wrong TIME_I2MS()");
+      }
+      ref = ((x * (time_conv_t)1000000) +
+             (time_conv_t)CH_CFG_ST_FREQUENCY - (time_conv_t)1) /
+            (time_conv_t)CH_CFG_ST_FREQUENCY;
+      if (ref <= (time_conv_t)((time_usecs_t)-1)) {
+        test_assert((time_conv_t)chTimeI2US((sysinterval_t)x) == ref,
+                    "wrong chTimeI2US()");
+        test_assert((time_conv_t)TIME_I2US(x) == ref, "wrong TIME_I2US()");
+      }
+    }
+  }
+  test_end_step(2);
+}
+
+static const testcase_t rt_test_003_004 = {
+  "Time conversions functionality",
+  NULL,
+  NULL,
+  rt_test_003_004_execute
+};
+
+#if ((CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_003_005 [3.5] Wait profiling functionality
+ *
+ * <h2>Description</h2>
+ * The waits on a profiled semaphore are measured, waits not requiring a
+ * sleep are not.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [3.5.1] Registering a wait profile on a semaphore, the profile
+ *   measurement is expected to be in the registry.
+ * - [3.5.2] Waiting on the semaphore until timeout, the wait is
+ *   expected to be measured.
+ * - [3.5.3] Taking the semaphore without waiting, no wait is expected
+ *   to be measured.
+ * - [3.5.4] Unregistering the profile, the registry is expected to be
+ *   empty.
+ * .
+ */
+
+static void rt_test_003_005_execute(void) {
+  static wait_profile_t wp1;
+  static semaphore_t sem1;
+  msg_t msg;
+
+  /* [3.5.1] Registering a wait profile on a semaphore, the profile
+     measurement is expected to be in the registry.*/
+  test_set_step(1);
+  {
+    chSemObjectInit(&sem1, 0);
+    chTMRegisterWait(&wp1, &sem1, "sem1");
+    test_assert(chTMRegistryFirstX() == &wp1.nm, "not registered");
+  }
+  test_end_step(1);
+
+  /* [3.5.2] Waiting on the semaphore until timeout, the wait is
+     expected to be measured.*/
+  test_set_step(2);
+  {
+    msg = chSemWaitTimeout(&sem1, TIME_MS2I(1));
+    test_assert(msg == MSG_TIMEOUT, "wrong wake-up message");
+    test_assert(wp1.nm.tm.n == (ucnt_t)1, "wait not measured");
+    test_assert(wp1.nm.tm.worst > (rtcnt_t)0, "wrong measurement");
+  }
+  test_end_step(2);
+
+  /* [3.5.3] Taking the semaphore without waiting, no wait is expected
+     to be measured.*/
+  test_set_step(3);
+  {
+    chSemSignal(&sem1);
+    msg = chSemWaitTimeout(&sem1, TIME_MS2I(1));
+    test_assert(msg == MSG_OK, "wrong wake-up message");
+    test_assert(wp1.nm.tm.n == (ucnt_t)1, "wrong count");
+  }
+  test_end_step(3);
+
+  /* [3.5.4] Unregistering the profile, the registry is expected to be
+     empty.*/
+  test_set_step(4);
+  {
+    chTMUnregisterWait(&wp1);
+    test_assert(chTMRegistryFirstX() == NULL, "not empty");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_003_005 = {
+  "Wait profiling functionality",
+  NULL,
+  NULL,
+  rt_test_003_005_execute
+};
+#endif /* (CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE) */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -163,6 +430,13 @@ static const testcase_t rt_test_003_002 = {
 const testcase_t * const rt_test_sequence_003_array[] = {
   &rt_test_003_001,
   &rt_test_003_002,
+#if ((CH_CFG_USE_TM == TRUE) && (CH_CFG_USE_TM_REGISTRY == TRUE)) || defined(__DOXYGEN__)
+  &rt_test_003_003,
+#endif
+  &rt_test_003_004,
+#if ((CH_CFG_USE_TM == TRUE) && (CH_DBG_WAIT_PROFILING == TRUE)) || defined(__DOXYGEN__)
+  &rt_test_003_005,
+#endif
   NULL
 };
 
@@ -34,6 +34,11 @@
  * - @subpage rt_test_005_002
  * - @subpage rt_test_005_003
  * - @subpage rt_test_005_004
+ * - @subpage rt_test_005_005
+ * - @subpage rt_test_005_006
+ * - @subpage rt_test_005_007
+ * - @subpage rt_test_005_008
+ * - @subpage rt_test_005_009
  * .
  */
 
@@ -46,6 +51,27 @@ static THD_FUNCTION(thread, p) {
   test_emit_token(*(char *)p);
 }
 
+#if CH_CFG_USE_TASKS || defined(__DOXYGEN__)
+static eventmask_t task_events;
+
+static void task(task_t *tkp, eventmask_t events) {
+
+  task_events = events;
+  test_emit_token(*(char *)chTaskGetArgX(tkp));
+}
+#endif
+
+#if (CH_CFG_USE_RESERVATIONS && CH_CFG_USE_MUTEXES) || defined(__DOXYGEN__)
+static MUTEX_DECL(m1);
+
+static THD_FUNCTION(locker, p) {
+
+  chMtxLock(&m1);
+  test_emit_token(*(char *)p);
+  chMtxUnlock(&m1);
+}
+#endif
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -339,6 +365,507 @@ static const testcase_t rt_test_005_004 = {
 };
 #endif /* CH_CFG_USE_MUTEXES */
 
+#if (CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_005 [5.5] Deadline scheduling class
+ *
+ * <h2>Description</h2>
+ * Threads in the deadline scheduling class are tested for execution in
+ * deadline order, then the current thread joins the class and the
+ * deadline miss detection is tested.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_EDF
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.5.1] Creating 5 threads in the deadline class with decreasing
+ *   deadlines, the threads are started together and the execution
+ *   sequence is tested.
+ * - [5.5.2] The current thread joins the deadline class, a job
+ *   completed before its deadline and a job completed after its
+ *   deadline are tested.
+ * - [5.5.3] The current thread leaves the deadline class, the previous
+ *   priority is restored.
+ * .
+ */
+
+static void rt_test_005_005_execute(void) {
+  tprio_t prio;
+  systime_t now;
+  edf_stats_t stats;
+  unsigned i;
+
+  /* [5.5.1] Creating 5 threads in the deadline class with decreasing
+     deadlines, the threads are started together and the execution
+     sequence is tested.*/
+  test_set_step(1);
+  {
+    prio = chThdSetPriority(HIGHPRIO);
+    now = chVTGetSystemTimeX();
+    for (i = 0U; i < 5U; i++) {
+      thread_descriptor_t td = {
+        .name  = "edf",
+        .wbase = wa[i],
+        .wend  = (stkalign_t *)((uint8_t *)wa[i] + WA_SIZE),
+        .prio  = CH_CFG_EDF_PRIORITY,
+        .funcp = thread,
+        .arg   = (void *)&"EDCBA"[i]
+      };
+
+      threads[i] = chThdCreateSuspended(&td);
+      threads[i]->edf.rdeadline = (sysinterval_t)(50U - (i * 10U));
+      threads[i]->edf.deadline  = chTimeAddX(now, threads[i]->edf.rdeadline);
+      (void) chThdStart(threads[i]);
+    }
+    (void) chThdSetPriority(prio);
+    test_wait_threads();
+    test_assert_sequence("ABCDE", "invalid sequence");
+  }
+  test_end_step(1);
+
+  /* [5.5.2] The current thread joins the deadline class, a job
+     completed before its deadline and a job completed after its
+     deadline are tested.*/
+  test_set_step(2);
+  {
+    chThdSetDeadline(TIME_MS2I(10), TIME_MS2I(50));
+    test_assert(chThdGetPriorityX() == CH_CFG_EDF_PRIORITY, "not in the deadline class");
+    test_assert(chThdWaitNextPeriod() == false, "unexpected deadline miss");
+    chThdSleep(TIME_MS2I(20));
+    test_assert(chThdWaitNextPeriod() == true, "deadline miss not detected");
+    chThdGetDeadlineStats(chThdGetSelfX(), &stats);
+    test_assert(stats.jobs == (ucnt_t)2, "unexpected jobs count");
+    test_assert(stats.misses == (ucnt_t)1, "unexpected misses count");
+    test_assert(stats.maxlateness >= TIME_MS2I(10), "unexpected lateness");
+  }
+  test_end_step(2);
+
+  /* [5.5.3] The current thread leaves the deadline class, the previous
+     priority is restored.*/
+  test_set_step(3);
+  {
+    chThdClearDeadline();
+    test_assert(chThdGetPriorityX() == prio, "priority not restored");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_005_005 = {
+  "Deadline scheduling class",
+  NULL,
+  NULL,
+  rt_test_005_005_execute
+};
+#endif /* CH_CFG_USE_EDF */
+
+#if (CH_CFG_USE_RESERVATIONS) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_006 [5.6] CPU budget reservations
+ *
+ * <h2>Description</h2>
+ * The current thread joins a reservation and exhausts its budget, the
+ * throttling and the replenishment of the budget are tested.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_RESERVATIONS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.6.1] The current thread joins a reservation with a 10mS budget
+ *   and a 50mS period, after using the CPU for 20mS the thread is
+ *   throttled.
+ * - [5.6.2] The throttled thread locks a mutex and is boosted by a
+ *   higher priority thread waiting on it, after unlocking the mutex the
+ *   priority must return to the throttling level.
+ * - [5.6.3] The current thread sleeps until the budget is replenished,
+ *   the priority is restored and the statistics are checked.
+ * - [5.6.4] The reservation is stopped and the current thread leaves
+ *   it.
+ * .
+ */
+
+static void rt_test_005_006_execute(void) {
+  tprio_t prio;
+  systime_t start;
+  reservation_t rs;
+  res_stats_t stats;
+
+  /* [5.6.1] The current thread joins a reservation with a 10mS budget and
+     a 50mS period, after using the CPU for 20mS the thread is throttled.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+    chResObjectInit(&rs, TIME_MS2I(10), TIME_MS2I(50));
+    chResJoin(&rs);
+    chResStart(&rs);
+    start = chVTGetSystemTimeX();
+    while (chVTTimeElapsedSinceX(start) < TIME_MS2I(20)) {
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    }
+    test_assert_lock(chResIsThrottledI(&rs), "not throttled");
+    test_assert(chThdGetPriorityX() == CH_CFG_RES_THROTTLE_PRIORITY, "priority not lowered");
+  }
+  test_end_step(1);
+
+  /* [5.6.2] The throttled thread locks a mutex and is boosted by a higher
+     priority thread waiting on it, after unlocking the mutex the
+     priority must return to the throttling level.*/
+  test_set_step(2);
+  {
+#if CH_CFG_USE_MUTEXES
+    chMtxLock(&m1);
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio + 1, locker, "A");
+    test_assert(chThdGetPriorityX() == prio + 1, "priority not boosted");
+    chMtxUnlock(&m1);
+    test_assert(chThdGetPriorityX() == CH_CFG_RES_THROTTLE_PRIORITY, "priority not throttled");
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+#endif
+  }
+  test_end_step(2);
+
+  /* [5.6.3] The current thread sleeps until the budget is replenished,
+     the priority is restored and the statistics are checked.*/
+  test_set_step(3);
+  {
+    chThdSleep(TIME_MS2I(40));
+    test_assert_lock(!chResIsThrottledI(&rs), "still throttled");
+    test_assert(chThdGetPriorityX() == prio, "priority not restored");
+    chResGetStats(&rs, &stats);
+    test_assert(stats.throttles == (ucnt_t)1, "unexpected throttles count");
+    test_assert(stats.maxused >= TIME_MS2I(10), "unexpected used time");
+  }
+  test_end_step(3);
+
+  /* [5.6.4] The reservation is stopped and the current thread leaves it.*/
+  test_set_step(4);
+  {
+    chResStop(&rs);
+    chResLeave();
+    test_assert(chThdGetPriorityX() == prio, "priority changed");
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_005_006 = {
+  "CPU budget reservations",
+  NULL,
+  NULL,
+  rt_test_005_006_execute
+};
+#endif /* CH_CFG_USE_RESERVATIONS */
+
+#if (CH_CFG_USE_PERIODIC) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_007 [5.7] Periodic threads
+ *
+ * <h2>Description</h2>
+ * Periodic threads are tested for drift-free releases, overrun
+ * detection and for the catch-up and skip overrun policies.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_PERIODIC
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.7.1] A thread is created from a descriptor specifying a period,
+ *   the thread must be periodic.
+ * - [5.7.2] The current thread becomes periodic with a 20mS period,
+ *   three jobs are released without overruns and the release times must
+ *   not drift.
+ * - [5.7.3] A job overruns its period with the catch-up policy, the
+ *   overrun is reported and the following job is released one period
+ *   after the late one.
+ * - [5.7.4] A job overruns two periods with the skip policy, the missed
+ *   releases are dropped and the thread waits for the first release in
+ *   the future.
+ * .
+ */
+
+static void rt_test_005_007_execute(void) {
+  systime_t start;
+  periodic_stats_t stats;
+  unsigned i;
+
+  /* [5.7.1] A thread is created from a descriptor specifying a period,
+     the thread must be periodic.*/
+  test_set_step(1);
+  {
+    thread_descriptor_t td = {
+      .name   = "periodic",
+      .wbase  = wa[0],
+      .wend   = (stkalign_t *)((uint8_t *)wa[0] + WA_SIZE),
+      .prio   = chThdGetPriorityX() - 1,
+      .funcp  = thread,
+      .arg    = "A",
+      .period = TIME_MS2I(10),
+      .policy = CH_PERIODIC_SKIP
+    };
+
+    threads[0] = chThdCreate(&td);
+    test_assert(threads[0]->periodic.period == TIME_MS2I(10), "not periodic");
+    test_assert(threads[0]->periodic.policy == CH_PERIODIC_SKIP, "wrong policy");
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+  }
+  test_end_step(1);
+
+  /* [5.7.2] The current thread becomes periodic with a 20mS period, three
+     jobs are released without overruns and the release times must not
+     drift.*/
+  test_set_step(2);
+  {
+    chThdSetPeriodic(TIME_MS2I(20), CH_PERIODIC_CATCHUP);
+    start = chThdGetSelfX()->periodic.release;
+    for (i = 0U; i < 3U; i++) {
+      test_assert(chThdWaitNextRelease() == false, "unexpected overrun");
+    }
+    test_assert(chVTTimeElapsedSinceX(start) >= TIME_MS2I(60), "early release");
+    test_assert(chThdGetSelfX()->periodic.release == chTimeAddX(start, TIME_MS2I(60)), "release drift");
+    chThdGetPeriodicStats(chThdGetSelfX(), &stats);
+    test_assert(stats.releases == (ucnt_t)3, "unexpected releases count");
+    test_assert(stats.overruns == (ucnt_t)0, "unexpected overruns count");
+  }
+  test_end_step(2);
+
+  /* [5.7.3] A job overruns its period with the catch-up policy, the
+     overrun is reported and the following job is released one period
+     after the late one.*/
+  test_set_step(3);
+  {
+    start = chThdGetSelfX()->periodic.release;
+    chThdSleep(TIME_MS2I(30));
+    test_assert(chThdWaitNextRelease() == true, "overrun not detected");
+    test_assert(chThdWaitNextRelease() == false, "unexpected overrun");
+    test_assert(chVTTimeElapsedSinceX(start) >= TIME_MS2I(40), "early release");
+    chThdGetPeriodicStats(chThdGetSelfX(), &stats);
+    test_assert(stats.overruns == (ucnt_t)1, "unexpected overruns count");
+    test_assert(stats.skipped == (ucnt_t)0, "unexpected skipped count");
+  }
+  test_end_step(3);
+
+  /* [5.7.4] A job overruns two periods with the skip policy, the missed
+     releases are dropped and the thread waits for the first release in
+     the future.*/
+  test_set_step(4);
+  {
+    chThdSetPeriodic(TIME_MS2I(20), CH_PERIODIC_SKIP);
+    start = chThdGetSelfX()->periodic.release;
+    chThdSleep(TIME_MS2I(50));
+    test_assert(chThdWaitNextRelease() == true, "overrun not detected");
+    test_assert(chVTTimeElapsedSinceX(start) >= TIME_MS2I(60), "early release");
+    chThdGetPeriodicStats(chThdGetSelfX(), &stats);
+    test_assert(stats.overruns == (ucnt_t)1, "unexpected overruns count");
+    test_assert(stats.skipped == (ucnt_t)2, "unexpected skipped count");
+    chThdSetPeriodic((sysinterval_t)0, CH_PERIODIC_CATCHUP);
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_005_007 = {
+  "Periodic threads",
+  NULL,
+  NULL,
+  rt_test_005_007_execute
+};
+#endif /* CH_CFG_USE_PERIODIC */
+
+#if (CH_CFG_USE_TASKS) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_008 [5.8] Run-to-completion tasks
+ *
+ * <h2>Description</h2>
+ * Run-to-completion tasks are tested for FIFO ordering, merging of
+ * activations, cancellation and termination of the priority level.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_TASKS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.8.1] A tasks level is created with priority above the current
+ *   thread, the runner thread must be created.
+ * - [5.8.2] Two tasks are activated from a critical zone, they must run
+ *   in activation order.
+ * - [5.8.3] A task is activated twice before running, the task must run
+ *   once and receive the events of both activations.
+ * - [5.8.4] Two tasks are activated and the first is cancelled, only
+ *   the second task must run.
+ * - [5.8.5] A task is activated using the API variant, the task must
+ *   run immediately.
+ * - [5.8.6] The tasks level is stopped, the runner thread must
+ *   terminate.
+ * .
+ */
+
+static void rt_test_005_008_execute(void) {
+  task_level_t tl;
+  task_t tk[2];
+
+  /* [5.8.1] A tasks level is created with priority above the current
+     thread, the runner thread must be created.*/
+  test_set_step(1);
+  {
+    threads[0] = chTaskLevelCreateStatic(&tl, wa[0], WA_SIZE,
+                                         chThdGetPriorityX() + 1);
+    test_assert(threads[0] != NULL, "runner not created");
+    chTaskObjectInit(&tk[0], &tl, task, "A");
+    chTaskObjectInit(&tk[1], &tl, task, "B");
+  }
+  test_end_step(1);
+
+  /* [5.8.2] Two tasks are activated from a critical zone, they must run
+     in activation order.*/
+  test_set_step(2);
+  {
+    chSysLock();
+    chTaskActivateI(&tk[0], (eventmask_t)1);
+    chTaskActivateI(&tk[1], (eventmask_t)1);
+    chSchRescheduleS();
+    chSysUnlock();
+    test_assert_sequence("AB", "invalid sequence");
+  }
+  test_end_step(2);
+
+  /* [5.8.3] A task is activated twice before running, the task must run
+     once and receive the events of both activations.*/
+  test_set_step(3);
+  {
+    chSysLock();
+    chTaskActivateI(&tk[0], (eventmask_t)1);
+    chTaskActivateI(&tk[0], (eventmask_t)2);
+    chSchRescheduleS();
+    chSysUnlock();
+    test_assert_sequence("A", "invalid sequence");
+    test_assert(task_events == (eventmask_t)3, "events not merged");
+  }
+  test_end_step(3);
+
+  /* [5.8.4] Two tasks are activated and the first is cancelled, only
+     the second task must run.*/
+  test_set_step(4);
+  {
+    chSysLock();
+    chTaskActivateI(&tk[0], (eventmask_t)1);
+    chTaskActivateI(&tk[1], (eventmask_t)4);
+    chTaskCancelI(&tk[0]);
+    chSchRescheduleS();
+    chSysUnlock();
+    test_assert_sequence("B", "invalid sequence");
+    test_assert(task_events == (eventmask_t)4, "wrong events");
+  }
+  test_end_step(4);
+
+  /* [5.8.5] A task is activated using the API variant, the task must
+     run immediately.*/
+  test_set_step(5);
+  {
+    chTaskActivate(&tk[1], (eventmask_t)8);
+    test_assert_sequence("B", "invalid sequence");
+    test_assert(task_events == (eventmask_t)8, "wrong events");
+  }
+  test_end_step(5);
+
+  /* [5.8.6] The tasks level is stopped, the runner thread must
+     terminate.*/
+  test_set_step(6);
+  {
+    chTaskLevelStop(&tl);
+    test_wait_threads();
+  }
+  test_end_step(6);
+}
+
+static const testcase_t rt_test_005_008 = {
+  "Run-to-completion tasks",
+  NULL,
+  NULL,
+  rt_test_005_008_execute
+};
+#endif /* CH_CFG_USE_TASKS */
+
+#if (CH_CFG_USE_PREEMPT_THRESHOLD) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_005_009 [5.9] Preemption threshold
+ *
+ * <h2>Description</h2>
+ * The preemption threshold is tested, threads with priority not above
+ * the threshold of the running thread must not preempt it.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_PREEMPT_THRESHOLD
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [5.9.1] The preemption threshold is raised above the priority of a
+ *   new thread, the thread must not preempt the current thread.
+ * - [5.9.2] A thread with priority above the threshold is created, the
+ *   thread must preempt the current thread.
+ * - [5.9.3] The threshold is removed, the pending thread must run.
+ * .
+ */
+
+static void rt_test_005_009_teardown(void) {
+  (void) chThdSetPreemptionThreshold(IDLEPRIO);
+  test_wait_threads();
+}
+
+static void rt_test_005_009_execute(void) {
+  tprio_t prio;
+
+  /* [5.9.1] The preemption threshold is raised above the priority of a
+     new thread, the thread must not preempt the current thread.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+    test_assert(chThdSetPreemptionThreshold(prio + 2) == IDLEPRIO,
+                "threshold already set");
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio + 1, thread, "A");
+    test_assert_sequence("", "preempted below the threshold");
+  }
+  test_end_step(1);
+
+  /* [5.9.2] A thread with priority above the threshold is created, the
+     thread must preempt the current thread.*/
+  test_set_step(2);
+  {
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio + 3, thread, "B");
+    test_assert_sequence("B", "not preempted above the threshold");
+  }
+  test_end_step(2);
+
+  /* [5.9.3] The threshold is removed, the pending thread must run.*/
+  test_set_step(3);
+  {
+    test_assert(chThdSetPreemptionThreshold(IDLEPRIO) == prio + 2,
+                "wrong threshold");
+    test_assert_sequence("A", "pending thread not run");
+    test_wait_threads();
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_005_009 = {
+  "Preemption threshold",
+  NULL,
+  rt_test_005_009_teardown,
+  rt_test_005_009_execute
+};
+#endif /* CH_CFG_USE_PREEMPT_THRESHOLD */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -352,6 +879,21 @@ const testcase_t * const rt_test_sequence_005_array[] = {
   &rt_test_005_003,
 #if (CH_CFG_USE_MUTEXES) || defined(__DOXYGEN__)
   &rt_test_005_004,
+#endif
+#if (CH_CFG_USE_EDF) || defined(__DOXYGEN__)
+  &rt_test_005_005,
+#endif
+#if (CH_CFG_USE_RESERVATIONS) || defined(__DOXYGEN__)
+  &rt_test_005_006,
+#endif
+#if (CH_CFG_USE_PERIODIC) || defined(__DOXYGEN__)
+  &rt_test_005_007,
+#endif
+#if (CH_CFG_USE_TASKS) || defined(__DOXYGEN__)
+  &rt_test_005_008,
+#endif
+#if (CH_CFG_USE_PREEMPT_THRESHOLD) || defined(__DOXYGEN__)
+  &rt_test_005_009,
 #endif
   NULL
 };
@@ -45,6 +45,9 @@
  * - @subpage rt_test_008_007
  * - @subpage rt_test_008_008
  * - @subpage rt_test_008_009
+ * - @subpage rt_test_008_010
+ * - @subpage rt_test_008_011
+ * - @subpage rt_test_008_012
  * .
  */
 
@@ -228,6 +231,24 @@ static THD_FUNCTION(thread9, p) {
 }
 #endif /* CH_CFG_USE_CONDVARS */
 
+#if CH_CFG_USE_RWLOCKS || defined(__DOXYGEN__)
+static RWLOCK_DECL(rw1);
+
+static THD_FUNCTION(thread10R, p) {
+
+  chRWLockReadLock(&rw1);
+  test_emit_token(*(char *)p);
+  chRWLockReadUnlock(&rw1);
+}
+
+static THD_FUNCTION(thread10W, p) {
+
+  chRWLockWriteLock(&rw1);
+  test_emit_token(*(char *)p);
+  chRWLockWriteUnlock(&rw1);
+}
+#endif /* CH_CFG_USE_RWLOCKS */
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -1078,6 +1099,280 @@ static const testcase_t rt_test_008_009 = {
 };
 #endif /* CH_CFG_USE_CONDVARS */
 
+#if (CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_008_010 [8.10] Reader-writer locks
+ *
+ * <h2>Description</h2>
+ * The reader-writer lock is tested for read sharing, write exclusion,
+ * writers precedence over readers and priority inheritance among writers.
+ *
+ * <h2>Test Steps</h2>
+ * - [8.10.1] Getting the initial priority.
+ * - [8.10.2] Locking RW1 twice for reading, a write lock attempt must
+ *   fail.
+ * - [8.10.3] Locking RW1 for writing, read and write lock attempts must
+ *   fail.
+ * - [8.10.4] Holding RW1 for reading, a writer and then a reader with
+ *   higher priority are started, the writer must precede the reader
+ *   once RW1 is released.
+ * - [8.10.5] Holding RW1 for writing, a writer with higher priority is
+ *   started, the priority must be boosted and then restored on release.
+ * .
+ */
+
+static void rt_test_008_010_setup(void) {
+  chRWLockObjectInit(&rw1);
+}
+
+static void rt_test_008_010_execute(void) {
+  tprio_t prio;
+
+  /* [8.10.1] Getting the initial priority.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+  }
+  test_end_step(1);
+
+  /* [8.10.2] Locking RW1 twice for reading, a write lock attempt must
+     fail.*/
+  test_set_step(2);
+  {
+    bool b;
+
+    b = chRWLockTryRead(&rw1);
+    test_assert(b, "read lock failed");
+    b = chRWLockTryRead(&rw1);
+    test_assert(b, "read lock failed");
+    b = chRWLockTryWrite(&rw1);
+    test_assert(!b, "write lock acquired while reading");
+    chRWLockReadUnlock(&rw1);
+    chRWLockReadUnlock(&rw1);
+  }
+  test_end_step(2);
+
+  /* [8.10.3] Locking RW1 for writing, read and write lock attempts must
+     fail.*/
+  test_set_step(3);
+  {
+    bool b;
+
+    b = chRWLockTryWrite(&rw1);
+    test_assert(b, "write lock failed");
+    b = chRWLockTryRead(&rw1);
+    test_assert(!b, "read lock acquired while writing");
+    b = chRWLockTryWrite(&rw1);
+    test_assert(!b, "write lock acquired twice");
+    chRWLockWriteUnlock(&rw1);
+  }
+  test_end_step(3);
+
+  /* [8.10.4] Holding RW1 for reading, a writer and then a reader with
+     higher priority are started, the writer must precede the reader
+     once RW1 is released.*/
+  test_set_step(4);
+  {
+    chRWLockReadLock(&rw1);
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, thread10W, "A");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio+2, thread10R, "B");
+    chRWLockReadUnlock(&rw1);
+    test_wait_threads();
+    test_assert_sequence("AB", "invalid sequence");
+  }
+  test_end_step(4);
+
+  /* [8.10.5] Holding RW1 for writing, a writer with higher priority is
+     started, the priority must be boosted and then restored on
+     release.*/
+  test_set_step(5);
+  {
+    chRWLockWriteLock(&rw1);
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+3, thread10W, "A");
+    test_assert(chThdGetPriorityX() == prio+3, "priority not boosted");
+    chRWLockWriteUnlock(&rw1);
+    test_assert(chThdGetPriorityX() == prio, "wrong priority level");
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+  }
+  test_end_step(5);
+}
+
+static const testcase_t rt_test_008_010 = {
+  "Reader-writer locks",
+  rt_test_008_010_setup,
+  NULL,
+  rt_test_008_010_execute
+};
+#endif /* CH_CFG_USE_RWLOCKS */
+
+#if (CH_CFG_USE_CONDVARS) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_008_011 [8.11] Condition Variable wait morphing
+ *
+ * <h2>Description</h2>
+ * The threads waiting on a condition variable are released by a
+ * broadcast performed while owning the mutex, the threads must be moved
+ * on the mutex queue and acquire the mutex in priority order.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_CONDVARS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [8.11.1] Starting five threads with increasing priority, the
+ *   threads will queue on the condition variable.
+ * - [8.11.2] Raising the priority above the threads, locking M1 and
+ *   broadcasting on the condition variable, the threads must be moved
+ *   on the mutex queue without being made ready.
+ * - [8.11.3] Restoring the priority, the threads must acquire the mutex
+ *   in priority order.
+ * .
+ */
+
+static void rt_test_008_011_setup(void) {
+  chCondObjectInit(&c1);
+  chMtxObjectInit(&m1);
+}
+
+static void rt_test_008_011_execute(void) {
+  tprio_t prio;
+  unsigned i;
+
+  /* [8.11.1] Starting five threads with increasing priority, the threads
+     will queue on the condition variable.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, thread6, "E");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio+2, thread6, "D");
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, prio+3, thread6, "C");
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, prio+4, thread6, "B");
+    threads[4] = chThdCreateStatic(wa[4], WA_SIZE, prio+5, thread6, "A");
+  }
+  test_end_step(1);
+
+  /* [8.11.2] Raising the priority above the threads, locking M1 and
+     broadcasting on the condition variable, the threads must be moved on
+     the mutex queue without being made ready.*/
+  test_set_step(2);
+  {
+    (void) chThdSetPriority(prio+6);
+    chMtxLock(&m1);
+    chCondBroadcast(&c1);
+    for (i = 0U; i < 5U; i++) {
+      test_assert(threads[i]->state == CH_STATE_WTMTX, "not on the mutex queue");
+    }
+    chMtxUnlock(&m1);
+  }
+  test_end_step(2);
+
+  /* [8.11.3] Restoring the priority, the threads must acquire the mutex
+     in priority order.*/
+  test_set_step(3);
+  {
+    (void) chThdSetPriority(prio);
+    test_wait_threads();
+    test_assert_sequence("ABCDE", "invalid sequence");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_008_011 = {
+  "Condition Variable wait morphing",
+  rt_test_008_011_setup,
+  NULL,
+  rt_test_008_011_execute
+};
+#endif /* CH_CFG_USE_CONDVARS */
+
+#if (CH_CFG_USE_MUTEXES_CEILING) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_008_012 [8.12] Priority ceiling mutexes
+ *
+ * <h2>Description</h2>
+ * The priority ceiling mutexes are tested for the immediate priority
+ * raise of the owner, for the absence of preemption by threads below
+ * the ceiling and for the priority restore when nested with priority
+ * inheritance mutexes.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MUTEXES_CEILING
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [8.12.1] Getting the initial priority.
+ * - [8.12.2] Locking M1, the priority must be raised to the ceiling.
+ * - [8.12.3] A thread with priority below the ceiling is created, it
+ *   must not run until M1 is released, then it must lock M1 and
+ *   complete.
+ * - [8.12.4] Locking M2 then M1, the priority must be raised to the
+ *   ceiling and restored when M1 is released.
+ * .
+ */
+
+static void rt_test_008_012_setup(void) {
+  chMtxCeilingObjectInit(&m1, chThdGetPriorityX() + 2);
+  chMtxObjectInit(&m2);
+}
+
+static void rt_test_008_012_execute(void) {
+  tprio_t prio;
+
+  /* [8.12.1] Getting the initial priority.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+  }
+  test_end_step(1);
+
+  /* [8.12.2] Locking M1, the priority must be raised to the ceiling.*/
+  test_set_step(2);
+  {
+    chMtxLock(&m1);
+    test_assert(chThdGetPriorityX() == prio+2, "not at ceiling");
+  }
+  test_end_step(2);
+
+  /* [8.12.3] A thread with priority below the ceiling is created, it must
+     not run until M1 is released, then it must lock M1 and complete.*/
+  test_set_step(3);
+  {
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+1, thread1, "A");
+    test_assert_sequence("", "preempted by a lower priority thread");
+    chMtxUnlock(&m1);
+    test_assert(chThdGetPriorityX() == prio, "wrong priority level");
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+  }
+  test_end_step(3);
+
+  /* [8.12.4] Locking M2 then M1, the priority must be raised to the
+     ceiling and restored when M1 is released.*/
+  test_set_step(4);
+  {
+    chMtxLock(&m2);
+    chMtxLock(&m1);
+    test_assert(chThdGetPriorityX() == prio+2, "not at ceiling");
+    chMtxUnlock(&m1);
+    test_assert(chThdGetPriorityX() == prio, "wrong priority level");
+    chMtxUnlock(&m2);
+  }
+  test_end_step(4);
+}
+
+static const testcase_t rt_test_008_012 = {
+  "Priority ceiling mutexes",
+  rt_test_008_012_setup,
+  NULL,
+  rt_test_008_012_execute
+};
+#endif /* CH_CFG_USE_MUTEXES_CEILING */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -1108,6 +1403,15 @@ const testcase_t * const rt_test_sequence_008_array[] = {
 #endif
 #if (CH_CFG_USE_CONDVARS) || defined(__DOXYGEN__)
   &rt_test_008_009,
+#endif
+#if (CH_CFG_USE_RWLOCKS) || defined(__DOXYGEN__)
+  &rt_test_008_010,
+#endif
+#if (CH_CFG_USE_CONDVARS) || defined(__DOXYGEN__)
+  &rt_test_008_011,
+#endif
+#if (CH_CFG_USE_MUTEXES_CEILING) || defined(__DOXYGEN__)
+  &rt_test_008_012,
 #endif
   NULL
 };
@@ -42,6 +42,7 @@
  * - @subpage rt_test_010_005
  * - @subpage rt_test_010_006
  * - @subpage rt_test_010_007
+ * - @subpage rt_test_010_008
  * .
  */
 
@@ -73,6 +74,15 @@ static THD_FUNCTION(evt_thread7, p) {
   chEvtBroadcast(&es2);
 }
 
+static THD_FUNCTION(evt_thread8, p) {
+  event_listener_t el;
+
+  chEvtRegister(&es1, &el, 0);
+  chEvtWaitAny(ALL_EVENTS);
+  chEvtUnregister(&es1, &el);
+  test_emit_token(*(char *)p);
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -573,6 +583,73 @@ static const testcase_t rt_test_010_007 = {
   rt_test_010_007_execute
 };
 
+/**
+ * @page rt_test_010_008 [10.8] Broadcasting to multiple listeners
+ *
+ * <h2>Description</h2>
+ * Five threads with different priorities are registered on the same Event
+ * Source and wait for events, the Event Source is broadcasted once from an
+ * I-Class context. The test expects the threads to be woken up in priority
+ * order and, among threads at the same priority level, in the order the
+ * listeners are linked to the Event Source.
+ *
+ * <h2>Test Steps</h2>
+ * - [10.8.1] Starting the listener threads in mixed priority order, the
+ *   threads register on the Event Source and wait.
+ * - [10.8.2] Broadcasting the Event Source using chEvtBroadcastFlagsI()
+ *   then rescheduling once.
+ * - [10.8.3] Checking the order of operations.
+ * .
+ */
+
+static void rt_test_010_008_setup(void) {
+  chEvtObjectInit(&es1);
+}
+
+static void rt_test_010_008_execute(void) {
+  tprio_t prio;
+
+  /* [10.8.1] Starting the listener threads in mixed priority order, the
+     threads register on the Event Source and wait.*/
+  test_set_step(1);
+  {
+    prio = chThdGetPriorityX();
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, prio+3, evt_thread8, "C");
+    threads[1] = chThdCreateStatic(wa[1], WA_SIZE, prio+5, evt_thread8, "A");
+    threads[2] = chThdCreateStatic(wa[2], WA_SIZE, prio+1, evt_thread8, "E");
+    threads[3] = chThdCreateStatic(wa[3], WA_SIZE, prio+4, evt_thread8, "B");
+    threads[4] = chThdCreateStatic(wa[4], WA_SIZE, prio+1, evt_thread8, "D");
+  }
+  test_end_step(1);
+
+  /* [10.8.2] Broadcasting the Event Source using chEvtBroadcastFlagsI()
+     then rescheduling once.*/
+  test_set_step(2);
+  {
+    chSysLock();
+    chEvtBroadcastFlagsI(&es1, (eventflags_t)0);
+    chSchRescheduleS();
+    chSysUnlock();
+  }
+  test_end_step(2);
+
+  /* [10.8.3] Checking the order of operations.*/
+  test_set_step(3);
+  {
+    test_wait_threads();
+    test_assert_sequence("ABCDE", "invalid sequence");
+    test_assert(!chEvtIsListeningI(&es1), "stuck listener");
+  }
+  test_end_step(3);
+}
+
+static const testcase_t rt_test_010_008 = {
+  "Broadcasting to multiple listeners",
+  rt_test_010_008_setup,
+  NULL,
+  rt_test_010_008_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -590,6 +667,7 @@ const testcase_t * const rt_test_sequence_010_array[] = {
   &rt_test_010_006,
 #endif
   &rt_test_010_007,
+  &rt_test_010_008,
   NULL
 };
 
@@ -119,6 +119,19 @@
 #define CH_CFG_NO_IDLE_THREAD               FALSE
 #endif
 
+/**
+ * @brief   Idle governor.
+ * @details If enabled then the idle thread selects the deepest low power
+ *          state, among the ones registered using @p chSchSetIdleStates(),
+ *          compatible with the next virtual timer deadline.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires the tickless mode.
+ */
+#if !defined(CH_CFG_USE_IDLE_GOVERNOR)
+#define CH_CFG_USE_IDLE_GOVERNOR            FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -140,6 +153,106 @@
 #define CH_CFG_OPTIMIZE_SPEED               TRUE
 #endif
 
+/**
+ * @brief   Bitmap-indexed ready list.
+ * @details If enabled then the ready list is indexed by a priority bitmap,
+ *          making the insertion of threads in the ready list a constant
+ *          time operation regardless of the number of ready threads.
+ *
+ * @note    The default is @p FALSE.
+ * @note    The index requires about 1kB of RAM on 32 bits architectures.
+ */
+#if !defined(CH_CFG_USE_BITMAP_READYLIST)
+#define CH_CFG_USE_BITMAP_READYLIST         FALSE
+#endif
+
+/**
+ * @brief   Virtual timers wheel.
+ * @details If enabled then virtual timers are hashed into a timing wheel
+ *          instead of being kept in a sorted delta list, arming and
+ *          disarming become constant time operations regardless of the
+ *          number of armed timers.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_VT_WHEEL)
+#define CH_CFG_USE_VT_WHEEL                 FALSE
+#endif
+
+/**
+ * @brief   Number of slots in the virtual timers wheel.
+ * @note    Must be a power of two between 32 and 1024.
+ * @note    The default is 64.
+ */
+#if !defined(CH_CFG_VT_WHEEL_SLOTS)
+#define CH_CFG_VT_WHEEL_SLOTS               64
+#endif
+
+/**
+ * @brief   Deferred virtual timers.
+ * @details If enabled then virtual timers armed using @p chVTSetDeferredI()
+ *          execute their callbacks in a dedicated timers thread instead of
+ *          the system tick interrupt, the callbacks expiring in the same
+ *          tick are executed in a single thread activation.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_VT_DEFERRED)
+#define CH_CFG_USE_VT_DEFERRED              FALSE
+#endif
+
+/**
+ * @brief   Priority of the deferred timers thread.
+ * @note    The default is @p HIGHPRIO.
+ */
+#if !defined(CH_CFG_VT_THREAD_PRIORITY)
+#define CH_CFG_VT_THREAD_PRIORITY           HIGHPRIO
+#endif
+
+/**
+ * @brief   Stack size of the deferred timers thread.
+ * @note    The stack must accommodate the deferred callbacks.
+ * @note    The default is 256.
+ */
+#if !defined(CH_CFG_VT_THREAD_STACK_SIZE)
+#define CH_CFG_VT_THREAD_STACK_SIZE         256
+#endif
+
+/**
+ * @brief   Virtual timers slack.
+ * @details If enabled then virtual timers armed using @p chVTDoSetSlackI()
+ *          can be delayed within a tolerance window in order to share the
+ *          deadline of an already armed timer, expirations close in time
+ *          are served by a single alarm.
+ * @note    Not compatible with @p CH_CFG_USE_VT_WHEEL.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_VT_SLACK)
+#define CH_CFG_USE_VT_SLACK                 FALSE
+#endif
+
+/**
+ * @brief   Deadline scheduling class.
+ * @details If enabled then threads can join an earliest deadline first
+ *          scheduling class using @p chThdSetDeadline(), threads in the
+ *          class run at @p CH_CFG_EDF_PRIORITY and are ordered by
+ *          absolute deadline within that priority level.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_EDF)
+#define CH_CFG_USE_EDF                      FALSE
+#endif
+
+/**
+ * @brief   Priority level reserved to the deadline scheduling class.
+ * @note    The default is @p HIGHPRIO minus one.
+ */
+#if !defined(CH_CFG_EDF_PRIORITY)
+#define CH_CFG_EDF_PRIORITY                 (HIGHPRIO - 1)
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -160,6 +273,19 @@
 #define CH_CFG_USE_TM                       TRUE
 #endif
 
+/**
+ * @brief   Named measurements registry.
+ * @details If enabled then named time measurements with log-scale
+ *          histograms can be registered, enumerated and queried for
+ *          percentiles.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TM.
+ */
+#if !defined(CH_CFG_USE_TM_REGISTRY)
+#define CH_CFG_USE_TM_REGISTRY              FALSE
+#endif
+
 /**
  * @brief   Time Stamps APIs.
  * @details If enabled then the time time stamps APIs are included in
@@ -237,6 +363,66 @@
 #define CH_CFG_USE_MUTEXES_RECURSIVE        FALSE
 #endif
 
+/**
+ * @brief   Enables priority ceiling mutexes.
+ * @details If enabled then mutexes can be initialized with a ceiling
+ *          priority using the immediate priority ceiling protocol.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MUTEXES.
+ */
+#if !defined(CH_CFG_USE_MUTEXES_CEILING)
+#define CH_CFG_USE_MUTEXES_CEILING          FALSE
+#endif
+
+/**
+ * @brief   Periodic threads APIs.
+ * @details If enabled then threads can be given a release period, the
+ *          kernel keeps the release times and measures jitter and
+ *          overruns of each periodic thread.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_PERIODIC)
+#define CH_CFG_USE_PERIODIC                 FALSE
+#endif
+
+/**
+ * @brief   Run-to-completion tasks APIs.
+ * @details If enabled then event-triggered tasks without a stack of their
+ *          own can be run, the tasks of a priority level share the stack
+ *          of a single runner thread.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_TASKS)
+#define CH_CFG_USE_TASKS                    FALSE
+#endif
+
+/**
+ * @brief   Preemption threshold.
+ * @details If enabled then threads can be given a preemption threshold, a
+ *          running thread can only be preempted by threads with priority
+ *          above its threshold.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_PREEMPT_THRESHOLD)
+#define CH_CFG_USE_PREEMPT_THRESHOLD        FALSE
+#endif
+
+/**
+ * @brief   Compact objects layout.
+ * @details If enabled then the kernel objects are made smaller at the cost
+ *          of some speed, the threads registry becomes a single linked
+ *          list and removing a thread from the registry requires a scan.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_COMPACT_OBJECTS)
+#define CH_CFG_COMPACT_OBJECTS              FALSE
+#endif
+
 /**
  * @brief   Conditional Variables APIs.
  * @details If enabled then the conditional variables APIs are included
@@ -261,6 +447,67 @@
 #define CH_CFG_USE_CONDVARS_TIMEOUT         TRUE
 #endif
 
+/**
+ * @brief   Reader-Writer Locks APIs.
+ * @details If enabled then the reader-writer locks APIs are included in
+ *          the kernel.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MUTEXES.
+ */
+#if !defined(CH_CFG_USE_RWLOCKS)
+#define CH_CFG_USE_RWLOCKS                  TRUE
+#endif
+
+/**
+ * @brief   CPU budget reservations APIs.
+ * @details If enabled then groups of threads can be limited to a CPU time
+ *          budget for each replenishment period.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_RESERVATIONS)
+#define CH_CFG_USE_RESERVATIONS             FALSE
+#endif
+
+/**
+ * @brief   Priority of the threads of an exhausted reservation.
+ * @note    The default is @p LOWPRIO.
+ */
+#if !defined(CH_CFG_RES_THROTTLE_PRIORITY)
+#define CH_CFG_RES_THROTTLE_PRIORITY        LOWPRIO
+#endif
+
+/**
+ * @brief   Thread local storage.
+ * @details If enabled then each thread owns a copy of the variables
+ *          declared @p __thread or @p _Thread_local.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires port support.
+ */
+#if !defined(CH_CFG_USE_TLS)
+#define CH_CFG_USE_TLS                      FALSE
+#endif
+
+/**
+ * @brief   Maximum size of the thread local variables.
+ * @note    The default is @p 64.
+ */
+#if !defined(CH_CFG_TLS_SIZE)
+#define CH_CFG_TLS_SIZE                     64
+#endif
+
+/**
+ * @brief   Per-thread newlib reentrancy structure.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TLS.
+ */
+#if !defined(CH_CFG_USE_NEWLIB_REENT)
+#define CH_CFG_USE_NEWLIB_REENT             FALSE
+#endif
+
 /**
  * @brief   Events Flags APIs.
  * @details If enabled then the event flags APIs are included in the kernel.
@@ -381,6 +628,20 @@
 #define CH_CFG_USE_HEAP                     TRUE
 #endif
 
+/**
+ * @brief   Constant time heap allocator.
+ * @details If enabled then the memory heap uses a two levels segregated
+ *          fit allocator (TLSF) instead of a first-fit free list, the
+ *          allocation and release times do not depend on the heap
+ *          fragmentation.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -447,6 +708,30 @@
 #define CH_CFG_USE_JOBS                     TRUE
 #endif
 
+/**
+ * @brief   Multiple objects wait APIs.
+ * @details If enabled then a thread can wait on several semaphores,
+ *          mailboxes, objects FIFOs, pipes and events at once.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_WAIT_MULTIPLE)
+#define CH_CFG_USE_WAIT_MULTIPLE            FALSE
+#endif
+
+/**
+ * @brief   Dataflow pipelines APIs.
+ * @details If enabled then chains of processing stages can be executed
+ *          as jobs on a jobs queue, buffers are taken from an objects
+ *          FIFO.
+ * @note    Requires @p CH_CFG_USE_OBJ_FIFOS and @p CH_CFG_USE_JOBS.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_CFG_USE_PIPELINES)
+#define CH_CFG_USE_PIPELINES                FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -536,6 +821,70 @@
 #define CH_DBG_STATISTICS                   FALSE
 #endif
 
+/**
+ * @brief   Debug option, ready-to-run latency histograms.
+ * @details If enabled then each thread keeps an histogram of the time spent
+ *          in the ready list before running.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_DBG_STATISTICS.
+ */
+#if !defined(CH_DBG_LATENCY_HISTOGRAMS)
+#define CH_DBG_LATENCY_HISTOGRAMS           FALSE
+#endif
+
+/**
+ * @brief   Debug option, wait time profiling.
+ * @details If enabled then the time spent by threads waiting on the kernel
+ *          objects registered using @p chTMRegisterWait() is recorded in
+ *          named measurements.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TM_REGISTRY.
+ */
+#if !defined(CH_DBG_WAIT_PROFILING)
+#define CH_DBG_WAIT_PROFILING               FALSE
+#endif
+
+/**
+ * @brief   Debug option, allocations profiling.
+ * @details If enabled then the heap, pool and core allocations are
+ *          aggregated by call site.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_TIMESTAMP.
+ */
+#if !defined(CH_DBG_MEM_PROFILING)
+#define CH_DBG_MEM_PROFILING                FALSE
+#endif
+
+/**
+ * @brief   Debug option, critical zones offenders.
+ * @details If different from zero then the specified number of longest
+ *          threads critical zones are recorded together with the thread and
+ *          the caller return address.
+ *
+ * @note    The default is @p 0.
+ * @note    Requires @p CH_DBG_STATISTICS.
+ */
+#if !defined(CH_DBG_CRIT_OFFENDERS)
+#define CH_DBG_CRIT_OFFENDERS               0
+#endif
+
+/**
+ * @brief   Debug option, critical zones duration threshold.
+ * @details If different from zero then threads critical zones longer than
+ *          the specified number of realtime counter cycles invoke the
+ *          @p CH_CFG_CRIT_THRESHOLD_HOOK hook and write an user trace
+ *          record.
+ *
+ * @note    The default is @p 0.
+ * @note    Requires @p CH_DBG_STATISTICS.
+ */
+#if !defined(CH_DBG_CRIT_THRESHOLD)
+#define CH_DBG_CRIT_THRESHOLD               0
+#endif
+
 /**
  * @brief   Debug option, system state check.
  * @details If enabled the correct call protocol for system APIs is checked
@@ -570,6 +919,21 @@
 #define CH_DBG_ENABLE_ASSERTS               FALSE
 #endif
 
+/**
+ * @brief   Debug option, expensive consistency checks.
+ * @details If enabled then the assertions scanning lists or the registry
+ *          are activated, their cost grows with the number of objects.
+ *          The parameter checks and the other assertions have constant
+ *          cost, this option can be disabled in production builds keeping
+ *          those enabled.
+ *
+ * @note    The default is equal to @p CH_DBG_ENABLE_ASSERTS.
+ * @note    Requires @p CH_DBG_ENABLE_ASSERTS.
+ */
+#if !defined(CH_DBG_ENABLE_EXPENSIVE_ASSERTS)
+#define CH_DBG_ENABLE_EXPENSIVE_ASSERTS     CH_DBG_ENABLE_ASSERTS
+#endif
+
 /**
  * @brief   Debug option, trace buffer.
  * @details If enabled then the trace buffer is activated.
@@ -615,6 +979,19 @@
 #define CH_DBG_FILL_THREADS                 FALSE
 #endif
 
+/**
+ * @brief   Debug option, stacks watermarks.
+ * @details If enabled then each thread keeps the minimum free stack space
+ *          observed by sampling the stack pointer on context switches and,
+ *          where supported by the port, on interrupts entry.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_DBG_ENABLE_STACK_CHECK.
+ */
+#if !defined(CH_DBG_STACK_WATERMARK)
+#define CH_DBG_STACK_WATERMARK              FALSE
+#endif
+
 /**
  * @brief   Debug option, threads profiling.
  * @details If enabled then a field is added to the @p thread_t structure that
@@ -94,7 +94,7 @@ test cfg4 "-DCH_CFG_USE_REGISTRY=FALSE -DCH_CFG_USE_DYNAMIC=FALSE"
 test cfg5 "-DCH_CFG_USE_TM=FALSE"
 test cfg6 "-DCH_CFG_USE_SEMAPHORES=FALSE -DCH_CFG_USE_MAILBOXES=FALSE -DCH_CFG_USE_OBJ_FIFOS=FALSE"
 test cfg7 "-DCH_CFG_USE_SEMAPHORES_PRIORITY=TRUE"
-test cfg8 "-DCH_CFG_USE_MUTEXES=FALSE -DCH_CFG_USE_CONDVARS=FALSE"
+test cfg8 "-DCH_CFG_USE_MUTEXES=FALSE -DCH_CFG_USE_CONDVARS=FALSE -DCH_CFG_USE_RWLOCKS=FALSE"
 test cfg9 "-DCH_CFG_USE_MUTEXES_RECURSIVE=TRUE"
 test cfg10 "-DCH_CFG_USE_CONDVARS=FALSE"
 test cfg11 "-DCH_CFG_USE_CONDVARS_TIMEOUT=FALSE"
@@ -122,6 +122,32 @@ test cfg32 "-DCH_CFG_ST_RESOLUTION=16 -DCH_CFG_INTERVALS_SIZE=64"
 test cfg33 "-DCH_CFG_INTERVALS_SIZE=64"
 test cfg34 "-DCH_CFG_USE_OBJ_FIFOS=FALSE"
 test cfg35 "-DCH_CFG_USE_FACTORY=FALSE"
+test cfg36 "-DCH_CFG_USE_BITMAP_READYLIST=TRUE"
+test cfg37 "-DCH_CFG_USE_BITMAP_READYLIST=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg38 "-DCH_CFG_USE_VT_WHEEL=TRUE"
+test cfg39 "-DCH_CFG_USE_VT_WHEEL=TRUE -DCH_CFG_VT_WHEEL_SLOTS=32 -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg40 "-DCH_CFG_USE_HEAP_TLSF=TRUE"
+test cfg41 "-DCH_CFG_USE_HEAP_TLSF=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg42 "-DCH_CFG_USE_RWLOCKS=FALSE"
+test cfg43 "-DCH_DBG_STATISTICS=TRUE -DCH_DBG_LATENCY_HISTOGRAMS=TRUE"
+test cfg44 "-DCH_CFG_USE_TM_REGISTRY=TRUE"
+test cfg45 "-DCH_DBG_STATISTICS=TRUE -DCH_DBG_CRIT_OFFENDERS=4 -DCH_DBG_CRIT_THRESHOLD=1000 -DCH_DBG_TRACE_MASK=CH_DBG_TRACE_MASK_ALL"
+test cfg46 "-DCH_CFG_USE_VT_DEFERRED=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg47 "-DCH_CFG_USE_EDF=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg48 "-DCH_CFG_USE_EDF=TRUE -DCH_CFG_USE_BITMAP_READYLIST=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg49 "-DCH_CFG_USE_RESERVATIONS=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg50 "-DCH_CFG_USE_MUTEXES_CEILING=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg51 "-DCH_CFG_USE_PERIODIC=TRUE -DCH_DBG_STATISTICS=TRUE -DCH_CFG_USE_TM_REGISTRY=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg52 "-DCH_CFG_USE_TASKS=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg53 "-DCH_CFG_USE_PREEMPT_THRESHOLD=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg54 "-DCH_CFG_COMPACT_OBJECTS=TRUE -DCH_CFG_REGISTRY_ID_SLOTS=16 -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg55 "-DCH_CFG_USE_WAIT_MULTIPLE=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg56 "-DCH_CFG_USE_TM_REGISTRY=TRUE -DCH_DBG_WAIT_PROFILING=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg57 "-DCH_DBG_MEM_PROFILING=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg58 "-DCH_DBG_MEM_PROFILING=TRUE -DCH_CFG_USE_HEAP_TLSF=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg59 "-DCH_DBG_ENABLE_CHECKS=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE -DCH_DBG_ENABLE_EXPENSIVE_ASSERTS=FALSE"
+test cfg60 "-DCH_CFG_USE_VT_SLACK=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
+test cfg61 "-DCH_CFG_USE_PIPELINES=TRUE -DCH_DBG_ENABLE_ASSERTS=TRUE"
 
 rm *log.txt 2> /dev/null
 echo
@@ -25,13 +25,15 @@
 
 #include "portab.h"
 
+/* The MFS banks are placed at the start of the second flash bank, erase
+   and program operations do not stall the code running from the first.*/
 const MFSConfig mfscfg1 = {
   .flashp           = (BaseFlash *)&EFLD1,
   .erased           = 0xFFFFFFFFU,
   .bank_size        = 4096U,
-  .bank0_start      = 128U,
+  .bank0_start      = 256U,
   .bank0_sectors    = 2U,
-  .bank1_start      = 130U,
+  .bank1_start      = 258U,
   .bank1_sectors    = 2U
 };
 
@@ -71,6 +73,9 @@ int main(void) {
 
   /* Starting EFL driver.*/
   eflStart(&EFLD1, NULL);
+  chDbgAssert(eflIsSectorConcurrent(&EFLD1, mfscfg1.bank0_start) &&
+              eflIsSectorConcurrent(&EFLD1, mfscfg1.bank1_start),
+              "MFS banks in the execution bank");
 
   /* Starting a serial port for test report output.*/
   sdStart(&PORTAB_SD1, NULL);
@@ -0,0 +1,118 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    portab.c
+ * @brief   Application portability module code.
+ *
+ * @addtogroup application_portability
+ * @{
+ */
+
+#include "hal.h"
+
+#include "hal_bench.h"
+#include "portab.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*
+ * Maximum speed SPI configuration (40MHz, CPHA=0, CPOL=0, MSb first).
+ */
+const SPIConfig portab_spicfg1 = {
+  false,
+  NULL,
+  GPIOB,
+  12,
+  0,
+  0
+};
+
+const ADCConfig portab_adccfg1 = {
+  .difsel       = 0U
+};
+
+/*
+ * ADC conversion group 1.
+ * Mode:        Continuous, 2 channels, SW triggered.
+ * Channels:    IN0, IN5.
+ */
+const ADCConversionGroup portab_adcgrpcfg1 = {
+  .circular     = true,
+  .num_channels = ADC_GRP1_NUM_CHANNELS,
+  .end_cb       = hal_bench_adc_cb,
+  .error_cb     = hal_bench_adc_error_cb,
+  .cfgr         = ADC_CFGR_CONT,
+  .cfgr2        = 0U,
+  .tr1          = ADC_TR_DISABLED,
+  .tr2          = ADC_TR_DISABLED,
+  .tr3          = ADC_TR_DISABLED,
+  .awd2cr       = 0U,
+  .awd3cr       = 0U,
+  .smpr         = {
+    ADC_SMPR1_SMP_AN0(ADC_SMPR_SMP_47P5) |
+    ADC_SMPR1_SMP_AN5(ADC_SMPR_SMP_47P5),
+    0U
+  },
+  .sqr          = {
+    ADC_SQR1_SQ1_N(ADC_CHANNEL_IN0) | ADC_SQR1_SQ2_N(ADC_CHANNEL_IN5),
+    0U,
+    0U,
+    0U
+  }
+};
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+void portab_setup(void) {
+
+  /* SPI2 I/O pins setup.*/
+  palSetPadMode(GPIOB, 13, PAL_MODE_ALTERNATE(5) |
+                           PAL_STM32_OSPEED_HIGH);          /* SCK.         */
+  palSetPadMode(GPIOB, 14, PAL_MODE_ALTERNATE(5) |
+                           PAL_STM32_OSPEED_HIGH);          /* MISO.        */
+  palSetPadMode(GPIOB, 15, PAL_MODE_ALTERNATE(5) |
+                           PAL_STM32_OSPEED_HIGH);          /* MOSI.        */
+  palSetPadMode(GPIOB, 12, PAL_MODE_OUTPUT_PUSHPULL |
+                           PAL_STM32_OSPEED_HIGH);          /* CS.          */
+  palSetPad(GPIOB, 12);
+
+  /* ADC inputs.*/
+  palSetPadMode(GPIOA, 0, PAL_MODE_INPUT_ANALOG);
+  palSetPadMode(GPIOB, 1, PAL_MODE_INPUT_ANALOG);
+}
+
+/** @} */
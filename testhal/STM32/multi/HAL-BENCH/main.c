@@ -0,0 +1,102 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ch.h"
+#include "hal.h"
+#include "ccportab.h"
+
+#include "hal_bench.h"
+#include "portab.h"
+
+#define ADC_GRP1_BUF_DEPTH      256
+
+/* Buffers are allocated with size and address aligned to the cache
+   line size.*/
+#if CACHE_LINE_SIZE > 0
+CC_ALIGN(CACHE_LINE_SIZE)
+#endif
+adcsample_t samples1[CACHE_SIZE_ALIGN(adcsample_t, ADC_GRP1_NUM_CHANNELS * ADC_GRP1_BUF_DEPTH)];
+
+/*
+ * Benchmark configuration, drivers not available on the board are left
+ * to NULL.
+ */
+static const hal_bench_config_t bench_config = {
+  .out          = (BaseSequentialStream *)&PORTAB_SD1,
+  .spip         = &PORTAB_SPI1,
+  .spicfgp      = &portab_spicfg1,
+  .adcp         = &PORTAB_ADC1,
+  .adccfgp      = &portab_adccfg1,
+  .adcgrpp      = &portab_adcgrpcfg1,
+  .adcbuf       = samples1,
+  .adcdepth     = ADC_GRP1_BUF_DEPTH
+};
+
+/*
+ * This is a periodic thread that does absolutely nothing except flashing
+ * a LED.
+ */
+static THD_WORKING_AREA(waThread1, 128);
+static THD_FUNCTION(Thread1, arg) {
+
+  (void)arg;
+  chRegSetThreadName("blinker");
+  while (true) {
+    palSetLine(PORTAB_LINE_LED1);
+    chThdSleepMilliseconds(500);
+    palClearLine(PORTAB_LINE_LED1);
+    chThdSleepMilliseconds(500);
+  }
+}
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  chSysInit();
+
+  /* Board-dependent GPIO setup code.*/
+  portab_setup();
+
+  /* Activates the serial driver used for the benchmark output.*/
+  sdStart(&PORTAB_SD1, NULL);
+
+  /*
+   * Creates the example thread.
+   */
+  chThdCreateStatic(waThread1, sizeof(waThread1), NORMALPRIO, Thread1, NULL);
+
+  /*
+   * Normal main() thread activity, the benchmark is executed each time the
+   * button is pressed.
+   */
+  while (true) {
+    if (palReadLine(PORTAB_LINE_BUTTON) == PORTAB_BUTTON_PRESSED) {
+      hal_bench_execute(&bench_config);
+    }
+    chThdSleepMilliseconds(500);
+  }
+  return 0;
+}
@@ -0,0 +1,509 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_bench.c
+ * @brief   HAL drivers benchmark code.
+ * @details Each benchmark repeats a driver operation for a fixed time
+ *          window, results are printed one per line in the format:
+ *          <tt>BENCH,board,driver,test,parameter,value,unit</tt>.<br>
+ *          The parameter is the transfer size in bytes, or in blocks for
+ *          the SDC benchmarks, transfer benchmarks report both bytes per
+ *          second and microseconds per operation, the per-transfer overhead
+ *          is the intercept of the time per operation against the size.
+ *
+ * @addtogroup HAL_BENCH
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "ccportab.h"
+#include "chprintf.h"
+#include "hal_bench.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+#define BENCH_SDC_BLOCKS            (HAL_BENCH_CFG_BUFFER_SIZE / MMCSD_BLOCK_SIZE)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+typedef bool (*bench_op_t)(size_t n);
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static const hal_bench_config_t *config;
+
+/*
+ * Transfers buffer.
+ */
+CC_ALIGN(32) static uint8_t buffer[HAL_BENCH_CFG_BUFFER_SIZE];
+
+#if (HAL_USE_SERIAL == TRUE) || (HAL_USE_SERIAL_USB == TRUE) ||             \
+    (HAL_USE_SPI == TRUE)
+static const size_t stream_sizes[] = {1, 16, 64, 256, 1024, 4096};
+#endif
+
+#if HAL_USE_SERIAL == TRUE
+static THD_WORKING_AREA(bench_tx_wa, HAL_BENCH_CFG_STACK_SIZE);
+static uint8_t txblock[64];
+#endif
+
+#if HAL_USE_SDC == TRUE
+static uint32_t sdc_block;
+static uint32_t sdc_capacity;
+static uint32_t rnd = 0x12345678U;
+#endif
+
+#if HAL_USE_ADC == TRUE
+static volatile uint32_t adc_samples;
+static volatile uint32_t adc_errors;
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void bench_report(const char *drv, const char *test, size_t param,
+                         uint32_t value, const char *unit) {
+
+  chprintf(config->out, "BENCH,%s,%s,%s,%u,%u,%s\r\n",
+           BOARD_NAME, drv, test, (unsigned)param, (unsigned)value, unit);
+}
+
+/*
+ * Repeats an operation for the measurement window, returns the number of
+ * completed operations or zero if an operation failed.
+ */
+static uint32_t bench_loop(bench_op_t op, size_t n) {
+  systime_t start, end;
+  uint32_t count = 0U;
+
+  /* Starting on a tick boundary.*/
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTime();
+  end = chTimeAddX(start, TIME_MS2I(HAL_BENCH_CFG_WINDOW));
+  do {
+    if (!op(n)) {
+      return 0U;
+    }
+    count++;
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  return count;
+}
+
+/*
+ * Measures and reports a transfer operation, the reported size is
+ * @p n, the bytes per operation are @p n multiplied by @p unit.
+ */
+static void bench_transfer(const char *drv, const char *test,
+                           bench_op_t op, size_t n, size_t unit) {
+  uint32_t count = bench_loop(op, n);
+
+  if (count == 0U) {
+    bench_report(drv, test, n, 0U, "error");
+    return;
+  }
+  bench_report(drv, test, n,
+               (uint32_t)(((uint64_t)count * n * unit * 1000U) /
+                          HAL_BENCH_CFG_WINDOW), "B/s");
+  bench_report(drv, test, n,
+               (uint32_t)(((uint64_t)HAL_BENCH_CFG_WINDOW * 1000U) / count),
+               "us/op");
+}
+
+/*
+ * Measures and reports an operations rate.
+ */
+static void bench_rate(const char *drv, const char *test,
+                       bench_op_t op, size_t n) {
+  uint32_t count = bench_loop(op, n);
+
+  if (count == 0U) {
+    bench_report(drv, test, n, 0U, "error");
+    return;
+  }
+  bench_report(drv, test, n,
+               (uint32_t)(((uint64_t)count * 1000U) / HAL_BENCH_CFG_WINDOW),
+               "op/s");
+}
+
+#if (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+static bool bench_spi_send(size_t n) {
+
+  spiSend(config->spip, n, buffer);
+  return true;
+}
+
+static void bench_spi(void) {
+  unsigned i;
+
+  spiStart(config->spip, config->spicfgp);
+  spiSelect(config->spip);
+  for (i = 0U; i < sizeof stream_sizes / sizeof stream_sizes[0]; i++) {
+    if (stream_sizes[i] <= sizeof buffer) {
+      bench_transfer("spi", "send", bench_spi_send, stream_sizes[i], 1U);
+    }
+  }
+  spiUnselect(config->spip);
+  spiStop(config->spip);
+}
+#endif
+
+#if (HAL_USE_WSPI == TRUE) || defined(__DOXYGEN__)
+static bool bench_wspi_receive(size_t n) {
+
+  return !wspiReceive(config->wspip, config->wspicmdp, n, buffer);
+}
+
+static void bench_wspi(void) {
+  static const size_t sizes[] = {16, 256, 1024, 4096};
+  unsigned i;
+
+  wspiStart(config->wspip, config->wspicfgp);
+  for (i = 0U; i < sizeof sizes / sizeof sizes[0]; i++) {
+    if (sizes[i] <= sizeof buffer) {
+      bench_transfer("wspi", "receive", bench_wspi_receive, sizes[i], 1U);
+    }
+  }
+  wspiStop(config->wspip);
+}
+#endif
+
+#if (HAL_USE_SERIAL == TRUE) || defined(__DOXYGEN__)
+/*
+ * Serial transmitter, the bytes are a modulo 256 sequence.
+ */
+static THD_FUNCTION(bench_tx_thread, arg) {
+  uint8_t seq = 0U;
+
+  (void)arg;
+  chRegSetThreadName("bench tx");
+  while (!chThdShouldTerminateX()) {
+    unsigned i;
+
+    for (i = 0U; i < sizeof txblock; i++) {
+      txblock[i] = seq++;
+    }
+    (void)sdWrite(config->sdp, txblock, sizeof txblock);
+  }
+}
+
+static void bench_serial(void) {
+  systime_t start, end;
+  uint32_t bytes = 0U, lost = 0U;
+  uint8_t expected = 0U;
+  bool synced = false;
+  thread_t *tp;
+
+  sdStart(config->sdp, config->sdcfgp);
+  tp = chThdCreateStatic(bench_tx_wa, sizeof bench_tx_wa,
+                         chThdGetPriorityX() - 1, bench_tx_thread, NULL);
+
+  /* Receiving and checking the sequence, gaps are lost bytes.*/
+  chThdSleep((sysinterval_t)1);
+  start = chVTGetSystemTime();
+  end = chTimeAddX(start, TIME_MS2I(HAL_BENCH_CFG_WINDOW));
+  do {
+    size_t i, n;
+
+    n = sdReadTimeout(config->sdp, buffer, 64, TIME_MS2I(100));
+    for (i = 0U; i < n; i++) {
+      if (synced && (buffer[i] != expected)) {
+        lost += (uint8_t)(buffer[i] - expected);
+      }
+      expected = buffer[i] + 1U;
+      synced = true;
+    }
+    bytes += (uint32_t)n;
+  } while (chVTIsSystemTimeWithinX(start, end));
+
+  chThdTerminate(tp);
+  (void)chThdWait(tp);
+  sdStop(config->sdp);
+
+  if (bytes == 0U) {
+    bench_report("serial", "rx", 64, 0U, "error");
+    return;
+  }
+  bench_report("serial", "rx", 64,
+               (uint32_t)(((uint64_t)bytes * 1000U) / HAL_BENCH_CFG_WINDOW),
+               "B/s");
+  bench_report("serial", "rx", 64, lost, "lost");
+}
+#endif
+
+#if (HAL_USE_SDC == TRUE) || defined(__DOXYGEN__)
+static uint32_t bench_sdc_next(uint32_t n) {
+  uint32_t blk = sdc_block;
+
+  sdc_block += n;
+  if (sdc_block + n > sdc_capacity) {
+    sdc_block = 0U;
+  }
+  return blk;
+}
+
+static uint32_t bench_sdc_random(void) {
+
+  rnd = (rnd * 1103515245U) + 12345U;
+  return (rnd >> 8) % sdc_capacity;
+}
+
+static bool bench_sdc_read(size_t n) {
+
+  return !sdcRead(config->sdcp, bench_sdc_next((uint32_t)n),
+                  buffer, (uint32_t)n);
+}
+
+static bool bench_sdc_write(size_t n) {
+
+  return !sdcWrite(config->sdcp, bench_sdc_next((uint32_t)n),
+                   buffer, (uint32_t)n);
+}
+
+static bool bench_sdc_random_read(size_t n) {
+
+  return !sdcRead(config->sdcp, bench_sdc_random(), buffer, (uint32_t)n);
+}
+
+static bool bench_sdc_random_write(size_t n) {
+
+  return !sdcWrite(config->sdcp, bench_sdc_random(), buffer, (uint32_t)n);
+}
+
+static void bench_sdc(void) {
+  static const size_t sizes[] = {1, 8, BENCH_SDC_BLOCKS};
+  unsigned i;
+
+  sdcStart(config->sdcp, config->sdccfgp);
+  if (sdcConnect(config->sdcp)) {
+    bench_report("sdc", "connect", 0U, 0U, "error");
+    sdcStop(config->sdcp);
+    return;
+  }
+  sdc_capacity = mmcsdGetCardCapacity(config->sdcp);
+
+  for (i = 0U; i < sizeof sizes / sizeof sizes[0]; i++) {
+    sdc_block = 0U;
+    bench_transfer("sdc", "read", bench_sdc_read, sizes[i], MMCSD_BLOCK_SIZE);
+  }
+  bench_rate("sdc", "random_read", bench_sdc_random_read, 1U);
+
+  if (config->sdcwrite) {
+    for (i = 0U; i < sizeof sizes / sizeof sizes[0]; i++) {
+      sdc_block = 0U;
+      bench_transfer("sdc", "write", bench_sdc_write, sizes[i],
+                     MMCSD_BLOCK_SIZE);
+    }
+    bench_rate("sdc", "random_write", bench_sdc_random_write, 1U);
+  }
+
+  (void)sdcDisconnect(config->sdcp);
+  sdcStop(config->sdcp);
+}
+#endif
+
+#if (HAL_USE_SERIAL_USB == TRUE) || defined(__DOXYGEN__)
+static bool bench_usb_write(size_t n) {
+
+  return chnWriteTimeout(config->sdup, buffer, n, TIME_MS2I(500)) == n;
+}
+
+static void bench_usb(void) {
+  unsigned i;
+
+  for (i = 0U; i < sizeof stream_sizes / sizeof stream_sizes[0]; i++) {
+    if (stream_sizes[i] <= sizeof buffer) {
+      bench_transfer("usb_cdc", "tx", bench_usb_write, stream_sizes[i], 1U);
+    }
+  }
+}
+#endif
+
+#if (HAL_USE_MAC == TRUE) || defined(__DOXYGEN__)
+static bool bench_mac_send(size_t n) {
+  MACTransmitDescriptor td;
+
+  if (macWaitTransmitDescriptor(config->macp, &td,
+                                TIME_MS2I(100)) != MSG_OK) {
+    return false;
+  }
+  (void)macWriteTransmitDescriptor(&td, buffer, n);
+  macReleaseTransmitDescriptor(&td);
+
+  return true;
+}
+
+static void bench_mac(void) {
+  static const uint8_t header[14] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,     /* Broadcast destination.   */
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x01,     /* Local source.            */
+    0x88, 0xB5                              /* Experimental EtherType.  */
+  };
+  static const size_t sizes[] = {60, 512, 1514};
+  unsigned i;
+
+  macStart(config->macp, config->maccfgp);
+  memcpy(buffer, header, sizeof header);
+  for (i = 0U; (i < 50U) && !macPollLinkStatus(config->macp); i++) {
+    chThdSleepMilliseconds(100);
+  }
+  for (i = 0U; i < sizeof sizes / sizeof sizes[0]; i++) {
+    bench_rate("mac", "tx", bench_mac_send, sizes[i]);
+  }
+  macStop(config->macp);
+}
+#endif
+
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+static void bench_adc(void) {
+  uint32_t samples;
+
+  adc_errors = 0U;
+  adcStart(config->adcp, config->adccfgp);
+  adcStartConversion(config->adcp, config->adcgrpp,
+                     config->adcbuf, config->adcdepth);
+
+  chThdSleep((sysinterval_t)1);
+  samples = adc_samples;
+  chThdSleepMilliseconds(HAL_BENCH_CFG_WINDOW);
+  samples = adc_samples - samples;
+
+  adcStopConversion(config->adcp);
+  adcStop(config->adcp);
+
+  bench_report("adc", "circular", config->adcgrpp->num_channels,
+               (uint32_t)(((uint64_t)samples * 1000U) / HAL_BENCH_CFG_WINDOW),
+               "sample/s");
+  bench_report("adc", "circular", config->adcgrpp->num_channels,
+               adc_errors, "errors");
+}
+#endif
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   ADC callback, counts the converted samples.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ */
+void hal_bench_adc_cb(ADCDriver *adcp) {
+
+  /* Invoked at half and full buffer in circular mode.*/
+  adc_samples += (uint32_t)(adcp->depth / 2U) * adcp->grpp->num_channels;
+}
+
+/**
+ * @brief   ADC error callback, counts the errors.
+ *
+ * @param[in] adcp      pointer to the @p ADCDriver object
+ * @param[in] err       ADC error code
+ */
+void hal_bench_adc_error_cb(ADCDriver *adcp, adcerror_t err) {
+
+  (void)adcp;
+  (void)err;
+  adc_errors++;
+}
+#endif
+
+/**
+ * @brief   HAL benchmark execution.
+ *
+ * @param[in] cfg       pointer to the benchmark configuration structure
+ */
+void hal_bench_execute(const hal_bench_config_t *cfg) {
+  unsigned i;
+
+  config = cfg;
+
+  for (i = 0U; i < sizeof buffer; i++) {
+    buffer[i] = (uint8_t)i;
+  }
+  cacheBufferFlush(buffer, sizeof buffer);
+
+  chprintf(cfg->out, "\r\n*** ChibiOS/HAL drivers benchmark\r\n***\r\n");
+  chprintf(cfg->out, "*** Kernel:       %s\r\n", CH_KERNEL_VERSION);
+  chprintf(cfg->out, "*** Compiled:     %s\r\n", __DATE__ " - " __TIME__);
+#ifdef PORT_COMPILER_NAME
+  chprintf(cfg->out, "*** Compiler:     %s\r\n", PORT_COMPILER_NAME);
+#endif
+#ifdef PLATFORM_NAME
+  chprintf(cfg->out, "*** Platform:     %s\r\n", PLATFORM_NAME);
+#endif
+  chprintf(cfg->out, "*** Test Board:   %s\r\n", BOARD_NAME);
+  chprintf(cfg->out, "*** Window:       %u mS\r\n***\r\n",
+           (unsigned)HAL_BENCH_CFG_WINDOW);
+  chprintf(cfg->out, "BENCH,board,driver,test,parameter,value,unit\r\n");
+
+#if HAL_USE_SPI == TRUE
+  if (cfg->spip != NULL) {
+    bench_spi();
+  }
+#endif
+#if HAL_USE_WSPI == TRUE
+  if (cfg->wspip != NULL) {
+    bench_wspi();
+  }
+#endif
+#if HAL_USE_SERIAL == TRUE
+  if (cfg->sdp != NULL) {
+    bench_serial();
+  }
+#endif
+#if HAL_USE_SDC == TRUE
+  if (cfg->sdcp != NULL) {
+    bench_sdc();
+  }
+#endif
+#if HAL_USE_SERIAL_USB == TRUE
+  if (cfg->sdup != NULL) {
+    bench_usb();
+  }
+#endif
+#if HAL_USE_MAC == TRUE
+  if (cfg->macp != NULL) {
+    bench_mac();
+  }
+#endif
+#if HAL_USE_ADC == TRUE
+  if (cfg->adcp != NULL) {
+    bench_adc();
+  }
+#endif
+
+  chprintf(cfg->out, "\r\nBenchmark Complete\r\n");
+}
+
+/** @} */
@@ -0,0 +1,202 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_bench.h
+ * @brief   HAL drivers benchmark header.
+ *
+ * @addtogroup HAL_BENCH
+ * @{
+ */
+
+#ifndef HAL_BENCH_H
+#define HAL_BENCH_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Duration of each measurement in milliseconds.
+ */
+#if !defined(HAL_BENCH_CFG_WINDOW) || defined(__DOXYGEN__)
+#define HAL_BENCH_CFG_WINDOW                1000
+#endif
+
+/**
+ * @brief   Size of the transfers buffer.
+ * @note    Transfer sizes larger than the buffer are skipped.
+ */
+#if !defined(HAL_BENCH_CFG_BUFFER_SIZE) || defined(__DOXYGEN__)
+#define HAL_BENCH_CFG_BUFFER_SIZE           4096
+#endif
+
+/**
+ * @brief   Stack size for the serial transmitter thread.
+ */
+#if !defined(HAL_BENCH_CFG_STACK_SIZE) || defined(__DOXYGEN__)
+#define HAL_BENCH_CFG_STACK_SIZE            256
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (HAL_BENCH_CFG_BUFFER_SIZE < 512) ||                                    \
+    ((HAL_BENCH_CFG_BUFFER_SIZE % 512) != 0)
+#error "HAL_BENCH_CFG_BUFFER_SIZE must be a multiple of 512"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Benchmark configuration.
+ * @details Drivers pointers set to @p NULL are not benchmarked.
+ */
+typedef struct {
+  /**
+   * @brief   Stream for output.
+   */
+  BaseSequentialStream      *out;
+#if (HAL_USE_SPI == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   SPI driver, exchanges are performed with the slave selected.
+   */
+  SPIDriver                 *spip;
+  /**
+   * @brief   SPI configuration.
+   */
+  const SPIConfig           *spicfgp;
+#endif
+#if (HAL_USE_WSPI == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   WSPI driver.
+   */
+  WSPIDriver                *wspip;
+  /**
+   * @brief   WSPI configuration.
+   */
+  const WSPIConfig          *wspicfgp;
+  /**
+   * @brief   WSPI read command of the device.
+   */
+  const wspi_command_t      *wspicmdp;
+#endif
+#if (HAL_USE_SERIAL == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Serial driver, its TX line must be looped back to RX.
+   */
+  SerialDriver              *sdp;
+  /**
+   * @brief   Serial configuration.
+   */
+  const SerialConfig        *sdcfgp;
+#endif
+#if (HAL_USE_SDC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   SDC driver.
+   */
+  SDCDriver                 *sdcp;
+  /**
+   * @brief   SDC configuration.
+   */
+  const SDCConfig           *sdccfgp;
+  /**
+   * @brief   Enables the write benchmarks, the card content is destroyed.
+   */
+  bool                      sdcwrite;
+#endif
+#if (HAL_USE_SERIAL_USB == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Serial over USB driver, already started and connected.
+   * @note    The host must read the transmitted data.
+   */
+  SerialUSBDriver           *sdup;
+#endif
+#if (HAL_USE_MAC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   MAC driver.
+   */
+  MACDriver                 *macp;
+  /**
+   * @brief   MAC configuration.
+   */
+  const MACConfig           *maccfgp;
+#endif
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   ADC driver.
+   */
+  ADCDriver                 *adcp;
+  /**
+   * @brief   ADC configuration.
+   */
+  const ADCConfig           *adccfgp;
+  /**
+   * @brief   ADC circular conversion group.
+   * @note    The group callbacks must be @p hal_bench_adc_cb() and
+   *          @p hal_bench_adc_error_cb().
+   */
+  const ADCConversionGroup  *adcgrpp;
+  /**
+   * @brief   ADC samples buffer.
+   */
+  adcsample_t               *adcbuf;
+  /**
+   * @brief   ADC samples buffer depth.
+   */
+  size_t                    adcdepth;
+#endif
+} hal_bench_config_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#if (HAL_USE_ADC == TRUE) || defined(__DOXYGEN__)
+  void hal_bench_adc_cb(ADCDriver *adcp);
+  void hal_bench_adc_error_cb(ADCDriver *adcp, adcerror_t err);
+#endif
+  void hal_bench_execute(const hal_bench_config_t *cfg);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* HAL_BENCH_H */
+
+/** @} */
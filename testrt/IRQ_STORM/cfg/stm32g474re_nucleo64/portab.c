@@ -24,6 +24,7 @@
 
 #include "hal.h"
 #include "irq_storm.h"
+#include "irq_latency.h"
 
 #include "portab.h"
 
@@ -68,6 +69,20 @@ const irq_storm_config_t portab_irq_storm_config = {
   STM32_SYSCLK
 };
 
+static const GPTConfig gpt5cfg = {
+  STM32_TIMCLK1,        /* Timer clock as system clock.*/
+  irq_latency_gpt_cb,   /* Timer callback.*/
+  0,
+  0
+};
+
+const irq_latency_config_t portab_irq_latency_config = {
+  (BaseSequentialStream  *)&PORTAB_SD1,
+  &GPTD5,
+  &gpt5cfg,
+  STM32_SYSCLK
+};
+
 /*===========================================================================*/
 /* Module local types.                                                       */
 /*===========================================================================*/
@@ -60,6 +60,7 @@
 /*===========================================================================*/
 
 extern const irq_storm_config_t portab_irq_storm_config;
+extern const irq_latency_config_t portab_irq_latency_config;
 
 #ifdef __cplusplus
 extern "C" {
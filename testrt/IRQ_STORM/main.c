@@ -18,6 +18,7 @@
 #include "hal.h"
 
 #include "irq_storm.h"
+#include "irq_latency.h"
 
 #include "portab.h"
 
@@ -39,7 +40,8 @@ int main(void) {
   /* Serial Driver for output.*/
   sdStart(&PORTAB_SD1, NULL);
 
-  /* Running the test.*/
+  /* Measuring the latencies then running the stress test.*/
+  irq_latency_execute(&portab_irq_latency_config);
   irq_storm_execute(&portab_irq_storm_config);
 
   /* Normal main() thread activity, nothing in this test.*/
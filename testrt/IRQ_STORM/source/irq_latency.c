@@ -0,0 +1,311 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    irq_latency.c
+ * @brief   IRQ latency measurement code.
+ * @details Two latencies are measured, in system clock cycles:
+ *          - Entry latency, the time from the timer update event to the
+ *            execution of the GPT callback, it includes the vector, the
+ *            IRQ prologue and the driver handler.
+ *          - Wakeup latency, the time from the GPT callback resuming a
+ *            thread to the thread running.
+ *          .
+ *          The measurements are repeated with the system idle and with a
+ *          background thread invoking kernel services, the difference
+ *          between the best and worst cases is the jitter introduced by
+ *          the kernel critical zones.
+ *
+ * @addtogroup IRQ_LATENCY
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+
+#include "chprintf.h"
+#include "irq_latency.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static const irq_latency_config_t *config;
+
+/*
+ * Timer ticks to clock cycles ratio.
+ */
+static uint32_t ratio;
+
+/*
+ * Measurements state, written by the ISR.
+ */
+static irq_latency_hist_t entry_hist;
+static irq_latency_hist_t wakeup_hist;
+static thread_reference_t trp;
+static rtcnt_t stamp;
+static uint32_t missed;
+static bool done;
+
+/*
+ * Threads working areas.
+ */
+static THD_WORKING_AREA(irq_latency_wait_wa, IRQ_LATENCY_CFG_STACK_SIZE);
+static THD_WORKING_AREA(irq_latency_load_wa, IRQ_LATENCY_CFG_STACK_SIZE);
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static void hist_reset(irq_latency_hist_t *hp) {
+  unsigned i;
+
+  hp->n          = 0U;
+  hp->best       = (uint32_t)-1;
+  hp->worst      = 0U;
+  hp->cumulative = 0U;
+  for (i = 0U; i < IRQ_LATENCY_CFG_BINS; i++) {
+    hp->bins[i] = 0U;
+  }
+}
+
+static void hist_add(irq_latency_hist_t *hp, uint32_t value) {
+  uint32_t bin = value / IRQ_LATENCY_CFG_BIN_WIDTH;
+
+  if (bin >= IRQ_LATENCY_CFG_BINS) {
+    bin = IRQ_LATENCY_CFG_BINS - 1U;
+  }
+  hp->bins[bin]++;
+  hp->n++;
+  hp->cumulative += value;
+  if (value < hp->best) {
+    hp->best = value;
+  }
+  if (value > hp->worst) {
+    hp->worst = value;
+  }
+}
+
+static void hist_print(const char *name, const irq_latency_hist_t *hp) {
+  BaseSequentialStream *out = config->out;
+  unsigned i;
+
+  if (hp->n == 0U) {
+    chprintf(out, "%s: no samples\r\n", name);
+    return;
+  }
+  chprintf(out, "%s: best %u, worst %u, average %u, jitter %u cycles\r\n",
+           name, hp->best, hp->worst,
+           (uint32_t)(hp->cumulative / hp->n), hp->worst - hp->best);
+  for (i = 0U; i < IRQ_LATENCY_CFG_BINS; i++) {
+    if (hp->bins[i] == 0U) {
+      continue;
+    }
+    if (i < IRQ_LATENCY_CFG_BINS - 1U) {
+      chprintf(out, "  %5u..%5u: %u\r\n",
+               i * IRQ_LATENCY_CFG_BIN_WIDTH,
+               ((i + 1U) * IRQ_LATENCY_CFG_BIN_WIDTH) - 1U,
+               hp->bins[i]);
+    }
+    else {
+      chprintf(out, "  %5u..     : %u\r\n",
+               i * IRQ_LATENCY_CFG_BIN_WIDTH, hp->bins[i]);
+    }
+  }
+}
+
+/*
+ * Thread woken by the GPT callback, it measures the wakeup latency.
+ */
+static THD_FUNCTION(irq_latency_wait_thread, arg) {
+
+  (void)arg;
+  chRegSetThreadName("irq_latency");
+
+  chSysLock();
+  while (!done) {
+    if (chThdSuspendS(&trp) == MSG_OK) {
+      uint32_t latency = (uint32_t)(chSysGetRealtimeCounterX() - stamp);
+
+      chSysUnlock();
+      hist_add(&wakeup_hist, latency);
+      chSysLock();
+    }
+  }
+  chSysUnlock();
+}
+
+static void load_cb(void *p) {
+
+  (void)p;
+}
+
+/*
+ * Background load thread, it keeps entering and leaving kernel critical
+ * zones.
+ */
+static THD_FUNCTION(irq_latency_load_thread, arg) {
+  virtual_timer_t vt;
+  semaphore_t sem;
+
+  (void)arg;
+  chRegSetThreadName("irq_load");
+
+  chVTObjectInit(&vt);
+  chSemObjectInit(&sem, 0);
+  while (chThdShouldTerminateX() == false) {
+    chSemSignal(&sem);
+    (void)chSemWaitTimeout(&sem, TIME_IMMEDIATE);
+    chVTSet(&vt, TIME_MS2I(10), load_cb, NULL);
+    chVTReset(&vt);
+  }
+}
+
+static void measure(const char *phase, bool load) {
+  thread_t *wtp, *ltp = NULL;
+
+  hist_reset(&entry_hist);
+  hist_reset(&wakeup_hist);
+  missed = 0U;
+  done   = false;
+
+  wtp = chThdCreateStatic(irq_latency_wait_wa, sizeof irq_latency_wait_wa,
+                          IRQ_LATENCY_CFG_THREAD_PRIORITY,
+                          irq_latency_wait_thread, NULL);
+  if (load) {
+    ltp = chThdCreateStatic(irq_latency_load_wa, sizeof irq_latency_load_wa,
+                            IRQ_LATENCY_CFG_LOAD_PRIORITY,
+                            irq_latency_load_thread, NULL);
+  }
+
+  /* Sampling until the callback has collected enough samples.*/
+  gptStartContinuous(config->gptp,
+                     (gptcnt_t)((config->gptcfgp->frequency / 1000000U) *
+                                IRQ_LATENCY_CFG_INTERVAL));
+  chThdWait(wtp);
+
+  if (ltp != NULL) {
+    chThdTerminate(ltp);
+    chThdWait(ltp);
+  }
+
+  chprintf(config->out, "--- %s\r\n", phase);
+  hist_print("Entry ", &entry_hist);
+  hist_print("Wakeup", &wakeup_hist);
+  chprintf(config->out, "Missed wakeups: %u\r\n\r\n", missed);
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   GPT callback.
+ */
+void irq_latency_gpt_cb(GPTDriver *gptp) {
+  uint32_t latency = (uint32_t)gptGetCounterX(gptp) * ratio;
+  rtcnt_t now = chSysGetRealtimeCounterX();
+
+  chSysLockFromISR();
+  if (!done) {
+    hist_add(&entry_hist, latency);
+    if (entry_hist.n >= IRQ_LATENCY_CFG_SAMPLES) {
+      gptStopTimerI(gptp);
+      done = true;
+    }
+    if (trp != NULL) {
+      stamp = now;
+      chThdResumeI(&trp, MSG_OK);
+    }
+    else {
+      /* The thread is still processing the previous sample.*/
+      missed++;
+    }
+  }
+  chSysUnlockFromISR();
+}
+
+/**
+ * @brief   IRQ latency measurement execution.
+ *
+ * @param[in] cfg       pointer to the test configuration structure
+ *
+ * @api
+ */
+void irq_latency_execute(const irq_latency_config_t *cfg) {
+
+  /* Global configuration pointer.*/
+  config = cfg;
+  ratio  = cfg->sysclk / cfg->gptcfgp->frequency;
+
+  /* Starting timer using the stored configuration.*/
+  gptStart(cfg->gptp, cfg->gptcfgp);
+
+  /* Printing environment information.*/
+  chprintf(cfg->out, "\r\n*** ChibiOS/RT IRQ latency measurement\r\n***\r\n");
+  chprintf(cfg->out, "*** Kernel:       %s\r\n", CH_KERNEL_VERSION);
+  chprintf(cfg->out, "*** Compiled:     %s\r\n", __DATE__ " - " __TIME__);
+#ifdef PORT_COMPILER_NAME
+  chprintf(cfg->out, "*** Compiler:     %s\r\n", PORT_COMPILER_NAME);
+#endif
+  chprintf(cfg->out, "*** Architecture: %s\r\n", PORT_ARCHITECTURE_NAME);
+#ifdef PORT_CORE_VARIANT_NAME
+  chprintf(cfg->out, "*** Core Variant: %s\r\n", PORT_CORE_VARIANT_NAME);
+#endif
+  chprintf(cfg->out, "*** System Clock: %d\r\n", cfg->sysclk);
+  chprintf(cfg->out, "*** Timer Clock:  %d\r\n", cfg->gptcfgp->frequency);
+#ifdef PORT_INFO
+  chprintf(cfg->out, "*** Port Info:    %s\r\n", PORT_INFO);
+#endif
+#ifdef PLATFORM_NAME
+  chprintf(cfg->out, "*** Platform:     %s\r\n", PLATFORM_NAME);
+#endif
+#ifdef BOARD_NAME
+  chprintf(cfg->out, "*** Test Board:   %s\r\n", BOARD_NAME);
+#endif
+  chprintf(cfg->out, "***\r\n");
+  chprintf(cfg->out, "*** Time Delta:   %d\r\n", CH_CFG_ST_TIMEDELTA);
+  chprintf(cfg->out, "*** Time Quantum: %d\r\n", CH_CFG_TIME_QUANTUM);
+  chprintf(cfg->out, "*** Statistics:   %d\r\n", CH_DBG_STATISTICS);
+  chprintf(cfg->out, "*** State Check:  %d\r\n", CH_DBG_SYSTEM_STATE_CHECK);
+  chprintf(cfg->out, "*** Param Checks: %d\r\n", CH_DBG_ENABLE_CHECKS);
+  chprintf(cfg->out, "*** Assertions:   %d\r\n", CH_DBG_ENABLE_ASSERTS);
+  chprintf(cfg->out, "*** Trace Mask:   %d\r\n", CH_DBG_TRACE_MASK);
+  chprintf(cfg->out, "*** Stack Check:  %d\r\n", CH_DBG_ENABLE_STACK_CHECK);
+  chprintf(cfg->out, "***\r\n");
+  chprintf(cfg->out, "*** Samples:      %d\r\n", IRQ_LATENCY_CFG_SAMPLES);
+  chprintf(cfg->out, "*** Interval:     %d uS\r\n", IRQ_LATENCY_CFG_INTERVAL);
+  chprintf(cfg->out, "*** Bin Width:    %d\r\n\r\n", IRQ_LATENCY_CFG_BIN_WIDTH);
+
+  measure("Idle system", false);
+  measure("Loaded system", true);
+
+  gptStop(cfg->gptp);
+}
+
+/** @} */
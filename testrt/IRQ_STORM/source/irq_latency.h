@@ -0,0 +1,179 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    irq_latency.h
+ * @brief   IRQ latency measurement header.
+ *
+ * @addtogroup IRQ_LATENCY
+ * @{
+ */
+
+#ifndef IRQ_LATENCY_H
+#define IRQ_LATENCY_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Number of samples for each measurement phase.
+ */
+#if !defined(IRQ_LATENCY_CFG_SAMPLES) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_SAMPLES             10000
+#endif
+
+/**
+ * @brief   Interval between interrupts in microseconds.
+ */
+#if !defined(IRQ_LATENCY_CFG_INTERVAL) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_INTERVAL            100
+#endif
+
+/**
+ * @brief   Number of histogram bins.
+ * @note    The last bin collects all the samples out of range.
+ */
+#if !defined(IRQ_LATENCY_CFG_BINS) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_BINS                16
+#endif
+
+/**
+ * @brief   Width of histogram bins in clock cycles.
+ */
+#if !defined(IRQ_LATENCY_CFG_BIN_WIDTH) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_BIN_WIDTH           8
+#endif
+
+/**
+ * @brief   Priority of the thread woken by the interrupt.
+ */
+#if !defined(IRQ_LATENCY_CFG_THREAD_PRIORITY) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_THREAD_PRIORITY     (tprio_t)(NORMALPRIO+10)
+#endif
+
+/**
+ * @brief   Priority of the background load thread.
+ */
+#if !defined(IRQ_LATENCY_CFG_LOAD_PRIORITY) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_LOAD_PRIORITY       (tprio_t)(NORMALPRIO-10)
+#endif
+
+/**
+ * @brief   Stack size for worker threads.
+ */
+#if !defined(IRQ_LATENCY_CFG_STACK_SIZE) || defined(__DOXYGEN__)
+#define IRQ_LATENCY_CFG_STACK_SIZE          256
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if IRQ_LATENCY_CFG_BINS < 2
+#error "invalid IRQ_LATENCY_CFG_BINS value"
+#endif
+
+#if PORT_SUPPORTS_RT == FALSE
+#error "IRQ latency measurement requires PORT_SUPPORTS_RT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+typedef struct {
+  /**
+   * @brief   Stream for output.
+   */
+  BaseSequentialStream  *out;
+  /**
+   * @brief   GPT driver used as interrupt source.
+   */
+  GPTDriver             *gptp;
+  /**
+   * @brief   GPT configuration.
+   * @note    The callback must be @p irq_latency_gpt_cb() and the
+   *          frequency must be a divisor of the system clock, the best
+   *          resolution is obtained with the timer running at the
+   *          system clock.
+   */
+  const GPTConfig       *gptcfgp;
+  /**
+   * @brief   System clock.
+   */
+  uint32_t              sysclk;
+} irq_latency_config_t;
+
+/**
+ * @brief   Latency histogram.
+ */
+typedef struct {
+  /**
+   * @brief   Number of samples.
+   */
+  uint32_t              n;
+  /**
+   * @brief   Best latency.
+   */
+  uint32_t              best;
+  /**
+   * @brief   Worst latency.
+   */
+  uint32_t              worst;
+  /**
+   * @brief   Sum of all samples.
+   */
+  uint64_t              cumulative;
+  /**
+   * @brief   Samples count for each bin.
+   */
+  uint32_t              bins[IRQ_LATENCY_CFG_BINS];
+} irq_latency_hist_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void irq_latency_gpt_cb(GPTDriver *gptp);
+  void irq_latency_execute(const irq_latency_config_t *cfg);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* IRQ_LATENCY_H */
+
+/** @} */